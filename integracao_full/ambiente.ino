@@ -0,0 +1,78 @@
+// Temperatura e umidade da sala (ambiente.ino)
+// O ModeloTermico_PI2 traz o ambiente do ensaio ao degrau: numa manhã fria
+// a sala está 10 C abaixo dele, a alimentação direta fica curta em
+// ganho * 10 C e o PID corre atrás da rampa inteira. Aqui o DHT_Unified
+// lê pelo leitor sem bloqueio do DHT (a ISR data as bordas, update() no
+// laco() só avança), no máximo a cada 2 s; cada leitura boa passa por um
+// filtro de AMBIENTE_TAU_S e, a cada AMBIENTE_PERIODO_MS fora da corrida,
+// o filtrado vai para ambiente_aplicado, que configAmbiente() (config.ino)
+// leva ao modelo no início de controle_pid(). A umidade só vai para
+// /metrics: na troca de calor da câmara ela não pesa.
+
+#if MODO_AMBIENTE
+
+#define AMBIENTE_MIN -20   // fora disso o sensor falhou ou está perto demais do forno
+#define AMBIENTE_MAX 60
+
+DHT_Unified ambiente_dht(ambienteDHT, AMBIENTE_TIPO);
+float ambiente_filtrado = NAN;
+float ambiente_umidade = NAN;
+uint32_t ambiente_instante = 0;              // millis() da última leitura boa
+uint32_t ambiente_publicado = 0;             // millis() do último ambiente_aplicado
+volatile float ambiente_aplicado = NAN;      // o que o controle usa; NAN = ff_amb
+uint32_t ambiente_boas = 0;
+uint32_t ambiente_rejeitadas = 0;
+
+void ambienteIniciar(){
+  ambiente_dht.begin();
+}
+
+// laco(): o DHT só leva o pino ao nível baixo e volta
+void ambienteAtender(){
+  uint32_t agora = millis();
+  if(ambiente_dht.update()){
+    sensors_event_t t, u;
+    ambiente_dht.temperature().getEvent(&t);
+    ambiente_dht.humidity().getEvent(&u);
+    if(t.temperature > AMBIENTE_MIN && t.temperature < AMBIENTE_MAX){
+      if(isnan(ambiente_filtrado)){
+        ambiente_filtrado = t.temperature;   // a primeira vale direto
+        ambiente_publicado = agora - AMBIENTE_PERIODO_MS;
+      }
+      else {
+        float dt = (t.timestamp - ambiente_instante) / 1000.0;
+        ambiente_filtrado += (t.temperature - ambiente_filtrado) * dt / (AMBIENTE_TAU_S + dt);
+      }
+      ambiente_umidade = u.relative_humidity;
+      ambiente_instante = t.timestamp;
+      ambiente_boas++;
+    }
+    else ambiente_rejeitadas++;
+  }
+
+  // na corrida o modelo fica com o ambiente do início
+  if(corridaAtiva() || agora - ambiente_publicado < AMBIENTE_PERIODO_MS) return;
+  ambiente_publicado = agora;
+  bool recente = !isnan(ambiente_filtrado) && agora - ambiente_instante < AMBIENTE_VALIDADE_MS;
+  ambiente_aplicado = recente ? ambiente_filtrado : NAN;
+}
+
+// configAmbiente(): NAN sem leitura recente
+float ambienteMedido(){
+  return ambiente_aplicado;
+}
+
+// handleMetrics()
+void ambienteMetricas(){
+  metricasCabecalho("forno_ambiente_celsius", "gauge", "temperatura da sala filtrada");
+  metricasLinha("forno_ambiente_celsius %.2f\n", ambiente_filtrado);
+  metricasCabecalho("forno_ambiente_umidade_pct", "gauge", "umidade relativa da sala");
+  metricasLinha("forno_ambiente_umidade_pct %.1f\n", ambiente_umidade);
+  metricasCabecalho("forno_ambiente_modelo_celsius", "gauge", "ambiente em uso no modelo termico");
+  metricasLinha("forno_ambiente_modelo_celsius %.2f\n", modelo.ambiente());
+  metricasCabecalho("forno_ambiente_leituras_total", "counter", "leituras do DHT por resultado");
+  metricasLinha("forno_ambiente_leituras_total{resultado=\"boa\"} %lu\n", (unsigned long)ambiente_boas);
+  metricasLinha("forno_ambiente_leituras_total{resultado=\"rejeitada\"} %lu\n", (unsigned long)ambiente_rejeitadas);
+}
+
+#endif
@@ -0,0 +1,75 @@
+// Painel no app Blynk (MODO_BLYNK)
+// O servidor Blynk derruba quem passa de BLYNK_MSG_LIMIT mensagens por
+// segundo, então a telemetria não vai pino a pino: a cada
+// BLYNK_INTERVALO_MS sai um único virtualWrite multi-valor em
+// BLYNK_PINO_TELEMETRIA com temperatura, set point, potência e estado da
+// corrida, nessa ordem. Os eventos (eventos.ino) vão por Blynk.notify.
+// No fim de cada corrida o resumo vai para a tabela BLYNK_PINO_RESUMO
+// numa escrita só (addRows: as linhas gastam uma vaga do limite, não uma
+// cada) e uma linha vai para o terminal BLYNK_PINO_TERMINAL, que junta o
+// texto e só envia depois de BLYNK_TERMINAL_FLUSH_MS.
+// Com BLYNK_SSL no ESP8266, os buffers do TLS, do tamanho de fragmento
+// negociado com o servidor, vão para o /metrics.
+
+#if MODO_BLYNK
+
+#define BLYNK_INTERVALO_MS    1000
+#define BLYNK_PINO_TELEMETRIA V0
+#define BLYNK_PINO_RESUMO     V1
+#define BLYNK_PINO_TERMINAL   V2
+#define BLYNK_LINHAS_RESUMO   7
+
+unsigned long blynk_envio = 0;
+WidgetTable blynk_tabela(BLYNK_PINO_RESUMO);
+WidgetTerminal blynk_terminal(BLYNK_PINO_TERMINAL);
+
+void blynkIniciar(){
+  Blynk.config(BLYNK_TOKEN);   // não conecta aqui: Blynk.run() cuida disso
+}
+
+void blynkAtender(){
+  if(!redeConectada()) return;
+  Blynk.run();
+  blynk_terminal.run();
+
+  if(!Blynk.connected() || millis() - blynk_envio < BLYNK_INTERVALO_MS) return;
+  blynk_envio = millis();
+
+  AmostraControle a;
+  telemetria.ler(a);
+  Blynk.virtualWrite(BLYNK_PINO_TELEMETRIA, a.rk, a.set_point, a.controle_potencia, corridaNome());
+}
+
+// corridaFecharRegistro(): a tabela troca de corrida inteira
+void blynkResumo(const ResumoCorrida& r){
+  if(!Blynk.connected()) return;
+  static const char* const nomes[BLYNK_LINHAS_RESUMO] = {
+    "pico C", "TAL s", "patamar s", "subida C/s", "descida C/s", "duracao s", "energia Wh"
+  };
+  const float medidas[BLYNK_LINHAS_RESUMO] = {
+    r.pico, r.tal_s, r.patamar_s, r.subidaMax, r.descidaMax, r.duracao_ms / 1000.0f, energiaCorridaWh()
+  };
+  char valores[BLYNK_LINHAS_RESUMO][12];
+  for(uint8_t i=0; i<BLYNK_LINHAS_RESUMO; i++) snprintf(valores[i], sizeof(valores[i]), "%.1f", medidas[i]);
+  blynk_tabela.clear();
+  blynk_tabela.addRows(0, nomes, valores, BLYNK_LINHAS_RESUMO);
+
+  blynk_terminal.print("corrida ");
+  blynk_terminal.print(registro.corrida());
+  blynk_terminal.print(r.falhas ? ": reprovada " : ": aprovada ");
+  char falhas[CORRIDA_FALHAS_JSON];
+  blynk_terminal.println(corridaFalhasJson(r.falhas, falhas, sizeof(falhas)));
+}
+
+#if BLYNK_SSL && !defined(ESP32) && !defined(BLYNK_SSL_USE_AXTLS)
+// handleMetrics(); 0 antes da primeira conexão
+void blynkMetricas(){
+  metricasCabecalho("forno_tls_buffer_bytes", "gauge", "buffers de registro TLS em uso por conexao e sentido");
+  metricasLinha("forno_tls_buffer_bytes{conexao=\"blynk\",sentido=\"rx\"} %u\n", _blynkTransport.rxBufferSize());
+  metricasLinha("forno_tls_buffer_bytes{conexao=\"blynk\",sentido=\"tx\"} %u\n", _blynkTransport.txBufferSize());
+  metricasCabecalho("forno_tls_mfln", "gauge", "1 se o servidor aceitou o tamanho maximo de fragmento");
+  metricasLinha("forno_tls_mfln{conexao=\"blynk\"} %d\n", _blynkTransport.fragmentNegotiated() ? 1 : 0);
+}
+#endif
+
+#endif
@@ -0,0 +1,329 @@
+// Telemetria pelo modem celular (MODO_CELULAR), para fornos sem WiFi
+// As amostras viram lotes compactos (deltas em varint, veja
+// celularAmostrar) gravados na fila da flash (FilaLotes_PI2) assim que
+// fecham; a fila sai por uma conexão TCP que fica aberta, vários lotes por
+// CIPSEND, e só é apagada quando o servidor confirma. Sem sinal ou sem
+// servidor, os lotes esperam na flash.
+//
+// Com o WDT de hardware alimentado só no loop() (seguranca.ino), nada aqui
+// espera pelo modem: tudo vai pela fila de comandos AT assíncrona do
+// TinyGSM (queueAT/poll), um passo por volta do loop().
+//
+// Protocolo, little endian:
+//   forno -> servidor, ao conectar: "PI2L", tamanho do nome (u8), nome
+//   forno -> servidor: registros da fila, [tamanho u16][número u32][lote]
+//   servidor -> forno: número do último lote recebido (u32)
+// Depois de um reset o forno pode repetir lotes: o servidor descarta os
+// números que já tem.
+
+#if MODO_CELULAR
+
+#define CELULAR_AMOSTRA_MS      1000    // em corrida
+#define CELULAR_AMOSTRA_OCIOSO  60000   // forno parado
+#define CELULAR_LOTE_AMOSTRAS   60
+#define CELULAR_LOTE_MS         300000  // lote mais velho que isso fecha mesmo incompleto
+#define CELULAR_LOTE_MAX        512
+#define CELULAR_ENVIO_MAX       1024    // bytes por CIPSEND (até 1460)
+#define CELULAR_CONFIRMA_MS     20000   // sem confirmação, derruba e reconecta
+#define CELULAR_ESPERA_MS       10000   // depois de uma falha
+#define CELULAR_CAMPOS          6
+#define CELULAR_VERSAO_LOTE     1
+
+enum EstadoCelular {
+  CEL_PREPARANDO,   // registro na rede e contexto GPRS
+  CEL_CONECTANDO,
+  CEL_ONLINE,
+  CEL_ESPERA
+};
+
+SoftwareSerial celularSerial(modemRX, modemTX);
+TinyGsm modem(celularSerial);
+TinyGsmClient celularTcp(modem, 0);
+FilaLotes_PI2 fila;
+
+EstadoCelular celular_estado = CEL_ESPERA;
+uint8_t celular_passo = 0;
+bool celular_ocupado = false;     // comando da máquina de estados na fila AT
+bool celular_falhou = false;
+unsigned long celular_desde = 0;
+
+// lote em montagem
+uint8_t celular_lote[CELULAR_LOTE_MAX];
+size_t celular_tamanho = 0;
+uint8_t celular_amostras = 0;
+int32_t celular_anterior[CELULAR_CAMPOS];
+unsigned long celular_amostra = 0;
+unsigned long celular_inicio_lote = 0;
+
+// envio em voo: fica na fila da flash até a confirmação
+uint8_t celular_envio[CELULAR_ENVIO_MAX];
+size_t celular_enviado = 0;
+uint32_t celular_ultimo = 0;
+uint8_t celular_confirmacao[4];
+uint8_t celular_recebido = 0;
+
+#if MODO_MQTT
+// Socket 1 do modem para o MQTT na reserva (transporte_PI2). O connect()
+// do GsmClient espera até 75 s pelo CONNECT OK, e o WDT só é alimentado no
+// loop(): este pede o +CIPSTART pela fila AT e responde 0 até o modem
+// confirmar; o ClienteMqtt_PI2 tenta de novo em MQTT_ESPERA_MS e encontra
+// o socket aberto
+class ClienteCelular : public TinyGsmClient {
+ public:
+  ClienteCelular(TinyGsm& m) : TinyGsmClient(m, 1) {}
+  using TinyGsmClient::connect;
+
+  virtual int connect(const char* host, uint16_t porta){
+    if(pedido) return 0;
+    if(aberto){
+      aberto = false;
+      if(TinyGsmClient::connected()) return 1;
+    }
+    if(!celularGprs()) return 0;
+    if(modem.queueConnect(*this, host, porta, conectou, this)) pedido = true;
+    return 0;
+  }
+
+  static void conectou(void* ctx, uint8_t resultado, const char* linha){
+    if(resultado == TinyGsm::AT_LINE) return;
+    ClienteCelular* c = (ClienteCelular*)ctx;
+    c->pedido = false;
+    c->aberto = resultado == TinyGsm::AT_OK;
+  }
+
+  bool pedido = false;   // +CIPSTART na fila AT
+  bool aberto = false;   // e o modem respondeu CONNECT OK
+};
+#endif
+
+void celularIniciar(){
+  celularSerial.begin(CELULAR_BAUD);
+  if(!fila.iniciar(LittleFS)){
+    Serial.println("fila do celular indisponivel: lotes serao descartados");
+  }
+  celular_desde = millis() - CELULAR_ESPERA_MS;   // começa já
+}
+
+void celularAtender(){
+  modem.poll();
+  celularAmostrar();
+
+  if(celular_ocupado) return;   // espera a resposta de um passo
+  if(celular_falhou){
+    celular_falhou = false;
+    celularCair();
+    return;
+  }
+
+  switch(celular_estado){
+    case CEL_ESPERA:
+      if(millis() - celular_desde >= CELULAR_ESPERA_MS){
+        celular_estado = CEL_PREPARANDO;
+        celular_passo = 0;
+      }
+      break;
+    case CEL_PREPARANDO:
+      celularPreparar();
+      break;
+    case CEL_CONECTANDO:
+      if(modem.queueConnect(celularTcp, CELULAR_HOST, CELULAR_PORTA, celularResposta, NULL)){
+        celular_ocupado = true;
+        celular_estado = CEL_ONLINE;
+        celular_passo = 0;
+      }
+      break;
+    case CEL_ONLINE:
+      celularEnviar();
+      break;
+  }
+}
+
+// Um comando por vez; cada um só sai depois do OK do anterior
+void celularPreparar(){
+  TinyGsm::AtCommand* c = NULL;
+
+  switch(celular_passo){
+    case 0:  c = modem.queueAT(celularResposta, NULL, GF("E0")); break;
+    case 1:  c = modem.queueAT(celularRegistro, NULL, GF("+CREG?")); break;
+    case 2:
+      c = modem.queueAT(celularResposta, NULL, GF("+CIPSHUT"));
+      if(c){ c->ok = "SHUT OK"; c->timeout = 60000L; }
+      break;
+    case 3:
+      c = modem.queueAT(celularResposta, NULL, GF("+CGATT=1"));
+      if(c) c->timeout = 60000L;
+      break;
+    case 4:  c = modem.queueAT(celularResposta, NULL, GF("+CIPMUX=1")); break;
+    case 5:  c = modem.queueAT(celularResposta, NULL, GF("+CIPQSEND=1")); break;
+    case 6:  c = modem.queueAT(celularResposta, NULL, GF("+CIPRXGET=1")); break;
+    case 7:
+      c = modem.queueAT(celularResposta, NULL, GF("+CSTT=\""), CELULAR_APN,
+                        GF("\",\""), CELULAR_USUARIO, GF("\",\""), CELULAR_SENHA, GF("\""));
+      if(c) c->timeout = 60000L;
+      break;
+    case 8:
+      c = modem.queueAT(celularResposta, NULL, GF("+CIICR"));
+      if(c) c->timeout = 60000L;
+      break;
+    case 9:
+      // responde só o IP, sem OK; o E0 que vem junto fecha o comando
+      c = modem.queueAT(celularResposta, NULL, GF("+CIFSR;E0"));
+      if(c) c->timeout = 10000L;
+      break;
+    case 10: c = modem.queueAT(celularResposta, NULL, GF("+CDNSCFG=\"8.8.8.8\",\"8.8.4.4\"")); break;
+    default:
+      celular_estado = CEL_CONECTANDO;
+      return;
+  }
+  if(c){
+    celular_ocupado = true;
+    celular_passo++;
+  }
+}
+
+void celularResposta(void* ctx, uint8_t resultado, const char* linha){
+  if(resultado == TinyGsm::AT_LINE) return;
+  celular_ocupado = false;
+  if(resultado != TinyGsm::AT_OK) celular_falhou = true;
+}
+
+// "+CREG: 0,1" (em casa) ou "+CREG: 0,5" (roaming); fora disso tenta
+// de novo depois da espera
+void celularRegistro(void* ctx, uint8_t resultado, const char* linha){
+  static bool registrado = false;
+
+  if(resultado == TinyGsm::AT_LINE){
+    if(strncmp(linha, "+CREG:", 6) == 0){
+      const char* v = strchr(linha, ',');
+      registrado = v && (v[1] == '1' || v[1] == '5');
+    }
+    return;
+  }
+  celular_ocupado = false;
+  if(resultado != TinyGsm::AT_OK || !registrado) celular_falhou = true;
+  registrado = false;
+}
+
+// Contexto GPRS de pé: dá para abrir outros sockets no modem
+bool celularGprs(){
+  return celular_estado == CEL_CONECTANDO || celular_estado == CEL_ONLINE;
+}
+
+void celularCair(){
+  if(celular_estado == CEL_ONLINE){
+    modem.queueAT(NULL, NULL, GF("+CIPCLOSE=0,1"));   // rápido, sem esperar o servidor
+  }
+  celular_estado = CEL_ESPERA;
+  celular_desde = millis();
+  celular_enviado = 0;       // o lote em voo fica na fila e sai de novo
+  celular_recebido = 0;
+}
+
+void celularEnviar(){
+  // a conexão acabou de abrir: apresenta o forno
+  if(celular_passo == 0){
+    const char* nome = frotaNome();
+    size_t n = strlen(nome);
+    if(n > 255) n = 255;
+    memcpy(celular_envio, "PI2L", 4);
+    celular_envio[4] = n;
+    memcpy(celular_envio + 5, nome, n);
+    if(celularCipsend(5 + n)) celular_passo = 1;
+    return;
+  }
+
+  // espera a confirmação do que saiu
+  if(celular_enviado > 0){
+    while(celular_recebido < sizeof(celular_confirmacao) && celularTcp.available()){
+      int b = celularTcp.read();
+      if(b < 0) break;
+      celular_confirmacao[celular_recebido++] = b;
+    }
+    if(celular_recebido == sizeof(celular_confirmacao)){
+      uint32_t numero;
+      memcpy(&numero, celular_confirmacao, sizeof(numero));
+      celular_recebido = 0;
+      if(numero == celular_ultimo){
+        fila.confirmar(celular_enviado);
+        celular_enviado = 0;
+      }
+    } else if(millis() - celular_desde > CELULAR_CONFIRMA_MS){
+      celularCair();
+    }
+    return;
+  }
+
+  if(!celularTcp.connected()){   // o servidor fechou
+    celularCair();
+    return;
+  }
+  size_t n = fila.ler(celular_envio, sizeof(celular_envio), celular_ultimo);
+  if(n > 0 && celularCipsend(n)){
+    celular_enviado = n;
+    celular_desde = millis();
+  }
+}
+
+// O buffer vai como payload no prompt '>' e fica intacto até o callback
+bool celularCipsend(size_t n){
+  TinyGsm::AtCommand* c = modem.queueAT(celularResposta, NULL, GF("+CIPSEND=0,"), (uint16_t)n);
+  if(!c) return false;
+  c->payload = celular_envio;
+  c->length = n;
+  c->ok = "DATA ACCEPT:";
+  c->fail = "SEND FAIL";
+  c->timeout = 10000L;
+  celular_ocupado = true;
+  return true;
+}
+
+// Amostra a cada CELULAR_AMOSTRA_MS em corrida, CELULAR_AMOSTRA_OCIOSO
+// parado. Lote: versão (u8), millis da primeira amostra (u32), número de
+// amostras (u8) e, por amostra, a diferença para a anterior de cada campo
+// em zigzag varint: t_ms, temperatura (c°C), set point (d°C), potência,
+// desarme e corrida. Na primeira, t_ms é a diferença para o do cabeçalho
+// (zero) e os outros campos, o valor inteiro.
+void celularAmostrar(){
+  unsigned long intervalo = corridaAtiva() ? CELULAR_AMOSTRA_MS : CELULAR_AMOSTRA_OCIOSO;
+  if(celular_amostra != 0 && millis() - celular_amostra < intervalo) return;
+  celular_amostra = millis();
+
+  AmostraControle a;
+  telemetria.ler(a);
+  if(a.timestamp == 0) return;   // controle ainda não publicou
+
+  if(celular_amostras == 0){
+    celular_lote[0] = CELULAR_VERSAO_LOTE;
+    memcpy(celular_lote + 1, &a.timestamp, sizeof(a.timestamp));
+    celular_tamanho = 6;
+    memset(celular_anterior, 0, sizeof(celular_anterior));
+    celular_anterior[0] = (int32_t)a.timestamp;
+    celular_inicio_lote = millis();
+  }
+
+  int32_t v[CELULAR_CAMPOS] = {
+    (int32_t)a.timestamp,
+    isnan(a.rk) ? INT32_MIN : (int32_t)lroundf(a.rk * 100),
+    (int32_t)lroundf(a.set_point * 10),
+    a.controle_potencia,
+    a.desarme,
+    a.corrida
+  };
+  for(int i=0; i<CELULAR_CAMPOS; i++){
+    celular_tamanho += codificarVarint(celular_lote + celular_tamanho,
+                                       (int32_t)((uint32_t)v[i] - (uint32_t)celular_anterior[i]));
+    celular_anterior[i] = v[i];
+  }
+  celular_amostras++;
+  celular_lote[5] = celular_amostras;
+
+  // sempre sobra lugar para a pior amostra seguinte
+  if(celular_amostras >= CELULAR_LOTE_AMOSTRAS ||
+     celular_tamanho + CELULAR_CAMPOS*5 > sizeof(celular_lote) ||
+     millis() - celular_inicio_lote >= CELULAR_LOTE_MS){
+    fila.acrescentar(celular_lote, celular_tamanho);
+    celular_amostras = 0;
+  }
+}
+
+#endif
@@ -0,0 +1,45 @@
+// Configuração gravada na LittleFS por config.ino (veja handleConfig())
+
+  // guarda de inclusão
+#ifndef ConfigForno_h
+#define ConfigForno_h
+
+#include <perfil_PI2.h>
+#include <sensor_PI2.h>
+
+#define CONFIG_ARQUIVO_A "/config.a"   // duas cópias com sequência e CRC32 (CopiaDupla_PI2)
+#define CONFIG_ARQUIVO_B "/config.b"
+#define CONFIG_ARQUIVO_ANTIGO "/config.bin"   // cópia única de antes, lida se não houver as duas
+#define CONFIG_MAGICO  0x43324950UL   // "PI2C"
+#define CONFIG_VERSAO  6
+#define CONFIG_PERSONALIZADO 255      // perfil vindo de `segmentos`
+#define CONFIG_ZONAS   2              // calibrações guardadas, uma por termopar
+
+// Autenticação básica do POST /update (ota.ino). Vazia, a rota nem é
+// registrada: o servidor é HTTP e o MD5 só pega upload corrompido, então
+// sem senha qualquer um na rede gravaria firmware no forno. Defina uma
+// antes de gravar a placa para ter a atualização pela rede
+#ifndef OTA_SENHA
+#define OTA_USUARIO    "forno"
+#define OTA_SENHA      ""
+#endif
+
+struct ConfigForno {
+  uint32_t magico;
+  uint8_t versao;
+  uint8_t perfil;           // índice no catálogo ou CONFIG_PERSONALIZADO
+  uint8_t quantidade;       // segmentos do perfil personalizado
+  uint8_t reservado;
+  float kc, ki, kd;
+  float ff_ganho, ff_tau, ff_ambiente;   // ModeloTermico_PI2; ganho 0 desliga
+  uint16_t ts_ms;
+  int16_t inicial_dC;
+  SegmentoPerfil segmentos[PERFIL_MAX_SEGMENTOS];
+  uint8_t pares[CONFIG_ZONAS];           // 0: termopar sem calibração
+  ParCalibracao calibracao[CONFIG_ZONAS][CALIBRACAO_PARES];
+  uint16_t watts[CONFIG_ZONAS];          // potência nominal de cada resistência, para a energia
+  float rampa;                           // subida máxima da potência, %/s; 0 = sem limite
+  float est_tau;                         // s, atraso da leitura no EstimadorTermico_PI2
+};
+
+#endif
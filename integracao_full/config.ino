@@ -0,0 +1,435 @@
+// Configuração em tempo de execução: ganhos do PID, modelo da
+// alimentação direta e atraso da leitura do estimador, Ts, perfil, a
+// calibração dos termopares, a potência das resistências e a rampa de partida
+// GET /config devolve JSON; POST /config (formulário) valida tudo antes
+// de aplicar qualquer coisa e grava na LittleFS, em duas cópias (A/B)
+// com sequência e CRC32: uma queda de energia durante a gravação perde só
+// a cópia que estava sendo escrita.
+// Ganhos e modelo novos valem a partir da próxima execução de controle_pid(),
+// potência das resistências (só para a energia) e rampa na hora;
+// Ts, perfil e calibração só mudam com o forno parado. POST /perfil/upload troca o
+// perfil personalizado por uma lista de pontos (no fim deste arquivo).
+
+// ConfigForno e as constantes ficam em config.h: os protótipos que o
+// Arduino gera para este arquivo vão para o topo do sketch
+#if ZONAS > CONFIG_ZONAS
+#error "config.h guarda calibracao para CONFIG_ZONAS termopares"
+#endif
+
+ConfigForno config_atual;
+CopiaDupla_PI2 config_copias(CONFIG_ARQUIVO_A, CONFIG_ARQUIVO_B);
+volatile bool config_pendente = false;   // ganhos esperando controle_pid()
+
+// setup(): aplica a configuração gravada, se houver uma válida
+void configCarregar(){
+  config_atual.magico = CONFIG_MAGICO;
+  config_atual.versao = CONFIG_VERSAO;
+  config_atual.perfil = perfil.indice();
+  config_atual.quantidade = 0;
+  config_atual.kc = kc;
+  config_atual.ki = ki;
+  config_atual.kd = kd;
+  config_atual.ff_ganho = modelo.ganho();
+  config_atual.ff_tau = modelo.tau();
+  config_atual.ff_ambiente = modelo.ambiente();
+  config_atual.est_tau = ESTIMADOR_TAU_TERMOPAR_S;
+  config_atual.ts_ms = Ts;
+  config_atual.inicial_dC = 0;
+  memset(config_atual.pares, 0, sizeof(config_atual.pares));
+  for(uint8_t z=0; z<CONFIG_ZONAS; z++) config_atual.watts[z] = RESISTENCIA_W;
+  energiaConfigurar(config_atual.watts);
+  config_atual.rampa = PARTIDA_RAMPA;
+  disparo.definirRampa(config_atual.rampa);
+
+  // o CRC já pegou a gravação pela metade; a validação pega o resto
+  ConfigForno lida;
+  String erro;
+  bool dupla = config_copias.ler(LittleFS, &lida, sizeof(lida));
+  if(!dupla && !configLerAntiga(lida)) return;
+  if(lida.magico != CONFIG_MAGICO || lida.versao != CONFIG_VERSAO || !configValidar(lida, erro)){
+    Serial.println("config: gravada invalida, usando os valores do sketch");
+    return;
+  }
+  configAplicar(lida);
+  Serial.printf("config: carregada da flash (copia %c, sequencia %lu)\n",
+                dupla ? config_copias.atual() : '-', (unsigned long)config_copias.sequencia());
+}
+
+// Antes das duas cópias: um arquivo só, sem CRC. O próximo configSalvar()
+// passa para as cópias e o apaga
+bool configLerAntiga(ConfigForno& c){
+  File f = LittleFS.open(CONFIG_ARQUIVO_ANTIGO, "r");
+  if(!f) return false;
+  bool ok = f.read((uint8_t*)&c, sizeof(c)) == sizeof(c);
+  f.close();
+  return ok;
+}
+
+bool configValidar(const ConfigForno& c, String& erro){
+  if(!(c.kc >= 0 && c.kc < 1000) || !(c.ki >= 0 && c.ki < 1000) || !(c.kd >= 0 && c.kd < 10000)){
+    erro = "ganho fora da faixa";
+    return false;
+  }
+  if(!(c.ff_ganho >= 0 && c.ff_ganho < 100) || !(c.ff_tau >= 0 && c.ff_tau < 10000)
+     || !(c.ff_ambiente > -40 && c.ff_ambiente < 100) || !(c.est_tau > 0 && c.est_tau < 600)){
+    erro = "modelo fora da faixa";
+    return false;
+  }
+  if(!(c.rampa >= 0 && c.rampa <= 100)){
+    erro = "rampa deve estar entre 0 e 100 %/s";
+    return false;
+  }
+  if(c.ts_ms < 20 || c.ts_ms > 1000){
+    erro = "ts deve estar entre 20 e 1000 ms";
+    return false;
+  }
+  if(c.perfil == CONFIG_PERSONALIZADO){
+    if(c.quantidade == 0 || c.quantidade > PERFIL_MAX_SEGMENTOS){
+      erro = "quantidade de segmentos invalida";
+      return false;
+    }
+    for(uint8_t i=0; i<c.quantidade; i++){
+      const SegmentoPerfil& s = c.segmentos[i];
+      if(s.fase > FASE_RESFRIAMENTO || s.duracao_s == 0 || s.duracao_s > 3600
+         || s.temperatura_dC < 0 || s.temperatura_dC > 3500){
+        erro = "segmento " + String(i) + " invalido";
+        return false;
+      }
+    }
+  }
+  else if(c.perfil >= QUANTIDADE_PERFIS){
+    erro = "perfil invalido";
+    return false;
+  }
+  for(uint8_t z=0; z<CONFIG_ZONAS; z++){
+    if(c.watts[z] > 10000){
+      erro = "potencia da resistencia acima de 10000 W";
+      return false;
+    }
+    CalibracaoTermopar_PI2 teste;
+    if(c.pares[z] > CALIBRACAO_PARES || !teste.configurar(c.calibracao[z], c.pares[z])){
+      erro = "calibracao " + String(z) + " invalida";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Com o forno parado: Ts e perfil na hora, ganhos via controle_pid()
+void configAplicar(const ConfigForno& c){
+  if(c.perfil == CONFIG_PERSONALIZADO) perfil.carregar(c.segmentos, c.quantidade, c.inicial_dC);
+  else perfil.selecionar(c.perfil);
+
+  if(c.ts_ms != Ts){
+    Ts = c.ts_ms;
+#if !defined(ESP32)
+    timerControle.attach_ms(Ts, controle_pid);   // no ESP32 a tarefa de nucleos.ino lê Ts
+#endif
+  }
+  for(uint8_t z=0; z<ZONAS; z++) zonas[z].calibracao.configurar(c.calibracao[z], c.pares[z]);
+  configGanhos(c);
+  config_atual = c;
+}
+
+// Ganhos e modelo trocam juntos, entre duas execuções do controle
+void configGanhos(const ConfigForno& c){
+  config_atual.kc = c.kc;
+  config_atual.ki = c.ki;
+  config_atual.kd = c.kd;
+  config_atual.ff_ganho = c.ff_ganho;
+  config_atual.ff_tau = c.ff_tau;
+  config_atual.ff_ambiente = c.ff_ambiente;
+  config_atual.est_tau = c.est_tau;
+  memcpy(config_atual.watts, c.watts, sizeof(c.watts));
+  energiaConfigurar(c.watts);
+  config_atual.rampa = c.rampa;
+  disparo.definirRampa(c.rampa);
+  __sync_synchronize();
+  config_pendente = true;
+}
+
+// Chamada no início de controle_pid()
+void configAtualizarControle(){
+  if(!config_pendente) return;
+  kc = config_atual.kc;
+  ki = config_atual.ki;
+  kd = config_atual.kd;
+  for(uint8_t z=0; z<ZONAS; z++) zonas[z].pid.configurar(kc, ki, kd);
+  modelo.configurar(config_atual.ff_ganho, config_atual.ff_tau, config_atual.ff_ambiente);
+#if MODO_PREDITIVO
+  for(uint8_t z=0; z<ZONAS; z++) zonas[z].preditivo.configurar(modelo, PREDITIVO_PASSO_S, Ts / 1000.0, PREDITIVO_LAMBDA);
+#endif
+#if MODO_ESTIMADOR
+  for(uint8_t z=0; z<ZONAS; z++) zonas[z].estimador.configurar(modelo, Ts / 1000.0, config_atual.est_tau);
+#endif
+  config_pendente = false;
+}
+
+#if MODO_AMBIENTE
+// Logo depois de configAtualizarControle(): o modelo usa o ambiente medido
+// (ambiente.ino) e, sem ele, o ff_amb de /config, que continua o gravado
+void configAmbiente(){
+  float a = ambienteMedido();
+  if(isnan(a)) a = config_atual.ff_ambiente;
+  if(a == modelo.ambiente()) return;
+  modelo.definirAmbiente(a);
+#if MODO_PREDITIVO
+  for(uint8_t z=0; z<ZONAS; z++) zonas[z].preditivo.definirAmbiente(a);
+#endif
+#if MODO_ESTIMADOR
+  for(uint8_t z=0; z<ZONAS; z++) zonas[z].estimador.definirAmbiente(a);
+#endif
+}
+#endif
+
+// /perfil?id=N escolheu outro perfil do catálogo
+void configPerfilSelecionado(){
+  config_atual.perfil = perfil.indice();
+  config_atual.quantidade = 0;
+  configSalvar();
+}
+
+// Sobre a cópia mais velha: uma queda de energia no meio deixa a outra
+bool configSalvar(){
+  if(!config_copias.gravar(LittleFS, &config_atual, sizeof(config_atual))) return false;
+  if(LittleFS.exists(CONFIG_ARQUIVO_ANTIGO)) LittleFS.remove(CONFIG_ARQUIVO_ANTIGO);
+  return true;
+}
+
+// Argumento numérico opcional: falso só se presente e malformado
+bool configNumero(const char* nome, float& valor){
+  if(!server.hasArg(nome)) return true;
+  String texto = server.arg(nome);
+  char* fim;
+  float v = strtod(texto.c_str(), &fim);
+  if(fim == texto.c_str() || *fim != '\0' || v != v) return false;
+  valor = v;
+  return true;
+}
+
+// segmentos=fase,duracao_s,temperatura;fase,duracao_s,temperatura;...
+bool configSegmentos(const String& texto, ConfigForno& c){
+  const char* p = texto.c_str();
+  uint8_t n = 0;
+  while(*p){
+    if(n == PERFIL_MAX_SEGMENTOS) return false;
+    char* fim;
+    long fase = strtol(p, &fim, 10);
+    if(*fim != ',') return false;
+    long duracao = strtol(fim + 1, &fim, 10);
+    if(*fim != ',') return false;
+    float temperatura = strtod(fim + 1, &fim);
+    if(*fim != ';' && *fim != '\0') return false;
+
+    c.segmentos[n].fase = fase < 0 || fase > 255 ? 255 : fase;
+    c.segmentos[n].reservado = 0;
+    c.segmentos[n].duracao_s = duracao < 0 || duracao > 65535 ? 0 : duracao;
+    c.segmentos[n].temperatura_dC = lroundf(constrain(temperatura, -3000.0f, 3000.0f) * 10.0f);
+    n++;
+    p = *fim ? fim + 1 : fim;
+  }
+  c.quantidade = n;
+  return true;
+}
+
+// cal0=lido:referencia;lido:referencia;... em C, lido crescente; vazio apaga
+bool configCalibracao(const String& texto, ConfigForno& c, uint8_t z){
+  memset(c.calibracao[z], 0, sizeof(c.calibracao[z]));
+  const char* p = texto.c_str();
+  uint8_t n = 0;
+  while(*p){
+    if(n == CALIBRACAO_PARES) return false;
+    char* fim;
+    float lido = strtod(p, &fim);
+    if(fim == p || *fim != ':') return false;
+    p = fim + 1;
+    float referencia = strtod(p, &fim);
+    if(fim == p || (*fim != ';' && *fim != '\0')) return false;
+
+    c.calibracao[z][n].lido_dC = lroundf(constrain(lido, -3000.0f, 3000.0f) * 10.0f);
+    c.calibracao[z][n].referencia_dC = lroundf(constrain(referencia, -3000.0f, 3000.0f) * 10.0f);
+    n++;
+    p = *fim ? fim + 1 : fim;
+  }
+  c.pares[z] = n;
+  return true;
+}
+
+String configJson(){
+  const ConfigForno& c = config_atual;
+  String json = "{\"kc\":" + String(c.kc, 4) + ",\"ki\":" + String(c.ki, 4) + ",\"kd\":" + String(c.kd, 4);
+  json += ",\"ff_k\":" + String(c.ff_ganho, 4) + ",\"ff_tau\":" + String(c.ff_tau, 1)
+          + ",\"ff_amb\":" + String(c.ff_ambiente, 1) + ",\"est_tau\":" + String(c.est_tau, 1);
+  json += ",\"rampa\":" + String(c.rampa, 1);
+  json += ",\"ts\":" + String(c.ts_ms) + ",\"perfil\":" + String(c.perfil);
+  if(c.perfil == CONFIG_PERSONALIZADO){
+    json += ",\"inicial\":" + String(c.inicial_dC / 10.0, 1) + ",\"segmentos\":[";
+    for(uint8_t i=0; i<c.quantidade; i++){
+      if(i) json += ",";
+      json += "[" + String(c.segmentos[i].fase) + "," + String(c.segmentos[i].duracao_s) + ","
+              + String(c.segmentos[i].temperatura_dC / 10.0, 1) + "]";
+    }
+    json += "]";
+  }
+  json += ",\"w\":[";
+  for(uint8_t z=0; z<ZONAS; z++){
+    if(z) json += ",";
+    json += String(c.watts[z]);
+  }
+  json += "],\"cal\":[";
+  for(uint8_t z=0; z<ZONAS; z++){
+    json += z ? ",[" : "[";
+    for(uint8_t i=0; i<c.pares[z]; i++){
+      if(i) json += ",";
+      json += "[" + String(c.calibracao[z][i].lido_dC / 10.0, 1) + ","
+              + String(c.calibracao[z][i].referencia_dC / 10.0, 1) + "]";
+    }
+    json += "]";
+  }
+  json += "]}";
+  return json;
+}
+
+void handleConfig() {
+ if(server.method() == HTTP_POST){
+   ConfigForno nova = config_atual;
+   float ts = nova.ts_ms, p = nova.perfil, inicial = nova.inicial_dC / 10.0;
+   if(!configNumero("kc", nova.kc) || !configNumero("ki", nova.ki) || !configNumero("kd", nova.kd)
+      || !configNumero("ff_k", nova.ff_ganho) || !configNumero("ff_tau", nova.ff_tau)
+      || !configNumero("ff_amb", nova.ff_ambiente) || !configNumero("est_tau", nova.est_tau)
+      || !configNumero("ts", ts)
+      || !configNumero("perfil", p) || !configNumero("inicial", inicial)
+      || !configNumero("rampa", nova.rampa)){
+     server.send(400, "text/plain", "numero malformado");
+     return;
+   }
+   nova.ts_ms = ts < 0 || ts > 65535 ? 0 : (uint16_t)ts;
+   nova.perfil = p < 0 || p > 255 ? QUANTIDADE_PERFIS : (uint8_t)p;
+   nova.inicial_dC = lroundf(constrain(inicial, -3000.0f, 3000.0f) * 10.0f);
+   if(server.hasArg("segmentos")){
+     if(!configSegmentos(server.arg("segmentos"), nova)){
+       server.send(400, "text/plain", "segmentos malformados");
+       return;
+     }
+     nova.perfil = CONFIG_PERSONALIZADO;
+   }
+   for(uint8_t z=0; z<ZONAS; z++){
+     char nome[5] = { 'c', 'a', 'l', (char)('0' + z), 0 };
+     if(server.hasArg(nome) && !configCalibracao(server.arg(nome), nova, z)){
+       server.send(400, "text/plain", String(nome) + " malformada");
+       return;
+     }
+     char watts[3] = { 'w', (char)('0' + z), 0 };
+     float w = nova.watts[z];
+     if(!configNumero(watts, w)){
+       server.send(400, "text/plain", "numero malformado");
+       return;
+     }
+     nova.watts[z] = w < 0 || w > 65535 ? 65535 : (uint16_t)w;
+   }
+
+   String erro;
+   if(!configValidar(nova, erro)){
+     server.send(400, "text/plain", erro);
+     return;
+   }
+
+   bool soGanhos = nova.ts_ms == config_atual.ts_ms && nova.perfil == config_atual.perfil
+                 && nova.inicial_dC == config_atual.inicial_dC && nova.quantidade == config_atual.quantidade
+                 && memcmp(nova.segmentos, config_atual.segmentos, sizeof(nova.segmentos)) == 0
+                 && memcmp(nova.pares, config_atual.pares, sizeof(nova.pares)) == 0
+                 && memcmp(nova.calibracao, config_atual.calibracao, sizeof(nova.calibracao)) == 0;
+   if(corridaAtiva() && !soGanhos){
+     server.send(409, "text/plain", "ts, perfil e calibracao so mudam com o forno parado");
+     return;
+   }
+   if(corridaAtiva()) configGanhos(nova);
+   else configAplicar(nova);
+
+   if(!configSalvar()){
+     server.send(500, "text/plain", "falha ao gravar na flash");
+     return;
+   }
+ }
+ server.send(200, "application/json", configJson());
+}
+
+// POST /perfil/upload?tolerancia=C com os pontos em multipart, por exemplo
+//   curl -F "perfil=@perfil.csv" http://forno/perfil/upload
+// Cada pedaço do upload (HTTP_UPLOAD_BUFLEN bytes) passa direto pelo
+// LeitorPerfil_PI2, que guarda só os segmentos: centenas de pontos cabem
+// na mesma RAM de um perfil de poucos. No fim o perfil vira o
+// personalizado da configuração, validado e gravado como por /config.
+LeitorPerfil_PI2 perfil_leitor;
+bool perfil_recebido = false;        // houve upload nesta requisição
+const char* perfil_recusa = NULL;    // recusado antes de ler
+int perfil_codigo = 200;
+
+void configReceberPerfil(){
+  HTTPUpload& up = server.upload();
+
+  if(up.status == UPLOAD_FILE_START){
+    perfil_recebido = true;
+    perfil_recusa = NULL;
+    float tolerancia = LEITOR_TOLERANCIA_C;
+    if(!configNumero("tolerancia", tolerancia) || !(tolerancia > 0 && tolerancia <= 20)){
+      perfil_codigo = 400;
+      perfil_recusa = "tolerancia invalida";
+    }
+    else if(corridaAtiva()){
+      perfil_codigo = 409;
+      perfil_recusa = "forno em execucao";
+    }
+    perfil_leitor.iniciar(tolerancia);
+  }
+  else if(up.status == UPLOAD_FILE_WRITE){
+    if(!perfil_recusa) perfil_leitor.alimentar(up.buf, up.currentSize);
+  }
+  else if(up.status == UPLOAD_FILE_END){
+    if(!perfil_recusa) perfil_leitor.finalizar();
+  }
+  else if(up.status == UPLOAD_FILE_ABORTED){
+    perfil_codigo = 400;
+    perfil_recusa = "upload interrompido";
+  }
+}
+
+// Fim do POST /perfil/upload
+void handlePerfilUpload(){
+  bool recebido = perfil_recebido;
+  perfil_recebido = false;
+  if(!recebido){
+    server.send(400, "text/plain", "nenhum arquivo recebido (multipart)");
+    return;
+  }
+  if(perfil_recusa){
+    server.send(perfil_codigo, "text/plain", perfil_recusa);
+    return;
+  }
+  if(perfil_leitor.erro()){
+    server.send(400, "text/plain", String(perfil_leitor.erro()) + " (ponto " + String(perfil_leitor.registro()) + ")");
+    return;
+  }
+
+  ConfigForno nova = config_atual;
+  nova.perfil = CONFIG_PERSONALIZADO;
+  nova.quantidade = perfil_leitor.quantidade();
+  nova.inicial_dC = perfil_leitor.inicial_dC();
+  memcpy(nova.segmentos, perfil_leitor.segmentos(), nova.quantidade * sizeof(SegmentoPerfil));
+  String erro;
+  if(!configValidar(nova, erro)){
+    server.send(400, "text/plain", erro);
+    return;
+  }
+  if(corridaAtiva()){
+    server.send(409, "text/plain", "forno em execucao");
+    return;
+  }
+  configAplicar(nova);
+  if(!configSalvar()){
+    server.send(500, "text/plain", "falha ao gravar na flash");
+    return;
+  }
+  server.send(200, "application/json", "{\"pontos\":" + String(perfil_leitor.pontos())
+              + ",\"segmentos\":" + String(perfil_leitor.quantidade()) + ",\"config\":" + configJson() + "}");
+}
@@ -0,0 +1,22 @@
+// Estados de uma corrida do perfil (veja corrida.ino)
+
+  // guarda de inclusão
+#ifndef CorridaForno_h
+#define CorridaForno_h
+
+enum EstadoCorrida {
+  CORRIDA_OCIOSA = 0,       // nada rodando, triac desligado
+  CORRIDA_PREAQUECENDO,     // set point na temperatura inicial do perfil
+  CORRIDA_RODANDO,          // perfil avançando
+  CORRIDA_PAUSADA,          // relógio do perfil parado, set point mantido
+  CORRIDA_RESFRIANDO,       // perfil terminado, triac desligado, ainda gravando
+  CORRIDA_ABORTADA,         // interrompida por /abort
+  CORRIDA_FALHA             // interrompida pelo supervisor de segurança
+};
+
+#define CORRIDA_TOLERANCIA 5.0    // C abaixo da inicial para sair do preaquecimento
+#define CORRIDA_FRIA       50.0   // C: abaixo disso o resfriamento termina
+#define CORRIDA_FAIXA_C    5.0    // C: faixa de tolerância em torno do set point no painel
+#define CORRIDA_FALHAS_JSON 160   // bytes de corridaFalhasJson() com todas as falhas
+
+#endif
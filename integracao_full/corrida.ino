@@ -0,0 +1,243 @@
+// Máquina de estados da corrida
+// /start liga, /pause alterna pausa e /abort interrompe; o supervisor
+// leva a FALHA. Cada início zera o perfil, os PIDs, o histórico e abre
+// um novo registro, então lotes seguidos não precisam de reset.
+// As transições do perfil (preaquecido, terminou, esfriou) acontecem na
+// tarefa de controle; as dos endpoints, no loop().
+// A AnaliseCorrida_PI2 acompanha cada amostra registrada; o veredito sai
+// uma vez, no fim, como evento, em /run/summary e no fim do arquivo.
+
+const char* const NOMES_CORRIDA[] = {
+  "ociosa", "preaquecendo", "rodando", "pausada", "resfriando", "abortada", "falha"
+};
+
+EstadoCorrida corrida_retomar = CORRIDA_RODANDO;   // estado de antes da pausa
+
+const char* corridaNome(){
+  return NOMES_CORRIDA[corrida];
+}
+
+// PID regulando o forno
+bool corridaAquecendo(){
+  return corrida == CORRIDA_PREAQUECENDO || corrida == CORRIDA_RODANDO || corrida == CORRIDA_PAUSADA;
+}
+
+// Corrida em andamento, inclusive o resfriamento: grava registro e histórico
+bool corridaAtiva(){
+  return corridaAquecendo() || corrida == CORRIDA_RESFRIANDO;
+}
+
+bool corridaSintonizando(){
+  return sintonia.estado() == SINTONIA_RODANDO || ensaio.estado() == SINTONIA_RODANDO;
+}
+
+void corridaZerarControle(){
+  for(uint8_t z=0; z<ZONAS; z++){
+    zonas[z].uk = 0;
+    zonas[z].pid.reiniciar();
+    zonas[z].preditivo.reiniciar();
+    aplicarPotencia(z, 0);
+  }
+  uk = 0;
+  controle_potencia = 0;
+}
+
+// 0 se iniciou, senão o motivo para o 409
+const char* corridaIniciar(){
+  if(corridaAtiva()) return "corrida em andamento";
+  if(corridaSintonizando()) return "sintonia em andamento";
+  if(otaAtiva()) return "firmware sendo gravado";
+  if(!segurancaRearmar()) return "desarmado pelo supervisor";
+
+  perfil.iniciar();
+  t_perfil = 0;
+  array_perfil = 0;
+  set_point = perfil.inicial_dC() / 10.0;
+  corridaZerarControle();
+  historico.reiniciar();
+  historico_tempo = 0;
+  corrida_ms = 0;
+  registro.abrir(perfil.indice(), Ts, relogioUtc());
+  analise.iniciar(perfil.janela());
+  energiaCorridaIniciar();
+  float rampa = config_atual.rampa;
+  disparo.adiarRampa(frotaPartida(rampa > 0 ? lroundf(100000 / rampa) : 0));
+  corrida = CORRIDA_PREAQUECENDO;
+  return 0;
+}
+
+void corridaAbortar(){
+  if(!corridaAtiva()) return;
+  corrida = CORRIDA_ABORTADA;
+  corridaZerarControle();
+}
+
+// Alterna: pausada volta ao estado de antes
+bool corridaPausar(){
+  if(corrida == CORRIDA_PAUSADA){
+    corrida = corrida_retomar;
+    return true;
+  }
+  if(corrida != CORRIDA_PREAQUECENDO && corrida != CORRIDA_RODANDO) return false;
+  corrida_retomar = corrida;
+  corrida = CORRIDA_PAUSADA;
+  return true;
+}
+
+void corridaFalha(){
+  if(corridaAtiva()) corrida = CORRIDA_FALHA;
+}
+
+// Tarefa de controle, antes do PID: avança o perfil e faz as transições
+// que dependem da temperatura
+void corridaPasso(){
+  switch(corrida){
+    case CORRIDA_PREAQUECENDO:
+      set_point = perfil.inicial_dC() / 10.0;
+      if(rk >= set_point - CORRIDA_TOLERANCIA) corrida = CORRIDA_RODANDO;
+      break;
+    case CORRIDA_RODANDO:
+      perfil_reflow();
+      if(perfil.terminado()) corrida = CORRIDA_RESFRIANDO;
+      break;
+    case CORRIDA_RESFRIANDO:
+      if(rk < CORRIDA_FRIA) corrida = CORRIDA_OCIOSA;
+      break;
+    default:
+      break;
+  }
+}
+
+// Primeiro período sem corrida ativa (ou o abortar, no loop()): só a
+// corrida que esfriou pelo perfil é completa
+void corridaEncerrarAnalise(){
+  if(corridaAtiva() || !analise.ativa()) return;
+  analise.finalizar(corrida == CORRIDA_OCIOSA);
+  ResumoCorrida r;
+  analise.ler(r);
+  eventoPostar(EVENTO_VEREDITO, r.falhas);
+}
+
+// loop(): fecha o arquivo com o resumo no fim
+void corridaFecharRegistro(){
+  corridaEncerrarAnalise();
+  ResumoCorrida r;
+  analise.ler(r);
+  RegistroResumo g;
+  memset(&g, 0, sizeof(g));
+  g.pico_dC = (int16_t)lroundf(r.pico * 10);
+  g.tal_ds = (uint16_t)lroundf(r.tal_s * 10);
+  g.patamar_ds = (uint16_t)lroundf(r.patamar_s * 10);
+  g.subida_dCs = (uint8_t)constrain(lroundf(r.subidaMax * 10), 0L, 255L);
+  g.descida_dCs = (uint8_t)constrain(lroundf(r.descidaMax * 10), 0L, 255L);
+  g.falhas = r.falhas;
+  registro.fechar(&g);
+#if MODO_BLYNK
+  blynkResumo(r);
+#endif
+  energiaSalvar();
+}
+
+const char* const NOMES_FALHA[] = {
+  "pico_baixo", "pico_alto", "tal_curto", "tal_longo", "patamar_curto", "patamar_longo",
+  "subida", "descida", "incompleta"
+};
+
+// ["pico_baixo","subida",...] em destino, de CORRIDA_FALHAS_JSON bytes
+const char* corridaFalhasJson(uint16_t falhas, char* destino, size_t tamanho){
+  size_t n = snprintf(destino, tamanho, "[");
+  for(uint8_t i=0; i<sizeof(NOMES_FALHA)/sizeof(NOMES_FALHA[0]) && n < tamanho; i++){
+    if(!(falhas & (1 << i))) continue;
+    n += snprintf(destino + n, tamanho - n, "%s\"%s\"", n > 1 ? "," : "", NOMES_FALHA[i]);
+  }
+  if(n < tamanho) snprintf(destino + n, tamanho - n, "]");
+  return destino;
+}
+
+// GET /run/summary: a corrida atual (parcial) ou a última; n=N: o resumo
+// gravado no arquivo da corrida N
+void handleRunSummary(){
+  server.sendHeader("Cache-Control", "no-store");
+  if(server.hasArg("n")){
+    uint16_t n = (uint16_t)strtoul(server.arg("n").c_str(), NULL, 10);
+    RegistroResumo g;
+    if(!registro.resumo(n, g)){
+      server.send(404, "text/plain", "corrida sem resumo");
+      return;
+    }
+    char falhas[CORRIDA_FALHAS_JSON];
+    enviarFormatado(200, "application/json",
+                    formatarResposta(server, "{\"corrida\":%u,\"finalizada\":true,\"aprovada\":%s,\"falhas\":%s"
+                                     ",\"pico_C\":%.1f,\"tal_s\":%.1f,\"patamar_s\":%.1f,\"subida_max_Cs\":%.1f"
+                                     ",\"descida_max_Cs\":%.1f}",
+                                     (unsigned)n, g.falhas ? "false" : "true", corridaFalhasJson(g.falhas, falhas, sizeof(falhas)),
+                                     g.pico_dC / 10.0, g.tal_ds / 10.0, g.patamar_ds / 10.0,
+                                     g.subida_dCs / 10.0, g.descida_dCs / 10.0));
+    return;
+  }
+
+  ResumoCorrida r;
+  analise.ler(r);
+  const JanelaProcesso& j = analise.janela();
+  char falhas[CORRIDA_FALHAS_JSON];
+  const char* janela = formatarResposta(server, "{\"liquidus_C\":%.1f,\"pico_C\":[%.1f,%.1f],\"tal_s\":[%u,%u]"
+                                        ",\"patamar_C\":[%.1f,%.1f],\"patamar_s\":[%u,%u],\"subida_max_Cs\":%.1f"
+                                        ",\"descida_max_Cs\":%.1f}",
+                                        j.liquidus_dC / 10.0, j.picoMin_dC / 10.0, j.picoMax_dC / 10.0,
+                                        (unsigned)j.talMin_s, (unsigned)j.talMax_s,
+                                        j.patamarMin_dC / 10.0, j.patamarMax_dC / 10.0,
+                                        (unsigned)j.patamarMin_s, (unsigned)j.patamarMax_s,
+                                        j.subidaMax_dCs / 10.0, j.descidaMax_dCs / 10.0);
+  enviarFormatado(200, "application/json", !janela ? NULL :
+                  formatarResposta(server, "{\"corrida\":%u,\"finalizada\":%s,\"aprovada\":%s,\"falhas\":%s"
+                                   ",\"pico_C\":%.1f,\"tal_s\":%.1f,\"patamar_s\":%.1f,\"subida_max_Cs\":%.2f"
+                                   ",\"descida_max_Cs\":%.2f,\"duracao_s\":%.1f,\"energia_Wh\":%.1f,\"janela\":%s}",
+                                   (unsigned)registro.corrida(), r.finalizada ? "true" : "false",
+                                   r.finalizada && !r.falhas ? "true" : "false",
+                                   corridaFalhasJson(r.falhas, falhas, sizeof(falhas)),
+                                   r.pico, r.tal_s, r.patamar_s, r.subidaMax, r.descidaMax,
+                                   r.duracao_ms / 1000.0, energiaCorridaWh(), janela));
+}
+
+// Na arena do pedido: só para os tratadores
+const char* corridaJson(){
+#if MODO_PORTA
+  const char* porta = formatarResposta(server, ",\"porta\":%.0f", portaAbertura());
+#else
+  const char* porta = "";
+#endif
+  return formatarResposta(server, "{\"estado\":\"%s\",\"codigo\":%d,\"tempo_s\":%d,\"segmento\":%d"
+                          ",\"set_point\":%.1f,\"desarme\":%u,\"energia_Wh\":%.1f%s}",
+                          corridaNome(), (int)corrida, t_perfil, array_perfil, set_point,
+                          (unsigned)segurancaMotivo(), energiaCorridaWh(), porta ? porta : "");
+}
+
+// POST /start: GET devolve o estado, como /run
+void handleStart(){
+  if(server.method() == HTTP_POST){
+    const char* erro = corridaIniciar();
+    if(erro){
+      server.send(409, "text/plain", erro);
+      return;
+    }
+  }
+  enviarFormatado(200, "application/json", corridaJson());
+}
+
+void handleAbort(){
+  if(server.method() == HTTP_POST) corridaAbortar();
+  enviarFormatado(200, "application/json", corridaJson());
+}
+
+void handlePause(){
+  if(server.method() == HTTP_POST && !corridaPausar()){
+    server.send(409, "text/plain", "nada para pausar");
+    return;
+  }
+  enviarFormatado(200, "application/json", corridaJson());
+}
+
+void handleRun(){
+  server.sendHeader("Cache-Control", "no-store");
+  enviarFormatado(200, "application/json", corridaJson());
+}
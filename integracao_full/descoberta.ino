@@ -0,0 +1,52 @@
+// Anúncio por mDNS/DNS-SD (descoberta.ino)
+// Cada forno responde por <frotaNome()>.local e anuncia _http._tcp e
+// _oven._tcp na porta 80. O TXT do _oven traz a versão do firmware, o
+// estado da corrida e onde está a telemetria ao vivo (o WebSocket de
+// websocket.ino, o SSE em /events): um coletor acha os fornos da rede e
+// se liga direto ao fluxo, sem IP configurado nem varredura. Uma mudança
+// de estado da corrida troca o TXT e sai num anúncio novo.
+// Começa na primeira conexão; o respondedor segue as reconexões sozinho.
+
+#define DESCOBERTA_ESPERA_MS 10000   // entre tentativas de MDNS.begin()
+
+bool descoberta_ativa = false;
+unsigned long descoberta_tentativa = 0;   // millis() da última falha; 0 = tenta já
+const char* descoberta_estado = NULL;     // o último anunciado
+
+void descobertaIniciar(){
+  MDNS.addService("http", "tcp", 80);
+  MDNS.addService("oven", "tcp", 80);
+  char porta[8];
+  snprintf(porta, sizeof(porta), "%u", wsPorta());
+  MDNS.addServiceTxt("oven", "tcp", "versao", FIRMWARE_VERSAO);
+  MDNS.addServiceTxt("oven", "tcp", "ws_porta", porta);
+  MDNS.addServiceTxt("oven", "tcp", "ws_caminho", "/");
+  MDNS.addServiceTxt("oven", "tcp", "sse", "/events");
+  descoberta_estado = corridaNome();
+  MDNS.addServiceTxt("oven", "tcp", "estado", descoberta_estado);
+}
+
+// laco()
+void descobertaAtender(){
+  if(!descoberta_ativa){
+    if(!redeConectada()) return;
+    if(descoberta_tentativa && millis() - descoberta_tentativa < DESCOBERTA_ESPERA_MS) return;
+    if(!MDNS.begin(frotaNome())){
+      descoberta_tentativa = millis() | 1;
+      return;
+    }
+    descobertaIniciar();
+    descoberta_ativa = true;
+    Serial.print("mDNS: ");
+    Serial.print(frotaNome());
+    Serial.println(".local");
+  }
+
+  mdnsAtender();
+  const char* estado = corridaNome();
+  if(estado != descoberta_estado){
+    descoberta_estado = estado;
+    MDNS.addServiceTxt("oven", "tcp", "estado", estado);   // substitui o valor
+    mdnsAnunciar();
+  }
+}
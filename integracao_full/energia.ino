@@ -0,0 +1,55 @@
+// Energia das resistências (energia.ino)
+// MedidorEnergia_PI2 soma, em angle(), a potência nominal de cada zona
+// (w0/w1 em /config) vezes o tempo conduzido em cada semiciclo, com o
+// período medido da rede. A corrida guarda o total no início; o total da
+// vida do forno é o que ENERGIA_ARQUIVO traz do boot anterior mais o
+// medido desde o boot, gravado no fim de cada corrida (fora delas o
+// forno não aquece, a não ser por /autotune e /steptest).
+
+#define ENERGIA_ARQUIVO "/energia.bin"
+
+uint64_t energia_gravada_uJ = 0;   // vida do forno até este boot
+uint64_t energia_inicio_uJ = 0;    // microjoules() no início da corrida
+uint64_t energia_corrida_uJ = 0;   // da corrida atual ou da última
+
+// setup(), com a LittleFS montada
+void energiaIniciar(){
+  File f = LittleFS.open(ENERGIA_ARQUIVO, "r");
+  if(!f) return;
+  if(f.read((uint8_t*)&energia_gravada_uJ, sizeof(energia_gravada_uJ)) != sizeof(energia_gravada_uJ)){
+    energia_gravada_uJ = 0;
+  }
+  f.close();
+}
+
+void energiaConfigurar(const uint16_t* watts){
+  for(uint8_t z=0; z<ZONAS; z++) energia.configurar(z, watts[z]);
+}
+
+void energiaCorridaIniciar(){
+  energia_inicio_uJ = energia.microjoules();
+  energia_corrida_uJ = 0;
+}
+
+// Tarefa de controle: a da corrida para de contar com o fim dela
+void energiaAtualizar(){
+  if(corridaAtiva()) energia_corrida_uJ = energia.microjoules() - energia_inicio_uJ;
+}
+
+float energiaCorridaWh(){
+  return MedidorEnergia_PI2::wattsHora(energia_corrida_uJ);
+}
+
+uint64_t energiaTotal(){
+  return energia_gravada_uJ + energia.microjoules();
+}
+
+// loop(), no fim da corrida; temporário e renomeia
+void energiaSalvar(){
+  uint64_t total = energiaTotal();
+  File f = LittleFS.open(ENERGIA_ARQUIVO ".tmp", "w");
+  if(!f) return;
+  bool ok = f.write((const uint8_t*)&total, sizeof(total)) == sizeof(total);
+  f.close();
+  if(ok) LittleFS.rename(ENERGIA_ARQUIVO ".tmp", ENERGIA_ARQUIVO);
+}
@@ -0,0 +1,114 @@
+// Eventos detectados no forno e empurrados para os clientes
+// A tarefa de controle compara o estado com o da amostra anterior e só
+// posta numa fila própria, separada da de trabalhos: os 10 ms do sensor
+// enchendo aquela não derrubam um desarme. O loop() formata um JSON por
+// evento e envia a todos os inscritos do WebSocket (e ao Blynk, se
+// MODO_BLYNK). Cada evento é detectado uma vez aqui, não em cada navegador.
+//
+// Quadro: {"evento":"<nome>","codigo":N,"valor":V,"t_ms":T}, com T o
+// millis() de quando o evento foi detectado, não o do envio
+
+#define EVENTO_CORRIDA   1    // valor = novo EstadoCorrida
+#define EVENTO_FASE      2    // valor = nova FasePerfil
+#define EVENTO_PICO      3    // valor = temperatura ao atingir o pico
+#define EVENTO_PORTA     4    // abrir a porta: começou o resfriamento; valor = temperatura
+#define EVENTO_DESARME   5    // valor = MotivoDesarme
+#define EVENTO_SENSOR    6    // valor = 1 termopar aberto, 0 voltou
+#define EVENTO_VEREDITO  7    // fim da corrida; valor = bits ANALISE_*, 0 = aprovada
+#define EVENTO_FILA      8    // fila de lotes (fila.ino); valor = placas que faltam, -1 = pausada
+
+#define EVENTO_PICO_MARGEM 2.0   // C abaixo do maior set point do perfil
+
+const char* const NOMES_EVENTO[] = { "", "corrida", "fase", "pico", "porta", "desarme", "sensor", "veredito", "fila" };
+
+uint8_t evento_corrida = CORRIDA_OCIOSA;
+uint8_t evento_fase = 0xFF;        // nenhuma até a corrida rodar
+uint8_t evento_desarme = DESARME_NENHUM;
+bool evento_sensor = false;
+bool evento_pico = false;          // já avisado nesta corrida
+float evento_pico_alvo = 0;
+
+FilaTrabalho_PI2 eventos_fila;     // descartados() vai para /metrics
+
+// Tarefa de controle: valor vai em centésimos no Trabalho e os 16 bits
+// de baixo do millis() da detecção no extra; o loop() drena a fila a cada
+// volta, muito antes de 65 s, e reconstrói o instante completo
+void eventoPostar(uint8_t codigo, float valor){
+  eventos_fila.postar(TRABALHO_EVENTO, (uint32_t)(int32_t)lroundf(valor * 100), codigo, (uint16_t)millis());
+}
+
+// loop(): até um lote por volta, logo depois dos trabalhos
+void eventosAtender(){
+  eventos_fila.drenar(eventoEnviar, ORCAMENTO_TRABALHOS_US);
+}
+
+float eventoMaiorSetPoint(){
+  int16_t maior = perfil.inicial_dC();
+  const SegmentoPerfil* seg = perfil.segmentos();
+  for(uint8_t i=0; i<perfil.quantidade(); i++){
+    if(seg[i].temperatura_dC > maior) maior = seg[i].temperatura_dC;
+  }
+  return maior / 10.0;
+}
+
+// Chamado no fim de cada período de controle
+void eventosDetectar(){
+  if(corrida != evento_corrida){
+    if(corrida == CORRIDA_PREAQUECENDO && !(evento_corrida == CORRIDA_PAUSADA)){
+      evento_pico = false;
+      evento_fase = 0xFF;
+      evento_pico_alvo = eventoMaiorSetPoint() - EVENTO_PICO_MARGEM;
+    }
+    if(corrida == CORRIDA_RESFRIANDO) eventoPostar(EVENTO_PORTA, rk);
+    evento_corrida = corrida;
+    eventoPostar(EVENTO_CORRIDA, corrida);
+  }
+
+  if(corrida == CORRIDA_RODANDO && perfil.fase() != evento_fase){
+    evento_fase = perfil.fase();
+    eventoPostar(EVENTO_FASE, evento_fase);
+    // o resfriamento do perfil também é hora de abrir a porta
+    if(evento_fase == FASE_RESFRIAMENTO) eventoPostar(EVENTO_PORTA, rk);
+  }
+
+  if(corridaAquecendo() && !evento_pico && rk >= evento_pico_alvo){
+    evento_pico = true;
+    eventoPostar(EVENTO_PICO, rk);
+  }
+
+  uint8_t desarme = segurancaMotivo();
+  if(desarme != evento_desarme){
+    evento_desarme = desarme;
+    if(desarme != DESARME_NENHUM) eventoPostar(EVENTO_DESARME, desarme);
+  }
+
+  if(falha_sensor != evento_sensor){
+    evento_sensor = falha_sensor;
+    eventoPostar(EVENTO_SENSOR, falha_sensor ? 1 : 0);
+  }
+}
+
+// loop(): o evento chega pela fila de eventos
+void eventoEnviar(const Trabalho& t){
+  if(t.arg == 0 || t.arg > EVENTO_FILA) return;
+
+  float valor = (int32_t)t.valor / 100.0;
+  uint32_t agora = millis();
+  uint16_t idade = (uint16_t)agora - t.extra;
+  uint64_t utc_us = relogioUtc();
+  if(utc_us) utc_us -= (uint64_t)idade * 1000;   // de volta à detecção
+  char utc[24];
+  relogioTexto(utc, sizeof(utc), utc_us);
+  char json[128];
+  snprintf(json, sizeof(json), "{\"evento\":\"%s\",\"codigo\":%u,\"valor\":%.2f,\"t_ms\":%lu,\"utc\":%s}",
+           NOMES_EVENTO[t.arg], (unsigned)t.arg, valor, (unsigned long)(agora - idade), utc);
+  wsEnviarTodos(json);
+  sseEnviarTodos("evento", json);
+
+#if MODO_BLYNK
+  if(t.arg == EVENTO_PORTA || t.arg == EVENTO_DESARME || t.arg == EVENTO_PICO
+     || t.arg == EVENTO_VEREDITO || t.arg == EVENTO_FILA){
+    Blynk.notify(json);
+  }
+#endif
+}
@@ -0,0 +1,236 @@
+// Fila de lotes (fila.ino)
+// Uma lista ordenada de lotes (perfil, número de placas, notas) que o forno
+// roda sem ninguém apertar "Iniciar": cada corrida começa sozinha quando a
+// câmara está abaixo de FILA_FRIA e a porta, aberta depois da corrida
+// anterior (a troca da placa), está fechada há FILA_FECHADA_MS. A porta é
+// lida por um reed no A0; com MODO_PORTA o servo também precisa estar
+// fechado. Abortada, desarme ou veredito reprovado pausam a fila até um
+// POST /queue?retomar=1. Roda no laco(), como o /start; a fila fica na
+// LittleFS e sobrevive a um reinício, mas só anda depois da porta abrir.
+//
+// GET /queue: estado e lotes; POST /queue?placas=N[&perfil=I][&notas=T]
+// acrescenta (perfil padrão: o ativo; 255 = o personalizado de /config),
+// POST /queue?remover=I tira o lote I, POST /queue?retomar=1 tira a pausa.
+
+#if MODO_FILA
+
+#define FILA_ARQUIVO "/fila.bin"
+#define FILA_MAGICO 0x46324950UL   // "PI2F"
+#define FILA_LOTES 8
+#define FILA_NOTAS 48
+#define FILA_LEITURA_MS 200        // o analogRead() frequente derruba o WiFi do ESP8266
+#define FILA_REED_LIMIAR 512       // reed fechado puxa o A0 para perto de 0
+
+struct LoteFila {
+  uint8_t perfil;                  // índice no catálogo ou CONFIG_PERSONALIZADO
+  uint8_t placas;
+  uint8_t feitas;
+  uint8_t reservado;
+  char notas[FILA_NOTAS];
+};
+
+struct ArquivoFila {
+  uint32_t magico;
+  uint8_t quantidade;
+  uint8_t pausada;
+  uint8_t reservado[2];
+  LoteFila lotes[FILA_LOTES];
+};
+
+ArquivoFila fila;
+const char* fila_motivo = "";      // por que está pausada
+bool fila_iniciada = false;        // a corrida atual saiu da fila
+bool fila_porta_abriu = false;     // troca de placa desde a última corrida
+bool fila_porta_fechada = false;
+uint32_t fila_fechada_desde = 0;
+uint32_t fila_leitura = 0;
+uint32_t fila_corridas = 0;
+
+// setup(), depois do LittleFS
+void filaIniciar(){
+  memset(&fila, 0, sizeof(fila));
+  File f = LittleFS.open(FILA_ARQUIVO, "r");
+  if(f){
+    if(f.read((uint8_t*)&fila, sizeof(fila)) != sizeof(fila) || fila.magico != FILA_MAGICO
+       || fila.quantidade > FILA_LOTES){
+      memset(&fila, 0, sizeof(fila));
+    }
+    f.close();
+  }
+  fila.magico = FILA_MAGICO;
+  if(fila.pausada) fila_motivo = "reiniciado";
+}
+
+void filaSalvar(){
+  File f = LittleFS.open(FILA_ARQUIVO ".tmp", "w");
+  if(!f) return;
+  bool ok = f.write((const uint8_t*)&fila, sizeof(fila)) == sizeof(fila);
+  f.close();
+  if(ok) LittleFS.rename(FILA_ARQUIVO ".tmp", FILA_ARQUIVO);
+}
+
+void filaPausar(const char* motivo){
+  fila.pausada = 1;
+  fila_motivo = motivo;
+  filaSalvar();
+  eventoPostar(EVENTO_FILA, -1);
+}
+
+void filaRemover(uint8_t i){
+  memmove(&fila.lotes[i], &fila.lotes[i + 1], (fila.quantidade - i - 1) * sizeof(LoteFila));
+  fila.quantidade--;
+}
+
+void filaLerPorta(){
+  bool fechada = analogRead(filaPorta) < FILA_REED_LIMIAR;
+#if MODO_PORTA
+  fechada = fechada && portaAbertura() < 1;
+#endif
+  if(fechada && !fila_porta_fechada) fila_fechada_desde = millis();
+  if(!fechada && !corridaAtiva()) fila_porta_abriu = true;   // o servo abre no resfriamento
+  fila_porta_fechada = fechada;
+}
+
+uint16_t filaFaltam(){
+  uint16_t faltam = 0;
+  for(uint8_t i=0; i<fila.quantidade; i++) faltam += fila.lotes[i].placas - fila.lotes[i].feitas;
+  return faltam;
+}
+
+// A corrida da fila acabou e a análise já fechou
+void filaFimCorrida(){
+  ResumoCorrida r;
+  analise.ler(r);
+  LoteFila& l = fila.lotes[0];
+  if(corrida != CORRIDA_OCIOSA){
+    filaPausar(corrida == CORRIDA_FALHA ? "desarme" : "abortada");
+    return;
+  }
+  fila_corridas++;
+  if(++l.feitas >= l.placas) filaRemover(0);
+  if(r.falhas){
+    filaPausar("veredito reprovado");   // a placa conta, mas alguém precisa olhar
+    return;
+  }
+  filaSalvar();
+  eventoPostar(EVENTO_FILA, filaFaltam());
+}
+
+// laco()
+void filaAtender(){
+  if(millis() - fila_leitura >= FILA_LEITURA_MS){
+    fila_leitura = millis();
+    filaLerPorta();
+  }
+
+  if(fila_iniciada){
+    if(corridaAtiva() || analise.ativa()) return;
+    fila_iniciada = false;
+    filaFimCorrida();
+    return;
+  }
+
+  if(fila.pausada || fila.quantidade == 0 || corridaAtiva() || corridaSintonizando()) return;
+  if(falha_sensor || !zonasValidas() || rk >= FILA_FRIA) return;
+  if(!fila_porta_abriu || !fila_porta_fechada || millis() - fila_fechada_desde < FILA_FECHADA_MS) return;
+
+  LoteFila& l = fila.lotes[0];
+  if(l.perfil != perfil.indice()){
+    if(l.perfil == CONFIG_PERSONALIZADO || !perfil.selecionar(l.perfil)){
+      filaPausar("perfil indisponivel");   // o personalizado foi trocado por outro
+      return;
+    }
+    configPerfilSelecionado();
+  }
+  const char* erro = corridaIniciar();
+  if(erro){
+    filaPausar(erro);
+    return;
+  }
+  fila_iniciada = true;
+  fila_porta_abriu = false;
+}
+
+// Texto livre vai para o JSON: aspas, barra e controles viram espaço
+void filaNotas(char* destino, const String& texto){
+  size_t n = 0;
+  for(; n < FILA_NOTAS - 1 && n < texto.length(); n++){
+    char c = texto[n];
+    destino[n] = (c == '"' || c == '\\' || (uint8_t)c < 0x20) ? ' ' : c;
+  }
+  destino[n] = '\0';
+}
+
+// Estado e lotes da fila, um pedaço por lote: com notas cheias os oito
+// lotes passam da arena de formatarResposta()
+void filaEnviar(){
+  const char* estado = fila.pausada ? "pausada" : fila_iniciada ? "rodando" : fila.quantidade ? "esperando" : "vazia";
+  char json[96 + FILA_NOTAS];
+  snprintf(json, sizeof(json),
+           "{\"estado\":\"%s\",\"motivo\":\"%s\",\"porta_fechada\":%s,\"porta_trocada\":%s"
+           ",\"fria_C\":%.1f,\"lotes\":[",
+           estado, fila.pausada ? fila_motivo : "", fila_porta_fechada ? "true" : "false",
+           fila_porta_abriu ? "true" : "false", (double)FILA_FRIA);
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+  server.sendContent(json);
+  for(uint8_t i=0; i<fila.quantidade; i++){
+    const LoteFila& l = fila.lotes[i];
+    snprintf(json, sizeof(json), "%s{\"perfil\":%u,\"placas\":%u,\"feitas\":%u,\"notas\":\"%s\"}",
+             i ? "," : "", l.perfil, l.placas, l.feitas, l.notas);
+    server.sendContent(json);
+  }
+  server.sendContent("]}");
+  server.sendContent("");
+}
+
+void handleQueue(){
+  if(server.method() == HTTP_POST){
+    if(server.hasArg("retomar")){
+      fila.pausada = 0;
+      fila_porta_abriu = true;          // quem retoma já olhou o forno
+    }
+    else if(server.hasArg("remover")){
+      long i = server.arg("remover").toInt();
+      if(i < 0 || i >= fila.quantidade || (i == 0 && fila_iniciada)){
+        server.send(409, "text/plain", "lote inexistente ou rodando");
+        return;
+      }
+      filaRemover(i);
+    }
+    else {
+      long placas = server.arg("placas").toInt();
+      long indice = server.hasArg("perfil") ? server.arg("perfil").toInt() : perfil.indice();
+      if(placas < 1 || placas > 255
+         || !(indice == CONFIG_PERSONALIZADO || (indice >= 0 && indice < QUANTIDADE_PERFIS))){
+        server.send(400, "text/plain", "placas 1-255 e perfil do catalogo ou 255");
+        return;
+      }
+      if(fila.quantidade == FILA_LOTES){
+        server.send(409, "text/plain", "fila cheia");
+        return;
+      }
+      if(fila.quantidade == 0) fila_porta_abriu = true;   // a primeira placa já está no forno
+      LoteFila& l = fila.lotes[fila.quantidade++];
+      memset(&l, 0, sizeof(l));
+      l.perfil = indice;
+      l.placas = placas;
+      filaNotas(l.notas, server.arg("notas"));
+    }
+    filaSalvar();
+  }
+  server.sendHeader("Cache-Control", "no-store");
+  filaEnviar();
+}
+
+// handleMetrics()
+void filaMetricas(){
+  metricasCabecalho("forno_fila_placas", "gauge", "placas que faltam na fila de lotes");
+  metricasLinha("forno_fila_placas %u\n", filaFaltam());
+  metricasCabecalho("forno_fila_pausada", "gauge", "1 se a fila espera o operador");
+  metricasLinha("forno_fila_pausada %d\n", fila.pausada ? 1 : 0);
+  metricasCabecalho("forno_fila_corridas_total", "counter", "corridas completas iniciadas pela fila");
+  metricasLinha("forno_fila_corridas_total %lu\n", (unsigned long)fila_corridas);
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Datagramas da frota de fornos (veja frota.ino)
+// Formato para quem for coletar em outro lugar: grupo multicast
+// 239.255.80.2, porta UDP 4210, little-endian, sem preenchimento. O
+// anúncio leva o quadro inteiro; a amostra termina antes de nome.
+
+  // guarda de inclusão
+#ifndef FrotaForno_h
+#define FrotaForno_h
+
+#define FROTA_MAGIA   0x5032    // bytes 0x32 0x50 na rede
+#define FROTA_VERSAO  3         // 2: utc_us; 3: partida_s
+#define FROTA_ANUNCIO 1         // nome do forno + última amostra
+#define FROTA_AMOSTRA 2         // só a amostra
+#define FROTA_NOME    16        // com o terminador
+
+struct __attribute__((packed)) QuadroFrota {
+  uint16_t magia;
+  uint8_t versao;
+  uint8_t tipo;
+  uint32_t chip;           // chipId() de plataforma.h: identifica o forno
+  uint32_t t_ms;           // millis() do remetente
+  int16_t rk;              // temperatura em décimos de C
+  int16_t set_point;       // décimos de C
+  uint8_t potencia;        // 0-100
+  uint8_t corrida;         // EstadoCorrida
+  uint8_t desarme;         // MotivoDesarme, 0 = armado
+  uint8_t zonas;
+  uint64_t utc_us;         // µs desde 1970 (relogio.ino), 0 sem SNTP
+  uint16_t partida_s;      // até o fim da rampa de partida, 0 = fora dela
+  char nome[FROTA_NOME];   // só no anúncio
+};
+
+#define FROTA_TAMANHO_AMOSTRA (sizeof(QuadroFrota) - FROTA_NOME)
+
+// Um forno ouvido no grupo
+struct FornoFrota {
+  uint32_t chip;           // 0 = entrada livre
+  uint32_t ip;
+  unsigned long visto;     // millis() do último datagrama
+  QuadroFrota quadro;      // último recebido (nome do último anúncio)
+};
+
+#endif
@@ -0,0 +1,230 @@
+// Frota de fornos por UDP multicast
+// Cada forno anuncia o seu nome a cada FROTA_ANUNCIO_MS e manda uma amostra
+// compacta (frota.h) a cada FROTA_AMOSTRA_MS para o grupo; todos escutam o
+// mesmo grupo e guardam o último quadro de cada vizinho. /fleet devolve a
+// tabela, então a página de qualquer forno mostra a sala inteira com uma
+// requisição só, e um coletor na rede pode ouvir o grupo direto.
+// Partida escalonada: quem começa uma corrida espera a rampa de partida
+// (definirRampa do disparo) dos vizinhos que já estão nela e avisa a
+// sua na hora; se dois começam juntos, o de chip menor vai primeiro e o
+// outro adia a própria rampa, para as correntes de partida não somarem
+// no mesmo circuito.
+// Tudo roda no loop(), como o resto da rede.
+
+#define FROTA_GRUPO       239, 255, 80, 2
+#define FROTA_PORTA       4210
+#define FROTA_MAX         8         // vizinhos guardados
+#define FROTA_ANUNCIO_MS  5000
+#define FROTA_AMOSTRA_MS  1000
+#define FROTA_VALIDADE_MS 15000     // sem notícias: some da tabela
+#define FROTA_LOTE        4         // datagramas lidos por chamada
+#define FROTA_ESPERA_MAX_MS 120000  // nunca espera mais que isso pelos vizinhos
+
+WiFiUDP frotaUdp;
+FornoFrota frota[FROTA_MAX];
+bool frota_ativa = false;
+unsigned long frota_anuncio = 0;    // millis() do último envio de cada tipo
+unsigned long frota_amostra = 0;
+char frota_nome[FROTA_NOME];
+bool frota_partindo = false;        // rampa de partida deste forno marcada
+unsigned long frota_rampa_inicio = 0;   // millis() do começo e do fim dela
+unsigned long frota_rampa_fim = 0;
+
+void frotaAtender(){
+  if(!redeConectada()){
+    if(frota_ativa){
+      frotaUdp.stop();
+      frota_ativa = false;
+    }
+    return;
+  }
+
+  unsigned long agora = millis();
+  if(!frota_ativa){
+    // a associação ao grupo precisa do IP, refeita a cada conexão
+    frotaUdp.beginMulticast(WiFi.localIP(), IPAddress(FROTA_GRUPO), FROTA_PORTA);
+    frota_ativa = true;
+    frota_anuncio = agora - FROTA_ANUNCIO_MS;   // anuncia já
+  }
+
+  frotaReceber();
+
+  if(agora - frota_anuncio >= FROTA_ANUNCIO_MS){
+    frota_anuncio = agora;
+    frota_amostra = agora;     // o anúncio também leva a amostra
+    frotaEnviar(FROTA_ANUNCIO);
+  }
+  else if(agora - frota_amostra >= FROTA_AMOSTRA_MS){
+    frota_amostra = agora;
+    frotaEnviar(FROTA_AMOSTRA);
+  }
+}
+
+// Nome do forno na rede (frota e MQTT): "forno-" e o fim do chip id
+const char* frotaNome(){
+  if(!frota_nome[0]){
+    snprintf(frota_nome, sizeof(frota_nome), "forno-%06lx", (unsigned long)(chipId() & 0xFFFFFF));
+  }
+  return frota_nome;
+}
+
+// Quadro com a amostra mais recente da tarefa de controle
+void frotaPreencher(QuadroFrota& q, uint8_t tipo){
+  AmostraControle a;
+  telemetria.ler(a);
+
+  memset(&q, 0, sizeof(q));
+  q.magia = FROTA_MAGIA;
+  q.versao = FROTA_VERSAO;
+  q.tipo = tipo;
+  q.chip = chipId();
+  q.t_ms = a.timestamp;
+  q.rk = (int16_t)(a.rk * 10);
+  q.set_point = (int16_t)(a.set_point * 10);
+  q.potencia = (uint8_t)a.controle_potencia;
+  q.corrida = a.corrida;
+  q.desarme = a.desarme;
+  q.zonas = ZONAS;
+  q.utc_us = a.utc_us;
+  q.partida_s = frotaPartidaRestante() / 1000;
+}
+
+// ms até o fim da rampa de partida deste forno, arredondado para cima
+uint32_t frotaPartidaRestante(){
+  if(!frota_partindo) return 0;
+  long resta = (long)(frota_rampa_fim - millis());
+  if(resta <= 0){
+    frota_partindo = false;
+    return 0;
+  }
+  return (resta + 999) / 1000 * 1000;
+}
+
+// corridaIniciar(): ms até a rampa deste forno começar, depois da dos
+// vizinhos ouvidos em partida. Sem rampa (rampa_ms 0) não há o que escalonar
+uint32_t frotaPartida(uint32_t rampa_ms){
+  frota_partindo = false;
+  if(rampa_ms == 0) return 0;
+  unsigned long agora = millis();
+  uint32_t espera = 0;
+  for(int i=0; i<FROTA_MAX; i++){
+    unsigned long idade = agora - frota[i].visto;
+    if(frota[i].chip == 0 || idade > FROTA_VALIDADE_MS) continue;
+    uint32_t ms = frota[i].quadro.partida_s * 1000UL;
+    if(ms > idade && ms - idade > espera) espera = ms - idade;
+  }
+  if(espera > FROTA_ESPERA_MAX_MS) espera = FROTA_ESPERA_MAX_MS;
+  frota_partindo = true;
+  frota_rampa_inicio = agora + espera;
+  frota_rampa_fim = frota_rampa_inicio + rampa_ms;
+  frota_amostra = agora - FROTA_AMOSTRA_MS;   // avisa os vizinhos já
+  return espera;
+}
+
+// Um vizinho de chip menor também está partindo e a nossa rampa ainda
+// não andou: a dele vem primeiro
+void frotaCederPartida(const QuadroFrota& q){
+  if(!frota_partindo || q.partida_s == 0 || q.chip > chipId()) return;
+  unsigned long agora = millis();
+  if((long)(agora - frota_rampa_inicio) > FROTA_AMOSTRA_MS) return;   // já subindo: segue
+  unsigned long inicio = agora + q.partida_s * 1000UL;
+  if((long)(inicio - frota_rampa_inicio) <= 0) return;
+  if(inicio - agora > FROTA_ESPERA_MAX_MS) return;
+  frota_rampa_fim += inicio - frota_rampa_inicio;
+  frota_rampa_inicio = inicio;
+  disparo.adiarRampa(inicio - agora);
+  frota_amostra = agora - FROTA_AMOSTRA_MS;
+}
+
+void frotaEnviar(uint8_t tipo){
+  QuadroFrota q;
+  frotaPreencher(q, tipo);
+  size_t tamanho = FROTA_TAMANHO_AMOSTRA;
+  if(tipo == FROTA_ANUNCIO){
+    strncpy(q.nome, frotaNome(), FROTA_NOME - 1);
+    tamanho = sizeof(q);
+  }
+
+  frotaUdp.beginPacketMulticast(IPAddress(FROTA_GRUPO), FROTA_PORTA, WiFi.localIP());
+  frotaUdp.write((const uint8_t*)&q, tamanho);
+  frotaUdp.endPacket();
+}
+
+void frotaReceber(){
+  for(int n=0; n<FROTA_LOTE; n++){
+    int tamanho = frotaUdp.parsePacket();
+    if(tamanho <= 0) return;
+
+    QuadroFrota q;
+    memset(&q, 0, sizeof(q));
+    int lidos = frotaUdp.read((unsigned char*)&q, sizeof(q));
+    if(lidos < (int)FROTA_TAMANHO_AMOSTRA) continue;
+    if(q.magia != FROTA_MAGIA || q.versao != FROTA_VERSAO) continue;
+    if(q.chip == 0 || q.chip == chipId()) continue;
+
+    FornoFrota& f = frotaEntrada(q.chip);
+    // a amostra não traz nome: fica o do último anúncio
+    char nome[FROTA_NOME] = "";
+    if(f.chip == q.chip) memcpy(nome, f.quadro.nome, FROTA_NOME);
+    if(q.tipo == FROTA_ANUNCIO && lidos == (int)sizeof(q)){
+      memcpy(nome, q.nome, FROTA_NOME);
+      nome[FROTA_NOME - 1] = 0;
+      // vai cru para o JSON e para a página: só letras, dígitos, - _ .
+      for(char* c = nome; *c; c++){
+        if(!isalnum(*c) && *c != '-' && *c != '_' && *c != '.') *c = '_';
+      }
+    }
+    f.chip = q.chip;
+    f.ip = (uint32_t)frotaUdp.remoteIP();
+    f.visto = millis();
+    f.quadro = q;
+    memcpy(f.quadro.nome, nome, FROTA_NOME);
+    frotaCederPartida(q);
+  }
+}
+
+// Entrada do forno, senão uma livre ou vencida, senão a mais antiga
+FornoFrota& frotaEntrada(uint32_t chip){
+  int escolhida = 0;
+  for(int i=0; i<FROTA_MAX; i++){
+    if(frota[i].chip == chip) return frota[i];
+  }
+  for(int i=0; i<FROTA_MAX; i++){
+    if(frota[i].chip == 0 || millis() - frota[i].visto > FROTA_VALIDADE_MS) return frota[i];
+    if((long)(frota[i].visto - frota[escolhida].visto) < 0) escolhida = i;
+  }
+  return frota[escolhida];
+}
+
+// Um forno do array de /fleet, enviado sozinho: nove deles não cabem na
+// arena de formatarResposta()
+void frotaEnviar(const char* separador, const char* nome, IPAddress ip, const QuadroFrota& q,
+                 unsigned long idade){
+  char json[224];
+  snprintf(json, sizeof(json),
+           "%s{\"nome\":\"%s\",\"ip\":\"%u.%u.%u.%u\",\"corrida\":%u,\"temperatura\":%.1f"
+           ",\"set_point\":%.1f,\"potencia\":%u,\"desarme\":%u,\"zonas\":%u,\"partida_s\":%u"
+           ",\"idade_ms\":%lu}",
+           separador, nome, ip[0], ip[1], ip[2], ip[3], q.corrida, q.rk / 10.0, q.set_point / 10.0,
+           q.potencia, q.desarme, q.zonas, q.partida_s, idade);
+  server.sendContent(json);
+}
+
+// GET /fleet: este forno primeiro, depois os vizinhos ouvidos há pouco
+void handleFleet(){
+  QuadroFrota proprio;
+  frotaPreencher(proprio, FROTA_AMOSTRA);
+
+  server.sendHeader("Cache-Control", "no-store");
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+  frotaEnviar("[", frotaNome(), WiFi.localIP(), proprio, 0);
+  for(int i=0; i<FROTA_MAX; i++){
+    unsigned long idade = millis() - frota[i].visto;
+    if(frota[i].chip == 0 || idade > FROTA_VALIDADE_MS) continue;
+    const char* nome = frota[i].quadro.nome[0] ? frota[i].quadro.nome : "?";
+    frotaEnviar(",", nome, IPAddress(frota[i].ip), frota[i].quadro, idade);
+  }
+  server.sendContent("]");
+  server.sendContent("");
+}
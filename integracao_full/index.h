@@ -1,228 +1,700 @@
-const char MAIN_page[] PROGMEM = R"=====(
-<!doctype html>
-<html>
- 
-<head>
-  <title>Estacao de Solda | Controle de Temperatura - Forno </title>
-  <!--For offline ESP graphs see this tutorial https://circuits4you.com/2018/03/10/esp8266-jquery-and-ajax-web-server/ -->
-  
-  <script src = "https://cdnjs.cloudflare.com/ajax/libs/Chart.js/2.7.3/Chart.min.js"></script>  
-  <script src="https://ajax.googleapis.com/ajax/libs/jquery/3.4.1/jquery.min.js"></script>
+// Gerado por web/gerar_index.py a partir de web/index.html e do app.
+// Não editar: altere os arquivos em web/ e rode o script de novo.
+// index.html: 19643 bytes -> 6778 bytes com gzip
+// grafico.js: 7741 bytes -> 2678 bytes com gzip
+// manifest.webmanifest: 208 bytes -> 153 bytes com gzip
+// sw.js: 2243 bytes -> 988 bytes com gzip
 
-  <style>
-  canvas{
-    -moz-user-select: none;
-    -webkit-user-select: none;
-    -ms-user-select: none;
-  }
- 
-  /* Data Table Styling */
-  #dataTable {
-    font-family: "Trebuchet MS", Arial, Helvetica, sans-serif;
-    border-collapse: collapse;
-    width: 100%;
-  }
- 
-  #dataTable td, #dataTable th {
-    border: 1px solid #ddd;
-    padding: 8px;
-  }
- 
-  #dataTable tr:nth-child(even){background-color: #f2f2f2;}
- 
-  #dataTable tr:hover {background-color: #ddd;}
- 
-  #dataTable th {
-    padding-top: 12px;
-    padding-bottom: 12px;
-    text-align: left;
-    background-color: #4CAF50;
-    color: white;
-  }
-
-  .iniciar {
-    background-color: #e7e7e7; /* Green */
-    border-radius: 12px;
-    color: black;
-    padding: 15px 32px;
-    text-align: center;
-    text-decoration: none;
-    display: inline-block;
-    font-size: 16px;
-    margin-left: 602px;
-    padding-top: 15px;
-    margin-top: 20px;
-    margin-bottom: 20px;
-    max-width: 400px;
-    margin: 0 auto;
-    border: 1px solid #ccc;
-  }
-
-  .parar {
-    background-color: #e7e7e7; /* Green */
-    border-radius: 12px;
-    color: black;
-    padding: 15px 32px;
-    text-align: center;
-    text-decoration: none;
-    display: inline-block;
-    font-size: 16px;
-    margin-left: 602px;
-    padding-top: 15px;
-    margin-top: 20px;
-    margin-bottom: 20px;
-    max-width: 400px;
-    margin: 0 auto;
-    border: 1px solid #ccc;
-  }
-
-  #dialog  {
-    color: red;
-    font-size: 30px;
-    text-align: center;
-  }
- 
-  </style>
-</head>
- 
-<body>
-    <div style="text-align:center;"><b>Estacao de Solda - PI2 </b><br>Controle de temperatura - Forno</div>
-    
-    <div style="display: flex">
-      <button type="button" id="button1"data-text-swap="INICIADO" class="iniciar" onClick="uploadChart();">Iniciar</button>
-      <button class="parar" onClick="resetChart();">Atualizar Pagina</button>
-    </div>
-    
-    <div id="dialog" title="Alerta">
-      <p>Abrir a porta do Forno!</p>
-    </div>
-
-    <div class="chart-container" position: relative; height:350px; width:100%">
-        <canvas id="Chart" width="400" height="400"></canvas>
-    </div>
-    
-    <div>
-      <table id="dataTable">
-        <tr><th>Tempo</th><th>Valor de Leitura</th></tr>
-      </table>
-    </div>
-
-<br>
-<br>  
- 
-<script>
-
-//Graphs visit: https://www.chartjs.org
-var values = [];
-var timeStamp = [];
-function showGraph()
-{
-    for (i = 0; i < arguments.length; i++) {
-      values.push(arguments[i]);    
-    }
- 
-    var ctx = document.getElementById("Chart").getContext('2d');
-    var Chart2 = new Chart(ctx, {
-        type: 'line',
-        data: {
-            labels: timeStamp,  //Bottom Labeling
-            datasets: [{
-                label: "Temperatura (Graus Celsius)",
-                fill: false,  //Try with true
-                backgroundColor: 'rgba( 243, 156, 18 , 1)', //Dot marker color
-                borderColor: 'rgba( 243, 156, 18 , 1)', //Graph Line Color
-                data: values,
-            }],
-        },
-        options: {
-            title: {
-                    display: false,
-                    text: "Leitura"
-                },
-            maintainAspectRatio: false,
-            elements: {
-            line: {
-                    tension: 0.5 //Smoothening (Curved) of data lines
-                }
-            },
-            scales: {
-                    yAxes: [{
-                        ticks: {
-                            beginAtZero:true
-                        }
-                    }]
-            }
-        }
-    });
- 
-}
- 
-//On Page load show graphs
-window.onload = function() {
-  console.log(new Date().toLocaleTimeString());
-  showGraph(5,10,4,58);
+#define MAIN_page_etag "\"c4e2d1888a5bc97c\""
 
+const uint8_t MAIN_page_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x5c, 0xfb, 0x73, 0xdc, 0x36,
+  0x92, 0xfe, 0x5d, 0x7f, 0x05, 0xcc, 0xd4, 0x5a, 0x9c, 0x68, 0xde, 0xb6, 0x64, 0x45, 0x2f, 0x97,
+  0x22, 0x3b, 0x6b, 0x5f, 0xf9, 0xa1, 0x93, 0x26, 0xc9, 0xde, 0xa9, 0x54, 0x36, 0x66, 0x88, 0x99,
+  0xa1, 0xcd, 0x21, 0x18, 0x92, 0xa3, 0x91, 0xe2, 0xd5, 0xff, 0x7e, 0x5f, 0x37, 0x40, 0x12, 0x9c,
+  0x87, 0xec, 0xe4, 0xb6, 0x76, 0xf7, 0xaa, 0x6e, 0xb3, 0x71, 0x38, 0x20, 0xd0, 0x68, 0x34, 0xfa,
+  0xf1, 0x75, 0x03, 0xf4, 0xd1, 0xa3, 0x40, 0x8f, 0xf2, 0xbb, 0x44, 0x89, 0x69, 0x3e, 0x8b, 0x4e,
+  0xb6, 0x8e, 0xcc, 0x7f, 0x04, 0x1e, 0x94, 0x0c, 0xf0, 0x20, 0x8e, 0xf2, 0x30, 0x8f, 0xd4, 0xc9,
+  0xcb, 0x2c, 0x97, 0x23, 0xa9, 0x45, 0xa0, 0xc4, 0xa5, 0x8e, 0x02, 0x29, 0xfe, 0x2e, 0xce, 0x74,
+  0x9c, 0xa7, 0x3a, 0x52, 0xd4, 0x36, 0x50, 0xb3, 0x44, 0xa5, 0x32, 0x9f, 0xa7, 0x52, 0xb4, 0xc4,
+  0x4f, 0x3a, 0x8d, 0xb5, 0x38, 0xea, 0x98, 0xa1, 0x44, 0x24, 0x0a, 0xe3, 0xcf, 0x22, 0x55, 0xd1,
+  0xb1, 0x37, 0x93, 0x71, 0x38, 0x56, 0x59, 0xee, 0x89, 0x69, 0xaa, 0xc6, 0xc7, 0x5e, 0xa7, 0x68,
+  0x68, 0x2f, 0xd4, 0xb0, 0x7c, 0xc9, 0x83, 0x66, 0x2a, 0x97, 0x22, 0x96, 0x33, 0x75, 0xec, 0xe5,
+  0x53, 0x35, 0x53, 0xad, 0x91, 0x8e, 0x74, 0xea, 0x89, 0x11, 0x26, 0x56, 0x71, 0x7e, 0xec, 0x7d,
+  0x37, 0x7e, 0xf2, 0xc3, 0xa8, 0xd7, 0x37, 0xbd, 0x1f, 0xb5, 0x5a, 0xe8, 0x25, 0x46, 0x53, 0x99,
+  0xe6, 0x22, 0xcc, 0x44, 0x90, 0xca, 0x45, 0x2c, 0x86, 0x77, 0x62, 0x92, 0xca, 0x71, 0x38, 0xd2,
+  0xed, 0x4f, 0x59, 0x53, 0x64, 0x2a, 0xbd, 0x51, 0x81, 0x18, 0xa7, 0x7a, 0x26, 0xa8, 0xb7, 0xbe,
+  0x51, 0xb1, 0x18, 0x47, 0x32, 0x9b, 0x8a, 0x45, 0x98, 0x4f, 0xd1, 0x86, 0x91, 0x89, 0x9c, 0x28,
+  0xe1, 0x67, 0x4a, 0x89, 0x09, 0xd6, 0x94, 0x7e, 0x08, 0xe3, 0x40, 0xdd, 0xb6, 0x93, 0xbb, 0x46,
+  0xab, 0xc5, 0x33, 0x65, 0xa3, 0x34, 0x4c, 0x72, 0x91, 0xa5, 0x23, 0xb0, 0x5f, 0x51, 0xf7, 0x4e,
+  0x8e, 0x3a, 0xe6, 0xd5, 0xc9, 0x16, 0x77, 0xcb, 0xef, 0xcc, 0xea, 0x47, 0x32, 0xbe, 0x91, 0xd9,
+  0x17, 0x3c, 0x09, 0xd1, 0x9a, 0xe9, 0xdf, 0x5b, 0x73, 0xb0, 0xd1, 0xca, 0x54, 0xa4, 0x46, 0xf9,
+  0x81, 0x88, 0x75, 0xac, 0x0e, 0xcd, 0x3b, 0x48, 0xe0, 0x73, 0x98, 0x6f, 0x7c, 0x3d, 0xcb, 0xd6,
+  0xbf, 0xba, 0xc7, 0x7e, 0x09, 0xd1, 0xf9, 0x5e, 0xbc, 0x90, 0x10, 0xd8, 0x40, 0x0e, 0xb1, 0x27,
+  0x97, 0x98, 0x3c, 0x8c, 0x27, 0xe2, 0xfb, 0x0e, 0x5e, 0x7d, 0x17, 0xe0, 0x05, 0xb7, 0x37, 0xc5,
+  0x77, 0xe3, 0x48, 0xa9, 0xdc, 0x74, 0x32, 0x2c, 0x8d, 0x21, 0xce, 0xd6, 0x58, 0xce, 0xc2, 0xe8,
+  0xee, 0x40, 0x78, 0x83, 0x54, 0x0d, 0xe7, 0xa3, 0xa9, 0xca, 0xc5, 0xdb, 0x4b, 0xaf, 0x29, 0x4e,
+  0xd3, 0x50, 0x46, 0x4d, 0xf1, 0x4a, 0x45, 0x37, 0x2a, 0x0f, 0x47, 0x12, 0x22, 0x94, 0x71, 0x06,
+  0x16, 0xd2, 0x70, 0x6c, 0xd8, 0x1a, 0xea, 0x34, 0x00, 0x53, 0xd8, 0x9b, 0x48, 0x26, 0x99, 0x3a,
+  0x10, 0xc5, 0x93, 0x79, 0xbd, 0x08, 0x83, 0x7c, 0x7a, 0x20, 0x7a, 0xdd, 0xee, 0x5f, 0x2a, 0x5e,
+  0x2b, 0x86, 0x44, 0x1e, 0x34, 0x6b, 0x3f, 0xa7, 0x75, 0x16, 0xf9, 0xb5, 0xfb, 0x7b, 0x6a, 0xb9,
+  0x36, 0xd3, 0x82, 0x70, 0x72, 0x2b, 0x32, 0x1d, 0x85, 0x01, 0xa8, 0x04, 0x81, 0x99, 0x33, 0x91,
+  0x41, 0x80, 0xc5, 0x1f, 0x88, 0xfd, 0xe4, 0x76, 0xfd, 0xa4, 0x69, 0x5b, 0xd1, 0xce, 0x7f, 0x19,
+  0xca, 0xd1, 0xe7, 0x49, 0xaa, 0xe7, 0x71, 0x60, 0x94, 0xeb, 0x00, 0x93, 0xf5, 0xe9, 0x9f, 0xc3,
+  0xfb, 0xad, 0x65, 0x3e, 0xed, 0xc4, 0x53, 0x15, 0x4e, 0xa6, 0x90, 0x7e, 0xbf, 0x6b, 0x88, 0x63,
+  0x89, 0xd3, 0x30, 0x57, 0xad, 0x2c, 0x91, 0x23, 0x45, 0x9b, 0xb2, 0x48, 0x65, 0x62, 0x66, 0x25,
+  0x0a, 0x39, 0x8d, 0xfe, 0x25, 0x54, 0x8b, 0xa5, 0xe1, 0x4f, 0xbb, 0xe5, 0x78, 0x28, 0x61, 0x3a,
+  0x8e, 0xf4, 0xa2, 0x05, 0xf9, 0xcb, 0x79, 0xae, 0x37, 0xb0, 0x7c, 0x30, 0xa5, 0x8e, 0x6b, 0x79,
+  0xa6, 0x95, 0xaf, 0x8e, 0x98, 0x6e, 0x10, 0x9d, 0x15, 0x4f, 0x2b, 0xd7, 0x09, 0xe4, 0xd7, 0x2f,
+  0xd8, 0x28, 0x9a, 0x87, 0x3a, 0xcf, 0xf5, 0xcc, 0x7d, 0x93, 0xab, 0xdb, 0xbc, 0x25, 0xa3, 0x70,
+  0x12, 0x1f, 0x88, 0x48, 0x8d, 0x73, 0xbb, 0xf1, 0xab, 0x7c, 0x3c, 0x3d, 0x3b, 0xfd, 0x69, 0xb7,
+  0x6b, 0x5e, 0xdb, 0x36, 0x16, 0x4e, 0x29, 0x8e, 0x76, 0x18, 0x87, 0xa3, 0x50, 0xa6, 0xc5, 0x26,
+  0xae, 0x92, 0x50, 0xcf, 0xe8, 0x9f, 0x43, 0x52, 0xe7, 0xbf, 0xa6, 0x0a, 0x7b, 0xc4, 0x1a, 0x5c,
+  0xaa, 0x59, 0x2a, 0x83, 0x70, 0x9e, 0xb9, 0xcc, 0xd9, 0x81, 0xc3, 0x08, 0xb4, 0x96, 0xb6, 0xbf,
+  0xb7, 0x0b, 0xe5, 0x78, 0xb2, 0x76, 0x19, 0x23, 0x38, 0x10, 0x95, 0x3a, 0xed, 0x81, 0x1a, 0x69,
+  0x38, 0xb0, 0x50, 0xc7, 0xae, 0xcd, 0x05, 0x61, 0x96, 0x44, 0x12, 0xfb, 0x12, 0xc6, 0x30, 0x27,
+  0xd5, 0x1a, 0x46, 0xba, 0x98, 0x85, 0xcd, 0x26, 0x0b, 0x7f, 0xc7, 0x9e, 0xf7, 0xf6, 0x8a, 0x29,
+  0x66, 0x32, 0x9d, 0x84, 0x71, 0x8b, 0x84, 0x74, 0x20, 0xf6, 0xba, 0x2b, 0xb2, 0x35, 0x22, 0xdf,
+  0x5d, 0xea, 0xce, 0xad, 0x95, 0x3e, 0xd9, 0xd6, 0x62, 0x1f, 0xdc, 0x17, 0xb7, 0x2d, 0x6b, 0x4f,
+  0x8e, 0xfa, 0x98, 0xee, 0x07, 0xa2, 0x5b, 0x2a, 0xcf, 0x5a, 0xeb, 0x18, 0x8d, 0x46, 0xd5, 0x36,
+  0x24, 0x32, 0xfd, 0xff, 0x4d, 0xf8, 0x17, 0x6f, 0xc2, 0x77, 0x01, 0x5c, 0xab, 0x9e, 0x08, 0xbb,
+  0x0d, 0x56, 0x84, 0xa9, 0x0a, 0x56, 0x96, 0xf6, 0xa4, 0xfb, 0xb0, 0xf4, 0x8c, 0xe9, 0x23, 0xfa,
+  0x98, 0x88, 0x73, 0xd4, 0xb1, 0xc1, 0x7b, 0xeb, 0x68, 0xa8, 0x83, 0xbb, 0x13, 0x1e, 0x79, 0x14,
+  0x84, 0x37, 0x82, 0x3b, 0x20, 0x9a, 0x56, 0x54, 0x2c, 0x11, 0xc4, 0xae, 0xe1, 0x6a, 0x8c, 0x6f,
+  0x89, 0xf3, 0xd7, 0x7d, 0xd0, 0x1d, 0xe2, 0x6d, 0x7a, 0xe2, 0xc6, 0xfb, 0x7c, 0x35, 0xde, 0x1f,
+  0x75, 0x30, 0x83, 0x99, 0x6b, 0x65, 0xc2, 0x72, 0x07, 0xe1, 0x8e, 0x6e, 0x3d, 0xd3, 0x09, 0x3d,
+  0x86, 0x73, 0x08, 0x37, 0x16, 0x84, 0x3f, 0x8e, 0x3d, 0xf3, 0xc3, 0x13, 0x61, 0x50, 0x3c, 0xf7,
+  0x3c, 0x72, 0x66, 0x2d, 0xe6, 0x36, 0x5b, 0xc8, 0xe4, 0xd8, 0x7b, 0xfd, 0xee, 0xf5, 0xd9, 0xeb,
+  0xd3, 0x17, 0xef, 0x81, 0x01, 0x10, 0xb3, 0xb3, 0x63, 0xcf, 0xba, 0x13, 0x4f, 0xe8, 0xf8, 0x2c,
+  0x0a, 0x47, 0x9f, 0x8f, 0xbd, 0x79, 0x12, 0x69, 0x19, 0x9c, 0x11, 0x0a, 0xf0, 0x1b, 0x58, 0xd7,
+  0x6b, 0xd3, 0x03, 0x8b, 0x60, 0x9a, 0xcb, 0x73, 0x5b, 0x3a, 0x6c, 0x0f, 0x0e, 0x95, 0x44, 0x22,
+  0xd2, 0x5e, 0xcc, 0x63, 0x26, 0x71, 0x8e, 0x1f, 0x7f, 0x98, 0x82, 0xc4, 0xee, 0xe7, 0x05, 0x85,
+  0x53, 0xfa, 0xf1, 0x87, 0x49, 0xa4, 0x2a, 0x53, 0x79, 0xb5, 0x92, 0xd3, 0x7c, 0x8e, 0x3d, 0xfb,
+  0x1d, 0x76, 0x7b, 0x2e, 0xa1, 0x6b, 0xb2, 0x4e, 0xcd, 0x11, 0x3f, 0x4b, 0x9e, 0xc4, 0x98, 0xce,
+  0xe3, 0xcb, 0x5c, 0xe6, 0xca, 0x7b, 0x70, 0xe3, 0xd7, 0xed, 0x1b, 0x8d, 0x36, 0xea, 0xe9, 0x09,
+  0x46, 0x71, 0xc7, 0xde, 0x69, 0xa4, 0xb0, 0x86, 0x6a, 0xf3, 0x12, 0xac, 0x2a, 0x0d, 0x53, 0x21,
+  0x45, 0x42, 0x8b, 0x13, 0x81, 0x36, 0x7a, 0xf0, 0xe8, 0xa8, 0x93, 0xd4, 0x58, 0xaa, 0xa8, 0xda,
+  0x75, 0x32, 0x44, 0x6b, 0x11, 0x8a, 0x93, 0x30, 0xe7, 0xb4, 0xe4, 0x2e, 0xd1, 0x59, 0x68, 0x6c,
+  0x1f, 0x48, 0x11, 0x5e, 0xe0, 0x46, 0x1d, 0x16, 0xe1, 0xf2, 0xc9, 0x2e, 0x99, 0x80, 0x05, 0x13,
+  0x84, 0x25, 0x4a, 0x3e, 0x40, 0xda, 0xe0, 0x2b, 0xe6, 0x99, 0xa5, 0xe5, 0x99, 0x7e, 0xc7, 0x1e,
+  0xec, 0xd3, 0xb3, 0x14, 0xcc, 0x0f, 0x2c, 0xd6, 0x74, 0x5e, 0x91, 0x59, 0x7d, 0xe9, 0x65, 0xd0,
+  0xae, 0x96, 0xcb, 0x4d, 0x46, 0x2e, 0x45, 0x84, 0x75, 0x79, 0xc8, 0xd9, 0xe4, 0x8e, 0xf2, 0x14,
+  0xff, 0x4e, 0x4f, 0x08, 0x0e, 0xc3, 0x20, 0xf0, 0x44, 0xbf, 0x7e, 0x81, 0x1c, 0x53, 0xb2, 0x9a,
+  0x37, 0x2a, 0x24, 0x8b, 0x31, 0x2f, 0x3a, 0xd4, 0xb7, 0x93, 0x17, 0x38, 0xbb, 0xa0, 0x43, 0x16,
+  0x5b, 0xf1, 0xf0, 0x23, 0x7e, 0x11, 0xd7, 0x79, 0x65, 0xc8, 0xc4, 0x36, 0xbf, 0xdb, 0x20, 0x64,
+  0x1a, 0xcb, 0x51, 0x7f, 0x13, 0xff, 0x15, 0x24, 0xd8, 0xbc, 0x00, 0x6b, 0xd1, 0x76, 0x01, 0xe4,
+  0x18, 0x82, 0xea, 0xa7, 0x03, 0xf6, 0xcb, 0xb6, 0x4b, 0x00, 0xc6, 0x44, 0x87, 0x71, 0x5e, 0xb6,
+  0x9c, 0x6b, 0x80, 0x74, 0x98, 0xde, 0xb7, 0xad, 0x96, 0x99, 0xfa, 0xf6, 0xd5, 0x92, 0x3f, 0xe2,
+  0x3f, 0x68, 0xe7, 0xb6, 0x8e, 0x4a, 0xd8, 0xdd, 0xe9, 0xb0, 0x06, 0x50, 0x8a, 0x30, 0x0e, 0x27,
+  0x73, 0x13, 0x4b, 0x10, 0x37, 0x18, 0xec, 0xf3, 0x2b, 0x00, 0x75, 0xd1, 0x87, 0x73, 0x4d, 0x67,
+  0x32, 0x17, 0x7e, 0x85, 0xde, 0x39, 0x5f, 0x80, 0x12, 0xe5, 0x0d, 0x10, 0x19, 0xb8, 0x89, 0xc4,
+  0x70, 0x1e, 0x46, 0x39, 0xac, 0x72, 0x04, 0x75, 0xcc, 0xe4, 0x2c, 0x89, 0x54, 0x26, 0x26, 0x1a,
+  0x44, 0x73, 0x0d, 0x17, 0x8f, 0xb0, 0x89, 0x84, 0x42, 0xa6, 0xa9, 0xbc, 0xcb, 0x30, 0x0b, 0x88,
+  0x96, 0x59, 0x08, 0x08, 0xa5, 0x58, 0x6f, 0x46, 0x49, 0x08, 0x72, 0x1d, 0x95, 0x42, 0x1e, 0x40,
+  0xe0, 0x99, 0x16, 0x4a, 0x8e, 0xa6, 0x22, 0x06, 0x26, 0x64, 0x91, 0xd1, 0x24, 0x9f, 0xe6, 0x59,
+  0x4e, 0xa6, 0x34, 0xcf, 0xa6, 0x98, 0x05, 0xf8, 0x3b, 0x98, 0x47, 0xea, 0x42, 0x81, 0x78, 0xea,
+  0x37, 0x98, 0x90, 0xe1, 0x8f, 0xd8, 0x10, 0x90, 0xbe, 0x40, 0xa6, 0x34, 0x33, 0xab, 0x1b, 0xa7,
+  0x48, 0x91, 0xc4, 0x54, 0x2f, 0x14, 0xc1, 0x43, 0xa4, 0x50, 0x77, 0x86, 0x6c, 0x46, 0x5c, 0xc1,
+  0x88, 0x82, 0xad, 0x1b, 0xf8, 0x8c, 0xb7, 0xa7, 0x7f, 0xfb, 0x70, 0xfe, 0xfe, 0xf5, 0xbb, 0xc1,
+  0xa5, 0x38, 0x16, 0x3f, 0x74, 0xbb, 0x87, 0xc8, 0x18, 0x3a, 0xbd, 0x5d, 0x31, 0x83, 0x70, 0xc0,
+  0x74, 0xcf, 0x2e, 0xad, 0x83, 0x24, 0x29, 0xd2, 0x31, 0x12, 0x1f, 0x5a, 0x0c, 0x5e, 0x11, 0xb5,
+  0x54, 0x8f, 0xc3, 0x48, 0x31, 0x99, 0x1b, 0x19, 0xcd, 0xb1, 0xfe, 0x63, 0x71, 0x75, 0x7d, 0xc8,
+  0x0d, 0x79, 0x38, 0x53, 0x70, 0x32, 0xb3, 0xc4, 0xb6, 0x75, 0x3a, 0xa5, 0x2a, 0x60, 0x70, 0x20,
+  0x72, 0x44, 0x8c, 0x54, 0x12, 0xd7, 0x43, 0xfc, 0x6c, 0x62, 0x01, 0x4a, 0xc0, 0xf5, 0xa4, 0x77,
+  0xbc, 0x0a, 0x33, 0xa9, 0x90, 0x34, 0x65, 0x16, 0xc2, 0x44, 0x3e, 0x9a, 0x09, 0x3e, 0x32, 0x6d,
+  0xb8, 0xbf, 0x73, 0xb3, 0x92, 0x6a, 0x3e, 0xa2, 0xf2, 0x0a, 0x16, 0xbd, 0xd4, 0xf4, 0x46, 0x2f,
+  0x9c, 0x16, 0xb3, 0x77, 0xc7, 0x22, 0x9e, 0x47, 0xd1, 0xe1, 0xd6, 0x78, 0x1e, 0x8f, 0x58, 0x52,
+  0x23, 0x6c, 0x47, 0xae, 0xac, 0x47, 0xdd, 0x32, 0x61, 0x97, 0xbb, 0xe7, 0xb7, 0xe8, 0x8c, 0x4c,
+  0x78, 0x3e, 0x03, 0x6b, 0xed, 0x89, 0xca, 0x5f, 0x46, 0x8a, 0x1e, 0x7f, 0xbc, 0x7b, 0x1d, 0xf8,
+  0xd6, 0xa9, 0x34, 0xa8, 0x9d, 0x62, 0x20, 0x7c, 0xa8, 0xbf, 0xdd, 0x0f, 0xb6, 0x1b, 0x16, 0xfa,
+  0x14, 0x73, 0x61, 0x3b, 0x0d, 0x69, 0x90, 0x6b, 0xda, 0xa0, 0xce, 0x31, 0x1b, 0xe1, 0xed, 0x40,
+  0x6c, 0x13, 0x74, 0xd9, 0x6e, 0x96, 0xad, 0xe4, 0x45, 0x0e, 0x9c, 0x5e, 0xf4, 0xbf, 0x48, 0x0e,
+  0x55, 0x04, 0x5c, 0x55, 0xca, 0xb4, 0x49, 0x9b, 0xf4, 0x23, 0x43, 0x10, 0xf1, 0x86, 0x5e, 0x02,
+  0xbe, 0xd4, 0x46, 0x10, 0x15, 0x48, 0x09, 0x63, 0xae, 0xea, 0xa4, 0x4a, 0x72, 0x94, 0xd2, 0x39,
+  0xc1, 0xda, 0xff, 0x6b, 0x8a, 0x68, 0x26, 0xce, 0x30, 0x0f, 0x20, 0x5c, 0xc3, 0x6b, 0xae, 0x8c,
+  0xc2, 0x56, 0x63, 0xd0, 0x58, 0x46, 0x99, 0xe2, 0xe9, 0x07, 0xd8, 0x2a, 0x93, 0x1b, 0xa7, 0x73,
+  0xb5, 0xd2, 0xbb, 0x02, 0x8f, 0x67, 0x06, 0xbf, 0x6c, 0xa7, 0x93, 0xa1, 0xf4, 0x45, 0xff, 0xe9,
+  0x93, 0x26, 0x30, 0xd6, 0x1e, 0xfe, 0xd8, 0x17, 0xf8, 0xa3, 0xb1, 0xdd, 0x04, 0xad, 0x17, 0x3a,
+  0x27, 0xa4, 0xf4, 0x19, 0x3b, 0xcf, 0x70, 0x67, 0x95, 0x1c, 0x43, 0xa6, 0x6f, 0x21, 0x85, 0x75,
+  0x24, 0x53, 0xf1, 0x06, 0x42, 0x15, 0x67, 0x6b, 0x49, 0x19, 0x01, 0x1b, 0x75, 0xaa, 0xaf, 0xf2,
+  0xbe, 0x29, 0x36, 0x0b, 0xab, 0xd4, 0xde, 0xaf, 0x88, 0x66, 0x95, 0x00, 0x58, 0x19, 0xa8, 0x38,
+  0xe3, 0x00, 0xd6, 0x5d, 0x7d, 0xcf, 0x44, 0x2f, 0x2c, 0x72, 0x5e, 0xf3, 0xde, 0x2c, 0xfd, 0x85,
+  0xcc, 0x00, 0x2c, 0xaf, 0xb0, 0xd8, 0xa7, 0xd7, 0xcd, 0x6f, 0x12, 0xcf, 0x6e, 0x9f, 0xa4, 0x83,
+  0x3f, 0xfa, 0xbd, 0x1f, 0xac, 0x78, 0x36, 0xc8, 0xa2, 0x34, 0xa7, 0x3f, 0x20, 0x8e, 0x9f, 0x64,
+  0x78, 0x2b, 0xff, 0x35, 0xa2, 0xf8, 0xd5, 0x56, 0x0e, 0xfe, 0x94, 0x18, 0xba, 0xed, 0x27, 0x9b,
+  0x05, 0x51, 0xf8, 0x90, 0x3f, 0x20, 0x07, 0x8f, 0x6d, 0x81, 0x56, 0x0d, 0x6f, 0x3f, 0x4f, 0xe0,
+  0xd6, 0xd8, 0xcf, 0xd3, 0x4a, 0x05, 0xa0, 0x1e, 0x41, 0x95, 0xcf, 0x2a, 0x41, 0x98, 0x98, 0xe3,
+  0xdf, 0xb1, 0x79, 0xa7, 0x26, 0xf0, 0xdf, 0x1b, 0x24, 0xb7, 0xdd, 0xea, 0x6d, 0xff, 0x5f, 0x12,
+  0xdc, 0x26, 0x3b, 0x5f, 0x19, 0xdd, 0xeb, 0x3f, 0x2c, 0x77, 0x38, 0xea, 0x25, 0xb1, 0x3b, 0x7a,
+  0x7e, 0x5f, 0x3d, 0xea, 0x84, 0x5c, 0x76, 0xb6, 0xec, 0x22, 0x19, 0x8c, 0x1e, 0xac, 0xd9, 0xa8,
+  0x5a, 0xa2, 0xb8, 0x41, 0x2f, 0x8b, 0x0c, 0x0a, 0xfb, 0x69, 0xa1, 0x98, 0xb7, 0xd2, 0xe7, 0xbe,
+  0x3e, 0xcc, 0x6c, 0xe2, 0xa6, 0x09, 0x0b, 0x87, 0xfd, 0x85, 0x76, 0x35, 0xa7, 0x5c, 0xaf, 0x88,
+  0x35, 0x7e, 0x88, 0x14, 0xa9, 0x81, 0x17, 0xa9, 0xc2, 0x3c, 0x80, 0x20, 0xf8, 0xd9, 0xa6, 0xb9,
+  0xc5, 0xa3, 0x63, 0x68, 0xd3, 0xa1, 0xb8, 0xa7, 0xac, 0xed, 0xe1, 0xb9, 0x67, 0x80, 0xc7, 0x04,
+  0x91, 0x4f, 0xb3, 0x44, 0x8d, 0xb0, 0xed, 0xa0, 0xbb, 0x76, 0x69, 0x25, 0x14, 0xd8, 0x28, 0x97,
+  0x79, 0x91, 0x54, 0x77, 0x49, 0x8b, 0x0d, 0x96, 0x40, 0x24, 0x8e, 0xee, 0x9a, 0x48, 0xb3, 0x45,
+  0xbe, 0x40, 0x8a, 0x4f, 0xc5, 0x42, 0x6d, 0x70, 0x12, 0xe3, 0xad, 0xfc, 0x6b, 0xdc, 0x29, 0x13,
+  0x22, 0x57, 0x76, 0x88, 0x74, 0x78, 0x13, 0x23, 0x79, 0xa9, 0xdb, 0xed, 0x5d, 0x30, 0x72, 0x39,
+  0xd3, 0x1a, 0x13, 0xf2, 0xdc, 0xfe, 0xd9, 0x9c, 0x4a, 0xb3, 0x0d, 0xb2, 0x1e, 0xd2, 0x16, 0xa6,
+  0x93, 0xad, 0x32, 0xb1, 0xf5, 0x00, 0x4b, 0xd9, 0x48, 0x02, 0x9c, 0x6d, 0x9a, 0xfc, 0xee, 0xf4,
+  0x56, 0xad, 0x0f, 0x94, 0x95, 0x72, 0x8d, 0x3e, 0x6f, 0x1c, 0x5e, 0x5a, 0x82, 0x42, 0xf2, 0x75,
+  0x9a, 0xff, 0xb7, 0x4a, 0xf5, 0xc1, 0xda, 0x90, 0xb8, 0x9e, 0xd5, 0x4a, 0xdd, 0xb7, 0xd6, 0x77,
+  0x32, 0x4f, 0xf7, 0x40, 0x15, 0xf7, 0x5b, 0x15, 0x64, 0x21, 0x40, 0xc8, 0x4e, 0xdb, 0x27, 0x50,
+  0xd0, 0x34, 0xf1, 0xac, 0x59, 0xba, 0x72, 0x17, 0xc5, 0x90, 0x75, 0x01, 0x87, 0x58, 0xb4, 0x26,
+  0x9e, 0x17, 0x4f, 0xed, 0x31, 0xf9, 0xf0, 0x0f, 0x67, 0xe2, 0x40, 0xbc, 0x93, 0xef, 0x0e, 0x6d,
+  0x7f, 0x0a, 0x8b, 0x6d, 0xa2, 0xee, 0xf3, 0xb3, 0x05, 0x33, 0x25, 0xf2, 0x30, 0xaf, 0xe8, 0xa7,
+  0x7d, 0x53, 0x06, 0x0f, 0xf3, 0xa6, 0x64, 0xa0, 0xa8, 0x05, 0x1a, 0x8f, 0x5a, 0x7f, 0x29, 0x76,
+  0xf8, 0x85, 0xd3, 0x07, 0xd6, 0xbf, 0xd4, 0xa5, 0xe5, 0x76, 0x09, 0xc7, 0xc2, 0xb7, 0xac, 0x45,
+  0x2a, 0x9e, 0x00, 0x74, 0x9c, 0x38, 0xc0, 0xb5, 0x51, 0xee, 0x8c, 0xed, 0x93, 0x4d, 0xc3, 0x31,
+  0xe5, 0xc6, 0x5b, 0xc5, 0xf6, 0x15, 0xcc, 0x2f, 0xbd, 0xa8, 0x78, 0x5f, 0x7a, 0x51, 0xb2, 0xbd,
+  0xa6, 0x9d, 0x58, 0xad, 0x35, 0xdf, 0xd3, 0xc6, 0x00, 0xc3, 0x90, 0x72, 0xb2, 0x89, 0x1c, 0x08,
+  0x42, 0xdc, 0x77, 0x05, 0x88, 0x05, 0x8a, 0xe7, 0x10, 0x00, 0x40, 0xfd, 0x31, 0xd5, 0x8b, 0xec,
+  0x63, 0x93, 0x30, 0xa1, 0x02, 0xae, 0x1f, 0x87, 0x69, 0x96, 0x37, 0x91, 0x48, 0xe4, 0x6c, 0x74,
+  0x64, 0x64, 0x04, 0xe9, 0x35, 0xe5, 0x1b, 0x31, 0xc3, 0x5e, 0x32, 0x3b, 0x24, 0x31, 0x9a, 0xc3,
+  0xcb, 0x0d, 0x12, 0x37, 0xca, 0xa9, 0x85, 0xba, 0x0d, 0xb3, 0xbc, 0xc8, 0x5e, 0x5e, 0xbc, 0x7f,
+  0x5b, 0x02, 0xf9, 0x8b, 0xf7, 0xbf, 0x12, 0x8c, 0x7f, 0xb2, 0x07, 0x1c, 0xcf, 0x8d, 0x4c, 0xab,
+  0xc2, 0xbf, 0xf8, 0xf9, 0x8a, 0xd3, 0x5e, 0xea, 0xf4, 0x8c, 0xa1, 0xfe, 0x4c, 0xc9, 0x6c, 0x9e,
+  0x52, 0xaa, 0x32, 0x91, 0x04, 0xf9, 0xc7, 0x39, 0x43, 0x7c, 0x65, 0x98, 0x83, 0x9b, 0xa2, 0x54,
+  0xc3, 0x20, 0xfa, 0x22, 0xf9, 0x6d, 0x8a, 0x32, 0x07, 0x75, 0x40, 0xb4, 0xe9, 0xc9, 0xf9, 0x63,
+  0x0d, 0x44, 0x1b, 0x3a, 0xc7, 0xe2, 0xad, 0xcc, 0xa7, 0xed, 0x71, 0xa4, 0x75, 0xea, 0x97, 0x94,
+  0xda, 0x66, 0x6d, 0x03, 0x9d, 0x88, 0x4e, 0xc5, 0x5c, 0xe3, 0xb0, 0x42, 0xe0, 0x88, 0x2c, 0xe5,
+  0xe0, 0x91, 0x0a, 0x23, 0x67, 0xec, 0x28, 0x0a, 0xe1, 0x67, 0xec, 0x7a, 0xdc, 0xe1, 0x50, 0xaf,
+  0x7e, 0x45, 0x22, 0x92, 0xd5, 0xf4, 0x48, 0x6a, 0x7c, 0x12, 0x89, 0xd5, 0xa2, 0xa6, 0x65, 0x6e,
+  0xc7, 0xcc, 0x63, 0xe7, 0xad, 0x31, 0x4c, 0x23, 0xec, 0x36, 0x11, 0x21, 0x74, 0x29, 0x09, 0xd3,
+  0x91, 0x18, 0xba, 0x6d, 0x23, 0x37, 0x2e, 0x2a, 0x15, 0xb6, 0x2a, 0xb1, 0x0d, 0x8a, 0x66, 0x94,
+  0xf8, 0xbe, 0xce, 0xd7, 0x76, 0x72, 0xeb, 0x99, 0xa4, 0x77, 0xbb, 0xa8, 0xe6, 0xa5, 0xa4, 0xda,
+  0xa9, 0x08, 0x41, 0x8a, 0x87, 0x1c, 0xe2, 0xf1, 0x88, 0x27, 0xc3, 0xd3, 0xce, 0x4e, 0xa5, 0xdc,
+  0x3c, 0xdf, 0x8e, 0x99, 0x90, 0x67, 0x08, 0xc5, 0x5f, 0x90, 0xb2, 0x3e, 0x17, 0xdb, 0x45, 0x01,
+  0x85, 0xce, 0x2e, 0xbc, 0x6d, 0xd8, 0xf3, 0xf6, 0x36, 0x4f, 0x86, 0x7c, 0x3b, 0x38, 0xa1, 0xae,
+  0xb4, 0xe6, 0xab, 0xf0, 0xfa, 0xaa, 0x7b, 0x2d, 0x76, 0x96, 0xbc, 0xcf, 0x36, 0xb8, 0x09, 0xca,
+  0x8e, 0x26, 0xff, 0xa5, 0xc4, 0xc0, 0x2f, 0xc6, 0xf4, 0xae, 0x99, 0x96, 0xe9, 0xe6, 0x70, 0x6e,
+  0xfc, 0x92, 0xcb, 0xd4, 0x3a, 0x29, 0xb8, 0xe2, 0x86, 0x4d, 0xb3, 0x0c, 0xbf, 0x2a, 0x94, 0x52,
+  0xbd, 0xda, 0x61, 0x1c, 0xab, 0xf4, 0xd5, 0xe0, 0xed, 0x1b, 0x48, 0x87, 0xa6, 0xb2, 0xe2, 0x27,
+  0x7f, 0xc0, 0xfb, 0x7a, 0x62, 0x64, 0xe6, 0x7a, 0x00, 0x6c, 0x0c, 0x3a, 0x57, 0x24, 0x78, 0x1d,
+  0xbd, 0xeb, 0xb6, 0x1e, 0x8f, 0x61, 0xef, 0x66, 0xd6, 0xc2, 0x9e, 0x89, 0x0e, 0xf9, 0x92, 0xae,
+  0x78, 0xfc, 0x18, 0xc3, 0x10, 0x82, 0x1d, 0xc6, 0x2a, 0x77, 0xef, 0x9a, 0xcd, 0xf4, 0xb0, 0x6a,
+  0x76, 0x35, 0xbe, 0x68, 0xbe, 0xaf, 0x7c, 0x42, 0xcd, 0x59, 0x5f, 0xe8, 0x85, 0xeb, 0xaa, 0x0b,
+  0x0b, 0x61, 0xf1, 0xcc, 0x63, 0xe3, 0x50, 0xae, 0x9c, 0x0e, 0xd7, 0x8e, 0xeb, 0x73, 0x65, 0x78,
+  0x52, 0x1a, 0x7a, 0xc3, 0x0c, 0x4e, 0x74, 0x52, 0xcc, 0xde, 0xe9, 0x48, 0x41, 0x27, 0x81, 0x95,
+  0xcb, 0x08, 0xf4, 0x22, 0x36, 0x15, 0x09, 0x32, 0xe9, 0x29, 0xdc, 0x86, 0x86, 0x63, 0xfa, 0xac,
+  0x54, 0x92, 0x21, 0x9d, 0xd7, 0x9f, 0x29, 0xc2, 0xda, 0xd2, 0x44, 0x46, 0xd5, 0x02, 0xa2, 0x58,
+  0x4e, 0xbb, 0xce, 0x4c, 0x21, 0xab, 0x86, 0x58, 0xf7, 0x62, 0xc7, 0x91, 0x5d, 0x3d, 0x54, 0x39,
+  0x3a, 0x55, 0x5f, 0xba, 0x45, 0x40, 0x19, 0xa2, 0x8f, 0x7d, 0x03, 0x65, 0xf6, 0x62, 0x19, 0x7b,
+  0xc2, 0x26, 0x68, 0xed, 0x5c, 0xff, 0x14, 0xde, 0xaa, 0xc0, 0xef, 0x9b, 0xf0, 0x07, 0x68, 0x60,
+  0x0b, 0x2d, 0xc6, 0x5f, 0xea, 0xf9, 0x68, 0xca, 0xcc, 0x9b, 0x3a, 0xcb, 0x61, 0x55, 0x63, 0x31,
+  0x35, 0x86, 0x02, 0xb4, 0xe0, 0xbd, 0x12, 0x06, 0xde, 0xc4, 0x5c, 0x2a, 0x69, 0x82, 0x94, 0x45,
+  0x35, 0x31, 0x81, 0xaf, 0xa5, 0xaa, 0x09, 0x17, 0x63, 0xa4, 0xd8, 0xed, 0x76, 0x5b, 0xa6, 0x62,
+  0x41, 0x30, 0x97, 0x00, 0x3a, 0x1c, 0x45, 0x96, 0x67, 0x5c, 0xac, 0x00, 0xa0, 0x04, 0xa8, 0x37,
+  0x6e, 0x95, 0x15, 0xe1, 0x3f, 0xe7, 0x6a, 0xae, 0x28, 0xd2, 0x32, 0x14, 0x73, 0x3c, 0xe3, 0x4a,
+  0xd9, 0xe6, 0x4b, 0xb5, 0xb3, 0xce, 0xc8, 0x86, 0x95, 0xc8, 0xe1, 0x56, 0xa5, 0x5c, 0x25, 0x4d,
+  0x42, 0x14, 0x95, 0x4f, 0x4b, 0xe5, 0x18, 0x6d, 0x8b, 0x30, 0xc6, 0xfe, 0xb6, 0x53, 0xf5, 0x1b,
+  0x82, 0x5e, 0x7e, 0x5a, 0x2c, 0xe1, 0x27, 0xae, 0xfb, 0xfc, 0xfd, 0xef, 0x15, 0xe6, 0x1c, 0x3b,
+  0x80, 0x13, 0x36, 0x30, 0x80, 0x96, 0x81, 0x75, 0x7f, 0x0c, 0x88, 0xbe, 0xd7, 0x00, 0xe4, 0xb4,
+  0x33, 0xca, 0xb1, 0x5f, 0x0e, 0xa9, 0xd4, 0x7f, 0xfd, 0xe2, 0xcc, 0x3b, 0x16, 0x75, 0x7b, 0x9e,
+  0x00, 0x98, 0x39, 0x26, 0xb0, 0xc6, 0x2e, 0xee, 0x8b, 0xfd, 0x7b, 0x1f, 0x53, 0x95, 0x1a, 0xd2,
+  0xd3, 0x32, 0x10, 0xd9, 0x54, 0x2f, 0xe8, 0x18, 0x3e, 0x99, 0x66, 0x5b, 0x76, 0x31, 0xd8, 0x57,
+  0x7a, 0x73, 0x2c, 0x96, 0x38, 0x19, 0x01, 0xf3, 0x6b, 0x60, 0x96, 0x48, 0x4f, 0x7c, 0xaa, 0xa8,
+  0xbc, 0xe0, 0x19, 0xa1, 0x1f, 0x6f, 0x34, 0x81, 0xbb, 0x01, 0x87, 0xf8, 0x14, 0xea, 0xec, 0x37,
+  0x78, 0xca, 0xea, 0x78, 0xf5, 0x81, 0x02, 0x4e, 0x55, 0xce, 0xad, 0xc6, 0x90, 0xcf, 0xf8, 0xea,
+  0x18, 0x2e, 0x48, 0xd6, 0xe7, 0x01, 0xe7, 0xc6, 0x18, 0x30, 0xd8, 0x11, 0x00, 0xf5, 0xa9, 0x95,
+  0x97, 0xa8, 0x61, 0x45, 0x40, 0xb4, 0xe6, 0x9f, 0xa8, 0xd2, 0x69, 0x7e, 0x62, 0x8f, 0x5e, 0x53,
+  0x15, 0x1e, 0x36, 0xe0, 0x97, 0xaf, 0x9a, 0xa4, 0x8e, 0x5d, 0x7e, 0x0f, 0x33, 0x98, 0x2a, 0xcc,
+  0x54, 0x5e, 0x57, 0x18, 0x92, 0xdd, 0xaa, 0x74, 0x3b, 0x13, 0x23, 0x39, 0xa2, 0xd8, 0x4d, 0x2f,
+  0x62, 0x4d, 0x58, 0x5e, 0xf8, 0xd9, 0xa2, 0xfd, 0x29, 0xc3, 0x36, 0xdb, 0x4e, 0xd6, 0x76, 0x64,
+  0x14, 0xe9, 0x05, 0xd3, 0x0a, 0x09, 0x7d, 0xc0, 0xbb, 0xe6, 0xf0, 0x09, 0x88, 0x46, 0x11, 0x09,
+  0x74, 0xaa, 0x29, 0xe2, 0x21, 0x87, 0x51, 0x8b, 0xa9, 0x4a, 0x0d, 0x0e, 0xa1, 0xeb, 0x0f, 0x98,
+  0x81, 0x3c, 0xca, 0xab, 0xc1, 0xe0, 0x9c, 0xa7, 0x62, 0xff, 0x91, 0x24, 0x88, 0xc4, 0xe4, 0x36,
+  0x48, 0xa3, 0x3d, 0xba, 0x4a, 0x11, 0x8e, 0xd4, 0xaf, 0x9a, 0xca, 0x39, 0x1e, 0xa1, 0x94, 0x58,
+  0xde, 0x84, 0x13, 0x09, 0xcf, 0xd3, 0xa8, 0x1e, 0xdb, 0xb5, 0x6e, 0xd0, 0xe1, 0x09, 0x7c, 0x13,
+  0x8c, 0xc3, 0xeb, 0x30, 0xbb, 0x24, 0x5c, 0xa8, 0x25, 0x14, 0xe6, 0x25, 0x43, 0x29, 0xbe, 0x8f,
+  0x51, 0x1a, 0x6c, 0xbe, 0xc0, 0xa8, 0xa6, 0x90, 0x99, 0x98, 0x2a, 0x99, 0x06, 0x54, 0x47, 0xe5,
+  0x0b, 0x1a, 0x64, 0x96, 0x7c, 0x16, 0xfe, 0xf3, 0x8b, 0x73, 0x31, 0x9b, 0x47, 0x74, 0x31, 0x01,
+  0x41, 0xc2, 0x87, 0x38, 0x72, 0x89, 0x58, 0xa2, 0x1b, 0x95, 0x51, 0x3a, 0x22, 0x67, 0x05, 0x23,
+  0xb3, 0xba, 0x25, 0x21, 0xd8, 0x92, 0xdd, 0xdf, 0xde, 0xbe, 0x79, 0x85, 0x5f, 0x17, 0xc6, 0xb8,
+  0xcc, 0xbe, 0xf0, 0x7b, 0x6c, 0x34, 0x55, 0x6f, 0xef, 0x32, 0x3a, 0x41, 0x81, 0x01, 0xc4, 0xd0,
+  0xe6, 0x15, 0x75, 0xb5, 0x0e, 0x14, 0x4c, 0xb5, 0xb9, 0x33, 0x1f, 0xb7, 0x50, 0x7c, 0x79, 0x4a,
+  0x86, 0xc9, 0xed, 0x34, 0x7e, 0x9e, 0x51, 0x5b, 0x1f, 0xdb, 0x5a, 0xb3, 0x7d, 0xe2, 0x85, 0x56,
+  0x4c, 0xd0, 0xed, 0x3f, 0x2e, 0xdf, 0xbf, 0xa3, 0x63, 0xd9, 0x4c, 0x15, 0xe4, 0xb2, 0x04, 0xaa,
+  0xa6, 0x06, 0x70, 0x5b, 0x0e, 0x50, 0xb2, 0x60, 0x04, 0x19, 0xe4, 0x2a, 0xac, 0xe8, 0x1a, 0x48,
+  0xc1, 0x14, 0x6d, 0x18, 0x59, 0x82, 0x16, 0x3c, 0x21, 0x7a, 0x72, 0x17, 0x04, 0xfd, 0x43, 0xa7,
+  0x9d, 0xd7, 0x89, 0x77, 0x17, 0x3f, 0xbf, 0xfb, 0x70, 0x39, 0x38, 0x1d, 0xbc, 0xbc, 0xbc, 0xd2,
+  0xed, 0x91, 0x4e, 0xd3, 0x30, 0x90, 0xd7, 0xb4, 0x9a, 0x62, 0x4e, 0xb3, 0x66, 0xdd, 0x0e, 0x54,
+  0x26, 0x53, 0x78, 0x20, 0x0e, 0x15, 0x66, 0x34, 0x82, 0x83, 0x07, 0xd5, 0x20, 0x40, 0x30, 0xb8,
+  0x78, 0x7d, 0xfe, 0xe1, 0xe2, 0xe5, 0x29, 0x96, 0x45, 0x84, 0x6c, 0x67, 0x26, 0x54, 0xfe, 0x22,
+  0x50, 0xe0, 0x35, 0x4a, 0xb2, 0x2e, 0xc6, 0x60, 0xa4, 0x72, 0x24, 0xed, 0x25, 0x21, 0xda, 0x8f,
+  0x83, 0x4e, 0x87, 0x90, 0x86, 0x6e, 0x87, 0x09, 0x61, 0x89, 0x8e, 0x77, 0x62, 0x7e, 0xc6, 0x1a,
+  0x3c, 0x30, 0x70, 0x91, 0x27, 0x16, 0x2e, 0x1d, 0x43, 0x16, 0x14, 0x62, 0xc4, 0xf7, 0x14, 0x61,
+  0x3c, 0xaf, 0xf1, 0x15, 0x34, 0x64, 0x99, 0x5f, 0x6a, 0xd5, 0x6d, 0xe7, 0x94, 0xb3, 0x8c, 0x50,
+  0x3d, 0x46, 0x32, 0xe2, 0xcc, 0xed, 0xba, 0x44, 0x5c, 0x43, 0xe9, 0xf3, 0x0f, 0x1c, 0x50, 0x1e,
+  0x1c, 0x86, 0x8e, 0x89, 0x3d, 0x24, 0xe1, 0x97, 0x7f, 0xd9, 0x80, 0xbd, 0x36, 0xfa, 0xa8, 0xea,
+  0xd0, 0xa4, 0xb1, 0x06, 0x41, 0x09, 0xe3, 0xf0, 0xad, 0x32, 0x27, 0x2a, 0xf6, 0xbd, 0xbf, 0xbe,
+  0x1c, 0x78, 0x4d, 0x61, 0xc6, 0xe1, 0x81, 0x82, 0x8d, 0xa3, 0xf0, 0x19, 0xdc, 0x95, 0x6f, 0x1c,
+  0x78, 0x65, 0x3f, 0xb5, 0xf3, 0x54, 0x28, 0x92, 0x35, 0x21, 0x7b, 0x72, 0xf9, 0x80, 0x03, 0x2d,
+  0xce, 0x70, 0x79, 0x02, 0xf3, 0x83, 0x0b, 0x20, 0x67, 0xe6, 0xf6, 0x16, 0x86, 0xda, 0x46, 0x0c,
+  0x3c, 0xcd, 0xe1, 0xd3, 0xf1, 0x53, 0xf9, 0x4b, 0x47, 0xbe, 0x66, 0xf4, 0x37, 0x99, 0xed, 0x3f,
+  0xc8, 0x6e, 0xeb, 0x16, 0x5a, 0xf6, 0xb2, 0x56, 0x7c, 0x6c, 0xad, 0x98, 0x22, 0x1a, 0x1d, 0xee,
+  0x3e, 0x68, 0xb5, 0xb0, 0x9e, 0x20, 0x9c, 0x68, 0x6b, 0xbd, 0xe4, 0x64, 0xd7, 0xd1, 0x7b, 0xda,
+  0xfd, 0xa1, 0x01, 0x2f, 0xad, 0x20, 0xdf, 0xf5, 0x86, 0xbf, 0xb2, 0x8b, 0xe7, 0xef, 0x2f, 0x79,
+  0x1b, 0x41, 0x23, 0xad, 0xb6, 0x51, 0xac, 0xec, 0x23, 0x0b, 0x0e, 0x01, 0x35, 0x56, 0x23, 0xc0,
+  0x32, 0xda, 0x9b, 0x3c, 0xbd, 0x63, 0x51, 0x71, 0x88, 0x7e, 0x13, 0xde, 0xd0, 0x41, 0xbe, 0x6d,
+  0x67, 0xf0, 0xaa, 0xac, 0x8f, 0x55, 0xa5, 0x23, 0xe6, 0x3c, 0x74, 0xbf, 0x07, 0x2b, 0xca, 0x3f,
+  0xcc, 0xb2, 0x26, 0x59, 0x44, 0x13, 0xda, 0xcd, 0xca, 0xdd, 0x4c, 0xf4, 0x42, 0xa5, 0x4d, 0x8b,
+  0x36, 0x9b, 0xd8, 0xc2, 0xa4, 0x99, 0xce, 0xe3, 0xe6, 0x3c, 0x1f, 0x79, 0x04, 0xbc, 0x38, 0x1b,
+  0x86, 0xf3, 0x8e, 0xe7, 0xb3, 0x21, 0xc5, 0x23, 0x4a, 0x8c, 0xb1, 0x00, 0xba, 0x83, 0xf1, 0x91,
+  0xee, 0x05, 0x21, 0x82, 0x91, 0x13, 0xcf, 0x53, 0x19, 0x67, 0x3c, 0x0f, 0x22, 0xd4, 0x88, 0x30,
+  0x0d, 0xf9, 0x76, 0x06, 0x5c, 0xb6, 0x77, 0x79, 0x92, 0x53, 0x81, 0x30, 0x02, 0x02, 0x69, 0xad,
+  0xdd, 0xb2, 0xf1, 0x8e, 0x60, 0x1e, 0xfb, 0x42, 0x84, 0xbc, 0x8f, 0x59, 0x08, 0x10, 0xf8, 0x91,
+  0xdd, 0x64, 0x89, 0x01, 0x3b, 0x05, 0x3c, 0xb6, 0x80, 0x8a, 0x47, 0xbf, 0x7a, 0x7d, 0x39, 0x78,
+  0x7f, 0xf1, 0x5f, 0xd5, 0x11, 0xd9, 0xae, 0x3d, 0x22, 0x2b, 0x85, 0x81, 0xcd, 0x89, 0x33, 0x13,
+  0x85, 0x0b, 0x90, 0xc8, 0x70, 0x1b, 0xf1, 0xc8, 0x3d, 0x73, 0xf3, 0xdf, 0x0c, 0x06, 0x3f, 0x3a,
+  0xf1, 0x67, 0x55, 0xfe, 0xac, 0x80, 0x9d, 0x8e, 0x3d, 0xd9, 0xb2, 0xc5, 0x62, 0xc8, 0xcd, 0x9c,
+  0x1e, 0x4e, 0x11, 0x66, 0x55, 0x4c, 0x1b, 0xa1, 0xc0, 0xb5, 0x82, 0xa3, 0x4d, 0x49, 0x56, 0x11,
+  0x9c, 0xe5, 0x42, 0xe1, 0xff, 0x68, 0x0a, 0xc2, 0xcc, 0x52, 0x55, 0x41, 0x93, 0x69, 0xf1, 0xa9,
+  0x20, 0xc7, 0x6e, 0x5b, 0xfc, 0xa1, 0x5a, 0x44, 0x4c, 0x11, 0x3c, 0xe3, 0x8c, 0xe0, 0x4e, 0xc0,
+  0xc8, 0xe8, 0x21, 0xe4, 0x43, 0x35, 0x7b, 0x3c, 0x97, 0x6b, 0x6d, 0x31, 0xc9, 0xb9, 0x19, 0xc6,
+  0x20, 0xe4, 0x95, 0x91, 0x8e, 0x01, 0x28, 0xa4, 0x61, 0x06, 0xce, 0x32, 0xe4, 0x62, 0x2b, 0x23,
+  0x1d, 0x7e, 0xe4, 0x7b, 0xbf, 0xaa, 0xe1, 0xa5, 0x1e, 0x7d, 0x86, 0x23, 0xa1, 0x8d, 0x35, 0xb0,
+  0xae, 0x51, 0x58, 0x17, 0x0f, 0x44, 0x48, 0xc7, 0x0a, 0x0b, 0x68, 0x58, 0x99, 0xd5, 0x7d, 0xe1,
+  0x44, 0xb8, 0x66, 0x41, 0xd6, 0x5c, 0xd2, 0xf2, 0xbd, 0x45, 0x06, 0x47, 0x4f, 0x11, 0x84, 0xf0,
+  0x09, 0x49, 0xb0, 0x4d, 0x18, 0x85, 0x6e, 0x81, 0x52, 0xb0, 0x38, 0xd8, 0xef, 0x75, 0x8c, 0x4f,
+  0xe0, 0x50, 0x66, 0x24, 0xe5, 0x80, 0x55, 0x53, 0x4b, 0x08, 0xd4, 0xc8, 0x12, 0x2e, 0xc5, 0x7e,
+  0x46, 0x8d, 0x86, 0x15, 0xe4, 0x52, 0xc3, 0x30, 0x96, 0xe9, 0xdd, 0x80, 0xee, 0xbd, 0x22, 0x62,
+  0x71, 0x52, 0x31, 0x9c, 0x8f, 0xc7, 0xc0, 0x31, 0xb6, 0x83, 0x8e, 0x89, 0xf6, 0x92, 0xdf, 0xa8,
+  0xe6, 0x63, 0x94, 0x6e, 0x0c, 0x93, 0x3b, 0xcf, 0x54, 0x96, 0xc9, 0xba, 0x9f, 0x51, 0x37, 0x79,
+  0xcd, 0xd5, 0x60, 0x2e, 0x6c, 0x35, 0x5a, 0xdb, 0x5c, 0xdd, 0xa4, 0x2a, 0x70, 0xc6, 0x40, 0xd6,
+  0xab, 0x87, 0x67, 0x73, 0x9a, 0x7b, 0x6c, 0x56, 0xd1, 0xa6, 0x0b, 0x51, 0x81, 0x62, 0x24, 0xfc,
+  0x33, 0xb6, 0x6c, 0xff, 0x94, 0x58, 0xf5, 0x0b, 0x2a, 0x8d, 0x86, 0x1b, 0x91, 0x79, 0x64, 0xc3,
+  0xb1, 0x19, 0x6e, 0x70, 0x03, 0x49, 0xe9, 0x82, 0x0a, 0x02, 0x6d, 0x02, 0xf6, 0xa7, 0xb9, 0x0f,
+  0x8f, 0x06, 0x4f, 0xe4, 0x7d, 0x01, 0x2f, 0x70, 0x98, 0x41, 0xa4, 0x78, 0xeb, 0x5c, 0xef, 0xb6,
+  0x3c, 0x25, 0x93, 0xaa, 0xa6, 0xe2, 0x4e, 0x9c, 0x90, 0x54, 0x3d, 0x4b, 0xdf, 0xc5, 0x22, 0x1a,
+  0x45, 0x3a, 0xdb, 0xe8, 0x88, 0x8d, 0x60, 0x1b, 0x6e, 0xd2, 0xb2, 0x6c, 0x37, 0x4d, 0x72, 0xbc,
+  0x80, 0xc5, 0xa6, 0x80, 0x6d, 0xdf, 0x56, 0xac, 0xd4, 0x15, 0xee, 0xa1, 0xfa, 0x2d, 0xc6, 0xc7,
+  0xba, 0xd2, 0x38, 0x83, 0x36, 0x09, 0x54, 0x62, 0xb0, 0xe1, 0x98, 0xbd, 0xe3, 0x8f, 0xac, 0x22,
+  0x8e, 0x7f, 0xf4, 0x17, 0x6a, 0x98, 0xf1, 0x10, 0x46, 0x98, 0x07, 0xe2, 0x0a, 0x59, 0x75, 0x40,
+  0xa5, 0xd8, 0xdf, 0x9a, 0x62, 0x5f, 0xfc, 0x1e, 0x4e, 0x7e, 0x97, 0x13, 0xda, 0x42, 0x32, 0xeb,
+  0xeb, 0x26, 0x92, 0xef, 0x3b, 0xb3, 0x03, 0x19, 0xa8, 0x8d, 0xa0, 0x63, 0xc6, 0xb1, 0xda, 0x03,
+  0x49, 0x11, 0xa8, 0x08, 0x6a, 0x60, 0x3a, 0x14, 0xe9, 0x2c, 0x85, 0x2a, 0xf6, 0x58, 0xd6, 0x96,
+  0xd5, 0x4d, 0xa8, 0x11, 0x24, 0xb8, 0x53, 0x1b, 0x54, 0x2e, 0xd8, 0x84, 0x4c, 0x77, 0xa3, 0x27,
+  0x8e, 0x77, 0xf5, 0x2b, 0xb4, 0xa2, 0xa8, 0xd0, 0x0b, 0xaf, 0xa1, 0xe2, 0xca, 0x97, 0x4f, 0xa9,
+  0x2b, 0x80, 0x73, 0xa3, 0x09, 0xf0, 0x0f, 0x5a, 0xe4, 0x38, 0xc5, 0x3c, 0xce, 0xc3, 0x08, 0x09,
+  0x70, 0xc9, 0xab, 0xad, 0x0b, 0x4a, 0x31, 0x91, 0x49, 0xe5, 0xc3, 0x96, 0xad, 0x88, 0x77, 0x8e,
+  0x83, 0x55, 0x79, 0x1d, 0x80, 0x34, 0x14, 0xb9, 0xcc, 0x93, 0xbe, 0xd1, 0xd0, 0x7d, 0x93, 0x34,
+  0x51, 0x97, 0x71, 0xa8, 0xa2, 0xe0, 0xe1, 0x2e, 0xa0, 0x12, 0xd6, 0xcc, 0xd8, 0x84, 0x48, 0xf5,
+  0x1b, 0xda, 0x5a, 0x3d, 0xda, 0x90, 0x3a, 0x07, 0x6d, 0xb8, 0xb9, 0x5c, 0x93, 0x49, 0x59, 0x03,
+  0x71, 0xf5, 0x6a, 0x58, 0xe1, 0x7c, 0x5a, 0x16, 0x60, 0x06, 0x95, 0xc3, 0xa0, 0xde, 0xbd, 0xc3,
+  0xc2, 0x79, 0x51, 0xfb, 0xe3, 0xc7, 0x78, 0x70, 0x66, 0x07, 0x2e, 0x1d, 0x5e, 0xf5, 0xae, 0xc9,
+  0x30, 0x7d, 0xbf, 0x9c, 0x7f, 0x47, 0x00, 0xb8, 0x3d, 0x16, 0xdd, 0xdb, 0xf1, 0xb8, 0x51, 0x3a,
+  0xb7, 0xf5, 0x3c, 0x97, 0x85, 0x0e, 0x13, 0x92, 0x8c, 0xcd, 0x99, 0xc2, 0xa8, 0x15, 0x80, 0x23,
+  0x8e, 0x66, 0x59, 0xf1, 0xec, 0x36, 0x45, 0x6c, 0xfe, 0xc3, 0xb5, 0x21, 0x0e, 0x5d, 0x5b, 0x4b,
+  0xc0, 0xbe, 0x6f, 0x80, 0xfd, 0xb0, 0xa8, 0x0d, 0x81, 0x77, 0x33, 0xfc, 0x48, 0xec, 0xd7, 0x10,
+  0x7e, 0x4c, 0xf0, 0xd9, 0x1f, 0x02, 0xd9, 0x33, 0xd3, 0xcf, 0xc6, 0x54, 0x83, 0xe3, 0xfa, 0x26,
+  0x42, 0xb5, 0xdf, 0xb7, 0x73, 0x14, 0x15, 0x7d, 0x9e, 0x0f, 0x03, 0x9e, 0x55, 0x58, 0xa7, 0x1c,
+  0xba, 0x0f, 0x97, 0x40, 0x37, 0xb4, 0xc2, 0xb8, 0xa8, 0x47, 0x18, 0xc6, 0xaf, 0x78, 0xe2, 0x9d,
+  0x1d, 0x48, 0x54, 0xf8, 0x31, 0x15, 0x26, 0xa9, 0x98, 0xd3, 0xc2, 0x23, 0x8b, 0xaa, 0x23, 0xfa,
+  0x40, 0xdc, 0x31, 0xfd, 0xf7, 0xd0, 0x72, 0x64, 0x17, 0x24, 0xea, 0xeb, 0xbb, 0xb7, 0x7b, 0x61,
+  0xd6, 0x01, 0xa1, 0xef, 0xd3, 0x0e, 0x84, 0xf4, 0x54, 0x2c, 0xb3, 0xb1, 0x2c, 0x50, 0xbe, 0x7f,
+  0x52, 0xc8, 0xd1, 0x68, 0x5e, 0x4d, 0x54, 0x9f, 0x4c, 0xdc, 0xff, 0x64, 0xc4, 0xf2, 0x89, 0xc4,
+  0x72, 0x73, 0xf5, 0x89, 0x38, 0xa5, 0x0d, 0x7f, 0x5e, 0xac, 0x00, 0x2d, 0x07, 0xe6, 0xc5, 0x4e,
+  0xd5, 0xb4, 0xa2, 0x8b, 0x45, 0x21, 0xc6, 0x51, 0x45, 0xd2, 0x0f, 0x93, 0xd6, 0x33, 0x5b, 0x57,
+  0x37, 0xa4, 0x58, 0x27, 0x27, 0x27, 0xb4, 0x79, 0xfe, 0x0d, 0x29, 0x0f, 0xb4, 0xac, 0xd5, 0xef,
+  0x3d, 0x7d, 0xf6, 0x74, 0xff, 0xc9, 0xde, 0xd3, 0x7d, 0x92, 0x0c, 0x19, 0x22, 0xcd, 0x86, 0x97,
+  0x1d, 0xba, 0x04, 0xdf, 0xc4, 0x73, 0xdf, 0x3c, 0xd3, 0xe3, 0x93, 0xda, 0x21, 0xff, 0xcd, 0xd5,
+  0xd3, 0x6b, 0x6a, 0xdd, 0xe5, 0x3f, 0xf7, 0xf8, 0xcf, 0x67, 0x76, 0x8a, 0xeb, 0x22, 0x51, 0x26,
+  0x5c, 0x58, 0xf8, 0x0d, 0xff, 0xf2, 0xf2, 0x25, 0xd9, 0x33, 0x0c, 0xb6, 0x72, 0x68, 0x74, 0x59,
+  0x83, 0x8e, 0xa1, 0x19, 0xaa, 0x18, 0x2f, 0xc6, 0xc1, 0xa4, 0xe1, 0x78, 0x0b, 0xa7, 0x66, 0x59,
+  0x79, 0x6e, 0x42, 0xdd, 0x95, 0xf1, 0x50, 0xe5, 0x89, 0x5a, 0xda, 0x19, 0xd2, 0x7e, 0x04, 0xe6,
+  0xa6, 0x89, 0xbb, 0xeb, 0x32, 0xce, 0x71, 0x3d, 0xdb, 0x1c, 0x93, 0x12, 0x15, 0x31, 0x01, 0x90,
+  0x22, 0xf7, 0xa9, 0xa5, 0xe1, 0x88, 0x6e, 0x5c, 0x55, 0xf9, 0x54, 0xb1, 0x16, 0x30, 0x77, 0x49,
+  0x5f, 0x67, 0xa4, 0xad, 0x4b, 0x4a, 0x0f, 0x8c, 0x2f, 0x27, 0xef, 0xdc, 0x51, 0xfc, 0x78, 0xe8,
+  0x56, 0x40, 0x44, 0x19, 0x02, 0xf8, 0x76, 0x55, 0x98, 0x67, 0x2a, 0x1a, 0x3b, 0x95, 0x38, 0x37,
+  0x1a, 0xf0, 0x8a, 0x2c, 0x68, 0xe1, 0xb6, 0x4b, 0x3d, 0x4f, 0x47, 0x6a, 0x23, 0x6c, 0x39, 0xd7,
+  0x51, 0x64, 0xd1, 0xce, 0x32, 0x6e, 0x31, 0x92, 0x29, 0x1d, 0x9e, 0x43, 0xcd, 0xf7, 0x0c, 0x97,
+  0x46, 0x48, 0xea, 0x41, 0x50, 0xf0, 0xb5, 0xb8, 0x69, 0xa2, 0x26, 0x68, 0xc8, 0x20, 0xe0, 0x29,
+  0xde, 0x50, 0xcd, 0x24, 0xa6, 0xaa, 0x09, 0x4f, 0xa2, 0x81, 0xf9, 0x97, 0x49, 0x7e, 0x3d, 0x6c,
+  0x73, 0x6d, 0xce, 0xb2, 0xa6, 0xd2, 0x54, 0xa7, 0x9b, 0x82, 0xb1, 0xaa, 0xe5, 0x44, 0x50, 0x69,
+  0x67, 0x99, 0xed, 0xb3, 0x37, 0xef, 0x2f, 0x5f, 0xbe, 0x68, 0x2c, 0x4b, 0xca, 0x44, 0xe5, 0xf1,
+  0x3c, 0x03, 0x22, 0x15, 0xaa, 0x3d, 0x69, 0xd3, 0xb9, 0xf2, 0x38, 0x55, 0x88, 0x67, 0x91, 0xce,
+  0x9d, 0xb0, 0x7a, 0x56, 0x15, 0x6d, 0x9d, 0x82, 0x2d, 0x7a, 0x72, 0xf2, 0x51, 0xde, 0x6e, 0xcb,
+  0x68, 0x7b, 0x83, 0xe2, 0x9b, 0x1c, 0x55, 0x1e, 0xa4, 0x31, 0xa2, 0xb1, 0xe7, 0x67, 0xfc, 0xc3,
+  0x16, 0xaa, 0x2a, 0x50, 0x5b, 0x7e, 0xf9, 0xc3, 0xa0, 0x19, 0x86, 0x41, 0xc8, 0x3a, 0xa4, 0x1b,
+  0x7b, 0x74, 0x77, 0xaa, 0xae, 0x21, 0x0e, 0xb2, 0x2d, 0x95, 0xc4, 0x4d, 0x2f, 0x1e, 0x99, 0xfc,
+  0xc2, 0x4d, 0x09, 0xeb, 0xd9, 0x87, 0x5b, 0xc0, 0x5b, 0x2b, 0xcb, 0x72, 0xa7, 0x57, 0x29, 0xd9,
+  0x0a, 0xef, 0x3c, 0x8e, 0xad, 0x2a, 0x98, 0xae, 0x55, 0xfd, 0x7f, 0x8f, 0xfc, 0xbc, 0x6d, 0x85,
+  0x33, 0x10, 0x27, 0x08, 0x61, 0x4b, 0x4d, 0x47, 0xc7, 0xe2, 0x89, 0xa1, 0x05, 0x55, 0x31, 0x25,
+  0xf3, 0x62, 0x4a, 0x78, 0x9c, 0xa6, 0x3d, 0x99, 0x24, 0x6e, 0x8b, 0x66, 0x84, 0xff, 0x62, 0xca,
+  0xe7, 0x25, 0xa5, 0xfe, 0xb5, 0x39, 0x1b, 0x76, 0x8e, 0x22, 0x56, 0xb8, 0x41, 0x62, 0x5c, 0xcf,
+  0xb0, 0x8a, 0xc1, 0x4f, 0xaf, 0x1f, 0x18, 0xb5, 0x6b, 0x52, 0xe5, 0x01, 0x52, 0xc3, 0x92, 0xb1,
+  0xdd, 0xeb, 0x87, 0xe6, 0xd9, 0xab, 0x92, 0xeb, 0x6a, 0xa1, 0x76, 0xc0, 0x72, 0x3a, 0xc8, 0x77,
+  0x76, 0x7a, 0xa6, 0x5a, 0xca, 0xda, 0x35, 0xb0, 0x68, 0xc7, 0x6a, 0xc5, 0xcf, 0x83, 0x33, 0x31,
+  0xa2, 0x8f, 0x05, 0x68, 0x5b, 0x23, 0x3d, 0x09, 0x35, 0x43, 0x37, 0x7b, 0x6d, 0xc3, 0x80, 0x2c,
+  0x56, 0x1a, 0x86, 0x4a, 0x61, 0xce, 0x20, 0x09, 0xd6, 0x41, 0xc9, 0x2b, 0xdd, 0xd2, 0xe4, 0x92,
+  0x64, 0xe1, 0x71, 0x48, 0x67, 0x55, 0x55, 0xa4, 0x94, 0x13, 0x68, 0xf7, 0xa1, 0xf0, 0xba, 0x9e,
+  0x98, 0x29, 0x24, 0xb0, 0xa4, 0xf0, 0x97, 0xef, 0x06, 0xe7, 0xe2, 0x4e, 0xe5, 0x8e, 0x9a, 0x55,
+  0x1b, 0x60, 0xe1, 0x79, 0xe1, 0x5e, 0x91, 0x24, 0x53, 0x08, 0x35, 0xd8, 0xae, 0x5c, 0xfd, 0x33,
+  0x8a, 0x19, 0xdc, 0x46, 0x8e, 0xff, 0xc0, 0xc4, 0x4a, 0xeb, 0x34, 0x7d, 0x1a, 0xc2, 0xc5, 0xb6,
+  0xe7, 0xa2, 0x2c, 0x8d, 0x53, 0xdb, 0xf7, 0x46, 0x06, 0x6b, 0x8b, 0xe4, 0xa0, 0x41, 0x37, 0x54,
+  0xc7, 0x61, 0x4c, 0xdf, 0x15, 0x18, 0x64, 0x5b, 0xa4, 0xaf, 0xd5, 0x57, 0x70, 0x71, 0x2b, 0x50,
+  0x54, 0xa5, 0x15, 0x34, 0xc8, 0xdc, 0xd1, 0xb4, 0xc9, 0x31, 0xe5, 0xa7, 0xbd, 0x6e, 0x6b, 0x78,
+  0x97, 0xd3, 0x65, 0xa7, 0x3c, 0x8f, 0x54, 0x8b, 0x36, 0x41, 0xc6, 0x5b, 0x06, 0x86, 0xa7, 0x40,
+  0x36, 0xfe, 0xfc, 0x49, 0x5f, 0xf0, 0x47, 0x72, 0x4d, 0x31, 0xef, 0xed, 0x89, 0xfc, 0x03, 0xf0,
+  0x4d, 0x48, 0x0f, 0xf0, 0x1b, 0x53, 0x4e, 0x71, 0x25, 0xf0, 0x2e, 0x09, 0x0c, 0x1d, 0xf6, 0x85,
+  0x29, 0x1b, 0xd0, 0x53, 0x17, 0xea, 0x28, 0xe9, 0x9e, 0xec, 0x0c, 0x39, 0xde, 0x72, 0x0e, 0x6e,
+  0x32, 0xe3, 0x59, 0x79, 0xb3, 0x95, 0xee, 0x88, 0x96, 0xb9, 0x32, 0xed, 0xd4, 0x90, 0xbe, 0x4c,
+  0x31, 0x76, 0xed, 0xa6, 0xf0, 0x17, 0x2f, 0xcf, 0xde, 0x5f, 0xbc, 0x80, 0x70, 0x7b, 0xdd, 0xc3,
+  0x7a, 0x1d, 0xd8, 0xa6, 0xb6, 0xff, 0xa6, 0x95, 0x60, 0xce, 0x0b, 0x8f, 0x8b, 0xad, 0x95, 0x74,
+  0xd8, 0x50, 0xaf, 0x08, 0x6d, 0x3a, 0x2f, 0x37, 0x87, 0xed, 0x9c, 0xcf, 0xd1, 0x3e, 0xbd, 0x31,
+  0xca, 0xd4, 0x59, 0x12, 0x88, 0x63, 0x74, 0x76, 0xf4, 0xb1, 0x58, 0xe2, 0xa2, 0xd3, 0x61, 0xcb,
+  0x30, 0xd7, 0x93, 0xad, 0x65, 0x14, 0x1e, 0x78, 0x21, 0xa3, 0xa8, 0x65, 0x8c, 0x89, 0x4e, 0x2f,
+  0xc9, 0x5a, 0x16, 0xd8, 0x83, 0x5c, 0x7e, 0x56, 0xb1, 0x45, 0xb3, 0x64, 0x9a, 0x54, 0x1b, 0x29,
+  0x8f, 0x25, 0x4a, 0x76, 0x63, 0xbe, 0x9d, 0x4b, 0x0a, 0xdb, 0xc6, 0xa3, 0xdf, 0x58, 0x39, 0xb5,
+  0x67, 0xe6, 0x27, 0x2a, 0xa7, 0x24, 0xb7, 0xb7, 0xe7, 0x5b, 0x0e, 0x5b, 0x04, 0x29, 0xbf, 0x5f,
+  0xde, 0xd8, 0x1d, 0xf1, 0xd4, 0x29, 0x5d, 0x72, 0xe4, 0xa1, 0xe2, 0x09, 0x31, 0xd5, 0x2a, 0x0b,
+  0x20, 0xf4, 0xf3, 0xa0, 0x48, 0xa3, 0xa6, 0x4a, 0xd2, 0xf5, 0x0b, 0x53, 0x50, 0x71, 0xcb, 0x24,
+  0x66, 0x3d, 0x1c, 0x0b, 0x54, 0x50, 0xf2, 0x64, 0x47, 0xd4, 0xee, 0xd2, 0x30, 0x9f, 0x25, 0x79,
+  0xae, 0x0c, 0xeb, 0x0f, 0x59, 0x61, 0xa1, 0xeb, 0x61, 0x11, 0x2f, 0x62, 0x4d, 0x05, 0x9e, 0x49,
+  0x87, 0x2b, 0x0b, 0x73, 0x8b, 0xf1, 0x6b, 0x64, 0x22, 0xf3, 0x95, 0x95, 0xbb, 0x6e, 0xbf, 0xe8,
+  0xfd, 0xba, 0xea, 0xbc, 0x67, 0x3b, 0x5b, 0xb4, 0x59, 0xfa, 0x0c, 0xda, 0x8d, 0x96, 0x3d, 0x58,
+  0x6f, 0x09, 0x3e, 0xa7, 0xdf, 0xec, 0x40, 0xd6, 0x5c, 0x42, 0x5c, 0xbe, 0x60, 0x74, 0x69, 0xaf,
+  0xd7, 0xf8, 0x46, 0x42, 0x2c, 0xbc, 0x46, 0x2d, 0xa2, 0xdc, 0x57, 0x9a, 0x60, 0x83, 0x07, 0xa1,
+  0x93, 0xd7, 0xb1, 0x2d, 0x79, 0x82, 0xed, 0x0b, 0xab, 0xe3, 0xaf, 0x60, 0x3b, 0x04, 0x74, 0xfe,
+  0xd6, 0x3a, 0x4f, 0xf5, 0x6d, 0x38, 0xd3, 0x5e, 0xc3, 0x51, 0xdc, 0x47, 0xe6, 0x10, 0x99, 0x88,
+  0x34, 0x96, 0xe3, 0x11, 0x35, 0x3e, 0x54, 0xf4, 0xb6, 0xbd, 0x9f, 0x9b, 0x63, 0xea, 0x63, 0x20,
+  0xe3, 0xc7, 0x9c, 0x6b, 0x1f, 0x53, 0xb1, 0xc9, 0x25, 0xb5, 0x23, 0xbc, 0xc7, 0xa6, 0x98, 0xc7,
+  0xaf, 0xea, 0x5e, 0x69, 0xa5, 0x68, 0x5e, 0x96, 0x6b, 0x37, 0x14, 0x93, 0x56, 0x4a, 0xeb, 0x9d,
+  0xce, 0xe9, 0x88, 0xbe, 0x6d, 0x29, 0xe5, 0x68, 0x62, 0x8e, 0x39, 0xda, 0x16, 0x3e, 0xb8, 0x15,
+  0x1d, 0x40, 0x20, 0xbc, 0xea, 0x8c, 0xe6, 0x40, 0x16, 0x8d, 0x03, 0xf1, 0xc5, 0xb3, 0x57, 0xb8,
+  0x68, 0x1d, 0x56, 0xf5, 0xb8, 0xc2, 0xea, 0x61, 0xea, 0x5c, 0x67, 0xde, 0x81, 0xb8, 0x62, 0xa7,
+  0x6b, 0x1c, 0x6e, 0x53, 0xb4, 0xdb, 0xed, 0x6b, 0x84, 0xc6, 0xb1, 0xca, 0xe9, 0x48, 0xda, 0x84,
+  0x37, 0x83, 0x84, 0x58, 0xd7, 0x81, 0xa5, 0x23, 0xe2, 0xc0, 0x7e, 0xcd, 0xe0, 0xd6, 0x27, 0xc2,
+  0xb4, 0x8e, 0xa7, 0x9a, 0xc5, 0x89, 0x5b, 0x74, 0xc7, 0x37, 0x57, 0xb3, 0xe2, 0x3a, 0x12, 0xdf,
+  0x36, 0x2b, 0x0e, 0xdf, 0x8b, 0x8a, 0xa8, 0x29, 0xda, 0xda, 0x75, 0xad, 0x5c, 0xbf, 0x77, 0x2b,
+  0x8d, 0x01, 0x95, 0x22, 0xfe, 0xa9, 0x6e, 0xf8, 0xdb, 0x0a, 0xfb, 0x15, 0xf3, 0xdf, 0x70, 0x20,
+  0x47, 0x8b, 0xf0, 0x1b, 0x0f, 0x29, 0x9d, 0xbb, 0x91, 0x0f, 0x1e, 0xb8, 0xb8, 0x9f, 0x4d, 0xe4,
+  0x16, 0xfe, 0x66, 0xd5, 0x8d, 0x0e, 0xcb, 0x56, 0x93, 0x5a, 0x54, 0x9a, 0xe8, 0x08, 0xab, 0x0a,
+  0xb0, 0x89, 0x9f, 0x95, 0x38, 0xe7, 0x29, 0x2e, 0x14, 0x7d, 0x41, 0xfc, 0xe1, 0xfc, 0x75, 0x9f,
+  0x3e, 0xc1, 0xa0, 0xac, 0x73, 0x5d, 0x4d, 0x98, 0x0b, 0xeb, 0x55, 0xea, 0xb7, 0x6c, 0xbe, 0xd5,
+  0x86, 0x24, 0x95, 0xf3, 0x6b, 0x1b, 0x1d, 0x2b, 0x8a, 0x27, 0x39, 0x81, 0xce, 0x32, 0x6e, 0x88,
+  0xa4, 0xc8, 0x6c, 0x39, 0x05, 0xb0, 0xc6, 0x4f, 0x81, 0xc0, 0x32, 0x1e, 0xc6, 0x61, 0x1e, 0xca,
+  0xc8, 0xf9, 0x60, 0x50, 0x6d, 0xa8, 0x6e, 0x24, 0x55, 0x12, 0x49, 0x45, 0x89, 0x7e, 0x6d, 0x3f,
+  0x81, 0x7b, 0x12, 0xca, 0x21, 0x97, 0x6a, 0x12, 0x7c, 0x6e, 0x99, 0x48, 0x2a, 0x32, 0xd0, 0x6b,
+  0x72, 0x3f, 0x57, 0x21, 0xfe, 0xec, 0x5f, 0xd7, 0x2a, 0x32, 0x3e, 0xf7, 0x39, 0xe1, 0x43, 0x41,
+  0xd3, 0xa1, 0x47, 0xc9, 0xbf, 0x4f, 0xcf, 0x3b, 0xf4, 0xdc, 0x2a, 0x9b, 0xc9, 0x19, 0x1a, 0x3f,
+  0x66, 0x09, 0x91, 0xf7, 0xe4, 0xe1, 0x07, 0xa2, 0xe8, 0x6e, 0x1c, 0x6a, 0x91, 0x11, 0xda, 0x39,
+  0xf8, 0x6a, 0xa5, 0x7b, 0x1d, 0xa6, 0x9e, 0x21, 0xf1, 0x62, 0x1e, 0x4c, 0x17, 0x48, 0x7e, 0xe2,
+  0x0c, 0x51, 0x16, 0x96, 0xea, 0x5c, 0xb6, 0x4b, 0x54, 0xce, 0x9f, 0xc2, 0x45, 0xf6, 0x2b, 0x8c,
+  0x1e, 0xb2, 0x64, 0xce, 0x8d, 0x42, 0x4b, 0xc9, 0x0e, 0x86, 0x0f, 0x25, 0xd4, 0x50, 0x5e, 0xc4,
+  0x68, 0x8a, 0xdd, 0x5d, 0xae, 0x97, 0x76, 0x3a, 0xe4, 0xdc, 0x67, 0x97, 0x56, 0xa5, 0xcc, 0x25,
+  0x0e, 0x91, 0xd2, 0x1f, 0x35, 0x7e, 0xdd, 0xaf, 0x0d, 0xcd, 0x39, 0x5f, 0x59, 0x81, 0x27, 0xf0,
+  0x2c, 0x83, 0xe2, 0xe4, 0x68, 0xe3, 0x89, 0x9f, 0xfd, 0x60, 0xb0, 0xd1, 0xe6, 0xfb, 0x61, 0x6d,
+  0x7b, 0x1b, 0x9b, 0x9c, 0x22, 0x15, 0x1e, 0xc9, 0x1b, 0x56, 0xb3, 0x55, 0x81, 0xeb, 0xf4, 0xc5,
+  0xd9, 0x2f, 0xe6, 0x52, 0xab, 0xb9, 0x15, 0x55, 0xde, 0x2c, 0x2d, 0x53, 0x32, 0x0e, 0xed, 0xc7,
+  0xb0, 0xd0, 0x12, 0xc9, 0x36, 0x4c, 0xb8, 0x3f, 0x16, 0x5f, 0xb9, 0x22, 0x52, 0x28, 0x6d, 0x79,
+  0xdb, 0x74, 0x89, 0x4a, 0xd5, 0x5e, 0x5c, 0x8d, 0x5d, 0xbe, 0x6f, 0x5b, 0x71, 0x57, 0xbb, 0xf1,
+  0x5a, 0xbf, 0xe9, 0x55, 0x74, 0x32, 0x67, 0x26, 0x4b, 0xb7, 0x80, 0xac, 0x79, 0xdb, 0x7a, 0x46,
+  0xa0, 0x72, 0x3e, 0xb7, 0x29, 0x2e, 0x39, 0x70, 0x2e, 0xe1, 0x9b, 0xb4, 0x3e, 0xb3, 0x85, 0xe5,
+  0x2f, 0x65, 0x9a, 0xef, 0x99, 0x13, 0x44, 0x3c, 0xdc, 0xd0, 0x37, 0x84, 0xf8, 0x2f, 0x9d, 0xc2,
+  0x79, 0xf7, 0x95, 0x1c, 0xdd, 0xbc, 0x5f, 0xdd, 0x54, 0x32, 0x53, 0x37, 0x6d, 0x43, 0x84, 0x0b,
+  0xfb, 0xfc, 0x85, 0x66, 0x79, 0xd0, 0x50, 0x6e, 0x20, 0x3c, 0x6c, 0x7a, 0x77, 0xc9, 0x7f, 0x9b,
+  0x04, 0x00, 0xa4, 0x57, 0x7c, 0x90, 0x9c, 0x60, 0x0b, 0xeb, 0x27, 0xb5, 0xde, 0x86, 0x4f, 0x3d,
+  0xcd, 0x59, 0x3f, 0xe6, 0x62, 0xf6, 0xea, 0x87, 0xdd, 0x9e, 0x38, 0x2b, 0x8e, 0xf6, 0xff, 0x84,
+  0xc6, 0xf0, 0xc8, 0x7b, 0xf7, 0xc4, 0xc2, 0x5d, 0x8f, 0xbd, 0x3f, 0x50, 0xae, 0xa8, 0xcc, 0x31,
+  0xd1, 0xcd, 0x88, 0x8c, 0xba, 0xed, 0xc2, 0xdc, 0x19, 0x20, 0xf3, 0x77, 0x0b, 0x7e, 0xc1, 0x26,
+  0x41, 0x13, 0x73, 0xbf, 0x66, 0x23, 0x7d, 0x7b, 0xed, 0xa1, 0x46, 0x9f, 0x32, 0xd2, 0x75, 0xd4,
+  0x1c, 0x78, 0x52, 0xb4, 0x71, 0xb5, 0xb9, 0x21, 0xfe, 0x17, 0x86, 0xb2, 0x99, 0xb5, 0x24, 0x1c,
+  0xe9, 0xd5, 0x9d, 0x5c, 0x9e, 0xa1, 0xfc, 0xf2, 0xb7, 0xbe, 0x93, 0x7c, 0x3f, 0x03, 0xbe, 0x4d,
+  0x49, 0xfa, 0xdb, 0x58, 0x24, 0x83, 0x03, 0x40, 0xc5, 0x07, 0x37, 0xd1, 0xb0, 0xb3, 0x45, 0xdf,
+  0x98, 0x77, 0x3a, 0x17, 0x06, 0x42, 0xc0, 0x77, 0xcc, 0xf8, 0x56, 0x90, 0x12, 0xbe, 0xf9, 0x38,
+  0xf4, 0xcc, 0x48, 0x8c, 0xd0, 0x81, 0x15, 0x5e, 0x7b, 0xda, 0x60, 0x38, 0x50, 0xdd, 0x27, 0xa1,
+  0x0b, 0xca, 0x5e, 0x08, 0x75, 0xe5, 0xc8, 0x58, 0x86, 0x0a, 0xfa, 0x65, 0x6b, 0x12, 0xfc, 0x82,
+  0x3e, 0xbd, 0x0e, 0xe8, 0x69, 0xa4, 0x75, 0x64, 0x1b, 0xf9, 0x6b, 0x6a, 0xd3, 0x3a, 0x96, 0xf3,
+  0x28, 0xf7, 0xae, 0xdd, 0x7b, 0x77, 0x76, 0x77, 0xa8, 0xca, 0x69, 0x24, 0xf3, 0x47, 0xe5, 0x52,
+  0xbb, 0xf5, 0x42, 0x64, 0x9c, 0x0b, 0x2f, 0xff, 0xa8, 0xdb, 0x0e, 0xcc, 0x5e, 0x59, 0xc4, 0xe1,
+  0x1f, 0x54, 0xbe, 0xa1, 0x6c, 0xfe, 0x9b, 0x2e, 0x42, 0xd0, 0x4d, 0x16, 0xfb, 0x31, 0xbb, 0x57,
+  0x8f, 0x34, 0x58, 0xd4, 0x99, 0x9e, 0xcd, 0xe0, 0x09, 0xfc, 0x44, 0x52, 0xdd, 0xfc, 0x9f, 0x05,
+  0xab, 0xe8, 0xf6, 0x02, 0x2d, 0xe6, 0x1f, 0x72, 0x43, 0x62, 0xd3, 0x35, 0x07, 0x5a, 0xd2, 0x43,
+  0xc8, 0xc9, 0xa9, 0x64, 0x17, 0xdf, 0xec, 0xd3, 0x2d, 0xc8, 0x4a, 0x26, 0x46, 0xa3, 0x3c, 0xaa,
+  0x80, 0x3a, 0xbd, 0xab, 0xef, 0xf3, 0x4b, 0x9f, 0xc9, 0x1f, 0x0d, 0xa7, 0x33, 0xdf, 0xb3, 0x9f,
+  0xeb, 0xc3, 0xdf, 0x59, 0x5d, 0x7e, 0x8e, 0x2c, 0xa4, 0x46, 0x92, 0x47, 0x7b, 0xd5, 0x65, 0x55,
+  0x20, 0xed, 0x3b, 0x91, 0xcd, 0x13, 0xba, 0xec, 0x96, 0xd1, 0x65, 0x03, 0x38, 0x23, 0xe1, 0xbf,
+  0xd5, 0x88, 0xdc, 0xfa, 0x85, 0xbd, 0x27, 0xc5, 0xa6, 0x61, 0xfe, 0x0a, 0x05, 0xc2, 0x69, 0xb0,
+  0x0f, 0xfa, 0xbc, 0xdd, 0xa0, 0x25, 0x08, 0xef, 0x8e, 0x0a, 0x25, 0x63, 0x7b, 0x24, 0x57, 0x5e,
+  0x56, 0x60, 0x14, 0xc1, 0x76, 0xe4, 0x5e, 0xa8, 0x62, 0x4b, 0xe2, 0x64, 0x60, 0xaa, 0xd2, 0x99,
+  0x46, 0xa2, 0x49, 0x1f, 0x20, 0x90, 0xd8, 0xf8, 0x5e, 0x88, 0x8a, 0x89, 0x07, 0xda, 0x28, 0x4b,
+  0x9b, 0xee, 0x08, 0xd3, 0x1b, 0xc2, 0x7f, 0x2d, 0x07, 0x8a, 0x79, 0xeb, 0xbf, 0x91, 0xf2, 0xd2,
+  0x30, 0x33, 0x18, 0x4e, 0x8b, 0x31, 0xb2, 0x44, 0x36, 0x3b, 0x3a, 0x2f, 0xe4, 0xca, 0x4d, 0x79,
+  0xc0, 0x50, 0x6c, 0xa5, 0xb1, 0x55, 0x5e, 0x99, 0xc8, 0x65, 0x46, 0x09, 0xb5, 0x4e, 0x12, 0xcc,
+  0xb8, 0x6c, 0xa4, 0xec, 0xa2, 0xc1, 0x56, 0xa6, 0x63, 0xb7, 0x2a, 0x6f, 0x5a, 0xb8, 0xb4, 0xe5,
+  0x82, 0xf4, 0x3f, 0x1c, 0xa6, 0x78, 0x2d, 0x5e, 0x21, 0x6e, 0xd8, 0x57, 0xa6, 0xe8, 0x13, 0xf0,
+  0x78, 0x24, 0x0f, 0xc4, 0xea, 0x9d, 0x34, 0x33, 0x2b, 0x1b, 0x7a, 0xc1, 0x12, 0xfc, 0x5d, 0x5b,
+  0x6c, 0x08, 0x75, 0xde, 0xe1, 0xd6, 0x9f, 0x0d, 0x64, 0xae, 0xda, 0x95, 0x30, 0xed, 0xdf, 0xc2,
+  0x48, 0xbf, 0xac, 0x94, 0x11, 0x9c, 0x43, 0x9b, 0x55, 0x73, 0x75, 0xb2, 0xf9, 0x4d, 0x09, 0x0f,
+  0x4d, 0x0c, 0x38, 0x54, 0xdd, 0x4a, 0xea, 0x74, 0x5e, 0x31, 0x44, 0x11, 0xf6, 0x8d, 0xf9, 0x2b,
+  0xb8, 0x52, 0xc2, 0x3f, 0x2f, 0x2f, 0xcf, 0xf7, 0xfb, 0x7b, 0x7b, 0xeb, 0x8c, 0x9a, 0xff, 0x4a,
+  0x86, 0xea, 0xaf, 0xd3, 0x3a, 0xea, 0xd8, 0xbf, 0x11, 0x80, 0xfe, 0x6e, 0x13, 0xfb, 0x37, 0x94,
+  0xfd, 0x0f, 0xc1, 0x8a, 0xe4, 0xca, 0xbb, 0x4c, 0x00, 0x00,
 };
 
+const uint8_t ARQ_grafico_js_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x19, 0xfd, 0x6f, 0xdb, 0xb8,
+  0xf5, 0xf7, 0xfe, 0x15, 0xaf, 0x1e, 0x76, 0x95, 0x16, 0x59, 0x89, 0xb3, 0x36, 0x28, 0xe2, 0xe4,
+  0x86, 0xb4, 0xd7, 0xdb, 0x75, 0xcb, 0xba, 0xa2, 0x0d, 0x70, 0x77, 0x2b, 0x8a, 0x03, 0x6d, 0xd1,
+  0x36, 0x17, 0x59, 0x14, 0x48, 0xf9, 0x6b, 0xbd, 0xfc, 0xef, 0x7b, 0xef, 0x91, 0x92, 0x28, 0xd9,
+  0x6e, 0xbb, 0x62, 0x45, 0x93, 0x98, 0xe4, 0xfb, 0xe6, 0xfb, 0xa4, 0x4f, 0x4f, 0x6f, 0x55, 0x21,
+  0x61, 0xba, 0x10, 0xa6, 0x02, 0x3d, 0x83, 0x6a, 0x21, 0x21, 0x13, 0x76, 0x31, 0xd1, 0xc2, 0x64,
+  0x09, 0x64, 0x46, 0x6c, 0x0a, 0xb0, 0x95, 0x11, 0x6a, 0xbe, 0x40, 0x80, 0x82, 0x01, 0xa6, 0xa2,
+  0x58, 0x0b, 0x0b, 0xa2, 0xc8, 0xc0, 0x4a, 0xb3, 0x96, 0x19, 0xcc, 0x8c, 0x5e, 0x3e, 0x3a, 0x3d,
+  0xa5, 0x43, 0xbd, 0x96, 0x05, 0xcc, 0x72, 0xa4, 0x01, 0x1b, 0x55, 0x2d, 0x18, 0xa1, 0x14, 0x73,
+  0x09, 0xd1, 0x5c, 0x1a, 0x61, 0x7e, 0x53, 0x45, 0x26, 0xb7, 0x69, 0xb9, 0x8b, 0x13, 0xb0, 0xba,
+  0xcb, 0x0f, 0x0a, 0x29, 0x33, 0x0b, 0x85, 0x46, 0x52, 0xaa, 0xa8, 0xa4, 0x29, 0x64, 0x95, 0xc2,
+  0xeb, 0x0a, 0x2a, 0x71, 0x2f, 0x2d, 0xc3, 0xbe, 0x24, 0x41, 0xd3, 0x7f, 0x5b, 0x38, 0x87, 0xa9,
+  0x2e, 0x66, 0x6a, 0xbe, 0x32, 0xa2, 0x52, 0x5e, 0x2e, 0x66, 0x23, 0x72, 0x23, 0x45, 0xb6, 0x83,
+  0x95, 0x45, 0xb9, 0x50, 0x44, 0xa2, 0xb5, 0x2c, 0x73, 0xb9, 0x94, 0x45, 0x65, 0x51, 0x83, 0x7c,
+  0x87, 0xb0, 0xa2, 0x02, 0xbb, 0x9a, 0x58, 0x59, 0x5d, 0xe2, 0x31, 0xc0, 0x10, 0xaa, 0x5d, 0x29,
+  0xe1, 0x49, 0x8e, 0xb6, 0x78, 0x32, 0x46, 0x81, 0x2a, 0x91, 0xe6, 0x62, 0x22, 0x73, 0xa7, 0xa4,
+  0x14, 0xd3, 0x05, 0x6f, 0x22, 0xc2, 0x13, 0xcb, 0x9f, 0x40, 0x18, 0x09, 0xc4, 0x08, 0x26, 0x3b,
+  0x26, 0x01, 0xb8, 0x9a, 0x49, 0x23, 0x8b, 0xa9, 0x64, 0xc5, 0xca, 0x95, 0x5d, 0xa8, 0x62, 0x0e,
+  0x95, 0xd3, 0x51, 0x18, 0x23, 0x76, 0x8e, 0xda, 0x54, 0xe4, 0x39, 0x9d, 0xac, 0x4a, 0x24, 0x24,
+  0xa3, 0x18, 0x94, 0x05, 0x59, 0xe8, 0xd5, 0x7c, 0x31, 0xf6, 0xc2, 0x94, 0xd2, 0xd4, 0xec, 0x2e,
+  0x81, 0xe5, 0x48, 0x60, 0xa2, 0x4d, 0x26, 0xcd, 0x4b, 0x9d, 0x6b, 0x83, 0x0b, 0x31, 0xbd, 0x9f,
+  0x1b, 0xbd, 0x2a, 0xb2, 0x7a, 0x83, 0x4f, 0x7f, 0x56, 0x59, 0xb5, 0x48, 0xbc, 0x38, 0x6e, 0xeb,
+  0x07, 0xb4, 0x6d, 0x02, 0xa5, 0x46, 0x73, 0xbe, 0x13, 0x99, 0x5a, 0x39, 0x11, 0x66, 0x2a, 0xcf,
+  0xe1, 0xc9, 0x70, 0xf4, 0x04, 0x22, 0xd4, 0x43, 0x40, 0xa6, 0xf1, 0x96, 0xbd, 0xa4, 0xa5, 0x91,
+  0x6b, 0xa5, 0x57, 0xd6, 0x93, 0xf1, 0x72, 0xc4, 0x63, 0x78, 0x23, 0xde, 0x40, 0x2e, 0xc5, 0x1a,
+  0x6f, 0x42, 0xc0, 0x5c, 0x94, 0xa0, 0x9c, 0xd5, 0xc9, 0x68, 0x63, 0xfe, 0x6d, 0xd9, 0x2a, 0x85,
+  0x46, 0xe3, 0x2e, 0xb5, 0xc6, 0xb3, 0xac, 0xd6, 0x48, 0x97, 0x74, 0x49, 0x36, 0xcd, 0xe5, 0x5c,
+  0x16, 0x99, 0xb7, 0x6d, 0x8a, 0x62, 0xe0, 0x25, 0x27, 0xcd, 0xe9, 0x52, 0xa0, 0x98, 0xf8, 0x73,
+  0x63, 0x4b, 0x39, 0x45, 0x79, 0x71, 0x17, 0x66, 0x22, 0xb7, 0xe8, 0x3b, 0x48, 0xcc, 0x0b, 0xe4,
+  0x9d, 0x6f, 0xa6, 0xf3, 0x5c, 0x6f, 0x2c, 0x28, 0xbc, 0x54, 0xf4, 0x04, 0x42, 0x93, 0x26, 0x66,
+  0xed, 0x76, 0x37, 0x5b, 0x69, 0x3f, 0x9c, 0x7d, 0x4c, 0x2b, 0x35, 0xbd, 0xb7, 0xe9, 0x44, 0xce,
+  0x91, 0x64, 0xf5, 0x2f, 0x69, 0x74, 0xfa, 0x28, 0x9a, 0xad, 0x8a, 0x29, 0x71, 0x43, 0xbb, 0x7f,
+  0x7a, 0x04, 0xb0, 0x16, 0x06, 0x7e, 0xfc, 0xe7, 0x9b, 0x3b, 0xb8, 0x86, 0xc1, 0xe8, 0xbc, 0xdc,
+  0xc2, 0x4f, 0x32, 0x5f, 0x4b, 0x44, 0x14, 0x09, 0xdc, 0x18, 0x25, 0xd0, 0xf2, 0x56, 0x14, 0x76,
+  0x88, 0x7e, 0xae, 0x66, 0x83, 0xb1, 0xc7, 0xb8, 0x7b, 0xf5, 0x0b, 0x63, 0xfc, 0xe1, 0xe2, 0xe2,
+  0xa2, 0xd9, 0xfc, 0xeb, 0xbb, 0xd7, 0x3f, 0xd0, 0xa6, 0x99, 0x4f, 0x44, 0x74, 0x96, 0x80, 0xff,
+  0x9f, 0x8e, 0xe2, 0x06, 0xe4, 0x97, 0xdf, 0x6e, 0x6f, 0x5e, 0xbc, 0xba, 0x7d, 0x8f, 0x60, 0xcf,
+  0xc7, 0xa8, 0xcb, 0xe9, 0x29, 0x3a, 0xe2, 0x52, 0xdb, 0x0a, 0xb9, 0x94, 0xec, 0x4d, 0x18, 0x3d,
+  0x86, 0xad, 0xba, 0x56, 0x56, 0x4d, 0x72, 0x89, 0xdc, 0xc9, 0x79, 0xad, 0x27, 0xf0, 0xeb, 0x6f,
+  0x77, 0xaf, 0x5f, 0xfe, 0x9d, 0xf0, 0x2f, 0xc6, 0x8f, 0x70, 0xaf, 0xd6, 0xc6, 0xc5, 0x45, 0x34,
+  0xad, 0xb6, 0x89, 0x8f, 0x0b, 0xa7, 0x1e, 0x20, 0x2d, 0x65, 0x53, 0xdc, 0x47, 0x14, 0xfc, 0x3d,
+  0x0e, 0xf6, 0x9c, 0x1d, 0x79, 0xdb, 0x2f, 0x82, 0x53, 0xf6, 0xf1, 0x6b, 0x4f, 0x8b, 0x57, 0xc1,
+  0xa1, 0xbf, 0xaf, 0xf6, 0xbc, 0xde, 0xf8, 0xfd, 0x77, 0xf8, 0xf4, 0xe0, 0x00, 0x49, 0x5a, 0x2b,
+  0xf3, 0x19, 0x02, 0x11, 0x8e, 0xdb, 0xdc, 0x60, 0xf0, 0xeb, 0x4d, 0x2a, 0xb2, 0xec, 0x15, 0x66,
+  0x89, 0xea, 0x56, 0xd9, 0x4a, 0xe2, 0xb5, 0x45, 0x03, 0x23, 0xad, 0xfa, 0x8f, 0x1c, 0x24, 0x10,
+  0x5e, 0x0f, 0xe3, 0xa7, 0x75, 0x98, 0x8c, 0xe1, 0x21, 0x0e, 0x64, 0x68, 0xb6, 0x71, 0xeb, 0x81,
+  0x4c, 0x71, 0x7a, 0xfa, 0xd2, 0x69, 0x44, 0x94, 0xc8, 0x37, 0x5f, 0xbe, 0x7f, 0x0f, 0xa5, 0xda,
+  0xa2, 0xa3, 0xb9, 0x80, 0xa1, 0x98, 0xb3, 0x95, 0x36, 0x7c, 0x98, 0xa1, 0x93, 0x4f, 0xa5, 0x3f,
+  0x47, 0x6c, 0x97, 0x57, 0x4a, 0xa3, 0x2b, 0x4d, 0xa9, 0x20, 0x75, 0x02, 0xa1, 0xf0, 0x3d, 0x7f,
+  0x71, 0x8a, 0x95, 0xe8, 0xe7, 0x45, 0xe5, 0x55, 0xf3, 0xc6, 0x4b, 0xdd, 0xe6, 0x1b, 0x9d, 0xc9,
+  0xd6, 0x02, 0x1b, 0x8a, 0x48, 0x84, 0x8b, 0x3c, 0xc6, 0x77, 0xdf, 0x79, 0xdc, 0x74, 0x9a, 0x2b,
+  0xfc, 0xc3, 0x11, 0x1b, 0x93, 0xdd, 0x42, 0x4a, 0x8c, 0xd5, 0x12, 0x59, 0x48, 0x4e, 0xbe, 0xd7,
+  0x1d, 0xe3, 0x1f, 0x0c, 0x96, 0xeb, 0xeb, 0x6b, 0x1f, 0x30, 0x0d, 0xa3, 0x3d, 0x96, 0x3f, 0x31,
+  0x35, 0x26, 0xde, 0xf9, 0xf7, 0x97, 0x43, 0x60, 0x70, 0xe9, 0x55, 0x38, 0x85, 0xf3, 0x56, 0x20,
+  0xe3, 0x98, 0xd5, 0xd7, 0xe9, 0x6c, 0xf9, 0x96, 0x4c, 0xe9, 0xc4, 0x40, 0x75, 0x46, 0x0e, 0x5a,
+  0xcd, 0x28, 0x74, 0x7b, 0x9a, 0xc1, 0xe3, 0x6b, 0xf8, 0x87, 0xa8, 0x16, 0x29, 0x67, 0xb0, 0xc8,
+  0xed, 0xfd, 0xc9, 0x51, 0xdd, 0xb3, 0x85, 0x57, 0xbe, 0x8b, 0xe2, 0x37, 0x6b, 0x9c, 0xfa, 0x6a,
+  0x60, 0xdf, 0x8a, 0xf0, 0x19, 0x56, 0xe3, 0x03, 0x48, 0x8d, 0xad, 0x8f, 0x73, 0x3b, 0x84, 0x66,
+  0xab, 0x5d, 0x2e, 0x1b, 0x8e, 0x83, 0xd1, 0xd9, 0xd9, 0x1f, 0x07, 0xc7, 0xe1, 0x1a, 0x26, 0xfe,
+  0xc3, 0x09, 0x0c, 0xca, 0xad, 0x87, 0x7f, 0xe8, 0x44, 0x6d, 0x8a, 0xa9, 0xf7, 0xce, 0x60, 0x02,
+  0x9a, 0x69, 0xb3, 0x8c, 0x98, 0x7f, 0x9d, 0x58, 0x82, 0x45, 0x18, 0x17, 0xb5, 0x0c, 0x81, 0x0f,
+  0xf1, 0x7e, 0x8f, 0x27, 0x87, 0xcd, 0xd8, 0xc5, 0xcd, 0x3b, 0xd2, 0x12, 0x43, 0x43, 0x96, 0x10,
+  0x8d, 0x12, 0xac, 0xac, 0xda, 0xc0, 0x33, 0xa8, 0xd4, 0x92, 0x33, 0x7d, 0xa9, 0x37, 0x98, 0x92,
+  0xa8, 0x35, 0x90, 0x45, 0xec, 0x4a, 0xe7, 0x5c, 0x71, 0x11, 0x98, 0xe8, 0x55, 0xd5, 0x64, 0x24,
+  0xce, 0xff, 0x61, 0x46, 0x22, 0x7a, 0x28, 0x71, 0x31, 0x97, 0x61, 0xe4, 0x60, 0x3f, 0x81, 0x32,
+  0xf0, 0x36, 0xfa, 0x54, 0x54, 0x63, 0x0f, 0x61, 0x14, 0xb7, 0xfe, 0xe5, 0x58, 0xfa, 0x3b, 0xc0,
+  0x45, 0x34, 0x42, 0x2d, 0x79, 0x31, 0xcb, 0xb5, 0x36, 0x11, 0x7f, 0xcc, 0xf5, 0x1c, 0xc9, 0x6f,
+  0x62, 0x24, 0xc3, 0xeb, 0xdb, 0x37, 0xa3, 0xb3, 0x38, 0x20, 0xb2, 0x2a, 0x54, 0xc5, 0xac, 0x36,
+  0x08, 0xc1, 0x14, 0xdd, 0x99, 0x91, 0xd5, 0xca, 0x14, 0x10, 0xf1, 0xf9, 0xd5, 0x35, 0x8c, 0xd0,
+  0xf3, 0x47, 0xe8, 0xe7, 0xf5, 0xfa, 0x1c, 0xd7, 0xe7, 0xc1, 0xfa, 0x19, 0xae, 0x9f, 0xe1, 0x1a,
+  0xa9, 0xa3, 0x0b, 0x34, 0x84, 0x38, 0xe7, 0xf4, 0xb3, 0x86, 0xc5, 0xda, 0x2e, 0x7f, 0x3d, 0x96,
+  0x35, 0x96, 0x98, 0x77, 0xae, 0xe1, 0x35, 0x66, 0x4c, 0x24, 0xbd, 0x4b, 0x60, 0x29, 0x28, 0x2b,
+  0x0f, 0xeb, 0x8d, 0x5e, 0xf6, 0x4d, 0x7d, 0xe5, 0xc5, 0x32, 0xa9, 0xcd, 0x2b, 0xec, 0x40, 0xda,
+  0xd2, 0x95, 0xb5, 0x0e, 0x9f, 0x39, 0xd8, 0x3d, 0x90, 0x75, 0x0b, 0xe2, 0xa2, 0x50, 0x59, 0xac,
+  0xdf, 0xb8, 0x1d, 0x7b, 0x03, 0x8c, 0x3b, 0xa7, 0x6b, 0xb8, 0x22, 0xf1, 0x62, 0x2f, 0xe3, 0xba,
+  0x7f, 0xfa, 0x3d, 0x09, 0x1b, 0x7b, 0x89, 0x9b, 0xd3, 0x3a, 0x21, 0x3f, 0x04, 0x66, 0xdf, 0x51,
+  0xb6, 0xeb, 0x24, 0x2a, 0x36, 0x8a, 0xa5, 0x3c, 0x74, 0x60, 0x3b, 0xe5, 0x62, 0xfd, 0xd9, 0x43,
+  0xac, 0xe4, 0x71, 0x58, 0x59, 0x48, 0xa2, 0x9d, 0xab, 0xed, 0x84, 0xb7, 0xdb, 0x2f, 0xf3, 0xad,
+  0xee, 0x4e, 0x1d, 0xf6, 0x0f, 0xfc, 0x18, 0xe1, 0x4f, 0x1b, 0x2e, 0xe0, 0xd5, 0x71, 0xa7, 0x62,
+  0x1b, 0xe1, 0x4f, 0x7b, 0xfa, 0xd0, 0xf0, 0x62, 0x1a, 0xed, 0xbd, 0x51, 0x61, 0x72, 0x64, 0xcf,
+  0xc6, 0x9e, 0xc2, 0x68, 0x1c, 0x82, 0xd3, 0xd6, 0xb5, 0xb3, 0xe6, 0x27, 0x06, 0x38, 0x61, 0x08,
+  0xc2, 0x19, 0x06, 0xb0, 0x5c, 0x20, 0x11, 0x99, 0xe3, 0x84, 0xc0, 0x86, 0x8c, 0xd3, 0x71, 0x52,
+  0xe6, 0x74, 0x19, 0xba, 0x3e, 0x51, 0x39, 0x05, 0x4b, 0xae, 0x68, 0xd9, 0x83, 0xfc, 0xe9, 0x54,
+  0xaa, 0x9c, 0xa9, 0xb4, 0x87, 0x44, 0xf8, 0x12, 0x59, 0x3c, 0x84, 0xb1, 0x7e, 0xcb, 0x0d, 0x18,
+  0x37, 0xf2, 0x1a, 0x4f, 0x05, 0xb6, 0x89, 0xdb, 0xb0, 0x91, 0xc3, 0x8a, 0x9e, 0xeb, 0x95, 0xe1,
+  0x3e, 0x8a, 0xf7, 0xa8, 0x53, 0x1b, 0x7b, 0x79, 0x5c, 0xb7, 0xb5, 0xa8, 0x0b, 0x48, 0xdf, 0xfb,
+  0x69, 0x58, 0xf0, 0xf4, 0x8f, 0x44, 0x80, 0xeb, 0x43, 0xea, 0xe4, 0xd6, 0x3a, 0x4d, 0x5e, 0x63,
+  0x75, 0x9c, 0xc0, 0xef, 0xf6, 0xae, 0xde, 0xb7, 0x90, 0x99, 0xb2, 0x65, 0x2e, 0x76, 0x6d, 0xc9,
+  0xab, 0x1d, 0x1b, 0xaf, 0xa5, 0xa1, 0xeb, 0x1a, 0x4c, 0xa4, 0xdb, 0xe9, 0x3b, 0xc9, 0x6b, 0x0e,
+  0x35, 0xa2, 0x2d, 0x9e, 0xaa, 0xe4, 0xd2, 0xd6, 0xe2, 0xf4, 0x82, 0x91, 0x41, 0x0f, 0xc6, 0xa2,
+  0xe7, 0xff, 0xd8, 0x73, 0x45, 0xb9, 0x3d, 0xf0, 0x27, 0xcc, 0x9d, 0x5b, 0x6c, 0xe5, 0x3d, 0x3f,
+  0x3a, 0x19, 0x0c, 0x0e, 0x46, 0x0f, 0x67, 0x6d, 0xe2, 0xcc, 0x12, 0xa0, 0x57, 0x96, 0x5d, 0x4e,
+  0x35, 0x8f, 0x67, 0xe7, 0x58, 0x34, 0xa8, 0x3e, 0x2c, 0xa5, 0xb0, 0x2b, 0x23, 0xef, 0x90, 0x7e,
+  0xd4, 0x21, 0x1f, 0xfb, 0x2e, 0xa2, 0x43, 0x1e, 0x2f, 0x4a, 0xe4, 0x75, 0x71, 0xb0, 0xd8, 0xe4,
+  0x64, 0xab, 0xa9, 0x6c, 0x39, 0x60, 0xcf, 0x3b, 0x09, 0x98, 0x08, 0xe4, 0x31, 0x41, 0x02, 0x6d,
+  0x50, 0x10, 0x8d, 0x4e, 0xc8, 0x60, 0x5e, 0x8e, 0x82, 0xb2, 0x33, 0x74, 0x1c, 0x28, 0x27, 0x9f,
+  0x7b, 0x14, 0x12, 0x92, 0xb4, 0x7f, 0x81, 0xe6, 0x63, 0x07, 0xc3, 0xf2, 0xb8, 0x54, 0x59, 0x96,
+  0xcb, 0x41, 0x17, 0xe0, 0x26, 0x57, 0x73, 0x8a, 0xaa, 0x41, 0x2e, 0x67, 0x95, 0x3f, 0x73, 0x56,
+  0xd8, 0xcf, 0x7f, 0x09, 0xa8, 0xd6, 0xec, 0x44, 0x80, 0x06, 0x9a, 0xf7, 0x54, 0x5b, 0x91, 0x40,
+  0x96, 0xf6, 0xc6, 0x23, 0x32, 0x08, 0x6e, 0xb6, 0x03, 0xd4, 0x38, 0xc0, 0xc4, 0xd9, 0x56, 0xdf,
+  0xcb, 0x00, 0xf7, 0x30, 0x18, 0x89, 0xfe, 0xb3, 0x2f, 0xad, 0xa3, 0x0e, 0xbe, 0xac, 0x68, 0x82,
+  0xa6, 0x39, 0x2b, 0xaa, 0xb1, 0x69, 0x41, 0x4c, 0x3f, 0x7c, 0x8c, 0xc7, 0x3d, 0x21, 0xdf, 0x61,
+  0xaf, 0x16, 0x61, 0x9a, 0xb9, 0x48, 0xe0, 0x29, 0x1a, 0x6f, 0x74, 0x1e, 0xef, 0x0b, 0xf3, 0x05,
+  0x98, 0x80, 0xe1, 0x01, 0x06, 0xb5, 0x26, 0x34, 0xa2, 0xf4, 0xcf, 0xf6, 0xbd, 0x24, 0xc1, 0xeb,
+  0x3c, 0x81, 0xa7, 0x17, 0x1d, 0x2e, 0x9c, 0xb1, 0x9c, 0x8b, 0x7c, 0x50, 0x1f, 0xbb, 0x4e, 0xea,
+  0x5d, 0xe3, 0xfc, 0x79, 0x98, 0x54, 0xde, 0x0a, 0x9e, 0xf3, 0x0d, 0xcd, 0xb0, 0x9c, 0x35, 0xfc,
+  0xd0, 0xe2, 0x66, 0x46, 0x5b, 0x61, 0x9a, 0xa0, 0x4e, 0xa2, 0x90, 0x1b, 0x6c, 0xe9, 0xe7, 0x34,
+  0x88, 0x87, 0x8d, 0x42, 0x65, 0x04, 0x3a, 0x21, 0x8f, 0x2e, 0x14, 0x65, 0x28, 0x52, 0x02, 0xbb,
+  0x30, 0x6b, 0xe8, 0x52, 0x92, 0x63, 0x70, 0x94, 0x3b, 0x29, 0xd0, 0x23, 0xb0, 0x2a, 0x51, 0xa0,
+  0xba, 0x34, 0xac, 0xb0, 0x7c, 0xb9, 0xa1, 0x5d, 0x16, 0x73, 0x72, 0x7a, 0x75, 0x72, 0xd2, 0x3a,
+  0x48, 0x5b, 0xfe, 0x08, 0x06, 0x55, 0xa2, 0x86, 0xb1, 0x4b, 0x95, 0x47, 0x48, 0x55, 0xac, 0x64,
+  0x9d, 0x9d, 0x1d, 0x16, 0xc1, 0xc4, 0xcd, 0xfd, 0xdf, 0xe9, 0x68, 0x1b, 0xa9, 0x18, 0xa5, 0x6b,
+  0x09, 0xd5, 0x36, 0x93, 0xd4, 0x74, 0x73, 0x40, 0xe2, 0x04, 0xf7, 0x39, 0x40, 0xcf, 0xb6, 0x32,
+  0x2b, 0xd9, 0x16, 0x1a, 0x3f, 0xc0, 0xdc, 0xd0, 0x2c, 0x3e, 0x91, 0xd5, 0x46, 0xca, 0x82, 0x73,
+  0x4f, 0x3d, 0x7d, 0x37, 0xe9, 0x58, 0x63, 0x00, 0x4d, 0xe4, 0x8c, 0x87, 0x98, 0xaa, 0x7e, 0x9e,
+  0xc1, 0xf4, 0x6d, 0x56, 0x98, 0x9c, 0xf5, 0x8c, 0xa9, 0x78, 0xe3, 0xc3, 0x66, 0x21, 0x11, 0x6c,
+  0x82, 0x73, 0x38, 0xc8, 0x2d, 0x4e, 0x5a, 0xa1, 0xcd, 0xc9, 0x1b, 0x5e, 0x38, 0x46, 0xce, 0xf2,
+  0xab, 0xb2, 0xa4, 0x49, 0x3c, 0xa7, 0xf6, 0x66, 0xff, 0x06, 0xd8, 0xcc, 0x09, 0x74, 0x6a, 0x29,
+  0x63, 0x78, 0x83, 0x7b, 0x44, 0xbf, 0xf2, 0xba, 0x6e, 0x16, 0x0a, 0x3d, 0x31, 0xa2, 0xbb, 0x29,
+  0xda, 0xcb, 0x08, 0x77, 0x29, 0x11, 0xfb, 0x9b, 0x61, 0x6a, 0x64, 0x28, 0xf2, 0x4b, 0xb7, 0xc5,
+  0x24, 0xd9, 0x76, 0x31, 0xdd, 0x67, 0x6d, 0x40, 0xae, 0x9b, 0xe4, 0x52, 0x94, 0x25, 0xc7, 0x47,
+  0xa8, 0x3e, 0xee, 0x53, 0x6d, 0xf7, 0x5a, 0xb2, 0x21, 0x55, 0xf6, 0x11, 0xcc, 0x5f, 0x8e, 0xf2,
+  0x15, 0xa6, 0xaf, 0xd6, 0x25, 0x82, 0x28, 0xe2, 0x26, 0x83, 0xdc, 0x3d, 0xea, 0x04, 0x5e, 0x73,
+  0xe9, 0x8c, 0xce, 0x17, 0xef, 0x58, 0xf3, 0x3a, 0xb8, 0xfd, 0xc6, 0x71, 0xef, 0xb9, 0xf2, 0x13,
+  0xaf, 0x13, 0x6a, 0x09, 0xee, 0x91, 0xa5, 0xc2, 0x3f, 0xe4, 0xb6, 0x1d, 0x77, 0xbb, 0x0f, 0x88,
+  0xdd, 0xf7, 0x09, 0x11, 0x11, 0x12, 0x9a, 0x09, 0x7c, 0xef, 0x09, 0xe2, 0xe7, 0xe1, 0xf0, 0x20,
+  0x15, 0xa7, 0x79, 0x48, 0x85, 0x47, 0xff, 0x5c, 0x5b, 0xb9, 0xaf, 0x12, 0x79, 0x48, 0x14, 0xf7,
+  0x5c, 0xb4, 0x5f, 0xf1, 0xdd, 0x10, 0x7e, 0xa8, 0xda, 0x73, 0x51, 0x70, 0x43, 0x74, 0x14, 0x14,
+  0x8f, 0x43, 0x0d, 0x80, 0x13, 0x42, 0x0a, 0xc3, 0x79, 0xcf, 0x0d, 0x37, 0x6d, 0x4d, 0x49, 0xc2,
+  0xf1, 0x25, 0xa8, 0x29, 0x33, 0xcd, 0x03, 0x38, 0xbd, 0xdd, 0x70, 0x16, 0xaa, 0x0b, 0x5c, 0xd9,
+  0x94, 0xed, 0xa6, 0x1b, 0x41, 0xa1, 0x4e, 0xe0, 0x79, 0xf0, 0x2c, 0x41, 0xcd, 0x65, 0x0d, 0xe6,
+  0x5a, 0xf6, 0x50, 0x46, 0xaa, 0x3f, 0xf4, 0x40, 0x83, 0x48, 0x4d, 0x9d, 0xeb, 0x97, 0x5a, 0xc6,
+  0xa2, 0x30, 0x48, 0x2b, 0xfd, 0x23, 0x0e, 0xbe, 0x59, 0x84, 0xb3, 0x87, 0x17, 0x78, 0x7f, 0xb4,
+  0x0e, 0xfe, 0x1d, 0x21, 0x24, 0xb6, 0xfb, 0x84, 0x48, 0xea, 0x8b, 0x60, 0xe8, 0x0e, 0x1f, 0x01,
+  0xea, 0x72, 0x3b, 0x0a, 0x9a, 0x1d, 0x8c, 0xf4, 0x4a, 0x2f, 0x6b, 0x08, 0x3f, 0xef, 0x0d, 0xe1,
+  0xfc, 0x69, 0xa0, 0x9a, 0xeb, 0x7f, 0xc2, 0xc6, 0xc6, 0x6d, 0xb5, 0x20, 0x45, 0x58, 0xde, 0x7d,
+  0x7b, 0x54, 0x07, 0x79, 0x5d, 0x22, 0x9a, 0x34, 0x42, 0x59, 0xae, 0xed, 0x17, 0xd8, 0x70, 0x27,
+  0x10, 0x19, 0xcf, 0x99, 0xd6, 0xd4, 0x8b, 0x2a, 0x9a, 0xf4, 0x0a, 0x37, 0xe3, 0xf9, 0xf4, 0xda,
+  0x50, 0xd8, 0xf1, 0xa4, 0x52, 0x53, 0xf0, 0x2a, 0x0c, 0x21, 0x6a, 0x3e, 0xe1, 0x8d, 0x12, 0x0d,
+  0x9c, 0x41, 0x86, 0xd0, 0x58, 0x9d, 0x1a, 0x8c, 0xd6, 0x74, 0x9d, 0x93, 0xb1, 0xf3, 0x54, 0x4a,
+  0x84, 0x73, 0xa3, 0xf8, 0x05, 0x18, 0xc4, 0x96, 0x47, 0xd3, 0x43, 0x05, 0x9f, 0x1e, 0xed, 0x5a,
+  0xa7, 0x3a, 0x50, 0xe5, 0x8f, 0xd7, 0xd5, 0xbd, 0xc6, 0x85, 0xf5, 0x1e, 0x7c, 0x65, 0xdb, 0x43,
+  0xb6, 0xce, 0xe4, 0x54, 0x2d, 0x05, 0x5f, 0x88, 0x53, 0x80, 0x67, 0xf0, 0x2b, 0x1e, 0x49, 0xdb,
+  0xae, 0x7e, 0xd8, 0x8c, 0xbb, 0x2d, 0x50, 0x77, 0xea, 0xc5, 0xe9, 0xf4, 0xac, 0x57, 0x18, 0xd7,
+  0x0d, 0x4d, 0x34, 0xca, 0x18, 0x97, 0x57, 0xcd, 0x9a, 0x26, 0x92, 0x90, 0x1f, 0x3d, 0xed, 0x20,
+  0xc0, 0x49, 0x28, 0x44, 0xb7, 0xbb, 0xfa, 0x7c, 0xd6, 0xa3, 0x6b, 0x4e, 0xc2, 0xf7, 0x92, 0x1d,
+  0x8f, 0x99, 0x27, 0x70, 0x96, 0x3e, 0x8b, 0xfb, 0x3d, 0x14, 0xc2, 0xb3, 0x99, 0xbe, 0x0a, 0xc1,
+  0x5d, 0xd5, 0x7e, 0x5e, 0xe2, 0xc8, 0x59, 0x37, 0x11, 0x53, 0x9b, 0x11, 0x93, 0x1c, 0xbb, 0xe0,
+  0x90, 0x3a, 0x27, 0xa6, 0x19, 0x8e, 0x72, 0x7b, 0xd7, 0x35, 0x95, 0xf4, 0x15, 0xc3, 0x67, 0xee,
+  0x0b, 0x5d, 0x2f, 0xb8, 0x2c, 0xb9, 0x96, 0x66, 0x17, 0x06, 0xc7, 0x28, 0x09, 0x2e, 0xa9, 0x13,
+  0x29, 0x68, 0xd2, 0xfa, 0xa5, 0xb7, 0x96, 0xe1, 0x50, 0xc7, 0xd2, 0xc1, 0xa1, 0x2d, 0xbc, 0x02,
+  0xe6, 0xf2, 0xbf, 0x58, 0x3f, 0x30, 0x23, 0x45, 0xa3, 0x37, 0x63, 0xc2, 0x71, 0x73, 0xc0, 0xf8,
+  0xc7, 0xc0, 0x5d, 0xbc, 0x7d, 0xbd, 0xf5, 0xdf, 0x57, 0x46, 0x15, 0x73, 0xaf, 0x36, 0x55, 0xd3,
+  0x04, 0x5c, 0xcb, 0xe3, 0x03, 0x17, 0x53, 0x57, 0x63, 0x7d, 0x1f, 0x8e, 0x84, 0x6b, 0xb1, 0xf3,
+  0x30, 0xfc, 0xdc, 0xad, 0xbd, 0x41, 0xd9, 0xd8, 0x58, 0xb8, 0x76, 0xd6, 0x0f, 0xa5, 0xfe, 0x5b,
+  0xa8, 0x65, 0xf0, 0x8a, 0x5c, 0x1d, 0x9e, 0xc5, 0x1c, 0xfd, 0x23, 0x4f, 0x24, 0x09, 0xdc, 0x77,
+  0x3b, 0xc0, 0x8c, 0x85, 0x87, 0xc7, 0x38, 0x2f, 0x0e, 0x86, 0xa3, 0x01, 0xf5, 0x19, 0xf7, 0x34,
+  0xa8, 0x9f, 0xf5, 0x5f, 0x44, 0xbe, 0x7d, 0x9e, 0xd8, 0xeb, 0xaa, 0x48, 0xb6, 0x0f, 0xf7, 0x94,
+  0xf9, 0x3e, 0xa6, 0xae, 0xb7, 0xcd, 0xd2, 0xa0, 0xc7, 0xed, 0xb6, 0xd6, 0x5f, 0x7c, 0xeb, 0xf9,
+  0xc6, 0x71, 0xa5, 0x06, 0xf2, 0x6b, 0x54, 0x19, 0x15, 0x91, 0x33, 0x84, 0xc8, 0x30, 0xcf, 0xfc,
+  0x19, 0x2e, 0xbb, 0x10, 0x7d, 0x32, 0x7f, 0xd3, 0xca, 0x65, 0x37, 0xd2, 0x7f, 0xf0, 0x8d, 0xa3,
+  0xcf, 0x01, 0x1f, 0x0e, 0xdb, 0xfe, 0x7d, 0xa3, 0x1c, 0x77, 0xc1, 0xbd, 0xf9, 0x27, 0xe8, 0x0b,
+  0x8d, 0xfb, 0x8a, 0x8b, 0x74, 0x0e, 0xbf, 0xf2, 0x3a, 0xac, 0x73, 0x00, 0x11, 0x76, 0x81, 0x9e,
+  0xc6, 0xd5, 0xff, 0xd5, 0x33, 0x8e, 0x3e, 0xd3, 0x75, 0x26, 0xd9, 0x2f, 0xbd, 0xd4, 0x1d, 0xb1,
+  0xa4, 0x3b, 0x10, 0x66, 0xda, 0x4c, 0x1d, 0xeb, 0x38, 0xf1, 0xb6, 0xe0, 0x6e, 0xea, 0x1c, 0x0b,
+  0x28, 0x07, 0xfe, 0xdb, 0xd7, 0x3d, 0xa4, 0xb0, 0xcb, 0xeb, 0xbf, 0xe7, 0xb9, 0xe9, 0xce, 0xbf,
+  0xf1, 0x73, 0xe7, 0x87, 0x2a, 0xf3, 0xdf, 0xf1, 0xa3, 0x87, 0x98, 0xb0, 0xfe, 0x0b, 0xd8, 0xd9,
+  0x1e, 0x17, 0x3d, 0x1e, 0x00, 0x00,
+};
 
-function uploadChart() {
-
-  var button = $("#button1");
-  button.text(button.data("text-swap"));
-  
-  var xhttp = new XMLHttpRequest();
-
-  xhttp.open("POST", "init", true); 
-  xhttp.send();
-  
-  setInterval(function() {
-      // Call a function repetatively with 1 Second interval
-      getData();
-    }, 5500); //1000mSeconds update rate 
-
-}
-
-function resetChart() {
-
-  location.reload();
-
-}
+const uint8_t ARQ_manifest_webmanifest_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x55, 0x8b, 0x31, 0x0e, 0xc2, 0x30,
+  0x0c, 0x45, 0xf7, 0x9e, 0xc2, 0x0a, 0x2b, 0x08, 0x01, 0x13, 0xac, 0x48, 0x1c, 0x00, 0x75, 0xaf,
+  0x4c, 0xe2, 0x52, 0x44, 0x62, 0x47, 0x4e, 0x32, 0x20, 0xc4, 0xdd, 0x69, 0x68, 0x87, 0xe2, 0xcd,
+  0xef, 0xbd, 0xff, 0x6e, 0x00, 0x0c, 0x63, 0x20, 0x73, 0x02, 0x73, 0x11, 0x65, 0x01, 0x47, 0x70,
+  0xa5, 0xbe, 0x24, 0x14, 0xd8, 0xc0, 0x59, 0x38, 0xab, 0x78, 0xaa, 0xb4, 0xa5, 0x10, 0x49, 0x31,
+  0x17, 0x45, 0xb3, 0xae, 0xbb, 0x34, 0x88, 0xe6, 0xee, 0x6f, 0x3d, 0x8b, 0x8c, 0xa3, 0x28, 0xea,
+  0x2b, 0xdf, 0xce, 0xcc, 0x4a, 0xa4, 0xc5, 0xef, 0x1e, 0x29, 0x7a, 0x7c, 0x55, 0x32, 0xe6, 0xec,
+  0xd0, 0x0b, 0xd3, 0xa4, 0x6e, 0x68, 0x9f, 0x77, 0x95, 0xc2, 0xae, 0xb3, 0xe2, 0x45, 0x6b, 0xb3,
+  0xea, 0x7f, 0x37, 0x05, 0x79, 0xa0, 0x40, 0x4b, 0x77, 0x38, 0xda, 0xdd, 0xde, 0x34, 0x9f, 0xe6,
+  0x0b, 0x41, 0x8d, 0xca, 0x61, 0xd0, 0x00, 0x00, 0x00,
+};
 
-$("#dialog" ).hide();
- 
-function getData() {
-  var xhttp = new XMLHttpRequest();
-  xhttp.onreadystatechange = function() {
-    if (this.readyState == 4 && this.status == 200) {
-     //Push the data in array
-      var time = new Date().toLocaleTimeString();
-      var ADCValue = this.responseText; 
-      values.push(ADCValue);
-      timeStamp.push(time);
+const uint8_t ARQ_sw_js_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x56, 0x51, 0x6f, 0xdb, 0x36,
+  0x10, 0x7e, 0xf7, 0xaf, 0xb8, 0xe9, 0xa1, 0x95, 0xb1, 0x4c, 0x1a, 0xd2, 0x6d, 0x58, 0x63, 0x64,
+  0x80, 0xd1, 0xba, 0x4b, 0x00, 0x63, 0x0d, 0x62, 0x77, 0x79, 0x18, 0x82, 0x80, 0x91, 0x4e, 0x26,
+  0x67, 0x89, 0xd4, 0x48, 0xca, 0x9e, 0xb1, 0xf6, 0xbf, 0xef, 0x48, 0x8a, 0xb6, 0xec, 0xd5, 0x40,
+  0x66, 0xc0, 0xb0, 0xc4, 0xe3, 0x1d, 0xbf, 0xfb, 0xbe, 0xbb, 0xa3, 0xf3, 0x7c, 0x81, 0x7a, 0x23,
+  0x0a, 0x84, 0xad, 0xd2, 0x6b, 0xd4, 0xa0, 0x2a, 0xb0, 0x1c, 0xa1, 0x64, 0x86, 0x3f, 0x2b, 0xa6,
+  0xcb, 0x2b, 0xff, 0x6a, 0x38, 0xd6, 0x35, 0xa4, 0x2d, 0x5b, 0xe1, 0x05, 0x14, 0x9c, 0x69, 0x7b,
+  0x01, 0x0d, 0x93, 0xa2, 0x42, 0x63, 0xc7, 0x20, 0xcc, 0x28, 0xcf, 0x99, 0x34, 0x5b, 0xd4, 0x58,
+  0x42, 0xa5, 0x55, 0xe3, 0x9d, 0x9e, 0xb5, 0xda, 0x1a, 0xd4, 0xaf, 0x0d, 0x14, 0xac, 0xe0, 0xe4,
+  0x68, 0x14, 0xa8, 0x16, 0xa5, 0x90, 0x2b, 0x6f, 0x77, 0xd1, 0xa0, 0x50, 0xc6, 0x1a, 0xff, 0xaa,
+  0x36, 0x28, 0x29, 0x8e, 0x54, 0x96, 0xd3, 0x8e, 0x09, 0x28, 0x59, 0xef, 0x7a, 0x2c, 0x96, 0xc1,
+  0xf4, 0xee, 0xd6, 0x80, 0x46, 0x0a, 0x04, 0xc2, 0x66, 0xb0, 0x42, 0xcd, 0xf4, 0x93, 0x90, 0x25,
+  0xfe, 0x9d, 0xb5, 0x3b, 0xa8, 0x44, 0x5d, 0x1b, 0x10, 0x12, 0x7e, 0x9f, 0xdd, 0x2f, 0x6e, 0x3f,
+  0xfe, 0x46, 0x71, 0xf6, 0x30, 0x3c, 0x76, 0x07, 0x42, 0x49, 0x8b, 0xd2, 0x1a, 0x8f, 0x83, 0x81,
+  0xc4, 0x2d, 0x04, 0x7f, 0x0e, 0x0d, 0x12, 0xfa, 0x7e, 0xcd, 0x6c, 0xb3, 0x3f, 0x69, 0xcf, 0x96,
+  0x8b, 0x82, 0x53, 0x18, 0x21, 0x8d, 0x65, 0x2e, 0x38, 0xa3, 0xc4, 0xd0, 0xf0, 0x90, 0x0b, 0x30,
+  0x59, 0x42, 0xa9, 0x55, 0xdb, 0x43, 0xaf, 0x4b, 0x82, 0x8b, 0xd9, 0x68, 0xc3, 0x74, 0x84, 0x00,
+  0xd7, 0x90, 0x54, 0xcf, 0xf8, 0xe3, 0xcf, 0x6f, 0x2e, 0x8b, 0xe2, 0x87, 0xcb, 0xb7, 0x3f, 0x5d,
+  0xbe, 0x7d, 0x93, 0x4c, 0xfc, 0x8e, 0xc5, 0xcd, 0x6c, 0x3e, 0x77, 0x76, 0x0f, 0xed, 0xbb, 0x04,
+  0xbe, 0x8d, 0x4e, 0xc1, 0xfe, 0x7e, 0xba, 0x9c, 0x3a, 0xb3, 0x4b, 0x7c, 0xe8, 0xf2, 0xf4, 0xe1,
+  0x76, 0x3e, 0x5b, 0x90, 0xe5, 0x8f, 0x24, 0x4f, 0x1e, 0x33, 0x4a, 0xa8, 0x60, 0x36, 0xa5, 0x97,
+  0x95, 0x66, 0x95, 0x28, 0x14, 0x01, 0x4f, 0x2e, 0x20, 0xc9, 0xa3, 0x32, 0xd9, 0x16, 0x9f, 0xe3,
+  0x73, 0xf2, 0x38, 0x9e, 0x50, 0x3a, 0x4b, 0x42, 0x5b, 0x33, 0x63, 0x21, 0xc8, 0x45, 0xd2, 0xc1,
+  0x1a, 0x5b, 0x1b, 0x28, 0xd1, 0x58, 0x2b, 0x56, 0xc2, 0x56, 0x58, 0xae, 0x3a, 0x0b, 0x0f, 0xe2,
+  0x83, 0x00, 0x63, 0x89, 0x5a, 0xe2, 0x90, 0xa4, 0xf4, 0xa9, 0xea, 0x4e, 0x7a, 0x40, 0xef, 0xa6,
+  0xef, 0x6e, 0x66, 0xef, 0x9f, 0x7a, 0xa8, 0x84, 0x81, 0x0b, 0x63, 0x95, 0xde, 0x79, 0x00, 0x2d,
+  0x6a, 0x52, 0x24, 0x2f, 0x3a, 0xbd, 0x61, 0xc9, 0xe3, 0x64, 0x34, 0x32, 0x58, 0x57, 0x19, 0x2b,
+  0xcb, 0x19, 0x69, 0x6c, 0xe7, 0xb4, 0x13, 0x25, 0xea, 0x34, 0xe9, 0xc9, 0x25, 0x9f, 0xaa, 0x93,
+  0x85, 0x15, 0x4a, 0xa6, 0xe8, 0x76, 0x8c, 0xe1, 0x9f, 0x11, 0x80, 0x7f, 0xcc, 0xb6, 0x4c, 0xd8,
+  0x4f, 0x92, 0x50, 0xa4, 0x9e, 0x79, 0x93, 0xb9, 0x12, 0x4a, 0x3d, 0x1f, 0xe3, 0x8c, 0x10, 0xc9,
+  0x74, 0xef, 0xeb, 0x37, 0x04, 0x5f, 0x80, 0x3c, 0x4f, 0x42, 0x3e, 0xc9, 0x15, 0x50, 0x4d, 0x79,
+  0xf0, 0x85, 0x6a, 0x43, 0x49, 0xdd, 0x2c, 0x97, 0x77, 0xbd, 0x92, 0x0d, 0xdb, 0xf5, 0x49, 0x72,
+  0x27, 0xa3, 0x2f, 0x1b, 0x26, 0x9d, 0xa4, 0x8e, 0x9e, 0x50, 0x20, 0x3e, 0xa0, 0x46, 0xdb, 0x69,
+  0x19, 0xbc, 0x5c, 0x2e, 0xd3, 0xba, 0x4e, 0x07, 0xb2, 0x64, 0x0d, 0x6b, 0x0f, 0x50, 0x2a, 0x82,
+  0x11, 0x3d, 0x5c, 0x55, 0xdd, 0xe3, 0x5f, 0x1d, 0xa9, 0x90, 0x56, 0x17, 0xb4, 0xee, 0x43, 0x5c,
+  0x41, 0xc4, 0x07, 0x5f, 0xc6, 0x13, 0xfa, 0x92, 0x3e, 0x40, 0x3f, 0x27, 0x39, 0x0d, 0xe2, 0x78,
+  0x12, 0xcd, 0x5a, 0xb4, 0x0f, 0x44, 0x09, 0xb5, 0x48, 0x1a, 0xdd, 0xc8, 0xff, 0x2c, 0xc5, 0x8c,
+  0xc2, 0x6c, 0x98, 0xc5, 0xff, 0xc7, 0xf1, 0x1a, 0x77, 0x26, 0x3d, 0x85, 0xe2, 0x16, 0x23, 0xbb,
+  0x3d, 0xa4, 0x3b, 0x62, 0x4b, 0x18, 0xa2, 0x83, 0xb8, 0x70, 0xe6, 0x8c, 0x64, 0xb7, 0x74, 0xec,
+  0xc1, 0x67, 0x80, 0x7f, 0x0d, 0xdf, 0x5c, 0xf7, 0xb5, 0xff, 0xea, 0x55, 0x78, 0x73, 0xe5, 0xe3,
+  0x92, 0xf0, 0x31, 0xcf, 0x7c, 0x8e, 0x89, 0x1d, 0x06, 0xec, 0xc1, 0x96, 0x58, 0xa3, 0x45, 0xb2,
+  0xbc, 0x9c, 0xc5, 0xa2, 0x16, 0x6e, 0x14, 0xd0, 0x2f, 0x13, 0xcd, 0x8b, 0x78, 0xac, 0xd0, 0x16,
+  0xfc, 0x0c, 0x89, 0xae, 0x1f, 0x3a, 0x5d, 0x53, 0x1f, 0x38, 0xa9, 0x3f, 0xdd, 0xcf, 0x83, 0x31,
+  0xd3, 0x41, 0xf4, 0x8c, 0x6c, 0x1e, 0x96, 0xa8, 0xe0, 0xc4, 0xd2, 0x20, 0xb5, 0x5a, 0xe9, 0x98,
+  0x48, 0x7e, 0x9d, 0x2d, 0x13, 0xf8, 0xfc, 0xd9, 0x05, 0xca, 0x94, 0x16, 0x2b, 0x1a, 0x66, 0xb4,
+  0x5c, 0x2b, 0x6a, 0x71, 0x3a, 0xae, 0x5f, 0x1a, 0xf7, 0x59, 0x10, 0xce, 0x10, 0x6e, 0x58, 0x80,
+  0xbe, 0x58, 0x3f, 0x56, 0xa9, 0x8b, 0xd0, 0x32, 0xcb, 0x25, 0x6b, 0xa8, 0x1b, 0x7e, 0xb9, 0x86,
+  0xef, 0xa3, 0x6a, 0xf1, 0x70, 0xd3, 0x2a, 0x59, 0x3e, 0x50, 0x9b, 0x47, 0xbd, 0x1b, 0x46, 0xd9,
+  0x1d, 0x63, 0x73, 0x85, 0x2a, 0x56, 0x52, 0x69, 0x5c, 0x20, 0xd3, 0x05, 0xa7, 0x8b, 0x40, 0x77,
+  0xf8, 0x5f, 0x6a, 0xb9, 0xb0, 0x31, 0xfc, 0xbe, 0x2c, 0x68, 0xcd, 0xa5, 0xe2, 0x39, 0x3b, 0x8e,
+  0xea, 0x79, 0x80, 0xbd, 0x4e, 0x80, 0xb5, 0x41, 0x9f, 0xc8, 0x60, 0x9e, 0xbc, 0x20, 0x11, 0xba,
+  0x26, 0xd0, 0xba, 0x1b, 0x8b, 0x26, 0xbf, 0x36, 0x36, 0x5c, 0x52, 0xa1, 0x9f, 0xfd, 0xb5, 0x11,
+  0xa6, 0x9b, 0xa1, 0x29, 0x8e, 0x72, 0x7f, 0xb9, 0xd0, 0x06, 0xf9, 0xda, 0x9e, 0x21, 0xe2, 0x6b,
+  0x58, 0x4f, 0x32, 0x0d, 0xdb, 0x0d, 0x1e, 0xd2, 0x75, 0xc0, 0xe3, 0x6a, 0xa6, 0xd6, 0x07, 0x43,
+  0xa8, 0x09, 0x3f, 0x6e, 0xae, 0x61, 0xbf, 0xa3, 0xa8, 0xe9, 0x92, 0x48, 0x7b, 0x0a, 0xdc, 0x67,
+  0x38, 0xd1, 0x5c, 0xe6, 0xe7, 0x06, 0x5a, 0x3f, 0x74, 0xda, 0xce, 0x9e, 0x6a, 0xe4, 0x8e, 0xf0,
+  0xe5, 0x1b, 0x83, 0x7e, 0x39, 0x56, 0x22, 0x9e, 0x1d, 0x69, 0xcf, 0x0a, 0xaf, 0xf4, 0xb0, 0x31,
+  0x8e, 0x1d, 0xce, 0x17, 0xc4, 0xd7, 0x85, 0x3f, 0x91, 0xfc, 0x3e, 0xe6, 0x8a, 0x5a, 0x2b, 0x9d,
+  0x0e, 0xa0, 0x45, 0xc9, 0x47, 0x4e, 0x3d, 0x0a, 0xac, 0x77, 0xfe, 0x9e, 0x0f, 0x15, 0x90, 0x5a,
+  0xea, 0x61, 0x6a, 0x06, 0xbd, 0x73, 0x29, 0x35, 0x74, 0x69, 0x95, 0x74, 0x07, 0xe7, 0x55, 0x8d,
+  0x48, 0x87, 0xac, 0x14, 0x1a, 0x9a, 0xd1, 0x9a, 0x89, 0x15, 0xa7, 0x41, 0xae, 0x0e, 0x7f, 0x17,
+  0x5c, 0xf0, 0x7f, 0x01, 0x0b, 0x20, 0xbf, 0xeb, 0xc3, 0x08, 0x00, 0x00,
+};
 
-      showGraph();  //Update Graphs    
-      //Update Data Table
-      var table = document.getElementById("dataTable");
-      var row = table.insertRow(1); //Add after headings
-      var cell1 = row.insertCell(0);
-      var cell2 = row.insertCell(1);
-      cell1.innerHTML = time;
-      cell2.innerHTML = ADCValue;
-      
-    }
-    if(parseInt(ADCValue) > 238) {
-      console.log("teste");
-      $("#dialog" ).show();
-    }
-  };
-  xhttp.open("GET", "readADC", true); //Handle readADC server on ESP8266
-  xhttp.send();
-}
+struct ArquivoWeb {
+  const char* caminho;
+  const char* tipo;
+  const char* cache;
+  const char* etag;
+  const uint8_t* dados;
+  size_t tamanho;
+};
 
-    
-</script>
-</body>
- 
-</html>
- 
-)=====";
+const ArquivoWeb ARQUIVOS_WEB[] = {
+  { "/grafico.js", "application/javascript", "max-age=86400", "\"e7535881d505b2ae\"", ARQ_grafico_js_gz, sizeof(ARQ_grafico_js_gz) },
+  { "/manifest.webmanifest", "application/manifest+json", "max-age=86400", "\"4701d7cd1d23468d\"", ARQ_manifest_webmanifest_gz, sizeof(ARQ_manifest_webmanifest_gz) },
+  { "/sw.js", "application/javascript", "no-cache", "\"efd433252a0cbf96\"", ARQ_sw_js_gz, sizeof(ARQ_sw_js_gz) },
+  { NULL, NULL, NULL, NULL, NULL, 0 }
+};
@@ -0,0 +1,72 @@
+// Boot em fases (inicio.ino)
+// Queda de energia na rede é comum: a cada volta o ESP reinicia com o
+// triac num pino ainda sem modo definido. Fase 0 (inicioSeguro(), a
+// primeira linha do setup()): os gatilhos vão a LOW e o disparo fica
+// travado, antes de montar tabelas, abrir a flash ou falar na serial.
+// Fase 1 (resto do setup()): termopares, configuração da flash, tarefa de
+// controle e cruzamento por zero; no fim, inicioControle() destrava o
+// disparo, e daí em diante só o supervisor (seguranca.ino) o trava.
+// Fase 2 (inicioAtender(), no loop()): servidor, WebSocket, WiFi, SNTP,
+// Blynk e celular, um passo por volta; até acabar, o loop() só atende o
+// supervisor e a fila de trabalhos. Os instantes de cada fase saem em
+// /metrics.
+
+enum PassoInicio {
+  INICIO_SERVIDOR,
+  INICIO_WEBSOCKET,
+  INICIO_WIFI,
+  INICIO_RELOGIO,
+#if MODO_BLYNK
+  INICIO_BLYNK,
+#endif
+#if MODO_CELULAR
+  INICIO_CELULAR,
+#endif
+  INICIO_PRONTO
+};
+
+uint8_t inicio_passo = INICIO_SERVIDOR;
+unsigned long inicio_seguro_us = 0;     // micros() no fim da fase 0
+unsigned long inicio_controle_us = 0;   // micros() com o controle rodando
+unsigned long inicio_rede_us = 0;       // micros() com a rede toda iniciada
+
+// Fase 0: nada antes disto. LOW antes do OUTPUT, para o pino não passar
+// por HIGH ao virar saída
+void inicioSeguro(){
+  digitalWrite(triac, LOW);
+  pinMode(triac, OUTPUT);
+#if ZONAS > 1
+  digitalWrite(triac2, LOW);
+  pinMode(triac2, OUTPUT);
+#endif
+  disparo.bloquear();
+  inicio_seguro_us = micros();
+}
+
+// Fim da fase 1: sensor, PID e cruzamento por zero já no ar. O controle
+// já roda e pode ter desarmado; conferido depois de liberar, porque no
+// ESP32 ele desarma do outro núcleo
+void inicioControle(){
+  disparo.liberar();
+  if(segurancaMotivo() != DESARME_NENHUM) disparo.bloquear();
+  inicio_controle_us = micros();
+}
+
+// Fase 2, no loop(): true quando não há mais nada a iniciar
+bool inicioAtender(){
+  switch(inicio_passo){
+    case INICIO_SERVIDOR:  servidorIniciar(); break;
+    case INICIO_WEBSOCKET: wsIniciar(); break;
+    case INICIO_WIFI:      redeIniciar(); break;   // não bloqueia: veja rede.ino
+    case INICIO_RELOGIO:   relogioIniciar(); break;
+#if MODO_BLYNK
+    case INICIO_BLYNK:     blynkIniciar(); break;
+#endif
+#if MODO_CELULAR
+    case INICIO_CELULAR:   celularIniciar(); break;
+#endif
+    default: return true;
+  }
+  if(++inicio_passo == INICIO_PRONTO) inicio_rede_us = micros();
+  return false;
+}
@@ -1,189 +1,1179 @@
 //Importando as Bibliotecas
-#include <ESP8266WiFi.h>
+#include "plataforma.h"   //ESP8266 ou ESP32 (dois núcleos, veja nucleos.ino)
 #include <WiFiClient.h>
-#include <ESP8266WebServer.h>
+#include <WiFiUdp.h>
+#include <WebSocketServer.h>
+#include <WebSocketHub.h>
 #include <sensor_PI2.h>
+#include <atuador_PI2.h>
+#include <controle_PI2.h>
+#include <perfil_PI2.h>
+#include <telemetria_PI2.h>
+#include <registro_PI2.h>
+#include <tarefas_PI2.h>
+#include <mqtt_PI2.h>
+#include <transporte_PI2.h>
+#include <LittleFS.h>
+#if !defined(ESP32)
 #include <Ticker.h>
+#endif
+#include <TimeLib.h>
 #include "index.h"
+#include "config.h"
+#include "corrida.h"
+#include "frota.h"
 
 //Definindo os pinos
 #define maxSO  D0 //  D0
 #define maxCS  D1 //  D1
 #define maxCLK D2 //  D2
-#define triac  12 //  D6
+#define triac  D6 //  GPIO12 no ESP8266
 #define zero   D7
 #define LED 2
 
+//Zonas de aquecimento (1 = forno simples, 2 = resistências de topo e fundo).
+//Cada zona tem um MAX6675 com CS próprio no barramento SCLK/SO comum
+//(lidos juntos por MAX6675Bus), um filtro, um PID e um canal de triac.
+//Na rajada, os canais se revezam nos semiciclos (forno_disparo_simultaneos
+//em /metrics): no mesmo disjuntor, o pico é o de uma zona até 100 % somados
+#define ZONAS 1
+#define maxCS2  D3 //  CS do termopar da zona 2
+#define triac2  D5 //  gatilho da zona 2
+#define RESISTENCIA_W 1500   // potência nominal de cada zona, padrão de w0/w1 em /config (energia.ino)
+#define PARTIDA_RAMPA 10     // subida máxima da potência em %/s, padrão de rampa em /config; 0 = sem limite
+
+//Versão anunciada por mDNS (descoberta.ino); sem -DFIRMWARE_VERSAO no build, a data da compilação
+#ifndef FIRMWARE_VERSAO
+#define FIRMWARE_VERSAO __DATE__
+#endif
+
+//Conversor de termopar: 6675 (barramento MAX6675Bus), 31855 ou 31856. Os dois
+//últimos leem em 1/4 e 1/128 C, informam a junção fria e o tipo de falha; o
+//31856 precisa ainda de um SDI (as portas do SPI de hardware já estão em uso)
+#define CONVERSOR 6675
+#define maxSDI  D8 //  SDI do MAX31856
+
+//Modo de acionamento do triac: 0 = rajada por semiciclos, 1 = ângulo de fase (timer1)
+#define MODO_FASE 0
+
+#if MODO_FASE && ZONAS > 1
+#error "o modo de fase usa o timer1 para um canal só: use rajada com mais de uma zona"
+#endif
+#if MODO_FASE && defined(ESP32)
+#error "o modo de fase usa o timer1 do ESP8266: no ESP32 use a rajada"
+#endif
+
+//Saída serial: 0 = resumo em texto a cada 4 s; FLUXO_CSV ou FLUXO_COBS = um
+//registro por amostra de controle, em BAUD_FLUXO, para sintonia no PC
+#define MODO_SERIAL 0
+#define BAUD_FLUXO 460800
+
+//App Blynk (blynk.ino): 1 = painel com temperatura, set point, potência e
+//estado, e os eventos (eventos.ino) como notificação. Exige o token do
+//projeto; a conexão com o servidor Blynk é feita em segundo plano
+#define MODO_BLYNK 0
+#define BLYNK_TOKEN ""
+//1 = Blynk por TLS (BLYNK_DEFAULT_PORT_SSL); no ESP8266 o BearSSL negocia o
+//tamanho máximo de fragmento e o buffer de recepção cai de 16 KB para
+//o que o servidor aceitar (/metrics, forno_tls_buffer_bytes)
+#define BLYNK_SSL 0
+#if MODO_BLYNK && defined(ESP32)
+#if BLYNK_SSL
+#include <BlynkSimpleEsp32_SSL.h>
+#else
+#include <BlynkSimpleEsp32.h>
+#endif
+#elif MODO_BLYNK && BLYNK_SSL
+#include <BlynkSimpleEsp8266_SSL.h>
+#elif MODO_BLYNK
+#include <BlynkSimpleEsp8266.h>
+#endif
+#if MODO_BLYNK
+#include <WidgetTable.h>
+#include <WidgetTerminal.h>
+#endif
+
+//Telemetria em lotes para um broker MQTT (mqtt.ino): 1 publica em
+//forno/<nome>/telemetria; sem usuário, deixe MQTT_USUARIO em NULL. Com o
+//broker fora, os lotes esperam na flash; com MODO_CELULAR, o MQTT passa
+//para o modem quando o WiFi cai e volta quando ele se firma
+#define MODO_MQTT 0
+#define MQTT_HOST ""
+#define MQTT_PORTA 1883
+#define MQTT_USUARIO NULL
+#define MQTT_SENHA NULL
+
+//Telemetria pelo modem SIM800 (celular.ino), para onde não há WiFi: 1 guarda
+//lotes das amostras na flash e os envia por TCP a CELULAR_HOST. O modem usa
+//D5 e D3, os pinos da segunda zona
+#define MODO_CELULAR 0
+#define CELULAR_APN ""
+#define CELULAR_USUARIO ""
+#define CELULAR_SENHA ""
+#define CELULAR_HOST ""
+#define CELULAR_PORTA 9300
+#define CELULAR_BAUD 57600
+#define modemRX D5
+#define modemTX D3
+#if MODO_CELULAR
+#if ZONAS > 1
+#error "o modem celular ocupa os pinos da zona 2"
+#endif
+#if defined(ESP32)
+#error "o modem usa a SoftwareSerial do ESP8266"
+#endif
+#define TINY_GSM_MODEM_SIM800
+#define TINY_GSM_ASYNC
+#include <TinyGsmClient.h>
+#include <SoftwareSerial.h>
+#endif
+
+//Mostrador local (painel.ino): 1 = MAX7219 de 8 dígitos com temperatura e
+//set point. Divide o SCLK dos termopares (maxCLK) e usa D8 e D3, os pinos
+//do SDI do MAX31856 e da segunda zona
+#define MODO_PAINEL 0
+#define PAINEL_PERIODO_MS 250   // intervalo entre atualizações do mostrador
+#define painelDIN D8
+#define painelCS  D3
+#if MODO_PAINEL
+#if ZONAS > 1 || CONVERSOR == 31856 || MODO_CELULAR
+#error "o mostrador ocupa D8 e D3: use uma zona, MAX6675 ou MAX31855 e sem modem"
+#endif
+#include <DigitLedDisplay.h>
+#endif
+
+//Porta automática (porta.ino): 1 = servo que abre a porta na fase de
+//resfriamento do perfil, em malha fechada na inclinação. O sinal sai no RX
+//(a serial só transmite); o Servo do core usa o timer1, o mesmo do MODO_FASE
+#define MODO_PORTA 0
+#define portaServo 3   // RX
+#if MODO_PORTA
+#if MODO_FASE
+#error "o servo da porta usa o timer1: use o disparo por rajada"
+#endif
+#if defined(ESP32)
+#error "o Servo da biblioteca é o do ESP8266"
+#endif
+#include <Servo.h>
+#endif
+
+//Perfilador (telemetria_PI2): 1 = ciclos de CPU de cada trecho marcado com
+//MEDIR_TRECHO, em /profile e no resumo da serial. Com 0 as marcas somem
+//do código compilado
+#define MODO_PERFIL 0
+#if MODO_PERFIL
+#define MEDIR_TRECHO(nome) static const uint8_t trecho_id = perfilador.trecho(nome); \
+                           MedidaTrecho trecho_medida(perfilador, trecho_id)
+#else
+#define MEDIR_TRECHO(nome)
+#endif
+
+//Latência do cruzamento por zero (LatenciaZero_PI2): 1 = CCOUNT na entrada
+//e na saída de angle(), com os histogramas do atraso até a ISR e até o
+//gatilho em /latency. No MODO_FASE o gatilho sai depois, no timer1, e a
+//saída mede só a ISR
+#define MODO_LATENCIA 0
+
+//Controle preditivo (ControlePreditivo_PI2): 1 = no lugar do PID com
+//alimentação direta, sobre o modelo de /config ou /steptest (ganho 0 no
+//modelo volta ao PID). Prevê PREDITIVO_HORIZONTE passos de
+//PREDITIVO_PASSO_S do perfil; PREDITIVO_LAMBDA pesa as trocas de potência.
+//Compare antes na simulação (simulacao -M)
+#define MODO_PREDITIVO 0
+#define PREDITIVO_PASSO_S 2
+#define PREDITIVO_LAMBDA 0.5
+
+//Estimador da câmara (EstimadorTermico_PI2): 1 = o controle recebe a
+//temperatura estimada pelo modelo de /config ou /steptest e corrigida a
+//cada conversão, sem o atraso do termopar, no lugar da leitura filtrada.
+//ESTIMADOR_TAU_TERMOPAR_S é o padrão do est_tau de /config (atraso da
+//bainha mais o do filtro), que /ident mede; o supervisor continua na leitura. Compare antes na simulação (simulacao -E)
+#define MODO_ESTIMADOR 0
+#define ESTIMADOR_TAU_TERMOPAR_S 2.5
+
+//Sondas sem fio na placa (sonda.ino, sketch sonda_placa/): 1 = até
+//SONDA_NOS MAX6675 a bateria presos à placa mandam cada leitura por rádio
+//e o controle segue a placa: o ar corrigido pela diferença ar-placa média
+//(FusaoPlaca_PI2), com constante SONDA_TAU_S; sem pacotes por 2 s volta ao
+//ar. O forno manda a cada SONDA_BALIZA_MS o relógio dele e as sondas leem
+//juntas a cada SONDA_PERIODO_MS, para o gradiente na placa. O supervisor
+//fica no ar. O rádio divide o SCLK e o SO dos termopares e usa D8, D3 e D5
+#define MODO_SONDA 0
+#define SONDA_RADIO 69             // 69 = RFM69 (RH_RF69), 95 = LoRa (RH_RF95)
+#define SONDA_FREQUENCIA_MHZ 915.0
+#define SONDA_ENDERECO 100         // o SONDA_FORNO das sondas, fora de 1 a SONDA_NOS
+#define SONDA_TAU_S 5
+#define SONDA_PERIODO_MS 250       // MAX6675: conversão de 220 ms
+#define SONDA_BALIZA_MS 1000
+#define sondaMOSI D8
+#define sondaCS   D3
+#define sondaDIO0 D5
+#if MODO_SONDA
+#if ZONAS > 1 || CONVERSOR == 31856 || MODO_PAINEL || MODO_CELULAR
+#error "o rádio da sonda ocupa D8, D3 e D5: use uma zona, MAX6675 ou MAX31855, sem mostrador nem modem"
+#endif
+#include <RHSoftwareSPI.h>
+#include <RHDatagram.h>
+#if SONDA_RADIO == 95
+#include <RH_RF95.h>
+#else
+#include <RH_RF69.h>
+#endif
+#endif
+
+//Ambiente (ambiente.ino): 1 = um DHT22 fora do forno mede a temperatura e
+//a umidade da sala; a temperatura, filtrada com AMBIENTE_TAU_S e levada ao
+//controle no máximo a cada AMBIENTE_PERIODO_MS, entra no lugar do ff_amb
+//de /config no modelo (alimentação direta, perdas, preditivo e estimador).
+//Congela durante a corrida; sem leitura boa por AMBIENTE_VALIDADE_MS volta
+//ao ff_amb. No ESP8266 o D4 é o GPIO2 do LED da placa, que sai
+#define MODO_AMBIENTE 0
+#define AMBIENTE_TIPO DHT22
+#define AMBIENTE_TAU_S 60
+#define AMBIENTE_PERIODO_MS 30000
+#define AMBIENTE_VALIDADE_MS 300000
+#define ambienteDHT D4
+#if MODO_AMBIENTE
+#include <DHT_U.h>
+#endif
+
+//Fila de lotes (fila.ino): 1 = /queue guarda lotes (perfil, placas, notas)
+//e cada corrida começa sozinha com a câmara abaixo de FILA_FRIA e a porta
+//fechada há FILA_FECHADA_MS depois de aberta para trocar a placa. A porta
+//é um reed entre o A0 e o GND (fechado com a porta fechada), com 10k do
+//A0 ao 3,3 V
+#define MODO_FILA 0
+#define FILA_FRIA 40.0          // C, abaixo de CORRIDA_FRIA: a placa nova não entra quente
+#define FILA_FECHADA_MS 5000    // a mão do operador já saiu
+#define filaPorta A0
+
+//Controle remoto infravermelho (ir.ino): 1 = um receptor de 38 kHz
+//(VS1838B, TSOP) no D4 e um controle NEC barato iniciam, abortam, pausam e
+//trocam o perfil. Só o endereço IR_ENDERECO vale. O D4 é o GPIO2 do LED da
+//placa, que sai; o receptor fica em nível alto em repouso, como o boot
+//pede. Compile o IRremoteESP8266 só com o NEC:
+//-D_IR_ENABLE_DEFAULT_=false -DDECODE_NEC=true (no arduino-cli,
+//--build-property compiler.cpp.extra_flags=...)
+#define MODO_IR 0
+#define IR_ENDERECO 0x00     // endereço NEC do controle (o valor de /metrics, forno_ir_ultimo_endereco)
+#define IR_INICIAR  0x45     // comandos NEC de cada botão
+#define IR_ABORTAR  0x47
+#define IR_PAUSAR   0x44
+#define IR_PERFIL_PROXIMO  0x43
+#define IR_PERFIL_ANTERIOR 0x40
+#define irPino D4
+#if MODO_IR
+#if MODO_AMBIENTE
+#error "o receptor IR e o DHT do ambiente usam o D4"
+#endif
+#include <IRrecv.h>
+#if !DECODE_NEC
+#error "o controle remoto é NEC: compile o IRremoteESP8266 com DECODE_NEC"
+#endif
+#endif
+
+//Repouso entre turnos (repouso.ino): 1 = parado há REPOUSO_MIN minutos (sem
+//corrida, sintonia, inscritos nem OTA), o loop() cede a CPU a cada volta e
+//o ESP8266 dorme em light sleep entre os Tickers, com o rádio acordando a
+//cada DTIM. O botão FLASH do NodeMCU (GPIO0, o D3) acorda na hora
+#define MODO_REPOUSO 0
+#define REPOUSO_MIN 10
+#define REPOUSO_PASSO_MS 10   // sono por volta: o período do timerSensor
+#define repousoBotao D3
+#if MODO_REPOUSO && (ZONAS > 1 || MODO_PAINEL)
+#error "o botão do repouso é o D3, já usado pela segunda zona e pelo mostrador"
+#endif
+
 //Instanciando os Objetos
-MAX6675_PI2 moduloMAX(maxCLK, maxCS, maxSO);
+PeriodoRede_PI2 rede;        //semiciclo medido no cruzamento por zero, 50 ou 60 Hz
+MedidorEnergia_PI2 energia;  //kWh das resistências, somado em angle() (energia.ino)
+#if MODO_FASE
+FaseTriac_PI2 disparo(triac, &rede);
+#else
+const uint8_t pinos_triac[ZONAS] = { triac
+#if ZONAS > 1
+  , triac2
+#endif
+};
+CanaisRajada_PI2 disparo(pinos_triac, ZONAS);   // uma ISR para todos os canais
+#endif
+#if !defined(ESP32)
 Ticker timerSensor;
-Ticker timerPerfil;
 Ticker timerSerial;
-ESP8266WebServer server(80); //Server on port 80
+Ticker timerControle;
+#if MODO_PAINEL
+Ticker timerPainel;
+#endif
+#endif
+ServidorWeb server(80); //Server on port 80
+Telemetria_PI2 telemetria;   //retrato consistente para web e serial
+#if MODO_SERIAL
+FluxoSerial_PI2 fluxo(MODO_SERIAL);
+#endif
+Historico_PI2 historico;     //corrida inteira, para /history
+RegistroCorrida_PI2 registro; //arquivo de cada corrida na LittleFS, para /log
+AnaliseCorrida_PI2 analise;   //pico, TAL, patamar e rampas da corrida, para /run/summary
+FilaTrabalho_PI2 trabalhos;  //o que os Tickers pedem e o loop() executa
+#if MODO_PERFIL
+Perfilador_PI2 perfilador;   //tempo por trecho, para /profile
+#endif
+#if MODO_LATENCIA
+LatenciaZero_PI2 latencia;   //atraso da ISR do cruzamento por zero, para /latency
+#endif
+
+//Trabalhos adiados: o Ticker só posta, o loop() executa entre os atendimentos
+#define TRABALHO_SENSOR 1      // consultar o barramento dos termopares
+#define TRABALHO_SERIAL 2      // resumo em texto na serial
+#define TRABALHO_EVENTO 3      // evento detectado pelo controle, na fila própria (eventos.ino)
+#define TRABALHO_PAINEL 4      // atualizar o mostrador local (painel.ino)
+#define TRABALHO_IR 5          // botão do controle remoto (ir.ino)
+#define ORCAMENTO_TRABALHOS_US 3000   // tempo máximo de trabalhos por volta do loop()
 
 //Variáveis Globais 
-bool inits = false; 
+EstadoCorrida corrida = CORRIDA_OCIOSA;   // veja corrida.ino
 
 //const char* ssid = "S9 gustavo";
 //const char* password = "fernandinha";
 const char* ssid = "leothi_note";
 const char* password = "VmcVl7CJ";
 
-float kc=5.207;
+float kc=5.207;  // ganhos discretos, por amostra de Ts
 float ki=0.006;
 float kd=55.44;
-int Ts=100;    
-float Ti= (kc*Ts)/ki; 
-float Td= (kd*Ts)/kc;  
-float ek_1=0;
-float ek_2=0;
-float uk_1=0;
-float yk=0; 
-float rk=0;  
-float ek= yk-rk;
-float uk= kc*(ek-ek_1+ Ts/Ti*ek+Td/Ts*(ek-2*ek_1+ek_2))+uk_1;
-
-int contCiclos=0;
+int Ts=100;    // período de amostragem do controle em ms (timerControle)
+float rk=0;                    // média das zonas: é o que o perfil e a web veem
+unsigned long instante_rk=0;   // millis() da amostra mais recente em rk
+bool falha_sensor=false;       // termopar aberto em qualquer zona: tudo desligado
+float uk=0;
+
+#if CONVERSOR == 6675
+const int8_t pinos_cs[ZONAS] = { maxCS
+#if ZONAS > 1
+  , maxCS2
+#endif
+};
+MAX6675Bus termopares(maxCLK, maxSO, pinos_cs, ZONAS);
+#else
+#if CONVERSOR == 31855
+MAX31855_PI2 termopar1(maxCLK, maxCS, maxSO);
+#if ZONAS > 1
+MAX31855_PI2 termopar2(maxCLK, maxCS2, maxSO);
+#endif
+#elif CONVERSOR == 31856
+MAX31856_PI2 termopar1(maxCLK, maxCS, maxSO, maxSDI);
+#if ZONAS > 1
+MAX31856_PI2 termopar2(maxCLK, maxCS2, maxSO, maxSDI);
+#endif
+#else
+#error "CONVERSOR deve ser 6675, 31855 ou 31856"
+#endif
+Termopar_PI2* sensores[ZONAS] = { &termopar1
+#if ZONAS > 1
+  , &termopar2
+#endif
+};
+#endif
+
+struct Zona {
+  FiltroTemperatura_PI2 filtro;
+  PidController pid;           // saída em % de potência
+  float rk;
+  unsigned long instante_rk;
+  float uk;
+  Supervisor_PI2 supervisor;   // desarme independente do PID (seguranca.ino)
+  ControlePreditivo_PI2 preditivo;   // MODO_PREDITIVO
+  EstimadorTermico_PI2 estimador;    // MODO_ESTIMADOR
+  unsigned long instante_estimado;   // instante_rk já usado pelo estimador
+  float medida;                      // o que o controle vê: rk ou a estimativa
+  CalibracaoTermopar_PI2 calibracao; // contra a sonda de referência, de /config
+};
+
+Zona zonas[ZONAS] = {
+  { FiltroTemperatura_PI2(3, 1), PidController(kc, ki, kd, 0, 100), 0, 0, 0, Supervisor_PI2(), ControlePreditivo_PI2(),
+    EstimadorTermico_PI2(), 0, 0, CalibracaoTermopar_PI2() },
+#if ZONAS > 1
+  { FiltroTemperatura_PI2(3, 1), PidController(kc, ki, kd, 0, 100), 0, 0, 0, Supervisor_PI2(), ControlePreditivo_PI2(),
+    EstimadorTermico_PI2(), 0, 0, CalibracaoTermopar_PI2() },
+#endif
+};
+PerfilReflow_PI2 perfil;                 // perfil ativo, escolhido em /perfil
+AutoSintonia_PI2 sintonia;               // relé de /autotune (sintonia.ino)
+ModeloTermico_PI2 modelo;                // alimentação direta, de /config ou /steptest
+EnsaioDegrau_PI2 ensaio;                 // degrau de /steptest (sintonia.ino)
+IdentificacaoTermica_PI2 identificacao;  // modelo medido numa corrida, /ident (sintonia.ino)
+
+// Estatísticas de temporização da tarefa de controle (em us)
+unsigned long tc_ultimo=0;       // instante da última execução
+unsigned long tc_min=0;          // menor período medido
+unsigned long tc_max=0;          // maior período medido
+unsigned long tc_jitter=0;       // maior desvio em relação a Ts
+unsigned long long tc_soma=0;    // soma dos períodos, para a média
+unsigned long tc_amostras=0;     // número de períodos medidos
+volatile uint32_t isr_cruzamentos=0;   // interrupções de cruzamento por zero, para /metrics
+
 int controle_potencia=0;
+uint32_t corrida_ms=0;           // ms de corrida, somados a cada Ts: base do arquivo e do histórico
+uint16_t historico_tempo=0;      // segundos de corrida no histórico, o próximo a registrar
 
 int t_perfil=0;
 int array_perfil=0;
 float set_point=0;
-float perfil_temp [19]={28.9988,52.1978,75.9768,99.1758,128.7545,141.5140,155.4334,174.5726,197.1916,224.4505,241.8498,209.9511,181.5323,156.5934,128.1746,101.4957,75.3968,55.6776,28.9988};
-int perfil_tempo[19]={4,18,31,48,74,89,111,129,143,161,180,201,210,220,232,246,262,276,298};
  
 
+// Boot em fases (inicio.ino): 0 = triac desligado e travado, 1 = sensores,
+// flash e controle, 2 = rede, já no loop(), um passo por volta
 void setup()
 {
-  pinMode(triac, OUTPUT);
+  inicioSeguro();
+  disparo.iniciar();
+#if CONVERSOR == 31856
+  termopar1.iniciar(MAX31856_TIPO_K, 60);
+#if ZONAS > 1
+  termopar2.iniciar(MAX31856_TIPO_K, 60);
+#endif
+#endif
+#if !MODO_AMBIENTE && !MODO_IR
   pinMode(LED, OUTPUT);
+#endif
+#if MODO_SERIAL
+  Serial.begin(BAUD_FLUXO);
+  if(MODO_SERIAL == FLUXO_CSV) Serial.println("t_ms,rk,set_point,uk,potencia,estado");
+#else
   Serial.begin(9600); //apenas para debugar
-
-  WiFi.begin(ssid, password);     //Connect to your WiFi router
   Serial.println("");
+#endif
 
-  while (WiFi.status() != WL_CONNECTED) {
-    delay(500);
-    Serial.print(".");
+  // a flash é local e rápida: ganhos, Ts e perfil gravados valem desde o boot
+  if(!LittleFS.begin() || !registro.iniciar(LittleFS)){
+    Serial.println("LittleFS indisponivel: corridas nao serao gravadas");
   }
+  energiaIniciar();
+  configCarregar();
+#if MODO_SONDA
+  sondaIniciar();
+#endif
+#if MODO_AMBIENTE
+  ambienteIniciar();
+#endif
+#if MODO_FILA
+  filaIniciar();
+#endif
+#if MODO_IR
+  irIniciar();
+#endif
+#if MODO_REPOUSO
+  repousoIniciar();
+#endif
 
-  Serial.println("");
-  Serial.print("Connected to ");
-  Serial.println(ssid);
-  Serial.print("IP address: ");
-  Serial.println(WiFi.localIP());  //IP address assigned to your ESP
-  
+#if defined(ESP32)
+#if MODO_PAINEL
+  painelIniciar();
+#endif
+  nucleosIniciarControle();   // sensor, PID e disparo no NUCLEO_CONTROLE
+#else
+  // atraso, duração e períodos perdidos de cada tarefa, para /tickers
+  timerSensor.enableStats(true);
+  timerSerial.enableStats(true);
+  timerControle.enableStats(true);
+  // só o controle roda no contexto do timer (amostragem em Ts exato);
+  // leitura do SPI e serial vão para a fila e rodam no loop()
+  timerSensor.attach_ms(10,[](){ trabalhos.postar(TRABALHO_SENSOR); });
+#if !MODO_SERIAL
+  timerSerial.attach(4,[](){ trabalhos.postar(TRABALHO_SERIAL); });
+#endif
+  timerControle.attach_ms(Ts,controle_pid);
+#if MODO_PAINEL
+  painelIniciar();
+  timerPainel.attach_ms(PAINEL_PERIODO_MS,[](){ trabalhos.postar(TRABALHO_PAINEL); });
+#endif
+#endif
+#if MODO_PORTA
+  portaIniciar();
+#endif
+
+  attachInterrupt(zero, angle, RISING);
+  inicioControle();   // destrava o disparo: daqui em diante vale o supervisor
+
+#if defined(ESP32)
+  nucleosIniciarRede();       // laco() no NUCLEO_REDE; este loop() termina
+#else
+  segurancaIniciar();
+#endif
+}
+
+// Fase 2 do boot, chamada por inicioAtender(): o servidor pode ser
+// registrado sem IP; atende assim que a rede subir
+void servidorIniciar(){
+  const char* cabecalhos[] = {"If-None-Match"};
+  server.collectHeaders(cabecalhos, 1);
   server.on("/", handleRoot);      //Which routine to handle at root location. This is display page
   server.on("/readADC", handleADC); //This page is called by java Script AJAX
   server.on("/init", HTTP_POST, handleInit);
+  server.on("/start", handleStart);
+  server.on("/abort", handleAbort);
+  server.on("/pause", handlePause);
+  server.on("/run", handleRun);
+  server.on("/run/summary", handleRunSummary);
+  server.on("/perfil", handlePerfil);
+  server.on("/perfil/upload", HTTP_POST, handlePerfilUpload, configReceberPerfil);
+  server.on("/perfil/curva", handlePerfilCurva);
+  server.on("/history", handleHistory);
+  server.on("/log", handleLog);
+  server.on("/config", handleConfig);
+  server.on("/autotune", handleAutotune);
+  server.on("/steptest", handleSteptest);
+  server.on("/ident", handleIdent);
+#if !defined(ESP32)
+  server.on("/tickers", handleTickers);
+#endif
+  server.on("/metrics", handleMetrics);
+#if MODO_PERFIL
+  server.on("/profile", handleProfile);
+#endif
+#if MODO_LATENCIA
+  server.on("/latency", handleLatency);
+#endif
+  server.on("/events", HTTP_GET, handleEvents);
+  server.on("/fleet", handleFleet);
+#if MODO_FILA
+  server.on("/queue", handleQueue);
+#endif
+  otaIniciar();
+  for(const ArquivoWeb* a = ARQUIVOS_WEB; a->caminho != NULL; a++){
+    server.on(a->caminho, [a](){ handleArquivo(*a); });
+  }
   
   server.begin();  
   Serial.println("HTTP server started");
-  Serial.println("");  
-  
-  timerSensor.attach(3,sensor_ler);
-  timerPerfil.attach(1,perfil_reflow);
-  timerSerial.attach(4,exibirSerial);
-
-  attachInterrupt(zero, angle, RISING);
 }
 
 void loop()
 {
-  server.handleClient();     
-  if(inits == true){
-    yk=set_point;   // set point
-    ek= yk-rk;
-    uk= (kc*((ek-ek_1)+ ((Ts/Ti)*(ek))+((Td/Ts)*(ek-2*ek_1+ek_2))))+uk_1; 
-    
-    controle_potencia=uk;
-    if((yk<rk)) { 
-    controle_potencia=0;
-    uk=0;
+#if defined(ESP32)
+  vTaskDelete(NULL);          // a rede roda em nucleos.ino
+#else
+  laco();
+#endif
+}
+
+// Rede, web, fila de trabalhos e flash: o loop() no ESP8266, a tarefa
+// da rede no ESP32
+void laco()
+{
+  metricasVolta();
+  MEDIR_TRECHO("loop");
+  { MEDIR_TRECHO("seguranca"); segurancaAtender(); }
+  if(!inicioAtender()){   // rede ainda subindo: só o que o controle precisa
+    trabalhos.drenar(executarTrabalho, ORCAMENTO_TRABALHOS_US);
+    eventosAtender();
+    return;
+  }
+  { MEDIR_TRECHO("rede"); redeAtender(); }
+  relogioAtender();
+  otaAtender();
+  { MEDIR_TRECHO("web"); atenderWeb(server); }
+#if MODO_IR
+  { MEDIR_TRECHO("ir"); irAtender(); }   // antes dos trabalhos: o comando sai nesta volta
+#endif
+  { MEDIR_TRECHO("trabalhos"); trabalhos.drenar(executarTrabalho, ORCAMENTO_TRABALHOS_US); eventosAtender(); }
+  { MEDIR_TRECHO("websocket"); wsAtender(); }
+  { MEDIR_TRECHO("frota"); frotaAtender(); }
+  { MEDIR_TRECHO("mdns"); descobertaAtender(); }
+#if MODO_MQTT
+  { MEDIR_TRECHO("mqtt"); mqttAtender(); }
+#endif
+#if MODO_BLYNK
+  { MEDIR_TRECHO("blynk"); blynkAtender(); }
+#endif
+#if MODO_CELULAR
+  { MEDIR_TRECHO("celular"); celularAtender(); }
+#endif
+  sintoniaAtender();
+#if MODO_AMBIENTE
+  ambienteAtender();
+#endif
+#if MODO_FILA
+  filaAtender();
+#endif
+#if MODO_SERIAL
+  fluxo.atender(Serial);   // só o que cabe no FIFO da UART
+#endif
+
+  // a flash só é escrita aqui, nunca na tarefa de controle
+  { MEDIR_TRECHO("registro"); registro.atender(); }
+  if(registro.aberto() && !corridaAtiva()){   // esfriou, abortada ou desarme
+    corridaFecharRegistro();
+  }
+#if MODO_REPOUSO
+  repousoAtender();   // por último: pode dormir até a próxima volta
+#endif
+}
+
+void executarTrabalho(const Trabalho& t){
+  switch(t.tipo){
+    case TRABALHO_SENSOR: sensor_ler(); break;
+    case TRABALHO_SERIAL: exibirSerial(); break;
+#if MODO_PAINEL
+    case TRABALHO_PAINEL: painelAtualizar(); break;
+#endif
+#if MODO_IR
+    case TRABALHO_IR: irExecutar(t); break;
+#endif
+  }
+}
+
+// Tarefa de controle: executada a cada Ts ms pelo timerControle
+void controle_pid(){
+  MEDIR_TRECHO("controle");
+  registrarPeriodo(micros());
+  configAtualizarControle();
+#if MODO_AMBIENTE
+  configAmbiente();
+#endif
+
+  // o supervisor olha as leituras antes de qualquer cálculo; desarmado,
+  // o disparo já está travado e a corrida termina aqui
+  bool seguro = segurancaVerificar();
+  if(!seguro) corridaFalha();
+  else if(zonasValidas()) corridaPasso();
+#if MODO_PORTA
+  portaAtualizar();
+#endif
+
+  // Sem leitura válida o PID não roda: NAN não pode chegar no integrador
+  estimarZonas();
+  identificacaoAmostra(controle_potencia);   // a potência do passo que terminou
+  bool sintonizando = seguro && corridaSintonizando();
+  bool aquecendo = corridaAquecendo();
+  // a rampa de partida e o adiamento da frota limitam o disparo; uk nunca
+  // passa disso, então o supervisor, o estimador e o registro veem a
+  // potência aplicada e o integrador não acumula o que não foi entregue
+  float teto[ZONAS];
+  for(uint8_t z=0; z<ZONAS; z++) teto[z] = tetoPotencia(z);
+  if(!seguro || falha_sensor || !zonasValidas() || (!aquecendo && !sintonizando)){
+    for(uint8_t z=0; z<ZONAS; z++){
+      zonas[z].uk = 0;
+      zonas[z].pid.reiniciar();
+      zonas[z].preditivo.reiniciar();
     }
-      
-    if((controle_potencia > 100) && (yk>=rk)){
-       controle_potencia=100;
-       uk=100;  
+    sintonia.cancelar();
+    ensaio.cancelar();
+  }
+  else if(sintonizando){
+    // relé ou degrau no lugar do PID, a mesma potência em todas as zonas
+    float u = (sintonia.estado() == SINTONIA_RODANDO) ? sintonia.atualizar(rk) : ensaio.atualizar(rk);
+    for(uint8_t z=0; z<ZONAS; z++) zonas[z].uk = (u < teto[z]) ? u : teto[z];
+  }
+#if MODO_PREDITIVO
+  else if(zonas[0].preditivo.ativo()){
+    // o set point que o perfil terá em cada passo do horizonte
+    float referencias[PREDITIVO_HORIZONTE];
+    for(uint8_t i=0; i<PREDITIVO_HORIZONTE; i++){
+      referencias[i] = (corrida == CORRIDA_RODANDO) ? perfil.previsao((i + 1) * PREDITIVO_PASSO_S * 1000UL) : set_point;
     }
-    if(controle_potencia<0){
-      controle_potencia=0;
-      uk=0;
-    }  
-       
-    ek_2=ek_1;
-    ek_1=ek;
-    uk_1=uk; 
-  }
-}
-
-void angle(){
-  if(inits == true) {
-      contCiclos++;
-         
-      if(contCiclos>100){
-          contCiclos=0;
-        }      
-      if(contCiclos<=controle_potencia){
-       digitalWrite(triac, HIGH);         
-       }
-      else if((contCiclos>=controle_potencia) && (contCiclos<=10)){
-       digitalWrite(triac,LOW);       
-      }
-  }
-}
-
-// Timer
+    for(uint8_t z=0; z<ZONAS; z++){
+      zonas[z].uk = zonas[z].preditivo.atualizar(referencias, zonas[z].medida, teto[z]);
+    }
+  }
+#endif
+  else {
+    // modelo na rampa mais PID, a mesma lei da simulação (simulacao/)
+    float inclinacao = (corrida == CORRIDA_RODANDO) ? perfil.inclinacao() : 0;
+    for(uint8_t z=0; z<ZONAS; z++){
+      zonas[z].uk = controleRampa(zonas[z].pid, modelo, set_point, inclinacao, zonas[z].medida, teto[z]);
+    }
+  }
+
+  bool liberado = seguro && (aquecendo || sintonizando) && !falha_sensor;
+  float soma = 0;
+  for(uint8_t z=0; z<ZONAS; z++){
+    aplicarPotencia(z, liberado ? zonas[z].uk : 0);
+    soma += zonas[z].uk;
+  }
+  uk = soma / ZONAS;
+  controle_potencia = uk;
+  energiaAtualizar();
+  publicarAmostra();
+  eventosDetectar();
+  registrarHistorico();
+  if(corridaAtiva()){
+    uint8_t estado = (array_perfil & REGISTRO_SEGMENTO) | (falha_sensor ? REGISTRO_FALHA_SENSOR : 0);
+    registro.registrar((uint16_t)(corrida_ms / 100), rk, set_point, controle_potencia, estado);
+    analise.adicionar(corrida_ms, rk);
+    corrida_ms += Ts;
+  }
+  else corridaEncerrarAnalise();
+}
+
+// Uma amostra por segundo de corrida no anel lido por /history
+void registrarHistorico(){
+  if(!corridaAtiva()) return;
+  if(corrida_ms < historico_tempo * 1000UL) return;
+  historico.registrar(historico_tempo++, rk, controle_potencia);
+}
+
+// Única escrita do retrato lido por handleADC() e exibirSerial()
+void publicarAmostra(){
+  AmostraControle a;
+  a.timestamp = millis();
+  a.utc_us = relogioUtc();
+  a.instante_rk = instante_rk;
+  a.rk = rk;
+  a.set_point = set_point;
+  a.uk = uk;
+  a.controle_potencia = controle_potencia;
+  a.t_perfil = t_perfil;
+  a.array_perfil = array_perfil;
+  a.falha_sensor = falha_sensor;
+  a.desarme = segurancaMotivo();
+  a.corrida = corrida;
+  a.energia_Wh = energiaCorridaWh();
+  telemetria.publicar(a);
+#if MODO_SERIAL
+  fluxo.registrar(a);
+#endif
+}
+
+// Mede o período real entre execuções da tarefa de controle
+void registrarPeriodo(unsigned long agora){
+  if(tc_ultimo != 0){
+    unsigned long periodo = agora - tc_ultimo;
+    unsigned long nominal = (unsigned long)Ts*1000;
+    unsigned long desvio = (periodo > nominal) ? periodo-nominal : nominal-periodo;
+
+    if((tc_amostras == 0) || (periodo < tc_min)) tc_min = periodo;
+    if(periodo > tc_max) tc_max = periodo;
+    if(desvio > tc_jitter) tc_jitter = desvio;
+    tc_soma += periodo;
+    tc_amostras++;
+  }
+  tc_ultimo = agora;
+}
+
+void aplicarPotencia(uint8_t z, float potencia){
+#if MODO_FASE
+  disparo.definirPotencia(potencia);
+#else
+  disparo.definirPotencia(z, (int)potencia);
+#endif
+}
+
+float tetoPotencia(uint8_t z){
+#if MODO_FASE
+  (void)z;
+  return disparo.teto();
+#else
+  return disparo.teto(z);
+#endif
+}
+
+bool zonasValidas(){
+  for(uint8_t z=0; z<ZONAS; z++){
+    if(!zonas[z].filtro.valido()) return false;
+  }
+  return true;
+}
+
+// Cruzamento por zero: o motor de disparo decide se/quando o semiciclo
+// conduz. Bordas cedo demais para a rede medida são ruído no
+// optoacoplador e não avançam o disparo (contadas em /metrics)
+void IRAM_ATTR angle(){
+  uint32_t entrada = ciclosCpu();
+  isr_cruzamentos++;
+  if(!rede.registrar(entrada)) return;
+  disparo.cruzamentoZero();
+  uint32_t periodo = rede.periodoUs();
+  for(uint8_t z=0; z<ZONAS; z++) energia.semiciclo(z, disparo.conducao(z), periodo);
+#if MODO_LATENCIA
+  latencia.registrar(entrada, ciclosCpu());   // o GPIO do gatilho já foi escrito
+#endif
+}
+
+// Pedido pelo timerSensor a cada 10 ms e executado no loop(); quando a
+// conversão terminou (~4 Hz) todas as zonas são lidas em uma varredura,
+// com o mesmo instante
 void sensor_ler(){
-   rk = moduloMAX.lerCelsius();
+#if MODO_SONDA
+   sondaAtender();   // mesmo barramento: nunca no meio de uma leitura
+#endif
+#if CONVERSOR != 6675
+   // conversores separados: cada zona entra quando a sua conversão termina
+   bool nova = false;
+   for(uint8_t z=0; z<ZONAS; z++){
+     if(!sensores[z]->atualizar()) continue;
+     Zona &zn = zonas[z];
+     zn.filtro.adicionar(zn.calibracao.corrigir(sensores[z]->ultimaCelsius()));
+     if(zn.filtro.valido()){
+       zn.rk = zn.filtro.celsius();
+       zn.instante_rk = sensores[z]->instanteAmostra();
+     }
+     nova = true;
+   }
+   if(nova) agregarZonas();
+#else
+   if(!termopares.atualizar()) return;
+
+   unsigned long instante = termopares.ultima().instante;
+   for(uint8_t z=0; z<ZONAS; z++){
+     Zona &zn = zonas[z];
+     zn.filtro.adicionar(zn.calibracao.corrigir(termopares.celsius(z)));
+     if(zn.filtro.valido()){
+       zn.rk = zn.filtro.celsius();
+       zn.instante_rk = instante;
+     }
+   }
+   agregarZonas();
+#endif
+}
+
+// controle_pid(): a medida de cada zona para o controle. O estimador
+// avança um Ts com a potência que acabou de ser aplicada e se corrige
+// quando há conversão nova; com a sonda, a medida passa à placa
+void estimarZonas(){
+#if MODO_ESTIMADOR
+  bool validas = !falha_sensor && zonasValidas();
+#endif
+  for(uint8_t z=0; z<ZONAS; z++){
+    Zona &zn = zonas[z];
+    zn.medida = zn.rk;
+#if MODO_ESTIMADOR
+    if(!validas){
+      zn.estimador.reiniciar();
+      continue;
+    }
+    if(zn.estimador.ativo()){
+      zn.medida = zn.estimador.atualizar(zn.uk, zn.rk, zn.instante_rk != zn.instante_estimado);
+      zn.instante_estimado = zn.instante_rk;
+    }
+#endif
+#if MODO_SONDA
+    zn.medida = sondaFundir(zn.medida, zn.instante_rk);
+#endif
+  }
+}
+
+// rk, instante_rk e falha_sensor resumem as zonas para o resto do sketch
+void agregarZonas(){
+   bool falha = false;
+   float soma = 0;
+   unsigned long instante = 0;
+   for(uint8_t z=0; z<ZONAS; z++){
+     falha = falha || zonas[z].filtro.falha();
+     soma += zonas[z].rk;
+     if((long)(zonas[z].instante_rk - instante) > 0) instante = zonas[z].instante_rk;
+   }
+   falha_sensor = falha;
+   if(zonasValidas()){
+     rk = soma / ZONAS;
+     instante_rk = instante;
+   }
 }
 
 void exibirSerial(){     
+    AmostraControle a;
+    telemetria.ler(a);
+
     Serial.println("");
     Serial.println("");
-    Serial.print("sensor C = "); Serial.println(rk); //apenas verificando a saida
-    Serial.print("temperatura desejada = "); Serial.println(set_point); //quando é float acrescenta um long
-    Serial.print("controle_potencia = "); Serial.println(controle_potencia); //apenas verificando a saida
-    Serial.print("uk = "); Serial.println(uk); //apenas verificando a saida
-    Serial.print("tempo = "); Serial.println(t_perfil); //apenas verificando a saida
-    Serial.print("posicao = "); Serial.println(array_perfil); //apenas verificando a saida
-    Serial.print("inits = "); Serial.println(inits);
+    Serial.print("sensor C = "); Serial.println(a.rk); //apenas verificando a saida
+    Serial.print("temperatura desejada = "); Serial.println(a.set_point); //quando é float acrescenta um long
+    Serial.print("controle_potencia = "); Serial.println(a.controle_potencia); //apenas verificando a saida
+    Serial.print("uk = "); Serial.println(a.uk); //apenas verificando a saida
+    Serial.print("tempo = "); Serial.println(a.t_perfil); //apenas verificando a saida
+    Serial.print("posicao = "); Serial.println(a.array_perfil); //apenas verificando a saida
+    Serial.print("corrida = "); Serial.println(corridaNome());
+    Serial.print("falha sensor = "); Serial.println(a.falha_sensor);
+    Serial.print("desarme = "); Serial.println(a.desarme);
+#if ZONAS > 1
+    for(uint8_t z=0; z<ZONAS; z++){
+      Serial.print("zona "); Serial.print(z + 1); Serial.print(" C / % = ");
+      Serial.print(zonas[z].rk); Serial.print(" / "); Serial.println(zonas[z].uk);
+    }
+#endif
+    Serial.print("wifi = "); Serial.println(redeConectada() ? "conectado" : "sem rede");
+    if(tc_amostras > 0){
+      Serial.print("periodo controle us (min/med/max) = ");
+      Serial.print(tc_min); Serial.print(" / ");
+      Serial.print((unsigned long)(tc_soma/tc_amostras)); Serial.print(" / ");
+      Serial.println(tc_max);
+      Serial.print("jitter controle us = "); Serial.println(tc_jitter);
+    }
+    Serial.print("fila trabalhos (pico/descartes) = ");
+    Serial.print(trabalhos.pico()); Serial.print(" / "); Serial.println(trabalhos.descartados());
+#if MODO_PERFIL
+    perfilador.imprimir(Serial);
+#endif
 }
 
  
+// Avança o perfil um período de controle e interpola o set point
 void perfil_reflow() 
- {
-   if(inits == true) {
-     t_perfil++;  
-  
-     if(t_perfil==perfil_tempo[array_perfil])
-     {
-       array_perfil++;
-       set_point=perfil_temp[array_perfil];
-     }
-  
-     if(array_perfil>0){
-         if((rk<perfil_temp[array_perfil-1]) && (array_perfil<=10) )
-         {
-             t_perfil--;
-         }
-     }
-   }   
+{
+  set_point = perfil.atualizar(Ts, rk);
+  t_perfil = perfil.tempoMs()/1000;
+  array_perfil = perfil.segmento();
 }
 
+// Página comprimida (web/gerar_index.py) enviada da flash em blocos, sem cópia na RAM
 void handleRoot() {                                    
- String s = MAIN_page; 
+#if !MODO_AMBIENTE && !MODO_IR
  digitalWrite(LED, LOW);
- server.send(200, "text/html", s); 
+#endif
+ enviarGzip("text/html", MAIN_page_etag, "max-age=86400", MAIN_page_gz, sizeof(MAIN_page_gz));
 }
 
+// grafico.js e o manifesto ficam um dia no cache do navegador.
+// O sw.js revalida sempre (um 304 quando nada mudou) e, instalado, serve
+// a página e o resto do shell do cache do navegador: o forno só atende
+// as APIs de dados
+void handleArquivo(const ArquivoWeb& a) {
+ enviarGzip(a.tipo, a.etag, a.cache, a.dados, a.tamanho);
+}
+
+void enviarGzip(const char* tipo, const char* etag, const char* cache, const uint8_t* dados, size_t tamanho) {
+ server.sendHeader("ETag", etag);
+ server.sendHeader("Cache-Control", cache);
+ if(etagConfere(server, etag)){
+   server.send(304);
+   return;
+ }
+ server.sendHeader("Content-Encoding", "gzip");
+ server.send_P(200, tipo, (PGM_P)dados, tamanho);
+}
+
+// Texto de formatarResposta(): NULL é a arena do pedido sem espaço
+void enviarFormatado(int codigo, const char* tipo, const char* texto) {
+  if(!texto){
+    server.send(500, "text/plain", "resposta grande demais");
+    return;
+  }
+  server.send(codigo, tipo, texto);
+}
+
+// Consultado a cada segundo por pollers (MES) em conexão keep-alive:
+// só o número, sem cabeçalhos além dos obrigatórios
 void handleADC() {
- String sensorRead = String(rk);
- server.send(200, "text/plane", sensorRead); 
-} 
+ AmostraControle a;
+ telemetria.ler(a);
+ char texto[16];
+ snprintf(texto, sizeof(texto), "%.2f", a.rk);
+ server.send(200, "text/plain", texto);
+}
 
+// Formulário antigo: como POST /start, mas volta para a página
 void handleInit() {
-  inits = true; 
+  const char* erro = corridaIniciar();
+  if(erro){
+    server.send(409, "text/plain", erro);
+    return;
+  }
   server.sendHeader("Location","/");
   server.send(303);
 }
+
+#if !defined(ESP32)
+const char* tickerJson(const char* nome, Ticker& t){
+  const TickerStats& e = t.stats();
+  return formatarResposta(server, "\"%s\":{\"periodo_us\":%lu,\"chamadas\":%lu,\"atraso_max_us\":%lu"
+                          ",\"duracao_max_us\":%lu,\"perdidos\":%lu,\"estouros\":%lu}",
+                          nome, (unsigned long)e.periodUs, (unsigned long)e.invocations,
+                          (unsigned long)e.maxLatenessUs, (unsigned long)e.maxDurationUs,
+                          (unsigned long)e.missed, (unsigned long)e.overruns);
+}
+
+// Temporização das tarefas do Ticker; ?zerar=1 recomeça a contagem depois da leitura
+void handleTickers(){
+  const char* sensor = tickerJson("sensor", timerSensor);
+  const char* controle = tickerJson("controle", timerControle);
+  const char* serial = tickerJson("serial", timerSerial);
+  const char* json = sensor && controle && serial
+                     ? formatarResposta(server, "{%s,%s,%s}", sensor, controle, serial) : NULL;
+  if(server.hasArg("zerar")){
+    timerSensor.resetStats();
+    timerControle.resetStats();
+    timerSerial.resetStats();
+  }
+  server.sendHeader("Cache-Control", "no-store");
+  enviarFormatado(200, "application/json", json);
+}
+#endif
+
+#if MODO_PERFIL
+// Tempo por trecho marcado com MEDIR_TRECHO, uma linha por trecho;
+// ?zerar=1 recomeça a contagem depois da leitura
+void handleProfile(){
+  server.sendHeader("Cache-Control", "no-store");
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain", PERFIL_CABECALHO "\n");
+  char linha[128];
+  for(uint8_t i=0; i<perfilador.quantos(); i++){
+    perfilador.formatar(i, linha, sizeof(linha));
+    server.sendContent(linha);
+  }
+  server.sendContent("");
+  if(server.hasArg("zerar")) perfilador.zerar();
+}
+#endif
+
+#if MODO_LATENCIA
+const char* latenciaJson(const char* nome, const HistogramaLatencia& h, uint32_t amostras){
+  char baldes[LATENCIA_BALDES * 11];   // até 10 dígitos e a vírgula
+  size_t n = 0;
+  for(uint8_t b=0; b<LATENCIA_BALDES; b++){
+    n += snprintf(baldes + n, sizeof(baldes) - n, b ? ",%lu" : "%lu", (unsigned long)h.baldes[b]);
+  }
+  return formatarResposta(server, "\"%s\":{\"max_us\":%lu,\"med_us\":%lu,\"baldes\":[%s]}", nome,
+                          (unsigned long)LatenciaZero_PI2::microssegundos(h.maximo),
+                          (unsigned long)(amostras ? LatenciaZero_PI2::microssegundos(h.soma / amostras) : 0),
+                          baldes);
+}
+
+// Atraso do cruzamento por zero até a ISR e até o gatilho. baldes[i]
+// conta atrasos em [2^i, 2^(i+1)) µs (o primeiro, abaixo de 2 µs; o
+// último, 2048 µs ou mais); ?zerar=1 recomeça depois da leitura
+void handleLatency(){
+  DadosLatencia d;
+  latencia.copiar(d);
+  const char* entrada = latenciaJson("entrada", d.entrada, d.amostras);
+  const char* gatilho = latenciaJson("gatilho", d.gatilho, d.amostras);
+  const char* json = entrada && gatilho
+                     ? formatarResposta(server, "{\"amostras\":%lu,\"ressincronias\":%lu,\"periodo_us\":%lu,%s,%s}",
+                                        (unsigned long)d.amostras, (unsigned long)d.ressincronias,
+                                        (unsigned long)LatenciaZero_PI2::microssegundos(d.periodo), entrada, gatilho)
+                     : NULL;
+  if(server.hasArg("zerar")) latencia.zerar();
+  server.sendHeader("Cache-Control", "no-store");
+  enviarFormatado(200, "application/json", json);
+}
+#endif
+
+// GET /history?since=N: as amostras do histórico a partir do índice N, em
+// CSV "indice,tempo_s,temperatura,potencia". X-Proximo traz o since do
+// próximo pedido; um cliente que reconecta busca só o que perdeu.
+// points=P reduz o trecho a P pontos (LTTB), para o gráfico de um tablet
+// não receber a corrida inteira. format=bin troca o CSV por registros de
+// 10 bytes little endian (u32 indice, u16 tempo_s, i16 décimos de grau,
+// u8 potencia, u8 0), lidos pela página com um DataView
+#define HISTORICO_REGISTRO_BIN 10
+
+void handleHistory() {
+ uint32_t desde = server.hasArg("since") ? strtoul(server.arg("since").c_str(), NULL, 10) : 0;
+ uint32_t fim = historico.proximo();
+ if(desde > fim) desde = fim;
+ long pontos = server.hasArg("points") ? server.arg("points").toInt() : 0;
+ if(server.hasArg("points") && (pontos < 3 || pontos > HISTORICO_CAPACIDADE)){
+   server.send(400, "text/plain", "points deve estar entre 3 e " + String(HISTORICO_CAPACIDADE));
+   return;
+ }
+ bool binario = server.arg("format") == "bin";
+
+ server.sendHeader("Cache-Control", "no-store");
+ server.sendHeader("X-Proximo", String(fim));
+
+ // puxada em pedaços conforme o TCP aceita: a resposta inteira não cabe
+ // no heap de uma vez; sem points a redução devolve todas as amostras
+ ReducaoHistorico_PI2 reducao(historico, desde, fim, pontos);
+ enviarFonte(server, 200, binario ? "application/octet-stream" : "text/csv",
+             [reducao, binario](uint8_t* destino, size_t max) mutable {
+   uint32_t indice;
+   AmostraHistorico a;
+   size_t usado = 0;
+   while(usado + 32 <= max && reducao.proxima(indice, a)){   // a maior linha do CSV tem 29
+     if(binario){
+       uint8_t* r = destino + usado;
+       memcpy(r, &indice, 4);
+       memcpy(r + 4, &a.tempo_s, 2);
+       memcpy(r + 6, &a.temperatura_dC, 2);
+       r[8] = a.potencia;
+       r[9] = 0;
+       usado += HISTORICO_REGISTRO_BIN;
+     }
+     else {
+       usado += snprintf((char*)destino + usado, max - usado, "%lu,%u,%.1f,%u\n", (unsigned long)indice,
+                         a.tempo_s, a.temperatura_dC / 10.0f, a.potencia);
+     }
+   }
+   return usado;
+ });
+}
+
+// GET: lista as corridas gravadas "numero;bytes"; GET n=N: baixa o
+// arquivo binário da corrida N (cabeçalho + registros de 8 bytes)
+void handleLog() {
+ if(server.hasArg("n")){
+   uint16_t n = (uint16_t)strtoul(server.arg("n").c_str(), NULL, 10);
+   if(registro.aberto() && n == registro.corrida()){
+     server.send(409, "text/plain", "corrida em andamento");
+     return;
+   }
+   File f = LittleFS.open(registro.caminho(n), "r");
+   if(!f){
+     server.send(404, "text/plain", "corrida inexistente");
+     return;
+   }
+   char disposicao[48];
+   snprintf(disposicao, sizeof(disposicao), "attachment; filename=corrida%u.bin", (unsigned)n);
+   server.sendHeader("Content-Disposition", disposicao);
+   server.streamFile(f, "application/octet-stream");   // fecha o arquivo no fim do envio
+   return;
+ }
+
+ // uma linha por arquivo, enviada assim que lida: a lista não tem tamanho fixo
+ server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+ server.send(200, "text/plain", "");
+ char linha[32];
+ Dir dir = LittleFS.openDir(REGISTRO_PASTA);
+ while(dir.next()){
+   snprintf(linha, sizeof(linha), "%lu;%lu\n", strtoul(dir.fileName().c_str(), NULL, 10),
+            (unsigned long)dir.fileSize());
+   server.sendContent(linha);
+ }
+ server.sendContent("");
+}
+
+// GET: lista os perfis em flash; POST id=N: escolhe o perfil (fora de execução)
+void handlePerfil() {
+  if(server.hasArg("id")){
+    if(corridaAtiva()){
+      server.send(409, "text/plain", "forno em execucao");
+      return;
+    }
+    if(!perfil.selecionar(server.arg("id").toInt())){
+      server.send(400, "text/plain", "perfil invalido");
+      return;
+    }
+    configPerfilSelecionado();
+  }
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "text/plain", "");
+  char linha[64];
+  for(uint8_t i=0; i<QUANTIDADE_PERFIS; i++){
+    PerfilReflow p;
+    memcpy_P(&p, &CATALOGO_PERFIS[i], sizeof(p));
+    snprintf(linha, sizeof(linha), "%u;%s;%u%s\n", i, p.nome, p.quantidade,
+             (i == perfil.indice()) ? ";ativo" : "");
+    server.sendContent(linha);
+  }
+  server.sendContent("");
+}
+
+// GET /perfil/curva: o perfil ativo num só array, para o painel desenhar
+// o set point e a faixa sem receber nada a mais por amostra:
+// {"indice":I,"faixa_C":F,"tempo_s":T,"pontos":[t0,dC0,t1,dC1,...]}, com
+// t em s desde o fim do preaquecimento e dC em décimos de grau; tempo_s
+// é onde o perfil está agora (só avança em CORRIDA_RODANDO)
+void handlePerfilCurva() {
+  const SegmentoPerfil* seg = perfil.segmentos();
+  char pontos[PERFIL_MAX_SEGMENTOS * 18 + 8];   // ",t,dC": até 10 e 6 caracteres
+  size_t n = snprintf(pontos, sizeof(pontos), "0,%d", (int)perfil.inicial_dC());
+  uint32_t t = 0;
+  for(uint8_t i=0; i<perfil.quantidade() && n < sizeof(pontos); i++){
+    t += seg[i].duracao_s;
+    n += snprintf(pontos + n, sizeof(pontos) - n, ",%lu,%d", (unsigned long)t, (int)seg[i].temperatura_dC);
+  }
+  server.sendHeader("Cache-Control", "no-store");
+  enviarFormatado(200, "application/json",
+                  formatarResposta(server, "{\"indice\":%u,\"faixa_C\":%.1f,\"tempo_s\":%d,\"pontos\":[%s]}",
+                                   (unsigned)perfil.indice(), CORRIDA_FAIXA_C, (int)t_perfil, pontos));
+}
@@ -0,0 +1,85 @@
+// Controle remoto infravermelho (ir.ino)
+// Para quem está de luvas: um controle NEC inicia, aborta, pausa e troca o
+// perfil. O IRrecv do IRremoteESP8266 só data as bordas do receptor numa
+// ISR curta na IRAM (sem tique periódico: um timer só marca o fim da
+// mensagem), então o cruzamento por zero espera no máximo uma dessas, e
+// com dois buffers a captura seguinte começa sem cópia. A decodificação
+// roda no laco(), nunca na ISR, e o botão vai pela fila de trabalhos
+// (TRABALHO_IR), drenada logo em seguida na mesma volta: o abortar zera a
+// potência antes do próximo período de controle.
+//
+// Segurar o botão manda o código de repetição do NEC, ignorado, e o mesmo
+// botão só vale de novo depois de IR_INTERVALO_MS: um toque é um comando.
+// Outro protocolo ou outro endereço (a TV da sala) não mexe no forno.
+
+#if MODO_IR
+
+#define IR_BUFFER 80               // NEC: 68 bordas e a folga do ruído
+#define IR_INTERVALO_MS 400        // o controle reenvia o quadro inteiro em alguns modelos
+
+IRrecv ir_receptor(irPino, IR_BUFFER, kTimeoutMs, true);
+decode_results ir_resultado;
+uint8_t ir_ultimo = 0;             // comando aceito por último
+uint32_t ir_instante = 0;          // millis() dele
+uint32_t ir_ultimo_endereco = 0;   // para achar o IR_ENDERECO do controle
+uint32_t ir_comandos = 0;
+uint32_t ir_recusados = 0;         // aceitos, mas o forno não pôde cumprir
+uint32_t ir_ignorados = 0;         // outro protocolo, endereço ou botão
+
+void irIniciar(){
+  ir_receptor.enableIRIn();
+}
+
+// laco(): decodifica o que a ISR terminou de capturar
+void irAtender(){
+  if(!ir_receptor.decode(&ir_resultado)) return;
+  if(ir_resultado.decode_type != NEC || ir_resultado.repeat) return;
+  ir_ultimo_endereco = ir_resultado.address;
+  uint8_t comando = ir_resultado.command;
+  if(ir_resultado.address != IR_ENDERECO){
+    ir_ignorados++;
+    return;
+  }
+  if(comando == ir_ultimo && millis() - ir_instante < IR_INTERVALO_MS) return;
+  ir_ultimo = comando;
+  ir_instante = millis();
+  trabalhos.postar(TRABALHO_IR, comando);
+}
+
+// Próximo perfil do catálogo, dando a volta; parado, como /perfil?id=
+bool irTrocarPerfil(int8_t passo){
+  if(corridaAtiva()) return false;
+  uint8_t atual = perfil.indice() < QUANTIDADE_PERFIS ? perfil.indice() : 0;
+  if(!perfil.selecionar((atual + QUANTIDADE_PERFIS + passo) % QUANTIDADE_PERFIS)) return false;
+  configPerfilSelecionado();
+  return true;
+}
+
+// Fila de trabalhos: o mesmo que os endpoints fazem
+void irExecutar(const Trabalho& t){
+  bool feito;
+  switch(t.valor){
+    case IR_INICIAR:         feito = corridaIniciar() == 0; break;
+    case IR_ABORTAR:         feito = corridaAtiva(); corridaAbortar(); break;
+    case IR_PAUSAR:          feito = corridaPausar(); break;
+    case IR_PERFIL_PROXIMO:  feito = irTrocarPerfil(1); break;
+    case IR_PERFIL_ANTERIOR: feito = irTrocarPerfil(-1); break;
+    default:
+      ir_ignorados++;
+      return;
+  }
+  if(feito) ir_comandos++;
+  else ir_recusados++;
+}
+
+// handleMetrics()
+void irMetricas(){
+  metricasCabecalho("forno_ir_comandos_total", "counter", "botoes do controle remoto por resultado");
+  metricasLinha("forno_ir_comandos_total{resultado=\"cumprido\"} %lu\n", (unsigned long)ir_comandos);
+  metricasLinha("forno_ir_comandos_total{resultado=\"recusado\"} %lu\n", (unsigned long)ir_recusados);
+  metricasLinha("forno_ir_comandos_total{resultado=\"ignorado\"} %lu\n", (unsigned long)ir_ignorados);
+  metricasCabecalho("forno_ir_ultimo_endereco", "gauge", "endereco NEC do ultimo quadro recebido");
+  metricasLinha("forno_ir_ultimo_endereco %lu\n", (unsigned long)ir_ultimo_endereco);
+}
+
+#endif
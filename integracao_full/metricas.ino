@@ -0,0 +1,227 @@
+// Métricas de memória e tempo em /metrics, no formato texto do Prometheus
+// Heap: livre, maior bloco, fragmentação e o menor livre já visto pelo
+// loop(); pilha: o menor espaço livre da pilha do loop() desde o boot
+// (pilhaLivreMinima() procura a marca de pintura, é o high-water; no
+// ESP32, a da tarefa da rede).
+// Duração de cada volta do loop(), do início de uma ao início da
+// seguinte (inclui o tempo do SDK e do WiFi), num histograma de baldes
+// fixos; os quantis saem do histograma, com a resolução dos baldes.
+// Tickers e interrupções: contadores acumulados desde o boot.
+// A resposta é uma fonte (enviarFonte): cada pedaço roda metricasGerar()
+// de novo e escreve só as linhas seguintes às já enviadas que couberem,
+// sem montar a resposta inteira em lugar nenhum; uma linha reflete o
+// instante do pedaço em que saiu.
+
+#define METRICAS_BALDES 12
+const uint32_t METRICAS_LIMITES_US[METRICAS_BALDES] = {
+  100, 200, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 200000, 500000
+};
+
+uint32_t metricas_baldes[METRICAS_BALDES + 1];   // o último é +Inf
+uint32_t metricas_voltas = 0;
+uint64_t metricas_soma_us = 0;
+uint32_t metricas_maior_us = 0;
+uint32_t metricas_inicio = 0;                     // micros() do início da volta anterior
+uint32_t metricas_heap_minimo = 0xFFFFFFFF;
+
+char* metricas_destino;             // pedaço em montagem
+size_t metricas_max;
+size_t metricas_usado;
+uint16_t metricas_linha;            // linhas geradas nesta passada
+uint16_t metricas_enviadas;         // linhas já nos pedaços anteriores
+bool metricas_cheio;
+
+// Primeira coisa do loop()
+void metricasVolta(){
+  uint32_t agora = micros();
+  if(metricas_inicio != 0){
+    uint32_t d = agora - metricas_inicio;
+    uint8_t b = 0;
+    while(b < METRICAS_BALDES && d > METRICAS_LIMITES_US[b]) b++;
+    metricas_baldes[b]++;
+    metricas_voltas++;
+    metricas_soma_us += d;
+    if(d > metricas_maior_us) metricas_maior_us = d;
+  }
+  metricas_inicio = agora;
+
+  uint32_t livre = ESP.getFreeHeap();
+  if(livre < metricas_heap_minimo) metricas_heap_minimo = livre;
+}
+
+// Limite do balde onde o quantil q cai (0 se ainda não houve voltas)
+uint32_t metricasQuantil(float q){
+  if(metricas_voltas == 0) return 0;
+  uint32_t alvo = (uint32_t)ceilf(q * metricas_voltas);
+  uint32_t acumulado = 0;
+  for(uint8_t b=0; b<METRICAS_BALDES; b++){
+    acumulado += metricas_baldes[b];
+    if(acumulado >= alvo) return METRICAS_LIMITES_US[b];
+  }
+  return metricas_maior_us;   // além do último limite
+}
+
+void metricasLinha(const char* formato, ...){
+  if(metricas_linha++ < metricas_enviadas || metricas_cheio) return;
+  char linha[160];
+  va_list args;
+  va_start(args, formato);
+  int n = vsnprintf(linha, sizeof(linha), formato, args);
+  va_end(args);
+  if(n < 0) return;
+  if(n >= (int)sizeof(linha)) n = sizeof(linha) - 1;
+  if(metricas_usado + n > metricas_max){
+    metricas_cheio = true;           // fica para o próximo pedaço
+    return;
+  }
+  memcpy(metricas_destino + metricas_usado, linha, n);
+  metricas_usado += n;
+  metricas_enviadas++;
+}
+
+void metricasCabecalho(const char* nome, const char* tipo, const char* ajuda){
+  metricasLinha("# HELP %s %s\n# TYPE %s %s\n", nome, ajuda, nome, tipo);
+}
+
+#if !defined(ESP32)
+// Uma família por campo de TickerStats, com uma linha por Ticker
+void metricasTickers(const char* nome, const char* tipo, const char* ajuda,
+                     uint32_t (*campo)(const TickerStats&)){
+  static const char* const nomes[] = { "sensor", "controle", "serial" };
+  Ticker* const tickers[] = { &timerSensor, &timerControle, &timerSerial };
+  metricasCabecalho(nome, tipo, ajuda);
+  for(uint8_t i=0; i<3; i++){
+    metricasLinha("%s{ticker=\"%s\"} %lu\n", nome, nomes[i], (unsigned long)campo(tickers[i]->stats()));
+  }
+}
+#endif
+
+void handleMetrics(){
+  uint16_t enviadas = 0;             // de cada pedido: dois /metrics podem correr juntos
+  server.sendHeader("Cache-Control", "no-store");
+  enviarFonte(server, 200, "text/plain; version=0.0.4", [enviadas](uint8_t* destino, size_t max) mutable {
+    metricas_destino = (char*)destino;
+    metricas_max = max;
+    metricas_usado = 0;
+    metricas_linha = 0;
+    metricas_enviadas = enviadas;
+    metricas_cheio = false;
+    metricasGerar();
+    enviadas = metricas_enviadas;
+    return metricas_usado;
+  });
+}
+
+void metricasGerar(){
+  metricasCabecalho("forno_heap_livre_bytes", "gauge", "heap livre agora");
+  metricasLinha("forno_heap_livre_bytes %lu\n", (unsigned long)ESP.getFreeHeap());
+  metricasCabecalho("forno_heap_minimo_bytes", "gauge", "menor heap livre visto no inicio de uma volta do loop");
+  metricasLinha("forno_heap_minimo_bytes %lu\n", (unsigned long)metricas_heap_minimo);
+  metricasCabecalho("forno_heap_maior_bloco_bytes", "gauge", "maior bloco que um malloc consegue agora");
+  metricasLinha("forno_heap_maior_bloco_bytes %lu\n", (unsigned long)heapMaiorBloco());
+  metricasCabecalho("forno_heap_fragmentacao_pct", "gauge", "fragmentacao do heap, 0 a 100");
+  metricasLinha("forno_heap_fragmentacao_pct %u\n", (unsigned)heapFragmentacao());
+  metricasCabecalho("forno_pilha_livre_minima_bytes", "gauge", "menor espaco livre da pilha do loop desde o boot");
+  metricasLinha("forno_pilha_livre_minima_bytes %lu\n", (unsigned long)pilhaLivreMinima());
+  metricasCabecalho("forno_uptime_segundos", "counter", "tempo desde o boot");
+  metricasLinha("forno_uptime_segundos %lu\n", (unsigned long)(millis() / 1000));
+  metricasCabecalho("forno_boot_fase_us", "gauge", "micros() no fim de cada fase do boot (inicio.ino), 0 se ainda nao terminou");
+  metricasLinha("forno_boot_fase_us{fase=\"seguro\"} %lu\n", inicio_seguro_us);
+  metricasLinha("forno_boot_fase_us{fase=\"controle\"} %lu\n", inicio_controle_us);
+  metricasLinha("forno_boot_fase_us{fase=\"rede\"} %lu\n", inicio_rede_us);
+  metricasCabecalho("forno_wifi_sono", "gauge", "1 se o radio dorme entre os DTIMs (forno parado, sem inscritos)");
+  metricasLinha("forno_wifi_sono %d\n", redeDormindo() ? 1 : 0);
+#if MODO_REPOUSO
+  metricasCabecalho("forno_repouso", "gauge", "1 se o loop cede a CPU entre os Tickers (repouso.ino)");
+  metricasLinha("forno_repouso %d\n", repousoAtivo() ? 1 : 0);
+  metricasCabecalho("forno_repouso_entradas_total", "counter", "vezes que o forno entrou em repouso");
+  metricasLinha("forno_repouso_entradas_total %lu\n", (unsigned long)repouso_entradas);
+#endif
+
+  metricasCabecalho("forno_loop_duracao_us", "histogram", "intervalo entre inicios de voltas do loop");
+  uint32_t acumulado = 0;
+  for(uint8_t b=0; b<METRICAS_BALDES; b++){
+    acumulado += metricas_baldes[b];
+    metricasLinha("forno_loop_duracao_us_bucket{le=\"%lu\"} %lu\n",
+                  (unsigned long)METRICAS_LIMITES_US[b], (unsigned long)acumulado);
+  }
+  metricasLinha("forno_loop_duracao_us_bucket{le=\"+Inf\"} %lu\n", (unsigned long)metricas_voltas);
+  metricasLinha("forno_loop_duracao_us_sum %.0f\n", (double)metricas_soma_us);
+  metricasLinha("forno_loop_duracao_us_count %lu\n", (unsigned long)metricas_voltas);
+  metricasCabecalho("forno_loop_quantil_us", "gauge", "quantis da duracao das voltas, pelo limite do balde");
+  metricasLinha("forno_loop_quantil_us{quantil=\"0.5\"} %lu\n", (unsigned long)metricasQuantil(0.5));
+  metricasLinha("forno_loop_quantil_us{quantil=\"0.9\"} %lu\n", (unsigned long)metricasQuantil(0.9));
+  metricasLinha("forno_loop_quantil_us{quantil=\"0.99\"} %lu\n", (unsigned long)metricasQuantil(0.99));
+  metricasCabecalho("forno_loop_maior_us", "gauge", "volta mais longa do loop desde o boot");
+  metricasLinha("forno_loop_maior_us %lu\n", (unsigned long)metricas_maior_us);
+
+#if !defined(ESP32)
+  metricasTickers("forno_ticker_chamadas_total", "counter", "callbacks executados",
+                  [](const TickerStats& e){ return e.invocations; });
+  metricasTickers("forno_ticker_perdidos_total", "counter", "periodos pulados por chamadas atrasadas",
+                  [](const TickerStats& e){ return e.missed; });
+  metricasTickers("forno_ticker_estouros_total", "counter", "callbacks mais longos que o periodo",
+                  [](const TickerStats& e){ return e.overruns; });
+  metricasTickers("forno_ticker_atraso_max_us", "gauge", "maior atraso da chamada",
+                  [](const TickerStats& e){ return e.maxLatenessUs; });
+  metricasTickers("forno_ticker_duracao_max_us", "gauge", "callback mais longo",
+                  [](const TickerStats& e){ return e.maxDurationUs; });
+#endif
+  metricasCabecalho("forno_controle_periodo_us", "gauge", "periodo da tarefa de controle medido por registrarPeriodo");
+  metricasLinha("forno_controle_periodo_us{medida=\"min\"} %lu\n", tc_min);
+  metricasLinha("forno_controle_periodo_us{medida=\"max\"} %lu\n", tc_max);
+  metricasLinha("forno_controle_periodo_us{medida=\"jitter\"} %lu\n", tc_jitter);
+  metricasCabecalho("forno_trabalhos_descartados_total", "counter", "trabalhos que nao couberam na fila");
+  metricasLinha("forno_trabalhos_descartados_total %lu\n", (unsigned long)trabalhos.descartados());
+  metricasCabecalho("forno_eventos_descartados_total", "counter", "eventos que nao couberam na fila de eventos");
+  metricasLinha("forno_eventos_descartados_total %lu\n", (unsigned long)eventos_fila.descartados());
+  metricasCabecalho("forno_trabalhos_pico", "gauge", "maior ocupacao da fila de trabalhos");
+  metricasLinha("forno_trabalhos_pico %lu\n", (unsigned long)trabalhos.pico());
+  metricasCabecalho("forno_isr_cruzamentos_total", "counter", "interrupcoes de cruzamento por zero, com as de ruido");
+  metricasLinha("forno_isr_cruzamentos_total %lu\n", (unsigned long)isr_cruzamentos);
+  metricasCabecalho("forno_rede_frequencia_hz", "gauge", "frequencia da rede medida nos cruzamentos, 0 ate travar");
+  metricasLinha("forno_rede_frequencia_hz %.3f\n", rede.frequencia());
+  metricasCabecalho("forno_energia_joules_total", "counter", "energia das resistencias na vida do forno");
+  metricasLinha("forno_energia_joules_total %.0f\n", energiaTotal() / 1e6);
+  metricasCabecalho("forno_energia_corrida_joules", "gauge", "energia da corrida atual ou da ultima");
+  metricasLinha("forno_energia_corrida_joules %.0f\n", energiaCorridaWh() * 3600.0);
+#if !MODO_FASE
+  metricasCabecalho("forno_disparo_simultaneos", "gauge", "zonas conduzindo juntas no pior semiciclo da janela de rajada");
+  metricasLinha("forno_disparo_simultaneos %u\n", disparo.simultaneos());
+#endif
+  metricasCabecalho("forno_rede_ruidos_total", "counter", "bordas do cruzamento por zero rejeitadas como ruido");
+  metricasLinha("forno_rede_ruidos_total %lu\n", (unsigned long)rede.ruidos());
+  metricasCabecalho("forno_rede_perdidos_total", "counter", "cruzamentos por zero que nao chegaram");
+  metricasLinha("forno_rede_perdidos_total %lu\n", (unsigned long)rede.perdidos());
+#if MODO_SONDA
+  sondaMetricas();
+#endif
+#if MODO_AMBIENTE
+  ambienteMetricas();
+#endif
+#if MODO_FILA
+  filaMetricas();
+#endif
+#if MODO_MQTT
+  mqttMetricas();
+#endif
+#if MODO_IR
+  irMetricas();
+#endif
+#if MODO_BLYNK && BLYNK_SSL && !defined(ESP32) && !defined(BLYNK_SSL_USE_AXTLS)
+  blynkMetricas();
+#endif
+#if !defined(ESP32)
+  metricasCabecalho("forno_http_pedidos_total", "counter", "pedidos HTTP atendidos");
+  metricasLinha("forno_http_pedidos_total %lu\n", (unsigned long)server.pedidos());
+  metricasCabecalho("forno_http_conexoes_total", "counter", "conexoes HTTP encerradas pelo servidor por motivo");
+  metricasLinha("forno_http_conexoes_total{motivo=\"recusada\"} %lu\n", (unsigned long)server.recusadas());
+  metricasLinha("forno_http_conexoes_total{motivo=\"derrubada\"} %lu\n", (unsigned long)server.derrubadas());
+  metricasCabecalho("forno_http_conexoes_abertas", "gauge", "conexoes HTTP ocupando vaga");
+  metricasLinha("forno_http_conexoes_abertas %u\n", server.abertas());
+  metricasCabecalho("forno_http_arena_pico_bytes", "gauge", "maior uso da arena de um pedido, de HTTP_ARENA");
+  metricasLinha("forno_http_arena_pico_bytes %lu\n", (unsigned long)server.arenaPico());
+  metricasCabecalho("forno_http_cabecalhos_perdidos_total", "counter", "cabecalhos de resposta que nao couberam em HTTP_CABECALHOS");
+  metricasLinha("forno_http_cabecalhos_perdidos_total %lu\n", (unsigned long)server.cabecalhosPerdidos());
+#endif
+}
@@ -0,0 +1,119 @@
+// Telemetria para o broker MQTT da planta (MODO_MQTT)
+// Cada amostra de controle vira uma linha "t_ms,temperatura,set_point,
+// potencia,corrida,utc" (utc em s.ms, relogio.ino); MQTT_LOTE linhas
+// saem juntas em um PUBLISH QoS 0 em forno/<nome>/telemetria, ou antes
+// disso se o lote ficar MQTT_LOTE_MS parado. Com o broker fora, os lotes
+// vão para a fila da flash (FilaLotes_PI2, em MQTT_FILA_PASTA) e saem de
+// novo, na ordem, um por volta do loop(), antes dos novos, assim que o
+// cliente reconecta (mqtt_PI2.h tenta a cada MQTT_ESPERA_MS).
+//
+// Com MODO_CELULAR a conexão é um TransporteReserva_PI2: WiFi primeiro, e
+// o socket 1 do modem quando o WiFi cai por segundos; a troca derruba a
+// conexão e o cliente reconecta pelo outro enlace sem saber de nada.
+
+#if MODO_MQTT
+
+#define MQTT_LOTE    10       // amostras por PUBLISH: 1 por segundo com Ts = 100 ms
+#define MQTT_LOTE_MS 2000
+
+#define MQTT_FILA_PASTA "/fila_mqtt"
+
+#if MODO_CELULAR
+WiFiClient mqttWifi;
+ClienteCelular mqttCelular(modem);
+TransporteReserva_PI2 mqttTcp(mqttWifi, mqttCelular);
+#else
+WiFiClient mqttTcp;
+#endif
+ClienteMqtt_PI2 mqtt(mqttTcp);
+FilaLotes_PI2 mqtt_fila;
+bool mqtt_fila_ok = false;
+uint8_t mqtt_reenvio[FILA_CABECALHO + MQTT_LOTE * 56];
+uint32_t mqtt_reenviados = 0;
+char mqtt_topico[48];
+char mqtt_lote[MQTT_LOTE * 56];
+size_t mqtt_tamanho = 0;
+uint8_t mqtt_amostras = 0;
+unsigned long mqtt_inicio_lote = 0;
+uint32_t mqtt_sequencia = 0;
+
+void mqttAtender(){
+  if(!mqtt_topico[0]){
+    snprintf(mqtt_topico, sizeof(mqtt_topico), "forno/%s/telemetria", frotaNome());
+    mqtt.configurar(MQTT_HOST, MQTT_PORTA, frotaNome(), MQTT_USUARIO, MQTT_SENHA);
+    mqtt_fila_ok = mqtt_fila.iniciar(LittleFS, MQTT_FILA_PASTA);
+#if MODO_CELULAR
+    mqttTcp.saude(redeConectada, celularGprs);
+    mqttWifi.setTimeout(MQTT_CONEXAO_MS);   // o do mqttTcp não chega ao WiFiClient
+#endif
+  }
+#if MODO_CELULAR
+  mqttTcp.atender();
+  mqtt.nomeNoCliente(mqttTcp.naReserva());   // sem WiFi não há DNS do lwIP; o modem resolve
+  mqtt.atender();
+#else
+  if(redeConectada()) mqtt.atender();
+#endif
+
+  uint32_t seq = telemetria.sequencia();
+  if(seq != mqtt_sequencia){
+    mqtt_sequencia = seq;
+    mqttAcumular();
+  }
+
+  if(mqtt_amostras > 0 && (mqtt_amostras >= MQTT_LOTE || millis() - mqtt_inicio_lote > MQTT_LOTE_MS)){
+    // o lote novo só passa na frente se não há nada guardado
+    bool direto = mqtt.conectado() && (!mqtt_fila_ok || mqtt_fila.vazia());
+    if(!(direto && mqtt.publicar(mqtt_topico, (const uint8_t*)mqtt_lote, mqtt_tamanho)) && mqtt_fila_ok){
+      mqtt_fila.acrescentar((const uint8_t*)mqtt_lote, mqtt_tamanho);
+    }
+    mqtt_tamanho = 0;
+    mqtt_amostras = 0;
+  }
+  else if(mqtt.conectado() && mqtt_fila_ok){
+    mqttReenviar();
+  }
+}
+
+// Um registro da fila por volta; só sai da flash depois de escrito na conexão
+void mqttReenviar(){
+  uint32_t ultimo;
+  size_t n = mqtt_fila.ler(mqtt_reenvio, sizeof(mqtt_reenvio), ultimo);
+  if(n < FILA_CABECALHO) return;
+  size_t tamanho = mqtt_reenvio[0] | (mqtt_reenvio[1] << 8);
+  if(!mqtt.publicar(mqtt_topico, mqtt_reenvio + FILA_CABECALHO, tamanho)) return;
+  mqtt_fila.confirmar(FILA_CABECALHO + tamanho);
+  mqtt_reenviados++;
+}
+
+void mqttAcumular(){
+  AmostraControle a;
+  telemetria.ler(a);
+
+  if(mqtt_amostras == 0) mqtt_inicio_lote = millis();
+  char utc[24];
+  relogioTexto(utc, sizeof(utc), a.utc_us);
+  int n = snprintf(mqtt_lote + mqtt_tamanho, sizeof(mqtt_lote) - mqtt_tamanho, "%lu,%.2f,%.1f,%d,%u,%s\n",
+                   (unsigned long)a.timestamp, a.rk, a.set_point, a.controle_potencia, (unsigned)a.corrida, utc);
+  if(n <= 0 || mqtt_tamanho + n >= sizeof(mqtt_lote)) return;   // não cabe: fica para o próximo lote
+  mqtt_tamanho += n;
+  mqtt_amostras++;
+}
+
+// handleMetrics()
+void mqttMetricas(){
+  metricasCabecalho("forno_mqtt_publicados_total", "counter", "PUBLISH enviados ao broker");
+  metricasLinha("forno_mqtt_publicados_total %lu\n", (unsigned long)mqtt.publicados());
+  metricasCabecalho("forno_mqtt_reenviados_total", "counter", "lotes guardados na flash e enviados depois");
+  metricasLinha("forno_mqtt_reenviados_total %lu\n", (unsigned long)mqtt_reenviados);
+  metricasCabecalho("forno_mqtt_fila_segmentos", "gauge", "segmentos da fila da flash esperando o broker");
+  metricasLinha("forno_mqtt_fila_segmentos %u\n", mqtt_fila_ok ? mqtt_fila.segmentos() : 0);
+#if MODO_CELULAR
+  metricasCabecalho("forno_mqtt_reserva", "gauge", "1 se o MQTT sai pelo modem celular");
+  metricasLinha("forno_mqtt_reserva %d\n", mqttTcp.naReserva() ? 1 : 0);
+  metricasCabecalho("forno_mqtt_trocas_total", "counter", "trocas entre WiFi e celular");
+  metricasLinha("forno_mqtt_trocas_total %lu\n", (unsigned long)mqttTcp.trocas());
+#endif
+}
+
+#endif
@@ -0,0 +1,78 @@
+// Divisão das tarefas entre os núcleos do ESP32 (nucleos.ino)
+// NUCLEO_CONTROLE: uma tarefa FreeRTOS de prioridade alta acorda a cada
+// NUCLEOS_TICK_MS por vTaskDelayUntil (sem deriva), lê os termopares e a
+// cada Ts roda controle_pid(); a ISR do cruzamento por zero, que dispara
+// o triac, é registrada no setup() deste mesmo núcleo. NUCLEO_REDE: o
+// WiFi do IDF e a tarefa da rede, que roda laco() (web, WebSocket, frota,
+// MQTT, flash) no lugar do loop(). As duas só conversam pelo que já não
+// usa trava: a Telemetria_PI2 (seqlock), a FilaTrabalho_PI2 (reserva por
+// CAS no ESP32) e a troca de ganhos de config_pendente. Uma requisição
+// lenta ou uma rajada de pacotes atrasa só o núcleo da rede.
+// No ESP8266 nada daqui compila: o controle fica nos Tickers.
+
+#if defined(ESP32)
+
+#define NUCLEOS_TICK_MS          10     // leitura dos termopares, como o timerSensor
+#define NUCLEOS_PILHA_CONTROLE   4096
+#define NUCLEOS_PILHA_REDE       8192
+#define NUCLEOS_PRIORIDADE_CONTROLE (configMAX_PRIORITIES - 2)
+#define NUCLEOS_PRIORIDADE_REDE  1
+#define NUCLEOS_SERIAL_MS        4000   // resumo em texto, como o timerSerial
+
+TaskHandle_t nucleos_controle = NULL;
+TaskHandle_t nucleos_rede = NULL;
+
+void nucleosTarefaControle(void*){
+  TickType_t acordar = xTaskGetTickCount();
+  uint32_t desde_controle = 0;
+#if !MODO_SERIAL
+  uint32_t desde_serial = 0;
+#endif
+#if MODO_PAINEL
+  uint32_t desde_painel = 0;
+#endif
+  for(;;){
+    vTaskDelayUntil(&acordar, pdMS_TO_TICKS(NUCLEOS_TICK_MS));
+    sensor_ler();
+    desde_controle += NUCLEOS_TICK_MS;
+    if(desde_controle >= (uint32_t)Ts){   // Ts muda por /config sem recriar a tarefa
+      desde_controle = 0;
+      controle_pid();
+    }
+    // o resto é da rede: só posta
+#if !MODO_SERIAL
+    desde_serial += NUCLEOS_TICK_MS;
+    if(desde_serial >= NUCLEOS_SERIAL_MS){
+      desde_serial = 0;
+      trabalhos.postar(TRABALHO_SERIAL);
+    }
+#endif
+#if MODO_PAINEL
+    desde_painel += NUCLEOS_TICK_MS;
+    if(desde_painel >= PAINEL_PERIODO_MS){
+      desde_painel = 0;
+      trabalhos.postar(TRABALHO_PAINEL);
+    }
+#endif
+  }
+}
+
+void nucleosTarefaRede(void*){
+  segurancaIniciar();   // o TWDT vigia esta tarefa
+  for(;;){
+    laco();
+    vTaskDelay(1);      // deixa a tarefa ociosa do núcleo alimentar o dela
+  }
+}
+
+void nucleosIniciarControle(){
+  xTaskCreatePinnedToCore(nucleosTarefaControle, "controle", NUCLEOS_PILHA_CONTROLE, NULL,
+                          NUCLEOS_PRIORIDADE_CONTROLE, &nucleos_controle, NUCLEO_CONTROLE);
+}
+
+void nucleosIniciarRede(){
+  xTaskCreatePinnedToCore(nucleosTarefaRede, "rede", NUCLEOS_PILHA_REDE, NULL,
+                          NUCLEOS_PRIORIDADE_REDE, &nucleos_rede, NUCLEO_REDE);
+}
+
+#endif
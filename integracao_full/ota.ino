@@ -0,0 +1,107 @@
+// Atualização do firmware pela rede (ota.ino)
+// POST /update?md5=<md5 do .bin> com o arquivo em multipart, por exemplo
+//   curl -F "firmware=@integracao_full.ino.bin" "http://forno/update?md5=$(md5sum < integracao_full.ino.bin | cut -c1-32)"
+// O Updater do core grava cada pedaço do upload (HTTP_UPLOAD_BUFLEN bytes)
+// na área livre da flash assim que chega, um setor de 4 KB por vez: a
+// imagem nunca fica inteira na RAM. No fim o MD5 do que foi gravado é
+// conferido; só então o boot passa para a imagem nova e o forno reinicia.
+// Recusado com corrida ou sintonia em andamento, e enquanto grava nenhuma
+// das duas começa. O servidor é HTTP: OTA_SENHA (config.h) é pedida por
+// autenticação básica e o MD5 é obrigatório; sem senha não há /update.
+
+#define OTA_REINICIO_MS  500     // resposta enviada antes de reiniciar
+
+bool ota_ativa = false;          // Updater aberto, gravando
+const char* ota_erro = NULL;     // motivo da recusa, respondido no fim do upload
+int ota_codigo = 200;
+unsigned long ota_reinicio = 0;  // millis() do OK, 0 = nada a fazer
+
+bool otaAtiva(){
+  return ota_ativa;
+}
+
+// No setup(), com as outras rotas
+void otaIniciar(){
+  if(strlen(OTA_SENHA) == 0){
+    Serial.println("OTA: OTA_SENHA vazia em config.h, /update desligado");
+    return;
+  }
+  server.on("/update", HTTP_POST, handleUpdate, otaReceber);
+}
+
+void otaRecusar(int codigo, const char* erro){
+  if(ota_ativa) Update.end(false);   // descarta o que já foi gravado
+  ota_ativa = false;
+  ota_codigo = codigo;
+  ota_erro = erro;
+}
+
+// Chamada pelo servidor a cada pedaço do upload, antes de handleUpdate()
+void otaReceber(){
+  HTTPUpload& up = server.upload();
+
+  if(up.status == UPLOAD_FILE_START){
+    ota_erro = NULL;
+    ota_codigo = 200;
+    if(!server.authenticate(OTA_USUARIO, OTA_SENHA)){
+      otaRecusar(401, "autenticacao necessaria");
+      return;
+    }
+    if(corridaAtiva() || corridaSintonizando()){
+      otaRecusar(409, "forno em execucao");
+      return;
+    }
+    String md5 = server.arg("md5");
+    if(md5.length() != 32){
+      otaRecusar(400, "md5 ausente ou malformado");
+      return;
+    }
+    // o espaço livre inteiro, alinhado ao setor: o tamanho real só se sabe no fim
+    uint32_t maximo = (ESP.getFreeSketchSpace() - 0x1000) & 0xFFFFF000;
+    if(!Update.begin(maximo, U_FLASH) || !Update.setMD5(md5.c_str())){
+      otaRecusar(500, "sem espaco para a imagem");
+      return;
+    }
+    ota_ativa = true;
+    Serial.println("OTA: recebendo " + up.filename);
+  }
+  else if(up.status == UPLOAD_FILE_WRITE){
+    if(!ota_ativa) return;
+    if(Update.write(up.buf, up.currentSize) != up.currentSize){
+      otaRecusar(500, "falha ao gravar na flash");
+    }
+  }
+  else if(up.status == UPLOAD_FILE_END){
+    if(!ota_ativa) return;
+    ota_ativa = false;
+    if(!Update.end(true)){   // confere o MD5 e só então troca a imagem do boot
+      ota_codigo = 400;
+      ota_erro = (Update.getError() == UPDATE_ERROR_MD5) ? "md5 nao confere" : "imagem invalida";
+    }
+  }
+  else if(up.status == UPLOAD_FILE_ABORTED){
+    otaRecusar(400, "upload interrompido");
+  }
+}
+
+// Fim do POST /update
+void handleUpdate(){
+  if(ota_erro){
+    server.send(ota_codigo, "text/plain", ota_erro);
+    return;
+  }
+  if(!Update.isFinished()){
+    server.send(400, "text/plain", "nenhum firmware recebido");
+    return;
+  }
+  server.send(200, "text/plain", "ok, reiniciando");
+  Serial.println("OTA: imagem conferida, reiniciando");
+  ota_reinicio = millis();
+}
+
+// loop(): reinicia depois que a resposta saiu
+void otaAtender(){
+  if(ota_reinicio != 0 && millis() - ota_reinicio > OTA_REINICIO_MS){
+    ESP.restart();
+  }
+}
@@ -0,0 +1,77 @@
+// Mostrador local no forno (MODO_PAINEL): MAX7219 com 8 dígitos de 7 segmentos
+// Os 4 dígitos da esquerda mostram a temperatura e os 4 da direita o set
+// point da corrida, em C inteiros; "----" é termopar aberto. O timerPainel
+// só posta TRABALHO_PAINEL; o loop() monta a imagem dos dígitos e escreve
+// no MAX7219 apenas os registradores que mudaram desde a última vez
+// (painel_sombra), e não a linha inteira como DigitLedDisplay::printDigit.
+// Roda na mesma fila que a leitura dos termopares, então as duas nunca
+// disputam o SCLK que compartilham.
+
+#if MODO_PAINEL
+
+#define PAINEL_DIGITOS   8
+#define PAINEL_BRILHO    8       // 0 a 15
+#define PAINEL_REESCRITA 40      // atualizações entre duas reescritas completas
+#define PAINEL_APAGADO   0x00
+#define PAINEL_TRACO     0x01    // só o segmento G
+#define PAINEL_INVALIDO  0xFF    // nunca mostrado (o ponto decimal não é usado)
+
+// registradores de controle do MAX7219
+#define PAINEL_REG_DECODIFICACAO 9
+#define PAINEL_REG_VARREDURA     11
+#define PAINEL_REG_DESLIGAMENTO  12
+#define PAINEL_REG_TESTE         15
+
+DigitLedDisplay painel(painelDIN, painelCS, maxCLK);
+uint8_t painel_sombra[PAINEL_DIGITOS];   // o que o MAX7219 mostra; [0] é o dígito da direita
+uint8_t painel_atualizacoes = 0;
+
+// Configura o MAX7219 e marca todos os dígitos para serem reescritos.
+// Repetido a cada PAINEL_REESCRITA atualizações: um pico do triac que
+// reinicie o chip não deixa o mostrador apagado até o próximo boot
+void painelIniciar(){
+  painel.write(PAINEL_REG_TESTE, 0);
+  painel.write(PAINEL_REG_DECODIFICACAO, 0);   // segmentos crus, pela charTable
+  painel.write(PAINEL_REG_VARREDURA, PAINEL_DIGITOS - 1);
+  painel.setBright(PAINEL_BRILHO);
+  painel.write(PAINEL_REG_DESLIGAMENTO, 1);
+  memset(painel_sombra, PAINEL_INVALIDO, sizeof(painel_sombra));
+}
+
+// valor de 0 a 9999 em 4 dígitos alinhado à direita, sem zeros à esquerda
+void painelNumero(uint8_t* digitos, long valor){
+  if(valor < 0 || valor > 9999){
+    memset(digitos, PAINEL_TRACO, 4);
+    return;
+  }
+  for(uint8_t i=0; i<4; i++){
+    digitos[i] = (i == 0 || valor > 0) ? pgm_read_byte(&charTable[valor % 10]) : PAINEL_APAGADO;
+    valor /= 10;
+  }
+}
+
+// Pedido pelo timerPainel e executado no loop(): no máximo PAINEL_DIGITOS
+// escritas de 16 bits, e nenhuma quando nada mudou
+void painelAtualizar(){
+  AmostraControle a;
+  telemetria.ler(a);
+
+  uint8_t imagem[PAINEL_DIGITOS];
+  if(a.falha_sensor) memset(imagem + 4, PAINEL_TRACO, 4);
+  else painelNumero(imagem + 4, lroundf(a.rk));
+  if(corridaAtiva()) painelNumero(imagem, lroundf(a.set_point));
+  else memset(imagem, PAINEL_APAGADO, 4);
+
+  if(++painel_atualizacoes >= PAINEL_REESCRITA){
+    painel_atualizacoes = 0;
+    painelIniciar();
+  }
+
+  for(uint8_t d=0; d<PAINEL_DIGITOS; d++){
+    if(imagem[d] == painel_sombra[d]) continue;
+    painel.write(d + 1, imagem[d]);   // registradores dos dígitos começam em 1
+    painel_sombra[d] = imagem[d];
+  }
+}
+
+#endif
@@ -0,0 +1,250 @@
+// Diferenças entre o ESP8266 (um núcleo) e o ESP32 (dois núcleos)
+// O sketch é escrito para o ESP8266; no ESP32 este arquivo troca as
+// bibliotecas do core, dá nomes D0-D8 aos GPIOs usados (um DevKit, sem
+// pinos de boot no triac) e os utilitários que só um dos dois tem. A
+// divisão das tarefas entre os núcleos fica em nucleos.ino.
+// O servidor web do ESP8266 é o ServidorHttp_PI2 (web_PI2), que não
+// espera a rede dentro do loop(); o ESP32 fica com o WebServer do core,
+// que roda na tarefa da rede, longe do controle. Os tratadores usam só o
+// que os dois têm, mais enviarFonte() daqui.
+
+  // guarda de inclusão
+#ifndef PlataformaForno_h
+#define PlataformaForno_h
+
+#if defined(ESP32)
+#include <WiFi.h>
+#include <WebServer.h>
+#include <ESPmDNS.h>
+#include <Update.h>
+#include <esp_task_wdt.h>
+#include <esp_timer.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include <functional>
+
+typedef WebServer ServidorWeb;
+typedef WiFiClient ClienteWeb;
+typedef std::function<size_t(uint8_t* destino, size_t max)> FonteWeb;
+
+// O ESP32 não tem light sleep no WiFi do Arduino: o modem sleep mínimo
+// já acorda a cada DTIM
+static inline void wifiSono(bool dormir){
+  WiFi.setSleep(dormir ? WIFI_PS_MIN_MODEM : WIFI_PS_NONE);
+}
+
+// O mDNS do IDF roda sozinho e anuncia cada TXT alterado
+static inline void mdnsAtender(){}
+static inline void mdnsAnunciar(){}
+
+// Resposta puxada de uma fonte até ela devolver 0; aqui, de uma vez
+static inline void enviarFonte(ServidorWeb& servidor, int codigo, const char* tipo, FonteWeb fonte){
+  uint8_t pedaco[512];
+  servidor.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  servidor.send(codigo, tipo, "");
+  size_t n;
+  while((n = fonte(pedaco, sizeof(pedaco))) > 0) servidor.sendContent((const char*)pedaco, n);
+  servidor.sendContent("");
+}
+
+// O WebServer do core não tem arena por pedido: esta é da tarefa da rede,
+// zerada por atenderWeb() antes de cada pedido
+#define ARENA_WEB 1536
+static char arena_web[ARENA_WEB];
+static size_t arena_web_usada = 0;
+
+static inline __attribute__((format(printf, 2, 3)))
+char* formatarResposta(ServidorWeb&, const char* formato, ...){
+  char* destino = arena_web + arena_web_usada;
+  size_t livre = ARENA_WEB - arena_web_usada;
+  va_list argumentos;
+  va_start(argumentos, formato);
+  int n = vsnprintf(destino, livre, formato, argumentos);
+  va_end(argumentos);
+  if(n < 0 || (size_t)n >= livre) return NULL;
+  arena_web_usada += n + 1;
+  return destino;
+}
+
+static inline bool etagConfere(ServidorWeb& servidor, const char* etag){
+  return servidor.header("If-None-Match") == etag;
+}
+
+static inline void atenderWeb(ServidorWeb& servidor){
+  arena_web_usada = 0;
+  servidor.handleClient();
+}
+
+// Os sinais do NodeMCU em GPIOs livres do DevKit
+#define D0 19
+#define D1 5
+#define D2 18
+#define D3 17
+#define D4 16
+#define D5 14
+#define D6 26
+#define D7 27
+#define D8 23
+
+#define NUCLEO_REDE     0      // o WiFi do IDF já mora aqui
+#define NUCLEO_CONTROLE 1
+
+static inline uint32_t chipId(){
+  uint64_t mac = ESP.getEfuseMac();
+  return (uint32_t)mac ^ (uint32_t)(mac >> 32);
+}
+
+static inline uint64_t micros64(){
+  return esp_timer_get_time();
+}
+
+static inline uint32_t heapMaiorBloco(){
+  return ESP.getMaxAllocHeap();
+}
+
+static inline uint8_t heapFragmentacao(){
+  uint32_t livre = ESP.getFreeHeap();
+  return livre ? 100 - (uint64_t)ESP.getMaxAllocHeap() * 100 / livre : 0;
+}
+
+// Menor espaço livre da pilha da tarefa que chama (a da rede)
+static inline uint32_t pilhaLivreMinima(){
+  return uxTaskGetStackHighWaterMark(NULL);
+}
+
+// O TWDT do IDF vigia só as tarefas inscritas: a da rede se inscreve
+static inline void watchdogIniciar(){
+  esp_task_wdt_init(6, true);
+  esp_task_wdt_add(NULL);
+}
+
+static inline void watchdogAlimentar(){
+  esp_task_wdt_reset();
+}
+
+// Sem esperar os 6 s do TWDT: o triac já está travado
+static inline void watchdogDisparar(){
+  Serial.flush();
+  ESP.restart();
+}
+
+// Sobrevive ao reset e ao deep sleep, não à falta de energia: quem lê
+// confere uma assinatura. Até 16 bytes (rede.ino)
+RTC_NOINIT_ATTR static uint32_t rtc_memoria[4];
+
+static inline void rtcLer(void* destino, size_t n){
+  memcpy(destino, rtc_memoria, n);
+}
+
+static inline void rtcGravar(const void* origem, size_t n){
+  memcpy(rtc_memoria, origem, n);
+}
+
+// Nível baixo no pino tira a CPU do light sleep (repouso.ino)
+static inline void acordarPorPino(uint8_t pino){
+  gpio_wakeup_enable((gpio_num_t)pino, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+}
+
+#else
+#include <ESP8266WiFi.h>
+#include <web_PI2.h>
+#include <ESP8266mDNS.h>
+#include <Updater.h>
+
+typedef ServidorHttp_PI2 ServidorWeb;
+typedef ClienteHttp_PI2 ClienteWeb;
+typedef FonteHttp_PI2 FonteWeb;
+
+// Light sleep entre os beacons, acordando a cada DTIM (intervalo 1); o
+// loop() nunca fica ocioso, então a CPU e os Tickers seguem rodando
+static inline void wifiSono(bool dormir){
+  if(dormir) WiFi.setSleepMode(WIFI_LIGHT_SLEEP, 1);
+  else WiFi.setSleepMode(WIFI_NONE_SLEEP);
+}
+
+// O respondedor do ESP8266 só anda no loop(); um TXT alterado precisa
+// de um anúncio novo
+static inline void mdnsAtender(){
+  MDNS.update();
+}
+
+static inline void mdnsAnunciar(){
+  MDNS.announce();
+}
+
+// A fonte é puxada em handleClient(), conforme o TCP aceita
+static inline void enviarFonte(ServidorWeb& servidor, int codigo, const char* tipo, FonteWeb fonte){
+  servidor.enviarFonte(codigo, tipo, fonte);
+}
+
+// Texto na arena do pedido (web_PI2), sem heap: vale até o tratador
+// retornar. NULL se não couber
+static inline __attribute__((format(printf, 2, 3)))
+char* formatarResposta(ServidorWeb& servidor, const char* formato, ...){
+  va_list argumentos;
+  va_start(argumentos, formato);
+  char* texto = servidor.formatarV(formato, argumentos);
+  va_end(argumentos);
+  return texto;
+}
+
+static inline bool etagConfere(ServidorWeb& servidor, const char* etag){
+  const char* valor = servidor.cabecalhoPedido("If-None-Match");
+  return valor && strcmp(valor, etag) == 0;
+}
+
+static inline void atenderWeb(ServidorWeb& servidor){
+  servidor.handleClient();
+}
+
+static inline uint32_t chipId(){
+  return ESP.getChipId();
+}
+
+static inline uint32_t heapMaiorBloco(){
+  return ESP.getMaxFreeBlockSize();
+}
+
+static inline uint8_t heapFragmentacao(){
+  return ESP.getHeapFragmentation();
+}
+
+static inline uint32_t pilhaLivreMinima(){
+  return ESP.getFreeContStack();
+}
+
+// Só o de hardware (~6 s). O SDK o alimenta a cada volta ou yield() do
+// loop(): ele só pega o loop() preso sem ceder, não o controle parado
+static inline void watchdogIniciar(){
+  ESP.wdtDisable();
+  ESP.wdtFeed();
+}
+
+static inline void watchdogAlimentar(){
+  ESP.wdtFeed();
+}
+
+// Deixar de alimentar não reinicia nada aqui (ver acima): o reset é pedido
+static inline void watchdogDisparar(){
+  Serial.flush();
+  ESP.restart();
+}
+
+// Memória de usuário do RTC, do bloco 0: sobrevive ao reset e ao deep
+// sleep, não à falta de energia (rede.ino). Tamanho múltiplo de 4
+static inline void rtcLer(void* destino, size_t n){
+  ESP.rtcUserMemoryRead(0, (uint32_t*)destino, n);
+}
+
+static inline void rtcGravar(const void* origem, size_t n){
+  ESP.rtcUserMemoryWrite(0, (uint32_t*)origem, n);
+}
+
+// Nível baixo no pino acorda do light sleep automático (repouso.ino)
+static inline void acordarPorPino(uint8_t pino){
+  wifi_enable_gpio_wakeup(GPIO_ID_PIN(pino), GPIO_PIN_INTR_LOLEVEL);
+}
+#endif
+
+#endif
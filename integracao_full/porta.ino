@@ -0,0 +1,64 @@
+// Porta automática do forno (MODO_PORTA): servo de hobby que abre a porta
+// na fase de resfriamento do perfil, no lugar do "Abrir a porta do Forno!"
+// lido no navegador. O triac já está desligado nessa fase; a abertura da
+// porta passa a ser a ação de controle: um PI compara rk com o set point
+// que o perfil faz descer e abre mais quando o forno esfria devagar, menos
+// quando esfria rápido demais. Depois do perfil (CORRIDA_RESFRIANDO) não há
+// mais inclinação a seguir e a porta fica toda aberta até CORRIDA_FRIA.
+// Roda dentro do controle_pid(), a cada Ts, depois de corridaPasso().
+
+#if MODO_PORTA
+
+#define PORTA_US_FECHADA 1000    // pulso do servo com a porta fechada
+#define PORTA_US_ABERTA  2000    // pulso do servo com a porta toda aberta
+#define PORTA_KC         10.0    // % de abertura por C acima do set point
+#define PORTA_KI         0.05    // idem, por C e por amostra de Ts
+#define PORTA_VELOCIDADE 25.0    // %/s: a porta não bate nem joga ar frio de uma vez
+
+Servo porta;
+PidController porta_pi(PORTA_KC, PORTA_KI, 0, 0, 100);
+float porta_abertura = 0;        // % aplicada agora, já limitada em velocidade
+int porta_us = -1;               // último pulso escrito no servo
+
+// Depois do Serial.begin(): o RX só recebe se ninguém reconfigurar o pino,
+// e aqui ele vira a saída do servo
+void portaIniciar(){
+  porta.attach(portaServo, PORTA_US_FECHADA, PORTA_US_ABERTA);
+  portaMover(0);
+}
+
+void portaMover(float abertura){
+  int us = PORTA_US_FECHADA + lroundf(abertura * (PORTA_US_ABERTA - PORTA_US_FECHADA) / 100);
+  if(us == porta_us) return;
+  porta.writeMicroseconds(us);
+  porta_us = us;
+}
+
+// % de abertura aplicada, para o corridaJson()
+float portaAbertura(){
+  return porta_abertura;
+}
+
+void portaAtualizar(){
+  float alvo = 0;
+  bool resfriando = corrida == CORRIDA_RODANDO && perfil.fase() == FASE_RESFRIAMENTO;
+  if(resfriando && !falha_sensor){
+    // referência e medida trocadas: erro = rk - set_point, positivo abre
+    alvo = porta_pi.atualizar(rk, set_point);
+  }
+  else {
+    porta_pi.reiniciar();
+    // sem rampa para seguir, ou com o triac travado pelo supervisor:
+    // o mais rápido possível, até esfriar. Abortada fica fechada: a
+    // corrida foi parada pelo operador, que está olhando o forno
+    if(corrida == CORRIDA_RESFRIANDO) alvo = 100;
+    else if(corrida == CORRIDA_FALHA && (falha_sensor || rk >= CORRIDA_FRIA)) alvo = 100;
+    else if(resfriando) alvo = porta_abertura;   // sensor aberto: segura
+  }
+
+  float passo = PORTA_VELOCIDADE * Ts / 1000;
+  porta_abertura += constrain(alvo - porta_abertura, -passo, passo);
+  portaMover(porta_abertura);
+}
+
+#endif
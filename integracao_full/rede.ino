@@ -0,0 +1,167 @@
+// Conexão WiFi em segundo plano
+// O boot não espera pela rede: controle, sensor e triac já estão rodando
+// quando WiFi.begin() é chamado. Os eventos do SDK só marcam flags; as
+// transições e mensagens acontecem em redeAtender(), no loop().
+// Sono do rádio: o modem sleep padrão acorda o rádio de tempos em tempos
+// e soma 100 ms ou mais, ao acaso, a cada pedido HTTP e quadro de
+// WebSocket. Com corrida, sintonia ou alguém inscrito no fluxo ao vivo
+// (WebSocket ou SSE) o rádio fica sempre acordado; parado há
+// REDE_OCIOSO_MS, dorme entre os beacons e acorda a cada DTIM.
+
+#define REDE_TEMPO_CONEXAO_MS 20000   // sem IP nesse tempo: recomeça do zero
+#define REDE_ESPERA_MS        5000    // pausa antes de tentar de novo
+#define REDE_OCIOSO_MS        30000   // sem atividade: o rádio volta a dormir
+
+enum EstadoRede { REDE_CONECTANDO, REDE_CONECTADA, REDE_ESPERA };
+
+EstadoRede rede_estado = REDE_ESPERA;
+unsigned long rede_instante = 0;        // millis() da última transição
+volatile bool rede_evento_ip = false;
+volatile bool rede_evento_queda = false;
+volatile int rede_motivo_queda = 0;
+int8_t rede_sono = -1;                  // 1 dormindo entre DTIMs, 0 acordado, -1 ainda não aplicado
+unsigned long rede_atividade = 0;       // millis() da última corrida ou inscrito
+#if !defined(ESP32)
+WiFiEventHandler rede_handler_ip;
+WiFiEventHandler rede_handler_queda;
+#endif
+
+void redeIniciar(){
+  WiFi.persistent(false);     // não regrava as credenciais na flash a cada boot
+  WiFi.mode(WIFI_STA);
+  WiFi.setAutoReconnect(true);
+
+#if defined(ESP32)
+  WiFi.onEvent([](WiFiEvent_t, WiFiEventInfo_t){
+    rede_evento_ip = true;
+  }, ARDUINO_EVENT_WIFI_STA_GOT_IP);
+  WiFi.onEvent([](WiFiEvent_t, WiFiEventInfo_t info){
+    rede_motivo_queda = info.wifi_sta_disconnected.reason;
+    rede_evento_queda = true;
+  }, ARDUINO_EVENT_WIFI_STA_DISCONNECTED);
+#else
+  rede_handler_ip = WiFi.onStationModeGotIP([](const WiFiEventStationModeGotIP&){
+    rede_evento_ip = true;
+  });
+  rede_handler_queda = WiFi.onStationModeDisconnected([](const WiFiEventStationModeDisconnected& e){
+    rede_motivo_queda = e.reason;
+    rede_evento_queda = true;
+  });
+#endif
+
+  redeConectar();
+}
+
+// BSSID e canal do último AP na memória RTC, que sobrevive ao reset (não
+// à falta de energia): com eles o WiFi.begin() pula a varredura dos canais
+// e a volta de um reset ou do repouso leva uma fração de segundo
+#define REDE_RTC_ASSINATURA 0x52454445UL   // "REDE"
+
+struct RedeRtc {
+  uint32_t assinatura;
+  uint8_t bssid[6];
+  uint8_t canal;
+  uint8_t soma;           // dos campos acima: RTC sem inicializar não passa
+};
+
+RedeRtc rede_rtc;
+
+uint8_t redeRtcSoma(){
+  uint8_t soma = rede_rtc.canal;
+  for(uint8_t i=0; i<6; i++) soma += rede_rtc.bssid[i];
+  return soma ^ (uint8_t)rede_rtc.assinatura;
+}
+
+bool redeRtcLer(){
+  rtcLer(&rede_rtc, sizeof(rede_rtc));
+  return rede_rtc.assinatura == REDE_RTC_ASSINATURA && rede_rtc.soma == redeRtcSoma()
+         && rede_rtc.canal > 0;
+}
+
+void redeRtcGravar(){
+  rede_rtc.assinatura = REDE_RTC_ASSINATURA;
+  memcpy(rede_rtc.bssid, WiFi.BSSID(), sizeof(rede_rtc.bssid));
+  rede_rtc.canal = WiFi.channel();
+  rede_rtc.soma = redeRtcSoma();
+  rtcGravar(&rede_rtc, sizeof(rede_rtc));
+}
+
+void redeRtcApagar(){
+  memset(&rede_rtc, 0, sizeof(rede_rtc));
+  rtcGravar(&rede_rtc, sizeof(rede_rtc));
+}
+
+void redeConectar(){
+  if(redeRtcLer()) WiFi.begin(ssid, password, rede_rtc.canal, rede_rtc.bssid);
+  else WiFi.begin(ssid, password);
+  rede_estado = REDE_CONECTANDO;
+  rede_instante = millis();
+  Serial.print("WiFi: conectando a ");
+  Serial.println(ssid);
+}
+
+void redeAtender(){
+  if(rede_evento_ip){
+    rede_evento_ip = false;
+    rede_estado = REDE_CONECTADA;
+    rede_instante = millis();
+    Serial.print("WiFi: conectado, IP ");
+    Serial.println(WiFi.localIP());
+    redeRtcGravar();
+  }
+  if(rede_evento_queda){
+    rede_evento_queda = false;
+    if(rede_estado == REDE_CONECTADA){
+      // o SDK tenta reconectar sozinho; o prazo abaixo cobre quando não consegue
+      rede_estado = REDE_CONECTANDO;
+      rede_instante = millis();
+      Serial.print("WiFi: conexao perdida, motivo ");
+      Serial.println(rede_motivo_queda);
+    }
+  }
+
+  switch(rede_estado){
+    case REDE_CONECTANDO:
+      if(millis() - rede_instante > REDE_TEMPO_CONEXAO_MS){
+        Serial.println("WiFi: sem resposta do AP, nova tentativa em breve");
+        WiFi.disconnect();
+        redeRtcApagar();   // o AP pode ter mudado de canal: a próxima varre
+        rede_estado = REDE_ESPERA;
+        rede_instante = millis();
+      }
+      break;
+    case REDE_ESPERA:
+      if(millis() - rede_instante > REDE_ESPERA_MS) redeConectar();
+      break;
+    case REDE_CONECTADA:
+      break;
+  }
+  redeSono();
+}
+
+// Acorda na hora; dorme só depois de REDE_OCIOSO_MS parado
+void redeSono(){
+  bool ativo = corridaAtiva() || corridaSintonizando() || wsClientes() > 0 || sseInscritos() > 0;
+  if(ativo) rede_atividade = millis();
+  bool dormir = !ativo && millis() - rede_atividade >= REDE_OCIOSO_MS;
+  if(rede_sono == (dormir ? 1 : 0)) return;
+  wifiSono(dormir);
+  rede_sono = dormir ? 1 : 0;
+}
+
+// Botão ou outro aviso de operador: o rádio acorda já e o repouso recomeça a contar
+void redeAcordar(){
+  rede_atividade = millis();
+}
+
+unsigned long redeOciosoMs(){
+  return millis() - rede_atividade;
+}
+
+bool redeConectada(){
+  return rede_estado == REDE_CONECTADA;
+}
+
+bool redeDormindo(){
+  return rede_sono == 1;
+}
@@ -0,0 +1,50 @@
+// Hora UTC comum a todos os fornos (relogio.ino)
+// O SNTP do core (configTime) acerta a hora do sistema em segundo plano;
+// o TimeLib consulta essa hora a cada RELOGIO_SINCRONIA_S pela fonte
+// registrada em setSyncProvider, e cada consulta corrige o Relogio_PI2.
+// Quem marca tempo (amostra de controle, registro, frota, MQTT, eventos)
+// lê relogioUtc(): só aritmética sobre micros64(), nunca espera pela rede.
+// Sem resposta do SNTP ainda, relogioUtc() é 0 e os receptores ficam com
+// o millis() que já vinha junto.
+
+#define RELOGIO_SERVIDOR    "pool.ntp.org"
+#define RELOGIO_SINCRONIA_S 60
+#define RELOGIO_VALIDO      1577836800UL   // 2020-01-01: antes disso o SNTP não respondeu
+
+Relogio_PI2 relogio;
+
+// Fonte do TimeLib, chamada de dentro de now() no loop(). A hora do
+// sistema já está na RAM: ler não envia nada pela rede
+time_t relogioSntp(){
+  timeval tv;
+  gettimeofday(&tv, NULL);
+  if((uint32_t)tv.tv_sec < RELOGIO_VALIDO) return 0;   // o TimeLib tenta de novo depois
+  relogio.corrigir(micros64(), (uint64_t)tv.tv_sec * 1000000ULL + tv.tv_usec);
+  return tv.tv_sec;
+}
+
+void relogioIniciar(){
+  configTime(0, 0, RELOGIO_SERVIDOR);   // UTC: o fuso fica para quem mostra
+  setSyncInterval(RELOGIO_SINCRONIA_S);
+  setSyncProvider(relogioSntp);
+}
+
+// O TimeLib só consulta a fonte quando alguém chama now()
+void relogioAtender(){
+  now();
+}
+
+// µs desde 1970, 0 enquanto não houver sincronia
+uint64_t relogioUtc(){
+  return relogio.sincronizado() ? relogio.agora(micros64()) : 0;
+}
+
+// "segundos.milissegundos" ou "0", para os formatos em texto
+void relogioTexto(char* destino, size_t tamanho, uint64_t utc_us){
+  if(utc_us == 0){
+    snprintf(destino, tamanho, "0");
+    return;
+  }
+  uint64_t ms = utc_us / 1000;
+  snprintf(destino, tamanho, "%lu.%03u", (unsigned long)(ms / 1000), (unsigned)(ms % 1000));
+}
@@ -0,0 +1,40 @@
+// Repouso entre turnos (MODO_REPOUSO)
+// Entre um turno e outro o forno fica parado com o loop() girando sem
+// nada para fazer, e o light sleep que rede.ino liga no rádio nunca chega
+// à CPU: o SDK do ESP8266 só dorme quando o loop() cede em delay(). Parado
+// há REPOUSO_MIN minutos (o mesmo "parado" do sono do rádio, mais OTA), o
+// loop() termina cada volta com um delay() de REPOUSO_PASSO_MS; a CPU dorme
+// até o próximo Ticker, e o controle e o supervisor seguem em Ts.
+// Acorda sozinho com corrida, sintonia ou alguém inscrito (a página abre o
+// WebSocket assim que carrega); um pedido HTTP espera no máximo um DTIM.
+// O botão em repousoBotao tira do light sleep pelo GPIO e acorda o rádio
+// na mesma volta. BSSID e canal do AP ficam na memória RTC (rede.ino).
+
+#if MODO_REPOUSO
+
+bool repouso_ativo = false;
+uint32_t repouso_entradas = 0;
+
+void repousoIniciar(){
+  pinMode(repousoBotao, INPUT_PULLUP);
+  acordarPorPino(repousoBotao);
+}
+
+// Última coisa do laco()
+void repousoAtender(){
+  if(digitalRead(repousoBotao) == LOW || otaAtiva()) redeAcordar();
+
+  bool repousar = redeOciosoMs() >= REPOUSO_MIN * 60000UL;
+  if(repousar != repouso_ativo){
+    repouso_ativo = repousar;
+    if(repousar) repouso_entradas++;
+    Serial.println(repousar ? "Repouso: parado, CPU dorme entre os Tickers" : "Repouso: acordado");
+  }
+  if(repouso_ativo) delay(REPOUSO_PASSO_MS);
+}
+
+bool repousoAtivo(){
+  return repouso_ativo;
+}
+
+#endif
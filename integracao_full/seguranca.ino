@@ -0,0 +1,76 @@
+// Supervisor de segurança, à parte do PID
+// A cada período de controle cada zona passa pelo seu Supervisor_PI2
+// (leitura renovada, máxima absoluta, taxa de subida, potência alta sem
+// resposta). Qualquer desarme trava o disparo, que a partir do próximo
+// cruzamento por zero ignora a potência pedida; só uma nova corrida
+// (/init) rearma, e apenas com o forno abaixo da máxima.
+//
+// O loop() confere a cada volta que a tarefa de controle está batendo;
+// parada por SEGURANCA_CONTROLE_PERIODOS, o disparo é travado e o ESP é
+// reiniciado (watchdogDisparar()), voltando com o triac desligado e sem
+// corrida. O loop() preso sem ceder é do watchdog: no ESP8266 o de
+// hardware (~6 s; o SDK o alimenta a cada yield(), então um loop() que
+// espera cedendo não é pego por ele), no ESP32 o TWDT do IDF vigiando a
+// tarefa da rede (plataforma.h).
+
+#define SEGURANCA_CONTROLE_PERIODOS 5   // controle sem rodar por 5*Ts: desarme
+
+unsigned long seguranca_batimento = 0;  // millis() da última tarefa de controle
+uint8_t seguranca_motivo = DESARME_NENHUM;
+
+// No fim do setup(): daqui para frente o loop() tem que girar
+void segurancaIniciar(){
+  seguranca_batimento = millis();
+  watchdogIniciar();
+}
+
+void segurancaDesarmar(uint8_t motivo){
+  disparo.bloquear();
+  if(seguranca_motivo == DESARME_NENHUM){
+    seguranca_motivo = motivo;
+    Serial.print("DESARME motivo "); Serial.println(motivo);
+  }
+}
+
+// Chamado pela tarefa de controle antes do PID; false = desarmado
+bool segurancaVerificar(){
+  unsigned long agora = millis();
+  seguranca_batimento = agora;
+
+  for(uint8_t z=0; z<ZONAS; z++){
+    Zona &zn = zonas[z];
+    float leitura = zn.filtro.falha() ? NAN : zn.rk;
+    uint8_t motivo = zn.supervisor.verificar(leitura, zn.instante_rk, zn.uk, agora);
+    if(motivo != DESARME_NENHUM) segurancaDesarmar(motivo);
+  }
+  return seguranca_motivo == DESARME_NENHUM;
+}
+
+// loop(): confere o controle e alimenta o watchdog de hardware
+void segurancaAtender(){
+  unsigned long limite = (unsigned long)SEGURANCA_CONTROLE_PERIODOS * Ts;
+  if(millis() - seguranca_batimento > limite){
+    segurancaDesarmar(DESARME_CONTROLE);
+    watchdogDisparar();
+    return;
+  }
+  watchdogAlimentar();
+}
+
+// Nova corrida: rearma se todas as zonas aceitarem
+bool segurancaRearmar(){
+  unsigned long agora = millis();
+  bool ok = true;
+  for(uint8_t z=0; z<ZONAS; z++){
+    float leitura = zonas[z].filtro.falha() ? NAN : zonas[z].rk;
+    ok = zonas[z].supervisor.rearmar(leitura, agora) && ok;
+  }
+  if(!ok) return false;
+  seguranca_motivo = DESARME_NENHUM;
+  disparo.liberar();
+  return true;
+}
+
+uint8_t segurancaMotivo(){
+  return seguranca_motivo;
+}
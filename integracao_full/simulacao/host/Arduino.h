@@ -0,0 +1,46 @@
+/*  Núcleo Arduino mínimo para compilar as bibliotecas do forno no PC
+ *  Só o que controle_PI2, perfil_PI2, sensor_PI2 e atuador_PI2 usam;
+ *  o tempo e os pinos são os da simulação (simulacao.cpp).
+ *
+ *  Arduino.h
+ */
+
+#ifndef ArduinoHost_h
+#define ArduinoHost_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+
+#define F_CPU 80000000L
+#define PI 3.1415926535897932384626433832795
+#define IRAM_ATTR
+#define PROGMEM
+#define memcpy_P memcpy
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define MSBFIRST 1
+
+#define constrain(x, baixo, alto) ((x) < (baixo) ? (baixo) : ((x) > (alto) ? (alto) : (x)))
+
+typedef uint8_t byte;
+
+// por thread: cada corrida simulada tem o seu relógio e os seus pinos
+extern thread_local uint32_t hostMillis;
+extern thread_local uint8_t hostPinos[32];   // último valor escrito em cada pino
+
+static inline uint32_t millis(void) { return hostMillis; }
+static inline uint32_t micros(void) { return hostMillis * 1000UL; }
+static inline void delayMicroseconds(unsigned int) {}
+static inline void pinMode(uint8_t, uint8_t) {}
+static inline void digitalWrite(uint8_t pino, uint8_t valor) { hostPinos[pino & 31] = valor; }
+static inline int digitalRead(uint8_t pino) { return hostPinos[pino & 31]; }
+static inline void noInterrupts(void) {}
+static inline void interrupts(void) {}
+
+#endif
@@ -0,0 +1,29 @@
+/*  SPI vazio para o PC: a simulação não lê os conversores, entrega a
+ *  temperatura direto ao FiltroTemperatura_PI2.
+ *
+ *  SPI.h
+ */
+
+#ifndef SPIHost_h
+#define SPIHost_h
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0
+#define SPI_MODE1 1
+
+struct SPISettings {
+  SPISettings(uint32_t, uint8_t, uint8_t) {}
+};
+
+struct SPIClass {
+  void begin(void) {}
+  void beginTransaction(const SPISettings &) {}
+  void endTransaction(void) {}
+  uint8_t transfer(uint8_t) { return 0; }
+  uint16_t transfer16(uint16_t) { return 0; }
+};
+
+static SPIClass SPI;
+
+#endif
@@ -0,0 +1,190 @@
+/*  Conferência do LatenciaZero_PI2 (atuador_PI2) no PC
+ *  Gera cruzamentos por zero numa grade de rede conhecida (com deriva
+ *  lenta da frequência), atrasa cada chegada da ISR por uma distribuição
+ *  conhecida (mínimo fixo, cauda exponencial e, às vezes, um bloqueio
+ *  longo como os do WiFi) e entrega entrada/saída em ciclos, como o
+ *  angle() do sketch. A biblioteca só vê as chegadas: ancora a grade nas
+ *  mais cedo, então mede o atraso acima do mínimo. O resultado é
+ *  comparado com a verdade (atraso - mínimo): máximo, média e, em cada
+ *  fronteira de balde do histograma, a fração das amostras abaixo dela.
+ *  A grade segue a rede com erro de cerca de 1 µs e fica num quantil
+ *  baixo dos atrasos, não exatamente no mínimo: a conferência aceita um
+ *  deslocamento de FOLGA_US ou FOLGA_REL da média, o que for maior. Com a
+ *  rede derivando mais de ~0,2 Hz em poucos minutos o erro passa disso.
+ *
+ *  latencia.cpp
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <getopt.h>
+#include <vector>
+#include <atuador_PI2.h>
+
+#define CICLOS_US (F_CPU / 1000000L)
+#define FOLGA_US  1.5
+#define FOLGA_REL 0.15      // da média verdadeira: a grade fica num quantil baixo, não no mínimo
+#define FOLGA_CAUDA 10000   // 1 amostra em tanto pode trocar de balde na cauda esparsa
+#define FINO_US   0.25      // resolução da distribuição verdadeira
+
+struct Opcoes {
+  long cruzamentos;
+  float rede_hz;
+  float minimo_us;          // atraso que a ISR sempre tem
+  float media_us;           // da cauda exponencial, acima do mínimo
+  float bloqueio;           // fração das chegadas com bloqueio longo
+  float bloqueio_us;        // duração máxima do bloqueio
+  float corpo_us;           // da entrada até o GPIO do triac
+  float deriva_hz;          // amplitude da variação lenta da rede
+  float tolerancia;         // % aceito na média e no máximo
+  unsigned semente;
+};
+
+// Só o que a verdade precisa para ser comparada com DadosLatencia
+struct Verdade {
+  uint32_t amostras;
+  double soma_us, soma_gatilho_us;
+  double maximo_us, maximo_gatilho_us;
+  std::vector<uint32_t> fino;       // amostras por FINO_US, para a distribuição
+};
+
+// Amostras verdadeiras abaixo de us
+static uint32_t abaixo(const Verdade &v, double us) {
+  long limite = lround(us / FINO_US);
+  uint32_t n = 0;
+  for (long i = 0; i < limite && i < (long)v.fino.size(); i++) n += v.fino[i];
+  return n;
+}
+
+static double uniforme(void) {
+  return (rand() + 1.0) / (RAND_MAX + 2.0);
+}
+
+static void uso(const char *programa) {
+  fprintf(stderr,
+    "uso: %s [-n cruzamentos] [-f hz] [-l minimo_us] [-m media_us] [-b fracao,max_us]\n"
+    "          [-c corpo_us] [-d deriva_hz] [-x tolerancia_pct] [-s semente]\n"
+    "  -n  cruzamentos gerados (padrão 200000, ~28 min de rede a 60 Hz)\n"
+    "  -f  frequência da rede (padrão 60)\n"
+    "  -l  atraso mínimo da ISR, invisível para a medida (padrão 3)\n"
+    "  -m  média da cauda exponencial acima do mínimo (padrão 4)\n"
+    "  -b  fração com bloqueio longo e a duração máxima dele (padrão 0.002,400)\n"
+    "  -c  corpo da ISR até o GPIO do triac (padrão 2.5)\n"
+    "  -d  variação lenta da frequência, em Hz (padrão 0.05)\n"
+    "  -x  erro aceito na média e no máximo, em %%, além de FOLGA_US (padrão 10)\n",
+    programa);
+}
+
+static bool lerOpcoes(int argc, char **argv, Opcoes &o) {
+  o.cruzamentos = 200000;
+  o.rede_hz = 60;
+  o.minimo_us = 3;
+  o.media_us = 4;
+  o.bloqueio = 0.002;
+  o.bloqueio_us = 400;
+  o.corpo_us = 2.5;
+  o.deriva_hz = 0.05;
+  o.tolerancia = 10;
+  o.semente = 1;
+
+  int opcao;
+  while ((opcao = getopt(argc, argv, "n:f:l:m:b:c:d:x:s:")) != -1) {
+    switch (opcao) {
+      case 'n': o.cruzamentos = atol(optarg); break;
+      case 'f': o.rede_hz = atof(optarg); break;
+      case 'l': o.minimo_us = atof(optarg); break;
+      case 'm': o.media_us = atof(optarg); break;
+      case 'b': if (sscanf(optarg, "%f,%f", &o.bloqueio, &o.bloqueio_us) != 2) return false; break;
+      case 'c': o.corpo_us = atof(optarg); break;
+      case 'd': o.deriva_hz = atof(optarg); break;
+      case 'x': o.tolerancia = atof(optarg); break;
+      case 's': o.semente = atoi(optarg); break;
+      default: return false;
+    }
+  }
+  // um bloqueio de meio semiciclo já seria lido como ruído (ressincronia)
+  return optind == argc && o.cruzamentos > 10 * LATENCIA_AQUECIMENTO && o.rede_hz >= 40
+         && o.rede_hz <= 70 && o.bloqueio_us < 250000.0 / o.rede_hz;
+}
+
+static bool confere(const char *nome, double medido, double verdade, double folga, const Opcoes &o) {
+  double erro = fabs(medido - verdade);
+  bool ok = erro <= folga || erro <= verdade * o.tolerancia / 100;
+  printf("%-16s medido %8.2f us, verdade %8.2f us%s\n", nome, medido, verdade, ok ? "" : " DIFERENTE");
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  Opcoes o;
+  if (!lerOpcoes(argc, argv, o)) {
+    uso(argv[0]);
+    return 2;
+  }
+  srand(o.semente);
+
+  LatenciaZero_PI2 latencia;
+  Verdade v = {};
+  v.fino.assign(lround(8192 / FINO_US), 0);
+  double cruzamento_s = 1;           // o contador de ciclos não começa em 0
+  for (long k = 0; k < o.cruzamentos; k++) {
+    // semiciclo com a frequência variando devagar (período de ~10 min)
+    double hz = o.rede_hz + o.deriva_hz * sin(2 * M_PI * cruzamento_s / 600);
+    cruzamento_s += 1 / (2 * hz);
+
+    double atraso_us = -o.media_us * log(uniforme());
+    if (uniforme() < o.bloqueio) atraso_us += uniforme() * o.bloqueio_us;
+    double corpo_us = o.corpo_us * (0.8 + 0.4 * uniforme());
+
+    double entrada_us = cruzamento_s * 1e6 + o.minimo_us + atraso_us;
+    uint32_t entrada = (uint32_t)(uint64_t)llround(entrada_us * CICLOS_US);
+    uint32_t saida = entrada + (uint32_t)llround(corpo_us * CICLOS_US);
+    latencia.registrar(entrada, saida);
+
+    // o aquecimento da biblioteca: o primeiro cruzamento ancora, os
+    // LATENCIA_AQUECIMENTO - 1 seguintes assentam o período
+    if (k < LATENCIA_AQUECIMENTO) continue;
+    v.amostras++;
+    v.soma_us += atraso_us;
+    v.soma_gatilho_us += atraso_us + corpo_us;
+    if (atraso_us > v.maximo_us) v.maximo_us = atraso_us;
+    if (atraso_us + corpo_us > v.maximo_gatilho_us) v.maximo_gatilho_us = atraso_us + corpo_us;
+    size_t i = (size_t)(atraso_us / FINO_US);
+    v.fino[i < v.fino.size() ? i : v.fino.size() - 1]++;
+  }
+
+  DadosLatencia d;
+  latencia.copiar(d);
+  const double por_us = CICLOS_US;
+  bool ok = true;
+  double folga = fmax(FOLGA_US, FOLGA_REL * v.soma_us / v.amostras);
+
+  printf("cruzamentos      %ld a %.1f Hz, ressincronias %lu, amostras %lu (verdade %lu)\n",
+         o.cruzamentos, o.rede_hz, (unsigned long)d.ressincronias, (unsigned long)d.amostras,
+         (unsigned long)v.amostras);
+  ok = ok && d.ressincronias == 0 && d.amostras == v.amostras;
+  ok = confere("entrada_media", d.entrada.soma / por_us / d.amostras, v.soma_us / v.amostras, folga, o) && ok;
+  ok = confere("entrada_max", d.entrada.maximo / por_us, v.maximo_us, folga, o) && ok;
+  ok = confere("gatilho_media", d.gatilho.soma / por_us / d.amostras, v.soma_gatilho_us / v.amostras, folga, o) && ok;
+  ok = confere("gatilho_max", d.gatilho.maximo / por_us, v.maximo_gatilho_us, folga, o) && ok;
+
+  // em cada fronteira (2, 4 ... 2048 µs), o medido abaixo dela tem de
+  // cair entre a verdade abaixo da fronteira -folga e +folga, com
+  // FOLGA_CAUDA de amostras a mais de cada lado
+  uint32_t medidos = 0;
+  for (uint8_t b = 0; b + 1 < LATENCIA_BALDES; b++) {
+    medidos += d.entrada.baldes[b];
+    double fronteira = 2 << b;
+    uint32_t menos = abaixo(v, fronteira - folga), mais = abaixo(v, fronteira + folga);
+    menos = (menos > v.amostras / FOLGA_CAUDA) ? menos - v.amostras / FOLGA_CAUDA : 0;
+    mais = (mais + v.amostras / FOLGA_CAUDA < v.amostras) ? mais + v.amostras / FOLGA_CAUDA : v.amostras;
+    bool dentro = medidos >= menos && medidos <= mais;
+    printf("abaixo_de_%-6.0f medido %6.2f %%, verdade %6.2f .. %6.2f %%%s\n", fronteira,
+           100.0 * medidos / d.amostras, 100.0 * menos / v.amostras, 100.0 * mais / v.amostras,
+           dentro ? "" : " DIFERENTE");
+    ok = ok && dentro;
+  }
+
+  printf("veredito         %s\n", ok ? "ok" : "REPROVADO");
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,35 @@
+/*  Modelo térmico do forno para a simulação no PC
+ *
+ *  planta.cpp
+ */
+
+#include <math.h>
+#include "planta.h"
+
+PlantaForno::PlantaForno(float ganho, float tauResistencia, float tauCamara, float tauTermopar, float ambiente) {
+  k = ganho;
+  tauR = tauResistencia;
+  tauC = tauCamara;
+  tauT = tauTermopar;
+  tamb = ambiente;
+  resistencia = ar = junta = 0;
+}
+
+float PlantaForno::atraso(float estado, float alvo, float tau, float dt_s) {
+  if (tau <= 0) return alvo;
+  return alvo + (estado - alvo) * expf(-dt_s / tau);
+}
+
+void PlantaForno::passo(float potencia, float dt_s) {
+  resistencia = atraso(resistencia, k * potencia, tauR, dt_s);
+  ar = atraso(ar, resistencia, tauC, dt_s);
+  junta = atraso(junta, ar, tauT, dt_s);
+}
+
+float PlantaForno::camara(void) const {
+  return tamb + ar;
+}
+
+float PlantaForno::termopar(void) const {
+  return tamb + junta;
+}
@@ -0,0 +1,32 @@
+/*  Modelo térmico do forno para a simulação no PC
+ *  Três atrasos de primeira ordem em cascata, todos sobre o excesso de
+ *  temperatura acima do ambiente:
+ *    resistência: tau_r * dR/dt = ganho * u - R
+ *    câmara:      tau_c * dC/dt = R - C
+ *    termopar:    tau_t * dT/dt = C - T
+ *  Em regime, a câmara fica ganho * u acima do ambiente. A resistência é
+ *  o atraso de aquecer o elemento; o termopar, o da junta na ponta da
+ *  bainha. Cada passo usa a solução exata do atraso, estável com
+ *  qualquer dt.
+ *
+ *  planta.h
+ */
+
+#ifndef PlantaForno_h
+#define PlantaForno_h
+
+class PlantaForno {
+ public:
+  PlantaForno(float ganho, float tauResistencia, float tauCamara, float tauTermopar, float ambiente);
+  void passo(float potencia, float dt_s);   // potência 0-100 % durante dt_s
+  float camara(void) const;                 // C: o que a placa sente
+  float termopar(void) const;               // C: o que o conversor lê
+
+ private:
+  float k, tauR, tauC, tauT, tamb;
+  float resistencia, ar, junta;             // excessos sobre o ambiente
+
+  static float atraso(float estado, float alvo, float tau, float dt_s);
+};
+
+#endif
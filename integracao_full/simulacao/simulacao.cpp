@@ -0,0 +1,135 @@
+/*  Simulação do controle do forno no PC
+ *  Uma corrida do perfil escolhido (simulador.cpp) com os ganhos da
+ *  linha de comando. Um perfil de 300 s roda em milissegundos; o resumo
+ *  traz sobressinal, erro de seguimento e o tempo acima do liquidus
+ *  (TAL), para comparar ganhos sem esquentar o forno. Para muitos
+ *  candidatos de uma vez, veja varredura.cpp.
+ *
+ *  simulacao.cpp
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include <time.h>
+#include <perfil_PI2.h>
+#include "simulador.h"
+
+static bool lerLista(const char *texto, float *v, int n) {
+  char *fim;
+  for (int i = 0; i < n; i++) {
+    v[i] = strtof(texto, &fim);
+    if (fim == texto) return false;
+    if (i < n - 1) {
+      if (*fim != ',') return false;
+      texto = fim + 1;
+    }
+  }
+  return *fim == 0;
+}
+
+static void uso(const char *programa) {
+  fprintf(stderr,
+    "uso: %s [-p perfil] [-g kc,ki,kd] [-m ganho,tau,ambiente] [-M lambda,passo_s]\n"
+    "       [-E tau_termopar] [-I passo_s] [-P ganho,tau_r,tau_c,tau_t,ambiente] [-t Ts_ms] [-l liquidus]\n"
+    "       [-r Hz] [-c] [-q]\n"
+    "  -p  índice no CATALOGO_PERFIS (padrão 2, SAC305)\n"
+    "  -g  ganhos discretos do PID, por amostra de Ts\n"
+    "  -m  alimentação direta (ModeloTermico_PI2), ganho 0 desliga (padrão)\n"
+    "  -M  controle preditivo sobre o modelo de -m no lugar do PID\n"
+    "  -E  estimador da câmara sobre o modelo de -m, com o atraso do termopar em s\n"
+    "  -I  identifica o modelo pela corrida (POST /ident), amostrado a cada passo_s\n"
+    "  -P  planta: C/%%, s, s, s, C\n"
+    "  -c  CSV a cada Ts na saída: t_s,set_point,rk,camara,potencia\n"
+    "  -q  resumo em uma linha chave=valor, para varreduras\n",
+    programa);
+}
+
+static bool lerParametros(int argc, char **argv, Parametros &p, bool &linha) {
+  parametrosPadrao(p);
+  linha = false;
+
+  int opcao;
+  float v[5];
+  while ((opcao = getopt(argc, argv, "p:g:m:M:E:I:P:t:l:r:cq")) != -1) {
+    switch (opcao) {
+      case 'p': p.perfil = atoi(optarg); break;
+      case 'g':
+        if (!lerLista(optarg, v, 3)) return false;
+        p.kc = v[0]; p.ki = v[1]; p.kd = v[2];
+        break;
+      case 'm':
+        if (!lerLista(optarg, v, 3)) return false;
+        p.ffGanho = v[0]; p.ffTau = v[1]; p.ffAmbiente = v[2];
+        break;
+      case 'M':
+        if (!lerLista(optarg, v, 2)) return false;
+        p.mpcLambda = v[0]; p.mpcPasso = v[1];
+        break;
+      case 'E': p.estTermopar = atof(optarg); break;
+      case 'I': p.identPasso = atof(optarg); break;
+      case 'P':
+        if (!lerLista(optarg, v, 5)) return false;
+        p.ganho = v[0]; p.tauR = v[1]; p.tauC = v[2]; p.tauT = v[3]; p.ambiente = v[4];
+        break;
+      case 't': p.ts = atoi(optarg); break;
+      case 'l': p.liquidus = atof(optarg); break;
+      case 'r': p.rede = atof(optarg); break;
+      case 'c': p.csv = true; break;
+      case 'q': linha = true; break;
+      default: return false;
+    }
+  }
+  return optind == argc && p.ts > 0 && p.rede > 0;
+}
+
+int main(int argc, char **argv) {
+  Parametros p;
+  bool linha;
+  if (!lerParametros(argc, argv, p, linha)) {
+    uso(argv[0]);
+    return 2;
+  }
+  if (p.perfil >= QUANTIDADE_PERFIS) {
+    fprintf(stderr, "perfil %u inexistente (%u no catálogo)\n", p.perfil, QUANTIDADE_PERFIS);
+    return 2;
+  }
+
+  clock_t inicio = clock();
+  Resultado r;
+  bool terminou = simular(p, r);
+  double gasto_ms = (clock() - inicio) * 1000.0 / CLOCKS_PER_SEC;
+
+  const char *nome = CATALOGO_PERFIS[p.perfil].nome;
+  FILE *saida = p.csv ? stderr : stdout;
+  if (linha) {
+    fprintf(saida, "perfil=%s duracao_s=%.1f pico_C=%.2f sobressinal_C=%.2f erro_rms_C=%.3f "
+            "erro_max_C=%.2f tal_s=%.1f desarme=%s falhas=0x%04x\n",
+            nome, r.duracao, r.pico, r.sobressinal, r.erroRms, r.erroMax, r.tal, nomeDesarme(r.desarme), r.falhas);
+  }
+  else {
+    fprintf(saida, "perfil           %s\n", nome);
+    fprintf(saida, "duracao_s        %.1f%s\n", r.duracao, terminou ? "" : " (perfil incompleto)");
+    fprintf(saida, "pico_C           %.2f\n", r.pico);
+    fprintf(saida, "sobressinal_C    %.2f (acima de %.1f, maior set point)\n", r.sobressinal, r.alvo);
+    fprintf(saida, "erro_rms_C       %.3f (câmara, fora do resfriamento)\n", r.erroRms);
+    fprintf(saida, "erro_max_C       %.2f\n", r.erroMax);
+    fprintf(saida, "tal_s            %.1f (acima de %.1f C)\n", r.tal, r.liquidus);
+    fprintf(saida, "desarme          %s\n", nomeDesarme(r.desarme));
+    fprintf(saida, "falhas           0x%04x (bits ANALISE_* da leitura, 0 = aprovada)\n", r.falhas);
+    if (p.identPasso > 0 && r.identificado) {
+      fprintf(saida, "identificado     ganho %.3f C/%%, tau %.1f s, tau_rapido %.1f s, atraso %.1f s, "
+              "ambiente %.1f C (erro %.3f C)\n",
+              r.idGanho, r.idTau, r.idTauRapido, r.idAtraso, r.idAmbiente, r.idErro);
+      fprintf(saida, "planta           ganho %.3f C/%%, tau_c %.1f s, tau_r %.1f s, tau_t %.1f s, ambiente %.1f C\n",
+              p.ganho, p.tauC, p.tauR, p.tauT, p.ambiente);
+      fprintf(saida, "para /config     -m %.3f,%.1f,%.1f -E %.1f (ff_k, ff_tau, ff_amb, est_tau)\n",
+              r.idGanho, r.idTauModelo, r.idAmbiente, r.idAtrasoLeitura);
+    }
+    else if (p.identPasso > 0) {
+      fprintf(saida, "identificado     nada (corrida curta ou modelo inválido)\n");
+    }
+    fprintf(saida, "simulado em      %.1f ms\n", gasto_ms);
+  }
+  return terminou ? 0 : 1;
+}
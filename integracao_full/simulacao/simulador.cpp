@@ -0,0 +1,202 @@
+/*  Uma corrida do forno simulada no PC
+ *  O mesmo código do firmware (perfil_PI2, controle_PI2 com
+ *  controleRampa() ou ControlePreditivo_PI2, EstimadorTermico_PI2,
+ *  FiltroTemperatura_PI2, CanaisRajada_PI2 e o Supervisor_PI2) contra o modelo térmico de planta.h, semiciclo a
+ *  semiciclo da rede.
+ *
+ *  simulador.cpp
+ */
+
+#include <Arduino.h>
+#include <controle_PI2.h>
+#include <perfil_PI2.h>
+#include <sensor_PI2.h>
+#include <atuador_PI2.h>
+#include "../corrida.h"
+#include "planta.h"
+#include "simulador.h"
+
+thread_local uint32_t hostMillis = 0;
+thread_local uint8_t hostPinos[32];
+
+#define PINO_TRIAC      12
+#define LEITURA_US      (MAX6675_CONVERSAO_MS * 1000UL)
+#define RESOLUCAO_C     0.25     // MAX6675
+#define FOLGA_FIM_S     600      // limite além da duração do perfil
+
+static const char *NOMES_DESARME[] = {
+  "nenhum", "sensor_falha", "sensor_parado", "temperatura", "subida", "sem_resposta", "controle"
+};
+
+const char *nomeDesarme(uint8_t motivo) {
+  return motivo < sizeof(NOMES_DESARME) / sizeof(NOMES_DESARME[0]) ? NOMES_DESARME[motivo] : "?";
+}
+
+void parametrosPadrao(Parametros &p) {
+  p.perfil = 2;
+  p.kc = 5.207;
+  p.ki = 0.006;
+  p.kd = 55.44;
+  p.ffGanho = 0;
+  p.ffTau = 0;
+  p.ffAmbiente = 25;
+  p.mpcLambda = -1;
+  p.mpcPasso = 2;
+  p.estTermopar = 0;
+  p.identPasso = 0;
+  p.ganho = 4.5;
+  p.tauR = 25;
+  p.tauC = 180;
+  p.tauT = 2;
+  p.ambiente = 25;
+  p.ts = 100;
+  p.liquidus = 0;
+  p.rede = 60;
+  p.csv = false;
+}
+
+// Uma corrida inteira, como controle_pid() e corridaPasso() no sketch;
+// sem pausa nem abortar, e termina com o perfil (o resfriamento até
+// CORRIDA_FRIA depois dele não muda nenhuma das medidas)
+bool simular(const Parametros &p, Resultado &r) {
+  memset(&r, 0, sizeof(r));
+  // antes de qualquer objeto: a rampa e o supervisor guardam millis() ao
+  // iniciar, e a corrida anterior na thread deixou o relógio no fim dela
+  hostMillis = 0;
+  memset(hostPinos, 0, sizeof(hostPinos));
+  PerfilReflow_PI2 perfil;
+  if (p.ts <= 0 || p.rede <= 0 || !perfil.selecionar(p.perfil)) return false;
+
+  PlantaForno planta(p.ganho, p.tauR, p.tauC, p.tauT, p.ambiente);
+  FiltroTemperatura_PI2 filtro(3, 1);
+  PidController pid(p.kc, p.ki, p.kd, 0, 100);
+  ModeloTermico_PI2 modelo;
+  ControlePreditivo_PI2 preditivo;
+  EstimadorTermico_PI2 estimador;
+  IdentificacaoTermica_PI2 identificacao;   // o que POST /ident faz na corrida
+  Supervisor_PI2 supervisor;
+  AnaliseCorrida_PI2 analise;               // o que o forno responde em /run/summary
+  const uint8_t pinos[1] = { PINO_TRIAC };
+  CanaisRajada_PI2 disparo(pinos, 1);
+
+  modelo.configurar(p.ffGanho, p.ffTau, p.ffAmbiente);
+  if (p.mpcLambda >= 0) preditivo.configurar(modelo, p.mpcPasso, p.ts / 1000.0, p.mpcLambda);
+  if (p.estTermopar > 0) estimador.configurar(modelo, p.ts / 1000.0, p.estTermopar);
+  if (p.identPasso > 0) identificacao.iniciar(p.ts / 1000.0, p.identPasso);
+  disparo.iniciar();
+  perfil.iniciar();
+  analise.iniciar(perfil.janela());
+
+  r.liquidus = (p.liquidus > 0) ? p.liquidus : perfil.janela().liquidus_dC / 10.0;
+  r.pico = p.ambiente;
+  for (uint8_t s = 0; s < perfil.quantidade(); s++) {
+    float t = perfil.segmentos()[s].temperatura_dC / 10.0;
+    if (t > r.alvo) r.alvo = t;
+  }
+
+  uint32_t semiciclo_us = lroundf(1e6 / (2 * p.rede));
+  float semiciclo_s = semiciclo_us / 1e6;
+  uint64_t limite_us = (uint64_t)(perfil.duracaoMs() / 1000 + FOLGA_FIM_S) * 1000000ULL;
+  uint64_t agora_us = 0, leitura_us = 0, controle_us = 0;
+  float rk = NAN, setPoint = perfil.inicial_dC() / 10.0, uk = 0;
+  uint32_t instanteRk = 0, instanteEstimado = 0;
+  EstadoCorrida corrida = CORRIDA_PREAQUECENDO;
+  float somaQuadrados = 0;
+  uint32_t amostras = 0;
+
+  if (p.csv) printf("t_s,set_point,rk,camara,potencia\n");
+
+  while (agora_us < limite_us) {
+    disparo.cruzamentoZero();
+    planta.passo(hostPinos[PINO_TRIAC] ? 100 : 0, semiciclo_s);
+    agora_us += semiciclo_us;
+    hostMillis = agora_us / 1000;
+
+    float camara = planta.camara();
+    if (camara > r.pico) r.pico = camara;
+    if (camara >= r.liquidus) r.tal += semiciclo_s;
+
+    if (agora_us >= leitura_us) {
+      leitura_us += LEITURA_US;
+      filtro.adicionar(roundf(planta.termopar() / RESOLUCAO_C) * RESOLUCAO_C);
+      if (filtro.valido()) {
+        rk = filtro.celsius();
+        instanteRk = hostMillis;
+      }
+    }
+
+    if (agora_us < controle_us) continue;
+    controle_us += p.ts * 1000UL;
+    analise.adicionar(hostMillis, rk);
+
+    identificacao.adicionar(disparo.potencia(0), rk);   // a do Ts que acabou
+    r.desarme = supervisor.verificar(rk, instanteRk, uk, hostMillis);
+    if (r.desarme != DESARME_NENHUM) {
+      disparo.bloquear();
+      break;
+    }
+
+    if (corrida == CORRIDA_PREAQUECENDO) {
+      if (rk >= setPoint - CORRIDA_TOLERANCIA) corrida = CORRIDA_RODANDO;
+    }
+    else {
+      setPoint = perfil.atualizar(p.ts, rk);
+      if (perfil.terminado()) {
+        r.terminou = true;
+        break;
+      }
+      if (perfil.fase() != FASE_RESFRIAMENTO) {   // sem porta, o forno não acompanha a descida
+        float erro = fabsf(setPoint - camara);
+        somaQuadrados += erro * erro;
+        amostras++;
+        if (erro > r.erroMax) r.erroMax = erro;
+      }
+    }
+
+    float medida = rk;
+    if (estimador.ativo() && !isnan(rk)) {
+      medida = estimador.atualizar(uk, rk, instanteRk != instanteEstimado);
+      instanteEstimado = instanteRk;
+    }
+
+    if (isnan(rk)) {
+      uk = 0;
+    }
+    else if (preditivo.ativo()) {
+      float referencias[PREDITIVO_HORIZONTE];
+      for (uint8_t i = 0; i < PREDITIVO_HORIZONTE; i++) {
+        referencias[i] = (corrida == CORRIDA_RODANDO) ? perfil.previsao((i + 1) * p.mpcPasso * 1000) : setPoint;
+      }
+      uk = preditivo.atualizar(referencias, medida);
+    }
+    else {
+      float inclinacao = (corrida == CORRIDA_RODANDO) ? perfil.inclinacao() : 0;
+      uk = controleRampa(pid, modelo, setPoint, inclinacao, medida);
+    }
+    disparo.definirPotencia(0, (int)uk);
+
+    if (p.csv) {
+      printf("%.1f,%.1f,%.2f,%.2f,%.1f\n", agora_us / 1e6, setPoint, rk, camara, uk);
+    }
+  }
+  // sem o resfriamento até CORRIDA_FRIA a descida medida é só a do perfil
+  analise.finalizar(r.terminou);
+  ResumoCorrida resumo;
+  analise.ler(resumo);
+  r.falhas = resumo.falhas;
+  if (p.identPasso > 0) {
+    r.identificado = identificacao.concluir();
+    r.idGanho = identificacao.ganho();
+    r.idTau = identificacao.tau();
+    r.idTauRapido = identificacao.tauRapido();
+    r.idAtraso = identificacao.atraso();
+    r.idAmbiente = identificacao.ambiente();
+    r.idErro = identificacao.erro();
+    r.idTauModelo = identificacao.tauModelo();
+    r.idAtrasoLeitura = identificacao.atrasoLeitura();
+  }
+  r.duracao = agora_us / 1e6;
+  r.sobressinal = r.pico - r.alvo;
+  r.erroRms = amostras ? sqrtf(somaQuadrados / amostras) : 0;
+  return r.terminou;
+}
@@ -0,0 +1,48 @@
+/*  Uma corrida do forno simulada no PC (simulador.cpp)
+ *  Usado pela simulação de uma corrida (simulacao.cpp) e pela varredura
+ *  de ganhos (varredura.cpp). Sem estado global além do relógio e dos
+ *  pinos do host/, que são por thread: várias corridas podem rodar ao
+ *  mesmo tempo.
+ *
+ *  simulador.h
+ */
+
+#ifndef SimuladorForno_h
+#define SimuladorForno_h
+
+#include <stdint.h>
+
+struct Parametros {
+  uint8_t perfil;                              // índice no CATALOGO_PERFIS
+  float kc, ki, kd;                            // por amostra de Ts, como no sketch
+  float ffGanho, ffTau, ffAmbiente;            // ModeloTermico_PI2; ganho 0 desliga
+  float mpcLambda, mpcPasso;                   // ControlePreditivo_PI2 no lugar do PID; lambda < 0 desliga
+  float estTermopar;                           // s, EstimadorTermico_PI2 antes do controle; 0 desliga
+  float identPasso;                            // s, IdentificacaoTermica_PI2 na corrida; 0 desliga
+  float ganho, tauR, tauC, tauT, ambiente;     // PlantaForno
+  int ts;                                      // ms
+  float liquidus;                              // C; 0 = o da janela do perfil
+  float rede;                                  // Hz
+  bool csv;                                    // uma linha por Ts na saída padrão
+};
+
+struct Resultado {
+  float pico, alvo;          // maior temperatura da câmara e maior set point
+  float sobressinal;         // pico - alvo
+  float erroRms, erroMax;    // câmara contra set point, fora do resfriamento
+  float tal;                 // s acima do liquidus
+  float liquidus;            // o usado em tal
+  float duracao;             // s de corrida (preaquecimento incluído)
+  uint8_t desarme;           // MotivoDesarme
+  bool terminou;             // o perfil chegou ao fim
+  uint16_t falhas;           // veredito da AnaliseCorrida_PI2 sobre a leitura, bits ANALISE_*
+  bool identificado;         // com identPasso: o modelo abaixo é válido
+  float idGanho, idTau, idTauRapido, idAtraso, idAmbiente, idErro;
+  float idTauModelo, idAtrasoLeitura;    // o que POST /ident grava em ff_tau e est_tau
+};
+
+void parametrosPadrao(Parametros &p);     // os ganhos de integracao_full.ino e a planta padrão
+bool simular(const Parametros &p, Resultado &r);   // false: perfil inexistente, desarme ou tempo esgotado
+const char *nomeDesarme(uint8_t motivo);
+
+#endif
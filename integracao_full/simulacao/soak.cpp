@@ -0,0 +1,231 @@
+/*  Ensaio de longa duração (soak) sobre o forno simulado
+ *  Roda N corridas seguidas (padrão 1000) com o código do firmware
+ *  (simulador.cpp), os perfis do catálogo em rodízio, e acusa o que
+ *  numa placa vira defeito depois de dias ligada:
+ *    heap    - bytes em uso no malloc do processo, depois de cada corrida,
+ *              contra os da primeira: vazamento nas bibliotecas
+ *    deriva  - cada corrida de um perfil tem de repetir a primeira dele
+ *              bit a bit; diferença é estado que sobra de uma corrida
+ *              para a outra (estáticos, acumuladores)
+ *    tempo   - CPU por passo de controle do último décimo das corridas
+ *              contra o primeiro: custo que cresce com o uso
+ *  Com -b, compara também com uma base gravada antes (ns por passo e o
+ *  resultado de cada perfil): regressão de desempenho ou de controle
+ *  entre dois builds, na mesma máquina. Sem a base, ela é gravada.
+ *  O ensaio com a placa de verdade fica em soak.py.
+ *
+ *  soak.cpp
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <getopt.h>
+#include <malloc.h>
+#include <time.h>
+#include <algorithm>
+#include <vector>
+#include <perfil_PI2.h>
+#include "simulador.h"
+
+struct Opcoes {
+  long corridas;
+  int perfil;                // -1 = rodízio por todos
+  float tolerancia;          // % de aumento aceito no tempo por passo
+  long heap;                 // bytes a mais aceitos no fim
+  const char *base;
+  bool silencioso;
+};
+
+static size_t heapEmUso() {
+  struct mallinfo2 m = mallinfo2();
+  return m.uordblks + m.hblkhd;
+}
+
+static double agoraNs() {
+  struct timespec t;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static bool iguais(const Resultado &a, const Resultado &b) {
+  return a.pico == b.pico && a.erroRms == b.erroRms && a.erroMax == b.erroMax && a.tal == b.tal
+         && a.duracao == b.duracao && a.desarme == b.desarme && a.terminou == b.terminou
+         && a.falhas == b.falhas;
+}
+
+static double mediana(std::vector<double> v) {
+  if (v.empty()) return 0;
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+static void uso(const char *programa) {
+  fprintf(stderr,
+    "uso: %s [-n corridas] [-p perfil] [-x tolerancia_pct] [-H bytes] [-b base] [-q]\n"
+    "  -n  corridas seguidas (padrão 1000)\n"
+    "  -p  só este perfil do catálogo (padrão: todos em rodízio)\n"
+    "  -x  aumento aceito no tempo por passo, em %% (padrão 15)\n"
+    "  -H  bytes de heap a mais aceitos no fim (padrão 0)\n"
+    "  -b  arquivo da base: grava se não existe, compara se existe\n"
+    "  -q  sem o progresso em stderr\n",
+    programa);
+}
+
+static bool lerOpcoes(int argc, char **argv, Opcoes &o) {
+  o.corridas = 1000;
+  o.perfil = -1;
+  o.tolerancia = 15;
+  o.heap = 0;
+  o.base = NULL;
+  o.silencioso = false;
+
+  int opcao;
+  while ((opcao = getopt(argc, argv, "n:p:x:H:b:q")) != -1) {
+    switch (opcao) {
+      case 'n': o.corridas = atol(optarg); break;
+      case 'p': o.perfil = atoi(optarg); break;
+      case 'x': o.tolerancia = atof(optarg); break;
+      case 'H': o.heap = atol(optarg); break;
+      case 'b': o.base = optarg; break;
+      case 'q': o.silencioso = true; break;
+      default: return false;
+    }
+  }
+  return optind == argc && o.corridas >= 10 && o.perfil < (int)QUANTIDADE_PERFIS;
+}
+
+// Base: "ns_por_passo V" e uma linha "perfil I erro_rms sobressinal tal duracao" por perfil
+static bool gravarBase(const char *arquivo, double ns, const Resultado *primeiro, const bool *visto) {
+  FILE *f = fopen(arquivo, "w");
+  if (!f) return false;
+  fprintf(f, "ns_por_passo %.1f\n", ns);
+  for (uint8_t i = 0; i < QUANTIDADE_PERFIS; i++) {
+    if (!visto[i]) continue;
+    fprintf(f, "perfil %u %.4f %.4f %.2f %.1f\n", i, primeiro[i].erroRms, primeiro[i].sobressinal,
+            primeiro[i].tal, primeiro[i].duracao);
+  }
+  return fclose(f) == 0;
+}
+
+// false se a base acusa regressão; imprime o que mudou
+static bool compararBase(FILE *f, const Opcoes &o, double ns, const Resultado *primeiro, const bool *visto) {
+  bool ok = true;
+  char linha[128];
+  while (fgets(linha, sizeof(linha), f)) {
+    double antes;
+    unsigned i;
+    float rms, sobre, tal, duracao;
+    if (sscanf(linha, "ns_por_passo %lf", &antes) == 1) {
+      double aumento = antes > 0 ? (ns / antes - 1) * 100 : 0;
+      bool pior = aumento > o.tolerancia;
+      printf("base_ns_passo    %.1f -> %.1f (%+.1f %%)%s\n", antes, ns, aumento, pior ? " REGRESSAO" : "");
+      ok = ok && !pior;
+    }
+    else if (sscanf(linha, "perfil %u %f %f %f %f", &i, &rms, &sobre, &tal, &duracao) == 5
+             && i < QUANTIDADE_PERFIS && visto[i]) {
+      const Resultado &r = primeiro[i];
+      if (fabsf(r.erroRms - rms) > 1e-3f || fabsf(r.sobressinal - sobre) > 1e-3f
+          || fabsf(r.tal - tal) > 0.05f || fabsf(r.duracao - duracao) > 0.05f) {
+        printf("base_perfil_%u    erro_rms %.4f -> %.4f, sobressinal %.4f -> %.4f, tal %.2f -> %.2f MUDOU\n",
+               i, rms, r.erroRms, sobre, r.sobressinal, tal, r.tal);
+        ok = false;
+      }
+    }
+  }
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  Opcoes o;
+  if (!lerOpcoes(argc, argv, o)) {
+    uso(argv[0]);
+    return 2;
+  }
+
+  Parametros p;
+  parametrosPadrao(p);
+  Resultado primeiro[QUANTIDADE_PERFIS];
+  bool visto[QUANTIDADE_PERFIS] = { false };
+  std::vector<double> nsPorPasso;   // um por corrida
+  nsPorPasso.reserve(o.corridas);
+  long divergencias = 0, incompletas = 0;
+  size_t heapInicial = 0, heapFinal = 0, heapMaior = 0;
+
+  for (long n = 0; n < o.corridas; n++) {
+    p.perfil = (o.perfil >= 0) ? o.perfil : n % QUANTIDADE_PERFIS;
+    Resultado r;
+    double inicio = agoraNs();
+    bool terminou = simular(p, r);
+    double gasto = agoraNs() - inicio;
+    if (!terminou) incompletas++;
+
+    double passos = r.duracao * 1000.0 / p.ts;
+    nsPorPasso.push_back(passos > 0 ? gasto / passos : 0);
+
+    if (!visto[p.perfil]) {
+      primeiro[p.perfil] = r;
+      visto[p.perfil] = true;
+    }
+    else if (!iguais(r, primeiro[p.perfil])) {
+      if (divergencias == 0) {
+        fprintf(stderr, "corrida %ld (%s) diferente da primeira: duracao %.1f -> %.1f s, erro_rms %.4f -> %.4f\n",
+                n, CATALOGO_PERFIS[p.perfil].nome, primeiro[p.perfil].duracao, r.duracao,
+                primeiro[p.perfil].erroRms, r.erroRms);
+      }
+      divergencias++;
+    }
+
+    // a primeira volta pelo catálogo paga as alocações preguiçosas (stdio)
+    size_t heap = heapEmUso();
+    if (n < (long)QUANTIDADE_PERFIS) heapInicial = heap;
+    if (heap > heapMaior) heapMaior = heap;
+    heapFinal = heap;
+
+    if (!o.silencioso && (n + 1) % 100 == 0) {
+      fprintf(stderr, "%ld/%ld corridas, heap %zu B\n", n + 1, o.corridas, heap);
+    }
+  }
+
+  // medianas: uma corrida que perdeu a CPU para outro processo não pesa
+  long decil = o.corridas / 10;
+  std::vector<double> antes(nsPorPasso.begin(), nsPorPasso.begin() + decil);
+  std::vector<double> depois(nsPorPasso.end() - decil, nsPorPasso.end());
+  double nsAntes = mediana(antes), nsDepois = mediana(depois), ns = mediana(nsPorPasso);
+  double aumento = nsAntes > 0 ? (nsDepois / nsAntes - 1) * 100 : 0;
+  long sobra = (long)heapFinal - (long)heapInicial;
+
+  bool okHeap = sobra <= o.heap;
+  bool okTempo = aumento <= o.tolerancia;
+  bool okDeriva = divergencias == 0;
+  bool okBase = true;
+
+  printf("corridas         %ld (%s), %ld sem terminar o perfil\n", o.corridas,
+         o.perfil >= 0 ? CATALOGO_PERFIS[o.perfil].nome : "catálogo em rodízio", incompletas);
+  printf("heap_B           depois da 1a volta %zu, final %zu, maior %zu (%+ld)%s\n",
+         heapInicial, heapFinal, heapMaior, sobra, okHeap ? "" : " VAZAMENTO");
+  printf("ns_por_passo     %.1f; primeiro decil %.1f, ultimo %.1f (%+.1f %%)%s\n",
+         ns, nsAntes, nsDepois, aumento, okTempo ? "" : " CRESCENDO");
+  printf("deriva           %ld corridas diferentes da primeira do mesmo perfil%s\n",
+         divergencias, okDeriva ? "" : " ESTADO ENTRE CORRIDAS");
+
+  if (o.base) {
+    FILE *f = fopen(o.base, "r");
+    if (f) {
+      okBase = compararBase(f, o, ns, primeiro, visto);
+      fclose(f);
+    }
+    else if (gravarBase(o.base, ns, primeiro, visto)) {
+      printf("base             gravada em %s\n", o.base);
+    }
+    else {
+      fprintf(stderr, "não consegui gravar %s\n", o.base);
+      return 2;
+    }
+  }
+
+  bool ok = okHeap && okTempo && okDeriva && okBase;
+  printf("veredito         %s\n", ok ? "ok" : "REPROVADO");
+  return ok ? 0 : 1;
+}
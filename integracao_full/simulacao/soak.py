@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""Ensaio de longa duração (soak) com a placa de verdade.
+
+Roda corridas seguidas no forno pela API HTTP (POST /start, GET /run) e,
+a cada --intervalo segundos, grava o /metrics num CSV: heap livre, menor
+heap, maior bloco, p99 e maior volta do loop, jitter do controle, maior
+atraso dos tickers e, com MODO_LATENCIA, o maior atraso do cruzamento por
+zero (/latency). No fim ajusta uma reta de cada série contra o uptime e
+acusa o que cresce (ou, no heap, o que cai) além do tolerado, além de
+reboot (uptime voltou) e corrida que terminou em falha.
+
+Sem forno de verdade, a placa fica na bancada com o emulador de
+soak_emulador/ no lugar do MAX6675 e do detector de zero: a planta dele é
+acelerada, e uma corrida leva minutos. O CSV do emulador (--emulador)
+entra no mesmo arquivo de saída, com o atraso zero -> gatilho medido por
+fora da placa.
+
+Uso: python3 soak.py --forno http://forno.local --corridas 200 --perfis 0,2
+     python3 soak.py --forno http://192.168.0.50 --emulador /dev/ttyUSB0
+     (a porta do emulador em 115200: stty -F /dev/ttyUSB0 115200 raw)
+Sai com 1 se algo foi acusado, 2 se o forno não responde.
+"""
+
+import argparse
+import csv
+import json
+import re
+import sys
+import threading
+import time
+import urllib.error
+import urllib.request
+
+# série do CSV -> (métrica, rótulo); None no rótulo = o maior entre todos
+METRICAS = {
+    "heap_livre": ("forno_heap_livre_bytes", ""),
+    "heap_minimo": ("forno_heap_minimo_bytes", ""),
+    "heap_maior_bloco": ("forno_heap_maior_bloco_bytes", ""),
+    "loop_p99_us": ("forno_loop_quantil_us", 'quantil="0.99"'),
+    "loop_maior_us": ("forno_loop_maior_us", ""),
+    "controle_jitter_us": ("forno_controle_periodo_us", 'medida="jitter"'),
+    "ticker_atraso_us": ("forno_ticker_atraso_max_us", None),
+}
+
+# as que não podem cair (bytes/h) e as que não podem subir (% do início ao fim)
+CAEM = ["heap_livre", "heap_minimo", "heap_maior_bloco"]
+SOBEM = ["loop_p99_us", "controle_jitter_us", "ticker_atraso_us", "zero_gatilho_us", "emul_atraso_us"]
+
+FIM = ("ociosa", "abortada", "falha")
+LINHA = re.compile(r'^(\w+)(?:\{([^}]*)\})?\s+(\S+)$')
+
+
+def pedir(base, caminho, metodo="GET", tempo=10):
+    req = urllib.request.Request(base + caminho, method=metodo)
+    try:
+        with urllib.request.urlopen(req, timeout=tempo) as r:
+            return r.status, r.read().decode("utf-8", "replace")
+    except urllib.error.HTTPError as e:
+        return e.code, e.read().decode("utf-8", "replace")
+
+
+def ler_metricas(base, latencia):
+    _, texto = pedir(base, "/metrics")
+    valores = {}
+    for linha in texto.splitlines():
+        m = LINHA.match(linha)
+        if not m:
+            continue
+        valores.setdefault(m.group(1), []).append((m.group(2) or "", float(m.group(3))))
+    amostra = {"uptime_s": valores.get("forno_uptime_segundos", [("", 0)])[0][1]}
+    for serie, (nome, rotulo) in METRICAS.items():
+        lidos = valores.get(nome, [])
+        if rotulo is None:
+            amostra[serie] = max((v for _, v in lidos), default="")
+        else:
+            amostra[serie] = next((v for r, v in lidos if r == rotulo), "")
+    if latencia:
+        codigo, texto = pedir(base, "/latency?zerar=1")
+        amostra["zero_gatilho_us"] = json.loads(texto)["gatilho"]["max_us"] if codigo == 200 else ""
+    return amostra
+
+
+class Emulador(threading.Thread):
+    """Última linha CSV do soak_emulador: t_s,camara,potencia,atraso_us,atrasados"""
+
+    def __init__(self, porta):
+        super().__init__(daemon=True)
+        self.porta = porta
+        self.ultimo = {}
+
+    def run(self):
+        with open(self.porta, "r", errors="replace") as f:
+            for linha in f:
+                campos = linha.strip().split(",")
+                if len(campos) == 5 and campos[0].replace(".", "").isdigit():
+                    self.ultimo = {"emul_camara": campos[1], "emul_atraso_us": campos[3],
+                                   "emul_atrasados": campos[4]}
+
+
+def reta(xs, ys):
+    """Inclinação por mínimos quadrados; 0 com menos de 3 pontos."""
+    pares = [(x, y) for x, y in zip(xs, ys) if y != ""]
+    if len(pares) < 3:
+        return 0.0
+    n = len(pares)
+    mx = sum(x for x, _ in pares) / n
+    my = sum(y for _, y in pares) / n
+    sxx = sum((x - mx) ** 2 for x, _ in pares)
+    return sum((x - mx) * (y - my) for x, y in pares) / sxx if sxx else 0.0
+
+
+def avaliar(amostras, args):
+    """Lista do que foi acusado nas séries gravadas."""
+    acusado = []
+    horas = [a["uptime_s"] / 3600 for a in amostras]
+    for i in range(1, len(horas)):
+        if horas[i] < horas[i - 1]:
+            acusado.append("reboot entre as amostras %d e %d" % (i - 1, i))
+    if len(amostras) < 8:
+        return acusado + ["poucas amostras para tendência (%d)" % len(amostras)]
+
+    for serie in CAEM:
+        queda = -reta(horas, [a.get(serie, "") for a in amostras])
+        print("%-20s %+9.0f B/h" % (serie, -queda))
+        if queda > args.heap_por_hora:
+            acusado.append("%s caindo %.0f B/h" % (serie, queda))
+
+    quarto = len(amostras) // 4
+    for serie in SOBEM:
+        inicio = [float(a[serie]) for a in amostras[:quarto] if a.get(serie, "") != ""]
+        fim = [float(a[serie]) for a in amostras[-quarto:] if a.get(serie, "") != ""]
+        if not inicio or not fim:
+            continue
+        antes, depois = sorted(inicio)[len(inicio) // 2], sorted(fim)[len(fim) // 2]
+        aumento = (depois / antes - 1) * 100 if antes else 0
+        print("%-20s %9.0f -> %.0f (%+.1f %%)" % (serie, antes, depois, aumento))
+        if aumento > args.tolerancia:
+            acusado.append("%s subiu %.1f %%" % (serie, aumento))
+    return acusado
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--forno", required=True, help="URL base do forno")
+    ap.add_argument("--corridas", type=int, default=100)
+    ap.add_argument("--perfis", default="", help="índices do catálogo em rodízio (padrão: o ativo)")
+    ap.add_argument("--intervalo", type=float, default=5, help="s entre amostras do /metrics")
+    ap.add_argument("--limite", type=float, default=3600, help="s máximos por corrida")
+    ap.add_argument("--csv", default="soak.csv")
+    ap.add_argument("--latencia", action="store_true", help="lê o /latency (MODO_LATENCIA)")
+    ap.add_argument("--emulador", help="porta serial do soak_emulador")
+    ap.add_argument("--heap-por-hora", type=float, default=256, help="queda de heap tolerada, B/h")
+    ap.add_argument("--tolerancia", type=float, default=25, help="aumento tolerado das latências, %%")
+    args = ap.parse_args()
+    base = args.forno.rstrip("/")
+    perfis = [int(p) for p in args.perfis.split(",") if p != ""]
+
+    try:
+        pedir(base, "/run")
+    except OSError as e:
+        print("forno não responde: %s" % e, file=sys.stderr)
+        return 2
+
+    emulador = None
+    if args.emulador:
+        emulador = Emulador(args.emulador)
+        emulador.start()
+
+    campos = ["corrida", "estado", "uptime_s"] + list(METRICAS)
+    campos += ["zero_gatilho_us"] if args.latencia else []
+    campos += ["emul_camara", "emul_atraso_us", "emul_atrasados"] if emulador else []
+    amostras = []
+    falhas = []
+    proxima = 0.0
+
+    with open(args.csv, "w", newline="") as saida:
+        escritor = csv.DictWriter(saida, fieldnames=campos, extrasaction="ignore")
+        escritor.writeheader()
+
+        def amostrar(corrida, estado):
+            a = ler_metricas(base, args.latencia)
+            a.update(corrida=corrida, estado=estado, **(emulador.ultimo if emulador else {}))
+            amostras.append(a)
+            escritor.writerow(a)
+            saida.flush()
+
+        for n in range(args.corridas):
+            if perfis:
+                pedir(base, "/perfil?id=%d" % perfis[n % len(perfis)])
+            codigo, texto = pedir(base, "/start", "POST")
+            if codigo != 200:
+                falhas.append("corrida %d não iniciou: %d %s" % (n, codigo, texto))
+                time.sleep(args.intervalo)
+                continue
+            inicio = time.monotonic()
+            estado = json.loads(texto)["estado"]
+            while time.monotonic() - inicio < args.limite:
+                time.sleep(0.5)
+                estado = json.loads(pedir(base, "/run")[1])["estado"]
+                if time.monotonic() >= proxima:
+                    proxima = time.monotonic() + args.intervalo
+                    amostrar(n, estado)
+                if estado in FIM:
+                    break
+            else:
+                pedir(base, "/abort", "POST")
+                falhas.append("corrida %d passou de %.0f s" % (n, args.limite))
+            if estado in ("abortada", "falha"):
+                falhas.append("corrida %d terminou %s" % (n, estado))
+            print("corrida %d/%d: %s em %.0f s" % (n + 1, args.corridas, estado,
+                                                   time.monotonic() - inicio), file=sys.stderr)
+
+    acusado = falhas + avaliar(amostras, args)
+    for a in acusado:
+        print("ACUSADO  " + a)
+    print("veredito %s (%d amostras em %s)" % ("ok" if not acusado else "REPROVADO",
+                                                len(amostras), args.csv))
+    return 1 if acusado else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,239 @@
+/*  Varredura de ganhos sobre o forno simulado
+ *  Avalia uma grade (ou uma amostra aleatória, -n) de kc, ki, kd, Ts e
+ *  da alimentação direta contra cada perfil do catálogo, uma corrida por
+ *  par candidato x perfil, em todas as CPUs. O custo de um candidato é a
+ *  média, entre os perfis, de erro_rms + peso * sobressinal (só a parte
+ *  positiva); desarme ou perfil que não termina descarta o candidato. Os
+ *  melhores saem ordenados pelo custo.
+ *
+ *  varredura.cpp
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <getopt.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+#include <perfil_PI2.h>
+#include "simulador.h"
+
+// min:max:pontos (min:max = os dois extremos), ou um valor só
+struct Faixa {
+  float minimo, maximo;
+  int pontos;
+
+  float valor(int i) const {
+    return (pontos <= 1) ? minimo : minimo + (maximo - minimo) * i / (pontos - 1);
+  }
+};
+
+enum { KC = 0, KI, KD, TS, FF_GANHO, FF_TAU, MPC_LAMBDA, DIMENSOES };
+static const char *NOMES[DIMENSOES] = { "kc", "ki", "kd", "ts_ms", "ff_ganho", "ff_tau", "mpc_lambda" };
+
+struct Candidato {
+  float v[DIMENSOES];
+  float custo;
+  float erroRms;             // média entre os perfis
+  float erroMax, sobressinal;   // pior entre os perfis
+  float tal;                 // menor entre os perfis
+  uint8_t desarme;           // primeiro motivo encontrado
+};
+
+struct Opcoes {
+  Faixa faixa[DIMENSOES];
+  Parametros base;           // planta, liquidus e rede
+  int perfil;                // -1 = todos
+  long aleatorios;           // 0 = grade
+  unsigned semente;
+  float peso;
+  int melhores;
+  unsigned threads;
+};
+
+static bool lerFaixa(const char *texto, Faixa &f) {
+  char *fim;
+  f.minimo = f.maximo = strtof(texto, &fim);
+  f.pontos = 1;
+  if (fim == texto) return false;
+  if (*fim == 0) return true;
+  if (*fim != ':') return false;
+  texto = fim + 1;
+  f.maximo = strtof(texto, &fim);
+  f.pontos = 2;
+  if (fim == texto) return false;
+  if (*fim == 0) return true;
+  if (*fim != ':') return false;
+  f.pontos = strtol(fim + 1, &fim, 10);
+  return *fim == 0 && f.pontos >= 1;
+}
+
+static void uso(const char *programa) {
+  fprintf(stderr,
+    "uso: %s [-k kc] [-i ki] [-d kd] [-t Ts_ms] [-f ff_ganho] [-a ff_tau] [-L mpc_lambda]\n"
+    "       [-E tau_termopar] [-n aleatorios] [-s semente] [-p perfil] [-P ganho,tau_r,tau_c,tau_t,ambiente]\n"
+    "       [-l liquidus] [-w peso] [-N melhores] [-j threads]\n"
+    "  cada parâmetro é um valor, min:max ou min:max:pontos; a grade é o produto\n"
+    "  de todos. Com -n, sorteia esse número de candidatos uniformes em min:max.\n"
+    "  ki e kd são por amostra de Ts, como no sketch: variar Ts muda o PID efetivo.\n"
+    "  -L  controle preditivo sobre o modelo de -f/-a no lugar do PID (padrão -1, desligado)\n"
+    "  -E  estimador da câmara sobre o modelo de -f/-a em todos os candidatos\n"
+    "  -p  só esse perfil do catálogo (padrão: todos)\n"
+    "  -w  peso do sobressinal no custo (padrão 2)\n",
+    programa);
+}
+
+static bool lerOpcoes(int argc, char **argv, Opcoes &o) {
+  parametrosPadrao(o.base);
+  float padrao[DIMENSOES] = { o.base.kc, o.base.ki, o.base.kd, (float)o.base.ts, o.base.ffGanho, o.base.ffTau,
+                              o.base.mpcLambda };
+  for (int d = 0; d < DIMENSOES; d++) o.faixa[d] = { padrao[d], padrao[d], 1 };
+  o.perfil = -1;
+  o.aleatorios = 0;
+  o.semente = 1;
+  o.peso = 2;
+  o.melhores = 10;
+  o.threads = std::thread::hardware_concurrency();
+  if (o.threads == 0) o.threads = 1;
+
+  int opcao;
+  char *fim;
+  while ((opcao = getopt(argc, argv, "k:i:d:t:f:a:L:E:n:s:p:P:l:w:N:j:")) != -1) {
+    switch (opcao) {
+      case 'k': if (!lerFaixa(optarg, o.faixa[KC])) return false; break;
+      case 'i': if (!lerFaixa(optarg, o.faixa[KI])) return false; break;
+      case 'd': if (!lerFaixa(optarg, o.faixa[KD])) return false; break;
+      case 't': if (!lerFaixa(optarg, o.faixa[TS])) return false; break;
+      case 'f': if (!lerFaixa(optarg, o.faixa[FF_GANHO])) return false; break;
+      case 'a': if (!lerFaixa(optarg, o.faixa[FF_TAU])) return false; break;
+      case 'L': if (!lerFaixa(optarg, o.faixa[MPC_LAMBDA])) return false; break;
+      case 'E': o.base.estTermopar = strtof(optarg, &fim); break;
+      case 'n': o.aleatorios = atol(optarg); break;
+      case 's': o.semente = strtoul(optarg, NULL, 10); break;
+      case 'p': o.perfil = atoi(optarg); break;
+      case 'P': {
+        Parametros &b = o.base;
+        if (sscanf(optarg, "%f,%f,%f,%f,%f", &b.ganho, &b.tauR, &b.tauC, &b.tauT, &b.ambiente) != 5) return false;
+        b.ffAmbiente = b.ambiente;
+        break;
+      }
+      case 'l': o.base.liquidus = strtof(optarg, &fim); break;
+      case 'w': o.peso = strtof(optarg, &fim); break;
+      case 'N': o.melhores = atoi(optarg); break;
+      case 'j': o.threads = atoi(optarg); break;
+      default: return false;
+    }
+  }
+  return optind == argc && o.threads > 0 && o.aleatorios >= 0
+         && o.perfil < (int)QUANTIDADE_PERFIS && o.faixa[TS].minimo >= 1;
+}
+
+static std::vector<Candidato> gerar(const Opcoes &o) {
+  std::vector<Candidato> lista;
+  if (o.aleatorios > 0) {
+    std::mt19937 gerador(o.semente);
+    lista.resize(o.aleatorios);
+    for (Candidato &c : lista) {
+      for (int d = 0; d < DIMENSOES; d++) {
+        const Faixa &f = o.faixa[d];
+        c.v[d] = std::uniform_real_distribution<float>(f.minimo, f.maximo)(gerador);
+      }
+    }
+  }
+  else {
+    size_t total = 1;
+    for (int d = 0; d < DIMENSOES; d++) total *= o.faixa[d].pontos;
+    lista.resize(total);
+    for (size_t n = 0; n < total; n++) {
+      size_t resto = n;
+      for (int d = 0; d < DIMENSOES; d++) {
+        lista[n].v[d] = o.faixa[d].valor(resto % o.faixa[d].pontos);
+        resto /= o.faixa[d].pontos;
+      }
+    }
+  }
+  return lista;
+}
+
+static void avaliar(const Opcoes &o, Candidato &c) {
+  Parametros p = o.base;
+  p.kc = c.v[KC];
+  p.ki = c.v[KI];
+  p.kd = c.v[KD];
+  p.ts = lroundf(c.v[TS]);
+  p.ffGanho = c.v[FF_GANHO];
+  p.ffTau = c.v[FF_TAU];
+  p.mpcLambda = c.v[MPC_LAMBDA];
+
+  uint8_t primeiro = (o.perfil < 0) ? 0 : o.perfil;
+  uint8_t ultimo = (o.perfil < 0) ? QUANTIDADE_PERFIS - 1 : o.perfil;
+  float soma = 0, somaRms = 0;
+  c.erroMax = c.sobressinal = -INFINITY;
+  c.tal = INFINITY;
+  c.desarme = 0;
+  bool valido = true;
+  for (uint8_t perfil = primeiro; perfil <= ultimo; perfil++) {
+    p.perfil = perfil;
+    Resultado r;
+    if (!simular(p, r)) {
+      valido = false;
+      if (!c.desarme) c.desarme = r.desarme;
+    }
+    soma += r.erroRms + o.peso * fmaxf(r.sobressinal, 0);
+    somaRms += r.erroRms;
+    c.erroMax = fmaxf(c.erroMax, r.erroMax);
+    c.sobressinal = fmaxf(c.sobressinal, r.sobressinal);
+    c.tal = fminf(c.tal, r.tal);
+  }
+  int n = ultimo - primeiro + 1;
+  c.erroRms = somaRms / n;
+  c.custo = valido ? soma / n : INFINITY;
+}
+
+int main(int argc, char **argv) {
+  Opcoes o;
+  if (!lerOpcoes(argc, argv, o)) {
+    uso(argv[0]);
+    return 2;
+  }
+
+  std::vector<Candidato> lista = gerar(o);
+  std::atomic<size_t> proximo(0);
+  auto inicio = std::chrono::steady_clock::now();
+
+  // cada thread pega o próximo candidato livre: corridas que desarmam
+  // cedo não deixam uma thread parada esperando as outras
+  std::vector<std::thread> trabalhadores;
+  for (unsigned t = 0; t < o.threads; t++) {
+    trabalhadores.emplace_back([&]() {
+      for (size_t i; (i = proximo++) < lista.size();) avaliar(o, lista[i]);
+    });
+  }
+  for (std::thread &t : trabalhadores) t.join();
+
+  double gasto = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+  size_t corridas = lista.size() * ((o.perfil < 0) ? QUANTIDADE_PERFIS : 1);
+  size_t validos = std::count_if(lista.begin(), lista.end(),
+                                 [](const Candidato &c) { return std::isfinite(c.custo); });
+
+  size_t n = std::min(lista.size(), (size_t)std::max(o.melhores, 0));
+  std::partial_sort(lista.begin(), lista.begin() + n, lista.end(),
+                    [](const Candidato &a, const Candidato &b) { return a.custo < b.custo; });
+
+  printf("%zu candidatos, %zu corridas em %.2f s (%.0f corridas/s, %u threads); %zu sem desarme\n",
+         lista.size(), corridas, gasto, corridas / gasto, o.threads, validos);
+  printf("%4s %9s", "#", "custo");
+  for (int d = 0; d < DIMENSOES; d++) printf(" %9s", NOMES[d]);
+  printf(" %9s %9s %9s %7s %s\n", "erro_rms", "erro_max", "sobressin", "tal_s", "desarme");
+  for (size_t i = 0; i < n; i++) {
+    const Candidato &c = lista[i];
+    printf("%4zu %9.3f", i + 1, c.custo);
+    for (int d = 0; d < DIMENSOES; d++) printf(" %9.4g", c.v[d]);
+    printf(" %9.3f %9.2f %9.2f %7.1f %s\n", c.erroRms, c.erroMax, c.sobressinal, c.tal, nomeDesarme(c.desarme));
+  }
+  return validos ? 0 : 1;
+}
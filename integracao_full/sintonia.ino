@@ -0,0 +1,215 @@
+// Autossintonia do PID por relé (POST /autotune) e identificação do
+// modelo térmico por degrau (POST /steptest), ambas com o forno parado.
+// Relé ou degrau assumem a potência no lugar do PID até terminar; o
+// resultado é aplicado e gravado como em POST /config.
+// POST /ident mede o modelo durante a próxima corrida, sem mexer no
+// controle: o PID segue no comando e a identificação só observa.
+
+#define SINTONIA_MAX_MS   (30UL*60*1000)  // desiste depois de 30 min
+#define SINTONIA_MARGEM   40.0            // acima do set point: falha por segurança
+#define ENSAIO_LIMITE     250.0           // acima disso o degrau é abortado
+#define IDENT_PASSO_S     4               // passo da regressão de /ident
+
+bool sintonia_pendente = false;   // concluída, ganhos ainda não aplicados
+bool ensaio_pendente = false;     // idem para o modelo do degrau
+bool ident_armada = false;        // começa na próxima corrida
+bool ident_pendente = false;      // corrida terminou, modelo ainda não avaliado
+bool ident_aplicar = true;        // grava o modelo medido; false só mostra
+uint8_t sintonia_regra = REGRA_POUCO_SOBRESSINAL;
+
+// loop(): aplica o resultado fora da tarefa de controle (grava na flash)
+void sintoniaAtender(){
+  ensaioAtender();
+  identAtender();
+  if(!sintonia_pendente) return;
+  uint8_t e = sintonia.estado();
+  if(e == SINTONIA_RODANDO) return;
+  sintonia_pendente = false;
+
+  ConfigForno nova = config_atual;
+  if(e != SINTONIA_CONCLUIDA || !sintonia.ganhos(sintonia_regra, nova.kc, nova.ki, nova.kd)){
+    Serial.println("autotune: interrompida, ganhos mantidos");
+    return;
+  }
+  String erro;
+  if(!configValidar(nova, erro)){
+    Serial.print("autotune: ganhos rejeitados, ");
+    Serial.println(erro);
+    return;
+  }
+  configGanhos(nova);
+  configSalvar();
+  Serial.println("autotune: novos ganhos gravados");
+}
+
+// POST sp=<C>[&h=<C>][&ciclos=N][&regra=0|1|2] inicia; POST cancelar=1 para;
+// GET devolve o andamento em JSON
+void handleAutotune() {
+ if(server.method() == HTTP_POST){
+   if(server.hasArg("cancelar")){
+     sintonia.cancelar();
+   }
+   else {
+     if(corridaAtiva() || otaAtiva() || sintonia.estado() == SINTONIA_RODANDO || ensaio.estado() == SINTONIA_RODANDO){
+       server.send(409, "text/plain", "forno em execucao");
+       return;
+     }
+     float sp = -1, h = 2, ciclos = 4, regra = REGRA_POUCO_SOBRESSINAL;
+     if(!configNumero("sp", sp) || !configNumero("h", h) || !configNumero("ciclos", ciclos)
+        || !configNumero("regra", regra)){
+       server.send(400, "text/plain", "numero malformado");
+       return;
+     }
+     if(sp < 50 || sp > 260 || h < 0 || h > 20 || ciclos < 1 || ciclos > 20
+        || regra < REGRA_ZIEGLER_NICHOLS || regra > REGRA_SEM_SOBRESSINAL){
+       server.send(400, "text/plain", "parametro fora da faixa");
+       return;
+     }
+     sintonia_regra = (uint8_t)regra;
+     sintonia.iniciar(sp, h, 0, 100, (uint8_t)ciclos, SINTONIA_MAX_MS / Ts, sp + SINTONIA_MARGEM);
+     sintonia_pendente = true;
+   }
+ }
+
+ static const char* const estados[] = {"parada", "rodando", "concluida", "falhou"};
+ String json = "{\"estado\":\"" + String(estados[sintonia.estado()]) + "\"";
+ json += ",\"ciclos\":" + String(sintonia.ciclos());
+ json += ",\"ku\":" + String(sintonia.ku(), 4);
+ json += ",\"pu_s\":" + String(sintonia.pu() * Ts / 1000.0, 1) + "}";
+ server.send(200, "application/json", json);
+}
+
+void ensaioAtender(){
+  if(!ensaio_pendente || ensaio.estado() == SINTONIA_RODANDO) return;
+  ensaio_pendente = false;
+  if(ensaio.estado() != SINTONIA_CONCLUIDA){
+    Serial.println("steptest: interrompido, modelo mantido");
+    return;
+  }
+
+  ConfigForno nova = config_atual;
+  nova.ff_ganho = ensaio.ganho();
+  nova.ff_tau = ensaio.tau();
+  nova.ff_ambiente = ensaio.ambiente();
+  String erro;
+  if(!configValidar(nova, erro)){
+    Serial.print("steptest: modelo rejeitado, ");
+    Serial.println(erro);
+    return;
+  }
+  configGanhos(nova);
+  configSalvar();
+  Serial.println("steptest: modelo gravado");
+}
+
+// POST potencia=<%> inicia com o forno frio; POST cancelar=1 para;
+// GET devolve o andamento e o último modelo identificado em JSON
+void handleSteptest() {
+ if(server.method() == HTTP_POST){
+   if(server.hasArg("cancelar")){
+     ensaio.cancelar();
+   }
+   else {
+     if(corridaAtiva() || otaAtiva() || sintonia.estado() == SINTONIA_RODANDO || ensaio.estado() == SINTONIA_RODANDO){
+       server.send(409, "text/plain", "forno em execucao");
+       return;
+     }
+     float potencia = 20;
+     if(!configNumero("potencia", potencia) || potencia < 5 || potencia > 60){
+       server.send(400, "text/plain", "potencia deve estar entre 5 e 60 %");
+       return;
+     }
+     // duas horas bastam para qualquer forno chegar ao regime
+     ensaio.iniciar(potencia, Ts / 1000.0, 2UL*60*60*1000 / Ts, ENSAIO_LIMITE);
+     ensaio_pendente = true;
+   }
+ }
+
+ static const char* const estados[] = {"parado", "rodando", "concluido", "falhou"};
+ String json = "{\"estado\":\"" + String(estados[ensaio.estado()]) + "\"";
+ json += ",\"ff_k\":" + String(ensaio.ganho(), 4);
+ json += ",\"ff_tau\":" + String(ensaio.tau(), 1);
+ json += ",\"ff_amb\":" + String(ensaio.ambiente(), 1) + "}";
+ server.send(200, "application/json", json);
+}
+
+// controle_pid(): uma amostra por Ts enquanto a corrida dura, inclusive o
+// resfriamento, que é o trecho com mais informação sobre a perda
+void identificacaoAmostra(float potencia){
+  if(ident_armada && corridaAquecendo()){
+    identificacao.iniciar(Ts / 1000.0, IDENT_PASSO_S);
+    ident_armada = false;
+  }
+  if(identificacao.estado() != SINTONIA_RODANDO) return;
+  if(falha_sensor){
+    identificacao.cancelar();
+    return;
+  }
+  if(corridaAtiva()) identificacao.adicionar(potencia, rk);
+  else {
+    identificacao.concluir();
+    ident_pendente = true;
+  }
+}
+
+void identAtender(){
+  if(!ident_pendente) return;
+  ident_pendente = false;
+  if(identificacao.estado() != SINTONIA_CONCLUIDA){
+    Serial.println("ident: corrida sem informação bastante, modelo mantido");
+    return;
+  }
+  if(!ident_aplicar) return;
+
+  ConfigForno nova = config_atual;
+  nova.ff_ganho = identificacao.ganho();
+  nova.ff_tau = identificacao.tauModelo();
+  nova.ff_ambiente = identificacao.ambiente();
+  nova.est_tau = identificacao.atrasoLeitura();
+  String erro;
+  if(!configValidar(nova, erro)){
+    Serial.print("ident: modelo rejeitado, ");
+    Serial.println(erro);
+    return;
+  }
+  configGanhos(nova);
+  configSalvar();
+  Serial.println("ident: modelo gravado");
+}
+
+// POST [aplicar=0] arma para a próxima corrida; POST cancelar=1 desarma ou
+// para; GET devolve o andamento e o último modelo medido em JSON
+void handleIdent() {
+ if(server.method() == HTTP_POST){
+   if(server.hasArg("cancelar")){
+     ident_armada = false;
+     identificacao.cancelar();
+   }
+   else {
+     if(identificacao.estado() == SINTONIA_RODANDO){
+       server.send(409, "text/plain", "identificacao em andamento");
+       return;
+     }
+     float aplicar = 1;
+     if(!configNumero("aplicar", aplicar)){
+       server.send(400, "text/plain", "numero malformado");
+       return;
+     }
+     ident_aplicar = aplicar != 0;
+     ident_armada = true;
+   }
+ }
+
+ static const char* const estados[] = {"parada", "rodando", "concluida", "falhou"};
+ String json = "{\"estado\":\"" + String(ident_armada ? "armada" : estados[identificacao.estado()]) + "\"";
+ json += ",\"amostras\":" + String(identificacao.amostras());
+ json += ",\"ff_k\":" + String(identificacao.ganho(), 4);
+ json += ",\"ff_tau\":" + String(identificacao.tauModelo(), 1);
+ json += ",\"ff_amb\":" + String(identificacao.ambiente(), 1);
+ json += ",\"est_tau\":" + String(identificacao.atrasoLeitura(), 1);
+ json += ",\"tau\":" + String(identificacao.tau(), 1);
+ json += ",\"tau_rapido\":" + String(identificacao.tauRapido(), 1);
+ json += ",\"atraso\":" + String(identificacao.atraso(), 1);
+ json += ",\"erro\":" + String(identificacao.erro(), 2) + "}";
+ server.send(200, "application/json", json);
+}
@@ -0,0 +1,135 @@
+// Sondas sem fio na placa (sonda.ino)
+// O rádio das sonda_placa/ (RH_RF69 ou RH_RF95) divide o SCLK e o SO dos
+// termopares, por RHSoftwareSPI. A ISR do driver leria a FIFO pelo SPI no
+// meio de uma leitura do MAX6675; por isso a interrupção é desligada
+// depois do init() e o DIO0 é consultado em sensor_ler(), no mesmo
+// contexto do barramento, a cada 10 ms. Dali também sai, pelo RHDatagram
+// em broadcast, a baliza com o relógio do forno (micros64(), o mesmo do
+// millis()) que as sondas seguem para ler juntas. Cada pacote entra na
+// FusaoPlaca_PI2 e o controle passa a ver a placa (estimarZonas()); o
+// supervisor continua no ar.
+
+#if MODO_SONDA
+
+#if SONDA_RADIO == 95
+#define SONDA_VOO_MS 12     // ~45 símbolos de 256 us em Bw500Cr45Sf128
+#define SONDA_JANELA_MS 14  // entre as transmissões de sondas vizinhas
+typedef RH_RF95 RadioBase;
+#else
+#define SONDA_VOO_MS 1      // ~27 bytes a 250 kbps em GFSK_Rb250Fd250
+#define SONDA_JANELA_MS 5
+typedef RH_RF69 RadioBase;
+#endif
+#if SONDA_NOS * SONDA_JANELA_MS >= SONDA_PERIODO_MS / 2
+#error "as janelas das sondas não cabem antes da baliza: aumente SONDA_PERIODO_MS"
+#endif
+
+// handleInterrupt() é protegido: só uma derivada pode chamá-lo fora da ISR
+class RadioSonda : public RadioBase {
+ public:
+  RadioSonda(RHGenericSPI& spi) : RadioBase(sondaCS, sondaDIO0, spi) {}
+  void atender(){
+    if(digitalRead(sondaDIO0)) handleInterrupt();
+  }
+};
+
+RHSoftwareSPI sonda_spi;
+RadioSonda sonda_radio(sonda_spi);
+RHDatagram sonda_gerente(sonda_radio, SONDA_ENDERECO);
+FusaoPlaca_PI2 sonda_fusao;
+bool sonda_ok = false;
+int16_t sonda_rssi = 0;
+uint64_t sonda_baliza_us = 0;   // próxima baliza, em micros64()
+uint32_t sonda_balizas = 0;
+
+// setup(), depois dos termopares: os pinos comuns já estão configurados
+void sondaIniciar(){
+  sonda_spi.setPins(maxSO, sondaMOSI, maxCLK);
+  sonda_fusao.configurar(SONDA_TAU_S);
+  sonda_ok = sonda_gerente.init();
+  if(!sonda_ok){
+    Serial.println("radio da sonda nao respondeu");
+    return;
+  }
+  detachInterrupt(digitalPinToInterrupt(sondaDIO0));
+#if SONDA_RADIO == 95
+  sonda_radio.setModemConfig(RH_RF95::Bw500Cr45Sf128);
+#else
+  sonda_radio.setModemConfig(RH_RF69::GFSK_Rb250Fd250);
+#endif
+  sonda_radio.setFrequency(SONDA_FREQUENCIA_MHZ);
+  sonda_radio.setModeRx();
+}
+
+// sensor_ler(): no máximo um pacote por chamada
+void sondaAtender(){
+  if(!sonda_ok) return;
+  digitalWrite(maxCLK, LOW);   // o MAX6675 deixa o SCLK alto; o rádio é modo 0
+  sonda_radio.atender();
+  if(sonda_radio.mode() == RHGenericDriver::RHModeTx) return;   // o DIO0 avisa o fim
+  if(micros64() >= sonda_baliza_us){
+    sondaBaliza();
+    return;
+  }
+  uint8_t dados[sizeof(PacoteSonda_PI2) + 1];   // maior que o pacote: rejeitado
+  uint8_t tamanho = sizeof(dados);
+  uint8_t de;
+  if(!sonda_gerente.available() || !sonda_gerente.recvfrom(dados, &tamanho, &de)) return;
+  sonda_rssi = sonda_radio.lastRssi();
+  sonda_fusao.receber(dados, tamanho, de, micros64() / 1000, SONDA_VOO_MS);
+}
+
+// Em k * SONDA_BALIZA_MS + SONDA_PERIODO_MS / 2, com até 10 ms de atraso
+// (a consulta); o instante vai na baliza, o atraso não importa
+void sondaBaliza(){
+  BalizaSonda_PI2 b;
+  b.versao = SONDA_VERSAO;
+  b.janela_ms = SONDA_JANELA_MS;
+  b.periodo_ms = SONDA_PERIODO_MS;
+  b.baliza_ms = SONDA_BALIZA_MS;
+  b.mestre_us = micros64();
+  sonda_gerente.sendto((uint8_t*)&b, sizeof(b), RH_BROADCAST_ADDRESS);
+  sonda_balizas++;
+  uint64_t k = b.mestre_us / (SONDA_BALIZA_MS * 1000ULL) + 1;
+  sonda_baliza_us = k * SONDA_BALIZA_MS * 1000ULL + SONDA_PERIODO_MS * 500ULL;
+}
+
+// estimarZonas(): a medida de uma zona só, corrigida para a placa
+float sondaFundir(float medida, unsigned long instante){
+  return sonda_fusao.fundir(medida, instante, millis());
+}
+
+// handleMetrics()
+void sondaMetricas(){
+  metricasCabecalho("forno_sonda_ativa", "gauge", "1 enquanto chegam pacotes das sondas da placa");
+  metricasLinha("forno_sonda_ativa %d\n", sonda_fusao.ativa(millis()) ? 1 : 0);
+  metricasCabecalho("forno_sonda_placa_celsius", "gauge", "media das sondas no ultimo instante comum");
+  metricasLinha("forno_sonda_placa_celsius %.2f\n", sonda_fusao.placa());
+  metricasCabecalho("forno_sonda_gradiente_celsius", "gauge", "maior - menor sonda no ultimo instante comum");
+  metricasLinha("forno_sonda_gradiente_celsius %.2f\n", sonda_fusao.gradiente());
+  metricasCabecalho("forno_sonda_diferenca_celsius", "gauge", "diferenca ar - placa descontada da medida do controle");
+  metricasLinha("forno_sonda_diferenca_celsius %.2f\n", sonda_fusao.diferenca());
+  metricasCabecalho("forno_sonda_pacotes_total", "counter", "pacotes da sonda por resultado");
+  metricasLinha("forno_sonda_pacotes_total{resultado=\"recebido\"} %lu\n", (unsigned long)sonda_fusao.recebidos());
+  metricasLinha("forno_sonda_pacotes_total{resultado=\"perdido\"} %lu\n", (unsigned long)sonda_fusao.perdidos());
+  metricasLinha("forno_sonda_pacotes_total{resultado=\"rejeitado\"} %lu\n", (unsigned long)sonda_fusao.rejeitados());
+  metricasCabecalho("forno_sonda_rssi_dbm", "gauge", "RSSI do ultimo pacote da sonda");
+  metricasLinha("forno_sonda_rssi_dbm %d\n", sonda_rssi);
+  metricasCabecalho("forno_sonda_balizas_total", "counter", "balizas de relogio enviadas as sondas");
+  metricasLinha("forno_sonda_balizas_total %lu\n", (unsigned long)sonda_balizas);
+  uint32_t agora = millis();
+  metricasCabecalho("forno_sonda_no_celsius", "gauge", "ultima leitura de cada sonda ativa");
+  for(uint8_t no=1; no<=SONDA_NOS; no++){
+    if(sonda_fusao.noAtivo(no, agora)) metricasLinha("forno_sonda_no_celsius{no=\"%u\"} %.2f\n", no, sonda_fusao.noCelsius(no));
+  }
+  metricasCabecalho("forno_sonda_no_sincronizada", "gauge", "1 se a sonda segue as balizas");
+  for(uint8_t no=1; no<=SONDA_NOS; no++){
+    if(sonda_fusao.noAtivo(no, agora)) metricasLinha("forno_sonda_no_sincronizada{no=\"%u\"} %d\n", no, sonda_fusao.noSincronizado(no) ? 1 : 0);
+  }
+  metricasCabecalho("forno_sonda_bateria_volts", "gauge", "bateria de cada sonda ativa");
+  for(uint8_t no=1; no<=SONDA_NOS; no++){
+    if(sonda_fusao.noAtivo(no, agora)) metricasLinha("forno_sonda_bateria_volts{no=\"%u\"} %.3f\n", no, sonda_fusao.noBateria(no) / 1000.0);
+  }
+}
+
+#endif
@@ -0,0 +1,57 @@
+// Telemetria ao vivo por Server-Sent Events (GET /events)
+// Para quem não fala WebSocket: a resposta HTTP fica aberta e cada amostra
+// vira uma linha "data:" com o mesmo quadro de websocket.ino; eventos
+// (eventos.ino) vão como "event: evento" com o JSON em "data:".
+// O servidor web só solta a sua referência à conexão depois do handler;
+// a cópia guardada aqui (ClienteWeb, plataforma.h) a mantém aberta.
+// Um inscrito que deixa acumular dados no buffer TCP é desconectado: o
+// loop() nunca espera por um navegador lento.
+
+#define SSE_MAX_CLIENTES 4
+
+ClienteWeb sseClientes[SSE_MAX_CLIENTES];
+
+void handleEvents(){
+  for(int i=0; i<SSE_MAX_CLIENTES; i++){
+    if(sseClientes[i].connected()) continue;
+    sseClientes[i] = server.client();
+    sseClientes[i].setNoDelay(true);
+    sseClientes[i].print(F("HTTP/1.1 200 OK\r\n"
+                           "Content-Type: text/event-stream\r\n"
+                           "Cache-Control: no-cache\r\n"
+                           "Connection: keep-alive\r\n"
+                           "Access-Control-Allow-Origin: *\r\n"
+                           "\r\n"
+                           "retry: 2000\n\n"));
+    return;
+  }
+  server.send(503, "text/plain", "sem vagas");
+}
+
+// redeSono(): inscritos ainda conectados
+uint8_t sseInscritos(){
+  uint8_t n = 0;
+  for(int i=0; i<SSE_MAX_CLIENTES; i++){
+    if(sseClientes[i].connected()) n++;
+  }
+  return n;
+}
+
+// evento = 0 para amostras (mensagem sem nome, onmessage no navegador)
+void sseEnviarTodos(const char* evento, const char* dados){
+  char quadro[160];
+  int n = evento ? snprintf(quadro, sizeof(quadro), "event: %s\ndata: %s\n\n", evento, dados)
+                 : snprintf(quadro, sizeof(quadro), "data: %s\n\n", dados);
+  if(n <= 0 || n >= (int)sizeof(quadro)) return;
+
+  for(int i=0; i<SSE_MAX_CLIENTES; i++){
+    if(!sseClientes[i].connected()) continue;
+    while(sseClientes[i].available()) sseClientes[i].read();
+    // sem espaço para o quadro inteiro: o cliente não está acompanhando
+    if(sseClientes[i].availableForWrite() < n){
+      sseClientes[i].stop();
+      continue;
+    }
+    sseClientes[i].write((const uint8_t*)quadro, n);
+  }
+}
@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Gera ../index.h a partir de index.html e dos arquivos do app
+(grafico.js, sw.js, manifest.webmanifest): cada arquivo é comprimido com
+gzip em um vetor PROGMEM e servido direto da flash pelo sketch
+(handleRoot() e handleArquivo()). A página não busca nada fora do forno.
+
+Uso: python3 gerar_index.py   (rodar depois de editar qualquer arquivo de web/)
+"""
+
+import gzip
+import hashlib
+import os
+
+AQUI = os.path.dirname(os.path.abspath(__file__))
+ENTRADA = os.path.join(AQUI, "index.html")
+SAIDA = os.path.join(AQUI, "..", "index.h")
+
+# servidos na raiz (o service worker só controla o que está abaixo dele);
+# o sw.js sempre revalida, é por ele que o navegador descobre um index.h
+# novo, e por isso vem por último: leva a versão de todos os outros
+APP = [
+    ("grafico.js", "application/javascript", "max-age=86400"),
+    ("manifest.webmanifest", "application/manifest+json", "max-age=86400"),
+    ("sw.js", "application/javascript", "no-cache"),
+]
+
+
+def comprimir(caminho, trocas=None):
+    with open(caminho, "rb") as f:
+        conteudo = f.read()
+    for de, para in (trocas or {}).items():
+        conteudo = conteudo.replace(de.encode(), para.encode())
+    # mtime=0 deixa a saída idêntica a cada execução
+    comprimido = gzip.compress(conteudo, compresslevel=9, mtime=0)
+    etag = hashlib.sha1(conteudo).hexdigest()[:16]
+    return conteudo, comprimido, etag
+
+
+def vetor(nome, dados):
+    linhas = []
+    for i in range(0, len(dados), 16):
+        bloco = dados[i:i + 16]
+        linhas.append("  " + ", ".join("0x%02x" % b for b in bloco) + ",")
+    return "const uint8_t %s[] PROGMEM = {\n%s\n};\n" % (nome, "\n".join(linhas))
+
+
+def identificador(nome):
+    return "ARQ_" + "".join(c if c.isalnum() else "_" for c in nome)
+
+
+def gerar(saida):
+    pagina, pagina_gz, pagina_etag = comprimir(ENTRADA)
+
+    # o sw.js leva a lista do shell e uma versão tirada do conteúdo de
+    # todos os outros: mudou qualquer um, o sw.js muda junto
+    arquivos = []
+    for nome, tipo, cache in APP:
+        trocas = None
+        if nome == "sw.js":
+            versao = hashlib.sha1(pagina_etag.encode())
+            for a in arquivos:
+                versao.update(a[5].encode())
+            trocas = {
+                "__VERSAO__": versao.hexdigest()[:16],
+                "__ARQUIVOS__": "[%s]" % ", ".join('"%s"' % a[0] for a in arquivos),
+            }
+        arquivos.append(("/" + nome, tipo, cache) + comprimir(os.path.join(AQUI, nome), trocas))
+
+    with open(saida, "w") as f:
+        f.write("// Gerado por web/gerar_index.py a partir de web/index.html e do app.\n")
+        f.write("// Não editar: altere os arquivos em web/ e rode o script de novo.\n")
+        f.write("// index.html: %d bytes -> %d bytes com gzip\n" % (len(pagina), len(pagina_gz)))
+        for caminho, _, _, conteudo, comprimido, _ in arquivos:
+            f.write("// %s: %d bytes -> %d bytes com gzip\n" % (caminho[1:], len(conteudo), len(comprimido)))
+        f.write("\n#define MAIN_page_etag \"\\\"%s\\\"\"\n\n" % pagina_etag)
+        f.write(vetor("MAIN_page_gz", pagina_gz))
+
+        for caminho, _, _, _, comprimido, _ in arquivos:
+            f.write("\n" + vetor(identificador(caminho[1:]) + "_gz", comprimido))
+
+        # tabela percorrida no setup() para registrar uma rota por arquivo;
+        # termina com caminho NULL para nunca ficar vazia
+        f.write("\nstruct ArquivoWeb {\n")
+        f.write("  const char* caminho;\n  const char* tipo;\n  const char* cache;\n  const char* etag;\n")
+        f.write("  const uint8_t* dados;\n  size_t tamanho;\n};\n\n")
+        f.write("const ArquivoWeb ARQUIVOS_WEB[] = {\n")
+        for caminho, tipo, cache, _, _, etag in arquivos:
+            ident = identificador(caminho[1:]) + "_gz"
+            f.write("  { \"%s\", \"%s\", \"%s\", \"\\\"%s\\\"\", %s, sizeof(%s) },\n"
+                    % (caminho, tipo, cache, etag, ident, ident))
+        f.write("  { NULL, NULL, NULL, NULL, NULL, 0 }\n};\n")
+    return len(pagina_gz) + sum(len(a[4]) for a in arquivos)
+
+
+if __name__ == "__main__":
+    print("index.h: %d bytes com gzip" % gerar(SAIDA))
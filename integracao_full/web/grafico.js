@@ -0,0 +1,205 @@
+//Line chart of the dashboard, drawn straight on the canvas and served from
+//the oven flash with the page (gerar_index.py), so the dashboard needs no
+//internet. It takes the Chart.js 2 configuration the page already used and
+//implements only that subset:
+//  - type 'line'; data.labels and each dataset's data are read by
+//    reference, so pushing to the arrays and calling update() is enough;
+//  - per dataset: label, borderColor, backgroundColor, borderWidth,
+//    borderDash, pointRadius and fill '-1' (area down to the previous
+//    dataset); NaN leaves a gap in the line; lines are not smoothed;
+//  - options.legend.labels.filter, options.maintainAspectRatio false (the
+//    canvas follows its container) and yAxes[0].ticks.beginAtZero.
+(function() {
+  var FONT = "12px Helvetica, Arial, sans-serif";
+  var TEXT = "#666";
+  var GRID = "rgba(0, 0, 0, 0.1)";
+  var X_LABELS = 8;   //at most, spread over the visible samples
+  var Y_TICKS = 6;
+
+  function Chart(ctx, config) {
+    this.ctx = ctx;
+    this.canvas = ctx.canvas;
+    this.data = config.data;
+    this.options = config.options || {};
+    var self = this;
+    window.addEventListener("resize", function() { self.update(); });
+    this.update();
+  }
+
+  //Canvas size in CSS pixels, backing store in device pixels
+  Chart.prototype.resize = function() {
+    var parent = this.canvas.parentNode;
+    var width = (parent && parent.clientWidth) || this.canvas.width;
+    var height = this.options.maintainAspectRatio === false && parent && parent.clientHeight
+                 ? parent.clientHeight : width / 2;
+    var ratio = window.devicePixelRatio || 1;
+    if (this.canvas.width != Math.round(width * ratio) || this.canvas.height != Math.round(height * ratio)) {
+      this.canvas.width = Math.round(width * ratio);
+      this.canvas.height = Math.round(height * ratio);
+      this.canvas.style.width = "100%";
+      this.canvas.style.height = height + "px";
+    }
+    this.ctx.setTransform(ratio, 0, 0, ratio, 0, 0);
+    this.width = width;
+    this.height = height;
+  };
+
+  //Round step (1, 2 or 5 times a power of ten) that gives about Y_TICKS lines
+  function step(range) {
+    var raw = range / (Y_TICKS - 1);
+    var power = Math.pow(10, Math.floor(Math.log(raw) / Math.LN10));
+    var unit = raw / power;
+    return (unit <= 1 ? 1 : unit <= 2 ? 2 : unit <= 5 ? 5 : 10) * power;
+  }
+
+  Chart.prototype.scaleY = function() {
+    var min = Infinity, max = -Infinity;
+    this.data.datasets.forEach(function(d) {
+      d.data.forEach(function(v) {
+        if (isNaN(v)) return;
+        if (v < min) min = v;
+        if (v > max) max = v;
+      });
+    });
+    var y = (this.options.scales && this.options.scales.yAxes && this.options.scales.yAxes[0]) || {};
+    if (y.ticks && y.ticks.beginAtZero) {
+      min = Math.min(min, 0);
+      max = Math.max(max, 0);
+    }
+    if (min == Infinity) { min = 0; max = 1; }
+    if (max == min) { max += 1; min -= 1; }
+    var s = step(max - min);
+    return { min: Math.floor(min / s) * s, max: Math.ceil(max / s) * s, step: s };
+  };
+
+  //Legend on top: a box in the line colour and the label; returns its height
+  Chart.prototype.drawLegend = function() {
+    var ctx = this.ctx;
+    var legend = this.options.legend || {};
+    if (legend.display === false) return 0;
+    var filter = legend.labels && legend.labels.filter;
+    var items = this.data.datasets.filter(function(d) {
+      return !filter || filter({ text: d.label || "" });
+    });
+    var widths = items.map(function(d) { return 52 + ctx.measureText(d.label || "").width; });
+    var total = widths.reduce(function(a, b) { return a + b; }, 0);
+    var x = Math.max(0, (this.width - total) / 2);
+    ctx.textBaseline = "middle";
+    ctx.textAlign = "left";
+    items.forEach(function(d, i) {
+      ctx.fillStyle = d.backgroundColor || d.borderColor;
+      ctx.strokeStyle = d.borderColor;
+      ctx.lineWidth = 1;
+      ctx.setLineDash(d.borderDash || []);
+      ctx.fillRect(x, 6, 40, 12);
+      ctx.strokeRect(x, 6, 40, 12);
+      ctx.setLineDash([]);
+      ctx.fillStyle = TEXT;
+      ctx.fillText(d.label || "", x + 46, 12);
+      x += widths[i];
+    });
+    return 28;
+  };
+
+  //Path through the samples; NaN starts a new segment
+  function trace(ctx, data, x, y) {
+    var open = false;
+    for (var i = 0; i < data.length; i++) {
+      if (isNaN(data[i])) { open = false; continue; }
+      if (open) ctx.lineTo(x(i), y(data[i]));
+      else ctx.moveTo(x(i), y(data[i]));
+      open = true;
+    }
+  }
+
+  //Area between this dataset and the one before it, drawn in runs of
+  //samples where both exist
+  function fillBetween(ctx, upper, lower, x, y) {
+    var i = 0, n = Math.min(upper.length, lower.length);
+    while (i < n) {
+      while (i < n && (isNaN(upper[i]) || isNaN(lower[i]))) i++;
+      var start = i;
+      while (i < n && !isNaN(upper[i]) && !isNaN(lower[i])) i++;
+      if (i - start < 2) continue;
+      ctx.beginPath();
+      ctx.moveTo(x(start), y(upper[start]));
+      for (var k = start + 1; k < i; k++) ctx.lineTo(x(k), y(upper[k]));
+      for (k = i - 1; k >= start; k--) ctx.lineTo(x(k), y(lower[k]));
+      ctx.closePath();
+      ctx.fill();
+    }
+  }
+
+  Chart.prototype.update = function() {
+    this.resize();
+    var ctx = this.ctx;
+    ctx.clearRect(0, 0, this.width, this.height);
+    ctx.font = FONT;
+
+    var top = this.drawLegend() + 8;
+    var scale = this.scaleY();
+    var left = 8 + Math.max(ctx.measureText(scale.min.toFixed(0)).width,
+                            ctx.measureText(scale.max.toFixed(0)).width) + 6;
+    var right = this.width - 10;
+    var bottom = this.height - 24;
+    var labels = this.data.labels;
+    var n = Math.max(labels.length, 2);
+    function x(i) { return left + (right - left) * i / (n - 1); }
+    function y(v) { return bottom - (bottom - top) * (v - scale.min) / (scale.max - scale.min); }
+
+    //grid and axes
+    ctx.strokeStyle = GRID;
+    ctx.lineWidth = 1;
+    ctx.fillStyle = TEXT;
+    ctx.textAlign = "right";
+    ctx.textBaseline = "middle";
+    var decimals = scale.step < 1 ? Math.ceil(-Math.log(scale.step) / Math.LN10) : 0;
+    for (var v = scale.min; v <= scale.max + scale.step / 2; v += scale.step) {
+      ctx.beginPath();
+      ctx.moveTo(left, Math.round(y(v)) + 0.5);
+      ctx.lineTo(right, Math.round(y(v)) + 0.5);
+      ctx.stroke();
+      ctx.fillText(v.toFixed(decimals), left - 6, y(v));
+    }
+    ctx.textAlign = "center";
+    ctx.textBaseline = "top";
+    var every = Math.max(1, Math.ceil(labels.length / X_LABELS));
+    for (var i = 0; i < labels.length; i += every) {
+      ctx.beginPath();
+      ctx.moveTo(Math.round(x(i)) + 0.5, top);
+      ctx.lineTo(Math.round(x(i)) + 0.5, bottom);
+      ctx.stroke();
+      ctx.fillText(String(labels[i]), x(i), bottom + 6);
+    }
+
+    //fills first, so every line stays on top of them
+    var sets = this.data.datasets;
+    sets.forEach(function(d, k) {
+      if (d.fill !== "-1" || k == 0) return;
+      ctx.fillStyle = d.backgroundColor || d.borderColor;
+      fillBetween(ctx, sets[k - 1].data, d.data, x, y);
+    });
+    sets.forEach(function(d) {
+      ctx.strokeStyle = d.borderColor;
+      ctx.lineWidth = d.borderWidth === undefined ? 3 : d.borderWidth;
+      ctx.lineJoin = "round";
+      ctx.setLineDash(d.borderDash || []);
+      ctx.beginPath();
+      trace(ctx, d.data, x, y);
+      ctx.stroke();
+      ctx.setLineDash([]);
+
+      var radius = d.pointRadius === undefined ? 3 : d.pointRadius;
+      if (radius <= 0) return;
+      ctx.fillStyle = d.backgroundColor || d.borderColor;
+      d.data.forEach(function(v, i) {
+        if (isNaN(v)) return;
+        ctx.beginPath();
+        ctx.arc(x(i), y(v), radius, 0, 2 * Math.PI);
+        ctx.fill();
+      });
+    });
+  };
+
+  window.Chart = Chart;
+})();
@@ -0,0 +1,48 @@
+//Service worker of the dashboard: the shell (page, chart, manifest) is
+//answered from the browser's cache, so opening the page costs the oven
+//nothing; only the data APIs reach it. gerar_index.py fills in VERSION
+//from the shell's contents, so a new index.h means a new sw.js, which
+//installs a fresh cache and drops the old one.
+var VERSION = "__VERSAO__";
+var SHELL = "shell-" + VERSION;
+var DATA = "data";
+var SHELL_FILES = ["/"].concat(__ARQUIVOS__);
+//The last answer is kept so a reload without WiFi still shows the run
+var CACHED_DATA = ["/history", "/perfil/curva"];
+
+self.addEventListener("install", function(event) {
+  event.waitUntil(caches.open(SHELL).then(function(cache) {
+    //"reload": not the copy the HTTP cache may still hold from an older index.h
+    return cache.addAll(SHELL_FILES.map(function(f) { return new Request(f, { cache: "reload" }); }));
+  }).then(function() { return self.skipWaiting(); }));
+});
+
+self.addEventListener("activate", function(event) {
+  event.waitUntil(caches.keys().then(function(keys) {
+    return Promise.all(keys.filter(function(k) { return k != SHELL && k != DATA; })
+                           .map(function(k) { return caches.delete(k); }));
+  }).then(function() { return self.clients.claim(); }));
+});
+
+self.addEventListener("fetch", function(event) {
+  var url = new URL(event.request.url);
+  if (event.request.method != "GET" || url.origin != location.origin) return;
+
+  if (SHELL_FILES.indexOf(url.pathname) >= 0) {
+    event.respondWith(caches.match(event.request, { ignoreSearch: true }).then(function(hit) {
+      return hit || fetch(event.request);
+    }));
+  } else if (CACHED_DATA.indexOf(url.pathname) >= 0) {
+    //network first: the cache only answers when the oven can't
+    event.respondWith(fetch(event.request).then(function(response) {
+      if (response.ok) {
+        var copy = response.clone();
+        caches.open(DATA).then(function(cache) { cache.put(event.request, copy); });
+      }
+      return response;
+    }).catch(function() {
+      return caches.match(event.request).then(function(hit) { return hit || Response.error(); });
+    }));
+  }
+  //everything else (telemetry, commands, /fleet) goes straight to the oven
+});
@@ -0,0 +1,119 @@
+// Telemetria ao vivo por WebSocket (porta 81)
+// Cada amostra publicada pela tarefa de controle vira um quadro de texto
+// "t_ms,temperatura,set_point,potencia,historico,desarme,corrida,utc" enviado
+// a todos os inscritos; historico é o since que o painel usa em /history
+// ao reconectar, desarme o motivo do supervisor (0 = armado), corrida o
+// EstadoCorrida e utc a hora da amostra em s.ms (relogio.ino, 0 sem SNTP).
+// Eventos (eventos.ino) vão pelo mesmo canal como objetos JSON.
+// O mesmo quadro segue para os inscritos de /events (sse.ino).
+// Os envios acontecem no loop(): o WiFiClient não pode ser usado a
+// partir do contexto do Ticker.
+// Com WS_TELEMETRIA_COMPACTA a amostra vai ao WebSocket num quadro
+// binário em vez do texto (o SSE continua em texto):
+//   [0] WS_QUADRO_CHAVE ou WS_QUADRO_DELTA  [1] seq  [2..] 8 varints
+// na ordem do quadro de texto, temperatura em centésimos, set point em
+// décimos e utc em segundos inteiros. O quadro chave leva os valores, o delta a diferença para a
+// amostra anterior, em zigzag (|d| < 64 cabe em um byte): ~10 bytes em
+// vez de ~40. Quem perdeu um quadro (seq fora de ordem) espera o próximo
+// chave, que sai a cada WS_INTERVALO_CHAVE quadros e logo depois de um
+// inscrito novo ou de um quadro descartado pelo hub.
+// O WebSocketHub codifica o quadro uma vez só para todos os inscritos e
+// nunca espera por um deles: quem não tem espaço no buffer de envio perde
+// o quadro, e depois de WS_QUADROS_PERDIDOS seguidos é desconectado.
+
+#define WS_PORTA 81
+#define WS_MAX_CLIENTES 4
+#define WS_QUADROS_PERDIDOS 20   // ~2 s de telemetria a 10 Hz
+#define WS_TELEMETRIA_COMPACTA 1
+#define WS_INTERVALO_CHAVE 50
+#define WS_QUADRO_CHAVE 0x01
+#define WS_QUADRO_DELTA 0x02
+#define WS_CAMPOS 8
+
+WiFiServer wsServidor(WS_PORTA);
+WebSocketHub::Slot wsSlots[WS_MAX_CLIENTES];
+WebSocketHub wsHub(wsServidor, wsSlots, WS_MAX_CLIENTES);
+uint32_t wsUltimaSequencia = 0;
+int32_t wsAnterior[WS_CAMPOS];
+uint8_t wsSeq = 0;
+uint8_t wsDesdeChave = WS_INTERVALO_CHAVE;   // o primeiro é chave
+uint8_t wsInscritos = 0;
+uint32_t wsDescartados = 0;
+
+void wsIniciar(){
+  wsHub.setBackpressure(WS_HUB_SKIP_FRAME, WS_QUADROS_PERDIDOS);
+  wsHub.begin();
+}
+
+// descoberta.ino e rede.ino: o #define e o wsHub não chegam às abas
+// anteriores a esta
+uint16_t wsPorta(){
+  return WS_PORTA;
+}
+
+uint8_t wsClientes(){
+  return wsHub.clients();
+}
+
+void wsAtender(){
+  // aceita, completa handshakes e responde pings; o painel não envia
+  // comandos, então não há onMessage
+  wsHub.poll();
+
+  uint32_t seq = telemetria.sequencia();
+  if(seq == wsUltimaSequencia) return;
+  wsUltimaSequencia = seq;
+
+  AmostraControle a;
+  telemetria.ler(a);
+
+  char utc[24];
+  relogioTexto(utc, sizeof(utc), a.utc_us);
+  char quadro[88];
+  snprintf(quadro, sizeof(quadro), "%lu,%.2f,%.1f,%d,%lu,%u,%u,%s",
+           (unsigned long)a.timestamp, a.rk, a.set_point, a.controle_potencia,
+           (unsigned long)historico.proximo(), (unsigned)a.desarme, (unsigned)a.corrida, utc);
+
+#if WS_TELEMETRIA_COMPACTA
+  wsEnviarCompacto(a);
+#else
+  wsEnviarTodos(quadro);
+#endif
+  sseEnviarTodos(0, quadro);
+}
+
+void wsEnviarCompacto(const AmostraControle& a){
+  int32_t v[WS_CAMPOS] = {
+    (int32_t)a.timestamp,
+    isnan(a.rk) ? INT32_MIN : (int32_t)lroundf(a.rk * 100),
+    (int32_t)lroundf(a.set_point * 10),
+    a.controle_potencia,
+    (int32_t)historico.proximo(),
+    a.desarme,
+    a.corrida,
+    (int32_t)(uint32_t)(a.utc_us / 1000000)   // o delta entre amostras é 0 ou 1
+  };
+
+  // quem chegou ou perdeu um quadro precisa de valores inteiros
+  uint8_t inscritos = wsHub.clients();
+  bool chave = wsDesdeChave >= WS_INTERVALO_CHAVE || inscritos > wsInscritos ||
+               wsHub.dropped() != wsDescartados;
+  wsInscritos = inscritos;
+  wsDescartados = wsHub.dropped();
+
+  uint8_t quadro[2 + WS_CAMPOS*5];
+  uint8_t n = 0;
+  quadro[n++] = chave ? WS_QUADRO_CHAVE : WS_QUADRO_DELTA;
+  quadro[n++] = wsSeq++;
+  for(int i=0; i<WS_CAMPOS; i++){
+    n += codificarVarint(quadro + n, chave ? v[i] : (int32_t)((uint32_t)v[i] - (uint32_t)wsAnterior[i]));
+    wsAnterior[i] = v[i];
+  }
+  wsDesdeChave = chave ? 1 : wsDesdeChave + 1;
+
+  wsHub.broadcast(quadro, n, WS_OPCODE_BINARY);
+}
+
+void wsEnviarTodos(const char* quadro){
+  wsHub.broadcast(quadro);
+}
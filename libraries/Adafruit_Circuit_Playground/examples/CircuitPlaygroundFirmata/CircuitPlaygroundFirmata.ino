@@ -119,6 +119,22 @@
                                       //  - red color (unsigned 8 bit value, split across 2 7-bit bytes)
                                       //  - green color (unsigned 8 bit value, split across 2 7-bit bytes)
                                       //  - blue color (unsigned 8 bit value, split across 2 7-bit bytes)
+#define CP_SAMPLES_ON           0x60  // Start sampling several sensors at a fixed rate and sending them in
+                                      // batches.  Expects 5 bytes of parameters:
+                                      //  - channel mask, a bit for each value to sample (see CP_SAMPLE_ below)
+                                      //  - sample interval in microseconds, as 3 7-bit bytes, least significant first
+                                      //  - number of samples to send in each CP_SAMPLES_REPLY, 1-16
+#define CP_SAMPLES_OFF          0x61  // Stop the sampling started by CP_SAMPLES_ON.
+#define CP_SAMPLES_REPLY        0x62  // A batch of samples.  Includes a byte with the channel mask, a byte with a
+                                      // sequence number that counts batches (so the host can spot lost ones), a
+                                      // byte with the number of samples, then for each sample an int16_t for each
+                                      // channel in the mask, in mask bit order.
+#define CP_SAMPLE_ACCEL         0x01  // Channel mask bit: raw accelerometer x, y, z (3 values).
+#define CP_SAMPLE_SOUND         0x02  // Channel mask bit: sound sensor, as soundSensor().
+#define CP_SAMPLE_LIGHT         0x04  // Channel mask bit: light sensor, as lightSensor().
+#define CP_SAMPLE_TEMP          0x08  // Channel mask bit: raw thermistor ADC reading.
+#define SAMPLE_MAX_BATCH        16    // Most samples in one CP_SAMPLES_REPLY.
+#define SAMPLE_MAX_VALUES       6     // Most int16_t values in one sample.
 
 
 // the minimum interval for sampling analog input
@@ -132,6 +148,14 @@
 // Circuit playground globals:
 bool streamTap = false;
 bool streamAccel = false;
+// Batched sampling, see CP_SAMPLES_ON.
+uint8_t sampleMask = 0;             // 0 = not sampling
+unsigned long sampleInterval;       // in microseconds
+unsigned long nextSampleMicros;
+uint8_t sampleBatch;                // samples per reply
+uint8_t sampleCount;                // samples in the reply being built
+uint8_t sampleSequence;
+uint8_t sampleReply[4 + SAMPLE_MAX_BATCH * SAMPLE_MAX_VALUES * 2];
 // Define type for the cap touch sensor state of each cap touch input.
 typedef struct {
   bool streaming;
@@ -700,6 +724,64 @@ void circuitPlaygroundCommand(byte command, byte argc, byte* argv) {
       // Sense the color of an object over the light sensor and send back
       // a CP_SENSECOLOR_REPLY response.
       sendColorSenseResponse();
+      break;
+    case CP_SAMPLES_ON:
+      // Start batched sampling.
+      // Expects 1 byte channel mask, 3 bytes interval, 1 byte batch size.
+      if (argc >= 5) {
+        uint8_t mask = argv[0] & 0x0F;
+        unsigned long interval = (argv[1] & 0x7F) | ((unsigned long)(argv[2] & 0x7F) << 7) |
+                                 ((unsigned long)(argv[3] & 0x7F) << 14);
+        uint8_t batch = argv[4] & 0x7F;
+        if ((mask == 0) || (interval == 0) || (batch == 0) || (batch > SAMPLE_MAX_BATCH)) {
+          // Bad parameters, stop processing!
+          return;
+        }
+        sampleMask = mask;
+        sampleInterval = interval;
+        sampleBatch = batch;
+        sampleCount = 0;
+        sampleSequence = 0;
+        nextSampleMicros = micros();
+      }
+      break;
+    case CP_SAMPLES_OFF:
+      sampleMask = 0;
+      break;
+  }
+}
+
+// Take one sample of each channel in sampleMask, and send the batch once
+// it is full.  All the samples go in one sysex message, so the host gets
+// SAMPLE_MAX_BATCH times fewer messages than with one reply per reading.
+void takeSample() {
+  int16_t values[SAMPLE_MAX_VALUES];
+  uint8_t count = 0;
+  if (sampleMask & CP_SAMPLE_ACCEL) {
+    CircuitPlayground.lis.read();
+    values[count++] = CircuitPlayground.lis.x;
+    values[count++] = CircuitPlayground.lis.y;
+    values[count++] = CircuitPlayground.lis.z;
+  }
+  if (sampleMask & CP_SAMPLE_SOUND) {
+    values[count++] = CircuitPlayground.soundSensor();
+  }
+  if (sampleMask & CP_SAMPLE_LIGHT) {
+    values[count++] = CircuitPlayground.lightSensor();
+  }
+  if (sampleMask & CP_SAMPLE_TEMP) {
+    values[count++] = analogRead(CPLAY_THERMISTORPIN);
+  }
+  memcpy(sampleReply + 4 + sampleCount * count * 2, values, count * 2);
+
+  if (++sampleCount >= sampleBatch) {
+    sampleReply[0] = CP_SAMPLES_REPLY;
+    sampleReply[1] = sampleMask;
+    sampleReply[2] = sampleSequence++;
+    sampleReply[3] = sampleCount;
+    // Send the response, this will expand each byte into 2 bytes of 7-bit data.
+    Firmata.sendSysex(CP_COMMAND, 4 + sampleCount * count * 2, sampleReply);
+    sampleCount = 0;
   }
 }
 
@@ -1085,6 +1167,7 @@ void circuitPlaygroundReset() {
   // Turn off streaming of tap, accel, and cap touch data.
   streamTap = false;
   streamAccel = false;
+  sampleMask = 0;
   for (int i=0; i<CAP_COUNT; ++i) {
     cap_state[i].streaming = false;
   }
@@ -1162,6 +1245,18 @@ void loop()
   while (Firmata.available())
     Firmata.processInput();
 
+  /* SAMPLES - batched sampling runs on its own clock, independent of the
+   * sampling interval, so it can go much faster. */
+  if (sampleMask && (long)(micros() - nextSampleMicros) >= 0) {
+    nextSampleMicros += sampleInterval;
+    // If we've fallen a whole interval behind, skip ahead instead of
+    // sending a burst of late samples.
+    if ((long)(micros() - nextSampleMicros) >= 0) {
+      nextSampleMicros = micros() + sampleInterval;
+    }
+    takeSample();
+  }
+
   // TODO - ensure that Stream buffer doesn't go over 60 bytes
 
   currentMillis = millis();
@@ -27,6 +27,16 @@
 
 #if defined(__SAMD21G18A__)
 
+#define FREETOUCH_SCAN_MAX 16  // one per Y line
+
+static Adafruit_CPlay_FreeTouch * volatile scanPads = NULL;
+static uint8_t           scanCount;
+static volatile uint8_t  scanIndex;
+static uint16_t          scanThreshold;
+static volatile uint16_t scanTouched;                    // bit per pad
+static volatile uint16_t scanReadings[FREETOUCH_SCAN_MAX];
+static volatile uint32_t scanBaselines[FREETOUCH_SCAN_MAX]; // 16ths, 0 = unset
+
 Adafruit_CPlay_FreeTouch::Adafruit_CPlay_FreeTouch(int p, oversample_t f, series_resistor_t r, freq_mode_t fh) {
   pin = p;
   oversample = f;
@@ -144,6 +154,8 @@ uint16_t Adafruit_CPlay_FreeTouch::measure(void) {
 uint16_t Adafruit_CPlay_FreeTouch::measureRaw(void) {
   if (yline == -1) 
     return -1;
+  if (scanPads)  // the PTC belongs to the background scan
+    return -1;
 
   runInStandby(true);
   enablePTC(true);
@@ -386,6 +398,112 @@ void Adafruit_CPlay_FreeTouch::sync_config(void) {
 
 
 
+/**************************** BACKGROUND SCAN *************************/
+
+// Start measuring pads[0..n-1] in turn, each conversion started from the
+// interrupt at the end of the one before, so touch state is always fresh
+// and reading it never waits for the PTC.  Each pad's baseline follows
+// slow drift (temperature, humidity) with a 1/64 IIR filter while it is
+// not touched.  A pad is touched once its reading is threshold above its
+// baseline, and released once it falls back under half that.  The pads
+// must each have had begin() called.  measure() can't be used meanwhile.
+bool Adafruit_CPlay_FreeTouch::startScan(Adafruit_CPlay_FreeTouch *pads, uint8_t n, uint16_t threshold) {
+  stopScan();
+  if (!n || (n > FREETOUCH_SCAN_MAX)) return false;
+  for (uint8_t i=0; i<n; i++) {
+    if (pads[i].yline == -1) return false;
+    pads[i].ptcConfigIOpin();
+    scanReadings[i] = 0;
+    scanBaselines[i] = 0;
+  }
+  scanCount = n;
+  scanIndex = 0;
+  scanThreshold = threshold;
+  scanTouched = 0;
+  scanPads = pads;
+
+  pads[0].runInStandby(true);
+  pads[0].enablePTC(true);
+  pads[0].enableWCOint(false);
+  pads[0].clearWCOintFlag();
+  pads[0].clearEOCintFlag();
+  pads[0].enableEOCint(true);
+  NVIC_ClearPendingIRQ(PTC_IRQn);
+  NVIC_EnableIRQ(PTC_IRQn);
+
+  pads[0].scanSelect();
+  pads[0].ptcAcquire();
+  return true;
+}
+
+void Adafruit_CPlay_FreeTouch::stopScan(void) {
+  Adafruit_CPlay_FreeTouch *pads = scanPads;
+  if (!pads) return;
+  NVIC_DisableIRQ(PTC_IRQn);
+  scanPads = NULL;
+  pads[0].enableEOCint(false);
+  while (QTOUCH_PTC->CONVCONTROL.bit.CONVERT) ;  // let the last one finish
+  pads[0].clearEOCintFlag();
+}
+
+bool Adafruit_CPlay_FreeTouch::isTouched(uint8_t n) {
+  return (n < FREETOUCH_SCAN_MAX) && (scanTouched & (1 << n));
+}
+
+uint16_t Adafruit_CPlay_FreeTouch::scanReading(uint8_t n) {
+  return (n < FREETOUCH_SCAN_MAX) ? scanReadings[n] : 0;
+}
+
+uint16_t Adafruit_CPlay_FreeTouch::scanBaseline(uint8_t n) {
+  return (n < FREETOUCH_SCAN_MAX) ? (scanBaselines[n] + 8) >> 4 : 0;
+}
+
+// Load this pad's line and settings into the PTC, as measureRaw() does.
+void Adafruit_CPlay_FreeTouch::scanSelect(void) {
+  selectYLine();
+  setSeriesResistor(seriesres);
+  setOversampling(oversample);
+  setFreqHopping(freqhop, hops);
+  setCompCap(compcap);
+  setIntCap(intcap);
+  QTOUCH_PTC->BURSTMODE.reg = 0xA4;
+  sync_config();
+}
+
+void Adafruit_CPlay_FreeTouch::scanHandler(void) {
+  Adafruit_CPlay_FreeTouch *pads = scanPads;
+  if (!pads) return;
+
+  uint8_t i = scanIndex;
+  pads[i].clearEOCintFlag();
+  uint16_t m = QTOUCH_PTC->RESULT.reg >> pads[i].oversample;  // as measure()
+  scanReadings[i] = m;
+
+  uint32_t base = scanBaselines[i];
+  uint16_t bit = 1 << i;
+  if (!base) {
+    base = (uint32_t)m << 4;            // first reading
+  } else if (scanTouched & bit) {
+    if (((uint32_t)m << 4) < base + ((uint32_t)scanThreshold << 3))
+      scanTouched &= ~bit;
+  } else if (((uint32_t)m << 4) >= base + ((uint32_t)scanThreshold << 4)) {
+    scanTouched |= bit;
+  } else {
+    base += (((int32_t)m << 4) - (int32_t)base) >> 6;  // track drift
+  }
+  scanBaselines[i] = base ? base : 1;
+
+  if (++i >= scanCount) i = 0;
+  scanIndex = i;
+  pads[i].scanSelect();
+  pads[i].ptcAcquire();
+}
+
+extern "C" void PTC_Handler(void) {
+  Adafruit_CPlay_FreeTouch::scanHandler();
+}
+
+
 /**************************** DEBUGGING ASSIST *************************/
 void Adafruit_CPlay_FreeTouch::snapshotRegsAndPrint(uint32_t base, uint8_t numregs) {
   volatile uint32_t addr = base;
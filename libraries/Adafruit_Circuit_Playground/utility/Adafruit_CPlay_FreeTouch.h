@@ -384,7 +384,17 @@ class Adafruit_CPlay_FreeTouch {
   uint16_t measure(void);
   uint16_t measureRaw(void);
 
+  // Background scanning of several pads, one after another from the PTC
+  // end-of-conversion interrupt, with a drifting baseline per pad.
+  static bool startScan(Adafruit_CPlay_FreeTouch *pads, uint8_t n, uint16_t threshold = 100);
+  static void stopScan(void);
+  static bool isTouched(uint8_t n);
+  static uint16_t scanReading(uint8_t n);
+  static uint16_t scanBaseline(uint8_t n);
+  static void scanHandler(void);  // called from PTC_Handler
+
  private:
+  void scanSelect(void);
   void ptcInitSettings(void);
   void ptcConfigIOpin(void);
   uint16_t startPtcAcquire(void);
@@ -34,7 +34,7 @@
 */
 /**************************************************************************/
 Adafruit_CPlay_LIS3DH::Adafruit_CPlay_LIS3DH()
-  : _cs(-1), _mosi(-1), _miso(-1), _sck(-1), _sensorID(-1)
+  : _cs(-1), _mosi(-1), _miso(-1), _sck(-1), _sensorID(-1), _fifo(false)
 {
 }
 
@@ -45,7 +45,7 @@ Adafruit_CPlay_LIS3DH::Adafruit_CPlay_LIS3DH()
 */
 /**************************************************************************/
 Adafruit_CPlay_LIS3DH::Adafruit_CPlay_LIS3DH(int8_t cspin)
-  : _cs(cspin), _mosi(-1), _miso(-1), _sck(-1), _sensorID(-1)
+  : _cs(cspin), _mosi(-1), _miso(-1), _sck(-1), _sensorID(-1), _fifo(false)
 { }
 
 /**************************************************************************/
@@ -58,7 +58,7 @@ Adafruit_CPlay_LIS3DH::Adafruit_CPlay_LIS3DH(int8_t cspin)
 */
 /**************************************************************************/
 Adafruit_CPlay_LIS3DH::Adafruit_CPlay_LIS3DH(int8_t cspin, int8_t mosipin, int8_t misopin, int8_t sckpin)
-  : _cs(cspin), _mosi(mosipin), _miso(misopin), _sck(sckpin), _sensorID(-1)
+  : _cs(cspin), _mosi(mosipin), _miso(misopin), _sck(sckpin), _sensorID(-1), _fifo(false)
 { }
 
 
@@ -177,12 +177,7 @@ void Adafruit_CPlay_LIS3DH::read(void) {
 #endif
   }
   #endif
-  uint8_t range = getRange();
-  uint16_t divider = 1;
-  if (range == LIS3DH_RANGE_16_G) divider = 1365;
-  if (range == LIS3DH_RANGE_8_G) divider = 4096;
-  if (range == LIS3DH_RANGE_4_G) divider = 8190;
-  if (range == LIS3DH_RANGE_2_G) divider = 16380;
+  uint16_t divider = rangeDivider();
 
   x_g = (float)x / divider;
   y_g = (float)y / divider;
@@ -282,6 +277,109 @@ uint8_t Adafruit_CPlay_LIS3DH::getClick(void) {
   return readRegister8(LIS3DH_REG_CLICKSRC);
 }
 
+/**************************************************************************/
+/*!
+    @brief  Buffer readings in the 32-sample hardware FIFO, in stream mode,
+      and signal on INT1 when it holds more than a watermark instead of on
+      every new reading.  The oldest readings are dropped if it fills up.
+    @param watermark the number of samples (1-31) at which INT1 goes high.
+      Pass 0 to turn the FIFO off and go back to data ready on INT1.
+*/
+/**************************************************************************/
+void Adafruit_CPlay_LIS3DH::setFifo(uint8_t watermark) {
+  uint8_t r3 = readRegister8(LIS3DH_REG_CTRL3);
+  uint8_t r5 = readRegister8(LIS3DH_REG_CTRL5);
+
+  _fifo = watermark;
+  if (!watermark) {
+    writeRegister8(LIS3DH_REG_FIFOCTRL, 0x00);  // bypass mode
+    writeRegister8(LIS3DH_REG_CTRL5, r5 & ~0x40);  // FIFO_EN off
+    writeRegister8(LIS3DH_REG_CTRL3, (r3 & ~0x04) | 0x10);  // I1_WTM off, DRDY on
+    return;
+  }
+  if (watermark > 31) watermark = 31;
+
+  writeRegister8(LIS3DH_REG_CTRL5, r5 | 0x40);  // FIFO_EN
+  // Going through bypass mode empties the FIFO
+  writeRegister8(LIS3DH_REG_FIFOCTRL, 0x00);
+  writeRegister8(LIS3DH_REG_FIFOCTRL, 0x80 | watermark);  // stream mode, INT1
+  writeRegister8(LIS3DH_REG_CTRL3, (r3 & ~0x10) | 0x04);  // DRDY off, I1_WTM on
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the number of samples waiting in the FIFO
+    @return the number of samples, 0-32
+*/
+/**************************************************************************/
+uint8_t Adafruit_CPlay_LIS3DH::fifoCount(void) {
+  uint8_t src = readRegister8(LIS3DH_REG_FIFOSRC);
+  if (src & 0x40) return 32;  // OVRN_FIFO: full
+  return src & 0x1F;          // FSS
+}
+
+/**************************************************************************/
+/*!
+    @brief  Read up to n x, y, z samples out of the FIFO (see setFifo()) in
+      one burst.  With the FIFO on, the register address wraps from OUT_Z_H
+      back to OUT_X_L, so one transfer reads many samples.  The x, y, z
+      and x_g, y_g, z_g members are not updated.
+    @param xyz the buffer to store the samples in, as raw x, y, z triples.
+      Must hold 3 * n values.
+    @param n the most samples to read
+    @return the number of samples read
+*/
+/**************************************************************************/
+uint8_t Adafruit_CPlay_LIS3DH::readFifo(int16_t *xyz, uint8_t n) {
+  uint8_t count = fifoCount();
+  if (count > n) count = n;
+  uint16_t values = (uint16_t)count * 3;
+
+  if (_cs == -1) {
+    // i2c, in as many transactions as the Wire buffer needs
+#ifdef BUFFER_LENGTH
+    const uint8_t chunk = BUFFER_LENGTH / 6;
+#else
+    const uint8_t chunk = 5;
+#endif
+    for (uint8_t done = 0; done < count; ) {
+      uint8_t samples = min(chunk, (uint8_t)(count - done));
+      Wire.beginTransmission(_i2caddr);
+      Wire.write(LIS3DH_REG_OUT_X_L | 0x80); // 0x80 for autoincrement
+      Wire.endTransmission();
+
+      Wire.requestFrom(_i2caddr, samples * 6);
+      for (uint8_t i = 0; i < samples * 3; i++) {
+        uint16_t v = Wire.read(); v |= ((uint16_t)Wire.read()) << 8;
+        *xyz++ = v;
+      }
+      done += samples;
+    }
+  }
+  #ifndef __AVR_ATtiny85__
+  else {
+#if SPI_HAS_TRANSACTION
+    if (_sck == -1)
+      SPI.beginTransaction(SPISettings(500000, MSBFIRST, SPI_MODE0));
+#endif
+    digitalWrite(_cs, LOW);
+    spixfer(LIS3DH_REG_OUT_X_L | 0x80 | 0x40); // read multiple, bit 7&6 high
+
+    for (uint16_t i = 0; i < values; i++) {
+      uint16_t v = spixfer(); v |= ((uint16_t)spixfer()) << 8;
+      *xyz++ = v;
+    }
+
+    digitalWrite(_cs, HIGH);
+#if SPI_HAS_TRANSACTION
+    if (_sck == -1)
+      SPI.endTransaction();              // release the SPI bus
+#endif
+  }
+  #endif
+
+  return count;
+}
 
 /**************************************************************************/
 /*!
@@ -340,7 +438,7 @@ lis3dh_dataRate_t Adafruit_CPlay_LIS3DH::getDataRate(void)
 /*!
     @brief  Gets the most recent sensor event
     @param event the pointer to place the event reading in
-    @return none
+    @return true
 */
 /**************************************************************************/
 bool Adafruit_CPlay_LIS3DH::getEvent(sensors_event_t *event) {
@@ -357,6 +455,87 @@ bool Adafruit_CPlay_LIS3DH::getEvent(sensors_event_t *event) {
   event->acceleration.x = x_g * SENSORS_GRAVITY_STANDARD;
   event->acceleration.y = y_g * SENSORS_GRAVITY_STANDARD;
   event->acceleration.z = z_g * SENSORS_GRAVITY_STANDARD;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets up to n sensor events.  With the FIFO on (see setFifo())
+      this is every reading waiting in it, up to n, else the latest one.
+    @param events the array to place the event readings in
+    @param n the size of the array
+    @return the number of events filled in
+*/
+/**************************************************************************/
+size_t Adafruit_CPlay_LIS3DH::getEvents(sensors_event_t *events, size_t n) {
+  if (!_fifo) return Adafruit_Sensor::getEvents(events, n);
+
+  sensors_sample_t samples[8];
+  size_t got = 0;
+  while (got < n) {
+    size_t want = min(n - got, sizeof(samples) / sizeof(samples[0]));
+    size_t read = getSamples(samples, want);
+    for (size_t i = 0; i < read; i++, got++) {
+      sensors_event_t *event = &events[got];
+      memset(event, 0, sizeof(sensors_event_t));
+      event->version        = sizeof(sensors_event_t);
+      event->sensor_id      = _sensorID;
+      event->type           = SENSOR_TYPE_ACCELEROMETER;
+      event->timestamp      = samples[i].timestamp;
+      event->acceleration.x = samples[i].data[0];
+      event->acceleration.y = samples[i].data[1];
+      event->acceleration.z = samples[i].data[2];
+    }
+    if (read < want) break;
+  }
+  return got;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Gets up to n readings as compact samples, x, y, z in m/s^2.
+      With the FIFO on (see setFifo()) this is every reading waiting in
+      it, up to n, read in bursts; else the latest one.
+    @param samples the array to place the readings in
+    @param n the size of the array
+    @return the number of samples filled in
+*/
+/**************************************************************************/
+size_t Adafruit_CPlay_LIS3DH::getSamples(sensors_sample_t *samples, size_t n) {
+  if (!_fifo) return Adafruit_Sensor::getSamples(samples, n);
+
+  float   scale = SENSORS_GRAVITY_STANDARD / rangeDivider();
+  int16_t raw[3 * 8];
+  size_t  got = 0;
+  while (got < n) {
+    uint8_t want = min(n - got, sizeof(raw) / sizeof(raw[0]) / 3);
+    uint8_t read = readFifo(raw, want);
+    for (uint8_t i = 0; i < read; i++, got++) {
+      samples[got].timestamp = 0;
+      samples[got].data[0]   = raw[3 * i]     * scale;
+      samples[got].data[1]   = raw[3 * i + 1] * scale;
+      samples[got].data[2]   = raw[3 * i + 2] * scale;
+    }
+    if (read < want) break;
+  }
+  return got;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Get the number to divide raw readings by for G at the current
+      range
+    @return the divider
+*/
+/**************************************************************************/
+uint16_t Adafruit_CPlay_LIS3DH::rangeDivider(void) {
+  uint8_t range = getRange();
+  uint16_t divider = 1;
+  if (range == LIS3DH_RANGE_16_G) divider = 1365;
+  if (range == LIS3DH_RANGE_8_G) divider = 4096;
+  if (range == LIS3DH_RANGE_4_G) divider = 8190;
+  if (range == LIS3DH_RANGE_2_G) divider = 16380;
+  return divider;
 }
 
 /**************************************************************************/
@@ -151,10 +151,16 @@ class Adafruit_CPlay_LIS3DH : public Adafruit_Sensor {
 
   bool getEvent(sensors_event_t *event);
   void getSensor(sensor_t *sensor);
+  size_t getEvents(sensors_event_t *events, size_t n);
+  size_t getSamples(sensors_sample_t *samples, size_t n);
 
   void setClick(uint8_t c, uint8_t clickthresh, uint8_t timelimit = 10, uint8_t timelatency = 20, uint8_t timewindow = 255);
   uint8_t getClick(void);
 
+  void setFifo(uint8_t watermark);
+  uint8_t fifoCount(void);
+  uint8_t readFifo(int16_t *xyz, uint8_t n);
+
 /**************************************************************************/
 /*! 
     @brief  integer axis readings
@@ -178,12 +184,14 @@ class Adafruit_CPlay_LIS3DH : public Adafruit_Sensor {
   uint8_t readRegister8(uint8_t reg);
   void writeRegister8(uint8_t reg, uint8_t value);
   uint8_t spixfer(uint8_t x = 0xFF);
+  uint16_t rangeDivider(void);
 
   // SPI
   int8_t _cs, _mosi, _miso, _sck;
 
   int8_t  _i2caddr;
   int32_t _sensorID;
+  bool    _fifo;
 };
 
 #endif
@@ -5,6 +5,7 @@
 
 #include <Arduino.h>
 #include "Adafruit_CPlay_Mic.h"
+#include "CPlay_DMA.h"
 
 #if defined(ARDUINO_ARCH_SAMD)
 
@@ -22,6 +23,216 @@ uint16_t sincfilter[DECIMATION] = {0, 2, 9, 21, 39, 63, 94, 132, 179, 236, 302,
 
 static bool pdmConfigured = false;
 
+/**************************************************************************/
+/*!
+    @brief  Filter and decimate 64 PDM bits (the low halves of 4 words read
+            from the I2S) down to one 10-bit audio sample.
+    @param words the 4 words, oldest first
+    @return the sample, close to 0-offset signed
+*/
+/**************************************************************************/
+static int16_t pdmToSample(const uint32_t *words) {
+  uint16_t runningsum = 0;
+  uint16_t *sinc_ptr = sincfilter;
+
+  for (uint8_t samplenum=0; samplenum < (DECIMATION/16) ; samplenum++) {
+     uint16_t sample = words[samplenum] & 0xFFFF; // by default the low half
+
+     ADAPDM_REPEAT_LOOP_16(      // manually unroll loop: for (int8_t b=0; b<16; b++)
+       {
+         // start at the LSB which is the 'first' bit to come down the line, chronologically
+         // (Note we had to set I2S_SERCTRL_BITREV to get this to work, but saves us time!)
+         if (sample & 0x1) {
+           runningsum += *sinc_ptr;     // do the convolution
+         }
+         sinc_ptr++;
+         sample >>= 1;
+      }
+    )
+  }
+
+  runningsum /= 64 ; // convert 16 bit -> 10 bit
+  runningsum -= 512;  // make it close to 0-offset signed
+  return runningsum;
+}
+
+// Streaming: the DMAC fills two blocks of raw PDM words in turn (ping-pong),
+// each worth half an FFT.  Every finished block is decimated onto the end of
+// a sliding window of the last CPLAY_MIC_FFT_N samples, so consecutive
+// spectra overlap by half and come out at SAMPLERATE_HZ / MIC_HOP per second.
+#define MIC_HOP       (CPLAY_MIC_FFT_N / 2)           // New samples per spectrum
+#define MIC_HOP_WORDS (MIC_HOP * (DECIMATION / 16))   // PDM words per block
+#define MIC_FFT_LOG2  8
+
+static uint32_t *micRaw     = NULL; // [2][MIC_HOP_WORDS] DMA ping-pong blocks
+static int16_t  *micHistory = NULL; // [CPLAY_MIC_FFT_N] latest samples
+static uint8_t   micNextBlock;      // Block the DMAC should finish next
+static uint16_t  micOverruns;
+static bool      micFresh;          // History changed since last spectrum
+static DmacDescriptor micDesc1 __attribute__ ((aligned (16)));
+
+// The sound level is the RMS over the last MIC_SPL_BLOCKS blocks (46 mS).
+// Each block's sum and sum of squares are kept, along with running totals
+// over the ring, so a new block costs a subtraction and an addition and a
+// reading costs nothing more than a logarithm.
+#define MIC_SPL_BLOCKS 8
+static int32_t   micBlockSum[MIC_SPL_BLOCKS];
+static uint32_t  micBlockSq[MIC_SPL_BLOCKS];
+static int32_t   micSum;
+static uint32_t  micSq;
+static uint8_t   micSplBlock;       // Oldest entry in the ring
+
+// Quarter wave of sin() in Q15, for the FFT twiddle factors.
+static const int16_t fftSine[CPLAY_MIC_FFT_N / 4 + 1] = {
+  0, 804, 1608, 2410, 3212, 4011, 4808, 5602, 6393, 7179, 7962, 8739, 9512,
+  10278, 11039, 11793, 12539, 13279, 14010, 14732, 15446, 16151, 16846,
+  17530, 18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594, 23170,
+  23731, 24279, 24811, 25329, 25832, 26319, 26790, 27245, 27683, 28105,
+  28510, 28898, 29268, 29621, 29956, 30273, 30571, 30852, 31113, 31356,
+  31580, 31785, 31971, 32137, 32285, 32412, 32521, 32609, 32678, 32728,
+  32757, 32767
+};
+
+// First half of a Hann window in Q15; the second half is its mirror image.
+static const int16_t fftWindow[CPLAY_MIC_FFT_N / 2] = {
+  0, 5, 20, 45, 80, 124, 179, 243, 317, 401, 495, 598, 711, 833, 965, 1106,
+  1257, 1416, 1585, 1763, 1949, 2145, 2349, 2561, 2782, 3011, 3249, 3494,
+  3747, 4008, 4276, 4552, 4834, 5124, 5421, 5724, 6034, 6350, 6672, 7000,
+  7334, 7673, 8018, 8367, 8722, 9081, 9444, 9812, 10184, 10559, 10938, 11321,
+  11706, 12094, 12485, 12879, 13274, 13671, 14070, 14470, 14872, 15274,
+  15677, 16081, 16484, 16888, 17291, 17694, 18096, 18497, 18897, 19295,
+  19691, 20085, 20477, 20867, 21254, 21638, 22019, 22396, 22770, 23139,
+  23505, 23866, 24223, 24575, 24922, 25264, 25601, 25932, 26257, 26576,
+  26889, 27195, 27495, 27789, 28075, 28354, 28626, 28891, 29148, 29397,
+  29638, 29871, 30096, 30313, 30521, 30721, 30912, 31094, 31267, 31432,
+  31587, 31732, 31869, 31996, 32114, 32222, 32320, 32409, 32488, 32557,
+  32617, 32666, 32706, 32736, 32756, 32766
+};
+
+/**************************************************************************/
+/*!
+    @brief  In-place radix-2 FFT of CPLAY_MIC_FFT_N Q15 points.  Each stage
+            halves its results to keep them in range, so the output is the
+            DFT divided by CPLAY_MIC_FFT_N.
+    @param re the real parts
+    @param im the imaginary parts
+*/
+/**************************************************************************/
+static void fftQ15(int16_t *re, int16_t *im) {
+  const uint16_t n = CPLAY_MIC_FFT_N;
+
+  for(uint16_t i=1, j=0; i<n; i++) { // Bit-reversed reordering
+    uint16_t bit = n >> 1;
+    for(; j & bit; bit >>= 1) j ^= bit;
+    j ^= bit;
+    if(i < j) {
+      int16_t t;
+      t = re[i]; re[i] = re[j]; re[j] = t;
+      t = im[i]; im[i] = im[j]; im[j] = t;
+    }
+  }
+
+  for(uint16_t len=2; len<=n; len<<=1) {
+    uint16_t half = len >> 1, step = n / len;
+    for(uint16_t k=0; k<half; k++) {
+      uint16_t w = k * step;           // Twiddle e^(-2*pi*i*w/n), w < n/2
+      int32_t  c, s;
+      if(w <= n/4) {
+        c =  fftSine[n/4 - w];
+        s =  fftSine[w];
+      } else {
+        c = -fftSine[w - n/4];
+        s =  fftSine[n/2 - w];
+      }
+      for(uint16_t a=k; a<n; a+=len) {
+        uint16_t b  = a + half;
+        int32_t  tr = (re[b] * c + im[b] * s) >> 15,
+                 ti = (im[b] * c - re[b] * s) >> 15;
+        re[b] = (re[a] - tr) >> 1;
+        im[b] = (im[a] - ti) >> 1;
+        re[a] = (re[a] + tr) >> 1;
+        im[a] = (im[a] + ti) >> 1;
+      }
+    }
+  }
+}
+
+/**************************************************************************/
+/*!
+    @brief  Fixed-point base 2 logarithm, good to about 1/11 (0.26 dB).
+    @param x the value, more than 0
+    @return log2(x) * 256
+*/
+/**************************************************************************/
+static uint16_t log2Q8(uint32_t x) {
+  static const uint8_t mantissa[16] = {
+    0, 22, 44, 63, 82, 100, 118, 134, 150, 165, 179, 193, 207, 220, 232, 244 };
+  uint8_t msb = 31;
+  while(!(x & (1UL << msb))) msb--;
+  uint8_t top = (msb >= 4) ? (x >> (msb - 4)) & 0x0F : (x << (4 - msb)) & 0x0F;
+  return ((uint16_t)msb << 8) + mantissa[top];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Take in the block the DMAC finished, if there is one: decimate
+            it onto the end of the sample history and add it to the sound
+            level totals.
+    @return true if a block was taken in
+*/
+/**************************************************************************/
+static bool micIntake(void) {
+  if(!micRaw || !cplayDMABlockDone(CPLAY_DMA_MIC)) return false;
+
+  // The block being filled is the one the write-back descriptor points
+  // into; the other one is complete.
+  uint32_t dst   = cplayDMAWriteback(CPLAY_DMA_MIC)->DSTADDR.reg;
+  uint8_t  block = (dst == (uint32_t)(micRaw + MIC_HOP_WORDS)) ? 1 : 0;
+  if(block != micNextBlock) micOverruns++; // Missed one; use the newest
+  micNextBlock = block ^ 1;
+
+  int32_t  sum = 0;
+  uint32_t sq  = 0;
+  memmove(micHistory, micHistory + MIC_HOP, MIC_HOP * sizeof(int16_t));
+  const uint32_t *words = micRaw + block * MIC_HOP_WORDS;
+  for(uint16_t i=0; i<MIC_HOP; i++, words += DECIMATION/16) {
+    int16_t sample = pdmToSample(words);
+    micHistory[MIC_HOP + i] = sample;
+    sum += sample;
+    sq  += (int32_t)sample * sample;
+  }
+
+  micSum += sum - micBlockSum[micSplBlock];
+  micSq  += sq  - micBlockSq[micSplBlock];
+  micBlockSum[micSplBlock] = sum;
+  micBlockSq[micSplBlock]  = sq;
+  if(++micSplBlock >= MIC_SPL_BLOCKS) micSplBlock = 0;
+  micFresh = true;
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Integer square root.
+    @param x the value
+    @return floor(sqrt(x))
+*/
+/**************************************************************************/
+static uint16_t isqrt32(uint32_t x) {
+  uint32_t root = 0, bit = 1UL << 30;
+  while(bit > x) bit >>= 2;
+  while(bit) {
+    if(x >= root + bit) {
+      x   -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
 #endif
 
 #define DC_OFFSET       (1023 / 3)
@@ -117,33 +328,14 @@ void Adafruit_CPlay_Mic::capture(int16_t *buf, uint16_t nSamples) {
 
   int16_t *ptr = buf;
   while(ptr < (buf + nSamples)){
-    uint16_t runningsum = 0;
-    uint16_t *sinc_ptr = sincfilter;
-
-    for (uint8_t samplenum=0; samplenum < (DECIMATION/16) ; samplenum++) {
-       uint16_t sample = pdm.read() & 0xFFFF;    // we read 16 bits at a time, by default the low half
-
-       ADAPDM_REPEAT_LOOP_16(      // manually unroll loop: for (int8_t b=0; b<16; b++) 
-         {
-           // start at the LSB which is the 'first' bit to come down the line, chronologically 
-           // (Note we had to set I2S_SERCTRL_BITREV to get this to work, but saves us time!)
-           if (sample & 0x1) {
-             runningsum += *sinc_ptr;     // do the convolution
-           }
-           sinc_ptr++;
-           sample >>= 1;
-        }
-      )
-    }
+    uint32_t words[DECIMATION/16];
 
     // since we wait for the samples from I2S peripheral, we dont need to delay, we will 'naturally'
     // wait the right amount of time between analog writes
-    //Serial.println(runningsum);
-    
-    runningsum /= 64 ; // convert 16 bit -> 10 bit
-    runningsum -= 512;  // make it close to 0-offset signed
-
-    *ptr++ = runningsum;
+    for (uint8_t samplenum=0; samplenum < (DECIMATION/16) ; samplenum++) {
+      words[samplenum] = pdm.read();
+    }
+    *ptr++ = pdmToSample(words);
   }
 #else
   #error "no compatible architecture defined."
@@ -249,3 +441,142 @@ void Adafruit_CPlay_Mic::fft(
     fft_output(butterfly, spectrum); // Complex -> spectrum (32 bins)
   }
 }
+
+#if defined(ARDUINO_ARCH_SAMD)
+/**************************************************************************/
+/*!
+    @brief  SAMD ONLY: Start capturing the microphone continuously by DMA,
+      for streamSpectrum().  The CPU is free until a spectrum is asked for.
+      Needs about 5 KB free RAM.  Don't use capture() or
+      soundPressureLevel() until stopStream() is called.
+    @return true if capture has started
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Mic::startStream(void) {
+  stopStream();
+  if(!pdmConfigured){
+    pdm.begin();
+    pdm.configure(SAMPLERATE_HZ * DECIMATION / 16, true);
+    pdmConfigured = true;
+  }
+
+  micRaw     = (uint32_t *)malloc(2 * MIC_HOP_WORDS * sizeof(uint32_t));
+  micHistory = (int16_t *)malloc(CPLAY_MIC_FFT_N * sizeof(int16_t));
+  if(!micRaw || !micHistory) {
+    stopStream();
+    return false;
+  }
+  memset(micHistory, 0, CPLAY_MIC_FFT_N * sizeof(int16_t));
+  micNextBlock = 0;
+  micOverruns  = 0;
+  micFresh     = false;
+  memset(micBlockSum, 0, sizeof(micBlockSum));
+  memset(micBlockSq, 0, sizeof(micBlockSq));
+  micSum       = 0;
+  micSq        = 0;
+  micSplBlock  = 0;
+
+  // Two descriptors chained into a loop, each filling one block and
+  // flagging its end.  Destination addresses are the ends of the blocks.
+  uint8_t ser = pdm.getSerializer();
+  DmacDescriptor *desc0 = cplayDMAChannel(CPLAY_DMA_MIC, I2S_DMAC_ID_RX_0 + ser);
+  desc0->BTCTRL.reg    = DMAC_BTCTRL_VALID |
+                         DMAC_BTCTRL_BEATSIZE_WORD |
+                         DMAC_BTCTRL_DSTINC |
+                         DMAC_BTCTRL_BLOCKACT_INT;
+  desc0->BTCNT.reg     = MIC_HOP_WORDS;
+  desc0->SRCADDR.reg   = (uint32_t)&I2S->DATA[ser].reg;
+  desc0->DSTADDR.reg   = (uint32_t)(micRaw + MIC_HOP_WORDS);
+  desc0->DESCADDR.reg  = (uint32_t)&micDesc1;
+  micDesc1             = *desc0;
+  micDesc1.DSTADDR.reg = (uint32_t)(micRaw + 2 * MIC_HOP_WORDS);
+  micDesc1.DESCADDR.reg = (uint32_t)desc0;
+  cplayDMAStart(CPLAY_DMA_MIC);
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  SAMD ONLY: Stop the capture started by startStream() and free
+      its buffers.
+*/
+/**************************************************************************/
+void Adafruit_CPlay_Mic::stopStream(void) {
+  if(micRaw) cplayDMAStop(CPLAY_DMA_MIC);
+  free(micRaw);
+  free(micHistory);
+  micRaw     = NULL;
+  micHistory = NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  SAMD ONLY: Windowed FFT of the latest CPLAY_MIC_FFT_N samples
+      from startStream(), if half of them are new since the last one.
+      Spectra come every MIC_HOP samples (about 172 per second) and overlap
+      by half.  Output is CPLAY_MIC_BINS magnitudes, each covering 86 Hz
+      from 0 to 11 KHz.  Call it at least every 5 mS or blocks are lost;
+      see streamOverruns().  Needs about 1 KB of stack.  Also keeps
+      streamSoundPressureLevel() up to date.
+    @param spectrum the buffer to store the results in, uint16_t[CPLAY_MIC_BINS]
+    @return true if spectrum was filled in, false if there is nothing new yet
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Mic::streamSpectrum(uint16_t *spectrum) {
+  micIntake();
+  if(!micFresh) return false;
+  micFresh = false;
+
+  int16_t re[CPLAY_MIC_FFT_N], im[CPLAY_MIC_FFT_N];
+  for(uint16_t i=0; i<CPLAY_MIC_FFT_N/2; i++) {
+    // 10-bit samples are scaled up by 32 to use the Q15 range
+    re[i] = ((int32_t)micHistory[i] * 32 * fftWindow[i]) >> 15;
+    re[CPLAY_MIC_FFT_N-1-i] =
+      ((int32_t)micHistory[CPLAY_MIC_FFT_N-1-i] * 32 * fftWindow[i]) >> 15;
+  }
+  memset(im, 0, sizeof(im));
+  fftQ15(re, im);
+
+  for(uint16_t i=0; i<CPLAY_MIC_BINS; i++) {
+    spectrum[i] = isqrt32((uint32_t)((int32_t)re[i] * re[i]) +
+                          (uint32_t)((int32_t)im[i] * im[i]));
+  }
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  SAMD ONLY: Count of blocks dropped because streamSpectrum()
+      wasn't called in time, since startStream().
+    @return the number of blocks
+*/
+/**************************************************************************/
+uint16_t Adafruit_CPlay_Mic::streamOverruns(void) const {
+  return micOverruns;
+}
+
+/**************************************************************************/
+/*!
+    @brief  SAMD ONLY: Sound pressure level over the last 46 mS captured by
+      startStream(), on the same scale as soundPressureLevel() but from the
+      RMS rather than the peak, and without floating point or waiting for
+      a capture.  Takes in any block the DMAC has finished; call it (or
+      streamSpectrum()) at least every 5 mS to keep the window complete.
+    @returns Sound Pressure Level in tenths of a db SPL, 520 for silence
+*/
+/**************************************************************************/
+uint16_t Adafruit_CPlay_Mic::streamSoundPressureLevel(void) {
+  micIntake();
+
+  // Variance about the window's own mean, which removes the DC offset.
+  const uint16_t n = MIC_SPL_BLOCKS * MIC_HOP;
+  uint32_t dc2 = ((int64_t)micSum * micSum) / n;
+  if(micSq < dc2 + n) return 520;    // Less than 1 count RMS
+  uint32_t var = (micSq - dc2) / n;
+
+  // 20 * log10(rms) = 10 * log10(var) = 3.0103 * log2(var), in tenths;
+  // then 52.9 dB for the mic gain (9 / 1023 / 20 uPa), as in
+  // soundPressureLevel().
+  return 529 + (((uint32_t)log2Q8(var) * 7706) >> 16);
+}
+#endif
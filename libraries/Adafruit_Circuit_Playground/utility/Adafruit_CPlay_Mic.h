@@ -17,6 +17,11 @@
 
 #include "Adafruit_ZeroPDM.h"
 
+#if defined(ARDUINO_ARCH_SAMD)
+#define CPLAY_MIC_FFT_N 256                   ///< samples per streamed spectrum
+#define CPLAY_MIC_BINS  (CPLAY_MIC_FFT_N / 2) ///< bins in a streamed spectrum
+#endif
+
 
 /**************************************************************************/
 /*! 
@@ -32,6 +37,14 @@ class Adafruit_CPlay_Mic {
 
   float soundPressureLevel(uint16_t ms);
 
+#if defined(ARDUINO_ARCH_SAMD)
+  bool     startStream(void),
+           streamSpectrum(uint16_t *spectrum);
+  void     stopStream(void);
+  uint16_t streamOverruns(void) const,
+           streamSoundPressureLevel(void);
+#endif
+
 private:
 #if defined(ARDUINO_ARCH_SAMD)
   static Adafruit_ZeroPDM pdm;
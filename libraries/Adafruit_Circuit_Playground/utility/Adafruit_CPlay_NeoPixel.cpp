@@ -33,6 +33,7 @@
   -------------------------------------------------------------------------*/
 
 #include "Adafruit_CPlay_NeoPixel.h"
+#include "CPlay_DMA.h"
 
 /**************************************************************************/
 /*! 
@@ -44,6 +45,9 @@
 /**************************************************************************/
 Adafruit_CPlay_NeoPixel::Adafruit_CPlay_NeoPixel(uint16_t n, uint8_t p, neoPixelType t) :
   begun(false), brightness(0), pixels(NULL), endTime(0)
+#ifdef __SAMD21G18A__
+  , dmaBuf(NULL), dmaBytes(0)
+#endif
 {
   updateType(t);
   updateLength(n);
@@ -69,10 +73,14 @@ Adafruit_CPlay_NeoPixel::Adafruit_CPlay_NeoPixel() :
   is800KHz(true),
   begun(false), numLEDs(0), numBytes(0), pin(-1), brightness(0), pixels(NULL),
   rOffset(1), gOffset(0), bOffset(2), wOffset(1), endTime(0)
+#ifdef __SAMD21G18A__
+  , dmaBuf(NULL), dmaBytes(0)
+#endif
 {
 }
 
 Adafruit_CPlay_NeoPixel::~Adafruit_CPlay_NeoPixel() {
+  useDMA(false);
   if(pixels)   free(pixels);
   if(pin >= 0) pinMode(pin, INPUT);
   pixels = NULL;
@@ -108,6 +116,12 @@ void Adafruit_CPlay_NeoPixel::updateLength(uint16_t n) {
   } else {
     numLEDs = numBytes = 0;
   }
+#ifdef __SAMD21G18A__
+  if(dmaBuf) { // Resize the bit pattern buffer to match
+    useDMA(false);
+    useDMA(true);
+  }
+#endif
 }
 
 /**************************************************************************/
@@ -136,13 +150,47 @@ void Adafruit_CPlay_NeoPixel::updateType(neoPixelType t) {
 /**************************************************************************/
 /*! 
     @brief  Write data to the neopixels
-    @note this disables interrupts on the chip until the write is complete.
+    @note this disables interrupts on the chip until the write is complete,
+          unless useDMA() has been turned on.
 */
 /**************************************************************************/
 void Adafruit_CPlay_NeoPixel::show(void) {
 
   if(!pixels) return;
 
+#ifdef __SAMD21G18A__
+  if(dmaBuf) {
+    // Each data bit goes out as three SPI bits, 100 for a 0 and 110 for a
+    // 1, so at 2.4 MHz (1.2 MHz for 400 KHz pixels) a bit lasts 1.25 uS.
+    // The DMAC feeds them to the SERCOM on its own, leaving interrupts on.
+    // The zero bytes at the end of the buffer hold the line low for the
+    // latch, so the transfer finishing (see canShow()) means it's done.
+    static const uint16_t nibbleBits[16] = {
+      0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+      0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6 };
+    uint8_t baud = is800KHz ? 9 : 19; // 48 MHz / (2 * (BAUD + 1))
+
+    while(!canShow());
+    if(SERCOM5->SPI.BAUD.reg != baud) {
+      SERCOM5->SPI.CTRLA.bit.ENABLE = 0;
+      while(SERCOM5->SPI.SYNCBUSY.bit.ENABLE);
+      SERCOM5->SPI.BAUD.reg = baud;
+      SERCOM5->SPI.CTRLA.bit.ENABLE = 1;
+      while(SERCOM5->SPI.SYNCBUSY.bit.ENABLE);
+    }
+    uint8_t *out = dmaBuf;
+    for(uint16_t i=0; i<numBytes; i++) {
+      uint32_t bits = ((uint32_t)nibbleBits[pixels[i] >> 4] << 12) |
+                      nibbleBits[pixels[i] & 0x0F];
+      *out++ = bits >> 16;
+      *out++ = bits >>  8;
+      *out++ = bits;
+    }
+    cplayDMAStart(CPLAY_DMA_NEOPIXEL);
+    return;
+  }
+#endif
+
   // Data latch = 50+ microsecond pause in the output stream.  Rather than
   // put a delay at the end of the function, the ending time is noted and
   // the function will simply hold off (if needed) on issuing the
@@ -435,6 +483,10 @@ void Adafruit_CPlay_NeoPixel::show(void) {
 */
 /**************************************************************************/
 void Adafruit_CPlay_NeoPixel::setPin(uint8_t p) {
+#ifdef __SAMD21G18A__
+  boolean dma = (dmaBuf != NULL);
+  useDMA(false);
+#endif
   if(begun && (pin >= 0)) pinMode(pin, INPUT);
     pin = p;
     if(begun) {
@@ -445,8 +497,103 @@ void Adafruit_CPlay_NeoPixel::setPin(uint8_t p) {
     port    = portOutputRegister(digitalPinToPort(p));
     pinMask = digitalPinToBitMask(p);
 #endif
+#ifdef __SAMD21G18A__
+    if(dma) useDMA(true);
+#endif
 }
 
+#ifdef __SAMD21G18A__
+// The Express's NeoPixels are on PB23, which is pad 3 of SERCOM5 on
+// peripheral function D. The SPI data out is put on that pad, and the
+// clock pad is left unconnected.
+#define NEO_DMA_PORT   PORTB
+#define NEO_DMA_PIN    23
+#define NEO_DMA_LATCH  18 // Zero bytes after the data: 60 uS at 2.4 MHz
+#endif
+
+/**************************************************************************/
+/*!
+    @brief  Send the data out with DMA instead of bit-banging it.
+            show() then no longer disables interrupts while the pixels
+            are written, and returns while they are still being sent.
+            Only available on the Circuit Playground Express, where it
+            claims SERCOM5 and a DMA channel and uses 3 bytes of RAM per
+            pixel byte.
+    @param on true to use DMA, false to go back to bit-banging
+    @return true if the pixels are now sent the requested way
+*/
+/**************************************************************************/
+boolean Adafruit_CPlay_NeoPixel::useDMA(boolean on) {
+#ifdef __SAMD21G18A__
+  if(dmaBuf) { // Finish off and hand the pin back to the PORT
+    while(dmaBusy());
+    cplayDMAStop(CPLAY_DMA_NEOPIXEL);
+    SERCOM5->SPI.CTRLA.bit.ENABLE = 0;
+    while(SERCOM5->SPI.SYNCBUSY.bit.ENABLE);
+    PORT->Group[NEO_DMA_PORT].PINCFG[NEO_DMA_PIN].bit.PMUXEN = 0;
+    free(dmaBuf);
+    dmaBuf   = NULL;
+    dmaBytes = 0;
+  }
+  if(!on) return true;
+
+  if((pin < 0) ||
+     (g_APinDescription[pin].ulPort != NEO_DMA_PORT) ||
+     (g_APinDescription[pin].ulPin  != NEO_DMA_PIN)) return false;
+  dmaBytes = numBytes * 3 + NEO_DMA_LATCH;
+  if(!(dmaBuf = (uint8_t *)malloc(dmaBytes))) {
+    dmaBytes = 0;
+    return false;
+  }
+  memset(dmaBuf, 0, dmaBytes);
+
+  PM->APBCMASK.reg |= PM_APBCMASK_SERCOM5;
+  GCLK->CLKCTRL.reg = GCLK_CLKCTRL_ID_SERCOM5_CORE |
+                      GCLK_CLKCTRL_GEN_GCLK0 |
+                      GCLK_CLKCTRL_CLKEN;
+  while(GCLK->STATUS.bit.SYNCBUSY);
+  SERCOM5->SPI.CTRLA.bit.SWRST = 1;
+  while(SERCOM5->SPI.CTRLA.bit.SWRST || SERCOM5->SPI.SYNCBUSY.bit.SWRST);
+  SERCOM5->SPI.CTRLA.reg = SERCOM_SPI_CTRLA_MODE_SPI_MASTER |
+                           SERCOM_SPI_CTRLA_DOPO(2); // DO on pad 3, MSB first
+  SERCOM5->SPI.CTRLB.reg = 0;                        // 8 bits, no receive
+  while(SERCOM5->SPI.SYNCBUSY.bit.CTRLB);
+  SERCOM5->SPI.BAUD.reg  = is800KHz ? 9 : 19;
+  SERCOM5->SPI.CTRLA.bit.ENABLE = 1;
+  while(SERCOM5->SPI.SYNCBUSY.bit.ENABLE);
+
+  PORT->Group[NEO_DMA_PORT].PMUX[NEO_DMA_PIN >> 1].bit.PMUXO =
+    PORT_PMUX_PMUXO_D_Val;
+  PORT->Group[NEO_DMA_PORT].PINCFG[NEO_DMA_PIN].bit.PMUXEN = 1;
+
+  DmacDescriptor *desc = cplayDMAChannel(CPLAY_DMA_NEOPIXEL,
+                                         SERCOM5_DMAC_ID_TX);
+  desc->BTCTRL.reg   = DMAC_BTCTRL_VALID |
+                       DMAC_BTCTRL_BEATSIZE_BYTE |
+                       DMAC_BTCTRL_SRCINC |
+                       DMAC_BTCTRL_BLOCKACT_NOACT;
+  desc->BTCNT.reg    = dmaBytes;
+  desc->SRCADDR.reg  = (uint32_t)(dmaBuf + dmaBytes); // End, as it increments
+  desc->DSTADDR.reg  = (uint32_t)&SERCOM5->SPI.DATA.reg;
+  desc->DESCADDR.reg = 0;
+  return true;
+#else
+  return !on;
+#endif
+}
+
+#ifdef __SAMD21G18A__
+/**************************************************************************/
+/*!
+    @brief  Check whether a DMA transfer (and so its latch) is still running.
+    @return true if show() must wait before writing new data
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_NeoPixel::dmaBusy(void) const {
+  return cplayDMABusy(CPLAY_DMA_NEOPIXEL);
+}
+#endif
+
 /**************************************************************************/
 /*! 
     @brief  Set pixel color from separate R,G,B components:
@@ -121,6 +121,8 @@ class Adafruit_CPlay_NeoPixel {
     clear(),
     updateLength(uint16_t n),
     updateType(neoPixelType t);
+  boolean
+    useDMA(boolean on);
   uint8_t
    *getPixels(void) const,
     getBrightness(void) const,
@@ -141,7 +143,12 @@ class Adafruit_CPlay_NeoPixel {
 */
 /**************************************************************************/
   inline bool
-    canShow(void) { return (micros() - endTime) >= 50L; }
+    canShow(void) {
+#ifdef __SAMD21G18A__
+      if(dmaBuf) return !dmaBusy();
+#endif
+      return (micros() - endTime) >= 50L;
+    }
 
  private:
 
@@ -170,6 +177,14 @@ class Adafruit_CPlay_NeoPixel {
   uint8_t
     pinMask;       ///< Output PORT bitmask
 #endif
+#ifdef __SAMD21G18A__
+  uint8_t
+   *dmaBuf;        ///< SPI bit patterns for 'pixels' + latch, NULL if unused
+  uint16_t
+    dmaBytes;      ///< Size of 'dmaBuf'
+  bool
+    dmaBusy(void) const;
+#endif
 
 };
 
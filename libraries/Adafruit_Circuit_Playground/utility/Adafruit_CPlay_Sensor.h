@@ -121,6 +121,14 @@ typedef struct
     };  ///< union of sensor event data
 } sensors_event_t;
 
+/* Sensor sample (16 bytes) */
+/** struct sensors_sample_s is used to provide one reading without the event header; the sensor_id, type and units are those reported by getSensor(). */
+typedef struct
+{
+    int32_t timestamp;                        ///< time is in milliseconds */
+    float   data[3];                          ///< values, in the units of the matching sensors_event_t field */
+} sensors_sample_t;
+
 /* Sensor details (40 bytes) */
 /** struct sensor_s is used to describe basic information about a specific sensor. */
 typedef struct
@@ -170,6 +178,38 @@ class Adafruit_Sensor {
 */
 /**************************************************************************/
   virtual void getSensor(sensor_t*) = 0;
+
+/**************************************************************************/
+/*! 
+    @brief  get up to n events at once. Sensors that buffer readings
+    override this; by default it returns the latest reading.
+    @param events the array to fill
+    @param n the size of the array
+    @return the number of events filled in, 0 if none was ready
+*/
+/**************************************************************************/
+  virtual size_t getEvents(sensors_event_t* events, size_t n) {
+    return (n && getEvent(events)) ? 1 : 0;
+  }
+
+/**************************************************************************/
+/*! 
+    @brief  get up to n compact samples at once. Sensors that buffer
+    readings override this; by default it returns the latest reading.
+    @param samples the array to fill
+    @param n the size of the array
+    @return the number of samples filled in, 0 if none was ready
+*/
+/**************************************************************************/
+  virtual size_t getSamples(sensors_sample_t* samples, size_t n) {
+    sensors_event_t event;
+    if (!n || !getEvent(&event)) return 0;
+    samples->timestamp = event.timestamp;
+    samples->data[0]   = event.data[0];
+    samples->data[1]   = event.data[1];
+    samples->data[2]   = event.data[2];
+    return 1;
+  }
   
  private:
   bool _autoRange; ///< state of auto-ranging for this sensor. True if enabled, false if disabled
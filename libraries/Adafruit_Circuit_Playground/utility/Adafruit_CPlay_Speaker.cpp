@@ -3,6 +3,31 @@
 
 #include <Arduino.h>
 #include "Adafruit_CPlay_Speaker.h"
+#if !defined(__AVR__)
+#include "CPlay_DMA.h"
+#endif
+
+// Background playback: the play buffer is two halves of CPLAY_SPEAKER_BUF
+// samples.  A timer at the sample rate moves one sample at a time to the
+// output (by interrupt into the PWM on AVR, by DMA into the DAC on SAMD)
+// while update() refills whichever half has just finished.
+static uint16_t            *spkBuf = NULL;
+static cplay_speaker_fill_t spkFill;
+static uint8_t              spkNext; // Half expected to finish next
+static uint8_t              spkLast; // Half holding the end of the sound
+static bool                 spkDry;  // Source has run out
+#ifdef __AVR__
+static volatile uint8_t     spkPos;  // Next sample; both halves fit in 8 bits
+static volatile uint8_t     spkDone; // Bit per half the interrupt finished
+#else
+static DmacDescriptor spkDesc1 __attribute__ ((aligned (16)));
+#endif
+
+// Source for playSoundBackground()
+static const uint8_t *sndData;
+static uint32_t       sndLeft;
+static bool           sndTenBit;
+static uint8_t        sndLoIdx, sndHiBits;
 
 /**************************************************************************/
 /*! 
@@ -59,6 +84,7 @@ void Adafruit_CPlay_Speaker::enable(bool e)  {
 */
 /**************************************************************************/
 void Adafruit_CPlay_Speaker::end(void) {
+  stopPlayback();
   if(started) {
 #ifdef __AVR__
     TCCR4A  = 0; // PWMA off
@@ -86,88 +112,245 @@ void Adafruit_CPlay_Speaker::set(uint8_t value) {
 #endif
 }
 
+#ifdef __AVR__
+ISR(TIMER3_COMPA_vect) {
+  uint8_t pos = spkPos;
+  OCR4A = spkBuf[pos] >> 2;
+  if(++pos == CPLAY_SPEAKER_BUF) {
+    spkDone |= 1;
+  } else if(pos == 2 * CPLAY_SPEAKER_BUF) {
+    spkDone |= 2;
+    pos      = 0;
+  }
+  spkPos = pos;
+}
+#endif
+
 /**************************************************************************/
-/*! 
-    @brief  Plays digitized 8-bit audio (optionally 10 bits on Express board) from
-      a PROGMEM (flash memory) buffer.  Maybe 1-3 seconds tops depending on
-      sampling rate (e.g. 8000 Hz = 8 Kbytes/second).  Max ~20K space avail on
-      Circuit Playground, lots more on Circuit Playground Express.
-      This function currently "blocks" -- it will not play sounds in the
-      background while other code runs.
-    @param data pointer to the audio data to play
-    @param len the length of the data in samples
-    @param sampleRate the sample rate of the data in samples per second
-    @param tenBit Optional flag if true 10-bit mode is enabled. AVR ONLY
+/*!
+    @brief  Fill one half of the play buffer from the source, padding with
+      the idle position once the source has run out.
+    @param half which half, 0 or 1
 */
 /**************************************************************************/
-void Adafruit_CPlay_Speaker::playSound(
-  const uint8_t *data, uint32_t len, uint16_t sampleRate, bool tenBit) {
+static void spkRefill(uint8_t half) {
+  uint16_t *b = spkBuf + half * CPLAY_SPEAKER_BUF;
+  uint16_t  n = 0;
+  if(!spkDry) {
+    n = spkFill(b, CPLAY_SPEAKER_BUF);
+    if(n < CPLAY_SPEAKER_BUF) {
+      spkDry  = true;
+      spkLast = half;
+    }
+  }
+  while(n < CPLAY_SPEAKER_BUF) b[n++] = 512;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start playing samples in the background.  The callback is asked
+      for the first two buffers' worth right away, and for more each time
+      update() finds a half of the buffer has been played.
+      On AVR the sample clock is Timer/Counter 3 (so tone() can't be used
+      alongside), on SAMD it is TC5 pacing DMA into the DAC (so tone() and
+      playTone() must not be called during playback).
+    @param sampleRate the sample rate in samples per second
+    @param fill the callback supplying samples
+    @return true if playback started, false if the buffer couldn't be
+      allocated
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Speaker::startPlayback(
+  uint16_t sampleRate, cplay_speaker_fill_t fill) {
 
-  uint32_t i;
+  stopPlayback();
+  if(!sampleRate || !fill) return false;
+  spkBuf = (uint16_t *)malloc(2 * CPLAY_SPEAKER_BUF * sizeof(uint16_t));
+  if(!spkBuf) return false;
 
   if(!started) begin();
 
+  spkFill = fill;
+  spkDry  = false;
+  spkNext = 0;
+  spkRefill(0);
+  spkRefill(1);
+
 #ifdef __AVR__
-  uint16_t interval = 1000000L / sampleRate;
+  noInterrupts();
+  spkPos  = 0;
+  spkDone = 0;
+  TCCR3A  = 0;
+  TCCR3B  = _BV(WGM32) | _BV(CS30);   // CTC on OCR3A, 1:1 prescale
+  OCR3A   = (F_CPU + sampleRate / 2) / sampleRate - 1;
+  TCNT3   = 0;
+  TIFR3   = _BV(OCF3A);
+  TIMSK3 |= _BV(OCIE3A);
+  interrupts();
 #else
-  uint32_t r2 = sampleRate / 2;
-  uint32_t startTime = micros();
+  analogWriteResolution(10);
+  analogWrite(A0, 512);               // Turns the DAC on
+
+  // Two descriptors chained into a loop, each playing one half and
+  // flagging its end.  Source addresses are the ends of the halves.
+  DmacDescriptor *desc0 = cplayDMAChannel(CPLAY_DMA_SPEAKER, TC5_DMAC_ID_OVF);
+  desc0->BTCTRL.reg     = DMAC_BTCTRL_VALID |
+                          DMAC_BTCTRL_BEATSIZE_HWORD |
+                          DMAC_BTCTRL_SRCINC |
+                          DMAC_BTCTRL_BLOCKACT_INT;
+  desc0->BTCNT.reg      = CPLAY_SPEAKER_BUF;
+  desc0->SRCADDR.reg    = (uint32_t)(spkBuf + CPLAY_SPEAKER_BUF);
+  desc0->DSTADDR.reg    = (uint32_t)&DAC->DATA.reg;
+  desc0->DESCADDR.reg   = (uint32_t)&spkDesc1;
+  spkDesc1              = *desc0;
+  spkDesc1.SRCADDR.reg  = (uint32_t)(spkBuf + 2 * CPLAY_SPEAKER_BUF);
+  spkDesc1.DESCADDR.reg = (uint32_t)desc0;
+  cplayDMAStart(CPLAY_DMA_SPEAKER);
+
+  // TC5 overflowing at the sample rate triggers each DMA beat
+  PM->APBCMASK.reg |= PM_APBCMASK_TC5;
+  GCLK->CLKCTRL.reg = (uint16_t)(GCLK_CLKCTRL_CLKEN |
+                                 GCLK_CLKCTRL_GEN_GCLK0 |
+                                 GCLK_CLKCTRL_ID_TC4_TC5);
+  while(GCLK->STATUS.bit.SYNCBUSY);
+  TC5->COUNT16.CTRLA.reg = TC_CTRLA_SWRST;
+  while(TC5->COUNT16.CTRLA.bit.SWRST);
+  TC5->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 |
+                           TC_CTRLA_WAVEGEN_MFRQ |
+                           TC_CTRLA_PRESCALER_DIV1;
+  TC5->COUNT16.CC[0].reg = (F_CPU + sampleRate / 2) / sampleRate - 1;
+  while(TC5->COUNT16.STATUS.bit.SYNCBUSY);
+  TC5->COUNT16.CTRLA.reg |= TC_CTRLA_ENABLE;
+  while(TC5->COUNT16.STATUS.bit.SYNCBUSY);
 #endif
+  return true;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Keep background playback going: refill any half of the buffer
+      that has finished playing, and stop once the end of the sound has
+      been heard.  Call this from loop() at least once per half buffer
+      (CPLAY_SPEAKER_BUF samples) or the buffer will repeat.
+    @return true while still playing
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Speaker::update(void) {
+  if(!spkBuf) return false;
 
-  if(tenBit) { // 10-bit audio samples?
-    uint8_t loIdx = 4;
 #ifdef __AVR__
-    // Because it uses 8-bit PWM for output, the AVR code must filter
-    // 10-bit data down to 8 bits.  This is ONLY here for compatibility
-    // with sketches with 10-bit samples.  If targeting a project for AVR,
-    // it's best to produce and use optimized 8-bit audio, else it's just
-    // wasted space!  Timer/Counter 4 DOES offer a 10-bit mode, but it's
-    // not used in this library, just not worth it in the limited flash
-    // space of the 32U4 chip.
-    uint16_t idx = 0;
-    uint8_t  hiBits;
-    for(i=0; i<len; i++) {
-      if(++loIdx >= 4) {
-        hiBits = pgm_read_byte(&data[idx++]);
-        loIdx  = 0;
-      }
-      OCR4A    = ((hiBits & 0xC0) | (pgm_read_byte(&data[idx++]) >> 2));
-      hiBits <<= 2; // Do this after write, because of masking op above
-      delayMicroseconds(interval);
-    }
-    OCR4A = 127;
+  for(uint8_t i=0; i<2; i++) {
+    noInterrupts();
+    bool done = spkDone & (1 << spkNext);
+    if(done) spkDone &= ~(1 << spkNext);
+    interrupts();
+    if(!done) break;
+    uint8_t half = spkNext;
 #else
-    // Circuit Playground Express -- use 10-bit analogWrite()
-    uint32_t idx = 0;
-    uint16_t hiBits;
-    analogWriteResolution(10);
-    for(i=0; i<len; i++) {
-      if(++loIdx >= 4) {
-        hiBits = (uint16_t)pgm_read_byte(&data[idx++]);
-        loIdx  = 0;
-      }
-      hiBits <<= 2; // Do this before write, because of masking op below
-      analogWrite(A0, (hiBits & 0x300) | pgm_read_byte(&data[idx++]));
-      while(((micros()-startTime+50)/100) < ((i*10000UL+r2)/sampleRate));
-    }
-    analogWriteResolution(8); // Return to 8 bits for set() compatibility
-    analogWrite(A0, 127);
+  if(cplayDMABlockDone(CPLAY_DMA_SPEAKER)) {
+    // The half being played is the one the write-back descriptor points
+    // into; the other one is finished.
+    uint32_t src  = cplayDMAWriteback(CPLAY_DMA_SPEAKER)->SRCADDR.reg;
+    uint8_t  half = (src == (uint32_t)(spkBuf + CPLAY_SPEAKER_BUF)) ? 1 : 0;
 #endif
+    if(spkDry && (half == spkLast)) {
+      stopPlayback();
+      return false;
+    }
+    spkRefill(half);
+    spkNext = half ^ 1;
+  }
+  return true;
+}
 
-  } else { // 8-bit audio samples
-
+/**************************************************************************/
+/*!
+    @brief  Stop background playback, return the speaker to its idle
+      position and free the play buffer.
+*/
+/**************************************************************************/
+void Adafruit_CPlay_Speaker::stopPlayback(void) {
+  if(!spkBuf) return;
 #ifdef __AVR__
-    for(i=0; i<len; i++) {
-      OCR4A = pgm_read_byte(&data[i]);
-      delayMicroseconds(interval);
-    }
-    OCR4A = 127;
+  TIMSK3 &= ~_BV(OCIE3A);
+  TCCR3B  = 0;
+  OCR4A   = 127;
 #else
-    for(i=0; i<len; i++) {
-      analogWrite(A0, pgm_read_byte(&data[i]));
-      while(((micros()-startTime+50)/100) < ((i*10000UL+r2)/sampleRate));
-    }
-    analogWrite(A0, 127);
+  TC5->COUNT16.CTRLA.reg &= ~TC_CTRLA_ENABLE;
+  while(TC5->COUNT16.STATUS.bit.SYNCBUSY);
+  cplayDMAStop(CPLAY_DMA_SPEAKER);
+  analogWriteResolution(8); // Return to 8 bits for set() compatibility
+  analogWrite(A0, 127);
 #endif
+  free(spkBuf);
+  spkBuf = NULL;
+}
+
+/**************************************************************************/
+/*!
+    @brief  playSoundBackground() source: unpack samples from flash.
+    @param buf where to put the samples
+    @param len how many are wanted
+    @return how many were written
+*/
+/**************************************************************************/
+static uint16_t sndFill(uint16_t *buf, uint16_t len) {
+  uint16_t n;
+  for(n=0; (n<len) && sndLeft; n++, sndLeft--) {
+    if(sndTenBit) { // Four samples' high bits, then their low bytes
+      if(++sndLoIdx >= 4) {
+        sndHiBits = pgm_read_byte(sndData++);
+        sndLoIdx  = 0;
+      }
+      buf[n]      = ((sndHiBits & 0xC0) << 2) | pgm_read_byte(sndData++);
+      sndHiBits <<= 2;
+    } else {
+      buf[n] = pgm_read_byte(sndData++) << 2;
+    }
+  }
+  return n;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Plays digitized 8-bit audio (optionally 10 bits on Express board) from
+      a PROGMEM (flash memory) buffer.  Maybe 1-3 seconds tops depending on
+      sampling rate (e.g. 8000 Hz = 8 Kbytes/second).  Max ~20K space avail on
+      Circuit Playground, lots more on Circuit Playground Express.
+      This function "blocks" until the sound is done; use
+      playSoundBackground() to let other code run meanwhile.
+    @param data pointer to the audio data to play
+    @param len the length of the data in samples
+    @param sampleRate the sample rate of the data in samples per second
+    @param tenBit Optional flag if true 10-bit mode is enabled. On AVR the
+      samples are played at 8 bits.
+*/
+/**************************************************************************/
+void Adafruit_CPlay_Speaker::playSound(
+  const uint8_t *data, uint32_t len, uint16_t sampleRate, bool tenBit) {
+  if(playSoundBackground(data, len, sampleRate, tenBit)) {
+    while(update());
   }
 }
+
+/**************************************************************************/
+/*!
+    @brief  Start playing digitized audio from a PROGMEM buffer, as with
+      playSound(), but return right away.  Call update() from loop() to
+      keep it going.
+    @param data pointer to the audio data to play
+    @param len the length of the data in samples
+    @param sampleRate the sample rate of the data in samples per second
+    @param tenBit Optional flag if true 10-bit mode is enabled
+    @return true if playback started
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Speaker::playSoundBackground(
+  const uint8_t *data, uint32_t len, uint16_t sampleRate, bool tenBit) {
+  stopPlayback(); // Before its source state changes under it
+  sndData   = data;
+  sndLeft   = len;
+  sndTenBit = tenBit;
+  sndLoIdx  = 4;
+  return startPlayback(sampleRate, sndFill);
+}
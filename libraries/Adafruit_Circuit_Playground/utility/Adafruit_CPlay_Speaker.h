@@ -8,8 +8,21 @@
 
 #if !defined(__AVR__) // circuit playground express has nicer amp w/shutdown
   #define CPLAY_SPEAKER_SHUTDOWN 11 ///< shutdown pin (Express boards only)
+  #define CPLAY_SPEAKER_BUF     256 ///< samples in each half of the play buffer
+#else
+  #define CPLAY_SPEAKER_BUF      64 ///< samples in each half of the play buffer
 #endif
 
+/**************************************************************************/
+/*!
+    @brief  Source of samples for background playback.  Called with one half
+      of the play buffer to fill with 10-bit samples (0-1023, 512 is the
+      idle position), it returns how many it wrote.  Returning fewer than
+      len ends playback once those samples have been heard.
+*/
+/**************************************************************************/
+typedef uint16_t (*cplay_speaker_fill_t)(uint16_t *buf, uint16_t len);
+
 /**************************************************************************/
 /*! 
     @brief  Class that stores state and functions for the speaker on CircuitPlayground boards
@@ -25,6 +38,13 @@ class Adafruit_CPlay_Speaker {
          bool tenBit=false),
        say(const uint8_t *addr);
 
+  bool startPlayback(uint16_t sampleRate, cplay_speaker_fill_t fill),
+       playSoundBackground(const uint8_t *data, uint32_t length,
+         uint16_t sampleRate, bool tenBit=false),
+       sayBackground(const uint8_t *addr),
+       update(void);
+  void stopPlayback(void);
+
   void enable(bool e);
 
   /**************************************************************************/
@@ -71,6 +71,8 @@ CPlay_CapacitiveSensor::CPlay_CapacitiveSensor(uint8_t sendPin, uint8_t receiveP
 	// get pin mapping and port for receive Pin - from digital pin functions in Wiring.c
 	leastTotal = 0x0FFFFFFFL;   // input large value for autocalibrate begin
 	lastCal = millis();         // set millis for start
+	pendingSamples = 0;
+	sensed = 0;
 }
 
 // Public Methods //////////////////////////////////////////////////////////////
@@ -95,6 +97,18 @@ long CPlay_CapacitiveSensor::capacitiveSensor(uint8_t samples)
 		if (SenseOneCycle() < 0)  return -2;   // variable over timeout
 }
 
+	return subtractBaseline();
+}
+
+/**************************************************************************/
+/*! 
+    @brief  subtract the auto-calibrated baseline from the samples in total,
+        recalibrating now and then while the pad doesn't look touched
+    @return the sensor reading
+*/
+/**************************************************************************/
+long CPlay_CapacitiveSensor::subtractBaseline(void)
+{
 		// only calibrate if time is greater than CS_AutocaL_Millis and total is less than 10% of baseline
 		// this is an attempt to keep from calibrating when the sensor is seeing a "touched" signal
 
@@ -149,6 +163,58 @@ long CPlay_CapacitiveSensor::capacitiveSensorRaw(uint8_t samples)
 	return total;
 }
 
+/**************************************************************************/
+/*! 
+    @brief  start a capacitiveSensor() reading that is taken one charge cycle
+        at a time by sensingDone(), so the caller is never held up for more
+        than one cycle. Round-robin over several sensors' sensingDone() to
+        read many pads without freezing the loop.
+    @param samples number of samples to take
+*/
+/**************************************************************************/
+void CPlay_CapacitiveSensor::startSensing(uint8_t samples)
+{
+	total = 0;
+	pendingSamples = samples;
+	sensed = 0;
+	if (error < 0) {                      // bad pin
+		pendingSamples = 0;
+		sensed = -1;
+	}
+}
+
+/**************************************************************************/
+/*! 
+    @brief  take the next charge cycle of the reading begun by startSensing()
+    @return true once the reading is finished and sensedValue() is ready
+*/
+/**************************************************************************/
+bool CPlay_CapacitiveSensor::sensingDone(void)
+{
+	if (pendingSamples == 0) return true;
+
+	if (SenseOneCycle() < 0) {            // variable over timeout
+		pendingSamples = 0;
+		sensed = -2;
+		return true;
+	}
+	if (--pendingSamples) return false;
+
+	sensed = subtractBaseline();
+	return true;
+}
+
+/**************************************************************************/
+/*! 
+    @brief  get the result of the reading begun by startSensing()
+    @return the sensor reading, as capacitiveSensor() would give it
+*/
+/**************************************************************************/
+long CPlay_CapacitiveSensor::sensedValue(void)
+{
+	return sensed;
+}
+
 /**************************************************************************/
 /*! 
     @brief  reset the auto calibration
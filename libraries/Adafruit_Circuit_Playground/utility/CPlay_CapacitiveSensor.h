@@ -213,6 +213,9 @@ class CPlay_CapacitiveSensor
 	void set_CS_Timeout_Millis(unsigned long timeout_millis);
 	void reset_CS_AutoCal();
 	void set_CS_AutocaL_Millis(unsigned long autoCal_millis);
+	void startSensing(uint8_t samples);
+	bool sensingDone(void);
+	long sensedValue(void);
   // library-accessible "private" interface
   private:
   // variables
@@ -227,8 +230,11 @@ class CPlay_CapacitiveSensor
 	volatile IO_REG_TYPE *sReg;
 	IO_REG_TYPE rBit;    // receive pin's ports and bitmask
 	volatile IO_REG_TYPE *rReg;
+	uint8_t pendingSamples;	// charge cycles left for startSensing()
+	long sensed;			// result of the last startSensing()
   // methods
 	int SenseOneCycle(void);
+	long subtractBaseline(void);
 };
 
 #endif
@@ -0,0 +1,124 @@
+/*!
+ * @file CPlay_DMA.cpp
+ *
+ * Shared DMA controller setup for the Circuit Playground Express.
+ */
+
+#include "CPlay_DMA.h"
+
+#if defined(__SAMD21G18A__)
+
+static DmacDescriptor dmaDesc[CPLAY_DMA_CHANNELS] __attribute__ ((aligned (16)));
+static DmacDescriptor dmaWriteback[CPLAY_DMA_CHANNELS] __attribute__ ((aligned (16)));
+
+/**************************************************************************/
+/*!
+    @brief  Turn on the DMA controller if needed and reset one channel to be
+            triggered by a peripheral, one beat per trigger.
+    @param ch the channel, one of the CPLAY_DMA_ values
+    @param trigsrc the peripheral trigger, e.g. SERCOM5_DMAC_ID_TX
+    @return the channel's descriptor, for the caller to fill in before
+            calling cplayDMAStart()
+*/
+/**************************************************************************/
+DmacDescriptor *cplayDMAChannel(uint8_t ch, uint8_t trigsrc) {
+  if(!DMAC->CTRL.bit.DMAENABLE) {
+    PM->AHBMASK.reg |= PM_AHBMASK_DMAC;
+    PM->APBBMASK.reg |= PM_APBBMASK_DMAC;
+    memset(dmaDesc, 0, sizeof(dmaDesc));
+    memset(dmaWriteback, 0, sizeof(dmaWriteback));
+    DMAC->BASEADDR.reg = (uint32_t)dmaDesc;
+    DMAC->WRBADDR.reg  = (uint32_t)dmaWriteback;
+    DMAC->CTRL.reg     = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xf);
+  }
+
+  // CHID selects which channel the CHxxx registers below refer to, so keep
+  // an interrupt handler using another channel from switching it under us.
+  noInterrupts();
+  DMAC->CHID.reg     = DMAC_CHID_ID(ch);
+  DMAC->CHCTRLA.reg &= ~DMAC_CHCTRLA_ENABLE;
+  DMAC->CHCTRLA.reg  = DMAC_CHCTRLA_SWRST;
+  DMAC->CHCTRLB.reg  = DMAC_CHCTRLB_LVL(0) |
+                       DMAC_CHCTRLB_TRIGSRC(trigsrc) |
+                       DMAC_CHCTRLB_TRIGACT_BEAT;
+  interrupts();
+
+  memset(&dmaDesc[ch], 0, sizeof(DmacDescriptor));
+  return &dmaDesc[ch];
+}
+
+/**************************************************************************/
+/*!
+    @brief  Start a transfer with the channel's descriptor.
+    @param ch the channel, one of the CPLAY_DMA_ values
+*/
+/**************************************************************************/
+void cplayDMAStart(uint8_t ch) {
+  noInterrupts();
+  DMAC->CHID.reg      = DMAC_CHID_ID(ch);
+  DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_MASK;
+  DMAC->CHCTRLA.reg  |= DMAC_CHCTRLA_ENABLE;
+  interrupts();
+}
+
+/**************************************************************************/
+/*!
+    @brief  Check whether a transfer is still running. The DMAC turns the
+            channel off itself at the end of a descriptor with no successor.
+    @param ch the channel, one of the CPLAY_DMA_ values
+    @return true if the channel is still moving data
+*/
+/**************************************************************************/
+bool cplayDMABusy(uint8_t ch) {
+  noInterrupts();
+  DMAC->CHID.reg = DMAC_CHID_ID(ch);
+  bool busy = DMAC->CHCTRLA.bit.ENABLE;
+  interrupts();
+  return busy;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Check for, and acknowledge, the end of a block whose descriptor
+            has DMAC_BTCTRL_BLOCKACT_INT set. No DMAC interrupt handler is
+            needed; the flag is set whether or not the interrupt is enabled.
+    @param ch the channel, one of the CPLAY_DMA_ values
+    @return true if a block has finished since the last call
+*/
+/**************************************************************************/
+bool cplayDMABlockDone(uint8_t ch) {
+  noInterrupts();
+  DMAC->CHID.reg = DMAC_CHID_ID(ch);
+  bool done = DMAC->CHINTFLAG.bit.TCMPL;
+  if(done) DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL;
+  interrupts();
+  return done;
+}
+
+/**************************************************************************/
+/*!
+    @brief  Abort any transfer on the channel.
+    @param ch the channel, one of the CPLAY_DMA_ values
+*/
+/**************************************************************************/
+void cplayDMAStop(uint8_t ch) {
+  noInterrupts();
+  DMAC->CHID.reg     = DMAC_CHID_ID(ch);
+  DMAC->CHCTRLA.reg &= ~DMAC_CHCTRLA_ENABLE;
+  interrupts();
+}
+
+/**************************************************************************/
+/*!
+    @brief  The DMAC's copy of the descriptor a channel is working through.
+            Its DSTADDR (or SRCADDR) tells which of a chain of descriptors
+            is in progress, and its BTCNT how many beats are left.
+    @param ch the channel, one of the CPLAY_DMA_ values
+    @return the channel's write-back descriptor
+*/
+/**************************************************************************/
+const volatile DmacDescriptor *cplayDMAWriteback(uint8_t ch) {
+  return &dmaWriteback[ch];
+}
+
+#endif // __SAMD21G18A__
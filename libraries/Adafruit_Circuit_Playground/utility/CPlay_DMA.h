@@ -0,0 +1,35 @@
+/*!
+ * @file CPlay_DMA.h
+ *
+ * Shared DMA controller setup for the Circuit Playground Express. The SAMD21
+ * DMAC has a single descriptor table for all channels, so every user of DMA
+ * in this library takes its descriptor from here rather than pointing the
+ * controller at a table of its own.
+ */
+
+#ifndef CPLAY_DMA_H
+#define CPLAY_DMA_H
+
+#include <Arduino.h>
+
+#if defined(__SAMD21G18A__)
+
+/** DMA channels used by this library. Channel 0 has the highest priority
+    when two channels share a priority level. */
+enum {
+  CPLAY_DMA_NEOPIXEL = 0,   ///< NeoPixel bitstream out of SERCOM5
+  CPLAY_DMA_MIC,            ///< Microphone PDM words in from I2S
+  CPLAY_DMA_SPEAKER,        ///< Speaker samples out to the DAC
+  CPLAY_DMA_CHANNELS        ///< Number of descriptors in the table
+};
+
+DmacDescriptor *cplayDMAChannel(uint8_t ch, uint8_t trigsrc);
+void cplayDMAStart(uint8_t ch);
+bool cplayDMABusy(uint8_t ch);
+bool cplayDMABlockDone(uint8_t ch);
+void cplayDMAStop(uint8_t ch);
+const volatile DmacDescriptor *cplayDMAWriteback(uint8_t ch);
+
+#endif // __SAMD21G18A__
+
+#endif // CPLAY_DMA_H
@@ -6,7 +6,6 @@
 
 #define FS    8000                        // Speech engine sample rate
 #define TICKS (FS / 40)                   // Speech data rate
-#define USEC  ((1000000 + (FS / 2)) / FS) // Sample period (microseconds)
 
 static const uint16_t PROGMEM
   tmsK1[]     = {0x82C0,0x8380,0x83C0,0x8440,0x84C0,0x8540,0x8600,0x8780,
@@ -54,6 +53,14 @@ static const uint8_t *ptrAddr;
 static uint16_t       buf;
 static uint8_t        bufBits;
 
+// Synthesizer state, carried from one buffer fill to the next
+static int16_t  x0, x1, x2, x3, x4, x5, x6, x7, x8, x9,
+                synthK1, synthK2;
+static uint16_t synthEnergy, synthRand;
+static int8_t   synthK3, synthK4, synthK5, synthK6,
+                synthK7, synthK8, synthK9, synthK10;
+static uint8_t  periodCounter, synthPeriod, iCount;
+
 static inline uint8_t rev(uint8_t a) { // Reverse bit sequence in 8-bit value
 	a = ( a         >> 4) | ( a         << 4); // 76543210 -> 32107654
 	a = ((a & 0xCC) >> 2) | ((a & 0x33) << 2); // 32107654 -> 10325476
@@ -79,47 +86,24 @@ static uint8_t getBits(uint8_t bits) {
 
 /**************************************************************************/
 /*! 
-    @brief  speak the data at the passed location
-    @param addr pointer to the data
+    @brief  Playback source: run the synthesizer for up to len samples,
+	stopping early at the stop frame.
+    @param out where to put the samples
+    @param len how many are wanted
+    @return how many were written
 */
 /**************************************************************************/
-void Adafruit_CPlay_Speaker::say(const uint8_t *addr) {
-
-	int16_t  x0=0, x1=0, x2=0, x3=0, x4=0,
-	         x5=0, x6=0, x7=0, x8=0, x9=0,
-	         synthK1, synthK2, u0;
-	uint16_t synthEnergy, synthRand = 1;
-	int8_t   synthK3, synthK4, synthK5, synthK6,
-	         synthK7, synthK8, synthK9, synthK10;
-	uint8_t  periodCounter=0, nextPwm = 0x7F, synthPeriod;
-	uint8_t  iCount = TICKS;
-	uint32_t nowTime, prevTime=0;
-
-	if(!started) begin();
-
-	buf = bufBits = 0; // Reset 'ROM' reader (global stuff)
-	ptrAddr = addr;
-
-	for(;;) {
-		while(((nowTime = micros()) - prevTime) < USEC);
-#ifdef __AVR__
-		OCR4A    = nextPwm;
-#else
-		analogWrite(A0, nextPwm);
-#endif
-		prevTime = nowTime;
+static uint16_t talkieFill(uint16_t *out, uint16_t len) {
+	int16_t  u0;
+	uint16_t n;
 
+	for(n=0; n<len; n++) {
 		if(++iCount >= TICKS) {
 			// Read speech data, processing the variable size frames
 			uint8_t energy;
 			if((energy = getBits(4)) == 0) {  // Rest frame
 				synthEnergy = 0;
 			} else if(energy == 0xF) {        // Stop frame; silence
-#ifdef __AVR__
-				TCCR4A = 0x7F;
-#else
-				analogWrite(A0, 0x7F);
-#endif
 				break;
 			} else {
 				synthEnergy    = pgm_read_byte(&tmsEnergy[energy]);
@@ -175,7 +159,46 @@ void Adafruit_CPlay_Speaker::say(const uint8_t *addr) {
 		if(     u0 >  511) u0 =  511; // Output clamp
 		else if(u0 < -512) u0 = -512;
 
-		x0      =  u0;
-		nextPwm = (u0 >> 2) + 0x80;
+		x0     = u0;
+		out[n] = u0 + 512;
+	}
+	return n;
+}
+
+/**************************************************************************/
+/*! 
+    @brief  speak the data at the passed location
+    @param addr pointer to the data
+*/
+/**************************************************************************/
+void Adafruit_CPlay_Speaker::say(const uint8_t *addr) {
+	if(sayBackground(addr)) {
+		while(update());
 	}
 }
+
+/**************************************************************************/
+/*! 
+    @brief  start speaking the data at the passed location and return right
+	away. Call update() from loop() to keep it going.
+    @param addr pointer to the data
+    @return true if playback started
+*/
+/**************************************************************************/
+bool Adafruit_CPlay_Speaker::sayBackground(const uint8_t *addr) {
+	stopPlayback(); // Before its synthesizer state is reset under it
+
+	buf = bufBits = 0; // Reset 'ROM' reader (global stuff)
+	ptrAddr = addr;
+
+	x0 = x1 = x2 = x3 = x4 = x5 = x6 = x7 = x8 = x9 = 0;
+	synthK1 = synthK2 = 0;
+	synthK3 = synthK4 = synthK5 = synthK6 = 0;
+	synthK7 = synthK8 = synthK9 = synthK10 = 0;
+	synthEnergy   = 0;
+	synthRand     = 1;
+	periodCounter = synthPeriod = 0;
+	iCount        = TICKS - 1; // First sample reads the first frame
+
+	return startPlayback(FS, talkieFill);
+}
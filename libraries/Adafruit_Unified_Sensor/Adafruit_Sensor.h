@@ -21,6 +21,7 @@
 #define _ADAFRUIT_SENSOR_H
 
 #ifndef ARDUINO
+ #include <stddef.h>
  #include <stdint.h>
 #elif ARDUINO >= 100
  #include "Arduino.h"
@@ -124,6 +125,14 @@ typedef struct
     };
 } sensors_event_t;
 
+/* Sensor sample (16 bytes) */
+/** struct sensors_sample_s is used to provide one reading without the event header; the sensor_id, type and units are those reported by getSensor(). */
+typedef struct
+{
+    int32_t timestamp;                        /**< time is in milliseconds */
+    float   data[3];                          /**< values, in the units of the matching sensors_event_t field */
+} sensors_sample_t;
+
 /* Sensor details (40 bytes) */
 /** struct sensor_s is used to describe basic information about a specific sensor. */
 typedef struct
@@ -148,6 +157,22 @@ class Adafruit_Sensor {
   virtual void enableAutoRange(bool enabled) { (void)enabled; /* suppress unused warning */ };
   virtual bool getEvent(sensors_event_t*) = 0;
   virtual void getSensor(sensor_t*) = 0;
+
+  // These may be overridden by sensors that buffer readings (e.g. in a FIFO)
+  // to return several at once; by default they return the latest reading.
+  // Both return the number filled in, up to n, and 0 if none is ready.
+  virtual size_t getEvents(sensors_event_t* events, size_t n) {
+    return (n && getEvent(events)) ? 1 : 0;
+  }
+  virtual size_t getSamples(sensors_sample_t* samples, size_t n) {
+    sensors_event_t event;
+    if (!n || !getEvent(&event)) return 0;
+    samples->timestamp = event.timestamp;
+    samples->data[0]   = event.data[0];
+    samples->data[1]   = event.data[1];
+    samples->data[2]   = event.data[2];
+    return 1;
+  }
   
  private:
   bool _autoRange;
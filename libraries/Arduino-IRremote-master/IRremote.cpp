@@ -111,6 +111,20 @@ int  MATCH_SPACE (int measured_ticks,  int desired_us)
  	return passed;
 }
 
+//+=============================================================================
+// If requested, flash the LED with the IR data
+//
+static inline void  blinkIR (uint8_t irdata)
+{
+	if (irparams.blinkflag) {
+		if (irdata == MARK)
+			if (irparams.blinkpin) digitalWrite(irparams.blinkpin, HIGH); // Turn user defined pin LED on
+				else BLINKLED_ON() ;   // if no user defined LED pin, turn default LED pin for the hardware on
+		else if (irparams.blinkpin) digitalWrite(irparams.blinkpin, LOW); // Turn user defined pin LED on
+				else BLINKLED_OFF() ;   // if no user defined LED pin, turn default LED pin for the hardware on
+	}
+}
+
 //+=============================================================================
 // Interrupt Service Routine - Fires every 50uS
 // TIMER2 interrupt code to collect raw data.
@@ -190,11 +204,64 @@ ISR (TIMER_INTR_NAME)
 	}
 
 	// If requested, flash LED while receiving IR data
-	if (irparams.blinkflag) {
-		if (irdata == MARK)
-			if (irparams.blinkpin) digitalWrite(irparams.blinkpin, HIGH); // Turn user defined pin LED on
-				else BLINKLED_ON() ;   // if no user defined LED pin, turn default LED pin for the hardware on
-		else if (irparams.blinkpin) digitalWrite(irparams.blinkpin, LOW); // Turn user defined pin LED on
-				else BLINKLED_OFF() ;   // if no user defined LED pin, turn default LED pin for the hardware on
+	blinkIR(irdata);
+}
+
+//+=============================================================================
+// Pin change Interrupt Service Routine - Fires on each edge of the IR receiver
+// Used instead of the timer ISR after IRrecv::enableIRInEdges().
+// Records the same SPACE, MARK widths in rawbuf, in ticks of 50uS, but from
+// the time between edges. So nothing runs between messages, and the widths are
+// rounded rather than sampled.
+// There is no edge at the end of a message, so decode() & isIdle() spot the
+// long SPACE after it instead. See checkEdgeGap().
+//
+void  irEdgeISR ( )
+{
+	unsigned long  now     = micros();
+	unsigned long  elapsed = (now - irparams.lastedge + USECPERTICK / 2) / USECPERTICK;
+	unsigned int   ticks   = (elapsed > 0xFFFF) ? 0xFFFF : elapsed;
+	irparams.lastedge = now;
+
+	uint8_t  irdata = (uint8_t)digitalRead(irparams.recvpin);
+
+	switch(irparams.rcvstate) {
+		//......................................................................
+		case STATE_IDLE: // The end of a gap?
+			if ((irdata == MARK) && (ticks >= GAP_TICKS)) {
+				// Gap just ended; Record duration; Start recording transmission
+				irparams.overflow                  = false;
+				irparams.rawlen                    = 0;
+				irparams.rawbuf[irparams.rawlen++] = ticks;
+				irparams.rcvstate                  = STATE_MARK;
+			}
+			break;
+		//......................................................................
+		case STATE_MARK:  // Mark ended; Record time
+			if (irdata == SPACE) {
+				irparams.rawbuf[irparams.rawlen++] = ticks;
+				irparams.rcvstate                  = STATE_SPACE;
+			}
+			break;
+		//......................................................................
+		case STATE_SPACE:  // Space ended
+			if (irdata == MARK) {
+				if (ticks > GAP_TICKS) {
+					// It was the gap after the message, and nobody checked.
+					irparams.rcvstate = STATE_STOP;
+				} else {
+					irparams.rawbuf[irparams.rawlen++] = ticks;
+					irparams.rcvstate                  = STATE_MARK;
+				}
+			}
+			break;
+	}
+	if ((irparams.rawlen >= RAWBUF) && (irparams.rcvstate != STATE_STOP)) {
+		// Buffer overflow; Stop the State Machine
+		irparams.overflow = true;
+		irparams.rcvstate = STATE_STOP;
 	}
+
+	// If requested, flash LED while receiving IR data
+	blinkIR(irdata);
 }
@@ -18,6 +18,16 @@
 #ifndef IRremote_h
 #define IRremote_h
 
+//------------------------------------------------------------------------------
+// IRremoteESP8266 is a fork of this library and declares the same classes
+// (IRrecv, IRsend, decode_results) and protocol names, so the two can't be
+// built into one sketch. Use IRremoteESP8266 on ESP8266/ESP32 and this
+// library everywhere else.
+//
+#ifdef IRREMOTEESP8266_H_
+#	error "IRremote.h and IRremoteESP8266.h can't be used in the same sketch"
+#endif
+
 //------------------------------------------------------------------------------
 // The ISR header contains several useful macros the user may wish to use
 //
@@ -177,6 +187,7 @@ class IRrecv
 		void  blink13    (int blinkflag) ;
 		int   decode     (decode_results *results) ;
 		void  enableIRIn ( ) ;
+		bool  enableIRInEdges ( ) ;
 		bool  isIdle     ( ) ;
 		void  resume     ( ) ;
 
@@ -50,7 +50,9 @@ typedef
 		uint8_t       blinkpin;
 		uint8_t       blinkflag;       // true -> enable blinking of pin on IR processing
 		uint8_t       rawlen;          // counter of entries in rawbuf
+		uint8_t       edgemode;        // true -> timing pin edges, not the timer
 		unsigned int  timer;           // State timer, counts 50uS ticks.
+		unsigned long lastedge;        // micros() at the last edge (edgemode)
 		unsigned int  rawbuf[RAWBUF];  // raw data
 		uint8_t       overflow;        // Raw buffer overflow occurred
 	}
@@ -68,6 +70,10 @@ irparams_t;
 // Therefore we declare it as "volatile" to stop the compiler/CPU caching it
 EXTERN  volatile irparams_t  irparams;
 
+// Pin change Interrupt Service Routine, used instead of the timer one by
+// IRrecv::enableIRInEdges()
+void  irEdgeISR ( ) ;
+
 //------------------------------------------------------------------------------
 // Defines for setting and clearing register bits
 //
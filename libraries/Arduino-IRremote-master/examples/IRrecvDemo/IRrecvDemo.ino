@@ -21,6 +21,9 @@ void setup()
   // to the user what's going on.
   Serial.println("Enabling IRin");
   irrecv.enableIRIn(); // Start the receiver
+  // Or, with RECV_PIN on an interrupt pin (e.g. 2 or 3 on an Uno), time the
+  // edges instead of sampling the pin every 50uS:
+  // irrecv.enableIRInEdges();
   Serial.println("Enabled IRin");
 }
 
@@ -6,6 +6,20 @@ hw_timer_t *timer;
 void IRTimer(); // defined in IRremote.cpp
 #endif
 
+//+=============================================================================
+// When timing edges, nothing happens at the end of a message, as there's no
+// edge until the next one starts. So see if the SPACE since the last edge is
+// long enough to be the gap after a message.
+//
+static void  checkEdgeGap ( )
+{
+	if (!irparams.edgemode)  return ;
+	noInterrupts();  // lastedge is more than one byte, & the ISR changes it.
+	if ((irparams.rcvstate == STATE_SPACE) && (micros() - irparams.lastedge > _GAP))
+		irparams.rcvstate = STATE_STOP;
+	interrupts();
+}
+
 //+=============================================================================
 // Decodes the received IR message
 // Returns 0 if no data ready, 1 if data ready.
@@ -13,6 +27,8 @@ void IRTimer(); // defined in IRremote.cpp
 //
 int  IRrecv::decode (decode_results *results)
 {
+	checkEdgeGap();
+
 	results->rawbuf   = irparams.rawbuf;
 	results->rawlen   = irparams.rawlen;
 
@@ -105,6 +121,7 @@ IRrecv::IRrecv (int recvpin)
 {
 	irparams.recvpin = recvpin;
 	irparams.blinkflag = 0;
+	irparams.edgemode = false;
 }
 
 IRrecv::IRrecv (int recvpin, int blinkpin)
@@ -113,6 +130,7 @@ IRrecv::IRrecv (int recvpin, int blinkpin)
 	irparams.blinkpin = blinkpin;
 	pinMode(blinkpin, OUTPUT);
 	irparams.blinkflag = 0;
+	irparams.edgemode = false;
 }
 
 
@@ -148,6 +166,12 @@ void  IRrecv::enableIRIn ( )
 	sei();  // enable interrupts
 #endif
 
+	// Stop timing edges, if we were.
+	if (irparams.edgemode) {
+		detachInterrupt(digitalPinToInterrupt(irparams.recvpin));
+		irparams.edgemode = false;
+	}
+
 	// Initialize state machine variables
 	irparams.rcvstate = STATE_IDLE;
 	irparams.rawlen = 0;
@@ -156,6 +180,33 @@ void  IRrecv::enableIRIn ( )
 	pinMode(irparams.recvpin, INPUT);
 }
 
+//+=============================================================================
+// initialization, to time the edges of the IR receiver output instead of
+// sampling it every 50uS. Use it instead of enableIRIn().
+// Nothing runs while there's no IR, and there's no timer interrupt to get in
+// the way of others. The receive pin must support attachInterrupt(),
+// e.g. pin 2 or 3 on an Uno.
+// Returns false if the receive pin can't do that.
+//
+bool  IRrecv::enableIRInEdges ( )
+{
+#ifdef NOT_AN_INTERRUPT
+	if (digitalPinToInterrupt(irparams.recvpin) == NOT_AN_INTERRUPT)  return false ;
+#endif
+
+	// Initialize state machine variables
+	irparams.rcvstate = STATE_IDLE;
+	irparams.rawlen = 0;
+	irparams.lastedge = micros();
+	irparams.edgemode = true;
+
+	// Set pin modes
+	pinMode(irparams.recvpin, INPUT);
+
+	attachInterrupt(digitalPinToInterrupt(irparams.recvpin), irEdgeISR, CHANGE);
+	return true;
+}
+
 //+=============================================================================
 // Enable/disable blinking of pin 13 on IR processing
 //
@@ -170,6 +221,7 @@ void  IRrecv::blink13 (int blinkflag)
 //
 bool  IRrecv::isIdle ( )
 {
+ checkEdgeGap();
  return (irparams.rcvstate == STATE_IDLE || irparams.rcvstate == STATE_STOP) ? true : false;
 }
 //+=============================================================================
@@ -0,0 +1,314 @@
+/**
+ * @file       BlynkEpoll.h
+ * @license    This project is released under the MIT License (MIT)
+ * @brief      Non-blocking socket transport for many sessions on one epoll loop
+ *
+ * BlynkTransportSocket blocks in connect() and polls the socket on every
+ * run(), so each device needs its own process. This transport never
+ * blocks: connect() only starts the TCP handshake, writes are queued and
+ * flushed when the socket is writable, and reads are served from a buffer
+ * that the owner of the epoll loop fills by calling onEvent(). The owner
+ * then calls run() on the session, so an idle session costs no system
+ * calls at all.
+ *
+ * Each transport registers its socket on a shared epoll descriptor with
+ * the tag given to the constructor as event data, so the loop can tell
+ * whose socket became ready (see gateway.cpp).
+ */
+
+#ifndef BlynkEpoll_h
+#define BlynkEpoll_h
+
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <errno.h>
+#include <arpa/inet.h>
+
+#include <Blynk/BlynkProtocol.h>
+
+#ifndef BLYNK_EPOLL_IN_BUFFER
+#define BLYNK_EPOLL_IN_BUFFER  1024
+#endif
+
+#ifndef BLYNK_EPOLL_OUT_BUFFER
+#define BLYNK_EPOLL_OUT_BUFFER 2048
+#endif
+
+class BlynkTransportEpoll
+{
+public:
+    BlynkTransportEpoll(int ep, void* owner)
+        : sockfd(-1), epfd(ep), tag(owner), domain(NULL), port(0)
+        , addrLen(0), pending(false), watchOut(false)
+        , inPos(0), inLen(0), outLen(0)
+    {}
+
+    void begin(const char* h, uint16_t p) {
+        this->domain = h;
+        this->port = p;
+        addrLen = 0;    // resolve again on the next connect()
+    }
+
+    // Starts the handshake and returns at once. The session counts as
+    // connected from here on: the login is queued and goes out when the
+    // socket becomes writable, and a refused or timed out handshake shows
+    // up in onEvent() as a disconnect.
+    bool connect()
+    {
+        if (!addrLen && !resolve()) {
+            return false;
+        }
+
+        sockfd = ::socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (sockfd < 0) {
+            BLYNK_LOG1(BLYNK_F("Can't create socket"));
+            return false;
+        }
+
+        int one = 1;
+        setsockopt(sockfd, SOL_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        if (::connect(sockfd, (struct sockaddr*)&addr, addrLen) < 0 && errno != EINPROGRESS) {
+            BLYNK_LOG2(BLYNK_F("Can't connect to "), domain);
+            disconnect();
+            return false;
+        }
+
+        pending = true;
+        watchOut = true;
+        inPos = inLen = outLen = 0;
+
+        struct epoll_event ev;
+        ev.events = EPOLLIN | EPOLLOUT;
+        ev.data.ptr = tag;
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, sockfd, &ev) < 0) {
+            BLYNK_LOG1(BLYNK_F("Can't watch socket"));
+            disconnect();
+            return false;
+        }
+        return true;
+    }
+
+    void disconnect()
+    {
+        if (sockfd != -1) {
+            epoll_ctl(epfd, EPOLL_CTL_DEL, sockfd, NULL);
+            ::close(sockfd);
+            sockfd = -1;
+        }
+        pending = false;
+        inPos = inLen = outLen = 0;
+    }
+
+    // Called by the loop with the events epoll_wait() reported for this
+    // transport: completes the handshake, flushes queued output and takes
+    // in what the socket holds.
+    void onEvent(uint32_t events)
+    {
+        if (sockfd < 0) {
+            return;
+        }
+        if (pending && (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+            int err = 0;
+            socklen_t len = sizeof(err);
+            getsockopt(sockfd, SOL_SOCKET, SO_ERROR, &err, &len);
+            if (err) {
+                BLYNK_LOG4(BLYNK_F("Can't connect to "), domain, BLYNK_F(": "), strerror(err));
+                disconnect();
+                return;
+            }
+            pending = false;
+        }
+        if (events & EPOLLOUT) {
+            flush();
+        }
+        if (sockfd >= 0 && (events & (EPOLLIN | EPOLLERR | EPOLLHUP))) {
+            fill();
+        }
+    }
+
+    size_t read(void* buf, size_t len) {
+        const size_t n = BlynkMin(len, size_t(inLen - inPos));
+        memcpy(buf, inBuffer + inPos, n);
+        inPos += n;
+        if (inPos == inLen) {
+            inPos = inLen = 0;
+        }
+        return n;
+    }
+
+    size_t write(const void* buf, size_t len) {
+        const BlynkIoVec iov = { buf, len };
+        return write(&iov, 1);
+    }
+
+    // All parts are queued together; if they do not fit, nothing is and
+    // the protocol drops the session, as it does for a failed blocking write
+    size_t write(const BlynkIoVec* iov, size_t count) {
+        if (sockfd < 0) {
+            return 0;
+        }
+        size_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            total += iov[i].length;
+        }
+        if (total > sizeof(outBuffer) - outLen) {
+            return 0;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (iov[i].length) {
+                memcpy(outBuffer + outLen, iov[i].base, iov[i].length);
+                outLen += iov[i].length;
+            }
+        }
+        if (!pending) {
+            flush();
+        }
+        return total;
+    }
+
+    bool connected() {
+        return sockfd >= 0;
+    }
+
+    int available() {
+        return inLen - inPos;
+    }
+
+    size_t queued() const {
+        return outLen;
+    }
+
+protected:
+    bool resolve()
+    {
+        struct addrinfo hints;
+        struct addrinfo *res = NULL;
+
+        memset(&hints, 0, sizeof hints);
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        // getaddrinfo() blocks, so the result is kept until begin() changes
+        // the server: a gateway pays it once per session, not per reconnect
+        char port_str[8];
+        snprintf(port_str, sizeof(port_str), "%u", port);
+        if (getaddrinfo(domain, port_str, &hints, &res) != 0 || res == NULL) {
+            BLYNK_LOG1(BLYNK_F("Cannot get addr info"));
+            return false;
+        }
+        memcpy(&addr, res->ai_addr, res->ai_addrlen);
+        addrLen = res->ai_addrlen;
+        freeaddrinfo(res);
+        return true;
+    }
+
+    void flush()
+    {
+        size_t sent = 0;
+        while (sent < outLen) {
+            const ssize_t w = ::send(sockfd, outBuffer + sent, outLen - sent, MSG_NOSIGNAL);
+            if (w < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                disconnect();
+                return;
+            }
+            sent += w;
+        }
+        if (sent) {
+            memmove(outBuffer, outBuffer + sent, outLen - sent);
+            outLen -= sent;
+        }
+        watch(outLen > 0);
+    }
+
+    void fill()
+    {
+        if (inPos) {
+            memmove(inBuffer, inBuffer + inPos, inLen - inPos);
+            inLen -= inPos;
+            inPos = 0;
+        }
+        // With the buffer full the socket stays readable and epoll reports
+        // it again once run() has made room
+        while (inLen < sizeof(inBuffer)) {
+            const ssize_t r = ::recv(sockfd, inBuffer + inLen, sizeof(inBuffer) - inLen, 0);
+            if (r > 0) {
+                inLen += r;
+                continue;
+            }
+            if (r < 0 && errno == EINTR) {
+                continue;
+            }
+            if (r == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                // peer closed: what already arrived is dropped with the session
+                disconnect();
+            }
+            break;
+        }
+    }
+
+    // EPOLLOUT only while output is queued, or the loop would spin
+    void watch(bool out)
+    {
+        if (sockfd < 0 || out == watchOut) {
+            return;
+        }
+        struct epoll_event ev;
+        ev.events = EPOLLIN | (out ? uint32_t(EPOLLOUT) : 0u);
+        ev.data.ptr = tag;
+        epoll_ctl(epfd, EPOLL_CTL_MOD, sockfd, &ev);
+        watchOut = out;
+    }
+
+    int         sockfd;
+    int         epfd;
+    void*       tag;
+    const char* domain;
+    uint16_t    port;
+
+    struct sockaddr_storage addr;
+    socklen_t   addrLen;
+    bool        pending;    // handshake in progress
+    bool        watchOut;
+
+    uint16_t    inPos;
+    uint16_t    inLen;
+    uint16_t    outLen;
+    uint8_t     inBuffer[BLYNK_EPOLL_IN_BUFFER];
+    uint8_t     outBuffer[BLYNK_EPOLL_OUT_BUFFER];
+};
+
+class BlynkEpoll
+    : public BlynkProtocol<BlynkTransportEpoll>
+{
+    typedef BlynkProtocol<BlynkTransportEpoll> Base;
+public:
+    BlynkEpoll(BlynkTransportEpoll& transp)
+        : Base(transp)
+    {}
+
+    void begin(const char* auth,
+               const char* domain = BLYNK_DEFAULT_DOMAIN,
+               uint16_t    port   = BLYNK_DEFAULT_PORT)
+    {
+        Base::begin(auth);
+        this->conn.begin(domain, port);
+    }
+
+};
+
+#endif
@@ -0,0 +1,223 @@
+/**
+ * @file       BlynkEventLoop.h
+ * @license    This project is released under the MIT License (MIT)
+ * @brief      One epoll loop for a Blynk session, its timers and GPIO edges
+ *
+ * main.cpp used to spin on Blynk.run() and BlynkTimer::run(), which keeps
+ * a core busy on a Raspberry Pi gateway doing nothing. Here the process
+ * sleeps in epoll_wait() on:
+ *
+ *   - the session socket (BlynkTransportEpoll, see BlynkEpoll.h)
+ *   - a timerfd armed for the next BlynkTimer expiry, or for the next
+ *     protocol sweep (heartbeat, login timeout, reconnect) if that comes
+ *     first: BLYNK_EVENT_SWEEP_MS
+ *   - edge events of GPIO lines from the gpiochip character device, so an
+ *     input is handled when it changes instead of when it is next polled
+ *
+ * and each wake-up does only what its source asks for.
+ */
+
+#ifndef BlynkEventLoop_h
+#define BlynkEventLoop_h
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <errno.h>
+
+#include <BlynkEpoll.h>
+#include <Blynk/BlynkTimer.h>
+
+#ifndef BLYNK_EVENT_SWEEP_MS
+#define BLYNK_EVENT_SWEEP_MS 1000
+#endif
+
+#ifndef BLYNK_EVENT_GPIOS
+#define BLYNK_EVENT_GPIOS    8
+#endif
+
+#ifndef BLYNK_EVENT_CHIP
+#define BLYNK_EVENT_CHIP     "/dev/gpiochip0"
+#endif
+
+// line is the offset on the chip (the BCM number on a Raspberry Pi),
+// value the level after the edge
+typedef void (*BlynkGpioCallback)(unsigned line, int value);
+
+class BlynkEventLoop
+{
+public:
+    BlynkEventLoop()
+        : epfd(epoll_create1(EPOLL_CLOEXEC))
+        , tfd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+        , chipfd(-1), gpios(0), lastSweep(millis_time_t(0) - BLYNK_EVENT_SWEEP_MS)   // first sweep at once
+    {
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = &tfd;
+        if (epfd < 0 || tfd < 0 || epoll_ctl(epfd, EPOLL_CTL_ADD, tfd, &ev) < 0) {
+            BLYNK_LOG1(BLYNK_F("Can't create event loop"));
+        }
+    }
+
+    ~BlynkEventLoop() {
+        for (unsigned i = 0; i < gpios; i++) {
+            ::close(gpio[i].fd);
+        }
+        if (chipfd >= 0) {
+            ::close(chipfd);
+        }
+        ::close(tfd);
+        ::close(epfd);
+    }
+
+    // For the BlynkTransportEpoll of the session
+    int fd() const { return epfd; }
+
+    // Calls cb on each edge of a GPIO line, which is requested as an input
+    bool watchGpio(unsigned line, BlynkGpioCallback cb, bool rising = true, bool falling = true)
+    {
+        if (gpios >= BLYNK_EVENT_GPIOS || !cb || !(rising || falling)) {
+            return false;
+        }
+        if (chipfd < 0) {
+            chipfd = ::open(BLYNK_EVENT_CHIP, O_RDONLY | O_CLOEXEC);
+            if (chipfd < 0) {
+                BLYNK_LOG2(BLYNK_F("Can't open " BLYNK_EVENT_CHIP ": "), strerror(errno));
+                return false;
+            }
+        }
+
+        struct gpioevent_request req;
+        memset(&req, 0, sizeof(req));
+        req.lineoffset = line;
+        req.handleflags = GPIOHANDLE_REQUEST_INPUT;
+        req.eventflags = (rising ? GPIOEVENT_REQUEST_RISING_EDGE : 0) |
+                         (falling ? GPIOEVENT_REQUEST_FALLING_EDGE : 0);
+        strncpy(req.consumer_label, "blynk", sizeof(req.consumer_label) - 1);
+        if (ioctl(chipfd, GPIO_GET_LINEEVENT_IOCTL, &req) < 0) {
+            BLYNK_LOG4(BLYNK_F("Can't watch GPIO "), line, BLYNK_F(": "), strerror(errno));
+            return false;
+        }
+        fcntl(req.fd, F_SETFL, fcntl(req.fd, F_GETFL) | O_NONBLOCK);
+
+        Gpio& g = gpio[gpios];
+        g.fd = req.fd;
+        g.line = line;
+        g.cb = cb;
+        struct epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = &g;
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, g.fd, &ev) < 0) {
+            ::close(g.fd);
+            return false;
+        }
+        gpios++;
+        return true;
+    }
+
+    // Current level of a watched line, -1 if it is not watched
+    int readGpio(unsigned line)
+    {
+        for (unsigned i = 0; i < gpios; i++) {
+            if (gpio[i].line == line) {
+                struct gpiohandle_data data;
+                if (ioctl(gpio[i].fd, GPIOHANDLE_GET_LINE_VALUES_IOCTL, &data) < 0) {
+                    return -1;
+                }
+                return data.values[0];
+            }
+        }
+        return -1;
+    }
+
+    // Sleeps until something happens and handles it: call it from loop()
+    // instead of Blynk.run() and timer.run()
+    template <class Session>
+    void run(Session& blynk, BlynkTransportEpoll& transport, BlynkTimer* timer = NULL)
+    {
+        arm(timer);
+
+        struct epoll_event events[BLYNK_EVENT_GPIOS + 2];
+        const int n = epoll_wait(epfd, events, BLYNK_EVENT_GPIOS + 2, -1);
+        if (n < 0) {
+            if (errno != EINTR) {
+                BLYNK_LOG2(BLYNK_F("epoll_wait failed: "), strerror(errno));
+            }
+            return;
+        }
+
+        bool session = false;
+        for (int i = 0; i < n; i++) {
+            void* const src = events[i].data.ptr;
+            if (src == &tfd) {
+                uint64_t expirations;
+                while (::read(tfd, &expirations, sizeof(expirations)) > 0) {}
+            } else if (src >= (void*)&gpio[0] && src < (void*)&gpio[BLYNK_EVENT_GPIOS]) {
+                edges(*(Gpio*)src);
+            } else {
+                transport.onEvent(events[i].events);
+                session = true;
+            }
+        }
+
+        // the session runs when its socket speaks, and on the sweep, so
+        // heartbeats and reconnects keep their time on a silent socket
+        const millis_time_t t = BlynkMillis();
+        if (session || t - lastSweep >= BLYNK_EVENT_SWEEP_MS) {
+            lastSweep = t;
+            blynk.run();
+        }
+        if (timer) {
+            timer->run();
+        }
+    }
+
+private:
+    struct Gpio {
+        int fd;
+        unsigned line;
+        BlynkGpioCallback cb;
+    };
+
+    // The timerfd goes off at the next timer expiry or sweep, whichever
+    // comes first; it_value 0 would disarm it, so "now" is 1 ns
+    void arm(BlynkTimer* timer)
+    {
+        const long sinceSweep = long(BlynkMillis() - lastSweep);
+        long ms = sinceSweep >= BLYNK_EVENT_SWEEP_MS ? 0 : BLYNK_EVENT_SWEEP_MS - sinceSweep;
+        const long next = timer ? timer->msUntilNext() : -1;
+        if (next >= 0 && next < ms) {
+            ms = next;
+        }
+        struct itimerspec its;
+        memset(&its, 0, sizeof(its));
+        its.it_value.tv_sec = ms / 1000;
+        its.it_value.tv_nsec = (ms % 1000) * 1000000L;
+        if (!ms) {
+            its.it_value.tv_nsec = 1;
+        }
+        timerfd_settime(tfd, 0, &its, NULL);
+    }
+
+    void edges(Gpio& g)
+    {
+        struct gpioevent_data ev;
+        while (::read(g.fd, &ev, sizeof(ev)) == sizeof(ev)) {
+            g.cb(g.line, ev.id == GPIOEVENT_EVENT_RISING_EDGE ? 1 : 0);
+        }
+    }
+
+    int epfd;
+    int tfd;
+    int chipfd;
+    Gpio gpio[BLYNK_EVENT_GPIOS];
+    unsigned gpios;
+    millis_time_t lastSweep;
+};
+
+#endif
@@ -13,6 +13,7 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <netdb.h>
@@ -110,6 +111,19 @@ public:
         return ::write(sockfd, buf, len);
     }
 
+    size_t write(const BlynkIoVec* iov, size_t count) {
+        struct iovec v[4];
+        if (count > 4) {
+            return 0;
+        }
+        for (size_t i = 0; i < count; i++) {
+            v[i].iov_base = const_cast<void*>(iov[i].base);
+            v[i].iov_len  = iov[i].length;
+        }
+        ssize_t w = ::writev(sockfd, v, count);
+        return (w < 0) ? 0 : w;
+    }
+
     bool connected() {
       return sockfd >= 0;
     }
@@ -0,0 +1,265 @@
+/**
+ * @file       gateway.cpp
+ * @license    This project is released under the MIT License (MIT)
+ * @brief      One process, one thread, one Blynk session per oven
+ *
+ * Listens to the oven fleet multicast group (integracao_full/frota.h) and
+ * forwards each oven's samples to its own Blynk device, using the same
+ * multi-value pin the ovens use when they talk to Blynk themselves
+ * (integracao_full/blynk.ino): temperature, set point, power, run state.
+ *
+ * The ovens to bridge come from a token file, one "chip token" pair per
+ * line, chip in hex as in the default oven name (forno-<chip>):
+ *
+ *     # chip   token
+ *     a1b2c3   YourAuthToken
+ *
+ * All sessions share one epoll loop (BlynkEpoll.h); nothing in the loop
+ * blocks, so one oven with a dead link does not hold up the others.
+ */
+
+#define BLYNK_PRINT stdout
+#define BLYNK_NO_DEFAULT_BANNER
+// every write is paced below; the library limit would busy-wait the loop
+#define BLYNK_MSG_LIMIT 0
+
+#include <BlynkApiLinux.h>
+#include <BlynkEpoll.h>
+#include <getopt.h>
+#include <vector>
+#include <string>
+
+#define FLEET_GROUP     "239.255.80.2"
+#define FLEET_PORT      4210
+#define FLEET_MAGIC     0x5032
+#define FLEET_VERSION   1
+#define FLEET_NAME      16
+
+#define TELEMETRY_PIN   V0
+#define SEND_MS         1000    // at most one write per oven per second
+#define SWEEP_MS        100     // timers of idle sessions
+#define MAX_EVENTS      64
+
+// Same layout as QuadroFrota in frota.h; sample frames end before name
+struct __attribute__((packed)) FleetFrame {
+    uint16_t magic;
+    uint8_t  version;
+    uint8_t  type;
+    uint32_t chip;
+    uint32_t t_ms;
+    int16_t  rk;            // tenths of a degree C
+    int16_t  set_point;     // tenths of a degree C
+    uint8_t  power;         // 0-100
+    uint8_t  run;           // EstadoCorrida
+    uint8_t  trip;          // MotivoDesarme, 0 = armed
+    uint8_t  zones;
+    char     name[FLEET_NAME];
+};
+
+#define FLEET_SAMPLE_SIZE (sizeof(FleetFrame) - FLEET_NAME)
+
+struct Oven {
+    Oven(int epfd, uint32_t id, const std::string& auth)
+        : transport(epfd, this), blynk(transport)
+        , chip(id), token(auth), lastSent(0)
+    {}
+
+    BlynkTransportEpoll transport;
+    BlynkEpoll          blynk;
+    uint32_t            chip;
+    std::string         token;
+    millis_time_t       lastSent;
+};
+
+static std::vector<Oven*> ovens;
+
+static
+void parse_options(int argc, char* argv[],
+                   const char*& tokens,
+                   const char*& serv,
+                   uint16_t&    port)
+{
+    static struct option long_options[] = {
+        {"tokens",  required_argument,   0, 'f'},
+        {"server",  required_argument,   0, 's'},
+        {"port",    required_argument,   0, 'p'},
+        {0, 0, 0, 0}
+    };
+
+    tokens = NULL;
+    serv = BLYNK_DEFAULT_DOMAIN;
+    port = BLYNK_DEFAULT_PORT;
+
+    const char* usage =
+        "Usage: blynk-gateway [options]\n"
+        "\n"
+        "Options:\n"
+        "  -f file, --tokens=file   Oven chip ids and auth tokens, one pair per line\n"
+        "  -s addr, --server=addr   Server name (default: " BLYNK_DEFAULT_DOMAIN ")\n"
+        "  -p num,  --port=num      Server port (default: " BLYNK_TOSTRING(BLYNK_DEFAULT_PORT) ")\n"
+        "\n";
+
+    int rez;
+    while (-1 != (rez = getopt_long(argc, argv, "f:s:p:", long_options, NULL))) {
+        switch (rez) {
+        case 'f': tokens = optarg; break;
+        case 's': serv = optarg; break;
+        case 'p': port = atoi(optarg); break;
+        default : printf("%s", usage); exit(1);
+        };
+    };
+
+    if (!tokens) {
+        printf("%s", usage);
+        exit(1);
+    }
+}
+
+static
+bool load_tokens(const char* path, int epfd)
+{
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        BLYNK_LOG2(BLYNK_F("Can't open "), path);
+        return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), f)) {
+        char token[64];
+        unsigned long chip;
+        if (line[0] == '#' || sscanf(line, "%lx %63s", &chip, token) != 2) {
+            continue;
+        }
+        ovens.push_back(new Oven(epfd, chip, token));
+    }
+    fclose(f);
+    return !ovens.empty();
+}
+
+static
+Oven* find_oven(uint32_t chip)
+{
+    for (size_t i = 0; i < ovens.size(); i++) {
+        if (ovens[i]->chip == chip) {
+            return ovens[i];
+        }
+    }
+    return NULL;
+}
+
+static
+int open_fleet(int epfd)
+{
+    int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons(FLEET_PORT);
+
+    struct ip_mreq mreq;
+    mreq.imr_multiaddr.s_addr = inet_addr(FLEET_GROUP);
+    mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+    // the fleet socket is the one with no tag
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+
+    if (bind(fd, (struct sockaddr*)&local, sizeof(local)) < 0 ||
+        setsockopt(fd, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0 ||
+        epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static
+void receive_fleet(int fd)
+{
+    FleetFrame q;
+    ssize_t n;
+    while ((n = ::recv(fd, &q, sizeof(q), 0)) >= 0) {
+        // frame fields are little-endian, like the hosts this runs on
+        if (size_t(n) < FLEET_SAMPLE_SIZE || q.magic != FLEET_MAGIC || q.version != FLEET_VERSION) {
+            continue;
+        }
+        Oven* oven = find_oven(q.chip);
+        if (!oven || !oven->blynk.connected()) {
+            continue;
+        }
+        const millis_time_t t = BlynkMillis();
+        if (t - oven->lastSent < SEND_MS) {
+            continue;
+        }
+        oven->lastSent = t;
+        oven->blynk.virtualWrite(TELEMETRY_PIN, q.rk / 10.0, q.set_point / 10.0, q.power, q.run);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const char *tokens, *serv;
+    uint16_t port;
+    parse_options(argc, argv, tokens, serv, port);
+
+    const int epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (epfd < 0) {
+        BLYNK_LOG1(BLYNK_F("Can't create epoll"));
+        return 1;
+    }
+    if (!load_tokens(tokens, epfd)) {
+        BLYNK_LOG1(BLYNK_F("No ovens to bridge"));
+        return 1;
+    }
+    const int fleet = open_fleet(epfd);
+    if (fleet < 0) {
+        BLYNK_LOG1(BLYNK_F("Can't join " FLEET_GROUP));
+        return 1;
+    }
+
+    BLYNK_LOG3(BLYNK_F("Bridging "), ovens.size(), BLYNK_F(" ovens"));
+    for (size_t i = 0; i < ovens.size(); i++) {
+        ovens[i]->blynk.begin(ovens[i]->token.c_str(), serv, port);
+    }
+
+    struct epoll_event events[MAX_EVENTS];
+    millis_time_t lastSweep = 0;
+    while (true) {
+        const int n = epoll_wait(epfd, events, MAX_EVENTS, SWEEP_MS);
+        if (n < 0 && errno != EINTR) {
+            BLYNK_LOG1(BLYNK_F("epoll_wait failed"));
+            return 1;
+        }
+        for (int i = 0; i < n; i++) {
+            Oven* oven = (Oven*)events[i].data.ptr;
+            if (!oven) {
+                receive_fleet(fleet);
+                continue;
+            }
+            oven->transport.onEvent(events[i].events);
+            oven->blynk.run();
+        }
+
+        // heartbeats, login timeouts and reconnects run on time even for
+        // sessions whose socket had nothing to say
+        const millis_time_t t = BlynkMillis();
+        if (t - lastSweep >= SWEEP_MS) {
+            lastSweep = t;
+            for (size_t i = 0; i < ovens.size(); i++) {
+                ovens[i]->blynk.run();
+            }
+        }
+    }
+
+    return 0;
+}
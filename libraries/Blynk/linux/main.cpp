@@ -14,11 +14,21 @@
 #else
   #include <BlynkApiLinux.h>
 #endif
-#include <BlynkSocket.h>
 #include <BlynkOptionsParser.h>
 
+#ifdef BLYNK_EVENT_LOOP
+// make loop=event: sleeps in epoll between events, see BlynkEventLoop.h
+#include <BlynkEventLoop.h>
+
+static BlynkEventLoop events;
+static BlynkTransportEpoll _blynkTransport(events.fd(), &_blynkTransport);
+BlynkEpoll Blynk(_blynkTransport);
+#else
+#include <BlynkSocket.h>
+
 static BlynkTransportSocket _blynkTransport;
 BlynkSocket Blynk(_blynkTransport);
+#endif
 
 static const char *auth, *serv;
 static uint16_t port;
@@ -38,12 +48,22 @@ void setup()
     tmr.setInterval(1000, [](){
       Blynk.virtualWrite(V0, BlynkMillis()/1000);
     });
+#ifdef BLYNK_EVENT_LOOP
+    // A button on BCM 17 shows on V2 as soon as it changes
+    events.watchGpio(17, [](unsigned, int value){
+      Blynk.virtualWrite(V2, value);
+    });
+#endif
 }
 
 void loop()
 {
+#ifdef BLYNK_EVENT_LOOP
+    events.run(Blynk, _blynkTransport, &tmr);
+#else
     Blynk.run();
     tmr.run();
+#endif
 }
 
 
@@ -14,6 +14,7 @@
 #include <Blynk/BlynkConfig.h>
 #include <Blynk/BlynkDebug.h>
 #include <Blynk/BlynkParam.h>
+#include <Blynk/BlynkArray.h>
 #include <Blynk/BlynkTimer.h>
 #include <Blynk/BlynkHandlers.h>
 #include <Blynk/BlynkProtocolDefs.h>
@@ -97,6 +98,56 @@ public:
         static_cast<Proto*>(this)->sendCmd(BLYNK_CMD_HARDWARE, 0, cmd.getBuffer(), cmd.getLength(), buff, len);
     }
 
+    /**
+     * Sends several commands to a Virtual Pin in one transport write that
+     * takes a single BLYNK_MSG_LIMIT slot (see WidgetTable::addRows)
+     *
+     * @param pin    Virtual Pin number
+     * @param bodies What follows "vw\0<pin>\0" in each command
+     * @param count  Number of commands; over BLYNK_MAX_BATCH, one write per BLYNK_MAX_BATCH
+     */
+    void virtualWriteBatch(int pin, const BlynkIoVec* bodies, size_t count) {
+        char mem[8];
+        BlynkParam cmd(mem, 0, sizeof(mem));
+        cmd.add("vw");
+        cmd.add(pin);
+        static_cast<Proto*>(this)->sendCmdBatch(BLYNK_CMD_HARDWARE, cmd.getBuffer(), cmd.getLength(), bodies, count);
+    }
+
+    /**
+     * Sends an array of numbers to a Virtual Pin as binary (see BlynkArray.h)
+     *
+     * What does not fit in BLYNK_MAX_SENDBYTES is left out.
+     *
+     * @param pin    Virtual Pin number
+     * @param values int16_t, uint16_t, int32_t, uint32_t or float elements
+     * @param count  Number of elements
+     */
+    template <typename T>
+    void virtualWriteArray(int pin, const T* values, size_t count) {
+        char mem[16];
+        BlynkParam cmd(mem, 0, sizeof(mem));
+        cmd.add("vw");
+        cmd.add(pin);
+        const char tag = BlynkArrayType<T>::tag;
+        cmd.add(&tag, 1);
+
+        const size_t room = (BLYNK_MAX_SENDBYTES - cmd.getLength()) / sizeof(T);
+        if (count > room) {
+            count = room;
+        }
+#ifdef BLYNK_ARRAY_SWAP
+        uint8_t data[BLYNK_MAX_SENDBYTES];
+        for (size_t i = 0; i < count; i++) {
+            BlynkArrayCopy(data + i * sizeof(T), values + i, sizeof(T));
+        }
+#else
+        // already in wire order: goes out straight from the caller's array
+        const T* data = values;
+#endif
+        static_cast<Proto*>(this)->sendCmd(BLYNK_CMD_HARDWARE, 0, cmd.getBuffer(), cmd.getLength(), data, count * sizeof(T));
+    }
+
     /**
      * Sends BlynkParam to a Virtual Pin
      *
@@ -0,0 +1,119 @@
+/**
+ * @file       BlynkArray.h
+ * @license    This project is released under the MIT License (MIT)
+ * @brief      Binary numeric arrays on a Virtual Pin
+ *
+ * virtualWrite() turns every number into text, which on a part without an
+ * FPU means a float formatting call per value and about three times the
+ * bytes. virtualWriteArray() sends the numbers as they are in memory:
+ *
+ *     "vw" \0 <pin> \0 <tag> <count elements, little-endian>
+ *
+ * The tag byte names the element type (BLYNK_ARRAY_*); the count follows
+ * from the frame length. The elements may contain zero bytes, so the
+ * reader has to take the value as raw bytes rather than split it on \0
+ * the way text values are: BlynkArrayReader does that, on the server or
+ * gateway side as well as in a BLYNK_WRITE handler.
+ */
+
+#ifndef BlynkArray_h
+#define BlynkArray_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define BLYNK_ARRAY_INT16   'h'
+#define BLYNK_ARRAY_UINT16  'H'
+#define BLYNK_ARRAY_INT32   'i'
+#define BLYNK_ARRAY_UINT32  'I'
+#define BLYNK_ARRAY_FLOAT   'f'
+
+template <typename T> struct BlynkArrayType;
+template <> struct BlynkArrayType<int16_t>  { enum { tag = BLYNK_ARRAY_INT16  }; };
+template <> struct BlynkArrayType<uint16_t> { enum { tag = BLYNK_ARRAY_UINT16 }; };
+template <> struct BlynkArrayType<int32_t>  { enum { tag = BLYNK_ARRAY_INT32  }; };
+template <> struct BlynkArrayType<uint32_t> { enum { tag = BLYNK_ARRAY_UINT32 }; };
+template <> struct BlynkArrayType<float>    { enum { tag = BLYNK_ARRAY_FLOAT  }; };
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    #define BLYNK_ARRAY_SWAP
+#endif
+
+// Element size for a tag, 0 if the tag is unknown
+inline
+size_t BlynkArrayElementSize(char tag)
+{
+    switch (tag) {
+    case BLYNK_ARRAY_INT16:
+    case BLYNK_ARRAY_UINT16: return 2;
+    case BLYNK_ARRAY_INT32:
+    case BLYNK_ARRAY_UINT32:
+    case BLYNK_ARRAY_FLOAT:  return 4;
+    default:                 return 0;
+    }
+}
+
+// Copies one element to or from wire order
+inline
+void BlynkArrayCopy(void* dst, const void* src, size_t size)
+{
+#ifdef BLYNK_ARRAY_SWAP
+    const uint8_t* s = (const uint8_t*)src;
+    uint8_t* d = (uint8_t*)dst;
+    for (size_t i = 0; i < size; i++) {
+        d[i] = s[size - 1 - i];
+    }
+#else
+    memcpy(dst, src, size);
+#endif
+}
+
+/**
+ * Reads an array value: give it the bytes after the pin number, i.e. a
+ * BLYNK_WRITE param buffer, or the frame body past "vw\0<pin>\0"
+ */
+class BlynkArrayReader
+{
+public:
+    BlynkArrayReader(const void* value, size_t length)
+        : data((const uint8_t*)value), len(length)
+    {}
+
+    bool isValid() const {
+        const size_t size = BlynkArrayElementSize(type());
+        return size && ((len - 1) % size) == 0;
+    }
+
+    char type() const {
+        return len ? (char)data[0] : 0;
+    }
+
+    size_t count() const {
+        return isValid() ? (len - 1) / BlynkArrayElementSize(type()) : 0;
+    }
+
+    // Elements are returned as T whatever their wire type; out of range
+    // or a wrong tag gives 0
+    template <typename T>
+    T get(size_t i) const {
+        if (i >= count()) {
+            return 0;
+        }
+        const uint8_t* p = data + 1 + i * BlynkArrayElementSize(type());
+        switch (type()) {
+        case BLYNK_ARRAY_INT16:  { int16_t  v; BlynkArrayCopy(&v, p, 2); return (T)v; }
+        case BLYNK_ARRAY_UINT16: { uint16_t v; BlynkArrayCopy(&v, p, 2); return (T)v; }
+        case BLYNK_ARRAY_INT32:  { int32_t  v; BlynkArrayCopy(&v, p, 4); return (T)v; }
+        case BLYNK_ARRAY_UINT32: { uint32_t v; BlynkArrayCopy(&v, p, 4); return (T)v; }
+        case BLYNK_ARRAY_FLOAT:  { float    v; BlynkArrayCopy(&v, p, 4); return (T)v; }
+        }
+        return 0;
+    }
+
+private:
+    const uint8_t* data;
+    size_t         len;
+};
+
+#endif
@@ -42,6 +42,24 @@
 #define BLYNK_MSG_LIMIT      15
 #endif
 
+// Uncomment to queue commands over BLYNK_MSG_LIMIT instead of waiting in
+// virtualWrite(): a newer write to the same pin replaces the queued one and
+// notifications go first. The value is the number of queued commands.
+//#define BLYNK_SEND_QUEUE     8
+
+// Commands a batch write (Blynk.virtualWriteBatch, WidgetTable::addRows)
+// puts in one transport write and one BLYNK_MSG_LIMIT slot. The server
+// still counts each of them against its own, much higher, limit.
+#ifndef BLYNK_MAX_BATCH
+#define BLYNK_MAX_BATCH      8
+#endif
+
+// WidgetTerminal holds its output until the buffer is full, or a line ends
+// this long after the oldest byte, or WidgetTerminal::run() finds it older.
+#ifndef BLYNK_TERMINAL_FLUSH_MS
+#define BLYNK_TERMINAL_FLUSH_MS 100
+#endif
+
 // Limit the incoming command length.
 #ifndef BLYNK_MAX_READBYTES
 #define BLYNK_MAX_READBYTES  256
@@ -52,6 +70,13 @@
 #define BLYNK_MAX_SENDBYTES  128
 #endif
 
+// Uncomment to take BlynkParamAllocated buffers from a fixed-block pool
+// instead of malloc (default on ESP8266 and ESP32, see utility/BlynkPool.h)
+//#define BLYNK_USE_POOL
+
+// Uncomment to keep using malloc on ESP8266 and ESP32
+//#define BLYNK_NO_POOL
+
 // Uncomment to use Let's Encrypt Root CA
 //#define BLYNK_SSL_USE_LETSENCRYPT
 
@@ -15,6 +15,8 @@
 #include <stdlib.h>
 #include <Blynk/BlynkConfig.h>
 #include <Blynk/BlynkDebug.h>
+#include <utility/BlynkPool.h>
+#include <utility/BlynkParse.h>
 
 #define BLYNK_PARAM_KV(k, v) k "\0" v "\0"
 #define BLYNK_PARAM_PLACEHOLDER_64 "PlaceholderPlaceholderPlaceholderPlaceholderPlaceholderPlaceholder"
@@ -32,12 +34,14 @@ public:
         operator int () const           { return asInt(); }
         const char* asStr() const       { return ptr; }
         const char* asString() const    { return ptr; }
-        int         asInt() const       { if(!isValid()) return 0; return atoi(ptr); }
-        long        asLong() const      { if(!isValid()) return 0; return atol(ptr); }
+        int         asInt() const       { if(!isValid()) return 0; return BlynkParseLong(ptr); }
+        long        asLong() const      { if(!isValid()) return 0; return BlynkParseLong(ptr); }
         //long long   asLongLong() const  { return atoll(ptr); }
+        // value * 10^decimals, rounded: a slider "0.75" as 75 with 2 decimals
+        long        asFixed(uint8_t decimals) const { if(!isValid()) return 0; return BlynkParseFixed(ptr, decimals); }
 #ifndef BLYNK_NO_FLOAT
-        double      asDouble() const    { if(!isValid()) return 0; return atof(ptr); }
-        float       asFloat() const     { if(!isValid()) return 0; return atof(ptr); }
+        double      asDouble() const    { if(!isValid()) return 0; return BlynkParseDouble(ptr); }
+        float       asFloat() const     { if(!isValid()) return 0; return BlynkParseFloat(ptr); }
 #endif
         bool isValid() const            { return ptr != NULL && ptr < limit; }
         bool isEmpty() const            { if(!isValid()) return true; return *ptr == '\0'; }
@@ -69,12 +73,13 @@ public:
 
     const char* asStr() const       { return buff; }
     const char* asString() const    { return buff; }
-    int         asInt() const       { return atoi(buff); }
-    long        asLong() const      { return atol(buff); }
+    int         asInt() const       { return BlynkParseLong(buff); }
+    long        asLong() const      { return BlynkParseLong(buff); }
     //long long   asLongLong() const  { return atoll(buff); }
+    long        asFixed(uint8_t decimals) const { return BlynkParseFixed(buff, decimals); }
 #ifndef BLYNK_NO_FLOAT
-    double      asDouble() const    { return atof(buff); }
-    float       asFloat() const     { return atof(buff); }
+    double      asDouble() const    { return BlynkParseDouble(buff); }
+    float       asFloat() const     { return BlynkParseFloat(buff); }
 #endif
     bool isEmpty() const            { return *buff == '\0'; }
 
@@ -136,10 +141,10 @@ class BlynkParamAllocated
 {
 public:
     BlynkParamAllocated(size_t size)
-        : BlynkParam(malloc(size), 0, size)
+        : BlynkParam(BlynkPoolAlloc(size), 0, size)
     {}
     ~BlynkParamAllocated() {
-        free(buff);
+        BlynkPoolFree(buff);
     }
 };
 
@@ -18,6 +18,21 @@
 #include <Blynk/BlynkApi.h>
 #include <utility/BlynkUtility.h>
 
+/**
+ * Detects a gather write, size_t Transp::write(const BlynkIoVec*, size_t).
+ */
+template <class T>
+class BlynkHasWriteV
+{
+    template <class U, size_t (U::*)(const BlynkIoVec*, size_t)> struct Check {};
+    template <class U> static char test(Check<U, &U::write>*);
+    template <class U> static long test(...);
+public:
+    enum { value = (sizeof(test<T>(0)) == sizeof(char)) };
+};
+
+template <bool> struct BlynkBoolTag {};
+
 template <class Transp>
 class BlynkProtocol
     : public BlynkApi< BlynkProtocol<Transp> >
@@ -41,6 +56,13 @@ public:
         , msgIdOut(0)
         , msgIdOutOverride(0)
         , nesting(0)
+        , inPos(0)
+        , inSkip(0)
+        , inBusy(false)
+#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0 && defined(BLYNK_SEND_QUEUE)
+        , sendQueued(0)
+        , sendDraining(false)
+#endif
         , state(CONNECTING)
     {}
 
@@ -62,6 +84,7 @@ public:
 
     void disconnect() {
         conn.disconnect();
+        clearQueue();
         state = DISCONNECTED;
         BLYNK_LOG1(BLYNK_F("Disconnected"));
     }
@@ -77,6 +100,7 @@ public:
     }
 
     void sendCmd(uint8_t cmd, uint16_t id = 0, const void* data = NULL, size_t length = 0, const void* data2 = NULL, size_t length2 = 0);
+    void sendCmdBatch(uint8_t cmd, const void* prefix, size_t prefixLength, const BlynkIoVec* bodies, size_t count);
 
     void printBanner() {
 #if defined(BLYNK_NO_FANCY_LOGO)
@@ -97,11 +121,36 @@ private:
     void internalReconnect() {
         state = CONNECTING;
         conn.disconnect();
+        resetInput();
+        clearQueue();
         BlynkOnDisconnected();
     }
 
-    int readHeader(BlynkHeader& hdr);
+    void resetInput() {
+        inPos = 0;
+        inSkip = 0;
+    }
+
+    bool processFrame(const BlynkHeader hdr, uint8_t* inputBuffer);
     uint16_t getNextMsgId();
+    void waitSendSlot();
+
+    size_t writeParts(const BlynkIoVec* iov, size_t count, BlynkBoolTag<true>);
+    size_t writeParts(const BlynkIoVec* iov, size_t count, BlynkBoolTag<false>);
+
+#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0 && defined(BLYNK_SEND_QUEUE)
+    // Milliseconds until BLYNK_MSG_LIMIT lets the next command out
+    int32_t sendWaitTime() const {
+        return int32_t(BlynkMax(lastActivityOut, lastActivityIn) + 1000/BLYNK_MSG_LIMIT - BlynkMillis());
+    }
+
+    bool enqueueCmd(uint8_t cmd, const void* data, size_t length, const void* data2, size_t length2);
+    void drainQueue();
+    void clearQueue();
+#else
+    void drainQueue() {}
+    void clearQueue() {}
+#endif
 
 protected:
     void begin(const char* auth) {
@@ -128,6 +177,26 @@ private:
     uint16_t msgIdOut;
     uint16_t msgIdOutOverride;
     uint8_t  nesting;
+
+    // Frame being received: kept across run() calls until it is complete
+    BlynkHeader inHdr;
+    uint16_t    inPos;      // header + body bytes received so far
+    uint16_t    inSkip;     // body bytes of an oversized frame left to drop
+    bool        inBusy;     // inBuffer is being dispatched
+    uint8_t     inBuffer[BLYNK_MAX_READBYTES+1]; // Add 1 to zero-terminate
+
+#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0 && defined(BLYNK_SEND_QUEUE)
+    // Commands held back by BLYNK_MSG_LIMIT, oldest first
+    struct QueuedCmd {
+        uint8_t* data;      // from the pool, header not included
+        uint16_t length;
+        uint16_t key;       // pin write a newer one replaces, 0 = none
+        uint8_t  cmd;
+    };
+    QueuedCmd sendQueue[BLYNK_SEND_QUEUE];
+    uint8_t   sendQueued;
+    bool      sendDraining;
+#endif
 protected:
     BlynkState state;
 };
@@ -148,7 +217,11 @@ bool BlynkProtocol<Transp>::run(bool avail)
       return true;
     }
 
-    if (conn.connected()) {
+    if (!conn.connected()) {
+        resetInput();   // a partial frame does not survive the connection
+    } else if (!inBusy) {
+        // a nested run() from inside a handler leaves the input alone:
+        // inBuffer still holds the command being handled
         while (avail || conn.available() > 0) {
             //BLYNK_LOG2(BLYNK_F("Available: "), conn.available());
             //const unsigned long t = micros();
@@ -195,6 +268,7 @@ bool BlynkProtocol<Transp>::run(bool avail)
             sendCmd(BLYNK_CMD_PING);
             lastHeartbeat = t;
         }
+        drainQueue();
     } else if (state == CONNECTING) {
 #ifdef BLYNK_USE_DIRECT_CONNECT
         if (!tconn)
@@ -226,20 +300,101 @@ template <class Transp>
 BLYNK_FORCE_INLINE
 bool BlynkProtocol<Transp>::processInput(void)
 {
-    BlynkHeader hdr;
-    const int ret = readHeader(hdr);
+    // Take only what the transport already holds; a partial frame is kept
+    // and completed by later run() calls, so run() never waits on the link.
+    // If nothing is reported available (run(true)), read as before.
+    uint8_t* dst;
+    size_t want;
+    if (inPos < sizeof(BlynkHeader)) {
+        dst = (uint8_t*)&inHdr + inPos;
+        want = sizeof(BlynkHeader) - inPos;
+    } else if (inSkip) {
+        dst = inBuffer;
+        want = BlynkMin(size_t(inSkip), sizeof(inBuffer));
+    } else {
+        dst = inBuffer + (inPos - sizeof(BlynkHeader));
+        want = inHdr.length - (inPos - sizeof(BlynkHeader));
+    }
 
-    if (ret == 0) {
-        return true; // Considered OK (no data on input)
+    const int avail = conn.available();
+    if (avail > 0 && size_t(avail) < want) {
+        want = avail;
     }
 
-    if (ret < 0 || hdr.msg_id == 0) {
+    const size_t rlen = conn.read(dst, want);
+    if (rlen == 0) {
+        return true; // Considered OK (no data on input)
+    }
+    if (rlen > want) {
 #ifdef BLYNK_DEBUG
-        BLYNK_LOG2(BLYNK_F("Bad hdr len: "), ret);
+        BLYNK_LOG1(BLYNK_F("Read error"));
 #endif
+        resetInput();
         return false;
     }
 
+    if (inSkip) {
+        inSkip -= rlen;
+        if (!inSkip) {
+            inPos = 0;
+        }
+        return true;
+    }
+
+    const bool header = (inPos < sizeof(BlynkHeader));
+    inPos += rlen;
+
+    if (header) {
+        if (inPos < sizeof(BlynkHeader)) {
+            return true;
+        }
+
+        BLYNK_DBG_DUMP(">", &inHdr, sizeof(BlynkHeader));
+
+        inHdr.msg_id = ntohs(inHdr.msg_id);
+        inHdr.length = ntohs(inHdr.length);
+
+        if (inHdr.msg_id == 0) {
+#ifdef BLYNK_DEBUG
+            BLYNK_LOG1(BLYNK_F("Bad hdr"));
+#endif
+            resetInput();
+            return false;
+        }
+
+        // Responses have no body: the length field is the status code
+        if (inHdr.type == BLYNK_CMD_RESPONSE) {
+            inPos = 0;
+            return processFrame(inHdr, NULL);
+        }
+
+        if (inHdr.length > BLYNK_MAX_READBYTES) {
+            BLYNK_LOG2(BLYNK_F("Packet too big: "), inHdr.length);
+            // dropped as it arrives; the connection stays up
+            inSkip = inHdr.length;
+            return true;
+        }
+    }
+
+    if (inPos - sizeof(BlynkHeader) < inHdr.length) {
+        return true;
+    }
+
+    inPos = 0;
+    inBuffer[inHdr.length] = '\0';
+
+    BLYNK_DBG_DUMP(">", inBuffer, inHdr.length);
+
+    // Dispatched in place; nested run() calls skip input until it is done
+    inBusy = true;
+    const bool ok = processFrame(inHdr, inBuffer);
+    inBusy = false;
+    return ok;
+}
+
+template <class Transp>
+bool BlynkProtocol<Transp>::processFrame(const BlynkHeader hdr, uint8_t* inputBuffer)
+{
     if (hdr.type == BLYNK_CMD_RESPONSE) {
         lastActivityIn = BlynkMillis();
 
@@ -277,24 +432,6 @@ bool BlynkProtocol<Transp>::processInput(void)
         return true;
     }
 
-    if (hdr.length > BLYNK_MAX_READBYTES) {
-        BLYNK_LOG2(BLYNK_F("Packet too big: "), hdr.length);
-        // TODO: Flush
-        internalReconnect();
-        return true;
-    }
-
-    uint8_t inputBuffer[hdr.length+1]; // Add 1 to zero-terminate
-    if (hdr.length != conn.read(inputBuffer, hdr.length)) {
-#ifdef BLYNK_DEBUG
-        BLYNK_LOG1(BLYNK_F("Can't read body"));
-#endif
-        return false;
-    }
-    inputBuffer[hdr.length] = '\0';
-
-    BLYNK_DBG_DUMP(">", inputBuffer, hdr.length);
-
     lastActivityIn = BlynkMillis();
 
     switch (hdr.type)
@@ -327,7 +464,7 @@ bool BlynkProtocol<Transp>::processInput(void)
     } break;
     case BLYNK_CMD_REDIRECT: {
         if (!redir_serv) {
-             redir_serv = (char*)malloc(32);
+             redir_serv = (char*)BlynkPoolAlloc(32);
         }
         BlynkParam param(inputBuffer, hdr.length);
         uint16_t redir_port = BLYNK_DEFAULT_PORT; // TODO: Fixit
@@ -392,26 +529,6 @@ bool BlynkProtocol<Transp>::processInput(void)
     return true;
 }
 
-template <class Transp>
-int BlynkProtocol<Transp>::readHeader(BlynkHeader& hdr)
-{
-    size_t rlen = conn.read(&hdr, sizeof(hdr));
-    if (rlen == 0) {
-        return 0;
-    }
-
-    if (sizeof(hdr) != rlen) {
-        return -1;
-    }
-
-    BLYNK_DBG_DUMP(">", &hdr, sizeof(BlynkHeader));
-
-    hdr.msg_id = ntohs(hdr.msg_id);
-    hdr.length = ntohs(hdr.length);
-
-    return rlen;
-}
-
 #ifndef BLYNK_SEND_THROTTLE
 #define BLYNK_SEND_THROTTLE 0
 #endif
@@ -430,49 +547,148 @@ void BlynkProtocol<Transp>::sendCmd(uint8_t cmd, uint16_t id, const void* data,
         return;
     }
 
+#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0 && defined(BLYNK_SEND_QUEUE)
+    // Over the limit, or behind commands already waiting: queue it instead
+    // of waiting here. Replies to the server (msgIdOutOverride) keep their
+    // id and go out now, as do pings, which are not limited.
+    if (cmd >= BLYNK_CMD_TWEET && cmd <= BLYNK_CMD_HARDWARE &&
+        0 == id && !msgIdOutOverride && !sendDraining &&
+        (sendQueued || sendWaitTime() >= 0) &&
+        enqueueCmd(cmd, data, length, data2, length2))
+    {
+        return;
+    }
+#endif
+
     if (0 == id) {
         id = getNextMsgId();
     }
 
-#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0
     if (cmd >= BLYNK_CMD_TWEET && cmd <= BLYNK_CMD_HARDWARE) {
-        const millis_time_t allowed_time = BlynkMax(lastActivityOut, lastActivityIn) + 1000/BLYNK_MSG_LIMIT;
-        int32_t wait_time = allowed_time - BlynkMillis();
-        if (wait_time >= 0) {
+        waitSendSlot();
+    }
+
+    const size_t full_length = (sizeof(BlynkHeader)) +
+                               (data  ? length  : 0) +
+                               (data2 ? length2 : 0);
+
+    BlynkHeader hdr;
+    hdr.type = cmd;
+    hdr.msg_id = htons(id);
+    hdr.length = htons(length+length2);
+
+    // Responses carry the status code in the length field and no body
+    const BlynkIoVec iov[3] = {
+        { &hdr,  sizeof(hdr) },
+        { data,  data  ? length  : 0 },
+        { data2, data2 ? length2 : 0 }
+    };
+
+    const size_t wlen = writeParts(iov, 3, BlynkBoolTag<BlynkHasWriteV<Transp>::value>());
+
+    if (wlen != full_length) {
+#ifdef BLYNK_DEBUG
+        BLYNK_LOG4(BLYNK_F("Sent "), wlen, '/', full_length);
+#endif
+        internalReconnect();
+        return;
+    }
+
+    lastActivityOut = BlynkMillis();
+
+}
+
+// Several commands of one type, each "prefix + body" with its own header,
+// in a single write and a single BLYNK_MSG_LIMIT slot (virtualWriteBatch)
+template <class Transp>
+void BlynkProtocol<Transp>::sendCmdBatch(uint8_t cmd, const void* prefix, size_t prefixLength, const BlynkIoVec* bodies, size_t count)
+{
+    while (count > BLYNK_MAX_BATCH) {
+        sendCmdBatch(cmd, prefix, prefixLength, bodies, BLYNK_MAX_BATCH);
+        bodies += BLYNK_MAX_BATCH;
+        count -= BLYNK_MAX_BATCH;
+    }
+    if (!count || !conn.connected() || state != CONNECTED) {
 #ifdef BLYNK_DEBUG_ALL
-            BLYNK_LOG2(BLYNK_F("Waiting:"), wait_time);
+        BLYNK_LOG2(BLYNK_F("Batch skipped:"), cmd);
 #endif
-            while (wait_time >= 0) {
-                run();
-                wait_time = allowed_time - BlynkMillis();
-            }
-        } else if (nesting == 0) {
-            run();
+        return;
+    }
+
+#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0 && defined(BLYNK_SEND_QUEUE)
+    // Queued commands may be for the same pin ("clr" before the rows):
+    // they go first, in their slots
+    while (sendQueued && conn.connected()) {
+        drainQueue();
+        run();
+    }
+#endif
+    waitSendSlot();
+
+    BlynkHeader hdr[BLYNK_MAX_BATCH];
+    BlynkIoVec iov[3 * BLYNK_MAX_BATCH];
+    size_t full_length = 0;
+    for (size_t i = 0; i < count; i++) {
+        hdr[i].type = cmd;
+        hdr[i].msg_id = htons(getNextMsgId());
+        hdr[i].length = htons(prefixLength + bodies[i].length);
+        iov[3*i].base = &hdr[i];
+        iov[3*i].length = sizeof(BlynkHeader);
+        iov[3*i+1].base = prefix;
+        iov[3*i+1].length = prefixLength;
+        iov[3*i+2] = bodies[i];
+        full_length += sizeof(BlynkHeader) + prefixLength + bodies[i].length;
+    }
+
+    const size_t wlen = writeParts(iov, 3 * count, BlynkBoolTag<BlynkHasWriteV<Transp>::value>());
+
+    if (wlen != full_length) {
+#ifdef BLYNK_DEBUG
+        BLYNK_LOG4(BLYNK_F("Sent "), wlen, '/', full_length);
+#endif
+        internalReconnect();
+        return;
+    }
+
+    lastActivityOut = BlynkMillis();
+}
+
+// Gather write: header and payload go from the callers' buffers straight
+// to the transport, in one call
+template <class Transp>
+size_t BlynkProtocol<Transp>::writeParts(const BlynkIoVec* iov, size_t count, BlynkBoolTag<true>)
+{
+#ifdef BLYNK_DEBUG_ALL
+    for (size_t i = 0; i < count; i++) {
+        if (iov[i].length) {
+            BLYNK_DBG_DUMP("<", iov[i].base, iov[i].length);
         }
     }
 #endif
+    const size_t w = conn.write(iov, count);
+    BlynkDelay(BLYNK_SEND_THROTTLE);
+    return w;
+}
 
-    const size_t full_length = (sizeof(BlynkHeader)) +
-                               (data  ? length  : 0) +
-                               (data2 ? length2 : 0);
+template <class Transp>
+size_t BlynkProtocol<Transp>::writeParts(const BlynkIoVec* iov, size_t count, BlynkBoolTag<false>)
+{
+    size_t full_length = 0;
+    for (size_t i = 0; i < count; i++) {
+        full_length += iov[i].length;
+    }
 
 #if defined(BLYNK_SEND_ATOMIC) || defined(ESP8266) || defined(ESP32) || defined(SPARK) || defined(PARTICLE) || defined(ENERGIA)
     // Those have more RAM and like single write at a time...
 
     uint8_t buff[full_length];
 
-    BlynkHeader* hdr = (BlynkHeader*)buff;
-    hdr->type = cmd;
-    hdr->msg_id = htons(id);
-    hdr->length = htons(length+length2);
-
-    size_t pos = sizeof(BlynkHeader);
-    if (data && length) {
-        memcpy(buff + pos, data, length);
-        pos += length;
-    }
-    if (data2 && length2) {
-        memcpy(buff + pos, data2, length2);
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (iov[i].length) {
+            memcpy(buff + pos, iov[i].base, iov[i].length);
+            pos += iov[i].length;
+        }
     }
 
     size_t wlen = 0;
@@ -485,50 +701,174 @@ void BlynkProtocol<Transp>::sendCmd(uint8_t cmd, uint16_t id, const void* data,
 #ifdef BLYNK_DEBUG
             BLYNK_LOG1(BLYNK_F("Cmd error"));
 #endif
-            conn.disconnect();
-            state = CONNECTING;
-            BlynkOnDisconnected();
-            return;
+            break;
         }
         wlen += w;
     }
 
 #else
 
-    BlynkHeader hdr;
-    hdr.type = cmd;
-    hdr.msg_id = htons(id);
-    hdr.length = htons(length+length2);
+    size_t wlen = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (iov[i].length) {
+            BLYNK_DBG_DUMP("<", iov[i].base, iov[i].length);
+            wlen += conn.write(iov[i].base, iov[i].length);
+            BlynkDelay(BLYNK_SEND_THROTTLE);
+        }
+    }
 
-    BLYNK_DBG_DUMP("<", &hdr, sizeof(hdr));
-    size_t wlen = conn.write(&hdr, sizeof(hdr));
-    BlynkDelay(BLYNK_SEND_THROTTLE);
+#endif
 
-    if (cmd != BLYNK_CMD_RESPONSE) {
-        if (length) {
-            BLYNK_DBG_DUMP("<", data, length);
-            wlen += conn.write(data, length);
-            BlynkDelay(BLYNK_SEND_THROTTLE);
+    return wlen;
+}
+
+#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0 && defined(BLYNK_SEND_QUEUE)
+
+// Notifications are few and someone is waiting for them: they overtake pin
+// writes, which are many and of which only the latest value matters
+static inline
+bool BlynkQueueUrgent(uint8_t cmd) {
+    return cmd == BLYNK_CMD_NOTIFY || cmd == BLYNK_CMD_EMAIL ||
+           cmd == BLYNK_CMD_TWEET  || cmd == BLYNK_CMD_SMS;
+}
+
+// Only a plain "vw\0<pin>\0<number>" (or aw/dw), all in the first buffer,
+// gives a key ('v' and the pin). Anything else keeps its place in line
+// and is never replaced: Terminal appends (virtualWriteBinary, text in the
+// second buffer), Table and Terminal commands ("clr", "add\0id\0...") and
+// any other text or multi-value write, whose order matters.
+static inline
+uint16_t BlynkQueueKey(uint8_t cmd, const void* data, size_t length, size_t length2) {
+    const char* body = (const char*)data;
+    if (cmd != BLYNK_CMD_HARDWARE || length2 || length < 6 || body[1] != 'w' || body[2] != '\0' ||
+        (body[0] != 'v' && body[0] != 'a' && body[0] != 'd'))
+    {
+        return 0;
+    }
+    const char* pin = body + 3;
+    const char* end = body + length;
+    const char* value = (const char*)memchr(pin, '\0', end - pin);
+    if (!value || value == pin || ++value == end) {
+        return 0;
+    }
+    // the value runs to the end: no further separator, and it is a number
+    char text[24];
+    const size_t n = end - value;
+    if (n >= sizeof(text) || memchr(value, '\0', n)) {
+        return 0;
+    }
+    memcpy(text, value, n);
+    text[n] = '\0';
+    char* rest;
+    strtod(text, &rest);
+    if (rest == text || *rest != '\0') {
+        return 0;
+    }
+    return (uint16_t(body[0]) << 8) | (atoi(pin) & 0xFF);
+}
+
+template <class Transp>
+bool BlynkProtocol<Transp>::enqueueCmd(uint8_t cmd, const void* data, size_t length, const void* data2, size_t length2)
+{
+    if (!data) {
+        length = 0;
+    }
+    if (!data2) {
+        length2 = 0;
+    }
+    const uint16_t key = BlynkQueueKey(cmd, data, length, length2);
+
+    QueuedCmd* e = NULL;
+    if (key) {
+        for (uint8_t i = 0; i < sendQueued; i++) {
+            if (sendQueue[i].key == key) {
+                // the newer value takes the older one's place in line
+                e = &sendQueue[i];
+                BlynkPoolFree(e->data);
+                break;
+            }
         }
-        if (length2) {
-            BLYNK_DBG_DUMP("<", data2, length2);
-            wlen += conn.write(data2, length2);
-            BlynkDelay(BLYNK_SEND_THROTTLE);
+    }
+    if (!e) {
+        if (sendQueued >= BLYNK_SEND_QUEUE) {
+            return false;   // full: the caller waits for its turn as before
         }
+        e = &sendQueue[sendQueued++];
     }
 
-#endif
+    e->data = (uint8_t*)BlynkPoolAlloc(length + length2);
+    if (!e->data) {
+        // drop the slot; a replaced entry loses its older value too
+        *e = sendQueue[--sendQueued];
+        return false;
+    }
+    if (length) {
+        memcpy(e->data, data, length);
+    }
+    if (length2) {
+        memcpy(e->data + length, data2, length2);
+    }
+    e->length = length + length2;
+    e->key = key;
+    e->cmd = cmd;
+    return true;
+}
 
-    if (wlen != full_length) {
-#ifdef BLYNK_DEBUG
-        BLYNK_LOG4(BLYNK_F("Sent "), wlen, '/', full_length);
-#endif
-        internalReconnect();
+// One command per BLYNK_MSG_LIMIT slot, urgent ones first
+template <class Transp>
+void BlynkProtocol<Transp>::drainQueue()
+{
+    if (!sendQueued || sendWaitTime() >= 0) {
         return;
     }
+    uint8_t next = 0;
+    for (uint8_t i = 0; i < sendQueued; i++) {
+        if (BlynkQueueUrgent(sendQueue[i].cmd)) {
+            next = i;
+            break;
+        }
+    }
+    const QueuedCmd e = sendQueue[next];
+    for (uint8_t i = next + 1; i < sendQueued; i++) {
+        sendQueue[i - 1] = sendQueue[i];
+    }
+    sendQueued--;
 
-    lastActivityOut = BlynkMillis();
+    sendDraining = true;
+    sendCmd(e.cmd, 0, e.data, e.length);
+    sendDraining = false;
+    BlynkPoolFree(e.data);
+}
 
+template <class Transp>
+void BlynkProtocol<Transp>::clearQueue()
+{
+    while (sendQueued) {
+        BlynkPoolFree(sendQueue[--sendQueued].data);
+    }
+}
+
+#endif
+
+// Spins in run() until BLYNK_MSG_LIMIT lets the next command out
+template <class Transp>
+void BlynkProtocol<Transp>::waitSendSlot()
+{
+#if defined(BLYNK_MSG_LIMIT) && BLYNK_MSG_LIMIT > 0
+    const millis_time_t allowed_time = BlynkMax(lastActivityOut, lastActivityIn) + 1000/BLYNK_MSG_LIMIT;
+    int32_t wait_time = allowed_time - BlynkMillis();
+    if (wait_time >= 0) {
+#ifdef BLYNK_DEBUG_ALL
+        BLYNK_LOG2(BLYNK_F("Waiting:"), wait_time);
+#endif
+        while (wait_time >= 0) {
+            run();
+            wait_time = allowed_time - BlynkMillis();
+        }
+    } else if (nesting == 0) {
+        run();
+    }
+#endif
 }
 
 template <class Transp>
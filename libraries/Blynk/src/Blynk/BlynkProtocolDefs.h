@@ -73,6 +73,17 @@ struct BlynkHeader
 }
 BLYNK_ATTR_PACKED;
 
+/**
+ * One piece of an outgoing message, for transports that implement
+ *   size_t write(const BlynkIoVec* iov, size_t count);
+ * (a writev-style gather write returning the total bytes written).
+ */
+struct BlynkIoVec
+{
+    const void* base;
+    size_t      length;
+};
+
 #if !defined(htons) && (defined(ARDUINO) || defined(ESP8266) || defined(PARTICLE) || defined(__MBED__))
     #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
         #define htons(x) ( ((x)<<8) | (((x)>>8)&0xFF) )
@@ -7,6 +7,8 @@
  *
  * Modifications by Bill Knight <billk@rosw.com> 18March2017
  *
+ * Timers kept in a list ordered by expiry, caller-owned timers
+ *
  * This library is free software; you can redistribute it
  * and/or modify it under the terms of the GNU Lesser
  * General Public License as published by the Free Software
@@ -29,6 +31,7 @@
 #ifndef BLYNKTIMER_H
 #define BLYNKTIMER_H
 
+#include <stdint.h>
 #include <Blynk/BlynkDebug.h>
 
 // Replace SimpleTimer
@@ -38,10 +41,53 @@
 typedef void (*timer_callback)(void);
 typedef void (*timer_callback_p)(void *);
 
+class SimpleTimer;
+class BlynkTimerEntry;
+
+typedef void (*timer_callback_e)(BlynkTimerEntry&);
+
+// A timer whose storage belongs to the caller, so there is no limit on how
+// many a sketch registers. Derive from it to keep the callback's arguments
+// next to the timer:
+//
+//     struct Blink : BlynkTimerEntry { int pin; };
+//     void blink(BlynkTimerEntry& e) { toggle(static_cast<Blink&>(e).pin); }
+//
+// It must outlive its registration or be deleted first; the destructor
+// takes it out of its timer.
+class BlynkTimerEntry {
+public:
+    BlynkTimerEntry();
+    ~BlynkTimerEntry();
+
+    bool isEnabled() const { return enabled; }
+    void enable()          { enabled = true; }
+    void disable()         { enabled = false; }
+
+private:
+    friend class SimpleTimer;
+
+    // linked in place: not copyable
+    BlynkTimerEntry(const BlynkTimerEntry&);
+    BlynkTimerEntry& operator=(const BlynkTimerEntry&);
+
+    BlynkTimerEntry* next;              // in the owner's list, earliest first
+    SimpleTimer* owner;                 // NULL while not registered
+    unsigned long prev_millis;          // start of the current period
+    unsigned long delay;                // delay value
+    void* callback;                     // pointer to the callback function
+    void* param;                        // function parameter
+    unsigned maxNumRuns;                // number of runs to be executed
+    unsigned numRuns;                   // number of executed runs
+    uint8_t kind;                       // which of the callback types above
+    bool enabled;                       // true if enabled
+};
+
 class SimpleTimer {
 
 public:
-    // maximum number of timers
+    // maximum number of timers with a number; BlynkTimerEntry timers have
+    // no limit
     const static int MAX_TIMERS = 16;
 
     // setTimer() constants
@@ -51,11 +97,19 @@ public:
     // constructor
     SimpleTimer();
 
+    // caller-owned timers still registered are let go
+    ~SimpleTimer();
+
     void init();
 
     // this function must be called inside loop()
+    // timers are kept in order of expiry, so it only looks at the ones due
     void run();
 
+    // milliseconds until run() has something to do, 0 if a timer is due
+    // now, -1 with no timer: an event loop sleeps that long
+    long msUntilNext();
+
     // Timer will call function 'f' every 'd' milliseconds forever
     // returns the timer number (numTimer) on success or
     // -1 on failure (f == NULL) or no free timers
@@ -86,6 +140,19 @@ public:
     // -1 on failure (f == NULL) or no free timers
     int setTimer(unsigned long d, timer_callback_p f, void* p, unsigned n);
 
+    // The same for a caller-owned timer 'e', called with 'e' itself;
+    // registering it again replaces what it did before.
+    // return false if f == NULL
+    bool setInterval(BlynkTimerEntry& e, unsigned long d, timer_callback_e f);
+    bool setTimeout(BlynkTimerEntry& e, unsigned long d, timer_callback_e f);
+    bool setTimer(BlynkTimerEntry& e, unsigned long d, timer_callback_e f, unsigned n);
+
+    // takes a caller-owned timer out; it can be registered again
+    void deleteTimer(BlynkTimerEntry& e);
+
+    // restart a caller-owned timer
+    void restartTimer(BlynkTimerEntry& e);
+
     // updates interval of the specified timer
     bool changeInterval(unsigned numTimer, unsigned long d);
 
@@ -121,32 +188,27 @@ public:
     unsigned getNumAvailableTimers() { return MAX_TIMERS - numTimers; };
 
 private:
-    // deferred call constants
-    const static int DEFCALL_DONTRUN = 0;       // don't call the callback function
-    const static int DEFCALL_RUNONLY = 1;       // call the callback function but don't delete the timer
-    const static int DEFCALL_RUNANDDEL = 2;     // call the callback function and delete the timer
+    // the list points into the timers: not copyable
+    SimpleTimer(const SimpleTimer&);
+    SimpleTimer& operator=(const SimpleTimer&);
 
     // low level function to initialize and enable a new timer
     // returns the timer number (numTimer) on success or
     // -1 on failure (f == NULL) or no free timers
-    int setupTimer(unsigned long d, void* f, void* p, bool h, unsigned n);
+    int setupTimer(unsigned long d, void* f, void* p, uint8_t k, unsigned n);
+
+    // fills in and links a timer
+    void arm(BlynkTimerEntry& e, unsigned long d, void* f, void* p, uint8_t k, unsigned n);
 
     // find the first available slot
     int findFirstFreeSlot();
 
-    typedef struct {
-      unsigned long prev_millis;        // value returned by the millis() function in the previous run() call
-      void* callback;                   // pointer to the callback function
-      void* param;                      // function parameter
-      bool hasParam;                 // true if callback takes a parameter
-      unsigned long delay;              // delay value
-      unsigned maxNumRuns;              // number of runs to be executed
-      unsigned numRuns;                 // number of executed runs
-      bool enabled;                  // true if enabled
-      unsigned toBeCalled;              // deferred function call (sort of) - N.B.: only used in run()
-    } timer_t;
-
-    timer_t timer[MAX_TIMERS];
+    // keeps the list in order of expiry
+    void link(BlynkTimerEntry& e);
+    void unlink(BlynkTimerEntry& e);
+
+    BlynkTimerEntry timer[MAX_TIMERS];
+    BlynkTimerEntry* head;              // the next timer to expire
 
     // actual number of timers in use (-1 means uninitialized)
     int numTimers;
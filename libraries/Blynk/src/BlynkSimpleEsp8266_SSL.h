@@ -24,6 +24,26 @@
 // Fingerprint is not used by default
 //#define BLYNK_DEFAULT_FINGERPRINT "FD C0 7D 8D 47 97 F7 E3 07 05 D3 4E E3 BB 8E 3D C0 EA BE 1C"
 
+// BearSSL is used by default: it keeps the TLS session between reconnects,
+// so coming back after a WiFi drop costs one round trip instead of a full
+// handshake. Define this to go back to the axTLS client.
+//#define BLYNK_SSL_USE_AXTLS
+
+// With BearSSL the receive buffer is sized to the smallest max fragment
+// length (RFC 6066) the server accepts, probed once per server, instead of
+// the 16 KB a record may otherwise carry. Blynk messages are small, so the
+// send buffer stays at BLYNK_SSL_TX_BUFFER. A server without MFLN support
+// gets the full 16 KB receive buffer.
+#ifndef BLYNK_SSL_MFLN_MIN
+#define BLYNK_SSL_MFLN_MIN  512
+#endif
+#ifndef BLYNK_SSL_MFLN_MAX
+#define BLYNK_SSL_MFLN_MAX  4096
+#endif
+#ifndef BLYNK_SSL_TX_BUFFER
+#define BLYNK_SSL_TX_BUFFER 512
+#endif
+
 #if defined(BLYNK_SSL_USE_LETSENCRYPT)
   static const unsigned char BLYNK_DEFAULT_CERT_DER[] PROGMEM =
   #include <certs/dst_der.h>  // TODO: using DST Root CA X3 for now
@@ -41,6 +61,36 @@
 #include <WiFiClientSecure.h>
 #include <time.h>
 
+// Synchronize time using SNTP. This is necessary to verify that
+// the TLS certificates offered by the server are currently valid.
+static inline
+time_t BlynkSyncTime()
+{
+    static bool started = false;
+    if (!started) {
+        configTime(0, 0, "pool.ntp.org", "time.nist.gov");
+        started = true;
+    }
+    time_t now = time(nullptr);
+    if (now >= 100000) {
+        return now;  // SNTP keeps it up to date from here on
+    }
+    while (now < 100000) {
+      delay(500);
+      now = time(nullptr);
+    }
+    struct tm timeinfo;
+    gmtime_r(&now, &timeinfo);
+    String ntpTime = asctime(&timeinfo);
+    ntpTime.trim();
+    BLYNK_LOG2("NTP time: ", ntpTime);
+    return now;
+}
+
+#if defined(BLYNK_SSL_USE_AXTLS)
+
+typedef WiFiClientSecure BlynkSecureClient;
+
 template <typename Client>
 class BlynkArduinoClientSecure
     : public BlynkArduinoClientGen<Client>
@@ -70,19 +120,7 @@ public:
     }
 
     bool connect() {
-        // Synchronize time useing SNTP. This is necessary to verify that
-        // the TLS certificates offered by the server are currently valid.
-        configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-        time_t now = time(nullptr);
-        while (now < 100000) {
-          delay(500);
-          now = time(nullptr);
-        }
-        struct tm timeinfo;
-        gmtime_r(&now, &timeinfo);
-        String ntpTime = asctime(&timeinfo);
-        ntpTime.trim();
-        BLYNK_LOG2("NTP time: ", ntpTime);
+        BlynkSyncTime();
 
         // Now try connecting
         if (BlynkArduinoClientGen<Client>::connect()) {
@@ -103,6 +141,106 @@ private:
     const char* fingerprint;
 };
 
+#else
+
+typedef BearSSL::WiFiClientSecure BlynkSecureClient;
+
+template <typename Client>
+class BlynkArduinoClientSecure
+    : public BlynkArduinoClientGen<Client>
+{
+public:
+    BlynkArduinoClientSecure(Client& client)
+        : BlynkArduinoClientGen<Client>(client)
+        , rxSize(0), txSize(0), probed(false)
+    {
+        // The client saves the session parameters here on stop() and
+        // offers them back to the server on the next connect()
+        client.setSession(&session);
+    }
+
+    void setFingerprint(const char* fp) {
+        if (!this->client->setFingerprint(fp)) {
+          BLYNK_LOG1("Invalid fingerprint!");
+        }
+    }
+
+    bool setCACert(const uint8_t* caCert, unsigned caCertLen) {
+        // X509List reads from RAM and PROGMEM alike
+        return setCACert_P(caCert, caCertLen);
+    }
+
+    bool setCACert_P(const uint8_t* caCert, unsigned caCertLen) {
+        bool res = caCerts.append(caCert, caCertLen);
+        if (!res) {
+          BLYNK_LOG1("Failed to load root CA certificate!");
+          return false;
+        }
+        this->client->setTrustAnchors(&caCerts);
+        return res;
+    }
+
+    bool connect() {
+        this->client->setX509Time(BlynkSyncTime());
+        sizeBuffers();
+
+        // The certificate (or fingerprint) is checked during the handshake;
+        // a resumed session was checked when it was first set up
+        if (BlynkArduinoClientGen<Client>::connect()) {
+          BLYNK_LOG1(BLYNK_F("Certificate OK"));
+          probed = true;   // the network was up: keep what the probe found
+          return true;
+        }
+        if (this->client->getLastSSLError() == 0) {
+          return false;   // no TCP connection, keep the session for later
+        }
+        // The handshake itself failed: don't offer that session again
+        session = BearSSL::Session();
+        BLYNK_LOG1(BLYNK_F("Certificate not validated"));
+        return false;
+    }
+
+    // Record buffers in use, without BearSSL's own overhead; 0 before
+    // the first connect()
+    unsigned rxBufferSize() const { return rxSize; }
+    unsigned txBufferSize() const { return txSize; }
+    bool fragmentNegotiated() const { return rxSize && rxSize < 16384; }
+
+private:
+    bool probe(uint16_t len) {
+        if (this->domain) {
+          return BearSSL::WiFiClientSecure::probeMaxFragmentLength(this->domain, this->port, len);
+        }
+        return BearSSL::WiFiClientSecure::probeMaxFragmentLength(this->addr, this->port, len);
+    }
+
+    // Each probe is a TCP connection and a ClientHello. A failed probe
+    // looks the same as a network that is down, so the result is only
+    // kept once a connect() has gone through
+    void sizeBuffers() {
+        if (!probed) {
+          rxSize = 16384;
+          for (uint16_t len = BLYNK_SSL_MFLN_MIN; len <= BLYNK_SSL_MFLN_MAX; len *= 2) {
+            if (probe(len)) {
+              rxSize = len;
+              break;
+            }
+          }
+          txSize = BLYNK_SSL_TX_BUFFER < rxSize ? BLYNK_SSL_TX_BUFFER : rxSize;
+          BLYNK_LOG4(BLYNK_F("TLS buffers: rx "), rxSize, BLYNK_F(", tx "), txSize);
+        }
+        this->client->setBufferSizes(rxSize, txSize);
+    }
+
+    BearSSL::Session  session;
+    BearSSL::X509List caCerts;
+    unsigned          rxSize;
+    unsigned          txSize;
+    bool              probed;
+};
+
+#endif
+
 template <typename Transport>
 class BlynkWifi
     : public BlynkProtocol<Transport>
@@ -189,9 +327,9 @@ public:
 
 };
 
-static WiFiClientSecure _blynkWifiClient;
-static BlynkArduinoClientSecure<WiFiClientSecure> _blynkTransport(_blynkWifiClient);
-BlynkWifi<BlynkArduinoClientSecure<WiFiClientSecure> > Blynk(_blynkTransport);
+static BlynkSecureClient _blynkWifiClient;
+static BlynkArduinoClientSecure<BlynkSecureClient> _blynkTransport(_blynkWifiClient);
+BlynkWifi<BlynkArduinoClientSecure<BlynkSecureClient> > Blynk(_blynkTransport);
 
 #include <BlynkWidgets.h>
 
@@ -42,14 +42,19 @@ class BlynkTransportShieldEsp8266
             return;
         }
         //BLYNK_LOG4("Got: ", len, ", Free: ", buffer.free());
-        if (buffer.free() < len) {
+        bool overflow = buffer.free() < len;
+        if (overflow) {
           BLYNK_LOG1(BLYNK_F("Buffer overflow"));
-          return;
         }
+        // through the ESP8266 object: part of the payload may already sit
+        // in its RX ring. On overflow the payload is still consumed, so it
+        // is not parsed as AT responses
         while (len) {
-            if (client->getUart()->available()) {
-                uint8_t b = client->getUart()->read();
-                buffer.put(b);
+            if (client->available()) {
+                uint8_t b = client->read();
+                if (!overflow) {
+                    buffer.put(b);
+                }
                 len--;
             }
         }
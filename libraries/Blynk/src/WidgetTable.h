@@ -54,11 +54,55 @@ public:
         Blynk.virtualWrite(mPin, "update", index, name, value);
     }
 
+    /**
+     * Adds count rows, indices firstIndex on, in as few writes as fit
+     * BLYNK_MAX_BATCH rows and BLYNK_MAX_SENDBYTES of them each, one
+     * BLYNK_MSG_LIMIT slot per write instead of one per row
+     */
+    template <typename T1, typename T2>
+    void addRows(int firstIndex, const T1 names[], const T2 values[], size_t count) {
+        sendRows("add", firstIndex, names, values, count);
+    }
+
+    template <typename T1, typename T2>
+    void updateRows(int firstIndex, const T1 names[], const T2 values[], size_t count) {
+        sendRows("update", firstIndex, names, values, count);
+    }
+
     void pickRow(int index) {
         Blynk.virtualWrite(mPin, "pick", index);
     }
 
 private:
+    template <typename T1, typename T2>
+    void sendRows(const char* op, int firstIndex, const T1 names[], const T2 values[], size_t count) {
+        char mem[BLYNK_MAX_SENDBYTES];   // rows of the batch, back to back
+        char one[BLYNK_MAX_SENDBYTES];
+        BlynkIoVec rows[BLYNK_MAX_BATCH];
+        size_t used = 0;
+        size_t qty = 0;
+        for (size_t i = 0; i < count; i++) {
+            BlynkParam row(one, 0, sizeof(one));
+            row.add(op);
+            row.add(int(firstIndex + i));
+            row.add(names[i]);
+            row.add(values[i]);
+            const size_t len = row.getLength() - 1;
+            if (qty == BLYNK_MAX_BATCH || used + len > sizeof(mem)) {
+                Blynk.virtualWriteBatch(mPin, rows, qty);
+                used = qty = 0;
+            }
+            memcpy(mem + used, one, len);
+            rows[qty].base = mem + used;
+            rows[qty].length = len;
+            used += len;
+            qty++;
+        }
+        if (qty) {
+            Blynk.virtualWriteBatch(mPin, rows, qty);
+        }
+    }
+
     ItemOrderChange  mOnOrderChange;
     ItemSelectChange mOnSelectChange;
 
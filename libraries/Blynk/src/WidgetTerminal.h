@@ -18,6 +18,12 @@
 
 #include <Blynk/BlynkWidgetBase.h>
 
+// Output is sent in virtualWriteBinary() commands of up to this many bytes,
+// leaving room for "vw\0<pin>\0" in BLYNK_MAX_SENDBYTES
+#ifndef BLYNK_TERMINAL_BUFFER
+#define BLYNK_TERMINAL_BUFFER (BLYNK_MAX_SENDBYTES - 8)
+#endif
+
 #ifdef BLYNK_USE_PRINT_CLASS
     #if !(defined(SPARK) || defined(PARTICLE) || (PLATFORM_ID==88) || defined(ARDUINO_RedBear_Duo)) // 88 -> RBL Duo
         // On Particle this is auto-included
@@ -35,16 +41,23 @@ public:
     WidgetTerminal(uint8_t vPin)
         : BlynkWidgetBase(vPin)
         , mOutQty(0)
+        , mOutSince(0)
     {}
 
     //virtual ~WidgetTerminal() {}
 
     virtual size_t write(uint8_t byte) {
-        mOutBuf[mOutQty++] = byte;
-        if (mOutQty >= sizeof(mOutBuf)) {
+        append(&byte, 1);
+        return 1;
+    }
+
+    /**
+     * Call from loop(): sends output held for BLYNK_TERMINAL_FLUSH_MS
+     */
+    void run() {
+        if (mOutQty && BlynkMillis() - mOutSince >= BLYNK_TERMINAL_FLUSH_MS) {
             flush();
         }
-        return 1;
     }
 
     virtual void flush() {
@@ -63,18 +76,19 @@ public:
 
     using Print::write;
 
+    virtual size_t write(const uint8_t* buff, size_t len) {
+        append(buff, len);
+        return len;
+    }
+
     virtual size_t write(const void* buff, size_t len) {
-        return write((char*)buff, len);
+        return write((const uint8_t*)buff, len);
     }
 
 #else
 
     virtual size_t write(const void* buff, size_t len) {
-        uint8_t* buf = (uint8_t*)buff;
-        size_t left = len;
-        while (left--) {
-            write(*buf++);
-        }
+        append((const uint8_t*)buff, len);
         return len;
     }
 
@@ -85,8 +99,33 @@ public:
 #endif
 
 private:
-    uint8_t mOutBuf[64];
-    uint8_t mOutQty;
+    // Many small prints make one command: a full buffer goes out at once,
+    // a line ending only once the oldest byte waited BLYNK_TERMINAL_FLUSH_MS
+    void append(const uint8_t* data, size_t len) {
+        if (!mOutQty && len) {
+            mOutSince = BlynkMillis();
+        }
+        while (len) {
+            const size_t n = BlynkMin(len, sizeof(mOutBuf) - mOutQty);
+            memcpy(mOutBuf + mOutQty, data, n);
+            mOutQty += n;
+            data += n;
+            len -= n;
+            if (mOutQty >= sizeof(mOutBuf)) {
+                flush();
+                if (len) {
+                    mOutSince = BlynkMillis();
+                }
+            }
+        }
+        if (mOutQty && mOutBuf[mOutQty - 1] == '\n') {
+            run();
+        }
+    }
+
+    uint8_t  mOutBuf[BLYNK_TERMINAL_BUFFER];
+    uint16_t mOutQty;
+    millis_time_t mOutSince;
 };
 
 #endif
@@ -220,7 +220,10 @@
 
     void BlynkDelay(millis_time_t ms)
     {
-        usleep(ms * 1000);
+        // BLYNK_SEND_THROTTLE is 0 by default: no system call for nothing
+        if (ms) {
+            usleep(ms * 1000);
+        }
     }
 
     millis_time_t BlynkMillis()
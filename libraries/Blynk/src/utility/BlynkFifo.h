@@ -11,8 +11,26 @@
 #ifndef BlynkFifo_h
 #define BlynkFifo_h
 
+#include <stdint.h>
+#include <string.h>
 #include <utility/BlynkUtility.h>
 
+// Single producer, single consumer; either side may be an interrupt
+// handler. Each index is written by one side only, and is stored after
+// the data it covers with BLYNK_FIFO_FENCE() in between.
+#if defined(ESP32) || defined(__linux__)
+    // more than one core: a real barrier, or the other core may see the
+    // index before the data
+    #define BLYNK_FIFO_FENCE() __sync_synchronize()
+#else
+    // one core, ISR or not: the compiler only has to keep the order
+    #define BLYNK_FIFO_FENCE() __asm__ __volatile__("" ::: "memory")
+#endif
+
+template <bool Small> struct BlynkFifoIndex       { typedef unsigned type; };
+template <>           struct BlynkFifoIndex<true> { typedef uint8_t  type; };
+
+
 template <class T, unsigned N>
 class BlynkFifo
 {
@@ -22,6 +40,7 @@ public:
         clear();
     }
 
+    // only while neither side is using the FIFO
     void clear()
     {
         _r = 0;
@@ -41,7 +60,7 @@ public:
 
     int free(void)
     {
-        int s = _r - _w;
+        int s = int(_r) - int(_w);
         if (s <= 0)
             s += N;
         return s - 1;
@@ -49,12 +68,12 @@ public:
 
     T put(const T& c)
     {
-        int i = _w;
-        int j = i;
-        i = _inc(i);
+        const Index w = _w;
+        const Index i = _inc(w);
         while (i == _r) // = !writeable()
             /* nothing / just wait */;
-        _b[j] = c;
+        _b[w] = c;
+        BLYNK_FIFO_FENCE();
         _w = i;
         return c;
     }
@@ -72,11 +91,12 @@ public:
             }
             // check free space
             if (c < f) f = c;
-            int w = _w;
+            const Index w = _w;
             int m = N - w;
             // check wrap
             if (f > m) f = m;
-            memcpy(&_b[w], p, f);
+            memcpy(&_b[w], p, f * sizeof(T));
+            BLYNK_FIFO_FENCE();
             _w = _inc(w, f);
             c -= f;
             p += f;
@@ -94,7 +114,7 @@ public:
 
     size_t size(void)
     {
-        int s = _w - _r;
+        int s = int(_w) - int(_r);
         if (s < 0)
             s += N;
         return s;
@@ -102,18 +122,21 @@ public:
 
     T get(void)
     {
-        int r = _r;
+        const Index r = _r;
         while (r == _w) // = !readable()
             /* nothing / just wait */;
+        BLYNK_FIFO_FENCE();
         T t = _b[r];
+        BLYNK_FIFO_FENCE(); // done with the slot before handing it back
         _r = _inc(r);
         return t;
     }
 
     T peek(void)
     {
-        int r = _r;
+        const Index r = _r;
         while (r == _w);
+        BLYNK_FIFO_FENCE();
         return _b[r];
     }
 
@@ -130,13 +153,15 @@ public:
                 if (!blocking) return n - c; // no space and not blocking
                 /* nothing / just wait */;
             }
+            BLYNK_FIFO_FENCE();
             // check available data
             if (c < f) f = c;
-            int r = _r;
+            const Index r = _r;
             int m = N - r;
             // check wrap
             if (f > m) f = m;
-            memcpy(p, &_b[r], f);
+            memcpy(p, &_b[r], f * sizeof(T));
+            BLYNK_FIFO_FENCE();
             _r = _inc(r, f);
             c -= f;
             p += f;
@@ -145,14 +170,20 @@ public:
     }
 
 private:
-    int _inc(int i, int n = 1)
+    // one byte when it can be: read and written in a single access even
+    // on 8-bit parts
+    typedef typename BlynkFifoIndex<(N <= 256)>::type Index;
+
+    // a mask for power-of-two sizes, a compare otherwise; never a division
+    static Index _inc(unsigned i, unsigned n = 1)
     {
-        return (i + n) % N;
+        return ((N & (N - 1)) == 0) ? Index((i + n) & (N - 1))
+                                    : Index((i + n >= N) ? i + n - N : i + n);
     }
 
-    T             _b[N];
-    volatile int  _w;
-    volatile int  _r;
+    T               _b[N];
+    volatile Index  _w;     // written by the producer only
+    volatile Index  _r;     // written by the consumer only
 };
 
 #endif
@@ -0,0 +1,168 @@
+/**
+ * @file       BlynkParse.h
+ * @license    This project is released under the MIT License (MIT)
+ * @brief      Number parsing for BlynkParam values
+ *
+ * atoi/atof go through strtol/strtod: locale, hex, correctly rounded
+ * conversion with big integers. On an ESP8266, with no FPU, atof of a
+ * slider value costs tens of microseconds. These read the plain decimals
+ * the server sends ("-12", "0.75", "1.5e3") straight from the
+ * null-separated buffer, with integer arithmetic and at most one
+ * floating-point scaling at the end. No heap, no locale.
+ *
+ * Like atoi/atof they skip leading spaces, stop at the first character
+ * that does not fit and return 0 for no number. Integers wrap instead of
+ * being undefined on overflow. A real keeps its first 9 (float) or 19
+ * (double) significant digits, and a float reads values below 1e-38 as 0;
+ * hex floats, "inf" and "nan" read as 0.
+ */
+
+#ifndef BlynkParse_h
+#define BlynkParse_h
+
+#include <stdint.h>
+#include <Blynk/BlynkConfig.h>
+
+static inline
+const char* BlynkParseSign(const char* s, bool* neg)
+{
+    while (*s == ' ' || (*s >= '\t' && *s <= '\r')) {
+        s++;
+    }
+    *neg = (*s == '-');
+    if (*s == '-' || *s == '+') {
+        s++;
+    }
+    return s;
+}
+
+static inline
+long BlynkParseLong(const char* s)
+{
+    bool neg;
+    s = BlynkParseSign(s, &neg);
+    unsigned long v = 0;
+    while (*s >= '0' && *s <= '9') {
+        v = v * 10 + (*s++ - '0');
+    }
+    return neg ? -long(v) : long(v);
+}
+
+/**
+ * The value times 10^decimals, rounded half away from zero: "12.345"
+ * with 2 decimals is 1235. No exponent.
+ */
+static inline
+long BlynkParseFixed(const char* s, uint8_t decimals)
+{
+    bool neg;
+    s = BlynkParseSign(s, &neg);
+    unsigned long v = 0;
+    while (*s >= '0' && *s <= '9') {
+        v = v * 10 + (*s++ - '0');
+    }
+    if (*s == '.') {
+        s++;
+    }
+    for (uint8_t i = 0; i < decimals; i++) {
+        v *= 10;
+        if (*s >= '0' && *s <= '9') {
+            v += *s++ - '0';
+        }
+    }
+    if (*s >= '5' && *s <= '9') {
+        v++;
+    }
+    return neg ? -long(v) : long(v);
+}
+
+#ifndef BLYNK_NO_FLOAT
+
+/**
+ * Digits into an integer mantissa M (up to D significant ones), a decimal
+ * exponent, and one scaling by a power of ten from the table P: 10^1,
+ * 10^2, 10^4, 10^8... Dividing for negative exponents keeps "0.1" exact
+ * to the last bit.
+ */
+template <typename T, typename M, int D, int N>
+T BlynkParseReal(const char* s, const T (&P)[N])
+{
+    bool neg;
+    s = BlynkParseSign(s, &neg);
+    M m = 0;
+    int digits = 0;
+    int scale = 0;
+    while (*s >= '0' && *s <= '9') {
+        if (digits < D) {
+            m = m * 10 + (*s - '0');
+            if (m) {
+                digits++;
+            }
+        } else {
+            scale++;    // dropped, but still counts
+        }
+        s++;
+    }
+    if (*s == '.') {
+        s++;
+        while (*s >= '0' && *s <= '9') {
+            if (digits < D) {
+                m = m * 10 + (*s - '0');
+                if (m) {
+                    digits++;
+                }
+                scale--;
+            }
+            s++;
+        }
+    }
+    if ((*s == 'e' || *s == 'E') && m) {
+        bool eneg;
+        const char* e = BlynkParseSign(s + 1, &eneg);
+        if (*e >= '0' && *e <= '9') {
+            int x = 0;
+            while (*e >= '0' && *e <= '9') {
+                if (x < 10000) {
+                    x = x * 10 + (*e - '0');
+                }
+                e++;
+            }
+            scale += eneg ? -x : x;
+        }
+    }
+
+    T v = T(m);
+    if (m && scale) {
+        unsigned n = scale < 0 ? -scale : scale;
+        T p = 1;
+        for (int i = 0; n && i < N; i++, n >>= 1) {
+            if (n & 1) {
+                p *= P[i];
+            }
+        }
+        if (n) {
+            v = scale < 0 ? T(0) : P[N-1] * P[N-1];     // out of range: 0 or inf
+        } else {
+            v = scale < 0 ? v / p : v * p;
+        }
+    }
+    return neg ? -v : v;
+}
+
+static inline
+float BlynkParseFloat(const char* s)
+{
+    static const float p[] = { 1e1f, 1e2f, 1e4f, 1e8f, 1e16f, 1e32f };
+    return BlynkParseReal<float, uint32_t, 9>(s, p);
+}
+
+static inline
+double BlynkParseDouble(const char* s)
+{
+    static const double p[] = { 1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256 };
+    return BlynkParseReal<double, uint64_t, 19>(s, p);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,171 @@
+/**
+ * @file       BlynkPool.h
+ * @license    This project is released under the MIT License (MIT)
+ * @brief      Fixed-block pool for small library buffers
+ *
+ * BlynkParamAllocated and the redirect host name used to come straight
+ * from malloc(). On a device that runs for weeks those short-lived small
+ * blocks fragment the heap; with BLYNK_USE_POOL they come from a few
+ * static size classes instead. A request goes to the smallest class that
+ * fits, then to the next one if it is full, and only then to the heap;
+ * every such spill is counted.
+ */
+
+#ifndef BlynkPool_h
+#define BlynkPool_h
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <Blynk/BlynkConfig.h>
+
+#if !defined(BLYNK_USE_POOL) && !defined(BLYNK_NO_POOL) && (defined(ESP8266) || defined(ESP32))
+#define BLYNK_USE_POOL
+#endif
+
+// Block size and count of each class (at most 32 blocks per class)
+#ifndef BLYNK_POOL_SMALL_SIZE
+#define BLYNK_POOL_SMALL_SIZE   32
+#endif
+#ifndef BLYNK_POOL_SMALL_COUNT
+#define BLYNK_POOL_SMALL_COUNT  8
+#endif
+#ifndef BLYNK_POOL_MEDIUM_SIZE
+#define BLYNK_POOL_MEDIUM_SIZE  64
+#endif
+#ifndef BLYNK_POOL_MEDIUM_COUNT
+#define BLYNK_POOL_MEDIUM_COUNT 4
+#endif
+#ifndef BLYNK_POOL_LARGE_SIZE
+#define BLYNK_POOL_LARGE_SIZE   256
+#endif
+#ifndef BLYNK_POOL_LARGE_COUNT
+#define BLYNK_POOL_LARGE_COUNT  2
+#endif
+
+#ifdef BLYNK_USE_POOL
+
+template <size_t Size, unsigned Count>
+class BlynkBlockPool
+{
+public:
+    static_assert(Count >= 1 && Count <= 32, "1 to 32 blocks per class");
+
+    BlynkBlockPool()
+        : mask(0), used(0), peak(0), exhausted(0)
+    {}
+
+    void* alloc() {
+        for (unsigned i = 0; i < Count; i++) {
+            if (!(mask & (1UL << i))) {
+                mask |= (1UL << i);
+                if (++used > peak) {
+                    peak = used;
+                }
+                return blocks[i];
+            }
+        }
+        exhausted++;
+        return NULL;
+    }
+
+    bool owns(const void* p) const {
+        return p >= (const void*)blocks[0] && p < (const void*)blocks[Count];
+    }
+
+    void release(void* p) {
+        const unsigned i = ((uint8_t*)p - (uint8_t*)blocks[0]) / sizeof(blocks[0]);
+        if (mask & (1UL << i)) {
+            mask &= ~(1UL << i);
+            used--;
+        }
+    }
+
+    static size_t blockSize() { return Size; }
+
+    uint32_t mask;
+    uint8_t  used;       // blocks taken now
+    uint8_t  peak;       // most blocks ever taken at once
+    uint32_t exhausted;  // requests that found the class full
+
+private:
+    // word-aligned blocks
+    uint32_t blocks[Count][(Size + 3) / 4];
+};
+
+class BlynkPool
+{
+public:
+    BlynkPool() : heap(0), heapInUse(0) {}
+
+    void* alloc(size_t size) {
+        void* p = NULL;
+        if (size <= small.blockSize()) {
+            p = small.alloc();
+        }
+        if (!p && size <= medium.blockSize()) {
+            p = medium.alloc();
+        }
+        if (!p && size <= large.blockSize()) {
+            p = large.alloc();
+        }
+        if (!p) {
+            p = malloc(size);
+            if (p) {
+                heap++;
+                heapInUse++;
+            }
+        }
+        return p;
+    }
+
+    void release(void* p) {
+        if (!p) {
+            return;
+        }
+        if (small.owns(p)) {
+            small.release(p);
+        } else if (medium.owns(p)) {
+            medium.release(p);
+        } else if (large.owns(p)) {
+            large.release(p);
+        } else {
+            free(p);
+            heapInUse--;
+        }
+    }
+
+    BlynkBlockPool<BLYNK_POOL_SMALL_SIZE,  BLYNK_POOL_SMALL_COUNT>  small;
+    BlynkBlockPool<BLYNK_POOL_MEDIUM_SIZE, BLYNK_POOL_MEDIUM_COUNT> medium;
+    BlynkBlockPool<BLYNK_POOL_LARGE_SIZE,  BLYNK_POOL_LARGE_COUNT>  large;
+    uint32_t heap;       // requests that ended up on the heap
+    uint32_t heapInUse;
+};
+
+// One pool per program: a function-local static in an inline function is
+// shared by every translation unit that includes this header
+inline BlynkPool& BlynkPoolInstance() {
+    static BlynkPool pool;
+    return pool;
+}
+
+inline void* BlynkPoolAlloc(size_t size) {
+    return BlynkPoolInstance().alloc(size);
+}
+
+inline void BlynkPoolFree(void* p) {
+    BlynkPoolInstance().release(p);
+}
+
+#else
+
+inline void* BlynkPoolAlloc(size_t size) {
+    return malloc(size);
+}
+
+inline void BlynkPoolFree(void* p) {
+    free(p);
+}
+
+#endif
+
+#endif
@@ -8,6 +8,8 @@
  * Callback function parameters added & compiler warnings
  * removed by Bill Knight <billk@rosw.com> 20March2017
  *
+ * Timers kept in a list ordered by expiry, caller-owned timers
+ *
  * This library is free software; you can redistribute it
  * and/or modify it under the terms of the GNU Lesser
  * General Public License as published by the Free Software
@@ -34,17 +36,62 @@
 //static inline unsigned long elapsed() { return micros(); }
 static inline unsigned long elapsed() { return BlynkMillis(); }
 
+// callback kinds
+enum {
+    TIMER_NONE = 0,
+    TIMER_PLAIN,        // timer_callback
+    TIMER_PARAM,        // timer_callback_p
+    TIMER_ENTRY         // timer_callback_e
+};
+
+// a zero delay fires on every millisecond, not forever within one run()
+static inline unsigned long period(unsigned long delay) {
+    return delay ? delay : 1;
+}
+
+
+BlynkTimerEntry::BlynkTimerEntry()
+    : next(NULL), owner(NULL), prev_millis(0), delay(0)
+    , callback(NULL), param(NULL), maxNumRuns(0), numRuns(0)
+    , kind(TIMER_NONE), enabled(false)
+{
+}
+
+BlynkTimerEntry::~BlynkTimerEntry()
+{
+    if (owner) {
+        owner->deleteTimer(*this);
+    }
+}
+
 
 SimpleTimer::SimpleTimer()
-    : numTimers (-1)
+    : head(NULL), numTimers (-1)
+{
+}
+
+SimpleTimer::~SimpleTimer()
 {
+    while (head) {
+        BlynkTimerEntry* e = head;
+        head = e->next;
+        e->next = NULL;
+        e->owner = NULL;
+    }
 }
 
 void SimpleTimer::init() {
     unsigned long current_millis = elapsed();
 
     for (int i = 0; i < MAX_TIMERS; i++) {
-        memset(&timer[i], 0, sizeof (timer_t));
+        unlink(timer[i]);
+        timer[i].callback = NULL;
+        timer[i].param = NULL;
+        timer[i].kind = TIMER_NONE;
+        timer[i].delay = 0;
+        timer[i].maxNumRuns = 0;
+        timer[i].numRuns = 0;
+        timer[i].enabled = false;
         timer[i].prev_millis = current_millis;
     }
 
@@ -52,63 +99,99 @@ void SimpleTimer::init() {
 }
 
 
-void SimpleTimer::run() {
-    int i;
-    unsigned long current_millis;
-
-    // get current time
-    current_millis = elapsed();
+void SimpleTimer::link(BlynkTimerEntry& e) {
+    const unsigned long due = e.prev_millis + period(e.delay);
 
-    for (i = 0; i < MAX_TIMERS; i++) {
-
-        timer[i].toBeCalled = DEFCALL_DONTRUN;
-
-        // no callback == no timer, i.e. jump over empty slots
-        if (timer[i].callback != NULL) {
+    // after every timer due no later, so equal ones keep their order
+    BlynkTimerEntry** pos = &head;
+    while (*pos && long(due - ((*pos)->prev_millis + period((*pos)->delay))) >= 0) {
+        pos = &(*pos)->next;
+    }
+    e.next = *pos;
+    *pos = &e;
+    e.owner = this;
+}
 
-            // is it time to process this timer ?
-            // see http://arduino.cc/forum/index.php/topic,124048.msg932592.html#msg932592
+void SimpleTimer::unlink(BlynkTimerEntry& e) {
+    for (BlynkTimerEntry** pos = &head; *pos; pos = &(*pos)->next) {
+        if (*pos == &e) {
+            *pos = e.next;
+            break;
+        }
+    }
+    e.next = NULL;
+    e.owner = NULL;
+}
 
-            if ((current_millis - timer[i].prev_millis) >= timer[i].delay) {
 
-                unsigned long skipTimes = (current_millis - timer[i].prev_millis) / timer[i].delay;
-                // update time
-                timer[i].prev_millis += timer[i].delay * skipTimes;
+void SimpleTimer::run() {
+    // get current time
+    const unsigned long current_millis = elapsed();
+
+    // only the front of the list can be due
+    while (head && long(current_millis - (head->prev_millis + period(head->delay))) >= 0) {
+        BlynkTimerEntry& e = *head;
+        head = e.next;
+        e.next = NULL;
+        e.owner = NULL;
+
+        // see http://arduino.cc/forum/index.php/topic,124048.msg932592.html#msg932592
+        const unsigned long d = period(e.delay);
+        unsigned long skipTimes = (current_millis - e.prev_millis) / d;
+        // update time
+        e.prev_millis += d * skipTimes;
+
+        bool call = false;
+        bool last = false;
+
+        // check if the timer callback has to be executed
+        if (e.enabled) {
+
+            // "run forever" timers must always be executed
+            if (e.maxNumRuns == RUN_FOREVER) {
+                call = true;
+            }
+            // other timers get executed the specified number of times
+            else if (e.numRuns < e.maxNumRuns) {
+                call = true;
+                e.numRuns++;
 
-                // check if the timer callback has to be executed
-                if (timer[i].enabled) {
+                // after the last run, delete the timer
+                last = (e.numRuns >= e.maxNumRuns);
+            }
+        }
 
-                    // "run forever" timers must always be executed
-                    if (timer[i].maxNumRuns == RUN_FOREVER) {
-                        timer[i].toBeCalled = DEFCALL_RUNONLY;
-                    }
-                    // other timers get executed the specified number of times
-                    else if (timer[i].numRuns < timer[i].maxNumRuns) {
-                        timer[i].toBeCalled = DEFCALL_RUNONLY;
-                        timer[i].numRuns++;
+        // back in line for the next period before the callback runs, so
+        // the callback may delete or change it like any other timer
+        if (!last) {
+            link(e);
+        }
 
-                        // after the last run, delete the timer
-                        if (timer[i].numRuns >= timer[i].maxNumRuns) {
-                            timer[i].toBeCalled = DEFCALL_RUNANDDEL;
-                        }
-                    }
-                }
+        if (call) {
+            switch (e.kind) {
+            case TIMER_PLAIN: (*(timer_callback)e.callback)();           break;
+            case TIMER_PARAM: (*(timer_callback_p)e.callback)(e.param);  break;
+            case TIMER_ENTRY: (*(timer_callback_e)e.callback)(e);        break;
+            default:                                                     break;
             }
         }
-    }
 
-    for (i = 0; i < MAX_TIMERS; i++) {
-        if (timer[i].toBeCalled == DEFCALL_DONTRUN)
-            continue;
+        // a finished numbered timer frees its slot, unless the callback
+        // already did; a finished caller-owned one is simply not linked
+        // (its callback may have registered it again)
+        if (last && &e >= &timer[0] && &e < &timer[MAX_TIMERS] && !e.owner) {
+            deleteTimer(unsigned(&e - &timer[0]));
+        }
+    }
+}
 
-        if (timer[i].hasParam)
-            (*(timer_callback_p)timer[i].callback)(timer[i].param);
-        else
-            (*(timer_callback)timer[i].callback)();
 
-        if (timer[i].toBeCalled == DEFCALL_RUNANDDEL)
-            deleteTimer(i);
+long SimpleTimer::msUntilNext() {
+    if (!head) {
+        return -1;
     }
+    const long left = long(head->prev_millis + period(head->delay) - elapsed());
+    return left > 0 ? left : 0;
 }
 
 
@@ -132,7 +215,20 @@ int SimpleTimer::findFirstFreeSlot() {
 }
 
 
-int SimpleTimer::setupTimer(unsigned long d, void* f, void* p, bool h, unsigned n) {
+void SimpleTimer::arm(BlynkTimerEntry& e, unsigned long d, void* f, void* p, uint8_t k, unsigned n) {
+    unlink(e);
+    e.delay = d;
+    e.callback = f;
+    e.param = p;
+    e.kind = k;
+    e.maxNumRuns = n;
+    e.numRuns = 0;
+    e.enabled = true;
+    e.prev_millis = elapsed();
+    link(e);
+}
+
+int SimpleTimer::setupTimer(unsigned long d, void* f, void* p, uint8_t k, unsigned n) {
     int freeTimer;
 
     if (numTimers < 0) {
@@ -148,13 +244,7 @@ int SimpleTimer::setupTimer(unsigned long d, void* f, void* p, bool h, unsigned
         return -1;
     }
 
-    timer[freeTimer].delay = d;
-    timer[freeTimer].callback = f;
-    timer[freeTimer].param = p;
-    timer[freeTimer].hasParam = h;
-    timer[freeTimer].maxNumRuns = n;
-    timer[freeTimer].enabled = true;
-    timer[freeTimer].prev_millis = elapsed();
+    arm(timer[freeTimer], d, f, p, k, n);
 
     numTimers++;
 
@@ -163,27 +253,58 @@ int SimpleTimer::setupTimer(unsigned long d, void* f, void* p, bool h, unsigned
 
 
 int SimpleTimer::setTimer(unsigned long d, timer_callback f, unsigned n) {
-  return setupTimer(d, (void *)f, NULL, false, n);
+  return setupTimer(d, (void *)f, NULL, TIMER_PLAIN, n);
 }
 
 int SimpleTimer::setTimer(unsigned long d, timer_callback_p f, void* p, unsigned n) {
-  return setupTimer(d, (void *)f, p, true, n);
+  return setupTimer(d, (void *)f, p, TIMER_PARAM, n);
 }
 
 int SimpleTimer::setInterval(unsigned long d, timer_callback f) {
-    return setupTimer(d, (void *)f, NULL, false, RUN_FOREVER);
+    return setupTimer(d, (void *)f, NULL, TIMER_PLAIN, RUN_FOREVER);
 }
 
 int SimpleTimer::setInterval(unsigned long d, timer_callback_p f, void* p) {
-  return setupTimer(d, (void *)f, p, true, RUN_FOREVER);
+  return setupTimer(d, (void *)f, p, TIMER_PARAM, RUN_FOREVER);
 }
 
 int SimpleTimer::setTimeout(unsigned long d, timer_callback f) {
-    return setupTimer(d, (void *)f, NULL, false, RUN_ONCE);
+    return setupTimer(d, (void *)f, NULL, TIMER_PLAIN, RUN_ONCE);
 }
 
 int SimpleTimer::setTimeout(unsigned long d, timer_callback_p f, void* p) {
-  return setupTimer(d, (void *)f, p, true, RUN_ONCE);
+  return setupTimer(d, (void *)f, p, TIMER_PARAM, RUN_ONCE);
+}
+
+
+bool SimpleTimer::setTimer(BlynkTimerEntry& e, unsigned long d, timer_callback_e f, unsigned n) {
+    if (f == NULL) {
+        return false;
+    }
+    arm(e, d, (void *)f, NULL, TIMER_ENTRY, n);
+    return true;
+}
+
+bool SimpleTimer::setInterval(BlynkTimerEntry& e, unsigned long d, timer_callback_e f) {
+    return setTimer(e, d, f, RUN_FOREVER);
+}
+
+bool SimpleTimer::setTimeout(BlynkTimerEntry& e, unsigned long d, timer_callback_e f) {
+    return setTimer(e, d, f, RUN_ONCE);
+}
+
+void SimpleTimer::deleteTimer(BlynkTimerEntry& e) {
+    if (e.owner == this) {
+        unlink(e);
+    }
+}
+
+void SimpleTimer::restartTimer(BlynkTimerEntry& e) {
+    e.prev_millis = elapsed();
+    if (e.owner == this) {
+        unlink(e);
+        link(e);
+    }
 }
 
 bool SimpleTimer::changeInterval(unsigned numTimer, unsigned long d) {
@@ -194,7 +315,7 @@ bool SimpleTimer::changeInterval(unsigned numTimer, unsigned long d) {
     // Updates interval of existing specified timer
     if (timer[numTimer].callback != NULL) {
         timer[numTimer].delay = d;
-        timer[numTimer].prev_millis = elapsed();
+        restartTimer(numTimer);
         return true;
     }
     // false return for non-used numTimer, no callback
@@ -214,8 +335,16 @@ void SimpleTimer::deleteTimer(unsigned timerId) {
     // don't decrease the number of timers if the
     // specified slot is already empty
     if (timer[timerId].callback != NULL) {
-        memset(&timer[timerId], 0, sizeof (timer_t));
-        timer[timerId].prev_millis = elapsed();
+        BlynkTimerEntry& e = timer[timerId];
+        unlink(e);
+        e.callback = NULL;
+        e.param = NULL;
+        e.kind = TIMER_NONE;
+        e.delay = 0;
+        e.maxNumRuns = 0;
+        e.numRuns = 0;
+        e.enabled = false;
+        e.prev_millis = elapsed();
 
         // update number of timers
         numTimers--;
@@ -229,7 +358,12 @@ void SimpleTimer::restartTimer(unsigned numTimer) {
         return;
     }
 
-    timer[numTimer].prev_millis = elapsed();
+    BlynkTimerEntry& e = timer[numTimer];
+    e.prev_millis = elapsed();
+    if (e.owner == this) {
+        unlink(e);
+        link(e);
+    }
 }
 
 
@@ -0,0 +1,299 @@
+/**
+ * @file       BlynkBenchmark.cpp
+ * @license    This project is released under the MIT License (MIT)
+ * @brief      Host benchmark of BlynkProtocol over an in-memory loopback
+ *
+ * No sockets and no server: the transport below hands the protocol bytes
+ * from a memory buffer and swallows what it writes, answering login and
+ * ping itself. What is measured is the library alone:
+ *
+ *   flood  - virtualWrite() of a pin with an int and a float, one call
+ *            timed at a time
+ *   array  - the same for virtualWriteArray() of 16 int16_t samples
+ *   burst  - hardware "vw" frames handed to run() a burst at a time; the
+ *            latency of a frame is from its burst arriving to its
+ *            BLYNK_WRITE handler running
+ *
+ * Heap high-water counts what the library itself takes from malloc().
+ *
+ * Usage: BlynkBenchmark [messages] [frames per burst]
+ */
+
+#define BLYNK_NO_DEFAULT_BANNER
+#define BLYNK_NO_INFO
+// the server's rate limit is a policy, not a cost of the stack
+#define BLYNK_MSG_LIMIT 0
+
+#include <arpa/inet.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+#include <BlynkApiLinux.h>
+#include <Blynk/BlynkProtocol.h>
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+// Heap accounting: the link wraps malloc and friends for the objects built
+// here, so allocations made inside the C++ runtime (vectors of the
+// benchmark itself) are not counted
+
+static size_t heap_now = 0, heap_peak = 0;
+
+extern "C" {
+void* __real_malloc(size_t);
+void  __real_free(void*);
+void* __real_realloc(void*, size_t);
+
+// size kept in front of the block, 16 bytes to keep it aligned
+void* __wrap_malloc(size_t size)
+{
+    size_t* p = (size_t*)__real_malloc(size + 16);
+    if (!p) {
+        return NULL;
+    }
+    *p = size;
+    heap_now += size;
+    heap_peak = std::max(heap_peak, heap_now);
+    return (uint8_t*)p + 16;
+}
+
+void __wrap_free(void* ptr)
+{
+    if (!ptr) {
+        return;
+    }
+    size_t* p = (size_t*)((uint8_t*)ptr - 16);
+    heap_now -= *p;
+    __real_free(p);
+}
+
+void* __wrap_calloc(size_t n, size_t size)
+{
+    void* p = __wrap_malloc(n * size);
+    if (p) {
+        memset(p, 0, n * size);
+    }
+    return p;
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    if (!ptr) {
+        return __wrap_malloc(size);
+    }
+    size_t* p = (size_t*)((uint8_t*)ptr - 16);
+    const size_t old = *p;
+    p = (size_t*)__real_realloc(p, size + 16);
+    if (!p) {
+        return NULL;
+    }
+    *p = size;
+    heap_now = heap_now - old + size;
+    heap_peak = std::max(heap_peak, heap_now);
+    return (uint8_t*)p + 16;
+}
+}
+
+class BlynkTransportLoopback
+{
+public:
+    BlynkTransportLoopback()
+        : rx(), rxPos(0), txBytes(0), txFrames(0), up(false)
+    {}
+
+    void begin(const char*, uint16_t) {}
+
+    bool connect() {
+        up = true;
+        rx.clear();
+        rxPos = 0;
+        return true;
+    }
+    void disconnect() { up = false; }
+    bool connected()  { return up; }
+
+    int available() {
+        return rx.size() - rxPos;
+    }
+
+    size_t read(void* buf, size_t len) {
+        len = std::min(len, rx.size() - rxPos);
+        memcpy(buf, &rx[rxPos], len);
+        rxPos += len;
+        if (rxPos == rx.size()) {
+            rx.clear();
+            rxPos = 0;
+        }
+        return len;
+    }
+
+    size_t write(const BlynkIoVec* iov, size_t count) {
+        size_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            total += iov[i].length;
+        }
+        // the header always comes whole in the first part
+        const BlynkHeader* hdr = (const BlynkHeader*)iov[0].base;
+        if (hdr->type == BLYNK_CMD_HW_LOGIN || hdr->type == BLYNK_CMD_PING) {
+            respond(ntohs(hdr->msg_id));
+        }
+        txBytes += total;
+        txFrames++;
+        return total;
+    }
+
+    size_t write(const void* buf, size_t len) {
+        const BlynkIoVec iov = { buf, len };
+        return write(&iov, 1);
+    }
+
+    void feed(const uint8_t* data, size_t len) {
+        rx.insert(rx.end(), data, data + len);
+    }
+
+    std::vector<uint8_t> rx;
+    size_t   rxPos;
+    uint64_t txBytes;
+    uint64_t txFrames;
+
+private:
+    void respond(uint16_t id) {
+        BlynkHeader rsp;
+        rsp.type = BLYNK_CMD_RESPONSE;
+        rsp.msg_id = htons(id);
+        rsp.length = htons(BLYNK_SUCCESS);
+        feed((const uint8_t*)&rsp, sizeof(rsp));
+    }
+
+    bool up;
+};
+
+class BlynkLoopback
+    : public BlynkProtocol<BlynkTransportLoopback>
+{
+    typedef BlynkProtocol<BlynkTransportLoopback> Base;
+public:
+    BlynkLoopback(BlynkTransportLoopback& transp)
+        : Base(transp)
+    {}
+
+    void begin(const char* auth) {
+        Base::begin(auth);
+    }
+};
+
+static BlynkTransportLoopback _blynkTransport;
+static BlynkLoopback Blynk(_blynkTransport);
+
+static uint64_t burst_start = 0;
+static std::vector<uint32_t> burst_latency;
+
+BLYNK_WRITE(V1)
+{
+    burst_latency.push_back(uint32_t(now_ns() - burst_start));
+}
+
+static void report(const char* name, size_t msgs, uint64_t bytes, uint64_t elapsed,
+                   std::vector<uint32_t>& lat)
+{
+    std::sort(lat.begin(), lat.end());
+    const double s = elapsed / 1e9;
+    printf("%-6s %9zu msgs  %11.0f msgs/s  %12.0f bytes/s  p50 %6u ns  p99 %6u ns  heap %zu B\n",
+           name, msgs, msgs / s, bytes / s,
+           lat.empty() ? 0 : lat[lat.size() / 2],
+           lat.empty() ? 0 : lat[lat.size() * 99 / 100],
+           heap_peak);
+}
+
+static void flood(size_t count)
+{
+    std::vector<uint32_t> lat;
+    lat.reserve(count);
+
+    heap_peak = heap_now;
+    const uint64_t bytes0 = _blynkTransport.txBytes;
+    const uint64_t t0 = now_ns();
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t a = now_ns();
+        Blynk.virtualWrite(V0, int(i), i * 0.25f);
+        lat.push_back(uint32_t(now_ns() - a));
+    }
+    report("flood", count, _blynkTransport.txBytes - bytes0, now_ns() - t0, lat);
+}
+
+static void array(size_t count)
+{
+    std::vector<uint32_t> lat;
+    lat.reserve(count);
+
+    int16_t samples[16];
+    for (size_t i = 0; i < 16; i++) {
+        samples[i] = int16_t(i * 1000 - 8000);
+    }
+
+    heap_peak = heap_now;
+    const uint64_t bytes0 = _blynkTransport.txBytes;
+    const uint64_t t0 = now_ns();
+    for (size_t i = 0; i < count; i++) {
+        const uint64_t a = now_ns();
+        Blynk.virtualWriteArray(V0, samples, 16);
+        lat.push_back(uint32_t(now_ns() - a));
+    }
+    report("array", count, _blynkTransport.txBytes - bytes0, now_ns() - t0, lat);
+}
+
+static void burst(size_t count, size_t per_burst)
+{
+    // one pre-built burst of "vw 1 <value>" frames, fed again and again
+    std::vector<uint8_t> frames;
+    for (size_t i = 0; i < per_burst; i++) {
+        char body[32];
+        const int len = snprintf(body, sizeof(body), "vw%c1%c%u", 0, 0, unsigned(i * 7));
+        BlynkHeader hdr;
+        hdr.type = BLYNK_CMD_HARDWARE;
+        hdr.msg_id = htons(uint16_t(i + 1));
+        hdr.length = htons(uint16_t(len));
+        frames.insert(frames.end(), (uint8_t*)&hdr, (uint8_t*)&hdr + sizeof(hdr));
+        frames.insert(frames.end(), body, body + len);
+    }
+
+    burst_latency.clear();
+    burst_latency.reserve(count + per_burst);
+
+    heap_peak = heap_now;
+    uint64_t bytes = 0, elapsed = 0;
+    while (burst_latency.size() < count) {
+        _blynkTransport.feed(&frames[0], frames.size());
+        bytes += frames.size();
+        burst_start = now_ns();
+        Blynk.run();
+        elapsed += now_ns() - burst_start;
+    }
+    report("burst", burst_latency.size(), bytes, elapsed, burst_latency);
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t count = (argc > 1) ? strtoul(argv[1], NULL, 10) : 200000;
+    const size_t per_burst = (argc > 2) ? strtoul(argv[2], NULL, 10) : 32;
+
+    Blynk.begin("12345678901234567890123456789012");
+    if (!Blynk.connect()) {
+        printf("Loopback login failed\n");
+        return 1;
+    }
+
+    flood(count);
+    array(count);
+    burst(count, per_burst ? per_burst : 1);
+    return 0;
+}
@@ -26,6 +26,10 @@ ESP8266::ESP8266(Stream *uart)
 {
     m_onData = NULL;
     m_onDataPtr = NULL;
+    m_rxHead = 0;
+    m_rxTail = 0;
+    m_sendPending = false;
+    m_sendFailed = false;
 }
 
 bool ESP8266::kick(void)
@@ -388,7 +392,97 @@ bool ESP8266::send(uint8_t mux_id, const uint8_t *buffer, uint32_t len)
 
 void ESP8266::run()
 {
-    rx_empty();
+    rx_poll();
+}
+
+int ESP8266::available(void)
+{
+    return rx_count() + m_puart->available();
+}
+
+int ESP8266::read(void)
+{
+    if (m_rxHead != m_rxTail) {
+        uint8_t b = m_rx[m_rxTail];
+        m_rxTail = (m_rxTail + 1) % ESP8266_RX_BUFFER;
+        return b;
+    }
+    return m_puart->read();
+}
+
+bool ESP8266::sendWait(uint32_t timeout)
+{
+    unsigned long start = millis();
+    while (m_sendPending && millis() - start < timeout) {
+        rx_poll();
+    }
+    if (m_sendPending) {
+        m_sendPending = false;
+        m_sendFailed = true;
+    }
+    bool ok = !m_sendFailed;
+    m_sendFailed = false;
+    return ok;
+}
+
+/*----------------------------------------------------------------------------*/
+/* RX ring: bytes taken from the UART while the CPU is busy writing, so the
+ * UART's own buffer (64 bytes on AVR) does not overflow during a send. */
+
+uint16_t ESP8266::rx_count(void)
+{
+    return (m_rxHead + ESP8266_RX_BUFFER - m_rxTail) % ESP8266_RX_BUFFER;
+}
+
+void ESP8266::rx_pump(void)
+{
+    while (m_puart->available() > 0) {
+        uint16_t next = (m_rxHead + 1) % ESP8266_RX_BUFFER;
+        if (next == m_rxTail) {
+            return; /* full: leave the rest in the UART */
+        }
+        m_rx[m_rxHead] = m_puart->read();
+        m_rxHead = next;
+    }
+}
+
+void ESP8266::rx_write(const uint8_t *buffer, uint32_t len, bool flash)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        rx_pump();
+        m_puart->write(flash ? (uint8_t)pgm_read_byte(&buffer[i]) : buffer[i]);
+    }
+}
+
+/* Handles whatever has arrived without waiting for the line to go quiet:
+ * +IPD payloads and the outcome of a send still in flight. A partial line
+ * stays in m_rxLine for the next call. */
+void ESP8266::rx_poll(void)
+{
+    char a;
+    while (available() > 0) {
+        a = read();
+        if(a == '\0') continue;
+        m_rxLine += a;
+        if (m_sendPending) {
+            if (m_rxLine.indexOf("SEND OK") != -1) {
+                m_sendPending = false;
+                m_rxLine = "";
+                continue;
+            }
+            if (m_rxLine.indexOf("SEND FAIL") != -1 || m_rxLine.indexOf("ERROR") != -1) {
+                m_sendPending = false;
+                m_sendFailed = true;
+                m_rxLine = "";
+                continue;
+            }
+        }
+        if (checkIPD(m_rxLine)) {
+            m_rxLine = "";
+        } else if (a == '\n') {
+            m_rxLine = ""; /* a complete line that is none of the above */
+        }
+    }
 }
 
 /*----------------------------------------------------------------------------*/
@@ -441,10 +535,12 @@ void ESP8266::rx_empty(void)
 {
     String data;
     char a;
+    sendWait(); /* a command may only follow the end of the previous send */
+    m_rxLine = "";
     unsigned long start = millis();
     while (millis() - start < 10) {
-        if (m_puart->available()) {
-            a = m_puart->read();
+        if (available()) {
+            a = read();
             if(a == '\0') continue;
             data += a;
             if (checkIPD(data)) {
@@ -461,8 +557,8 @@ String ESP8266::recvString(String target, uint32_t timeout)
     char a;
     unsigned long start = millis();
     while (millis() - start < timeout) {
-        while(m_puart->available() > 0) {
-            a = m_puart->read();
+        while(available() > 0) {
+            a = read();
             if(a == '\0') continue;
             data += a;
             if (data.indexOf(target) != -1) {
@@ -482,8 +578,8 @@ String ESP8266::recvString(String target1, String target2, uint32_t timeout)
     char a;
     unsigned long start = millis();
     while (millis() - start < timeout) {
-        while(m_puart->available() > 0) {
-            a = m_puart->read();
+        while(available() > 0) {
+            a = read();
             if(a == '\0') continue;
             data += a;
             if (data.indexOf(target1) != -1) {
@@ -504,8 +600,8 @@ String ESP8266::recvString(String target1, String target2, String target3, uint3
     char a;
     unsigned long start = millis();
     while (millis() - start < timeout) {
-        while(m_puart->available() > 0) {
-            a = m_puart->read();
+        while(available() > 0) {
+            a = read();
             if(a == '\0') continue;
             data += a;
             
@@ -1132,65 +1228,44 @@ bool ESP8266::sATCIPSTARTMultiple(uint8_t mux_id, String type, String addr, uint
     }
     return false;
 }
-bool ESP8266::sATCIPSENDSingle(const uint8_t *buffer, uint32_t len)
+/* The send returns once the payload is written: "SEND OK" is collected by
+ * the next send, the next command or run(), so the ESP8266 transmits while
+ * the caller prepares more data. A failure is reported by the next send. */
+bool ESP8266::sATCIPSEND(int16_t mux_id, const uint8_t *buffer, uint32_t len, bool flash)
 {
-    rx_empty();
+    if (!sendWait()) {
+        return false;
+    }
+    rx_poll();
     m_puart->print(F("AT+CIPSEND="));
+    if (mux_id >= 0) {
+        m_puart->print(mux_id);
+        m_puart->print(F(","));
+    }
     m_puart->println(len);
     if (recvFind(">", 5000)) {
-        rx_empty();
-        for (uint32_t i = 0; i < len; i++) {
-            m_puart->write(buffer[i]);
-        }
-        return recvFind("SEND OK", 10000);
+        rx_poll(); /* the space after the prompt */
+        rx_write(buffer, len, flash);
+        m_sendPending = true;
+        return true;
     }
     return false;
 }
+bool ESP8266::sATCIPSENDSingle(const uint8_t *buffer, uint32_t len)
+{
+    return sATCIPSEND(-1, buffer, len, false);
+}
 bool ESP8266::sATCIPSENDMultiple(uint8_t mux_id, const uint8_t *buffer, uint32_t len)
 {
-    rx_empty();
-    m_puart->print(F("AT+CIPSEND="));
-    m_puart->print(mux_id);
-    m_puart->print(F(","));
-    m_puart->println(len);
-    if (recvFind(">", 5000)) {
-        rx_empty();
-        for (uint32_t i = 0; i < len; i++) {
-            m_puart->write(buffer[i]);
-        }
-        return recvFind("SEND OK", 10000);
-    }
-    return false;
+    return sATCIPSEND(mux_id, buffer, len, false);
 }
 bool ESP8266::sATCIPSENDSingleFromFlash(const uint8_t *buffer, uint32_t len)
 {
-    rx_empty();
-    m_puart->print(F("AT+CIPSEND="));
-    m_puart->println(len);
-    if (recvFind(">", 5000)) {
-        rx_empty();
-        for (uint32_t i = 0; i < len; i++) {
-            m_puart->write((char) pgm_read_byte(&buffer[i]));
-        }
-        return recvFind("SEND OK", 10000);
-    }
-    return false;
+    return sATCIPSEND(-1, buffer, len, true);
 }
 bool ESP8266::sATCIPSENDMultipleFromFlash(uint8_t mux_id, const uint8_t *buffer, uint32_t len)
 {
-    rx_empty();
-    m_puart->print(F("AT+CIPSEND="));
-    m_puart->print(mux_id);
-    m_puart->print(F(","));
-    m_puart->println(len);
-    if (recvFind(">", 5000)) {
-        rx_empty();
-        for (uint32_t i = 0; i < len; i++) {
-            m_puart->write((char) pgm_read_byte(&buffer[i]));
-        }
-        return recvFind("SEND OK", 10000);
-    }
-    return false;
+    return sATCIPSEND(mux_id, buffer, len, true);
 }
 bool ESP8266::sATCIPCLOSEMulitple(uint8_t mux_id)
 {
@@ -33,6 +33,14 @@
 
 #define  USER_SEL_VERSION         VERSION_22
 
+/**
+ * Bytes of ESP8266 output kept by the library while a send is being written,
+ * on top of the UART's own buffer.
+ */
+#ifndef ESP8266_RX_BUFFER
+#define ESP8266_RX_BUFFER         128
+#endif
+
 /**
  * Provide an easy-to-use way to manipulate ESP8266. 
  */
@@ -58,7 +66,25 @@ class ESP8266 {
         m_onDataPtr = ptr;
     }
     
+    /*
+     * Handle data that has arrived (+IPD payloads, the end of a send) without waiting.
+     */
     void run();
+
+    /*
+     * Bytes from the ESP8266 not yet consumed: the RX ring first, then the UART.
+     * The onData callback must read the payload through these, not getUart().
+     */
+    int available(void);
+    int read(void);
+
+    /*
+     * Wait for the send still in flight, if any.
+     *
+     * @retval true - it was accepted (or there was none).
+     * @retval false - it failed, or a failure was not yet reported.
+     */
+    bool sendWait(uint32_t timeout = 10000);
     
     /** 
      * Verify ESP8266 whether live or not. 
@@ -578,6 +604,11 @@ class ESP8266 {
      * Empty the buffer or UART RX.
      */
     void rx_empty(void);
+
+    uint16_t rx_count(void);
+    void rx_pump(void);
+    void rx_poll(void);
+    void rx_write(const uint8_t *buffer, uint32_t len, bool flash);
  
     /* 
      * Recvive data from uart. Return all received data if target found or timeout. 
@@ -651,6 +682,7 @@ class ESP8266 {
     bool eATCIPSTATUS(String &list);
     bool sATCIPSTARTSingle(String type, String addr, uint32_t port);
     bool sATCIPSTARTMultiple(uint8_t mux_id, String type, String addr, uint32_t port);
+    bool sATCIPSEND(int16_t mux_id, const uint8_t *buffer, uint32_t len, bool flash);
     bool sATCIPSENDSingle(const uint8_t *buffer, uint32_t len);
     bool sATCIPSENDMultiple(uint8_t mux_id, const uint8_t *buffer, uint32_t len);
     bool sATCIPSENDSingleFromFlash(const uint8_t *buffer, uint32_t len);
@@ -673,6 +705,13 @@ class ESP8266 {
     Stream *m_puart; /* The UART to communicate with ESP8266 */
     onData m_onData;
     void*  m_onDataPtr;
+
+    uint8_t  m_rx[ESP8266_RX_BUFFER];
+    uint16_t m_rxHead;
+    uint16_t m_rxTail;
+    bool     m_sendPending; /* payload written, "SEND OK" not seen yet */
+    bool     m_sendFailed;  /* a pipelined send failed, reported by the next one */
+    String   m_rxLine;      /* partial line seen by rx_poll() */
 };
 
 #endif /* #ifndef __ESP8266_H__ */
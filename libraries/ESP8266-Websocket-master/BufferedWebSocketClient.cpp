@@ -0,0 +1,171 @@
+//#define DEBUGGING
+
+#include "BufferedWebSocketClient.h"
+
+// Each frame in the ring: 2-byte length (little-endian), then the frame
+// as it goes on the wire
+#define FRAME_PREFIX 2
+
+static char no_protocol[] = "";
+
+BufferedWebSocketClient::BufferedWebSocketClient(Client &client, uint8_t *ring, size_t ringSize)
+    : client(client), port(0), ring(ring), ring_size(ringSize),
+      head(0), tail(0), used(0), queued_frames(0), dropped_frames(0),
+      link_up(false), last_attempt(0), retry_delay(0), backoff(WS_RECONNECT_MIN_MS) {
+}
+
+void BufferedWebSocketClient::begin(char *host, uint16_t port, char *path, char *protocol) {
+    ws.host = host;
+    ws.path = path;
+    ws.protocol = protocol ? protocol : no_protocol;
+    this->port = port;
+    retry_delay = 0;   // first attempt on the next loop()
+    last_attempt = millis();
+}
+
+void BufferedWebSocketClient::loop() {
+    if (link_up && !client.connected()) {
+        linkDown();
+    }
+    if (!link_up) {
+        tryConnect();
+        return;
+    }
+
+    uint8_t scrap[32];
+    while (client.available()) {
+        client.read(scrap, sizeof(scrap));
+    }
+
+    flush();
+}
+
+void BufferedWebSocketClient::tryConnect() {
+    if (!ws.host || millis() - last_attempt < retry_delay) {
+        return;
+    }
+    last_attempt = millis();
+
+    if (client.connect(ws.host, port) && ws.handshake(client)) {
+#ifdef DEBUGGING
+        Serial.println(F("Reconnected"));
+#endif
+        link_up = true;
+        backoff = WS_RECONNECT_MIN_MS;
+        return;
+    }
+    client.stop();
+
+    // up to a quarter more, so a fleet doesn't come back in lockstep
+    retry_delay = backoff + random(0, backoff / 4 + 1);
+    backoff = backoff * 2 > WS_RECONNECT_MAX_MS ? WS_RECONNECT_MAX_MS : backoff * 2;
+}
+
+void BufferedWebSocketClient::linkDown() {
+    client.stop();
+    link_up = false;
+    last_attempt = millis();
+    retry_delay = backoff;
+}
+
+bool BufferedWebSocketClient::send(const uint8_t *data, size_t length, uint8_t opcode) {
+    uint8_t hdr[8];
+    size_t hdrLength;
+
+    // Opcode; final fragment
+    hdr[0] = opcode | WS_FIN;
+    if (length > 125) {
+        hdr[1] = WS_SIZE16 | WS_MASK;
+        hdr[2] = (uint8_t) (length >> 8);
+        hdr[3] = (uint8_t) (length & 0xFF);
+        hdrLength = 4;
+    } else {
+        hdr[1] = (uint8_t) length | WS_MASK;
+        hdrLength = 2;
+    }
+    uint8_t *mask = hdr + hdrLength;
+    for (int i = 0; i < 4; i++) {
+        mask[i] = random(0, 256);
+    }
+    hdrLength += 4;
+
+    const size_t frameLength = hdrLength + length;
+    if (frameLength > WS_CLIENT_BATCH || FRAME_PREFIX + frameLength > ring_size) {
+        return false;
+    }
+
+    while (ring_size - used < FRAME_PREFIX + frameLength) {
+        dropOldest();
+    }
+
+    uint8_t prefix[FRAME_PREFIX] = { (uint8_t) (frameLength & 0xFF), (uint8_t) (frameLength >> 8) };
+    ringPut(prefix, FRAME_PREFIX, NULL);
+    ringPut(hdr, hdrLength, NULL);
+    ringPut(data, length, mask);
+    queued_frames++;
+    return true;
+}
+
+// Whole frames, oldest first, as many as fit one write. They leave the
+// ring only once the write took all of them.
+void BufferedWebSocketClient::flush() {
+    static uint8_t batch[WS_CLIENT_BATCH];
+
+    while (queued_frames && link_up) {
+        size_t n = 0;
+        size_t at = tail;
+        size_t taken = 0;
+        uint16_t frames = 0;
+
+        while (frames < queued_frames) {
+            size_t frameLength = frameAt(at);
+            if (n + frameLength > sizeof(batch)) {
+                break;
+            }
+            ringGet((at + FRAME_PREFIX) % ring_size, batch + n, frameLength);
+            n += frameLength;
+            taken += FRAME_PREFIX + frameLength;
+            at = (at + FRAME_PREFIX + frameLength) % ring_size;
+            frames++;
+        }
+
+        if (client.write(batch, n) != n) {
+            linkDown();
+            return;
+        }
+
+        used -= taken;
+        tail = at;
+        queued_frames -= frames;
+    }
+}
+
+void BufferedWebSocketClient::ringPut(const uint8_t *data, size_t length, const uint8_t *mask) {
+    for (size_t i = 0; i < length; i++) {
+        ring[head] = mask ? data[i] ^ mask[i % 4] : data[i];
+        head = (head + 1) % ring_size;
+    }
+    used += length;
+}
+
+void BufferedWebSocketClient::ringGet(size_t at, uint8_t *data, size_t length) const {
+    size_t first = ring_size - at;
+    if (first > length) {
+        first = length;
+    }
+    memcpy(data, ring + at, first);
+    memcpy(data + first, ring, length - first);
+}
+
+size_t BufferedWebSocketClient::frameAt(size_t at) const {
+    return ring[at] | (ring[(at + 1) % ring_size] << 8);
+}
+
+void BufferedWebSocketClient::dropOldest() {
+    size_t length = FRAME_PREFIX + frameAt(tail);
+
+    tail = (tail + length) % ring_size;
+    used -= length;
+    queued_frames--;
+    dropped_frames++;
+}
@@ -0,0 +1,107 @@
+/*
+BufferedWebSocketClient, a WebSocketClient that outlives its connection
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+-------------
+send() never talks to the network: it masks the frame and appends it to a
+ring the caller provides. loop() keeps the connection up and writes the
+ring out, as many whole frames per write as fit in WS_CLIENT_BATCH.
+
+While the server is away frames keep queueing; when the ring is full the
+oldest ones make room and are counted in dropped(). Reconnects back off
+from WS_RECONNECT_MIN_MS, doubling up to WS_RECONNECT_MAX_MS, with some
+jitter so a fleet doesn't come back in lockstep.
+
+A batch that was only partly written when the link broke is sent again
+after the reconnect, so the server may see a frame twice, but it never
+misses one that was still in the ring.
+
+Frames from the server are read and thrown away.
+*/
+
+#ifndef BUFFEREDWEBSOCKETCLIENT_H_
+#define BUFFEREDWEBSOCKETCLIENT_H_
+
+#include <Arduino.h>
+#include "Client.h"
+#include "WebSocketClient.h"
+
+#ifndef WS_RECONNECT_MIN_MS
+#define WS_RECONNECT_MIN_MS 1000
+#endif
+
+#ifndef WS_RECONNECT_MAX_MS
+#define WS_RECONNECT_MAX_MS 30000
+#endif
+
+// Largest write loop() makes, and so the largest frame send() takes
+#ifndef WS_CLIENT_BATCH
+#define WS_CLIENT_BATCH 512
+#endif
+
+class BufferedWebSocketClient {
+public:
+    BufferedWebSocketClient(Client &client, uint8_t *ring, size_t ringSize);
+
+    // host, path and protocol are kept, not copied
+    void begin(char *host, uint16_t port, char *path, char *protocol = NULL);
+
+    // Reconnects when due and writes out the ring. Call it from loop().
+    void loop();
+
+    // Queues one frame; fails only if it's larger than WS_CLIENT_BATCH
+    // allows or than the whole ring
+    bool send(const uint8_t *data, size_t length, uint8_t opcode = WS_OPCODE_BINARY);
+    bool send(const char *str) { return send(reinterpret_cast<const uint8_t *>(str), strlen(str), WS_OPCODE_TEXT); }
+
+    bool connected() const { return link_up; }
+    uint16_t queued() const { return queued_frames; }
+    size_t queuedBytes() const { return used; }
+    uint32_t dropped() const { return dropped_frames; }
+
+private:
+    Client &client;
+    WebSocketClient ws;
+    uint16_t port;
+
+    uint8_t *ring;
+    size_t ring_size;
+    size_t head;            // next byte written
+    size_t tail;            // oldest frame's length prefix
+    size_t used;
+    uint16_t queued_frames;
+    uint32_t dropped_frames;
+
+    bool link_up;
+    unsigned long last_attempt;
+    unsigned long retry_delay;
+    unsigned long backoff;
+
+    void tryConnect();
+    void linkDown();
+    void flush();
+
+    void ringPut(const uint8_t *data, size_t length, const uint8_t *mask);
+    void ringGet(size_t at, uint8_t *data, size_t length) const;
+    size_t frameAt(size_t at) const;
+    void dropOldest();
+};
+
+#endif
@@ -0,0 +1,209 @@
+#include "WebSocketHub.h"
+
+WebSocketHub::WebSocketHub(WiFiServer &server, Slot *slots, uint8_t count)
+    : server(server), slots(slots), slot_count(count),
+      policy(WS_HUB_SKIP_FRAME), max_skipped(8), dropped_frames(0),
+      message_handler(NULL) {
+    for (uint8_t i = 0; i < slot_count; i++) {
+        slots[i].state = SLOT_FREE;
+    }
+}
+
+void WebSocketHub::begin() {
+    dropped_frames = 0;
+    server.begin();
+    server.setNoDelay(true);
+}
+
+void WebSocketHub::setBackpressure(WebSocketHubPolicy policy, uint8_t maxSkipped) {
+    this->policy = policy;
+    max_skipped = maxSkipped;
+}
+
+uint8_t WebSocketHub::clients() const {
+    uint8_t n = 0;
+
+    for (uint8_t i = 0; i < slot_count; i++) {
+        if (slots[i].state == SLOT_OPEN) {
+            n++;
+        }
+    }
+    return n;
+}
+
+void WebSocketHub::poll() {
+    accept();
+
+    for (uint8_t i = 0; i < slot_count; i++) {
+        if (slots[i].state == SLOT_PENDING) {
+            checkPending(i);
+        } else if (slots[i].state == SLOT_OPEN) {
+            receive(i);
+        }
+    }
+}
+
+// One new client per call, into a free slot
+void WebSocketHub::accept() {
+    WiFiClient client = server.available();
+    if (!client) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < slot_count; i++) {
+        Slot &s = slots[i];
+        if (s.state != SLOT_FREE) {
+            continue;
+        }
+        s.client = client;
+        s.client.setNoDelay(true);
+        s.state = SLOT_PENDING;
+        s.skipped = 0;
+        s.seen = 0;
+        s.since = millis();
+        return;
+    }
+    client.stop();   // no free slot
+}
+
+// Hands the client to the handshake once the blank line ending its
+// request header is in the receive buffer
+void WebSocketHub::checkPending(uint8_t i) {
+    Slot &s = slots[i];
+
+    if (!s.client.connected() || millis() - s.since > WS_HUB_HANDSHAKE_MS) {
+        release(i);
+        return;
+    }
+
+    size_t avail = s.client.available();
+    if (avail <= s.seen) {
+        return;
+    }
+    if (avail > WS_HUB_REQUEST_MAX) {
+        avail = WS_HUB_REQUEST_MAX;
+    }
+
+    static uint8_t request[WS_HUB_REQUEST_MAX];
+    avail = s.client.peekBytes(request, avail);
+
+    // the end may straddle what was searched last time
+    size_t from = s.seen > 3 ? s.seen - 3 : 0;
+    for (size_t k = from; k + 3 < avail; k++) {
+        if (request[k] == '\r' && request[k + 1] == '\n' &&
+            request[k + 2] == '\r' && request[k + 3] == '\n') {
+            if (s.session.handshake(s.client)) {
+                s.state = SLOT_OPEN;
+            } else {
+                release(i);
+            }
+            return;
+        }
+    }
+
+    if (avail >= WS_HUB_REQUEST_MAX) {
+        release(i);
+        return;
+    }
+    s.seen = avail;
+}
+
+void WebSocketHub::receive(uint8_t i) {
+    Slot &s = slots[i];
+
+    if (!s.client.available()) {
+        if (!s.client.connected()) {
+            release(i);
+        }
+        return;
+    }
+
+    // getData() answers pings and closes on a close frame or an
+    // oversized message; the slot is freed on a later poll()
+    uint8_t buf[WS_HUB_RX_BUFFER];
+    int length = s.session.getData(buf, sizeof(buf));
+    if (length >= 0 && message_handler) {
+        message_handler(i, s.session.getOpcode(), buf, length);
+    }
+}
+
+uint8_t WebSocketHub::broadcast(const uint8_t *data, size_t length, uint8_t opcode) {
+    uint8_t frame[WS_SEND_BUFFER];
+    size_t frameLength = WebSocketServer::encodeHeader(frame, opcode | WS_FIN, length);
+    const uint8_t *payload = data;
+
+    if (frameLength + length <= sizeof(frame)) {
+        memcpy(frame + frameLength, data, length);
+        frameLength += length;
+        payload = NULL;
+        length = 0;
+    }
+
+    uint8_t sent = 0;
+    for (uint8_t i = 0; i < slot_count; i++) {
+        if (slots[i].state == SLOT_OPEN && sendFrame(i, frame, frameLength, payload, length)) {
+            sent++;
+        }
+    }
+    return sent;
+}
+
+uint8_t WebSocketHub::broadcast(const char *str) {
+    return broadcast(reinterpret_cast<const uint8_t *>(str), strlen(str), WS_OPCODE_TEXT);
+}
+
+bool WebSocketHub::send(uint8_t slot, const uint8_t *data, size_t length, uint8_t opcode) {
+    if (!isOpen(slot)) {
+        return false;
+    }
+
+    uint8_t hdr[10];
+    size_t hdrLength = WebSocketServer::encodeHeader(hdr, opcode | WS_FIN, length);
+    return sendFrame(slot, hdr, hdrLength, data, length);
+}
+
+bool WebSocketHub::sendFrame(uint8_t i, const uint8_t *frame, size_t frameLength,
+                             const uint8_t *payload, size_t payloadLength) {
+    Slot &s = slots[i];
+
+    if (!s.client.connected()) {
+        release(i);
+        return false;
+    }
+
+    const size_t total = frameLength + payloadLength;
+    if ((size_t) s.client.availableForWrite() < total) {
+        dropped_frames++;
+        if (policy == WS_HUB_DROP_CLIENT || ++s.skipped > max_skipped) {
+            release(i);
+        }
+        return false;
+    }
+    s.skipped = 0;
+
+    size_t written = s.client.write(frame, frameLength);
+    if (payloadLength) {
+        written += s.client.write(payload, payloadLength);
+    }
+    if (written != total) {
+        // half a frame on the wire: the stream can't be resumed
+        release(i);
+        return false;
+    }
+    return true;
+}
+
+void WebSocketHub::close(uint8_t slot) {
+    if (slot >= slot_count) {
+        return;
+    }
+    if (slots[slot].state == SLOT_OPEN && slots[slot].client.connected()) {
+        slots[slot].session.disconnectStream();
+    }
+    release(slot);
+}
+
+void WebSocketHub::release(uint8_t i) {
+    slots[i].client.stop();
+    slots[i].state = SLOT_FREE;
+}
@@ -0,0 +1,128 @@
+/*
+WebSocketHub, several WebSocketServer sessions behind one listening socket
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+
+-------------
+The hub owns a fixed array of slots given by the caller, one client each.
+poll() never waits on a client: a new connection stays pending until its
+whole request header has arrived, and only then is it handed to
+WebSocketServer::handshake(), which at that point has nothing to wait for.
+
+broadcast() encodes the frame header once and writes the same bytes to
+every open slot. A client whose send buffer can't take the whole frame is
+not waited for; what happens to it is the backpressure policy:
+
+    WS_HUB_SKIP_FRAME   it misses this frame; after maxSkipped frames in a
+                        row it is closed
+    WS_HUB_DROP_CLIENT  it is closed at once
+
+Only RFC 6455 clients are served: the frames are built for it.
+*/
+
+#ifndef WEBSOCKETHUB_H_
+#define WEBSOCKETHUB_H_
+
+#include <Arduino.h>
+#if defined(ESP32)
+#include <WiFi.h>
+#else
+#include <ESP8266WiFi.h>
+#endif
+#include "WebSocketServer.h"
+
+// A pending client that hasn't sent its request header by then is closed
+#ifndef WS_HUB_HANDSHAKE_MS
+#define WS_HUB_HANDSHAKE_MS 2000
+#endif
+
+// Longest request header the hub waits for; longer ones are refused
+#ifndef WS_HUB_REQUEST_MAX
+#define WS_HUB_REQUEST_MAX WS_REQUEST_BUFFER
+#endif
+
+// Largest message a client may send the hub
+#ifndef WS_HUB_RX_BUFFER
+#define WS_HUB_RX_BUFFER 128
+#endif
+
+enum WebSocketHubPolicy {
+    WS_HUB_SKIP_FRAME,
+    WS_HUB_DROP_CLIENT
+};
+
+class WebSocketHub {
+public:
+    struct Slot {
+        WiFiClient client;
+        WebSocketServer session;
+        uint8_t state;
+        uint8_t skipped;        // frames missed in a row
+        uint16_t seen;          // request bytes already searched
+        uint32_t since;         // millis() of the accept
+    };
+
+    // Called with each message a client sends, already unmasked
+    typedef void (*MessageHandler)(uint8_t slot, uint8_t opcode, const uint8_t *data, size_t length);
+
+    WebSocketHub(WiFiServer &server, Slot *slots, uint8_t count);
+
+    void begin();
+
+    // Accepts, finishes handshakes, reads messages and frees closed slots.
+    // Call it from loop().
+    void poll();
+
+    // Sends one frame to every open client; returns how many got it
+    uint8_t broadcast(const uint8_t *data, size_t length, uint8_t opcode = WS_OPCODE_BINARY);
+    uint8_t broadcast(const char *str);
+
+    // Sends to a single slot, same backpressure rules
+    bool send(uint8_t slot, const uint8_t *data, size_t length, uint8_t opcode = WS_OPCODE_BINARY);
+
+    void close(uint8_t slot);
+
+    void setBackpressure(WebSocketHubPolicy policy, uint8_t maxSkipped = 8);
+    void onMessage(MessageHandler handler) { message_handler = handler; }
+
+    uint8_t clients() const;
+    bool isOpen(uint8_t slot) const { return slot < slot_count && slots[slot].state == SLOT_OPEN; }
+    // Frames not delivered because of backpressure, since begin()
+    uint32_t dropped() const { return dropped_frames; }
+
+private:
+    enum { SLOT_FREE, SLOT_PENDING, SLOT_OPEN };
+
+    WiFiServer &server;
+    Slot *slots;
+    uint8_t slot_count;
+    WebSocketHubPolicy policy;
+    uint8_t max_skipped;
+    uint32_t dropped_frames;
+    MessageHandler message_handler;
+
+    void accept();
+    void checkPending(uint8_t i);
+    void receive(uint8_t i);
+    bool sendFrame(uint8_t i, const uint8_t *frame, size_t frameLength,
+                   const uint8_t *payload, size_t payloadLength);
+    void release(uint8_t i);
+};
+
+#endif
@@ -1,5 +1,4 @@
 //#define DEBUGGING
-//#define SUPPORT_HIXIE_76
 
 //MS:
 
@@ -10,12 +9,17 @@
 #include "MD5.c"
 #endif
 
+#ifdef ESP8266
+#include <bearssl/bearssl_hash.h>
+#else
 #include "sha1.h"
+#endif
 #include "Base64.h"
 
 
 bool WebSocketServer::handshake(Client &client) {
     socket_client = &client;
+    last_opcode = 0;
 
     // If there is a connected client->
     if (socket_client->connected()) {
@@ -44,182 +48,218 @@ bool WebSocketServer::handshake(Client &client) {
     }
 }
 
+// Value of a header line once "Name:" matched, spaces trimmed; NULL if not
+static char *headerValue(char *line, const char *name) {
+    size_t n = strlen(name);
+
+    if (strncasecmp(line, name, n) != 0 || line[n] != ':') {
+        return NULL;
+    }
+    char *value = line + n + 1;
+    while (*value == ' ' || *value == '\t') {
+        value++;
+    }
+    char *end = value + strlen(value);
+    while (end > value && (end[-1] == ' ' || end[-1] == '\t')) {
+        *--end = 0;
+    }
+    return value;
+}
+
+#ifdef SUPPORT_HIXIE_76
+// Hixie-76 key: its digits as a number, divided by its number of spaces
+static unsigned long hixie76Key(const char *key) {
+    unsigned long number = 0;
+    unsigned int spaces = 0;
+
+    for (; *key; key++) {
+        if (*key >= '0' && *key <= '9') {
+            number = number * 10 + (*key - '0');
+        } else if (*key == ' ') {
+            spaces++;
+        }
+    }
+    return spaces ? number / spaces : 0;
+}
+#endif
+
 bool WebSocketServer::analyzeRequest(int bufferLength) {
-    // Use String library to do some sort of read() magic here.
-    String temp,tempLc;
-    int charpos;
-    int bite;
+    // Handshakes run one at a time, so one buffer serves them all
+    static char request[WS_REQUEST_BUFFER + 1];
+    size_t length = 0;
+    char *end = NULL;
     bool foundupgrade = false;
+    char *newkey = NULL;
 #ifdef SUPPORT_HIXIE_76
-    String oldkey[2];
-    unsigned long intkey[2];
+    char *oldkey[2] = { NULL, NULL };
+    char *hostValue = NULL;
 #endif
-    String newkey;
 
+#ifdef SUPPORT_HIXIE_76
     hixie76style = false;
-    
+#endif
+
 #ifdef DEBUGGING
     Serial.println(F("Analyzing request headers"));
 #endif
 
-    for (int i = 0; i < 10 && !socket_client->available(); i++) {
-      delay(20);
+    // Bulk reads until the blank line; nothing is read past what the
+    // client has sent, and a client waits for our answer before framing.
+    // A header that stalls for 200 ms is given up on, as before.
+    unsigned long start = millis();
+    while (!end) {
+        int avail = socket_client->available();
+        if (avail <= 0) {
+            if (!socket_client->connected() || millis() - start > TIMEOUT_IN_MS / 50) {
+                return false;
+            }
+            delay(1);
+            continue;
+        }
+        if (length == WS_REQUEST_BUFFER) {
+#ifdef DEBUGGING
+            Serial.println(F("Request header too long"));
+#endif
+            return false;
+        }
+        size_t room = WS_REQUEST_BUFFER - length;
+        int n = socket_client->read(reinterpret_cast<uint8_t *>(request) + length,
+                                    (size_t) avail < room ? avail : room);
+        if (n <= 0) {
+            return false;
+        }
+        // the blank line may straddle the previous read
+        size_t from = length > 3 ? length - 3 : 0;
+        length += n;
+        request[length] = 0;
+        end = strstr(request + from, "\r\n\r\n");
     }
+    end[2] = 0;
 
-    // TODO: More robust string extraction
-    while ((bite = socket_client->read()) != -1) {
-
-        temp += (char)bite;
-
-        if ((char)bite == '\n') {
-            // Recieved CRNL without content, so header is done
-#ifndef SUPPORT_HIXIE_76
-            if (temp.charAt(0) == '\r') break;
-#endif
+    // Header lines are parsed where they lie
+    for (char *line = request; *line; ) {
+        char *eol = strstr(line, "\r\n");
+        *eol = 0;
 #ifdef DEBUGGING
-            Serial.print("Got Line: " + temp);
+        Serial.print(F("Got Line: "));
+        Serial.println(line);
 #endif
-            // Preserve mixed case vor values
-            tempLc = temp;
-            // Remove whitespaces and convert to lowercase to comply
-            // http://www.w3.org/Protocols/rfc2616/rfc2616-sec4.html
-            tempLc.toLowerCase();
-            while ((charpos = temp.indexOf(' ')) != -1) {
-                temp.remove(charpos,1);
-            }
-            if (!foundupgrade && tempLc.startsWith("upgrade:") && temp.indexOf("WebSocket") != -1) {
-                // OK, it's a websockets handshake for sure
-                foundupgrade = true;
-                hixie76style = true;
-            } else if (!foundupgrade && tempLc.startsWith("upgrade:") && temp.indexOf("websocket") != -1) {
-                foundupgrade = true;
-                hixie76style = false;
-            } else if (tempLc.startsWith("origin:")) {
-                origin = temp.substring(7,temp.length() - 2); // Don't save last CR+LF
-            } else
+        char *value;
+        if (!foundupgrade && (value = headerValue(line, "upgrade")) && strncasecmp(value, "websocket", 9) == 0) {
+            foundupgrade = true;
 #ifdef SUPPORT_HIXIE_76
-            if (tempLc.startsWith("host:")) {
-                host = temp.substring(5,temp.length() - 2); // Don't save last CR+LF
-            } else if (tempLcLc.startsWith("sec-websocket-key1:")) {
-                oldkey[0]=tempLc.substring(19,temp.length() - 2); // Don't save last CR+LF
-            } else if (temp.startsWith("sec-websocket-key2:")) {
-                oldkey[1]=tempLc.substring(19,temp.length() - 2); // Don't save last CR+LF
-            } else
+            // OK, Hixie-76 clients spell it WebSocket
+            hixie76style = strncmp(value, "WebSocket", 9) == 0;
 #endif
-            if (tempLc.startsWith("sec-websocket-key:")) {
-                newkey=temp.substring(18,temp.length() - 2); // Don't save last CR+LF
-            }
-            temp = "";        
+        } else if ((value = headerValue(line, "sec-websocket-key"))) {
+            newkey = value;
         }
-
-        if (!socket_client->available()) {
-          delay(20);
+#ifdef SUPPORT_HIXIE_76
+        else if ((value = headerValue(line, "origin"))) {
+            origin = value;
+        } else if ((value = headerValue(line, "host"))) {
+            hostValue = value;
+        } else if ((value = headerValue(line, "sec-websocket-key1"))) {
+            oldkey[0] = value;
+        } else if ((value = headerValue(line, "sec-websocket-key2"))) {
+            oldkey[1] = value;
         }
+#endif
+        line = eol + 2;
     }
 
     if (!socket_client->connected()) {
         return false;
     }
 
-    temp += 0; // Terminate string
-
     // Assert that we have all headers that are needed. If so, go ahead and
     // send response headers.
     if (foundupgrade == true) {
 
 #ifdef SUPPORT_HIXIE_76
-        if (hixie76style && host.length() > 0 && oldkey[0].length() > 0 && oldkey[1].length() > 0) {
-            // All ok, proceed with challenge and MD5 digest
-            char key3[9] = {0};
-            // What now is in temp should be the third key
-            temp.toCharArray(key3, 9);
-
-            // Process keys
-            for (int i = 0; i <= 1; i++) {
-                unsigned int spaces =0;
-                String numbers;
-                
-                for (int c = 0; c < oldkey[i].length(); c++) {
-                    char ac = oldkey[i].charAt(c);
-                    if (ac >= '0' && ac <= '9') {
-                        numbers += ac;
-                    }
-                    if (ac == ' ') {
-                        spaces++;
-                    }
-                }
-                char numberschar[numbers.length() + 1];
-                numbers.toCharArray(numberschar, numbers.length()+1);
-                intkey[i] = strtoul(numberschar, NULL, 10) / spaces;        
+        if (hixie76style && hostValue && oldkey[0] && oldkey[1]) {
+            host = hostValue;
+
+            // The third key is the 8 bytes after the header, maybe read already
+            char key3[8];
+            size_t got = length - (end + 4 - request);
+            if (got > 8) {
+                got = 8;
+            }
+            memcpy(key3, end + 4, got);
+            if (!readFully(reinterpret_cast<uint8_t *>(key3) + got, 8 - got)) {
+                return false;
             }
-            
+
+            unsigned long intkey[2] = { hixie76Key(oldkey[0]), hixie76Key(oldkey[1]) };
+
             unsigned char challenge[16] = {0};
             challenge[0] = (unsigned char) ((intkey[0] >> 24) & 0xFF);
             challenge[1] = (unsigned char) ((intkey[0] >> 16) & 0xFF);
             challenge[2] = (unsigned char) ((intkey[0] >>  8) & 0xFF);
-            challenge[3] = (unsigned char) ((intkey[0]      ) & 0xFF);    
+            challenge[3] = (unsigned char) ((intkey[0]      ) & 0xFF);
             challenge[4] = (unsigned char) ((intkey[1] >> 24) & 0xFF);
             challenge[5] = (unsigned char) ((intkey[1] >> 16) & 0xFF);
             challenge[6] = (unsigned char) ((intkey[1] >>  8) & 0xFF);
             challenge[7] = (unsigned char) ((intkey[1]      ) & 0xFF);
-            
+
             memcpy(challenge + 8, key3, 8);
-            
+
             unsigned char md5Digest[16];
             MD5(challenge, md5Digest, 16);
-            
+
             socket_client->print(F("HTTP/1.1 101 Web Socket Protocol Handshake\r\n"));
             socket_client->print(F("Upgrade: WebSocket\r\n"));
             socket_client->print(F("Connection: Upgrade\r\n"));
-            socket_client->print(F("Sec-WebSocket-Origin: "));        
+            socket_client->print(F("Sec-WebSocket-Origin: "));
             socket_client->print(origin);
             socket_client->print(CRLF);
-            
+
             // The "Host:" value should be used as location
             socket_client->print(F("Sec-WebSocket-Location: ws://"));
             socket_client->print(host);
             socket_client->print(socket_urlPrefix);
             socket_client->print(CRLF);
             socket_client->print(CRLF);
-            
+
             socket_client->write(md5Digest, 16);
 
             return true;
         }
 #endif
 
-        if (!hixie76style && newkey.length() > 0) {
-
-            // add the magic string
-            newkey += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-
-            uint8_t *hash;
-            char result[21];
-            char b64Result[30];
-
+        if (!hixie76style && newkey && *newkey) {
+            static const char magic[] = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+            uint8_t digest[20];
+
+#ifdef ESP8266
+            br_sha1_context sha;
+            br_sha1_init(&sha);
+            br_sha1_update(&sha, newkey, strlen(newkey));
+            br_sha1_update(&sha, magic, sizeof(magic) - 1);
+            br_sha1_out(&sha, digest);
+#else
             SHA1Context sha;
-            int err;
-            uint8_t Message_Digest[20];
-            Serial.println("Calculating");
-            err = SHA1Reset(&sha);
-            err = SHA1Input(&sha, reinterpret_cast<const uint8_t *>(newkey.c_str()), newkey.length());
-            err = SHA1Result(&sha, Message_Digest);
-            hash = Message_Digest;
-
-            for (int i=0; i<20; ++i) {
-                result[i] = (char)hash[i];
-            }
-            result[20] = '\0';
+            SHA1Reset(&sha);
+            SHA1Input(&sha, reinterpret_cast<const uint8_t *>(newkey), strlen(newkey));
+            SHA1Input(&sha, reinterpret_cast<const uint8_t *>(magic), sizeof(magic) - 1);
+            SHA1Result(&sha, digest);
+#endif
 
-            base64_encode(b64Result, result, 20);
-            Serial.println("Sending");
-            char * response = (char*)malloc(200);
-            sprintf(response, "HTTP/1.1 101 Web Socket Protocol Handshake\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n", b64Result);
-            socket_client->print(response);
+            char b64Result[30];
+            base64_encode(b64Result, reinterpret_cast<char *>(digest), 20);
+
+            // One write for the whole response
+            char response[160];
+            int n = snprintf(response, sizeof(response),
+                             "HTTP/1.1 101 Web Socket Protocol Handshake\r\n"
+                             "Upgrade: websocket\r\n"
+                             "Connection: Upgrade\r\n"
+                             "Sec-WebSocket-Accept: %s\r\n\r\n", b64Result);
+            socket_client->write(reinterpret_cast<const uint8_t *>(response), n);
 #ifdef DEBUGGING
             Serial.print(response);
 #endif
-            free(response);
             return true;
         } else {
             // something went horribly wrong
@@ -234,128 +274,161 @@ bool WebSocketServer::analyzeRequest(int bufferLength) {
     }
 }
 
+// XORs a received payload with its mask, a word at a time once p is aligned
+static void unmaskPayload(uint8_t *p, size_t length, const uint8_t mask[4]) {
+    size_t i = 0;
+
+    while (i < length && ((uintptr_t)(p + i) & 3)) {
+        p[i] ^= mask[i & 3];
+        i++;
+    }
+    if (length - i >= 4) {
+        // the mask as it lines up from here, in memory order
+        uint8_t m[4];
+        for (int k = 0; k < 4; k++) {
+            m[k] = mask[(i + k) & 3];
+        }
+        uint32_t word;
+        memcpy(&word, m, 4);
+
+        uint32_t *w = reinterpret_cast<uint32_t *>(p + i);
+        for (; length - i >= 4; i += 4) {
+            *w++ ^= word;
+        }
+    }
+    while (i < length) {
+        p[i] ^= mask[i & 3];
+        i++;
+    }
+}
+
 #ifdef SUPPORT_HIXIE_76
-String WebSocketServer::handleHixie76Stream() {
+int WebSocketServer::handleHixie76Stream(uint8_t *buf, size_t cap) {
+    size_t frameLength = 0;
     int bite;
-    int frameLength = 0;
-    // String to hold bytes sent by client to server.
-    String socketString;
-
-    if (socket_client->connected() && socket_client->available()) {
-        bite = timedRead();
-
-        if (bite != -1) {
-            if (bite == 0)
-                continue; // Frame start, don't save
-
-            if ((uint8_t) bite == 0xFF) {
-                // Frame end. Process what we got.
-                return socketString;
-                
-            } else {
-                socketString += (char)bite;
-                frameLength++;            
-
-                if (frameLength > MAX_FRAME_LENGTH) {
-                    // Too big to handle!
+
+    if (!socket_client->connected() || !socket_client->available()) {
+        return -1;
+    }
+
+    // 0x00 <text> 0xFF
+    while ((bite = timedRead()) != -1) {
+        if (bite == 0 && frameLength == 0) {
+            continue; // Frame start, don't save
+        }
+        if ((uint8_t) bite == 0xFF) {
+            last_opcode = WS_OPCODE_TEXT;
+            return frameLength;
+        }
+        if (frameLength >= cap) {
+            // Too big to handle!
 #ifdef DEBUGGING
-                    Serial.print("Client send frame exceeding ");
-                    Serial.print(MAX_FRAME_LENGTH);
-                    Serial.println(" bytes");
+            Serial.print("Client send frame exceeding ");
+            Serial.print(cap);
+            Serial.println(" bytes");
 #endif
-                    return;
-                }  
-            }           
+            disconnectStream();
+            return -1;
         }
+        buf[frameLength++] = bite;
     }
 
-    return socketString;
+    return -1;
 }
 
 #endif
 
-String WebSocketServer::handleStream() {
-    uint8_t msgtype;
-    unsigned int length;
-    uint8_t mask[4];
-    unsigned int i;
+int WebSocketServer::handleStream(uint8_t *buf, size_t cap) {
+    size_t got = 0;
+    uint8_t opcode = 0;
 
-    // String to hold bytes sent by client to server.
-    String socketString;
-
-    if (socket_client->connected() && socket_client->available()) {
-        msgtype = timedRead();
-        if (msgtype == 0x88) {
-            disconnectStream();
-            return socketString;
-        }
-        if (!socket_client->connected()) {
-            return socketString;
-        }
+    if (!socket_client->connected() || !socket_client->available()) {
+        return -1;
+    }
 
-        length = timedRead() & 127;
-        if (!socket_client->connected()) {
-            return socketString;
+    while (true) {
+        uint8_t hdr[2];
+        if (!readFully(hdr, 2)) {
+            return -1;
         }
+        const bool fin = hdr[0] & WS_FIN;
+        const uint8_t frameOpcode = hdr[0] & 0x0F;
+        const bool masked = hdr[1] & 0x80;
+        uint64_t length = hdr[1] & 127;
 
         if (length == 126) {
-            length = timedRead() << 8;
-            if (!socket_client->connected()) {
-                return socketString;
+            uint8_t ext[2];
+            if (!readFully(ext, 2)) {
+                return -1;
             }
-            
-            length |= timedRead();
-            if (!socket_client->connected()) {
-                return socketString;
-            }   
-
+            length = (ext[0] << 8) | ext[1];
         } else if (length == 127) {
-#ifdef DEBUGGING
-            Serial.println(F("No support for over 16 bit sized messages"));
-#endif
-            terminateStream(0x89);
-            return socketString;
+            uint8_t ext[8];
+            if (!readFully(ext, 8)) {
+                return -1;
+            }
+            length = 0;
+            for (int i = 0; i < 8; i++) {
+                length = (length << 8) | ext[i];
+            }
         }
 
-        // get the mask
-        mask[0] = timedRead();
-        if (!socket_client->connected()) {
-            return socketString;
+        uint8_t mask[4] = {0, 0, 0, 0};
+        if (masked && !readFully(mask, 4)) {
+            return -1;
         }
 
-        mask[1] = timedRead();
-        if (!socket_client->connected()) {
+        if (frameOpcode & 0x08) {
+            // Control frames: at most 125 bytes, and may come between fragments
+            uint8_t control[125];
+            if (length > sizeof(control) || !readFully(control, length)) {
+                disconnectStream();
+                return -1;
+            }
+            unmaskPayload(control, length, mask);
 
-            return socketString;
+            if (frameOpcode == WS_OPCODE_CLOSE) {
+                disconnectStream();
+                return -1;
+            }
+            if (frameOpcode == WS_OPCODE_PING) {
+                sendEncodedData(control, length, WS_OPCODE_PONG);
+            }
+#ifdef DEBUGGING
+            if (frameOpcode == WS_OPCODE_PONG) {
+                Serial.println(F("Received pong"));
+            }
+#endif
+            if (got == 0 && !opcode && !socket_client->available()) {
+                return -1; // nothing but a control frame this time
+            }
+            continue;
         }
 
-        mask[2] = timedRead();
-        if (!socket_client->connected()) {
-            return socketString;
+        if (frameOpcode != WS_OPCODE_CONTINUATION) {
+            opcode = frameOpcode;
         }
 
-        mask[3] = timedRead();
-        if (!socket_client->connected()) {
-            return socketString;
+        if (length > cap - got) {
+#ifdef DEBUGGING
+            Serial.println(F("Message does not fit the buffer"));
+#endif
+            skip(length);
+            closeWithStatus(1009);
+            return -1;
         }
 
-        for (i=0; i<length; ++i) {
-            socketString += (char) (timedRead() ^ mask[i % 4]);
-            if (!socket_client->connected()) {
-                return socketString;
-            }
+        if (!readFully(buf + got, length)) {
+            return -1;
         }
-        if (msgtype == 0x89) {
-            sendPong(socketString);
-        } else if (msgtype == 0x8A) {
-#ifdef DEBUGGING
-            Serial.println(F("Received pong"));
-#endif
-            return socketString;
+        unmaskPayload(buf + got, length, mask);
+        got += length;
+
+        if (fin) {
+            last_opcode = opcode;
+            return got;
         }
     }
-
-    return socketString;
 }
 
 void WebSocketServer::terminateStream(uint8_t cause) {
@@ -405,17 +478,27 @@ void WebSocketServer::disconnectStream() {
 }
 
 String WebSocketServer::getData() {
-    String data;
+    uint8_t buf[MAX_FRAME_LENGTH + 1];
+
+    int length = getData(buf, MAX_FRAME_LENGTH);
+    if (length < 0) {
+        return String();
+    }
+    buf[length] = 0;
 
+    return String(reinterpret_cast<char *>(buf));
+}
+
+int WebSocketServer::getData(uint8_t *buf, size_t cap) {
     if (hixie76style) {
 #ifdef SUPPORT_HIXIE_76
-        data = handleHixie76Stream();
+        return handleHixie76Stream(buf, cap);
+#else
+        return -1;
 #endif
-    } else {
-        data = handleStream();
     }
 
-    return data;
+    return handleStream(buf, cap);
 }
 
 void WebSocketServer::sendData(const char *str) {
@@ -434,6 +517,12 @@ void WebSocketServer::sendData(const char *str) {
     }
 }
 
+void WebSocketServer::sendData(const uint8_t *data, size_t length, uint8_t opcode) {
+    if (socket_client->connected() && !hixie76style) {
+        sendEncodedData(data, length, opcode);
+    }
+}
+
 void WebSocketServer::sendData(String str) {
 #ifdef DEBUGGING
     Serial.print(F("Sending data: "));
@@ -450,39 +539,101 @@ void WebSocketServer::sendData(String str) {
     }
 }
 
+bool WebSocketServer::readFully(uint8_t *buf, size_t length) {
+    unsigned long start = millis();
+
+    while (length) {
+        int avail = socket_client->available();
+        if (avail <= 0) {
+            if (!socket_client->connected() || millis() - start > TIMEOUT_IN_MS) {
+                return false;
+            }
+            delay(1);
+            continue;
+        }
+        int n = socket_client->read(buf, length < (size_t) avail ? length : avail);
+        if (n <= 0) {
+            return false;
+        }
+        buf += n;
+        length -= n;
+        start = millis();
+    }
+    return true;
+}
+
+bool WebSocketServer::skip(size_t length) {
+    uint8_t scrap[32];
+
+    while (length) {
+        size_t n = length < sizeof(scrap) ? length : sizeof(scrap);
+        if (!readFully(scrap, n)) {
+            return false;
+        }
+        length -= n;
+    }
+    return true;
+}
+
 int WebSocketServer::timedRead() {
-  while (!socket_client->available()) {
-    delay(20);  
-  }
+    uint8_t bite;
 
-  return socket_client->read();
+    return readFully(&bite, 1) ? bite : -1;
 }
 
-void WebSocketServer::sendEncodedData(char *str, uint8_t opcode) {
-    int size = strlen(str);
+size_t WebSocketServer::encodeHeader(uint8_t *hdr, uint8_t opcode, size_t length) {
+    hdr[0] = opcode;
+    if (length > 0xFFFF) {
+        hdr[1] = 127;
+        for (int i = 0; i < 8; i++) {
+            hdr[9 - i] = (uint8_t) ((uint64_t) length >> (8 * i));
+        }
+        return 10;
+    }
+    if (length > 125) {
+        hdr[1] = 126;
+        hdr[2] = (uint8_t) (length >> 8);
+        hdr[3] = (uint8_t) (length & 0xFF);
+        return 4;
+    }
+    hdr[1] = (uint8_t) length;
+    return 2;
+}
+
+void WebSocketServer::sendEncodedData(const uint8_t *data, size_t length, uint8_t opcode) {
+    // Bare opcodes from older callers mean a final frame
+    if (opcode < WS_FIN) {
+        opcode |= WS_FIN;
+    }
 
-    // string type
-    socket_client->write(opcode);
+    uint8_t frame[WS_SEND_BUFFER];
+    size_t hdrLength = encodeHeader(frame, opcode, length);
 
-    // NOTE: no support for > 16-bit sized messages
-    if (size > 125) {
-        socket_client->write(126);
-        socket_client->write((uint8_t) (size >> 8));
-        socket_client->write((uint8_t) (size & 0xFF));
+    if (hdrLength + length <= sizeof(frame)) {
+        // header and payload in one segment
+        memcpy(frame + hdrLength, data, length);
+        socket_client->write(frame, hdrLength + length);
     } else {
-        socket_client->write((uint8_t) size);
+        socket_client->write(frame, hdrLength);
+        socket_client->write(data, length);
     }
+}
 
-    socket_client->print(str);
+void WebSocketServer::sendEncodedData(char *str, uint8_t opcode) {
+    sendEncodedData(reinterpret_cast<const uint8_t *>(str), strlen(str), opcode);
 }
 
-void WebSocketServer::sendEncodedData(String str, uint8_t opcode) {
-    int size = str.length() + 1;
-    char cstr[size];
+void WebSocketServer::closeWithStatus(uint16_t status) {
+    uint8_t code[2] = { (uint8_t) (status >> 8), (uint8_t) (status & 0xFF) };
 
-    str.toCharArray(cstr, size);
+    sendEncodedData(code, 2, WS_OPCODE_CLOSE);
+    socket_client->flush();
+    delay(10);
+    socket_client->stop();
+}
 
-    sendEncodedData(cstr, opcode);
+void WebSocketServer::sendEncodedData(String str, uint8_t opcode) {
+    sendEncodedData(reinterpret_cast<const uint8_t *>(str.c_str()), str.length(), opcode);
 }
 
 void WebSocketServer::sendPing(String str) {
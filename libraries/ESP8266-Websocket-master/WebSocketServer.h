@@ -56,6 +56,15 @@ http://tools.ietf.org/html/draft-hixie-thewebsocketprotocol-75
 #define TIMEOUT_IN_MS 10000
 #define BUFFER_LENGTH 32
 
+// Longest request header a handshake accepts
+#ifndef WS_REQUEST_BUFFER
+#define WS_REQUEST_BUFFER 768
+#endif
+
+// Hixie-76 (draft 76) clients: MD5 challenge and 0x00/0xFF text frames.
+// Off by default; no browser in use still speaks it.
+//#define SUPPORT_HIXIE_76
+
 // ACTION_SPACE is how many actions are allowed in a program. Defaults to 
 // 5 unless overwritten by user.
 #ifndef CALLBACK_FUNCTIONS
@@ -70,6 +79,20 @@ http://tools.ietf.org/html/draft-hixie-thewebsocketprotocol-75
 
 #define SIZE(array) (sizeof(array) / sizeof(*array))
 
+// Frame opcodes (RFC 6455 5.2)
+#define WS_OPCODE_CONTINUATION 0x0
+#define WS_OPCODE_TEXT         0x1
+#define WS_OPCODE_BINARY       0x2
+#define WS_OPCODE_CLOSE        0x8
+#define WS_OPCODE_PING         0x9
+#define WS_OPCODE_PONG         0xA
+#define WS_FIN                 0x80
+
+// Frames up to this size (header included) go out in a single write
+#ifndef WS_SEND_BUFFER
+#define WS_SEND_BUFFER 128
+#endif
+
 class WebSocketServer {
 public:
 
@@ -77,12 +100,25 @@ public:
     // connections.
     bool handshake(Client &client);
     
-    // Get data off of the stream
+    // Get data off of the stream, as text of up to MAX_FRAME_LENGTH bytes
     String getData();
 
+    // Reads the next message into buf, unmasked; fragments are joined.
+    // Pings are answered on the way. Returns the payload length, or -1 if
+    // there was no message, the peer closed, or the message didn't fit in
+    // cap (the connection is then closed with 1009, message too big).
+    // getOpcode() tells text from binary.
+    int getData(uint8_t *buf, size_t cap);
+    uint8_t getOpcode() const { return last_opcode; }
+
     // Write data to the stream
     void sendData(const char *str);
     void sendData(String str);
+    void sendData(const uint8_t *data, size_t length, uint8_t opcode = WS_OPCODE_BINARY);
+
+    // Writes the header of an unmasked frame to hdr (10 bytes at most),
+    // returns its length
+    static size_t encodeHeader(uint8_t *hdr, uint8_t opcode, size_t length);
     
     // Disconnect user gracefully.
     void disconnectStream();
@@ -96,23 +132,33 @@ private:
 
     const char *socket_urlPrefix;
 
+#ifdef SUPPORT_HIXIE_76
     String origin;
     String host;
     bool hixie76style;
+#else
+    static const bool hixie76style = false;
+#endif
+    uint8_t last_opcode;
 
     // Discovers if the client's header is requesting an upgrade to a
     // websocket connection.
     bool analyzeRequest(int bufferLength);
 
 #ifdef SUPPORT_HIXIE_76
-    String handleHixie76Stream();
+    int handleHixie76Stream(uint8_t *buf, size_t cap);
 #endif
-    String handleStream();    
-    
+    int handleStream(uint8_t *buf, size_t cap);
+
+    // Bulk reads that give up after TIMEOUT_IN_MS without progress
+    bool readFully(uint8_t *buf, size_t length);
+    bool skip(size_t length);
     int timedRead();
 
+    void sendEncodedData(const uint8_t *data, size_t length, uint8_t opcode);
     void sendEncodedData(char *str, uint8_t);
     void sendEncodedData(String str, uint8_t);
+    void closeWithStatus(uint16_t status);
     
     // Disconnect user gracefully.
     void terminateStream(uint8_t);
@@ -0,0 +1,36 @@
+#include <ESP8266WiFi.h>
+#include <BufferedWebSocketClient.h>
+
+const char* ssid     = "SSID HERE";
+const char* password = "PASSWORD HERE";
+char path[] = "/";
+char host[] = "collector.local";
+
+// Use WiFiClient class to create TCP connections
+WiFiClient client;
+
+// Room for a minute or so of samples while the server is away
+uint8_t ring[4096];
+BufferedWebSocketClient webSocketClient(client, ring, sizeof(ring));
+
+unsigned long lastSample = 0;
+
+void setup() {
+  Serial.begin(115200);
+  WiFi.begin(ssid, password);
+
+  // No need to wait for WiFi: loop() connects when it can
+  webSocketClient.begin(host, 80, path);
+}
+
+void loop() {
+  webSocketClient.loop();
+
+  if (millis() - lastSample >= 1000) {
+    lastSample = millis();
+
+    char sample[32];
+    snprintf(sample, sizeof(sample), "%lu,%d", lastSample, analogRead(A0));
+    webSocketClient.send(sample);
+  }
+}
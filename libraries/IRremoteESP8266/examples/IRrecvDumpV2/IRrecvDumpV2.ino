@@ -334,8 +334,10 @@ void loop() {
           "This result shouldn't be trusted until this is resolved. "
           "Edit & increase kCaptureBufferSize.\n",
           kCaptureBufferSize);
+    // Print the results straight to Serial, so they don't need the heap.
+    IRtext output(&Serial);
     // Display the basic output of what we found.
-    Serial.print(resultToHumanReadableBasic(&results));
+    resultToHumanReadableBasic(&results, &output);
     dumpACInfo(&results);  // Display any extra A/C info if we have it.
     yield();  // Feed the WDT as the text output can take a while to print.
 
@@ -345,11 +347,13 @@ void loop() {
     Serial.println();
 
     // Output RAW timing info of the result.
-    Serial.println(resultToTimingInfo(&results));
+    resultToTimingInfo(&results, &output);
+    Serial.println();
     yield();  // Feed the WDT (again)
 
     // Output the results as source code
-    Serial.println(resultToSourceCode(&results));
+    resultToSourceCode(&results, &output);
+    Serial.println();
     Serial.println("");  // Blank line between entries
     yield();             // Feed the WDT (again)
   }
@@ -35,7 +35,136 @@
 #include "ir_Vestel.h"
 #include "ir_Whirlpool.h"
 
-IRac::IRac(uint8_t pin) { _pin = pin; }
+IRac::IRac(uint8_t pin) : _irsend(pin) {
+  _pin = pin;
+  _cache = NULL;
+  _cache_size = 0;
+  _cache_clock = 0;
+  _diff = NULL;
+  _diff_size = 0;
+  _diff_refresh = 0;
+  _diff_skipped = 0;
+}
+
+IRac::~IRac(void) {
+  disableCache();
+  disableDiff();
+}
+
+// Keep the timings of the last few A/C messages sendAc() sent, so sending one
+// of them again skips building the state and encoding it.
+// The timings are kept on the heap, sized to fit each message.
+//
+// Args:
+//   entries: Nr. of different messages to keep. The least recently used one
+//            makes way for a new one.
+void IRac::enableCache(const uint8_t entries) {
+  disableCache();
+  if (entries == 0) return;
+  _cache = new cache_entry_t[entries];
+  _cache_size = entries;
+  for (uint8_t i = 0; i < _cache_size; i++) _cache[i].timings = NULL;
+}
+
+// Stop caching, and free all the cached messages.
+void IRac::disableCache(void) {
+  if (_cache == NULL) return;
+  for (uint8_t i = 0; i < _cache_size; i++) delete[] _cache[i].timings;
+  delete[] _cache;
+  _cache = NULL;
+  _cache_size = 0;
+}
+
+// Are two sets of sendAc() arguments the same?
+// Args:
+//   a, b: The sets of arguments to compare.
+//   clock: Compare the clock too.
+bool IRac::sameState(const stdAc::state_t *a, const stdAc::state_t *b,
+                     const bool clock) {
+  return a->protocol == b->protocol && a->model == b->model &&
+      a->power == b->power && a->mode == b->mode &&
+      a->degrees == b->degrees && a->celsius == b->celsius &&
+      a->fanspeed == b->fanspeed && a->swingv == b->swingv &&
+      a->swingh == b->swingh && a->quiet == b->quiet &&
+      a->turbo == b->turbo && a->econo == b->econo && a->light == b->light &&
+      a->filter == b->filter && a->clean == b->clean && a->beep == b->beep &&
+      a->sleep == b->sleep && (!clock || a->clock == b->clock);
+}
+
+// Only send an A/C message when it differs from the last one sent to the same
+// (vendor, model). An unchanged sendAc() returns true without sending.
+// Changes to the clock alone don't count; the clock goes with the next message.
+//
+// Args:
+//   refresh_ms: Send the unchanged state again once this many milliseconds
+//               have passed since it was last sent, in case the A/C missed it
+//               or its own remote changed something. 0 means never.
+//   entries: Nr. of different (vendor, model)s to remember. The one sent to
+//            least recently makes way for a new one.
+void IRac::enableDiff(const uint32_t refresh_ms, const uint8_t entries) {
+  disableDiff();
+  if (entries == 0) return;
+  _diff = new diff_entry_t[entries];
+  _diff_size = entries;
+  _diff_refresh = refresh_ms;
+  for (uint8_t i = 0; i < _diff_size; i++) _diff[i].used = false;
+}
+
+// Send every sendAc() again, and forget the last states.
+void IRac::disableDiff(void) {
+  delete[] _diff;
+  _diff = NULL;
+  _diff_size = 0;
+}
+
+// Forget the last states, so the next sendAc() to each (vendor, model) is
+// sent. e.g. After the A/C lost power, or someone used its own remote.
+void IRac::resetDiff(void) {
+  for (uint8_t i = 0; i < _diff_size; i++) _diff[i].used = false;
+}
+
+// Nr. of sendAc() calls not sent because nothing had changed.
+uint32_t IRac::skippedSends(void) { return _diff_skipped; }
+
+// The last state sent to the (vendor, model) of the given arguments. If there
+// is none, an unused entry, or the one sent to least recently.
+IRac::diff_entry_t *IRac::diffEntry(const stdAc::state_t *key) {
+  diff_entry_t *entry = &_diff[0];
+  for (uint8_t i = 0; i < _diff_size; i++) {
+    diff_entry_t *e = &_diff[i];
+    if (e->used && e->state.protocol == key->protocol &&
+        e->state.model == key->model)
+      return e;
+    if (entry->used && (!e->used || e->sent.elapsed() > entry->sent.elapsed()))
+      entry = e;
+  }
+  entry->used = false;
+  return entry;
+}
+
+// Send a cached A/C message, if there is one for the given arguments.
+// Like the A/C classes do, it doesn't return until it has been sent.
+//
+// Args:
+//   key: The sendAc() arguments.
+// Returns:
+//   A boolean indicating if it was found & sent.
+bool IRac::sendCached(const stdAc::state_t *key) {
+  for (uint8_t i = 0; i < _cache_size; i++) {
+    cache_entry_t *entry = &_cache[i];
+    if (entry->timings == NULL || !sameState(&entry->key, key)) continue;
+    entry->used = ++_cache_clock;
+#if IRSEND_BACKGROUND
+    while (IRsend::busy()) yield();  // Let WiFi etc. run while we wait.
+#endif  // IRSEND_BACKGROUND
+    _irsend.playback(entry->timings, entry->len, entry->hz, entry->duty);
+#if IRSEND_BACKGROUND
+    while (IRsend::busy()) yield();
+#endif  // IRSEND_BACKGROUND
+    return true;
+  }
+  return false;
+}
 
 // Is the given protocol supported by the IRac class?
 bool IRac::isProtocolSupported(const decode_type_t protocol) {
@@ -812,6 +941,10 @@ void IRac::whirlpool(IRWhirlpoolAc *ac, const whirlpool_ac_remote_model_t model,
 //   clock:   Nr. of mins past midnight to set the clock to. (< 0 means off.)
 // Returns:
 //   boolean: True, if accepted/converted/attempted. False, if unsupported.
+//
+// Note:
+//   With enableDiff(), a message the same as the last one sent isn't sent.
+//   With enableCache(), a message is looked up by these arguments first.
 bool IRac::sendAc(const decode_type_t vendor, const int16_t model,
                   const bool power, const stdAc::opmode_t mode,
                   const float degrees, const bool celsius,
@@ -820,6 +953,98 @@ bool IRac::sendAc(const decode_type_t vendor, const int16_t model,
                   const bool quiet, const bool turbo, const bool econo,
                   const bool light, const bool filter, const bool clean,
                   const bool beep, const int16_t sleep, const int16_t clock) {
+  stdAc::state_t key;
+  key.protocol = vendor;
+  key.model = model;
+  key.power = power;
+  key.mode = mode;
+  key.degrees = degrees;
+  key.celsius = celsius;
+  key.fanspeed = fan;
+  key.swingv = swingv;
+  key.swingh = swingh;
+  key.quiet = quiet;
+  key.turbo = turbo;
+  key.econo = econo;
+  key.light = light;
+  key.filter = filter;
+  key.clean = clean;
+  key.beep = beep;
+  key.sleep = sleep;
+  key.clock = clock;
+  if (_diff == NULL || !isProtocolSupported(vendor)) return sendState(&key);
+
+  diff_entry_t *last = diffEntry(&key);
+  if (last->used && sameState(&last->state, &key, false) &&
+      (_diff_refresh == 0 || last->sent.elapsed() < _diff_refresh)) {
+    _diff_skipped++;
+    return true;
+  }
+  if (!sendState(&key)) return false;
+  last->state = key;
+  last->used = true;
+  last->sent.reset();
+  return true;
+}
+
+// Send an A/C message, from the cache if it is enabled.
+// Args:
+//   key: The sendAc() arguments.
+// Returns:
+//   boolean: True, if accepted/converted/attempted. False, if unsupported.
+bool IRac::sendState(const stdAc::state_t *key) {
+  // Caching needs to record, so it can't be used if someone else is.
+  if (_cache == NULL || IRsend::isRecording() ||
+      !isProtocolSupported(key->protocol))
+    return sendAcNow(key);
+  if (sendCached(key)) return true;
+
+  // Not cached. Record what it would send, keep that, then send it.
+  uint32_t *timings = new uint32_t[kIrAcCacheMaxTimings];
+  IRsend::record(timings, kIrAcCacheMaxTimings);
+  sendAcNow(key);
+  const uint16_t len = IRsend::stopRecord();
+  if (len == 0) {  // Too long to cache, so just send it.
+    delete[] timings;
+    return sendAcNow(key);
+  }
+  // Replace an unused or the least recently used entry.
+  cache_entry_t *entry = &_cache[0];
+  for (uint8_t i = 0; i < _cache_size && entry->timings != NULL; i++)
+    if (_cache[i].timings == NULL || _cache[i].used < entry->used)
+      entry = &_cache[i];
+  delete[] entry->timings;
+  entry->timings = new uint32_t[len];
+  memcpy(entry->timings, timings, len * sizeof(timings[0]));
+  delete[] timings;
+  entry->key = *key;
+  entry->len = len;
+  entry->hz = IRsend::recordedFreq();
+  entry->duty = IRsend::recordedDuty();
+  return sendCached(key);
+}
+
+// sendAcNow() with the arguments in a stdAc::state_t.
+bool IRac::sendAcNow(const stdAc::state_t *s) {
+  return sendAcNow(s->protocol, s->model, s->power, s->mode, s->degrees,
+                   s->celsius, s->fanspeed, s->swingv, s->swingh, s->quiet,
+                   s->turbo, s->econo, s->light, s->filter, s->clean, s->beep,
+                   s->sleep, s->clock);
+}
+
+// The uncached part of sendAc(). Builds the message & sends it.
+// Args & Returns:
+//   Same as sendAc().
+bool IRac::sendAcNow(const decode_type_t vendor, const int16_t model,
+                     const bool power, const stdAc::opmode_t mode,
+                     const float degrees, const bool celsius,
+                     const stdAc::fanspeed_t fan,
+                     const stdAc::swingv_t swingv,
+                     const stdAc::swingh_t swingh,
+                     const bool quiet, const bool turbo, const bool econo,
+                     const bool light, const bool filter, const bool clean,
+                     const bool beep, const int16_t sleep,
+                     const int16_t clock) {
   // Convert the temperature to Celsius.
   float degC;
   if (celsius)
@@ -7,6 +7,7 @@
 #include <Arduino.h>
 #endif
 #include "IRremoteESP8266.h"
+#include "IRtimer.h"
 #include "ir_Argo.h"
 #include "ir_Coolix.h"
 #include "ir_Daikin.h"
@@ -28,10 +29,22 @@
 #include "ir_Trotec.h"
 #include "ir_Vestel.h"
 #include "ir_Whirlpool.h"
+#ifdef UNIT_TEST
+#include "IRsend_test.h"
+#endif
+
+// Constants
+// Nr. of A/C messages IRac can keep the timings of. See enableCache().
+const uint8_t kIrAcCacheEntries = 4;
+// The most timings (marks + spaces) an A/C message can have to be cached.
+const uint16_t kIrAcCacheMaxTimings = 1024;
+// Nr. of (vendor, model)s IRac remembers the last state of. See enableDiff().
+const uint8_t kIrAcDiffEntries = 4;
 
 class IRac {
  public:
   explicit IRac(uint8_t pin);
+  ~IRac(void);
   static bool isProtocolSupported(const decode_type_t protocol);
   bool sendAc(const decode_type_t vendor, const int16_t model,
               const bool power, const stdAc::opmode_t mode, const float degrees,
@@ -41,6 +54,13 @@ class IRac {
               const bool light, const bool filter, const bool clean,
               const bool beep, const int16_t sleep = -1,
               const int16_t clock = -1);
+  void enableCache(const uint8_t entries = kIrAcCacheEntries);
+  void disableCache(void);
+  void enableDiff(const uint32_t refresh_ms = 0,
+                  const uint8_t entries = kIrAcDiffEntries);
+  void disableDiff(void);
+  void resetDiff(void);
+  uint32_t skippedSends(void);
 
   static bool strToBool(const char *str, const bool def = false);
   static int16_t strToModel(const char *str, const int16_t def = -1);
@@ -63,6 +83,47 @@ class IRac {
  private:
 #endif
   uint8_t _pin;
+  // A cached A/C message: the sendAc() arguments, and what they sent.
+  typedef struct {
+    stdAc::state_t key;
+    uint32_t *timings;  // NULL if the entry is unused.
+    uint16_t len;
+    uint32_t hz;
+    uint8_t duty;
+    uint32_t used;      // When it was last used. Higher is more recent.
+  } cache_entry_t;
+  cache_entry_t *_cache;
+  uint8_t _cache_size;
+  uint32_t _cache_clock;
+  // The last state sent to a (vendor, model).
+  typedef struct {
+    stdAc::state_t state;
+    TimerMs sent;      // Since it was sent.
+    bool used;
+  } diff_entry_t;
+  diff_entry_t *_diff;
+  uint8_t _diff_size;
+  uint32_t _diff_refresh;  // mSeconds. 0 means never.
+  uint32_t _diff_skipped;
+#ifndef UNIT_TEST
+  IRsend _irsend;
+#else
+  IRsendTest _irsend;
+#endif
+  static bool sameState(const stdAc::state_t *a, const stdAc::state_t *b,
+                        const bool clock = true);
+  diff_entry_t *diffEntry(const stdAc::state_t *key);
+  bool sendCached(const stdAc::state_t *key);
+  bool sendState(const stdAc::state_t *key);
+  bool sendAcNow(const stdAc::state_t *s);
+  bool sendAcNow(const decode_type_t vendor, const int16_t model,
+                 const bool power, const stdAc::opmode_t mode,
+                 const float degrees, const bool celsius,
+                 const stdAc::fanspeed_t fan,
+                 const stdAc::swingv_t swingv, const stdAc::swingh_t swingh,
+                 const bool quiet, const bool turbo, const bool econo,
+                 const bool light, const bool filter, const bool clean,
+                 const bool beep, const int16_t sleep, const int16_t clock);
 #if SEND_ARGO
   void argo(IRArgoAC *ac,
             const bool on, const stdAc::opmode_t mode, const float degrees,
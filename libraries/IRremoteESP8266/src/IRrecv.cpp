@@ -30,6 +30,9 @@ extern "C" {
 #if defined(ESP32)
 #define USE_IRAM_ATTR IRAM_ATTR
 #endif  // ESP32
+#ifndef USE_IRAM_ATTR
+#define USE_IRAM_ATTR
+#endif  // USE_IRAM_ATTR
 #endif  // USE_IRAM_ATTR
 
 #define ONCE 0
@@ -55,7 +58,113 @@ static hw_timer_t * timer = NULL;
 portMUX_TYPE irremote_mux = portMUX_INITIALIZER_UNLOCKED;
 #endif  // ESP32
 volatile irparams_t irparams;
-irparams_t *irparams_save;  // A copy of the interrupt state while decoding.
+
+// Double buffering, when the IRrecv was made with save_buffer. A finished
+// capture is handed over by swapping irparams.rawbuf with spare_rawbuf, so
+// the interrupt can start on the next message at once and nothing is copied.
+static volatile uint8_t spare_state = kSpareNone;
+static uint16_t * volatile spare_rawbuf = NULL;
+static volatile uint16_t spare_rawlen = 0;
+static volatile uint8_t spare_overflow = false;
+
+#if defined(ESP32)
+#define IR_LOCK() portENTER_CRITICAL(&irremote_mux)
+#define IR_UNLOCK() portEXIT_CRITICAL(&irremote_mux)
+#elif defined(ESP8266) && !defined(UNIT_TEST)
+#define IR_LOCK() noInterrupts()
+#define IR_UNLOCK() interrupts()
+#else
+#define IR_LOCK()
+#define IR_UNLOCK()
+#endif
+
+// Pre-classification for decode(). Most decoders give up straight away unless
+// the first mark is their header (or leading bit) mark, so decode() first
+// works out which of those the capture's first mark could be, and skips the
+// rest. Decoders without a fixed leading mark are always tried.
+enum lead_t {
+  kLeadArgo = 0, kLeadCarrierAc, kLeadCoolix, kLeadDaikin2, kLeadDaikin216,
+  kLeadDaikin160, kLeadDenon, kLeadElectraAc, kLeadFujitsuAc, kLeadGicable,
+  kLeadGoodweather, kLeadGree, kLeadHaierAc, kLeadHitachiAc, kLeadInax,
+  kLeadKelvinator, kLeadLegoPf, kLeadMidea, kLeadMitsubishi, kLeadMitsubishi2,
+  kLeadMitsubishiHeavy, kLeadNec, kLeadNikai, kLeadPanasonic, kLeadRc6,
+  kLeadRcmm, kLeadSamsung, kLeadSamsungAc, kLeadSharp, kLeadSharpAc, kLeadSony,
+  kLeadTcl112Ac, kLeadTeco, kLeadToshibaAc, kLeadTrotec, kLeadVestelAc,
+  kLeadWhirlpoolAc, kLeadWhynter,
+  kLeadAny = 0xFF,  // Decoders that don't need a particular first mark.
+};
+
+#define IR_LEAD_BIT(lead) (1ULL << (lead))
+
+// The windows are much wider than any decoder's own match (up to 40%
+// tolerance and kMarkExcess), so this never rules out a capture that the
+// decoder would have accepted.
+#define IR_LEAD(lead, usecs) \
+    {lead, (usecs) * 55 / 100, ((usecs) + 100) * 3 / 2}
+
+struct lead_window_t {
+  uint8_t lead;
+  uint16_t low;   // uSeconds.
+  uint16_t high;  // uSeconds.
+};
+
+// Nominal first mark, in uSeconds, of each of the above.
+static const lead_window_t kLeadWindows[] = {
+    IR_LEAD(kLeadArgo, 6400),
+    IR_LEAD(kLeadCarrierAc, 8532),
+    IR_LEAD(kLeadCoolix, 4480),
+    IR_LEAD(kLeadDaikin2, 10024),
+    IR_LEAD(kLeadDaikin216, 3440),
+    IR_LEAD(kLeadDaikin160, 5000),
+    IR_LEAD(kLeadDenon, 263),  // Also its Sharp format.
+    IR_LEAD(kLeadDenon, 3456),  // Its Panasonic format.
+    IR_LEAD(kLeadElectraAc, 9166),
+    IR_LEAD(kLeadFujitsuAc, 3324),
+    IR_LEAD(kLeadGicable, 9000),
+    IR_LEAD(kLeadGoodweather, 6800),
+    IR_LEAD(kLeadGree, 9000),
+    IR_LEAD(kLeadHaierAc, 3000),
+    IR_LEAD(kLeadHitachiAc, 3300),
+    IR_LEAD(kLeadHitachiAc, 3400),  // HitachiAc1
+    IR_LEAD(kLeadInax, 9000),
+    IR_LEAD(kLeadKelvinator, 9010),
+    IR_LEAD(kLeadLegoPf, 158),
+    IR_LEAD(kLeadMidea, 4480),
+    IR_LEAD(kLeadMitsubishi, 300),
+    IR_LEAD(kLeadMitsubishi2, 8400),
+    IR_LEAD(kLeadMitsubishiHeavy, 3140),
+    IR_LEAD(kLeadNec, 8960),  // Also Aiwa, Sanyo LC7461 & Pioneer.
+    IR_LEAD(kLeadNikai, 4000),
+    IR_LEAD(kLeadPanasonic, 3456),
+    IR_LEAD(kLeadRc6, 2664),
+    IR_LEAD(kLeadRcmm, 416),
+    IR_LEAD(kLeadSamsung, 4480),
+    IR_LEAD(kLeadSamsungAc, 586),
+    IR_LEAD(kLeadSharp, 260),
+    IR_LEAD(kLeadSharpAc, 3800),
+    IR_LEAD(kLeadSony, 2400),
+    IR_LEAD(kLeadTcl112Ac, 3000),
+    IR_LEAD(kLeadTeco, 9000),
+    IR_LEAD(kLeadToshibaAc, 4400),
+    IR_LEAD(kLeadTrotec, 5952),
+    IR_LEAD(kLeadVestelAc, 3110),
+    IR_LEAD(kLeadWhirlpoolAc, 8950),
+    IR_LEAD(kLeadWhynter, 750),
+};
+
+// Moves the stopped capture to the spare buffer and rearms the capture with
+// the old spare. Only call it with interrupts locked and the spare free.
+static void USE_IRAM_ATTR handOver(void) {
+  uint16_t *full = irparams.rawbuf;
+  irparams.rawbuf = spare_rawbuf;
+  spare_rawbuf = full;
+  spare_rawlen = irparams.rawlen;
+  spare_overflow = irparams.overflow;
+  spare_state = kSpareReady;
+  irparams.rawlen = 0;
+  irparams.overflow = false;
+  irparams.rcvstate = kIdleState;
+}
 
 #ifndef UNIT_TEST
 #if defined(ESP8266)
@@ -66,7 +175,10 @@ static void USE_IRAM_ATTR read_timeout(void *arg __attribute__((unused))) {
 static void USE_IRAM_ATTR read_timeout(void) {
   portENTER_CRITICAL(&irremote_mux);
 #endif  // ESP32
-  if (irparams.rawlen) irparams.rcvstate = kStopState;
+  if (irparams.rawlen) {
+    irparams.rcvstate = kStopState;
+    if (spare_state == kSpareFree) handOver();
+  }
 #if defined(ESP8266)
   os_intr_unlock();
 #endif  // ESP8266
@@ -161,11 +273,11 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
 #endif
   }
   // If we have been asked to use a save buffer (for decoding), then create one.
+  // The interrupt and decode() take turns with it and irparams.rawbuf.
   if (save_buffer) {
-    irparams_save = new irparams_t;
-    irparams_save->rawbuf = new uint16_t[bufsize];
+    spare_rawbuf = new uint16_t[bufsize];
     // Check we allocated the memory successfully.
-    if (irparams_save->rawbuf == NULL) {
+    if (spare_rawbuf == NULL) {
       DPRINTLN(
           "Could not allocate memory for the second IR buffer.\n"
           "Try a smaller size for CAPTURE_BUFFER_SIZE.\nRebooting!");
@@ -173,20 +285,28 @@ IRrecv::IRrecv(const uint16_t recvpin, const uint16_t bufsize,
       ESP.restart();  // Mem alloc failure. Reboot.
 #endif
     }
+    spare_state = kSpareFree;
   } else {
-    irparams_save = NULL;
+    spare_state = kSpareNone;
   }
 #if DECODE_HASH
   _unknown_threshold = kUnknownThreshold;
 #endif  // DECODE_HASH
+#ifdef UNIT_TEST
+  _attempts = 0;
+#endif  // UNIT_TEST
 }
 
 // Class destructor
 IRrecv::~IRrecv(void) {
+  IR_LOCK();
+  bool double_buffered = (spare_state != kSpareNone);
+  spare_state = kSpareNone;
+  IR_UNLOCK();
   delete[] irparams.rawbuf;
-  if (irparams_save != NULL) {
-    delete[] irparams_save->rawbuf;
-    delete irparams_save;
+  if (double_buffered) {
+    delete[] spare_rawbuf;  // Whichever of the two buffers it is now.
+    spare_rawbuf = NULL;
   }
   disableIRIn();
 #if defined(ESP32)
@@ -206,7 +326,8 @@ void IRrecv::enableIRIn(void) {
 #endif  // ESP32
 
   // Initialize state machine variables
-  resume();
+  if (spare_state != kSpareNone) spare_state = kSpareFree;
+  rearm();
 
 #ifndef UNIT_TEST
 #if defined(ESP8266)
@@ -232,7 +353,20 @@ void IRrecv::disableIRIn(void) {
 #endif  // UNIT_TEST
 }
 
+// With double buffering this only releases the last message handed out by
+// decode(), as any capture in progress is already going into the other buffer.
 void IRrecv::resume(void) {
+  if (spare_state != kSpareNone) {
+    IR_LOCK();
+    if (spare_state == kSpareInUse) spare_state = kSpareFree;
+    IR_UNLOCK();
+    return;
+  }
+  rearm();
+}
+
+// Start capturing a new message into irparams.rawbuf.
+void IRrecv::rearm(void) {
   irparams.rcvstate = kIdleState;
   irparams.rawlen = 0;
   irparams.overflow = false;
@@ -270,6 +404,56 @@ void IRrecv::copyIrParams(volatile irparams_t *src, irparams_t *dst) {
   for (uint16_t i = 0; i < dst->bufsize; i++) dst->rawbuf[i] = src->rawbuf[i];
 }
 
+// Double buffering: gets the next finished capture into the spare buffer and
+// marks it as in use by the caller. The one handed out last time is released
+// first. A capture that stopped because the spare was still in use is handed
+// over now.
+// Returns:
+//   A boolean indicating if a capture is in the spare buffer for the caller.
+bool IRrecv::takeCapture(void) {
+  IR_LOCK();
+  if (spare_state == kSpareInUse) spare_state = kSpareFree;
+  if (spare_state == kSpareFree && irparams.rcvstate == kStopState)
+    handOver();
+  bool ready = (spare_state == kSpareReady);
+  if (ready) spare_state = kSpareInUse;
+  IR_UNLOCK();
+  return ready;
+}
+
+// Work out which header-gated decoders could match a capture, going by its
+// first mark. See kLeadWindows.
+// Args:
+//   results: A pointer to the capture.
+// Returns:
+//   A bit mask of the lead_t's that the first mark fits. All bits are set if
+//   there is no first mark to go by.
+uint64_t IRrecv::leadCandidates(const decode_results *results) {
+  if (results->rawlen <= kStartOffset) return UINT64_MAX;
+  uint32_t usecs = results->rawbuf[kStartOffset] * kRawTick;
+  uint64_t candidates = 0;
+  for (uint8_t i = 0; i < sizeof(kLeadWindows) / sizeof(kLeadWindows[0]);
+       i++)
+    if (usecs >= kLeadWindows[i].low && usecs <= kLeadWindows[i].high)
+      candidates |= IR_LEAD_BIT(kLeadWindows[i].lead);
+  return candidates;
+}
+
+// One step of decode(): whether to try a decoder, given the candidates from
+// leadCandidates(). Unit tests count the decoders tried.
+// Args:
+//   candidates: The result of leadCandidates().
+//   lead: The lead_t the decoder needs, or kLeadAny.
+// Returns:
+//   A boolean indicating if the decoder should be tried.
+inline bool IRrecv::attempt(const uint64_t candidates, const uint8_t lead) {
+  if (lead != kLeadAny && !(candidates & IR_LEAD_BIT(lead))) return false;
+#ifdef UNIT_TEST
+  _attempts++;
+#endif  // UNIT_TEST
+  return true;
+}
+
 // Obtain the maximum number of entries possible in the capture buffer.
 // i.e. It's size.
 uint16_t IRrecv::getBufSize(void) { return irparams.bufsize; }
@@ -286,6 +470,9 @@ void IRrecv::setUnknownThreshold(const uint16_t length) {
 // for the next IR message to avoid missing messages.
 // Note: There is a trade-off here. Saving the state means less time lost until
 // we can receiving the next message vs. using more RAM. Choose appropriately.
+// With save_buffer set in the constructor, nothing is saved or copied: the
+// interrupt swaps to the second buffer itself as each message ends, and
+// results->rawbuf stays valid until the next call to decode() or resume().
 //
 // Args:
 //   results:  A pointer to where the decoded IR message will be stored.
@@ -294,41 +481,51 @@ void IRrecv::setUnknownThreshold(const uint16_t length) {
 // Returns:
 //   A boolean indicating if an IR message is ready or not.
 bool IRrecv::decode(decode_results *results, irparams_t *save) {
-  // Proceed only if an IR message been received.
+  bool resumed = false;  // Flag indicating if we have resumed.
+
+  if (save == NULL && spare_state != kSpareNone) {
+    // Double buffered. The capture is in the spare buffer, where the
+    // interrupt won't touch it until the next decode() or resume(), and the
+    // interrupt is already capturing into the other one.
+    if (!takeCapture()) return false;
+    // Clear the entry after the last one, as below.
+    if (spare_rawlen < irparams.bufsize) spare_rawbuf[spare_rawlen] = 0;
+    results->rawbuf = spare_rawbuf;
+    results->rawlen = spare_rawlen;
+    results->overflow = spare_overflow;
+    resumed = true;
+  } else {
+    // Proceed only if an IR message been received.
 #ifndef UNIT_TEST
-  if (irparams.rcvstate != kStopState) return false;
+    if (irparams.rcvstate != kStopState) return false;
 #endif
 
-  // Clear the entry we are currently pointing to when we got the timeout.
-  // i.e. Stopped collecting IR data.
-  // It's junk as we never wrote an entry to it and can only confuse decoding.
-  // This is done here rather than logically the best place in read_timeout()
-  // as it saves a few bytes of ICACHE_RAM as that routine is bound to an
-  // interrupt. decode() is not stored in ICACHE_RAM.
-  // Another better option would be to zero the entire irparams.rawbuf[] on
-  // resume() but that is a much more expensive operation compare to this.
-  irparams.rawbuf[irparams.rawlen] = 0;
-
-  bool resumed = false;  // Flag indicating if we have resumed.
-
-  // If we were requested to use a save buffer previously, do so.
-  if (save == NULL) save = irparams_save;
+    // Clear the entry we are currently pointing to when we got the timeout.
+    // i.e. Stopped collecting IR data.
+    // It's junk as we never wrote an entry to it and can only confuse decoding.
+    // This is done here rather than logically the best place in read_timeout()
+    // as it saves a few bytes of ICACHE_RAM as that routine is bound to an
+    // interrupt. decode() is not stored in ICACHE_RAM.
+    // Another better option would be to zero the entire irparams.rawbuf[] on
+    // resume() but that is a much more expensive operation compare to this.
+    irparams.rawbuf[irparams.rawlen] = 0;
 
-  if (save == NULL) {
-    // We haven't been asked to copy it so use the existing memory.
+    if (save == NULL) {
+      // We haven't been asked to copy it so use the existing memory.
 #ifndef UNIT_TEST
-    results->rawbuf = irparams.rawbuf;
-    results->rawlen = irparams.rawlen;
-    results->overflow = irparams.overflow;
+      results->rawbuf = irparams.rawbuf;
+      results->rawlen = irparams.rawlen;
+      results->overflow = irparams.overflow;
 #endif
-  } else {
-    copyIrParams(&irparams, save);  // Duplicate the interrupt's memory.
-    resume();  // It's now safe to rearm. The IR message won't be overridden.
-    resumed = true;
-    // Point the results at the saved copy.
-    results->rawbuf = save->rawbuf;
-    results->rawlen = save->rawlen;
-    results->overflow = save->overflow;
+    } else {
+      copyIrParams(&irparams, save);  // Duplicate the interrupt's memory.
+      rearm();  // It's now safe to rearm. The IR message won't be overridden.
+      resumed = true;
+      // Point the results at the saved copy.
+      results->rawbuf = save->rawbuf;
+      results->rawlen = save->rawlen;
+      results->overflow = save->overflow;
+    }
   }
 
   // Reset any previously partially processed results.
@@ -339,12 +536,18 @@ bool IRrecv::decode(decode_results *results, irparams_t *save) {
   results->command = 0;
   results->repeat = false;
 
+  // Which of the decoders that need a particular first mark are worth trying.
+  const uint64_t lead = leadCandidates(results);
+#ifdef UNIT_TEST
+  _attempts = 0;
+#endif  // UNIT_TEST
+
 #if DECODE_AIWA_RC_T501
   DPRINTLN("Attempting Aiwa RC T501 decode");
   // Try decodeAiwaRCT501() before decodeSanyoLC7461() & decodeNEC()
   // because the protocols are similar. This protocol is more specific than
   // those ones, so should got before them.
-  if (decodeAiwaRCT501(results)) return true;
+  if (attempt(lead, kLeadNec) && decodeAiwaRCT501(results)) return true;
 #endif
 #if DECODE_SANYO
   DPRINTLN("Attempting Sanyo LC7461 decode");
@@ -352,7 +555,7 @@ bool IRrecv::decode(decode_results *results, irparams_t *save) {
   // similar in timings & structure, but the Sanyo one is much longer than the
   // NEC protocol (42 vs 32 bits) so this one should be tried first to try to
   // reduce false detection as a NEC packet.
-  if (decodeSanyoLC7461(results)) return true;
+  if (attempt(lead, kLeadNec) && decodeSanyoLC7461(results)) return true;
 #endif
 #if DECODE_CARRIER_AC
   DPRINTLN("Attempting Carrier AC decode");
@@ -360,7 +563,7 @@ bool IRrecv::decode(decode_results *results, irparams_t *save) {
   // similar in timings & structure, but the Carrier one is much longer than the
   // NEC protocol (3x32 bits vs 1x32 bits) so this one should be tried first to
   // try to reduce false detection as a NEC packet.
-  if (decodeCarrierAC(results)) return true;
+  if (attempt(lead, kLeadCarrierAc) && decodeCarrierAC(results)) return true;
 #endif
 #if DECODE_PIONEER
   DPRINTLN("Attempting Pioneer decode");
@@ -368,131 +571,134 @@ bool IRrecv::decode(decode_results *results, irparams_t *save) {
   // similar in timings & structure, but the Pioneer one is much longer than the
   // NEC protocol (2x32 bits vs 1x32 bits) so this one should be tried first to
   // try to reduce false detection as a NEC packet.
-  if (decodePioneer(results)) return true;
+  if (attempt(lead, kLeadNec) && decodePioneer(results)) return true;
 #endif
 #if DECODE_NEC
   DPRINTLN("Attempting NEC decode");
-  if (decodeNEC(results)) return true;
+  if (attempt(lead, kLeadNec) && decodeNEC(results)) return true;
 #endif
 #if DECODE_SONY
   DPRINTLN("Attempting Sony decode");
-  if (decodeSony(results)) return true;
+  if (attempt(lead, kLeadSony) && decodeSony(results)) return true;
 #endif
 #if DECODE_MITSUBISHI
   DPRINTLN("Attempting Mitsubishi decode");
-  if (decodeMitsubishi(results)) return true;
+  if (attempt(lead, kLeadMitsubishi) && decodeMitsubishi(results)) return true;
 #endif
 #if DECODE_MITSUBISHI_AC
   DPRINTLN("Attempting Mitsubishi AC decode");
-  if (decodeMitsubishiAC(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeMitsubishiAC(results)) return true;
 #endif
 #if DECODE_MITSUBISHI2
   DPRINTLN("Attempting Mitsubishi2 decode");
-  if (decodeMitsubishi2(results)) return true;
+  if (attempt(lead, kLeadMitsubishi2) && decodeMitsubishi2(results))
+    return true;
 #endif
 #if DECODE_RC5
   DPRINTLN("Attempting RC5 decode");
-  if (decodeRC5(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeRC5(results)) return true;
 #endif
 #if DECODE_RC6
   DPRINTLN("Attempting RC6 decode");
-  if (decodeRC6(results)) return true;
+  if (attempt(lead, kLeadRc6) && decodeRC6(results)) return true;
 #endif
 #if DECODE_RCMM
   DPRINTLN("Attempting RC-MM decode");
-  if (decodeRCMM(results)) return true;
+  if (attempt(lead, kLeadRcmm) && decodeRCMM(results)) return true;
 #endif
 #if DECODE_FUJITSU_AC
   // Fujitsu A/C needs to precede Panasonic and Denon as it has a short
   // message which looks exactly the same as a Panasonic/Denon message.
   DPRINTLN("Attempting Fujitsu A/C decode");
-  if (decodeFujitsuAC(results)) return true;
+  if (attempt(lead, kLeadFujitsuAc) && decodeFujitsuAC(results)) return true;
 #endif
 #if DECODE_DENON
   // Denon needs to precede Panasonic as it is a special case of Panasonic.
   DPRINTLN("Attempting Denon decode");
-  if (decodeDenon(results, kDenon48Bits) || decodeDenon(results, kDenonBits) ||
-      decodeDenon(results, kDenonLegacyBits))
+  if (attempt(lead, kLeadDenon) &&
+      (decodeDenon(results, kDenon48Bits) || decodeDenon(results, kDenonBits) ||
+       decodeDenon(results, kDenonLegacyBits)))
     return true;
 #endif
 #if DECODE_PANASONIC
   DPRINTLN("Attempting Panasonic decode");
-  if (decodePanasonic(results)) return true;
+  if (attempt(lead, kLeadPanasonic) && decodePanasonic(results)) return true;
 #endif
 #if DECODE_LG
   DPRINTLN("Attempting LG (28-bit) decode");
-  if (decodeLG(results, kLgBits, true)) return true;
+  if (attempt(lead, kLeadAny) && decodeLG(results, kLgBits, true)) return true;
   DPRINTLN("Attempting LG (32-bit) decode");
   // LG32 should be tried before Samsung
-  if (decodeLG(results, kLg32Bits, true)) return true;
+  if (attempt(lead, kLeadAny) && decodeLG(results, kLg32Bits, true))
+    return true;
 #endif
 #if DECODE_GICABLE
   // Note: Needs to happen before JVC decode, because it looks similar except
   //       with a required NEC-like repeat code.
   DPRINTLN("Attempting GICable decode");
-  if (decodeGICable(results)) return true;
+  if (attempt(lead, kLeadGicable) && decodeGICable(results)) return true;
 #endif
 #if DECODE_JVC
   DPRINTLN("Attempting JVC decode");
-  if (decodeJVC(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeJVC(results)) return true;
 #endif
 #if DECODE_SAMSUNG
   DPRINTLN("Attempting SAMSUNG decode");
-  if (decodeSAMSUNG(results)) return true;
+  if (attempt(lead, kLeadSamsung) && decodeSAMSUNG(results)) return true;
 #endif
 #if DECODE_SAMSUNG36
   DPRINTLN("Attempting Samsung36 decode");
-  if (decodeSamsung36(results)) return true;
+  if (attempt(lead, kLeadSamsung) && decodeSamsung36(results)) return true;
 #endif
 #if DECODE_WHYNTER
   DPRINTLN("Attempting Whynter decode");
-  if (decodeWhynter(results)) return true;
+  if (attempt(lead, kLeadWhynter) && decodeWhynter(results)) return true;
 #endif
 #if DECODE_DISH
   DPRINTLN("Attempting DISH decode");
-  if (decodeDISH(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeDISH(results)) return true;
 #endif
 #if DECODE_SHARP
   DPRINTLN("Attempting Sharp decode");
-  if (decodeSharp(results)) return true;
+  if (attempt(lead, kLeadSharp) && decodeSharp(results)) return true;
 #endif
 #if DECODE_COOLIX
   DPRINTLN("Attempting Coolix decode");
-  if (decodeCOOLIX(results)) return true;
+  if (attempt(lead, kLeadCoolix) && decodeCOOLIX(results)) return true;
 #endif
 #if DECODE_NIKAI
   DPRINTLN("Attempting Nikai decode");
-  if (decodeNikai(results)) return true;
+  if (attempt(lead, kLeadNikai) && decodeNikai(results)) return true;
 #endif
 #if DECODE_KELVINATOR
   // Kelvinator based-devices use a similar code to Gree ones, to avoid false
   // matches this needs to happen before decodeGree().
   DPRINTLN("Attempting Kelvinator decode");
-  if (decodeKelvinator(results)) return true;
+  if (attempt(lead, kLeadKelvinator) && decodeKelvinator(results)) return true;
 #endif
 #if DECODE_DAIKIN
   DPRINTLN("Attempting Daikin decode");
-  if (decodeDaikin(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeDaikin(results)) return true;
 #endif
 #if DECODE_DAIKIN2
   DPRINTLN("Attempting Daikin2 decode");
-  if (decodeDaikin2(results)) return true;
+  if (attempt(lead, kLeadDaikin2) && decodeDaikin2(results)) return true;
 #endif
 #if DECODE_DAIKIN216
   DPRINTLN("Attempting Daikin216 decode");
-  if (decodeDaikin216(results)) return true;
+  if (attempt(lead, kLeadDaikin216) && decodeDaikin216(results)) return true;
 #endif
 #if DECODE_TOSHIBA_AC
   DPRINTLN("Attempting Toshiba AC decode");
-  if (decodeToshibaAC(results)) return true;
+  if (attempt(lead, kLeadToshibaAc) && decodeToshibaAC(results)) return true;
 #endif
 #if DECODE_MIDEA
   DPRINTLN("Attempting Midea decode");
-  if (decodeMidea(results)) return true;
+  if (attempt(lead, kLeadMidea) && decodeMidea(results)) return true;
 #endif
 #if DECODE_MAGIQUEST
   DPRINTLN("Attempting Magiquest decode");
-  if (decodeMagiQuest(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeMagiQuest(results)) return true;
 #endif
 /* NOTE: Disabled due to poor quality.
 #if DECODE_SANYO
@@ -511,123 +717,139 @@ bool IRrecv::decode(decode_results *results, irparams_t *save) {
   // other protocols that are NEC-like as well, as turning off strict may
   // cause this to match other valid protocols.
   DPRINTLN("Attempting NEC (non-strict) decode");
-  if (decodeNEC(results, kNECBits, false)) {
+  if (attempt(lead, kLeadNec) && decodeNEC(results, kNECBits, false)) {
     results->decode_type = NEC_LIKE;
     return true;
   }
 #endif
 #if DECODE_LASERTAG
   DPRINTLN("Attempting Lasertag decode");
-  if (decodeLasertag(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeLasertag(results)) return true;
 #endif
 #if DECODE_GREE
   // Gree based-devices use a similar code to Kelvinator ones, to avoid false
   // matches this needs to happen after decodeKelvinator().
   DPRINTLN("Attempting Gree decode");
-  if (decodeGree(results)) return true;
+  if (attempt(lead, kLeadGree) && decodeGree(results)) return true;
 #endif
 #if DECODE_HAIER_AC
   DPRINTLN("Attempting Haier AC decode");
-  if (decodeHaierAC(results)) return true;
+  if (attempt(lead, kLeadHaierAc) && decodeHaierAC(results)) return true;
 #endif
 #if DECODE_HAIER_AC_YRW02
   DPRINTLN("Attempting Haier AC YR-W02 decode");
-  if (decodeHaierACYRW02(results)) return true;
+  if (attempt(lead, kLeadHaierAc) && decodeHaierACYRW02(results)) return true;
 #endif
 #if DECODE_HITACHI_AC2
   // HitachiAC2 should be checked before HitachiAC
   DPRINTLN("Attempting Hitachi AC2 decode");
-  if (decodeHitachiAC(results, kHitachiAc2Bits)) return true;
+  if (attempt(lead, kLeadHitachiAc) &&
+      decodeHitachiAC(results, kHitachiAc2Bits))
+    return true;
 #endif
 #if DECODE_HITACHI_AC
   DPRINTLN("Attempting Hitachi AC decode");
-  if (decodeHitachiAC(results, kHitachiAcBits)) return true;
+  if (attempt(lead, kLeadHitachiAc) && decodeHitachiAC(results, kHitachiAcBits))
+    return true;
 #endif
 #if DECODE_HITACHI_AC1
   DPRINTLN("Attempting Hitachi AC1 decode");
-  if (decodeHitachiAC(results, kHitachiAc1Bits)) return true;
+  if (attempt(lead, kLeadHitachiAc) &&
+      decodeHitachiAC(results, kHitachiAc1Bits))
+    return true;
 #endif
 #if DECODE_WHIRLPOOL_AC
   DPRINTLN("Attempting Whirlpool AC decode");
-  if (decodeWhirlpoolAC(results)) return true;
+  if (attempt(lead, kLeadWhirlpoolAc) && decodeWhirlpoolAC(results))
+    return true;
 #endif
 #if DECODE_SAMSUNG_AC
   DPRINTLN("Attempting Samsung AC (extended) decode");
   // Check the extended size first, as it should fail fast due to longer length.
-  if (decodeSamsungAC(results, kSamsungAcExtendedBits, false)) return true;
+  if (attempt(lead, kLeadSamsungAc) &&
+      decodeSamsungAC(results, kSamsungAcExtendedBits, false))
+    return true;
   // Now check for the more common length.
   DPRINTLN("Attempting Samsung AC decode");
-  if (decodeSamsungAC(results, kSamsungAcBits)) return true;
+  if (attempt(lead, kLeadSamsungAc) && decodeSamsungAC(results, kSamsungAcBits))
+    return true;
 #endif
 #if DECODE_ELECTRA_AC
   DPRINTLN("Attempting Electra AC decode");
-  if (decodeElectraAC(results)) return true;
+  if (attempt(lead, kLeadElectraAc) && decodeElectraAC(results)) return true;
 #endif
 #if DECODE_PANASONIC_AC
   DPRINTLN("Attempting Panasonic AC decode");
-  if (decodePanasonicAC(results)) return true;
+  if (attempt(lead, kLeadPanasonic) && decodePanasonicAC(results)) return true;
   DPRINTLN("Attempting Panasonic AC short decode");
-  if (decodePanasonicAC(results, kPanasonicAcShortBits)) return true;
+  if (attempt(lead, kLeadPanasonic) &&
+      decodePanasonicAC(results, kPanasonicAcShortBits))
+    return true;
 #endif
 #if DECODE_LUTRON
   DPRINTLN("Attempting Lutron decode");
-  if (decodeLutron(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeLutron(results)) return true;
 #endif
 #if DECODE_MWM
   DPRINTLN("Attempting MWM decode");
-  if (decodeMWM(results)) return true;
+  if (attempt(lead, kLeadAny) && decodeMWM(results)) return true;
 #endif
 #if DECODE_VESTEL_AC
   DPRINTLN("Attempting Vestel AC decode");
-  if (decodeVestelAc(results)) return true;
+  if (attempt(lead, kLeadVestelAc) && decodeVestelAc(results)) return true;
 #endif
 #if DECODE_TCL112AC
   DPRINTLN("Attempting TCL112AC decode");
-  if (decodeTcl112Ac(results)) return true;
+  if (attempt(lead, kLeadTcl112Ac) && decodeTcl112Ac(results)) return true;
 #endif
 #if DECODE_TECO
   DPRINTLN("Attempting Teco decode");
-  if (decodeTeco(results)) return true;
+  if (attempt(lead, kLeadTeco) && decodeTeco(results)) return true;
 #endif
 #if DECODE_LEGOPF
   DPRINTLN("Attempting LEGOPF decode");
-  if (decodeLegoPf(results)) return true;
+  if (attempt(lead, kLeadLegoPf) && decodeLegoPf(results)) return true;
 #endif
 #if DECODE_MITSUBISHIHEAVY
   DPRINTLN("Attempting MITSUBISHIHEAVY (152 bit) decode");
-  if (decodeMitsubishiHeavy(results, kMitsubishiHeavy152Bits)) return true;
+  if (attempt(lead, kLeadMitsubishiHeavy) &&
+      decodeMitsubishiHeavy(results, kMitsubishiHeavy152Bits))
+    return true;
   DPRINTLN("Attempting MITSUBISHIHEAVY (88 bit) decode");
-  if (decodeMitsubishiHeavy(results, kMitsubishiHeavy88Bits)) return true;
+  if (attempt(lead, kLeadMitsubishiHeavy) &&
+      decodeMitsubishiHeavy(results, kMitsubishiHeavy88Bits))
+    return true;
 #endif
 #if DECODE_ARGO
   DPRINTLN("Attempting Argo decode");
-  if (decodeArgo(results)) return true;
+  if (attempt(lead, kLeadArgo) && decodeArgo(results)) return true;
 #endif  // DECODE_ARGO
 #if DECODE_SHARP_AC
   DPRINTLN("Attempting SHARP_AC decode");
-  if (decodeSharpAc(results)) return true;
+  if (attempt(lead, kLeadSharpAc) && decodeSharpAc(results)) return true;
 #endif
 #if DECODE_GOODWEATHER
   DPRINTLN("Attempting GOODWEATHER decode");
-  if (decodeGoodweather(results)) return true;
+  if (attempt(lead, kLeadGoodweather) && decodeGoodweather(results))
+    return true;
 #endif  // DECODE_GOODWEATHER
 #if DECODE_INAX
   DPRINTLN("Attempting Inax decode");
-  if (decodeInax(results)) return true;
+  if (attempt(lead, kLeadInax) && decodeInax(results)) return true;
 #endif  // DECODE_INAX
 #if DECODE_TROTEC
   DPRINTLN("Attempting Trotec decode");
-  if (decodeTrotec(results)) return true;
+  if (attempt(lead, kLeadTrotec) && decodeTrotec(results)) return true;
 #endif  // DECODE_TROTEC
 #if DECODE_DAIKIN160
   DPRINTLN("Attempting Daikin160 decode");
-  if (decodeDaikin160(results)) return true;
+  if (attempt(lead, kLeadDaikin160) && decodeDaikin160(results)) return true;
 #endif  // DECODE_DAIKIN160
 #if DECODE_HASH
   // decodeHash returns a hash on any input.
   // Thus, it needs to be last in the list.
   // If you add any decodes, add them before this.
-  if (decodeHash(results)) {
+  if (attempt(lead, kLeadAny) && decodeHash(results)) {
     return true;
   }
 #endif  // DECODE_HASH
@@ -32,6 +32,11 @@ const uint8_t kIdleState = 2;
 const uint8_t kMarkState = 3;
 const uint8_t kSpaceState = 4;
 const uint8_t kStopState = 5;
+// States of the spare buffer, when double buffering.
+const uint8_t kSpareNone = 0;   // Not double buffering.
+const uint8_t kSpareFree = 1;   // Available to the interrupt.
+const uint8_t kSpareReady = 2;  // Holds a capture not yet given to decode().
+const uint8_t kSpareInUse = 3;  // Holds the capture decode() last returned.
 const uint8_t kTolerance = 25;  // default percent tolerance in measurements.
 const uint16_t kRawTick = 2;    // Capture tick to uSec factor.
 #define RAWTICK kRawTick  // Deprecated. For legacy user code support only.
@@ -142,13 +147,19 @@ class IRrecv {
 
  private:
 #endif
-  irparams_t *irparams_save;
   uint8_t _timer_num;
 #if DECODE_HASH
   uint16_t _unknown_threshold;
 #endif
   // These are called by decode
   void copyIrParams(volatile irparams_t *src, irparams_t *dst);
+  bool takeCapture(void);
+  void rearm(void);
+  static uint64_t leadCandidates(const decode_results *results);
+  bool attempt(const uint64_t candidates, const uint8_t lead);
+#ifdef UNIT_TEST
+  uint16_t _attempts;  // Nr. of decoders the last decode() tried.
+#endif  // UNIT_TEST
   int16_t compare(uint16_t oldval, uint16_t newval);
   static uint32_t ticksLow(uint32_t usecs, uint8_t tolerance = kTolerance,
                            uint16_t delta = 0);
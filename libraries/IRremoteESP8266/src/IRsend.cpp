@@ -9,11 +9,15 @@
 #define __STDC_LIMIT_MACROS
 #include <stdint.h>
 #endif
+#include <string.h>
 #include <algorithm>
 #ifdef UNIT_TEST
 #include <cmath>
 #endif
 #include "IRtimer.h"
+#if IRSEND_BACKGROUND
+#include <core_esp8266_waveform.h>
+#endif  // IRSEND_BACKGROUND
 
 // Originally from https://github.com/shirriff/Arduino-IRremote/
 // Updated by markszabo (https://github.com/markszabo/IRremoteESP8266) for
@@ -60,6 +64,7 @@ void IRsend::begin() {
 
 // Turn off the IR LED.
 void IRsend::ledOff() {
+  if (_recording) return;  // A playback() may be using the pin.
 #ifndef UNIT_TEST
   digitalWrite(IRpin, outputOff);
 #endif
@@ -67,6 +72,7 @@ void IRsend::ledOff() {
 
 // Turn on the IR LED.
 void IRsend::ledOn() {
+  if (_recording) return;
 #ifndef UNIT_TEST
   digitalWrite(IRpin, outputOn);
 #endif
@@ -113,6 +119,10 @@ void IRsend::enableIROut(uint32_t freq, uint8_t duty) {
 #ifdef UNIT_TEST
   _freq_unittest = freq;
 #endif  // UNIT_TEST
+  if (_recording) {
+    _timings_hz = freq;
+    _timings_duty = _dutycycle;
+  }
   uint32_t period = calcUSecPeriod(freq);
   // Nr. of uSeconds the LED will be on per pulse.
   onTimePeriod = (period * _dutycycle) / kDutyMax;
@@ -174,6 +184,10 @@ void IRsend::_delayMicroseconds(uint32_t usec) {
 // Ref:
 //   https://www.analysir.com/blog/2017/01/29/updated-esp8266-nodemcu-backdoor-upwm-hack-for-ir-signals/
 uint16_t IRsend::mark(uint16_t usec) {
+  if (_recording) {
+    recordTiming(usec, false);
+    return 1;
+  }
   // Handle the simple case of no required frequency modulation.
   if (!modulation || _dutycycle >= 100) {
     ledOn();
@@ -213,6 +227,10 @@ uint16_t IRsend::mark(uint16_t usec) {
 // Args:
 //   time: Time in microseconds (us).
 void IRsend::space(uint32_t time) {
+  if (_recording) {
+    recordTiming(time, true);
+    return;
+  }
   ledOff();
   if (time == 0) return;
   _delayMicroseconds(time);
@@ -491,6 +509,300 @@ void IRsend::sendRaw(uint16_t buf[], uint16_t len, uint16_t hz) {
 }
 #endif  // SEND_RAW
 
+// Background sending -----------------------------------------------------------
+// mark() & space() normally block for as long as the message takes to send,
+// which for a long A/C message is well over 100ms. Instead, a message can be
+// recorded as a list of timings first, then handed to playback(), which
+// returns straight away and sends it from the timer1 interrupt.
+//
+// e.g.
+//   uint32_t timings[kDaikinStateLength * 8 * 2 + 16];
+//   irsend.record(timings, sizeof(timings) / sizeof(timings[0]));
+//   irsend.sendDaikin(state);
+//   irsend.stopRecord();
+//   irsend.playback(callback);
+
+uint32_t *IRsend::_timings = NULL;
+uint16_t IRsend::_timings_size = 0;
+uint16_t IRsend::_timings_len = 0;
+uint32_t IRsend::_timings_hz = 38000;
+uint8_t IRsend::_timings_duty = kDutyDefault;
+bool IRsend::_recording = false;
+bool IRsend::_timings_overflow = false;
+
+// Start recording what the send*() calls of every IRsend object would send,
+// instead of sending it.
+//
+// Args:
+//   timings: Array to record into. Even elements are Mark times (On), Odd
+//            elements are Space times (Off), in uSeconds. i.e. The same
+//            layout as sendRaw(). It must be left alone until playback()
+//            has finished with it.
+//   size:    Nr. of elements in the timings[] array.
+//
+// Note:
+//   A recording has one carrier frequency & duty cycle: the last ones set.
+void IRsend::record(uint32_t timings[], const uint16_t size) {
+  _timings = timings;
+  _timings_size = size;
+  _timings_len = 0;
+  _timings_overflow = false;
+  _recording = true;
+}
+
+// Stop recording. Further send*() calls send as normal again.
+//
+// Returns:
+//   The nr. of timings recorded, or 0 if they didn't fit in the array.
+uint16_t IRsend::stopRecord(void) {
+  _recording = false;
+  if (_timings_overflow) _timings_len = 0;
+  return _timings_len;
+}
+
+// Is a record() in progress?
+bool IRsend::isRecording(void) { return _recording; }
+
+// The carrier frequency (Hz) of the last recording.
+uint32_t IRsend::recordedFreq(void) { return _timings_hz; }
+
+// The duty cycle (%) of the last recording.
+uint8_t IRsend::recordedDuty(void) { return _timings_duty; }
+
+// Add a mark or space to the recording, merging it with the previous one if
+// that was of the same kind.
+//
+// Args:
+//   usec: Nr. of uSeconds.
+//   is_space: Is it a space (true) or a mark (false)?
+void IRsend::recordTiming(const uint32_t usec, const bool is_space) {
+  if (!addTiming(_timings, _timings_size, &_timings_len, usec, is_space))
+    _timings_overflow = true;
+}
+
+// Add a mark or space to a list of timings, merging it with the previous one
+// if that was of the same kind. The list always starts with a mark, even if it
+// is an empty one.
+//
+// Args:
+//   timings: The list. Even elements are Mark times, Odd are Space times.
+//   size:    Nr. of elements in the timings[] array.
+//   len:     Nr. of elements used so far. Updated.
+//   usec:    Nr. of uSeconds.
+//   is_space: Is it a space (true) or a mark (false)?
+// Returns:
+//   False if it didn't fit.
+bool IRsend::addTiming(uint32_t timings[], const uint16_t size, uint16_t *len,
+                       const uint32_t usec, const bool is_space) {
+  if (*len && ((*len - 1) & 1) == is_space) {
+    timings[*len - 1] += usec;
+    return true;
+  }
+  if (is_space && *len == 0 && !addTiming(timings, size, len, 0, false))
+    return false;
+  if (*len >= size) return false;
+  timings[(*len)++] = usec;
+  return true;
+}
+
+// What can come between the numbers of an IR code in text form.
+static const char kWordSeparators[] = " ,\t\r\n";
+
+// Read the next number of an IR code in text form (Pronto, GlobalCache),
+// skipping the white space & commas before it.
+//
+// Args:
+//   str:  Where to read from. Moved past the number.
+//   base: 16 or 10.
+//   word: Where to put the number.
+// Returns:
+//   1 if a number was read, 0 at the end of the text, -1 if the text there
+//   isn't a number in that base, or it doesn't fit in 16 bits.
+int8_t IRsend::parseWord(const char **str, const uint8_t base,
+                         uint16_t *word) {
+  const char *p = *str;
+  while (*p != '\0' && strchr(kWordSeparators, *p) != NULL) p++;
+  if (*p == '\0') {
+    *str = p;
+    return 0;
+  }
+  uint32_t value = 0;
+  const char *start = p;
+  for (;; p++) {
+    uint8_t digit;
+    if (*p >= '0' && *p <= '9')
+      digit = *p - '0';
+    else if (base == 16 && *p >= 'a' && *p <= 'f')
+      digit = *p - 'a' + 10;
+    else if (base == 16 && *p >= 'A' && *p <= 'F')
+      digit = *p - 'A' + 10;
+    else
+      break;
+    value = value * base + digit;
+    if (value > UINT16_MAX) return -1;
+  }
+  if (p == start || (*p != '\0' && strchr(kWordSeparators, *p) == NULL))
+    return -1;
+  *word = value;
+  *str = p;
+  return 1;
+}
+
+#if IRSEND_BACKGROUND
+// State of the playback in progress. Only the timer1 callback changes it
+// while `active` is set.
+static struct {
+  const uint32_t *timings;
+  uint16_t len;
+  uint16_t index;        // The timing after the current one.
+  uint32_t deadline;     // CPU cycle count when the current timing ends.
+  uint32_t edge;         // CPU cycle count of the next carrier edge.
+  uint32_t on_cycles;    // Carrier on time. 0 means no modulation.
+  uint32_t off_cycles;   // Carrier off time.
+  uint8_t pin;
+  uint8_t output_on;
+  uint8_t output_off;
+  bool lit;              // Is the LED on at the moment?
+  bool in_mark;
+  void (*done)(void);
+  volatile bool active;
+  bool hooked;           // Is playbackStep() still set as the timer1 callback?
+} pb;
+
+static inline void ICACHE_RAM_ATTR playbackWrite(const bool lit) {
+  pb.lit = lit;
+  const uint8_t level = lit ? pb.output_on : pb.output_off;
+  if (pb.pin < 16) {
+    if (level)
+      GPOS = 1 << pb.pin;
+    else
+      GPOC = 1 << pb.pin;
+  } else {
+    digitalWrite(pb.pin, level);
+  }
+}
+
+// Called from the waveform (timer1) interrupt, which runs for other reasons
+// too, so everything goes by the CPU cycle count.
+// Returns:
+//   Nr. of CPU cycles until it next needs to be called.
+static uint32_t ICACHE_RAM_ATTR playbackStep(void) {
+  uint32_t now = ESP.getCycleCount();
+  // Move on past every timing that has ended. Deadlines are added up rather
+  // than taken from `now`, so the odd late interrupt doesn't add up to drift.
+  while ((int32_t)(pb.deadline - now) <= 0) {
+    if (pb.index >= pb.len) {
+      // Finished. busy() unhooks us later, outside of the interrupt.
+      if (pb.active) {
+        playbackWrite(false);
+        pb.active = false;
+        if (pb.done != NULL) pb.done();
+      }
+      return microsecondsToClockCycles(kMaxAccurateUsecDelay);
+    }
+    pb.in_mark = !(pb.index & 1);
+    pb.deadline += microsecondsToClockCycles(pb.timings[pb.index++]);
+    playbackWrite(pb.in_mark);
+    pb.edge = now + (pb.in_mark ? pb.on_cycles : 0);
+  }
+  // Carrier modulation during a mark.
+  if (pb.in_mark && pb.on_cycles && (int32_t)(pb.edge - now) <= 0) {
+    playbackWrite(!pb.lit);
+    pb.edge += pb.lit ? pb.on_cycles : pb.off_cycles;
+  }
+  uint32_t next = pb.deadline - now;
+  if (pb.in_mark && pb.on_cycles) next = std::min(next, pb.edge - now);
+  return next;
+}
+#endif  // IRSEND_BACKGROUND
+
+// Send what was recorded, in the background where possible.
+//
+// Args:
+//   done: Optional function to call when it has all been sent.
+//         In the background, it is called from the interrupt, so it should
+//         only set a flag or similar, and must be in ICACHE_RAM.
+//
+// Returns:
+//   False if there is nothing to send or a playback is already in progress.
+//
+// Note:
+//   On the ESP8266 this needs core 2.5.0 or later. It shares the timer1
+//   interrupt with analogWrite()/tone() via setTimer1Callback(), so those
+//   keep working. The carrier is generated in software, like mark() does,
+//   at one interrupt per edge. Elsewhere the timings are sent before
+//   playback() returns.
+bool IRsend::playback(void (*done)(void)) {
+  if (_recording) stopRecord();
+  return playback(_timings, _timings_len, _timings_hz, _timings_duty, done);
+}
+
+// Send a list of timings, in the background where possible.
+// e.g. One kept from an earlier recording.
+//
+// Args:
+//   timings: Even elements are Mark times (On), Odd elements are Space times
+//            (Off), in uSeconds. It must be left alone until it is sent.
+//   len:     Nr. of elements in the timings[] array.
+//   hz:      The carrier frequency.
+//   duty:    The duty cycle (%) of the carrier.
+//   done:    Optional function to call when it has all been sent. See above.
+//
+// Returns:
+//   False if there is nothing to send or a playback is already in progress.
+bool IRsend::playback(const uint32_t timings[], const uint16_t len,
+                      const uint32_t hz, const uint8_t duty,
+                      void (*done)(void)) {
+  if (timings == NULL || len == 0 || _recording || busy()) return false;
+#if IRSEND_BACKGROUND
+  const uint32_t period = calcUSecPeriod(hz, false);
+  const uint8_t duty_used = modulation ? std::min(duty, kDutyMax) : kDutyMax;
+  uint32_t on_usecs = (period * duty_used) / kDutyMax;
+  pb.timings = timings;
+  pb.len = len;
+  pb.index = 0;
+  pb.on_cycles = (duty_used < kDutyMax) ? microsecondsToClockCycles(on_usecs)
+                                        : 0;
+  pb.off_cycles = microsecondsToClockCycles(period - on_usecs);
+  pb.pin = IRpin;
+  pb.output_on = outputOn;
+  pb.output_off = outputOff;
+  pb.in_mark = false;
+  pb.done = done;
+  pb.deadline = ESP.getCycleCount();
+  pb.active = true;
+  pb.hooked = true;
+  setTimer1Callback(playbackStep);
+#else  // IRSEND_BACKGROUND
+  enableIROut(hz, duty);
+  for (uint16_t i = 0; i < len; i++) {
+    if (i & 1) {
+      space(timings[i]);
+    } else {
+      uint32_t usecs = timings[i];
+      for (; usecs > UINT16_MAX; usecs -= UINT16_MAX) mark(UINT16_MAX);
+      mark(usecs);
+    }
+  }
+  if (done != NULL) done();
+#endif  // IRSEND_BACKGROUND
+  return true;
+}
+
+// Is a playback() still sending?
+bool IRsend::busy(void) {
+#if IRSEND_BACKGROUND
+  if (pb.active) return true;
+  if (pb.hooked) {
+    setTimer1Callback(NULL);
+    pb.hooked = false;
+  }
+  return false;
+#else  // IRSEND_BACKGROUND
+  return false;
+#endif  // IRSEND_BACKGROUND
+}
+
 // Send a simple (up to 64 bits) IR message of a given type.
 // An unknown/unsupported type will do nothing.
 // Args:
@@ -40,6 +40,18 @@ const uint16_t kMaxAccurateUsecDelay = 16383;
 //  Usecs to wait between messages we don't know the proper gap time.
 const uint32_t kDefaultMessageGap = 100000;
 
+// On the ESP8266 (core 2.5.0 or later), playback() sends in the background
+// from the timer1 (waveform) interrupt. Elsewhere it falls back to sending
+// the recorded timings with mark() & space() before it returns.
+#if defined(ESP8266) && !defined(UNIT_TEST) && defined(__has_include)
+#if __has_include(<core_esp8266_waveform.h>)
+#define IRSEND_BACKGROUND true
+#endif  // __has_include(<core_esp8266_waveform.h>)
+#endif  // defined(ESP8266) && !defined(UNIT_TEST) && defined(__has_include)
+#ifndef IRSEND_BACKGROUND
+#define IRSEND_BACKGROUND false
+#endif  // IRSEND_BACKGROUND
+
 
 namespace stdAc {
   enum class opmode_t {
@@ -115,6 +127,16 @@ class IRsend {
   VIRTUAL void space(uint32_t usec);
   int8_t calibrate(uint16_t hz = 38000U);
   void sendRaw(uint16_t buf[], uint16_t len, uint16_t hz);
+  static void record(uint32_t timings[], const uint16_t size);
+  static uint16_t stopRecord(void);
+  static bool isRecording(void);
+  static uint32_t recordedFreq(void);
+  static uint8_t recordedDuty(void);
+  bool playback(void (*done)(void) = NULL);
+  bool playback(const uint32_t timings[], const uint16_t len,
+                const uint32_t hz, const uint8_t duty = kDutyDefault,
+                void (*done)(void) = NULL);
+  static bool busy(void);
   void sendData(uint16_t onemark, uint32_t onespace, uint16_t zeromark,
                 uint32_t zerospace, uint64_t data, uint16_t nbits,
                 bool MSBfirst = true);
@@ -293,6 +315,9 @@ class IRsend {
 #endif  // SEND_INAX
 #if SEND_GLOBALCACHE
   void sendGC(uint16_t buf[], uint16_t len);
+  uint16_t parseGC(const char *str, uint32_t timings[], const uint16_t size,
+                   uint32_t *hz);
+  bool sendGC(const char *str, uint32_t timings[], const uint16_t size);
 #endif
 #if SEND_KELVINATOR
   void sendKelvinator(const unsigned char data[],
@@ -336,6 +361,11 @@ class IRsend {
 #endif  // SEND_GOODWEATHER
 #if SEND_PRONTO
   void sendPronto(uint16_t data[], uint16_t len, uint16_t repeat = kNoRepeat);
+  uint16_t parsePronto(const char *str, uint32_t timings[],
+                       const uint16_t size, uint32_t *hz,
+                       uint16_t repeat = kNoRepeat);
+  bool sendPronto(const char *str, uint32_t timings[], const uint16_t size,
+                  const uint16_t repeat = kNoRepeat);
 #endif
 #if SEND_ARGO
   void sendArgo(const unsigned char data[],
@@ -470,11 +500,25 @@ class IRsend {
 #endif  // UNIT_TEST
   uint16_t onTimePeriod;
   uint16_t offTimePeriod;
+  // The recording is shared by all IRsend objects, so it also catches what
+  // the A/C classes send with their own ones.
+  static uint32_t *_timings;  // Recorded marks (even) & spaces (odd).
+  static uint16_t _timings_size;
+  static uint16_t _timings_len;
+  static uint32_t _timings_hz;
+  static uint8_t _timings_duty;
+  static bool _recording;
+  static bool _timings_overflow;
   uint16_t IRpin;
   int8_t periodOffset;
   uint8_t _dutycycle;
   bool modulation;
   uint32_t calcUSecPeriod(uint32_t hz, bool use_offset = true);
+  static void recordTiming(const uint32_t usec, const bool is_space);
+  static bool addTiming(uint32_t timings[], const uint16_t size, uint16_t *len,
+                        const uint32_t usec, const bool is_space);
+  static int8_t parseWord(const char **str, const uint8_t base,
+                          uint16_t *word);
 };
 
 #endif  // IRSEND_H_
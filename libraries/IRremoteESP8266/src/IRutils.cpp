@@ -35,28 +35,100 @@ uint64_t reverseBits(uint64_t input, uint16_t nbits) {
   return (input << nbits) | output;
 }
 
-// Convert a uint64_t (unsigned long long) to a string.
+// Render text into a caller's buffer. The buffer is always NUL terminated.
+// Text that doesn't fit is dropped, but still counted by length().
+//
+// Args:
+//   buf:  The buffer to write to.
+//   size: The size of the buffer in bytes, including the NUL.
+IRtext::IRtext(char *buf, const size_t size) {
+  _buf = buf;
+  _size = size;
+  _str = NULL;
+#ifndef UNIT_TEST
+  _stream = NULL;
+#endif  // UNIT_TEST
+  _len = 0;
+  if (_size) _buf[0] = '\0';
+}
+
+// Render text onto the end of a String. (Uses the heap, as Strings do.)
+IRtext::IRtext(String *str) {
+  _buf = NULL;
+  _size = 0;
+  _str = str;
+#ifndef UNIT_TEST
+  _stream = NULL;
+#endif  // UNIT_TEST
+  _len = 0;
+}
+
+#ifndef UNIT_TEST
+// Render text straight out to a stream. e.g. Serial
+IRtext::IRtext(Print *stream) {
+  _buf = NULL;
+  _size = 0;
+  _str = NULL;
+  _stream = stream;
+  _len = 0;
+}
+#endif  // UNIT_TEST
+
+IRtext &IRtext::operator+=(const char c) {
+  if (_buf != NULL) {
+    if (_len + 1 < _size) {
+      _buf[_len] = c;
+      _buf[_len + 1] = '\0';
+    }
+  } else if (_str != NULL) {
+    *_str += c;
+#ifndef UNIT_TEST
+  } else if (_stream != NULL) {
+    _stream->write(c);
+#endif  // UNIT_TEST
+  }
+  _len++;
+  return *this;
+}
+
+IRtext &IRtext::operator+=(const char *str) {
+  if (_str != NULL) {
+    *_str += str;
+    _len += strlen(str);
+  } else {
+    while (*str) *this += *str++;
+  }
+  return *this;
+}
+
+#ifndef UNIT_TEST
+IRtext &IRtext::operator+=(const __FlashStringHelper *str) {
+  PGM_P ptr = reinterpret_cast<PGM_P>(str);
+  for (char c = pgm_read_byte(ptr++); c; c = pgm_read_byte(ptr++)) *this += c;
+  return *this;
+}
+#endif  // UNIT_TEST
+
+IRtext &IRtext::operator+=(const String &str) { return *this += str.c_str(); }
+
+// Add an unsigned integer.
 // Arduino String/toInt/Serial.print() can't handle printing 64 bit values.
 //
 // Args:
-//   input: The value to print
-//   base:  The output base.
-// Returns:
-//   A string representation of the integer.
+//   input:  The value to add.
+//   base:   The output base.
+//   digits: Zero pad it to at least this many digits.
 // Note: Based on Arduino's Print::printNumber()
-String uint64ToString(uint64_t input, uint8_t base) {
-  String result = "";
+void IRtext::addNum(uint64_t input, uint8_t base, const uint8_t digits) {
   // prevent issues if called with base <= 1
   if (base < 2) base = 10;
   // Check we have a base that we can actually print.
   // i.e. [0-9A-Z] == 36
   if (base > 36) base = 10;
 
-  // Reserve some string space to reduce fragmentation.
-  // 16 bytes should store a uint64 in hex text which is the likely worst case.
-  // 64 bytes would be the worst case (base 2).
-  result.reserve(16);
-
+  char num[65];  // 64 digits would be the worst case (base 2), plus a NUL.
+  uint8_t pos = sizeof(num) - 1;
+  num[pos] = '\0';
   do {
     char c = input % base;
     input /= base;
@@ -65,9 +137,33 @@ String uint64ToString(uint64_t input, uint8_t base) {
       c += '0';
     else
       c += 'A' - 10;
-    result = c + result;
+    num[--pos] = c;
   } while (input);
-  return result;
+  while (pos && sizeof(num) - 1 - pos < digits) num[--pos] = '0';
+  *this += num + pos;
+}
+
+// Returns:
+//   The nr. of chars rendered so far. Including any that didn't fit.
+size_t IRtext::length(void) { return _len; }
+
+// Returns:
+//   Whether some text didn't fit in the caller's buffer.
+bool IRtext::truncated(void) { return _buf != NULL && _len >= _size; }
+
+// Convert a uint64_t (unsigned long long) to a string.
+// Arduino String/toInt/Serial.print() can't handle printing 64 bit values.
+//
+// Args:
+//   input: The value to print
+//   base:  The output base.
+// Returns:
+//   A string representation of the integer.
+String uint64ToString(uint64_t input, uint8_t base) {
+  char num[65];  // Base 2 is the worst case.
+  IRtext text(num, sizeof(num));
+  text.addNum(input, base);
+  return String(num);
 }
 
 #ifdef ARDUINO
@@ -297,212 +393,223 @@ String htmlEscape(const String unescaped) {
 //   A string containing the protocol name.
 String typeToString(const decode_type_t protocol, const bool isRepeat) {
   String result = "";
+  IRtext text(&result);
+  typeToString(protocol, isRepeat, &text);
+  return result;
+}
+
+// Render a protocol type (enum etc) as human readable text.
+// Args:
+//   protocol: Nr. (enum) of the protocol.
+//   isRepeat: A flag indicating if it is a repeat message of the protocol.
+//   result:   Where to render it.
+void typeToString(const decode_type_t protocol, const bool isRepeat,
+                  IRtext *result) {
   switch (protocol) {
     case UNUSED:
-      result = F("UNUSED");
+      *result += F("UNUSED");
       break;
     case AIWA_RC_T501:
-      result = F("AIWA_RC_T501");
+      *result += F("AIWA_RC_T501");
       break;
     case ARGO:
-      result = F("ARGO");
+      *result += F("ARGO");
       break;
     case CARRIER_AC:
-      result = F("CARRIER_AC");
+      *result += F("CARRIER_AC");
       break;
     case COOLIX:
-      result = F("COOLIX");
+      *result += F("COOLIX");
       break;
     case DAIKIN:
-      result = F("DAIKIN");
+      *result += F("DAIKIN");
       break;
     case DAIKIN160:
-      result = F("DAIKIN160");
+      *result += F("DAIKIN160");
       break;
     case DAIKIN2:
-      result = F("DAIKIN2");
+      *result += F("DAIKIN2");
       break;
     case DAIKIN216:
-      result = F("DAIKIN216");
+      *result += F("DAIKIN216");
       break;
     case DENON:
-      result = F("DENON");
+      *result += F("DENON");
       break;
     case DISH:
-      result = F("DISH");
+      *result += F("DISH");
       break;
     case ELECTRA_AC:
-      result = F("ELECTRA_AC");
+      *result += F("ELECTRA_AC");
       break;
     case FUJITSU_AC:
-      result = F("FUJITSU_AC");
+      *result += F("FUJITSU_AC");
       break;
     case GICABLE:
-      result = F("GICABLE");
+      *result += F("GICABLE");
       break;
     case GLOBALCACHE:
-      result = F("GLOBALCACHE");
+      *result += F("GLOBALCACHE");
       break;
     case GOODWEATHER:
-      result = F("GOODWEATHER");
+      *result += F("GOODWEATHER");
       break;
     case GREE:
-      result = F("GREE");
+      *result += F("GREE");
       break;
     case HAIER_AC:
-      result = F("HAIER_AC");
+      *result += F("HAIER_AC");
       break;
     case HAIER_AC_YRW02:
-      result = F("HAIER_AC_YRW02");
+      *result += F("HAIER_AC_YRW02");
       break;
     case HITACHI_AC:
-      result = F("HITACHI_AC");
+      *result += F("HITACHI_AC");
       break;
     case HITACHI_AC1:
-      result = F("HITACHI_AC1");
+      *result += F("HITACHI_AC1");
       break;
     case HITACHI_AC2:
-      result = F("HITACHI_AC2");
+      *result += F("HITACHI_AC2");
       break;
     case INAX:
-      result = F("INAX");
+      *result += F("INAX");
       break;
     case JVC:
-      result = F("JVC");
+      *result += F("JVC");
       break;
     case KELVINATOR:
-      result = F("KELVINATOR");
+      *result += F("KELVINATOR");
       break;
     case LEGOPF:
-      result = F("LEGOPF");
+      *result += F("LEGOPF");
       break;
     case LG:
-      result = F("LG");
+      *result += F("LG");
       break;
     case LG2:
-      result = F("LG2");
+      *result += F("LG2");
       break;
     case LASERTAG:
-      result = F("LASERTAG");
+      *result += F("LASERTAG");
       break;
     case LUTRON:
-      result = F("LUTRON");
+      *result += F("LUTRON");
       break;
     case MAGIQUEST:
-      result = F("MAGIQUEST");
+      *result += F("MAGIQUEST");
       break;
     case MIDEA:
-      result = F("MIDEA");
+      *result += F("MIDEA");
       break;
     case MITSUBISHI:
-      result = F("MITSUBISHI");
+      *result += F("MITSUBISHI");
       break;
     case MITSUBISHI2:
-      result = F("MITSUBISHI2");
+      *result += F("MITSUBISHI2");
       break;
     case MITSUBISHI_AC:
-      result = F("MITSUBISHI_AC");
+      *result += F("MITSUBISHI_AC");
       break;
     case MITSUBISHI_HEAVY_88:
-      result = F("MITSUBISHI_HEAVY_88");
+      *result += F("MITSUBISHI_HEAVY_88");
       break;
     case MITSUBISHI_HEAVY_152:
-      result = F("MITSUBISHI_HEAVY_152");
+      *result += F("MITSUBISHI_HEAVY_152");
       break;
     case MWM:
-      result = F("MWM");
+      *result += F("MWM");
       break;
     case NEC:
-      result = F("NEC");
+      *result += F("NEC");
       break;
     case NEC_LIKE:
-      result = F("NEC (non-strict)");
+      *result += F("NEC (non-strict)");
       break;
     case NIKAI:
-      result = F("NIKAI");
+      *result += F("NIKAI");
       break;
     case PANASONIC:
-      result = F("PANASONIC");
+      *result += F("PANASONIC");
       break;
     case PANASONIC_AC:
-      result = F("PANASONIC_AC");
+      *result += F("PANASONIC_AC");
       break;
     case PIONEER:
-      result = F("PIONEER");
+      *result += F("PIONEER");
       break;
     case PRONTO:
-      result = F("PRONTO");
+      *result += F("PRONTO");
       break;
     case RAW:
-      result = F("RAW");
+      *result += F("RAW");
       break;
     case RC5:
-      result = F("RC5");
+      *result += F("RC5");
       break;
     case RC5X:
-      result = F("RC5X");
+      *result += F("RC5X");
       break;
     case RC6:
-      result = F("RC6");
+      *result += F("RC6");
       break;
     case RCMM:
-      result = F("RCMM");
+      *result += F("RCMM");
       break;
     case SAMSUNG:
-      result = F("SAMSUNG");
+      *result += F("SAMSUNG");
       break;
     case SAMSUNG36:
-      result = F("SAMSUNG36");
+      *result += F("SAMSUNG36");
       break;
     case SAMSUNG_AC:
-      result = F("SAMSUNG_AC");
+      *result += F("SAMSUNG_AC");
       break;
     case SANYO:
-      result = F("SANYO");
+      *result += F("SANYO");
       break;
     case SANYO_LC7461:
-      result = F("SANYO_LC7461");
+      *result += F("SANYO_LC7461");
       break;
     case SHARP:
-      result = F("SHARP");
+      *result += F("SHARP");
       break;
     case SHARP_AC:
-      result = F("SHARP_AC");
+      *result += F("SHARP_AC");
       break;
     case SHERWOOD:
-      result = F("SHERWOOD");
+      *result += F("SHERWOOD");
       break;
     case SONY:
-      result = F("SONY");
+      *result += F("SONY");
       break;
     case TCL112AC:
-      result = F("TCL112AC");
+      *result += F("TCL112AC");
       break;
     case TECO:
-      result = F("TECO");
+      *result += F("TECO");
       break;
     case TOSHIBA_AC:
-      result = F("TOSHIBA_AC");
+      *result += F("TOSHIBA_AC");
       break;
     case TROTEC:
-      result = F("TROTEC");
+      *result += F("TROTEC");
       break;
     case VESTEL_AC:
-      result = F("VESTEL_AC");
+      *result += F("VESTEL_AC");
       break;
     case WHIRLPOOL_AC:
-      result = F("WHIRLPOOL_AC");
+      *result += F("WHIRLPOOL_AC");
       break;
     case WHYNTER:
-      result = F("WHYNTER");
+      *result += F("WHYNTER");
       break;
     case UNKNOWN:
     default:
-      result = F("UNKNOWN");
+      *result += F("UNKNOWN");
       break;
   }
-  if (isRepeat) result += F(" (Repeat)");
-  return result;
+  if (isRepeat) *result += F(" (Repeat)");
 }
 
 // Does the given protocol use a complex state as part of the decode?
@@ -561,56 +668,65 @@ String resultToSourceCode(const decode_results * const results) {
   String output = "";
   // Reserve some space for the string to reduce heap fragmentation.
   output.reserve(1536);  // 1.5KB should cover most cases.
+  IRtext text(&output);
+  resultToSourceCode(results, &text);
+  return output;
+}
+
+// Render the key values of a decode_results structure in a C/C++ code style
+// format.
+void resultToSourceCode(const decode_results * const results, IRtext *output) {
   // Start declaration
-  output += F("uint16_t ");  // variable type
-  output += F("rawData[");   // array name
-  output += uint64ToString(getCorrectedRawLength(results), 10);
+  *output += F("uint16_t ");  // variable type
+  *output += F("rawData[");   // array name
+  output->addNum(getCorrectedRawLength(results), 10);
   // array size
-  output += F("] = {");  // Start declaration
+  *output += F("] = {");  // Start declaration
 
   // Dump data
   for (uint16_t i = 1; i < results->rawlen; i++) {
     uint32_t usecs;
     for (usecs = results->rawbuf[i] * kRawTick; usecs > UINT16_MAX;
          usecs -= UINT16_MAX) {
-      output += uint64ToString(UINT16_MAX);
+      output->addNum(UINT16_MAX);
       if (i % 2)
-        output += F(", 0,  ");
+        *output += F(", 0,  ");
       else
-        output += F(",  0, ");
+        *output += F(",  0, ");
     }
-    output += uint64ToString(usecs, 10);
+    output->addNum(usecs, 10);
     if (i < results->rawlen - 1)
-      output += F(", ");            // ',' not needed on the last one
-    if (i % 2 == 0) output += ' ';  // Extra if it was even.
+      *output += F(", ");            // ',' not needed on the last one
+    if (i % 2 == 0) *output += ' ';  // Extra if it was even.
   }
 
   // End declaration
-  output += F("};");
+  *output += F("};");
 
   // Comment
-  output += F("  // ");
-  output += typeToString(results->decode_type, results->repeat);
+  *output += F("  // ");
+  typeToString(results->decode_type, results->repeat, output);
   // Only display the value if the decode type doesn't have an A/C state.
-  if (!hasACState(results->decode_type))
-    output += ' ' + uint64ToString(results->value, 16);
-  output += F("\n");
+  if (!hasACState(results->decode_type)) {
+    *output += ' ';
+    output->addNum(results->value, 16);
+  }
+  *output += F("\n");
 
   // Now dump "known" codes
   if (results->decode_type != UNKNOWN) {
     if (hasACState(results->decode_type)) {
 #if DECODE_AC
       uint16_t nbytes = results->bits / 8;
-      output += F("uint8_t state[");
-      output += uint64ToString(nbytes);
-      output += F("] = {");
+      *output += F("uint8_t state[");
+      output->addNum(nbytes);
+      *output += F("] = {");
       for (uint16_t i = 0; i < nbytes; i++) {
-        output += F("0x");
-        if (results->state[i] < 0x10) output += '0';
-        output += uint64ToString(results->state[i], 16);
-        if (i < nbytes - 1) output += F(", ");
+        *output += F("0x");
+        output->addNum(results->state[i], 16, 2);
+        if (i < nbytes - 1) *output += F(", ");
       }
-      output += F("};\n");
+      *output += F("};\n");
 #endif  // DECODE_AC
     } else {
       // Simple protocols
@@ -618,49 +734,55 @@ String resultToSourceCode(const decode_results * const results) {
       // NOTE: It will ignore the atypical case when a message has been
       // decoded but the address & the command are both 0.
       if (results->address > 0 || results->command > 0) {
-        output += F("uint32_t address = 0x");
-        output += uint64ToString(results->address, 16);
-        output += F(";\n");
-        output += F("uint32_t command = 0x");
-        output += uint64ToString(results->command, 16);
-        output += F(";\n");
+        *output += F("uint32_t address = 0x");
+        output->addNum(results->address, 16);
+        *output += F(";\n");
+        *output += F("uint32_t command = 0x");
+        output->addNum(results->command, 16);
+        *output += F(";\n");
       }
       // Most protocols have data
-      output += F("uint64_t data = 0x");
-      output += uint64ToString(results->value, 16);
-      output += F(";\n");
+      *output += F("uint64_t data = 0x");
+      output->addNum(results->value, 16);
+      *output += F(";\n");
     }
   }
-  return output;
 }
 
 // Dump out the decode_results structure.
 //
 String resultToTimingInfo(const decode_results * const results) {
   String output = "";
-  String value = "";
   // Reserve some space for the string to reduce heap fragmentation.
   output.reserve(2048);  // 2KB should cover most cases.
-  value.reserve(6);  // Max value should be 2^17 = 131072
-  output += F("Raw Timing[");
-  output += uint64ToString(results->rawlen - 1, 10);
-  output += F("]:\n");
+  IRtext text(&output);
+  resultToTimingInfo(results, &text);
+  return output;
+}
+
+// Render the timings of the decode_results structure.
+//
+void resultToTimingInfo(const decode_results * const results, IRtext *output) {
+  *output += F("Raw Timing[");
+  output->addNum(results->rawlen - 1, 10);
+  *output += F("]:\n");
 
   for (uint16_t i = 1; i < results->rawlen; i++) {
     if (i % 2 == 0)
-      output += '-';  // even
+      *output += '-';  // even
     else
-      output += F("   +");  // odd
-    value = uint64ToString(results->rawbuf[i] * kRawTick);
+      *output += F("   +");  // odd
+    char value[11];  // Max value should be 2^17 = 131072
+    IRtext num(value, sizeof(value));
+    num.addNum(results->rawbuf[i] * kRawTick);
     // Space pad the value till it is at least 6 chars long.
-    while (value.length() < 6) value = ' ' + value;
-    output += value;
+    for (size_t len = num.length(); len < 6; len++) *output += ' ';
+    *output += value;
     if (i < results->rawlen - 1)
-      output += F(", ");  // ',' not needed for last one
-    if (!(i % 8)) output += '\n';  // Newline every 8 entries.
+      *output += F(", ");  // ',' not needed for last one
+    if (!(i % 8)) *output += '\n';  // Newline every 8 entries.
   }
-  output += '\n';
-  return output;
+  *output += '\n';
 }
 
 // Convert the decode_results structure's value/state to simple hexadecimal.
@@ -669,17 +791,22 @@ String resultToHexidecimal(const decode_results * const result) {
   String output = "";
   // Reserve some space for the string to reduce heap fragmentation.
   output.reserve(2 * kStateSizeMax);  // Should cover worst cases.
+  IRtext text(&output);
+  resultToHexidecimal(result, &text);
+  return output;
+}
+
+// Render the decode_results structure's value/state as simple hexadecimal.
+//
+void resultToHexidecimal(const decode_results * const result, IRtext *output) {
   if (hasACState(result->decode_type)) {
 #if DECODE_AC
-    for (uint16_t i = 0; result->bits > i * 8; i++) {
-      if (result->state[i] < 0x10) output += '0';  // Zero pad
-      output += uint64ToString(result->state[i], 16);
-    }
+    for (uint16_t i = 0; result->bits > i * 8; i++)
+      output->addNum(result->state[i], 16, 2);  // Zero pad
 #endif  // DECODE_AC
   } else {
-    output += uint64ToString(result->value, 16);
+    output->addNum(result->value, 16);
   }
-  return output;
 }
 
 // Dump out the decode_results structure.
@@ -688,18 +815,26 @@ String resultToHumanReadableBasic(const decode_results * const results) {
   String output = "";
   // Reserve some space for the string to reduce heap fragmentation.
   output.reserve(2 * kStateSizeMax + 50);  // Should cover most cases.
+  IRtext text(&output);
+  resultToHumanReadableBasic(results, &text);
+  return output;
+}
+
+// Render the basics of the decode_results structure.
+//
+void resultToHumanReadableBasic(const decode_results * const results,
+                                IRtext *output) {
   // Show Encoding standard
-  output += F("Encoding  : ");
-  output += typeToString(results->decode_type, results->repeat);
-  output += '\n';
+  *output += F("Encoding  : ");
+  typeToString(results->decode_type, results->repeat, output);
+  *output += '\n';
 
   // Show Code & length
-  output += F("Code      : ");
-  output += resultToHexidecimal(results);
-  output += F(" (");
-  output += uint64ToString(results->bits);
-  output += F(" bits)\n");
-  return output;
+  *output += F("Code      : ");
+  resultToHexidecimal(results, output);
+  *output += F(" (");
+  output->addNum(results->bits);
+  *output += F(" bits)\n");
 }
 
 // Convert a decode_results into an array suitable for `sendRaw()`.
@@ -14,15 +14,51 @@
 #include "IRremoteESP8266.h"
 #include "IRrecv.h"
 
+// Somewhere to render text to, without needing the heap. Either a caller's
+// char buffer, a Print stream (e.g. Serial), or a String.
+class IRtext {
+ public:
+  IRtext(char *buf, const size_t size);
+  explicit IRtext(String *str);
+#ifndef UNIT_TEST
+  explicit IRtext(Print *stream);
+#endif  // UNIT_TEST
+  IRtext &operator+=(const char c);
+  IRtext &operator+=(const char *str);
+#ifndef UNIT_TEST
+  IRtext &operator+=(const __FlashStringHelper *str);
+#endif  // UNIT_TEST
+  IRtext &operator+=(const String &str);
+  void addNum(uint64_t input, uint8_t base = 10, const uint8_t digits = 1);
+  size_t length(void);
+  bool truncated(void);
+
+ private:
+  char *_buf;
+  size_t _size;
+  String *_str;
+#ifndef UNIT_TEST
+  Print *_stream;
+#endif  // UNIT_TEST
+  size_t _len;
+};
+
 uint64_t reverseBits(uint64_t input, uint16_t nbits);
 String uint64ToString(uint64_t input, uint8_t base = 10);
 String typeToString(const decode_type_t protocol,
                     const bool isRepeat = false);
+void typeToString(const decode_type_t protocol, const bool isRepeat,
+                  IRtext *result);
 void serialPrintUint64(uint64_t input, uint8_t base = 10);
 String resultToSourceCode(const decode_results * const results);
+void resultToSourceCode(const decode_results * const results, IRtext *output);
 String resultToTimingInfo(const decode_results * const results);
+void resultToTimingInfo(const decode_results * const results, IRtext *output);
 String resultToHumanReadableBasic(const decode_results * const results);
+void resultToHumanReadableBasic(const decode_results * const results,
+                                IRtext *output);
 String resultToHexidecimal(const decode_results * const result);
+void resultToHexidecimal(const decode_results * const result, IRtext *output);
 String htmlEscape(const String unescaped);
 bool hasACState(const decode_type_t protocol);
 uint16_t getCorrectedRawLength(const decode_results * const results);
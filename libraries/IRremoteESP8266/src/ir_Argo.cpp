@@ -333,13 +333,21 @@ stdAc::state_t IRArgoAC::toCommon(void) {
 }
 
 // Convert the internal state into a human readable string.
-String IRArgoAC::toString() {
+String IRArgoAC::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRArgoAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += getPower() ? F("On") : F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kArgoAuto:
       result += F(" (AUTO)");
@@ -363,7 +371,7 @@ String IRArgoAC::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kArgoFanAuto:
       result += F(" (AUTO)");
@@ -381,10 +389,10 @@ String IRArgoAC::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += 'C';
   result += F(", Room Temp: ");
-  result += uint64ToString(getRoomTemp());
+  result.addNum(getRoomTemp());
   result += 'C';
   result += F(", Max: ");
   result += getMax() ? F("On") : F("Off");
@@ -392,7 +400,6 @@ String IRArgoAC::toString() {
   result += getiFeel() ? F("On") : F("Off");
   result += F(", Night: ");
   result += getNight() ? F("On") : F("Off");
-  return result;
 }
 
 #if DECODE_ARGO
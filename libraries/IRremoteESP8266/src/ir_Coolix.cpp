@@ -428,39 +428,47 @@ stdAc::state_t IRCoolixAC::toCommon(void) {
 }
 
 // Convert the internal state into a human readable string.
-String IRCoolixAC::toString() {
+String IRCoolixAC::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRCoolixAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (getPower()) {
     result += F("On");
   } else {
     result += F("Off");
-    return result;  // If it's off, there is no other info.
+    return;  // If it's off, there is no other info.
   }
   // Special modes.
   if (getSwing()) {
     result += F(", Swing: Toggle");
-    return result;
+    return;
   }
   if (getSleep()) {
     result += F(", Sleep: Toggle");
-    return result;
+    return;
   }
   if (getTurbo()) {
     result += F(", Turbo: Toggle");
-    return result;
+    return;
   }
   if (getLed()) {
     result += F(", Led: Toggle");
-    return result;
+    return;
   }
   if (getClean()) {
     result += F(", Clean: Toggle");
-    return result;
+    return;
   }
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kCoolixAuto:
       result += F(" (AUTO)");
@@ -481,7 +489,7 @@ String IRCoolixAC::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kCoolixFanAuto:
       result += F(" (AUTO)");
@@ -509,7 +517,7 @@ String IRCoolixAC::toString() {
   }
   if (getMode() != kCoolixFan) {  // Fan mode doesn't have a temperature.
     result += F(", Temp: ");
-    result += uint64ToString(getTemp());
+    result.addNum(getTemp());
     result += 'C';
   }
   result += F(", Zone Follow: ");
@@ -520,9 +528,10 @@ String IRCoolixAC::toString() {
   result += F(", Sensor Temp: ");
   if (getSensorTemp() > kCoolixSensorTempMax)
     result += F("Ignored");
-  else
-    result += uint64ToString(getSensorTemp()) + F("C");
-  return result;
+  else {
+    result.addNum(getSensorTemp());
+    result += F("C");
+  }
 }
 
 #if DECODE_COOLIX
@@ -12,6 +12,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -132,6 +133,7 @@ class IRCoolixAC {
   static stdAc::fanspeed_t toCommonFanSpeed(const uint8_t speed);
   stdAc::state_t toCommon(void);
   String toString();
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
@@ -497,21 +497,33 @@ stdAc::state_t IRDaikinESP::toCommon(void) {
 
 String IRDaikinESP::renderTime(const uint16_t timemins) {
   String ret;
-  ret = uint64ToString(timemins / 60) + ':';
-  uint8_t mins = timemins % 60;
-  if (mins < 10) ret += '0';
-  ret += uint64ToString(mins);
+  IRtext text(&ret);
+  renderTime(timemins, &text);
   return ret;
 }
 
+void IRDaikinESP::renderTime(const uint16_t timemins, IRtext *result) {
+  result->addNum(timemins / 60);
+  *result += ':';
+  result->addNum(timemins % 60, 10, 2);
+}
+
 // Convert the internal state into a human readable string.
 String IRDaikinESP::toString(void) {
   String result = "";
   result.reserve(230);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRDaikinESP::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += this->getPower() ? F("On") : F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kDaikinAuto:
       result += F(" (AUTO)");
@@ -532,9 +544,9 @@ String IRDaikinESP::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kDaikinFanAuto:
       result += F(" (AUTO)");
@@ -564,7 +576,7 @@ String IRDaikinESP::toString(void) {
   result += F(", Swing (Vertical): ");
   result += this->getSwingVertical() ? F("On") : F("Off");
   result += F(", Current Time: ");
-  result += this->renderTime(this->getCurrentTime());
+  this->renderTime(this->getCurrentTime(), &result);
   result += F(", Current Day: ");
   switch (this->getCurrentDay()) {
   case 1:
@@ -586,17 +598,16 @@ String IRDaikinESP::toString(void) {
   }
   result += F(", On Time: ");
   if (this->getOnTimerEnabled())
-    result += this->renderTime(this->getOnTime());
+    this->renderTime(this->getOnTime(), &result);
   else
     result += F("Off");
   result += F(", Off Time: ");
   if (this->getOffTimerEnabled())
-    result += this->renderTime(this->getOffTime());
+    this->renderTime(this->getOffTime(), &result);
   else
     result += F("Off");
   result += F(", Weekly Timer: ");
   result += this->getWeeklyTimerEnable() ? F("On") : F("Off");
-  return result;
 }
 
 #if DECODE_DAIKIN
@@ -1206,16 +1217,24 @@ stdAc::state_t IRDaikin2::toCommon(void) {
 }
 
 // Convert the internal state into a human readable string.
-String IRDaikin2::toString() {
+String IRDaikin2::toString(void) {
   String result = "";
   result.reserve(310);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRDaikin2::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (getPower())
     result += F("On");
   else
     result += F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kDaikinAuto:
       result += F(" (AUTO)");
@@ -1236,9 +1255,9 @@ String IRDaikin2::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kDaikinFanAuto:
       result += F(" (Auto)");
@@ -1254,7 +1273,7 @@ String IRDaikin2::toString() {
       break;
   }
   result += F(", Swing (V): ");
-  result += uint64ToString(getSwingVertical());
+  result.addNum(getSwingVertical());
   switch (getSwingVertical()) {
     case kDaikin2SwingVHigh:
       result += F(" (Highest)");
@@ -1280,7 +1299,7 @@ String IRDaikin2::toString() {
       result += F(" (Unknown)");
   }
   result += F(", Swing (H): ");
-  result += uint64ToString(getSwingHorizontal());
+  result.addNum(getSwingHorizontal());
   switch (getSwingHorizontal()) {
     case kDaikin2SwingHAuto:
       result += F(" (Auto)");
@@ -1290,24 +1309,24 @@ String IRDaikin2::toString() {
       break;
   }
   result += F(", Clock: ");
-  result += IRDaikinESP::renderTime(getCurrentTime());
+  IRDaikinESP::renderTime(getCurrentTime(), &result);
   result += F(", On Time: ");
   if (getOnTimerEnabled())
-    result += IRDaikinESP::renderTime(getOnTime());
+    IRDaikinESP::renderTime(getOnTime(), &result);
   else
     result += F("Off");
   result += F(", Off Time: ");
   if (getOffTimerEnabled())
-    result += IRDaikinESP::renderTime(getOffTime());
+    IRDaikinESP::renderTime(getOffTime(), &result);
   else
     result += F("Off");
   result += F(", Sleep Time: ");
   if (getSleepTimerEnabled())
-    result += IRDaikinESP::renderTime(getSleepTime());
+    IRDaikinESP::renderTime(getSleepTime(), &result);
   else
     result += F("Off");
   result += F(", Beep: ");
-  result += uint64ToString(getBeep());
+  result.addNum(getBeep());
   switch (getBeep()) {
     case kDaikinBeepLoud:
       result += F(" (Loud)");
@@ -1322,7 +1341,7 @@ String IRDaikin2::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Light: ");
-  result += uint64ToString(getLight());
+  result.addNum(getLight());
   switch (getLight()) {
     case kDaikinLightBright:
       result += F(" (Bright)");
@@ -1357,7 +1376,6 @@ String IRDaikin2::toString() {
   result += (getPurify() ? F("On") : F("Off"));
   result += F(", Econo: ");
   result += (getEcono() ? F("On") : F("Off"));
-  return result;
 }
 
 #if DECODE_DAIKIN2
@@ -1723,16 +1741,24 @@ stdAc::state_t IRDaikin216::toCommon(void) {
 }
 
 // Convert the internal state into a human readable string.
-String IRDaikin216::toString() {
+String IRDaikin216::toString(void) {
   String result = "";
   result.reserve(120);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRDaikin216::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (this->getPower())
     result += F("On");
   else
     result += F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (getMode()) {
     case kDaikinAuto:
       result += F(" (AUTO)");
@@ -1753,9 +1779,9 @@ String IRDaikin216::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kDaikinFanAuto:
       result += F(" (AUTO)");
@@ -1778,7 +1804,6 @@ String IRDaikin216::toString() {
   result += (this->getQuiet() ? F("On") : F("Off"));
   result += F(", Powerful: ");
   result += (this->getPowerful() ? F("On") : F("Off"));
-  return result;
 }
 
 #if DECODE_DAIKIN216
@@ -20,6 +20,7 @@
 #include "IRrecv.h"
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -300,7 +301,9 @@ class IRDaikinESP {
   static stdAc::fanspeed_t toCommonFanSpeed(const uint8_t speed);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
   static String renderTime(const uint16_t timemins);
+  static void renderTime(const uint16_t timemins, IRtext *result);
 #ifndef UNIT_TEST
 
  private:
@@ -391,6 +394,7 @@ class IRDaikin2 {
   static stdAc::swingh_t toCommonSwingH(const uint8_t setting);
   stdAc::state_t toCommon(void);
   String toString();
+  void toString(IRtext *output);
   static String renderTime(uint16_t timemins);
 #ifndef UNIT_TEST
 
@@ -443,6 +447,7 @@ class IRDaikin216 {
   bool getPowerful(void);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
   static String renderTime(const uint16_t timemins);
 #ifndef UNIT_TEST
 
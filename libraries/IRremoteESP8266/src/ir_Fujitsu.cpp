@@ -528,9 +528,17 @@ stdAc::state_t IRFujitsuAC::toCommon(void) {
 String IRFujitsuAC::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRFujitsuAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Model: ");
   fujitsu_ac_remote_model_t model = this->getModel();
-  result += uint64ToString(model);
+  result.addNum(model);
   switch (model) {
     case fujitsu_ac_remote_model_t::ARRAH2E: result += F(" (ARRAH2E)"); break;
     case fujitsu_ac_remote_model_t::ARDB1: result += F(" (ARDB1)"); break;
@@ -541,7 +549,7 @@ String IRFujitsuAC::toString(void) {
   result += F(", Power: ");
   result += this->getPower() ? F("On") : F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kFujitsuAcModeAuto:
       result += F(" (AUTO)");
@@ -562,9 +570,9 @@ String IRFujitsuAC::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFanSpeed());
+  result.addNum(this->getFanSpeed());
   switch (getFanSpeed()) {
     case kFujitsuAcFanAuto:
       result += F(" (AUTO)");
@@ -633,7 +641,6 @@ String IRFujitsuAC::toString(void) {
     result += F(", Outside Quiet: ");
     result += this->getOutsideQuiet() ? F("On") : F("Off");
   }
-  return result;
 }
 
 #if DECODE_FUJITSU_AC
@@ -4,6 +4,7 @@
 // Global Cache IR format sender originally added by Hisham Khalifa
 //   (http://www.hishamkhalifa.com)
 
+#include <string.h>
 #include <algorithm>
 #include "IRsend.h"
 
@@ -61,4 +62,67 @@ void IRsend::sendGC(uint16_t buf[], uint16_t len) {
   // It's possible that we've ended on a mark(), thus ensure the LED is off.
   ledOff();
 }
+
+// Turn a GlobalCache code in text form straight into timings for playback(),
+// in one pass and without using the heap. e.g. A code POSTed over HTTP.
+//
+// Args:
+//   str: The code, in decimal numbers separated by commas, shortened as for
+//        sendGC() or as a whole "sendir,1:1,1,38000,1,1,9,70,..." command.
+//   timings: Where to put the timings. Even elements are Mark times, Odd are
+//            Space times, in uSeconds.
+//   size: Nr. of elements in the timings[] array.
+//   hz: Where to put the carrier frequency.
+// Returns:
+//   The nr. of timings, or 0 if the code isn't valid or doesn't fit.
+uint16_t IRsend::parseGC(const char *str, uint32_t timings[],
+                         const uint16_t size, uint32_t *hz) {
+  // Skip the command, the emitter ID & the request ID of a whole command.
+  if (strncmp(str, "sendir,", 7) == 0)
+    for (uint8_t commas = 0; *str && commas < 3; str++)
+      if (*str == ',') commas++;
+  uint16_t header[kGlobalCacheStartIndex];
+  for (uint8_t i = 0; i < kGlobalCacheStartIndex; i++)
+    if (parseWord(&str, 10, &header[i]) != 1) return 0;
+  *hz = header[kGlobalCacheFreqIndex];  // GC frequency is in Hz.
+  const uint32_t periodic_time = calcUSecPeriod(*hz, false);
+  const uint8_t emits =
+      std::min(header[kGlobalCacheRptIndex], (uint16_t)kGlobalCacheMaxRepeat);
+  if (emits == 0) return 0;
+
+  // First time through. These codes start with a mark.
+  uint16_t len = 0;
+  uint16_t word;
+  int8_t got;
+  while ((got = parseWord(&str, 10, &word)) == 1)
+    if (!addTiming(timings, size, &len,
+                   std::max(word * periodic_time, kGlobalCacheMinUsec),
+                   len & 1))
+      return 0;
+  if (got < 0 || len == 0) return 0;
+  // Repeats start a specified offset into the data sent the first time.
+  const uint16_t end = len;
+  const uint16_t start = std::max(header[kGlobalCacheRptStartIndex],
+                                  (uint16_t)1) - 1;
+  for (uint8_t repeat = 1; repeat < emits; repeat++)
+    for (uint16_t i = start; i < end; i++)
+      if (!addTiming(timings, size, &len, timings[i], i & 1)) return 0;
+  return len;
+}
+
+// Send a GlobalCache code in text form. See parseGC().
+//
+// Args:
+//   str: The code, in decimal numbers separated by commas.
+//   timings: Array to build the message in. It must be left alone until it is
+//            sent. See playback().
+//   size: Nr. of elements in the timings[] array.
+// Returns:
+//   False if the code isn't valid, doesn't fit, or a playback() is already
+//   in progress.
+bool IRsend::sendGC(const char *str, uint32_t timings[], const uint16_t size) {
+  uint32_t hz;
+  const uint16_t len = parseGC(str, timings, size, &hz);
+  return len && playback(timings, len, hz);
+}
 #endif
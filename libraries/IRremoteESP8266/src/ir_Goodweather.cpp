@@ -300,13 +300,21 @@ stdAc::state_t IRGoodweatherAc::toCommon(void) {
 }
 
 // Convert the internal state into a human readable string.
-String IRGoodweatherAc::toString() {
+String IRGoodweatherAc::toString(void) {
   String result = "";
   result.reserve(150);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRGoodweatherAc::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += this->getPower() ? F("On") : F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kGoodweatherAuto:
       result += F(" (AUTO)");
@@ -327,9 +335,9 @@ String IRGoodweatherAc::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kGoodweatherFanAuto:
       result += F(" (AUTO)");
@@ -351,7 +359,7 @@ String IRGoodweatherAc::toString() {
   result += F(", Sleep: ");
   result += this->getSleep() ? F("Toggle") : F("-");
   result += F(", Swing: ");
-  result += uint64ToString(this->getSwing());
+  result.addNum(this->getSwing());
   switch (this->getSwing()) {
     case kGoodweatherSwingFast:
       result += F(" (Fast)");
@@ -366,7 +374,7 @@ String IRGoodweatherAc::toString() {
       result += F(" (UNKNOWN)");
   }
   result += F(", Command: ");
-  result += uint64ToString(this->getCommand());
+  result.addNum(this->getCommand());
   switch (this->getCommand()) {
     case kGoodweatherCmdPower:
       result += F(" (Power)");
@@ -407,7 +415,6 @@ String IRGoodweatherAc::toString() {
     default:
       result += F(" (UNKNOWN)");
   }
-  return result;
 }
 
 #if DECODE_GOODWEATHER
@@ -16,6 +16,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -124,6 +125,7 @@ class IRGoodweatherAc {
   static stdAc::fanspeed_t toCommonFanSpeed(const uint8_t speed);
   stdAc::state_t toCommon(void);
   String toString();
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
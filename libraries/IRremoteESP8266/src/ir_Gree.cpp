@@ -417,13 +417,21 @@ stdAc::state_t IRGreeAC::toCommon(void) {
 String IRGreeAC::toString(void) {
   String result = "";
   result.reserve(150);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRGreeAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (getPower())
     result += F("On");
   else
     result += F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kGreeAuto:
       result += F(" (AUTO)");
@@ -444,9 +452,9 @@ String IRGreeAC::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case 0:
       result += F(" (AUTO)");
@@ -481,7 +489,7 @@ String IRGreeAC::toString(void) {
   else
     result += F("Manual");
   result += F(", Swing Vertical Pos: ");
-  result += uint64ToString(getSwingVerticalPosition());
+  result.addNum(getSwingVerticalPosition());
   switch (getSwingVerticalPosition()) {
     case kGreeSwingLastPos:
       result += F(" (Last Pos)");
@@ -490,7 +498,6 @@ String IRGreeAC::toString(void) {
       result += F(" (Auto)");
       break;
   }
-  return result;
 }
 
 #if DECODE_GREE
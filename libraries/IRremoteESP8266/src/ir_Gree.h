@@ -15,6 +15,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -121,6 +122,7 @@ class IRGreeAC {
   static bool validChecksum(const uint8_t state[],
                             const uint16_t length = kGreeStateLength);
   String toString(void);
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
@@ -299,14 +299,18 @@ void IRHaierAC::setSwing(const uint8_t state) {
 // Convert a Haier time into a human readable string.
 String IRHaierAC::timeToString(const uint16_t nr_mins) {
   String result = "";
-  if (nr_mins / 24 < 10) result += '0';  // Zero pad.
-  result += uint64ToString(nr_mins / 60);
-  result += ':';
-  if (nr_mins % 60 < 10) result += '0';  // Zero pad.
-  result += uint64ToString(nr_mins % 60);
+  IRtext text(&result);
+  timeToString(nr_mins, &text);
   return result;
 }
 
+void IRHaierAC::timeToString(const uint16_t nr_mins, IRtext *result) {
+  if (nr_mins / 24 < 10) *result += '0';  // Zero pad.
+  result->addNum(nr_mins / 60);
+  *result += ':';
+  result->addNum(nr_mins % 60, 10, 2);  // Zero pad.
+}
+
 // Convert a standard A/C mode into its native mode.
 uint8_t IRHaierAC::convertMode(const stdAc::opmode_t mode) {
   switch (mode) {
@@ -417,9 +421,17 @@ stdAc::state_t IRHaierAC::toCommon(void) {
 String IRHaierAC::toString(void) {
   String result = "";
   result.reserve(150);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRHaierAC::toString(IRtext *output) {
+  IRtext &result = *output;
   uint8_t cmd = getCommand();
   result += F("Command: ");
-  result += uint64ToString(cmd);
+  result.addNum(cmd);
   result += F(" (");
   switch (cmd) {
     case kHaierAcCmdOff:
@@ -460,7 +472,7 @@ String IRHaierAC::toString(void) {
   }
   result += ')';
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kHaierAcAuto:
       result += F(" (AUTO)");
@@ -481,9 +493,9 @@ String IRHaierAC::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kHaierAcFanAuto:
       result += F(" (AUTO)");
@@ -493,7 +505,7 @@ String IRHaierAC::toString(void) {
       break;
   }
   result += F(", Swing: ");
-  result += uint64ToString(getSwing());
+  result.addNum(getSwing());
   result += F(" (");
   switch (getSwing()) {
     case kHaierAcSwingOff:
@@ -523,19 +535,18 @@ String IRHaierAC::toString(void) {
   else
     result += F("Off");
   result += F(", Current Time: ");
-  result += timeToString(getCurrTime());
+  timeToString(getCurrTime(), &result);
   result += F(", On Timer: ");
   if (getOnTimer() >= 0)
-    result += timeToString(getOnTimer());
+    timeToString(getOnTimer(), &result);
   else
     result += F("Off");
   result += F(", Off Timer: ");
   if (getOffTimer() >= 0)
-    result += timeToString(getOffTimer());
+    timeToString(getOffTimer(), &result);
   else
     result += F("Off");
 
-  return result;
 }
 // End of IRHaierAC class.
 
@@ -852,6 +863,14 @@ stdAc::state_t IRHaierACYRW02::toCommon(void) {
 String IRHaierACYRW02::toString(void) {
   String result = "";
   result.reserve(130);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRHaierACYRW02::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (getPower())
     result += F("On");
@@ -859,7 +878,7 @@ String IRHaierACYRW02::toString(void) {
     result += F("Off");
   uint8_t cmd = getButton();
   result += F(", Button: ");
-  result += uint64ToString(cmd);
+  result.addNum(cmd);
   result += F(" (");
   switch (cmd) {
     case kHaierAcYrw02ButtonPower:
@@ -894,7 +913,7 @@ String IRHaierACYRW02::toString(void) {
   }
   result += ')';
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kHaierAcYrw02Auto:
       result += F(" (Auto)");
@@ -915,9 +934,9 @@ String IRHaierACYRW02::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kHaierAcYrw02FanAuto:
       result += F(" (Auto)");
@@ -935,7 +954,7 @@ String IRHaierACYRW02::toString(void) {
       result += F(" (Unknown)");
   }
   result += F(", Turbo: ");
-  result += uint64ToString(getTurbo());
+  result.addNum(getTurbo());
   result += F(" (");
   switch (getTurbo()) {
     case kHaierAcYrw02TurboOff:
@@ -952,7 +971,7 @@ String IRHaierACYRW02::toString(void) {
   }
   result += ')';
   result += F(", Swing: ");
-  result += uint64ToString(getSwing());
+  result.addNum(getSwing());
   result += F(" (");
   switch (getSwing()) {
     case kHaierAcYrw02SwingOff:
@@ -988,7 +1007,6 @@ String IRHaierACYRW02::toString(void) {
   else
     result += F("Off");
 
-  return result;
 }
 // End of IRHaierACYRW02 class.
 
@@ -14,6 +14,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -236,7 +237,9 @@ class IRHaierAC {
   static stdAc::swingv_t toCommonSwingV(const uint8_t pos);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
   static String timeToString(const uint16_t nr_mins);
+  static void timeToString(const uint16_t nr_mins, IRtext *result);
 #ifndef UNIT_TEST
 
  private:
@@ -300,6 +303,7 @@ class IRHaierACYRW02 {
   static stdAc::swingv_t toCommonSwingV(const uint8_t pos);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
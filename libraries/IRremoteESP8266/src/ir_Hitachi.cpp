@@ -340,13 +340,21 @@ stdAc::state_t IRHitachiAc::toCommon(void) {
 String IRHitachiAc::toString(void) {
   String result = "";
   result.reserve(110);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRHitachiAc::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (getPower())
     result += F("On");
   else
     result += F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kHitachiAcAuto:
       result += F(" (AUTO)");
@@ -367,9 +375,9 @@ String IRHitachiAc::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kHitachiAcFanAuto:
       result += F(" (AUTO)");
@@ -394,7 +402,6 @@ String IRHitachiAc::toString(void) {
     result += F("On");
   else
     result += F("Off");
-  return result;
 }
 
 #if (DECODE_HITACHI_AC || DECODE_HITACHI_AC1 || DECODE_HITACHI_AC2)
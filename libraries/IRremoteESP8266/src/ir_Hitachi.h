@@ -17,6 +17,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -72,6 +73,7 @@ class IRHitachiAc {
   static stdAc::fanspeed_t toCommonFanSpeed(const uint8_t speed);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
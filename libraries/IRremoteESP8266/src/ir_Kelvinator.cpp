@@ -416,10 +416,18 @@ stdAc::state_t IRKelvinatorAC::toCommon(void) {
 String IRKelvinatorAC::toString(void) {
   String result = "";
   result.reserve(160);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRKelvinatorAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += getPower() ? F("On") : F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kKelvinatorAuto:
       result += F(" (AUTO)");
@@ -440,9 +448,9 @@ String IRKelvinatorAC::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kKelvinatorFanAuto:
       result += F(" (AUTO)");
@@ -465,7 +473,6 @@ String IRKelvinatorAC::toString(void) {
   result += getSwingHorizontal() ? F("On") : F("Off");
   result += F(", Swing (Vertical): ");
   result += getSwingVertical() ? F("On") : F("Off");
-  return result;
 }
 
 #if DECODE_KELVINATOR
@@ -24,6 +24,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -176,6 +177,7 @@ class IRKelvinatorAC {
   static stdAc::fanspeed_t toCommonFanSpeed(const uint8_t speed);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
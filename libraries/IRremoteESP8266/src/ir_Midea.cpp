@@ -335,13 +335,21 @@ stdAc::state_t IRMideaAC::toCommon(void) {
 String IRMideaAC::toString(void) {
   String result = "";
   result.reserve(70);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRMideaAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (getPower())
     result += F("On");
   else
     result += F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kMideaACAuto:
       result += F(" (AUTO)");
@@ -362,11 +370,11 @@ String IRMideaAC::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp(true));
+  result.addNum(getTemp(true));
   result += F("C/");
-  result += uint64ToString(getTemp(false));
+  result.addNum(getTemp(false));
   result += F("F, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kMideaACFanAuto:
       result += F(" (AUTO)");
@@ -386,7 +394,6 @@ String IRMideaAC::toString(void) {
     result += F("On");
   else
     result += F("Off");
-  return result;
 }
 
 #if DECODE_MIDEA
@@ -728,18 +728,29 @@ stdAc::state_t IRMitsubishiAC::toCommon(void) {
 String IRMitsubishiAC::timeToString(const uint64_t time) {
   String result = "";
   result.reserve(6);
-  if (time / 6 < 10) result += '0';
-  result += uint64ToString(time / 6);
-  result += ':';
-  if (time * 10 % 60 < 10) result += '0';
-  result += uint64ToString(time * 10 % 60);
+  IRtext text(&result);
+  timeToString(time, &text);
   return result;
 }
 
+void IRMitsubishiAC::timeToString(const uint64_t time, IRtext *result) {
+  result->addNum(time / 6, 10, 2);
+  *result += ':';
+  result->addNum(time * 10 % 60, 10, 2);
+}
+
 // Convert the internal state into a human readable string.
 String IRMitsubishiAC::toString(void) {
   String result = "";
   result.reserve(110);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRMitsubishiAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (this->getPower())
     result += F("On");
@@ -762,7 +773,7 @@ String IRMitsubishiAC::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, FAN: ");
   switch (this->getFan()) {
     case MITSUBISHI_AC_FAN_AUTO:
@@ -775,7 +786,7 @@ String IRMitsubishiAC::toString(void) {
       result += F("SILENT");
       break;
     default:
-      result += uint64ToString(this->getFan());
+      result.addNum(this->getFan());
   }
   result += F(", VANE: ");
   switch (this->getVane()) {
@@ -786,14 +797,14 @@ String IRMitsubishiAC::toString(void) {
       result += F("AUTO MOVE");
       break;
     default:
-      result += uint64ToString(this->getVane());
+      result.addNum(this->getVane());
   }
   result += F(", Time: ");
-  result += this->timeToString(this->getClock());
+  this->timeToString(this->getClock(), &result);
   result += F(", On timer: ");
-  result += this->timeToString(this->getStartClock());
+  this->timeToString(this->getStartClock(), &result);
   result += F(", Off timer: ");
-  result += this->timeToString(this->getStopClock());
+  this->timeToString(this->getStopClock(), &result);
   result += F(", Timer: ");
   switch (this->getTimer()) {
     case kMitsubishiAcNoTimer:
@@ -813,5 +824,4 @@ String IRMitsubishiAC::toString(void) {
       result += this->getTimer();
       result += F(")\n");
   }
-  return result;
 }
@@ -17,6 +17,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -100,6 +101,7 @@ class IRMitsubishiAC {
   static stdAc::swingv_t toCommonSwingV(const uint8_t pos);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
@@ -108,6 +110,7 @@ class IRMitsubishiAC {
   IRsendTest _irsend;
 #endif
   String timeToString(const uint64_t time);
+  void timeToString(const uint64_t time, IRtext *result);
   uint8_t remote_state[kMitsubishiACStateLength];
   void checksum(void);
 };
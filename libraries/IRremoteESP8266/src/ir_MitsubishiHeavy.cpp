@@ -455,10 +455,18 @@ stdAc::state_t IRMitsubishiHeavy152Ac::toCommon(void) {
 String IRMitsubishiHeavy152Ac::toString(void) {
   String result = "";
   result.reserve(180);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRMitsubishiHeavy152Ac::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += (this->getPower() ? F("On") : F("Off"));
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kMitsubishiHeavyAuto:
       result += F(" (Auto)");
@@ -479,9 +487,10 @@ String IRMitsubishiHeavy152Ac::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp()) + 'C';
+  result.addNum(this->getTemp());
+  result += 'C';
   result += F(", Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kMitsubishiHeavy152FanAuto:
       result += F(" (Auto)");
@@ -508,7 +517,7 @@ String IRMitsubishiHeavy152Ac::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Swing (V): ");
-  result += uint64ToString(this->getSwingVertical());
+  result.addNum(this->getSwingVertical());
   switch (this->getSwingVertical()) {
     case kMitsubishiHeavy152SwingVAuto:
       result += F(" (Auto)");
@@ -535,7 +544,7 @@ String IRMitsubishiHeavy152Ac::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Swing (H): ");
-  result += uint64ToString(this->getSwingHorizontal());
+  result.addNum(this->getSwingHorizontal());
   switch (this->getSwingHorizontal()) {
     case kMitsubishiHeavy152SwingHAuto:
       result += F(" (Auto)");
@@ -581,7 +590,6 @@ String IRMitsubishiHeavy152Ac::toString(void) {
   result += (this->get3D() ? F("On") : F("Off"));
   result += F(", Clean: ");
   result += (this->getClean() ? F("On") : F("Off"));
-  return result;
 }
 
 
@@ -931,10 +939,18 @@ stdAc::state_t IRMitsubishiHeavy88Ac::toCommon(void) {
 String IRMitsubishiHeavy88Ac::toString(void) {
   String result = "";
   result.reserve(140);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRMitsubishiHeavy88Ac::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += (this->getPower() ? F("On") : F("Off"));
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kMitsubishiHeavyAuto:
       result += F(" (Auto)");
@@ -955,9 +971,10 @@ String IRMitsubishiHeavy88Ac::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp()) + 'C';
+  result.addNum(this->getTemp());
+  result += 'C';
   result += F(", Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kMitsubishiHeavy88FanAuto:
       result += F(" (Auto)");
@@ -981,7 +998,7 @@ String IRMitsubishiHeavy88Ac::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Swing (V): ");
-  result += uint64ToString(this->getSwingVertical());
+  result.addNum(this->getSwingVertical());
   switch (this->getSwingVertical()) {
     case kMitsubishiHeavy88SwingVAuto:
       result += F(" (Auto)");
@@ -1008,7 +1025,7 @@ String IRMitsubishiHeavy88Ac::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Swing (H): ");
-  result += uint64ToString(this->getSwingHorizontal());
+  result.addNum(this->getSwingHorizontal());
   switch (this->getSwingHorizontal()) {
     case kMitsubishiHeavy88SwingHAuto:
       result += F(" (Auto)");
@@ -1051,7 +1068,6 @@ String IRMitsubishiHeavy88Ac::toString(void) {
   result += (this->get3D() ? F("On") : F("Off"));
   result += F(", Clean: ");
   result += (this->getClean() ? F("On") : F("Off"));
-  return result;
 }
 
 #if DECODE_MITSUBISHIHEAVY
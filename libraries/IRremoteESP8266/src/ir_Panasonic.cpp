@@ -612,10 +612,16 @@ bool IRPanasonicAc::isOffTimerEnabled(void) {
 String IRPanasonicAc::timeToString(const uint16_t mins_since_midnight) {
   String result = "";
   result.reserve(6);
-  result += uint64ToString(mins_since_midnight / 60) + ':';
-  uint8_t mins = mins_since_midnight % 60;
-  if (mins < 10) result += '0';  // Zero pad the minutes.
-  return result + uint64ToString(mins);
+  IRtext text(&result);
+  timeToString(mins_since_midnight, &text);
+  return result;
+}
+
+void IRPanasonicAc::timeToString(const uint16_t mins_since_midnight,
+                                 IRtext *result) {
+  result->addNum(mins_since_midnight / 60);
+  *result += ':';
+  result->addNum(mins_since_midnight % 60, 10, 2);  // Zero pad the minutes.
 }
 
 // Convert a standard A/C mode into its native mode.
@@ -758,8 +764,16 @@ stdAc::state_t IRPanasonicAc::toCommon(void) {
 String IRPanasonicAc::toString(void) {
   String result = "";
   result.reserve(180);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRPanasonicAc::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Model: ");
-  result += uint64ToString(getModel());
+  result.addNum(getModel());
   switch (getModel()) {
     case kPanasonicDke:
       result += F(" (DKE)");
@@ -788,7 +802,7 @@ String IRPanasonicAc::toString(void) {
   else
     result += F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (getMode()) {
     case kPanasonicAcAuto:
       result += F(" (AUTO)");
@@ -809,9 +823,9 @@ String IRPanasonicAc::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kPanasonicAcFanAuto:
       result += F(" (AUTO)");
@@ -827,7 +841,7 @@ String IRPanasonicAc::toString(void) {
       break;
   }
   result += F(", Swing (Vertical): ");
-  result += uint64ToString(getSwingVertical());
+  result.addNum(getSwingVertical());
   switch (getSwingVertical()) {
     case kPanasonicAcSwingVAuto:
       result += F(" (AUTO)");
@@ -852,7 +866,7 @@ String IRPanasonicAc::toString(void) {
       break;  // No Horizontal Swing support.
     default:
       result += F(", Swing (Horizontal): ");
-      result += uint64ToString(getSwingHorizontal());
+      result.addNum(getSwingHorizontal());
       switch (getSwingHorizontal()) {
         case kPanasonicAcSwingHAuto:
           result += F(" (AUTO)");
@@ -888,18 +902,17 @@ String IRPanasonicAc::toString(void) {
   else
     result += F("Off");
   result += F(", Clock: ");
-  result += timeToString(getClock());
+  timeToString(getClock(), &result);
   result += F(", On Timer: ");
   if (isOnTimerEnabled())
-    result += timeToString(getOnTimer());
+    timeToString(getOnTimer(), &result);
   else
     result += F("Off");
   result += F(", Off Timer: ");
   if (isOffTimerEnabled())
-    result += timeToString(getOffTimer());
+    timeToString(getOffTimer(), &result);
   else
     result += F("Off");
-  return result;
 }
 
 #if DECODE_PANASONIC_AC
@@ -29,6 +29,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -148,7 +149,10 @@ class IRPanasonicAc {
   static stdAc::swingh_t toCommonSwingH(const uint8_t pos);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
   static String timeToString(const uint16_t mins_since_midnight);
+  static void timeToString(const uint16_t mins_since_midnight,
+                           IRtext *result);
 #ifndef UNIT_TEST
 
  private:
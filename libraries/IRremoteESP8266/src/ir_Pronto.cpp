@@ -101,4 +101,76 @@ void IRsend::sendPronto(uint16_t data[], uint16_t len, uint16_t repeat) {
       }
   }
 }
+
+// Turn a Pronto code in text form straight into timings for playback(), in
+// one pass and without using the heap. e.g. A code POSTed over HTTP.
+//
+// Args:
+//   str: The Pronto code, in hexadecimal words separated by white space (or
+//        commas). e.g. "0000 0067 0000 0015 0060 0018 ..."
+//   timings: Where to put the timings. Even elements are Mark times, Odd are
+//            Space times, in uSeconds.
+//   size: Nr. of elements in the timings[] array.
+//   hz: Where to put the carrier frequency.
+//   repeat: Nr. of times to repeat the message. As for sendPronto().
+// Returns:
+//   The nr. of timings, or 0 if the code isn't valid or doesn't fit.
+uint16_t IRsend::parsePronto(const char *str, uint32_t timings[],
+                             const uint16_t size, uint32_t *hz,
+                             uint16_t repeat) {
+  uint16_t header[kProntoDataOffset];
+  for (uint16_t i = 0; i < kProntoDataOffset; i++)
+    if (parseWord(&str, 16, &header[i]) != 1) return 0;
+  // We only know how to deal with 'raw' pronto codes types. Reject all others.
+  if (header[kProntoTypeOffset] != 0 || header[kProntoFreqOffset] == 0)
+    return 0;
+  *hz = (uint16_t)(1000000U / (header[kProntoFreqOffset] * kProntoFreqFactor));
+  const uint32_t periodic_time = calcUSecPeriod(*hz, false);
+  const uint16_t seq_1_len = header[kProntoSeq1LenOffset] * 2;
+  const uint16_t seq_2_len = header[kProntoSeq2LenOffset] * 2;
+  // No first sequence implies sending the 2nd/repeat one at least once.
+  if (seq_1_len == 0) repeat++;
+
+  uint16_t len = 0;
+  uint16_t seq_2_start = 0;  // In timings[].
+  uint16_t words = 0;        // Of data.
+  uint16_t word;
+  int8_t got;
+  while ((got = parseWord(&str, 16, &word)) == 1) {
+    if (words == seq_1_len) seq_2_start = len;
+    // Anything past the two sequences is ignored, as sendPronto() does.
+    if (words < seq_1_len || (words < seq_1_len + seq_2_len && repeat))
+      if (!addTiming(timings, size, &len, word * periodic_time, words & 1))
+        return 0;
+    words++;
+  }
+  if (got < 0) return 0;
+  if (words + kProntoDataOffset < kProntoMinLength ||
+      words < seq_1_len + seq_2_len)
+    return 0;
+  // The repeats are copies of the 2nd sequence sent the first time.
+  const uint16_t seq_2_end = len;
+  for (uint16_t r = 1; r < repeat && seq_2_len; r++)
+    for (uint16_t i = seq_2_start; i < seq_2_end; i++)
+      if (!addTiming(timings, size, &len, timings[i], i & 1)) return 0;
+  return len;
+}
+
+// Send a Pronto code in text form. See parsePronto().
+//
+// Args:
+//   str: The Pronto code, in hexadecimal words separated by white space.
+//   timings: Array to build the message in. It must be left alone until it is
+//            sent. See playback().
+//   size: Nr. of elements in the timings[] array.
+//   repeat: Nr. of times to repeat the message.
+// Returns:
+//   False if the code isn't valid, doesn't fit, or a playback() is already
+//   in progress.
+bool IRsend::sendPronto(const char *str, uint32_t timings[],
+                        const uint16_t size, const uint16_t repeat) {
+  uint32_t hz;
+  const uint16_t len = parsePronto(str, timings, size, &hz, repeat);
+  return len && playback(timings, len, hz);
+}
 #endif
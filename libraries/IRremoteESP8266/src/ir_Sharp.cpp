@@ -520,10 +520,18 @@ stdAc::state_t IRSharpAc::toCommon(void) {
 String IRSharpAc::toString(void) {
   String result = "";
   result.reserve(60);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRSharpAc::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += this->getPower() ? F("On") : F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kSharpAcAuto:
       result += F(" (AUTO)");
@@ -541,9 +549,9 @@ String IRSharpAc::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kSharpAcFanAuto:
       result += F(" (AUTO)");
@@ -561,7 +569,6 @@ String IRSharpAc::toString(void) {
       result += F(" (MAX)");
       break;
   }
-  return result;
 }
 
 #if DECODE_SHARP_AC
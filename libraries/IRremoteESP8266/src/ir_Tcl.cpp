@@ -343,10 +343,18 @@ stdAc::state_t IRTcl112Ac::toCommon(void) {
 String IRTcl112Ac::toString(void) {
   String result = "";
   result.reserve(140);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRTcl112Ac::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += (this->getPower() ? F("On") : F("Off"));
   result += F(", Mode: ");
-  result += uint64ToString(getMode());
+  result.addNum(getMode());
   switch (this->getMode()) {
     case kTcl112AcAuto:
       result += F(" (AUTO)");
@@ -368,10 +376,10 @@ String IRTcl112Ac::toString(void) {
   }
   uint16_t nrHalfDegrees = this->getTemp() * 2;
   result += F(", Temp: ");
-  result += uint64ToString(nrHalfDegrees / 2);
+  result.addNum(nrHalfDegrees / 2);
   if (nrHalfDegrees & 1) result += F(".5");
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (getFan()) {
     case kTcl112AcFanAuto:
       result += F(" (Auto)");
@@ -398,7 +406,6 @@ String IRTcl112Ac::toString(void) {
   result += (this->getSwingHorizontal() ? F("On") : F("Off"));
   result += F(", Swing (V): ");
   result += (this->getSwingVertical() ? F("On") : F("Off"));
-  return result;
 }
 
 #if DECODE_TCL112AC
@@ -8,6 +8,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #include "IRrecv.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
@@ -90,6 +91,7 @@ class IRTcl112Ac {
   static stdAc::fanspeed_t toCommonFanSpeed(const uint8_t speed);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
@@ -220,10 +220,18 @@ stdAc::state_t IRTecoAc::toCommon(void) {
 String IRTecoAc::toString(void) {
   String result = "";
   result.reserve(80);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRTecoAc::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += (this->getPower() ? F("On") : F("Off"));
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kTecoAuto:
       result += F(" (AUTO)");
@@ -244,9 +252,9 @@ String IRTecoAc::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(getTemp());
+  result.addNum(getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(getFan());
+  result.addNum(getFan());
   switch (this->getFan()) {
     case kTecoFanAuto:
       result += F(" (Auto)");
@@ -267,7 +275,6 @@ String IRTecoAc::toString(void) {
   result += (this->getSleep() ? F("On") : F("Off"));
   result += F(", Swing: ");
   result += (this->getSwing() ? F("On") : F("Off"));
-  return result;
 }
 
 #if DECODE_TECO
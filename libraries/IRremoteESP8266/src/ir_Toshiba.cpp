@@ -316,13 +316,21 @@ stdAc::state_t IRToshibaAC::toCommon(void) {
 String IRToshibaAC::toString(void) {
   String result = "";
   result.reserve(40);
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRToshibaAC::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   if (this->getPower())
     result += F("On");
   else
     result += F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kToshibaAcAuto:
       result += F(" (AUTO)");
@@ -340,9 +348,9 @@ String IRToshibaAC::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kToshibaAcFanAuto:
       result += F(" (AUTO)");
@@ -351,7 +359,6 @@ String IRToshibaAC::toString(void) {
       result += F(" (MAX)");
       break;
   }
-  return result;
 }
 
 #if DECODE_TOSHIBA_AC
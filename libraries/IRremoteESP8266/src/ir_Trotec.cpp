@@ -229,10 +229,18 @@ stdAc::state_t IRTrotecESP::toCommon(void) {
 String IRTrotecESP::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRTrotecESP::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Power: ");
   result += (this->getPower() ? F("On") : F("Off"));
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kTrotecAuto:
       result += F(" (AUTO)");
@@ -250,9 +258,9 @@ String IRTrotecESP::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan Speed: ");
-  result += uint64ToString(this->getSpeed());
+  result.addNum(this->getSpeed());
   switch (this->getSpeed()) {
     case kTrotecFanLow:
       result += F(" (Low)");
@@ -266,7 +274,6 @@ String IRTrotecESP::toString(void) {
   }
   result += F(", Sleep: ");
   result += (this->getSleep() ? F("On") : F("Off"));
-  return result;
 }
 
 #if DECODE_TROTEC
@@ -484,29 +484,41 @@ stdAc::state_t IRVestelAc::toCommon(void) {
 String IRVestelAc::toString(void) {
   String result = "";
   result.reserve(100);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRVestelAc::toString(IRtext *output) {
+  IRtext &result = *output;
   if (this->isTimeCommand()) {
     result += F("Time: ");
-    result += IRHaierAC::timeToString(getTime());
+    IRHaierAC::timeToString(getTime(), &result);
 
     result += F(", Timer: ");
-    result += this->isTimerActive() ? IRHaierAC::timeToString(this->getTimer())
-                                    : F("Off");
+    if (this->isTimerActive())
+      IRHaierAC::timeToString(this->getTimer(), &result);
+    else
+      result += F("Off");
     result += F(", On Timer: ");
-    result += (this->isOnTimerActive() && !this->isTimerActive())
-                  ? IRHaierAC::timeToString(this->getOnTimer())
-                  : F("Off");
+    if (this->isOnTimerActive() && !this->isTimerActive())
+      IRHaierAC::timeToString(this->getOnTimer(), &result);
+    else
+      result += F("Off");
 
     result += F(", Off Timer: ");
-    result +=
-        this->isOffTimerActive() ? IRHaierAC::timeToString(this->getOffTimer())
-                                 : F("Off");
-    return result;
+    if (this->isOffTimerActive())
+      IRHaierAC::timeToString(this->getOffTimer(), &result);
+    else
+      result += F("Off");
+    return;
   }
   // Not a time command, it's a normal command.
   result += F("Power: ");
   result += (this->getPower() ? F("On") : F("Off"));
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kVestelAcAuto:
       result += F(" (AUTO)");
@@ -527,9 +539,9 @@ String IRVestelAc::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (this->getFan()) {
     case kVestelAcFanAuto:
       result += F(" (AUTO)");
@@ -560,7 +572,6 @@ String IRVestelAc::toString(void) {
   result += this->getIon() ? F("On") : F("Off");
   result += F(", Swing: ");
   result += this->getSwing() ? F("On") : F("Off");
-  return result;
 }
 
 #if DECODE_VESTEL_AC
@@ -478,22 +478,32 @@ stdAc::state_t IRWhirlpoolAc::toCommon(void) {
 
 String IRWhirlpoolAc::timeToString(const uint16_t minspastmidnight) {
   String result = "";
-  uint8_t hours = minspastmidnight / 60;
-  if (hours < 10) result += '0';
-  result += uint64ToString(hours);
-  result += ':';
-  uint8_t mins = minspastmidnight % 60;
-  if (mins < 10) result += '0';
-  result += uint64ToString(mins);
+  IRtext text(&result);
+  timeToString(minspastmidnight, &text);
   return result;
 }
 
+void IRWhirlpoolAc::timeToString(const uint16_t minspastmidnight,
+                                 IRtext *result) {
+  result->addNum(minspastmidnight / 60, 10, 2);
+  *result += ':';
+  result->addNum(minspastmidnight % 60, 10, 2);
+}
+
 // Convert the internal state into a human readable string.
 String IRWhirlpoolAc::toString(void) {
   String result = "";
   result.reserve(200);  // Reserve some heap for the string to reduce fragging.
+  IRtext text(&result);
+  toString(&text);
+  return result;
+}
+
+// Render the internal state as human readable text.
+void IRWhirlpoolAc::toString(IRtext *output) {
+  IRtext &result = *output;
   result += F("Model: ");
-  result += uint64ToString(this->getModel());
+  result.addNum(this->getModel());
   switch (this->getModel()) {
     case DG11J191:
       result += F(" (DG11J191)");
@@ -507,7 +517,7 @@ String IRWhirlpoolAc::toString(void) {
   result += F(", Power toggle: ");
   result += this->getPowerToggle() ? F("On") : F("Off");
   result += F(", Mode: ");
-  result += uint64ToString(this->getMode());
+  result.addNum(this->getMode());
   switch (this->getMode()) {
     case kWhirlpoolAcHeat:
       result += F(" (HEAT)");
@@ -528,9 +538,9 @@ String IRWhirlpoolAc::toString(void) {
       result += F(" (UNKNOWN)");
   }
   result += F(", Temp: ");
-  result += uint64ToString(this->getTemp());
+  result.addNum(this->getTemp());
   result += F("C, Fan: ");
-  result += uint64ToString(this->getFan());
+  result.addNum(this->getFan());
   switch (getFan()) {
     case kWhirlpoolAcFanAuto:
       result += F(" (AUTO)");
@@ -553,15 +563,15 @@ String IRWhirlpoolAc::toString(void) {
   result += F(", Light: ");
   result += this->getLight() ? F("On") : F("Off");
   result += F(", Clock: ");
-  result += this->timeToString(this->getClock());
+  this->timeToString(this->getClock(), &result);
   result += F(", On Timer: ");
   if (this->isOnTimerEnabled())
-    result += this->timeToString(this->getOnTimer());
+    this->timeToString(this->getOnTimer(), &result);
   else
     result += F("Off");
   result += F(", Off Timer: ");
   if (this->isOffTimerEnabled())
-    result += this->timeToString(this->getOffTimer());
+    this->timeToString(this->getOffTimer(), &result);
   else
     result += F("Off");
   result += F(", Sleep: ");
@@ -569,7 +579,7 @@ String IRWhirlpoolAc::toString(void) {
   result += F(", Super: ");
   result += this->getSuper() ? F("On") : F("Off");
   result += F(", Command: ");
-  result += uint64ToString(this->getCommand());
+  result.addNum(this->getCommand());
   switch (this->getCommand()) {
     case kWhirlpoolAcCommandLight:
       result += F(" (LIGHT)");
@@ -611,7 +621,6 @@ String IRWhirlpoolAc::toString(void) {
       result += F(" (UNKNOWN)");
       break;
   }
-  return result;
 }
 
 #if DECODE_WHIRLPOOL_AC
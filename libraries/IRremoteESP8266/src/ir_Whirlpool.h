@@ -22,6 +22,7 @@
 #endif
 #include "IRremoteESP8266.h"
 #include "IRsend.h"
+#include "IRutils.h"
 #ifdef UNIT_TEST
 #include "IRsend_test.h"
 #endif
@@ -141,6 +142,7 @@ class IRWhirlpoolAc {
   static stdAc::fanspeed_t toCommonFanSpeed(const uint8_t speed);
   stdAc::state_t toCommon(void);
   String toString(void);
+  void toString(IRtext *output);
 #ifndef UNIT_TEST
 
  private:
@@ -160,6 +162,7 @@ class IRWhirlpoolAc {
   void _setMode(const uint8_t mode);
   int8_t getTempOffset(void);
   String timeToString(uint16_t minspastmidnight);
+  void timeToString(const uint16_t minspastmidnight, IRtext *result);
 };
 
 #endif  // IR_WHIRLPOOL_H_
@@ -996,3 +996,124 @@ TEST(TestIRac, swinghToString) {
   EXPECT_EQ("auto", IRac::swinghToString(stdAc::swingh_t::kAuto));
   EXPECT_EQ("unknown", IRac::swinghToString((stdAc::swingh_t)500));
 }
+
+TEST(TestIRac, Cache) {
+  IRKelvinatorAC ac(0);
+  IRac irac(0);
+  irac.enableCache(1);
+
+  ac.begin();
+  irac.kelvinator(&ac, true, stdAc::opmode_t::kCool, 19,
+                  stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+                  stdAc::swingh_t::kOff, false, true, true, false, false);
+  std::string expected = ac._irsend.outputStr();
+  // The first send is recorded, then sent.
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              19, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+  ASSERT_NE(nullptr, irac._cache[0].timings);
+  // The second comes from the cache.
+  irac._irsend.reset();
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              19, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+  EXPECT_EQ(2, irac._cache_clock);
+
+  // A different state replaces it.
+  ac._irsend.reset();
+  irac._irsend.reset();
+  irac.kelvinator(&ac, true, stdAc::opmode_t::kCool, 25,
+                  stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+                  stdAc::swingh_t::kOff, false, true, true, false, false);
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              25, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ(ac._irsend.outputStr(), irac._irsend.outputStr());
+  EXPECT_EQ(25, irac._cache[0].key.degrees);
+
+  irac.disableCache();
+  EXPECT_EQ(nullptr, irac._cache);
+}
+
+TEST(TestIRac, Diff) {
+  IRKelvinatorAC ac(0);
+  IRac irac(0);
+  // The cache plays messages back through irac._irsend, where we can see them.
+  irac.enableCache(2);
+  irac.enableDiff();
+
+  ac.begin();
+  irac.kelvinator(&ac, true, stdAc::opmode_t::kCool, 19,
+                  stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+                  stdAc::swingh_t::kOff, false, true, true, false, false);
+  std::string expected = ac._irsend.outputStr();
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              19, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+  // Unchanged: nothing is sent.
+  irac._irsend.reset();
+  EXPECT_TRUE(irac.sendAc(decode_type_t::KELVINATOR, -1, true,
+                          stdAc::opmode_t::kCool, 19, true,
+                          stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+                          stdAc::swingh_t::kOff, false, true, false, true,
+                          false, false, false, -1, -1));
+  EXPECT_EQ("", irac._irsend.outputStr());
+  // Neither is a change of the clock alone.
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              19, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, 600);
+  EXPECT_EQ("", irac._irsend.outputStr());
+  EXPECT_EQ(2, irac.skippedSends());
+
+  // A change is sent.
+  ac._irsend.reset();
+  irac.kelvinator(&ac, true, stdAc::opmode_t::kCool, 25,
+                  stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+                  stdAc::swingh_t::kOff, false, true, true, false, false);
+  expected = ac._irsend.outputStr();
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              25, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+  EXPECT_EQ(2, irac.skippedSends());
+  // As is the same state after a resetDiff().
+  irac._irsend.reset();
+  irac.resetDiff();
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              25, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+
+  // With a refresh, the unchanged state goes again once it is due.
+  irac.enableDiff(1000);
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              25, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  irac._irsend.reset();
+  TimerMs::add(999);
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              25, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ("", irac._irsend.outputStr());
+  TimerMs::add(2);
+  irac.sendAc(decode_type_t::KELVINATOR, -1, true, stdAc::opmode_t::kCool,
+              25, true, stdAc::fanspeed_t::kMedium, stdAc::swingv_t::kAuto,
+              stdAc::swingh_t::kOff, false, true, false, true, false, false,
+              false, -1, -1);
+  EXPECT_EQ(expected, irac._irsend.outputStr());
+
+  irac.disableDiff();
+  EXPECT_EQ(nullptr, irac._diff);
+}
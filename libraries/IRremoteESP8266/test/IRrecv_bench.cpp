@@ -0,0 +1,301 @@
+// Copyright 2019 David Conran
+//
+// Host benchmark of IRsend encoding and IRrecv::decode().
+//
+// Every protocol in the corpus below is encoded with IRsend::send() into an
+// IRsendTest, turned into a capture, and then decoded over and over by the
+// same IRrecv. For each one it reports:
+//   send ns   - time for one IRsend::send() of the message.
+//   decode ns - time for one IRrecv::decode() of the capture.
+//   allocs    - heap allocations made by send()+decode(), per round.
+//   chain     - decoders decode() tried before it stopped (see
+//               IRrecv::attempt()).
+//   result    - the protocol it decoded as, if not the one expected.
+// A last "noise" capture matches nothing, so decode() falls through to
+// decodeHash(), trying every decoder its first mark doesn't rule out.
+//
+// Usage: IRrecv_bench [rounds per protocol]
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <new>
+#include <string>
+#include "IRrecv.h"
+#include "IRremoteESP8266.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+#include "ir_Argo.h"
+#include "ir_Daikin.h"
+#include "ir_Fujitsu.h"
+#include "ir_Gree.h"
+#include "ir_Haier.h"
+#include "ir_Hitachi.h"
+#include "ir_Kelvinator.h"
+#include "ir_Mitsubishi.h"
+#include "ir_MitsubishiHeavy.h"
+#include "ir_Panasonic.h"
+#include "ir_Samsung.h"
+#include "ir_Sharp.h"
+#include "ir_Tcl.h"
+#include "ir_Toshiba.h"
+#include "ir_Trotec.h"
+#include "ir_Whirlpool.h"
+
+// Heap accounting. Only counted while `counting` is set, i.e. inside the
+// timed loops, so the set up of the corpus doesn't show up.
+static bool counting = false;
+static uint32_t allocations = 0;
+
+void *operator new(size_t size) {
+  if (counting) allocations++;
+  void *ptr = malloc(size ? size : 1);
+  if (ptr == NULL) throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void *ptr) noexcept { free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+
+static uint64_t nowNs(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// One message of the corpus.
+struct sample_t {
+  decode_type_t type;      // What to send it as.
+  decode_type_t expected;  // What decode() should report it as.
+  uint64_t value;          // Used when nbytes is 0.
+  uint16_t nbits;
+  uint8_t state[kStateSizeMax];
+  uint16_t nbytes;         // Non-zero for state[] based protocols.
+};
+
+static const uint16_t kMaxSamples = kLastDecodeType + 8;
+static sample_t corpus[kMaxSamples];
+static uint16_t corpus_len = 0;
+
+static void addValue(const decode_type_t type, const uint64_t value,
+                     const uint16_t nbits,
+                     const decode_type_t expected = UNKNOWN) {
+  sample_t *sample = &corpus[corpus_len++];
+  sample->type = type;
+  sample->expected = (expected == UNKNOWN) ? type : expected;
+  sample->value = value;
+  sample->nbits = nbits;
+  sample->nbytes = 0;
+}
+
+static void addState(const decode_type_t type, const uint8_t *state,
+                     const uint16_t nbytes) {
+  sample_t *sample = &corpus[corpus_len++];
+  sample->type = type;
+  sample->expected = type;
+  sample->nbits = nbytes * 8;
+  sample->nbytes = nbytes;
+  memcpy(sample->state, state, nbytes);
+}
+
+// The default state of an A/C class, which has valid checksums.
+template <typename AC>
+static void addAc(const decode_type_t type, const uint16_t nbytes) {
+  AC *ac = new AC(0);
+  ac->begin();
+  addState(type, ac->getRaw(), nbytes);
+  delete ac;
+}
+
+static void buildCorpus(void) {
+  // Simple protocols. Values are the ones the unit tests round-trip.
+  addValue(RC5, 0x175, kRC5Bits);
+  addValue(RC5, 0x1081, kRC5XBits, RC5X);
+  addValue(RC6, 0x175, kRC6Mode0Bits);
+  addValue(NEC, 0x807F40BF, kNECBits);
+  addValue(SONY, 0x240C, kSony20Bits);
+  addValue(PANASONIC, 0x40040190ED7C, kPanasonicBits);
+  addValue(JVC, 0xC2B8, kJvcBits);
+  addValue(SAMSUNG, 0xE0E09966, kSamsungBits);
+  addValue(WHYNTER, 0x87654321, kWhynterBits);
+  addValue(AIWA_RC_T501, 0x7F, kAiwaRcT501Bits);
+  addValue(LG, 0x4B4AE51, kLgBits);
+  addValue(LG, 0xB4B4AE51, kLg32Bits);
+  addValue(MITSUBISHI, 0xE242, kMitsubishiBits);
+  addValue(DISH, 0x9C00, kDishBits);
+  addValue(SHARP, 0x454A, kSharpBits);
+  addValue(COOLIX, 0xB21F28, kCoolixBits);
+  addValue(DENON, 0x2278, kDenonBits);
+  addValue(DENON, 0x2A4C028D6CE3, kDenon48Bits);
+  addValue(SHERWOOD, 0xC1A28877, kNECBits, NEC);
+  addValue(RCMM, 0xE0A600, kRCMMBits);
+  addValue(SANYO_LC7461, 0x2468DCB56A9, kSanyoLC7461Bits);
+  addValue(NIKAI, 0xD5F2A, kNikaiBits);
+  addValue(MIDEA, 0xA1826FFFFF62, kMideaBits);
+  addValue(MAGIQUEST, 0x123456789ABC, kMagiquestBits);
+  addValue(LASERTAG, 0x51, kLasertagBits);
+  addValue(CARRIER_AC, 0x4CCA541D, kCarrierAcBits);
+  addValue(MITSUBISHI2, 0xE242, kMitsubishiBits);
+  addValue(GICABLE, 0x8807, kGicableBits);
+  addValue(LUTRON, 0x7F88BD120, kLutronBits);
+  addValue(PIONEER, 0x659A05FAF50AC53A, kPioneerBits);
+  addValue(VESTEL_AC, 0x0F00D9001FEF201ULL, kVestelAcBits);
+  addValue(TECO, 0x250002BC9, kTecoBits);
+  addValue(SAMSUNG36, 0x400E00FF, kSamsung36Bits);
+  addValue(LEGOPF, 0x100E, kLegoPfBits);
+  addValue(INAX, 0x5C32CD, kInaxBits);
+  // A/C protocols with a class to build a valid state.
+  addAc<IRArgoAC>(ARGO, kArgoStateLength);
+  addAc<IRDaikinESP>(DAIKIN, kDaikinStateLength);
+  addAc<IRDaikin2>(DAIKIN2, kDaikin2StateLength);
+  addAc<IRDaikin216>(DAIKIN216, kDaikin216StateLength);
+  addAc<IRDaikin160>(DAIKIN160, kDaikin160StateLength);
+  addAc<IRFujitsuAC>(FUJITSU_AC, kFujitsuAcStateLength);
+  addAc<IRGreeAC>(GREE, kGreeStateLength);
+  addAc<IRHaierAC>(HAIER_AC, kHaierACStateLength);
+  addAc<IRHaierACYRW02>(HAIER_AC_YRW02, kHaierACYRW02StateLength);
+  addAc<IRHitachiAc>(HITACHI_AC, kHitachiAcStateLength);
+  addAc<IRKelvinatorAC>(KELVINATOR, kKelvinatorStateLength);
+  addAc<IRMitsubishiAC>(MITSUBISHI_AC, kMitsubishiACStateLength);
+  addAc<IRMitsubishiHeavy88Ac>(MITSUBISHI_HEAVY_88,
+                               kMitsubishiHeavy88StateLength);
+  addAc<IRMitsubishiHeavy152Ac>(MITSUBISHI_HEAVY_152,
+                                kMitsubishiHeavy152StateLength);
+  addAc<IRPanasonicAc>(PANASONIC_AC, kPanasonicAcStateLength);
+  addAc<IRSamsungAc>(SAMSUNG_AC, kSamsungAcStateLength);
+  addAc<IRSharpAc>(SHARP_AC, kSharpAcStateLength);
+  addAc<IRTcl112Ac>(TCL112AC, kTcl112AcStateLength);
+  addAc<IRToshibaAC>(TOSHIBA_AC, kToshibaACStateLength);
+  addAc<IRTrotecESP>(TROTEC, kTrotecStateLength);
+  addAc<IRWhirlpoolAc>(WHIRLPOOL_AC, kWhirlpoolAcStateLength);
+  // A/C protocols without one. States are from the unit tests.
+  const uint8_t electra[kElectraAcStateLength] = {
+      0xC3, 0x87, 0xF6, 0x28, 0x60, 0x00, 0x20, 0x00, 0x00, 0x20, 0x00, 0x05,
+      0x0D};
+  addState(ELECTRA_AC, electra, kElectraAcStateLength);
+  const uint8_t hitachi1[kHitachiAc1StateLength] = {
+      0xB2, 0xAE, 0x4D, 0x51, 0xF0, 0x61, 0x84, 0x00, 0x00, 0x00, 0x00, 0x30,
+      0xB8};
+  addState(HITACHI_AC1, hitachi1, kHitachiAc1StateLength);
+  const uint8_t hitachi2[kHitachiAc2StateLength] = {
+      0x80, 0x08, 0x00, 0x02, 0xFD, 0xFF, 0x00, 0x33, 0xCC, 0x49, 0xB6,
+      0x22, 0xDD, 0x01, 0xFE, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+      0xFF, 0x00, 0xFF, 0xCA, 0x35, 0x8F, 0x70, 0x00, 0xFF, 0x00, 0xFF,
+      0x01, 0xFE, 0xC0, 0x3F, 0x80, 0x7F, 0x11, 0xEE, 0x00, 0xFF, 0x00,
+      0xFF, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00};
+  addState(HITACHI_AC2, hitachi2, kHitachiAc2StateLength);
+  const uint8_t mwm[] = {0x96, 0x19, 0x10, 0x24, 0x0A, 0x6B, 0x20, 0x03, 0x82};
+  addState(MWM, mwm, sizeof(mwm));
+}
+
+// A capture that no protocol accepts: a Panasonic-ish header followed by
+// irregular marks & spaces.
+static void makeNoise(IRsendTest *irsend) {
+  irsend->reset();
+  irsend->mark(3500);
+  irsend->space(1700);
+  uint32_t seed = 12345;
+  for (uint16_t i = 0; i < 60; i++) {
+    seed = seed * 1103515245 + 12345;
+    irsend->mark(200 + (seed >> 16) % 1800);
+    seed = seed * 1103515245 + 12345;
+    irsend->space(200 + (seed >> 16) % 1800);
+  }
+  irsend->mark(500);
+  irsend->space(40000);
+}
+
+// IRsendTest::reset() clears all of its buffers, which would cost far more
+// than the encoding. Rewinding to the start is enough for mark() & space().
+static bool send(IRsendTest *irsend, const sample_t *sample) {
+  irsend->last = 0;
+  irsend->output[0] = 0;
+  if (sample->nbytes)
+    return irsend->send(sample->type, sample->state, sample->nbytes);
+  return irsend->send(sample->type, sample->value, sample->nbits);
+}
+
+// Too big for the stack with its output buffers.
+static IRsendTest sender(0);
+static IRsendTest *irsend = &sender;
+static IRrecv receiver(0);
+static IRrecv *irrecv = &receiver;
+
+int main(int argc, char *argv[]) {
+  uint32_t rounds = 2000;
+  if (argc > 1) rounds = strtoul(argv[1], NULL, 10);
+  if (rounds == 0) rounds = 1;
+
+  buildCorpus();
+  irsend->begin();
+
+  printf("%-22s %5s %10s %10s %6s %5s  %s\n", "protocol", "bits", "send ns",
+         "decode ns", "allocs", "chain", "result");
+  uint64_t total_ns = 0;
+  uint32_t total_decodes = 0;
+  uint16_t worst_chain = 0;
+  std::string worst;
+  uint16_t failed = 0;
+
+  for (uint16_t n = 0; n <= corpus_len; n++) {
+    const bool noise = (n == corpus_len);
+    const sample_t *sample = noise ? NULL : &corpus[n];
+    std::string name = noise ? "(noise)" : typeToString(sample->type);
+
+    // Encode.
+    allocations = 0;
+    uint64_t send_ns = 0;
+    if (!noise) {
+      if (!send(irsend, sample)) {
+        printf("%-22s %5d %10s\n", name.c_str(), sample->nbits, "no sender");
+        continue;
+      }
+      counting = true;
+      const uint64_t start = nowNs();
+      for (uint32_t r = 0; r < rounds; r++) send(irsend, sample);
+      send_ns = (nowNs() - start) / rounds;
+      counting = false;
+    } else {
+      makeNoise(irsend);
+    }
+    irsend->makeDecodeResult();
+
+    // Decode.
+    counting = true;
+    const uint64_t start = nowNs();
+    for (uint32_t r = 0; r < rounds; r++) irrecv->decode(&irsend->capture);
+    const uint64_t decode_ns = (nowNs() - start) / rounds;
+    counting = false;
+    total_ns += decode_ns;
+    total_decodes++;
+
+    const uint16_t chain = irrecv->_attempts;
+    if (chain > worst_chain) {
+      worst_chain = chain;
+      worst = name;
+    }
+    std::string result = "";
+    const decode_type_t got = irsend->capture.decode_type;
+    if (!noise && got != sample->expected) {
+      result = "got " + typeToString(got);
+      failed++;
+    }
+    if (noise) {
+      printf("%-22s %5s %10s ", name.c_str(), "-", "-");
+    } else {
+      printf("%-22s %5d %10llu ", name.c_str(), sample->nbits,
+             (unsigned long long)send_ns);  // NOLINT(runtime/int)
+    }
+    printf("%10llu %6.2f %5d  %s\n",
+           (unsigned long long)decode_ns,  // NOLINT(runtime/int)
+           (double)allocations / rounds, chain, result.c_str());
+  }
+
+  printf("\n%d captures, %d rounds each: mean %llu ns/decode\n",
+         total_decodes, rounds,
+         (unsigned long long)(total_ns / total_decodes));  // NOLINT
+  printf("Longest decoder chain: %d (%s)\n", worst_chain, worst.c_str());
+  if (failed) printf("%d capture(s) did not decode as expected.\n", failed);
+  return failed ? 1 : 0;
+}
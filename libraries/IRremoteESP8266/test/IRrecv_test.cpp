@@ -108,6 +108,82 @@ TEST(TestCopyIrParams, CopyNonEmpty) {
   EXPECT_EQ(0xDEAD, dst.rawbuf[test_size - 1]);
 }
 
+// Tests for double buffered capture (save_buffer).
+
+extern volatile irparams_t irparams;
+
+// Pretend to be the interrupt: capture what irsend sent and stop.
+void captureAsInterrupt(IRsendTest *irsend) {
+  irsend->makeDecodeResult();
+  ASSERT_LE(irsend->capture.rawlen, irparams.bufsize);
+  for (uint16_t i = 0; i < irsend->capture.rawlen; i++)
+    irparams.rawbuf[i] = irsend->capture.rawbuf[i];
+  irparams.rawlen = irsend->capture.rawlen;
+  irparams.rcvstate = kStopState;
+}
+
+TEST(TestDoubleBuffer, DecodeSwapsBuffers) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+
+  EXPECT_FALSE(irrecv.decode(&results));  // Nothing captured yet.
+
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  volatile uint16_t *capture_buffer = irparams.rawbuf;
+  captureAsInterrupt(&irsend);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x807F40BF, results.value);
+  // The message was handed over, not copied, and capturing goes on at once.
+  EXPECT_EQ(capture_buffer, results.rawbuf);
+  EXPECT_NE(capture_buffer, irparams.rawbuf);
+  EXPECT_EQ(kIdleState, irparams.rcvstate);
+  EXPECT_EQ(0, irparams.rawlen);
+
+  // The next message arrives before the previous one was released.
+  irsend.reset();
+  irsend.sendNEC(0x20DF10EF);
+  captureAsInterrupt(&irsend);
+  // Its buffer is left alone until the caller is done with the first one.
+  EXPECT_EQ(0x807F40BF, results.value);
+  EXPECT_EQ(kStopState, irparams.rcvstate);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(NEC, results.decode_type);
+  EXPECT_EQ(0x20DF10EF, results.value);
+  EXPECT_NE(capture_buffer, results.rawbuf);
+  EXPECT_EQ(capture_buffer, irparams.rawbuf);  // The first buffer again.
+  EXPECT_EQ(kIdleState, irparams.rcvstate);
+
+  EXPECT_FALSE(irrecv.decode(&results));
+}
+
+TEST(TestDoubleBuffer, ResumeKeepsCaptureInProgress) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1, kRawBuf, kTimeoutMs, true);
+  decode_results results;
+  irsend.begin();
+  irrecv.enableIRIn();
+
+  irsend.reset();
+  irsend.sendSony(0xF50, kSony12Bits);
+  captureAsInterrupt(&irsend);
+  ASSERT_TRUE(irrecv.decode(&results));
+  EXPECT_EQ(SONY, results.decode_type);
+
+  // A new message is half way in when the caller resumes.
+  irparams.rcvstate = kMarkState;
+  irparams.rawlen = 5;
+  irrecv.resume();
+  EXPECT_EQ(kMarkState, irparams.rcvstate);
+  EXPECT_EQ(5, irparams.rawlen);
+  EXPECT_FALSE(irrecv.decode(&results));
+  EXPECT_EQ(kMarkState, irparams.rcvstate);
+}
+
 // Tests for decode().
 
 // Test decode of a NEC message.
@@ -447,6 +523,77 @@ TEST(TestDecode, DecodeAiwa) {
   EXPECT_EQ(0x7F, irsend.capture.value);
 }
 
+// Test the first mark pre-classification used by decode().
+TEST(TestLeadCandidates, FirstMark) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  // Nothing to go by, so everything is a candidate.
+  decode_results empty;
+  empty.rawlen = 0;
+  EXPECT_EQ(UINT64_MAX, irrecv.leadCandidates(&empty));
+
+  // A NEC header rules out the short leading marks, but not the other ~9ms
+  // headers.
+  irsend.reset();
+  irsend.sendNEC(0x807F40BF);
+  irsend.makeDecodeResult();
+  uint64_t nec = irrecv.leadCandidates(&irsend.capture);
+  irsend.reset();
+  irsend.sendSony(0x240, kSony12Bits);
+  irsend.makeDecodeResult();
+  uint64_t sony = irrecv.leadCandidates(&irsend.capture);
+  EXPECT_NE(0, nec);
+  EXPECT_NE(0, sony);
+  EXPECT_EQ(0, nec & sony);
+  irsend.reset();
+  irsend.sendGree(0x1234567890ABCDEF);
+  irsend.makeDecodeResult();
+  EXPECT_NE(0, nec & irrecv.leadCandidates(&irsend.capture));
+
+  // Nothing has a 20ms leading mark.
+  uint16_t long_lead[5] = {20000, 4500, 560, 1690, 560};
+  irsend.reset();
+  irsend.sendRaw(long_lead, 5, 38000);
+  irsend.makeDecodeResult();
+  EXPECT_EQ(0, irrecv.leadCandidates(&irsend.capture));
+}
+
+// Test that skipping decoders by their first mark still gets the decode
+// order right for protocols sharing a header.
+TEST(TestLeadCandidates, SharedHeadersStillDecode) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendSAMSUNG(0xE0E09966);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(SAMSUNG, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendCOOLIX(0xB2BFD0);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(COOLIX, irsend.capture.decode_type);
+
+  irsend.reset();
+  irsend.sendDenon(0x1278, kDenonLegacyBits);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(DENON, irsend.capture.decode_type);
+
+  // A long lead mark still ends up as an UNKNOWN hash.
+  uint16_t long_lead[9] = {20000, 4500, 560, 1690, 560, 560, 560, 1690, 560};
+  irsend.reset();
+  irsend.sendRaw(long_lead, 9, 38000);
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  EXPECT_EQ(UNKNOWN, irsend.capture.decode_type);
+}
+
 // Test matchData() on space encoded data.
 TEST(TestMatchData, SpaceEncoded) {
   IRsendTest irsend(0);
@@ -379,6 +379,72 @@ TEST(TestLowLevelSend, SpaceNoModulation) {
   EXPECT_EQ("[Off]1000usecs", irsend.low_level_sequence);
 }
 
+static uint16_t playbacks_done = 0;
+static void playbackDone(void) { playbacks_done++; }
+
+TEST(TestRecordAndPlayback, Record) {
+  IRsendLowLevelTest irsend(0);
+  uint32_t timings[16];
+
+  irsend.begin();
+  irsend.reset();
+  irsend.record(timings, 16);
+  irsend.sendGeneric(9000, 4500, 560, 1690, 560, 560, 560, 40000,
+                     0b101, 3, 38, true, 0, kDutyDefault);
+  EXPECT_EQ(10, irsend.stopRecord());
+  // Nothing was sent.
+  EXPECT_EQ("", irsend.low_level_sequence);
+  uint32_t expected[10] = {9000, 4500, 560, 1690, 560, 560, 560, 1690,
+                           560, 40000};
+  for (uint16_t i = 0; i < 10; i++) EXPECT_EQ(expected[i], timings[i]);
+
+  // A leading space gets an empty mark, and like kinds are merged.
+  irsend.record(timings, 16);
+  irsend.space(100);
+  irsend.space(200);
+  irsend.mark(300);
+  irsend.mark(400);
+  EXPECT_EQ(3, irsend.stopRecord());
+  EXPECT_EQ(0, timings[0]);
+  EXPECT_EQ(300, timings[1]);
+  EXPECT_EQ(700, timings[2]);
+
+  // Too much to fit.
+  irsend.record(timings, 4);
+  irsend.sendGeneric(9000, 4500, 560, 1690, 560, 560, 560, 40000,
+                     0b101, 3, 38, true, 0, kDutyDefault);
+  EXPECT_EQ(0, irsend.stopRecord());
+  EXPECT_FALSE(irsend.playback());
+}
+
+TEST(TestRecordAndPlayback, PlaybackMatchesSending) {
+  IRsendLowLevelTest direct(0);
+  IRsendLowLevelTest irsend(0);
+  uint32_t timings[16];
+
+  direct.begin();
+  direct.reset();
+  direct.sendGeneric(9000, 4500, 560, 1690, 560, 560, 560, 40000,
+                     0b101, 3, 38, true, 0, kDutyDefault);
+
+  irsend.begin();
+  irsend.reset();
+  EXPECT_FALSE(irsend.playback());  // Nothing recorded yet.
+  irsend.record(timings, 16);
+  irsend.sendGeneric(9000, 4500, 560, 1690, 560, 560, 560, 40000,
+                     0b101, 3, 38, true, 0, kDutyDefault);
+  playbacks_done = 0;
+  EXPECT_TRUE(irsend.playback(playbackDone));  // Also stops the recording.
+  EXPECT_EQ(1, playbacks_done);
+  EXPECT_FALSE(irsend.busy());
+  EXPECT_EQ(direct.low_level_sequence, irsend.low_level_sequence);
+
+  // It can be played back again.
+  irsend.reset();
+  EXPECT_TRUE(irsend.playback());
+  EXPECT_EQ(direct.low_level_sequence, irsend.low_level_sequence);
+}
+
 // Test expected to work/produce a message for simple irsend:send()
 TEST(TestSend, GenericSimpleSendMethod) {
   IRsendTest irsend(0);
@@ -102,6 +102,7 @@ class IRsendTest : public IRsend {
   void addGap(uint32_t usecs) { space(usecs); }
 
   uint16_t mark(uint16_t usec) {
+    if (isRecording()) return IRsend::mark(usec);
     IRtimer::add(usec);
     if (last >= OUTPUT_BUF) return 0;
     if (last & 1)  // Is odd? (i.e. last call was a space())
@@ -114,6 +115,7 @@ class IRsendTest : public IRsend {
   }
 
   void space(uint32_t time) {
+    if (isRecording()) return IRsend::space(time);
     IRtimer::add(time);
     if (last >= OUTPUT_BUF) return;
     if (last & 1) {  // Is odd? (i.e. last call was a space())
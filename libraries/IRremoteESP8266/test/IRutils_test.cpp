@@ -333,6 +333,54 @@ TEST(TestResultToHumanReadableBasic, ComplexCodes) {
       resultToHumanReadableBasic(&irsend.capture));
 }
 
+TEST(TestResultToHumanReadableBasic, CallersBuffer) {
+  IRsendTest irsend(0);
+  IRrecv irrecv(1);
+  irsend.begin();
+
+  irsend.reset();
+  irsend.sendNEC(irsend.encodeNEC(0x10, 0x20));
+  irsend.makeDecodeResult();
+  ASSERT_TRUE(irrecv.decode(&irsend.capture));
+  char buf[64];
+  IRtext text(buf, sizeof(buf));
+  resultToHumanReadableBasic(&irsend.capture, &text);
+  EXPECT_STREQ(
+      "Encoding  : NEC\n"
+      "Code      : 8F704FB (32 bits)\n", buf);
+  EXPECT_EQ(strlen(buf), text.length());
+  EXPECT_FALSE(text.truncated());
+}
+
+TEST(TestIRtext, Buffer) {
+  char buf[8];
+  IRtext text(buf, sizeof(buf));
+  EXPECT_STREQ("", buf);
+  text += "Temp: ";
+  text.addNum(5, 10, 2);
+  EXPECT_STREQ("Temp: 0", buf);  // Truncated, but still terminated.
+  EXPECT_EQ(8, text.length());
+  EXPECT_TRUE(text.truncated());
+
+  char hex[20];
+  IRtext num(hex, sizeof(hex));
+  num.addNum(0xA, 16, 2);
+  num += ',';
+  num.addNum(UINT64_MAX, 16);
+  EXPECT_STREQ("0A,FFFFFFFFFFFFFFFF", hex);
+  EXPECT_FALSE(num.truncated());
+}
+
+TEST(TestIRtext, String) {
+  String str = "Mode: ";
+  IRtext text(&str);
+  text.addNum(3);
+  text += String(" (HEAT)");
+  EXPECT_EQ("Mode: 3 (HEAT)", str);
+  EXPECT_EQ(8, text.length());
+  EXPECT_FALSE(text.truncated());
+}
+
 TEST(TestInvertBits, Normal) {
   ASSERT_EQ(0xAAAA5555AAAA5555, invertBits(0x5555AAAA5555AAAA, 64));
   ASSERT_EQ(0xAAAA5555, invertBits(0x5555AAAA, 32));
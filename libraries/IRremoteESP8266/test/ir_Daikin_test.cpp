@@ -727,6 +727,24 @@ TEST(TestDaikinClass, HumanReadable) {
       ac.toString());
 }
 
+// Test human readable output straight into a caller's buffer.
+TEST(TestDaikinClass, HumanReadableIntoBuffer) {
+  IRDaikinESP ac(0);
+  ac.setCurrentTime(9 * 60 + 5);
+  char buf[300];
+  IRtext text(buf, sizeof(buf));
+  ac.toString(&text);
+  EXPECT_EQ(ac.toString(), buf);
+  EXPECT_FALSE(text.truncated());
+
+  char small[12];
+  IRtext part(small, sizeof(small));
+  ac.toString(&part);
+  EXPECT_STREQ("Power: On, ", small);
+  EXPECT_TRUE(part.truncated());
+  EXPECT_EQ(ac.toString().length(), part.length());
+}
+
 // Test general message construction after tweaking some settings.
 TEST(TestDaikinClass, MessageConstuction) {
   IRDaikinESP ac(0);
@@ -1,5 +1,6 @@
 // Copyright 2017 David Conran
 
+#include <string>
 #include "IRsend.h"
 #include "IRsend_test.h"
 #include "gtest/gtest.h"
@@ -71,3 +72,49 @@ TEST(TestSendGlobalCache, RepeatCode) {
       "m8866s2210m546s94822",
       irsend.outputStr());
 }
+
+// Tests for parseGC() & sendGC() of text.
+
+TEST(TestSendGlobalCache, FromText) {
+  IRsendTest irsend(4);
+  irsend.begin();
+
+  // Sherwood (NEC-like) "Power On" from Global Cache with 2 repeats, as in
+  // RepeatCode.
+  uint16_t gc_test[75] = {
+      38000, 2,  69, 341, 171, 21, 64, 21, 64, 21, 21,   21,  21, 21, 21,
+      21,    21, 21, 21,  21,  64, 21, 64, 21, 21, 21,   64,  21, 21, 21,
+      21,    21, 21, 21,  64,  21, 21, 21, 64, 21, 21,   21,  21, 21, 21,
+      21,    64, 21, 21,  21,  21, 21, 21, 21, 21, 21,   64,  21, 64, 21,
+      64,    21, 21, 21,  64,  21, 64, 21, 64, 21, 1600, 341, 85, 21, 3647};
+  const char *gc_text =
+      "38000,2,69,341,171,21,64,21,64,21,21,21,21,21,21,21,21,21,21,21,64,21,"
+      "64,21,21,21,64,21,21,21,21,21,21,21,64,21,21,21,64,21,21,21,21,21,21,"
+      "21,64,21,21,21,21,21,21,21,21,21,64,21,64,21,64,21,21,21,64,21,64,21,"
+      "64,21,1600,341,85,21,3647";
+  uint32_t timings[100];
+
+  irsend.reset();
+  irsend.sendGC(gc_test, 75);
+  std::string expected = irsend.outputStr();
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendGC(gc_text, timings, 100));
+  EXPECT_EQ(expected, irsend.outputStr());
+
+  // A whole command, with spaces.
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendGC((std::string("sendir,1:1,1, ") + gc_text).c_str(),
+                            timings, 100));
+  EXPECT_EQ(expected, irsend.outputStr());
+
+  uint32_t hz;
+  EXPECT_EQ(76, irsend.parseGC(gc_text, timings, 100, &hz));
+  EXPECT_EQ(38000, hz);
+  // Doesn't fit.
+  EXPECT_EQ(0, irsend.parseGC(gc_text, timings, 75, &hz));
+  // Not a number.
+  EXPECT_EQ(0, irsend.parseGC("38000,1,1,341,17a,21", timings, 100, &hz));
+  // Nothing to send.
+  EXPECT_EQ(0, irsend.parseGC("38000,1,1", timings, 100, &hz));
+  EXPECT_EQ(0, irsend.parseGC("38000,0,1,341,171", timings, 100, &hz));
+}
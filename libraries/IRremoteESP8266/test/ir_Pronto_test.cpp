@@ -366,3 +366,81 @@ TEST(TestSendPronto, NormalPlusRepeatSequence) {
       "m8892s2210m546s95212",
       irsend.outputStr());
 }
+
+// Tests for parsePronto() & sendPronto() of text.
+
+TEST(TestSendPronto, FromText) {
+  IRsendTest irsend(4);
+  irsend.begin();
+
+  // NEC 32 bit power on command, as in NormalPlusRepeatSequence.
+  uint16_t pronto_test[76] = {
+      0x0000, 0x006D, 0x0022, 0x0002, 0x0156, 0x00AB, 0x0015, 0x0015, 0x0015,
+      0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0015,
+      0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015,
+      0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0040, 0x0015, 0x0040,
+      0x0015, 0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015,
+      0x0040, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015, 0x0015,
+      0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0015, 0x0015,
+      0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x0040, 0x0015, 0x05FD,
+      0x0156, 0x0055, 0x0015, 0x0E4E};
+  const char *pronto_text =
+      "0000 006D 0022 0002 0156 00AB 0015 0015 0015 0015 0015 0015 0015 0040\n"
+      "0015 0040 0015 0015 0015 0015 0015 0015 0015 0040 0015 0040 0015 0040\n"
+      "0015 0015 0015 0015 0015 0040 0015 0040 0015 0040 0015 0015 0015 0015\n"
+      "0015 0015 0015 0040 0015 0015 0015 0015 0015 0015 0015 0015 0015 0040\n"
+      "0015 0040 0015 0040 0015 0015 0015 0040 0015 0040 0015 0040 0015 0040\n"
+      "0015 05fd 0156 0055 0015 0e4e";
+  uint32_t timings[300];
+
+  for (uint16_t repeat = 0; repeat < 3; repeat++) {
+    irsend.reset();
+    irsend.sendPronto(pronto_test, 76, repeat);
+    std::string expected = irsend.outputStr();
+    irsend.reset();
+    EXPECT_TRUE(irsend.sendPronto(pronto_text, timings, 300, repeat));
+    EXPECT_EQ(expected, irsend.outputStr());
+  }
+  uint32_t hz;
+  EXPECT_EQ(68, irsend.parsePronto(pronto_text, timings, 300, &hz));
+  EXPECT_EQ(38028, hz);
+  EXPECT_EQ(72, irsend.parsePronto(pronto_text, timings, 300, &hz, 1));
+
+  // Only the 2nd/repeat sequence: it is sent at least once.
+  irsend.reset();
+  EXPECT_TRUE(irsend.sendPronto("0000 006D 0000 0002 0156 0055 0015 0E4E",
+                                timings, 300));
+  EXPECT_EQ("f38028d50m8892s2210m546s95212", irsend.outputStr());
+}
+
+TEST(TestSendPronto, FromBadText) {
+  IRsendTest irsend(4);
+  irsend.begin();
+  irsend.reset();
+  uint32_t timings[8];
+  uint32_t hz;
+
+  // Too short.
+  EXPECT_EQ(0, irsend.parsePronto("0000 0067 0034 0000 0000", timings, 8,
+                                  &hz));
+  // The sequences are declared longer than the data.
+  EXPECT_EQ(0, irsend.parsePronto("0000 0067 0010 0000 0000 0000", timings, 8,
+                                  &hz));
+  // Not a raw code.
+  EXPECT_EQ(0, irsend.parsePronto("0100 0067 0001 0000 0001 0002", timings, 8,
+                                  &hz));
+  // Not hexadecimal, or more than 16 bits.
+  EXPECT_EQ(0, irsend.parsePronto("0000 0067 0001 0000 00x1 0002", timings, 8,
+                                  &hz));
+  EXPECT_EQ(0, irsend.parsePronto("0000 0067 0001 0000 10001 0002", timings, 8,
+                                  &hz));
+  // Doesn't fit.
+  EXPECT_EQ(0, irsend.parsePronto("0000 0067 0005 0000 1 2 3 4 5 6 7 8 9 A",
+                                  timings, 8, &hz));
+  EXPECT_FALSE(irsend.sendPronto("0000 0067 0005 0000 1 2 3 4 5 6 7 8 9 A",
+                                 timings, 8));
+  EXPECT_EQ("", irsend.outputStr());
+  // More data than needed is ignored.
+  EXPECT_EQ(2, irsend.parsePronto("0000 0067 0001 0000 0001 0002 0003 0004",
+                                  timings, 8, &hz));
+}
@@ -0,0 +1,524 @@
+// Copyright 2019 David Conran
+//
+// Analyse a large batch of raw IR captures of an unknown protocol in one go.
+//
+// auto_analyse_raw_data.py looks at one capture at a time. This instead pools
+// the mark & space timings of every capture it is given, clusters each pool
+// with a k-means, and from the clusters guesses the header & bit timings, the
+// message gaps, the nr. of bits, and the kXyz constants for a new protocol.
+// With many captures the noise in any one of them averages out.
+//
+// Usage:
+//   ./raw_analyse [-r range] [-a] [file ...]
+//     -r range  Max nr. of usecs between timings to start them off in the
+//               same cluster. (Default: 200)
+//     -a        Also analyse the captures the library can already decode.
+//   It reads stdin when no files are given.
+//
+// Input is any number of `uint16_t rawData[N] = {...};` declarations, as
+// output by IRrecvDumpV2. Anything outside of the braces is ignored.
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "IRrecv.h"
+#include "IRsend.h"
+#include "IRsend_test.h"
+#include "IRutils.h"
+
+const uint32_t kDefaultRange = 200;  // usecs. Same as auto_analyse_raw_data.py
+const uint16_t kMaxIterations = 100;
+const uint16_t kMaxExamples = 10;
+// A cluster needs at least this many timings per capture to be treated as a
+// regular part of the message. e.g. A header, rather than some noise.
+const double kRegular = 0.5;
+
+typedef std::vector<uint32_t> timings_t;
+
+struct cluster_t {
+  double centre;
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  double stddev;
+};
+
+// What each timing in a capture turned out to be.
+enum part_t { kUnknown, kHdrMark, kHdrSpace, kBitMark, kBitSpace, kZero, kOne,
+              kGap };
+
+struct guess_t {
+  bool space_encoded;
+  int16_t hdr_mark;  // Cluster indexes. -1 means none found.
+  int16_t hdr_space;
+  int16_t bit_mark;
+  int16_t bit_space;  // Mark encoded only.
+  int16_t zero;
+  int16_t one;
+  std::vector<int16_t> gaps;
+};
+
+// Add all the rawData declarations found in the input to the captures.
+void parseCaptures(std::istream &input, std::vector<timings_t> *captures) {
+  bool inside = false;
+  bool in_number = false;
+  uint32_t number = 0;
+  timings_t timings;
+  char c;
+  while (input.get(c)) {
+    if (!inside) {
+      if (c == '{') {
+        inside = true;
+        timings.clear();
+      }
+      continue;
+    }
+    if (c >= '0' && c <= '9') {
+      number = number * 10 + (c - '0');
+      in_number = true;
+      continue;
+    }
+    if (in_number) timings.push_back(number);
+    in_number = false;
+    number = 0;
+    if (c == '}') {
+      inside = false;
+      if (timings.size() > 3) captures->push_back(timings);
+    }
+  }
+}
+
+// Try to decode a capture with the library.
+decode_type_t knownProtocol(IRsendTest *irsend, IRrecv *irrecv,
+                            const timings_t &timings) {
+  irsend->reset();
+  for (size_t i = 0; i < timings.size(); i++)
+    if (i % 2)
+      irsend->space(timings[i]);
+    else
+      irsend->mark(timings[i]);
+  irsend->makeDecodeResult();
+  if (!irrecv->decode(&irsend->capture)) return decode_type_t::UNKNOWN;
+  return irsend->capture.decode_type;
+}
+
+// Split the sorted values wherever they jump by more than `range`, like
+// auto_analyse_raw_data.py does. The centres of those are the k-means seeds.
+std::vector<double> seedCentres(const std::vector<float> &sorted,
+                                const uint32_t range) {
+  std::vector<double> centres;
+  double sum = 0;
+  uint32_t count = 0;
+  for (size_t i = 0; i < sorted.size(); i++) {
+    if (count && sorted[i] - sorted[i - 1] > range) {
+      centres.push_back(sum / count);
+      sum = 0;
+      count = 0;
+    }
+    sum += sorted[i];
+    count++;
+  }
+  if (count) centres.push_back(sum / count);
+  return centres;
+}
+
+// Which cluster does each value belong to?
+// The centres are kept sorted, so that is simply the nr. of midpoints between
+// centres that the value is above. Doing one midpoint at a time over the
+// whole contiguous array is branch free, so the compiler vectorises it.
+void assign(const std::vector<float> &values, const std::vector<double> &centres,
+            std::vector<uint16_t> *label) {
+  const size_t n = values.size();
+  const float *v = values.data();
+  uint16_t *l = label->data();
+  for (size_t i = 0; i < n; i++) l[i] = 0;
+  for (size_t k = 1; k < centres.size(); k++) {
+    const float mid = (centres[k - 1] + centres[k]) / 2;
+    for (size_t i = 0; i < n; i++) l[i] += (v[i] > mid);
+  }
+}
+
+// Split any cluster that is really two, i.e. where the best split of it into
+// two has centres more than `range` apart. The seeds can miss those when
+// noise fills the space between two timings.
+// Returns:
+//   Whether any cluster was split.
+bool splitCentres(const std::vector<float> &sorted,
+                  const std::vector<uint16_t> &label, const uint32_t range,
+                  std::vector<double> *centres) {
+  std::vector<double> result;
+  bool split = false;
+  for (size_t lo = 0, hi; lo < sorted.size(); lo = hi) {
+    for (hi = lo; hi < sorted.size() && label[hi] == label[lo]; hi++) {}
+    // Find the split with the smallest sum of squared errors, which is the
+    // one with the largest weighted spread of the two means.
+    double total = 0;
+    for (size_t i = lo; i < hi; i++) total += sorted[i];
+    double left = 0, best = -1, best_left = 0, best_right = 0;
+    for (size_t i = lo + 1; i < hi; i++) {
+      left += sorted[i - 1];
+      const double n_left = i - lo, n_right = hi - i;
+      const double mean_left = left / n_left;
+      const double mean_right = (total - left) / n_right;
+      const double score = n_left * n_right * (mean_right - mean_left) *
+          (mean_right - mean_left) / (n_left + n_right);
+      if (score > best) {
+        best = score;
+        best_left = mean_left;
+        best_right = mean_right;
+      }
+    }
+    if (best >= 0 && best_right - best_left > range) {
+      result.push_back(best_left);
+      result.push_back(best_right);
+      split = true;
+    } else {
+      result.push_back(total / (hi - lo));
+    }
+  }
+  *centres = result;
+  return split;
+}
+
+// Lloyd's k-means, on one dimension.
+// Returns:
+//   The clusters, in ascending order of their centre.
+std::vector<cluster_t> kMeans(const timings_t &timings, const uint32_t range) {
+  std::vector<float> values(timings.begin(), timings.end());
+  std::sort(values.begin(), values.end());
+  std::vector<double> centres = seedCentres(values, range);
+  std::vector<uint16_t> label(values.size());
+  std::vector<double> sum(centres.size());
+  std::vector<uint32_t> count(centres.size());
+  for (uint16_t iter = 0; iter < kMaxIterations; iter++) {
+    assign(values, centres, &label);
+    std::fill(sum.begin(), sum.end(), 0);
+    std::fill(count.begin(), count.end(), 0);
+    for (size_t i = 0; i < values.size(); i++) {
+      sum[label[i]] += values[i];
+      count[label[i]]++;
+    }
+    bool moved = false;
+    for (size_t k = 0; k < centres.size(); k++) {
+      if (!count[k]) continue;  // Leave empty ones be. They're dropped below.
+      double centre = sum[k] / count[k];
+      if (fabs(centre - centres[k]) >= 0.5) moved = true;
+      centres[k] = centre;
+    }
+    if (moved) continue;
+    // Converged. Done, unless some cluster needs splitting.
+    if (!splitCentres(values, label, range, &centres)) break;
+    sum.resize(centres.size());
+    count.resize(centres.size());
+  }
+  assign(values, centres, &label);
+  std::vector<cluster_t> clusters(centres.size());
+  for (size_t k = 0; k < centres.size(); k++) {
+    clusters[k].centre = centres[k];
+    clusters[k].count = 0;
+    clusters[k].min = UINT32_MAX;
+    clusters[k].max = 0;
+    clusters[k].stddev = 0;
+  }
+  for (size_t i = 0; i < values.size(); i++) {
+    cluster_t *c = &clusters[label[i]];
+    c->count++;
+    c->min = std::min(c->min, (uint32_t)values[i]);
+    c->max = std::max(c->max, (uint32_t)values[i]);
+    c->stddev += (values[i] - c->centre) * (values[i] - c->centre);
+  }
+  std::vector<cluster_t> result;
+  for (size_t k = 0; k < clusters.size(); k++) {
+    if (!clusters[k].count) continue;
+    clusters[k].stddev = sqrt(clusters[k].stddev / clusters[k].count);
+    result.push_back(clusters[k]);
+  }
+  return result;
+}
+
+// The index of the cluster with the nearest centre.
+int16_t nearest(const std::vector<cluster_t> &clusters, const uint32_t usecs) {
+  int16_t best = 0;
+  for (size_t k = 1; k < clusters.size(); k++)
+    if (fabs(clusters[k].centre - usecs) < fabs(clusters[best].centre - usecs))
+      best = k;
+  return best;
+}
+
+// The index of the most used cluster, ignoring some. -1 if none are left.
+int16_t mostUsed(const std::vector<cluster_t> &clusters,
+                 const std::vector<int16_t> &ignore) {
+  int16_t best = -1;
+  for (size_t k = 0; k < clusters.size(); k++) {
+    if (std::find(ignore.begin(), ignore.end(), k) != ignore.end()) continue;
+    if (best < 0 || clusters[k].count > clusters[best].count) best = k;
+  }
+  return best;
+}
+
+// Work out which cluster is which part of the protocol.
+guess_t guessParts(const std::vector<cluster_t> &marks,
+                   const std::vector<cluster_t> &spaces,
+                   const size_t nr_captures) {
+  guess_t guess;
+  guess.hdr_mark = -1;
+  guess.hdr_space = -1;
+  guess.bit_space = -1;
+  // The bits make up most of a message, so their timings are the most used.
+  guess.bit_mark = mostUsed(marks, {});
+  int16_t mark2 = mostUsed(marks, {guess.bit_mark});
+  int16_t space1 = mostUsed(spaces, {});
+  int16_t space2 = mostUsed(spaces, {space1});
+  // Whichever of the two has a second, frequent, timing carries the data.
+  uint32_t mark2_count = mark2 >= 0 ? marks[mark2].count : 0;
+  uint32_t space2_count = space2 >= 0 ? spaces[space2].count : 0;
+  guess.space_encoded = space2_count >= mark2_count;
+  std::vector<int16_t> used_marks = {guess.bit_mark};
+  std::vector<int16_t> used_spaces;
+  if (guess.space_encoded) {
+    guess.zero = std::min(space1, space2);  // Clusters are in usecs order.
+    guess.one = std::max(space1, space2);
+    used_spaces = {space1, space2};
+  } else {
+    guess.zero = std::min(guess.bit_mark, mark2);
+    guess.one = std::max(guess.bit_mark, mark2);
+    guess.bit_mark = -1;
+    guess.bit_space = space1;
+    used_marks = {mark2, guess.zero, guess.one};
+    used_spaces = {space1};
+  }
+  // A header is a regular mark longer than the bits, & the space after it.
+  int16_t hdr = mostUsed(marks, used_marks);
+  if (hdr >= 0 && hdr > std::max(guess.zero, guess.bit_mark) &&
+      marks[hdr].count >= kRegular * nr_captures) {
+    guess.hdr_mark = hdr;
+    int16_t hdr_space = mostUsed(spaces, used_spaces);
+    if (hdr_space >= 0 && spaces[hdr_space].count >= kRegular * nr_captures) {
+      guess.hdr_space = hdr_space;
+      used_spaces.push_back(hdr_space);
+    }
+  }
+  // Any other regular space longer than the bits is a gap.
+  for (size_t k = 0; k < spaces.size(); k++)
+    if (std::find(used_spaces.begin(), used_spaces.end(), k) ==
+            used_spaces.end() &&
+        (int16_t)k > std::max(guess.one, guess.bit_space) &&
+        spaces[k].count >= kRegular * nr_captures)
+      guess.gaps.push_back(k);
+  return guess;
+}
+
+// Break a capture up into its parts, and collect the data bits.
+// Returns:
+//   A description of the layout of the message. e.g. "H 32 G H 32"
+std::string decodeCapture(const timings_t &timings,
+                          const std::vector<cluster_t> &marks,
+                          const std::vector<cluster_t> &spaces,
+                          const guess_t &guess, std::string *bits) {
+  std::string layout;
+  uint16_t nbits = 0;
+  for (size_t i = 0; i < timings.size(); i++) {
+    int16_t k = nearest(i % 2 ? spaces : marks, timings[i]);
+    part_t part = kUnknown;
+    if (i % 2 == 0) {
+      if (k == guess.hdr_mark) part = kHdrMark;
+      else if (k == guess.bit_mark) part = kBitMark;
+      else if (!guess.space_encoded && k == guess.zero) part = kZero;
+      else if (!guess.space_encoded && k == guess.one) part = kOne;
+    } else {
+      if (k == guess.hdr_space) part = kHdrSpace;
+      else if (k == guess.bit_space) part = kBitSpace;
+      else if (guess.space_encoded && k == guess.zero) part = kZero;
+      else if (guess.space_encoded && k == guess.one) part = kOne;
+      else if (std::find(guess.gaps.begin(), guess.gaps.end(), k) !=
+               guess.gaps.end()) part = kGap;
+    }
+    if (part == kZero || part == kOne) {
+      *bits += (part == kOne) ? '1' : '0';
+      nbits++;
+      continue;
+    }
+    if (part == kBitMark || part == kBitSpace || part == kHdrSpace) continue;
+    if (nbits) layout += " " + std::to_string(nbits);
+    nbits = 0;
+    if (part == kHdrMark) layout += " Header";
+    else if (part == kGap) layout += " Gap";
+    else if (part == kUnknown) layout += " ?";
+  }
+  if (nbits) layout += " " + std::to_string(nbits);
+  return layout.empty() ? layout : layout.substr(1);
+}
+
+// Display a string of bits in hex. MSB first, padded on the left.
+std::string bitsToHex(const std::string &bits) {
+  std::string hex;
+  size_t pad = (4 - bits.size() % 4) % 4;
+  std::string padded = std::string(pad, '0') + bits;
+  for (size_t i = 0; i < padded.size(); i += 4)
+    hex += "0123456789ABCDEF"[std::stoi(padded.substr(i, 4), nullptr, 2)];
+  return hex;
+}
+
+void printClusters(const char *name, const std::vector<cluster_t> &clusters) {
+  std::cout << name << " clusters (usecs):" << std::endl
+            << "   centre    count      min      max   stddev" << std::endl;
+  for (size_t k = 0; k < clusters.size(); k++)
+    printf("  %7.0f  %7" PRIu32 "  %7" PRIu32 "  %7" PRIu32 "  %7.1f\n",
+           clusters[k].centre, clusters[k].count, clusters[k].min,
+           clusters[k].max, clusters[k].stddev);
+}
+
+// The worst percentage difference of a cluster's members from its centre.
+double deviation(const cluster_t &cluster) {
+  return 100.0 * std::max(cluster.centre - cluster.min,
+                          cluster.max - cluster.centre) / cluster.centre;
+}
+
+void constant(const char *name, const cluster_t &cluster, double *worst) {
+  printf("const uint16_t kXyz%s = %.0f;\n", name, cluster.centre);
+  *worst = std::max(*worst, deviation(cluster));
+}
+
+void usage_error(char *name) {
+  std::cerr << "Usage: " << name << " [-r range] [-a] [file ...]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  uint32_t range = kDefaultRange;
+  bool all = false;
+  std::vector<timings_t> captures;
+  bool read_file = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+      range = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-a") == 0) {
+      all = true;
+    } else if (argv[i][0] == '-') {
+      usage_error(argv[0]);
+      return 1;
+    } else {
+      std::ifstream file(argv[i]);
+      if (!file) {
+        std::cerr << "Can't read " << argv[i] << std::endl;
+        return 1;
+      }
+      parseCaptures(file, &captures);
+      read_file = true;
+    }
+  }
+  if (!read_file) parseCaptures(std::cin, &captures);
+
+  // Put the captures we can already decode to one side.
+  static IRsendTest irsend(0);  // Too big for the stack.
+  IRrecv irrecv(0);
+  std::map<decode_type_t, uint32_t> known;
+  std::vector<timings_t> unknown;
+  for (size_t i = 0; i < captures.size(); i++) {
+    decode_type_t protocol = knownProtocol(&irsend, &irrecv, captures[i]);
+    if (protocol != decode_type_t::UNKNOWN) known[protocol]++;
+    if (protocol == decode_type_t::UNKNOWN || all)
+      unknown.push_back(captures[i]);
+  }
+  std::cout << "Read " << captures.size() << " captures." << std::endl;
+  for (auto it = known.begin(); it != known.end(); it++)
+    std::cout << "  " << it->second << " decode as "
+              << typeToString(it->first) << std::endl;
+  if (unknown.empty()) {
+    std::cout << "Nothing left to analyse." << std::endl;
+    return 0;
+  }
+  std::cout << "Analysing " << unknown.size() << " of them." << std::endl
+            << std::endl;
+
+  timings_t mark_pool, space_pool;
+  for (size_t i = 0; i < unknown.size(); i++)
+    for (size_t j = 0; j < unknown[i].size(); j++)
+      (j % 2 ? space_pool : mark_pool).push_back(unknown[i][j]);
+  std::vector<cluster_t> marks = kMeans(mark_pool, range);
+  std::vector<cluster_t> spaces = kMeans(space_pool, range);
+  printClusters("Mark", marks);
+  printClusters("Space", spaces);
+  if (spaces.size() < 1 || marks.size() + spaces.size() < 3) {
+    std::cout << std::endl << "Too few different timings to analyse."
+              << std::endl;
+    return 1;
+  }
+
+  guess_t guess = guessParts(marks, spaces, unknown.size());
+  std::cout << std::endl << "Looks like it uses "
+            << (guess.space_encoded ? "space" : "mark") << " encoding."
+            << std::endl;
+
+  // Decode every capture with those guesses, & find the usual layout.
+  std::map<std::string, uint32_t> layouts;
+  std::map<std::string, uint32_t> messages;
+  for (size_t i = 0; i < unknown.size(); i++) {
+    std::string bits;
+    layouts[decodeCapture(unknown[i], marks, spaces, guess, &bits)]++;
+    messages[bits]++;
+  }
+  std::string layout;
+  uint32_t layout_count = 0;
+  for (auto it = layouts.begin(); it != layouts.end(); it++)
+    if (it->second > layout_count) {
+      layout = it->first;
+      layout_count = it->second;
+    }
+  std::cout << "Message layout: " << layout << "  (" << layout_count << " of "
+            << unknown.size() << " captures)" << std::endl;
+  std::vector<std::pair<uint32_t, std::string>> common;
+  for (auto it = messages.begin(); it != messages.end(); it++)
+    common.push_back(std::make_pair(it->second, it->first));
+  std::sort(common.rbegin(), common.rend());
+  std::cout << "Most common messages (MSB first):" << std::endl;
+  for (size_t i = 0; i < common.size() && i < kMaxExamples; i++)
+    std::cout << "  0x" << bitsToHex(common[i].second) << "  x"
+              << common[i].first << std::endl;
+
+  // Total up the bits in the usual layout.
+  uint16_t nbits = 0;
+  for (size_t pos = 0; pos < layout.size();) {
+    size_t end = layout.find(' ', pos);
+    if (end == std::string::npos) end = layout.size();
+    std::string part = layout.substr(pos, end - pos);
+    if (isdigit(part[0])) nbits += std::stoi(part);
+    pos = end + 1;
+  }
+
+  std::cout << std::endl << "Guessing key values:" << std::endl;
+  double worst = 0;
+  if (guess.hdr_mark >= 0) constant("HdrMark", marks[guess.hdr_mark], &worst);
+  if (guess.hdr_space >= 0)
+    constant("HdrSpace", spaces[guess.hdr_space], &worst);
+  if (guess.space_encoded) {
+    constant("BitMark", marks[guess.bit_mark], &worst);
+    constant("OneSpace", spaces[guess.one], &worst);
+    constant("ZeroSpace", spaces[guess.zero], &worst);
+  } else {
+    constant("OneMark", marks[guess.one], &worst);
+    constant("ZeroMark", marks[guess.zero], &worst);
+    constant("BitSpace", spaces[guess.bit_space], &worst);
+  }
+  for (size_t i = 0; i < guess.gaps.size(); i++) {
+    std::string name = "SpaceGap";
+    if (guess.gaps.size() > 1) name += std::to_string(i + 1);
+    constant(name.c_str(), spaces[guess.gaps[i]], &worst);
+  }
+  printf("const uint16_t kXyzBits = %u;\n", nbits);
+  if (nbits > 64) printf("const uint16_t kXyzStateLength = %u;\n", nbits / 8);
+  printf("// Worst timing seen is %.0f%% off its value. ", worst);
+  if (worst < kTolerance)
+    printf("The default kTolerance (%u%%) will do.\n", kTolerance);
+  else
+    printf("Needs a tolerance above the default (%u%%).\n", kTolerance);
+  return 0;
+}
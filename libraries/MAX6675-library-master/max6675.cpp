@@ -8,12 +8,17 @@
 #endif
 #include <util/delay.h>
 #include <stdlib.h>
+#include <SPI.h>
 #include "max6675.h"
 
+// The MAX6675 clocks out data at up to 4.3 MHz
+#define MAX6675_SPI_CLOCK 4000000
+
 MAX6675::MAX6675(int8_t SCLK, int8_t CS, int8_t MISO) {
   sclk = SCLK;
   cs = CS;
   miso = MISO;
+  hwSPI = false;
 
   //define pin modes
   pinMode(cs, OUTPUT);
@@ -22,10 +27,30 @@ MAX6675::MAX6675(int8_t SCLK, int8_t CS, int8_t MISO) {
 
   digitalWrite(cs, HIGH);
 }
-double MAX6675::readCelsius(void) {
 
+MAX6675::MAX6675(int8_t CS) {
+  sclk = -1;
+  cs = CS;
+  miso = -1;
+  hwSPI = true;
+
+  pinMode(cs, OUTPUT);
+  digitalWrite(cs, HIGH);
+  SPI.begin();
+}
+
+uint16_t MAX6675::readFrame(void) {
   uint16_t v;
 
+  if (hwSPI) {
+    SPI.beginTransaction(SPISettings(MAX6675_SPI_CLOCK, MSBFIRST, SPI_MODE0));
+    digitalWrite(cs, LOW);
+    v = SPI.transfer16(0);
+    digitalWrite(cs, HIGH);
+    SPI.endTransaction();
+    return v;
+  }
+
   digitalWrite(cs, LOW);
   _delay_ms(1);
 
@@ -34,6 +59,12 @@ double MAX6675::readCelsius(void) {
   v |= spiread();
 
   digitalWrite(cs, HIGH);
+  return v;
+}
+
+double MAX6675::readCelsius(void) {
+
+  uint16_t v = readFrame();
 
   if (v & 0x4) {
     // uh oh, no thermocouple attached!
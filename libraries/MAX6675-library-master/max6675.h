@@ -10,6 +10,8 @@
 class MAX6675 {
  public:
   MAX6675(int8_t SCLK, int8_t CS, int8_t MISO);
+  // Hardware SPI: reads the 16-bit frame in a single transaction
+  MAX6675(int8_t CS);
 
   double readCelsius(void);
   double readFahrenheit(void);
@@ -17,5 +19,7 @@ class MAX6675 {
   double readFarenheit(void) { return readFahrenheit(); }
  private:
   int8_t sclk, miso, cs;
+  bool hwSPI;
   uint8_t spiread(void);
+  uint16_t readFrame(void);
 };
@@ -0,0 +1,303 @@
+// Benchmark of the RFM69 library between two nodes, one built with BENCH_MASTER 1
+// and the other with BENCH_MASTER 0. It speaks the same little protocol as the
+// RadioHead rh_benchmark example and prints the same lines, so the two stacks
+// can be compared on the same modules.
+//
+// For every bitrate in the table the master measures
+//   rtt_*_us   ping-pong round trip of a BENCH_PAYLOAD byte message
+//   ping_lost  pings without an answer
+//   tx_pps     packets/s it can send back to back (send() includes the CSMA wait)
+//   rx_pps     of those, packets/s the other node got
+//   rx_Bps     payload bytes/s the other node got
+//   cpu_us     CPU time the receiving node spends per packet, interrupt included:
+//              how much a busy loop there slows down during the flood
+// and prints them on Serial as CSV, one metric per line:
+//   stack,driver,config,payload,metric,value
+// The first config in the table is also the control channel both nodes go back
+// to between tests.
+// **********************************************************************************
+// License
+// **********************************************************************************
+// This program is free software; you can redistribute it 
+// and/or modify it under the terms of the GNU General    
+// Public License as published by the Free Software       
+// Foundation; either version 3 of the License, or        
+// (at your option) any later version.                    
+//                                                        
+// This program is distributed in the hope that it will   
+// be useful, but WITHOUT ANY WARRANTY; without even the  
+// implied warranty of MERCHANTABILITY or FITNESS FOR A   
+// PARTICULAR PURPOSE. See the GNU General Public        
+// License for more details.                              
+//                                                        
+// Licence can be viewed at                               
+// http://www.gnu.org/licenses/gpl-3.0.txt
+// **********************************************************************************
+#include <RFM69.h>         //get it here: https://www.github.com/lowpowerlab/rfm69
+#include <RFM69registers.h>
+#include <SPI.h>           //included with Arduino IDE install (www.arduino.cc)
+
+//*********************************************************************************************
+//************ IMPORTANT SETTINGS - YOU MUST CHANGE/CONFIGURE TO FIT YOUR HARDWARE ************
+//*********************************************************************************************
+#define BENCH_MASTER    1
+#define NETWORKID       100  //the same on both nodes
+//#define FREQUENCY     RF69_433MHZ
+//#define FREQUENCY     RF69_868MHZ
+#define FREQUENCY       RF69_915MHZ
+//#define IS_RFM69HW_HCW  //uncomment only for RFM69HW/HCW! Leave out if you have RFM69W/CW!
+#define SERIAL_BAUD     115200
+//*********************************************************************************************
+#define BENCH_PAYLOAD   32
+#define BENCH_PINGS     50
+#define BENCH_FLOOD_MS  3000
+#define BENCH_FLOOD_MIN 5
+#define BENCH_REPLY_MS  1000   // longer than a round trip at the slowest bitrate
+#define BENCH_IDLE_MS   5000   // the other node goes back to the control channel
+
+#if BENCH_MASTER
+  #define NODEID 1
+  #define PEERID 2
+#else
+  #define NODEID 2
+  #define PEERID 1
+#endif
+
+#if defined (MOTEINO_M0) && defined(SERIAL_PORT_USBVIRTUAL)
+  #define Serial SERIAL_PORT_USBVIRTUAL // Required for Serial on Zero based boards
+#endif
+
+// RxBw must stay above Fdev + bitrate/2
+struct BenchConfig {
+  const char* name;
+  uint8_t bitrateMsb, bitrateLsb, fdevMsb, fdevLsb, rxbw;
+};
+const BenchConfig configs[] = {
+  { "Rb55555Fd50k", RF_BITRATEMSB_55555, RF_BITRATELSB_55555, RF_FDEVMSB_50000, RF_FDEVLSB_50000, RF_RXBW_DCCFREQ_010 | RF_RXBW_MANT_16 | RF_RXBW_EXP_2 }, // the library default
+  { "Rb200kFd100k", RF_BITRATEMSB_200KBPS, RF_BITRATELSB_200KBPS, RF_FDEVMSB_100000, RF_FDEVLSB_100000, RF_RXBW_DCCFREQ_010 | RF_RXBW_MANT_16 | RF_RXBW_EXP_0 },
+  { "Rb100kFd100k", RF_BITRATEMSB_100000, RF_BITRATELSB_100000, RF_FDEVMSB_100000, RF_FDEVLSB_100000, RF_RXBW_DCCFREQ_010 | RF_RXBW_MANT_16 | RF_RXBW_EXP_1 },
+  { "Rb19200Fd20k", RF_BITRATEMSB_19200, RF_BITRATELSB_19200, RF_FDEVMSB_20000, RF_FDEVLSB_20000, RF_RXBW_DCCFREQ_010 | RF_RXBW_MANT_24 | RF_RXBW_EXP_3 },
+  { "Rb9600Fd20k",  RF_BITRATEMSB_9600, RF_BITRATELSB_9600, RF_FDEVMSB_20000, RF_FDEVLSB_20000, RF_RXBW_DCCFREQ_010 | RF_RXBW_MANT_16 | RF_RXBW_EXP_4 },
+};
+#define NUM_CONFIGS (sizeof(configs) / sizeof(configs[0]))
+
+RFM69 radio;
+uint8_t buf[RF69_MAX_DATA_LEN];
+uint8_t len;
+uint8_t current;
+
+void setConfig(uint8_t i) {
+  current = i;
+  radio.writeReg(REG_BITRATEMSB, configs[i].bitrateMsb);
+  radio.writeReg(REG_BITRATELSB, configs[i].bitrateLsb);
+  radio.writeReg(REG_FDEVMSB, configs[i].fdevMsb);
+  radio.writeReg(REG_FDEVLSB, configs[i].fdevLsb);
+  radio.writeReg(REG_RXBW, configs[i].rxbw);
+  radio.receiveDone(); // back to RX with the new settings
+}
+
+// true with the packet in buf/len if one came from the peer
+bool receivePacket() {
+  if (!radio.receiveDone() || radio.SENDERID != PEERID || radio.DATALEN == 0) return false;
+  len = radio.DATALEN;
+  memcpy(buf, (const void*)radio.DATA, len);
+  return true;
+}
+
+// a packet from the peer that starts with first, or false after timeout ms
+bool receiveReply(uint8_t first, unsigned long timeout) {
+  unsigned long start = millis();
+  while (millis() - start < timeout)
+    if (receivePacket() && buf[0] == first) return true;
+  return false;
+}
+
+void setup() {
+  Serial.begin(SERIAL_BAUD);
+  radio.initialize(FREQUENCY, NODEID, NETWORKID);
+#ifdef IS_RFM69HW_HCW
+  radio.setHighPower(); //must include this only for RFM69HW/HCW!
+#endif
+  setConfig(0);
+#if BENCH_MASTER
+  Serial.println("stack,driver,config,payload,metric,value");
+#else
+  calibrate();
+#endif
+}
+
+void result(const char* metric, float value) {
+  Serial.print("RFM69_LowPowerLab,RFM69,");
+  Serial.print(configs[current].name);
+  Serial.print(',');
+  Serial.print(BENCH_PAYLOAD);
+  Serial.print(',');
+  Serial.print(metric);
+  Serial.print(',');
+  Serial.println(value);
+}
+
+#if BENCH_MASTER
+//=============================================================================
+// the node that runs the tests
+//=============================================================================
+
+// asks the other node, on the control channel, to move to config i
+bool startConfig(uint8_t i) {
+  unsigned long start = millis();
+  while (millis() - start < BENCH_IDLE_MS + BENCH_REPLY_MS) {
+    uint8_t command[2] = { 'C', i };
+    radio.send(PEERID, command, sizeof(command));
+    if (receiveReply('c', 200) && len == 2 && buf[1] == i) {
+      setConfig(i);
+      delay(20); // the other node is still switching
+      return true;
+    }
+  }
+  return false;
+}
+
+void endConfig() {
+  radio.send(PEERID, "D", 1);
+  radio.send(PEERID, "D", 1);
+  setConfig(0);
+  delay(50);
+}
+
+void pingPong() {
+  unsigned long lowest = 0xffffffff, highest = 0, total = 0;
+  uint16_t answered = 0;
+  uint8_t ping[BENCH_PAYLOAD];
+
+  memset(ping, 0x55, sizeof(ping));
+  ping[0] = 'P';
+  for (uint16_t seq = 0; seq < BENCH_PINGS; seq++) {
+    ping[1] = seq;
+    ping[2] = seq >> 8;
+    unsigned long start = micros();
+    radio.send(PEERID, ping, sizeof(ping));
+    if (receiveReply('p', BENCH_REPLY_MS) && len == sizeof(ping) && buf[1] == ping[1] && buf[2] == ping[2]) {
+      unsigned long rtt = micros() - start;
+      total += rtt;
+      answered++;
+      if (rtt < lowest) lowest = rtt;
+      if (rtt > highest) highest = rtt;
+    }
+  }
+  if (answered) {
+    result("rtt_min_us", lowest);
+    result("rtt_avg_us", (float)total / answered);
+    result("rtt_max_us", highest);
+  }
+  result("ping_lost", BENCH_PINGS - answered);
+}
+
+void flood() {
+  uint8_t packet[BENCH_PAYLOAD];
+  uint16_t sent = 0;
+
+  memset(packet, 0xaa, sizeof(packet));
+  packet[0] = 'F';
+  unsigned long start = millis();
+  while (millis() - start < BENCH_FLOOD_MS || sent < BENCH_FLOOD_MIN) {
+    packet[1] = sent;
+    packet[2] = sent >> 8;
+    radio.send(PEERID, packet, sizeof(packet));
+    sent++;
+  }
+  unsigned long elapsed = millis() - start;
+  result("tx_pps", sent * 1000.0 / elapsed);
+
+  for (uint8_t tries = 0; tries < 5; tries++) {
+    radio.send(PEERID, "R", 1);
+    if (receiveReply('r', BENCH_REPLY_MS) && len == 5) {
+      uint16_t received = buf[1] | (uint16_t)buf[2] << 8;
+      uint16_t cpu = buf[3] | (uint16_t)buf[4] << 8;
+      result("rx_pps", received * 1000.0 / elapsed);
+      result("rx_Bps", (float)received * BENCH_PAYLOAD * 1000.0 / elapsed);
+      result("cpu_us", cpu);
+      return;
+    }
+  }
+}
+
+void loop() {
+  static bool done = false;
+  if (done) return;
+  for (uint8_t i = 0; i < NUM_CONFIGS; i++) {
+    if (!startConfig(i)) {
+      Serial.print("# no answer for ");
+      Serial.println(configs[i].name);
+      continue;
+    }
+    pingPong();
+    flood();
+    endConfig();
+  }
+  Serial.println("# done");
+  done = true;
+}
+
+#else
+//=============================================================================
+// the node that answers
+//=============================================================================
+volatile uint8_t sink;
+unsigned long spins;     // busy loop iterations
+float spinsPerUs;        // with nothing on the air
+uint16_t floodCount;
+unsigned long floodFirst, floodLast, spinsFirst, spinsLast;
+unsigned long lastHeard;
+
+void spin() {
+  for (uint8_t i = 0; i < 16; i++) sink++;
+  spins++;
+}
+
+// busy loop rate with the radio polled but idle
+void calibrate() {
+  unsigned long start = micros();
+  spins = 0;
+  while (micros() - start < 1000000) {
+    radio.receiveDone();
+    spin();
+  }
+  spinsPerUs = spins / 1000000.0;
+}
+
+void loop() {
+  spin();
+  if (!receivePacket()) {
+    if (current != 0 && millis() - lastHeard > BENCH_IDLE_MS) setConfig(0);
+    return;
+  }
+  lastHeard = millis();
+
+  if (current == 0 && buf[0] == 'C' && len == 2 && buf[1] < NUM_CONFIGS) {
+    buf[0] = 'c';
+    radio.send(PEERID, buf, 2);
+    setConfig(buf[1]);
+    floodCount = 0;
+  }
+  else if (buf[0] == 'P') {
+    buf[0] = 'p';
+    radio.send(PEERID, buf, len);
+  }
+  else if (buf[0] == 'F') {
+    if (floodCount++ == 0) {
+      floodFirst = micros();
+      spinsFirst = spins;
+    }
+    floodLast = micros();
+    spinsLast = spins;
+  }
+  else if (buf[0] == 'R') {
+    // time the loop didn't get between the first and the last flood packet
+    float lostUs = (floodLast - floodFirst) - (spinsLast - spinsFirst) / spinsPerUs;
+    uint16_t cpu = floodCount > 1 && lostUs > 0 ? lostUs / (floodCount - 1) : 0;
+    uint8_t report[5] = { 'r', (uint8_t)floodCount, (uint8_t)(floodCount >> 8), (uint8_t)cpu, (uint8_t)(cpu >> 8) };
+    radio.send(PEERID, report, sizeof(report));
+  }
+  else if (buf[0] == 'D' && current != 0) setConfig(0);
+}
+#endif
@@ -28,6 +28,7 @@
 #include <SPI.h>
 
 uint8_t RFM69::DATA[RF69_MAX_DATA_LEN];
+uint8_t RFM69::TXDATA[RF69_MAX_DATA_LEN];
 uint8_t RFM69::_mode;        // current transceiver state
 uint8_t RFM69::DATALEN;
 uint16_t RFM69::SENDERID;
@@ -36,7 +37,15 @@ uint8_t RFM69::PAYLOADLEN;
 uint8_t RFM69::ACK_REQUESTED;
 uint8_t RFM69::ACK_RECEIVED; // should be polled immediately after sending a packet with ACK request
 int16_t RFM69::RSSI;          // most accurate RSSI during reception (closest to the reception)
+uint32_t RFM69::RXTIME;
 volatile bool RFM69::_haveData;
+#if RF69_RX_QUEUE_SLOTS
+RFM69Packet RFM69::_rxQueue[RF69_RX_QUEUE_SLOTS];
+volatile uint8_t RFM69::_rxHead;
+volatile uint8_t RFM69::_rxTail;
+volatile uint16_t RFM69::_rxDropped;
+volatile bool RFM69::_spiBusy;
+#endif
 RFM69* RFM69::selfPointer;
 
 RFM69::RFM69(uint8_t slaveSelectPin, uint8_t interruptPin, bool isRFM69HW)
@@ -132,9 +141,12 @@ bool RFM69::initialize(uint8_t freqBand, uint16_t nodeID, uint8_t networkID)
   while (((readReg(REG_IRQFLAGS1) & RF_IRQFLAGS1_MODEREADY) == 0x00) && millis()-start < timeout); // wait for ModeReady
   if (millis()-start >= timeout)
     return false;
+  selfPointer = this;
+#if RF69_RX_QUEUE_SLOTS && defined(SPI_HAS_TRANSACTION) && (RF69_PLATFORM != RF69_PLATFORM_ESP8266) && (RF69_PLATFORM != RF69_PLATFORM_ESP32)
+  SPI.usingInterrupt(_interruptNum); // isr0() talks to the radio, keep it out of other devices' transactions
+#endif
   attachInterrupt(_interruptNum, RFM69::isr0, RISING);
 
-  selfPointer = this;
   _address = nodeID;
 #if defined(RF69_LISTENMODE_ENABLE)
   _freqBand = freqBand;
@@ -234,7 +246,11 @@ void RFM69::setPowerLevel(uint8_t powerLevel)
 
 bool RFM69::canSend()
 {
+#if RF69_RX_QUEUE_SLOTS
+  if (_mode == RF69_MODE_RX && !_haveData && readRSSI() < CSMA_LIMIT) // the queue keeps the FIFO empty, DATA may still hold the last packet
+#else
   if (_mode == RF69_MODE_RX && PAYLOADLEN == 0 && readRSSI() < CSMA_LIMIT) // if signal stronger than -100dBm is detected assume channel activity
+#endif
   {
     setMode(RF69_MODE_STANDBY);
     return true;
@@ -246,7 +262,7 @@ void RFM69::send(uint16_t toAddress, const void* buffer, uint8_t bufferSize, boo
 {
   writeReg(REG_PACKETCONFIG2, (readReg(REG_PACKETCONFIG2) & 0xFB) | RF_PACKET2_RXRESTART); // avoid RX deadlocks
   uint32_t now = millis();
-  while (!canSend() && millis() - now < RF69_CSMA_LIMIT_MS) receiveDone();
+  while (!canSend() && millis() - now < RF69_CSMA_LIMIT_MS) receivePoll();
   sendFrame(toAddress, buffer, bufferSize, requestACK, false);
 }
 
@@ -272,9 +288,29 @@ bool RFM69::sendWithRetry(uint16_t toAddress, const void* buffer, uint8_t buffer
 
 // should be polled immediately after sending a packet with ACK request
 bool RFM69::ACKReceived(uint16_t fromNodeID) {
+#if RF69_RX_QUEUE_SLOTS
+  // only the ACK leaves the queue, other nodes' packets stay for receiveDone()
+  receivePoll();
+  uint8_t n = receiveQueued();
+  for (uint8_t i = 0; i < n; i++)
+  {
+    uint8_t at = _rxHead + i;
+    RFM69Packet& p = _rxQueue[at % RF69_RX_QUEUE_SLOTS];
+    if ((p.ctl & RFM69_CTL_SENDACK) && (p.sender == fromNodeID || fromNodeID == RF69_BROADCAST_ADDR))
+    {
+      loadPacket(at % RF69_RX_QUEUE_SLOTS);
+      for (; at != _rxHead; at--) // close the gap; queuePacket() never writes below _rxTail
+        _rxQueue[at % RF69_RX_QUEUE_SLOTS] = _rxQueue[(uint8_t)(at - 1) % RF69_RX_QUEUE_SLOTS];
+      _rxHead++;
+      return true;
+    }
+  }
+  return false;
+#else
   if (receiveDone())
     return (SENDERID == fromNodeID || fromNodeID == RF69_BROADCAST_ADDR) && ACK_RECEIVED;
   return false;
+#endif
 }
 
 // check whether an ACK was requested in the last received packet (non-broadcasted packet)
@@ -289,7 +325,7 @@ void RFM69::sendACK(const void* buffer, uint8_t bufferSize) {
   int16_t _RSSI = RSSI; // save payload received RSSI value
   writeReg(REG_PACKETCONFIG2, (readReg(REG_PACKETCONFIG2) & 0xFB) | RF_PACKET2_RXRESTART); // avoid RX deadlocks
   uint32_t now = millis();
-  while (!canSend() && millis() - now < RF69_CSMA_LIMIT_MS) receiveDone();
+  while (!canSend() && millis() - now < RF69_CSMA_LIMIT_MS) receivePoll();
   SENDERID = sender;    // TWS: Restore SenderID after it gets wiped out by receiveDone()
   sendFrame(sender, buffer, bufferSize, false, true);
   RSSI = _RSSI; // restore payload RSSI
@@ -313,16 +349,11 @@ void RFM69::sendFrame(uint16_t toAddress, const void* buffer, uint8_t bufferSize
   if (toAddress > 0xFF) CTLbyte |= (toAddress & 0x300) >> 6; //assign last 2 bits of address if > 255
   if (_address > 0xFF) CTLbyte |= (_address & 0x300) >> 8;   //assign last 2 bits of address if > 255
 
-  // write to FIFO
+  // write to FIFO: header and payload in two bursts, straight from the caller's buffer
+  uint8_t header[5] = { REG_FIFO | 0x80, (uint8_t)(bufferSize + 3), (uint8_t)toAddress, (uint8_t)_address, CTLbyte };
   select();
-  SPI.transfer(REG_FIFO | 0x80);
-  SPI.transfer(bufferSize + 3);
-  SPI.transfer((uint8_t)toAddress);
-  SPI.transfer((uint8_t)_address);
-  SPI.transfer(CTLbyte);
-
-  for (uint8_t i = 0; i < bufferSize; i++)
-    SPI.transfer(((uint8_t*) buffer)[i]);
+  spiWrite(header, sizeof(header));
+  spiWrite(buffer, bufferSize);
   unselect();
 
   // no need to wait for transmit mode to be ready since its handled by the radio
@@ -361,30 +392,156 @@ void RFM69::interruptHandler() {
     ACK_REQUESTED = CTLbyte & RFM69_CTL_REQACK; // extract ACK-requested flag
     interruptHook(CTLbyte);     // TWS: hook to derived class interrupt function
 
-    for (uint8_t i = 0; i < DATALEN; i++)
-      DATA[i] = SPI.transfer(0);
+    if (DATALEN > RF69_MAX_DATA_LEN) DATALEN = RF69_MAX_DATA_LEN;
+    spiRead(DATA, DATALEN);
     if (DATALEN < RF69_MAX_DATA_LEN) DATA[DATALEN] = 0; // add null at end of string
     unselect();
     setMode(RF69_MODE_RX);
+    RXTIME = millis();
   }
   RSSI = readRSSI();
 }
 
+#if RF69_RX_QUEUE_SLOTS
+// internal function - moves a received packet from the FIFO to the tail of the queue
+// Runs from the interrupt; the receiver isn't stopped: AutoRxRestart takes over as soon as the FIFO is empty
+void RFM69::queuePacket() {
+  if (_mode != RF69_MODE_RX || !(readReg(REG_IRQFLAGS2) & RF_IRQFLAGS2_PAYLOADREADY)) return;
+  int16_t rssi = readRSSI(); // still the packet's, the receiver hasn't restarted yet
+  bool full = (uint8_t)(_rxTail - _rxHead) >= RF69_RX_QUEUE_SLOTS;
+  RFM69Packet& p = _rxQueue[_rxTail % RF69_RX_QUEUE_SLOTS];
+  uint8_t header[3] = { 0, 0, 0 };
+
+  select();
+  SPI.transfer(REG_FIFO & 0x7F);
+  uint8_t payloadLen = SPI.transfer(0);
+  payloadLen = payloadLen > 66 ? 66 : payloadLen; // precaution
+  uint8_t headerLen = payloadLen < 3 ? payloadLen : 3;
+  spiRead(header, headerLen);
+  uint8_t left = payloadLen - headerLen;
+
+  uint16_t target = header[0] | (uint16_t(header[2]) & 0x0C) << 6; //10 bit address, see interruptHandler()
+  uint16_t sender = header[1] | (uint16_t(header[2]) & 0x03) << 8;
+  bool wanted = (_promiscuousMode || target == _address || target == RF69_BROADCAST_ADDR) && payloadLen >= 3;
+  uint8_t len = (wanted && !full) ? (left < RF69_MAX_DATA_LEN ? left : RF69_MAX_DATA_LEN) : 0;
+  spiRead(p.data, len); // the payload lands in its slot, never in the head slot a reader may hold
+  if (left > len) // always empty the FIFO, even for a packet we drop
+  {
+    uint8_t rest[66];
+    spiRead(rest, left - len);
+  }
+  unselect();
+
+  if (!wanted)
+    return;
+  if (full)
+  {
+    _rxDropped++;
+    return;
+  }
+  p.time = millis();
+  p.rssi = rssi;
+  p.sender = sender;
+  p.target = target;
+  p.ctl = header[2];
+  p.len = len;
+  _rxTail++;
+}
+
+// internal function - the header fields of a queued packet (SENDERID, RSSI, ...); DATA is left alone and DATALEN is 0
+void RFM69::loadHeader(uint8_t slot) {
+  RFM69Packet& p = _rxQueue[slot];
+  SENDERID = p.sender;
+  TARGETID = p.target;
+  PAYLOADLEN = p.len + 3;
+  DATALEN = 0;
+  ACK_RECEIVED = p.ctl & RFM69_CTL_SENDACK;
+  ACK_REQUESTED = p.ctl & RFM69_CTL_REQACK;
+  RSSI = p.rssi;
+  RXTIME = p.time;
+}
+
+// internal function - makes a queued packet the current one (DATA, SENDERID, ...)
+void RFM69::loadPacket(uint8_t slot) {
+  RFM69Packet& p = _rxQueue[slot];
+  loadHeader(slot);
+  DATALEN = p.len;
+  memcpy(DATA, p.data, p.len);
+  interruptHook(p.ctl);
+  if (DATALEN < RF69_MAX_DATA_LEN) DATA[DATALEN] = 0; // add null at end of string
+}
+
+// The oldest queued packet without the copy to DATA: a gateway can parse p->data in its slot.
+// The interrupt only writes to free slots, so it stays put until receiveRelease(). The hook
+// sees DATALEN 0 (an ATC ACK-RSSI byte stays at the start of the payload; ACKs normally go
+// through ACKReceived() anyway).
+const RFM69Packet* RFM69::receivePeek() {
+  receivePoll();
+  if (receiveQueued() == 0) return NULL;
+  uint8_t slot = _rxHead % RF69_RX_QUEUE_SLOTS;
+  loadHeader(slot);
+  interruptHook(_rxQueue[slot].ctl);
+  return &_rxQueue[slot];
+}
+
+void RFM69::receiveRelease() {
+  if (receiveQueued()) _rxHead++;
+}
+
+uint8_t RFM69::receiveQueued() {
+  noInterrupts();
+  uint8_t n = _rxTail - _rxHead;
+  interrupts();
+  return n;
+}
+
+uint16_t RFM69::receiveDropped() {
+  noInterrupts();
+  uint16_t n = _rxDropped;
+  interrupts();
+  return n;
+}
+
+// internal function - an interrupt in the middle of our own SPI transfer is left for receivePoll()
+void RFM69::isr0() {
+  if (_spiBusy) _haveData = true;
+  else selfPointer->queuePacket();
+}
+#else
 // internal function
 void RFM69::isr0() { _haveData = true; }
+#endif
+
+// internal function
+void RFM69::receivePoll() {
+#if RF69_RX_QUEUE_SLOTS
+  if (_haveData)
+  {
+    _haveData = false;
+    noInterrupts(); // the interrupt would take the same packet
+    queuePacket();
+    interrupts();
+  }
+  if (_mode != RF69_MODE_RX) receiveBegin();
+#else
+  receiveDone();
+#endif
+}
 
 // internal function
 void RFM69::receiveBegin() {
+#if !RF69_RX_QUEUE_SLOTS // with the queue, the current packet stays until receiveDone() takes the next one
   DATALEN = 0;
   SENDERID = 0;
   TARGETID = 0;
   PAYLOADLEN = 0;
   ACK_REQUESTED = 0;
   ACK_RECEIVED = 0;
+  RSSI = 0;
+#endif
 #if defined(RF69_LISTENMODE_ENABLE)
   RF69_LISTEN_BURST_REMAINING_MS = 0;
 #endif
-  RSSI = 0;
   if (readReg(REG_IRQFLAGS2) & RF_IRQFLAGS2_PAYLOADREADY)
     writeReg(REG_PACKETCONFIG2, (readReg(REG_PACKETCONFIG2) & 0xFB) | RF_PACKET2_RXRESTART); // avoid RX deadlocks
   writeReg(REG_DIOMAPPING1, RF_DIOMAPPING1_DIO0_01); // set DIO0 to "PAYLOADREADY" in receive mode
@@ -393,6 +550,13 @@ void RFM69::receiveBegin() {
 
 // checks if a packet was received and/or puts transceiver in receive (ie RX or listen) mode
 bool RFM69::receiveDone() {
+#if RF69_RX_QUEUE_SLOTS
+  receivePoll();
+  if (receiveQueued() == 0) return false;
+  loadPacket(_rxHead % RF69_RX_QUEUE_SLOTS);
+  _rxHead++;
+  return true;
+#else
 //ATOMIC_BLOCK(ATOMIC_FORCEON)
 //{
   if (_haveData) {
@@ -411,6 +575,7 @@ bool RFM69::receiveDone() {
   receiveBegin();
   return false;
 //}
+#endif
 }
 
 // To enable encryption: radio.encrypt("ABCDEFGHIJKLMNOP");
@@ -466,8 +631,34 @@ void RFM69::writeReg(uint8_t addr, uint8_t value)
   unselect();
 }
 
+// internal function - writes a burst to the radio; the buffer is only read, so TXDATA survives retries
+void RFM69::spiWrite(const void* buffer, uint8_t size) {
+#if defined(ESP8266) || defined(ESP32)
+  SPI.writeBytes((const uint8_t*) buffer, size);
+#else
+  for (uint8_t i = 0; i < size; i++)
+    SPI.transfer(((const uint8_t*) buffer)[i]);
+#endif
+}
+
+// internal function - reads a FIFO burst into buffer. CRC and AES are left to the radio
+// (CrcAutoClear drops bad packets, the FIFO is already decrypted at PayloadReady), so the
+// bytes go straight to their final place
+void RFM69::spiRead(void* buffer, uint8_t size) {
+  if (size == 0) return;
+#ifdef SPI_HAS_TRANSACTION // transfer(buf, n) came with the transaction API; what it clocks out is ignored by the FIFO
+  SPI.transfer((uint8_t*) buffer, size);
+#else
+  for (uint8_t i = 0; i < size; i++)
+    ((uint8_t*) buffer)[i] = SPI.transfer(0);
+#endif
+}
+
 // select the RFM69 transceiver (save SPI settings, set CS low)
 void RFM69::select() {
+#if RF69_RX_QUEUE_SLOTS
+  _spiBusy = true;
+#endif
 #if defined (SPCR) && defined (SPSR)
   // save current SPI settings
   _SPCR = SPCR;
@@ -500,6 +691,9 @@ void RFM69::unselect() {
   SPCR = _SPCR;
   SPSR = _SPSR;
 #endif
+#if RF69_RX_QUEUE_SLOTS
+  _spiBusy = false;
+#endif
 }
 
 // true  = disable filtering to capture all frames on network
@@ -152,6 +152,29 @@
 #define RFM69_CTL_SENDACK   0x80
 #define RFM69_CTL_REQACK    0x40
 
+// Received packets wait in a queue of this many slots (a power of two), filled
+// right from the DIO0 interrupt while the receiver stays on, so bursts from
+// several nodes survive a sketch that is slow to call receiveDone().
+// Each slot costs about 70 bytes of RAM; 0 goes back to the single DATA buffer.
+#ifndef RF69_RX_QUEUE_SLOTS
+  #define RF69_RX_QUEUE_SLOTS 4
+#endif
+#if RF69_RX_QUEUE_SLOTS & (RF69_RX_QUEUE_SLOTS - 1)
+  #error RF69_RX_QUEUE_SLOTS must be a power of two
+#endif
+
+#if RF69_RX_QUEUE_SLOTS
+typedef struct {
+  uint32_t time;     // millis() at reception
+  int16_t rssi;
+  uint16_t sender;
+  uint16_t target;
+  uint8_t ctl;
+  uint8_t len;       // payload bytes in data
+  uint8_t data[RF69_MAX_DATA_LEN];
+} RFM69Packet;
+#endif
+
 //Native hardware ListenMode is experimental
 //It was determined to be buggy and unreliable, see https://lowpowerlab.com/forum/low-power-techniques/ultra-low-power-listening-mode-for-battery-nodes/msg20261/#msg20261
 //uncomment to try ListenMode, adds ~1K to compiled size
@@ -167,6 +190,7 @@
 class RFM69 {
   public:
     static uint8_t DATA[RF69_MAX_DATA_LEN]; // recv/xmit buf, including header & crc bytes
+    static uint8_t TXDATA[RF69_MAX_DATA_LEN]; // a payload can be built right here and passed to send()/sendWithRetry(); it goes out in one burst and stays intact for retries
     static uint8_t DATALEN;
     static uint16_t SENDERID;
     static uint16_t TARGETID; // should match _address
@@ -174,6 +198,7 @@ class RFM69 {
     static uint8_t ACK_REQUESTED;
     static uint8_t ACK_RECEIVED; // should be polled immediately after sending a packet with ACK request
     static int16_t RSSI; // most accurate RSSI during reception (closest to the reception). RSSI of last packet.
+    static uint32_t RXTIME; // millis() when the packet in DATA came in
     static uint8_t _mode; // should be protected?
 
     RFM69(uint8_t slaveSelectPin, uint8_t interruptPin, bool isRFM69HW, uint8_t interruptNum) //interruptNum is now deprecated
@@ -202,6 +227,12 @@ class RFM69 {
     void sleep();
     uint8_t readTemperature(uint8_t calFactor=0); // get CMOS temperature (8bit)
     void rcCalibration(); // calibrate the internal RC oscillator for use in wide temperature variations - see datasheet section [4.3.5. RC Timer Accuracy]
+#if RF69_RX_QUEUE_SLOTS
+    uint8_t receiveQueued(); // packets waiting for receiveDone(), not counting the one in DATA
+    uint16_t receiveDropped(); // packets lost because the queue was full
+    const RFM69Packet* receivePeek(); // next queued packet, read in place (no copy to DATA); NULL if none. SENDERID, RSSI, ACKRequested(), sendACK() refer to it
+    void receiveRelease(); // done with the receivePeek() packet; don't send anything but sendACK() before this
+#endif
 
     // allow hacking registers by making these public
     uint8_t readReg(uint8_t addr);
@@ -212,9 +243,22 @@ class RFM69 {
   protected:
     static void isr0();
     void interruptHandler();
-    virtual void interruptHook(uint8_t CTLbyte) {};
+    virtual void interruptHook(uint8_t CTLbyte) {}; // with the RX queue: called as the packet is taken off the queue, payload already in DATA
     static volatile bool _haveData;
+    void receivePoll(); // keeps the receiver on without handing over a packet
+#if RF69_RX_QUEUE_SLOTS
+    void queuePacket();
+    void loadHeader(uint8_t slot);
+    void loadPacket(uint8_t slot);
+    static RFM69Packet _rxQueue[RF69_RX_QUEUE_SLOTS];
+    static volatile uint8_t _rxHead; // free running, written only by the sketch side
+    static volatile uint8_t _rxTail; // free running, written only by queuePacket()
+    static volatile uint16_t _rxDropped;
+    static volatile bool _spiBusy; // the sketch side is in the middle of an SPI transfer
+#endif
     virtual void sendFrame(uint16_t toAddress, const void* buffer, uint8_t size, bool requestACK=false, bool sendACK=false);
+    void spiWrite(const void* buffer, uint8_t size); // FIFO bursts, between select() and unselect()
+    void spiRead(void* buffer, uint8_t size);
 
     static RFM69* selfPointer;
     uint8_t _slaveSelectPin;
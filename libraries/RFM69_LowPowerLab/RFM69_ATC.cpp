@@ -42,6 +42,7 @@ bool RFM69_ATC::initialize(uint8_t freqBand, uint16_t nodeID, uint8_t networkID)
   ACK_RSSI_REQUESTED = 0; // TomWS1: init to none
   //_powerBoost = false;    // TomWS1: require someone to explicitly turn boost on!
   _transmitLevel = 31;    // TomWS1: match default value in PA Level register
+  _nodePowerCount = 0;
   return RFM69::initialize(freqBand, nodeID, networkID);  // use base class to initialize most everything
 }
 
@@ -71,7 +72,7 @@ void RFM69_ATC::sendACK(const void* buffer, uint8_t bufferSize) {
   bool sendRSSI = ACK_RSSI_REQUESTED;  
   writeReg(REG_PACKETCONFIG2, (readReg(REG_PACKETCONFIG2) & 0xFB) | RF_PACKET2_RXRESTART); // avoid RX deadlocks
   uint32_t now = millis();
-  while (!canSend() && millis() - now < RF69_CSMA_LIMIT_MS) receiveDone();
+  while (!canSend() && millis() - now < RF69_CSMA_LIMIT_MS) receivePoll();
   SENDERID = sender;    // TomWS1: Restore SenderID after it gets wiped out by receiveDone()
   sendFrame(sender, buffer, bufferSize, false, true, sendRSSI, _RSSI);   // TomWS1: Special override on sendFrame with extra params
   RSSI = _RSSI; // restore payload RSSI
@@ -96,6 +97,17 @@ void RFM69_ATC::sendFrame(uint16_t toAddress, const void* buffer, uint8_t buffer
   bufferSize += (sendACK && sendRSSI)?1:0;  // if sending ACK_RSSI then increase data size by 1
   if (bufferSize > RF69_MAX_DATA_LEN) bufferSize = RF69_MAX_DATA_LEN;
 
+  if (_targetRSSI) // setMode(TX) applies it
+  {
+    if (toAddress != RF69_BROADCAST_ADDR) _transmitLevel = getPowerLevel(toAddress);
+    else                                  // loud enough for the farthest node we know of
+    {
+      _transmitLevel = _nodePowerCount ? 0 : RFM69_ATC_MAX_LEVEL;
+      for (uint8_t i = 0; i < _nodePowerCount; i++)
+        if (_nodePower[i].level > _transmitLevel) _transmitLevel = _nodePower[i].level;
+    }
+  }
+
   // write to FIFO
   select();
   SPI.transfer(REG_FIFO | 0x80);
@@ -119,8 +131,7 @@ void RFM69_ATC::sendFrame(uint16_t toAddress, const void* buffer, uint8_t buffer
   }
   else SPI.transfer(CTLbyte);
 
-  for (uint8_t i = 0; i < bufferSize; i++)
-    SPI.transfer(((uint8_t*) buffer)[i]);
+  spiWrite(buffer, bufferSize);
   unselect();
 
   // no need to wait for transmit mode to be ready since its handled by the radio
@@ -132,7 +143,8 @@ void RFM69_ATC::sendFrame(uint16_t toAddress, const void* buffer, uint8_t buffer
 }
 
 //=============================================================================
-// interruptHook() - gets called by the base class interrupt handler right after the header is fetched.
+// interruptHook() - gets called by the base class interrupt handler right after the header is fetched
+//                   (with the RX queue: when the packet is taken off the queue, see RFM69.h).
 //=============================================================================
 void RFM69_ATC::interruptHook(uint8_t CTLbyte) {
   ACK_RSSI_REQUESTED = CTLbyte & RFM69_CTL_RESERVE1; // TomWS1: extract the ACK RSSI request bit (could potentially merge with ACK_REQUESTED)
@@ -140,17 +152,23 @@ void RFM69_ATC::interruptHook(uint8_t CTLbyte) {
   if (ACK_RECEIVED && ACK_RSSI_REQUESTED) {
     // the next two bytes contain the ACK_RSSI (assuming the datalength is valid)
     if (DATALEN >= 1) {
+#if RF69_RX_QUEUE_SLOTS
+      _ackRSSI = -1 * DATA[0]; // the queued payload is already in DATA
+      DATALEN -= 1;
+      memmove(DATA, DATA + 1, DATALEN);
+#else
       _ackRSSI = -1 * SPI.transfer(0); //rssi was sent as single byte positive value, get the real value by * -1
       DATALEN -= 1;   // and compensate data length accordingly
-      // TomWS1: Now dither transmitLevel value (register update occurs later when transmitting);
+#endif
+      // Now correct the sender's level (register update occurs later when transmitting).
+      // A level is 1dB of output power, so the whole RSSI error is taken in one step.
       if (_targetRSSI != 0) {
-        // if (_isRFM69HW) {
-          // if (_ackRSSI < _targetRSSI && _transmitLevel < 51) _transmitLevel++;
-          // else if (_ackRSSI > _targetRSSI && _transmitLevel > 32) _transmitLevel--;
-        // } else {
-        if (_ackRSSI < _targetRSSI && _transmitLevel < 31) { _transmitLevel++; /*Serial.println("\n ======= _transmitLevel ++   ======");*/ }
-        else if (_ackRSSI > _targetRSSI && _transmitLevel > 0) { _transmitLevel--; /*Serial.println("\n ======= _transmitLevel --   ======");*/ }
-        //}
+        int16_t error = _targetRSSI - _ackRSSI;
+        if (error > RFM69_ATC_DEADBAND || error < -RFM69_ATC_DEADBAND) {
+          uint8_t* level = nodeLevel(SENDERID);
+          int16_t newLevel = *level + error;
+          *level = newLevel < 0 ? 0 : (newLevel > RFM69_ATC_MAX_LEVEL ? RFM69_ATC_MAX_LEVEL : newLevel);
+        }
       }
     }
   }
@@ -172,8 +190,12 @@ bool RFM69_ATC::sendWithRetry(uint16_t toAddress, const void* buffer, uint8_t bu
         return true;
       }
     }
+    if (_targetRSSI && toAddress != RF69_BROADCAST_ADDR) // the next attempt goes out louder
+    {
+      uint8_t* level = nodeLevel(toAddress);
+      *level = *level + RFM69_ATC_RETRY_STEP > RFM69_ATC_MAX_LEVEL ? RFM69_ATC_MAX_LEVEL : *level + RFM69_ATC_RETRY_STEP;
+    }
   }
-  if (_transmitLevel < 31) _transmitLevel++;
   return false;
 }
 
@@ -257,6 +279,30 @@ void  RFM69_ATC::enableAutoPower(int16_t targetRSSI){    // TomWS1: New method t
   _targetRSSI = targetRSSI;         // no logic here, just set the value (if non-zero, then enabled), caller's responsibility to use a reasonable value
 }
 
+//=============================================================================
+// getPowerLevel() - returns the transmit level used for nodeID.
+//=============================================================================
+uint8_t RFM69_ATC::getPowerLevel(uint16_t nodeID) {
+  for (uint8_t i = 0; i < _nodePowerCount; i++)
+    if (_nodePower[i].node == nodeID) return _nodePower[i].level;
+  return RFM69_ATC_MAX_LEVEL;
+}
+
+//=============================================================================
+// nodeLevel() - finds nodeID's entry and moves it to the front; new nodes start at full power.
+//=============================================================================
+uint8_t* RFM69_ATC::nodeLevel(uint16_t nodeID) {
+  uint8_t i = 0;
+  while (i < _nodePowerCount && _nodePower[i].node != nodeID) i++;
+  NodePower entry = { nodeID, RFM69_ATC_MAX_LEVEL };
+  if (i < _nodePowerCount) entry = _nodePower[i];
+  else if (_nodePowerCount < RFM69_ATC_NODES) _nodePowerCount++;
+  else i--;                       // table full, the least recently used node goes
+  for (; i > 0; i--) _nodePower[i] = _nodePower[i - 1];
+  _nodePower[0] = entry;
+  return &_nodePower[0].level;
+}
+
 //=============================================================================
 // getAckRSSI() - returns the RSSI value ack'd by the far end.
 //=============================================================================
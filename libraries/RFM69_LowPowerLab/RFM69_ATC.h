@@ -32,6 +32,21 @@
 
 #define RFM69_CTL_RESERVE1  0x20
 
+// Power levels are learned per destination, so a gateway can whisper to the node next door
+// and shout to the one across the field. The table keeps the most recently adjusted nodes.
+#ifndef RFM69_ATC_NODES
+  #define RFM69_ATC_NODES 8
+#endif
+// ACK RSSI this close to the target (dB) leaves the level alone, so noise doesn't make it wander
+#ifndef RFM69_ATC_DEADBAND
+  #define RFM69_ATC_DEADBAND 2
+#endif
+// levels added after each attempt sendWithRetry() got no ACK for
+#ifndef RFM69_ATC_RETRY_STEP
+  #define RFM69_ATC_RETRY_STEP 4
+#endif
+#define RFM69_ATC_MAX_LEVEL 31
+
 class RFM69_ATC: public RFM69 {
   public:
     static volatile uint8_t ACK_RSSI_REQUESTED;  // new flag in CTL byte to request RSSI with ACK (could potentially be merged with ACK_REQUESTED)
@@ -49,6 +64,7 @@ class RFM69_ATC: public RFM69 {
     void setMode(uint8_t mode);  // TWS: moved from protected to try to build block()/unblock() wrapper
     
     int16_t getAckRSSI(void);       // TWS: New method to retrieve the ack'd RSSI (if any)
+    uint8_t getPowerLevel(uint16_t nodeID); // level learned for nodeID, RFM69_ATC_MAX_LEVEL until it has ACK'd with RSSI
     uint8_t setLNA(uint8_t newReg); // TWS: function to control LNA reg for power testing purposes
     int16_t _targetRSSI;     // if non-zero then this is the desired end point RSSI for our transmission
     uint8_t _transmitLevel;  // saved powerLevel in case we do auto power adjustment, this value gets dithered
@@ -63,6 +79,14 @@ class RFM69_ATC: public RFM69 {
     int16_t _ackRSSI;         // this contains the RSSI our destination Ack'd back to us (if we enabledAutoPower)
     //bool    _powerBoost;      // this controls whether we need to turn on the highpower regs based on the setPowerLevel input
     uint8_t _PA_Reg;          // saved and derived PA control bits so we don't have to spend time reading back from SPI port
+
+    struct NodePower {
+      uint16_t node;
+      uint8_t level;
+    };
+    NodePower _nodePower[RFM69_ATC_NODES]; // most recently adjusted first
+    uint8_t _nodePowerCount;
+    uint8_t* nodeLevel(uint16_t nodeID);   // entry for nodeID, added (possibly evicting the oldest) if missing
 };
 
 #endif
\ No newline at end of file
@@ -55,14 +55,15 @@ void CheckForWirelessHEX(RFM69& radio, SPIFlash& flash, uint8_t DEBUG, uint8_t L
   if (radio.DATALEN >= 4 && radio.DATA[0]=='F' && radio.DATA[1]=='L' && radio.DATA[2]=='X' && radio.DATA[3]=='?')
   {
     uint8_t remoteID = radio.SENDERID;
+    uint8_t binary = radio.DATALEN == 7 && radio.DATA[4]=='B' && radio.DATA[5]=='I' && radio.DATA[6]=='N';
     if (radio.DATALEN == 7 && radio.DATA[4]=='E' && radio.DATA[5]=='O' && radio.DATA[6]=='F')
     { //sender must have not received EOF ACK so just resend
       radio.send(remoteID, "FLX?OK",6);
     }
 #ifdef SHIFTCHANNEL
-    else if (HandleWirelessHEXDataWrapper(radio, remoteID, flash, DEBUG, LEDpin))
+    else if (HandleWirelessHEXDataWrapper(radio, remoteID, flash, DEBUG, LEDpin, binary))
 #else
-    else if (HandleWirelessHEXData(radio, remoteID, flash, DEBUG, LEDpin))
+    else if (binary ? HandleWirelessBINData(radio, remoteID, flash, DEBUG, LEDpin) : HandleWirelessHEXData(radio, remoteID, flash, DEBUG, LEDpin))
 #endif
     {
       if (DEBUG) Serial.print(F("FLASH IMG TRANSMISSION SUCCESS!\n"));
@@ -81,7 +82,7 @@ void CheckForWirelessHEX(RFM69& radio, SPIFlash& flash, uint8_t DEBUG, uint8_t L
 //===================================================================================================================
 // HandleHandshakeACK() - checks there is a FLASH chip and sends an ACK for the OTA request handshake
 //===================================================================================================================
-void HandleHandshakeACK(RFM69& radio, SPIFlash& flash, uint8_t flashCheck) {
+void HandleHandshakeACK(RFM69& radio, SPIFlash& flash, uint8_t flashCheck, uint8_t binary) {
   if (flashCheck)
   {
     if (!flash.initialize())
@@ -91,7 +92,8 @@ void HandleHandshakeACK(RFM69& radio, SPIFlash& flash, uint8_t flashCheck) {
       return;
     }
   }
-  radio.sendACK("FLX?OK",6); //ACK the HANDSHAKE
+  if (binary) radio.sendACK("FLX?OK:BIN",10); //ACK the HANDSHAKE, binary transfer accepted
+  else radio.sendACK("FLX?OK",6); //ACK the HANDSHAKE
 }
 
 
@@ -100,11 +102,11 @@ void HandleHandshakeACK(RFM69& radio, SPIFlash& flash, uint8_t flashCheck) {
 // that also shifts channel when SHIFTCHANNEL is defined
 //===================================================================================================================
 #ifdef SHIFTCHANNEL
-uint8_t HandleWirelessHEXDataWrapper(RFM69& radio, uint8_t remoteID, SPIFlash& flash, uint8_t DEBUG, uint8_t LEDpin) {
-  HandleHandshakeACK(radio, flash);
+uint8_t HandleWirelessHEXDataWrapper(RFM69& radio, uint8_t remoteID, SPIFlash& flash, uint8_t DEBUG, uint8_t LEDpin, uint8_t binary) {
+  HandleHandshakeACK(radio, flash, true, binary);
   if (DEBUG) { Serial.println(F("FLX?OK (ACK sent)")); Serial.print(F("Shifting channel to ")); Serial.println(radio.getFrequency() + SHIFTCHANNEL);}
   radio.setFrequency(radio.getFrequency() + SHIFTCHANNEL); //shift center freq by SHIFTCHANNEL amount
-  uint8_t result = HandleWirelessHEXData(radio, remoteID, flash, DEBUG, LEDpin);
+  uint8_t result = binary ? HandleWirelessBINData(radio, remoteID, flash, DEBUG, LEDpin) : HandleWirelessHEXData(radio, remoteID, flash, DEBUG, LEDpin);
   if (DEBUG) { Serial.print(F("UNShifting channel to ")); Serial.println(radio.getFrequency() - SHIFTCHANNEL);}
   radio.setFrequency(radio.getFrequency() - SHIFTCHANNEL); //restore center freq
   return result;
@@ -259,6 +261,132 @@ uint8_t HandleWirelessHEXData(RFM69& radio, uint8_t remoteID, SPIFlash& flash, u
 }
 
 
+//===================================================================================================================
+// HandleWirelessBINData() - the binary counterpart of HandleWirelessHEXData(), at the OTA programmed node side
+// Packets from the MAIN node:
+//   'B' seq(u16) data        RFM69_OTA_CHUNK bytes of image at seq*RFM69_OTA_CHUNK (the last one may be shorter)
+//   'P' base(u16) count(u8)  ACK request for packets base..base+count-1, answered with 'P' base(u16) received(u16 bitmap)
+//   'E' size(u32) crc(u32)   end of image, answered with 'E' and 1 if size and CRC32 match the flash, 0 if not
+// The image is written where HandleWirelessHEXData() puts it; the FLXIMG header only goes in once the CRC matched
+//===================================================================================================================
+uint8_t HandleWirelessBINData(RFM69& radio, uint8_t remoteID, SPIFlash& flash, uint8_t DEBUG, uint8_t LEDpin) {
+#if defined (MOTEINO_ZERO)
+  const uint32_t imageStart = 11, imageMax = 253952;
+#elif defined(__AVR_ATmega1284P__)
+  const uint32_t imageStart = 10, imageMax = 65526;
+#else //assuming atmega328p
+  const uint32_t imageStart = 10, imageMax = 31744;
+#endif
+  uint32_t now;
+  uint16_t base = 0; //lowest packet number of the window the MAIN node last asked about
+  uint16_t received = 0; //bit i: packet base+i is in flash
+  uint8_t erased = 1; //32K blocks erased so far
+  uint8_t result = 2; //EOF result, 2 until it's known
+  uint16_t timeout = 3000; //3s for flash data
+
+#ifndef SHIFTCHANNEL
+  HandleHandshakeACK(radio, flash, true, true);
+  if (DEBUG) Serial.println(F("FLX?OK:BIN (ACK sent)"));
+#endif
+
+  flash.blockErase32K(0);
+  now = millis();
+  pinMode(LEDpin,OUTPUT);
+
+  while(1)
+  {
+    if (radio.receiveDone() && radio.SENDERID == remoteID)
+    {
+      uint8_t dataLen = radio.DATALEN;
+      uint8_t* data = radio.DATA;
+
+      digitalWrite(LEDpin,HIGH);
+      now = millis(); //got a packet from the MAIN node
+      if (data[0]=='B' && dataLen > 3)
+      {
+        uint16_t seq = data[1] | (uint16_t)data[2] << 8;
+        uint32_t address = imageStart + (uint32_t)seq * RFM69_OTA_CHUNK;
+        uint8_t length = dataLen - 3;
+        //the window after the one being ACK'd can arrive before the next poll moves base, so 16 bits cover two windows
+        if (seq >= base && seq - base < 16 && !(received & (1 << (seq - base))) && address + length <= imageStart + imageMax)
+        {
+          while (address + length > erased * 32768UL) flash.blockErase32K(erased++ * 32768UL); //erase subsequent 32K blocks (possible in case of atmega1284p)
+          flash.writeBytes(address, data + 3, length);
+          received |= 1 << (seq - base);
+        }
+        if (DEBUG) { Serial.print(F("BIN:")); Serial.println(seq); }
+      }
+      else if (data[0]=='P' && dataLen == 4 && radio.ACKRequested())
+      {
+        uint16_t pollBase = data[1] | (uint16_t)data[2] << 8;
+        uint8_t count = data[3] > 16 ? 16 : data[3];
+        if (pollBase > base) //the MAIN node has all of the window before
+        {
+          received = pollBase - base >= 16 ? 0 : received >> (pollBase - base);
+          base = pollBase;
+        }
+        uint16_t got = pollBase < base ? 0xFFFF : received; //a stale poll: all of it made it
+        if (count < 16) got &= (1 << count) - 1;
+        uint8_t ack[5] = { 'P', data[1], data[2], (uint8_t)got, (uint8_t)(got >> 8) };
+        radio.sendACK(ack, 5);
+      }
+      else if (data[0]=='E' && dataLen == 9 && radio.ACKRequested())
+      {
+        if (result == 2) //the CRC takes a while for a large image, MAIN keeps asking meanwhile
+        {
+          uint32_t size, crc;
+          memcpy(&size, data + 1, 4); //both ends little endian
+          memcpy(&crc, data + 5, 4);
+          result = false;
+          if (size > 0 && size <= imageMax)
+          {
+            uint8_t buffer[32];
+            uint32_t check = 0;
+            for (uint32_t i = 0; i < size; i += sizeof(buffer))
+            {
+              uint16_t n = size - i < sizeof(buffer) ? size - i : sizeof(buffer);
+              flash.readBytes(imageStart + i, buffer, n);
+              check = CRC32(check, buffer, n);
+            }
+            result = check == crc;
+            if (DEBUG) { Serial.print(F("CRC32 ")); Serial.print(check, HEX); Serial.println(result ? F(" OK") : F(" MISMATCH")); }
+          }
+          if (result)
+          {
+            flash.writeBytes(0,"FLXIMG:", 7);
+#ifdef MOTEINO_ZERO
+            flash.writeByte(7,size>>16);
+            flash.writeByte(8,size>>8);
+            flash.writeByte(9,size);
+            flash.writeByte(10,':');
+#else
+            flash.writeByte(7,size>>8);
+            flash.writeByte(8,size);
+            flash.writeByte(9,':');
+#endif
+          }
+        }
+        uint8_t ack[2] = { 'E', result };
+        radio.sendACK(ack, 2);
+        timeout = 500; //stay a little in case this ACK is lost and EOF comes again
+      }
+      else if (dataLen==7 && data[0]=='F' && data[1]=='L' && data[2]=='X' && data[3]=='?' && data[4]=='B') //ACK for handshake was lost, resend
+      {
+        HandleHandshakeACK(radio, flash, true, true);
+        if (DEBUG) Serial.println(F("FLX?OK:BIN resend"));
+      }
+      digitalWrite(LEDpin,LOW);
+    }
+
+    //abort FLASH sequence if no valid packet received for a long time
+    if (millis()-now > timeout)
+    {
+      return result == 1;
+    }
+  }
+}
+
+
 //===================================================================================================================
 // readSerialLine() - reads a line feed (\n) terminated line from the serial stream
 // returns # of bytes read, up to 254
@@ -291,11 +419,13 @@ uint8_t CheckForSerialHEX(uint8_t* input, uint8_t inputLen, RFM69& radio, uint8_
         return false;
       }
       
+      uint8_t binary = radio.DATALEN == 10 && radio.DATA[6]==':' && radio.DATA[7]=='B' && radio.DATA[8]=='I' && radio.DATA[9]=='N'; //older targets only know HEX
+      if (DEBUG && binary) Serial.println(F("Binary transfer"));
       Serial.println(F("\nFLX?OK")); //signal serial handshake back to host script
 #ifdef SHIFTCHANNEL
-      if (HandleSerialHEXDataWrapper(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG))
+      if (HandleSerialHEXDataWrapper(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG, binary))
 #else
-      if (HandleSerialHEXData(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG))
+      if (binary ? HandleSerialBINData(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG) : HandleSerialHEXData(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG))
 #endif
       {
         Serial.println(F("FLX?OK")); //signal EOF serial handshake back to host script
@@ -320,7 +450,7 @@ uint8_t HandleSerialHandshake(RFM69& radio, uint8_t targetID, uint8_t isEOF, uin
 
   while (millis()-now<TIMEOUT)
   {
-    if (radio.sendWithRetry(targetID, isEOF ? "FLX?EOF" : "FLX?", isEOF?7:4, 2,ACKTIMEOUT))
+    if (radio.sendWithRetry(targetID, isEOF ? "FLX?EOF" : "FLX?BIN", 7, 2,ACKTIMEOUT)) //the target answers FLX?OK:BIN if it takes binary transfers
       if (radio.DATALEN >= 6 && radio.DATA[0]=='F' && radio.DATA[1]=='L' && radio.DATA[2]=='X' && radio.DATA[3]=='?')
         return true;
   }
@@ -334,9 +464,9 @@ uint8_t HandleSerialHandshake(RFM69& radio, uint8_t targetID, uint8_t isEOF, uin
 // HandleSerialHEXDataWrapper() - wrapper for HandleSerialHEXData(), also shifts the channel if SHIFTCHANNEL is defined
 //===================================================================================================================
 #ifdef SHIFTCHANNEL
-uint8_t HandleSerialHEXDataWrapper(RFM69& radio, uint8_t targetID, uint16_t TIMEOUT, uint16_t ACKTIMEOUT, uint8_t DEBUG) {
+uint8_t HandleSerialHEXDataWrapper(RFM69& radio, uint8_t targetID, uint16_t TIMEOUT, uint16_t ACKTIMEOUT, uint8_t DEBUG, uint8_t binary) {
   radio.setFrequency(radio.getFrequency() + SHIFTCHANNEL); //shift center freq by SHIFTCHANNEL amount
-  uint8_t result = HandleSerialHEXData(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG);
+  uint8_t result = binary ? HandleSerialBINData(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG) : HandleSerialHEXData(radio, targetID, TIMEOUT, ACKTIMEOUT, DEBUG);
   radio.setFrequency(radio.getFrequency() - SHIFTCHANNEL); //shift center freq by SHIFTCHANNEL amount
   return result;
 }
@@ -425,6 +555,153 @@ timeoutcheck:
 }
 
 
+//===================================================================================================================
+// HandleSerialBINData() - takes the same HEX lines from the serial port as HandleSerialHEXData(), but sends the
+// decoded bytes in windows of RFM69_OTA_WINDOW packets, see HandleWirelessBINData()
+// each line is confirmed to the host as soon as it's in the window buffer
+// this is called at the OTA programmer side
+//===================================================================================================================
+uint8_t HandleSerialBINData(RFM69& radio, uint8_t targetID, uint16_t TIMEOUT, uint16_t ACKTIMEOUT, uint8_t DEBUG) {
+  static uint8_t window[RFM69_OTA_WINDOW][RFM69_OTA_CHUNK];
+  long now=millis();
+  uint16_t seq=0, inputLen;
+  uint16_t base=0; //packet number of window[0]
+  uint16_t used=0; //image bytes in window
+  uint32_t size=0, crc=0;
+  uint8_t remoteID = radio.SENDERID; //save the remoteID as soon as possible
+  char input[115];
+
+  while(1) {
+    inputLen = readSerialLine(input);
+    if (inputLen == 0) goto timeoutcheck;
+
+    if (inputLen >= 6 && input[0]=='F' && input[1]=='L' && input[2]=='X') { //FLX:9:
+      if (input[3]==':')
+      {
+        unsigned int tmp = 0;
+        int index = 0;
+        if (sscanf(input, "FLX:%u:%n", &tmp, &index) < 1 || index == 0) return false;
+        now = millis(); //got good packet
+        uint8_t hexDataLen = validateHEXData(input+index, inputLen-index);
+
+        if (hexDataLen>0 && hexDataLen<253)
+        {
+          if (tmp==seq) //only read data when packet number is the next expected SEQ number
+          {
+            for (uint8_t i=0; i<hexDataLen; i++)
+            {
+              uint8_t b = BYTEfromHEX(input[index+8+i*2], input[index+9+i*2]); //+8 jumps over the header to the HEX raw data
+              window[used / RFM69_OTA_CHUNK][used % RFM69_OTA_CHUNK] = b;
+              crc = CRC32(crc, &b, 1);
+              size++;
+              if (++used == sizeof(window))
+              {
+                if (!sendBINWindow(radio, remoteID, window, base, used, TIMEOUT, ACKTIMEOUT, DEBUG)) return false;
+                base += RFM69_OTA_WINDOW;
+                used = 0;
+              }
+            }
+            sprintf(input, "FLX:%u:OK",seq);
+            Serial.println(input); //response to host
+            seq++;
+          }
+        }
+        else { Serial.print(F("FLX:INV:"));Serial.println(hexDataLen); }
+      }
+      if (inputLen==7 && input[3]=='?' && input[4]=='E' && input[5]=='O' && input[6]=='F')
+      {
+        if (used && !sendBINWindow(radio, remoteID, window, base, used, TIMEOUT, ACKTIMEOUT, DEBUG)) return false;
+
+        //SEND RADIO EOF, the target answers once the CRC of what it has in flash is done
+        uint8_t eof[9] = { 'E' };
+        memcpy(eof + 1, &size, 4); //both ends little endian
+        memcpy(eof + 5, &crc, 4);
+        if (DEBUG) { Serial.print(F("EOF ")); Serial.print(size); Serial.print(F(" CRC32 ")); Serial.println(crc, HEX); }
+        now = millis();
+        while (millis()-now < TIMEOUT)
+          if (radio.sendWithRetry(remoteID, eof, sizeof(eof), 2, ACKTIMEOUT) && radio.DATALEN == 2 && radio.DATA[0] == 'E')
+            return radio.DATA[1] == 1;
+        if (DEBUG) Serial.println(F("EOF fail"));
+        return false;
+      }
+    }
+
+    //abort FLASH sequence if no valid packet received for a long time
+timeoutcheck:
+    if (millis()-now > TIMEOUT)
+    {
+      Serial.print(F("Timeout getting FLASH image from SERIAL, aborting.."));
+      return false;
+    }
+  }
+}
+
+
+//===================================================================================================================
+// sendBINWindow() - sends the first length bytes of window as packets base.. and resends whatever the target
+// says is missing until it has all of them; returns false on TIMEOUT
+//===================================================================================================================
+uint8_t sendBINWindow(RFM69& radio, uint8_t targetID, uint8_t window[][RFM69_OTA_CHUNK], uint16_t base, uint16_t length, uint16_t TIMEOUT, uint16_t ACKTIMEOUT, uint8_t DEBUG)
+{
+  uint8_t count = (length + RFM69_OTA_CHUNK - 1) / RFM69_OTA_CHUNK;
+  uint8_t missing = 0xFF >> (8 - count); //bit i: packet base+i not confirmed yet
+  uint8_t resend = true;
+  uint8_t packet[3 + RFM69_OTA_CHUNK];
+  uint8_t poll[4] = { 'P', (uint8_t)base, (uint8_t)(base >> 8), count };
+  long now = millis();
+
+  while (missing)
+  {
+    if (resend)
+    {
+      for (uint8_t i = 0; i < count; i++)
+      {
+        if (!(missing & (1 << i))) continue;
+        uint16_t seq = base + i;
+        uint8_t chunk = i == count - 1 ? length - i * RFM69_OTA_CHUNK : RFM69_OTA_CHUNK;
+        packet[0] = 'B';
+        packet[1] = seq;
+        packet[2] = seq >> 8;
+        memcpy(packet + 3, window[i], chunk);
+        radio.send(targetID, packet, 3 + chunk);
+      }
+    }
+
+    //a poll that isn't answered is repeated alone, no use sending the data again before we know what's missing
+    resend = radio.sendWithRetry(targetID, poll, sizeof(poll), 2, ACKTIMEOUT) &&
+             radio.DATALEN == 5 && radio.DATA[0] == 'P' && radio.DATA[1] == poll[1] && radio.DATA[2] == poll[2];
+    if (resend)
+    {
+      missing &= ~radio.DATA[3];
+      if (DEBUG) { Serial.print(F("WIN:")); Serial.print(base); Serial.print(F(" missing ")); Serial.println(missing, BIN); }
+    }
+
+    if (millis()-now > TIMEOUT)
+    {
+      Serial.println(F("Timeout waiting for window ACK, aborting FLASH operation ..."));
+      return false;
+    }
+  }
+  return true;
+}
+
+
+//===================================================================================================================
+// CRC32() - IEEE 802.3 CRC32 (as zlib's crc32()), start with crc=0 and feed it the result of the previous call
+//===================================================================================================================
+uint32_t CRC32(uint32_t crc, const uint8_t* data, uint16_t length)
+{
+  crc = ~crc;
+  while (length--)
+  {
+    crc ^= *data++;
+    for (uint8_t k = 0; k < 8; k++)
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0 - (crc & 1)));
+  }
+  return ~crc;
+}
+
+
 //===================================================================================================================
 // validateHEXData() - returns length of HEX data bytes if everything is valid
 //returns 0 if any validation failed
@@ -57,28 +57,43 @@
   #define ACK_TIMEOUT 20
 #endif
 
+// Binary transfers ("FLX?BIN" handshake): the MAIN node decodes the HEX lines and sends raw image bytes,
+// RFM69_OTA_CHUNK per packet, and asks for one ACK per RFM69_OTA_WINDOW packets; the size and CRC32 of
+// the whole image are checked before the flash image is marked valid. Remotes that don't know it fall back to HEX.
+#define RFM69_OTA_CHUNK 58 // RF69_MAX_DATA_LEN minus 'B' and a 2 byte packet number
+#ifndef RFM69_OTA_WINDOW
+  #define RFM69_OTA_WINDOW 8 // costs RFM69_OTA_CHUNK bytes of RAM per packet on the MAIN node
+#endif
+#if RFM69_OTA_WINDOW < 1 || RFM69_OTA_WINDOW > 8
+  #error RFM69_OTA_WINDOW must be 1..8
+#endif
+
 //functions used in the REMOTE node
 void CheckForWirelessHEX(RFM69& radio, SPIFlash& flash, uint8_t DEBUG=false, uint8_t LEDpin=LED);
-void HandleHandshakeACK(RFM69& radio, SPIFlash& flash, uint8_t flashCheck=true);
+void HandleHandshakeACK(RFM69& radio, SPIFlash& flash, uint8_t flashCheck=true, uint8_t binary=false);
 void resetUsingWatchdog(uint8_t DEBUG=false);
 uint8_t HandleWirelessHEXData(RFM69& radio, uint8_t remoteID, SPIFlash& flash, uint8_t DEBUG=false, uint8_t LEDpin=LED);
+uint8_t HandleWirelessBINData(RFM69& radio, uint8_t remoteID, SPIFlash& flash, uint8_t DEBUG=false, uint8_t LEDpin=LED);
 
 #ifdef SHIFTCHANNEL
-uint8_t HandleWirelessHEXDataWrapper(RFM69& radio, uint8_t remoteID, SPIFlash& flash, uint8_t DEBUG=false, uint8_t LEDpin=LED);
+uint8_t HandleWirelessHEXDataWrapper(RFM69& radio, uint8_t remoteID, SPIFlash& flash, uint8_t DEBUG=false, uint8_t LEDpin=LED, uint8_t binary=false);
 #endif
 
 //functions used in the MAIN node
 uint8_t CheckForSerialHEX(uint8_t* input, uint8_t inputLen, RFM69& radio, uint8_t targetID, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false);
 uint8_t HandleSerialHandshake(RFM69& radio, uint8_t targetID, uint8_t isEOF, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false);
 uint8_t HandleSerialHEXData(RFM69& radio, uint8_t targetID, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false);
+uint8_t HandleSerialBINData(RFM69& radio, uint8_t targetID, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false);
 #ifdef SHIFTCHANNEL
-uint8_t HandleSerialHEXDataWrapper(RFM69& radio, uint8_t targetID, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false);
+uint8_t HandleSerialHEXDataWrapper(RFM69& radio, uint8_t targetID, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false, uint8_t binary=false);
 #endif
 uint8_t waitForAck(RFM69& radio, uint8_t fromNodeID, uint16_t ACKTIMEOUT=ACK_TIMEOUT);
 
 uint8_t validateHEXData(void* data, uint8_t length);
 uint8_t prepareSendBuffer(char* hexdata, uint8_t*buf, uint8_t length, uint16_t seq);
 uint8_t sendHEXPacket(RFM69& radio, uint8_t remoteID, uint8_t* sendBuf, uint8_t hexDataLen, uint16_t seq, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false);
+uint8_t sendBINWindow(RFM69& radio, uint8_t remoteID, uint8_t window[][RFM69_OTA_CHUNK], uint16_t base, uint16_t length, uint16_t TIMEOUT=DEFAULT_TIMEOUT, uint16_t ACKTIMEOUT=ACK_TIMEOUT, uint8_t DEBUG=false);
+uint32_t CRC32(uint32_t crc, const uint8_t* data, uint16_t length);
 uint8_t BYTEfromHEX(char MSB, char LSB);
 uint8_t readSerialLine(char* input, char endOfLineChar=10, uint8_t maxLength=115, uint16_t timeout=1000);
 void PrintHex83(uint8_t* data, uint8_t length);
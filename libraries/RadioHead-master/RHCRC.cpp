@@ -42,40 +42,75 @@
 
 #include <RHCRC.h>
 
+#if defined(__AVR__)
+// avr-libc has these as hand written assembler, which beats any table on AVR
+#include <util/crc16.h>
+
+uint16_t RHcrc16_update(uint16_t crc, uint8_t a)
+{
+    return _crc16_update(crc, a);
+}
+
+uint16_t RHcrc_xmodem_update (uint16_t crc, uint8_t data)
+{
+    return _crc_xmodem_update(crc, data);
+}
+
+uint16_t RHcrc_ccitt_update (uint16_t crc, uint8_t data)
+{
+    return _crc_ccitt_update(crc, data);
+}
+
+uint8_t RHcrc_ibutton_update(uint8_t crc, uint8_t data)
+{
+    return _crc_ibutton_update(crc, data);
+}
+
+#else
+
 #define lo8(x) ((x)&0xff) 
 #define hi8(x) ((x)>>8)
 
+// Elsewhere each byte is done a nibble at a time, from a 16 entry table
+// per polynomial, instead of bit by bit. The tables are small enough to
+// stay in flash on any of the 32 bit platforms.
+
+// 0xA001, reflected
+static const uint16_t crc16_nibble[16] =
+{
+    0x0000, 0xcc01, 0xd801, 0x1400, 0xf001, 0x3c00, 0x2800, 0xe401,
+    0xa001, 0x6c00, 0x7800, 0xb401, 0x5000, 0x9c01, 0x8801, 0x4400
+};
+
+// 0x1021, most significant bit first
+static const uint16_t xmodem_nibble[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef
+};
+
+// 0x8C, reflected (Dallas/Maxim 1-Wire)
+static const uint8_t ibutton_nibble[16] =
+{
+    0x00, 0x9d, 0x23, 0xbe, 0x46, 0xdb, 0x65, 0xf8,
+    0x8c, 0x11, 0xaf, 0x32, 0xca, 0x57, 0xe9, 0x74
+};
+
 uint16_t RHcrc16_update(uint16_t crc, uint8_t a)
 {
-    int i;
-
-    crc ^= a;
-    for (i = 0; i < 8; ++i)
-    {
-	if (crc & 1)
-	    crc = (crc >> 1) ^ 0xA001;
-	else
-	    crc = (crc >> 1);
-    }
+    crc = (crc >> 4) ^ crc16_nibble[(crc ^ a) & 0xf];
+    crc = (crc >> 4) ^ crc16_nibble[(crc ^ (a >> 4)) & 0xf];
     return crc;
 }
 
 uint16_t RHcrc_xmodem_update (uint16_t crc, uint8_t data)
 {
-    int i;
-    
-    crc = crc ^ ((uint16_t)data << 8);
-    for (i=0; i<8; i++)
-    {
-	if (crc & 0x8000)
-	    crc = (crc << 1) ^ 0x1021;
-	else
-	    crc <<= 1;
-    }
-    
+    crc = (crc << 4) ^ xmodem_nibble[((crc >> 12) ^ (data >> 4)) & 0xf];
+    crc = (crc << 4) ^ xmodem_nibble[((crc >> 12) ^ data) & 0xf];
     return crc;
 }
 
+// Already branch free and table free
 uint16_t RHcrc_ccitt_update (uint16_t crc, uint8_t data)
 {
     data ^= lo8 (crc);
@@ -87,18 +122,37 @@ uint16_t RHcrc_ccitt_update (uint16_t crc, uint8_t data)
 
 uint8_t RHcrc_ibutton_update(uint8_t crc, uint8_t data)
 {
-    uint8_t i;
-    
-    crc = crc ^ data;
-    for (i = 0; i < 8; i++)
-    {
-	if (crc & 0x01)
-	    crc = (crc >> 1) ^ 0x8C;
-	else
-	    crc >>= 1;
-    }
-    
+    crc = (crc >> 4) ^ ibutton_nibble[(crc ^ data) & 0xf];
+    crc = (crc >> 4) ^ ibutton_nibble[(crc ^ (data >> 4)) & 0xf];
+    return crc;
+}
+
+#endif
+
+uint16_t RHcrc16(const uint8_t* data, uint16_t len, uint16_t crc)
+{
+    while (len--)
+	crc = RHcrc16_update(crc, *data++);
     return crc;
 }
 
+uint16_t RHcrc_xmodem(const uint8_t* data, uint16_t len, uint16_t crc)
+{
+    while (len--)
+	crc = RHcrc_xmodem_update(crc, *data++);
+    return crc;
+}
 
+uint16_t RHcrc_ccitt(const uint8_t* data, uint16_t len, uint16_t crc)
+{
+    while (len--)
+	crc = RHcrc_ccitt_update(crc, *data++);
+    return crc;
+}
+
+uint8_t RHcrc_ibutton(const uint8_t* data, uint16_t len, uint8_t crc)
+{
+    while (len--)
+	crc = RHcrc_ibutton_update(crc, *data++);
+    return crc;
+}
@@ -16,4 +16,11 @@ extern uint16_t RHcrc_xmodem_update (uint16_t crc, uint8_t data);
 extern uint16_t RHcrc_ccitt_update (uint16_t crc, uint8_t data);
 extern uint8_t  RHcrc_ibutton_update(uint8_t crc, uint8_t data);
 
+// The same over a whole buffer. crc is where to start from: the usual
+// initial value by default, or the result of an earlier call to continue it
+extern uint16_t RHcrc16(const uint8_t* data, uint16_t len, uint16_t crc = 0xffff);
+extern uint16_t RHcrc_xmodem(const uint8_t* data, uint16_t len, uint16_t crc = 0);
+extern uint16_t RHcrc_ccitt(const uint8_t* data, uint16_t len, uint16_t crc = 0xffff);
+extern uint8_t  RHcrc_ibutton(const uint8_t* data, uint16_t len, uint8_t crc = 0);
+
 #endif
@@ -68,6 +68,11 @@ bool RHGenericDriver::waitPacketSent(uint16_t timeout)
     return false;
 }
 
+bool RHGenericDriver::isSending()
+{
+    return _mode == RHModeTx;
+}
+
 // Wait until no channel activity detected or timeout
 bool RHGenericDriver::waitCAD()
 {
@@ -115,6 +115,12 @@ public:
     /// \return true if the radio completed transmission within the timeout period. False if it timed out.
     virtual bool            waitPacketSent(uint16_t timeout);
 
+    /// Tells whether a message is still being transmitted, without blocking.
+    /// Once it returns false, waitPacketSent() returns at once. Some drivers must call it
+    /// to finish the transmission before they can receive again.
+    /// \return true if the transmitter is busy with the last message passed to send()
+    virtual bool            isSending();
+
     /// Starts the receiver and blocks until a received message is available or a timeout
     /// \param[in] timeout Maximum time to wait in milliseconds.
     /// \return true if a message is available
@@ -13,13 +13,19 @@
 
 #include <RHMesh.h>
 
-uint8_t RHMesh::_tmpMessage[RH_ROUTER_MAX_MESSAGE_LEN];
+RH_THREAD_LOCAL uint8_t RHMesh::_tmpMessage[RH_ROUTER_MAX_MESSAGE_LEN];
 
 ////////////////////////////////////////////////////////////////////
 // Constructors
 RHMesh::RHMesh(RHGenericDriver& driver, uint8_t thisAddress) 
     : RHRouter(driver, thisAddress)
 {
+    memset(_seen, 0, sizeof(_seen));
+    _nextSeen = 0;
+    memset(_noRoute, 0, sizeof(_noRoute));
+    _nextNoRoute = 0;
+    _discoveriesSuppressed = 0;
+    _duplicatesSuppressed = 0;
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -36,8 +42,23 @@ uint8_t RHMesh::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address, uint8_t f
     if (address != RH_BROADCAST_ADDRESS)
     {
 	RoutingTableEntry* route = getRouteTo(address);
-	if (!route && !doArp(address))
-	    return RH_ROUTER_ERROR_NO_ROUTE;
+	if (!route)
+	{
+	    // Don't flood the mesh again for a node that just didn't answer
+	    if (noRouteTo(address))
+	    {
+		_discoveriesSuppressed++;
+		return RH_ROUTER_ERROR_NO_ROUTE;
+	    }
+	    if (!doArp(address))
+	    {
+		_noRoute[_nextNoRoute].dest = address;
+		_noRoute[_nextNoRoute].valid = true;
+		_noRoute[_nextNoRoute].time = millis();
+		_nextNoRoute = (_nextNoRoute + 1) % RH_MESH_NO_ROUTE_CACHE_SIZE;
+		return RH_ROUTER_ERROR_NO_ROUTE;
+	    }
+	}
     }
 
     // Now have a route. Contruct an application layer message and send it via that route
@@ -47,6 +68,51 @@ uint8_t RHMesh::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address, uint8_t f
     return RHRouter::sendtoWait(_tmpMessage, sizeof(RHMesh::MeshMessageHeader) + len, address, flags);
 }
 
+////////////////////////////////////////////////////////////////////
+void RHMesh::clearNoRouteCache()
+{
+    uint8_t i;
+    for (i = 0; i < RH_MESH_NO_ROUTE_CACHE_SIZE; i++)
+	_noRoute[i].valid = false;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHMesh::noRouteTo(uint8_t dest)
+{
+    uint8_t i;
+    for (i = 0; i < RH_MESH_NO_ROUTE_CACHE_SIZE; i++)
+    {
+	if (!_noRoute[i].valid)
+	    continue;
+	if (millis() - _noRoute[i].time >= RH_MESH_NO_ROUTE_TIMEOUT)
+	    _noRoute[i].valid = false;
+	else if (_noRoute[i].dest == dest)
+	    return true;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHMesh::requestSeen(uint8_t origin, uint8_t dest, uint8_t id)
+{
+    uint8_t i;
+    for (i = 0; i < RH_MESH_SEEN_REQUESTS; i++)
+    {
+	SeenRequest* r = &_seen[i];
+	if (   r->valid
+	    && r->origin == origin && r->dest == dest && r->id == id
+	    && millis() - r->time < RH_MESH_ARP_TIMEOUT)
+	    return true;
+    }
+    _seen[_nextSeen].origin = origin;
+    _seen[_nextSeen].dest = dest;
+    _seen[_nextSeen].id = id;
+    _seen[_nextSeen].valid = true;
+    _seen[_nextSeen].time = millis();
+    _nextSeen = (_nextSeen + 1) % RH_MESH_SEEN_REQUESTS;
+    return false;
+}
+
 ////////////////////////////////////////////////////////////////////
 bool RHMesh::doArp(uint8_t address)
 {
@@ -189,6 +255,13 @@ bool RHMesh::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* source, uint8_t* d
 	    // If it originally came from us, ignore it
 	    if (_source == _thisAddress)
 		return false;
+
+	    // A copy of one we already handled, that came by another path
+	    if (requestSeen(_source, d->dest, _id))
+	    {
+		_duplicatesSuppressed++;
+		return false;
+	    }
 	    
 	    uint8_t numRoutes = tmpMessageLen - sizeof(MeshMessageHeader) - 2;
 	    uint8_t i;
@@ -214,9 +287,15 @@ bool RHMesh::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* source, uint8_t* d
 		// Its for someone else, rebroadcast it, after adding ourselves to the list
 		d->route[numRoutes] = _thisAddress;
 		tmpMessageLen++;
-		// Have to impersonate the source
+		// Neighbours heard the same broadcast: don't all answer in the same instant
+#if (RH_PLATFORM == RH_PLATFORM_RASPI) // use standard library random(), bugs in random(min, max)
+		delay(random() % RH_MESH_REBROADCAST_JITTER);
+#else
+		delay(random(0, RH_MESH_REBROADCAST_JITTER));
+#endif
+		// Have to impersonate the source, and keep its ID so other relays know the request
 		// REVISIT: if this fails what can we do?
-		RHRouter::sendtoFromSourceWait(_tmpMessage, tmpMessageLen, RH_BROADCAST_ADDRESS, _source);
+		RHRouter::relayFromSourceWait(_tmpMessage, tmpMessageLen, RH_BROADCAST_ADDRESS, _source, _id, _flags);
 	    }
 	}
     }
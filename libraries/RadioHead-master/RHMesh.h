@@ -18,6 +18,27 @@
 // Timeout for address resolution in milliecs
 #define RH_MESH_ARP_TIMEOUT 4000
 
+// Destinations whose route discovery failed recently, and for how long
+// sendtoWait() gives up on them at once instead of flooding again
+#ifndef RH_MESH_NO_ROUTE_CACHE_SIZE
+#define RH_MESH_NO_ROUTE_CACHE_SIZE 4
+#endif
+#ifndef RH_MESH_NO_ROUTE_TIMEOUT
+#define RH_MESH_NO_ROUTE_TIMEOUT 10000
+#endif
+
+// Route discovery requests remembered, so a copy arriving by another path
+// is dropped instead of being relayed again. Each is kept for RH_MESH_ARP_TIMEOUT
+#ifndef RH_MESH_SEEN_REQUESTS
+#define RH_MESH_SEEN_REQUESTS 8
+#endif
+
+// Relays wait up to this many millisecs before rebroadcasting a route discovery
+// request, so neighbours that heard the same broadcast don't all transmit at once
+#ifndef RH_MESH_REBROADCAST_JITTER
+#define RH_MESH_REBROADCAST_JITTER 50
+#endif
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHMesh RHMesh.h <RHMesh.h>
 /// \brief RHRouter subclass for sending addressed, optionally acknowledged datagrams
@@ -49,6 +70,14 @@
 /// If a node receives a RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_REQUEST that already has itself 
 /// listed in the visited nodes, it knows it has already seen and rebroadcast this request, 
 /// and threfore ignores it. This prevents broadcast storms.
+/// Each node also remembers the last RH_MESH_SEEN_REQUESTS requests by their originator, 
+/// destination and end-to-end ID, so a copy that reaches it by a second path is ignored too. 
+/// Relays wait a random time of up to RH_MESH_REBROADCAST_JITTER msecs before rebroadcasting, 
+/// so nearby relays don't collide.
+///
+/// When a route discovery fails, the destination is remembered for RH_MESH_NO_ROUTE_TIMEOUT msecs
+/// and sendtoWait() to it returns RH_ROUTER_ERROR_NO_ROUTE at once, without flooding the mesh 
+/// again. clearNoRouteCache() forgets them, eg when a node is known to have come back.
 /// When a node receives a RH_MESH_MESSAGE_TYPE_ROUTE_DISCOVERY_REQUEST it can use the list of 
 /// nodes aready visited to deduce routes back towards the originating (requesting node). 
 /// This also means that when the destination node of the request is reached, it (and all 
@@ -213,6 +242,16 @@ public:
     /// \return true if a valid message was copied to buf
     bool recvfromAckTimeout(uint8_t* buf, uint8_t* len,  uint16_t timeout, uint8_t* source = NULL, uint8_t* dest = NULL, uint8_t* id = NULL, uint8_t* flags = NULL);
 
+    /// Forgets the destinations whose route discovery failed recently,
+    /// so the next sendtoWait() to any of them tries discovery again
+    void clearNoRouteCache();
+
+    /// \return The number of route discoveries not sent because the destination recently failed
+    uint32_t discoveriesSuppressed() const { return _discoveriesSuppressed; }
+
+    /// \return The number of route discovery requests dropped because they had already been seen
+    uint32_t duplicatesSuppressed() const { return _duplicatesSuppressed; }
+
 protected:
 
     /// Internal function that inspects messages being received and adjusts the routing table if necessary.
@@ -247,10 +286,47 @@ protected:
     /// \return true if the physical address of this node is identical to address
     virtual bool isPhysicalAddress(uint8_t* address, uint8_t addresslen);
 
+    /// Checks whether a route discovery request has been seen before, and remembers it if not
+    /// \param [in] origin The node that started the discovery
+    /// \param [in] dest The destination whose route is sought
+    /// \param [in] id The end-to-end ID of the request
+    /// \return true if it was already seen
+    bool requestSeen(uint8_t origin, uint8_t dest, uint8_t id);
+
+    /// \param [in] dest The destination node address
+    /// \return true if a route discovery for dest failed less than RH_MESH_NO_ROUTE_TIMEOUT msecs ago
+    bool noRouteTo(uint8_t dest);
+
 private:
     /// Temporary message buffer
-    static uint8_t _tmpMessage[RH_ROUTER_MAX_MESSAGE_LEN];
+    static RH_THREAD_LOCAL uint8_t _tmpMessage[RH_ROUTER_MAX_MESSAGE_LEN];
+
+    typedef struct
+    {
+	uint8_t      origin;
+	uint8_t      dest;
+	uint8_t      id;
+	uint8_t      valid;
+	uint32_t     time;     ///< millis() when first seen
+    } SeenRequest;
+
+    typedef struct
+    {
+	uint8_t      dest;
+	uint8_t      valid;
+	uint32_t     time;     ///< millis() when the discovery failed
+    } NoRoute;
+
+    /// Recent route discovery requests, oldest overwritten first
+    SeenRequest          _seen[RH_MESH_SEEN_REQUESTS];
+    uint8_t              _nextSeen;
+
+    /// Recent failed route discoveries, oldest overwritten first
+    NoRoute              _noRoute[RH_MESH_NO_ROUTE_CACHE_SIZE];
+    uint8_t              _nextNoRoute;
 
+    uint32_t             _discoveriesSuppressed;
+    uint32_t             _duplicatesSuppressed;
 };
 
 /// @example rf22_mesh_client.pde
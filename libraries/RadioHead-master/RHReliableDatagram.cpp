@@ -23,6 +23,11 @@ RHReliableDatagram::RHReliableDatagram(RHGenericDriver& driver, uint8_t thisAddr
     _timeout = RH_DEFAULT_TIMEOUT;
     _retries = RH_DEFAULT_RETRIES;
     memset(_seenIds, 0, sizeof(_seenIds));
+    _asyncState = RH_ASYNC_IDLE;
+    _sendCallback = NULL;
+    _window = RH_DEFAULT_WINDOW;
+    _windowActive = false;
+    _windowDoneBase = 0; // None completed yet
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -44,6 +49,16 @@ uint8_t RHReliableDatagram::retries()
     return _retries;
 }
 
+////////////////////////////////////////////////////////////////////
+void RHReliableDatagram::setWindow(uint8_t window)
+{
+    if (window < 1)
+	window = 1;
+    if (window > RH_MAX_WINDOW)
+	window = RH_MAX_WINDOW;
+    _window = window;
+}
+
 ////////////////////////////////////////////////////////////////////
 bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
 {
@@ -53,7 +68,7 @@ bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
     while (retries++ <= _retries)
     {
 	setHeaderId(thisSequenceNumber);
-	setHeaderFlags(RH_FLAGS_NONE, RH_FLAGS_ACK); // Clear the ACK flag
+	setHeaderFlags(RH_FLAGS_NONE, RH_FLAGS_ACK | RH_FLAGS_WINDOW | RH_FLAGS_POLL); // Clear the ACK flag
 	sendto(buf, len, address);
 	waitPacketSent();
 
@@ -65,14 +80,7 @@ bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
 	    _retransmissions++;
 	unsigned long thisSendTime = millis(); // Timeout does not include original transmit time
 
-	// Compute a new timeout, random between _timeout and _timeout*2
-	// This is to prevent collisions on every retransmit
-	// if 2 nodes try to transmit at the same time
-#if (RH_PLATFORM == RH_PLATFORM_RASPI) // use standard library random(), bugs in random(min, max)
-	uint16_t timeout = _timeout + (_timeout * (random() & 0xFF) / 256);
-#else
-	uint16_t timeout = _timeout + (_timeout * random(0, 256) / 256);
-#endif
+	uint16_t timeout = randomTimeout();
 	int32_t timeLeft;
         while ((timeLeft = timeout - (millis() - thisSendTime)) > 0)
 	{
@@ -85,12 +93,13 @@ bool RHReliableDatagram::sendtoWait(uint8_t* buf, uint8_t len, uint8_t address)
 		    if (   from == address 
 			   && to == _thisAddress 
 			   && (flags & RH_FLAGS_ACK) 
+			   && !(flags & RH_FLAGS_WINDOW)
 			   && (id == thisSequenceNumber))
 		    {
 			// Its the ACK we are waiting for
 			return true;
 		    }
-		    else if (   !(flags & RH_FLAGS_ACK)
+		    else if (   !(flags & (RH_FLAGS_ACK | RH_FLAGS_WINDOW))
 				&& (id == _seenIds[from]))
 		    {
 			// This is a request we have already received. ACK it again
@@ -119,8 +128,20 @@ bool RHReliableDatagram::recvfromAck(uint8_t* buf, uint8_t* len, uint8_t* from,
     // Get the message before its clobbered by the ACK (shared rx and tx buffer in some drivers
     if (available() && recvfrom(buf, len, &_from, &_to, &_id, &_flags))
     {
-	// Never ACK an ACK
-	if (!(_flags & RH_FLAGS_ACK))
+	// The ack sendPoll() is waiting for?
+	if (   _asyncState == RH_ASYNC_WAITING
+	    && (_flags & RH_FLAGS_ACK)
+	    && !(_flags & RH_FLAGS_WINDOW)
+	    && _from == _asyncTo
+	    && _to == _thisAddress
+	    && _id == _asyncId)
+	{
+	    asyncState(RH_ASYNC_ACKED);
+	    return false;
+	}
+
+	// Never ACK an ACK. Windowed frames are for recvfromWindowAck()
+	if (!(_flags & (RH_FLAGS_ACK | RH_FLAGS_WINDOW)))
 	{
 	    // Its a normal message not an ACK
 	    if (_to ==_thisAddress)
@@ -176,7 +197,7 @@ void RHReliableDatagram::resetRetransmissions()
 void RHReliableDatagram::acknowledge(uint8_t id, uint8_t from)
 {
     setHeaderId(id);
-    setHeaderFlags(RH_FLAGS_ACK);
+    setHeaderFlags(RH_FLAGS_ACK, RH_FLAGS_WINDOW | RH_FLAGS_POLL);
     // We would prefer to send a zero length ACK,
     // but if an RH_RF22 receives a 0 length message with a CRC error, it will never receive
     // a 0 length message again, until its reset, which makes everything hang :-(
@@ -187,3 +208,335 @@ void RHReliableDatagram::acknowledge(uint8_t id, uint8_t from)
     waitPacketSent();
 }
 
+
+////////////////////////////////////////////////////////////////////
+uint16_t RHReliableDatagram::randomTimeout()
+{
+    // Compute a new timeout, random between _timeout and _timeout*2
+    // This is to prevent collisions on every retransmit
+    // if 2 nodes try to transmit at the same time
+#if (RH_PLATFORM == RH_PLATFORM_RASPI) // use standard library random(), bugs in random(min, max)
+    return _timeout + (_timeout * (random() & 0xFF) / 256);
+#else
+    return _timeout + (_timeout * random(0, 256) / 256);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHReliableDatagram::sendAsync(uint8_t* buf, uint8_t len, uint8_t address)
+{
+    if (_asyncState == RH_ASYNC_SENDING || _asyncState == RH_ASYNC_WAITING)
+	return false;
+    _asyncBuf = buf;
+    _asyncLen = len;
+    _asyncTo = address;
+    _asyncId = ++_lastSequenceNumber;
+    _asyncTries = 0;
+    asyncTransmit();
+    return _asyncState == RH_ASYNC_SENDING;
+}
+
+////////////////////////////////////////////////////////////////////
+uint8_t RHReliableDatagram::sendPoll()
+{
+    if (_asyncState == RH_ASYNC_SENDING)
+    {
+	if (_driver.isSending())
+	    return _asyncState;
+	waitPacketSent(); // Returns at once, and lets drivers that poll their status go idle
+	if (_asyncTo == RH_BROADCAST_ADDRESS)
+	{
+	    // Never wait for ACKS to broadcasts
+	    asyncState(RH_ASYNC_ACKED);
+	    return _asyncState;
+	}
+	_asyncSent = millis(); // Timeout does not include transmit time
+	_asyncTimeout = randomTimeout();
+	asyncState(RH_ASYNC_WAITING);
+    }
+    if (_asyncState != RH_ASYNC_WAITING)
+	return _asyncState;
+
+    if (available())
+    {
+	uint8_t from, to, id, flags;
+	if (recvfrom(0, 0, &from, &to, &id, &flags)) // Discards the message
+	{
+	    if (   from == _asyncTo
+		&& to == _thisAddress
+		&& (flags & RH_FLAGS_ACK)
+		&& !(flags & RH_FLAGS_WINDOW)
+		&& id == _asyncId)
+	    {
+		asyncState(RH_ASYNC_ACKED);
+		return _asyncState;
+	    }
+	    else if (   !(flags & (RH_FLAGS_ACK | RH_FLAGS_WINDOW))
+		     && (id == _seenIds[from]))
+	    {
+		// This is a request we have already received. ACK it again
+		acknowledge(id, from);
+	    }
+	}
+    }
+
+    if (millis() - _asyncSent >= _asyncTimeout)
+    {
+	if (_asyncTries > _retries)
+	{
+	    asyncState(RH_ASYNC_FAILED);
+	    return _asyncState;
+	}
+	_retransmissions++;
+	asyncTransmit();
+    }
+    return _asyncState;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHReliableDatagram::setSendCallback(RHSendCallback callback)
+{
+    _sendCallback = callback;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHReliableDatagram::asyncTransmit()
+{
+    _asyncTries++;
+    setHeaderId(_asyncId);
+    setHeaderFlags(RH_FLAGS_NONE, RH_FLAGS_ACK | RH_FLAGS_WINDOW | RH_FLAGS_POLL);
+    asyncState(sendto(_asyncBuf, _asyncLen, _asyncTo) ? RH_ASYNC_SENDING : RH_ASYNC_FAILED);
+}
+
+////////////////////////////////////////////////////////////////////
+void RHReliableDatagram::asyncState(uint8_t state)
+{
+    _asyncState = state;
+    if (_sendCallback)
+	_sendCallback(state, _asyncTo);
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHReliableDatagram::sendtoWindowWait(const uint8_t* data, uint16_t len, uint8_t address)
+{
+    uint8_t maxLen = _driver.maxMessageLength();
+    if (address == RH_BROADCAST_ADDRESS || maxLen < RH_WINDOW_HEADER_LEN + 2)
+	return false;
+    uint8_t chunk = maxLen - RH_WINDOW_HEADER_LEN;
+    // A chunk of at least 2 keeps the last index below RH_WINDOW_REFUSED
+    uint16_t last = len ? (len - 1) / chunk : 0;
+
+    uint8_t transfer = ++_lastSequenceNumber;
+    uint16_t base = 0;   // First frame not acknowledged
+    uint8_t acked = 0;   // Bit n set when frame base+1+n has been acknowledged
+    uint32_t next = 0;   // First frame never sent
+    uint8_t retries = 0;
+    uint8_t frame[RH_MAX_MESSAGE_LEN];
+
+    setHeaderId(transfer);
+    while (retries <= _retries)
+    {
+	// Send whatever is still missing in the window. The last frame sent polls for an ack
+	uint32_t end = (uint32_t)base + _window - 1;
+	if (end > last)
+	    end = last;
+	while (end > base && (acked & (1 << (end - base - 1))))
+	    end--;
+	for (uint32_t i = base; i <= end; i++)
+	{
+	    if (i != base && (acked & (1 << (i - base - 1))))
+		continue;
+	    uint32_t offset = i * chunk;
+	    uint8_t n = (len - offset) < chunk ? (len - offset) : chunk;
+	    frame[0] = i & 0xff;
+	    frame[1] = i >> 8;
+	    frame[2] = last & 0xff;
+	    frame[3] = last >> 8;
+	    frame[4] = chunk;
+	    memcpy(frame + RH_WINDOW_HEADER_LEN, data + offset, n);
+	    setHeaderFlags(i == end ? (RH_FLAGS_WINDOW | RH_FLAGS_POLL) : RH_FLAGS_WINDOW,
+			   RH_FLAGS_ACK | RH_FLAGS_WINDOW | RH_FLAGS_POLL);
+	    sendto(frame, RH_WINDOW_HEADER_LEN + n, address);
+	    waitPacketSent();
+	    if (i < next)
+		_retransmissions++;
+	}
+	if (end >= next)
+	    next = end + 1;
+
+	// Wait for the selective ack. Earlier, delayed acks are skipped
+	bool progress = false;
+	unsigned long thisSendTime = millis();
+	uint16_t timeout = randomTimeout();
+	int32_t timeLeft;
+	while ((timeLeft = timeout - (millis() - thisSendTime)) > 0)
+	{
+	    if (waitAvailableTimeout(timeLeft))
+	    {
+		uint8_t ack[RH_WINDOW_ACK_LEN];
+		uint8_t ackLen = sizeof(ack);
+		uint8_t from, to, id, flags;
+		if (recvfrom(ack, &ackLen, &from, &to, &id, &flags))
+		{
+		    if (   from == address
+			&& to == _thisAddress
+			&& (flags & RH_FLAGS_ACK)
+			&& (flags & RH_FLAGS_WINDOW)
+			&& id == transfer
+			&& ackLen == RH_WINDOW_ACK_LEN)
+		    {
+			uint16_t ackBase = ack[0] | (ack[1] << 8);
+			if (ackBase == RH_WINDOW_REFUSED)
+			    return false;
+			if (ackBase > last)
+			    return true;
+			if (ackBase < base)
+			    continue;
+			progress = ackBase > base || (ack[2] & ~acked);
+			base = ackBase;
+			acked = ack[2];
+			break;
+		    }
+		    else if (   !(flags & (RH_FLAGS_ACK | RH_FLAGS_WINDOW))
+			     && (id == _seenIds[from]))
+		    {
+			// This is a request we have already received. ACK it again
+			acknowledge(id, from);
+			setHeaderId(transfer);
+		    }
+		    // Else discard it
+		}
+	    }
+	    YIELD;
+	}
+	if (progress)
+	    retries = 0;
+	else
+	    retries++;
+	YIELD;
+    }
+    // Retries exhausted
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHReliableDatagram::recvfromWindowAck(uint8_t* buf, uint16_t* len, uint8_t* from)
+{
+    uint8_t frame[RH_MAX_MESSAGE_LEN];
+    uint8_t frameLen = sizeof(frame);
+    uint8_t _from, _to, _id, _flags;
+    if (!available() || !recvfrom(frame, &frameLen, &_from, &_to, &_id, &_flags))
+	return false;
+    if (   !(_flags & RH_FLAGS_WINDOW)
+	|| (_flags & RH_FLAGS_ACK)
+	|| _to != _thisAddress
+	|| frameLen < RH_WINDOW_HEADER_LEN)
+	return false; // Not a windowed frame for us: discarded
+
+    uint16_t index = frame[0] | (frame[1] << 8);
+    uint16_t last = frame[2] | (frame[3] << 8);
+    uint8_t chunk = frame[4];
+    uint8_t n = frameLen - RH_WINDOW_HEADER_LEN;
+
+    if (_windowActive && (_from != _windowFrom || _id != _windowId))
+    {
+	// Another node must wait until this transfer finishes or its sender gives up.
+	// A new transfer from the same node means that it has already given up
+	if (   _from != _windowFrom
+	    && millis() - _windowHeard < (uint32_t)_timeout * 2 * (_retries + 1))
+	    return false;
+	_windowActive = false;
+    }
+    if (!_windowActive)
+    {
+	if (_windowDoneBase && _from == _windowDoneFrom && _id == _windowDoneId)
+	{
+	    // The sender lost our final ack and is still polling
+	    if (_flags & RH_FLAGS_POLL)
+		windowAcknowledge(_id, _from, _windowDoneBase, 0);
+	    return false;
+	}
+	if (chunk == 0 || (uint32_t)last * chunk >= *len)
+	{
+	    windowAcknowledge(_id, _from, RH_WINDOW_REFUSED, 0);
+	    return false;
+	}
+	_windowActive = true;
+	_windowFrom = _from;
+	_windowId = _id;
+	_windowChunk = chunk;
+	_windowLast = last;
+	_windowBase = 0;
+	_windowReceived = 0;
+	_windowLength = 0;
+    }
+    _windowHeard = millis();
+
+    // Keep frames up to 8 beyond the first missing one, which is what the ack can report
+    if (   chunk == _windowChunk
+	&& last == _windowLast
+	&& index <= _windowLast
+	&& index >= _windowBase
+	&& index - _windowBase <= 8
+	&& n <= chunk
+	&& !(_windowReceived & (1 << (index - _windowBase))))
+    {
+	uint32_t offset = (uint32_t)index * chunk;
+	if (offset + n > *len)
+	{
+	    _windowActive = false;
+	    windowAcknowledge(_id, _from, RH_WINDOW_REFUSED, 0);
+	    return false;
+	}
+	memcpy(buf + offset, frame + RH_WINDOW_HEADER_LEN, n);
+	if (index == _windowLast)
+	    _windowLength = offset + n;
+	_windowReceived |= 1 << (index - _windowBase);
+	while (_windowReceived & 1)
+	{
+	    _windowReceived >>= 1;
+	    _windowBase++;
+	}
+    }
+
+    bool complete = _windowBase > _windowLast;
+    if (complete || (_flags & RH_FLAGS_POLL))
+	windowAcknowledge(_id, _from, _windowBase, _windowReceived >> 1);
+    if (!complete)
+	return false;
+
+    _windowActive = false;
+    _windowDoneFrom = _from;
+    _windowDoneId = _id;
+    _windowDoneBase = _windowBase;
+    *len = _windowLength;
+    if (from) *from = _from;
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////
+bool RHReliableDatagram::recvfromWindowAckTimeout(uint8_t* buf, uint16_t* len, uint16_t timeout, uint8_t* from)
+{
+    unsigned long starttime = millis();
+    int32_t timeLeft;
+    while ((timeLeft = timeout - (millis() - starttime)) > 0)
+    {
+	if (waitAvailableTimeout(timeLeft))
+	{
+	    if (recvfromWindowAck(buf, len, from))
+		return true;
+	}
+	YIELD;
+    }
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////
+void RHReliableDatagram::windowAcknowledge(uint8_t id, uint8_t to, uint16_t base, uint8_t bitmap)
+{
+    setHeaderId(id);
+    setHeaderFlags(RH_FLAGS_ACK | RH_FLAGS_WINDOW, RH_FLAGS_POLL);
+    uint8_t ack[RH_WINDOW_ACK_LEN] = { (uint8_t)(base & 0xff), (uint8_t)(base >> 8), bitmap };
+    sendto(ack, sizeof(ack), to);
+    waitPacketSent();
+}
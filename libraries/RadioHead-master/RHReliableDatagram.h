@@ -14,12 +14,50 @@
 // for application layer use.
 #define RH_FLAGS_ACK 0x80
 
+// Frames of a windowed transfer (see sendtoWindowWait()) and their selective acknowledgements
+#define RH_FLAGS_WINDOW 0x40
+
+// Set on the frame that ends each burst of a windowed transfer. The receiver
+// answers it with a selective acknowledgement
+#define RH_FLAGS_POLL 0x20
+
 /// the default retry timeout in milliseconds
 #define RH_DEFAULT_TIMEOUT 200
 
 /// The default number of retries
 #define RH_DEFAULT_RETRIES 3
 
+/// The default number of frames sendtoWindowWait() keeps in flight
+#ifndef RH_DEFAULT_WINDOW
+#define RH_DEFAULT_WINDOW 4
+#endif
+
+/// The largest window. A selective acknowledgement reports the first missing frame
+/// and a bitmap of the 8 frames after it
+#define RH_MAX_WINDOW 9
+
+/// Octets at the front of each windowed frame: index (2), last index (2) and chunk size (1)
+#define RH_WINDOW_HEADER_LEN 5
+
+/// Octets in a selective acknowledgement: first missing index (2) and bitmap (1)
+#define RH_WINDOW_ACK_LEN 3
+
+/// First missing index that tells the sender the transfer is refused (it does not fit the receiver's buffer)
+#define RH_WINDOW_REFUSED 0xffff
+
+// States of the message started by sendAsync(), as returned by sendPoll()
+#define RH_ASYNC_IDLE     0 ///< Nothing sent yet
+#define RH_ASYNC_SENDING  1 ///< The transmitter is busy with the message
+#define RH_ASYNC_WAITING  2 ///< Transmitted, waiting for the ack
+#define RH_ASYNC_ACKED    3 ///< Acknowledged, or transmitted if it was a broadcast
+#define RH_ASYNC_FAILED   4 ///< Retries exhausted, or the driver refused the message
+
+/// Called by sendPoll() or recvfromAck() whenever the state of the message started by sendAsync() changes.
+/// Called from the sketch's context, never from an interrupt.
+/// \param[in] state The new state, one of RH_ASYNC_*
+/// \param[in] address The address the message was sent to
+typedef void (*RHSendCallback)(uint8_t state, uint8_t address);
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHReliableDatagram RHReliableDatagram.h <RHReliableDatagram.h>
 /// \brief RHDatagram subclass for sending addressed, acknowledged, retransmitted datagrams.
@@ -69,6 +107,53 @@
 /// retransmit strategy and configuration lest they hang for a long time
 /// trying to reply to clients that are unreachable.
 ///
+/// \par Non-blocking sends
+///
+/// sendtoWait() keeps the CPU busy until the message has been transmitted and acknowledged. With LoRa at a high
+/// spreading factor, that can be most of a second per try.
+/// sendAsync() loads the message into the transmitter and returns at once. The sketch then calls sendPoll() from its
+/// main loop. sendPoll() notices when the transmission has finished, watches for the ack, and
+/// retransmits after the usual randomised timeout.
+/// sendPoll() returns the state of the message (RH_ASYNC_*). The callback set with setSendCallback(), if any, is
+/// called whenever that state changes.
+/// Only one message can be in flight. Its buffer is not copied, so it must stay untouched until the
+/// message is acked or has failed.
+/// While waiting for the ack, sendPoll() consumes any message received. As in sendtoWait(), it re-acks duplicates and discards the rest.
+/// A sketch that also receives should call recvfromAck() first in its loop. recvfromAck() recognises the ack itself.
+/// Do not call sendtoWait() while a non-blocking send is in flight.
+///
+/// \par Windowed transfers
+///
+/// sendtoWait() is stop-and-wait: every message costs a full round trip, which bounds
+/// bulk transfers (such as a log of several kilobytes) by latency rather than by the radio's bit rate.
+/// sendtoWindowWait() splits a buffer of up to 65535 octets into numbered frames and keeps up to
+/// setWindow() of them in flight.
+/// The radios are half duplex, so the receiver does not answer every frame. It answers only the frame
+/// that ends each burst, which carries RH_FLAGS_POLL, and then it sends a selective acknowledgement. This ack contains
+/// the index of the first frame still missing and a bitmap of which of the next 8 it already has.
+/// The next burst carries only the frames still missing in the window, followed by new ones.
+/// If the acknowledgement is lost, the sender repeats the whole burst after the usual randomised timeout.
+/// The sender gives up after setRetries() consecutive bursts that make no progress.
+///
+/// Every frame of a transfer has the same header ID, and RH_FLAGS_WINDOW is set. The payload is:
+/// - 2 octets: the frame index, little endian
+/// - 2 octets: the index of the last frame, little endian
+/// - 1 octet: the chunk size, so the receiver can place frames that arrive out of order
+/// - up to maxMessageLength() - 5 octets of data
+///
+/// A selective acknowledgement has RH_FLAGS_ACK and RH_FLAGS_WINDOW set, and the ID of the transfer.
+/// Its payload is the first missing index (2 octets, little endian) followed by the bitmap.
+/// Bit n of the bitmap is set when frame index+1+n has already arrived.
+///
+/// The receiver calls recvfromWindowAck() or recvfromWindowAckTimeout(). The whole transfer is placed
+/// in the caller's buffer, so that buffer must be large enough for it. Transfers that do not fit are
+/// refused, and sendtoWindowWait() returns false at once.
+/// The transfer in progress is kept between calls, so always pass the same buffer until one
+/// completes. Only one transfer is received at a time. Frames from another node are
+/// ignored until the current sender goes quiet, and that sender retries later.
+/// recvfromAck() ignores windowed frames, and sendtoWindowWait() to a node running an older
+/// RHReliableDatagram fails.
+///
 /// Caution: if you have a radio network with a mixture of slow and fast
 /// processors and ReliableDatagrams, you may be affected by race conditions
 /// where the fast processor acknowledges a message before the sender is ready
@@ -107,6 +192,12 @@ public:
     /// \return The currently configured maximum number of retries.
     uint8_t retries();
 
+    /// Sets the number of frames sendtoWindowWait() sends before it waits for an acknowledgement.
+    /// Defaults to RH_DEFAULT_WINDOW. Values are limited to the range 1 to RH_MAX_WINDOW.
+    /// A window of 1 is stop-and-wait, like sendtoWait().
+    /// \param[in] window The new window size in frames
+    void setWindow(uint8_t window);
+
     /// Send the message (with retries) and waits for an ack. Returns true if an acknowledgement is received.
     /// Synchronous: any message other than the desired ACK received while waiting is discarded.
     /// Blocks until an ACK is received or all retries are exhausted (ie up to retries*timeout milliseconds).
@@ -154,6 +245,51 @@ public:
     /// \return true if a valid message was copied to buf
     bool recvfromAckTimeout(uint8_t* buf, uint8_t* len,  uint16_t timeout, uint8_t* from = NULL, uint8_t* to = NULL, uint8_t* id = NULL, uint8_t* flags = NULL);
 
+    /// Starts sending a message and returns without waiting for it to be transmitted or acknowledged.
+    /// Call sendPoll() frequently until it returns RH_ASYNC_ACKED or RH_ASYNC_FAILED.
+    /// \param[in] buf Pointer to the binary message to send. It is not copied and must not change until the send completes
+    /// \param[in] len Number of octets to send
+    /// \param[in] address The address to send the message to
+    /// \return true if the message was started; false if another one is still in flight or the driver refused it
+    bool sendAsync(uint8_t* buf, uint8_t len, uint8_t address);
+
+    /// Advances the message started by sendAsync(): notices the end of transmission, looks for the ack,
+    /// and retransmits on timeout. It never blocks, except to re-ack a duplicate message (see above).
+    /// \return The state of the message, one of RH_ASYNC_*
+    uint8_t sendPoll();
+
+    /// Sets the function called whenever the state of the message started by sendAsync() changes.
+    /// \param[in] callback The function to call, or NULL for none
+    void setSendCallback(RHSendCallback callback);
+
+    /// Sends a buffer, which may be larger than one message, as a windowed transfer (see above).
+    /// It blocks until every frame has been acknowledged, or until setRetries() bursts in a row make no progress.
+    /// Any other message received while waiting is discarded, as in sendtoWait().
+    /// Broadcast transfers are not supported.
+    /// \param[in] data Pointer to the octets to send
+    /// \param[in] len Number of octets to send
+    /// \param[in] address The address to send the transfer to
+    /// \return true if the receiver acknowledged the whole transfer
+    bool sendtoWindowWait(const uint8_t* data, uint16_t len, uint8_t address);
+
+    /// Takes the next message if it is a frame of a windowed transfer addressed to this node. The frame is added to the
+    /// transfer in progress, and the sender is acknowledged if it is polling.
+    /// When the frame completes the transfer, the function returns true.
+    /// Other messages are discarded.
+    /// \param[in] buf Location the transfer is assembled in. Pass the same buffer until a transfer completes
+    /// \param[in,out] len Available space in buf. Set to the length of the transfer once it completes
+    /// \param[in] from If present and not NULL, the referenced uint8_t will be set to the SRC address
+    /// \return true if a transfer has completed in buf
+    bool recvfromWindowAck(uint8_t* buf, uint16_t* len, uint8_t* from = NULL);
+
+    /// Similar to recvfromWindowAck(), but blocks until a transfer completes or the timeout expires.
+    /// \param[in] buf Location the transfer is assembled in. Pass the same buffer until a transfer completes
+    /// \param[in,out] len Available space in buf. Set to the length of the transfer once it completes
+    /// \param[in] timeout Maximum time to wait in milliseconds
+    /// \param[in] from If present and not NULL, the referenced uint8_t will be set to the SRC address
+    /// \return true if a transfer has completed in buf
+    bool recvfromWindowAckTimeout(uint8_t* buf, uint16_t* len, uint16_t timeout, uint8_t* from = NULL);
+
     /// Returns the number of retransmissions 
     /// we have had to send since starting or since the last call to resetRetransmissions().
     /// \return The number of retransmissions since initialisation.
@@ -173,6 +309,23 @@ protected:
     /// \return true if there is a message received and it is a new message
     bool haveNewMessage();
 
+    /// Send a selective acknowledgement for the windowed transfer id to the given address
+    /// Blocks until it has been sent
+    /// \param[in] id The ID of the transfer
+    /// \param[in] to The address of the sender
+    /// \param[in] base The index of the first frame still missing
+    /// \param[in] bitmap Bit n is set if frame base+1+n has been received
+    void windowAcknowledge(uint8_t id, uint8_t to, uint16_t base, uint8_t bitmap);
+
+    /// Returns a retransmit timeout, random between _timeout and _timeout*2
+    uint16_t randomTimeout();
+
+    /// (Re)transmits the message started by sendAsync()
+    void asyncTransmit();
+
+    /// Changes the state of the message started by sendAsync() and tells the callback
+    void asyncState(uint8_t state);
+
 private:
     /// Count of retransmissions we have had to send
     uint32_t _retransmissions;
@@ -194,6 +347,44 @@ private:
     /// (this is generally due to lost ACKs, causing the sender to retransmit, even though we have already
     /// received that message)
     uint8_t _seenIds[256];
+
+    /// The message started by sendAsync()
+    uint8_t* _asyncBuf;
+    uint8_t _asyncLen;
+    uint8_t _asyncTo;
+    uint8_t _asyncId;
+    uint8_t _asyncTries;
+    uint8_t _asyncState;
+    unsigned long _asyncSent;
+    uint16_t _asyncTimeout;
+    RHSendCallback _sendCallback;
+
+    /// Frames in flight in sendtoWindowWait()
+    uint8_t _window;
+
+    /// The windowed transfer being received, if _windowActive
+    bool _windowActive;
+    uint8_t _windowFrom;
+    uint8_t _windowId;
+    uint8_t _windowChunk;
+    uint16_t _windowLast;
+
+    /// The first frame still missing
+    uint16_t _windowBase;
+
+    /// Bit n set when frame _windowBase+n has been received
+    uint16_t _windowReceived;
+
+    /// Length of the transfer, known once its last frame has arrived
+    uint16_t _windowLength;
+
+    /// When the transfer last received a frame, to tell when its sender has given up
+    unsigned long _windowHeard;
+
+    /// The last transfer completed. The sender may keep polling it if the final ack was lost
+    uint8_t _windowDoneFrom;
+    uint8_t _windowDoneId;
+    uint16_t _windowDoneBase;
 };
 
 /// @example rf22_reliable_datagram_client.pde
@@ -13,7 +13,7 @@
 
 #include <RHRouter.h>
 
-RHRouter::RoutedMessage RHRouter::_tmpMessage;
+RH_THREAD_LOCAL RHRouter::RoutedMessage RHRouter::_tmpMessage;
 
 ////////////////////////////////////////////////////////////////////
 // Constructors
@@ -21,7 +21,8 @@ RHRouter::RHRouter(RHGenericDriver& driver, uint8_t thisAddress)
     : RHReliableDatagram(driver, thisAddress)
 {
     _max_hops = RH_DEFAULT_MAX_HOPS;
-    clearRoutingTable();
+    _routesRetired = 0;
+    setRoutingTable(_defaultRoutes, RH_ROUTING_TABLE_SIZE);
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -41,65 +42,123 @@ void RHRouter::setMaxHops(uint8_t max_hops)
 }
 
 ////////////////////////////////////////////////////////////////////
-void RHRouter::addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state)
+void RHRouter::setRoutingTable(RoutingTableEntry* routes, uint8_t size)
 {
-    uint8_t i;
+    _routes = routes;
+    _routesSize = size;
+    clearRoutingTable();
+}
 
-    // First look for an existing entry we can update
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+////////////////////////////////////////////////////////////////////
+// The table is open addressed: a route lives in the slot its dest hashes to,
+// or in the first free slot after it. Lookups stop at the first free slot,
+// so deleteRoute() has to close the gap it leaves.
+uint8_t RHRouter::findRoute(uint8_t dest)
+{
+    if (_routesSize == 0)
+	return 0;
+    uint8_t i = dest % _routesSize;
+    uint8_t n;
+    for (n = 0; n < _routesSize; n++)
     {
+	if (_routes[i].state == Invalid)
+	    break;
 	if (_routes[i].dest == dest)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	    return;
-	}
+	    return i;
+	if (++i == _routesSize)
+	    i = 0;
     }
+    return _routesSize;
+}
 
-    // Look for an invalid entry we can use
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+////////////////////////////////////////////////////////////////////
+void RHRouter::addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state)
+{
+    uint8_t i = findRoute(dest);
+    uint32_t now = millis();
+
+    // First look for an existing entry we can update
+    if (i < _routesSize)
     {
-	if (_routes[i].state == Invalid)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	    return;
-	}
+	if (_routes[i].next_hop != next_hop)
+	    _routes[i].learned = now;
+	_routes[i].next_hop = next_hop;
+	_routes[i].state = state;
+	_routes[i].used = now;
+	return;
     }
+    if (_routesSize == 0)
+	return;
 
     // Need to make room for a new one
-    retireOldestRoute();
-    // Should be an invalid slot now
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
-    {
-	if (_routes[i].state == Invalid)
-	{
-	    _routes[i].dest = dest;
-	    _routes[i].next_hop = next_hop;
-	    _routes[i].state = state;
-	}
-    }
+    if (_routeCount == _routesSize)
+	retireOldestRoute();
+
+    // The first free slot from where dest hashes to
+    i = dest % _routesSize;
+    while (_routes[i].state != Invalid)
+	if (++i == _routesSize)
+	    i = 0;
+    _routes[i].dest = dest;
+    _routes[i].next_hop = next_hop;
+    _routes[i].state = state;
+    _routes[i].learned = now;
+    _routes[i].used = now;
+    _routeCount++;
 }
 
 ////////////////////////////////////////////////////////////////////
 RHRouter::RoutingTableEntry* RHRouter::getRouteTo(uint8_t dest)
 {
-    uint8_t i;
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
-	if (_routes[i].dest == dest && _routes[i].state != Invalid)
-	    return &_routes[i];
-    return NULL;
+    uint8_t i = findRoute(dest);
+    if (i == _routesSize)
+	return NULL;
+    _routes[i].used = millis();
+    return &_routes[i];
+}
+
+////////////////////////////////////////////////////////////////////
+uint32_t RHRouter::routeAge(uint8_t dest)
+{
+    uint8_t i = findRoute(dest);
+    return i < _routesSize ? millis() - _routes[i].learned : 0;
+}
+
+////////////////////////////////////////////////////////////////////
+uint32_t RHRouter::routeIdle(uint8_t dest)
+{
+    uint8_t i = findRoute(dest);
+    return i < _routesSize ? millis() - _routes[i].used : 0;
 }
 
 ////////////////////////////////////////////////////////////////////
 void RHRouter::deleteRoute(uint8_t index)
 {
-    // Delete a route by copying following routes on top of it
-    memcpy(&_routes[index], &_routes[index+1], 
-	   sizeof(RoutingTableEntry) * (RH_ROUTING_TABLE_SIZE - index - 1));
-    _routes[RH_ROUTING_TABLE_SIZE - 1].state = Invalid;
+    if (index >= _routesSize || _routes[index].state == Invalid)
+	return;
+    _routes[index].state = Invalid;
+    _routeCount--;
+
+    // Move back any following entry that a lookup would no longer reach
+    // across the slot just freed, until the run of used slots ends
+    uint8_t hole = index;
+    uint8_t i = index;
+    while (true)
+    {
+	if (++i == _routesSize)
+	    i = 0;
+	if (_routes[i].state == Invalid)
+	    break;
+	uint8_t home = _routes[i].dest % _routesSize;
+	// Is home cyclically outside (hole, i]? Then the entry must fill the hole
+	bool reachable = (hole < i) ? (home > hole && home <= i) : (home > hole || home <= i);
+	if (!reachable)
+	{
+	    _routes[hole] = _routes[i];
+	    _routes[i].state = Invalid;
+	    hole = i;
+	}
+    }
 }
 
 ////////////////////////////////////////////////////////////////////
@@ -107,7 +166,8 @@ void RHRouter::printRoutingTable()
 {
 #ifdef RH_HAVE_SERIAL
     uint8_t i;
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+    uint32_t now = millis();
+    for (i = 0; i < _routesSize; i++)
     {
 	Serial.print(i, DEC);
 	Serial.print(" Dest: ");
@@ -115,39 +175,58 @@ void RHRouter::printRoutingTable()
 	Serial.print(" Next Hop: ");
 	Serial.print(_routes[i].next_hop, DEC);
 	Serial.print(" State: ");
-	Serial.println(_routes[i].state, DEC);
+	Serial.print(_routes[i].state, DEC);
+	if (_routes[i].state != Invalid)
+	{
+	    Serial.print(" Age: ");
+	    Serial.print(now - _routes[i].learned, DEC);
+	    Serial.print(" Idle: ");
+	    Serial.print(now - _routes[i].used, DEC);
+	}
+	Serial.println("");
     }
+    Serial.print("Retired: ");
+    Serial.println(_routesRetired, DEC);
 #endif
 }
 
 ////////////////////////////////////////////////////////////////////
 bool RHRouter::deleteRouteTo(uint8_t dest)
 {
-    uint8_t i;
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
-    {
-	if (_routes[i].dest == dest)
-	{
-	    deleteRoute(i);
-	    return true;
-	}
-    }
-    return false;
+    uint8_t i = findRoute(dest);
+    if (i == _routesSize)
+	return false;
+    deleteRoute(i);
+    return true;
 }
 
 ////////////////////////////////////////////////////////////////////
 void RHRouter::retireOldestRoute()
 {
-    // We just obliterate the first in the table and clear the last
-    deleteRoute(0);
+    // Least recently used, so routes still carrying traffic survive
+    uint8_t oldest = _routesSize;
+    uint32_t now = millis();
+    uint8_t i;
+    for (i = 0; i < _routesSize; i++)
+    {
+	if (_routes[i].state == Invalid)
+	    continue;
+	if (oldest == _routesSize || now - _routes[i].used > now - _routes[oldest].used)
+	    oldest = i;
+    }
+    if (oldest == _routesSize)
+	return;
+    deleteRoute(oldest);
+    _routesRetired++;
 }
 
 ////////////////////////////////////////////////////////////////////
 void RHRouter::clearRoutingTable()
 {
     uint8_t i;
-    for (i = 0; i < RH_ROUTING_TABLE_SIZE; i++)
+    for (i = 0; i < _routesSize; i++)
 	_routes[i].state = Invalid;
+    _routeCount = 0;
 }
 
 
@@ -159,6 +238,12 @@ uint8_t RHRouter::sendtoWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t fl
 ////////////////////////////////////////////////////////////////////
 // Waits for delivery to the next hop (but not for delivery to the final destination)
 uint8_t RHRouter::sendtoFromSourceWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t source, uint8_t flags)
+{
+    return relayFromSourceWait(buf, len, dest, source, _lastE2ESequenceNumber++, flags);
+}
+
+////////////////////////////////////////////////////////////////////
+uint8_t RHRouter::relayFromSourceWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t source, uint8_t id, uint8_t flags)
 {
     if (((uint16_t)len + sizeof(RoutedMessageHeader)) > _driver.maxMessageLength())
 	return RH_ROUTER_ERROR_INVALID_LENGTH;
@@ -167,7 +252,7 @@ uint8_t RHRouter::sendtoFromSourceWait(uint8_t* buf, uint8_t len, uint8_t dest,
     _tmpMessage.header.source = source;
     _tmpMessage.header.dest = dest;
     _tmpMessage.header.hops = 0;
-    _tmpMessage.header.id = _lastE2ESequenceNumber++;
+    _tmpMessage.header.id = id;
     _tmpMessage.header.flags = flags;
     memcpy(_tmpMessage.data, buf, len);
 
@@ -12,8 +12,11 @@
 // Default max number of hops we will route
 #define RH_DEFAULT_MAX_HOPS 30
 
-// The default size of the routing table we keep
+// The default size of the routing table we keep. Larger networks can pass
+// their own table to setRoutingTable() instead of rebuilding with this changed
+#ifndef RH_ROUTING_TABLE_SIZE
 #define RH_ROUTING_TABLE_SIZE 10
+#endif
 
 // Error codes
 #define RH_ROUTER_ERROR_NONE              0
@@ -90,10 +93,17 @@
 /// You can also use addRouteTo() to change a route and 
 /// deleteRouteTo() to delete a route at run time. Youcan also clear the entire routing table
 ///
-/// The Routing Table has limited capacity for entries (defined by RH_ROUTING_TABLE_SIZE, which is 10)
-/// if more than RH_ROUTING_TABLE_SIZE are added, the oldest (first) one will be removed by calling 
+/// The Routing Table has limited capacity for entries (defined by RH_ROUTING_TABLE_SIZE, which is 10,
+/// unless you give it a table of your own with setRoutingTable()).
+/// If more routes are added than it can hold, the least recently used one will be removed by calling 
 /// retireOldestRoute()
 ///
+/// Entries are placed by hashing the destination address, so finding the route for a message
+/// does not search the whole table, however large it is. Each entry remembers when its
+/// route was learned and when it was last used, see routeAge() and routeIdle(). In a large
+/// RHMesh network, give the table room for every node you talk to: each route that falls out 
+/// of it costs a new route discovery broadcast the next time it is needed.
+///
 /// \par Message Format
 ///
 /// RHRouter add to the lower level RHReliableDatagram (and even lower level RH) class message formats. 
@@ -165,6 +175,8 @@ public:
 	uint8_t      dest;      ///< Destination node address
 	uint8_t      next_hop;  ///< Send via this next hop address
 	uint8_t      state;     ///< State of this route, one of RouteState
+	uint32_t     learned;   ///< millis() when next_hop was set
+	uint32_t     used;      ///< millis() when the route was last looked up or confirmed
     } RoutingTableEntry;
 
     /// Constructor. 
@@ -184,14 +196,49 @@ public:
     /// \param [in] max_hops The new value for max_hops
     void setMaxHops(uint8_t max_hops);
 
+    /// Replaces the routing table with one provided by the caller, which must stay valid
+    /// for the life of this RHRouter. All existing routes are cleared.
+    /// \param [in] routes Storage for the table
+    /// \param [in] size Number of entries in routes
+    void setRoutingTable(RoutingTableEntry* routes, uint8_t size);
+
+    /// Same as above, sized from the array itself:
+    /// \code
+    /// RHRouter::RoutingTableEntry routes[40];
+    /// manager.setRoutingTable(routes);
+    /// \endcode
+    template <uint8_t N>
+    void setRoutingTable(RoutingTableEntry (&routes)[N]) { setRoutingTable(routes, N); }
+
+    /// \return The number of entries the routing table can hold
+    uint8_t routingTableSize() const { return _routesSize; }
+
+    /// \return The number of routes in the routing table
+    uint8_t routeCount() const { return _routeCount; }
+
+    /// \return The number of routes removed by retireOldestRoute() to make room for new ones.
+    /// If this keeps growing, the routing table is too small for the network
+    uint32_t routesRetired() const { return _routesRetired; }
+
+    /// \param [in] dest The destination node address
+    /// \return milliseconds since the route to dest was learned or its next hop changed,
+    /// 0 if there is no route
+    uint32_t routeAge(uint8_t dest);
+
+    /// \param [in] dest The destination node address
+    /// \return milliseconds since the route to dest was last looked up or confirmed,
+    /// 0 if there is no route
+    uint32_t routeIdle(uint8_t dest);
+
     /// Adds a route to the local routing table, or updates it if already present.
-    /// If there is not enough room the oldest (first) route will be deleted by calling retireOldestRoute().
+    /// If there is not enough room the least recently used route will be deleted by calling retireOldestRoute().
     /// \param [in] dest The destination node address. RH_BROADCAST_ADDRESS is permitted.
     /// \param [in] next_hop The address of the next hop to send messages destined for dest
     /// \param [in] state The satte of the route. Defaults to Valid
     void addRouteTo(uint8_t dest, uint8_t next_hop, uint8_t state = Valid);
 
-    /// Finds and returns a RoutingTableEntry for the given destination node
+    /// Finds and returns a RoutingTableEntry for the given destination node, and marks the route as used.
+    /// The pointer is only good until the routing table is next changed.
     /// \param [in] dest The desired destination node address.
     /// \return pointer to a RoutingTableEntry for dest
     RoutingTableEntry* getRouteTo(uint8_t dest);
@@ -201,7 +248,7 @@ public:
     /// \return true if the route was present
     bool deleteRouteTo(uint8_t dest);
 
-    /// Deletes the oldest (first) route from the 
+    /// Deletes the least recently used route from the 
     /// local routing table
     void retireOldestRoute();
 
@@ -299,10 +346,27 @@ protected:
     /// \param [in] messageLen Length of message in octets
     virtual uint8_t route(RoutedMessage* message, uint8_t messageLen);
 
+    /// Like sendtoFromSourceWait(), but the message keeps the end-to-end ID given
+    /// instead of taking the next one of this node. Used when relaying broadcasts, so
+    /// every copy of a message can be recognised by its (SOURCE, ID)
+    /// \param [in] buf The application message data.
+    /// \param [in] len Number of octets in the application message data. 0 is permitted.
+    /// \param [in] dest The destination node address.
+    /// \param [in] source The (fake) originating node address.
+    /// \param [in] id The originator's end-to-end ID
+    /// \param [in] flags Optional flags, delivered end-to-end to the dest address
+    /// \return The result code, as sendtoFromSourceWait()
+    uint8_t relayFromSourceWait(uint8_t* buf, uint8_t len, uint8_t dest, uint8_t source, uint8_t id, uint8_t flags = 0);
+
     /// Deletes a specific rout entry from therouting table
     /// \param [in] index The 0 based index of the routing table entry to delete
     void deleteRoute(uint8_t index);
 
+    /// Finds the slot holding the route to dest
+    /// \param [in] dest The destination node address
+    /// \return The index of the entry, or _routesSize if there is none
+    uint8_t findRoute(uint8_t dest);
+
     /// The last end-to-end sequence number to be used
     /// Defaults to 0
     uint8_t _lastE2ESequenceNumber;
@@ -314,10 +378,16 @@ protected:
 private:
 
     /// Temporary mesage buffer
-    static RoutedMessage _tmpMessage;
+    static RH_THREAD_LOCAL RoutedMessage _tmpMessage;
+
+    /// Local routing table, open addressed by destination (see findRoute())
+    RoutingTableEntry*   _routes;
+    uint8_t              _routesSize;
+    uint8_t              _routeCount;
+    uint32_t             _routesRetired;
 
-    /// Local routing table
-    RoutingTableEntry    _routes[RH_ROUTING_TABLE_SIZE];
+    /// Storage used until setRoutingTable() is called
+    RoutingTableEntry    _defaultRoutes[RH_ROUTING_TABLE_SIZE];
 };
 
 /// @example rf22_router_client.pde
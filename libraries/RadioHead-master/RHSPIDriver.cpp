@@ -101,6 +101,42 @@ uint8_t RHSPIDriver::spiBurstWrite(uint8_t reg, const uint8_t* src, uint8_t len)
     return status;
 }
 
+uint8_t RHSPIDriver::spiBatch(RHSPIOp* ops, uint8_t count)
+{
+    uint8_t status = 0;
+    uint8_t i;
+    ATOMIC_BLOCK_START;
+#if defined(SPI_HAS_TRANSACTION)
+    SPI.beginTransaction(_spi._settings);
+#endif
+    for (i = 0; i < count; i++)
+    {
+	uint8_t reg = ops[i].reg;
+	// Start a new burst unless this is the next register, in the same direction
+	if (   i == 0
+	    || ((reg ^ ops[i-1].reg) & RH_SPI_WRITE_MASK)
+	    || (reg & ~RH_SPI_WRITE_MASK) != ((ops[i-1].reg + 1) & ~RH_SPI_WRITE_MASK)
+	    || (reg & ~RH_SPI_WRITE_MASK) == 0)
+	{
+	    if (i)
+		digitalWrite(_slaveSelectPin, HIGH);
+	    digitalWrite(_slaveSelectPin, LOW);
+	    status = _spi.transfer(reg);
+	}
+	if (reg & RH_SPI_WRITE_MASK)
+	    _spi.transfer(ops[i].val);
+	else
+	    ops[i].val = _spi.transfer(0);
+    }
+    if (count)
+	digitalWrite(_slaveSelectPin, HIGH);
+#if defined(SPI_HAS_TRANSACTION)
+    SPI.endTransaction();
+#endif
+    ATOMIC_BLOCK_END;
+    return status;
+}
+
 void RHSPIDriver::setSlaveSelectPin(uint8_t slaveSelectPin)
 {
     _slaveSelectPin = slaveSelectPin;
@@ -14,6 +14,13 @@
 
 class RHGenericSPI;
 
+/// One register access in a batch run by RHSPIDriver::spiBatch()
+typedef struct
+{
+    uint8_t reg; ///< Register number, with RH_SPI_WRITE_MASK set for a write
+    uint8_t val; ///< The value to write, or set to the value read
+} RHSPIOp;
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHSPIDriver RHSPIDriver.h <RHSPIDriver.h>
 /// \brief Base class for a RadioHead drivers that use the SPI bus
@@ -77,6 +84,15 @@ public:
     ///  it may or may not be meaningfule depending on the the type of device being accessed.
     uint8_t           spiBurstWrite(uint8_t reg, const uint8_t* src, uint8_t len);
 
+    /// Runs a list of register reads and writes in one SPI transaction, with interrupts disabled only once.
+    /// Runs of consecutive registers in the same direction are merged into one burst,
+    /// so the register address is sent only once for each run. The device must auto-increment the address
+    /// in burst mode, as all RHSPIDriver devices do.
+    /// \param[in,out] ops The accesses, in order. The val of each read is set to the register value
+    /// \param[in] count Number of entries in ops
+    /// \return The status byte returned during the address transfer of the last burst
+    uint8_t           spiBatch(RHSPIOp* ops, uint8_t count);
+
     /// Set or change the pin to be used for SPI slave select.
     /// This can be called at any time to change the
     /// pin that will be used for slave select in subsquent SPI operations.
@@ -5,10 +5,24 @@
 
 #include <RHSoftwareSPI.h>
 
+#if (RH_PLATFORM == RH_PLATFORM_ARDUINO) && defined(RH_SOFTWARE_SPI_FAST)
+ #define RH_SOFTSPI_HIGH(pin) (*_##pin##Out |= _##pin##Mask)
+ #define RH_SOFTSPI_LOW(pin)  (*_##pin##Out &= ~_##pin##Mask)
+ #define RH_SOFTSPI_MISO()    (*_misoIn & _misoMask)
+#elif defined(RH_SOFTWARE_SPI_FAST)
+ // ESP8266: separate set and clear registers, so no read-modify-write
+ #define RH_SOFTSPI_HIGH(pin) (GPOS = _##pin##Mask)
+ #define RH_SOFTSPI_LOW(pin)  (GPOC = _##pin##Mask)
+ #define RH_SOFTSPI_MISO()    (GPI & _misoMask)
+#endif
+
 RHSoftwareSPI::RHSoftwareSPI(Frequency frequency, BitOrder bitOrder, DataMode dataMode)
     :
     RHGenericSPI(frequency, bitOrder, dataMode)
 {
+#ifdef RH_SOFTWARE_SPI_FAST
+    _fast = false;
+#endif
     setPins(12, 11, 13);
 }
 
@@ -17,6 +31,11 @@ RHSoftwareSPI::RHSoftwareSPI(Frequency frequency, BitOrder bitOrder, DataMode da
 // resulting in very slow SPI bus speeds using this technique, up to about 120us per octet of transfer
 uint8_t RHSoftwareSPI::transfer(uint8_t data) 
 {
+#ifdef RH_SOFTWARE_SPI_FAST
+    if (_fast)
+	return transferFast(data);
+#endif
+
     uint8_t readData;
     uint8_t writeData;
     uint8_t builtReturn;
@@ -48,7 +67,7 @@ uint8_t RHSoftwareSPI::transfer(uint8_t data)
 	{
 	    // CPHA=1, miso/mosi changing state now
 	    digitalWrite(_mosi, writeData);
-	    digitalWrite(_sck, ~_clockPolarity);
+	    digitalWrite(_sck, !_clockPolarity);
 	    delayPeriod();
 
 	    // CPHA=1, miso/mosi stable now
@@ -65,7 +84,7 @@ uint8_t RHSoftwareSPI::transfer(uint8_t data)
 
 	    // CPHA=0, miso/mosi stable now
 	    readData = digitalRead(_miso);
-	    digitalWrite(_sck, ~_clockPolarity);
+	    digitalWrite(_sck, !_clockPolarity);
 	    delayPeriod();
 	}
 			
@@ -109,6 +128,9 @@ void RHSoftwareSPI::begin()
 	_clockPhase = 1;
     }
     digitalWrite(_sck, _clockPolarity);
+#ifdef RH_SOFTWARE_SPI_FAST
+    cachePins();
+#endif
 
     // Caution: these counts assume that digitalWrite is very fast, which is usually not true
     switch (_frequency)
@@ -153,6 +175,9 @@ void RHSoftwareSPI::setPins(uint8_t miso, uint8_t mosi, uint8_t sck)
     pinMode(_mosi, OUTPUT);
     pinMode(_sck, OUTPUT);
     digitalWrite(_sck, _clockPolarity);
+#ifdef RH_SOFTWARE_SPI_FAST
+    cachePins();
+#endif
 }
 
 
@@ -164,3 +189,83 @@ void RHSoftwareSPI::delayPeriod()
     }
 }
 
+
+#ifdef RH_SOFTWARE_SPI_FAST
+void RHSoftwareSPI::cachePins()
+{
+#if (RH_PLATFORM == RH_PLATFORM_ARDUINO)
+    uint8_t misoPort = digitalPinToPort(_miso);
+    uint8_t mosiPort = digitalPinToPort(_mosi);
+    uint8_t sckPort = digitalPinToPort(_sck);
+    _fast = misoPort != NOT_A_PIN && mosiPort != NOT_A_PIN && sckPort != NOT_A_PIN;
+    if (!_fast)
+	return;
+    _misoIn = portInputRegister(misoPort);
+    _mosiOut = portOutputRegister(mosiPort);
+    _sckOut = portOutputRegister(sckPort);
+    _misoMask = digitalPinToBitMask(_miso);
+    _mosiMask = digitalPinToBitMask(_mosi);
+    _sckMask = digitalPinToBitMask(_sck);
+#else
+    // GPIO16 lives in the RTC block, not in GPO/GPI
+    _fast = _miso < 16 && _mosi < 16 && _sck < 16;
+    _misoMask = 1UL << _miso;
+    _mosiMask = 1UL << _mosi;
+    _sckMask = 1UL << _sck;
+#endif
+}
+
+// One bit, MSB first. CPHA=0: data out before the leading clock edge, sampled on it.
+// CPHA=1: data out on the leading edge, sampled on the trailing one
+#define RH_SOFTSPI_BIT_CPHA0(lead, trail) \
+    if (out & 0x80) RH_SOFTSPI_HIGH(mosi); else RH_SOFTSPI_LOW(mosi); \
+    out <<= 1; \
+    delayPeriod(); \
+    lead(sck); \
+    in = (in << 1) | (RH_SOFTSPI_MISO() ? 1 : 0); \
+    delayPeriod(); \
+    trail(sck);
+#define RH_SOFTSPI_BIT_CPHA1(lead, trail) \
+    lead(sck); \
+    if (out & 0x80) RH_SOFTSPI_HIGH(mosi); else RH_SOFTSPI_LOW(mosi); \
+    out <<= 1; \
+    delayPeriod(); \
+    trail(sck); \
+    in = (in << 1) | (RH_SOFTSPI_MISO() ? 1 : 0); \
+    delayPeriod();
+#define RH_SOFTSPI_OCTET(bit, lead, trail) \
+    bit(lead, trail) bit(lead, trail) bit(lead, trail) bit(lead, trail) \
+    bit(lead, trail) bit(lead, trail) bit(lead, trail) bit(lead, trail)
+
+static uint8_t reverseBits(uint8_t b)
+{
+    b = (b & 0xf0) >> 4 | (b & 0x0f) << 4;
+    b = (b & 0xcc) >> 2 | (b & 0x33) << 2;
+    b = (b & 0xaa) >> 1 | (b & 0x55) << 1;
+    return b;
+}
+
+uint8_t RHSoftwareSPI::transferFast(uint8_t data)
+{
+    uint8_t out = _bitOrder == BitOrderLSBFirst ? reverseBits(data) : data;
+    uint8_t in = 0;
+
+    switch (_dataMode)
+    {
+	case DataMode0:
+	    RH_SOFTSPI_OCTET(RH_SOFTSPI_BIT_CPHA0, RH_SOFTSPI_HIGH, RH_SOFTSPI_LOW);
+	    break;
+	case DataMode1:
+	    RH_SOFTSPI_OCTET(RH_SOFTSPI_BIT_CPHA1, RH_SOFTSPI_HIGH, RH_SOFTSPI_LOW);
+	    break;
+	case DataMode2:
+	    RH_SOFTSPI_OCTET(RH_SOFTSPI_BIT_CPHA0, RH_SOFTSPI_LOW, RH_SOFTSPI_HIGH);
+	    break;
+	default:
+	    RH_SOFTSPI_OCTET(RH_SOFTSPI_BIT_CPHA1, RH_SOFTSPI_LOW, RH_SOFTSPI_HIGH);
+	    break;
+    }
+
+    return _bitOrder == BitOrderLSBFirst ? reverseBits(in) : in;
+}
+#endif
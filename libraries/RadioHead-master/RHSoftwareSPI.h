@@ -8,6 +8,16 @@
 
 #include <RHGenericSPI.h>
 
+// On these platforms transfer() drives the pins through the GPIO registers, not digitalWrite()
+#if (RH_PLATFORM == RH_PLATFORM_ARDUINO && defined(__AVR__))
+ #define RH_SOFTWARE_SPI_FAST
+ typedef volatile uint8_t RHSoftwareSPIPort;
+ typedef uint8_t RHSoftwareSPIMask;
+#elif (RH_PLATFORM == RH_PLATFORM_ESP8266)
+ #define RH_SOFTWARE_SPI_FAST
+ typedef uint32_t RHSoftwareSPIMask;
+#endif
+
 /////////////////////////////////////////////////////////////////////
 /// \class RHSoftwareSPI RHSoftwareSPI.h <RHSoftwareSPI.h>
 /// \brief Encapsulate a software SPI interface
@@ -32,6 +42,13 @@
 ///    ....
 /// }
 /// \endcode
+///
+/// \par Speed
+///
+/// On AVR Arduinos and ESP8266, the port registers and bit masks of the pins are looked up once, by setPins() and begin(),
+/// and transfer() then toggles them directly, with the loop unrolled for each SPI mode. That is roughly
+/// 10 times faster than digitalWrite(). On other platforms, or for pins without their own port bit (such as
+/// GPIO16 on ESP8266), it falls back to digitalWrite() and digitalRead().
 class RHSoftwareSPI : public RHGenericSPI 
 {
 public:
@@ -76,14 +93,34 @@ private:
     /// Delay routine for bus timing.
     void delayPeriod();
 
+#ifdef RH_SOFTWARE_SPI_FAST
+    /// Looks up the port registers and bit masks of the pins, if they have them
+    void cachePins();
+
+    /// transfer() through the port registers
+    uint8_t transferFast(uint8_t data);
+#endif
+
 private:
     uint8_t _miso;
     uint8_t _mosi;
     uint8_t _sck;
-    uint8_t _bitOrder;
     uint8_t _delayCounts;
     uint8_t _clockPolarity;
     uint8_t _clockPhase;
+
+#ifdef RH_SOFTWARE_SPI_FAST
+    /// True if all 3 pins were found in the port registers
+    bool _fast;
+#if (RH_PLATFORM == RH_PLATFORM_ARDUINO)
+    RHSoftwareSPIPort* _misoIn;
+    RHSoftwareSPIPort* _mosiOut;
+    RHSoftwareSPIPort* _sckOut;
+#endif
+    RHSoftwareSPIMask _misoMask;
+    RHSoftwareSPIMask _mosiMask;
+    RHSoftwareSPIMask _sckMask;
+#endif
 };
 
 #endif
@@ -28,6 +28,16 @@ HardwareTimer timer(MAPLE_TIMER);
 // Interrupt handler uses this to find the most recently initialised instance of this driver
 static RH_ASK* thisASKDriver;
 
+#if defined(RH_ASK_EDGE_RX)
+ #if !((RH_PLATFORM == RH_PLATFORM_ARDUINO) && defined(__AVR__)) && (RH_PLATFORM != RH_PLATFORM_ESP8266)
+  #error RH_ASK_EDGE_RX is only supported on Arduino AVR and ESP8266
+ #endif
+void INTERRUPT_ATTR ask_edge_interrupt_handler()
+{
+    thisASKDriver->handleEdgeInterrupt();
+}
+#endif
+
 // 4 bit to 6 bit symbol converter table
 // Used to convert the high and low nybbles of the transmitted data
 // into 6 bit symbols for transmission. Each 6-bit symbol has 3 1s and 3 0s 
@@ -83,6 +93,13 @@ bool RH_ASK::init()
     setModeIdle();
     timerSetup();
 
+#if defined(RH_ASK_EDGE_RX)
+    _rxBitMicros = 1000000UL / _speed;
+    _rxLastSample = readRx();
+    _rxLastEdge = micros();
+    attachInterrupt(digitalPinToInterrupt(_rxPin), ask_edge_interrupt_handler, CHANGE);
+#endif
+
     return true;
 }
 
@@ -118,7 +135,7 @@ uint8_t RH_ASK::timerCalc(uint16_t speed, uint16_t max_ticks, uint16_t *nticks)
 
     // test increasing prescaler (divisor), decreasing ulticks until no overflow
     // 1/Fraction of second needed to xmit one bit
-    unsigned long inv_bit_time = ((unsigned long)speed) * 8;
+    unsigned long inv_bit_time = ((unsigned long)speed) * RH_ASK_TICKS_PER_BIT;
     for (prescaler=1; prescaler < NUM_PRESCALERS; prescaler += 1)
     {
 	// Integer arithmetic courtesy Jim Remington
@@ -153,6 +170,7 @@ uint8_t RH_ASK::timerCalc(uint16_t speed, uint16_t max_ticks, uint16_t *nticks)
 }
 
 // The idea here is to get 8 timer interrupts per bit period
+// (RH_ASK_TICKS_PER_BIT, only one with RH_ASK_EDGE_RX)
 void RH_ASK::timerSetup()
 {
 #if (RH_PLATFORM == RH_PLATFORM_GENERIC_AVR8)
@@ -387,7 +405,7 @@ void RH_ASK::timerSetup()
 #elif (RH_PLATFORM == RH_PLATFORM_ESP8266)
     void INTERRUPT_ATTR esp8266_timer_interrupt_handler(); // Forward declarat
     // The - 120 is a heuristic to correct for interrupt handling overheads
-    _timerIncrement = (clockCyclesPerMicrosecond() * 1000000 / 8 / _speed) - 120;
+    _timerIncrement = (clockCyclesPerMicrosecond() * 1000000 / RH_ASK_TICKS_PER_BIT / _speed) - 120;
     timer0_isr_init();
     timer0_attachInterrupt(esp8266_timer_interrupt_handler);
     timer0_write(ESP.getCycleCount() + _timerIncrement);
@@ -695,10 +713,8 @@ uint8_t INTERRUPT_ATTR RH_ASK::symbol_6to4(uint8_t symbol)
 // since it is slow
 void RH_ASK::validateRxBuf()
 {
-    uint16_t crc = 0xffff;
     // The CRC covers the byte count, headers and user data
-    for (uint8_t i = 0; i < _rxBufLen; i++)
-	crc = RHcrc_ccitt_update(crc, _rxBuf[i]);
+    uint16_t crc = RHcrc_ccitt(_rxBuf, _rxBufLen);
     if (crc != 0xf0b8) // CRC when buffer and expected CRC are CRC'd
     {
 	// Reject and drop the message
@@ -745,71 +761,116 @@ void INTERRUPT_ATTR RH_ASK::receiveTimer()
     }
     if (_rxPllRamp >= RH_ASK_RX_RAMP_LEN)
     {
-	// Add this to the 12th bit of _rxBits, LSB first
-	// The last 12 bits are kept
-	_rxBits >>= 1;
-
 	// Check the integrator to see how many samples in this cycle were high.
 	// If < 5 out of 8, then its declared a 0 bit, else a 1;
-	if (_rxIntegrator >= 5)
-	    _rxBits |= 0x800;
+	bool bit = _rxIntegrator >= 5;
 
 	_rxPllRamp -= RH_ASK_RX_RAMP_LEN;
 	_rxIntegrator = 0; // Clear the integral for the next cycle
 
-	if (_rxActive)
+	receiveBit(bit);
+    }
+}
+
+void INTERRUPT_ATTR RH_ASK::receiveBit(bool bit)
+{
+    // Add this to the 12th bit of _rxBits, LSB first
+    // The last 12 bits are kept
+    _rxBits >>= 1;
+    if (bit)
+	_rxBits |= 0x800;
+
+    if (_rxActive)
+    {
+	// We have the start symbol and now we are collecting message bits,
+	// 6 per symbol, each which has to be decoded to 4 bits
+	if (++_rxBitCount >= 12)
 	{
-	    // We have the start symbol and now we are collecting message bits,
-	    // 6 per symbol, each which has to be decoded to 4 bits
-	    if (++_rxBitCount >= 12)
+	    // Have 12 bits of encoded message == 1 byte encoded
+	    // Decode as 2 lots of 6 bits into 2 lots of 4 bits
+	    // The 6 lsbits are the high nybble
+	    uint8_t this_byte = 
+		(symbol_6to4(_rxBits & 0x3f)) << 4 
+		| symbol_6to4(_rxBits >> 6);
+
+	    // The first decoded byte is the byte count of the following message
+	    // the count includes the byte count and the 2 trailing FCS bytes
+	    // REVISIT: may also include the ACK flag at 0x40
+	    if (_rxBufLen == 0)
 	    {
-		// Have 12 bits of encoded message == 1 byte encoded
-		// Decode as 2 lots of 6 bits into 2 lots of 4 bits
-		// The 6 lsbits are the high nybble
-		uint8_t this_byte = 
-		    (symbol_6to4(_rxBits & 0x3f)) << 4 
-		    | symbol_6to4(_rxBits >> 6);
-
-		// The first decoded byte is the byte count of the following message
-		// the count includes the byte count and the 2 trailing FCS bytes
-		// REVISIT: may also include the ACK flag at 0x40
-		if (_rxBufLen == 0)
-		{
-		    // The first byte is the byte count
-		    // Check it for sensibility. It cant be less than 7, since it
-		    // includes the byte count itself, the 4 byte header and the 2 byte FCS
-		    _rxCount = this_byte;
-		    if (_rxCount < 7 || _rxCount > RH_ASK_MAX_PAYLOAD_LEN)
-		    {
-			// Stupid message length, drop the whole thing
-			_rxActive = false;
-			_rxBad++;
-                        return;
-		    }
-		}
-		_rxBuf[_rxBufLen++] = this_byte;
-
-		if (_rxBufLen >= _rxCount)
+		// The first byte is the byte count
+		// Check it for sensibility. It cant be less than 7, since it
+		// includes the byte count itself, the 4 byte header and the 2 byte FCS
+		_rxCount = this_byte;
+		if (_rxCount < 7 || _rxCount > RH_ASK_MAX_PAYLOAD_LEN)
 		{
-		    // Got all the bytes now
+		    // Stupid message length, drop the whole thing
 		    _rxActive = false;
-		    _rxBufFull = true;
-		    setModeIdle();
+		    _rxBad++;
+		    return;
 		}
-		_rxBitCount = 0;
 	    }
-	}
-	// Not in a message, see if we have a start symbol
-	else if (_rxBits == RH_ASK_START_SYMBOL)
-	{
-	    // Have start symbol, start collecting message
-	    _rxActive = true;
+	    _rxBuf[_rxBufLen++] = this_byte;
+
+	    if (_rxBufLen >= _rxCount)
+	    {
+		// Got all the bytes now
+		_rxActive = false;
+		_rxBufFull = true;
+		setModeIdle();
+	    }
 	    _rxBitCount = 0;
-	    _rxBufLen = 0;
 	}
     }
+    // Not in a message, see if we have a start symbol
+    else if (_rxBits == RH_ASK_START_SYMBOL)
+    {
+	// Have start symbol, start collecting message
+	_rxActive = true;
+	_rxBitCount = 0;
+	_rxBufLen = 0;
+    }
+}
+
+#if defined(RH_ASK_EDGE_RX)
+void INTERRUPT_ATTR RH_ASK::receiveElapsed(uint32_t now, bool atEdge)
+{
+    uint32_t elapsed = now - _rxLastEdge;
+    uint32_t threshold = _rxBitMicros / 2;
+    uint8_t bits = 0;
+
+    // At a transition the partial bit rounds to the nearest whole one. From the timer
+    // only bits whose centre is more than half a bit back are certain; the rest are
+    // left for the next transition
+    if (!atEdge)
+	threshold += _rxBitMicros;
+    // A long run is idle or noise: 12 bits fill _rxBits, more change nothing
+    while (elapsed >= threshold && bits < 12)
+    {
+	bits++;
+	threshold += _rxBitMicros;
+    }
+    if (bits == 0)
+	return;
+    _rxLastEdge = atEdge ? now : _rxLastEdge + (uint32_t)bits * _rxBitMicros;
+    while (bits-- && _mode == RHModeRx)
+	receiveBit(_rxLastSample);
 }
 
+void INTERRUPT_ATTR RH_ASK::handleEdgeInterrupt()
+{
+    uint32_t now = micros();
+    bool sample = readRx();
+
+    if (sample == _rxLastSample)
+	return; // a glitch too short to see, or a missed edge
+    if (_mode == RHModeRx)
+	receiveElapsed(now, true);
+    _rxLastEdge = now;
+    _rxLastSample = sample;
+}
+#endif
+
 void INTERRUPT_ATTR RH_ASK::transmitTimer()
 {
     if (_txSample++ == 0)
@@ -834,14 +895,20 @@ void INTERRUPT_ATTR RH_ASK::transmitTimer()
 	}
     }
 	
-    if (_txSample > 7)
+    if (_txSample >= RH_ASK_TICKS_PER_BIT)
 	_txSample = 0;
 }
 
 void INTERRUPT_ATTR RH_ASK::handleTimerInterrupt()
 {
     if (_mode == RHModeRx)
+    {
+#if defined(RH_ASK_EDGE_RX)
+	receiveElapsed(micros(), false); // Bits with no transition since the last one
+#else
 	receiveTimer(); // Receiving
+#endif
+    }
     else if (_mode == RHModeTx)
         transmitTimer(); // Transmitting
 }
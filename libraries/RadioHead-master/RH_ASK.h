@@ -28,6 +28,18 @@
  #define RH_ASK_RX_SAMPLES_PER_BIT 8
 #endif //RH_ASK_RX_SAMPLES_PER_BIT  
 
+// Define RH_ASK_EDGE_RX to receive from pin change interrupts instead of sampling the
+// RX pin RH_ASK_RX_SAMPLES_PER_BIT times per bit. The timer then only ticks once per bit,
+// for the transmitter. Arduino AVR and ESP8266 only, and the rxPin must be able to
+// interrupt (attachInterrupt)
+//#define RH_ASK_EDGE_RX
+
+#if defined(RH_ASK_EDGE_RX)
+ #define RH_ASK_TICKS_PER_BIT 1
+#else
+ #define RH_ASK_TICKS_PER_BIT 8
+#endif
+
 /// The size of the receiver ramp. Ramp wraps modulo this number
 #define RH_ASK_RX_RAMP_LEN 160
 
@@ -227,6 +239,16 @@
 /// Which will initialise the driver at 2000 bps, recieve on GPIO2, transmit on GPIO4, PTT on GPIO5.
 /// Caution: on the tronixlabs breakout board, pins 4 and 5 may be labelled vice-versa.
 ///
+/// \par Edge triggered receive
+/// With RH_ASK_EDGE_RX defined (in RH_ASK.h or the build flags), the receiver does not sample the
+/// rxPin from the timer. A pin change interrupt timestamps each transition with micros() instead,
+/// and the time since the previous one says how many bits of the old level there were. The timer
+/// interrupt then runs once per bit instead of 8 times, which leaves much more of the CPU for the
+/// application at high bit rates, since a 4b6b signal has on average a transition every 2 bits.
+/// The price is noise immunity: there is no majority vote over 8 samples, so a glitch shorter
+/// than half a bit is dropped and a longer one becomes a bit error, caught by the FCS.
+/// The over the air format is unchanged, so edge and sampling receivers can share a network.
+///
 /// \par Timers
 /// The RH_ASK driver uses a timer-driven interrupt to generate 8 interrupts per bit period. RH_ASK
 /// takes over a timer on Arduino-like platforms. By default it takes over Timer 1. You can force it
@@ -303,6 +325,11 @@ public:
     /// dont call this it used by the interrupt handler
     void            handleTimerInterrupt();
 
+#if defined(RH_ASK_EDGE_RX)
+    /// dont call this it used by the pin change interrupt handler
+    void            handleEdgeInterrupt();
+#endif
+
     /// Returns the current speed in bits per second
     /// \return The current speed in bits per second
     uint16_t        speed() { return _speed;}
@@ -334,6 +361,17 @@ protected:
     /// The receiver handler function, called a 8 times the bit rate
     void            receiveTimer();
 
+    /// Shifts one received bit into _rxBits and looks for the start symbol or
+    /// assembles the message from it
+    void            receiveBit(bool bit);
+
+#if defined(RH_ASK_EDGE_RX)
+    /// Passes on, as bits of the level before it, the time since the last transition. Called
+    /// at each transition and from the timer, which only passes on the bits whose centre has
+    /// gone by, so that runs longer than a symbol still arrive
+    void            receiveElapsed(uint32_t now, bool atEdge);
+#endif
+
     /// The transmitter handler function, called a 8 times the bit rate 
     void            transmitTimer();
 
@@ -370,6 +408,14 @@ protected:
     /// Last digital input from the rx data pin
     volatile bool   _rxLastSample;
 
+#if defined(RH_ASK_EDGE_RX)
+    /// micros() at the last transition, or where the bits already passed on by the timer end
+    volatile uint32_t _rxLastEdge;
+
+    /// Length of one bit in microseconds
+    uint16_t        _rxBitMicros;
+#endif
+
     /// This is the integrate and dump integral. If there are <5 0 samples in the PLL cycle
     /// the bit is declared a 0, else a 1
     volatile uint8_t _rxIntegrator;
@@ -382,6 +382,15 @@ bool RH_CC110::waitPacketSent()
     return true;
 }
 
+bool RH_CC110::isSending()
+{
+    if (_mode != RHModeTx)
+	return false;
+
+    // Caution: may transition through CALIBRATE
+    return (statusRead() & RH_CC110_STATUS_STATE) != RH_CC110_STATUS_IDLE;
+}
+
 bool RH_CC110::setTxPower(TransmitPower power)
 {
     if (power > sizeof(paPowerValues))
@@ -699,6 +699,11 @@ public:
     /// \return true on success, false if the chip is not in transmit mode or other transmit failure
     virtual bool waitPacketSent();
 
+    /// Indicates if the chip is in transmit mode and 
+    /// there is a packet currently being transmitted
+    /// \return true if the chip is in transmit mode and there is a transmission in progress
+    virtual bool isSending();
+
     /// Tests whether a new message is available
     /// from the Driver. 
     /// On most drivers, this will also put the Driver into RHModeRx mode until
@@ -8,7 +8,12 @@
 RH_NRF24::RH_NRF24(uint8_t chipEnablePin, uint8_t slaveSelectPin, RHGenericSPI& spi)
     :
     RHNRFSPIDriver(slaveSelectPin, spi),
-    _rxBufValid(0)
+    _rxBufValid(0),
+    _shockBurst(false),
+    _ackQueued(false),
+    _pipe(0),
+    _retransmissions(0),
+    _txLost(0)
 {
     _configuration = RH_NRF24_EN_CRC | RH_NRF24_CRCO; // Default: 2 byte CRC enabled
     _chipEnablePin = chipEnablePin;
@@ -43,6 +48,8 @@ bool RH_NRF24::init()
             return false;
     }
 
+    _shockBurst = false;
+
     // Make sure we are powered down
     setModeIdle();
 
@@ -117,6 +124,86 @@ bool RH_NRF24::setNetworkAddress(uint8_t* address, uint8_t len)
     return true;
 }
 
+bool RH_NRF24::setEnhancedShockBurst(bool on, uint8_t retries, uint16_t retryDelay)
+{
+    if (retries > 15 || retryDelay < 250 || retryDelay > 4000)
+	return false;
+
+    uint8_t feature = RH_NRF24_EN_DPL | RH_NRF24_EN_DYN_ACK;
+    if (on)
+    {
+	// Delay is (ARD + 1) * 250us
+	spiWriteRegister(RH_NRF24_REG_04_SETUP_RETR, (((retryDelay / 250) - 1) << 4) | retries);
+	spiWriteRegister(RH_NRF24_REG_01_EN_AA, RH_NRF24_ENAA_P0 | RH_NRF24_ENAA_P1 | RH_NRF24_ENAA_P2
+			 | RH_NRF24_ENAA_P3 | RH_NRF24_ENAA_P4 | RH_NRF24_ENAA_P5);
+	feature |= RH_NRF24_EN_ACK_PAY;
+    }
+    spiWriteRegister(RH_NRF24_REG_1D_FEATURE, feature);
+    _shockBurst = on;
+    return true;
+}
+
+bool RH_NRF24::setPipeAddress(uint8_t pipe, uint8_t* address, uint8_t len)
+{
+    if (pipe < 1 || pipe > 5)
+	return false;
+
+    if (pipe == 1)
+    {
+	if (len < 3 || len > 5)
+	    return false;
+	spiBurstWriteRegister(RH_NRF24_REG_0B_RX_ADDR_P1, address, len);
+    }
+    else
+	// Only the LSB, the rest comes from pipe 1
+	spiWriteRegister(RH_NRF24_REG_0B_RX_ADDR_P1 + pipe - 1, address[0]);
+    spiWriteRegister(RH_NRF24_REG_02_EN_RXADDR, spiReadRegister(RH_NRF24_REG_02_EN_RXADDR) | (1 << pipe));
+    return true;
+}
+
+bool RH_NRF24::disablePipe(uint8_t pipe)
+{
+    if (pipe < 1 || pipe > 5)
+	return false;
+
+    spiWriteRegister(RH_NRF24_REG_02_EN_RXADDR, spiReadRegister(RH_NRF24_REG_02_EN_RXADDR) & ~(1 << pipe));
+    return true;
+}
+
+bool RH_NRF24::setAckPayload(uint8_t pipe, const uint8_t* data, uint8_t len)
+{
+    if (!_shockBurst || pipe > 5 || len > RH_NRF24_MAX_MESSAGE_LEN)
+	return false;
+    if (spiReadRegister(RH_NRF24_REG_17_FIFO_STATUS) & RH_NRF24_TX_FULL)
+	return false;
+
+    // The same headers as send(), so the transmitter gets it with recv()
+    uint8_t buf[RH_NRF24_MAX_PAYLOAD_LEN];
+    buf[0] = _txHeaderTo;
+    buf[1] = _txHeaderFrom;
+    buf[2] = _txHeaderId;
+    buf[3] = _txHeaderFlags;
+    memcpy(buf+RH_NRF24_HEADER_LEN, data, len);
+    spiBurstWrite(RH_NRF24_COMMAND_W_ACK_PAYLOAD(pipe), buf, len + RH_NRF24_HEADER_LEN);
+    _ackQueued = true;
+    return true;
+}
+
+uint8_t RH_NRF24::lastPipe()
+{
+    return _pipe;
+}
+
+uint8_t RH_NRF24::lastRetransmissions()
+{
+    return _retransmissions;
+}
+
+uint16_t RH_NRF24::txLost()
+{
+    return _txLost;
+}
+
 bool RH_NRF24::setRF(DataRate data_rate, TransmitPower power)
 {
     uint8_t value = (power << 1) & RH_NRF24_PWR;
@@ -131,8 +218,8 @@ bool RH_NRF24::setRF(DataRate data_rate, TransmitPower power)
     value |= RH_NRF24_LNA_HCURR;
     
     spiWriteRegister(RH_NRF24_REG_06_RF_SETUP, value);
-    // If we were using auto-ack, we would have to set the appropriate timeout in reg 4 here
-    // see NRF24::setRF()
+    // The auto-ack timeout in reg 4 is set by setEnhancedShockBurst(), it depends on the 
+    // data rate and the size of the payloads with ack
     return true;
 }
 
@@ -197,7 +284,17 @@ bool RH_NRF24::send(const uint8_t* data, uint8_t len)
     _buf[2] = _txHeaderId;
     _buf[3] = _txHeaderFlags;
     memcpy(_buf+RH_NRF24_HEADER_LEN, data, len);
-    spiBurstWrite(RH_NRF24_COMMAND_W_TX_PAYLOAD_NOACK, _buf, len + RH_NRF24_HEADER_LEN);
+    // Payloads with ack still waiting in the TX FIFO would be sent ahead of this one
+    if (_ackQueued)
+    {
+	flushTx();
+	_ackQueued = false;
+    }
+    // Nobody can acknowledge a broadcast: several receivers would answer at once
+    if (_shockBurst && _txHeaderTo != RH_BROADCAST_ADDRESS)
+	spiBurstWrite(RH_NRF24_COMMAND_W_TX_PAYLOAD, _buf, len + RH_NRF24_HEADER_LEN);
+    else
+	spiBurstWrite(RH_NRF24_COMMAND_W_TX_PAYLOAD_NOACK, _buf, len + RH_NRF24_HEADER_LEN);
     setModeTx();
     // Radio will return to Standby II mode after transmission is complete
     _txGood++;
@@ -212,14 +309,20 @@ bool RH_NRF24::waitPacketSent()
 
     // Wait for either the Data Sent or Max ReTries flag, signalling the 
     // end of transmission
-    // We dont actually use auto-ack, so prob dont expect to see RH_NRF24_MAX_RT
+    // RH_NRF24_MAX_RT only happens with setEnhancedShockBurst(true): no ack after all the retries
     uint8_t status;
     while (!((status = statusRead()) & (RH_NRF24_TX_DS | RH_NRF24_MAX_RT)))
 	YIELD;
 
+    if (_shockBurst)
+	_retransmissions = spiReadRegister(RH_NRF24_REG_08_OBSERVE_TX) & RH_NRF24_ARC_CNT;
     // Must clear RH_NRF24_MAX_RT if it is set, else no further comm
     if (status & RH_NRF24_MAX_RT)
+    {
 	flushTx();
+	_txLost++;
+    }
+    // A payload with the ack, if any, stays in the RX FIFO for available()
     setModeIdle();
     spiWriteRegister(RH_NRF24_REG_07_STATUS, RH_NRF24_TX_DS | RH_NRF24_MAX_RT);
     // Return true if data sent, false if MAX_RT
@@ -293,6 +396,8 @@ bool RH_NRF24::available()
 	setModeRx();
 	if (spiReadRegister(RH_NRF24_REG_17_FIFO_STATUS) & RH_NRF24_RX_EMPTY)
 	    return false;
+	// The pipe of the payload at the top of the RX FIFO
+	_pipe = (statusRead() & RH_NRF24_RX_P_NO) >> 1;
 	// Manual says that messages > 32 octets should be discarded
 	uint8_t len = spiRead(RH_NRF24_COMMAND_R_RX_PL_WID);
 	if (len > 32)
@@ -309,8 +414,9 @@ bool RH_NRF24::available()
 	_bufLen = len;
 	// 140 microsecs (32 octet payload)
 	validateRxBuf(); 
-	if (_rxBufValid)
-	    setModeIdle(); // Got one
+	// Got one. With auto-ack stay in RX, to keep acknowledging the other pipes
+	if (_rxBufValid && !_shockBurst)
+	    setModeIdle();
     }
     return _rxBufValid;
 }
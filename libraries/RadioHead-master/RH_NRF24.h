@@ -408,6 +408,28 @@
 /// 2 byte CRC, No Auto-Ack mode. Enhanced shockburst is used. 
 /// TX and P0 are set to the Network address. Node addresses and decoding are handled with the RH_NRF24 module.
 ///
+/// \par Hardware auto-acknowledgement and multiple pipes
+///
+/// By default the chip's own acknowledgement and retransmission are unused: every packet goes out with
+/// NOACK and reliability is left to RHReliableDatagram, which costs a full software round trip (and a turn
+/// around of both radios) per message. setEnhancedShockBurst(true) hands that job to the chip instead.
+/// Addressed packets are sent with an ack request, the receiving chip acknowledges them by itself within
+/// a few hundred microseconds, and the transmitting chip retransmits up to the given number of times
+/// before waitPacketSent() returns false. Broadcasts still go out with NOACK.
+///
+/// A receiver listens on up to 6 pipes: pipe 0 is the network address, set by setNetworkAddress(),
+/// and pipes 1 to 5 are set with setPipeAddress(). Pipes 2 to 5 share all but the least significant
+/// byte with pipe 1. lastPipe() tells which pipe the last message came in on, so a hub can tell 
+/// 6 probes apart without looking at the headers. Each probe calls setNetworkAddress() with the address of
+/// its own pipe on the hub, which is also where the hub's acknowledgements come back to.
+/// While ShockBurst is enabled, the receiver stays in RX mode after a message is available, so that it
+/// keeps acknowledging the other pipes. 
+///
+/// A receiver can also queue a short reply for a pipe with setAckPayload(). It rides back on the
+/// acknowledgement of the next packet from that pipe, and the transmitter receives it with recv() like
+/// any other message (lastPipe() is then 0). Use this with RHDatagram, not RHReliableDatagram: the
+/// software acknowledgements are redundant, and its replies would wait for a packet from the other side.
+///
 /// \par Memory
 ///
 /// Memory usage of this class is minimal. The compiled client and server sketches are about 6000 bytes on Arduino. 
@@ -524,6 +546,56 @@ public:
     /// \return true on success, false if len is not in the range 3-5 inclusive.
     bool setNetworkAddress(uint8_t* address, uint8_t len);
 
+    /// Enables or disables hardware acknowledgement and retransmission (Enhanced ShockBurst
+    /// auto-ack), with dynamic payload lengths and payloads with acknowledgement. 
+    /// See "Hardware auto-acknowledgement and multiple pipes" above.
+    /// Both sides of a link must use the same setting.
+    /// \param[in] on true to enable, false to go back to NOACK packets (the default after init())
+    /// \param[in] retries Number of retransmissions before giving up, 0 to 15
+    /// \param[in] retryDelay Microseconds to wait for an acknowledgement before retransmitting, 
+    /// 250 to 4000 in steps of 250. Must cover the acknowledgement with its payload: 500 is enough at 1 and 2Mbps 
+    /// for payloads up to 15 octets, 32 octets at 250kbps need 1500.
+    /// \return true on success
+    bool setEnhancedShockBurst(bool on, uint8_t retries = 3, uint16_t retryDelay = 750);
+
+    /// Sets the receive address of one of pipes 1 to 5 and enables it.
+    /// Pipe 0 is the network address, see setNetworkAddress().
+    /// \param[in] pipe The pipe number, 1 to 5
+    /// \param[in] address The address, least significant octet first like setNetworkAddress(). 
+    /// For pipes 2 to 5 only address[0] is used: the other octets are the ones of pipe 1.
+    /// \param[in] len Number of octets in address, the same as given to setNetworkAddress() (3 to 5). 
+    /// Ignored for pipes 2 to 5.
+    /// \return true on success, false if pipe or len are out of range.
+    bool setPipeAddress(uint8_t pipe, uint8_t* address, uint8_t len);
+
+    /// Disables reception on one of pipes 1 to 5.
+    /// \param[in] pipe The pipe number, 1 to 5
+    /// \return true on success
+    bool disablePipe(uint8_t pipe);
+
+    /// Queues a message to be sent back with the acknowledgement of the next packet received on a pipe.
+    /// The current header To, From, ID and Flags are sent with it, as with send().
+    /// Only meaningful with setEnhancedShockBurst(true). The chip holds up to 3 of them, for all pipes together.
+    /// Queued messages still pending are discarded by the next send().
+    /// \param[in] pipe The pipe number, 0 to 5
+    /// \param[in] data Data bytes to send.
+    /// \param[in] len Number of data bytes to send
+    /// \return true if queued, false if the queue is full or len is too long
+    bool setAckPayload(uint8_t pipe, const uint8_t* data, uint8_t len);
+
+    /// The pipe the last message made available by available() arrived on
+    /// \return The pipe number, 0 to 5
+    uint8_t lastPipe();
+
+    /// The number of retransmissions the last packet sent with setEnhancedShockBurst(true) needed
+    /// \return The retransmission count, 0 if the first transmission was acknowledged
+    uint8_t lastRetransmissions();
+
+    /// The number of packets sent with setEnhancedShockBurst(true) that were never acknowledged,
+    /// even after all the retransmissions.
+    /// \return The number of lost packets
+    uint16_t txLost();
+
     /// Sets the data rate and transmitter power to use. Note that the nRF24 and the RFM73 have different
     /// available power levels, and for convenience, 2 different sets of values are available in the 
     /// RH_NRF24::TransmitPower enum. The ones with the RFM73 only have meaning on the RFM73 and compatible
@@ -562,7 +634,7 @@ public:
     /// Indicates if the chip is in transmit mode and 
     /// there is a packet currently being transmitted
     /// \return true if the chip is in transmit mode and there is a transmission in progress
-    bool isSending();
+    virtual bool isSending();
 
     /// Prints the value of all chip registers
     /// to the Serial device if RH_HAVE_SERIAL is defined for the current platform
@@ -628,12 +700,29 @@ private:
 
     /// True when there is a valid message in the buffer
     bool                _rxBufValid;
+
+    /// True when setEnhancedShockBurst(true)
+    bool                _shockBurst;
+
+    /// Payloads with acknowledgement queued since the last send()
+    bool                _ackQueued;
+
+    /// Pipe of the message in the buffer
+    uint8_t             _pipe;
+
+    /// ARC_CNT of the last packet sent
+    uint8_t             _retransmissions;
+
+    /// Packets that reached MAX_RT
+    uint16_t            _txLost;
 };
 
 /// @example nrf24_client.pde
 /// @example nrf24_server.pde
 /// @example nrf24_reliable_datagram_client.pde
 /// @example nrf24_reliable_datagram_server.pde
+/// @example nrf24_hub.pde
+/// @example nrf24_probe.pde
 /// @example RasPiRH.cpp
 
 #endif 
@@ -354,7 +354,7 @@ public:
     /// Indicates if the chip is in transmit mode and 
     /// there is a packet currently being transmitted
     /// \return true if the chip is in transmit mode and there is a transmission in progress
-    bool isSending();
+    virtual bool isSending();
 
     /// Prints the value of a single chip register
     /// to the Serial device if RH_HAVE_SERIAL is defined for the current platform
@@ -158,7 +158,6 @@ bool RH_RF69::init()
     // RSSI Threshold -114dBm
     // We dont use the RH_RF69s address filtering: instead we prepend our own headers to the beginning
     // of the RH_RF69 payload
-    spiWrite(RH_RF69_REG_3C_FIFOTHRESH, RH_RF69_FIFOTHRESH_TXSTARTCONDITION_NOTEMPTY | 0x0f); // thresh 15 is default
     // RSSITHRESH is default
 //    spiWrite(RH_RF69_REG_29_RSSITHRESH, 220); // -110 dbM
     // SYNCCONFIG is default. SyncSize is set later by setSyncWords()
@@ -166,10 +165,14 @@ bool RH_RF69::init()
     // PAYLOADLENGTH is default
 //    spiWrite(RH_RF69_REG_38_PAYLOADLENGTH, RH_RF69_FIFO_SIZE); // max size only for RX
     // PACKETCONFIG 2 is default 
-    spiWrite(RH_RF69_REG_6F_TESTDAGC, RH_RF69_TESTDAGC_CONTINUOUSDAGC_IMPROVED_LOWBETAOFF);
-    // If high power boost set previously, disable it
-    spiWrite(RH_RF69_REG_5A_TESTPA1, RH_RF69_TESTPA1_NORMAL);
-    spiWrite(RH_RF69_REG_5C_TESTPA2, RH_RF69_TESTPA2_NORMAL);
+    RHSPIOp ops[] = {
+	{ RH_RF69_REG_3C_FIFOTHRESH | RH_SPI_WRITE_MASK, RH_RF69_FIFOTHRESH_TXSTARTCONDITION_NOTEMPTY | 0x0f }, // thresh 15 is default
+	{ RH_RF69_REG_6F_TESTDAGC | RH_SPI_WRITE_MASK, RH_RF69_TESTDAGC_CONTINUOUSDAGC_IMPROVED_LOWBETAOFF },
+	// If high power boost set previously, disable it
+	{ RH_RF69_REG_5A_TESTPA1 | RH_SPI_WRITE_MASK, RH_RF69_TESTPA1_NORMAL },
+	{ RH_RF69_REG_5C_TESTPA2 | RH_SPI_WRITE_MASK, RH_RF69_TESTPA2_NORMAL },
+    };
+    spiBatch(ops, sizeof(ops) / sizeof(ops[0]));
 
     // The following can be changed later by the user if necessary.
     // Set up default configuration
@@ -258,17 +261,17 @@ void RH_RF69::readFifo()
 // These are low level functions that call the interrupt handler for the correct
 // instance of RH_RF69.
 // 3 interrupts allows us to have 3 different devices
-void RH_RF69::isr0()
+void RH_INTERRUPT_ATTR RH_RF69::isr0()
 {
     if (_deviceForInterrupt[0])
 	_deviceForInterrupt[0]->handleInterrupt();
 }
-void RH_RF69::isr1()
+void RH_INTERRUPT_ATTR RH_RF69::isr1()
 {
     if (_deviceForInterrupt[1])
 	_deviceForInterrupt[1]->handleInterrupt();
 }
-void RH_RF69::isr2()
+void RH_INTERRUPT_ATTR RH_RF69::isr2()
 {
     if (_deviceForInterrupt[2])
 	_deviceForInterrupt[2]->handleInterrupt();
@@ -288,9 +291,8 @@ bool RH_RF69::setFrequency(float centre, float afcPullInRange)
 {
     // Frf = FRF / FSTEP
     uint32_t frf = (uint32_t)((centre * 1000000.0) / RH_RF69_FSTEP);
-    spiWrite(RH_RF69_REG_07_FRFMSB, (frf >> 16) & 0xff);
-    spiWrite(RH_RF69_REG_08_FRFMID, (frf >> 8) & 0xff);
-    spiWrite(RH_RF69_REG_09_FRFLSB, frf & 0xff);
+    uint8_t regs[3] = { (uint8_t)((frf >> 16) & 0xff), (uint8_t)((frf >> 8) & 0xff), (uint8_t)(frf & 0xff) };
+    spiBurstWrite(RH_RF69_REG_07_FRFMSB, regs, sizeof(regs));
 
     // afcPullInRange is not used
     return true;
@@ -349,13 +351,16 @@ void RH_RF69::setModeRx()
 {
     if (_mode != RHModeRx)
     {
+	// If high power boost, return power amp to receive mode
+	RHSPIOp ops[] = {
+	    { RH_RF69_REG_5A_TESTPA1 | RH_SPI_WRITE_MASK, RH_RF69_TESTPA1_NORMAL },
+	    { RH_RF69_REG_5C_TESTPA2 | RH_SPI_WRITE_MASK, RH_RF69_TESTPA2_NORMAL },
+	    { RH_RF69_REG_25_DIOMAPPING1 | RH_SPI_WRITE_MASK, RH_RF69_DIOMAPPING1_DIO0MAPPING_01 }, // Set interrupt line 0 PayloadReady
+	};
 	if (_power >= 18)
-	{
-	    // If high power boost, return power amp to receive mode
-	    spiWrite(RH_RF69_REG_5A_TESTPA1, RH_RF69_TESTPA1_NORMAL);
-	    spiWrite(RH_RF69_REG_5C_TESTPA2, RH_RF69_TESTPA2_NORMAL);
-	}
-	spiWrite(RH_RF69_REG_25_DIOMAPPING1, RH_RF69_DIOMAPPING1_DIO0MAPPING_01); // Set interrupt line 0 PayloadReady
+	    spiBatch(ops, 3);
+	else
+	    spiBatch(ops + 2, 1);
 	setOpMode(RH_RF69_OPMODE_MODE_RX); // Clears FIFO
 	_mode = RHModeRx;
     }
@@ -365,14 +370,17 @@ void RH_RF69::setModeTx()
 {
     if (_mode != RHModeTx)
     {
+	// If high power, set high power boost mode
+	// Note that OCP defaults to ON so no need to change that.
+	RHSPIOp ops[] = {
+	    { RH_RF69_REG_5A_TESTPA1 | RH_SPI_WRITE_MASK, RH_RF69_TESTPA1_BOOST },
+	    { RH_RF69_REG_5C_TESTPA2 | RH_SPI_WRITE_MASK, RH_RF69_TESTPA2_BOOST },
+	    { RH_RF69_REG_25_DIOMAPPING1 | RH_SPI_WRITE_MASK, RH_RF69_DIOMAPPING1_DIO0MAPPING_00 }, // Set interrupt line 0 PacketSent
+	};
 	if (_power >= 18)
-	{
-	    // Set high power boost mode
-	    // Note that OCP defaults to ON so no need to change that.
-	    spiWrite(RH_RF69_REG_5A_TESTPA1, RH_RF69_TESTPA1_BOOST);
-	    spiWrite(RH_RF69_REG_5C_TESTPA2, RH_RF69_TESTPA2_BOOST);
-	}
-	spiWrite(RH_RF69_REG_25_DIOMAPPING1, RH_RF69_DIOMAPPING1_DIO0MAPPING_00); // Set interrupt line 0 PacketSent
+	    spiBatch(ops, 3);
+	else
+	    spiBatch(ops + 2, 1);
 	setOpMode(RH_RF69_OPMODE_MODE_TX); // Clears FIFO
 	_mode = RHModeTx;
     }
@@ -446,8 +454,8 @@ bool RH_RF69::setModemConfig(ModemConfigChoice index)
 
 void RH_RF69::setPreambleLength(uint16_t bytes)
 {
-    spiWrite(RH_RF69_REG_2C_PREAMBLEMSB, bytes >> 8);
-    spiWrite(RH_RF69_REG_2D_PREAMBLELSB, bytes & 0xff);
+    uint8_t regs[2] = { (uint8_t)(bytes >> 8), (uint8_t)(bytes & 0xff) };
+    spiBurstWrite(RH_RF69_REG_2C_PREAMBLEMSB, regs, sizeof(regs));
 }
 
 void RH_RF69::setSyncWords(const uint8_t* syncWords, uint8_t len)
@@ -30,6 +30,8 @@ RH_RF95::RH_RF95(uint8_t slaveSelectPin, uint8_t interruptPin, RHGenericSPI& spi
 {
     _interruptPin = interruptPin;
     _myInterruptIndex = 0xff; // Not allocated yet
+    _sniffInterval = 0;
+    _sniffCad = false;
 }
 
 bool RH_RF95::init()
@@ -120,8 +122,11 @@ bool RH_RF95::init()
 // We use this to get RxDone and TxDone interrupts
 void RH_RF95::handleInterrupt()
 {
-    // Read the interrupt register
-    uint8_t irq_flags = spiRead(RH_RF95_REG_12_IRQ_FLAGS);
+    // Read the interrupt register, with the RX FIFO address before it and the RX byte count after it
+    // in the same burst
+    uint8_t regs[4];
+    spiBurstRead(RH_RF95_REG_10_FIFO_RX_CURRENT_ADDR, regs, sizeof(regs));
+    uint8_t irq_flags = regs[RH_RF95_REG_12_IRQ_FLAGS - RH_RF95_REG_10_FIFO_RX_CURRENT_ADDR];
     if (_mode == RHModeRx && irq_flags & (RH_RF95_RX_TIMEOUT | RH_RF95_PAYLOAD_CRC_ERROR))
     {
 	_rxBad++;
@@ -129,22 +134,25 @@ void RH_RF95::handleInterrupt()
     else if (_mode == RHModeRx && irq_flags & RH_RF95_RX_DONE)
     {
 	// Have received a packet
-	uint8_t len = spiRead(RH_RF95_REG_13_RX_NB_BYTES);
+	uint8_t len = regs[RH_RF95_REG_13_RX_NB_BYTES - RH_RF95_REG_10_FIFO_RX_CURRENT_ADDR];
 
 	// Reset the fifo read ptr to the beginning of the packet
-	spiWrite(RH_RF95_REG_0D_FIFO_ADDR_PTR, spiRead(RH_RF95_REG_10_FIFO_RX_CURRENT_ADDR));
+	spiWrite(RH_RF95_REG_0D_FIFO_ADDR_PTR, regs[0]);
 	spiBurstRead(RH_RF95_REG_00_FIFO, _buf, len);
 	_bufLen = len;
 	spiWrite(RH_RF95_REG_12_IRQ_FLAGS, 0xff); // Clear all IRQ flags
 
 	// Remember the last signal to noise ratio, LORA mode
 	// Per page 111, SX1276/77/78/79 datasheet
-	_lastSNR = (int8_t)spiRead(RH_RF95_REG_19_PKT_SNR_VALUE) / 4;
+	// The packet RSSI follows it
+	uint8_t quality[2];
+	spiBurstRead(RH_RF95_REG_19_PKT_SNR_VALUE, quality, sizeof(quality));
+	_lastSNR = (int8_t)quality[0] / 4;
 
 	// Remember the RSSI of this packet, LORA mode
 	// this is according to the doc, but is it really correct?
 	// weakest receiveable signals are reported RSSI at about -66
-	_lastRssi = spiRead(RH_RF95_REG_1A_PKT_RSSI_VALUE);
+	_lastRssi = quality[1];
 	// Adjust the RSSI, datasheet page 87
 	if (_lastSNR < 0)
 	    _lastRssi = _lastRssi + _lastSNR;
@@ -168,7 +176,17 @@ void RH_RF95::handleInterrupt()
     else if (_mode == RHModeCad && irq_flags & RH_RF95_CAD_DONE)
     {
         _cad = irq_flags & RH_RF95_CAD_DETECTED;
-        setModeIdle();
+	if (_sniffCad)
+	{
+	    // A preamble on the air: listen for the message. Else back to sleep
+	    _sniffCad = false;
+	    if (_cad)
+		setModeRx();
+	    else
+		sleep();
+	}
+	else
+	    setModeIdle();
     }
     
     spiWrite(RH_RF95_REG_12_IRQ_FLAGS, 0xff); // Clear all IRQ flags
@@ -177,17 +195,17 @@ void RH_RF95::handleInterrupt()
 // These are low level functions that call the interrupt handler for the correct
 // instance of RH_RF95.
 // 3 interrupts allows us to have 3 different devices
-void RH_RF95::isr0()
+void RH_INTERRUPT_ATTR RH_RF95::isr0()
 {
     if (_deviceForInterrupt[0])
 	_deviceForInterrupt[0]->handleInterrupt();
 }
-void RH_RF95::isr1()
+void RH_INTERRUPT_ATTR RH_RF95::isr1()
 {
     if (_deviceForInterrupt[1])
 	_deviceForInterrupt[1]->handleInterrupt();
 }
-void RH_RF95::isr2()
+void RH_INTERRUPT_ATTR RH_RF95::isr2()
 {
     if (_deviceForInterrupt[2])
 	_deviceForInterrupt[2]->handleInterrupt();
@@ -216,10 +234,45 @@ bool RH_RF95::available()
 {
     if (_mode == RHModeTx)
 	return false;
-    setModeRx();
+    if (_sniffInterval)
+	sniff();
+    else
+	setModeRx();
     return _rxBufValid; // Will be set by the interrupt handler when a good message is received
 }
 
+void RH_RF95::sniff()
+{
+    if (_rxBufValid || _mode == RHModeCad)
+	return; // Collect the message first, or wait for the CAD to finish
+
+    unsigned long now = millis();
+    if (_txGood != _sniffTxGood)
+    {
+	// Just transmitted: listen for the reply (such as an ack) as if a CAD had found it
+	_sniffTxGood = _txGood;
+	_sniffLast = now;
+	setModeRx();
+	return;
+    }
+    if (   _mode == RHModeRx
+	&& (   now - _sniffLast < 2 * (unsigned long)_sniffInterval
+	    || (spiRead(RH_RF95_REG_18_MODEM_STAT) & (RH_RF95_MODEM_STATUS_SIGNAL_DETECTED | RH_RF95_MODEM_STATUS_RX_ONGOING))))
+	return; // Still waiting for the message after the preamble
+
+    if (now - _sniffLast >= _sniffInterval)
+    {
+	_sniffLast = now;
+	setModeIdle();
+	_sniffCad = true;
+	spiWrite(RH_RF95_REG_01_OP_MODE, RH_RF95_MODE_CAD);
+	spiWrite(RH_RF95_REG_40_DIO_MAPPING1, 0x80); // Interrupt on CadDone
+	_mode = RHModeCad;
+    }
+    else
+	sleep();
+}
+
 void RH_RF95::clearRxBuf()
 {
     ATOMIC_BLOCK_START;
@@ -259,10 +312,8 @@ bool RH_RF95::send(const uint8_t* data, uint8_t len)
     // Position at the beginning of the FIFO
     spiWrite(RH_RF95_REG_0D_FIFO_ADDR_PTR, 0);
     // The headers
-    spiWrite(RH_RF95_REG_00_FIFO, _txHeaderTo);
-    spiWrite(RH_RF95_REG_00_FIFO, _txHeaderFrom);
-    spiWrite(RH_RF95_REG_00_FIFO, _txHeaderId);
-    spiWrite(RH_RF95_REG_00_FIFO, _txHeaderFlags);
+    uint8_t headers[RH_RF95_HEADER_LEN] = { _txHeaderTo, _txHeaderFrom, _txHeaderId, _txHeaderFlags };
+    spiBurstWrite(RH_RF95_REG_00_FIFO, headers, sizeof(headers));
     // The message data
     spiBurstWrite(RH_RF95_REG_00_FIFO, data, len);
     spiWrite(RH_RF95_REG_22_PAYLOAD_LENGTH, len + RH_RF95_HEADER_LEN);
@@ -297,9 +348,8 @@ bool RH_RF95::setFrequency(float centre)
 {
     // Frf = FRF / FSTEP
     uint32_t frf = (centre * 1000000.0) / RH_RF95_FSTEP;
-    spiWrite(RH_RF95_REG_06_FRF_MSB, (frf >> 16) & 0xff);
-    spiWrite(RH_RF95_REG_07_FRF_MID, (frf >> 8) & 0xff);
-    spiWrite(RH_RF95_REG_08_FRF_LSB, frf & 0xff);
+    uint8_t regs[3] = { (uint8_t)((frf >> 16) & 0xff), (uint8_t)((frf >> 8) & 0xff), (uint8_t)(frf & 0xff) };
+    spiBurstWrite(RH_RF95_REG_06_FRF_MSB, regs, sizeof(regs));
     _usingHFport = (centre >= 779.0);
 
     return true;
@@ -389,9 +439,12 @@ void RH_RF95::setTxPower(int8_t power, bool useRFO)
 // Sets registers from a canned modem configuration structure
 void RH_RF95::setModemRegisters(const ModemConfig* config)
 {
-    spiWrite(RH_RF95_REG_1D_MODEM_CONFIG1,       config->reg_1d);
-    spiWrite(RH_RF95_REG_1E_MODEM_CONFIG2,       config->reg_1e);
-    spiWrite(RH_RF95_REG_26_MODEM_CONFIG3,       config->reg_26);
+    RHSPIOp ops[] = {
+	{ RH_RF95_REG_1D_MODEM_CONFIG1 | RH_SPI_WRITE_MASK, config->reg_1d },
+	{ RH_RF95_REG_1E_MODEM_CONFIG2 | RH_SPI_WRITE_MASK, config->reg_1e },
+	{ RH_RF95_REG_26_MODEM_CONFIG3 | RH_SPI_WRITE_MASK, config->reg_26 },
+    };
+    spiBatch(ops, sizeof(ops) / sizeof(ops[0]));
 }
 
 // Set one of the canned FSK Modem configs
@@ -410,8 +463,8 @@ bool RH_RF95::setModemConfig(ModemConfigChoice index)
 
 void RH_RF95::setPreambleLength(uint16_t bytes)
 {
-    spiWrite(RH_RF95_REG_20_PREAMBLE_MSB, bytes >> 8);
-    spiWrite(RH_RF95_REG_21_PREAMBLE_LSB, bytes & 0xff);
+    uint8_t regs[2] = { (uint8_t)(bytes >> 8), (uint8_t)(bytes & 0xff) };
+    spiBurstWrite(RH_RF95_REG_20_PREAMBLE_MSB, regs, sizeof(regs));
 }
 
 bool RH_RF95::isChannelActive()
@@ -424,12 +477,35 @@ bool RH_RF95::isChannelActive()
         _mode = RHModeCad;
     }
 
+    _sniffCad = false;
     while (_mode == RHModeCad)
         YIELD;
 
     return _cad;
 }
 
+void RH_RF95::setSniff(uint16_t interval)
+{
+    _sniffInterval = interval;
+    _sniffLast = millis() - interval; // First CAD right away
+    _sniffTxGood = _txGood;
+    if (!interval && _mode == RHModeSleep)
+	setModeIdle();
+}
+
+void RH_RF95::setSniffPreamble(uint16_t interval)
+{
+    // A symbol lasts 2^SF / BW: count enough of them to span the interval, plus
+    // the default preamble for the receiver to lock on after its CAD
+    float bw_tab[] = {7.8, 10.4, 15.6, 20.8, 31.25, 41.7, 62.5, 125, 250, 500};
+    uint8_t bwindex = spiRead(RH_RF95_REG_1D_MODEM_CONFIG1) >> 4;
+    uint8_t sf = spiRead(RH_RF95_REG_1E_MODEM_CONFIG2) >> 4;
+    if (bwindex >= (sizeof(bw_tab) / sizeof(float)))
+	return;
+    uint32_t symbols = (uint32_t)((float)interval * bw_tab[bwindex] / (float)(1L << sf)) + 8;
+    setPreambleLength(symbols > 0xffff ? 0xffff : symbols);
+}
+
 void RH_RF95::enableTCXO()
 {
     while ((spiRead(RH_RF95_REG_4B_TCXO) & RH_RF95_TCXO_TCXO_INPUT_ON) != RH_RF95_TCXO_TCXO_INPUT_ON)
@@ -444,6 +444,23 @@
 /// and from that other device.  Use cli() to disable interrupts and sei() to
 /// reenable them.
 ///
+/// \par Low power listening
+///
+/// In the usual receive mode the radio draws about 11mA all the time. With setSniff(), the receiver
+/// sleeps instead, and wakes every interval milliseconds to run a Channel Activity Detection (CAD), which takes a
+/// couple of LoRa symbols. It turns on the receiver only when CAD finds a preamble on the air, and it goes back to sleep if no
+/// message follows within twice the interval, unless the modem is still receiving one.
+/// After each transmission, the receiver also stays on for twice the interval, so that replies such as acks
+/// arrive without a long preamble.
+/// The timing is driven by available(), so keep calling it (or recv(), recvfromAck() etc.), at least once per
+/// interval. The sketch may sleep the processor between calls.
+/// For a sniffing node to catch a message, the preamble of that message must last longer than the interval:
+/// call setSniffPreamble() with the same interval on every node that sends to it, after setting the modem configuration.
+/// That makes every message longer, so keep the interval as short as your power budget allows.
+///
+/// For listen-before-talk, call setCADTimeout(). send() then runs CAD and retries after a random
+/// backoff until the channel is clear, or until the timeout expires. If the timeout expires, send() fails.
+///
 /// \par Memory
 ///
 /// The RH_RF95 driver requires non-trivial amounts of memory. The sample
@@ -726,6 +743,16 @@ public:
     /// \return true if channel is in use.  
     virtual bool    isChannelActive();
 
+    /// Enables or disables low power listening (see above).
+    /// \param[in] interval Milliseconds between CADs. 0 (the default) keeps the receiver on continuously
+    /// whenever the driver is not transmitting
+    void           setSniff(uint16_t interval);
+
+    /// Sets the preamble long enough for a receiver that sniffs every interval milliseconds to catch it, with the
+    /// current spreading factor and bandwidth. Calls setPreambleLength(). Set the modem configuration first.
+    /// \param[in] interval The interval the receivers passed to setSniff()
+    void           setSniffPreamble(uint16_t interval);
+
     /// Enable TCXO mode
     /// Call this immediately after init(), to force your radio to use an external 
     /// frequency source, such as a Temperature Compensated Crystal Oscillator (TCXO).
@@ -763,6 +790,10 @@ protected:
     /// Clear our local receive buffer
     void clearRxBuf();
 
+    /// Advances low power listening: starts a CAD when one is due, and stops
+    /// the receiver when no message followed the preamble. Called by available()
+    void sniff();
+
 private:
     /// Low level interrupt service routine for device connected to interrupt 0
     static void         isr0();
@@ -800,6 +831,18 @@ private:
 
     // Last measured SNR, dB
     int8_t              _lastSNR;
+
+    /// Milliseconds between CADs when sniffing, 0 when not
+    uint16_t            _sniffInterval;
+
+    /// When the last sniffing CAD started
+    unsigned long       _sniffLast;
+
+    /// _txGood when sniff() last saw it, to notice transmissions
+    uint16_t            _sniffTxGood;
+
+    /// True while the CAD in progress was started by sniff(), not by isChannelActive()
+    volatile bool       _sniffCad;
 };
 
 /// @example rf95_client.pde
@@ -13,7 +13,10 @@
 RH_Serial::RH_Serial(HardwareSerial& serial)
     :
     _serial(serial),
-    _rxState(RxStateInitialising)
+    _rxState(RxStateInitialising),
+    _rxBufLen(0),
+    _rxHead(0),
+    _rxCount(0)
 {
 }
 
@@ -27,15 +30,30 @@ bool RH_Serial::init()
     if (!RHGenericDriver::init())
 	return false;
     _rxState = RxStateIdle;
+    _rxBufLen = 0;
+    _rxHead = 0;
+    _rxCount = 0;
     return true;
 }
 
 // Call this often
 bool RH_Serial::available()
 {
-    while (!_rxBufValid &&_serial.available())
-	handleRx(_serial.read());
-    return _rxBufValid;
+    uint8_t chunk[RH_SERIAL_RX_CHUNK];
+    uint8_t n;
+
+    // Once the queue is full the rest waits in the UART buffer
+    while (_rxCount < RH_SERIAL_RX_FRAMES && (n = readChunk(chunk, sizeof(chunk))))
+	handleRx(chunk, n);
+    if (!_rxCount)
+	return false;
+
+    // Headers of the frame recv() will return next
+    _rxHeaderTo    = _rxBuf[_rxHead][0];
+    _rxHeaderFrom  = _rxBuf[_rxHead][1];
+    _rxHeaderId    = _rxBuf[_rxHead][2];
+    _rxHeaderFlags = _rxBuf[_rxHead][3];
+    return true;
 }
 
 void RH_Serial::waitAvailable()
@@ -67,120 +85,162 @@ bool RH_Serial::waitAvailableTimeout(uint16_t timeout)
 #endif
 }
 
-void  RH_Serial::handleRx(uint8_t ch)
+uint8_t RH_Serial::readChunk(uint8_t* buf, uint8_t len)
 {
-    // State machine for receiving chars
-    switch(_rxState)
+    int avail = _serial.available();
+    if (avail <= 0)
+	return 0;
+    if (avail < len)
+	len = avail;
+#if (RH_PLATFORM == RH_PLATFORM_STM32STD)
+    // STM32ArduinoCompat has no readBytes, and available() is only 0 or 1
+    buf[0] = _serial.read();
+    return 1;
+#else
+    // Never more than available(), so readBytes() does not wait for its timeout
+    return _serial.readBytes((char*)buf, len);
+#endif
+}
+
+void RH_Serial::handleRx(const uint8_t* buf, uint8_t len)
+{
+    const uint8_t* end = buf + len;
+
+    // State machine for receiving chars. Data between DLEs is found with
+    // memchr and copied as a run, not byte by byte
+    while (buf < end)
     {
-	case RxStateIdle:
+	switch(_rxState)
 	{
-	    if (ch == DLE)
+	    case RxStateIdle:
+	    {
+		buf = (const uint8_t*)memchr(buf, DLE, end - buf);
+		if (!buf)
+		    return;
+		buf++;
 		_rxState = RxStateDLE;
-	}
-	break;
-	    
-	case RxStateDLE:
-	{
-	    if (ch == STX)
+	    }
+	    break;
+
+	    case RxStateDLE:
 	    {
-		clearRxBuf();
-		_rxState = RxStateData;
+		if (*buf++ == STX)
+		{
+		    _rxBufLen = 0;
+		    _rxState = RxStateData;
+		}
+		else
+		    _rxState = RxStateIdle;
 	    }
-	    else
-		_rxState = RxStateIdle;
-	}
-	break;
+	    break;
 
-	case RxStateData:
-	{
-	    if (ch == DLE)
-		_rxState = RxStateEscape;
-	    else
-		appendRxBuf(ch);
-	}
-	break;
+	    case RxStateData:
+	    {
+		const uint8_t* dle = (const uint8_t*)memchr(buf, DLE, end - buf);
+		const uint8_t* stop = dle ? dle : end;
+		appendRxBuf(buf, stop - buf);
+		buf = stop;
+		if (dle)
+		{
+		    buf++;
+		    _rxState = RxStateEscape;
+		}
+	    }
+	    break;
 
-	case RxStateEscape:
-	{
-	    if (ch == ETX)
+	    case RxStateEscape:
 	    {
-		// add fcs for DLE, ETX
-		_rxFcs = RHcrc_ccitt_update(_rxFcs, DLE);
-		_rxFcs = RHcrc_ccitt_update(_rxFcs, ETX);
-		_rxState = RxStateWaitFCS1; // End frame
+		if (*buf == ETX)
+		    _rxState = RxStateWaitFCS1; // End frame
+		else if (*buf == DLE)
+		{
+		    appendRxBuf(buf, 1);
+		    _rxState = RxStateData;
+		}
+		else
+		    _rxState = RxStateIdle; // Unexpected
+		buf++;
 	    }
-	    else if (ch == DLE)
+	    break;
+
+	    case RxStateWaitFCS1:
 	    {
-		appendRxBuf(ch);
-		_rxState = RxStateData;
+		_rxRecdFcs = *buf++ << 8;
+		_rxState = RxStateWaitFCS2;
 	    }
-	    else
-		_rxState = RxStateIdle; // Unexpected
-	}
-	break;
+	    break;
 
-	case RxStateWaitFCS1:
-	{
-	    _rxRecdFcs = ch << 8;
-	    _rxState = RxStateWaitFCS2;
-	}
-	break;
+	    case RxStateWaitFCS2:
+	    {
+		_rxRecdFcs |= *buf++;
+		_rxState = RxStateIdle;
+		validateRxBuf();
+	    }
+	    break;
 
-	case RxStateWaitFCS2:
-	{
-	    _rxRecdFcs |= ch;
-	    _rxState = RxStateIdle;
-	    validateRxBuf();
+	    default: // Else some compilers complain
+		buf = end;
+		break;
 	}
-	break;
-
-	default: // Else some compilers complain
-	    break; 
     }
 }
 
-void RH_Serial::clearRxBuf()
-{
-    _rxBufValid = false;
-    _rxFcs = 0xffff;
-    _rxBufLen = 0;
-}
-
-void RH_Serial::appendRxBuf(uint8_t ch)
+void RH_Serial::appendRxBuf(const uint8_t* data, uint8_t len)
 {
-    if (_rxBufLen < RH_SERIAL_MAX_PAYLOAD_LEN)
+    // An overlong frame is marked by a length past the end of the buffer
+    // and is dropped when its FCS arrives
+    if (_rxBufLen > RH_SERIAL_MAX_PAYLOAD_LEN || len > RH_SERIAL_MAX_PAYLOAD_LEN - _rxBufLen)
     {
-	// Normal data, save and add to FCS
-	_rxBuf[_rxBufLen++] = ch;
-	_rxFcs = RHcrc_ccitt_update(_rxFcs, ch);
+	_rxBufLen = RH_SERIAL_MAX_PAYLOAD_LEN + 1;
+	return;
     }
-    // If the buffer overflows, we dont record the trailing data, and the FCS will be wrong,
-    // causing the message to be dropped when the FCS is received
+    memcpy(rxSlot() + _rxBufLen, data, len);
+    _rxBufLen += len;
 }
 
-// Check whether the latest received message is complete and uncorrupted
+// Check whether the latest received message is complete and uncorrupted,
+// and if so queue it for recv()
 void RH_Serial::validateRxBuf()
 {
-    if (_rxRecdFcs != _rxFcs)
+    if (_rxBufLen < RH_SERIAL_HEADER_LEN || _rxBufLen > RH_SERIAL_MAX_PAYLOAD_LEN)
+    {
+	_rxBad++;
+	return;
+    }
+
+    // FCS covers the unstuffed data and the trailing DLE, ETX
+    uint8_t* frame = rxSlot();
+    uint16_t fcs = RHcrc_ccitt(frame, _rxBufLen);
+    fcs = RHcrc_ccitt_update(fcs, DLE);
+    fcs = RHcrc_ccitt_update(fcs, ETX);
+    if (_rxRecdFcs != fcs)
     {
 	_rxBad++;
 	return;
     }
 
-    // Extract the 4 headers
-    _rxHeaderTo    = _rxBuf[0];
-    _rxHeaderFrom  = _rxBuf[1];
-    _rxHeaderId    = _rxBuf[2];
-    _rxHeaderFlags = _rxBuf[3];
     if (_promiscuous ||
-	_rxHeaderTo == _thisAddress ||
-	_rxHeaderTo == RH_BROADCAST_ADDRESS)
+	frame[0] == _thisAddress ||
+	frame[0] == RH_BROADCAST_ADDRESS)
     {
+	// The slot we assembled into stays in use only if there was room
+	// in the queue, else the frame is lost
+	if (_rxCount >= RH_SERIAL_RX_FRAMES)
+	{
+	    _rxBad++;
+	    return;
+	}
+	_rxLen[(_rxHead + _rxCount) % (RH_SERIAL_RX_FRAMES + 1)] = _rxBufLen;
+	_rxCount++;
 	_rxGood++;
-	_rxBufValid = true;
     }
 }
 
+uint8_t* RH_Serial::rxSlot()
+{
+    return _rxBuf[(_rxHead + _rxCount) % (RH_SERIAL_RX_FRAMES + 1)];
+}
+
 bool RH_Serial::recv(uint8_t* buf, uint8_t* len)
 {
     if (!available())
@@ -188,50 +248,64 @@ bool RH_Serial::recv(uint8_t* buf, uint8_t* len)
 
     if (buf && len)
     {
-	// Skip the 4 headers that are at the beginning of the rxBuf
-	if (*len > _rxBufLen-RH_SERIAL_HEADER_LEN)
-	    *len = _rxBufLen-RH_SERIAL_HEADER_LEN;
-	memcpy(buf, _rxBuf+RH_SERIAL_HEADER_LEN, *len);
+	// Skip the 4 headers that are at the beginning of the frame
+	uint8_t frameLen = _rxLen[_rxHead] - RH_SERIAL_HEADER_LEN;
+	if (*len > frameLen)
+	    *len = frameLen;
+	memcpy(buf, _rxBuf[_rxHead] + RH_SERIAL_HEADER_LEN, *len);
     }
-    clearRxBuf(); // This message accepted and cleared
+    // This message accepted and cleared. A frame being assembled keeps
+    // its slot, since head + count does not change
+    _rxHead = (_rxHead + 1) % (RH_SERIAL_RX_FRAMES + 1);
+    _rxCount--;
     return true;
 }
 
 // Caution: this may block
 bool RH_Serial::send(const uint8_t* data, uint8_t len)
 {
+    if (len > RH_SERIAL_MAX_MESSAGE_LEN)
+	return false;
+
     if (!waitCAD()) 
 	return false;  // Check channel activity
 
-    _txFcs = 0xffff;    // Initial value
-    _serial.write(DLE); // Not in FCS
-    _serial.write(STX); // Not in FCS
-    // First the 4 headers
-    txData(_txHeaderTo);
-    txData(_txHeaderFrom);
-    txData(_txHeaderId);
-    txData(_txHeaderFlags);
-    // Now the payload
-    while (len--)
-	txData(*data++);
-    // End of message
-    _serial.write(DLE);
-    _txFcs = RHcrc_ccitt_update(_txFcs, DLE);
-    _serial.write(ETX);
-    _txFcs = RHcrc_ccitt_update(_txFcs, ETX);
-
-    // Now send the calculated FCS for this message
-    _serial.write((_txFcs >> 8) & 0xff);
-    _serial.write(_txFcs & 0xff);
+    uint8_t headers[RH_SERIAL_HEADER_LEN] = { _txHeaderTo, _txHeaderFrom, _txHeaderId, _txHeaderFlags };
+    uint16_t fcs = RHcrc_ccitt(headers, sizeof(headers));
+    fcs = RHcrc_ccitt(data, len, fcs);
+    fcs = RHcrc_ccitt_update(fcs, DLE);
+    fcs = RHcrc_ccitt_update(fcs, ETX);
+
+    // The whole stuffed frame is built here and goes to the UART in one write
+    uint8_t frame[RH_SERIAL_MAX_FRAME_LEN];
+    uint8_t n = 0;
+    frame[n++] = DLE; // Not in FCS
+    frame[n++] = STX; // Not in FCS
+    n = txData(frame, n, headers, sizeof(headers));
+    n = txData(frame, n, data, len);
+    frame[n++] = DLE;
+    frame[n++] = ETX;
+    frame[n++] = (fcs >> 8) & 0xff;
+    frame[n++] = fcs & 0xff;
+
+#if (RH_PLATFORM == RH_PLATFORM_STM32STD)
+    for (uint8_t i = 0; i < n; i++)
+	_serial.write(frame[i]);
+#else
+    _serial.write(frame, n);
+#endif
     return true;
 }
 
-void  RH_Serial::txData(uint8_t ch)
+uint8_t RH_Serial::txData(uint8_t* frame, uint8_t n, const uint8_t* data, uint8_t len)
 {
-    if (ch == DLE)    // DLE stuffing required?
-	_serial.write(DLE); // Not in FCS
-    _serial.write(ch);
-    _txFcs = RHcrc_ccitt_update(_txFcs, ch);
+    while (len--)
+    {
+	if (*data == DLE)    // DLE stuffing required?
+	    frame[n++] = DLE; // Not in FCS
+	frame[n++] = *data++;
+    }
+    return n;
 }
 
 uint8_t RH_Serial::maxMessageLength()
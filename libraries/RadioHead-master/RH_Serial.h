@@ -33,6 +33,21 @@
 #define RH_SERIAL_MAX_MESSAGE_LEN (RH_SERIAL_MAX_PAYLOAD_LEN - RH_SERIAL_HEADER_LEN)
 #endif
 
+// Longest frame on the wire: DLE STX, every payload octet stuffed, DLE ETX and the FCS
+#define RH_SERIAL_MAX_FRAME_LEN (2 + 2 * RH_SERIAL_MAX_PAYLOAD_LEN + 4)
+
+// Number of complete frames that can wait for recv(). There is one more
+// buffer than this, for the frame being received.
+// Can be pre-defined to 1 (to save SRAM) prior to including this header
+#ifndef RH_SERIAL_RX_FRAMES
+#define RH_SERIAL_RX_FRAMES 2
+#endif
+
+// Octets taken from the serial port per readBytes() call, on the stack of available()
+#ifndef RH_SERIAL_RX_CHUNK
+#define RH_SERIAL_RX_CHUNK 32
+#endif
+
 #if (RH_PLATFORM == RH_PLATFORM_STM32F2)
  #define HardwareSerial USARTSerial
 #endif
@@ -137,7 +152,21 @@ class HardwareSerial;
 /// RH_HARDWARESERIAL_DEVICE_NAME=/dev/ttyUSB0 ./serial_reliable_datagram_client 
 /// \endcode
 /// You should see the 2 programs passing messages to each other.
-/// 
+///
+/// \par Receive and transmit paths
+///
+/// available() drains the serial port RH_SERIAL_RX_CHUNK octets at a time with readBytes(),
+/// so cores that keep their UART data in a FIFO or DMA buffer hand it over as a
+/// block. Within a chunk the data between DLEs is located with memchr and copied as a run,
+/// and the FCS is calculated once over the whole frame when DLE ETX and the FCS have arrived.
+/// Up to RH_SERIAL_RX_FRAMES good frames are queued for recv(), and the port keeps
+/// being drained into a spare buffer while they wait, so back-to-back frames on a busy
+/// multidrop line are not lost between calls. A frame that completes while the queue is
+/// full is dropped and counted in rxBad().
+///
+/// send() builds the whole stuffed frame in a buffer and hands it to the port in one write().
+/// The frame format is the same as before, so these nodes interoperate with older RH_Serial ones.
+///
 class RH_Serial : public RHGenericDriver
 {
 public:
@@ -208,23 +237,29 @@ protected:
 	RxStateWaitFCS2           ///< Waiting for second FCS octet
     } RxState;
 
-    /// HAndle a character received from the serial port. IMplements
-    /// the receiver state machine
-    void  handleRx(uint8_t ch);
+    /// Reads up to len octets that are already waiting in the serial port, without blocking
+    /// \param[in] buf Where to put them
+    /// \param[in] len Size of buf
+    /// \return The number of octets read, 0 if there were none
+    uint8_t readChunk(uint8_t* buf, uint8_t len);
 
-    /// Empties the Rx buffer
-    void  clearRxBuf();
+    /// Handle a chunk of octets received from the serial port. Implements
+    /// the receiver state machine
+    void  handleRx(const uint8_t* buf, uint8_t len);
 
-    /// Adds a charater to the Rx buffer
-    void  appendRxBuf(uint8_t ch);
+    /// Adds a run of unstuffed data to the frame being received
+    void  appendRxBuf(const uint8_t* data, uint8_t len);
 
-    /// Checks whether the Rx buffer contains valid data that is complete and uncorrupted
-    /// Check the FCS, the TO address, and extracts the headers
+    /// Checks whether the frame just received is complete and uncorrupted
+    /// Checks the FCS and the TO address, and queues the frame for recv()
     void  validateRxBuf();
 
-    /// Sends a single data octet to the serial port.
-    /// Implements DLE stuffing and keeps track of the senders FCS
-    void  txData(uint8_t ch);
+    /// Buffer of the frame being received
+    uint8_t* rxSlot();
+
+    /// Copies data to the frame being built at frame[n], with DLE stuffing
+    /// \return The new length of the frame
+    uint8_t txData(uint8_t* frame, uint8_t n, const uint8_t* data, uint8_t len);
 
     /// Reference to the HardwareSerial port we will use
     HardwareSerial& _serial;
@@ -232,23 +267,23 @@ protected:
     /// The current state of the Rx state machine
     RxState         _rxState;
 
-    /// Progressive FCS calc (CCITT CRC-16 covering all received data (but not stuffed DLEs), plus trailing DLE, ETX)
-    uint16_t        _rxFcs;
-
     /// The received FCS at the end of the current message
     uint16_t        _rxRecdFcs; 
 
-    /// The Rx buffer
-    uint8_t         _rxBuf[RH_SERIAL_MAX_PAYLOAD_LEN];
+    /// Queued frames from _rxHead, followed by the one being received
+    uint8_t         _rxBuf[RH_SERIAL_RX_FRAMES + 1][RH_SERIAL_MAX_PAYLOAD_LEN];
+
+    /// Length of each queued frame, headers included
+    uint8_t         _rxLen[RH_SERIAL_RX_FRAMES + 1];
 
-    /// Current length of data in the Rx buffer
+    /// Current length of the frame being received
     uint8_t         _rxBufLen;
 
-    /// True if the data in the Rx buffer is value and uncorrupted and complete message is available for collection
-    bool            _rxBufValid;
+    /// Slot of the oldest queued frame
+    uint8_t         _rxHead;
 
-    /// FCS for transmitted data
-    uint16_t        _txFcs;
+    /// Number of complete frames queued for recv()
+    uint8_t         _rxCount;
 };
 
 /// @example serial_reliable_datagram_client.pde
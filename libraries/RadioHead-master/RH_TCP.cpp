@@ -13,6 +13,7 @@
 #include <errno.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
@@ -21,9 +22,11 @@
 
 RH_TCP::RH_TCP(const char* server)
     : _server(server),
+      _socket(-1),
       _rxBufLen(0),
       _rxBufValid(false),
-      _socket(-1)
+      _rxBufFull(false),
+      _socketBufLen(0)
 {
 }
     
@@ -92,6 +95,10 @@ bool RH_TCP::connectToServer()
 
     freeaddrinfo(result);           /* No longer needed */
 
+    // Packets are small and latency matters more than throughput
+    int nodelay = 1;
+    setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
     // Now make the socket non-blocking
     int on = 1;
     int rc = ioctl(_socket, FIONBIO, (char *)&on);
@@ -113,12 +120,8 @@ void RH_TCP::clearRxBuf()
 
 void RH_TCP::checkForEvents()
 {
-    #define RH_TCP_SOCKETBUF_LEN 500
-    static uint8_t socketBuf[RH_TCP_SOCKETBUF_LEN]; // Room for several messages
-    static uint16_t socketBufLen = 0;
-
     // Read at most the amount of space we have left in the buffer
-    ssize_t count = read(_socket, socketBuf + socketBufLen, sizeof(socketBuf) - socketBufLen);
+    ssize_t count = read(_socket, _socketBuf + _socketBufLen, sizeof(_socketBuf) - _socketBufLen);
     if (count < 0)
     {
 	if (errno != EAGAIN)
@@ -127,54 +130,56 @@ void RH_TCP::checkForEvents()
 	    exit(1);
 	}
     }
-    else if (count == 0)
+    else if (count == 0 && _socketBufLen < sizeof(_socketBuf))
     {
 	// End of file
 	fprintf(stderr,"RH_TCP::checkForEvents unexpected end of file on read\n");
 	exit(1);
     }
     else
+	_socketBufLen += count;
+
+    // Messages already buffered are handled even if nothing new was read.
+    // A packet stays in _socketBuf until the previous one has been collected,
+    // so back-to-back packets are not lost
+    while (_socketBufLen >= 5 && !_rxBufFull && !_rxBufValid)
     {
-	socketBufLen += count;
-	while (socketBufLen >= 5)
+	RHTcpTypeMessage* message = ((RHTcpTypeMessage*)_socketBuf);
+	uint32_t len = ntohl(message->length);
+	uint32_t messageLen = len + sizeof(message->length);
+	if (len > sizeof(_socketBuf) - sizeof(message->length))
 	{
-	    RHTcpTypeMessage* message = ((RHTcpTypeMessage*)socketBuf);
-	    uint32_t len = ntohl(message->length);
-	    uint32_t messageLen = len + sizeof(message->length);
-	    if (len > sizeof(socketBuf) - sizeof(message->length))
-	    {
-		// Bogus length
-		fprintf(stderr, "RH_TCP::checkForEvents read ridiculous length: %d. Corrupt message stream? Aborting\n", len);
-		exit(1);
-	    }
-	    if (socketBufLen >= len + sizeof(message->length))
+	    // Bogus length
+	    fprintf(stderr, "RH_TCP::checkForEvents read ridiculous length: %d. Corrupt message stream? Aborting\n", len);
+	    exit(1);
+	}
+	if (_socketBufLen < messageLen)
+	    break; // Rest of this message not here yet
+
+	// Got at least all of this message
+	if (message->type == RH_TCP_MESSAGE_TYPE_PACKET && len >= 5)
+	{
+	    // REVISIT: need to check if we are actually receiving?
+	    // Its a new packet, extract the headers and payload
+	    RHTcpPacket* packet = ((RHTcpPacket*)_socketBuf);
+	    _rxHeaderTo    = packet->to;
+	    _rxHeaderFrom  = packet->from;
+	    _rxHeaderId    = packet->id;
+	    _rxHeaderFlags = packet->flags;
+	    uint32_t payloadLen = len - 5;
+	    if (payloadLen <= sizeof(_rxBuf))
 	    {
-		// Got at least all of this message
-		if (message->type == RH_TCP_MESSAGE_TYPE_PACKET && len >= 5)
-		{
-		    // REVISIT: need to check if we are actually receiving?
-		    // Its a new packet, extract the headers and payload
-		    RHTcpPacket* packet = ((RHTcpPacket*)socketBuf);
-		    _rxHeaderTo    = packet->to;
-		    _rxHeaderFrom  = packet->from;
-		    _rxHeaderId    = packet->id;
-		    _rxHeaderFlags = packet->flags;
-		    uint32_t payloadLen = len - 5;
-		    if (payloadLen <= sizeof(_rxBuf))
-		    {
-			// Enough room in our receiver buffer
-			memcpy(_rxBuf, packet->payload, payloadLen);
-			_rxBufLen = payloadLen;
-			_rxBufFull = true;
-		    }
-		}
-		// check for other message types here
-		// Now remove the used message by copying the trailing bytes (maybe start of a new message?)
-		// to the top of the buffer
-		memcpy(socketBuf, socketBuf + messageLen, sizeof(socketBuf) - messageLen);
-		socketBufLen -= messageLen;
+		// Enough room in our receiver buffer
+		memcpy(_rxBuf, packet->payload, payloadLen);
+		_rxBufLen = payloadLen;
+		_rxBufFull = true;
 	    }
 	}
+	// check for other message types here
+	// Now remove the used message by moving the trailing bytes (maybe start of a new message?)
+	// to the top of the buffer
+	memmove(_socketBuf, _socketBuf + messageLen, _socketBufLen - messageLen);
+	_socketBufLen -= messageLen;
     }
 }
 
@@ -195,10 +200,12 @@ bool RH_TCP::available()
     if (_socket < 0)
 	return false;
     checkForEvents();
-    if (_rxBufFull)
+    while (_rxBufFull)
     {
 	validateRxBuf();
 	_rxBufFull= false;
+	if (!_rxBufValid)
+	    checkForEvents(); // Not for us, maybe the next one is
     }
     return _rxBufValid;
 }
@@ -216,6 +223,10 @@ bool RH_TCP::waitAvailableTimeout(uint16_t timeout)
     fd_set         input;
     int            result;
 
+    // May already have a whole packet buffered, with nothing more to come on the socket
+    if (available())
+	return true;
+
     FD_ZERO(&input);
     FD_SET(_socket, &input);
     max_fd = _socket + 1;
@@ -290,14 +301,14 @@ bool RH_TCP::sendPacket(const uint8_t* data, uint8_t len)
     if (_socket < 0)
 	return false;
     RHTcpPacket m;
-    m.length = htonl(len + 4);
+    m.length = htonl(len + 5); // type, 4 headers and the data
     m.type  = RH_TCP_MESSAGE_TYPE_PACKET;
     m.to    = _txHeaderTo;
     m.from  = _txHeaderFrom;
     m.id    = _txHeaderId;
     m.flags = _txHeaderFlags;
     memcpy(m.payload, data, len);
-    ssize_t sent = write(_socket, &m, len + 8);
+    ssize_t sent = write(_socket, &m, len + 9);
     return sent > 0;
 }
 
@@ -58,12 +58,31 @@
 /// The simulated sketches send messages out to the 'ether' over the TCP connection to the etherServer.
 /// etherServer manages the delivery of each message to any other RH_TCP sketches that are running.
 ///
+/// \par Many nodes
+///
+/// tools/etherSimulator.cpp is a C++ version of etherSimulator.pl that does not need Perl.
+/// It is a single non-blocking process (epoll on Linux, poll elsewhere) that serves hundreds
+/// of connections, with the same options and config file as the Perl version. It also accepts
+/// a "default:probability" line for the node pairs the config does not list.
+/// With "default:0.0", a sparse topology only needs to list its links.
+/// \code
+/// g++ -O2 -I . -o etherSimulator tools/etherSimulator.cpp
+/// \endcode
+///
+/// Each RH_TCP instance has its own receive buffer. On Unix the manager scratch buffers are
+/// thread local, so a single process can run many nodes, one per thread.
+/// examples/simulator/simulator_mesh_scale does that to load test RHMesh routing on a grid.
+///
 /// \par Prerequisites
 ///
 /// g++ compiler installed and in your $PATH
-/// Perl
-/// Perl POE library
+/// Perl and the Perl POE library, for etherSimulator.pl
 ///
+// Size of the buffer for the stream of messages from the server
+#ifndef RH_TCP_SOCKETBUF_LEN
+#define RH_TCP_SOCKETBUF_LEN 500
+#endif
+
 class RH_TCP : public RHGenericDriver
 {
 public:
@@ -179,9 +198,15 @@ private:
     /// Buf is filled but not validated
     volatile bool   _rxBufFull;
 
+    /// Stream from the server, room for several messages. Per instance, so that
+    /// several RH_TCP nodes can run in one process
+    uint8_t         _socketBuf[RH_TCP_SOCKETBUF_LEN];
+    uint16_t        _socketBufLen;
+
 };
 
 /// @example simulator_reliable_datagram_client.pde
 /// @example simulator_reliable_datagram_server.pde
+/// @example simulator_mesh_scale.pde
 
 #endif
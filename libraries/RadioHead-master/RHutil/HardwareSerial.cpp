@@ -85,6 +85,28 @@ size_t HardwareSerial::write(uint8_t ch)
     return 1; // OK
 }
 
+size_t HardwareSerial::write(const uint8_t* buf, size_t len)
+{
+    ssize_t result = ::write(_device, buf, len);
+    if (result < 0)
+    {
+	fprintf(stderr, "HardwareSerial::write failed: %s\n", strerror(errno));
+	return 0;
+    }
+    return result;
+}
+
+size_t HardwareSerial::readBytes(char* buf, size_t len)
+{
+    ssize_t result = ::read(_device, buf, len);
+    if (result < 0)
+    {
+	fprintf(stderr, "HardwareSerial::readBytes read failed: %s\n", strerror(errno));
+	return 0;
+    }
+    return result;
+}
+
 bool HardwareSerial::openDevice()
 {
     if (_device == -1)
@@ -74,6 +74,20 @@ public:
     /// \return 1 if successful else 0
     size_t write(uint8_t ch);
 
+    /// Transmit a block of characters on the serial port.
+    /// IO errors are repored by printing a message to stderr.
+    /// \param[in] buf The characters to send
+    /// \param[in] len Number of characters in buf
+    /// \return The number of characters written
+    size_t write(const uint8_t* buf, size_t len);
+
+    /// Read up to len characters. Unlike Arduino Stream::readBytes() this
+    /// does not wait for more: ask for no more than available() to get them all.
+    /// \param[in] buf Where to put the characters
+    /// \param[in] len Size of buf
+    /// \return The number of characters read
+    size_t readBytes(char* buf, size_t len);
+
     // These are not usually in HardwareSerial but we 
     // need them in a Unix environment
 
@@ -973,6 +973,24 @@
  #define YIELD
 #endif
 
+////////////////////////////////////////////////////
+// Recent ESP8266 and ESP32 cores refuse attachInterrupt() for a handler that
+// is not in IRAM, so the isr*() glue functions of the drivers are placed there
+#if (RH_PLATFORM == RH_PLATFORM_ESP8266) || (RH_PLATFORM == RH_PLATFORM_ESP32)
+ #define RH_INTERRUPT_ATTR IRAM_ATTR
+#else
+ #define RH_INTERRUPT_ATTR
+#endif
+
+////////////////////////////////////////////////////
+// Managers share some static scratch buffers to save SRAM. On Unix each thread
+// gets its own, so one simulator process can run many nodes in threads
+#if (RH_PLATFORM == RH_PLATFORM_UNIX)
+ #define RH_THREAD_LOCAL thread_local
+#else
+ #define RH_THREAD_LOCAL
+#endif
+
 ////////////////////////////////////////////////////
 // digitalPinToInterrupt is not available prior to Arduino 1.5.6 and 1.0.6
 // See http://arduino.cc/en/Reference/attachInterrupt
@@ -0,0 +1,325 @@
+// rh_benchmark.pde
+// -*- mode: C++ -*-
+// Benchmark of a RadioHead driver between two nodes, one built with
+// BENCH_MASTER 1 and the other with BENCH_MASTER 0. It speaks the same
+// little protocol as the Benchmark example of the RFM69 library and prints
+// the same lines, so the two stacks can be compared on the same modules.
+//
+// For every modem config in the table the master measures
+//   rtt_*_us   ping-pong round trip of a BENCH_PAYLOAD byte message
+//   ping_lost  pings without an answer
+//   tx_pps     messages/s the master can send back to back
+//   rx_pps     of those, messages/s the other node got
+//   rx_Bps     payload bytes/s the other node got
+//   cpu_us     CPU time the receiving node spends per message, interrupt
+//              included: how much a busy loop there slows down during the flood
+// and prints them on Serial as CSV, one metric per line:
+//   stack,driver,config,payload,metric,value
+// The first config in the table is also the control channel both nodes go
+// back to between tests.
+// Tested with RFM69HW (RH_RF69) and RFM95 (RH_RF95)
+
+#include <SPI.h>
+
+#define BENCH_MASTER    1
+#define BENCH_RF95      0       // 0 for RH_RF69
+#define BENCH_FREQUENCY 434.0
+#define BENCH_PAYLOAD   32
+#define BENCH_PINGS     50
+#define BENCH_FLOOD_MS  3000
+#define BENCH_FLOOD_MIN 5       // slow LoRa configs flood longer than BENCH_FLOOD_MS
+#define BENCH_REPLY_MS  5000    // longer than a round trip in the slowest config
+#define BENCH_IDLE_MS   15000   // the other node goes back to the control channel
+
+#if BENCH_RF95
+#include <RH_RF95.h>
+RH_RF95 driver;
+#define BENCH_DRIVER  "RH_RF95"
+#define BENCH_MAX_LEN RH_RF95_MAX_MESSAGE_LEN
+#define CONFIG(c) { #c, RH_RF95::c }
+struct { const char* name; RH_RF95::ModemConfigChoice config; } configs[] =
+{
+  CONFIG(Bw125Cr45Sf128),
+  CONFIG(Bw500Cr45Sf128),
+  CONFIG(Bw31_25Cr48Sf512),
+  CONFIG(Bw125Cr48Sf4096),
+};
+#else
+#include <RH_RF69.h>
+RH_RF69 driver;
+//RH_RF69 driver(4, 2); // For MoteinoMEGA https://lowpowerlab.com/shop/moteinomega
+#define BENCH_DRIVER  "RH_RF69"
+#define BENCH_MAX_LEN RH_RF69_MAX_MESSAGE_LEN
+#define CONFIG(c) { #c, RH_RF69::c }
+struct { const char* name; RH_RF69::ModemConfigChoice config; } configs[] =
+{
+  CONFIG(GFSK_Rb250Fd250),
+  CONFIG(GFSK_Rb55555Fd50),
+  CONFIG(FSK_Rb55555Fd50),
+  CONFIG(GFSK_Rb125Fd125),
+  CONFIG(GFSK_Rb19_2Fd38_4),
+  CONFIG(GFSK_Rb4_8Fd9_6),
+};
+#endif
+#define NUM_CONFIGS (sizeof(configs) / sizeof(configs[0]))
+
+#if BENCH_PAYLOAD > BENCH_MAX_LEN
+#error BENCH_PAYLOAD is more than the driver takes
+#endif
+
+uint8_t buf[BENCH_MAX_LEN];
+uint8_t len;
+uint8_t current;
+
+void setConfig(uint8_t i)
+{
+  current = i;
+  driver.setModemConfig(configs[i].config);
+}
+
+// Transmits and waits till it's out
+void sendPacket(const uint8_t* data, uint8_t length)
+{
+  driver.send((uint8_t*)data, length);
+  driver.waitPacketSent();
+}
+
+// A message that starts with first, or false after timeout ms
+bool receiveReply(uint8_t first, unsigned long timeout)
+{
+  unsigned long start = millis();
+  while (millis() - start < timeout)
+  {
+    len = sizeof(buf);
+    if (driver.available() && driver.recv(buf, &len) && len > 0 && buf[0] == first)
+      return true;
+  }
+  return false;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  while (!Serial)
+    ;
+  if (!driver.init())
+    Serial.println("# init failed");
+  driver.setFrequency(BENCH_FREQUENCY);
+  // If you are using a high power RF69 eg RFM69HW, you *must* set a Tx power with the
+  // ishighpowermodule flag set like this:
+  //driver.setTxPower(14, true);
+  setConfig(0);
+#if BENCH_MASTER
+  Serial.println("stack,driver,config,payload,metric,value");
+#else
+  calibrate();
+#endif
+}
+
+void result(const char* metric, float value)
+{
+  Serial.print("RadioHead," BENCH_DRIVER ",");
+  Serial.print(configs[current].name);
+  Serial.print(',');
+  Serial.print(BENCH_PAYLOAD);
+  Serial.print(',');
+  Serial.print(metric);
+  Serial.print(',');
+  Serial.println(value);
+}
+
+#if BENCH_MASTER
+////////////////////////////////////////////////////////////////////
+// The node that runs the tests
+
+// Asks the other node, on the control channel, to move to config i
+bool startConfig(uint8_t i)
+{
+  unsigned long start = millis();
+  while (millis() - start < BENCH_IDLE_MS + BENCH_REPLY_MS)
+  {
+    uint8_t command[2] = { 'C', i };
+    sendPacket(command, sizeof(command));
+    if (receiveReply('c', 500) && len == 2 && buf[1] == i)
+    {
+      setConfig(i);
+      delay(20); // the other node is still switching
+      return true;
+    }
+  }
+  return false;
+}
+
+void endConfig()
+{
+  uint8_t command = 'D';
+  sendPacket(&command, 1);
+  sendPacket(&command, 1);
+  setConfig(0);
+  delay(50);
+}
+
+void pingPong()
+{
+  unsigned long lowest = 0xffffffff, highest = 0, total = 0;
+  uint16_t answered = 0;
+  uint8_t ping[BENCH_PAYLOAD];
+
+  memset(ping, 0x55, sizeof(ping));
+  ping[0] = 'P';
+  for (uint16_t seq = 0; seq < BENCH_PINGS; seq++)
+  {
+    ping[1] = seq;
+    ping[2] = seq >> 8;
+    unsigned long start = micros();
+    sendPacket(ping, sizeof(ping));
+    if (receiveReply('p', BENCH_REPLY_MS) && len == sizeof(ping) && buf[1] == ping[1] && buf[2] == ping[2])
+    {
+      unsigned long rtt = micros() - start;
+      total += rtt;
+      answered++;
+      if (rtt < lowest) lowest = rtt;
+      if (rtt > highest) highest = rtt;
+    }
+  }
+  if (answered)
+  {
+    result("rtt_min_us", lowest);
+    result("rtt_avg_us", (float)total / answered);
+    result("rtt_max_us", highest);
+  }
+  result("ping_lost", BENCH_PINGS - answered);
+}
+
+void flood()
+{
+  uint8_t packet[BENCH_PAYLOAD];
+  uint16_t sent = 0;
+
+  memset(packet, 0xaa, sizeof(packet));
+  packet[0] = 'F';
+  unsigned long start = millis();
+  while (millis() - start < BENCH_FLOOD_MS || sent < BENCH_FLOOD_MIN)
+  {
+    packet[1] = sent;
+    packet[2] = sent >> 8;
+    sendPacket(packet, sizeof(packet));
+    sent++;
+  }
+  unsigned long elapsed = millis() - start;
+  result("tx_pps", sent * 1000.0 / elapsed);
+
+  for (uint8_t tries = 0; tries < 5; tries++)
+  {
+    uint8_t command = 'R';
+    sendPacket(&command, 1);
+    if (receiveReply('r', BENCH_REPLY_MS) && len == 5)
+    {
+      uint16_t received = buf[1] | (uint16_t)buf[2] << 8;
+      uint16_t cpu = buf[3] | (uint16_t)buf[4] << 8;
+      result("rx_pps", received * 1000.0 / elapsed);
+      result("rx_Bps", (float)received * BENCH_PAYLOAD * 1000.0 / elapsed);
+      result("cpu_us", cpu);
+      return;
+    }
+  }
+}
+
+void loop()
+{
+  static bool done = false;
+  if (done)
+    return;
+  for (uint8_t i = 0; i < NUM_CONFIGS; i++)
+  {
+    if (!startConfig(i))
+    {
+      Serial.print("# no answer for ");
+      Serial.println(configs[i].name);
+      continue;
+    }
+    pingPong();
+    flood();
+    endConfig();
+  }
+  Serial.println("# done");
+  done = true;
+}
+
+#else
+////////////////////////////////////////////////////////////////////
+// The node that answers
+
+volatile uint8_t sink;
+unsigned long spins;            // busy loop iterations
+float spinsPerUs;               // with nothing on the air
+uint16_t floodCount;
+unsigned long floodFirst, floodLast, spinsFirst, spinsLast;
+unsigned long lastHeard;
+
+void spin()
+{
+  for (uint8_t i = 0; i < 16; i++)
+    sink++;
+  spins++;
+}
+
+// Busy loop rate with the driver polled but idle
+void calibrate()
+{
+  unsigned long start = micros();
+  spins = 0;
+  while (micros() - start < 1000000)
+  {
+    driver.available();
+    spin();
+  }
+  spinsPerUs = spins / 1000000.0;
+}
+
+void loop()
+{
+  spin();
+  len = sizeof(buf);
+  if (!(driver.available() && driver.recv(buf, &len) && len > 0))
+  {
+    if (current != 0 && millis() - lastHeard > BENCH_IDLE_MS)
+      setConfig(0);
+    return;
+  }
+  lastHeard = millis();
+
+  if (current == 0 && buf[0] == 'C' && len == 2 && buf[1] < NUM_CONFIGS)
+  {
+    buf[0] = 'c';
+    sendPacket(buf, 2);
+    setConfig(buf[1]);
+    floodCount = 0;
+  }
+  else if (buf[0] == 'P')
+  {
+    buf[0] = 'p';
+    sendPacket(buf, len);
+  }
+  else if (buf[0] == 'F')
+  {
+    if (floodCount++ == 0)
+    {
+      floodFirst = micros();
+      spinsFirst = spins;
+    }
+    floodLast = micros();
+    spinsLast = spins;
+  }
+  else if (buf[0] == 'R')
+  {
+    // time the loop didn't get between the first and the last flood message
+    float lostUs = (floodLast - floodFirst) - (spinsLast - spinsFirst) / spinsPerUs;
+    uint16_t cpu = floodCount > 1 && lostUs > 0 ? lostUs / (floodCount - 1) : 0;
+    uint8_t report[5] = { 'r', (uint8_t)floodCount, (uint8_t)(floodCount >> 8), (uint8_t)cpu, (uint8_t)(cpu >> 8) };
+    sendPacket(report, sizeof(report));
+  }
+  else if (buf[0] == 'D' && current != 0)
+    setConfig(0);
+}
+#endif
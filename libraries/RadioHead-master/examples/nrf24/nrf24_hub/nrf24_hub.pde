@@ -0,0 +1,60 @@
+// nrf24_hub.pde
+// -*- mode: C++ -*-
+// Example sketch showing how to receive from up to 6 probes on different pipes
+// with the RH_NRF24 class and the chip's own acknowledgements (Enhanced ShockBurst auto-ack).
+// Each probe gets a hardware ack within a few hundred microseconds, carrying a short
+// reply queued with setAckPayload(): no software acks, no turn around of the radios.
+// It is designed to work with the other example nrf24_probe
+
+#include <SPI.h>
+#include <RH_NRF24.h>
+
+// Singleton instance of the radio driver
+RH_NRF24 nrf24;
+
+// Pipe 0 and pipe 1 addresses. Pipes 2 to 5 share the upper octets of pipe 1
+uint8_t pipe0[] = { 0xe7, 0xe7, 0xe7, 0xe7, 0xe7 };
+uint8_t pipe1[] = { 0xc1, 0xc2, 0xc2, 0xc2, 0xc2 };
+uint8_t lsb[]   = { 0xc3, 0xc4, 0xc5, 0xc6 };
+
+uint8_t reply[] = "ok";
+// Dont put this on the stack:
+uint8_t buf[RH_NRF24_MAX_MESSAGE_LEN];
+
+void setup() 
+{
+  Serial.begin(9600);
+  while (!Serial) 
+    ; // wait for serial port to connect. Needed for Leonardo only
+  if (!nrf24.init())
+    Serial.println("init failed");
+  if (!nrf24.setEnhancedShockBurst(true, 5, 750))
+    Serial.println("setEnhancedShockBurst failed");
+  // The probes send to node 1
+  nrf24.setThisAddress(1);
+  nrf24.setNetworkAddress(pipe0, sizeof(pipe0));
+  nrf24.setPipeAddress(1, pipe1, sizeof(pipe1));
+  for (uint8_t pipe = 2; pipe <= 5; pipe++)
+    nrf24.setPipeAddress(pipe, &lsb[pipe - 2], 1);
+  // A reply ready for the first packet of each pipe (the chip holds 3)
+  for (uint8_t pipe = 0; pipe < 3; pipe++)
+    nrf24.setAckPayload(pipe, reply, sizeof(reply));
+}
+
+void loop()
+{
+  if (nrf24.available())
+  {
+    uint8_t len = sizeof(buf);
+    if (nrf24.recv(buf, &len))
+    {
+      uint8_t pipe = nrf24.lastPipe();
+      Serial.print("probe on pipe ");
+      Serial.print(pipe);
+      Serial.print(": ");
+      Serial.println((char*)buf);
+      // Replaces the reply just sent with the ack
+      nrf24.setAckPayload(pipe, reply, sizeof(reply));
+    }
+  }
+}
@@ -0,0 +1,58 @@
+// nrf24_probe.pde
+// -*- mode: C++ -*-
+// Example sketch showing how to send to a hub with the RH_NRF24 class and the chip's own
+// acknowledgements and retransmissions (Enhanced ShockBurst auto-ack).
+// Give each probe its own pipe address from the hub.
+// It is designed to work with the other example nrf24_hub
+
+#include <SPI.h>
+#include <RH_NRF24.h>
+
+// Singleton instance of the radio driver
+RH_NRF24 nrf24;
+
+// The hub's pipe 1. For pipe 2 use { 0xc3, 0xc2, 0xc2, 0xc2, 0xc2 } and so on
+uint8_t address[] = { 0xc1, 0xc2, 0xc2, 0xc2, 0xc2 };
+
+uint8_t data[] = "Hello World!";
+// Dont put this on the stack:
+uint8_t buf[RH_NRF24_MAX_MESSAGE_LEN];
+
+void setup() 
+{
+  Serial.begin(9600);
+  while (!Serial) 
+    ; // wait for serial port to connect. Needed for Leonardo only
+  if (!nrf24.init())
+    Serial.println("init failed");
+  if (!nrf24.setEnhancedShockBurst(true, 5, 750))
+    Serial.println("setEnhancedShockBurst failed");
+  // TX address and pipe 0, where the acks come back
+  nrf24.setNetworkAddress(address, sizeof(address));
+  // Not a broadcast, else it goes without an ack request
+  nrf24.setHeaderTo(1);
+}
+
+void loop()
+{
+  nrf24.send(data, sizeof(data));
+  if (nrf24.waitPacketSent())
+  {
+    Serial.print("acked after ");
+    Serial.print(nrf24.lastRetransmissions());
+    Serial.println(" retransmissions");
+    // The hub's reply came with the ack
+    uint8_t len = sizeof(buf);
+    if (nrf24.recv(buf, &len))
+    {
+      Serial.print("reply: ");
+      Serial.println((char*)buf);
+    }
+  }
+  else
+  {
+    Serial.print("lost, total ");
+    Serial.println(nrf24.txLost());
+  }
+  delay(400);
+}
@@ -0,0 +1,196 @@
+// simulator_mesh_scale.pde
+// -*- mode: C++ -*-
+// Load test of RHMesh routing with many nodes in one simulator process.
+// Each node has its own RH_TCP connection to the ether simulator and runs in
+// its own thread. Every node sends a message to a random other node now and
+// then and counts what it receives, and the totals are printed as it goes.
+// Tested on Linux
+//
+// Nodes 1 to n sit on a grid w nodes wide, each in range of the 4 next to
+// it. -T prints that topology as a config file for the ether simulator.
+// Build with
+// cd whatever/RadioHead
+// tools/simBuild examples/simulator/simulator_mesh_scale/simulator_mesh_scale.pde
+// g++ -O2 -I . -o etherSimulator tools/etherSimulator.cpp
+// Run with
+// ./simulator_mesh_scale -n 200 -w 20 -T > grid.conf
+// ./etherSimulator -c grid.conf -b 100000 &
+// ./simulator_mesh_scale -n 200 -w 20 -t 60
+//
+// Options:
+//  -n nodes      number of nodes, up to 254 (default 100)
+//  -w width      grid width (default 10)
+//  -t seconds    how long to run (default 30)
+//  -i ms         mean time between sends from each node (default 5000)
+//  -l prob       probability of delivery over each link, for -T (default 1.0)
+//  -s server     ether simulator, name[:port] (default localhost:4000)
+//  -T            print the topology and exit
+
+#include <RHMesh.h>
+#include <RH_TCP.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <atomic>
+
+static int           nodes = 100;
+static int           width = 10;
+static unsigned long seconds = 30;
+static unsigned long interval = 5000;
+static double        linkProbability = 1.0;
+static const char*   server = "localhost:4000";
+
+static volatile bool stopping = false;
+
+// Totals over all nodes
+static std::atomic<unsigned long> initFailed(0);
+static std::atomic<unsigned long> sent(0);
+static std::atomic<unsigned long> sentOk(0);        // Next hop acknowledged
+static std::atomic<unsigned long> noRoute(0);
+static std::atomic<unsigned long> undeliverable(0);
+static std::atomic<unsigned long> received(0);      // At the final destination
+static std::atomic<unsigned long> latencySum(0);    // ms, of the received ones
+
+// What every node sends
+typedef struct
+{
+    unsigned long sentAt;
+    uint8_t       from;
+} Probe;
+
+static void printTopology()
+{
+    printf("# simulator_mesh_scale grid, %d nodes %d wide\n", nodes, width);
+    printf("default:0.0\n");
+    for (int a = 1; a <= nodes; a++)
+    {
+	if ((a - 1) % width != width - 1 && a + 1 <= nodes)
+	    printf("probability:%d:%d:%g\n", a, a + 1, linkProbability);
+	if (a + width <= nodes)
+	    printf("probability:%d:%d:%g\n", a, a + width, linkProbability);
+    }
+}
+
+static void* runNode(void* arg)
+{
+    uint8_t address = (uint8_t)(intptr_t)arg;
+    RH_TCP driver(server);
+    RHMesh manager(driver, address);
+    if (!manager.init())
+    {
+	initFailed++;
+	return NULL;
+    }
+
+    uint8_t buf[RH_MESH_MAX_MESSAGE_LEN];
+    unsigned long nextSend = millis() + random(interval * 2);
+    while (!stopping)
+    {
+	if ((long)(millis() - nextSend) >= 0)
+	{
+	    uint8_t dest = 1 + random(nodes - 1);
+	    if (dest >= address)
+		dest++;
+	    Probe probe;
+	    probe.sentAt = millis();
+	    probe.from = address;
+	    sent++;
+	    switch (manager.sendtoWait((uint8_t*)&probe, sizeof(probe), dest))
+	    {
+		case RH_ROUTER_ERROR_NONE:              sentOk++; break;
+		case RH_ROUTER_ERROR_NO_ROUTE:          noRoute++; break;
+		case RH_ROUTER_ERROR_UNABLE_TO_DELIVER: undeliverable++; break;
+	    }
+	    nextSend = millis() + random(interval * 2);
+	}
+
+	uint8_t len = sizeof(buf);
+	if (manager.recvfromAckTimeout(buf, &len, 50) && len == sizeof(Probe))
+	{
+	    Probe probe;
+	    memcpy(&probe, buf, sizeof(probe));
+	    received++;
+	    latencySum += millis() - probe.sentAt;
+	}
+    }
+    return NULL;
+}
+
+static void report(const char* what)
+{
+    unsigned long r = received;
+    printf("%s t=%lus sent=%lu hop_ok=%lu no_route=%lu undeliverable=%lu received=%lu latency_ms=%lu\n",
+	   what, millis() / 1000, (unsigned long)sent, (unsigned long)sentOk, (unsigned long)noRoute,
+	   (unsigned long)undeliverable, r, r ? (unsigned long)latencySum / r : 0);
+    fflush(stdout);
+}
+
+void setup()
+{
+    bool topology = false;
+    int opt;
+    while ((opt = getopt(_simulator_argc, _simulator_argv, "n:w:t:i:l:s:T")) != -1)
+    {
+	switch (opt)
+	{
+	    case 'n': nodes = atoi(optarg); break;
+	    case 'w': width = atoi(optarg); break;
+	    case 't': seconds = atol(optarg); break;
+	    case 'i': interval = atol(optarg); break;
+	    case 'l': linkProbability = atof(optarg); break;
+	    case 's': server = optarg; break;
+	    case 'T': topology = true; break;
+	    default:
+		fprintf(stderr, "usage: %s [-n nodes] [-w width] [-t seconds] [-i ms] [-l prob] [-s server] [-T]\n", _simulator_argv[0]);
+		exit(1);
+	}
+    }
+    if (nodes < 2 || nodes > 254 || width < 1 || interval < 1)
+    {
+	fprintf(stderr, "%s: need 2 to 254 nodes, a width and an interval\n", _simulator_argv[0]);
+	exit(1);
+    }
+    if (topology)
+    {
+	printTopology();
+	exit(0);
+    }
+
+    // Nodes keep their buffers in thread local storage, not on the stack
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, 256 * 1024);
+    for (int a = 1; a <= nodes; a++)
+    {
+	pthread_t thread;
+	if (pthread_create(&thread, &attr, runNode, (void*)(intptr_t)a) != 0)
+	{
+	    fprintf(stderr, "%s: could not start node %d\n", _simulator_argv[0], a);
+	    exit(1);
+	}
+	pthread_detach(thread);
+    }
+    pthread_attr_destroy(&attr);
+}
+
+void loop()
+{
+    static unsigned long lastReport = 0;
+
+    delay(1000);
+    if (initFailed)
+    {
+	fprintf(stderr, "%lu nodes failed to init, is the ether simulator running?\n", (unsigned long)initFailed);
+	exit(1);
+    }
+    if (millis() - lastReport >= 5000)
+    {
+	lastReport = millis();
+	report("progress");
+    }
+    if (millis() >= seconds * 1000)
+    {
+	stopping = true;
+	report("total");
+	exit(0);
+    }
+}
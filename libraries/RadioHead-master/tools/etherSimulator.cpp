@@ -0,0 +1,466 @@
+// etherSimulator.cpp
+//
+// Simulates the luminiferous ether for RH_TCP, like etherSimulator.pl, but
+// as a single threaded non-blocking server that copes with hundreds of
+// connected nodes. Uses epoll on Linux and poll elsewhere.
+// Speaks the protocol in RHTcpProtocol.h and reads the same config file
+// format as etherSimulator.pl, plus an optional default probability.
+//
+// Build and run with:
+//  g++ -O2 -I . -o etherSimulator tools/etherSimulator.cpp
+//  ./etherSimulator [-h] [-c configfile] [-b bitspersec] [-p portnumber] [-d probability] [-s seed]
+// -s seeds the random losses, so a run can be repeated
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <map>
+#include <string>
+#include <vector>
+#ifdef __linux__
+ #include <sys/epoll.h>
+#else
+ #include <poll.h>
+#endif
+
+#include <RHTcpProtocol.h>
+
+// Configurable variables
+static int      port = 4000;
+static double   bps = 10000;
+static double   defaultProbability = 1.0;
+
+// Probability of successful transmission between nodes, from the config file
+// Key is (from << 8) | to
+static std::map<uint16_t, double> netconfig;
+
+// One connected RH_TCP sketch
+struct Client
+{
+    int         fd;
+    int         thisAddress;   // -1 until the client tells us
+    std::string in;            // Partial messages from the client
+    std::string out;           // Not yet accepted by the socket
+    std::string packet;        // Waiting for its transmission time to elapse
+    bool        havePacket;
+    double      deliverAt;     // When the packet has been on air long enough
+};
+
+static std::map<int, Client> clients;
+
+#ifdef __linux__
+static int epfd;
+#endif
+
+// Statistics printed on exit
+static unsigned long packetsIn, deliveries, collisions, lost;
+
+static double now()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void usage(const char* name)
+{
+    fprintf(stderr, "usage: %s [-h] [-c configfile] [-b bitspersec] [-p portnumber] [-d probability] [-s seed]\n", name);
+    exit(1);
+}
+
+// config file for etherSimulator
+// Specify the probability of correct delivery between nodea and nodeb (bidirectional)
+// probability:nodea:nodeb:probability
+// nodea and nodeb are integers 0 to 255
+// probability is a float range 0.0 to 1.0
+// Pairs that are not listed use the default, 1.0 unless changed with -d or
+// a line like this, so sparse topologies only need to list their links
+// default:0.0
+static void readConfig(const char* config)
+{
+    FILE* f = fopen(config, "r");
+    if (!f)
+    {
+	fprintf(stderr, "Could not open config file %s: %s\n", config, strerror(errno));
+	exit(1);
+    }
+    char line[200];
+    while (fgets(line, sizeof(line), f))
+    {
+	unsigned a, b;
+	double p;
+	if (sscanf(line, "probability:%u:%u:%lf", &a, &b, &p) == 3 && a < 256 && b < 256)
+	{
+	    netconfig[(a << 8) | b] = p;
+	    netconfig[(b << 8) | a] = p; // Bidirectional
+	}
+	else if (sscanf(line, "default:%lf", &p) == 1)
+	    defaultProbability = p;
+    }
+    fclose(f);
+}
+
+// Look up the source and dest nodes in the netconfig and return the 0.0 to 1.0 probability
+// of successful delivery
+static double probabilityOfSuccessfulDelivery(int from, int to)
+{
+    if (from >= 0 && to >= 0)
+    {
+	std::map<uint16_t, double>::iterator it = netconfig.find((from << 8) | to);
+	if (it != netconfig.end())
+	    return it->second;
+    }
+    return defaultProbability;
+}
+
+static void watch(Client& c)
+{
+#ifdef __linux__
+    struct epoll_event ev;
+    ev.events = EPOLLIN | (c.out.empty() ? 0 : EPOLLOUT);
+    ev.data.fd = c.fd;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, c.fd, &ev);
+#else
+    (void)c; // poll() set is rebuilt on every pass
+#endif
+}
+
+static void dropClient(int fd)
+{
+#ifdef __linux__
+    epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+#endif
+    close(fd);
+    clients.erase(fd);
+}
+
+// Returns false if the client has gone away
+static bool flushClient(Client& c)
+{
+    bool wasPending = !c.out.empty();
+    while (!c.out.empty())
+    {
+	ssize_t n = write(c.fd, c.out.data(), c.out.size());
+	if (n < 0)
+	{
+	    if (errno == EAGAIN || errno == EWOULDBLOCK)
+		break;
+	    return false;
+	}
+	c.out.erase(0, n);
+    }
+    if (wasPending != !c.out.empty())
+	watch(c);
+    return true;
+}
+
+static void queueMessage(Client& c, uint8_t type, const std::string& payload)
+{
+    uint32_t length = htonl(payload.size() + 1);
+    c.out.append((const char*)&length, sizeof(length));
+    c.out.append(1, (char)type);
+    c.out.append(payload);
+}
+
+// New packet for transmission. Try to deliver it to all the other clients
+static void transmit(Client& sender, const std::string& packet)
+{
+    packetsIn++;
+    for (std::map<int, Client>::iterator it = clients.begin(); it != clients.end(); ++it)
+    {
+	Client& c = it->second;
+	if (c.fd == sender.fd)
+	    continue; // Dont deliver back to the same client
+
+	// Check the network config and see if delivery to this node is possible.
+	// Nodes out of range dont count as losses
+	double prob = probabilityOfSuccessfulDelivery(sender.thisAddress, c.thisAddress);
+	if (prob <= 0)
+	    continue;
+	if (drand48() >= prob)
+	{
+	    lost++;
+	    continue;
+	}
+
+	// The packet reached this destination, see if it collided with
+	// another packet
+	if (c.havePacket)
+	{
+	    // Collision with waiting packet, delete it
+	    c.havePacket = false;
+	    collisions++;
+	}
+	else
+	{
+	    // New packet, queue it for delivery to the client after the
+	    // nominal transmission time is complete
+	    c.packet = packet;
+	    c.havePacket = true;
+	    c.deliverAt = now() + packet.size() * 8 / bps;
+	}
+    }
+}
+
+// Returns false if the client sent something we cant make sense of
+static bool handleInput(Client& c)
+{
+    while (c.in.size() >= 4)
+    {
+	uint32_t length;
+	memcpy(&length, c.in.data(), sizeof(length));
+	length = ntohl(length);
+	if (length < 1 || length > sizeof(RHTcpMessage) - 4)
+	{
+	    fprintf(stderr, "etherSimulator: ridiculous length %u from client, dropping it\n", length);
+	    return false;
+	}
+	if (c.in.size() < length + 4)
+	    break;
+
+	uint8_t type = c.in[4];
+	if (type == RH_TCP_MESSAGE_TYPE_THISADDRESS && length >= 2)
+	    c.thisAddress = (uint8_t)c.in[5]; // Client notifies us of its node ID
+	else if (type == RH_TCP_MESSAGE_TYPE_PACKET)
+	    transmit(c, c.in.substr(5, length - 1));
+	c.in.erase(0, length + 4);
+    }
+    return true;
+}
+
+static void readClient(int fd)
+{
+    std::map<int, Client>::iterator it = clients.find(fd);
+    if (it == clients.end())
+	return;
+    Client& c = it->second;
+    char buf[4096];
+    while (1)
+    {
+	ssize_t n = read(fd, buf, sizeof(buf));
+	if (n > 0)
+	{
+	    c.in.append(buf, n);
+	    continue;
+	}
+	if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+	    break;
+	dropClient(fd); // EOF or error
+	return;
+    }
+    if (!handleInput(c))
+	dropClient(fd);
+}
+
+static void acceptClients(int listener)
+{
+    while (1)
+    {
+	int fd = accept(listener, NULL, NULL);
+	if (fd < 0)
+	    return;
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+	int on = 1;
+	setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+	Client& c = clients[fd];
+	c.fd = fd;
+	c.thisAddress = -1;
+	c.havePacket = false;
+#ifdef __linux__
+	struct epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.fd = fd;
+	epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+#endif
+    }
+}
+
+// Delivers the packets whose time on air is over. Returns the milliseconds
+// until the next one is due, or -1 if none is waiting
+static int deliverMessages()
+{
+    double t = now();
+    double next = -1;
+    std::vector<int> gone;
+    for (std::map<int, Client>::iterator it = clients.begin(); it != clients.end(); ++it)
+    {
+	Client& c = it->second;
+	if (!c.havePacket)
+	    continue;
+	if (c.deliverAt <= t)
+	{
+	    queueMessage(c, RH_TCP_MESSAGE_TYPE_PACKET, c.packet);
+	    c.havePacket = false;
+	    deliveries++;
+	    if (!flushClient(c))
+		gone.push_back(c.fd);
+	}
+	else if (next < 0 || c.deliverAt < next)
+	    next = c.deliverAt;
+    }
+    for (size_t i = 0; i < gone.size(); i++)
+	dropClient(gone[i]);
+    return next < 0 ? -1 : (int)((next - t) * 1000) + 1;
+}
+
+static volatile bool stopping = false;
+
+static void onSignal(int)
+{
+    stopping = true;
+}
+
+int main(int argc, char** argv)
+{
+    int opt;
+    long seed = getpid();
+    while ((opt = getopt(argc, argv, "hc:b:p:d:s:")) != -1)
+    {
+	switch (opt)
+	{
+	    case 'c': readConfig(optarg); break;
+	    case 'b': bps = atof(optarg); break;
+	    case 'p': port = atoi(optarg); break;
+	    case 'd': defaultProbability = atof(optarg); break;
+	    case 's': seed = atol(optarg); break;
+	    default:  usage(argv[0]);
+	}
+    }
+    if (bps <= 0)
+	usage(argv[0]);
+    srand48(seed);
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    int listener = socket(AF_INET6, SOCK_STREAM, 0);
+    int family = AF_INET6;
+    if (listener < 0)
+    {
+	listener = socket(AF_INET, SOCK_STREAM, 0);
+	family = AF_INET;
+    }
+    int on = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    int rc;
+    if (family == AF_INET6)
+    {
+	int off = 0;
+	setsockopt(listener, IPPROTO_IPV6, IPV6_V6ONLY, &off, sizeof(off)); // IPv4 too
+	struct sockaddr_in6 addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin6_family = AF_INET6;
+	addr.sin6_addr = in6addr_any;
+	addr.sin6_port = htons(port);
+	rc = bind(listener, (struct sockaddr*)&addr, sizeof(addr));
+    }
+    else
+    {
+	struct sockaddr_in addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(port);
+	rc = bind(listener, (struct sockaddr*)&addr, sizeof(addr));
+    }
+    if (rc < 0 || listen(listener, 1024) < 0)
+    {
+	fprintf(stderr, "etherSimulator: cant listen on port %d: %s\n", port, strerror(errno));
+	return 1;
+    }
+    fcntl(listener, F_SETFL, fcntl(listener, F_GETFL) | O_NONBLOCK);
+
+#ifdef __linux__
+    epfd = epoll_create1(0);
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = listener;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listener, &ev);
+    std::vector<struct epoll_event> events(256);
+#else
+    std::vector<struct pollfd> fds;
+#endif
+
+    while (!stopping)
+    {
+	int timeout = deliverMessages();
+#ifdef __linux__
+	int n = epoll_wait(epfd, &events[0], events.size(), timeout);
+	for (int i = 0; i < n; i++)
+	{
+	    int fd = events[i].data.fd;
+	    if (fd == listener)
+	    {
+		acceptClients(listener);
+		continue;
+	    }
+	    if (events[i].events & EPOLLOUT)
+	    {
+		std::map<int, Client>::iterator it = clients.find(fd);
+		if (it != clients.end() && !flushClient(it->second))
+		{
+		    dropClient(fd);
+		    continue;
+		}
+	    }
+	    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR))
+		readClient(fd);
+	}
+#else
+	fds.clear();
+	struct pollfd p;
+	p.fd = listener;
+	p.events = POLLIN;
+	fds.push_back(p);
+	for (std::map<int, Client>::iterator it = clients.begin(); it != clients.end(); ++it)
+	{
+	    p.fd = it->first;
+	    p.events = POLLIN | (it->second.out.empty() ? 0 : POLLOUT);
+	    fds.push_back(p);
+	}
+	int n = poll(&fds[0], fds.size(), timeout);
+	for (size_t i = 0; n > 0 && i < fds.size(); i++)
+	{
+	    if (!fds[i].revents)
+		continue;
+	    int fd = fds[i].fd;
+	    if (fd == listener)
+	    {
+		acceptClients(listener);
+		continue;
+	    }
+	    if (fds[i].revents & POLLOUT)
+	    {
+		std::map<int, Client>::iterator it = clients.find(fd);
+		if (it != clients.end() && !flushClient(it->second))
+		{
+		    dropClient(fd);
+		    continue;
+		}
+	    }
+	    if (fds[i].revents & (POLLIN | POLLHUP | POLLERR))
+		readClient(fd);
+	}
+#endif
+	if (n < 0 && errno != EINTR)
+	{
+	    fprintf(stderr, "etherSimulator: wait failed: %s\n", strerror(errno));
+	    return 1;
+	}
+    }
+
+    fprintf(stderr, "etherSimulator: %lu packets, %lu deliveries, %lu collisions, %lu lost in the ether\n",
+	    packetsIn, deliveries, collisions, lost);
+    return 0;
+}
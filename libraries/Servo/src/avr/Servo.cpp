@@ -32,8 +32,37 @@
 
 //#define NBR_TIMERS        (MAX_SERVOS / SERVOS_PER_TIMER)
 
+#define MERGE_TICKS         usToTicks(8)                    // end edges closer than this are taken in the same interrupt
+
 static servo_t servos[MAX_SERVOS];                          // static array of servo structures
-static volatile int8_t Channel[_Nbr_16timers ];             // counter for the servo being pulsed for each timer (or -1 if refresh interval)
+
+// Each frame raises every active pin of a timer at once and then lowers them
+// in order of pulse width, so the interrupt only runs at the frame start and
+// at each distinct end time. The schedule is built outside the interrupt and
+// double buffered: the ISR picks up a new one only at a frame start.
+typedef struct {
+  volatile uint8_t *out;                                    // PORTx register
+  uint8_t mask;                                             // pins of this port written together
+} servo_port_t;
+
+typedef struct {
+  uint16_t ticks;                                           // end time from the frame start
+  uint8_t last;                                             // one past the last entry of ends[] lowered here
+} servo_event_t;
+
+typedef struct {
+  uint8_t nStarts;
+  uint8_t nEvents;
+  servo_port_t starts[SERVOS_PER_TIMER];
+  servo_port_t ends[SERVOS_PER_TIMER];
+  servo_event_t events[SERVOS_PER_TIMER];
+} servo_frame_t;
+
+static servo_frame_t Frames[_Nbr_16timers][2];
+static uint8_t Active[_Nbr_16timers];                       // frame buffer the ISR reads
+static volatile bool Pending[_Nbr_16timers];                // the other buffer holds a newer schedule
+static volatile int8_t Event[_Nbr_16timers];               // next end event for each timer (or -1 if refresh interval)
+static uint8_t EndIndex[_Nbr_16timers];                     // next entry of ends[] to lower
 
 uint8_t ServoCount = 0;                                     // the total number of attached servos
 
@@ -51,18 +80,37 @@ uint8_t ServoCount = 0;                                     // the total number
 
 static inline void handle_interrupts(timer16_Sequence_t timer, volatile uint16_t *TCNTn, volatile uint16_t* OCRnA)
 {
-  if( Channel[timer] < 0 )
-    *TCNTn = 0; // channel set to -1 indicated that refresh interval completed so reset the timer
-  else{
-    if( SERVO_INDEX(timer,Channel[timer]) < ServoCount && SERVO(timer,Channel[timer]).Pin.isActive == true )
-      digitalWrite( SERVO(timer,Channel[timer]).Pin.nbr,LOW); // pulse this channel low if activated
+  servo_frame_t *frame;
+  if( Event[timer] < 0 ) {
+    *TCNTn = 0; // refresh interval completed so reset the timer and start a new frame
+    if( Pending[timer] ) {
+      Active[timer] ^= 1;
+      Pending[timer] = false;
+    }
+    frame = &Frames[timer][Active[timer]];
+    for(uint8_t i = 0; i < frame->nStarts; i++)
+      *frame->starts[i].out |= frame->starts[i].mask;
+    Event[timer] = 0;
+    EndIndex[timer] = 0;
+  }
+  else {
+    frame = &Frames[timer][Active[timer]];
+    uint8_t e = Event[timer];
+    uint8_t i = EndIndex[timer];
+    do {
+      // wait out an edge that is too close to leave and come back for
+      while( (int16_t)(frame->events[e].ticks - *TCNTn) > 0 )
+        ;
+      for( ; i < frame->events[e].last; i++)
+        *frame->ends[i].out &= ~frame->ends[i].mask;
+      e++;
+    } while( e < frame->nEvents && (int16_t)(frame->events[e].ticks - *TCNTn) < (int16_t)MERGE_TICKS );
+    Event[timer] = e;
+    EndIndex[timer] = i;
   }
 
-  Channel[timer]++;    // increment to the next channel
-  if( SERVO_INDEX(timer,Channel[timer]) < ServoCount && Channel[timer] < SERVOS_PER_TIMER) {
-    *OCRnA = *TCNTn + SERVO(timer,Channel[timer]).ticks;
-    if(SERVO(timer,Channel[timer]).Pin.isActive == true)     // check if activated
-      digitalWrite( SERVO(timer,Channel[timer]).Pin.nbr,HIGH); // its an active channel so pulse it high
+  if( Event[timer] < frame->nEvents ) {
+    *OCRnA = frame->events[Event[timer]].ticks;
   }
   else {
     // finished all channels so wait for the refresh period to expire before starting over
@@ -70,8 +118,68 @@ static inline void handle_interrupts(timer16_Sequence_t timer, volatile uint16_t
       *OCRnA = (unsigned int)usToTicks(REFRESH_INTERVAL);
     else
       *OCRnA = *TCNTn + 4;  // at least REFRESH_INTERVAL has elapsed
-    Channel[timer] = -1; // this will get incremented at the end of the refresh period to start again at the first channel
+    Event[timer] = -1; // this will start the next frame at the end of the refresh period
+  }
+}
+
+// adds pin to the write list, sharing the entry of a pin on the same port
+static uint8_t addPortWrite(servo_port_t *list, uint8_t first, uint8_t count, uint8_t pin)
+{
+  volatile uint8_t *out = portOutputRegister(digitalPinToPort(pin));
+  uint8_t mask = digitalPinToBitMask(pin);
+  for(uint8_t i = first; i < count; i++) {
+    if(list[i].out == out) {
+      list[i].mask |= mask;
+      return count;
+    }
   }
+  list[count].out = out;
+  list[count].mask = mask;
+  return count + 1;
+}
+
+// rebuilds the schedule of a timer from the servo table and hands it to the ISR
+static void updateSchedule(timer16_Sequence_t timer)
+{
+  uint8_t order[SERVOS_PER_TIMER];
+  uint8_t n = 0;
+  for(uint8_t channel = 0; channel < SERVOS_PER_TIMER; channel++) {
+    if(SERVO_INDEX(timer,channel) >= ServoCount || SERVO(timer,channel).Pin.isActive == false)
+      continue;
+    // insertion sort by pulse width, at most SERVOS_PER_TIMER entries
+    uint8_t j = n++;
+    while(j > 0 && SERVO(timer,order[j-1]).ticks > SERVO(timer,channel).ticks) {
+      order[j] = order[j-1];
+      j--;
+    }
+    order[j] = channel;
+  }
+
+  uint8_t oldSREG = SREG;
+  cli();
+  Pending[timer] = false;  // the ISR must not switch to the buffer being written
+  SREG = oldSREG;
+
+  servo_frame_t *frame = &Frames[timer][Active[timer] ^ 1];
+  uint8_t starts = 0, ends = 0, events = 0;
+  for(uint8_t k = 0; k < n; k++) {
+    const servo_t &servo = SERVO(timer,order[k]);
+    starts = addPortWrite(frame->starts, 0, starts, servo.Pin.nbr);
+    if(events == 0 || frame->events[events-1].ticks != servo.ticks) {
+      frame->events[events].ticks = servo.ticks;
+      events++;
+    }
+    uint8_t first = (events > 1) ? frame->events[events-2].last : 0;
+    ends = addPortWrite(frame->ends, first, ends, servo.Pin.nbr);
+    frame->events[events-1].last = ends;
+  }
+  frame->nStarts = starts;
+  frame->nEvents = events;
+
+  oldSREG = SREG;
+  cli();
+  Pending[timer] = true;
+  SREG = oldSREG;
 }
 
 #ifndef WIRING // Wiring pre-defines signal handlers so don't define any if compiling for the Wiring platform
@@ -123,6 +231,7 @@ void Timer3Service()
 
 static void initISR(timer16_Sequence_t timer)
 {
+  Event[timer] = -1;        // the first interrupt starts a frame
 #if defined (_useTimer1)
   if(timer == _timer1) {
     TCCR1A = 0;             // normal counting mode
@@ -239,6 +348,7 @@ uint8_t Servo::attach(int pin, int min, int max)
 {
   if(this->servoIndex < MAX_SERVOS ) {
     pinMode( pin, OUTPUT) ;                                   // set servo pin to output
+    digitalWrite( pin, LOW) ;                                 // also turns off PWM, the ISR only flips the port bit
     servos[this->servoIndex].Pin.nbr = pin;
     // todo min/max check: abs(min - MIN_PULSE_WIDTH) /4 < 128
     this->min  = (MIN_PULSE_WIDTH - min)/4; //resolution of min/max is 4 uS
@@ -248,6 +358,7 @@ uint8_t Servo::attach(int pin, int min, int max)
     if(isTimerActive(timer) == false)
       initISR(timer);
     servos[this->servoIndex].Pin.isActive = true;  // this must be set after the check for isTimerActive
+    updateSchedule(timer);
   }
   return this->servoIndex ;
 }
@@ -256,6 +367,7 @@ void Servo::detach()
 {
   servos[this->servoIndex].Pin.isActive = false;
   timer16_Sequence_t timer = SERVO_INDEX_TO_TIMER(servoIndex);
+  updateSchedule(timer);  // the frame in progress still ends this pulse
   if(isTimerActive(timer) == false) {
     finISR(timer);
   }
@@ -290,6 +402,8 @@ void Servo::writeMicroseconds(int value)
     cli();
     servos[channel].ticks = value;
     SREG = oldSREG;
+    if(servos[channel].Pin.isActive == true)
+      updateSchedule(SERVO_INDEX_TO_TIMER(channel));
   }
 }
 
@@ -29,6 +29,22 @@
 #define PERIOD_IDX 38
 #define ASTERISK_IDX 39
 
+#if defined(__AVR__)
+// Timer2 counts F_CPU/128, so a step must be under 256 ticks
+#define SEVSEG_US_TO_TICKS(us) ((unsigned long)(us) * (F_CPU / 1000000UL) / 128)
+#if (SEVSEG_TIMER_STEP_US * (F_CPU / 1000000UL) / 128) > 255
+#error "SEVSEG_TIMER_STEP_US is too long for Timer2"
+#endif
+#define SEVSEG_ISR_ATTR
+#elif defined(ESP8266)
+// timer1 counts 80 MHz / 16
+#define SEVSEG_US_TO_TICKS(us) ((unsigned long)(us) * 5)
+#define SEVSEG_ISR_ATTR IRAM_ATTR
+#else
+#define SEVSEG_US_TO_TICKS(us) (us)
+#define SEVSEG_ISR_ATTR
+#endif
+
 static const long powersOf10[] = {
   1, // 10^0
   10,
@@ -115,6 +131,13 @@ SevSeg::SevSeg() {
   prevUpdateTime = 0;
   resOnSegments = 0;
   updateWithDelays = 0;
+  timerActive = false;
+  timerLit = false;
+  timerStep = 0;
+  numSteps = 0;
+  timerPortCount = 0;
+  timerOnTicks = SEVSEG_US_TO_TICKS(SEVSEG_TIMER_STEP_US);
+  timerOffTicks = 0;
 }
 
 
@@ -211,6 +234,8 @@ void SevSeg::begin(byte hardwareConfig, byte numDigitsIn, byte digitPinsIn[],
 
 void SevSeg::refreshDisplay() {
 
+  if (timerActive) return; // The timer interrupt is doing it
+
   if (!updateWithDelays) {
     unsigned long us = micros();
 
@@ -376,6 +401,14 @@ void SevSeg::setBrightness(int brightness) {
     ledOnTime = 0;
     waitOffTime = map(brightness, 0, -100, 1, 2000);
   }
+
+  // With timer refresh, the brightness is the share of each step spent lit
+  unsigned int stepTicks = SEVSEG_US_TO_TICKS(SEVSEG_TIMER_STEP_US);
+  unsigned int onTicks = (unsigned long)constrain(brightness, 0, 100) * stepTicks / 100;
+  noInterrupts();
+  timerOnTicks = onTicks;
+  timerOffTicks = stepTicks - onTicks;
+  interrupts();
 }
 
 
@@ -429,6 +462,7 @@ void SevSeg::setNewNum(long numToShow, char decPlaces, bool hex) {
   byte digits[numDigits];
   findDigits(numToShow, decPlaces, hex, digits);
   setDigitCodes(digits, decPlaces);
+  updateTimerMasks();
 }
 
 
@@ -452,6 +486,7 @@ void SevSeg::setSegments(byte segs[]) {
   for (byte digit = 0; digit < numDigits; digit++) {
     digitCodes[digit] = segs[digit];
   }
+  updateTimerMasks();
 }
 
 // setChars
@@ -497,6 +532,7 @@ void SevSeg::setChars(char str[]) {
       strIdx++;
     }
   }
+  updateTimerMasks();
 }
 
 // blank
@@ -505,6 +541,10 @@ void SevSeg::blank(void) {
   for (byte digitNum = 0 ; digitNum < numDigits ; digitNum++) {
     digitCodes[digitNum] = digitCodeMap[BLANK_IDX];
   }
+  if (timerActive) {
+    updateTimerMasks();
+    return;
+  }
   segmentOff(0);
   digitOff(0);
 }
@@ -579,4 +619,190 @@ void SevSeg::setDigitCodes(byte digits[], char decPlaces) {
   }
 }
 
+
+#if defined(SEVSEG_HAS_TIMER)
+static SevSeg *timerDisplay = NULL; // The display the timer is refreshing
+
+#if defined(__AVR__)
+// Timer2 runs free; compare B is moved along to the end of each phase.
+// Only the compare B vector is taken, so tone() still links, but the two
+// can't be used at the same time.
+ISR(TIMER2_COMPB_vect) {
+  OCR2B += timerDisplay->timerTick();
+}
+#else
+static void SEVSEG_ISR_ATTR sevsegTimerISR() {
+  timer1_write(timerDisplay->timerTick());
+}
+#endif
+#endif
+
+
+// beginTimerRefresh
+/******************************************************************************/
+// Refreshes the display from a timer interrupt, so that nothing the sketch
+// does in loop() can make it flicker or go dark. refreshDisplay() then does
+// nothing. Each tick either lights the next digit (or segment) or turns it
+// off, writing one register per output port, with the port values worked
+// out in advance. setBrightness() sets the share of each step that is lit.
+// Uses Timer2 on AVR (so no tone()) and timer1 on ESP8266 (so no Servo,
+// tone() or analogWrite()), and only one display can use it at a time.
+// Returns false if the board has no such timer, another display is using
+// it, the pins are spread over more than SEVSEG_MAX_PORTS ports, or (on
+// ESP8266) a pin is GPIO16.
+bool SevSeg::beginTimerRefresh() {
+#if defined(SEVSEG_HAS_TIMER)
+  if (timerDisplay && timerDisplay != this) return false;
+  endTimerRefresh();
+
+  numSteps = resOnSegments ? numDigits : numSegments;
+  timerPortCount = 0;
+  for (byte i = 0 ; i < numDigits + numSegments ; i++) {
+    byte pin = (i < numDigits) ? digitPins[i] : segmentPins[i - numDigits];
+#if defined(ESP8266)
+    if (pin >= 16) return false;
+#endif
+    volatile SevSegPort *port = portOutputRegister(digitalPinToPort(pin));
+    byte p = 0;
+    while (p < timerPortCount && timerPorts[p] != port) p++;
+    if (p == timerPortCount) {
+      if (timerPortCount == SEVSEG_MAX_PORTS) return false;
+      timerPorts[p] = port;
+      timerPortMasks[p] = 0;
+      timerPortCount++;
+    }
+    timerPortMasks[p] |= digitalPinToBitMask(pin);
+  }
+
+  timerActive = true;
+  updateTimerMasks();
+  timerStep = numSteps - 1;
+  timerLit = false;
+  timerDisplay = this;
+
+#if defined(__AVR__)
+  noInterrupts();
+  TCCR2A = 0; // Normal mode: count to 255 and wrap
+  TCCR2B = _BV(CS22) | _BV(CS20); // F_CPU / 128
+  OCR2B = TCNT2 + 1;
+  TIFR2 = _BV(OCF2B);
+  TIMSK2 = _BV(OCIE2B);
+  interrupts();
+#else
+  timer1_isr_init();
+  timer1_attachInterrupt(sevsegTimerISR);
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+  timer1_write(SEVSEG_US_TO_TICKS(SEVSEG_TIMER_STEP_US));
+#endif
+  return true;
+#else
+  return false;
+#endif
+}
+
+// endTimerRefresh
+/******************************************************************************/
+// Stops the timer interrupt and turns the display off. Call refreshDisplay()
+// from loop() again afterwards.
+void SevSeg::endTimerRefresh() {
+#if defined(SEVSEG_HAS_TIMER)
+  if (!timerActive) return;
+#if defined(__AVR__)
+  TIMSK2 &= ~_BV(OCIE2B);
+#else
+  timer1_disable();
+  timer1_detachInterrupt();
+#endif
+  timerActive = false;
+  timerDisplay = NULL;
+  timerWrite(timerOffVals);
+#endif
+}
+
+// timerTick
+/******************************************************************************/
+// Moves the display on by one phase: lights the next step, or turns the
+// current one off when brightness is below 100. Returns the number of timer
+// ticks until the next call.
+unsigned int SEVSEG_ISR_ATTR SevSeg::timerTick() {
+  if (timerLit && timerOffTicks) {
+    timerWrite(timerOffVals);
+    timerLit = false;
+    return timerOffTicks;
+  }
+  timerStep++;
+  if (timerStep >= numSteps) timerStep = 0;
+  if (!timerOnTicks) {
+    timerWrite(timerOffVals);
+    timerLit = false;
+    return timerOffTicks;
+  }
+  timerWrite(timerStepVals[timerStep]);
+  timerLit = true;
+  return timerOnTicks;
+}
+
+// timerWrite
+/******************************************************************************/
+// Sets every pin of the display at once, one register write per port
+void SEVSEG_ISR_ATTR SevSeg::timerWrite(const SevSegPort vals[]) {
+  for (byte p = 0 ; p < timerPortCount ; p++) {
+    *timerPorts[p] = (*timerPorts[p] & ~timerPortMasks[p]) | vals[p];
+  }
+}
+
+// timerSetPin
+/******************************************************************************/
+// Sets one pin's bit in a set of port values
+void SevSeg::timerSetPin(SevSegPort vals[], byte pin, bool level) {
+  volatile SevSegPort *port = portOutputRegister(digitalPinToPort(pin));
+  SevSegPort bit = digitalPinToBitMask(pin);
+  for (byte p = 0 ; p < timerPortCount ; p++) {
+    if (timerPorts[p] != port) continue;
+    if (level) vals[p] |= bit;
+    else vals[p] &= ~bit;
+  }
+}
+
+// updateTimerMasks
+/******************************************************************************/
+// Works out the port values for every step from 'digitCodes[]', the same
+// way digitOn() and segmentOn() choose which pins to turn on. A step may
+// show a mix of the old and new numbers for one tick while this runs.
+void SevSeg::updateTimerMasks() {
+  if (!timerActive) return;
+
+  for (byte p = 0 ; p < timerPortCount ; p++) timerOffVals[p] = 0;
+  for (byte digitNum = 0 ; digitNum < numDigits ; digitNum++) {
+    timerSetPin(timerOffVals, digitPins[digitNum], digitOffVal);
+  }
+  for (byte segmentNum = 0 ; segmentNum < numSegments ; segmentNum++) {
+    timerSetPin(timerOffVals, segmentPins[segmentNum], segmentOffVal);
+  }
+
+  for (byte step = 0 ; step < numSteps ; step++) {
+    SevSegPort vals[SEVSEG_MAX_PORTS];
+    for (byte p = 0 ; p < timerPortCount ; p++) vals[p] = timerOffVals[p];
+
+    if (!resOnSegments) { // Step through segments, lighting digits
+      timerSetPin(vals, segmentPins[step], segmentOnVal);
+      for (byte digitNum = 0 ; digitNum < numDigits ; digitNum++) {
+        if (digitCodes[digitNum] & (1 << step)) {
+          timerSetPin(vals, digitPins[digitNum], digitOnVal);
+        }
+      }
+    }
+    else { // Step through digits, lighting segments
+      timerSetPin(vals, digitPins[step], digitOnVal);
+      for (byte segmentNum = 0 ; segmentNum < numSegments ; segmentNum++) {
+        if (digitCodes[step] & (1 << segmentNum)) {
+          timerSetPin(vals, segmentPins[segmentNum], segmentOnVal);
+        }
+      }
+    }
+
+    for (byte p = 0 ; p < timerPortCount ; p++) timerStepVals[step][p] = vals[p];
+  }
+}
+
 /// END ///
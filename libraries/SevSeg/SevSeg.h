@@ -26,6 +26,10 @@
 #define MAXNUMDIGITS 8 // Can be increased, but the max number is 2^31
 #endif
 
+#ifndef SEVSEG_TIMER_STEP_US
+#define SEVSEG_TIMER_STEP_US 1000 // Time each digit/segment gets with timer refresh
+#endif
+
 #ifndef SevSeg_h
 #define SevSeg_h
 
@@ -43,6 +47,19 @@
 #define NP_COMMON_CATHODE 1
 #define NP_COMMON_ANODE 0
 
+// Timer refresh uses Timer2 (compare B) on AVR and timer1 on ESP8266
+#if (defined(__AVR__) && defined(OCR2B)) || defined(ESP8266)
+#define SEVSEG_HAS_TIMER
+#endif
+#define SEVSEG_MAX_PORTS 4 // Output ports the pins may be spread over
+#define SEVSEG_MAX_STEPS (MAXNUMDIGITS > 8 ? MAXNUMDIGITS : 8)
+
+#if defined(__AVR__)
+typedef uint8_t SevSegPort;
+#else
+typedef uint32_t SevSegPort;
+#endif
+
 
 class SevSeg
 {
@@ -68,6 +85,10 @@ public:
   void setChars(char str[]);
   void blank(void);
 
+  bool beginTimerRefresh();
+  void endTimerRefresh();
+  unsigned int timerTick(); // Called by the timer interrupt, not by sketches
+
 private:
   void setNewNum(long numToShow, char decPlaces, bool hex=0);
   void findDigits(long numToShow, char decPlaces, bool hex, byte digits[]);
@@ -76,6 +97,9 @@ private:
   void segmentOff(byte segmentNum);
   void digitOn(byte digitNum);
   void digitOff(byte digitNum);
+  void updateTimerMasks();
+  void timerSetPin(SevSegPort vals[], byte pin, bool level);
+  void timerWrite(const SevSegPort vals[]);
 
   bool digitOnVal,digitOffVal,segmentOnVal,segmentOffVal;
   bool resOnSegments, updateWithDelays, leadingZeros;
@@ -89,6 +113,21 @@ private:
   int ledOnTime; // The time (us) to wait with LEDs on
   int waitOffTime; // The time (us) to wait with LEDs off
   bool waitOffActive; // Whether  the program is waiting with LEDs off
+
+  // Timer refresh: the port values for every step of the multiplexing are
+  // worked out whenever the display changes, so the interrupt only writes
+  // one register per port
+  bool timerActive;
+  bool timerLit; // Whether the current step's LEDs are on
+  byte timerStep; // The digit or segment being shown
+  byte numSteps;
+  byte timerPortCount;
+  volatile SevSegPort *timerPorts[SEVSEG_MAX_PORTS];
+  SevSegPort timerPortMasks[SEVSEG_MAX_PORTS]; // The bits of each port in use
+  SevSegPort timerStepVals[SEVSEG_MAX_STEPS][SEVSEG_MAX_PORTS];
+  SevSegPort timerOffVals[SEVSEG_MAX_PORTS];
+  unsigned int timerOnTicks; // Timer ticks with LEDs on, per step
+  unsigned int timerOffTicks; // Timer ticks with LEDs off, per step
 };
 
 #endif //SevSeg_h
@@ -0,0 +1,331 @@
+/*
+ * TimerWheel.cpp
+ *
+ * TimerWheel - SimpleTimer-style scheduler on a hierarchical timer wheel.
+ *
+ * This library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser
+ * General Public License as published by the Free Software
+ * Foundation; either version 2.1 of the License, or (at
+ * your option) any later version.
+ */
+
+
+#include "TimerWheel.h"
+
+
+static inline unsigned long elapsed() { return micros(); }
+
+// slots spanned by a level: 6 bits per level
+static inline uint8_t shiftOf(uint8_t level) { return level * TIMERWHEEL_SLOT_BITS; }
+
+// index of the highest set bit (x != 0)
+static inline uint8_t highestBit(uint64_t x) { return 63 - __builtin_clzll(x); }
+
+// index of the lowest set bit (x != 0)
+static inline uint8_t lowestBit(uint64_t x) { return __builtin_ctzll(x); }
+
+// slots first+1 .. first+count of a level, wrapping at 64 (0 < count < 64)
+static inline uint64_t slotsAfter(uint8_t first, uint64_t count) {
+    uint64_t run = (1ULL << count) - 1;
+    uint8_t start = (first + 1) & (TIMERWHEEL_SLOTS - 1);
+    return (run << start) | (start ? (run >> (TIMERWHEEL_SLOTS - start)) : 0);
+}
+
+
+TimerWheel::TimerWheel(TimerWheelEntry *pool, uint16_t capacity) {
+    this->pool = pool;
+    this->capacity = capacity;
+
+    // all entries start in the free list, linked through next
+    freeList = capacity ? 0 : NIL;
+    for (uint16_t i = 0; i < capacity; i++) {
+        pool[i].callback = 0;
+        pool[i].enabled = false;
+        pool[i].list = NO_LIST;
+        pool[i].next = (i + 1 < capacity) ? i + 1 : NIL;
+    }
+
+    for (uint16_t i = 0; i <= EXPIRED; i++) {
+        heads[i] = NIL;
+    }
+    for (uint8_t l = 0; l < TIMERWHEEL_LEVELS; l++) {
+        pending[l] = 0;
+    }
+
+    numTimers = 0;
+    now = 0;
+    lastMicros = elapsed();
+}
+
+
+void TimerWheel::link(uint16_t id, uint16_t list) {
+    TimerWheelEntry &t = pool[id];
+    t.list = list;
+    t.prev = NIL;
+    t.next = heads[list];
+    if (t.next != NIL) {
+        pool[t.next].prev = id;
+    }
+    heads[list] = id;
+    if (list != EXPIRED) {
+        pending[list / TIMERWHEEL_SLOTS] |= 1ULL << (list % TIMERWHEEL_SLOTS);
+    }
+}
+
+
+void TimerWheel::unlink(uint16_t id) {
+    TimerWheelEntry &t = pool[id];
+    if (t.list == NO_LIST) {
+        return;
+    }
+    if (t.prev != NIL) {
+        pool[t.prev].next = t.next;
+    } else {
+        heads[t.list] = t.next;
+        if (t.next == NIL && t.list != EXPIRED) {
+            pending[t.list / TIMERWHEEL_SLOTS] &= ~(1ULL << (t.list % TIMERWHEEL_SLOTS));
+        }
+    }
+    if (t.next != NIL) {
+        pool[t.next].prev = t.prev;
+    }
+    t.list = NO_LIST;
+}
+
+
+// file a timer by its deadline: the level is given by the highest bit in
+// which deadline and now differ, the slot by the deadline's bits there
+void TimerWheel::schedule(uint16_t id) {
+    TimerWheelEntry &t = pool[id];
+
+    if (t.deadline <= now) {
+        link(id, EXPIRED);
+        return;
+    }
+
+    // deadlines past the top level land in it by their own bits: the slot
+    // comes round before the deadline (or right at it) and is re-filed then
+    uint8_t level = highestBit(t.deadline ^ now) / TIMERWHEEL_SLOT_BITS;
+    if (level >= TIMERWHEEL_LEVELS) {
+        level = TIMERWHEEL_LEVELS - 1;
+    }
+    uint8_t slot = (t.deadline >> shiftOf(level)) & (TIMERWHEEL_SLOTS - 1);
+    link(id, level * TIMERWHEEL_SLOTS + slot);
+}
+
+
+// move the wheel to the current time: every slot passed since the previous
+// call is emptied and its timers re-filed, either one level down or in the
+// expired list. Only the slots that were passed are looked at.
+void TimerWheel::advance() {
+    unsigned long current = elapsed();
+    uint64_t then = now;
+    now += (unsigned long)(current - lastMicros);
+    lastMicros = current;
+
+    uint16_t todo = NIL;
+
+    for (uint8_t l = 0; l < TIMERWHEEL_LEVELS; l++) {
+        uint64_t passed = (now >> shiftOf(l)) - (then >> shiftOf(l));
+        if (passed == 0) {
+            break;  // coarser levels cannot have moved either
+        }
+
+        uint64_t due = pending[l];
+        if (passed < TIMERWHEEL_SLOTS) {
+            due &= slotsAfter((then >> shiftOf(l)) & (TIMERWHEEL_SLOTS - 1), passed);
+        }
+
+        while (due) {
+            uint8_t slot = lowestBit(due);
+            due &= due - 1;
+
+            // splice the whole slot onto the to-do chain
+            uint16_t list = l * TIMERWHEEL_SLOTS + slot;
+            uint16_t id = heads[list];
+            while (id != NIL) {
+                uint16_t next = pool[id].next;
+                pool[id].list = NO_LIST;
+                pool[id].next = todo;
+                todo = id;
+                id = next;
+            }
+            heads[list] = NIL;
+            pending[l] &= ~(1ULL << slot);
+        }
+    }
+
+    while (todo != NIL) {
+        uint16_t next = pool[todo].next;
+        schedule(todo);
+        todo = next;
+    }
+}
+
+
+void TimerWheel::run() {
+    advance();
+
+    // callbacks may add, delete or restart timers (including their own), so
+    // each due timer is taken off the list and re-filed before it is called
+    while (heads[EXPIRED] != NIL) {
+        uint16_t id = heads[EXPIRED];
+        TimerWheelEntry &t = pool[id];
+        timer_callback f = t.callback;
+        unlink(id);
+
+        boolean last = false;
+        if (t.maxNumRuns != RUN_FOREVER) {
+            t.numRuns++;
+            last = t.numRuns >= t.maxNumRuns;
+        }
+
+        if (last) {
+            deleteTimer(id);
+        } else {
+            // same drift-free rule as SimpleTimer: the next run counts from
+            // this deadline, unless the loop fell a whole period behind
+            t.deadline += t.period;
+            if (t.deadline <= now) {
+                t.deadline = now + t.period;
+            }
+            schedule(id);
+        }
+
+        (*f)();
+    }
+}
+
+
+int TimerWheel::setTimer(unsigned long d, timer_callback f, int n) {
+    if (f == NULL || freeList == NIL) {
+        return -1;
+    }
+
+    uint16_t id = freeList;
+    TimerWheelEntry &t = pool[id];
+    freeList = t.next;
+
+    advance();
+    t.period = d ? d : 1;     // a zero period would never leave run()
+    t.callback = f;
+    t.maxNumRuns = n;
+    t.numRuns = 0;
+    t.enabled = true;
+    t.list = NO_LIST;
+    t.deadline = now + d;
+    schedule(id);
+
+    numTimers++;
+
+    return id;
+}
+
+
+int TimerWheel::setInterval(unsigned long d, timer_callback f) {
+    return setTimer(d, f, RUN_FOREVER);
+}
+
+
+int TimerWheel::setTimeout(unsigned long d, timer_callback f) {
+    return setTimer(d, f, RUN_ONCE);
+}
+
+
+boolean TimerWheel::valid(int numTimer) {
+    return numTimer >= 0 && numTimer < capacity && pool[numTimer].callback != 0;
+}
+
+
+void TimerWheel::deleteTimer(int numTimer) {
+    if (!valid(numTimer)) {
+        return;
+    }
+
+    TimerWheelEntry &t = pool[numTimer];
+    unlink(numTimer);
+    t.callback = 0;
+    t.enabled = false;
+    t.next = freeList;
+    freeList = numTimer;
+
+    numTimers--;
+}
+
+
+void TimerWheel::restartTimer(int numTimer) {
+    if (!valid(numTimer)) {
+        return;
+    }
+
+    TimerWheelEntry &t = pool[numTimer];
+    advance();
+    unlink(numTimer);
+    t.deadline = now + t.period;
+    if (t.enabled) {
+        schedule(numTimer);
+    }
+}
+
+
+boolean TimerWheel::isEnabled(int numTimer) {
+    return valid(numTimer) && pool[numTimer].enabled;
+}
+
+
+void TimerWheel::enable(int numTimer) {
+    if (!valid(numTimer) || pool[numTimer].enabled) {
+        return;
+    }
+
+    pool[numTimer].enabled = true;
+    restartTimer(numTimer);
+}
+
+
+// a disabled timer keeps its entry but leaves the wheel
+void TimerWheel::disable(int numTimer) {
+    if (!valid(numTimer)) {
+        return;
+    }
+
+    pool[numTimer].enabled = false;
+    unlink(numTimer);
+}
+
+
+void TimerWheel::toggle(int numTimer) {
+    if (isEnabled(numTimer)) {
+        disable(numTimer);
+    } else {
+        enable(numTimer);
+    }
+}
+
+
+unsigned long TimerWheel::nextDeadline() {
+    advance();
+
+    if (heads[EXPIRED] != NIL) {
+        return 0;
+    }
+
+    // the first non-empty slot of the lowest level that has one; its start
+    // is a lower bound for every deadline in coarser levels too
+    for (uint8_t l = 0; l < TIMERWHEEL_LEVELS; l++) {
+        if (!pending[l]) {
+            continue;
+        }
+        uint8_t current = (now >> shiftOf(l)) & (TIMERWHEEL_SLOTS - 1);
+        // rotate so that the slot after the current one is bit 0
+        uint8_t r = (current + 1) & (TIMERWHEEL_SLOTS - 1);
+        uint64_t rotated = (pending[l] >> r) | (r ? (pending[l] << (TIMERWHEEL_SLOTS - r)) : 0);
+        uint64_t slots = lowestBit(rotated) + 1;
+        uint64_t start = ((now >> shiftOf(l)) + slots) << shiftOf(l);
+        uint64_t wait = start > now ? start - now : 0;
+        return wait > 0xFFFFFFFEULL ? 0xFFFFFFFEUL : (unsigned long)wait;
+    }
+
+    return ~0UL;
+}
@@ -0,0 +1,142 @@
+/*
+ * TimerWheel.h
+ *
+ * TimerWheel - SimpleTimer-style scheduler on a hierarchical timer wheel.
+ *
+ * Same job as SimpleTimer (callbacks run from loop() via run()), but:
+ *  - delays and deadlines are in microseconds;
+ *  - the capacity is chosen per instance (TimerWheelPool<N>);
+ *  - insert, delete and restart are O(1), and run() only touches the wheel
+ *    slots that came due since the previous call, so its cost does not
+ *    grow with the number of timers.
+ *
+ * The wheel has TIMERWHEEL_LEVELS levels of 64 slots; level 0 slots are
+ * 1 us wide, each next level is 64 times coarser (4 levels cover ~16.7 s).
+ * Longer delays sit in the last level and are re-filed as they come
+ * closer. Time is kept in 64 bits, so micros() rollover is not an issue.
+ *
+ * This library is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU Lesser
+ * General Public License as published by the Free Software
+ * Foundation; either version 2.1 of the License, or (at
+ * your option) any later version.
+ */
+
+
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include <Arduino.h>
+#else
+#include <WProgram.h>
+#endif
+
+#include "SimpleTimer.h"
+
+#ifndef TIMERWHEEL_LEVELS
+#define TIMERWHEEL_LEVELS 4
+#endif
+
+#define TIMERWHEEL_SLOT_BITS 6
+#define TIMERWHEEL_SLOTS     (1 << TIMERWHEEL_SLOT_BITS)
+
+// one timer; lives in the pool handed to TimerWheel
+struct TimerWheelEntry {
+    uint64_t deadline;          // absolute wheel time, in us
+    unsigned long period;       // us between runs
+    timer_callback callback;    // 0 = free entry
+    int maxNumRuns;             // RUN_FOREVER or number of runs
+    int numRuns;
+    uint16_t next, prev;        // doubly linked list of the slot it is in
+    uint16_t list;              // slot index, or NO_LIST when not filed
+    boolean enabled;
+};
+
+class TimerWheel {
+
+public:
+    // setTimer() constants, as in SimpleTimer
+    const static int RUN_FOREVER = SimpleTimer::RUN_FOREVER;
+    const static int RUN_ONCE = SimpleTimer::RUN_ONCE;
+
+    // pool: caller-provided storage for up to capacity timers
+    TimerWheel(TimerWheelEntry *pool, uint16_t capacity);
+
+    // this function must be called inside loop()
+    void run();
+
+    // call function f every d microseconds
+    int setInterval(unsigned long d, timer_callback f);
+
+    // call function f once after d microseconds
+    int setTimeout(unsigned long d, timer_callback f);
+
+    // call function f every d microseconds for n times
+    int setTimer(unsigned long d, timer_callback f, int n);
+
+    // destroy the specified timer
+    void deleteTimer(int numTimer);
+
+    // restart the specified timer: next run d microseconds from now
+    void restartTimer(int numTimer);
+
+    // returns true if the specified timer is enabled
+    boolean isEnabled(int numTimer);
+
+    // enables the specified timer (its period counts from now)
+    void enable(int numTimer);
+
+    // disables the specified timer
+    void disable(int numTimer);
+
+    // enables the specified timer if it's currently disabled,
+    // and vice-versa
+    void toggle(int numTimer);
+
+    // returns the number of used timers
+    int getNumTimers() { return numTimers; };
+
+    // returns the number of available timers
+    int getNumAvailableTimers() { return capacity - numTimers; };
+
+    // microseconds until the next filed deadline, at slot resolution
+    // (0 if one is already due, ~0UL if nothing is scheduled)
+    unsigned long nextDeadline();
+
+private:
+    const static uint16_t NO_LIST = 0xFFFF;
+    const static uint16_t NIL = 0xFFFF;
+    const static uint16_t EXPIRED = TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS;
+
+    void advance();
+    void schedule(uint16_t id);
+    void link(uint16_t id, uint16_t list);
+    void unlink(uint16_t id);
+    boolean valid(int numTimer);
+
+    TimerWheelEntry *pool;
+    uint16_t capacity;
+    int numTimers;
+    uint16_t freeList;
+
+    uint64_t now;               // wheel time, in us
+    unsigned long lastMicros;   // micros() at the previous advance()
+
+    // one list head per slot plus the list of due timers
+    uint16_t heads[TIMERWHEEL_LEVELS * TIMERWHEEL_SLOTS + 1];
+    // non-empty slots of each level
+    uint64_t pending[TIMERWHEEL_LEVELS];
+};
+
+// TimerWheel with its own storage for N timers
+template <uint16_t N>
+class TimerWheelPool : public TimerWheel {
+public:
+    TimerWheelPool() : TimerWheel(entries, N) {}
+
+private:
+    TimerWheelEntry entries[N];
+};
+
+#endif
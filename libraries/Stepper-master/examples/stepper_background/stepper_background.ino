@@ -0,0 +1,65 @@
+/*
+ Stepper Motor Control - background moves
+
+ This program drives a unipolar or bipolar stepper motor.
+ The motor is attached to digital pins 8 - 11 of the Arduino.
+
+ The motor is stepped from a timer interrupt 10000 times a second, so
+ loop() is free to do other things while it moves. It speeds up and
+ slows down smoothly, going back and forth one revolution.
+
+ On AVR boards the interrupt comes from Timer1 (so the Servo library
+ can't be used as well), on the ESP8266 from timer1.
+
+ */
+
+#include <Stepper.h>
+
+const int stepsPerRevolution = 200;  // change this to fit the number of steps per revolution
+// for your motor
+const unsigned long tickRate = 10000; // how often the motor is serviced, per second
+
+// initialize the stepper library on pins 8 through 11:
+Stepper myStepper(stepsPerRevolution, 8, 9, 10, 11);
+
+#if defined(ESP8266)
+void IRAM_ATTR onTick() {
+  myStepper.run();
+}
+#else
+ISR(TIMER1_COMPA_vect) {
+  myStepper.run();
+}
+#endif
+
+void setup() {
+  Serial.begin(9600);
+
+  myStepper.setTickRate(tickRate);
+  myStepper.setMaxSpeed(400);       // steps per second
+  myStepper.setAcceleration(800);   // steps per second per second
+
+#if defined(ESP8266)
+  timer1_attachInterrupt(onTick);
+  timer1_enable(TIM_DIV16, TIM_EDGE, TIM_LOOP);
+  timer1_write(5000000 / tickRate); // 5 MHz timer clock
+#else
+  noInterrupts();
+  TCCR1A = 0;
+  TCCR1B = _BV(WGM12) | _BV(CS11); // CTC, clock / 8
+  OCR1A = F_CPU / 8 / tickRate - 1;
+  TIMSK1 = _BV(OCIE1A);
+  interrupts();
+#endif
+}
+
+void loop() {
+  if (!myStepper.isRunning()) {
+    // go the other way
+    myStepper.moveTo(myStepper.currentPosition() == 0 ? stepsPerRevolution : 0);
+  }
+  // loop() can block for a while without the motor missing a step
+  Serial.print("position: ");
+  Serial.println(myStepper.currentPosition());
+  delay(100);
+}
@@ -88,6 +88,7 @@ Stepper::Stepper(int number_of_steps, int motor_pin_1, int motor_pin_2)
   this->direction = 0;      // motor direction
   this->last_step_time = 0; // time stamp in us of the last step taken
   this->number_of_steps = number_of_steps; // total number of steps for this motor
+  initMotion();
 
   // Arduino pins for the motor control connection:
   this->motor_pin_1 = motor_pin_1;
@@ -118,6 +119,7 @@ Stepper::Stepper(int number_of_steps, int motor_pin_1, int motor_pin_2,
   this->direction = 0;      // motor direction
   this->last_step_time = 0; // time stamp in us of the last step taken
   this->number_of_steps = number_of_steps; // total number of steps for this motor
+  initMotion();
 
   // Arduino pins for the motor control connection:
   this->motor_pin_1 = motor_pin_1;
@@ -150,6 +152,7 @@ Stepper::Stepper(int number_of_steps, int motor_pin_1, int motor_pin_2,
   this->direction = 0;      // motor direction
   this->last_step_time = 0; // time stamp in us of the last step taken
   this->number_of_steps = number_of_steps; // total number of steps for this motor
+  initMotion();
 
   // Arduino pins for the motor control connection:
   this->motor_pin_1 = motor_pin_1;
@@ -199,37 +202,45 @@ void Stepper::step(int steps_to_move)
     {
       // get the timeStamp of when you stepped:
       this->last_step_time = now;
-      // increment or decrement the step number,
-      // depending on direction:
-      if (this->direction == 1)
-      {
-        this->step_number++;
-        if (this->step_number == this->number_of_steps) {
-          this->step_number = 0;
-        }
-      }
-      else
-      {
-        if (this->step_number == 0) {
-          this->step_number = this->number_of_steps;
-        }
-        this->step_number--;
-      }
       // decrement the steps left:
       steps_left--;
-      // step the motor to step number 0, 1, ..., {3 or 10}
-      if (this->pin_count == 5)
-        stepMotor(this->step_number % 10);
-      else
-        stepMotor(this->step_number % 4);
+      // increment or decrement the step number, depending on direction:
+      advance(this->direction == 1 ? 1 : -1);
     }
   }
 }
 
+/*
+ * Moves the motor one step in direction dir (1 or -1), wrapping
+ * step_number around the motor's steps per revolution.
+ */
+STEPPER_ISR_ATTR void Stepper::advance(int dir)
+{
+  if (dir > 0)
+  {
+    this->step_number++;
+    if (this->step_number == this->number_of_steps) {
+      this->step_number = 0;
+    }
+  }
+  else
+  {
+    if (this->step_number == 0) {
+      this->step_number = this->number_of_steps;
+    }
+    this->step_number--;
+  }
+  // step the motor to step number 0, 1, ..., {3 or 10}
+  if (this->pin_count == 5)
+    stepMotor(this->step_number % 10);
+  else
+    stepMotor(this->step_number % 4);
+}
+
 /*
  * Moves the motor forward or backwards.
  */
-void Stepper::stepMotor(int thisStep)
+STEPPER_ISR_ATTR void Stepper::stepMotor(int thisStep)
 {
   if (this->pin_count == 2) {
     switch (thisStep) {
@@ -356,6 +367,206 @@ void Stepper::stepMotor(int thisStep)
   }
 }
 
+/*
+ * Background motion.
+ *
+ * run() is called at a fixed rate from a timer interrupt the sketch sets
+ * up, and set with setTickRate(). Each call moves the speed one tick's
+ * worth along a trapezoidal ramp (speeding up at the acceleration to the
+ * max speed, cruising, then slowing down in as many steps as it took to
+ * speed up) and takes a step whenever the accumulated speed makes one due.
+ * A step can be taken at most once per tick, so the tick rate has to be
+ * above the max speed; a few times above it keeps the steps evenly spaced.
+ * moveTo() and the rest return at once, so nothing waits for the motor.
+ */
+
+#define STEPPER_PHASE_ONE (1UL << 24) // one step, in the units of speed
+
+void Stepper::initMotion(void)
+{
+  this->tick_rate = 10000;
+  this->max_speed = 500;
+  this->acceleration = 1000;
+  this->speed = 0;
+  this->phase = 0;
+  this->ramp_steps = 0;
+  this->position = 0;
+  this->target = 0;
+  this->run_direction = 1;
+  updateRamp(false);
+}
+
+/*
+ * Converts the speed settings to per-tick values for run(). The
+ * constructors pass lock = false: interrupts mustn't be turned on while
+ * global objects are being built.
+ */
+void Stepper::updateRamp(bool lock)
+{
+  float per_tick = (float)STEPPER_PHASE_ONE / this->tick_rate;
+  unsigned long top = STEPPER_PHASE_ONE - 1; // one step per tick at most
+  unsigned long vmax = min((float)this->max_speed * per_tick, (float)top);
+  unsigned long vstep = (float)this->acceleration * per_tick / this->tick_rate;
+  unsigned long vmin = sqrt(2.0 * this->acceleration) * per_tick;
+  if (vmax < 1) vmax = 1;
+  if (vstep < 1) vstep = 1;
+  if (vmin < 1) vmin = 1;
+  if (vmin > vmax) vmin = vmax;
+
+  if (lock) noInterrupts();
+  this->speed_max = vmax;
+  this->speed_step = vstep;
+  this->speed_min = vmin;
+  if (lock) interrupts();
+}
+
+/*
+ * Sets how many times per second run() is called.
+ */
+void Stepper::setTickRate(unsigned long ticks_per_second)
+{
+  if (ticks_per_second == 0) return;
+  this->tick_rate = ticks_per_second;
+  updateRamp(true);
+}
+
+/*
+ * Sets the cruising speed of background moves, in steps per second.
+ */
+void Stepper::setMaxSpeed(unsigned long steps_per_second)
+{
+  this->max_speed = steps_per_second;
+  updateRamp(true);
+}
+
+/*
+ * Sets how fast background moves speed up and slow down, in steps per
+ * second per second.
+ */
+void Stepper::setAcceleration(unsigned long steps_per_second_per_second)
+{
+  if (steps_per_second_per_second == 0) return;
+  this->acceleration = steps_per_second_per_second;
+  updateRamp(true);
+}
+
+/*
+ * Starts a background move to an absolute position, or changes the
+ * target of the one in progress. A move the other way slows to a stop
+ * first.
+ */
+void Stepper::moveTo(long absolute)
+{
+  noInterrupts();
+  this->target = absolute;
+  interrupts();
+}
+
+/*
+ * Starts a background move relative to the current position.
+ */
+void Stepper::move(long relative)
+{
+  noInterrupts();
+  this->target = this->position + relative;
+  interrupts();
+}
+
+/*
+ * Slows down to a stop as soon as the acceleration allows.
+ */
+void Stepper::stop(void)
+{
+  noInterrupts();
+  if (this->speed != 0) {
+    this->target = this->position + this->run_direction * (long)this->ramp_steps;
+  }
+  interrupts();
+}
+
+/*
+ * Moves the background motion on by one tick. Call it from a timer
+ * interrupt, at the rate given to setTickRate().
+ */
+STEPPER_ISR_ATTR void Stepper::run(void)
+{
+  long remaining = this->target - this->position;
+  if (this->speed == 0) {
+    if (remaining == 0) return;
+    // from rest, any direction can start at the ramp's first speed
+    this->run_direction = (remaining > 0) ? 1 : -1;
+    this->speed = this->speed_min;
+    this->phase = STEPPER_PHASE_ONE - 1; // the first step goes right away
+    this->ramp_steps = 0;
+  }
+
+  unsigned long distance = (remaining > 0) ? remaining : -remaining;
+  bool wrong_way = (remaining > 0) != (this->run_direction > 0);
+  bool slowing = wrong_way || distance <= this->ramp_steps;
+  if (slowing) {
+    if (this->speed > this->speed_min + this->speed_step) this->speed -= this->speed_step;
+    else this->speed = this->speed_min;
+  }
+  else if (this->speed < this->speed_max) {
+    this->speed = min(this->speed + this->speed_step, this->speed_max);
+  }
+  else if (this->speed > this->speed_max) {
+    this->speed -= min(this->speed_step, this->speed - this->speed_max); // max speed lowered
+  }
+
+  this->phase += this->speed;
+  if (this->phase < STEPPER_PHASE_ONE) return;
+  this->phase -= STEPPER_PHASE_ONE;
+
+  if (remaining == 0 || (wrong_way && this->speed == this->speed_min)) {
+    // there, or slow enough to turn around: stop, and start again next tick
+    this->speed = 0;
+    return;
+  }
+  advance(this->run_direction);
+  this->position += this->run_direction;
+  if (slowing) {
+    if (this->ramp_steps > 0) this->ramp_steps--;
+  }
+  else if (this->speed < this->speed_max) {
+    this->ramp_steps++;
+  }
+}
+
+/*
+ * True while a background move is in progress.
+ */
+bool Stepper::isRunning(void)
+{
+  noInterrupts();
+  bool running = this->speed != 0 || this->target != this->position;
+  interrupts();
+  return running;
+}
+
+/*
+ * The position in steps, counted by background moves from the origin.
+ */
+long Stepper::currentPosition(void)
+{
+  noInterrupts();
+  long position = this->position;
+  interrupts();
+  return position;
+}
+
+/*
+ * Redefines the current position, e.g. after homing against a switch.
+ * Only call it while stopped.
+ */
+void Stepper::setCurrentPosition(long position)
+{
+  noInterrupts();
+  this->position = position;
+  this->target = position;
+  interrupts();
+}
+
 /*
   version() returns the version of the library:
 */
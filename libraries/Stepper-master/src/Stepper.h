@@ -79,6 +79,15 @@
 #ifndef Stepper_h
 #define Stepper_h
 
+#include "Arduino.h"
+
+// run() and what it calls must be in RAM to be run from an interrupt
+#if defined(ESP8266) || defined(ESP32)
+#define STEPPER_ISR_ATTR IRAM_ATTR
+#else
+#define STEPPER_ISR_ATTR
+#endif
+
 // library interface description
 class Stepper {
   public:
@@ -98,8 +107,23 @@ class Stepper {
 
     int version(void);
 
+    // background motion with a trapezoidal speed ramp, stepped by run():
+    void setTickRate(unsigned long ticks_per_second);
+    void setMaxSpeed(unsigned long steps_per_second);
+    void setAcceleration(unsigned long steps_per_second_per_second);
+    void moveTo(long absolute);
+    void move(long relative);
+    void stop(void);
+    void run(void);
+    bool isRunning(void);
+    long currentPosition(void);
+    void setCurrentPosition(long position);
+
   private:
     void stepMotor(int this_step);
+    void advance(int dir);
+    void initMotion(void);
+    void updateRamp(bool lock);
 
     int direction;            // Direction of rotation
     unsigned long step_delay; // delay between steps, in ms, based on speed
@@ -115,6 +139,20 @@ class Stepper {
     int motor_pin_5;          // Only 5 phase motor
 
     unsigned long last_step_time; // time stamp in us of when the last step was taken
+
+    // background motion; speeds are in steps per tick, scaled by 2^24
+    unsigned long tick_rate;      // how often run() is called, in Hz
+    unsigned long max_speed;      // steps per second
+    unsigned long acceleration;   // steps per second per second
+    unsigned long speed_max;      // max_speed per tick
+    unsigned long speed_min;      // speed after one step from rest; the ramp starts and ends here
+    unsigned long speed_step;     // acceleration per tick
+    volatile unsigned long speed; // current speed, 0 when stopped
+    unsigned long phase;          // a step is due each time this passes 2^24
+    unsigned long ramp_steps;     // steps taken speeding up, so needed to slow down
+    volatile long position;       // steps from the origin
+    volatile long target;         // position to move to
+    int run_direction;            // 1 or -1 while moving
 };
 
 #endif
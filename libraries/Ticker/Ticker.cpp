@@ -27,6 +27,8 @@
 #include "ets_sys.h"
 #include "osapi.h"
 
+#include <Arduino.h>
+
 static const int ONCE   = 0;
 static const int REPEAT = 1;
 
@@ -53,6 +55,9 @@ void Ticker::_attach_ms(uint32_t milliseconds, bool repeat, callback_with_arg_t
 		_timer = new ETSTimer;
 	}
 
+	_stats.periodUs = milliseconds * 1000;
+	_due_us = micros() + _stats.periodUs;
+
 	os_timer_setfn(_timer, reinterpret_cast<ETSTimerFunc*>(callback), reinterpret_cast<void*>(arg));
 	os_timer_arm(_timer, milliseconds, (repeat)?REPEAT:ONCE);
 }
@@ -80,8 +85,56 @@ void Ticker::_static_callback(void* arg)
 	{
 		return;
 	}
-	if (_this->_callback_function)
+	if (!_this->_callback_function)
+	{
+		return;
+	}
+	if (!_this->_stats_enabled)
 	{
 		_this->_callback_function();
+		return;
 	}
+
+	TickerStats& st = _this->_stats;
+	uint32_t start = micros();
+	int32_t late = (int32_t)(start - _this->_due_us);
+	if (late > 0)
+	{
+		if ((uint32_t)late > st.maxLatenessUs)
+			st.maxLatenessUs = late;
+		// the SDK keeps the repeat grid, so a call more than a period late
+		// means the ones in between never happened
+		if (st.periodUs && (uint32_t)late >= st.periodUs)
+		{
+			uint32_t skipped = late / st.periodUs;
+			st.missed += skipped;
+			_this->_due_us += skipped * st.periodUs;
+		}
+	}
+	_this->_due_us += st.periodUs;
+
+	_this->_callback_function();
+
+	uint32_t duration = micros() - start;
+	st.invocations++;
+	if (duration > st.maxDurationUs)
+		st.maxDurationUs = duration;
+	if (st.periodUs && duration > st.periodUs)
+		st.overruns++;
+}
+
+void Ticker::enableStats(bool enable)
+{
+	if (enable && !_stats_enabled)
+	{
+		resetStats();
+	}
+	_stats_enabled = enable;
+}
+
+void Ticker::resetStats()
+{
+	uint32_t period = _stats.periodUs;
+	_stats = TickerStats();
+	_stats.periodUs = period;
 }
@@ -32,6 +32,20 @@ extern "C" {
 	typedef struct _ETSTIMER_ ETSTimer;
 }
 
+// Timing of the callbacks attached with a std::function (the attach()/once()
+// overloads without an argument), collected while enableStats(true). Times
+// are in microseconds. Ticker callbacks run from the SDK timer task, never in
+// the middle of loop(), so stats() can be read from loop() without locking.
+struct TickerStats
+{
+	uint32_t periodUs;        // period requested in attach()
+	uint32_t invocations;     // callbacks run
+	uint32_t maxLatenessUs;   // worst delay from the due time to the call
+	uint32_t maxDurationUs;   // longest callback
+	uint32_t missed;          // whole periods skipped by late calls
+	uint32_t overruns;        // callbacks that ran longer than the period
+};
+
 class Ticker
 {
 public:
@@ -123,6 +137,10 @@ public:
 	void detach();
 	bool active() const;
 
+	void enableStats(bool enable);
+	const TickerStats& stats() const { return _stats; }
+	void resetStats();
+
 protected:	
 	void _attach_ms(uint32_t milliseconds, bool repeat, callback_with_arg_t callback, uint32_t arg);
 	static void _static_callback (void* arg);
@@ -130,6 +148,9 @@ protected:
 protected:
 	ETSTimer* _timer;
 	callback_function_t _callback_function = nullptr;
+	bool _stats_enabled = false;
+	uint32_t _due_us = 0;
+	TickerStats _stats = {};
 };
 
 
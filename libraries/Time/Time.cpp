@@ -37,13 +37,35 @@
 
 static tmElements_t tm;          // a cache of time elements
 static time_t cacheTime;   // the time the cache was updated
+static uint32_t cacheMidnight;  // start of the cached day
+static bool cacheValid = false;
 static uint32_t syncInterval = 300;  // time sync will be attempted after this many seconds
 
 void refreshCache(time_t t) {
-  if (t != cacheTime) {
-    breakTime(t, tm); 
-    cacheTime = t; 
+  if (cacheValid && t == cacheTime)
+    return;
+  uint32_t secs = (uint32_t)t - cacheMidnight;  // wraps to a large value before the cached day
+  if (!cacheValid || secs >= SECS_PER_DAY) {
+    // another day: the only case that needs the calendar
+    breakTime(t, tm);
+    cacheMidnight = (uint32_t)t - (((tm.Hour * 60U) + tm.Minute) * 60UL + tm.Second);
+    cacheValid = true;
+  } else if ((uint32_t)t == (uint32_t)cacheTime + 1) {
+    // the usual step of a clock being read every second
+    if (++tm.Second == 60) {
+      tm.Second = 0;
+      if (++tm.Minute == 60) {
+        tm.Minute = 0;
+        tm.Hour++;  // still the same day, checked above
+      }
+    }
+  } else {
+    uint16_t mins = secs / 60;
+    tm.Second = secs - mins * 60U;
+    tm.Hour = mins / 60;
+    tm.Minute = mins - tm.Hour * 60U;
   }
+  cacheTime = t;
 }
 
 int hour() { // the hour now 
@@ -143,62 +165,39 @@ int year(time_t t) { // the year for the given time
 /* functions to convert to and from system time */
 /* These are for interfacing with time serivces and are not normally needed in a sketch */
 
-// leap year calulator expects year argument as years offset from 1970
-#define LEAP_YEAR(Y)     ( ((1970+Y)>0) && !((1970+Y)%4) && ( ((1970+Y)%100) || !((1970+Y)%400) ) )
+// Day counts are converted with the era arithmetic of Howard Hinnant's
+// days_from_civil/civil_from_days: years run from March, so the leap day is
+// the last day of the year and no table or loop over years or months is
+// needed. 719468 is the number of days from 0000-03-01 to 1970-01-01.
+#define DAYS_TO_1970     719468UL
+#define DAYS_PER_ERA     146097UL  // 400 years
 
-static  const uint8_t monthDays[]={31,28,31,30,31,30,31,31,30,31,30,31}; // API starts months from 1, this array starts from 0
- 
 void breakTime(time_t timeInput, tmElements_t &tm){
 // break the given time_t into time components
 // this is a more compact version of the C library localtime function
 // note that year is offset from 1970 !!!
 
-  uint8_t year;
-  uint8_t month, monthLength;
   uint32_t time;
-  unsigned long days;
+  uint32_t days;
 
   time = (uint32_t)timeInput;
-  tm.Second = time % 60;
-  time /= 60; // now it is minutes
-  tm.Minute = time % 60;
-  time /= 60; // now it is hours
-  tm.Hour = time % 24;
-  time /= 24; // now it is days
-  tm.Wday = ((time + 4) % 7) + 1;  // Sunday is day 1 
-  
-  year = 0;  
-  days = 0;
-  while((unsigned)(days += (LEAP_YEAR(year) ? 366 : 365)) <= time) {
-    year++;
-  }
-  tm.Year = year; // year is offset from 1970 
-  
-  days -= LEAP_YEAR(year) ? 366 : 365;
-  time  -= days; // now it is days in this year, starting at 0
-  
-  days=0;
-  month=0;
-  monthLength=0;
-  for (month=0; month<12; month++) {
-    if (month==1) { // february
-      if (LEAP_YEAR(year)) {
-        monthLength=29;
-      } else {
-        monthLength=28;
-      }
-    } else {
-      monthLength = monthDays[month];
-    }
-    
-    if (time >= monthLength) {
-      time -= monthLength;
-    } else {
-        break;
-    }
-  }
-  tm.Month = month + 1;  // jan is month 1  
-  tm.Day = time + 1;     // day of month
+  days = time / SECS_PER_DAY;
+  time -= days * SECS_PER_DAY;  // now it is seconds of the day
+  uint16_t mins = time / 60;
+  tm.Second = time - mins * 60U;
+  tm.Hour = mins / 60;
+  tm.Minute = mins - tm.Hour * 60U;
+  tm.Wday = ((days + 4) % 7) + 1;  // Sunday is day 1 
+
+  uint32_t z = days + DAYS_TO_1970;
+  uint32_t era = z / DAYS_PER_ERA;
+  uint32_t doe = z - era * DAYS_PER_ERA;                          // [0, 146096]
+  uint16_t yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365; // [0, 399]
+  uint16_t doy = doe - (365UL*yoe + yoe/4 - yoe/100);             // [0, 365], from March 1st
+  uint8_t mp = (5*doy + 2) / 153;                                 // [0, 11], March is 0
+  tm.Day = doy - (153*mp + 2) / 5 + 1;                            // day of month
+  tm.Month = mp < 10 ? mp + 3 : mp - 9;                           // jan is month 1
+  tm.Year = era * 400 + yoe + (tm.Month <= 2) - 1970;             // year is offset from 1970 
 }
 
 time_t makeTime(tmElements_t &tm){   
@@ -206,26 +205,15 @@ time_t makeTime(tmElements_t &tm){
 // note year argument is offset from 1970 (see macros in time.h to convert to other formats)
 // previous version used full four digit year (or digits since 2000),i.e. 2009 was 2009 or 9
   
-  int i;
-  uint32_t seconds;
+  uint16_t y = tm.Year + 1970 - (tm.Month <= 2);
+  uint16_t era = y / 400;
+  uint16_t yoe = y - era * 400;                                                 // [0, 399]
+  uint16_t doy = (153*(tm.Month > 2 ? tm.Month - 3 : tm.Month + 9) + 2)/5 + tm.Day - 1;  // [0, 365]
+  uint32_t doe = 365UL*yoe + yoe/4 - yoe/100 + doy;                             // [0, 146096]
+  uint32_t days = era * DAYS_PER_ERA + doe - DAYS_TO_1970;
 
-  // seconds from 1970 till 1 jan 00:00:00 of the given year
-  seconds= tm.Year*(SECS_PER_DAY * 365);
-  for (i = 0; i < tm.Year; i++) {
-    if (LEAP_YEAR(i)) {
-      seconds +=  SECS_PER_DAY;   // add extra days for leap years
-    }
-  }
-  
-  // add days for this year, months start from 1
-  for (i = 1; i < tm.Month; i++) {
-    if ( (i == 2) && LEAP_YEAR(tm.Year)) { 
-      seconds += SECS_PER_DAY * 29;
-    } else {
-      seconds += SECS_PER_DAY * monthDays[i-1];  //monthDay array starts from 0
-    }
-  }
-  seconds+= (tm.Day-1) * SECS_PER_DAY;
+  uint32_t seconds;
+  seconds = days * SECS_PER_DAY;
   seconds+= tm.Hour * SECS_PER_HOUR;
   seconds+= tm.Minute * SECS_PER_MIN;
   seconds+= tm.Second;
@@ -286,17 +274,18 @@ void setTime(time_t t) {
 void setTime(int hr,int min,int sec,int dy, int mnth, int yr){
  // year can be given as full four digit year or two digts (2010 or 10 for 2010);  
  //it is converted to years since 1970
+  tmElements_t te;  // not the cache: cacheTime would no longer match it
   if( yr > 99)
       yr = yr - 1970;
   else
       yr += 30;  
-  tm.Year = yr;
-  tm.Month = mnth;
-  tm.Day = dy;
-  tm.Hour = hr;
-  tm.Minute = min;
-  tm.Second = sec;
-  setTime(makeTime(tm));
+  te.Year = yr;
+  te.Month = mnth;
+  te.Day = dy;
+  te.Hour = hr;
+  te.Minute = min;
+  te.Second = sec;
+  setTime(makeTime(te));
 }
 
 void adjustTime(long adjustment) {
@@ -18,6 +18,26 @@
 
 #define TINY_GSM_MUX_COUNT 5
 
+// Most +CIPRXGET=2 hands out at once
+#if !defined(TINY_GSM_RX_CHUNK)
+  #define TINY_GSM_RX_CHUNK 1460
+#endif
+
+#if defined(TINY_GSM_ASYNC)
+  // Commands queued ahead of the one in flight, counting it
+  #if !defined(TINY_GSM_AT_QUEUE)
+    #define TINY_GSM_AT_QUEUE 4
+  #endif
+  // Longest command, without "AT" and the line end
+  #if !defined(TINY_GSM_AT_CMD_MAX)
+    #define TINY_GSM_AT_CMD_MAX 64
+  #endif
+  // Longer response lines are cut
+  #if !defined(TINY_GSM_AT_LINE)
+    #define TINY_GSM_AT_LINE 64
+  #endif
+#endif
+
 #include <TinyGsmCommon.h>
 
 #define GSM_NL "\r\n"
@@ -69,6 +89,9 @@ public:
     prev_check = 0;
     sock_connected = false;
     got_data = false;
+#if defined(TINY_GSM_ASYNC)
+    rx_pending = false;
+#endif
 
     at->sockets[mux] = this;
 
@@ -146,13 +169,23 @@ public:
         cnt += chunk;
         continue;
       }
-      // TODO: Read directly into user buffer?
+#if defined(TINY_GSM_ASYNC)
+      break;  // the rest comes in through poll()
+#else
       at->maintain();
-      if (sock_available > 0) {
-        at->modemRead(rx.free(), mux);
-      } else {
+      if (sock_available == 0) {
         break;
       }
+      // a request the FIFO couldn't hold goes straight to the caller's
+      // buffer, in as few +CIPRXGET as the modem allows
+      if (size - cnt >= (size_t)rx.free()) {
+        size_t len = at->modemRead(size - cnt, mux, buf);
+        buf += len;
+        cnt += len;
+      } else {
+        at->modemRead(rx.free(), mux);
+      }
+#endif
     }
     return cnt;
   }
@@ -189,6 +222,9 @@ private:
   uint32_t       prev_check;
   bool           sock_connected;
   bool           got_data;
+#if defined(TINY_GSM_ASYNC)
+  bool           rx_pending;  // a +CIPRXGET for it is queued
+#endif
   RxFifo         rx;
 };
 
@@ -217,6 +253,17 @@ public:
     : stream(stream)
   {
     memset(sockets, 0, sizeof(sockets));
+#if defined(TINY_GSM_ASYNC)
+    at_head = 0;
+    at_queued = 0;
+    at_busy = false;
+    at_prompted = false;
+    at_line_len = 0;
+    at_rx_left = 0;
+    at_rx_nibble = -1;
+    urc_callback = NULL;
+    memset(connect_callback, 0, sizeof(connect_callback));
+#endif
   }
 
   /*
@@ -258,6 +305,9 @@ public:
   }
 
   void maintain() {
+#if defined(TINY_GSM_ASYNC)
+    poll();
+#else
     for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
       GsmClient* sock = sockets[mux];
       if (sock && sock->got_data) {
@@ -268,6 +318,7 @@ public:
     while (stream.available()) {
       waitResponse(10, NULL, NULL);
     }
+#endif
   }
 
   bool factoryDefault() {
@@ -827,7 +878,9 @@ protected:
     return stream.readStringUntil('\n').toInt();
   }
 
-  size_t modemRead(size_t size, uint8_t mux) {
+  // Into dst if given, else into the socket's FIFO
+  size_t modemRead(size_t size, uint8_t mux, uint8_t* dst = NULL) {
+    size = TinyGsmMin(size, (size_t)TINY_GSM_RX_CHUNK);
 #ifdef TINY_GSM_USE_HEX
     sendAT(GF("+CIPRXGET=3,"), mux, ',', size);
     if (waitResponse(GF("+CIPRXGET:")) != 1) {
@@ -844,21 +897,48 @@ protected:
     size_t len = stream.readStringUntil(',').toInt();
     sockets[mux]->sock_available = stream.readStringUntil('\n').toInt();
 
-    for (size_t i=0; i<len; i++) {
+    size_t got = 0;
+    while (got < len) {
+      uint8_t chunk[32];
+      uint8_t* p = dst ? dst + got : chunk;
+      size_t n = TinyGsmMin(len - got, dst ? len - got : sizeof(chunk));
+      n = streamReadData(p, n);
+      if (!n) {
+        break;
+      }
+      if (!dst) {
+        sockets[mux]->rx.put(chunk, n);
+      }
+      got += n;
+    }
+    waitResponse();
+    return got;
+  }
+
+  // Socket data as the modem sends it, decoded from hex if need be
+  size_t streamReadData(uint8_t* buf, size_t len, const unsigned long timeout = 3000L) {
+    size_t n = 0;
+    unsigned long startMillis = millis();
+    while (n < len && millis() - startMillis < timeout) {
 #ifdef TINY_GSM_USE_HEX
-      while (stream.available() < 2) { TINY_GSM_YIELD(); }
-      char buf[4] = { 0, };
-      buf[0] = stream.read();
-      buf[1] = stream.read();
-      char c = strtol(buf, NULL, 16);
+      if (stream.available() < 2) {
+        TINY_GSM_YIELD();
+        continue;
+      }
+      char hex[4] = { 0, };
+      hex[0] = stream.read();
+      hex[1] = stream.read();
+      buf[n++] = strtol(hex, NULL, 16);
 #else
-      while (!stream.available()) { TINY_GSM_YIELD(); }
-      char c = stream.read();
+      int avail = stream.available();
+      if (avail <= 0) {
+        TINY_GSM_YIELD();
+        continue;
+      }
+      n += stream.readBytes(buf + n, TinyGsmMin(len - n, (size_t)avail));
 #endif
-      sockets[mux]->rx.put(c);
     }
-    waitResponse();
-    return len;
+    return n;
   }
 
   size_t modemGetAvailable(uint8_t mux) {
@@ -912,6 +992,9 @@ public:
 
   template<typename... Args>
   void sendAT(Args... cmd) {
+#if defined(TINY_GSM_ASYNC)
+    asyncSettle();
+#endif
     streamWrite("AT", cmd..., GSM_NL);
     stream.flush();
     TINY_GSM_YIELD();
@@ -1001,6 +1084,383 @@ finish:
     return waitResponse(1000, r1, r2, r3, r4, r5);
   }
 
+#if defined(TINY_GSM_ASYNC)
+
+  /*
+   * Asynchronous AT commands
+   *
+   * queueAT() only stores the command; poll() writes it out once the one
+   * before it has its final result, and hands every response line to the
+   * command's callback as it arrives. Socket data is pulled the same way,
+   * so with TINY_GSM_ASYNC the GsmClient calls never wait on the modem,
+   * except write() and connect(), which still use the blocking commands.
+   *
+   * A blocking command first lets the one in flight finish; the queued
+   * ones go after it. Callbacks run inside poll() and must not call the
+   * blocking functions while they get AT_LINE.
+   */
+
+  enum AtResult {
+    AT_LINE    = 0,  // a response line, not the final one
+    AT_OK      = 1,
+    AT_ERROR   = 2,
+    AT_TIMEOUT = 3,
+  };
+
+  typedef void (*AtCallback)(void* ctx, uint8_t result, const char* line);
+  typedef void (*UrcCallback)(const char* line);
+
+  struct AtCommand {
+    char           cmd[TINY_GSM_AT_CMD_MAX];
+    const char*    ok;       // a line containing it ends the command, NULL: "OK"
+    const char*    fail;     // same for AT_ERROR, NULL: "ERROR"
+    const uint8_t* payload;  // written at the '>' prompt, kept until the callback
+    size_t         length;
+    uint32_t       timeout;
+    AtCallback     callback;
+    void*          ctx;
+  };
+
+  // Queues a command, given as to sendAT(). The entry returned can still
+  // be changed (matchers, timeout, payload) until the next poll(); NULL
+  // means the queue is full or the command too long.
+  template<typename... Args>
+  AtCommand* queueAT(AtCallback callback, void* ctx, Args... cmd) {
+    if (at_queued >= TINY_GSM_AT_QUEUE) {
+      return NULL;
+    }
+    AtCommand& c = at_queue[(at_head + at_queued) % TINY_GSM_AT_QUEUE];
+    AtPrinter p(c.cmd, sizeof(c.cmd));
+    printAll(p, cmd...);
+    if (p.overflow) {
+      return NULL;
+    }
+    c.ok = NULL;
+    c.fail = NULL;
+    c.payload = NULL;
+    c.length = 0;
+    c.timeout = 1000L;
+    c.callback = callback;
+    c.ctx = ctx;
+    at_queued++;
+    return &c;
+  }
+
+  // Lines no command is waiting for and that TinyGSM doesn't handle itself
+  void onUrc(UrcCallback callback) {
+    urc_callback = callback;
+  }
+
+  // Commands not yet answered, counting the one in flight
+  uint8_t queuedAT() const {
+    return at_queued;
+  }
+
+  // GsmClient::connect() without the wait: the socket is open once the
+  // callback gets AT_OK. host must stay valid until the command is sent.
+  AtCommand* queueConnect(GsmClient& client, const char* host, uint16_t port,
+                          AtCallback callback = NULL, void* ctx = NULL)
+  {
+#if !defined(TINY_GSM_MODEM_SIM900)
+    const uint8_t needed = 2;
+#else
+    const uint8_t needed = 1;
+#endif
+    if (TINY_GSM_AT_QUEUE - at_queued < needed) {
+      return NULL;
+    }
+    client.sock_connected = false;
+    client.rx.clear();
+#if !defined(TINY_GSM_MODEM_SIM900)
+    queueAT(NULL, NULL, GF("+CIPSSL=0"));
+#endif
+    AtCommand* c = queueAT(asyncConnectDone, &client, GF("+CIPSTART="), client.mux, ',',
+                           GF("\"TCP"), GF("\",\""), host, GF("\","), port);
+    if (!c) {
+      return NULL;
+    }
+    c->ok = "CONNECT OK";
+    c->fail = "CONNECT FAIL";
+    c->timeout = 75000L;
+    connect_callback[client.mux] = callback;
+    connect_ctx[client.mux] = ctx;
+    return c;
+  }
+
+  // Takes in what the modem has written and sends the next command,
+  // waiting for neither. Call it from loop().
+  void poll() {
+    asyncReceive();
+    asyncCheckTimeout();
+    asyncScheduleSockets();
+    asyncStart();
+  }
+
+protected:
+
+  class AtPrinter : public Print {
+  public:
+    AtPrinter(char* buf, size_t size)
+      : buf(buf), size(size), len(0), overflow(false)
+    {
+      buf[0] = '\0';
+    }
+
+    virtual size_t write(uint8_t c) {
+      if (len + 1 >= size) {
+        overflow = true;
+        return 0;
+      }
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+
+    char*  buf;
+    size_t size;
+    size_t len;
+    bool   overflow;
+  };
+
+  static void printAll(Print&) {}
+
+  template<typename T, typename... Args>
+  static void printAll(Print& p, T head, Args... tail) {
+    p.print(head);
+    printAll(p, tail...);
+  }
+
+  // Keeps each socket's FIFO topped up: asks how much is waiting when the
+  // modem says there is data, then pulls as much as the FIFO takes
+  void asyncScheduleSockets() {
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClient* sock = sockets[mux];
+      if (!sock || sock->rx_pending) {
+        continue;
+      }
+      if (sock->got_data) {
+        if (queueAT(asyncSocketDone, sock, GF("+CIPRXGET=4,"), mux)) {
+          sock->got_data = false;
+          sock->rx_pending = true;
+        }
+      } else if (sock->sock_available > 0 && sock->rx.free() > 0) {
+        size_t size = TinyGsmMin((size_t)sock->rx.free(), (size_t)sock->sock_available);
+        size = TinyGsmMin(size, (size_t)TINY_GSM_RX_CHUNK);
+#ifdef TINY_GSM_USE_HEX
+        AtCommand* c = queueAT(asyncSocketDone, sock, GF("+CIPRXGET=3,"), mux, ',', size);
+#else
+        AtCommand* c = queueAT(asyncSocketDone, sock, GF("+CIPRXGET=2,"), mux, ',', size);
+#endif
+        if (c) {
+          c->timeout = 5000L;
+          sock->rx_pending = true;
+        }
+      }
+    }
+  }
+
+  static void asyncSocketDone(void* ctx, uint8_t result, const char*) {
+    if (result != AT_LINE) {
+      static_cast<GsmClient*>(ctx)->rx_pending = false;
+    }
+  }
+
+  static void asyncConnectDone(void* ctx, uint8_t result, const char* line) {
+    GsmClient* sock = static_cast<GsmClient*>(ctx);
+    if (result == AT_LINE) {
+      return;
+    }
+    sock->sock_connected = (result == AT_OK);
+    AtCallback callback = sock->at->connect_callback[sock->mux];
+    if (callback) {
+      callback(sock->at->connect_ctx[sock->mux], result, line);
+    }
+  }
+
+  void asyncStart() {
+    if (at_busy || !at_queued) {
+      return;
+    }
+    streamWrite("AT", at_queue[at_head].cmd, GSM_NL);
+    stream.flush();
+    at_busy = true;
+    at_prompted = false;
+    at_started = millis();
+  }
+
+  void asyncReceive() {
+    while (stream.available() > 0) {
+      int a = stream.read();
+      if (a < 0) {
+        break;
+      }
+      if (at_rx_left) {
+        asyncData(a);
+        continue;
+      }
+      if (a == '\n') {
+        at_line[at_line_len] = '\0';
+        at_line_len = 0;
+        if (at_line[0]) {
+          asyncLine(at_line);
+        }
+        continue;
+      }
+      if (a == '\r' || a == 0 || (a == ' ' && !at_line_len)) {
+        continue;
+      }
+      if (at_line_len < sizeof(at_line) - 1) {
+        at_line[at_line_len++] = a;
+      }
+      // the send prompt has no line end
+      if (a == '>' && at_line_len == 1 && at_busy && !at_prompted &&
+          at_queue[at_head].payload)
+      {
+        stream.write(at_queue[at_head].payload, at_queue[at_head].length);
+        stream.flush();
+        at_prompted = true;
+        at_line_len = 0;
+      }
+    }
+  }
+
+  // Socket data after "+CIPRXGET: 2", straight into the socket's FIFO
+  void asyncData(int a) {
+#ifdef TINY_GSM_USE_HEX
+    char buf[4] = { (char)at_rx_nibble, (char)a, 0, 0 };
+    if (at_rx_nibble < 0) {
+      at_rx_nibble = a;
+      return;
+    }
+    at_rx_nibble = -1;
+    uint8_t c = strtol(buf, NULL, 16);
+#else
+    uint8_t c = a;
+#endif
+    GsmClient* sock = sockets[at_rx_mux];
+    if (sock) {
+      sock->rx.put(c);
+    }
+    at_rx_left--;
+  }
+
+  void asyncLine(const char* line) {
+    if (asyncUrc(line)) {
+      return;
+    }
+    if (!at_busy) {
+      if (urc_callback) {
+        urc_callback(line);
+      }
+      return;
+    }
+
+    const AtCommand& c = at_queue[at_head];
+    uint8_t result = AT_LINE;
+    if (c.ok ? strstr(line, c.ok) != NULL : !strcmp(line, "OK")) {
+      result = AT_OK;
+    } else if (c.fail ? strstr(line, c.fail) != NULL : !strcmp(line, "ERROR")) {
+      result = AT_ERROR;
+    } else if (!strncmp(line, "+CME ERROR:", 11) || !strcmp(line, "ERROR")) {
+      result = AT_ERROR;
+    }
+
+    if (result == AT_LINE) {
+      if (c.callback) {
+        c.callback(c.ctx, result, line);
+      }
+      return;
+    }
+    asyncFinish(result, line);
+  }
+
+  // What the blocking waitResponse() handles on its own; true if the line
+  // is used up
+  bool asyncUrc(const char* line) {
+    if (!strncmp(line, "+CIPRXGET:", 10)) {
+      char* p;
+      int mode = strtol(line + 10, &p, 10);
+      int mux = (*p == ',') ? strtol(p + 1, &p, 10) : -1;
+      GsmClient* sock = (mux >= 0 && mux < TINY_GSM_MUX_COUNT) ? sockets[mux] : NULL;
+      if (mode == 1) {
+        if (sock) {
+          sock->got_data = true;
+        }
+        return true;
+      }
+      if (mode == 4 && sock && *p == ',') {
+        sock->sock_available = strtol(p + 1, NULL, 10);
+      } else if ((mode == 2 || mode == 3) && *p == ',') {
+        size_t len = strtol(p + 1, &p, 10);
+        if (sock && *p == ',') {
+          sock->sock_available = strtol(p + 1, NULL, 10);
+        }
+        at_rx_left = len;
+        at_rx_mux = mux >= 0 && mux < TINY_GSM_MUX_COUNT ? mux : 0;
+        at_rx_nibble = -1;
+      }
+      return false;
+    }
+
+    size_t len = strlen(line);
+    if (len > 8 && !strcmp(line + len - 8, ", CLOSED") && line[0] >= '0' && line[0] <= '9') {
+      int mux = atoi(line);
+      if (mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        sockets[mux]->sock_connected = false;
+      }
+      DBG("### Closed: ", mux);
+      return true;
+    }
+    return false;
+  }
+
+  void asyncCheckTimeout() {
+    if (at_busy && millis() - at_started > at_queue[at_head].timeout) {
+      at_rx_left = 0;
+      at_line_len = 0;
+      asyncFinish(AT_TIMEOUT, "");
+    }
+  }
+
+  // Frees the entry before the callback, which may then queue more or
+  // use the blocking functions
+  void asyncFinish(uint8_t result, const char* line) {
+    AtCallback callback = at_queue[at_head].callback;
+    void* ctx = at_queue[at_head].ctx;
+    at_head = (at_head + 1) % TINY_GSM_AT_QUEUE;
+    at_queued--;
+    at_busy = false;
+    if (callback) {
+      callback(ctx, result, line);
+    }
+  }
+
+  // Before a blocking command: lets the command in flight finish
+  void asyncSettle() {
+    while (at_busy) {
+      TINY_GSM_YIELD();
+      asyncReceive();
+      asyncCheckTimeout();
+    }
+  }
+
+  AtCommand     at_queue[TINY_GSM_AT_QUEUE];
+  uint8_t       at_head;
+  uint8_t       at_queued;
+  bool          at_busy;      // at_queue[at_head] is written, no final result yet
+  bool          at_prompted;  // and its payload too
+  uint32_t      at_started;
+  char          at_line[TINY_GSM_AT_LINE];
+  uint8_t       at_line_len;
+  size_t        at_rx_left;   // socket data bytes still to come
+  uint8_t       at_rx_mux;
+  int           at_rx_nibble;
+  UrcCallback   urc_callback;
+  AtCallback    connect_callback[TINY_GSM_MUX_COUNT];
+  void*         connect_ctx[TINY_GSM_MUX_COUNT];
+
+#endif
+
 public:
   Stream&       stream;
 
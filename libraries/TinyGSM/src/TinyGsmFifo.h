@@ -1,6 +1,23 @@
 #ifndef TinyGsmFifo_h
 #define TinyGsmFifo_h
 
+#include <stdint.h>
+#include <string.h>
+
+// Single producer, single consumer; either side may be an interrupt
+// handler. Each index is written by one side only, and is stored after
+// the data it covers with TINY_GSM_FIFO_FENCE() in between.
+#if defined(ESP32) || defined(__linux__)
+  // several cores: a real barrier, so no core sees the index first
+  #define TINY_GSM_FIFO_FENCE() __sync_synchronize()
+#else
+  // single core: keeping the compiler from reordering is enough
+  #define TINY_GSM_FIFO_FENCE() __asm__ __volatile__("" ::: "memory")
+#endif
+
+template <bool Small> struct TinyGsmFifoIndex       { typedef unsigned type; };
+template <>           struct TinyGsmFifoIndex<true> { typedef uint8_t  type; };
+
 template <class T, unsigned N>
 class TinyGsmFifo
 {
@@ -10,6 +27,7 @@ public:
         clear();
     }
 
+    // only while neither side is using the FIFO
     void clear()
     {
         _r = 0;
@@ -26,7 +44,7 @@ public:
 
     int free(void)
     {
-        int s = _r - _w;
+        int s = int(_r) - int(_w);
         if (s <= 0)
             s += N;
         return s - 1;
@@ -34,12 +52,12 @@ public:
 
     bool put(const T& c)
     {
-        int i = _w;
-        int j = i;
-        i = _inc(i);
+        const Index w = _w;
+        const Index i = _inc(w);
         if (i == _r) // !writeable()
             return false;
-        _b[j] = c;
+        _b[w] = c;
+        TINY_GSM_FIFO_FENCE();
         _w = i;
         return true;
     }
@@ -57,11 +75,12 @@ public:
             }
             // check free space
             if (c < f) f = c;
-            int w = _w;
+            const Index w = _w;
             int m = N - w;
             // check wrap
             if (f > m) f = m;
-            memcpy(&_b[w], p, f);
+            memcpy(&_b[w], p, f * sizeof(T));
+            TINY_GSM_FIFO_FENCE();
             _w = _inc(w, f);
             c -= f;
             p += f;
@@ -79,7 +98,7 @@ public:
 
     size_t size(void)
     {
-        int s = _w - _r;
+        int s = int(_w) - int(_r);
         if (s < 0)
             s += N;
         return s;
@@ -87,10 +106,12 @@ public:
 
     bool get(T* p)
     {
-        int r = _r;
+        const Index r = _r;
         if (r == _w) // !readable()
             return false;
+        TINY_GSM_FIFO_FENCE();
         *p = _b[r];
+        TINY_GSM_FIFO_FENCE();
         _r = _inc(r);
         return true;
     }
@@ -108,13 +129,15 @@ public:
                 if (!t) return n - c; // no space and not blocking
                 /* nothing / just wait */;
             }
+            TINY_GSM_FIFO_FENCE();
             // check available data
             if (c < f) f = c;
-            int r = _r;
+            const Index r = _r;
             int m = N - r;
             // check wrap
             if (f > m) f = m;
-            memcpy(p, &_b[r], f);
+            memcpy(p, &_b[r], f * sizeof(T));
+            TINY_GSM_FIFO_FENCE();
             _r = _inc(r, f);
             c -= f;
             p += f;
@@ -123,14 +146,20 @@ public:
     }
 
 private:
-    int _inc(int i, int n = 1)
+    // one byte when it can be: read and written in a single access even
+    // on 8-bit parts
+    typedef typename TinyGsmFifoIndex<(N <= 256)>::type Index;
+
+    // a mask for power-of-two sizes, a compare otherwise; never a division
+    static Index _inc(unsigned i, unsigned n = 1)
     {
-        return (i + n) % N;
+        return ((N & (N - 1)) == 0) ? Index((i + n) & (N - 1))
+                                    : Index((i + n >= N) ? i + n - N : i + n);
     }
 
-    T    _b[N];
-    int  _w;
-    int  _r;
+    T               _b[N];
+    volatile Index  _w;     // written by the producer only
+    volatile Index  _r;     // written by the consumer only
 };
 
 #endif
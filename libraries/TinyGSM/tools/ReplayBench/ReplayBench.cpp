@@ -0,0 +1,504 @@
+/**
+ * @file       ReplayBench.cpp
+ * @license    LGPL-3.0
+ * @brief      Replays an AT trace through a TinyGsmClient on the host
+ *
+ * The modem is a Stream that plays the trace back: each command the
+ * library writes must be the next one the trace expects, and the answer
+ * that follows it in the trace is what the library gets to read. A command
+ * the trace doesn't expect stops the run, so a trace is also a check that
+ * the command sequence hasn't changed.
+ *
+ * Per scenario (connect, send, receive) it reports:
+ *
+ *   cmds      AT commands sent, i.e. round trips to a real modem
+ *   rx/calls  bytes the library read from the modem, and in how many
+ *             read()/readBytes() calls
+ *   tx        bytes written to the modem
+ *   us        host time per run, the fake modem's own work included
+ *
+ * One binary per modem, since a build picks one with TINY_GSM_MODEM_*.
+ *
+ * Usage: ReplayBench_<modem> <trace> [runs]
+ *        REPLAY_VERBOSE=1 lists the commands as they are matched
+ */
+
+#include <stdarg.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include <TinyGsmClient.h>
+
+#if defined(TINY_GSM_MODEM_SIM800)
+  #define MODEM_NAME "SIM800"
+#elif defined(TINY_GSM_MODEM_BG96)
+  #define MODEM_NAME "BG96"
+#elif defined(TINY_GSM_MODEM_UBLOX)
+  #define MODEM_NAME "UBLOX"
+#else
+  #define MODEM_NAME "?"
+#endif
+
+unsigned long host_millis = 0;
+
+// REPLAY_VERBOSE set: every command as it's matched, on stderr
+static bool verbose = false;
+
+// How long a library may wait on the trace, in fake milliseconds
+#define STALL_MS 200000UL
+
+static uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+// The server's data: a pattern the receiver can check byte by byte
+static uint8_t pattern(size_t i)
+{
+    return uint8_t(i * 7 + (i >> 8) + 3);
+}
+
+struct Step {
+    enum Kind { EXPECT, EXPECT_RAW, ANSWER, ANSWER_RAW, DATA, POOL, LOOP, END, SCENARIO };
+
+    Kind        kind;
+    std::string text;
+    size_t      count;
+    int         line;
+};
+
+static std::string unescape(const std::string& s)
+{
+    std::string res;
+    for (size_t i = 0; i < s.size(); i++) {
+        if (s[i] != '\\' || i + 1 == s.size()) {
+            res += s[i];
+            continue;
+        }
+        switch (s[++i]) {
+        case 'r': res += '\r'; break;
+        case 'n': res += '\n'; break;
+        default:  res += s[i]; break;
+        }
+    }
+    return res;
+}
+
+static bool loadTrace(const char* path, std::vector<Step>& steps)
+{
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char buf[512];
+    int line = 0;
+    while (fgets(buf, sizeof(buf), f)) {
+        line++;
+        std::string l(buf);
+        while (!l.empty() && (l.back() == '\n' || l.back() == '\r')) {
+            l.pop_back();
+        }
+        if (l.empty() || l[0] == '#') {
+            continue;
+        }
+
+        Step s = { Step::EXPECT, "", 0, line };
+        if (!l.compare(0, 3, ">~ ")) {
+            s.kind = Step::EXPECT_RAW;
+            s.count = atol(l.c_str() + 3);
+        } else if (!l.compare(0, 2, "> ")) {
+            s.kind = Step::EXPECT;
+            s.text = l.substr(2);
+        } else if (l == "<~") {
+            s.kind = Step::DATA;
+        } else if (!l.compare(0, 3, "<| ")) {
+            s.kind = Step::ANSWER_RAW;
+            s.text = unescape(l.substr(3));
+        } else if (!l.compare(0, 2, "< ")) {
+            s.kind = Step::ANSWER;
+            s.text = l.substr(2);
+        } else if (!l.compare(0, 5, "pool ")) {
+            s.kind = Step::POOL;
+            s.count = atol(l.c_str() + 5);
+        } else if (l == "loop") {
+            s.kind = Step::LOOP;
+        } else if (l == "end") {
+            s.kind = Step::END;
+        } else if (!l.compare(0, 9, "scenario ")) {
+            s.kind = Step::SCENARIO;
+            s.text = l.substr(9);
+        } else {
+            fprintf(stderr, "%s:%d: can't parse '%s'\n", path, line, l.c_str());
+            fclose(f);
+            return false;
+        }
+        steps.push_back(s);
+    }
+    fclose(f);
+    return true;
+}
+
+class ReplayStream : public Stream
+{
+public:
+    struct Counters {
+        size_t commands;
+        size_t rx_bytes;
+        size_t rx_calls;
+        size_t tx_bytes;
+    };
+
+    ReplayStream(const std::vector<Step>& steps, const char* path)
+        : steps(steps), path(path)
+    {
+        rewind();
+    }
+
+    void rewind() {
+        pc = 0;
+        pool = 0;
+        n = 0;
+        left = 0;
+        data_pos = 0;
+        raw_got = 0;
+        loop_pc = 0;
+        out.clear();
+        out_pos = 0;
+        line.clear();
+        idle = 0;
+    }
+
+    // Positions the trace on a scenario and sends what the modem says
+    // before the library's first command; false if there is none
+    bool begin(const std::string& scenario) {
+        for (; pc < steps.size(); pc++) {
+            if (steps[pc].kind == Step::SCENARIO && steps[pc].text == scenario) {
+                pc++;
+                memset(&count, 0, sizeof(count));
+                stall_from = host_millis;
+                play();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The library is done with the scenario: nothing may be left unsaid
+    void finish(const char* scenario) {
+        if (pc < steps.size() && steps[pc].kind != Step::SCENARIO) {
+            fail(steps[pc].line, "%s: the library stopped early", scenario);
+        }
+    }
+
+    size_t poolSize() const { return pool; }
+    size_t dataSent() const { return data_pos; }
+    const Counters& counters() const { return count; }
+
+    void stalled(const char* scenario) {
+        if (host_millis - stall_from > STALL_MS) {
+            fail(pc < steps.size() ? steps[pc].line : 0, "%s: the library is stuck", scenario);
+        }
+    }
+
+    /* Stream, as the library sees the modem */
+
+    virtual int available() {
+        int avail = int(out.size() - out_pos);
+        // asking again with nothing in between is waiting: let time pass
+        if (!avail && idle++) {
+            host_millis++;
+            stalled("waiting");
+        }
+        return avail;
+    }
+
+    virtual int read() {
+        if (out_pos == out.size()) {
+            return -1;
+        }
+        count.rx_bytes++;
+        count.rx_calls++;
+        return (uint8_t)out[out_pos++];
+    }
+
+    virtual size_t readBytes(uint8_t* buf, size_t length) {
+        count.rx_calls++;
+        size_t size = std::min(length, out.size() - out_pos);
+        memcpy(buf, out.data() + out_pos, size);
+        out_pos += size;
+        count.rx_bytes += size;
+        if (size < length) {
+            return size + Stream::readBytes(buf + size, length - size);
+        }
+        return size;
+    }
+
+    virtual int peek() {
+        return out_pos == out.size() ? -1 : (uint8_t)out[out_pos];
+    }
+
+    virtual size_t write(uint8_t c) {
+        count.tx_bytes++;
+        idle = 0;
+        if (pc < steps.size() && steps[pc].kind == Step::EXPECT_RAW) {
+            if (++raw_got == steps[pc].count) {
+                raw_got = 0;
+                pc++;
+                play();
+            }
+            return 1;
+        }
+        line += (char)c;
+        if (line.size() >= 2 && !line.compare(line.size() - 2, 2, "\r\n")) {
+            line.resize(line.size() - 2);
+            command(line);
+            line.clear();
+        }
+        return 1;
+    }
+
+    using Print::write;
+
+private:
+    void command(const std::string& cmd) {
+        if (pc >= steps.size() || steps[pc].kind != Step::EXPECT) {
+            fail(pc < steps.size() ? steps[pc].line : 0, "unexpected '%s'", cmd.c_str());
+        }
+        if (!match(steps[pc].text, cmd)) {
+            fail(steps[pc].line, "expected '%s', got '%s'", steps[pc].text.c_str(), cmd.c_str());
+        }
+        count.commands++;
+        if (verbose) {
+            fprintf(stderr, "%6lu ms  %s\n", host_millis, cmd.c_str());
+        }
+        stall_from = host_millis;
+        pc++;
+        play();
+    }
+
+    // '{n}' takes a number, '*' at the end anything
+    bool match(const std::string& pat, const std::string& cmd) {
+        size_t i = 0, j = 0;
+        while (i < pat.size()) {
+            if (pat[i] == '*' && i + 1 == pat.size()) {
+                return true;
+            }
+            if (!pat.compare(i, 3, "{n}")) {
+                size_t start = j;
+                while (j < cmd.size() && cmd[j] >= '0' && cmd[j] <= '9') {
+                    j++;
+                }
+                if (start == j) {
+                    return false;
+                }
+                n = std::min((size_t)atol(cmd.c_str() + start), pool);
+                left = pool - n;
+                i += 3;
+                continue;
+            }
+            if (j >= cmd.size() || pat[i] != cmd[j]) {
+                return false;
+            }
+            i++;
+            j++;
+        }
+        return j == cmd.size();
+    }
+
+    std::string subst(const std::string& s) {
+        std::string res;
+        for (size_t i = 0; i < s.size(); i++) {
+            if (!s.compare(i, 3, "{n}")) {
+                res += std::to_string(n);
+                i += 2;
+            } else if (!s.compare(i, 6, "{left}")) {
+                res += std::to_string(left);
+                i += 5;
+            } else if (!s.compare(i, 6, "{pool}")) {
+                res += std::to_string(pool);
+                i += 5;
+            } else {
+                res += s[i];
+            }
+        }
+        return res;
+    }
+
+    // The modem's side, up to the next thing the library has to send
+    void play() {
+        if (out_pos == out.size()) {
+            out.clear();
+            out_pos = 0;
+        }
+        while (pc < steps.size()) {
+            const Step& s = steps[pc];
+            switch (s.kind) {
+            case Step::ANSWER:
+                out += "\r\n" + subst(s.text) + "\r\n";
+                break;
+            case Step::ANSWER_RAW:
+                out += subst(s.text);
+                break;
+            case Step::DATA:
+                for (size_t i = 0; i < n; i++) {
+                    out += (char)pattern(data_pos++);
+                }
+                pool -= n;
+                n = 0;
+                break;
+            case Step::POOL:
+                pool = s.count;
+                break;
+            case Step::LOOP:
+                if (!pool) {
+                    while (pc < steps.size() && steps[pc].kind != Step::END) {
+                        pc++;
+                    }
+                } else {
+                    loop_pc = pc;
+                }
+                break;
+            case Step::END:
+                if (pool) {
+                    pc = loop_pc;
+                }
+                break;
+            default:
+                return;
+            }
+            pc++;
+        }
+    }
+
+    void fail(int at, const char* fmt, ...) __attribute__((format(printf, 3, 4))) {
+        va_list ap;
+        va_start(ap, fmt);
+        fprintf(stderr, "%s:%d: ", path, at);
+        vfprintf(stderr, fmt, ap);
+        fprintf(stderr, "\n");
+        va_end(ap);
+        exit(1);
+    }
+
+    const std::vector<Step>& steps;
+    const char*   path;
+    size_t        pc;
+    size_t        pool;
+    size_t        n;
+    size_t        left;
+    size_t        data_pos;
+    size_t        raw_got;
+    size_t        loop_pc;
+    std::string   out;
+    size_t        out_pos;
+    std::string   line;
+    unsigned      idle;
+    unsigned long stall_from;
+    Counters      count;
+};
+
+struct Result {
+    ReplayStream::Counters count;
+    uint64_t ns;
+};
+
+static void scenario(ReplayStream& modemStream, TinyGsmClient& client, const char* name, Result& res)
+{
+    if (!modemStream.begin(name)) {
+        return;
+    }
+    uint64_t t0 = now_ns();
+
+    if (!strcmp(name, "connect")) {
+        if (!client.connect("example.com", 80)) {
+            fprintf(stderr, "connect failed\n");
+            exit(1);
+        }
+    } else if (!strcmp(name, "send")) {
+        uint8_t payload[256];
+        for (size_t i = 0; i < sizeof(payload); i++) {
+            payload[i] = i;
+        }
+        if (client.write(payload, sizeof(payload)) != sizeof(payload)) {
+            fprintf(stderr, "send came short\n");
+            exit(1);
+        }
+    } else if (!strcmp(name, "receive")) {
+        const size_t want = modemStream.poolSize();
+        const size_t base = modemStream.dataSent();
+        size_t got = 0;
+        uint8_t buf[512];
+        while (got < want) {
+            if (!client.available()) {
+                modemStream.stalled(name);
+                continue;
+            }
+            int len = client.read(buf, sizeof(buf));
+            for (int i = 0; i < len; i++, got++) {
+                if (buf[i] != pattern(base + got)) {
+                    fprintf(stderr, "receive: byte %u is wrong\n", (unsigned)got);
+                    exit(1);
+                }
+            }
+        }
+    }
+
+    res.ns += now_ns() - t0;
+    const ReplayStream::Counters& c = modemStream.counters();
+    res.count.commands += c.commands;
+    res.count.rx_bytes += c.rx_bytes;
+    res.count.rx_calls += c.rx_calls;
+    res.count.tx_bytes += c.tx_bytes;
+    modemStream.finish(name);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <trace> [runs]\n", argv[0]);
+        return 2;
+    }
+    const char* path = argv[1];
+    verbose = getenv("REPLAY_VERBOSE") != NULL;
+    const int runs = argc > 2 ? atoi(argv[2]) : 1000;
+
+    std::vector<Step> steps;
+    if (!loadTrace(path, steps)) {
+        return 1;
+    }
+
+    static const char* names[] = { "connect", "send", "receive" };
+    const int count = sizeof(names) / sizeof(names[0]);
+    Result results[count];
+    memset(results, 0, sizeof(results));
+
+    for (int r = 0; r < runs; r++) {
+        host_millis = 0;  // every run as if just powered up
+        ReplayStream modemStream(steps, path);
+        TinyGsm modem(modemStream);
+        TinyGsmClient client(modem);
+        for (int i = 0; i < count; i++) {
+            scenario(modemStream, client, names[i], results[i]);
+        }
+    }
+
+    printf("%-7s %-8s %6s %8s %8s %6s %9s\n", "modem", "scenario", "cmds", "rx", "calls", "tx", "us");
+    for (int i = 0; i < count; i++) {
+        const Result& res = results[i];
+        if (!res.count.commands) {
+            continue;
+        }
+        printf("%-7s %-8s %6zu %8zu %8zu %6zu %9.2f\n", MODEM_NAME, names[i],
+               res.count.commands / runs, res.count.rx_bytes / runs,
+               res.count.rx_calls / runs, res.count.tx_bytes / runs,
+               res.ns / 1000.0 / runs);
+    }
+    return 0;
+}
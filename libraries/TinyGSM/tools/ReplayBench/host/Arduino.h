@@ -0,0 +1,206 @@
+/**
+ * @file       Arduino.h
+ * @license    LGPL-3.0
+ * @brief      Just enough of the Arduino core to build TinyGSM on a host
+ *
+ * millis() is a counter the harness owns: delay() moves it forward, and so
+ * does every poll that finds the modem silent, so a library waiting on a
+ * timeout gets there without the harness sleeping.
+ */
+
+#ifndef ReplayBench_Arduino_h
+#define ReplayBench_Arduino_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <string>
+
+typedef uint8_t byte;
+
+#define DEC 10
+#define HEX 16
+
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+
+extern unsigned long host_millis;
+
+static inline unsigned long millis() { return host_millis; }
+static inline void delay(unsigned long ms) { host_millis += ms; }
+
+class String
+{
+public:
+    String() {}
+    String(const char* c) : s(c ? c : "") {}
+    String(char c) : s(1, c) {}
+    String(int v) : s(std::to_string(v)) {}
+    String(unsigned v) : s(std::to_string(v)) {}
+    String(long v) : s(std::to_string(v)) {}
+    String(unsigned long v) : s(std::to_string(v)) {}
+
+    void reserve(size_t n) { s.reserve(n); }
+    unsigned length() const { return s.size(); }
+    const char* c_str() const { return s.c_str(); }
+    char operator[](unsigned i) const { return i < s.size() ? s[i] : 0; }
+
+    String& operator+=(const String& o) { s += o.s; return *this; }
+    String& operator+=(const char* o) { s += o; return *this; }
+    String& operator+=(char c) { s += c; return *this; }
+    String& operator+=(int v) { s += std::to_string(v); return *this; }
+    String& operator+=(unsigned char v) { s += std::to_string(v); return *this; }
+
+    bool operator==(const char* o) const { return s == o; }
+    bool operator==(const String& o) const { return s == o.s; }
+    bool operator!=(const char* o) const { return s != o; }
+
+    bool endsWith(const char* x) const {
+        size_t n = strlen(x);
+        return s.size() >= n && !s.compare(s.size() - n, n, x);
+    }
+    bool endsWith(const String& x) const { return endsWith(x.c_str()); }
+    bool startsWith(const char* x) const { return !s.compare(0, strlen(x), x); }
+
+    int indexOf(char c, unsigned from = 0) const { return pos(s.find(c, from)); }
+    int indexOf(const char* c, unsigned from = 0) const { return pos(s.find(c, from)); }
+    int lastIndexOf(const char* c, int from) const { return pos(s.rfind(c, from)); }
+
+    String substring(unsigned from) const { return from < s.size() ? String(s.substr(from)) : String(); }
+    String substring(unsigned from, unsigned to) const {
+        return from < s.size() ? String(s.substr(from, to - from)) : String();
+    }
+
+    long toInt() const { return atol(s.c_str()); }
+    float toFloat() const { return atof(s.c_str()); }
+
+    void trim() {
+        size_t a = s.find_first_not_of(" \t\r\n");
+        if (a == std::string::npos) {
+            s.clear();
+            return;
+        }
+        s = s.substr(a, s.find_last_not_of(" \t\r\n") - a + 1);
+    }
+
+    void replace(const char* from, const char* to) {
+        size_t n = strlen(from), m = strlen(to);
+        for (size_t p = 0; (p = s.find(from, p)) != std::string::npos; p += m) {
+            s.replace(p, n, to);
+        }
+    }
+
+private:
+    explicit String(const std::string& x) : s(x) {}
+    static int pos(size_t p) { return p == std::string::npos ? -1 : int(p); }
+
+    std::string s;
+};
+
+class Print
+{
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buf, size_t size) {
+        size_t n = 0;
+        while (size--) {
+            n += write(*buf++);
+        }
+        return n;
+    }
+    size_t write(const char* str) { return write((const uint8_t*)str, strlen(str)); }
+    virtual void flush() {}
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(const String& s) { return write(s.c_str()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char v, int base = DEC) { return number(v, base); }
+    size_t print(int v, int base = DEC) { return number(v, base); }
+    size_t print(unsigned v, int base = DEC) { return number(v, base); }
+    size_t print(long v, int base = DEC) { return number(v, base); }
+    size_t print(unsigned long v, int base = DEC) { return number(v, base); }
+    size_t print(double v, int digits = 2) {
+        char buf[40];
+        snprintf(buf, sizeof(buf), "%.*f", digits, v);
+        return write(buf);
+    }
+
+    template <typename T>
+    size_t println(T v) { return print(v) + write("\r\n"); }
+    size_t println() { return write("\r\n"); }
+
+private:
+    size_t number(long v, int base) {
+        char buf[24];
+        snprintf(buf, sizeof(buf), base == HEX ? "%lX" : "%ld", v);
+        return write(buf);
+    }
+};
+
+class Stream : public Print
+{
+public:
+    Stream() : timeout(1000) {}
+
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long ms) { timeout = ms; }
+
+    virtual size_t readBytes(uint8_t* buf, size_t length) {
+        size_t n = 0;
+        for (int c; n < length && (c = timedRead()) >= 0; ) {
+            buf[n++] = c;
+        }
+        return n;
+    }
+    size_t readBytes(char* buf, size_t length) { return readBytes((uint8_t*)buf, length); }
+
+    String readStringUntil(char terminator) {
+        String res;
+        for (int c; (c = timedRead()) >= 0 && c != terminator; ) {
+            res += (char)c;
+        }
+        return res;
+    }
+
+    String readString() {
+        String res;
+        for (int c; (c = timedRead()) >= 0; ) {
+            res += (char)c;
+        }
+        return res;
+    }
+
+protected:
+    int timedRead() {
+        unsigned long start = millis();
+        do {
+            int c = read();
+            if (c >= 0) {
+                return c;
+            }
+            available();  // lets the clock move on
+        } while (millis() - start < timeout);
+        return -1;
+    }
+
+    unsigned long timeout;
+};
+
+class IPAddress
+{
+public:
+    IPAddress() { memset(a, 0, sizeof(a)); }
+    IPAddress(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) { a[0] = b0; a[1] = b1; a[2] = b2; a[3] = b3; }
+    uint8_t operator[](int i) const { return a[i]; }
+    operator uint32_t() const { return a[0] | a[1] << 8 | a[2] << 16 | uint32_t(a[3]) << 24; }
+
+private:
+    uint8_t a[4];
+};
+
+#endif
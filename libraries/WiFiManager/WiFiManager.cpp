@@ -12,6 +12,95 @@
 
 #include "WiFiManager.h"
 
+// Streams a page with chunked transfer encoding, so no page is ever whole
+// in RAM: short pieces are gathered in a WIFI_MANAGER_CHUNK buffer, long
+// PROGMEM ones are sent straight from flash.
+class WiFiManagerPage {
+  public:
+    WiFiManagerPage(ESP8266WebServer &server) : _server(server), _len(0) {
+      _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+      _server.send(200, "text/html", "");
+    }
+
+    void add(const char *text) {
+      add(text, strlen(text));
+    }
+
+    void add(const String &text) {
+      add(text.c_str(), text.length());
+    }
+
+    void add(uint32_t number) {
+      char digits[11];
+      add(digits, snprintf(digits, sizeof(digits), "%u", (unsigned)number));
+    }
+
+    void add_P(PGM_P text) {
+      size_t len = strlen_P(text);
+      if (len > sizeof(_buf) - _len) {
+        flush();
+        _server.sendContent_P(text, len);
+      } else {
+        memcpy_P(_buf + _len, text, len);
+        _len += len;
+      }
+    }
+
+    // PROGMEM text where {k} becomes values[i] for the i-th letter k of
+    // keys, like the String::replace() calls this replaces
+    void addTemplate_P(PGM_P tmpl, const char *keys, const char *const *values) {
+      char c;
+      while ((c = pgm_read_byte(tmpl++))) {
+        if (c == '{') {
+          char k = pgm_read_byte(tmpl);
+          const char *key = k ? strchr(keys, k) : NULL;
+          if (key && pgm_read_byte(tmpl + 1) == '}') {
+            add(values[key - keys]);
+            tmpl += 2;
+            continue;
+          }
+        }
+        if (_len == sizeof(_buf)) {
+          flush();
+        }
+        _buf[_len++] = c;
+      }
+    }
+
+    void end() {
+      flush();
+      _server.sendContent("");   // last chunk
+    }
+
+  private:
+    void add(const char *text, size_t len) {
+      while (len) {
+        if (_len == sizeof(_buf)) {
+          flush();
+        }
+        size_t n = sizeof(_buf) - _len;
+        if (n > len) {
+          n = len;
+        }
+        memcpy(_buf + _len, text, n);
+        _len += n;
+        text += n;
+        len -= n;
+      }
+    }
+
+    void flush() {
+      if (_len) {
+        _server.sendContent_P(_buf, _len);
+        _len = 0;
+      }
+    }
+
+    ESP8266WebServer &_server;
+    char              _buf[WIFI_MANAGER_CHUNK];
+    size_t            _len;
+};
+
 WiFiManagerParameter::WiFiManagerParameter(const char *custom) {
   _id = NULL;
   _placeholder = NULL;
@@ -173,6 +262,23 @@ boolean WiFiManager::autoConnect(char const *apName, char const *apPassword) {
   // attempt to connect; should it fail, fall back to AP
   WiFi.mode(WIFI_STA);
 
+  if (!_configPortalIsBlocking) {
+    _apNameCopy = apName;
+    _apName = _apNameCopy.c_str();
+    _apPassword = apPassword;
+    if (WiFi.status() == WL_CONNECTED) {
+      return true;
+    }
+    // saved credentials are tried from process(); without any, the portal
+    // is all there is
+    _connecting = startConnect("", "");
+    _connectStart = millis();
+    if (!_connecting) {
+      startConfigPortal(_apName, apPassword);
+    }
+    return false;
+  }
+
   if (connectWifi("", "") == WL_CONNECTED)   {
     DEBUG_WM(F("IP Address:"));
     DEBUG_WM(WiFi.localIP());
@@ -198,7 +304,8 @@ boolean WiFiManager::startConfigPortal() {
 
 boolean  WiFiManager::startConfigPortal(char const *apName, char const *apPassword) {
   
-  if(!WiFi.isConnected()){
+  // non-blocking, the station stays up to keep trying saved credentials
+  if(!WiFi.isConnected() && _configPortalIsBlocking){
     WiFi.persistent(false);
     // disconnect sta, start ap
     WiFi.disconnect(); //  this alone is not enough to stop the autoconnecter
@@ -212,8 +319,14 @@ boolean  WiFiManager::startConfigPortal(char const *apName, char const *apPasswo
   }
 
 
-  _apName = apName;
-  _apPassword = apPassword;
+  _apNameCopy = apName;
+  _apName = _apNameCopy.c_str();
+  if (apPassword != NULL) {
+    _apPasswordCopy = apPassword;
+    _apPassword = _apPasswordCopy.c_str();
+  } else {
+    _apPassword = NULL;
+  }
 
   //notify we entered AP mode
   if ( _apcallback != NULL) {
@@ -223,86 +336,160 @@ boolean  WiFiManager::startConfigPortal(char const *apName, char const *apPasswo
   connect = false;
   setupConfigPortal();
 
+  // have the network list ready by the time someone has joined the AP
+  WiFi.scanNetworksStream(nullptr);
+
+  if (!_configPortalIsBlocking) {
+    _configPortalActive = true;
+    return false;
+  }
+
   while(1){
+    if (processConfigPortal()) break;
+    yield();
+  }
 
-    // check if timeout
-    if(configPortalHasTimeout()) break;
+  server.reset();
+  dnsServer.reset();
 
-    //DNS
-    dnsServer->processNextRequest();
-    //HTTP
-    server->handleClient();
+  return  WiFi.status() == WL_CONNECTED;
+}
 
+/** One pass of the portal: DNS, HTTP and the connection asked for on the
+    save page. Returns true when the portal is done. */
+boolean WiFiManager::processConfigPortal() {
+  // check if timeout
+  if(configPortalHasTimeout()) return true;
 
-    if (connect) {
-      connect = false;
-      delay(2000);
-      DEBUG_WM(F("Connecting to new AP"));
+  //DNS
+  dnsServer->processNextRequest();
+  //HTTP
+  server->handleClient();
 
-      // using user-provided  _ssid, _pass in place of system-stored ssid and pass
-      if (connectWifi(_ssid, _pass) != WL_CONNECTED) {
-        DEBUG_WM(F("Failed to connect."));
-      } else {
-        //connected
+  if (!_configPortalIsBlocking) {
+    if (_connecting) {
+      if (WiFi.status() == WL_CONNECTED) {
+        _connecting = false;
         WiFi.mode(WIFI_STA);
-        //notify that configuration has changed and any optional parameters should be saved
         if ( _savecallback != NULL) {
-          //todo: check if any custom parameters actually exist, and check if they really changed maybe
           _savecallback();
         }
-        break;
+        return true;
       }
+      if (!connectHasTimeout()) return false;
 
+      _connecting = false;
+      DEBUG_WM(F("Failed to connect."));
       if (_shouldBreakAfterConfig) {
-        //flag set to exit after config after trying to connect
-        //notify that configuration has changed and any optional parameters should be saved
         if ( _savecallback != NULL) {
-          //todo: check if any custom parameters actually exist, and check if they really changed maybe
           _savecallback();
         }
-        break;
+        return true;
       }
+      return false;
+    }
+
+    // the save page goes out before the radio starts hopping channels
+    if (connect && millis() - _connectRequested >= 2000) {
+      connect = false;
+      DEBUG_WM(F("Connecting to new AP"));
+      _connecting = startConnect(_ssid, _pass);
+      _connectStart = millis();
+      return false;
+    }
+
+    // saved credentials may get through while the portal is up
+    if (!connect && WiFi.status() == WL_CONNECTED) {
+      WiFi.mode(WIFI_STA);
+      return true;
+    }
+    return false;
+  }
+
+  if (connect) {
+    connect = false;
+    delay(2000);
+    DEBUG_WM(F("Connecting to new AP"));
+
+    // using user-provided  _ssid, _pass in place of system-stored ssid and pass
+    if (connectWifi(_ssid, _pass) != WL_CONNECTED) {
+      DEBUG_WM(F("Failed to connect."));
+    } else {
+      //connected
+      WiFi.mode(WIFI_STA);
+      //notify that configuration has changed and any optional parameters should be saved
+      if ( _savecallback != NULL) {
+        //todo: check if any custom parameters actually exist, and check if they really changed maybe
+        _savecallback();
+      }
+      return true;
+    }
+
+    if (_shouldBreakAfterConfig) {
+      //flag set to exit after config after trying to connect
+      //notify that configuration has changed and any optional parameters should be saved
+      if ( _savecallback != NULL) {
+        //todo: check if any custom parameters actually exist, and check if they really changed maybe
+        _savecallback();
+      }
+      return true;
     }
-    yield();
   }
+  return false;
+}
 
+boolean WiFiManager::process() {
+  if (_configPortalActive) {
+    if (processConfigPortal()) {
+      stopConfigPortal();
+    }
+  } else if (_connecting) {
+    if (WiFi.status() == WL_CONNECTED) {
+      _connecting = false;
+      DEBUG_WM(F("IP Address:"));
+      DEBUG_WM(WiFi.localIP());
+    } else if (connectHasTimeout()) {
+      _connecting = false;
+      DEBUG_WM(F("Failed to connect, starting portal"));
+      startConfigPortal(_apName, _apPassword);
+    }
+  }
+  return WiFi.status() == WL_CONNECTED;
+}
+
+void WiFiManager::stopConfigPortal() {
+  if (!_configPortalActive) {
+    return;
+  }
+  DEBUG_WM(F("Stopping config portal"));
   server.reset();
   dnsServer.reset();
+  _configPortalActive = false;
+}
 
-  return  WiFi.status() == WL_CONNECTED;
+boolean WiFiManager::getConfigPortalActive() {
+  return _configPortalActive;
+}
+
+void WiFiManager::setConfigPortalBlocking(boolean shouldBlock) {
+  _configPortalIsBlocking = shouldBlock;
+}
+
+boolean WiFiManager::connectHasTimeout() {
+  unsigned long timeout = _connectTimeout ? _connectTimeout : WIFI_MANAGER_CONNECT_MS;
+  return millis() - _connectStart > timeout;
 }
 
 
 int WiFiManager::connectWifi(String ssid, String pass) {
   DEBUG_WM(F("Connecting as wifi client..."));
 
-  // check if we've got static_ip settings, if we do, use those.
-  if (_sta_static_ip) {
-    DEBUG_WM(F("Custom STA IP/GW/Subnet"));
-    WiFi.config(_sta_static_ip, _sta_static_gw, _sta_static_sn);
-    DEBUG_WM(WiFi.localIP());
-  }
   //fix for auto connect racing issue
   if (WiFi.status() == WL_CONNECTED) {
     DEBUG_WM(F("Already connected. Bailing out."));
     return WL_CONNECTED;
   }
-  //check if we have ssid and pass and force those, if not, try with last saved values
-  if (ssid != "") {
-    WiFi.begin(ssid.c_str(), pass.c_str());
-  } else {
-    if (WiFi.SSID()) {
-      DEBUG_WM(F("Using last saved values, should be faster"));
-      //trying to fix connection in progress hanging
-      ETS_UART_INTR_DISABLE();
-      wifi_station_disconnect();
-      ETS_UART_INTR_ENABLE();
-
-      WiFi.begin();
-    } else {
-      DEBUG_WM(F("No saved credentials"));
-    }
-  }
+  startConnect(ssid, pass);
 
   int connRes = waitForConnectResult();
   DEBUG_WM ("Connection result: ");
@@ -318,6 +505,34 @@ int WiFiManager::connectWifi(String ssid, String pass) {
   return connRes;
 }
 
+/** Starts connecting without waiting for the result; false if there was
+    nothing to connect with */
+boolean WiFiManager::startConnect(String ssid, String pass) {
+  // check if we've got static_ip settings, if we do, use those.
+  if (_sta_static_ip) {
+    DEBUG_WM(F("Custom STA IP/GW/Subnet"));
+    WiFi.config(_sta_static_ip, _sta_static_gw, _sta_static_sn);
+    DEBUG_WM(WiFi.localIP());
+  }
+  //check if we have ssid and pass and force those, if not, try with last saved values
+  if (ssid != "") {
+    WiFi.begin(ssid.c_str(), pass.c_str());
+    return true;
+  }
+  if (WiFi.SSID() != "") {
+    DEBUG_WM(F("Using last saved values, should be faster"));
+    //trying to fix connection in progress hanging
+    ETS_UART_INTR_DISABLE();
+    wifi_station_disconnect();
+    ETS_UART_INTR_ENABLE();
+
+    WiFi.begin();
+    return true;
+  }
+  DEBUG_WM(F("No saved credentials"));
+  return false;
+}
+
 uint8_t WiFiManager::waitForConnectResult() {
   if (_connectTimeout == 0) {
     return WiFi.waitForConnectResult();
@@ -413,6 +628,15 @@ void WiFiManager::setBreakAfterConfig(boolean shouldBreak) {
   _shouldBreakAfterConfig = shouldBreak;
 }
 
+/** Head of every portal page, up to the opening of the body */
+void WiFiManager::pageStart(WiFiManagerPage &page, const char *title) {
+  page.addTemplate_P(HTTP_HEAD, "v", &title);
+  page.add_P(HTTP_SCRIPT);
+  page.add_P(HTTP_STYLE);
+  page.add(_customHeadElement);
+  page.add_P(HTTP_HEAD_END);
+}
+
 /** Handle root or redirect to captive portal */
 void WiFiManager::handleRoot() {
   DEBUG_WM(F("Handle root"));
@@ -420,73 +644,54 @@ void WiFiManager::handleRoot() {
     return;
   }
 
-  String page = FPSTR(HTTP_HEAD);
-  page.replace("{v}", "Options");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += String(F("<h1>"));
-  page += _apName;
-  page += String(F("</h1>"));
-  page += String(F("<h3>WiFiManager</h3>"));
-  page += FPSTR(HTTP_PORTAL_OPTIONS);
-  page += FPSTR(HTTP_END);
-
-  server->sendHeader("Content-Length", String(page.length()));
-  server->send(200, "text/html", page);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Options");
+  page.add_P(PSTR("<h1>"));
+  page.add(_apName);
+  page.add_P(PSTR("</h1>"));
+  page.add_P(PSTR("<h3>WiFiManager</h3>"));
+  page.add_P(HTTP_PORTAL_OPTIONS);
+  page.add_P(HTTP_END);
+  page.end();
 
 }
 
 /** Wifi config page handler */
 void WiFiManager::handleWifi(boolean scan) {
 
-  String page = FPSTR(HTTP_HEAD);
-  page.replace("{v}", "Config ESP");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Config ESP");
 
   if (scan) {
-    int n = WiFi.scanNetworks();
-    DEBUG_WM(F("Scan done"));
+    // the list comes from the stream scan cache, already sorted by RSSI; a
+    // stale one is refreshed in the background for the next page load
+    if (!WiFi.scanStreamRunning() && WiFi.scanCacheAge() > WIFI_MANAGER_SCAN_CACHE_MS) {
+      WiFi.scanNetworksStream(nullptr);
+    }
+    int n = WiFi.scanCacheCount();
+    DEBUG_WM(F("Scan cache"));
     if (n == 0) {
       DEBUG_WM(F("No networks found"));
-      page += F("No networks found. Refresh to scan again.");
+      if (WiFi.scanStreamRunning()) {
+        page.add_P(PSTR("Scanning for networks. Refresh in a few seconds."));
+      } else {
+        page.add_P(PSTR("No networks found. Refresh to scan again."));
+      }
     } else {
 
-      //sort networks
       int indices[n];
       for (int i = 0; i < n; i++) {
         indices[i] = i;
       }
 
-      // RSSI SORT
-
-      // old sort
-      for (int i = 0; i < n; i++) {
-        for (int j = i + 1; j < n; j++) {
-          if (WiFi.RSSI(indices[j]) > WiFi.RSSI(indices[i])) {
-            std::swap(indices[i], indices[j]);
-          }
-        }
-      }
-
-      /*std::sort(indices, indices + n, [](const int & a, const int & b) -> bool
-        {
-        return WiFi.RSSI(a) > WiFi.RSSI(b);
-        });*/
-
       // remove duplicates ( must be RSSI sorted )
       if (_removeDuplicateAPs) {
-        String cssid;
         for (int i = 0; i < n; i++) {
           if (indices[i] == -1) continue;
-          cssid = WiFi.SSID(indices[i]);
+          const char *cssid = WiFi.scanCacheEntry(i)->ssid;
           for (int j = i + 1; j < n; j++) {
-            if (cssid == WiFi.SSID(indices[j])) {
-              DEBUG_WM("DUP AP: " + WiFi.SSID(indices[j]));
+            if (indices[j] != -1 && !strcmp(cssid, WiFi.scanCacheEntry(j)->ssid)) {
+              DEBUG_WM("DUP AP: " + String(cssid));
               indices[j] = -1; // set dup aps to index -1
             }
           }
@@ -496,34 +701,27 @@ void WiFiManager::handleWifi(boolean scan) {
       //display networks in page
       for (int i = 0; i < n; i++) {
         if (indices[i] == -1) continue; // skip dups
-        DEBUG_WM(WiFi.SSID(indices[i]));
-        DEBUG_WM(WiFi.RSSI(indices[i]));
-        int quality = getRSSIasQuality(WiFi.RSSI(indices[i]));
+        const WiFiScanEntry *net = WiFi.scanCacheEntry(indices[i]);
+        DEBUG_WM(net->ssid);
+        DEBUG_WM((int)net->rssi);
+        int quality = getRSSIasQuality(net->rssi);
 
         if (_minimumQuality == -1 || _minimumQuality < quality) {
-          String item = FPSTR(HTTP_ITEM);
-          String rssiQ;
-          rssiQ += quality;
-          item.replace("{v}", WiFi.SSID(indices[i]));
-          item.replace("{r}", rssiQ);
-          if (WiFi.encryptionType(indices[i]) != ENC_TYPE_NONE) {
-            item.replace("{i}", "l");
-          } else {
-            item.replace("{i}", "");
-          }
-          //DEBUG_WM(item);
-          page += item;
+          char rssiQ[5];
+          snprintf(rssiQ, sizeof(rssiQ), "%d", quality);
+          const char *item[] = { net->ssid, rssiQ, net->encryptionType != ENC_TYPE_NONE ? "l" : "" };
+          page.addTemplate_P(HTTP_ITEM, "vri", item);
           delay(0);
         } else {
           DEBUG_WM(F("Skipping due to quality"));
         }
 
       }
-      page += "<br/>";
+      page.add_P(PSTR("<br/>"));
     }
   }
 
-  page += FPSTR(HTTP_FORM_START);
+  page.add_P(HTTP_FORM_START);
   char parLength[5];
   // add the extra parameters to the form
   for (int i = 0; i < _paramsCount; i++) {
@@ -531,64 +729,45 @@ void WiFiManager::handleWifi(boolean scan) {
       break;
     }
 
-    String pitem = FPSTR(HTTP_FORM_PARAM);
     if (_params[i]->getID() != NULL) {
-      pitem.replace("{i}", _params[i]->getID());
-      pitem.replace("{n}", _params[i]->getID());
-      pitem.replace("{p}", _params[i]->getPlaceholder());
       snprintf(parLength, 5, "%d", _params[i]->getValueLength());
-      pitem.replace("{l}", parLength);
-      pitem.replace("{v}", _params[i]->getValue());
-      pitem.replace("{c}", _params[i]->getCustomHTML());
+      const char *pitem[] = { _params[i]->getID(), _params[i]->getID(), _params[i]->getPlaceholder(),
+                              parLength, _params[i]->getValue(), _params[i]->getCustomHTML() };
+      page.addTemplate_P(HTTP_FORM_PARAM, "inplvc", pitem);
     } else {
-      pitem = _params[i]->getCustomHTML();
+      page.add(_params[i]->getCustomHTML());
     }
-
-    page += pitem;
   }
   if (_params[0] != NULL) {
-    page += "<br/>";
+    page.add_P(PSTR("<br/>"));
   }
 
   if (_sta_static_ip) {
 
-    String item = FPSTR(HTTP_FORM_PARAM);
-    item.replace("{i}", "ip");
-    item.replace("{n}", "ip");
-    item.replace("{p}", "Static IP");
-    item.replace("{l}", "15");
-    item.replace("{v}", _sta_static_ip.toString());
-
-    page += item;
+    String ip = _sta_static_ip.toString();
+    const char *item[] = { "ip", "ip", "Static IP", "15", ip.c_str(), "" };
+    page.addTemplate_P(HTTP_FORM_PARAM, "inplvc", item);
 
-    item = FPSTR(HTTP_FORM_PARAM);
-    item.replace("{i}", "gw");
-    item.replace("{n}", "gw");
-    item.replace("{p}", "Static Gateway");
-    item.replace("{l}", "15");
-    item.replace("{v}", _sta_static_gw.toString());
+    ip = _sta_static_gw.toString();
+    item[0] = item[1] = "gw";
+    item[2] = "Static Gateway";
+    item[4] = ip.c_str();
+    page.addTemplate_P(HTTP_FORM_PARAM, "inplvc", item);
 
-    page += item;
+    ip = _sta_static_sn.toString();
+    item[0] = item[1] = "sn";
+    item[2] = "Subnet";
+    item[4] = ip.c_str();
+    page.addTemplate_P(HTTP_FORM_PARAM, "inplvc", item);
 
-    item = FPSTR(HTTP_FORM_PARAM);
-    item.replace("{i}", "sn");
-    item.replace("{n}", "sn");
-    item.replace("{p}", "Subnet");
-    item.replace("{l}", "15");
-    item.replace("{v}", _sta_static_sn.toString());
-
-    page += item;
-
-    page += "<br/>";
+    page.add_P(PSTR("<br/>"));
   }
 
-  page += FPSTR(HTTP_FORM_END);
-  page += FPSTR(HTTP_SCAN_LINK);
+  page.add_P(HTTP_FORM_END);
+  page.add_P(HTTP_SCAN_LINK);
 
-  page += FPSTR(HTTP_END);
-
-  server->sendHeader("Content-Length", String(page.length()));
-  server->send(200, "text/html", page);
+  page.add_P(HTTP_END);
+  page.end();
 
 
   DEBUG_WM(F("Sent config page"));
@@ -636,60 +815,49 @@ void WiFiManager::handleWifiSave() {
     optionalIPFromString(&_sta_static_sn, sn.c_str());
   }
 
-  String page = FPSTR(HTTP_HEAD);
-  page.replace("{v}", "Credentials Saved");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += FPSTR(HTTP_SAVED);
-  page += FPSTR(HTTP_END);
-
-  server->sendHeader("Content-Length", String(page.length()));
-  server->send(200, "text/html", page);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Credentials Saved");
+  page.add_P(HTTP_SAVED);
+  page.add_P(HTTP_END);
+  page.end();
 
   DEBUG_WM(F("Sent wifi save page"));
 
   connect = true; //signal ready to connect/reset
+  _connectRequested = millis();
 }
 
 /** Handle the info page */
 void WiFiManager::handleInfo() {
   DEBUG_WM(F("Info"));
 
-  String page = FPSTR(HTTP_HEAD);
-  page.replace("{v}", "Info");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += F("<dl>");
-  page += F("<dt>Chip ID</dt><dd>");
-  page += ESP.getChipId();
-  page += F("</dd>");
-  page += F("<dt>Flash Chip ID</dt><dd>");
-  page += ESP.getFlashChipId();
-  page += F("</dd>");
-  page += F("<dt>IDE Flash Size</dt><dd>");
-  page += ESP.getFlashChipSize();
-  page += F(" bytes</dd>");
-  page += F("<dt>Real Flash Size</dt><dd>");
-  page += ESP.getFlashChipRealSize();
-  page += F(" bytes</dd>");
-  page += F("<dt>Soft AP IP</dt><dd>");
-  page += WiFi.softAPIP().toString();
-  page += F("</dd>");
-  page += F("<dt>Soft AP MAC</dt><dd>");
-  page += WiFi.softAPmacAddress();
-  page += F("</dd>");
-  page += F("<dt>Station MAC</dt><dd>");
-  page += WiFi.macAddress();
-  page += F("</dd>");
-  page += F("</dl>");
-  page += FPSTR(HTTP_END);
-
-  server->sendHeader("Content-Length", String(page.length()));
-  server->send(200, "text/html", page);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Info");
+  page.add_P(PSTR("<dl>"));
+  page.add_P(PSTR("<dt>Chip ID</dt><dd>"));
+  page.add(ESP.getChipId());
+  page.add_P(PSTR("</dd>"));
+  page.add_P(PSTR("<dt>Flash Chip ID</dt><dd>"));
+  page.add(ESP.getFlashChipId());
+  page.add_P(PSTR("</dd>"));
+  page.add_P(PSTR("<dt>IDE Flash Size</dt><dd>"));
+  page.add(ESP.getFlashChipSize());
+  page.add_P(PSTR(" bytes</dd>"));
+  page.add_P(PSTR("<dt>Real Flash Size</dt><dd>"));
+  page.add(ESP.getFlashChipRealSize());
+  page.add_P(PSTR(" bytes</dd>"));
+  page.add_P(PSTR("<dt>Soft AP IP</dt><dd>"));
+  page.add(WiFi.softAPIP().toString());
+  page.add_P(PSTR("</dd>"));
+  page.add_P(PSTR("<dt>Soft AP MAC</dt><dd>"));
+  page.add(WiFi.softAPmacAddress());
+  page.add_P(PSTR("</dd>"));
+  page.add_P(PSTR("<dt>Station MAC</dt><dd>"));
+  page.add(WiFi.macAddress());
+  page.add_P(PSTR("</dd>"));
+  page.add_P(PSTR("</dl>"));
+  page.add_P(HTTP_END);
+  page.end();
 
   DEBUG_WM(F("Sent info page"));
 }
@@ -698,17 +866,11 @@ void WiFiManager::handleInfo() {
 void WiFiManager::handleReset() {
   DEBUG_WM(F("Reset"));
 
-  String page = FPSTR(HTTP_HEAD);
-  page.replace("{v}", "Info");
-  page += FPSTR(HTTP_SCRIPT);
-  page += FPSTR(HTTP_STYLE);
-  page += _customHeadElement;
-  page += FPSTR(HTTP_HEAD_END);
-  page += F("Module will reset in a few seconds.");
-  page += FPSTR(HTTP_END);
-
-  server->sendHeader("Content-Length", String(page.length()));
-  server->send(200, "text/html", page);
+  WiFiManagerPage page(*server);
+  pageStart(page, "Info");
+  page.add_P(PSTR("Module will reset in a few seconds."));
+  page.add_P(HTTP_END);
+  page.end();
 
   DEBUG_WM(F("Sent reset page"));
   delay(5000);
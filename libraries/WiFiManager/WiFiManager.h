@@ -39,6 +39,24 @@ const char HTTP_END[] PROGMEM             = "</div></body></html>";
 #define WIFI_MANAGER_MAX_PARAMS 10
 #endif
 
+// network list older than this is rescanned in the background
+#ifndef WIFI_MANAGER_SCAN_CACHE_MS
+#define WIFI_MANAGER_SCAN_CACHE_MS 30000
+#endif
+
+// without setConnectTimeout(), how long a non-blocking connection attempt
+// may take before it counts as failed
+#ifndef WIFI_MANAGER_CONNECT_MS
+#define WIFI_MANAGER_CONNECT_MS 10000
+#endif
+
+// portal pages go out in chunks of up to this many bytes
+#ifndef WIFI_MANAGER_CHUNK
+#define WIFI_MANAGER_CHUNK 256
+#endif
+
+class WiFiManagerPage;
+
 class WiFiManagerParameter {
   public:
     /** 
@@ -84,6 +102,14 @@ class WiFiManager
     // get the AP name of the config portal, so it can be used in the callback
     String        getConfigPortalSSID();
 
+    //if false, autoConnect() and startConfigPortal() return at once and the
+    //connection attempt and the portal run from process(), called from loop()
+    void          setConfigPortalBlocking(boolean shouldBlock);
+    //non-blocking mode only: true once connected as a station
+    boolean       process();
+    boolean       getConfigPortalActive();
+    void          stopConfigPortal();
+
     void          resetSettings();
 
     //sets timeout before webserver loop ends and exits even if there has been no setup.
@@ -132,6 +158,8 @@ class WiFiManager
 
     const char*   _apName                 = "no-net";
     const char*   _apPassword             = NULL;
+    String        _apNameCopy;            // _apName outlives the caller's string in non-blocking mode
+    String        _apPasswordCopy;
     String        _ssid                   = "";
     String        _pass                   = "";
     unsigned long _configPortalTimeout    = 0;
@@ -150,6 +178,11 @@ class WiFiManager
     boolean       _removeDuplicateAPs     = true;
     boolean       _shouldBreakAfterConfig = false;
     boolean       _tryWPS                 = false;
+    boolean       _configPortalIsBlocking = true;
+    boolean       _configPortalActive     = false;
+    boolean       _connecting             = false;  //non-blocking attempt under way
+    unsigned long _connectStart           = 0;
+    unsigned long _connectRequested       = 0;
 
     const char*   _customHeadElement      = "";
 
@@ -158,8 +191,12 @@ class WiFiManager
 
     int           status = WL_IDLE_STATUS;
     int           connectWifi(String ssid, String pass);
+    boolean       startConnect(String ssid, String pass);
+    boolean       connectHasTimeout();
+    boolean       processConfigPortal();
     uint8_t       waitForConnectResult();
 
+    void          pageStart(WiFiManagerPage &page, const char *title);
     void          handleRoot();
     void          handleWifi(boolean scan);
     void          handleWifiSave();
@@ -9,6 +9,11 @@ written by Adafruit Industries
 #define MIN_INTERVAL 2000
 #define TIMEOUT -1
 
+// The whole answer takes under 5 ms; give up on the non-blocking read after this.
+#define RECEIVE_TIMEOUT_US 10000
+
+DHT *DHT::_isrOwner = NULL;
+
 DHT::DHT(uint8_t pin, uint8_t type, uint8_t count) {
   _pin = pin;
   _type = type;
@@ -20,6 +25,9 @@ DHT::DHT(uint8_t pin, uint8_t type, uint8_t count) {
                                                  // reading pulses from DHT sensor.
   // Note that count is now ignored as the DHT reading algorithm adjusts itself
   // based on the speed of the processor.
+  _state = DHT_IDLE;
+  _edgeCount = 0;
+  _lastresult = false;
 }
 
 // Optionally pass pull-up time (in microseconds) before DHT reading starts.
@@ -37,42 +45,48 @@ void DHT::begin(uint8_t usec) {
 
 //boolean S == Scale.  True == Fahrenheit; False == Celcius
 float DHT::readTemperature(bool S, bool force) {
+  if (read(force)) {
+    return convertTemperature(S);
+  }
+  return NAN;
+}
+
+// Converts the last 40 bits received, whichever reader got them.
+float DHT::convertTemperature(bool S) {
   float f = NAN;
 
-  if (read(force)) {
-    switch (_type) {
-    case DHT11:
-      f = data[2];
-      if (data[3] & 0x80) {
-        f = -1 - f ;
-      }
-      f += (data[3] & 0x0f) * 0.1;
-      if(S) {
-        f = convertCtoF(f);
-      }
-      break;
-    case DHT12:
-      f = data[2];
-      f += (data[3] & 0x0f) * 0.1;
-      if (data[2] & 0x80) {
-        f *= -1;
-      }
-      if(S) {
-        f = convertCtoF(f);
-      }
-      break;
-    case DHT22:
-    case DHT21:
-      f = ((word)(data[2] & 0x7F)) << 8 | data[3];
-      f *= 0.1;
-      if (data[2] & 0x80) {
-        f *= -1;
-      }
-      if(S) {
-        f = convertCtoF(f);
-      }
-      break;
+  switch (_type) {
+  case DHT11:
+    f = data[2];
+    if (data[3] & 0x80) {
+      f = -1 - f ;
+    }
+    f += (data[3] & 0x0f) * 0.1;
+    if(S) {
+      f = convertCtoF(f);
+    }
+    break;
+  case DHT12:
+    f = data[2];
+    f += (data[3] & 0x0f) * 0.1;
+    if (data[2] & 0x80) {
+      f *= -1;
+    }
+    if(S) {
+      f = convertCtoF(f);
     }
+    break;
+  case DHT22:
+  case DHT21:
+    f = ((word)(data[2] & 0x7F)) << 8 | data[3];
+    f *= 0.1;
+    if (data[2] & 0x80) {
+      f *= -1;
+    }
+    if(S) {
+      f = convertCtoF(f);
+    }
+    break;
   }
   return f;
 }
@@ -86,19 +100,25 @@ float DHT::convertFtoC(float f) {
 }
 
 float DHT::readHumidity(bool force) {
-  float f = NAN;
   if (read(force)) {
-    switch (_type) {
-    case DHT11:
-    case DHT12:
-      f = data[0] + data[1] * 0.1;
-      break;
-    case DHT22:
-    case DHT21:
-      f = ((word)data[0]) << 8 | data[1];
-      f *= 0.1;
-      break;
-    }
+    return convertHumidity();
+  }
+  return NAN;
+}
+
+float DHT::convertHumidity(void) {
+  float f = NAN;
+
+  switch (_type) {
+  case DHT11:
+  case DHT12:
+    f = data[0] + data[1] * 0.1;
+    break;
+  case DHT22:
+  case DHT21:
+    f = ((word)data[0]) << 8 | data[1];
+    f *= 0.1;
+    break;
   }
   return f;
 }
@@ -144,6 +164,11 @@ float DHT::computeHeatIndex(float temperature, float percentHumidity,
 }
 
 bool DHT::read(bool force) {
+  // A non-blocking read owns the line until poll() finishes it.
+  if (_state != DHT_IDLE) {
+    return _lastresult;
+  }
+
   // Check if sensor was read less than two seconds ago and return early
   // to use last reading.
   uint32_t currenttime = millis();
@@ -297,3 +322,133 @@ uint32_t DHT::expectPulse(bool level) {
 
   return count;
 }
+
+// Starts a non-blocking read: the line is pulled low here and released by
+// poll() once the start signal has lasted long enough for the sensor type.
+// Returns false if a read is already running (on this or another DHT, as the
+// edge ISR serves one sensor at a time) or the last one was under two seconds
+// ago and force is not set.
+bool DHT::startRead(bool force) {
+  uint32_t currenttime = millis();
+  if (_state != DHT_IDLE || _isrOwner != NULL) {
+    return false;
+  }
+  if (!force && ((currenttime - _lastreadtime) < MIN_INTERVAL)) {
+    return false;
+  }
+  _lastreadtime = currenttime;
+
+  _isrOwner = this;
+  pinMode(_pin, OUTPUT);
+  digitalWrite(_pin, LOW);
+  _stateStart = micros();
+  _state = DHT_STARTING;
+  return true;
+}
+
+// Advances the non-blocking read; call it often from loop(). Returns true
+// once, when a read has just finished, with lastResult() telling whether the
+// 40 bits arrived with a good checksum.
+bool DHT::poll(void) {
+  uint32_t elapsed = micros() - _stateStart;
+
+  switch (_state) {
+  case DHT_STARTING:
+    // data sheets: DHT22/21 at least 1 ms low, DHT11 at least 18 ms
+    if (elapsed < ((_type == DHT22 || _type == DHT21) ? 1100UL : 20000UL)) {
+      return false;
+    }
+    _edgeCount = 0;
+    pinMode(_pin, INPUT_PULLUP);
+    _stateStart = micros();
+    _state = DHT_RECEIVING;
+    attachInterrupt(digitalPinToInterrupt(_pin), edgeISR, CHANGE);
+    return false;
+  case DHT_RECEIVING:
+    if (_edgeCount < DHT_EDGES && elapsed < RECEIVE_TIMEOUT_US) {
+      return false;
+    }
+    finishRead();
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool DHT::busy(void) {
+  return _state != DHT_IDLE;
+}
+
+bool DHT::lastResult(void) {
+  return _lastresult;
+}
+
+// Temperature/humidity of the last successful read, without reading again.
+float DHT::getTemperature(bool S) {
+  return _lastresult ? convertTemperature(S) : NAN;
+}
+
+float DHT::getHumidity(void) {
+  return _lastresult ? convertHumidity() : NAN;
+}
+
+void DHT::finishRead(void) {
+  detachInterrupt(digitalPinToInterrupt(_pin));
+  _state = DHT_IDLE;
+  _isrOwner = NULL;
+  _lastresult = decodeEdges();
+}
+
+// Each edge gets a timestamp and the level the line changed to. The
+// sensor's answer starts at the first falling edge: ~80 us low, ~80 us high,
+// then per bit ~50 us low and a high of ~27 us (0) or ~70 us (1). As in
+// read(), a bit is 1 when its high lasts longer than its low.
+bool DHT::decodeEdges(void) {
+  uint8_t count = _edgeCount;
+  uint8_t first = 0;
+
+  data[0] = data[1] = data[2] = data[3] = data[4] = 0;
+
+  while (first < count && (_edgeLevel[first / 8] & (1 << (first % 8)))) {
+    first++;
+  }
+  // response fall, rise, then fall/rise per bit and the fall ending bit 39
+  if (count < first + 83) {
+    DEBUG_PRINTLN(F("DHT timeout waiting for pulse."));
+    return false;
+  }
+
+  for (int i=0; i<40; ++i) {
+    uint8_t e = first + 2 + 2*i;
+    uint32_t lowTime  = _edgeTime[e+1] - _edgeTime[e];
+    uint32_t highTime = _edgeTime[e+2] - _edgeTime[e+1];
+    data[i/8] <<= 1;
+    if (highTime > lowTime) {
+      data[i/8] |= 1;
+    }
+  }
+
+  if (data[4] == ((data[0] + data[1] + data[2] + data[3]) & 0xFF)) {
+    return true;
+  }
+  DEBUG_PRINTLN(F("DHT checksum failure!"));
+  return false;
+}
+
+void DHT_ISR_ATTR DHT::edgeISR(void) {
+  DHT *dht = _isrOwner;
+  if (dht == NULL) {
+    return;
+  }
+  uint8_t n = dht->_edgeCount;
+  if (n >= DHT_EDGES) {
+    return;
+  }
+  dht->_edgeTime[n] = micros();
+  if (digitalRead(dht->_pin)) {
+    dht->_edgeLevel[n / 8] |= (1 << (n % 8));
+  } else {
+    dht->_edgeLevel[n / 8] &= ~(1 << (n % 8));
+  }
+  dht->_edgeCount = n + 1;
+}
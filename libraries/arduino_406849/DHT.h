@@ -35,6 +35,22 @@ written by Adafruit Industries
 #define DHT21 21
 #define AM2301 21
 
+// Edges captured by the non-blocking reader: response low/high, 40 bits of
+// low/high and the final release, plus a little room for a stray edge when
+// the line is handed back to the pull-up.
+#define DHT_EDGES 88
+
+// States of the non-blocking reader (see startRead() / poll()).
+#define DHT_IDLE      0
+#define DHT_STARTING  1  // host holding the line low
+#define DHT_RECEIVING 2  // ISR timestamping the sensor's edges
+
+#if defined(ESP8266)
+  #define DHT_ISR_ATTR ICACHE_RAM_ATTR
+#else
+  #define DHT_ISR_ATTR
+#endif
+
 
 class DHT {
   public:
@@ -48,6 +64,17 @@ class DHT {
    float readHumidity(bool force=false);
    bool read(bool force=false);
 
+   // Non-blocking read: startRead() pulls the line low and returns, poll()
+   // (called from loop()) releases it and, once the sensor has answered,
+   // decodes the edge timestamps captured by a pin-change interrupt.
+   // Interrupts are never masked, so other ISRs keep their timing.
+   bool startRead(bool force=false);
+   bool poll(void);
+   bool busy(void);
+   bool lastResult(void);
+   float getTemperature(bool S=false);
+   float getHumidity(void);
+
  private:
   uint8_t data[5];
   uint8_t _pin, _type;
@@ -61,6 +88,19 @@ class DHT {
   uint8_t pullTime; // Time (in usec) to pull up data line before reading
 
   uint32_t expectPulse(bool level);
+  float convertTemperature(bool S);
+  float convertHumidity(void);
+
+  // Non-blocking reader state; _edge* are written by edgeISR().
+  uint8_t _state;
+  uint32_t _stateStart;
+  volatile uint8_t _edgeCount;
+  uint32_t _edgeTime[DHT_EDGES];
+  uint8_t _edgeLevel[(DHT_EDGES + 7) / 8];
+  void finishRead(void);
+  bool decodeEdges(void);
+  static DHT *_isrOwner;
+  static void DHT_ISR_ATTR edgeISR(void);
 
 };
 
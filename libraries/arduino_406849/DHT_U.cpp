@@ -24,6 +24,10 @@
 DHT_Unified::DHT_Unified(uint8_t pin, uint8_t type, uint8_t count, int32_t tempSensorId, int32_t humiditySensorId):
   _dht(pin, type, count),
   _type(type),
+  _cached(false),
+  _lastTemperature(NAN),
+  _lastHumidity(NAN),
+  _lastReadTime(0),
   _temp(this, tempSensorId),
   _humidity(this, humiditySensorId)
 {}
@@ -32,6 +36,21 @@ void DHT_Unified::begin() {
   _dht.begin();
 }
 
+bool DHT_Unified::update(void) {
+  _cached = true;
+  if (!_dht.busy()) {
+    _dht.startRead();  // false while under MIN_INTERVAL since the last one
+    return false;
+  }
+  if (!_dht.poll() || !_dht.lastResult()) {
+    return false;
+  }
+  _lastTemperature = _dht.getTemperature();
+  _lastHumidity = _dht.getHumidity();
+  _lastReadTime = millis();
+  return true;
+}
+
 void DHT_Unified::setName(sensor_t* sensor) {
   switch(_type) {
     case DHT11:
@@ -88,6 +107,12 @@ bool DHT_Unified::Temperature::getEvent(sensors_event_t* event) {
   event->version     = sizeof(sensors_event_t);
   event->sensor_id   = _id;
   event->type        = SENSOR_TYPE_AMBIENT_TEMPERATURE;
+  if (_parent->_cached) {
+    // Last good read from update(), stamped with its own time.
+    event->timestamp   = _parent->_lastReadTime;
+    event->temperature = _parent->_lastTemperature;
+    return !isnan(event->temperature);
+  }
   event->timestamp   = millis();
   event->temperature = _parent->_dht.readTemperature();
   
@@ -147,6 +172,11 @@ bool DHT_Unified::Humidity::getEvent(sensors_event_t* event) {
   event->version           = sizeof(sensors_event_t);
   event->sensor_id         = _id;
   event->type              = SENSOR_TYPE_RELATIVE_HUMIDITY;
+  if (_parent->_cached) {
+    event->timestamp         = _parent->_lastReadTime;
+    event->relative_humidity = _parent->_lastHumidity;
+    return !isnan(event->relative_humidity);
+  }
   event->timestamp         = millis();
   event->relative_humidity = _parent->_dht.readHumidity();
   
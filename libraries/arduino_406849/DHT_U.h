@@ -31,6 +31,11 @@ class DHT_Unified {
 public:
   DHT_Unified(uint8_t pin, uint8_t type, uint8_t count=6, int32_t tempSensorId=-1, int32_t humiditySensorId=-1);
   void begin();
+  // Non-blocking: starts a read whenever the sensor allows one and advances
+  // it through DHT::poll(); call it often from loop(). Returns true when a
+  // read has just finished with a good checksum. Once update() is in use,
+  // getEvent() returns that cached reading instead of reading again.
+  bool update(void);
 
   class Temperature : public Adafruit_Sensor {
   public:
@@ -67,6 +72,9 @@ public:
 private:
   DHT _dht;
   uint8_t _type;
+  bool _cached;
+  float _lastTemperature, _lastHumidity;
+  uint32_t _lastReadTime;
   Temperature _temp;
   Humidity _humidity;
 
@@ -0,0 +1,47 @@
+// Non-blocking DHT reading: the sensor's pulses are timestamped by a
+// pin-change interrupt and decoded in loop(), so interrupts are never turned
+// off and other ISRs (zero-cross detectors, encoders...) keep running.
+// Written for the DHT Sensor Library, public domain
+
+// REQUIRES the following Arduino libraries:
+// - DHT Sensor Library: https://github.com/adafruit/DHT-sensor-library
+// - Adafruit Unified Sensor Lib: https://github.com/adafruit/Adafruit_Sensor
+
+#include "DHT.h"
+
+#define DHTPIN 2     // Digital pin connected to the DHT sensor (must support interrupts)
+
+// Uncomment whatever type you're using!
+//#define DHTTYPE DHT11   // DHT 11
+#define DHTTYPE DHT22   // DHT 22  (AM2302), AM2321
+//#define DHTTYPE DHT21   // DHT 21 (AM2301)
+
+DHT dht(DHTPIN, DHTTYPE);
+
+void setup() {
+  Serial.begin(9600);
+  Serial.println(F("DHTxx non-blocking test!"));
+
+  dht.begin();
+}
+
+void loop() {
+  // Ask for a new reading; this does nothing while one is running or if
+  // the last one was less than two seconds ago.
+  dht.startRead();
+
+  // poll() returns true once per finished reading.
+  if (dht.poll()) {
+    if (!dht.lastResult()) {
+      Serial.println(F("Failed to read from DHT sensor!"));
+      return;
+    }
+    Serial.print(F("Humidity: "));
+    Serial.print(dht.getHumidity());
+    Serial.print(F("%  Temperature: "));
+    Serial.print(dht.getTemperature());
+    Serial.println(F("°C"));
+  }
+
+  // ... the rest of the sketch runs here between edges
+}
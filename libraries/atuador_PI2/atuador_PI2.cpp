@@ -7,7 +7,7 @@
 
 #include "Arduino.h"
 #include "atuador_PI2.h"
-#define T 8333.33 // O período em us
+#define T SEMICICLO_PADRAO_US // O período em us
 //#define T 2000000 // O período em 2 segundos (Testando a biblioteca)
 
 Triac_PI2::Triac_PI2(int pin)
@@ -25,3 +25,604 @@ void Triac_PI2::ControlePotencia(float pot)
    delayMicroseconds((1-pot)*T); // Período de Tempo do LOW que é complemento de HIGH
   
 }
+
+RampaPotencia::RampaPotencia()
+{
+   _pctPorMs = 0;
+   _teto = 0;
+   _instante = millis();
+}
+
+void RampaPotencia::configurar(float pct_por_s)
+{
+   _pctPorMs = (pct_por_s > 0) ? pct_por_s / 1000 : 0;
+}
+
+void RampaPotencia::adiar(uint32_t ms)
+{
+   _teto = 0;
+   _instante = millis() + ms;
+}
+
+float RampaPotencia::limitar(float pot)
+{
+   uint32_t agora = millis();
+   int32_t decorrido = (int32_t)(agora - _instante);
+   if (decorrido < 0) return 0;      // adiada: ainda não é a vez deste forno
+   _instante = agora;
+   if (_pctPorMs <= 0) {
+      _teto = pot;
+      return pot;
+   }
+   float teto = _teto + _pctPorMs * decorrido;
+   _teto = (pot < teto) ? pot : teto;
+   return _teto;
+}
+
+// Sem mexer no estado: o controle pergunta antes de calcular a potência
+float RampaPotencia::teto()
+{
+   int32_t decorrido = (int32_t)(millis() - _instante);
+   if (decorrido < 0) return 0;
+   if (_pctPorMs <= 0) return 100;
+   float teto = _teto + _pctPorMs * decorrido;
+   return (teto < 100) ? teto : 100;
+}
+
+CanaisRajada_PI2::CanaisRajada_PI2(const uint8_t *pinos, uint8_t canais)
+{
+   _canais = (canais > CANAIS_MAX) ? CANAIS_MAX : canais;
+   for (uint8_t c = 0; c < _canais; c++) {
+      _pinos[c] = pinos[c];
+      _mascaraPino[c] = (pinos[c] < 16) ? (1UL << pinos[c]) : 0;
+      _nivel[c] = 0;
+   }
+   memset(_mascara, 0, sizeof(_mascara));
+   _ativa = 0;
+   _simultaneos = 0;
+   _conduzindo = 0;
+   _semiciclo = 0;
+   _bloqueado = false;
+}
+
+void CanaisRajada_PI2::iniciar()
+{
+   for (uint8_t c = 0; c < _canais; c++) {
+      pinMode(_pinos[c], OUTPUT);
+      digitalWrite(_pinos[c], LOW);
+   }
+   alocar();
+}
+
+void CanaisRajada_PI2::definirPotencia(uint8_t canal, int pot)
+{
+   if (canal >= _canais) return;
+   if (pot < 0) pot = 0;
+   if (pot > 100) pot = 100;
+   uint8_t nivel = (int)_rampa[canal].limitar(pot);
+   if (nivel == _nivel[canal]) return;
+   _nivel[canal] = nivel;
+   alocar();
+}
+
+// Máscaras novas no buffer que a ISR não lê; a troca é a escrita de um byte
+void CanaisRajada_PI2::alocar()
+{
+   uint8_t livre = _ativa ^ 1;
+   memset(_mascara[livre], 0, sizeof(_mascara[livre]));
+
+   if (_canais == 1) {
+      int acumulador = JANELA_RAJADA / 2;  // centraliza os disparos na janela
+      for (int i = 0; i < JANELA_RAJADA; i++) {
+         acumulador += _nivel[0];
+         if (acumulador >= JANELA_RAJADA) {
+            acumulador -= JANELA_RAJADA;
+            _mascara[livre][0][i >> 5] |= (1UL << (i & 31));
+         }
+      }
+   }
+   else {
+      uint8_t posicao = 0;
+      for (uint8_t c = 0; c < _canais; c++) {
+         for (uint8_t n = 0; n < _nivel[c]; n++) {
+            uint8_t i = (uint16_t)posicao * PASSO_RAJADA % JANELA_RAJADA;
+            _mascara[livre][c][i >> 5] |= (1UL << (i & 31));
+            if (++posicao >= JANELA_RAJADA) posicao = 0;
+         }
+      }
+   }
+
+   uint8_t pior = 0;
+   for (uint8_t i = 0; i < JANELA_RAJADA; i++) {
+      uint8_t juntos = 0;
+      for (uint8_t c = 0; c < _canais; c++) {
+         if (_mascara[livre][c][i >> 5] & (1UL << (i & 31))) juntos++;
+      }
+      if (juntos > pior) pior = juntos;
+   }
+   _simultaneos = pior;
+   _ativa = livre;
+}
+
+void CanaisRajada_PI2::definirRampa(float pct_por_s)
+{
+   for (uint8_t c = 0; c < _canais; c++) _rampa[c].configurar(pct_por_s);
+}
+
+void CanaisRajada_PI2::adiarRampa(uint32_t ms)
+{
+   for (uint8_t c = 0; c < _canais; c++) {
+      _rampa[c].adiar(ms);
+      _nivel[c] = 0;
+   }
+   alocar();
+}
+
+int CanaisRajada_PI2::potencia(uint8_t canal)
+{
+   return (canal < _canais) ? _nivel[canal] : 0;
+}
+
+float CanaisRajada_PI2::teto(uint8_t canal)
+{
+   return (canal < _canais) ? _rampa[canal].teto() : 0;
+}
+
+uint8_t CanaisRajada_PI2::canais()
+{
+   return _canais;
+}
+
+uint8_t CanaisRajada_PI2::simultaneos()
+{
+   return _simultaneos;
+}
+
+void IRAM_ATTR CanaisRajada_PI2::cruzamentoZero()
+{
+   uint8_t i = _semiciclo;
+   uint8_t conduzindo = 0;
+#if defined(ESP8266)
+   uint32_t liga = 0, desliga = 0;
+#endif
+
+   const uint32_t (*mascara)[PALAVRAS_RAJADA] = _mascara[_ativa];
+
+   for (uint8_t c = 0; c < _canais; c++) {
+      bool ligado = !_bloqueado && (mascara[c][i >> 5] & (1UL << (i & 31)));
+      if (ligado) conduzindo |= 1 << c;
+#if defined(ESP8266)
+      if (_mascaraPino[c]) {
+         if (ligado) liga |= _mascaraPino[c];
+         else desliga |= _mascaraPino[c];
+         continue;
+      }
+#endif
+      digitalWrite(_pinos[c], ligado ? HIGH : LOW);
+   }
+#if defined(ESP8266)
+   if (liga) GPOS = liga;
+   if (desliga) GPOC = desliga;
+#endif
+   _conduzindo = conduzindo;
+
+   i++;
+   if (i >= JANELA_RAJADA) i = 0;
+   _semiciclo = i;
+}
+
+uint16_t IRAM_ATTR CanaisRajada_PI2::conducao(uint8_t canal)
+{
+   return (_conduzindo >> canal) & 1 ? ENERGIA_ESCALA : 0;
+}
+
+void IRAM_ATTR CanaisRajada_PI2::bloquear()
+{
+   _bloqueado = true;
+#if defined(ESP8266)
+   uint32_t desliga = 0;
+   for (uint8_t c = 0; c < _canais; c++) desliga |= _mascaraPino[c];
+   if (desliga) GPOC = desliga;
+#endif
+   for (uint8_t c = 0; c < _canais; c++) {
+#if defined(ESP8266)
+      if (_mascaraPino[c]) continue;
+#endif
+      digitalWrite(_pinos[c], LOW);
+   }
+}
+
+void CanaisRajada_PI2::liberar()
+{
+   _bloqueado = false;
+}
+
+bool CanaisRajada_PI2::bloqueado()
+{
+   return _bloqueado;
+}
+
+#define US_PARA_TICKS(us) ((uint32_t)(us) * (F_CPU / 16000000L))  // timer1 com TIM_DIV16
+
+#define REDE_CICLOS_US (F_CPU / 1000000L)
+#define REDE_CICLOS(us) ((uint32_t)(us) * REDE_CICLOS_US)
+
+PeriodoRede_PI2::PeriodoRede_PI2()
+{
+   _periodo256 = REDE_CICLOS(SEMICICLO_PADRAO_US) << 8;
+   _ruidos = 0;
+   _perdidos = 0;
+   _boas = 0;
+   _fora = 0;
+   _iniciado = false;
+   _anterior = 0;
+}
+
+bool IRAM_ATTR PeriodoRede_PI2::registrar(uint32_t ciclos)
+{
+   if (!_iniciado) {
+      _anterior = ciclos;
+      _iniciado = true;
+      return true;
+   }
+   uint32_t intervalo = ciclos - _anterior;
+   bool trava = _boas >= REDE_TRAVA;
+   uint32_t periodo = _periodo256 >> 8;
+   uint32_t minimo = trava ? periodo - periodo / 4 : REDE_CICLOS(SEMICICLO_MIN_US);
+   uint32_t maximo = trava ? periodo + periodo / 4 : REDE_CICLOS(SEMICICLO_MAX_US);
+
+   if (intervalo < minimo) {          // ruído no meio do semiciclo
+      _ruidos++;
+      return false;
+   }
+   _anterior = ciclos;
+   if (intervalo > maximo) {          // cruzamento perdido ou rede ainda não vista
+      if (!trava) {
+         _boas = 0;
+      }
+      else {
+         _perdidos++;
+         if (++_fora >= REDE_TRAVA / 4) {   // a grade mudou: trava de novo
+            _boas = 0;
+            _fora = 0;
+         }
+      }
+      return true;
+   }
+
+   _fora = 0;
+   if (_boas == 0) _periodo256 = intervalo << 8;
+   else _periodo256 += ((int32_t)(intervalo << 8) - (int32_t)_periodo256) >> REDE_MEDIA;
+   if (_boas < REDE_TRAVA) _boas++;
+   return true;
+}
+
+uint32_t IRAM_ATTR PeriodoRede_PI2::periodoUs()
+{
+   return travado() ? (_periodo256 / REDE_CICLOS_US + 128) >> 8 : SEMICICLO_PADRAO_US;
+}
+
+float PeriodoRede_PI2::frequencia()
+{
+   return travado() ? 256.0 * F_CPU / (2.0 * _periodo256) : 0;
+}
+
+bool IRAM_ATTR PeriodoRede_PI2::travado()
+{
+   return _boas >= REDE_TRAVA;
+}
+
+uint32_t PeriodoRede_PI2::ruidos()
+{
+   return _ruidos;
+}
+
+uint32_t PeriodoRede_PI2::perdidos()
+{
+   return _perdidos;
+}
+
+enum { FASE_OCIOSA, FASE_AGUARDANDO, FASE_PULSO };
+
+FaseTriac_PI2 *FaseTriac_PI2::_instancia = NULL;
+
+FaseTriac_PI2::FaseTriac_PI2(int pin, PeriodoRede_PI2 *rede)
+{
+   _pin = pin;
+   _mascaraPino = (pin < 16) ? (1UL << pin) : 0;
+   _potencia = 0;
+   _rede = rede;
+   _angulo = 0xFFFF;
+   _conducao = 0;
+   _estado = FASE_OCIOSA;
+   _bloqueado = false;
+}
+
+// Tabela de atraso para cada nível: para carga resistiva a potência com
+// ângulo a é P(a) = 1 - a/pi + sen(2a)/(2 pi); inverte-se por bisseção.
+void FaseTriac_PI2::iniciar()
+{
+   pinMode(_pin, OUTPUT);
+   escreverPino(false);
+
+   for (int nivel = 0; nivel < NIVEIS_POTENCIA; nivel++) {
+      float alvo = nivel / 100.0;
+      float baixo = 0, alto = PI;
+      for (int i = 0; i < 20; i++) {
+         float a = (baixo + alto) / 2;
+         float p = 1 - a / PI + sin(2 * a) / (2 * PI);
+         if (p > alvo) baixo = a;
+         else alto = a;
+      }
+      _tabelaAngulo[nivel] = ((baixo + alto) / 2) / PI;
+   }
+
+   _instancia = this;
+#if defined(ESP8266)
+   timer1_isr_init();
+   timer1_attachInterrupt(interrupcaoTimer);
+#endif
+}
+
+void FaseTriac_PI2::definirRampa(float pct_por_s)
+{
+   _rampa.configurar(pct_por_s);
+}
+
+void FaseTriac_PI2::adiarRampa(uint32_t ms)
+{
+   _rampa.adiar(ms);
+   definirPotencia(0);
+}
+
+void FaseTriac_PI2::definirPotencia(float pot)
+{
+   if (pot < 0) pot = 0;
+   if (pot > 100) pot = 100;
+   pot = _rampa.limitar(pot);
+   _potencia = pot;
+   _conducao = (uint16_t)(pot * ENERGIA_ESCALA / 100 + 0.5f);
+
+   if (pot <= 0) {
+      _angulo = 0xFFFF;
+      return;
+   }
+   if (pot >= 100) {
+      _angulo = 0;
+      return;
+   }
+
+   int nivel = (int)pot;
+   float fracao = pot - nivel;
+   float angulo = _tabelaAngulo[nivel] + fracao * (_tabelaAngulo[nivel + 1] - _tabelaAngulo[nivel]);
+   uint16_t a = (uint16_t)(angulo * 0xFFFF + 0.5f);
+   _angulo = constrain(a, 1, 0xFFFE);
+}
+
+float FaseTriac_PI2::potencia()
+{
+   return _potencia;
+}
+
+float FaseTriac_PI2::teto()
+{
+   return _rampa.teto();
+}
+
+// O atraso sai do período desta rede, em aritmética inteira: a fração
+// de 16 bits vezes o semiciclo em µs cabe em 32 bits
+void IRAM_ATTR FaseTriac_PI2::cruzamentoZero()
+{
+   uint16_t angulo = _bloqueado ? 0xFFFF : _angulo;
+
+   if (angulo == 0xFFFF) {
+      escreverPino(false);
+      _estado = FASE_OCIOSA;
+      return;
+   }
+   if (angulo == 0) {
+      escreverPino(true);
+      _estado = FASE_OCIOSA;
+      return;
+   }
+
+   uint32_t periodo = _rede ? _rede->periodoUs() : SEMICICLO_PADRAO_US;
+   uint32_t atraso = (angulo * periodo) >> 16;
+   // mantém espaço para o pulso antes do próximo cruzamento
+   if (atraso > periodo - 2 * LARGURA_PULSO_US) atraso = periodo - 2 * LARGURA_PULSO_US;
+   if (atraso < LARGURA_PULSO_US) atraso = LARGURA_PULSO_US;
+
+   escreverPino(false);
+   _estado = FASE_AGUARDANDO;
+#if defined(ESP8266)
+   timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);
+   timer1_write(US_PARA_TICKS(atraso));
+#endif
+}
+
+uint16_t IRAM_ATTR FaseTriac_PI2::conducao(uint8_t canal)
+{
+   return (_bloqueado || canal != 0) ? 0 : _conducao;
+}
+
+void IRAM_ATTR FaseTriac_PI2::interrupcaoTimer()
+{
+   FaseTriac_PI2 *f = _instancia;
+   if (f == NULL) return;
+
+   if (f->_estado == FASE_AGUARDANDO && !f->_bloqueado) {
+      f->escreverPino(true);
+      f->_estado = FASE_PULSO;
+#if defined(ESP8266)
+      timer1_write(US_PARA_TICKS(LARGURA_PULSO_US));
+#endif
+   }
+   else {
+      f->escreverPino(false);
+      f->_estado = FASE_OCIOSA;
+#if defined(ESP8266)
+      timer1_disable();
+#endif
+   }
+}
+
+// O pulso eventualmente armado no timer1 é cancelado ao disparar: a
+// interrupção do timer vê a trava e só derruba o gatilho
+void IRAM_ATTR FaseTriac_PI2::bloquear()
+{
+   _bloqueado = true;
+   escreverPino(false);
+}
+
+void FaseTriac_PI2::liberar()
+{
+   _bloqueado = false;
+}
+
+bool FaseTriac_PI2::bloqueado()
+{
+   return _bloqueado;
+}
+
+void IRAM_ATTR FaseTriac_PI2::escreverPino(bool ligado)
+{
+#if defined(ESP8266)
+   if (_mascaraPino) {
+      if (ligado) GPOS = _mascaraPino;
+      else GPOC = _mascaraPino;
+      return;
+   }
+#endif
+   digitalWrite(_pin, ligado ? HIGH : LOW);
+}
+
+MedidorEnergia_PI2::MedidorEnergia_PI2()
+{
+   memset(_watts, 0, sizeof(_watts));
+   _uJ = 0;
+}
+
+void MedidorEnergia_PI2::configurar(uint8_t canal, uint16_t watts)
+{
+   if (canal < CANAIS_MAX) _watts[canal] = watts;
+}
+
+// periodo * ENERGIA_ESCALA e watts * µs de um semiciclo cabem em 32 bits
+void IRAM_ATTR MedidorEnergia_PI2::semiciclo(uint8_t canal, uint16_t conducao, uint32_t periodo_us)
+{
+   if (canal >= CANAIS_MAX || conducao == 0) return;
+   uint32_t conduzido_us = (periodo_us * conducao) / ENERGIA_ESCALA;
+   _uJ += (uint32_t)_watts[canal] * conduzido_us;
+}
+
+uint64_t MedidorEnergia_PI2::microjoules()
+{
+   noInterrupts();
+   uint64_t uJ = _uJ;
+   interrupts();
+   return uJ;
+}
+
+float MedidorEnergia_PI2::wattsHora(uint64_t uJ)
+{
+   return uJ / 3.6e9;
+}
+
+#define LATENCIA_CICLOS_US (F_CPU / 1000000L)
+
+LatenciaZero_PI2::LatenciaZero_PI2()
+{
+   zerar();
+}
+
+void LatenciaZero_PI2::zerar()
+{
+   noInterrupts();
+   memset((void *)&_dados, 0, sizeof(_dados));
+   _periodo256 = 0;
+   _aquecimento = 0;
+   interrupts();
+}
+
+// Grade e período médio recomeçam desta chegada; a medida volta só
+// depois do aquecimento
+void IRAM_ATTR LatenciaZero_PI2::ressincronizar(uint32_t entrada)
+{
+   _previsto = entrada;
+   _fracao = 0;
+   _periodo256 = 0;
+   _aquecimento = 1;
+}
+
+void IRAM_ATTR LatenciaZero_PI2::acumular(volatile HistogramaLatencia &h, uint32_t ciclos)
+{
+   if (ciclos > h.maximo) h.maximo = ciclos;
+   h.soma += ciclos;
+   uint32_t us = ciclos / LATENCIA_CICLOS_US;
+   uint8_t b = (us < 2) ? 0 : 31 - __builtin_clz(us);
+   if (b >= LATENCIA_BALDES) b = LATENCIA_BALDES - 1;
+   h.baldes[b]++;
+}
+
+void IRAM_ATTR LatenciaZero_PI2::registrar(uint32_t entrada, uint32_t saida)
+{
+   uint32_t intervalo = entrada - _anterior;
+   _anterior = entrada;
+   if (_aquecimento == 0) {           // primeiro cruzamento
+      ressincronizar(entrada);
+      return;
+   }
+
+   uint32_t periodo = _periodo256 >> 8;
+   if (_periodo256 == 0) {
+      _periodo256 = intervalo << 8;
+      periodo = intervalo;
+   }
+   else if (intervalo < periodo / 2 || intervalo > periodo + periodo / 2) {
+      _dados.ressincronias++;
+      ressincronizar(entrada);
+      return;
+   }
+   else {
+      _periodo256 += intervalo - periodo;   // média móvel de 256 intervalos
+   }
+   _dados.periodo = periodo;
+
+   // a fração de ciclo do período médio vai somando (60 Hz a 80 MHz são
+   // 666666,67 ciclos): truncada, a grade adiantaria um ciclo a cada três
+   _fracao += _periodo256 & 0xFF;
+   uint32_t previsto = _previsto + periodo + (_fracao >> 8);
+   _fracao &= 0xFF;
+
+   // chegou antes da previsão: a grade estava atrasada e esta chegada é a
+   // nova âncora. Depois, a grade segue 1/64 do atraso. Com o período
+   // certo as correções se anulam; com a rede derivando elas puxam para
+   // um lado, e 1/32 delas vai para o período, que a média de 256
+   // intervalos sozinha seguiria com atraso
+   int32_t atraso = (int32_t)(entrada - previsto);
+   int32_t correcao = (atraso < 0) ? atraso : (atraso >> 6);
+   if (atraso < 0) atraso = 0;
+   _previsto = entrada - atraso + (atraso >> 6);
+   _periodo256 += correcao * 8;
+
+   if (_aquecimento < LATENCIA_AQUECIMENTO) {
+      _aquecimento++;
+      return;
+   }
+   _dados.amostras++;
+   acumular(_dados.entrada, atraso);
+   acumular(_dados.gatilho, atraso + (saida - entrada));
+}
+
+// Cópia coerente: a ISR fica parada durante o memcpy
+void LatenciaZero_PI2::copiar(DadosLatencia &destino)
+{
+   noInterrupts();
+   memcpy(&destino, (const void *)&_dados, sizeof(destino));
+   interrupts();
+}
+
+uint32_t LatenciaZero_PI2::microssegundos(uint32_t ciclos)
+{
+   return ciclos / LATENCIA_CICLOS_US;
+}
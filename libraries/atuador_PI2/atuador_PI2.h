@@ -11,6 +11,38 @@
 
 #include "Arduino.h"
 
+#define NIVEIS_POTENCIA 101   // potência de 0 a 100 %
+#define JANELA_RAJADA   100   // semiciclos por janela de rajada
+#define PALAVRAS_RAJADA ((JANELA_RAJADA + 31) / 32)
+#define LARGURA_PULSO_US 100   // largura do pulso de gatilho no modo de fase
+#define CANAIS_MAX      4     // canais de CanaisRajada_PI2
+#define PASSO_RAJADA    61    // ordem dos semiciclos na alocação de vários canais
+
+#define SEMICICLO_PADRAO_US 8333    // 60 Hz, até PeriodoRede_PI2 travar
+#define SEMICICLO_MIN_US    7500    // 66,7 Hz
+#define SEMICICLO_MAX_US    11000   // 45,5 Hz
+#define REDE_TRAVA          32      // intervalos bons seguidos até valer
+#define REDE_MEDIA          5       // média exponencial de 2^5 intervalos
+#define ENERGIA_ESCALA      1024    // conducao(): fração do semiciclo conduzida
+
+// Limite de subida da potência pedida (partida suave): o teto sobe
+// pct_por_s desde o último pedido e desce junto com a potência, então
+// cortar é sempre imediato. Fica fora da ISR, em definirPotencia().
+class RampaPotencia
+{
+   public:
+       RampaPotencia();
+       void configurar(float pct_por_s);
+       void adiar(uint32_t ms);          // teto em 0 até lá
+       float limitar(float pot);
+       float teto();                     // o que limitar() deixaria passar agora
+
+   private:
+       float _pctPorMs;
+       float _teto;
+       uint32_t _instante;              // millis() do último pedido ou do fim do adiamento
+};
+
 class Triac_PI2
 {
    public:
@@ -23,4 +55,182 @@ class Triac_PI2
   
 };
 
+// Rajada em vários canais (zonas do forno) com uma só ISR de cruzamento
+// por zero. Com vários canais, as potências são enfileiradas numa volta
+// de JANELA_RAJADA posições, cada canal a partir de onde o anterior
+// parou, e a posição p é o semiciclo p * PASSO_RAJADA da janela (passo
+// primo com a janela, perto da razão áurea: qualquer trecho da volta
+// cai espalhado). Um canal ocupa no máximo uma volta, então nunca pega
+// o mesmo semiciclo duas vezes, e em cada semiciclo conduzem soma/100
+// canais, arredondado para baixo ou para cima: o menor pico de corrente
+// possível na rede com a potência de cada canal exata. Com um canal
+// fica o sigma-delta, o mais espalhado. As máscaras são recalculadas
+// em definirPotencia(), fora da ISR, num segundo buffer trocado de uma
+// vez; a ISR só testa um bit por canal e escreve GPOS/GPOC uma vez.
+class CanaisRajada_PI2
+{
+   public:
+       CanaisRajada_PI2(const uint8_t *pinos, uint8_t canais);
+       void iniciar();
+       void definirPotencia(uint8_t canal, int pot);   // 0-100 %
+       int potencia(uint8_t canal);
+       float teto(uint8_t canal);            // potência máxima aceita agora pela rampa
+       void definirRampa(float pct_por_s);   // subida máxima, 0 = sem limite
+       void adiarRampa(uint32_t ms);         // partida escalonada: só sobe depois de ms
+       uint8_t canais();
+       void cruzamentoZero();            // chamar na ISR do cruzamento por zero
+       uint16_t conducao(uint8_t canal); // do semiciclo que começou, em 1/ENERGIA_ESCALA
+       uint8_t simultaneos();            // canais juntos no pior semiciclo da janela
+       void bloquear();                  // desliga já e ignora a potência até liberar()
+       void liberar();
+       bool bloqueado();
+
+   private:
+       uint8_t _canais;
+       uint8_t _pinos[CANAIS_MAX];
+       uint32_t _mascaraPino[CANAIS_MAX];    // 0 para o GPIO16
+       uint8_t _nivel[CANAIS_MAX];
+       uint32_t _mascara[2][CANAIS_MAX][PALAVRAS_RAJADA];   // semiciclos de cada canal
+       volatile uint8_t _ativa;              // buffer lido pela ISR
+       uint8_t _simultaneos;
+       volatile uint8_t _conduzindo;         // bit por canal, do último cruzamento
+       volatile uint8_t _semiciclo;
+       volatile bool _bloqueado;
+       RampaPotencia _rampa[CANAIS_MAX];
+
+       void alocar();
+};
+
+// Período do semiciclo da rede medido nas chegadas da ISR de cruzamento
+// por zero, em média exponencial: serve 50 e 60 Hz sem recompilar e
+// acompanha a deriva da frequência. Antes de REDE_TRAVA intervalos bons
+// seguidos vale SEMICICLO_PADRAO_US. É também o filtro da ISR: um pulso
+// antes de 3/4 do período (antes de SEMICICLO_MIN_US, sem trava) é ruído
+// no optoacoplador, não move a âncora e registrar() devolve falso para o
+// motor de disparo não contar o semiciclo. Um intervalo além de 5/4 é um
+// cruzamento perdido e só reancora (muitos seguidos destravam). Os
+// instantes são do contador de ciclos da CPU (CCOUNT), lido de graça.
+class PeriodoRede_PI2
+{
+   public:
+       PeriodoRede_PI2();
+       bool registrar(uint32_t ciclos);     // na ISR; falso = ruído, ignorar a borda
+       uint32_t periodoUs();                // semiciclo médio
+       float frequencia();                  // Hz, 0 até travar
+       bool travado();
+       uint32_t ruidos();                   // bordas rejeitadas
+       uint32_t perdidos();                 // cruzamentos que não chegaram
+
+   private:
+       volatile uint32_t _periodo256;   // ciclos * 256
+       volatile uint32_t _ruidos;
+       volatile uint32_t _perdidos;
+       volatile uint8_t _boas;          // intervalos bons seguidos, até REDE_TRAVA
+       uint8_t _fora;                   // intervalos longos seguidos, já travado
+       bool _iniciado;
+       uint32_t _anterior;
+};
+
+// Controle por ângulo de fase (exige optoacoplador sem detecção de zero,
+// ex. MOC3021). A ISR de cruzamento por zero arma o timer1 com o atraso
+// de disparo; a interrupção do timer1 liga o gatilho e, na seguinte,
+// derruba o gatilho. Não há espera ativa. O atraso é a fração do
+// semiciclo de cada nível vezes o período medido por `rede`, se houver.
+class FaseTriac_PI2
+{
+   public:
+       FaseTriac_PI2(int pin, PeriodoRede_PI2 *rede = NULL);
+       void iniciar();
+       void definirPotencia(float pot);  // 0-100 %, com fração
+       float potencia();
+       float teto();                         // potência máxima aceita agora pela rampa
+       void definirRampa(float pct_por_s);   // subida máxima, 0 = sem limite
+       void adiarRampa(uint32_t ms);         // partida escalonada: só sobe depois de ms
+       void cruzamentoZero();            // chamar na ISR do cruzamento por zero
+       uint16_t conducao(uint8_t canal = 0);   // do semiciclo que começou, em 1/ENERGIA_ESCALA
+       void bloquear();                  // desliga já e ignora a potência até liberar()
+       void liberar();
+       bool bloqueado();
+
+   private:
+       int _pin;
+       uint32_t _mascaraPino;
+       float _potencia;
+       volatile uint16_t _conducao;      // potência em 1/ENERGIA_ESCALA
+       RampaPotencia _rampa;
+       PeriodoRede_PI2 *_rede;
+       volatile uint16_t _angulo;        // fração do semiciclo * 65535: 0 = sempre ligado, 65535 = desligado
+       volatile uint8_t _estado;
+       volatile bool _bloqueado;
+       float _tabelaAngulo[NIVEIS_POTENCIA];  // atraso relativo ao semiciclo
+
+       static FaseTriac_PI2 *_instancia;
+       static void interrupcaoTimer();
+       void escreverPino(bool ligado);
+};
+
+// Energia entregue às resistências: a cada cruzamento, por canal, a
+// potência nominal vezes o tempo conduzido no semiciclo (W * µs = µJ),
+// só com inteiros de 32 bits na ISR e a soma em 64 bits. Para carga
+// resistiva a fração de potência do ângulo de fase é a fração de energia.
+class MedidorEnergia_PI2
+{
+   public:
+       MedidorEnergia_PI2();
+       void configurar(uint8_t canal, uint16_t watts);
+       void semiciclo(uint8_t canal, uint16_t conducao, uint32_t periodo_us);   // na ISR
+       uint64_t microjoules();           // desde o boot, todos os canais
+       static float wattsHora(uint64_t uJ);
+
+   private:
+       uint16_t _watts[CANAIS_MAX];
+       volatile uint64_t _uJ;
+};
+
+// Latência da ISR do cruzamento por zero. Não há marca de tempo do
+// flanco em hardware: o instante do cruzamento é previsto pela grade da
+// rede (período médio dos intervalos entre interrupções) ancorada nas
+// chegadas mais cedo, que são as de menor latência. A entrada da ISR é
+// comparada com essa previsão; a saída, depois de escrever o GPIO do
+// gatilho, dá o atraso até o triac mudar. Os tempos vêm do contador de
+// ciclos da CPU (CCOUNT) lido pelo sketch na entrada e na saída da ISR.
+// O atraso fixo do optoacoplador fica fora: é o mesmo em todo semiciclo.
+#define LATENCIA_BALDES      12   // [0,2) µs, [2,4) ... [1024,2048), 2048 ou mais
+#define LATENCIA_AQUECIMENTO 250  // cruzamentos até o período médio assentar
+
+struct HistogramaLatencia {
+  uint32_t maximo;                // ciclos
+  uint64_t soma;                  // ciclos
+  uint32_t baldes[LATENCIA_BALDES];
+};
+
+struct DadosLatencia {
+  uint32_t amostras;              // cruzamentos medidos (fora o aquecimento)
+  uint32_t ressincronias;         // intervalos fora de 1/2..3/2 período: ruído ou perda
+  uint32_t periodo;               // ciclos entre cruzamentos, média
+  HistogramaLatencia entrada;     // cruzamento previsto -> entrada da ISR
+  HistogramaLatencia gatilho;     // cruzamento previsto -> GPIO do triac escrito
+};
+
+class LatenciaZero_PI2
+{
+   public:
+       LatenciaZero_PI2();
+       void registrar(uint32_t entrada, uint32_t saida);   // na ISR, em ciclos
+       void copiar(DadosLatencia &destino);                // fora da ISR
+       void zerar();
+       static uint32_t microssegundos(uint32_t ciclos);
+
+   private:
+       volatile DadosLatencia _dados;
+       uint32_t _anterior;        // entrada da ISR anterior
+       uint32_t _previsto;        // cruzamento previsto do semiciclo anterior
+       uint32_t _periodo256;      // período médio * 256 (até 16M ciclos)
+       uint32_t _fracao;          // fração de ciclo acumulada da grade, * 256
+       uint8_t _aquecimento;
+
+       void ressincronizar(uint32_t entrada);
+       static void acumular(volatile HistogramaLatencia &h, uint32_t ciclos);
+};
+
 #endif
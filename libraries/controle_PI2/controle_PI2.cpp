@@ -0,0 +1,750 @@
+/*  Biblioteca do Sistema de Controle do Forno
+ *
+ *  controle_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "controle_PI2.h"
+
+PidController::PidController(float kc, float ki, float kd, float umin, float umax) {
+  configurar(kc, ki, kd);
+  limites(umin, umax);
+  reiniciar();
+}
+
+void PidController::configurar(float kc, float ki, float kd) {
+  kcQ = PARA_Q16(kc);
+  kiQ = PARA_Q16(ki);
+  kdQ = PARA_Q16(kd);
+}
+
+void PidController::limites(float umin, float umax) {
+  uminQ = PARA_Q16(umin);
+  umaxQ = PARA_Q16(umax);
+}
+
+void PidController::reiniciar(void) {
+  integradorQ = 0;
+  medidaAnteriorQ = 0;
+  saidaQ = 0;
+  primeira = true;
+}
+
+// Produto Q16.16 com intermediário de 64 bits
+int32_t PidController::multiplicar(int32_t a, int32_t b) {
+  return (int32_t)(((int64_t)a * b) >> 16);
+}
+
+int32_t PidController::atualizarQ16(int32_t referencia, int32_t medida) {
+  int32_t erro = referencia - medida;
+
+  if (primeira) {
+    medidaAnteriorQ = medida;
+    primeira = false;
+  }
+
+  int32_t p = multiplicar(kcQ, erro);
+  int32_t d = -multiplicar(kdQ, medida - medidaAnteriorQ);
+  int32_t incremento = multiplicar(kiQ, erro);
+  int32_t u = p + integradorQ + incremento + d;
+
+  // integração condicional
+  bool saturaAlto = (u > umaxQ) && (erro > 0);
+  bool saturaBaixo = (u < uminQ) && (erro < 0);
+  if (!saturaAlto && !saturaBaixo) {
+    integradorQ += incremento;
+  }
+
+  u = p + integradorQ + d;
+  if (u > umaxQ) u = umaxQ;
+  if (u < uminQ) u = uminQ;
+
+  medidaAnteriorQ = medida;
+  saidaQ = u;
+  return u;
+}
+
+float PidController::atualizar(float referencia, float medida) {
+  return DE_Q16(atualizarQ16(PARA_Q16(referencia), PARA_Q16(medida)));
+}
+
+float PidController::saida(void) {
+  return DE_Q16(saidaQ);
+}
+
+float PidController::integral(void) {
+  return DE_Q16(integradorQ);
+}
+
+AutoSintonia_PI2::AutoSintonia_PI2() {
+  situacao = SINTONIA_PARADA;
+  ciclosMedidos = 0;
+  kuCalc = puCalc = 0;
+}
+
+// Mede `ciclos` ciclos de oscilação. Sem concluir em maxAmostras, ou com a
+// medida acima de `limite`, a sintonia falha com a saída em umin.
+void AutoSintonia_PI2::iniciar(float setPoint, float histerese, float umin, float umax,
+                               uint8_t ciclos, uint32_t maxAmostras, float limite) {
+  sp = setPoint;
+  hist = histerese;
+  baixo = umin;
+  alto = umax;
+  this->limite = limite;
+  ciclosAlvo = ciclos > 0 ? ciclos : 1;
+  this->maxAmostras = maxAmostras;
+  amostra = 0;
+  ligado = true;
+  ultimaSubida = 0;
+  subidas = 0;
+  maximo = -1e9;
+  minimo = 1e9;
+  somaPeriodo = somaAmplitude = 0;
+  ciclosMedidos = 0;
+  kuCalc = puCalc = 0;
+  situacao = SINTONIA_RODANDO;
+}
+
+float AutoSintonia_PI2::atualizar(float medida) {
+  if (situacao != SINTONIA_RODANDO) return baixo;
+
+  if (!(medida < limite) || ++amostra > maxAmostras) {
+    situacao = SINTONIA_FALHOU;
+    return baixo;
+  }
+
+  if (medida > maximo) maximo = medida;
+  if (medida < minimo) minimo = medida;
+
+  if (ligado && medida > sp + hist) {
+    ligado = false;
+  }
+  else if (!ligado && medida < sp - hist) {
+    ligado = true;
+    // cada subida fecha um ciclo iniciado na subida anterior; o primeiro
+    // ciclo ainda carrega o transitório da partida e fica de fora
+    subidas++;
+    if (subidas >= 3) {
+      somaPeriodo += amostra - ultimaSubida;
+      somaAmplitude += (maximo - minimo) / 2;
+      ciclosMedidos++;
+    }
+    ultimaSubida = amostra;
+    maximo = minimo = medida;
+    if (ciclosMedidos >= ciclosAlvo) {
+      concluir();
+      return baixo;
+    }
+  }
+  return ligado ? alto : baixo;
+}
+
+void AutoSintonia_PI2::concluir(void) {
+  float a = somaAmplitude / ciclosMedidos;
+  float d = (alto - baixo) / 2;
+  // a histerese atrasa a troca do relé; descontá-la da amplitude
+  float efetiva = a * a - hist * hist;
+  if (efetiva <= 0) {
+    situacao = SINTONIA_FALHOU;
+    return;
+  }
+  kuCalc = 4 * d / (PI * sqrt(efetiva));
+  puCalc = somaPeriodo / ciclosMedidos;
+  situacao = SINTONIA_CONCLUIDA;
+}
+
+void AutoSintonia_PI2::cancelar(void) {
+  if (situacao == SINTONIA_RODANDO) situacao = SINTONIA_PARADA;
+}
+
+uint8_t AutoSintonia_PI2::estado(void) {
+  return situacao;
+}
+
+uint8_t AutoSintonia_PI2::ciclos(void) {
+  return ciclosMedidos;
+}
+
+float AutoSintonia_PI2::ku(void) {
+  return kuCalc;
+}
+
+float AutoSintonia_PI2::pu(void) {
+  return puCalc;
+}
+
+// Ganhos discretos por amostra: ki = Kp/Ti e kd = Kp*Td com Ti e Td em amostras
+bool AutoSintonia_PI2::ganhos(uint8_t regra, float &kc, float &ki, float &kd) {
+  if (situacao != SINTONIA_CONCLUIDA) return false;
+
+  float kp, ti, td;
+  switch (regra) {
+    case REGRA_ZIEGLER_NICHOLS:   kp = 0.6f * kuCalc;  ti = puCalc / 2; td = puCalc / 8; break;
+    case REGRA_POUCO_SOBRESSINAL: kp = 0.33f * kuCalc; ti = puCalc / 2; td = puCalc / 3; break;
+    default:                      kp = 0.2f * kuCalc;  ti = puCalc / 2; td = puCalc / 3; break;
+  }
+  kc = kp;
+  ki = kp / ti;
+  kd = kp * td;
+  return true;
+}
+
+ModeloTermico_PI2::ModeloTermico_PI2() {
+  configurar(0, 0, 25);
+}
+
+// ganho em C por % de potência, tau em s; ganho 0 desliga o modelo
+void ModeloTermico_PI2::configurar(float ganho, float tau_s, float ambiente) {
+  k = ganho;
+  constante = tau_s;
+  tamb = ambiente;
+}
+
+// Ambiente medido durante a operação (o de configurar() é o do ensaio)
+void ModeloTermico_PI2::definirAmbiente(float ambiente) {
+  tamb = ambiente;
+}
+
+bool ModeloTermico_PI2::ativo(void) {
+  return k > 0;
+}
+
+float ModeloTermico_PI2::potencia(float setPoint, float inclinacao) {
+  if (!ativo()) return 0;
+  return (setPoint - tamb + constante * inclinacao) / k;
+}
+
+float ModeloTermico_PI2::ganho(void) {
+  return k;
+}
+
+float ModeloTermico_PI2::tau(void) {
+  return constante;
+}
+
+float ModeloTermico_PI2::ambiente(void) {
+  return tamb;
+}
+
+float controleRampa(PidController &pid, ModeloTermico_PI2 &modelo,
+                    float setPoint, float inclinacao, float medida, float teto) {
+  float ff = constrain(modelo.potencia(setPoint, inclinacao), 0.0f, 100.0f);
+  teto = constrain(teto, 0.0f, 100.0f);
+  pid.limites(0 - ff, teto - ff);
+  return pid.atualizar(setPoint, medida) + ff;
+}
+
+ControlePreditivo_PI2::ControlePreditivo_PI2() {
+  configurado = false;
+  reiniciar();
+}
+
+// passo_s é o intervalo entre os pontos previstos; ts_s, o período das
+// chamadas de atualizar(). Sem modelo identificado não há o que prever
+bool ControlePreditivo_PI2::configurar(ModeloTermico_PI2 &modelo, float passo_s, float ts_s, float lambda) {
+  configurado = modelo.ativo() && modelo.tau() > 0 && passo_s >= ts_s && ts_s > 0;
+  if (!configurado) return false;
+
+  float a = expf(-passo_s / modelo.tau());
+  float ai = 1, soma2 = lambda, somaEstado = 0;
+  float g[PREDITIVO_HORIZONTE], ag[PREDITIVO_HORIZONTE];
+  for (uint8_t i = 0; i < PREDITIVO_HORIZONTE; i++) {
+    ai *= a;
+    g[i] = modelo.ganho() * (1 - ai);
+    ag[i] = ai * g[i];
+    soma2 += g[i] * g[i];
+    somaEstado += ag[i];
+  }
+  for (uint8_t i = 0; i < PREDITIVO_HORIZONTE; i++) coef[i] = g[i] / soma2;
+  coefEstado = somaEstado / soma2;
+  coefAnterior = lambda / soma2;
+
+  aPasso = a;
+  bPasso = modelo.ganho() * (1 - a);
+  tamb = modelo.ambiente();
+  amostrasPasso = lroundf(passo_s / ts_s);
+  reiniciar();
+  return true;
+}
+
+void ControlePreditivo_PI2::reiniciar(void) {
+  du = 0;
+  vAnterior = 0;
+  contador = 0;
+  somaU = 0;
+  primeira = true;
+}
+
+bool ControlePreditivo_PI2::ativo(void) {
+  return configurado;
+}
+
+float ControlePreditivo_PI2::atualizar(const float *referencias, float medida, float teto) {
+  if (!configurado) return 0;
+
+  // observador: compara a medida com o que o modelo previa no início
+  // da janela para a potência média aplicada desde então
+  if (primeira) {
+    medidaInicio = medida;
+    primeira = false;
+  }
+  else if (contador >= amostrasPasso) {
+    float previsto = tamb + aPasso * (medidaInicio - tamb) + bPasso * (somaU / contador + du);
+    du = constrain(du + PREDITIVO_OBSERVADOR * (medida - previsto) / bPasso, -100.0f, 100.0f);
+    medidaInicio = medida;
+    contador = 0;
+    somaU = 0;
+  }
+
+  float v = coefAnterior * vAnterior - coefEstado * (medida - tamb);
+  for (uint8_t i = 0; i < PREDITIVO_HORIZONTE; i++) v += coef[i] * (referencias[i] - tamb);
+  // somaU fica com a potência aplicada: o que o teto cortou não vira perturbação
+  float u = constrain(v - du, 0.0f, constrain(teto, 0.0f, 100.0f));
+
+  vAnterior = u + du;
+  somaU += u;
+  contador++;
+  return u;
+}
+
+// O observador absorve o que o ambiente novo ainda errar
+void ControlePreditivo_PI2::definirAmbiente(float ambiente) {
+  tamb = ambiente;
+}
+
+float ControlePreditivo_PI2::perturbacao(void) {
+  return du;
+}
+
+EstimadorTermico_PI2::EstimadorTermico_PI2() {
+  configurado = false;
+  reiniciar();
+}
+
+// ts_s é o período das chamadas de atualizar(); tauTermopar_s, o atraso
+// entre a câmara e a leitura filtrada
+bool EstimadorTermico_PI2::configurar(ModeloTermico_PI2 &modelo, float ts_s, float tauTermopar_s) {
+  configurado = modelo.ativo() && modelo.tau() > 0 && tauTermopar_s > 0 && ts_s > 0;
+  if (!configurado) return false;
+
+  k = modelo.ganho();
+  tau = modelo.tau();
+  tamb = modelo.ambiente();
+  ac = expf(-ts_s / tau);
+  at = expf(-ts_s / tauTermopar_s);
+  bc = (1 - ac) * k;
+  qc = ESTIMADOR_PROCESSO_C * ESTIMADOR_PROCESSO_C * ts_s;
+  qd = ESTIMADOR_PERTURBACAO * ESTIMADOR_PERTURBACAO * ts_s;
+  reiniciar();
+  return true;
+}
+
+void EstimadorTermico_PI2::reiniciar(void) {
+  iniciado = false;
+  uAnterior = 0;
+  memset(x, 0, sizeof(x));
+  memset(P, 0, sizeof(P));
+}
+
+bool EstimadorTermico_PI2::ativo(void) {
+  return configurado;
+}
+
+float EstimadorTermico_PI2::atualizar(float potencia, float medida, bool nova) {
+  if (!configurado || isnan(medida)) return medida;
+  uAnterior = potencia;
+
+  if (!iniciado) {
+    // parado e em equilíbrio com a leitura; a perturbação ainda é incerta
+    x[0] = x[1] = medida - tamb;
+    x[2] = 0;
+    memset(P, 0, sizeof(P));
+    P[0][0] = P[1][1] = ESTIMADOR_RUIDO_C * ESTIMADOR_RUIDO_C;
+    P[2][2] = 100;
+    iniciado = true;
+    return medida;
+  }
+
+  // previsão: x = F x + B u, P = F P F' + Q, com
+  //   F = | ac     0   bc |
+  //       | 1-at  at   0  |
+  //       | 0      0   1  |
+  float F[3][3] = { { ac, 0, bc }, { 1 - at, at, 0 }, { 0, 0, 1 } };
+  float c = ac * x[0] + bc * (potencia + x[2]);
+  x[1] = at * x[1] + (1 - at) * x[0];
+  x[0] = c;
+
+  float FP[3][3];
+  for (uint8_t i = 0; i < 3; i++) {
+    for (uint8_t j = 0; j < 3; j++) {
+      FP[i][j] = F[i][0] * P[0][j] + F[i][1] * P[1][j] + F[i][2] * P[2][j];
+    }
+  }
+  for (uint8_t i = 0; i < 3; i++) {
+    for (uint8_t j = 0; j < 3; j++) {
+      P[i][j] = FP[i][0] * F[j][0] + FP[i][1] * F[j][1] + FP[i][2] * F[j][2];
+    }
+  }
+  P[0][0] += qc;
+  P[2][2] += qd;
+
+  // correção só com amostra nova: a medida é a junta, H = | 0 1 0 |
+  if (nova) {
+    float s = P[1][1] + ESTIMADOR_RUIDO_C * ESTIMADOR_RUIDO_C;
+    float inovacao = (medida - tamb) - x[1];
+    float K[3] = { P[0][1] / s, P[1][1] / s, P[2][1] / s };
+    float linha[3] = { P[1][0], P[1][1], P[1][2] };
+    for (uint8_t i = 0; i < 3; i++) {
+      x[i] += K[i] * inovacao;
+      for (uint8_t j = 0; j < 3; j++) P[i][j] -= K[i] * linha[j];
+    }
+    x[2] = constrain(x[2], -100.0f, 100.0f);
+  }
+  return temperatura();
+}
+
+// Os estados são excessos sobre o ambiente: mudam junto, as temperaturas não
+void EstimadorTermico_PI2::definirAmbiente(float ambiente) {
+  if (iniciado) {
+    x[0] += tamb - ambiente;
+    x[1] += tamb - ambiente;
+  }
+  tamb = ambiente;
+}
+
+float EstimadorTermico_PI2::temperatura(void) {
+  return tamb + x[0];
+}
+
+float EstimadorTermico_PI2::taxa(void) {
+  if (!configurado) return 0;
+  return (k * (uAnterior + x[2]) - x[0]) / tau;
+}
+
+float EstimadorTermico_PI2::perturbacao(void) {
+  return x[2];
+}
+
+EnsaioDegrau_PI2::EnsaioDegrau_PI2() {
+  situacao = SINTONIA_PARADA;
+  kCalc = tauCalc = 0;
+  inicial = 0;
+}
+
+// A temperatura é tida como estável quando varia menos de 0,5 C em 60 s
+void EnsaioDegrau_PI2::iniciar(float potencia, float periodo_s, uint32_t maxAmostras, float limite) {
+  u = potencia;
+  periodo = periodo_s;
+  this->limite = limite;
+  this->maxAmostras = maxAmostras;
+  amostra = 0;
+  janela = (uint32_t)(60 / periodo_s);
+  if (janela == 0) janela = 1;
+  pontos = 0;
+  passo = 1;
+  kCalc = tauCalc = 0;
+  situacao = SINTONIA_RODANDO;
+}
+
+float EnsaioDegrau_PI2::atualizar(float medida) {
+  if (situacao != SINTONIA_RODANDO) return 0;
+
+  if (!(medida < limite) || amostra >= maxAmostras) {
+    situacao = SINTONIA_FALHOU;
+    return 0;
+  }
+
+  if (amostra == 0) inicial = referencia = medida;
+
+  // registro cheio: fica com um ponto de cada dois e dobra o passo
+  if (amostra % passo == 0) {
+    if (pontos == ENSAIO_PONTOS) {
+      for (uint16_t i = 0; i < ENSAIO_PONTOS / 2; i++) registro[i] = registro[2 * i];
+      pontos = ENSAIO_PONTOS / 2;
+      passo *= 2;
+    }
+    if (amostra % passo == 0) registro[pontos++] = medida;
+  }
+
+  amostra++;
+  if (amostra % janela == 0) {
+    if (fabs(medida - referencia) < 0.5 && medida - inicial > 5) {
+      concluir(medida, (medida - referencia) / (janela * periodo));
+      return 0;
+    }
+    referencia = medida;
+  }
+  return u;
+}
+
+// O critério de estabilidade para a resposta um pouco antes do fim; em
+// primeira ordem Tf = T + tau * dT/dt, então o valor final é corrigido
+// pela inclinação da última janela, refinando tau a cada passada
+void EnsaioDegrau_PI2::concluir(float medida, float inclinacao) {
+  float final = medida;
+  for (uint8_t passada = 0; passada < 4; passada++) {
+    float alvo = inicial + 0.632 * (final - inicial);
+    tauCalc = 0;
+    for (uint16_t i = 1; i < pontos; i++) {
+      if (registro[i] < alvo) continue;
+      float fracao = (alvo - registro[i - 1]) / (registro[i] - registro[i - 1]);
+      tauCalc = (i - 1 + fracao) * passo * periodo;
+      break;
+    }
+    final = medida + tauCalc * inclinacao;
+  }
+  kCalc = (final - inicial) / u;
+  situacao = (tauCalc > 0 && kCalc > 0) ? SINTONIA_CONCLUIDA : SINTONIA_FALHOU;
+}
+
+void EnsaioDegrau_PI2::cancelar(void) {
+  if (situacao == SINTONIA_RODANDO) situacao = SINTONIA_PARADA;
+}
+
+uint8_t EnsaioDegrau_PI2::estado(void) {
+  return situacao;
+}
+
+float EnsaioDegrau_PI2::ganho(void) {
+  return kCalc;
+}
+
+float EnsaioDegrau_PI2::tau(void) {
+  return tauCalc;
+}
+
+float EnsaioDegrau_PI2::ambiente(void) {
+  return inicial;
+}
+
+IdentificacaoTermica_PI2::IdentificacaoTermica_PI2() {
+  situacao = SINTONIA_PARADA;
+  passos = 0;
+  escolhido = 0;
+  kCalc = tauCalc = tauRapidoCalc = ambienteCalc = 0;
+}
+
+// P começa grande: sem nada sabido dos coeficientes, as primeiras amostras
+// mandam
+void IdentificacaoTermica_PI2::iniciar(float ts_s, float passo_s) {
+  porPasso = (uint16_t)lroundf(passo_s / ts_s);
+  if (porPasso == 0) porPasso = 1;
+  passo = porPasso * ts_s;
+  memset(theta, 0, sizeof(theta));
+  memset(P, 0, sizeof(P));
+  for (uint8_t d = 0; d < IDENT_ATRASOS; d++) {
+    for (uint8_t i = 0; i < IDENT_PARAMETROS; i++) P[d][i][i] = 1000;
+    somaErro[d] = 0;
+    entradas[d] = 0;
+  }
+  somaU = 0;
+  contador = 0;
+  passos = 0;
+  escolhido = 0;
+  kCalc = tauCalc = tauRapidoCalc = ambienteCalc = 0;
+  situacao = SINTONIA_RODANDO;
+}
+
+void IdentificacaoTermica_PI2::adicionar(float potencia, float medida) {
+  if (situacao != SINTONIA_RODANDO || isnan(medida)) return;
+  somaU += potencia;
+  if (++contador < porPasso) return;
+
+  float y = medida / IDENT_ESCALA;
+  float u = somaU / contador / IDENT_ESCALA;
+  somaU = 0;
+  contador = 0;
+
+  // u[k] é a média do passo que termina em T[k]: d = 0 é sem atraso puro
+  for (uint8_t d = IDENT_ATRASOS - 1; d > 0; d--) entradas[d] = entradas[d - 1];
+  entradas[0] = u;
+
+  // dois passos para ter T[k-1] e T[k-2]; o erro de previsão só conta
+  // depois de IDENT_MINIMO / 2, quando os coeficientes já saíram do zero
+  if (passos >= 2) {
+    for (uint8_t d = 0; d < IDENT_ATRASOS; d++) {
+      float phi[IDENT_PARAMETROS] = { y1, (y1 - y2) * (float)IDENT_DERIVADA, entradas[d], 1 };
+      float *t = theta[d];
+      float (*p)[IDENT_PARAMETROS] = P[d];
+
+      float Pphi[IDENT_PARAMETROS];
+      float s = 1;
+      float previsto = 0;
+      for (uint8_t i = 0; i < IDENT_PARAMETROS; i++) {
+        Pphi[i] = 0;
+        for (uint8_t j = 0; j < IDENT_PARAMETROS; j++) Pphi[i] += p[i][j] * phi[j];
+        s += phi[i] * Pphi[i];
+        previsto += t[i] * phi[i];
+      }
+      float e = (y - y1) - previsto;
+      if (passos >= IDENT_MINIMO / 2) somaErro[d] += e * e;
+
+      // theta += K e, P -= K phi' P, com K = P phi / s; P fica simétrica
+      for (uint8_t i = 0; i < IDENT_PARAMETROS; i++) t[i] += Pphi[i] / s * e;
+      for (uint8_t i = 0; i < IDENT_PARAMETROS; i++) {
+        for (uint8_t j = i; j < IDENT_PARAMETROS; j++) {
+          p[i][j] -= Pphi[i] * Pphi[j] / s;
+          p[j][i] = p[i][j];
+        }
+      }
+    }
+  }
+
+  y2 = (passos == 0) ? y : y1;
+  y1 = y;
+  if (passos < 0xFFFF) passos++;
+}
+
+bool IdentificacaoTermica_PI2::concluir(void) {
+  if (situacao != SINTONIA_RODANDO) return situacao == SINTONIA_CONCLUIDA;
+  situacao = SINTONIA_FALHOU;
+  if (passos < IDENT_MINIMO) return false;
+
+  escolhido = 0;
+  for (uint8_t d = 1; d < IDENT_ATRASOS; d++) {
+    if (somaErro[d] < somaErro[escolhido]) escolhido = d;
+  }
+  const float *t = theta[escolhido];
+  float a2 = -t[1] * IDENT_DERIVADA;
+  float a1 = t[0] + 1 - a2;
+  float b = t[2], c = t[3];
+  float resto = 1 - a1 - a2;       // o ganho estático divide por isto
+  if (!(resto > 0)) return false;
+
+  kCalc = b / resto;
+  ambienteCalc = c / resto * IDENT_ESCALA;
+  float discriminante = a1 * a1 + 4 * a2;
+  float r1 = 0, r2 = 0;
+  if (discriminante >= 0) {
+    r1 = (a1 + sqrtf(discriminante)) / 2;
+    r2 = (a1 - sqrtf(discriminante)) / 2;
+  }
+  if (r1 > 0 && r1 < 1 && r2 > 0 && r2 < 1) {
+    tauCalc = -passo / logf(r1);
+    tauRapidoCalc = -passo / logf(r2);
+  }
+  else {
+    tauCalc = passo * (a1 + 2 * a2) / resto;
+    tauRapidoCalc = 0;
+  }
+
+  if (!(kCalc > 0 && kCalc < 100 && tauCalc > 0 && tauCalc < 10000)) return false;
+  situacao = SINTONIA_CONCLUIDA;
+  return true;
+}
+
+void IdentificacaoTermica_PI2::cancelar(void) {
+  if (situacao == SINTONIA_RODANDO) situacao = SINTONIA_PARADA;
+}
+
+uint8_t IdentificacaoTermica_PI2::estado(void) {
+  return situacao;
+}
+
+uint16_t IdentificacaoTermica_PI2::amostras(void) {
+  return passos;
+}
+
+float IdentificacaoTermica_PI2::ganho(void) {
+  return kCalc;
+}
+
+float IdentificacaoTermica_PI2::tau(void) {
+  return tauCalc;
+}
+
+float IdentificacaoTermica_PI2::tauRapido(void) {
+  return tauRapidoCalc;
+}
+
+float IdentificacaoTermica_PI2::atraso(void) {
+  return escolhido * passo;
+}
+
+float IdentificacaoTermica_PI2::tauModelo(void) {
+  return tauCalc + tauRapidoCalc / 2;
+}
+
+float IdentificacaoTermica_PI2::atrasoLeitura(void) {
+  return atraso() + tauRapidoCalc / 2;
+}
+
+float IdentificacaoTermica_PI2::ambiente(void) {
+  return ambienteCalc;
+}
+
+float IdentificacaoTermica_PI2::erro(void) {
+  uint16_t n = (passos > IDENT_MINIMO / 2) ? passos - IDENT_MINIMO / 2 : 0;
+  return n ? sqrtf(somaErro[escolhido] / n) * IDENT_ESCALA : 0;
+}
+
+Supervisor_PI2::Supervisor_PI2() {
+  maxima = SUPERVISOR_MAXIMA;
+  subidaMax = SUPERVISOR_SUBIDA_MAX;
+  desarme = DESARME_NENHUM;
+  refSubida = NAN;
+  inicioSubida = 0;
+  aquecendo = false;
+}
+
+void Supervisor_PI2::configurar(float maxima, float subidaMax) {
+  this->maxima = maxima;
+  this->subidaMax = subidaMax;
+}
+
+// A cada período de controle. instante = 0 enquanto não houve leitura;
+// devolve o motivo travado (DESARME_NENHUM se está tudo bem)
+uint8_t Supervisor_PI2::verificar(float temperatura, uint32_t instante, float potencia, uint32_t agora) {
+  if (desarme != DESARME_NENHUM) return desarme;
+
+  if (isnan(temperatura)) {
+    desarme = DESARME_SENSOR_FALHA;
+  }
+  else if (instante != 0 && (uint32_t)(agora - instante) > SUPERVISOR_IDADE_MS) {
+    desarme = DESARME_SENSOR_PARADO;
+  }
+  else if (temperatura >= maxima) {
+    desarme = DESARME_TEMPERATURA;
+  }
+  if (desarme != DESARME_NENHUM || instante == 0) return desarme;
+
+  // taxa medida entre leituras a ~2 s, acima do ruído do termopar
+  if (isnan(refSubida)) {
+    refSubida = temperatura;
+    inicioSubida = agora;
+  }
+  else if ((uint32_t)(agora - inicioSubida) >= SUPERVISOR_JANELA_MS) {
+    float taxa = (temperatura - refSubida) * 1000.0 / (uint32_t)(agora - inicioSubida);
+    if (taxa > subidaMax) desarme = DESARME_SUBIDA;
+    refSubida = temperatura;
+    inicioSubida = agora;
+  }
+
+  // aquecimento pleno precisa fazer a temperatura andar; cada subida
+  // de SUPERVISOR_RESPOSTA_C recomeça a contagem
+  if (potencia < SUPERVISOR_POTENCIA_ALTA) {
+    aquecendo = false;
+  }
+  else if (!aquecendo || temperatura - refResposta >= SUPERVISOR_RESPOSTA_C) {
+    aquecendo = true;
+    refResposta = temperatura;
+    inicioResposta = agora;
+  }
+  else if ((uint32_t)(agora - inicioResposta) >= SUPERVISOR_RESPOSTA_MS) {
+    desarme = DESARME_SEM_RESPOSTA;
+  }
+  return desarme;
+}
+
+uint8_t Supervisor_PI2::motivo(void) {
+  return desarme;
+}
+
+bool Supervisor_PI2::rearmar(float temperatura, uint32_t agora) {
+  if (isnan(temperatura) || temperatura >= maxima - SUPERVISOR_HISTERESE) return desarme == DESARME_NENHUM;
+  desarme = DESARME_NENHUM;
+  refSubida = NAN;
+  aquecendo = false;
+  inicioSubida = agora;
+  return true;
+}
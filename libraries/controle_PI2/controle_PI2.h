@@ -0,0 +1,320 @@
+/*  Biblioteca do Sistema de Controle do Forno
+ *  PID em ponto fixo Q16.16 para o ESP8266 (sem FPU)
+ *
+ *  controle_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef ControleForno
+#define ControleForno
+
+#include <Arduino.h>
+
+#define Q16_UM 65536L                        // 1,0 em Q16.16
+#define PARA_Q16(x) ((int32_t)((x) * 65536.0))
+#define DE_Q16(x) ((x) / 65536.0)
+
+// PID posicional com coeficientes pré-calculados.
+// Os ganhos são discretos, por amostra, como no sketch do forno:
+//   u = kc*e + ki*soma(e) + kd*(derivada da medida)
+// - anti-windup por integração condicional: o integrador para quando a
+//   saída está saturada e o erro empurra para a mesma saturação;
+// - derivada sobre a medida: degraus no set point não geram picos.
+class PidController {
+ public:
+  PidController(float kc, float ki, float kd, float umin, float umax);
+  void configurar(float kc, float ki, float kd);
+  void limites(float umin, float umax);
+  void reiniciar(void);
+
+  int32_t atualizarQ16(int32_t referencia, int32_t medida);  // Q16.16
+  float atualizar(float referencia, float medida);
+
+  float saida(void);
+  float integral(void);
+
+ private:
+  int32_t kcQ, kiQ, kdQ;         // ganhos em Q16.16
+  int32_t uminQ, umaxQ;
+  int32_t integradorQ;           // termo integral acumulado
+  int32_t medidaAnteriorQ;
+  int32_t saidaQ;
+  bool primeira;
+
+  static int32_t multiplicar(int32_t a, int32_t b);
+};
+
+// Autossintonia por realimentação a relé (Åström-Hägglund).
+// O relé liga a potência máxima abaixo de setPoint - histerese e desliga
+// acima de setPoint + histerese; a oscilação resultante dá o ganho e o
+// período críticos (Ku, Pu). Os tempos são contados em amostras, então
+// os ganhos saem já no formato discreto do PidController.
+enum EstadoSintonia {
+  SINTONIA_PARADA = 0,
+  SINTONIA_RODANDO,
+  SINTONIA_CONCLUIDA,
+  SINTONIA_FALHOU
+};
+
+enum RegraSintonia {
+  REGRA_ZIEGLER_NICHOLS = 0,   // Kp = 0,6 Ku, Ti = Pu/2, Td = Pu/8
+  REGRA_POUCO_SOBRESSINAL,     // Kp = 0,33 Ku, Ti = Pu/2, Td = Pu/3
+  REGRA_SEM_SOBRESSINAL        // Kp = 0,2 Ku, Ti = Pu/2, Td = Pu/3
+};
+
+class AutoSintonia_PI2 {
+ public:
+  AutoSintonia_PI2();
+  void iniciar(float setPoint, float histerese, float umin, float umax,
+               uint8_t ciclos, uint32_t maxAmostras, float limite);
+  float atualizar(float medida);   // uma vez por amostra; devolve a saída
+  void cancelar(void);
+
+  uint8_t estado(void);
+  uint8_t ciclos(void);            // ciclos completos já medidos
+  float ku(void);
+  float pu(void);                  // em amostras
+  bool ganhos(uint8_t regra, float &kc, float &ki, float &kd);
+
+ private:
+  float sp, hist, baixo, alto, limite;
+  uint8_t ciclosAlvo, ciclosMedidos;
+  uint32_t maxAmostras, amostra;
+  bool ligado;
+  uint32_t ultimaSubida;           // amostra da última troca para `alto`
+  uint8_t subidas;
+  float maximo, minimo;            // extremos no ciclo em andamento
+  float somaPeriodo, somaAmplitude;
+  uint8_t situacao;
+  float kuCalc, puCalc;
+
+  void concluir(void);
+};
+
+// Modelo térmico de primeira ordem do forno:
+//   tau * dT/dt = ganho * u - (T - ambiente)
+// Invertido, dá a potência que sustenta um set point que sobe a uma
+// dada inclinação; somada à saída do PID, tira dele o atraso nas rampas.
+class ModeloTermico_PI2 {
+ public:
+  ModeloTermico_PI2();
+  void configurar(float ganho, float tau_s, float ambiente);
+  void definirAmbiente(float ambiente);   // medido, sem mexer no ganho e em tau
+  bool ativo(void);
+  float potencia(float setPoint, float inclinacao);  // % antes de saturar
+
+  float ganho(void);
+  float tau(void);
+  float ambiente(void);
+
+ private:
+  float k, constante, tamb;
+};
+
+// Lei de controle da corrida: o modelo dá a potência da rampa e o PID
+// só corrige o que sobra; os limites do PID andam junto com a potência
+// do modelo para o anti-windup continuar valendo. Devolve 0-teto %;
+// teto é o que o disparo aceita agora (rampa de partida), e o integrador
+// para enquanto ele segura a potência.
+float controleRampa(PidController &pid, ModeloTermico_PI2 &modelo,
+                    float setPoint, float inclinacao, float medida, float teto = 100);
+
+// Controle preditivo (MPC) de horizonte curto sobre o ModeloTermico_PI2.
+// A cada amostra escolhe a potência u, mantida pelo horizonte, que minimiza
+//   soma_i (r_i - T_i)^2 + lambda * (u - u_anterior)^2
+// com T_i a temperatura prevista pelo modelo i passos à frente e r_i o set
+// point que o perfil terá nesse instante: o forno começa a esquentar antes
+// da subida. Com uma variável só, o mínimo tem forma fechada e a saturação
+// em 0-100 % é a solução exata do problema com limites; os coeficientes
+// saem prontos de configurar() e cada amostra custa PREDITIVO_HORIZONTE
+// multiplicações. Um observador estima, a cada passo, a perturbação na
+// entrada (perdas, erro de ganho do modelo) e tira o erro de regime.
+#define PREDITIVO_HORIZONTE 15
+#define PREDITIVO_OBSERVADOR 0.2   // fração do resíduo corrigida por passo
+
+class ControlePreditivo_PI2 {
+ public:
+  ControlePreditivo_PI2();
+  bool configurar(ModeloTermico_PI2 &modelo, float passo_s, float ts_s, float lambda);
+  void reiniciar(void);
+  bool ativo(void);
+  float atualizar(const float *referencias, float medida, float teto = 100);  // referencias[i]: set point a (i+1)*passo; teto: potência máxima aceita agora
+  void definirAmbiente(float ambiente);
+  float perturbacao(void);         // % de potência estimada pelo observador
+
+ private:
+  float coef[PREDITIVO_HORIZONTE]; // g_i / D, g_i = ganho * (1 - a^i)
+  float coefEstado;                // soma g_i * a^i / D
+  float coefAnterior;              // lambda / D
+  float aPasso, bPasso;            // modelo discretizado no passo
+  float tamb;
+  uint16_t amostrasPasso, contador;
+  float somaU, medidaInicio;       // janela do observador
+  float vAnterior;                 // u + perturbação da última amostra
+  float du;
+  bool configurado, primeira;
+};
+
+// Estimador (filtro de Kalman) da temperatura da câmara. O termopar
+// atrasa a câmara (bainha, conversão, FiltroTemperatura_PI2) e só tem
+// amostra nova a cada conversão; entre elas o ModeloTermico_PI2 avança
+// com a potência comandada, e cada amostra corrige o estado. Estados:
+// câmara e junta do termopar (excesso sobre o ambiente, a junta segue a
+// câmara com tau_termopar) e uma perturbação na entrada, em % de
+// potência, que absorve o erro do modelo. O PID recebe a câmara
+// estimada, sem o atraso e sem os degraus da quantização.
+#define ESTIMADOR_RUIDO_C        0.25   // desvio da medida (resolução do MAX6675)
+#define ESTIMADOR_PROCESSO_C     0.05   // C/raiz(s): o quanto a câmara foge do modelo
+#define ESTIMADOR_PERTURBACAO    0.5    // %/raiz(s): deriva da perturbação
+
+class EstimadorTermico_PI2 {
+ public:
+  EstimadorTermico_PI2();
+  bool configurar(ModeloTermico_PI2 &modelo, float ts_s, float tauTermopar_s);
+  void reiniciar(void);
+  bool ativo(void);
+  float atualizar(float potencia, float medida, bool nova);  // potência do último Ts; nova: medida não usada ainda
+  void definirAmbiente(float ambiente);   // sem salto na câmara estimada
+  float temperatura(void);       // C, câmara estimada
+  float taxa(void);              // C/s
+  float perturbacao(void);       // % de potência
+
+ private:
+  float x[3];                    // câmara, junta, perturbação
+  float P[3][3];
+  float ac, at, bc;              // modelo discretizado em ts
+  float k, tau, tamb;
+  float qc, qd;
+  bool configurado, iniciado;
+  float uAnterior;
+};
+
+// Ensaio ao degrau para identificar o ModeloTermico_PI2: aplica uma
+// potência fixa a partir do forno frio até a temperatura estabilizar.
+// ganho = variação final / potência e tau = instante em que a resposta
+// passa de 63,2 % (o atraso puro fica embutido em tau).
+#define ENSAIO_PONTOS 128
+
+class EnsaioDegrau_PI2 {
+ public:
+  EnsaioDegrau_PI2();
+  void iniciar(float potencia, float periodo_s, uint32_t maxAmostras, float limite);
+  float atualizar(float medida);   // uma vez por amostra; devolve a saída
+  void cancelar(void);
+
+  uint8_t estado(void);            // EstadoSintonia
+  float ganho(void);
+  float tau(void);                 // em s
+  float ambiente(void);
+
+ private:
+  float u, periodo, limite;
+  uint32_t maxAmostras, amostra;
+  float inicial, referencia;       // T0 e a medida do início da janela
+  uint32_t janela;                 // amostras entre testes de estabilidade
+  float registro[ENSAIO_PONTOS];   // resposta dizimada por `passo`
+  uint16_t pontos;
+  uint32_t passo;
+  uint8_t situacao;
+  float kCalc, tauCalc;
+
+  void concluir(float medida, float inclinacao);
+};
+
+// Identificação do modelo térmico durante uma corrida qualquer, sem ensaio
+// à parte, por mínimos quadrados recursivos (RLS) sobre a potência e a
+// leitura. Modelo ARX de segunda ordem com atraso puro, amostrado a cada
+// `passo`:
+//   T[k] = a1 T[k-1] + a2 T[k-2] + b u[k-d] + c
+// (u[k], a média do passo que termina em T[k]), estimado na forma
+//   T[k] - T[k-1] = (a1 + a2 - 1) T[k-1] - a2 (T[k-1] - T[k-2]) + b u[k-d] + c
+// que separa a inclinação do nível: em T[k-1] e T[k-2], quase iguais, as
+// duas colunas seriam quase a mesma e o RLS em float não as distinguiria.
+// Um RLS para cada atraso d de 0 a IDENT_ATRASOS-1 passos; vale o de menor
+// erro de previsão acumulado. Dos coeficientes saem o ganho, o ambiente e
+// as duas constantes de tempo (dos polos); polos complexos ou fora de
+// (0, 1) caem para uma constante só, o tempo de residência da resposta.
+// Para os modelos de primeira ordem do forno, a regra da metade
+// (Skogestad): metade da constante rápida vai para o tau do
+// ModeloTermico_PI2, a outra metade mais o atraso puro é o atraso da
+// leitura do EstimadorTermico_PI2.
+#define IDENT_ATRASOS     6
+#define IDENT_PARAMETROS  4
+#define IDENT_MINIMO      60       // passos antes de aceitar um resultado
+#define IDENT_ESCALA      100.0    // C e % divididos por isto: regressores perto de 1
+#define IDENT_DERIVADA    50.0     // peso de T[k-1] - T[k-2], idem
+
+class IdentificacaoTermica_PI2 {
+ public:
+  IdentificacaoTermica_PI2();
+  void iniciar(float ts_s, float passo_s);
+  void adicionar(float potencia, float medida);   // uma vez por ts
+  bool concluir(void);             // calcula o modelo; false: sem resultado válido
+  void cancelar(void);
+
+  uint8_t estado(void);            // EstadoSintonia
+  uint16_t amostras(void);         // passos usados
+  float ganho(void);               // C/%
+  float tau(void);                 // s, constante lenta
+  float tauRapido(void);           // s, 0 sem o segundo polo
+  float atraso(void);              // s, atraso puro escolhido
+  float tauModelo(void);           // s, tau + tauRapido / 2
+  float atrasoLeitura(void);       // s, atraso + tauRapido / 2
+  float ambiente(void);
+  float erro(void);                // C, RMS da previsão de um passo
+
+ private:
+  float theta[IDENT_ATRASOS][IDENT_PARAMETROS];
+  float P[IDENT_ATRASOS][IDENT_PARAMETROS][IDENT_PARAMETROS];
+  float somaErro[IDENT_ATRASOS];   // quadrados dos erros a priori
+  float entradas[IDENT_ATRASOS];   // u[k] ... u[k-IDENT_ATRASOS+1]
+  float y1, y2;                    // T[k-1], T[k-2]
+  float somaU;
+  uint16_t porPasso, contador, passos;
+  float passo;
+  uint8_t situacao, escolhido;
+  float kCalc, tauCalc, tauRapidoCalc, ambienteCalc;
+};
+
+// Supervisor de segurança de uma zona, independente do PID: vê só a
+// leitura, o instante dela e a potência aplicada. O primeiro motivo
+// encontrado fica travado até rearmar(), que exige o forno já abaixo
+// da máxima menos a histerese.
+#define SUPERVISOR_MAXIMA       260.0    // C absoluto
+#define SUPERVISOR_HISTERESE    20.0     // C abaixo da máxima para rearmar
+#define SUPERVISOR_IDADE_MS     1500     // leitura mais velha: sensor parado
+#define SUPERVISOR_SUBIDA_MAX   5.0      // C/s
+#define SUPERVISOR_JANELA_MS    2000     // janela da taxa de subida
+#define SUPERVISOR_POTENCIA_ALTA 90.0    // % considerada aquecimento pleno
+#define SUPERVISOR_RESPOSTA_MS  90000UL  // aquecimento pleno sem subir...
+#define SUPERVISOR_RESPOSTA_C   2.0      // ...ao menos isso: termopar solto
+
+enum MotivoDesarme {
+  DESARME_NENHUM = 0,
+  DESARME_SENSOR_FALHA,      // termopar aberto
+  DESARME_SENSOR_PARADO,     // leitura não se renova
+  DESARME_TEMPERATURA,       // acima da máxima
+  DESARME_SUBIDA,            // subindo mais rápido que o forno consegue
+  DESARME_SEM_RESPOSTA,      // potência alta e temperatura parada
+  DESARME_CONTROLE           // tarefa de controle parou (usado pelo sketch)
+};
+
+class Supervisor_PI2 {
+ public:
+  Supervisor_PI2();
+  void configurar(float maxima, float subidaMax);
+  uint8_t verificar(float temperatura, uint32_t instante, float potencia, uint32_t agora);
+  uint8_t motivo(void);
+  bool rearmar(float temperatura, uint32_t agora);
+
+ private:
+  float maxima, subidaMax;
+  uint8_t desarme;
+  float refSubida;                 // leitura do início da janela de subida
+  uint32_t inicioSubida;
+  float refResposta;               // leitura do início do aquecimento pleno
+  uint32_t inicioResposta;
+  bool aquecendo;
+};
+
+#endif
@@ -0,0 +1,30 @@
+/*  Exemplo do PID em ponto fixo do controle do Forno
+ *
+ *  pid_ponto_fixo.ino
+ */
+
+#include <sensor_PI2.h>
+#include <controle_PI2.h>
+
+// Pinos
+int maxSO = D0;
+int maxCS = D1;
+int maxCLK = D2;
+
+// Instanciando objetos
+MAX6675_PI2 moduloMAX(maxCLK, maxCS, maxSO);
+PidController pid(5.207, 0.006, 55.44, 0, 100);
+
+float referencia = 150;
+
+void setup() {
+  Serial.begin(9600);
+}
+
+void loop() {
+  if (moduloMAX.atualizar()) {
+    float potencia = pid.atualizar(referencia, moduloMAX.ultimaCelsius());
+    Serial.print("\tPotencia = ");
+    Serial.println(potencia);
+  }
+}
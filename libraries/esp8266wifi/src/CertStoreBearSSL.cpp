@@ -19,6 +19,7 @@
 
 #include "CertStoreBearSSL.h"
 #include <memory>
+#include <stdlib.h>
 
 
 #ifdef DEBUG_ESP_SSL
@@ -35,12 +36,36 @@ extern "C" {
     br_sha256_context *sha1 = (br_sha256_context*)ctx;
     br_sha256_update(sha1, buf, len);
   }
+
+  static int index_compare(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+  }
 }
 
+// First bytes of a hash, in a fixed order so the RAM index sorts like the hashes
+static uint32_t hashPrefix(const void *sha256) {
+  const uint8_t *h = (const uint8_t *)sha256;
+  return ((uint32_t)h[0] << 24) | ((uint32_t)h[1] << 16) | ((uint32_t)h[2] << 8) | h[3];
+}
 
 CertStore::~CertStore() {
   free(_indexName);
   free(_dataName);
+  delete _x509;
+  _freeIndex();
+}
+
+void CertStore::_freeIndex() {
+  free(_index);
+  _index = nullptr;
+  _indexCount = 0;
+  for (int i = 0; i < CERTSTORE_CACHE_SIZE; i++) {
+    delete _cache[i].x509;
+    _cache[i].x509 = nullptr;
+    _cache[i].users = 0;
+  }
 }
 
 CertStore::CertInfo CertStore::_preprocessCert(uint32_t length, uint32_t offset, const void *raw) {
@@ -82,12 +107,20 @@ int CertStore::initCertStore(FS &fs, const char *indexFileName, const char *data
 
   _fs = &fs;
 
+  // Starting over with a (possibly) different bundle
+  free(_indexName);
+  free(_dataName);
+  _freeIndex();
+  uint16_t indexSize = 0;
+
   // No strdup_P, so manually do it
   _indexName = (char *)malloc(strlen_P(indexFileName) + 1);
   _dataName = (char *)malloc(strlen_P(dataFileName) + 1);
   if (!_indexName || !_dataName) {
     free(_indexName);
     free(_dataName);
+    _indexName = nullptr;
+    _dataName = nullptr;
     return 0;
   }
   memcpy_P(_indexName, indexFileName, strlen_P(indexFileName) + 1);
@@ -143,6 +176,20 @@ int CertStore::initCertStore(FS &fs, const char *indexFileName, const char *data
         free(raw);
         break;
       }
+      // Keep a RAM entry too; if RAM runs out lookups just scan the file
+      if (_indexCount == indexSize && indexSize < 0x8000) {
+        uint16_t grown = indexSize ? indexSize * 2 : 32;
+        IndexEntry *more = (IndexEntry *)realloc(_index, grown * sizeof(IndexEntry));
+        if (more) {
+          _index = more;
+          indexSize = grown;
+        }
+      }
+      if (_index && _indexCount < indexSize) {
+        _index[_indexCount].hashPrefix = hashPrefix(ci.sha256);
+        _index[_indexCount].record = count;
+        _indexCount++;
+      }
       count++;
     }
 
@@ -156,6 +203,12 @@ int CertStore::initCertStore(FS &fs, const char *indexFileName, const char *data
   }
   data.close();
   index.close();
+
+  if (_indexCount != count) {
+    _freeIndex();  // an incomplete index would miss certificates
+  } else if (_index) {
+    qsort(_index, _indexCount, sizeof(IndexEntry), index_compare);
+  }
   return count;
 }
 
@@ -163,6 +216,76 @@ void CertStore::installCertStore(br_x509_minimal_context *ctx) {
   br_x509_minimal_set_dynamic(ctx, (void*)this, findHashedTA, freeHashedTA);
 }
 
+// Finds the CertInfo record for a hash, through the RAM index when there is one
+bool CertStore::_findCertInfo(const void *hashed_dn, File &index, CertInfo &ci) {
+  if (!_index) {
+    index.seek(0, SeekSet);
+    while (index.read((uint8_t *)&ci, sizeof(ci)) == sizeof(ci)) {
+      if (!memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Lower bound of the prefix, then every record sharing it
+  const uint32_t prefix = hashPrefix(hashed_dn);
+  uint16_t lo = 0, hi = _indexCount;
+  while (lo < hi) {
+    uint16_t mid = (lo + hi) / 2;
+    if (_index[mid].hashPrefix < prefix) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  for (; lo < _indexCount && _index[lo].hashPrefix == prefix; lo++) {
+    if (!index.seek(_index[lo].record * sizeof(ci), SeekSet) ||
+        index.read((uint8_t *)&ci, sizeof(ci)) != sizeof(ci)) {
+      return false;
+    }
+    if (!memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Puts a freshly decoded TA in the least recently used free slot of the cache
+const br_x509_trust_anchor *CertStore::_cacheTA(const uint8_t sha256[32], X509List *x509) {
+  br_x509_trust_anchor *ta = (br_x509_trust_anchor*)x509->getTrustAnchors();
+  memcpy(ta->dn.data, sha256, 32);
+  ta->dn.len = 32;
+
+  CachedTA *slot = nullptr;
+  for (int i = 0; i < CERTSTORE_CACHE_SIZE; i++) {
+    CachedTA *c = &_cache[i];
+    if (c->users) {
+      continue;
+    }
+    if (!c->x509) {
+      slot = c;
+      break;
+    }
+    if (!slot || (int32_t)(c->lastUse - slot->lastUse) < 0) {
+      slot = c;
+    }
+  }
+  if (!slot) {
+    // Every cached TA is in use, lend this one out uncached
+    delete _x509;
+    _x509 = x509;
+    return ta;
+  }
+
+  delete slot->x509;
+  memcpy(slot->sha256, sha256, sizeof(slot->sha256));
+  slot->x509 = x509;
+  slot->lastUse = ++_useClock;
+  slot->users = 1;
+  return ta;
+}
+
 const br_x509_trust_anchor *CertStore::findHashedTA(void *ctx, void *hashed_dn, size_t len) {
   CertStore *cs = static_cast<CertStore*>(ctx);
   CertStore::CertInfo ci;
@@ -171,54 +294,67 @@ const br_x509_trust_anchor *CertStore::findHashedTA(void *ctx, void *hashed_dn,
     return nullptr;
   }
 
+  for (int i = 0; i < CERTSTORE_CACHE_SIZE; i++) {
+    CachedTA *c = &cs->_cache[i];
+    if (c->x509 && !memcmp(c->sha256, hashed_dn, sizeof(c->sha256))) {
+      c->lastUse = ++cs->_useClock;
+      c->users++;
+      return c->x509->getTrustAnchors();
+    }
+  }
+
   File index = cs->_fs->open(cs->_indexName, "r");
   if (!index) {
     return nullptr;
   }
+  bool found = cs->_findCertInfo(hashed_dn, index, ci);
+  index.close();
+  if (!found) {
+    return nullptr;
+  }
 
-  while (index.read((uint8_t *)&ci, sizeof(ci)) == sizeof(ci)) {
-    if (!memcmp(ci.sha256, hashed_dn, sizeof(ci.sha256))) {
-      index.close();
-      uint8_t *der = (uint8_t*)malloc(ci.length);
-      if (!der) {
-        return nullptr;
-      }
-      File data = cs->_fs->open(cs->_dataName, "r");
-      if (!data) {
-        free(der);
-        return nullptr;
-      }
-      if (!data.seek(ci.offset, SeekSet)) {
-        data.close();
-        free(der);
-        return nullptr;
-      }
-      if (data.read((uint8_t *)der, ci.length) != ci.length) {
-        free(der);
-        return nullptr;
-      }
-      data.close();
-      cs->_x509 = new X509List(der, ci.length);
-      free(der);
-      if (!cs->_x509) {
-        DEBUG_BSSL("CertStore::findHashedTA: OOM\n");
-        return nullptr;
-      }
-
-      br_x509_trust_anchor *ta = (br_x509_trust_anchor*)cs->_x509->getTrustAnchors();
-      memcpy(ta->dn.data, ci.sha256, sizeof(ci.sha256));
-      ta->dn.len = sizeof(ci.sha256);
-
-      return ta;
-    }
+  uint8_t *der = (uint8_t*)malloc(ci.length);
+  if (!der) {
+    return nullptr;
   }
-  index.close();
-  return nullptr;
+  File data = cs->_fs->open(cs->_dataName, "r");
+  if (!data) {
+    free(der);
+    return nullptr;
+  }
+  if (!data.seek(ci.offset, SeekSet)) {
+    data.close();
+    free(der);
+    return nullptr;
+  }
+  if (data.read((uint8_t *)der, ci.length) != ci.length) {
+    data.close();
+    free(der);
+    return nullptr;
+  }
+  data.close();
+  X509List *x509 = new X509List(der, ci.length);
+  free(der);
+  if (!x509) {
+    DEBUG_BSSL("CertStore::findHashedTA: OOM\n");
+    return nullptr;
+  }
+
+  return cs->_cacheTA(ci.sha256, x509);
 }
 
 void CertStore::freeHashedTA(void *ctx, const br_x509_trust_anchor *ta) {
   CertStore *cs = static_cast<CertStore*>(ctx);
-  (void) ta; // Unused
+  // Cached TAs stay decoded for the next handshake
+  for (int i = 0; i < CERTSTORE_CACHE_SIZE; i++) {
+    CachedTA *c = &cs->_cache[i];
+    if (c->x509 && c->x509->getTrustAnchors() == ta) {
+      if (c->users) {
+        c->users--;
+      }
+      return;
+    }
+  }
   delete cs->_x509;
   cs->_x509 = nullptr;
 }
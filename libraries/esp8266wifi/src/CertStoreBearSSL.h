@@ -29,6 +29,11 @@
 // of a large set of certificates stored on SPIFFS of SD card to
 // be dynamically used when validating a X509 certificate
 
+// Number of decoded trust anchors kept in RAM between handshakes
+#ifndef CERTSTORE_CACHE_SIZE
+#define CERTSTORE_CACHE_SIZE 2
+#endif
+
 namespace BearSSL {
 
 class CertStore {
@@ -46,7 +51,28 @@ class CertStore {
     FS *_fs = nullptr;
     char *_indexName = nullptr;
     char *_dataName = nullptr;
-    X509List *_x509 = nullptr;
+    X509List *_x509 = nullptr; // TA handed out while the cache was full
+
+    // RAM copy of the index file: the start of each hash and where its
+    // CertInfo record is, sorted by hash, so a lookup reads one record
+    class IndexEntry {
+    public:
+      uint32_t hashPrefix;
+      uint16_t record;
+    };
+    IndexEntry *_index = nullptr;
+    uint16_t _indexCount = 0;
+
+    // Recently used trust anchors, already decoded
+    class CachedTA {
+    public:
+      uint8_t sha256[32];
+      X509List *x509;
+      uint32_t lastUse;
+      uint8_t users;
+    };
+    CachedTA _cache[CERTSTORE_CACHE_SIZE] = {};
+    uint32_t _useClock = 0;
 
     // These need to be static as they are callbacks from BearSSL C code
     static const br_x509_trust_anchor *findHashedTA(void *ctx, void *hashed_dn, size_t len);
@@ -61,6 +87,10 @@ class CertStore {
     };
     static CertInfo _preprocessCert(uint32_t length, uint32_t offset, const void *raw);
 
+    void _freeIndex();
+    bool _findCertInfo(const void *hashed_dn, File &index, CertInfo &ci);
+    const br_x509_trust_anchor *_cacheTA(const uint8_t sha256[32], X509List *x509);
+
 };
 
 };
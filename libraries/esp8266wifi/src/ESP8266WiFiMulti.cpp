@@ -27,6 +27,10 @@
 #include <limits.h>
 #include <string.h>
 
+extern "C" {
+#include "user_interface.h"
+}
+
 ESP8266WiFiMulti::ESP8266WiFiMulti() {
 }
 
@@ -42,13 +46,30 @@ bool ESP8266WiFiMulti::existsAP(const char* ssid, const char *passphrase) {
     return APlistExists(ssid, passphrase);
 }
 
+void ESP8266WiFiMulti::setFastConnect(bool enable, uint32_t rtcOffset) {
+    fastConnectEnabled = enable;
+    fastConnectOffset = rtcOffset;
+}
+
 wl_status_t ESP8266WiFiMulti::run(void) {
 
     wl_status_t status = WiFi.status();
+    if(status == WL_CONNECTED) {
+        fastConnectTried = false; // next time the link drops, try again
+        return status;
+    }
     if(status == WL_DISCONNECTED || status == WL_NO_SSID_AVAIL || status == WL_IDLE_STATUS || status == WL_CONNECT_FAILED) {
 
         int8_t scanResult = WiFi.scanComplete();
 
+        if(fastConnectEnabled && !fastConnectTried && scanResult != WIFI_SCAN_RUNNING) {
+            fastConnectTried = true;
+            status = fastConnect();
+            if(status == WL_CONNECTED) {
+                return status;
+            }
+        }
+
         if(scanResult == WIFI_SCAN_RUNNING) {
             // scan is running, do nothing yet
             status = WL_NO_SSID_AVAIL;
@@ -162,6 +183,9 @@ wl_status_t ESP8266WiFiMulti::run(void) {
                         break;
                 }
 #endif
+                if(status == WL_CONNECTED) {
+                    lastAPSave();
+                }
             } else {
                 DEBUG_WIFI_MULTI("[WIFI] no matching wifi found!\n");
             }
@@ -183,6 +207,104 @@ wl_status_t ESP8266WiFiMulti::run(void) {
 
 // ##################################################################################
 
+// Connects straight to the AP of the last good connection, or failing a
+// record of it (power cycle), to the BSSID the SDK saved in flash, leaving
+// the channel to the SDK
+wl_status_t ESP8266WiFiMulti::fastConnect(void) {
+    WifiLastAP ap;
+    if(!lastAPLoad(ap)) {
+        struct station_config conf;
+        if(!wifi_station_get_config_default(&conf) || !conf.bssid_set) {
+            return WiFi.status();
+        }
+        memset(&ap, 0, sizeof(ap));
+        memcpy(ap.ssid, conf.ssid, sizeof(ap.ssid));
+        ap.ssidLen = strnlen(ap.ssid, sizeof(ap.ssid));
+        memcpy(ap.bssid, conf.bssid, sizeof(ap.bssid));
+    }
+
+    char ssid[33];
+    memcpy(ssid, ap.ssid, ap.ssidLen);
+    ssid[ap.ssidLen] = 0;
+    const WifiAPEntry* entry = APlistFind(ssid);
+    if(!entry) {
+        return WiFi.status();
+    }
+
+    DEBUG_WIFI_MULTI("[WIFI] Fast connect BSSID: %02X:%02X:%02X:%02X:%02X:%02X SSID: %s Channel: %d\n", ap.bssid[0], ap.bssid[1], ap.bssid[2], ap.bssid[3], ap.bssid[4], ap.bssid[5], ssid, ap.channel);
+
+    wl_status_t status = WiFi.begin(entry->ssid, entry->passphrase, ap.channel, ap.bssid);
+
+    // a known AP answers within a few hundred ms; anything slower is
+    // better served by the scan
+    static const uint32_t fastConnectTimeout = 3000;
+
+    auto startTime = millis();
+    while(status != WL_CONNECTED && status != WL_NO_SSID_AVAIL && status != WL_CONNECT_FAILED && (millis() - startTime) <= fastConnectTimeout) {
+        delay(10);
+        status = WiFi.status();
+    }
+
+    if(status == WL_CONNECTED) {
+        DEBUG_WIFI_MULTI("[WIFI] Fast connect done in %d ms\n", (int)(millis() - startTime));
+        lastAPSave();
+    } else {
+        // the scan that follows disconnects first
+        DEBUG_WIFI_MULTI("[WIFI] Fast connect failed (%d), scanning\n", status);
+        lastAPClear();
+    }
+    return status;
+}
+
+static uint32_t lastAPCheck(const WifiLastAP& ap) {
+    // FNV-1a over everything after the check word
+    const uint8_t* p = (const uint8_t*) &ap + sizeof(ap.check);
+    uint32_t h = 2166136261u;
+    for(size_t i = sizeof(ap.check); i < sizeof(ap); ++i) {
+        h = (h ^ *p++) * 16777619u;
+    }
+    return h;
+}
+
+bool ESP8266WiFiMulti::lastAPLoad(WifiLastAP& ap) {
+    if(!ESP.rtcUserMemoryRead(fastConnectOffset, (uint32_t*) &ap, sizeof(ap))) {
+        return false;
+    }
+    return ap.check == lastAPCheck(ap) && ap.ssidLen > 0 && ap.ssidLen <= sizeof(ap.ssid);
+}
+
+void ESP8266WiFiMulti::lastAPSave(void) {
+    WifiLastAP ap;
+    memset(&ap, 0, sizeof(ap));
+    String ssid = WiFi.SSID();
+    ap.ssidLen = (ssid.length() < sizeof(ap.ssid)) ? ssid.length() : sizeof(ap.ssid);
+    memcpy(ap.ssid, ssid.c_str(), ap.ssidLen);
+    memcpy(ap.bssid, WiFi.BSSID(), sizeof(ap.bssid));
+    ap.channel = WiFi.channel();
+    ap.check = lastAPCheck(ap);
+
+    WifiLastAP old;
+    if(lastAPLoad(old) && !memcmp(&old, &ap, sizeof(ap))) {
+        return;
+    }
+    ESP.rtcUserMemoryWrite(fastConnectOffset, (uint32_t*) &ap, sizeof(ap));
+}
+
+void ESP8266WiFiMulti::lastAPClear(void) {
+    WifiLastAP ap;
+    memset(&ap, 0, sizeof(ap));
+    ESP.rtcUserMemoryWrite(fastConnectOffset, (uint32_t*) &ap, sizeof(ap));
+}
+
+const WifiAPEntry* ESP8266WiFiMulti::APlistFind(const char* ssid) {
+    for(auto& entry : APlist) {
+        if(!strcmp(entry.ssid, ssid)) {
+            return &entry;
+        }
+    }
+    return NULL;
+}
+
 bool ESP8266WiFiMulti::APlistAdd(const char* ssid, const char *passphrase) {
 
     WifiAPEntry newAP;
@@ -47,6 +47,20 @@ struct WifiAPEntry {
 
 typedef std::vector<WifiAPEntry> WifiAPlist;
 
+// Last AP connected to, kept in RTC user memory across resets and deep
+// sleep. Default place is the top 44 bytes of the 512.
+#ifndef WIFI_MULTI_RTC_OFFSET
+#define WIFI_MULTI_RTC_OFFSET 117
+#endif
+
+struct WifiLastAP {
+    uint32_t check;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint8_t ssidLen;
+    char ssid[32];
+};
+
 class ESP8266WiFiMulti {
     public:
         ESP8266WiFiMulti();
@@ -57,8 +71,20 @@ class ESP8266WiFiMulti {
 
         wl_status_t run(void);
 
+        // Before scanning, try the last AP that worked directly, by BSSID
+        // and channel. On by default; rtcOffset is in 4-byte blocks.
+        void setFastConnect(bool enable, uint32_t rtcOffset = WIFI_MULTI_RTC_OFFSET);
+
     private:
         WifiAPlist APlist;
+        bool fastConnectEnabled = true;
+        bool fastConnectTried = false;
+        uint32_t fastConnectOffset = WIFI_MULTI_RTC_OFFSET;
+        wl_status_t fastConnect(void);
+        bool lastAPLoad(WifiLastAP& ap);
+        void lastAPSave(void);
+        void lastAPClear(void);
+        const WifiAPEntry* APlistFind(const char* ssid);
         bool APlistAdd(const char* ssid, const char *passphrase = NULL);
         bool APlistExists(const char* ssid, const char *passphrase = NULL);
         void APlistClean(void);
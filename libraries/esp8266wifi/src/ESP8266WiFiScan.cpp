@@ -36,6 +36,7 @@ extern "C" {
 }
 
 #include "debug.h"
+#include <Schedule.h>
 
 extern "C" void esp_schedule();
 extern "C" void esp_yield();
@@ -60,6 +61,18 @@ void* ESP8266WiFiScanClass::_scanResult = 0;
 
 std::function<void(int)> ESP8266WiFiScanClass::_onComplete;
 
+uint8_t ESP8266WiFiScanClass::_streamChannel = 0;
+uint8_t ESP8266WiFiScanClass::_streamLastChannel = 0;
+bool ESP8266WiFiScanClass::_streamHidden = false;
+int ESP8266WiFiScanClass::_streamFound = 0;
+std::function<void(const WiFiScanEntry&)> ESP8266WiFiScanClass::_onStreamNetwork;
+std::function<void(int)> ESP8266WiFiScanClass::_onStreamComplete;
+
+WiFiScanEntry* ESP8266WiFiScanClass::_cache = 0;
+uint8_t ESP8266WiFiScanClass::_cacheCount = 0;
+uint32_t ESP8266WiFiScanClass::_cacheTime = 0;
+bool ESP8266WiFiScanClass::_cacheValid = false;
+
 /**
  * Start scan WiFi networks available
  * @param async         run in async mode
@@ -69,7 +82,7 @@ std::function<void(int)> ESP8266WiFiScanClass::_onComplete;
  * @return Number of discovered networks
  */
 int8_t ESP8266WiFiScanClass::scanNetworks(bool async, bool show_hidden, uint8 channel, uint8* ssid) {
-    if(ESP8266WiFiScanClass::_scanStarted) {
+    if(ESP8266WiFiScanClass::_scanStarted || ESP8266WiFiScanClass::_streamChannel) {
         return WIFI_SCAN_RUNNING;
     }
 
@@ -208,7 +221,11 @@ uint8_t ESP8266WiFiScanClass::encryptionType(uint8_t i) {
         return -1;
     }
 
-    switch(it->authmode) {
+    return _encryptionType(it->authmode);
+}
+
+uint8_t ESP8266WiFiScanClass::_encryptionType(uint8_t authmode) {
+    switch(authmode) {
         case AUTH_OPEN:
             return ENC_TYPE_NONE;
         case AUTH_WEP:
@@ -341,3 +358,196 @@ void * ESP8266WiFiScanClass::_getScanInfoByIndex(int i) {
     }
     return reinterpret_cast<bss_info*>(ESP8266WiFiScanClass::_scanResult) + i;
 }
+
+/**
+ * Starts a scan that runs one channel at a time
+ * @param onNetwork     called for every BSS found, as soon as its channel is done
+ * @param onComplete    called with the number of BSS found when the last channel is done
+ * @param show_hidden   show hidden networks
+ * @return true if the scan started
+ */
+bool ESP8266WiFiScanClass::scanNetworksStream(std::function<void(const WiFiScanEntry&)> onNetwork,
+                                              std::function<void(int)> onComplete,
+                                              bool show_hidden) {
+    if(_scanStarted || _streamChannel) {
+        return false;
+    }
+    if(!_cache) {
+        _cache = new WiFiScanEntry[WIFI_SCAN_CACHE_SIZE];
+        if(!_cache) {
+            return false;
+        }
+    }
+
+    WiFi.enableSTA(true);
+
+    int status = wifi_station_get_connect_status();
+    if(status != STATION_GOT_IP && status != STATION_IDLE) {
+        wifi_station_disconnect();
+    }
+
+    uint8_t firstChannel = 1;
+    _streamLastChannel = 13;
+    wifi_country_t country;
+    if(wifi_get_country(&country) && country.nchan) {
+        firstChannel = country.schan;
+        _streamLastChannel = country.schan + country.nchan - 1;
+    }
+
+    for(uint8_t i = 0; i < _cacheCount; i++) {
+        _cache[i].seen = false;
+    }
+    _onStreamNetwork = onNetwork;
+    _onStreamComplete = onComplete;
+    _streamHidden = show_hidden;
+    _streamFound = 0;
+    _streamChannel = firstChannel;
+    if(!_streamNext()) {
+        _streamChannel = 0;
+        return false;
+    }
+    return true;
+}
+
+bool ESP8266WiFiScanClass::scanStreamRunning() {
+    return _streamChannel != 0;
+}
+
+uint8_t ESP8266WiFiScanClass::scanCacheCount() {
+    return _cacheCount;
+}
+
+const WiFiScanEntry* ESP8266WiFiScanClass::scanCacheEntry(uint8_t i) {
+    if(i >= _cacheCount) {
+        return 0;
+    }
+    return &_cache[i];
+}
+
+uint32_t ESP8266WiFiScanClass::scanCacheAge() {
+    if(!_cacheValid) {
+        return UINT32_MAX;
+    }
+    return millis() - _cacheTime;
+}
+
+void ESP8266WiFiScanClass::scanCacheDelete() {
+    if(_streamChannel) {
+        return; // the callback is still writing to it
+    }
+    delete[] _cache;
+    _cache = 0;
+    _cacheCount = 0;
+    _cacheValid = false;
+}
+
+/**
+ * private
+ * starts the scan of _streamChannel
+ */
+bool ESP8266WiFiScanClass::_streamNext() {
+    struct scan_config config;
+    memset(&config, 0, sizeof(config));
+    config.channel = _streamChannel;
+    config.show_hidden = _streamHidden;
+    return wifi_station_scan(&config, reinterpret_cast<scan_done_cb_t>(&ESP8266WiFiScanClass::_streamDone));
+}
+
+/**
+ * private
+ * scan callback of one channel of a stream scan
+ * @param result  void *arg
+ * @param status STATUS
+ */
+void ESP8266WiFiScanClass::_streamDone(void* result, int status) {
+    if(status == OK) {
+        for(bss_info* it = reinterpret_cast<bss_info*>(result); it; it = STAILQ_NEXT(it, next)) {
+            // a channel's scan hears its neighbours too; they get their own turn
+            if(it->channel != _streamChannel) {
+                continue;
+            }
+            WiFiScanEntry entry;
+            memcpy(entry.ssid, it->ssid, sizeof(it->ssid));
+            entry.ssid[32] = 0;
+            memcpy(entry.bssid, it->bssid, sizeof(entry.bssid));
+            entry.rssi = it->rssi;
+            entry.channel = it->channel;
+            entry.encryptionType = _encryptionType(it->authmode);
+            entry.isHidden = (it->is_hidden != 0);
+            entry.seen = true;
+            _streamFound++;
+            _cacheUpdate(entry);
+            if(_onStreamNetwork) {
+                _onStreamNetwork(entry);
+            }
+        }
+    }
+
+    if(_streamChannel < _streamLastChannel) {
+        // not from inside the SDK callback: start the next channel from loop()
+        _streamChannel++;
+        schedule_function([]() {
+            if(!_streamNext()) {
+                _streamChannel = _streamLastChannel;
+                _streamDone(0, FAIL);
+            }
+        });
+        return;
+    }
+
+    _streamChannel = 0;
+    _cacheExpire();
+    _cacheTime = millis();
+    _cacheValid = true;
+    if(_onStreamComplete) {
+        auto onComplete = _onStreamComplete;
+        _onStreamComplete = nullptr;
+        _onStreamNetwork = nullptr;
+        onComplete(_streamFound);
+    } else {
+        _onStreamNetwork = nullptr;
+    }
+}
+
+/**
+ * private
+ * puts a BSS in the cache at its place by RSSI, replacing its older entry
+ */
+void ESP8266WiFiScanClass::_cacheUpdate(const WiFiScanEntry& entry) {
+    uint8_t i;
+    for(i = 0; i < _cacheCount; i++) {
+        if(!memcmp(_cache[i].bssid, entry.bssid, sizeof(entry.bssid))) {
+            memmove(&_cache[i], &_cache[i + 1], (_cacheCount - i - 1) * sizeof(WiFiScanEntry));
+            _cacheCount--;
+            break;
+        }
+    }
+
+    uint8_t pos = 0;
+    while(pos < _cacheCount && _cache[pos].rssi >= entry.rssi) {
+        pos++;
+    }
+    if(pos >= WIFI_SCAN_CACHE_SIZE) {
+        return; // weaker than everything kept
+    }
+    if(_cacheCount == WIFI_SCAN_CACHE_SIZE) {
+        _cacheCount--; // the weakest makes room
+    }
+    memmove(&_cache[pos + 1], &_cache[pos], (_cacheCount - pos) * sizeof(WiFiScanEntry));
+    _cache[pos] = entry;
+    _cacheCount++;
+}
+
+/**
+ * private
+ * drops the networks the completed scan did not find again
+ */
+void ESP8266WiFiScanClass::_cacheExpire() {
+    uint8_t kept = 0;
+    for(uint8_t i = 0; i < _cacheCount; i++) {
+        if(_cache[i].seen) {
+            _cache[kept++] = _cache[i];
+        }
+    }
+    _cacheCount = kept;
+}
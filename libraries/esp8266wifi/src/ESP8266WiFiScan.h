@@ -26,6 +26,23 @@
 #include "ESP8266WiFiType.h"
 #include "ESP8266WiFiGeneric.h"
 
+// A scanned network as kept by the stream scan cache: what a network list
+// needs, in well under half a bss_info
+struct WiFiScanEntry {
+    char ssid[33];
+    uint8_t bssid[6];
+    int8_t rssi;
+    uint8_t channel;
+    uint8_t encryptionType;
+    bool isHidden;
+    bool seen;      // found again by the scan in progress
+};
+
+// Strongest networks kept by scanNetworksStream()
+#ifndef WIFI_SCAN_CACHE_SIZE
+#define WIFI_SCAN_CACHE_SIZE 20
+#endif
+
 class ESP8266WiFiScanClass {
 
         // ----------------------------------------------------------------------------------------------
@@ -40,6 +57,23 @@ class ESP8266WiFiScanClass {
         int8_t scanComplete();
         void scanDelete();
 
+        // Scans one channel at a time, going back to loop() between channels.
+        // onNetwork gets each BSS as soon as its channel is done (from the
+        // SDK callback, like onComplete of scanNetworksAsync), onComplete the
+        // number found at the end. Results also update the scan cache.
+        bool scanNetworksStream(std::function<void(const WiFiScanEntry&)> onNetwork,
+                                std::function<void(int)> onComplete = nullptr,
+                                bool show_hidden = false);
+        bool scanStreamRunning();
+
+        // Networks of the stream scans, strongest first. Kept while a new
+        // scan runs; what it no longer finds is dropped when it completes.
+        uint8_t scanCacheCount();
+        const WiFiScanEntry* scanCacheEntry(uint8_t i);
+        // ms since the last stream scan completed, UINT32_MAX if none did
+        uint32_t scanCacheAge();
+        void scanCacheDelete();
+
         // scan result
         bool getNetworkInfo(uint8_t networkItem, String &ssid, uint8_t &encryptionType, int32_t &RSSI, uint8_t* &BSSID, int32_t &channel, bool &isHidden);
 
@@ -65,6 +99,24 @@ class ESP8266WiFiScanClass {
         static void _scanDone(void* result, int status);
         static void * _getScanInfoByIndex(int i);
 
+        static uint8_t _streamChannel;      // channel being scanned, 0 = idle
+        static uint8_t _streamLastChannel;
+        static bool _streamHidden;
+        static int _streamFound;
+        static std::function<void(const WiFiScanEntry&)> _onStreamNetwork;
+        static std::function<void(int)> _onStreamComplete;
+
+        static WiFiScanEntry* _cache;
+        static uint8_t _cacheCount;
+        static uint32_t _cacheTime;
+        static bool _cacheValid;
+
+        static bool _streamNext();
+        static void _streamDone(void* result, int status);
+        static void _cacheUpdate(const WiFiScanEntry& entry);
+        static void _cacheExpire();
+        static uint8_t _encryptionType(uint8_t authmode);
+
 };
 
 
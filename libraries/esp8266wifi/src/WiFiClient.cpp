@@ -287,6 +287,28 @@ int WiFiClient::peek()
     return _client->peek();
 }
 
+const char* WiFiClient::peekBuffer()
+{
+    if (!_client)
+        return nullptr;
+
+    return _client->peekBuffer();
+}
+
+size_t WiFiClient::peekAvailable()
+{
+    if (!_client)
+        return 0;
+
+    return _client->peekAvailable();
+}
+
+void WiFiClient::peekConsume(size_t consume)
+{
+    if (_client)
+        _client->peekConsume(consume);
+}
+
 size_t WiFiClient::peekBytes(uint8_t *buffer, size_t length) {
     size_t count = 0;
 
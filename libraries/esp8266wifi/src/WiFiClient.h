@@ -72,6 +72,16 @@ public:
   size_t peekBytes(char *buffer, size_t length) {
     return peekBytes((uint8_t *) buffer, length);
   }
+
+  // Zero-copy receive: peekBuffer() points at up to peekAvailable() bytes
+  // of received data, in place in the network stack's buffers; peekConsume()
+  // releases them. A buffer ends at a packet boundary, so peekAvailable()
+  // may be less than available(): consume and peek again for the rest.
+  // The pointer is valid until the next read(), peekConsume() or stop().
+  virtual bool hasPeekBufferAPI() const { return true; }
+  virtual const char* peekBuffer();
+  virtual size_t peekAvailable();
+  virtual void peekConsume(size_t consume);
   virtual void flush() override { (void)flush(0); }
   virtual void stop() override { (void)stop(0); }
   bool flush(unsigned int maxWaitMs);
@@ -51,6 +51,11 @@ public:
   int read() override;
   int peek() override;
   size_t peekBytes(uint8_t *buffer, size_t length) override;
+  // axTLS has no contiguous view of its plaintext, use read()
+  bool hasPeekBufferAPI() const override { return false; }
+  const char* peekBuffer() override { return nullptr; }
+  size_t peekAvailable() override { return 0; }
+  void peekConsume(size_t consume) override { (void)consume; }
   void stop() override { (void)stop(0); }
   bool stop(unsigned int maxWaitMs);
 
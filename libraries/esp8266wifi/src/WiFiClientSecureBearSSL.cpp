@@ -426,6 +426,30 @@ size_t WiFiClientSecure::peekBytes(uint8_t *buffer, size_t length) {
   return to_copy;
 }
 
+const char* WiFiClientSecure::peekBuffer() {
+  if (!ctx_present() || !_handshake_done || !available()) {
+    return nullptr;
+  }
+  return (const char*)_recvapp_buf;
+}
+
+size_t WiFiClientSecure::peekAvailable() {
+  if (!ctx_present() || !_handshake_done) {
+    return 0;
+  }
+  return available();
+}
+
+void WiFiClientSecure::peekConsume(size_t consume) {
+  if (!ctx_present() || !_handshake_done || !available()) {
+    return;
+  }
+  // Only the current record is acked; the next one shows up on the next peek
+  br_ssl_engine_recvapp_ack(_eng, consume < _recvapp_len ? consume : _recvapp_len);
+  _recvapp_buf = nullptr;
+  _recvapp_len = 0;
+}
+
 /* --- Copied almost verbatim from BEARSSL SSL_IO.C ---
    Run the engine, until the specified target state is achieved, or
    an error occurs. The target state is SENDAPP, RECVAPP, or the
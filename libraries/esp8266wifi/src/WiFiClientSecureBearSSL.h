@@ -56,6 +56,10 @@ class WiFiClientSecure : public WiFiClient {
     int read() override;
     int peek() override;
     size_t peekBytes(uint8_t *buffer, size_t length) override;
+    // Decrypted data, in place in BearSSL's receive buffer
+    const char* peekBuffer() override;
+    size_t peekAvailable() override;
+    void peekConsume(size_t consume) override;
     bool flush(unsigned int maxWaitMs);
     bool stop(unsigned int maxWaitMs);
     void flush() override { (void)flush(0); }
@@ -176,6 +176,25 @@ int WiFiUDP::endPacket()
     return (_ctx->send()) ? 1 : 0;
 }
 
+size_t WiFiUDP::send(WiFiUDPBatch& batch)
+{
+    if (!_ctx) {
+        _ctx = new UdpContext;
+        _ctx->ref();
+    }
+
+    size_t sent = 0;
+    for (size_t i = 0; i < batch.count(); i++) {
+        const WiFiUDPBatch::Datagram& d = batch.datagram(i);
+        ip_addr_t addr = d.ip;
+        if (_ctx->sendTo(batch.data(i), d.length, &addr, d.port)) {
+            sent++;
+        }
+    }
+    batch.clear();
+    return sent;
+}
+
 size_t WiFiUDP::write(uint8_t byte)
 {
     return write(&byte, 1);
@@ -29,6 +29,69 @@
 
 class UdpContext;
 
+// Datagrams queued for WiFiUDP::send(WiFiUDPBatch&), laid out back to back
+// in a pool the caller owns; nothing here allocates. Either write a
+// datagram in place (reserve(), then commit() with its real length) or
+// copy a finished one in with add().
+class WiFiUDPBatch {
+public:
+  struct Datagram {
+    IPAddress ip;
+    uint16_t  port;
+    uint16_t  offset;   // in the pool, so pools up to 64 KB
+    uint16_t  length;
+  };
+
+  WiFiUDPBatch(uint8_t* pool, size_t poolSize, Datagram* slots, size_t slotCount)
+    : _pool(pool), _poolSize(poolSize), _slots(slots), _slotCount(slotCount)
+    , _used(0), _count(0)
+  {}
+
+  // Room for the next datagram, or nullptr if the pool or the slots are full
+  uint8_t* reserve(size_t maxLength) {
+    if (_count >= _slotCount || _poolSize - _used < maxLength) {
+      return nullptr;
+    }
+    return _pool + _used;
+  }
+
+  // Queues the datagram written at reserve()
+  bool commit(IPAddress ip, uint16_t port, size_t length) {
+    if (!reserve(length)) {
+      return false;
+    }
+    Datagram& d = _slots[_count++];
+    d.ip = ip;
+    d.port = port;
+    d.offset = _used;
+    d.length = length;
+    _used += length;
+    return true;
+  }
+
+  bool add(IPAddress ip, uint16_t port, const void* data, size_t length) {
+    uint8_t* dst = reserve(length);
+    if (!dst) {
+      return false;
+    }
+    memcpy(dst, data, length);
+    return commit(ip, port, length);
+  }
+
+  size_t count() const { return _count; }
+  const Datagram& datagram(size_t i) const { return _slots[i]; }
+  const uint8_t* data(size_t i) const { return _pool + _slots[i].offset; }
+  void clear() { _used = 0; _count = 0; }
+
+private:
+  uint8_t*  _pool;
+  size_t    _poolSize;
+  Datagram* _slots;
+  size_t    _slotCount;
+  size_t    _used;
+  size_t    _count;
+};
+
 class WiFiUDP : public UDP, public SList<WiFiUDP> {
 private:
   UdpContext* _ctx;
@@ -70,6 +133,12 @@ public:
   // Finish off this packet and send it
   // Returns 1 if the packet was sent successfully, 0 if there was an error
   int endPacket() override;
+  // Send every datagram in batch, each in one pbuf copied once from the
+  // pool, then empty it. Destinations come from the batch, not from
+  // beginPacket(); a multicast TTL set with beginPacketMulticast() applies.
+  // Returns the number of datagrams sent
+  size_t send(WiFiUDPBatch& batch);
+
   // Write a single byte into the packet
   size_t write(uint8_t) override;
   // Write size bytes from buffer into the packet
@@ -147,7 +147,12 @@ public:
 
     size_t availableForWrite() const
     {
-        return _pcb? tcp_sndbuf(_pcb): 0;
+        // flash data goes out one pbuf per write, so the segment queue
+        // can fill up before the send buffer does
+        if (!_pcb || tcp_sndqueuelen(_pcb) >= TCP_SND_QUEUELEN) {
+            return 0;
+        }
+        return tcp_sndbuf(_pcb);
     }
 
     void setNoDelay(bool nodelay)
@@ -286,6 +291,37 @@ public:
         return copy_size;
     }
 
+    // Received data at the read position, up to the end of the current
+    // pbuf, in place. Valid until the next read or peekConsume().
+    const char* peekBuffer() const
+    {
+        if(!_rx_buf) {
+            return nullptr;
+        }
+
+        return reinterpret_cast<const char*>(_rx_buf->payload) + _rx_buf_offset;
+    }
+
+    size_t peekAvailable() const
+    {
+        if(!_rx_buf) {
+            return 0;
+        }
+
+        return _rx_buf->len - _rx_buf_offset;
+    }
+
+    void peekConsume(size_t size)
+    {
+        while(size && _rx_buf) {
+            size_t buf_size = _rx_buf->len - _rx_buf_offset;
+            size_t consume_size = (size < buf_size) ? size : buf_size;
+            DEBUGV(":pc %d, %d\r\n", size, consume_size);
+            _consume(consume_size);
+            size -= consume_size;
+        }
+    }
+
     void discard_received()
     {
         if(!_rx_buf) {
@@ -374,8 +410,16 @@ public:
         if (!_pcb) {
             return 0;
         }
+        if (!ProgmemDataSource::in_flash(buf)) {
+            // PGM_P may well point to RAM: no bounce buffer needed then
+            return _write_from_source(new BufferDataSource(reinterpret_cast<const uint8_t*>(buf), size));
+        }
+#ifdef NON32XFER_HANDLER
+        return _write_from_source(new ProgmemDataSource(buf, size));
+#else
         ProgmemStream stream(buf, size);
         return _write_from_source(new BufferedStreamDataSource<ProgmemStream>(stream, size));
+#endif
     }
 
     void keepAlive (uint16_t idle_sec = TCP_DEFAULT_KEEPALIVE_IDLE_SEC, uint16_t intv_sec = TCP_DEFAULT_KEEPALIVE_INTERVAL_SEC, uint8_t count = TCP_DEFAULT_KEEPALIVE_COUNT)
@@ -493,9 +537,10 @@ protected:
                 //   #5173: windows needs this flag
                 //   more info: https://lists.gnu.org/archive/html/lwip-users/2009-11/msg00018.html
                 flags |= TCP_WRITE_FLAG_MORE; // do not tcp-PuSH (yet)
-            if (!_sync)
+            if (!_sync && !_datasource->is_persistent())
                 // user data must be copied when data are sent but not yet acknowledged
-                // (with sync, we wait for acknowledgment before returning to user)
+                // (with sync, we wait for acknowledgment before returning to user;
+                // persistent data, i.e. flash, outlives the acknowledgment anyway)
                 flags |= TCP_WRITE_FLAG_COPY;
 
             err_t err = tcp_write(_pcb, buf, next_chunk_size, flags);
@@ -13,6 +13,9 @@ public:
     virtual size_t available() = 0;
     virtual const uint8_t* get_buffer(size_t size) = 0;
     virtual void release_buffer(const uint8_t* buffer, size_t size) = 0;
+    // True if the buffers stay valid for good, so lwIP can send straight
+    // from them instead of copying them until they are acknowledged
+    virtual bool is_persistent() const { return false; }
 
 };
 
@@ -127,6 +130,28 @@ protected:
     size_t _streamPos = 0;
 };
 
+// Constant data in flash, handed to lwIP in place. Reading it byte by byte
+// (checksum, driver copy) relies on the non-32-bit load exception handler.
+class ProgmemDataSource : public BufferDataSource {
+public:
+    ProgmemDataSource(PGM_P data, size_t size) :
+        BufferDataSource(reinterpret_cast<const uint8_t*>(data), size)
+    {
+    }
+
+    bool is_persistent() const override
+    {
+        return true;
+    }
+
+    // Whether a PGM_P actually points into the memory-mapped flash
+    static bool in_flash(PGM_P data)
+    {
+        const uint32_t addr = reinterpret_cast<uint32_t>(data);
+        return addr >= 0x40200000 && addr < 0x40300000;
+    }
+};
+
 class ProgmemStream
 {
 public:
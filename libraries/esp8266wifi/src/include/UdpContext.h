@@ -368,7 +368,27 @@ public:
             return false;
         }
 
+        return _send(tx_copy, addr, port);
+    }
+
+    // One datagram from a contiguous buffer: a single pbuf and a single
+    // copy, without going through the append() chain
+    bool sendTo(const void* data, size_t size, CONST ip_addr_t* addr, uint16_t port)
+    {
+        pbuf* tx = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
+        if (!tx) {
+            DEBUGV("failed pbuf_alloc");
+            return false;
+        }
+        memcpy(tx->payload, data, size);
+        return _send(tx, addr, port);
+    }
+
+private:
 
+    // Sends and frees tx
+    bool _send(pbuf* tx, CONST ip_addr_t* addr, uint16_t port)
+    {
         if (!addr) {
             addr = &_pcb->remote_ip;
             port = _pcb->remote_port;
@@ -379,19 +399,17 @@ public:
             _pcb->ttl = _mcast_ttl;
         }
 #endif
-        err_t err = udp_sendto(_pcb, tx_copy, addr, port);
+        err_t err = udp_sendto(_pcb, tx, addr, port);
         if (err != ERR_OK) {
             DEBUGV(":ust rc=%d\r\n", (int) err);
         }
 #ifdef LWIP_MAYBE_XCC
         _pcb->ttl = old_ttl;
 #endif
-        pbuf_free(tx_copy);
+        pbuf_free(tx);
         return err == ERR_OK;
     }
 
-private:
-
     void _reserve(size_t size)
     {
         const size_t pbuf_unit_size = 128;
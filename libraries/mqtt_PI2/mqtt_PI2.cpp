@@ -0,0 +1,302 @@
+/*  Biblioteca de MQTT do Forno
+ *
+ *  mqtt_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "mqtt_PI2.h"
+
+#if defined(ESP8266) || defined(ESP32)
+#define MQTT_LWIP 1
+#include "lwip/dns.h"
+#include "lwip/ip_addr.h"
+#endif
+
+#define DNS_NADA      0           // _ip vazio: resolver antes de conectar
+#define DNS_PEDIDO    1           // aguardando o callback
+#define DNS_RESPOSTA  2           // _dnsIp chegou
+#define DNS_FALHOU    3
+#define DNS_PRONTO    4           // _ip vale
+
+#define MQTT_CONNECT    0x10
+#define MQTT_CONNACK    0x20
+#define MQTT_PUBLISH    0x30
+#define MQTT_PINGREQ    0xC0
+#define MQTT_DISCONNECT 0xE0
+
+#define MQTT_CABECALHO_MAX 5      // tipo + até 4 bytes de comprimento
+
+ClienteMqtt_PI2::ClienteMqtt_PI2(Client &cliente) : _cliente(cliente)
+{
+  _host = NULL;
+  _porta = 1883;
+  _id = NULL;
+  _usuario = NULL;
+  _senha = NULL;
+  _estado = MQTT_DESCONECTADO;
+  _primeira = true;
+  _instante = 0;
+  _enviado = 0;
+  _recebido = 0;
+  _lidos = 0;
+  _publicados = 0;
+  _reconexoes = 0;
+  _dns = DNS_NADA;
+  _dnsIp = 0;
+  _nomeNoCliente = false;
+}
+
+void ClienteMqtt_PI2::configurar(const char *host, uint16_t porta, const char *id,
+                                 const char *usuario, const char *senha)
+{
+  _host = host;
+  _porta = porta;
+  _id = id;
+  _usuario = usuario;
+  _senha = senha;
+  _dns = _ip.fromString(host) ? DNS_PRONTO : DNS_NADA;   // IP literal: sem DNS
+  _cliente.setTimeout(MQTT_CONEXAO_MS);
+}
+
+void ClienteMqtt_PI2::nomeNoCliente(bool sim)
+{
+  _nomeNoCliente = sim;
+}
+
+bool ClienteMqtt_PI2::conectado(void) const
+{
+  return _estado == MQTT_CONECTADO;
+}
+
+uint32_t ClienteMqtt_PI2::publicados(void) const
+{
+  return _publicados;
+}
+
+uint32_t ClienteMqtt_PI2::reconexoes(void) const
+{
+  return _reconexoes;
+}
+
+// lwIP: no SYS do ESP8266 ou na tarefa tcpip do ESP32; só escreve dois campos
+void ClienteMqtt_PI2::resolvido(const char *nome, const void *ip, void *arg)
+{
+  (void)nome;
+  ClienteMqtt_PI2 *eu = (ClienteMqtt_PI2 *)arg;
+#if MQTT_LWIP
+  if (ip) eu->_dnsIp = ip4_addr_get_u32(ip_2_ip4((const ip_addr_t *)ip));
+#endif
+  eu->_dns = ip ? DNS_RESPOSTA : DNS_FALHOU;
+}
+
+// connect() ao IP guardado, limitado por MQTT_CONEXAO_MS (setTimeout() em
+// configurar()); se falha, o nome é resolvido de novo na próxima tentativa
+bool ClienteMqtt_PI2::conectarTcp(void)
+{
+#if MQTT_LWIP
+  if (!_nomeNoCliente) {
+    if (_cliente.connect(_ip, _porta)) return true;
+    _dns = DNS_NADA;
+    return false;
+  }
+#endif
+  return _cliente.connect(_host, _porta);
+}
+
+// Chamado no loop(). Resolver o nome e esperar o CONNACK não param o
+// loop(); só o connect() ao IP espera, no máximo MQTT_CONEXAO_MS.
+void ClienteMqtt_PI2::atender(void)
+{
+  if (_host == NULL || _host[0] == 0) return;
+
+  unsigned long agora = millis();
+
+  if (_estado > MQTT_RESOLVENDO && !_cliente.connected()) {
+    derrubar();
+  }
+
+  switch (_estado) {
+    case MQTT_DESCONECTADO:
+      if (!_primeira && agora - _instante < MQTT_ESPERA_MS) return;
+      _primeira = false;
+      _instante = agora;
+#if MQTT_LWIP
+      if (_dns != DNS_PRONTO && !_nomeNoCliente) {
+        ip_addr_t endereco;
+        _dns = DNS_PEDIDO;
+#if defined(ESP32) && defined(LOCK_TCPIP_CORE)
+        LOCK_TCPIP_CORE();
+#endif
+        err_t e = dns_gethostbyname(_host, &endereco, (dns_found_callback)resolvido, this);
+#if defined(ESP32) && defined(LOCK_TCPIP_CORE)
+        UNLOCK_TCPIP_CORE();
+#endif
+        if (e == ERR_OK) resolvido(_host, &endereco, this);      // estava no cache
+        else if (e != ERR_INPROGRESS) _dns = DNS_FALHOU;
+        _estado = MQTT_RESOLVENDO;
+        return;
+      }
+#endif
+      if (!conectarTcp()) return;
+      if (!enviarConnect()) return;
+      _estado = MQTT_AGUARDANDO;
+      _lidos = 0;
+      break;
+
+    case MQTT_RESOLVENDO:
+      if (_dns == DNS_RESPOSTA) {
+        _ip = IPAddress((uint32_t)_dnsIp);
+        _dns = DNS_PRONTO;
+        _instante = agora;
+        if (!conectarTcp() || !enviarConnect()) {
+          _estado = MQTT_DESCONECTADO;
+          return;
+        }
+        _estado = MQTT_AGUARDANDO;
+        _lidos = 0;
+      }
+      else if (_dns == DNS_FALHOU || agora - _instante > MQTT_DNS_MS) {
+        // um callback atrasado fica sem efeito: a próxima tentativa pede de novo
+        _dns = DNS_NADA;
+        _estado = MQTT_DESCONECTADO;
+        _instante = agora;
+      }
+      break;
+
+    case MQTT_AGUARDANDO:
+      while (_cliente.available() && _lidos < sizeof(_connack)) {
+        _connack[_lidos++] = _cliente.read();
+      }
+      if (_lidos == sizeof(_connack)) {
+        // CONNACK: 0x20 0x02 flags código; código 0 = aceito
+        if (_connack[0] == MQTT_CONNACK && _connack[3] == 0) {
+          _estado = MQTT_CONECTADO;
+          _recebido = agora;
+          _reconexoes++;
+        }
+        else {
+          derrubar();
+        }
+      }
+      else if (agora - _instante > MQTT_CONNACK_MS) {
+        derrubar();
+      }
+      break;
+
+    case MQTT_CONECTADO:
+      // sem assinaturas, só chegam PINGRESP: basta saber que o broker responde
+      while (_cliente.available()) {
+        _cliente.read();
+        _recebido = agora;
+      }
+      if (agora - _recebido > 2000UL * MQTT_KEEPALIVE_S) {
+        derrubar();
+      }
+      else if (agora - _enviado > 500UL * MQTT_KEEPALIVE_S) {
+        _buffer[0] = MQTT_PINGREQ;
+        _buffer[1] = 0;
+        enviar(2);
+      }
+      break;
+  }
+}
+
+// Cabeçalho fixo em _buffer[0]: tipo e o comprimento restante em até 4
+// bytes de 7 bits. Devolve onde começa o cabeçalho variável.
+size_t ClienteMqtt_PI2::cabecalho(uint8_t tipo, size_t restante)
+{
+  size_t pos = 0;
+  _buffer[pos++] = tipo;
+  do {
+    uint8_t b = restante & 0x7F;
+    restante >>= 7;
+    if (restante) b |= 0x80;
+    _buffer[pos++] = b;
+  } while (restante);
+  return pos;
+}
+
+size_t ClienteMqtt_PI2::escreverTexto(size_t pos, const char *texto)
+{
+  size_t n = strlen(texto);
+  _buffer[pos++] = n >> 8;
+  _buffer[pos++] = n & 0xFF;
+  memcpy(_buffer + pos, texto, n);
+  return pos + n;
+}
+
+bool ClienteMqtt_PI2::enviarConnect(void)
+{
+  const char *id = _id ? _id : "";
+  size_t restante = 10 + 2 + strlen(id);
+  uint8_t flags = 0x02;   // sessão limpa
+  if (_usuario) {
+    restante += 2 + strlen(_usuario);
+    flags |= 0x80;
+    if (_senha) {
+      restante += 2 + strlen(_senha);
+      flags |= 0x40;
+    }
+  }
+  if (restante + MQTT_CABECALHO_MAX > sizeof(_buffer)) {
+    derrubar();
+    return false;
+  }
+
+  size_t pos = cabecalho(MQTT_CONNECT, restante);
+  pos = escreverTexto(pos, "MQTT");
+  _buffer[pos++] = 4;       // nível do protocolo: 3.1.1
+  _buffer[pos++] = flags;
+  _buffer[pos++] = MQTT_KEEPALIVE_S >> 8;
+  _buffer[pos++] = MQTT_KEEPALIVE_S & 0xFF;
+  pos = escreverTexto(pos, id);
+  if (flags & 0x80) pos = escreverTexto(pos, _usuario);
+  if (flags & 0x40) pos = escreverTexto(pos, _senha);
+  return enviar(pos);
+}
+
+// PUBLISH QoS 0: nada a confirmar nem a reenviar. Com a sessão caída ou
+// a carga maior que o buffer, descarta e devolve false.
+bool ClienteMqtt_PI2::publicar(const char *topico, const uint8_t *carga, size_t tamanho, bool reter)
+{
+  if (_estado != MQTT_CONECTADO) return false;
+
+  size_t n = strlen(topico);
+  size_t restante = 2 + n + tamanho;
+  if (restante + MQTT_CABECALHO_MAX > sizeof(_buffer)) return false;
+
+  size_t pos = cabecalho(MQTT_PUBLISH | (reter ? 0x01 : 0), restante);
+  pos = escreverTexto(pos, topico);
+  memcpy(_buffer + pos, carga, tamanho);
+  if (!enviar(pos + tamanho)) return false;
+  _publicados++;
+  return true;
+}
+
+bool ClienteMqtt_PI2::enviar(size_t tamanho)
+{
+  if (_cliente.write(_buffer, tamanho) != tamanho) {
+    derrubar();
+    return false;
+  }
+  _enviado = millis();
+  return true;
+}
+
+void ClienteMqtt_PI2::desconectar(void)
+{
+  if (_estado == MQTT_CONECTADO) {
+    _buffer[0] = MQTT_DISCONNECT;
+    _buffer[1] = 0;
+    _cliente.write(_buffer, 2);
+  }
+  derrubar();
+  _host = NULL;
+}
+
+void ClienteMqtt_PI2::derrubar(void)
+{
+  _cliente.stop();
+  _estado = MQTT_DESCONECTADO;
+  _instante = millis();
+}
@@ -0,0 +1,78 @@
+/*  Biblioteca de MQTT do Forno
+ *  Cliente MQTT 3.1.1 mínimo sobre qualquer Client (WiFiClient): só
+ *  publica, em QoS 0, e mantém a sessão com PINGREQ. Um buffer fixo monta
+ *  cada PUBLISH inteiro, que sai em uma escrita só; a reconexão é uma
+ *  máquina de estados chamada do loop(), com espera entre tentativas.
+ *  Nada nela pode segurar o loop(), onde também correm as leituras dos
+ *  termopares: o nome do broker é resolvido uma vez pelo DNS do lwIP sem
+ *  esperar (de novo só quando uma conexão ao endereço guardado falha) e
+ *  o connect() vai ao IP com prazo de MQTT_CONEXAO_MS. Sem lwIP (outras
+ *  placas), ou com nomeNoCliente() (o modem celular resolve sozinho), o
+ *  connect() recebe o nome, como antes.
+ *
+ *  mqtt_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef MqttForno
+#define MqttForno
+
+#include <Arduino.h>
+#include <Client.h>
+
+#define MQTT_TAMANHO_BUFFER 768    // maior PUBLISH: cabeçalho + tópico + carga
+#define MQTT_KEEPALIVE_S    30
+#define MQTT_ESPERA_MS      5000   // entre tentativas de conexão
+#define MQTT_CONNACK_MS     3000   // prazo do broker para aceitar
+#define MQTT_CONEXAO_MS     300    // connect() ao IP: bem abaixo dos 1,5 s do supervisor
+#define MQTT_DNS_MS         5000   // prazo da resposta do DNS
+
+enum EstadoMqtt { MQTT_DESCONECTADO, MQTT_RESOLVENDO, MQTT_AGUARDANDO, MQTT_CONECTADO };
+
+class ClienteMqtt_PI2 {
+ public:
+  ClienteMqtt_PI2(Client &cliente);
+  void configurar(const char *host, uint16_t porta, const char *id,
+                  const char *usuario = NULL, const char *senha = NULL);
+  void atender(void);
+  bool conectado(void) const;
+  bool publicar(const char *topico, const uint8_t *carga, size_t tamanho, bool reter = false);
+  void desconectar(void);
+  void nomeNoCliente(bool sim);     // o Client resolve o nome (modem), sem o DNS do lwIP
+  uint32_t publicados(void) const;
+  uint32_t reconexoes(void) const;
+
+ private:
+  bool enviarConnect(void);
+  bool enviar(size_t tamanho);
+  size_t cabecalho(uint8_t tipo, size_t restante);
+  size_t escreverTexto(size_t pos, const char *texto);
+  void derrubar(void);
+  bool conectarTcp(void);
+  static void resolvido(const char *nome, const void *ip, void *arg);
+
+  Client &_cliente;
+  const char *_host;
+  uint16_t _porta;
+  const char *_id;
+  const char *_usuario;
+  const char *_senha;
+
+  IPAddress _ip;
+  bool _nomeNoCliente;
+  volatile uint8_t _dns;      // DNS_* de mqtt_PI2.cpp, escrito pelo callback do lwIP
+  volatile uint32_t _dnsIp;
+
+  EstadoMqtt _estado;
+  bool _primeira;             // primeira tentativa sai sem esperar
+  unsigned long _instante;    // millis() da última transição/tentativa
+  unsigned long _enviado;     // millis() do último pacote enviado
+  unsigned long _recebido;    // millis() do último byte do broker
+  uint8_t _connack[4];
+  uint8_t _lidos;
+  uint32_t _publicados;
+  uint32_t _reconexoes;
+  uint8_t _buffer[MQTT_TAMANHO_BUFFER];
+};
+
+#endif
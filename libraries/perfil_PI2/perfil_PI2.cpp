@@ -0,0 +1,593 @@
+/*  Biblioteca de Perfis de Refusão do Forno
+ *
+ *  perfil_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "perfil_PI2.h"
+
+// Perfil medido no forno do laboratório (antigos perfil_temp/perfil_tempo)
+static const SegmentoPerfil PERFIL_LABORATORIO[] PROGMEM = {
+  {FASE_RAMPA,        0,  4,  290},
+  {FASE_RAMPA,        0, 14,  522},
+  {FASE_RAMPA,        0, 13,  760},
+  {FASE_RAMPA,        0, 17,  992},
+  {FASE_RAMPA,        0, 26, 1288},
+  {FASE_RAMPA,        0, 15, 1415},
+  {FASE_RAMPA,        0, 22, 1554},
+  {FASE_PATAMAR,      0, 18, 1746},
+  {FASE_PATAMAR,      0, 14, 1972},
+  {FASE_PICO,         0, 18, 2245},
+  {FASE_PICO,         0, 19, 2418},
+  {FASE_RESFRIAMENTO, 0, 21, 2100},
+  {FASE_RESFRIAMENTO, 0,  9, 1815},
+  {FASE_RESFRIAMENTO, 0, 10, 1566},
+  {FASE_RESFRIAMENTO, 0, 12, 1282},
+  {FASE_RESFRIAMENTO, 0, 14, 1015},
+  {FASE_RESFRIAMENTO, 0, 16,  754},
+  {FASE_RESFRIAMENTO, 0, 14,  557},
+  {FASE_RESFRIAMENTO, 0, 22,  290},
+};
+
+#define QTD(v) (sizeof(v) / sizeof(v[0]))
+
+// Janelas das fichas das pastas: liquidus, pico, TAL, faixa e tempo do
+// patamar, subida até 3 C/s e descida até 6 C/s
+//                          liquidus  pico       TAL      patamar     tempo     subida/descida
+static constexpr JanelaProcesso JANELA_SAC305   = { 2170, 2350, 2500, 45,  90, 1500, 2000, 60, 120, 30, 60 };
+static constexpr JanelaProcesso JANELA_Sn63Pb37 = { 1830, 2050, 2250, 45,  90, 1400, 1700, 60, 120, 30, 60 };
+static constexpr JanelaProcesso JANELA_Sn42Bi58 = { 1380, 1600, 1800, 30,  90,  900, 1200, 60, 120, 30, 60 };
+static constexpr JanelaProcesso JANELA_LAB      = { 2170, 2300, 2500, 30, 150, 1500, 2000, 30, 120, 30, 60 };
+
+static const JanelaProcesso JANELA_PADRAO = JANELA_SAC305;   // perfis sem pasta conhecida
+
+// Perfis das pastas gerados na compilação a partir da janela, no meio de
+// cada faixa: pico, TAL e tempo de patamar centrais, subidas na metade
+// da taxa máxima e descidas na metade da máxima. Trocar de pasta é trocar
+// o nome em PERFIL_LIGA; static_assert confere cada tabela contra a
+// própria janela
+#define PERFIL_GERADO_SEGMENTOS 7
+#define PERFIL_AMBIENTE_dC      250   // início do perfil
+#define PERFIL_FIM_dC           500   // fim do resfriamento
+
+struct TabelaGerada {
+  SegmentoPerfil segmentos[PERFIL_GERADO_SEGMENTOS];
+};
+
+// segundos para variar delta_dC a taxa_dCs, arredondado para cima
+static constexpr uint16_t duracaoRampa(int16_t delta_dC, uint8_t taxa_dCs) {
+  return (uint16_t)((delta_dC < 0 ? -delta_dC : delta_dC) + taxa_dCs - 1) / taxa_dCs;
+}
+
+static constexpr TabelaGerada gerarTabela(const JanelaProcesso &j) {
+  const uint8_t subida = j.subidaMax_dCs / 2, descida = j.descidaMax_dCs / 2;
+  const int16_t pico = (j.picoMin_dC + j.picoMax_dC) / 2;
+  const uint16_t tal = (j.talMin_s + j.talMax_s) / 2;
+  const uint16_t acima = duracaoRampa(pico - j.liquidus_dC, subida);
+  const uint16_t abaixo = duracaoRampa(pico - j.liquidus_dC, descida);
+  const uint16_t retencao = tal > acima + abaixo ? tal - acima - abaixo : 0;
+  return TabelaGerada{{
+    {FASE_RAMPA,        0, duracaoRampa(j.patamarMin_dC - PERFIL_AMBIENTE_dC, subida), j.patamarMin_dC},
+    {FASE_PATAMAR,      0, (uint16_t)((j.patamarMin_s + j.patamarMax_s) / 2),          j.patamarMax_dC},
+    {FASE_RAMPA,        0, duracaoRampa(j.liquidus_dC - j.patamarMax_dC, subida),      j.liquidus_dC},
+    {FASE_PICO,         0, acima,                                                      pico},
+    {FASE_PICO,         0, retencao,                                                   pico},
+    {FASE_RESFRIAMENTO, 0, abaixo,                                                     j.liquidus_dC},
+    {FASE_RESFRIAMENTO, 0, duracaoRampa(j.liquidus_dC - PERFIL_FIM_dC, descida),       PERFIL_FIM_dC},
+  }};
+}
+
+// O set point gerado cabe na janela: TAL do set point, taxas e patamar
+static constexpr bool tabelaNaJanela(const TabelaGerada &t, const JanelaProcesso &j) {
+  uint16_t tal = t.segmentos[3].duracao_s + t.segmentos[4].duracao_s + t.segmentos[5].duracao_s;
+  int16_t de = PERFIL_AMBIENTE_dC;
+  for (uint8_t i = 0; i < PERFIL_GERADO_SEGMENTOS; i++) {
+    const SegmentoPerfil &s = t.segmentos[i];
+    int16_t delta = s.temperatura_dC - de;
+    if (s.duracao_s == 0 && delta != 0) return false;
+    if (delta > 0 && delta > (int32_t)j.subidaMax_dCs * s.duracao_s) return false;
+    if (delta < 0 && -delta > (int32_t)j.descidaMax_dCs * s.duracao_s) return false;
+    de = s.temperatura_dC;
+  }
+  return tal >= j.talMin_s && tal <= j.talMax_s
+         && t.segmentos[3].temperatura_dC >= j.picoMin_dC && t.segmentos[3].temperatura_dC <= j.picoMax_dC
+         && t.segmentos[1].duracao_s >= j.patamarMin_s && t.segmentos[1].duracao_s <= j.patamarMax_s;
+}
+
+#define PERFIL_LIGA(liga) \
+  static const TabelaGerada TABELA_##liga PROGMEM = gerarTabela(JANELA_##liga); \
+  static_assert(tabelaNaJanela(gerarTabela(JANELA_##liga), JANELA_##liga), "perfil " #liga " fora da janela")
+
+PERFIL_LIGA(SAC305);
+PERFIL_LIGA(Sn63Pb37);
+PERFIL_LIGA(Sn42Bi58);
+
+#define ENTRADA_LIGA(liga) \
+  {#liga, PERFIL_AMBIENTE_dC, PERFIL_GERADO_SEGMENTOS, TABELA_##liga.segmentos, JANELA_##liga}
+
+const PerfilReflow CATALOGO_PERFIS[] PROGMEM = {
+  {"laboratorio", 290, QTD(PERFIL_LABORATORIO), PERFIL_LABORATORIO, JANELA_LAB},
+  ENTRADA_LIGA(Sn63Pb37),
+  ENTRADA_LIGA(SAC305),
+  ENTRADA_LIGA(Sn42Bi58),
+};
+
+const uint8_t QUANTIDADE_PERFIS = QTD(CATALOGO_PERFIS);
+
+PerfilReflow_PI2::PerfilReflow_PI2() {
+  total = 0;
+  perfilAtual = 0;
+  inicio_dC = 0;
+  toleranciaRetencao = 0;
+  selecionar(0);
+}
+
+bool PerfilReflow_PI2::selecionar(uint8_t indice) {
+  if (indice >= QUANTIDADE_PERFIS) return false;
+
+  PerfilReflow p;
+  memcpy_P(&p, &CATALOGO_PERFIS[indice], sizeof(p));
+  if (p.quantidade > PERFIL_MAX_SEGMENTOS) return false;
+
+  memcpy_P(tabela, p.segmentos, p.quantidade * sizeof(SegmentoPerfil));
+  total = p.quantidade;
+  inicio_dC = p.inicial_dC;
+  limites = p.janela;
+  perfilAtual = indice;
+  iniciar();
+  return true;
+}
+
+// Perfil vindo da RAM (configuração ou upload)
+bool PerfilReflow_PI2::carregar(const SegmentoPerfil *seg, uint8_t n, int16_t inicial_dC,
+                                const JanelaProcesso *janela) {
+  if (n == 0 || n > PERFIL_MAX_SEGMENTOS) return false;
+
+  memcpy(tabela, seg, n * sizeof(SegmentoPerfil));
+  total = n;
+  inicio_dC = inicial_dC;
+  limites = janela ? *janela : JANELA_PADRAO;
+  perfilAtual = 255;
+  iniciar();
+  return true;
+}
+
+void PerfilReflow_PI2::tolerancia(float celsius) {
+  toleranciaRetencao = celsius;
+}
+
+void PerfilReflow_PI2::iniciar(void) {
+  atual = 0;
+  inicioSegmento = 0;
+  tempo = 0;
+  referencia = inicio_dC / 10.0;
+  retido = false;
+}
+
+int16_t PerfilReflow_PI2::temperaturaInicial(uint8_t seg) {
+  return (seg == 0) ? inicio_dC : tabela[seg - 1].temperatura_dC;
+}
+
+float PerfilReflow_PI2::interpolar(void) {
+  if (atual >= total) return tabela[total - 1].temperatura_dC / 10.0;
+
+  const SegmentoPerfil &s = tabela[atual];
+  int16_t de = temperaturaInicial(atual);
+  uint32_t duracao = (uint32_t)s.duracao_s * 1000;
+  uint32_t decorrido = tempo - inicioSegmento;
+
+  if (duracao == 0) return s.temperatura_dC / 10.0;
+  return (de + (float)(s.temperatura_dC - de) * decorrido / duracao) / 10.0;
+}
+
+float PerfilReflow_PI2::atualizar(uint32_t dt_ms, float medida) {
+  if (total == 0 || atual >= total) return referencia;
+
+  // Retenção: nas fases de aquecimento o relógio do perfil espera a
+  // medida alcançar o ponto de partida do segmento
+  bool aquecendo = tabela[atual].fase != FASE_RESFRIAMENTO;
+  bool atrasado = medida < temperaturaInicial(atual) / 10.0 - toleranciaRetencao;
+  retido = aquecendo && atrasado && atual > 0;
+  if (!retido) {
+    tempo += dt_ms;
+  }
+
+  while (atual < total && (tempo - inicioSegmento) >= (uint32_t)tabela[atual].duracao_s * 1000) {
+    inicioSegmento += (uint32_t)tabela[atual].duracao_s * 1000;
+    atual++;
+  }
+
+  referencia = interpolar();
+  return referencia;
+}
+
+float PerfilReflow_PI2::setPoint(void) {
+  return referencia;
+}
+
+// Derivada do set point, usada pela alimentação direta do controle
+float PerfilReflow_PI2::inclinacao(void) {
+  if (total == 0 || atual >= total || retido) return 0;
+  const SegmentoPerfil &s = tabela[atual];
+  if (s.duracao_s == 0) return 0;
+  return (s.temperatura_dC - temperaturaInicial(atual)) / 10.0 / s.duracao_s;
+}
+
+// Para o controle preditivo: anda pela tabela a partir do ponto atual
+// sem mexer no relógio do perfil. Em retenção o relógio só volta a
+// andar quando a medida alcançar o segmento: até lá, o set point é o de agora
+float PerfilReflow_PI2::previsao(uint32_t adiante_ms) {
+  if (total == 0 || retido) return referencia;
+  uint8_t seg = atual;
+  uint32_t decorrido = tempo - inicioSegmento + adiante_ms;
+  while (seg < total && decorrido >= (uint32_t)tabela[seg].duracao_s * 1000) {
+    decorrido -= (uint32_t)tabela[seg].duracao_s * 1000;
+    seg++;
+  }
+  if (seg >= total) return tabela[total - 1].temperatura_dC / 10.0;
+
+  const SegmentoPerfil &s = tabela[seg];
+  int16_t de = temperaturaInicial(seg);
+  return (de + (float)(s.temperatura_dC - de) * decorrido / ((uint32_t)s.duracao_s * 1000)) / 10.0;
+}
+
+uint8_t PerfilReflow_PI2::segmento(void) {
+  return atual;
+}
+
+uint8_t PerfilReflow_PI2::fase(void) {
+  if (total == 0) return FASE_RESFRIAMENTO;
+  return tabela[(atual < total) ? atual : total - 1].fase;
+}
+
+bool PerfilReflow_PI2::terminado(void) {
+  return atual >= total;
+}
+
+uint32_t PerfilReflow_PI2::tempoMs(void) {
+  return tempo;
+}
+
+uint32_t PerfilReflow_PI2::duracaoMs(void) {
+  uint32_t d = 0;
+  for (uint8_t i = 0; i < total; i++) d += (uint32_t)tabela[i].duracao_s * 1000;
+  return d;
+}
+
+uint8_t PerfilReflow_PI2::indice(void) {
+  return perfilAtual;
+}
+
+uint8_t PerfilReflow_PI2::quantidade(void) {
+  return total;
+}
+
+const SegmentoPerfil *PerfilReflow_PI2::segmentos(void) {
+  return tabela;
+}
+
+int16_t PerfilReflow_PI2::inicial_dC(void) {
+  return inicio_dC;
+}
+
+const JanelaProcesso &PerfilReflow_PI2::janela(void) {
+  return limites;
+}
+
+AnaliseCorrida_PI2::AnaliseCorrida_PI2() {
+  limites = JANELA_PADRAO;
+  memset(&r, 0, sizeof(r));
+  iniciada = false;
+}
+
+void AnaliseCorrida_PI2::iniciar(const JanelaProcesso &janela) {
+  limites = janela;
+  memset(&r, 0, sizeof(r));
+  posicao = ocupados = 0;
+  ultimoMs = proximoPontoMs = 0;
+  primeira = true;
+  liquidusAtingido = false;
+  iniciada = true;
+}
+
+// Uma chamada por amostra de controle: cada amostra vale o intervalo
+// desde a anterior
+void AnaliseCorrida_PI2::adicionar(uint32_t tempo_ms, float temperatura) {
+  if (!ativa() || isnan(temperatura)) return;
+
+  float dt_s = primeira ? 0 : (tempo_ms - ultimoMs) / 1000.0;
+  if (primeira || temperatura > r.pico) r.pico = temperatura;
+  primeira = false;
+  ultimoMs = tempo_ms;
+  r.duracao_ms = tempo_ms;
+
+  if (temperatura >= limites.liquidus_dC / 10.0) {
+    r.tal_s += dt_s;
+    liquidusAtingido = true;
+  }
+  else if (!liquidusAtingido && temperatura >= limites.patamarMin_dC / 10.0
+           && temperatura <= limites.patamarMax_dC / 10.0) {
+    r.patamar_s += dt_s;
+  }
+
+  // taxas: um ponto por segundo, comparado com o de ANALISE_RAMPA_S atrás
+  if ((int32_t)(tempo_ms - proximoPontoMs) < 0) return;
+  proximoPontoMs += 1000;
+  pontos[posicao] = temperatura;
+  posicao = (posicao + 1) % (ANALISE_RAMPA_S + 1);
+  if (ocupados < ANALISE_RAMPA_S + 1) ocupados++;
+  if (ocupados <= ANALISE_RAMPA_S) return;
+
+  float taxa = (temperatura - pontos[posicao]) / ANALISE_RAMPA_S;   // posicao é o mais antigo
+  if (taxa > r.subidaMax) r.subidaMax = taxa;
+  if (-taxa > r.descidaMax) r.descidaMax = -taxa;
+}
+
+// completa: a corrida esfriou pelo perfil, sem abortar nem desarmar
+void AnaliseCorrida_PI2::finalizar(bool completa) {
+  if (!ativa()) return;
+  uint16_t f = completa ? 0 : ANALISE_INCOMPLETA;
+  if (r.pico < limites.picoMin_dC / 10.0) f |= ANALISE_PICO_BAIXO;
+  if (r.pico > limites.picoMax_dC / 10.0) f |= ANALISE_PICO_ALTO;
+  if (r.tal_s < limites.talMin_s) f |= ANALISE_TAL_CURTO;
+  if (r.tal_s > limites.talMax_s) f |= ANALISE_TAL_LONGO;
+  if (r.patamar_s < limites.patamarMin_s) f |= ANALISE_PATAMAR_CURTO;
+  if (r.patamar_s > limites.patamarMax_s) f |= ANALISE_PATAMAR_LONGO;
+  if (r.subidaMax > limites.subidaMax_dCs / 10.0) f |= ANALISE_SUBIDA;
+  if (r.descidaMax > limites.descidaMax_dCs / 10.0) f |= ANALISE_DESCIDA;
+  r.falhas = f;
+  r.finalizada = true;
+}
+
+bool AnaliseCorrida_PI2::ativa(void) {
+  return iniciada && !r.finalizada;
+}
+
+void AnaliseCorrida_PI2::ler(ResumoCorrida &destino) {
+  destino = r;
+}
+
+const JanelaProcesso &AnaliseCorrida_PI2::janela(void) {
+  return limites;
+}
+
+LeitorPerfil_PI2::LeitorPerfil_PI2() {
+  iniciar();
+}
+
+void LeitorPerfil_PI2::iniciar(float tolerancia) {
+  tol = tolerancia > 0 ? tolerancia : LEITOR_TOLERANCIA_C;
+  total = 0;
+  falha = NULL;
+  lidos = registros = 0;
+  tamanho = 0;
+  nCampos = 0;
+  json = decidido = comentario = invalido = false;
+  profundidade = 0;
+  fimAnterior_s = 0;
+  inicio_dC = 0;
+  fase = -1;
+  temPonto = temSegmento = false;
+}
+
+bool LeitorPerfil_PI2::alimentar(const uint8_t *dados, size_t n) {
+  for (size_t i = 0; i < n && !falha; i++) caractere((char)dados[i]);
+  return !falha;
+}
+
+bool LeitorPerfil_PI2::finalizar(void) {
+  if (falha) return false;
+  if (json && profundidade != 0) {
+    erroEm("json incompleto");
+    return false;
+  }
+  if (!json) fimRegistro();                  // última linha sem \n
+  if (falha) return false;
+  if (!temPonto || !temSegmento) {
+    erroEm("perfil precisa de pelo menos dois pontos");
+    return false;
+  }
+  return fechar(tAnt, TAnt);
+}
+
+void LeitorPerfil_PI2::erroEm(const char *mensagem) {
+  if (!falha) falha = mensagem;
+}
+
+void LeitorPerfil_PI2::caractere(char c) {
+  if (!decidido) {
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n') return;
+    decidido = true;
+    json = (c == '[');
+  }
+
+  if (comentario) {
+    if (c == '\n') comentario = false;
+    return;
+  }
+  if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+    if (tamanho == LEITOR_NUMERO) {
+      invalido = true;
+      return;
+    }
+    numero[tamanho++] = c;
+    return;
+  }
+
+  if (json) {
+    switch (c) {
+      case '[':
+        if (++profundidade > 2) erroEm("json aninhado demais");
+        break;
+      case ']':
+        fimNumero();
+        if (profundidade == 2) fimRegistro();
+        if (profundidade == 0) erroEm("json malformado");
+        else profundidade--;
+        break;
+      case ',': case ' ': case '\t': case '\r': case '\n':
+        fimNumero();
+        break;
+      default:
+        erroEm("json malformado");
+    }
+    return;
+  }
+
+  switch (c) {
+    case ',': case ';': case ' ': case '\t': case '\r':
+      fimNumero();
+      break;
+    case '\n':
+      fimRegistro();
+      break;
+    case '#':
+      fimRegistro();
+      comentario = true;
+      break;
+    default:
+      invalido = true;   // texto: só o cabeçalho pode ter
+  }
+}
+
+void LeitorPerfil_PI2::fimNumero(void) {
+  if (tamanho == 0) return;
+  numero[tamanho] = 0;
+  tamanho = 0;
+  char *fim;
+  float v = strtod(numero, &fim);
+  if (*fim != 0 || nCampos == 3) {
+    invalido = true;
+    return;
+  }
+  campos[nCampos++] = v;
+}
+
+void LeitorPerfil_PI2::fimRegistro(void) {
+  fimNumero();
+  uint8_t n = nCampos;
+  bool texto = invalido;
+  nCampos = 0;
+  invalido = false;
+  if (n == 0 && !texto) return;             // linha em branco
+  registros++;
+  if (texto) {
+    if (registros == 1 && !json) return;    // cabeçalho do CSV
+    erroEm("valor malformado");
+    return;
+  }
+  if (n < 2) {
+    erroEm("ponto precisa de tempo e temperatura");
+    return;
+  }
+  ponto(campos[0], campos[1], n == 3 ? (int)campos[2] : -1);
+}
+
+void LeitorPerfil_PI2::ponto(float t, float T, int faseLida) {
+  if (!(T >= 0 && T <= 350)) {
+    erroEm("temperatura fora de 0-350 C");
+    return;
+  }
+  if (faseLida > FASE_RESFRIAMENTO || faseLida < -1) {
+    erroEm("fase invalida");
+    return;
+  }
+  lidos++;
+
+  if (!temPonto) {
+    tInicio = t;
+    inicio_dC = lroundf(T * 10);
+    abrir(t, T, faseLida);
+    temPonto = true;
+    return;
+  }
+  if (!(t > tAnt)) {
+    erroEm("tempo nao crescente");
+    return;
+  }
+  if (t - tAnt > 3600) {
+    erroEm("intervalo maior que 3600 s");
+    return;
+  }
+
+  // fase diferente ou segmento longo demais: fecha no ponto anterior
+  bool trocaFase = temSegmento && faseLida != fase;
+  if ((trocaFase || t - t0 > 3600) && temSegmento) {
+    if (!fechar(tAnt, TAnt)) return;
+  }
+  if (!temSegmento) fase = faseLida;
+
+  float lo = (T - tol - T0) / (t - t0);
+  float hi = (T + tol - T0) / (t - t0);
+  float novoMin = temSegmento ? fmaxf(sMin, lo) : lo;
+  float novoMax = temSegmento ? fminf(sMax, hi) : hi;
+  if (novoMin > novoMax) {
+    // o ponto não cabe na reta: o segmento termina no anterior
+    if (!fechar(tAnt, TAnt)) return;
+    fase = faseLida;
+    novoMin = (T - tol - T0) / (t - t0);
+    novoMax = (T + tol - T0) / (t - t0);
+  }
+  sMin = novoMin;
+  sMax = novoMax;
+  tAnt = t;
+  TAnt = T;
+  temSegmento = true;
+}
+
+// Fecha o segmento em t, na reta viável mais perto de T, e abre o
+// próximo a partir daí
+bool LeitorPerfil_PI2::fechar(float t, float T) {
+  if (!temSegmento) return true;
+  float s = constrain((T - T0) / (t - t0), sMin, sMax);
+  float Tfim = T0 + s * (t - t0);
+  uint32_t fim_s = lroundf(t - tInicio);
+  if (fim_s <= fimAnterior_s) fim_s = fimAnterior_s + 1;   // pontos a menos de 1 s
+  if (total == PERFIL_MAX_SEGMENTOS) {
+    erroEm("segmentos demais: aumente a tolerancia");
+    return false;
+  }
+
+  SegmentoPerfil &seg = tabela[total];
+  int16_t de = total ? tabela[total - 1].temperatura_dC : inicio_dC;
+  seg.temperatura_dC = lroundf(Tfim * 10);
+  seg.duracao_s = fim_s - fimAnterior_s;
+  seg.reservado = 0;
+  seg.fase = (fase >= 0) ? fase : (seg.temperatura_dC < de ? FASE_RESFRIAMENTO : FASE_RAMPA);
+  total++;
+  fimAnterior_s = fim_s;
+
+  abrir(t, Tfim, -1);
+  return true;
+}
+
+void LeitorPerfil_PI2::abrir(float t, float T, int faseLida) {
+  t0 = tAnt = t;
+  T0 = TAnt = T;
+  fase = faseLida;
+  temSegmento = false;
+}
+
+const char *LeitorPerfil_PI2::erro(void) {
+  return falha;
+}
+
+uint32_t LeitorPerfil_PI2::registro(void) {
+  return registros;
+}
+
+uint32_t LeitorPerfil_PI2::pontos(void) {
+  return lidos;
+}
+
+uint8_t LeitorPerfil_PI2::quantidade(void) {
+  return total;
+}
+
+const SegmentoPerfil *LeitorPerfil_PI2::segmentos(void) {
+  return tabela;
+}
+
+int16_t LeitorPerfil_PI2::inicial_dC(void) {
+  return inicio_dC;
+}
@@ -0,0 +1,207 @@
+/*  Biblioteca de Perfis de Refusão do Forno
+ *  Perfis como tabelas binárias de segmentos, com set point interpolado
+ *
+ *  perfil_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef PerfilForno
+#define PerfilForno
+
+#include <Arduino.h>
+
+#define PERFIL_MAX_SEGMENTOS 32
+
+// Fase de cada segmento do perfil
+enum FasePerfil {
+  FASE_RAMPA = 0,
+  FASE_PATAMAR = 1,
+  FASE_PICO = 2,
+  FASE_RESFRIAMENTO = 3
+};
+
+// Segmento: o set point vai linearmente da temperatura final do segmento
+// anterior até temperatura_dC em duracao_s segundos (6 bytes)
+struct SegmentoPerfil {
+  uint8_t fase;
+  uint8_t reservado;
+  uint16_t duracao_s;
+  int16_t temperatura_dC;   // décimos de grau
+};
+
+// Janela de processo da pasta: o que a placa precisa ver para a corrida
+// ser aprovada. Temperaturas em décimos de grau, taxas em décimos de C/s
+struct JanelaProcesso {
+  int16_t liquidus_dC;
+  int16_t picoMin_dC, picoMax_dC;
+  uint16_t talMin_s, talMax_s;             // tempo acima do liquidus
+  int16_t patamarMin_dC, patamarMax_dC;    // faixa do patamar, antes do liquidus
+  uint16_t patamarMin_s, patamarMax_s;
+  uint8_t subidaMax_dCs, descidaMax_dCs;
+};
+
+// Perfil guardado em flash (PROGMEM)
+struct PerfilReflow {
+  const char *nome;
+  int16_t inicial_dC;
+  uint8_t quantidade;
+  const SegmentoPerfil *segmentos;
+  JanelaProcesso janela;
+};
+
+extern const PerfilReflow CATALOGO_PERFIS[] PROGMEM;
+extern const uint8_t QUANTIDADE_PERFIS;
+
+class PerfilReflow_PI2 {
+ public:
+  PerfilReflow_PI2();
+  bool selecionar(uint8_t indice);     // copia um perfil do catálogo
+  bool carregar(const SegmentoPerfil *seg, uint8_t n, int16_t inicial_dC,
+                const JanelaProcesso *janela = NULL);   // sem janela: a de JANELA_PADRAO
+  void tolerancia(float celsius);      // retenção do tempo nas fases de aquecimento
+  void iniciar(void);
+
+  // Avança dt_ms (exceto em retenção) e devolve o set point interpolado
+  float atualizar(uint32_t dt_ms, float medida);
+
+  float setPoint(void);
+  float inclinacao(void);              // C/s do set point agora (0 em retenção)
+  float previsao(uint32_t adiante_ms); // set point daqui a adiante_ms (o de agora em retenção)
+  uint8_t segmento(void);
+  uint8_t fase(void);
+  bool terminado(void);
+  uint32_t tempoMs(void);
+  uint32_t duracaoMs(void);
+  uint8_t indice(void);
+  uint8_t quantidade(void);
+  const SegmentoPerfil *segmentos(void);
+  int16_t inicial_dC(void);
+  const JanelaProcesso &janela(void);
+
+ private:
+  SegmentoPerfil tabela[PERFIL_MAX_SEGMENTOS];
+  uint8_t total;
+  uint8_t perfilAtual;
+  int16_t inicio_dC;
+  JanelaProcesso limites;
+  float toleranciaRetencao;
+
+  uint8_t atual;            // segmento em execução
+  uint32_t inicioSegmento;  // ms do início do segmento atual
+  uint32_t tempo;           // ms desde o início do perfil
+  float referencia;
+  bool retido;              // relógio parado na última atualização
+
+  int16_t temperaturaInicial(uint8_t seg);
+  float interpolar(void);
+};
+
+// Análise da corrida em O(1) por amostra, sem guardar a curva: pico,
+// tempo acima do liquidus (TAL), tempo no patamar e as maiores taxas de
+// subida e descida, comparados no fim com a JanelaProcesso do perfil.
+// As taxas são medidas entre pontos a ANALISE_RAMPA_S segundos, como nas
+// especificações de perfil (J-STD-020), e não amostra a amostra: a
+// quantização do termopar viraria degraus de vários C/s.
+#define ANALISE_RAMPA_S 5
+
+// bits de ResumoCorrida::falhas; 0 = aprovada
+#define ANALISE_PICO_BAIXO    0x0001
+#define ANALISE_PICO_ALTO     0x0002
+#define ANALISE_TAL_CURTO     0x0004
+#define ANALISE_TAL_LONGO     0x0008
+#define ANALISE_PATAMAR_CURTO 0x0010
+#define ANALISE_PATAMAR_LONGO 0x0020
+#define ANALISE_SUBIDA        0x0040
+#define ANALISE_DESCIDA       0x0080
+#define ANALISE_INCOMPLETA    0x0100   // abortada ou desarmada antes de esfriar
+
+struct ResumoCorrida {
+  float pico;               // C
+  float tal_s;
+  float patamar_s;
+  float subidaMax;          // C/s
+  float descidaMax;         // C/s, positiva
+  uint32_t duracao_ms;
+  uint16_t falhas;          // bits ANALISE_*, depois de finalizar()
+  bool finalizada;
+};
+
+class AnaliseCorrida_PI2 {
+ public:
+  AnaliseCorrida_PI2();
+  void iniciar(const JanelaProcesso &janela);
+  void adicionar(uint32_t tempo_ms, float temperatura);   // tempo desde o início da corrida
+  void finalizar(bool completa);
+  bool ativa(void);         // iniciada e ainda não finalizada
+  void ler(ResumoCorrida &destino);
+  const JanelaProcesso &janela(void);
+
+ private:
+  JanelaProcesso limites;
+  ResumoCorrida r;
+  float pontos[ANALISE_RAMPA_S + 1];   // um por segundo, circular
+  uint8_t posicao, ocupados;
+  uint32_t ultimoMs, proximoPontoMs;
+  bool iniciada, primeira, liquidusAtingido;
+};
+
+// Leitura de um perfil em pontos "t_s,temperatura[,fase]" (CSV, uma
+// linha por ponto, cabeçalho e # comentários aceitos) ou JSON
+// [[t_s,temperatura],...], em pedaços de qualquer tamanho, na ordem em
+// que chegam: a memória é a tabela de segmentos e o número em leitura,
+// nunca o corpo inteiro. Pontos seguidos que cabem em uma reta, com até
+// `tolerancia` C de erro, viram um segmento só (janela de inclinações
+// viável, O(1) por ponto): uma curva exportada a cada segundo cabe em
+// PERFIL_MAX_SEGMENTOS. A fase de um ponto é a do trecho que termina
+// nele; sem fase, segmento que desce é resfriamento e o resto é rampa, e
+// uma fase explícita diferente sempre abre segmento novo.
+#define LEITOR_TOLERANCIA_C 0.5
+#define LEITOR_NUMERO       16      // caracteres de um número
+
+class LeitorPerfil_PI2 {
+ public:
+  LeitorPerfil_PI2();
+  void iniciar(float tolerancia = LEITOR_TOLERANCIA_C);
+  bool alimentar(const uint8_t *dados, size_t n);   // false: erro, o resto é ignorado
+  bool finalizar(void);                             // fim do corpo: fecha o último segmento
+  const char *erro(void);                           // NULL se tudo certo
+  uint32_t registro(void);                          // ponto (linha) do erro, a partir de 1
+  uint32_t pontos(void);
+  uint8_t quantidade(void);
+  const SegmentoPerfil *segmentos(void);
+  int16_t inicial_dC(void);
+
+ private:
+  SegmentoPerfil tabela[PERFIL_MAX_SEGMENTOS];
+  uint8_t total;
+  float tol;
+  const char *falha;
+  uint32_t lidos, registros;
+
+  // léxico
+  char numero[LEITOR_NUMERO + 1];
+  uint8_t tamanho;
+  float campos[3];
+  uint8_t nCampos;
+  bool json, decidido, comentario, invalido;
+  uint8_t profundidade;
+
+  // segmento em construção: começa em (t0, T0), inclinações viáveis em
+  // [sMin, sMax]; (tAnt, TAnt) é o último ponto aceito nele
+  float t0, T0, tAnt, TAnt, sMin, sMax;
+  float tInicio;            // t do primeiro ponto
+  uint32_t fimAnterior_s;   // fim do último segmento fechado, desde tInicio
+  int16_t inicio_dC;
+  int fase;                 // explícita do segmento, -1 = inferir
+  bool temPonto, temSegmento;
+
+  void caractere(char c);
+  void fimNumero(void);
+  void fimRegistro(void);
+  void ponto(float t, float T, int faseLida);
+  bool fechar(float t, float T);
+  void abrir(float t, float T, int faseLida);
+  void erroEm(const char *mensagem);
+};
+
+#endif
@@ -0,0 +1,431 @@
+/*  Biblioteca de Registro das corridas do Forno
+ *
+ *  registro_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "registro_PI2.h"
+
+RegistroCorrida_PI2::RegistroCorrida_PI2() {
+  _fs = NULL;
+  _corrida = 0;
+  _pronta[0] = _pronta[1] = false;
+  _ativa = 0;
+  _posicao = 0;
+  _aberto = false;
+  _descartados = 0;
+}
+
+// fs já montado (LittleFS.begin()); acha o número da última corrida
+bool RegistroCorrida_PI2::iniciar(fs::FS &fs) {
+  _fs = &fs;
+  if (!_fs->exists(REGISTRO_PASTA) && !_fs->mkdir(REGISTRO_PASTA)) return false;
+
+  fs::Dir dir = _fs->openDir(REGISTRO_PASTA);
+  while (dir.next()) {
+    uint16_t n = (uint16_t)strtoul(dir.fileName().c_str(), NULL, 10);
+    if (n > _corrida) _corrida = n;
+  }
+  return true;
+}
+
+String RegistroCorrida_PI2::caminho(uint16_t corrida) {
+  char nome[32];
+  snprintf(nome, sizeof(nome), REGISTRO_PASTA "/%05u.bin", corrida);
+  return String(nome);
+}
+
+// Chamar do loop(), com a tarefa de controle ainda sem registrar
+bool RegistroCorrida_PI2::abrir(uint8_t perfil, uint16_t periodo_ms, uint64_t inicio_utc_us) {
+  if (_fs == NULL) return false;
+  if (_aberto) fechar();
+
+  _corrida++;
+  apagarAntigas();
+  _arquivo = _fs->open(caminho(_corrida), "w");
+  if (!_arquivo) return false;
+
+  RegistroCabecalho c;
+  memset(&c, 0, sizeof(c));
+  c.magico = REGISTRO_MAGICO;
+  c.versao = REGISTRO_VERSAO;
+  c.tamanho_registro = sizeof(RegistroAmostra);
+  c.periodo_ms = periodo_ms;
+  c.perfil = perfil;
+  c.inicio_s = (uint32_t)(inicio_utc_us / 1000000);
+  c.inicio_ms = (uint16_t)(inicio_utc_us / 1000 % 1000);
+  _arquivo.write((const uint8_t *)&c, sizeof(c));
+
+  _pronta[0] = _pronta[1] = false;
+  _ativa = 0;
+  _posicao = 0;
+  _descartados = 0;
+  __sync_synchronize();
+  _aberto = true;
+  return true;
+}
+
+// Chamada apenas pela tarefa de controle (único produtor)
+void RegistroCorrida_PI2::registrar(uint16_t tempo_ds, float temperatura, float set_point,
+                                    int potencia, uint8_t estado) {
+  if (!_aberto) return;
+  uint8_t p = _ativa;
+  if (_pronta[p]) {           // o loop() ainda não gravou esta página
+    _descartados = _descartados + 1;
+    return;
+  }
+
+  RegistroAmostra &r = _paginas[p][_posicao];
+  r.tempo_ds = tempo_ds;
+  r.temperatura_dC = (int16_t)lroundf(temperatura * 10.0f);
+  r.set_point_dC = (int16_t)lroundf(set_point * 10.0f);
+  r.potencia = (uint8_t)(potencia < 0 ? 0 : (potencia > 100 ? 100 : potencia));
+  r.estado = estado;
+
+  if (++_posicao == REGISTROS_POR_PAGINA) {
+    __sync_synchronize();
+    _pronta[p] = true;        // entregue ao loop()
+    _posicao = 0;
+    _ativa = p ^ 1;
+  }
+}
+
+// Chamar do loop(): grava as páginas cheias, a mais antiga primeiro
+void RegistroCorrida_PI2::atender(void) {
+  if (!_aberto) return;
+  uint8_t p = _ativa;         // com as duas cheias, a ativa é a mais antiga
+  for (uint8_t i = 0; i < 2; i++, p ^= 1) {
+    if (!_pronta[p]) continue;
+    gravar(p, REGISTROS_POR_PAGINA);
+    __sync_synchronize();
+    _pronta[p] = false;
+  }
+}
+
+// Grava o que estiver pendente, inclusive a página incompleta, e o
+// resumo, se houver, e fecha
+void RegistroCorrida_PI2::fechar(const RegistroResumo *resumo) {
+  if (!_aberto) return;
+  _aberto = false;            // o produtor para de escrever a partir daqui
+  __sync_synchronize();
+  for (uint8_t i = 0, p = _ativa; i < 2; i++, p ^= 1) {
+    if (_pronta[p]) {
+      gravar(p, REGISTROS_POR_PAGINA);
+      _pronta[p] = false;
+    }
+  }
+  if (_posicao > 0) gravar(_ativa, _posicao);
+  _posicao = 0;
+  if (resumo) {
+    RegistroResumo r = *resumo;
+    r.magico = REGISTRO_RESUMO_MAGICO;
+    _arquivo.write((const uint8_t *)&r, sizeof(r));
+  }
+  _arquivo.close();
+}
+
+bool RegistroCorrida_PI2::resumo(uint16_t corrida, RegistroResumo &destino) {
+  if (_fs == NULL) return false;
+  fs::File f = _fs->open(caminho(corrida), "r");
+  if (!f) return false;
+  bool ok = f.size() >= sizeof(RegistroCabecalho) + sizeof(destino)
+            && f.seek(f.size() - sizeof(destino), fs::SeekSet)
+            && f.read((uint8_t *)&destino, sizeof(destino)) == sizeof(destino)
+            && destino.magico == REGISTRO_RESUMO_MAGICO;
+  f.close();
+  return ok;
+}
+
+bool RegistroCorrida_PI2::aberto(void) {
+  return _aberto;
+}
+
+uint16_t RegistroCorrida_PI2::corrida(void) {
+  return _corrida;
+}
+
+uint32_t RegistroCorrida_PI2::descartados(void) {
+  return _descartados;
+}
+
+// Uma página inteira por write/flush: a LittleFS regrava os blocos
+// uma vez a cada 32 registros, e não a cada amostra
+void RegistroCorrida_PI2::gravar(uint8_t pagina, size_t n) {
+  _arquivo.write((const uint8_t *)_paginas[pagina], n * sizeof(RegistroAmostra));
+  _arquivo.flush();
+}
+
+// Mantém só as REGISTRO_MAX_CORRIDAS mais recentes, contando a nova.
+// Cada abrir() cria uma corrida, então basta apagar a que saiu da janela.
+void RegistroCorrida_PI2::apagarAntigas(void) {
+  if (_corrida <= REGISTRO_MAX_CORRIDAS) return;
+  String antiga = caminho(_corrida - REGISTRO_MAX_CORRIDAS);
+  if (_fs->exists(antiga)) _fs->remove(antiga);
+}
+
+FilaLotes_PI2::FilaLotes_PI2() {
+  _fs = NULL;
+  _pasta = FILA_PASTA;
+  _primeiro = _ultimo = 0;
+  _cursor = 0;
+  _numero = 1;
+  _descartados = 0;
+}
+
+String FilaLotes_PI2::caminho(uint16_t segmento) {
+  char nome[32];
+  snprintf(nome, sizeof(nome), "%s/%05u.lot", _pasta, segmento);
+  return String(nome);
+}
+
+// fs já montado; retoma a fila e a numeração de antes do boot. Cada
+// fila do sketch tem a sua pasta
+bool FilaLotes_PI2::iniciar(fs::FS &fs, const char *pasta) {
+  _fs = &fs;
+  _pasta = pasta;
+  if (!_fs->exists(_pasta) && !_fs->mkdir(_pasta)) return false;
+
+  fs::Dir dir = _fs->openDir(_pasta);
+  while (dir.next()) {
+    uint16_t n = (uint16_t)strtoul(dir.fileName().c_str(), NULL, 10);
+    if (n == 0) continue;
+    if (_primeiro == 0 || n < _primeiro) _primeiro = n;
+    if (n > _ultimo) _ultimo = n;
+  }
+
+  // o número segue o do último lote gravado, ou o guardado quando a
+  // fila esvaziou
+  fs::File f = _fs->open(String(_pasta) + "/numero", "r");
+  if (f) {
+    f.read((uint8_t *)&_numero, sizeof(_numero));
+    f.close();
+  }
+  if (_ultimo) {
+    f = _fs->open(caminho(_ultimo), "r");
+    uint8_t cab[FILA_CABECALHO];
+    while (f && f.read(cab, sizeof(cab)) == sizeof(cab)) {
+      uint32_t numero;
+      memcpy(&numero, cab + 2, sizeof(numero));
+      if (numero >= _numero) _numero = numero + 1;
+      f.seek(cab[0] | (cab[1] << 8), fs::SeekCur);
+    }
+    if (f) f.close();
+  }
+  return true;
+}
+
+// Grava já, sem buffer: chamar do loop(), um lote de cada vez
+bool FilaLotes_PI2::acrescentar(const uint8_t *lote, size_t tamanho) {
+  if (_fs == NULL || tamanho > 0xFFFF) return false;
+
+  if (_ultimo == 0) {
+    _primeiro = _ultimo = 1;
+    _cursor = 0;
+  }
+  fs::File f = _fs->open(caminho(_ultimo), "a");
+  if (f && f.size() > 0 && f.size() + FILA_CABECALHO + tamanho > FILA_SEGMENTO) {
+    f.close();
+    _ultimo++;
+    if (_ultimo - _primeiro + 1 > FILA_MAX_SEGMENTOS) apagarPrimeiro();
+    f = _fs->open(caminho(_ultimo), "a");
+  }
+  if (!f) return false;
+
+  uint8_t cab[FILA_CABECALHO] = { (uint8_t)tamanho, (uint8_t)(tamanho >> 8) };
+  memcpy(cab + 2, &_numero, sizeof(_numero));
+  bool ok = f.write(cab, sizeof(cab)) == sizeof(cab) && f.write(lote, tamanho) == tamanho;
+  f.close();
+  if (ok) _numero++;
+  return ok;
+}
+
+// Copia para destino os lotes a partir do mais antigo não confirmado,
+// inteiros e com o cabeçalho, até maximo bytes, sem passar de um
+// segmento para o outro; ultimo recebe o número do último copiado
+size_t FilaLotes_PI2::ler(uint8_t *destino, size_t maximo, uint32_t &ultimo) {
+  if (_ultimo == 0) return 0;
+
+  fs::File f = _fs->open(caminho(_primeiro), "r");
+  if (!f) {
+    apagarPrimeiro();       // sumiu: segue com o próximo
+    return 0;
+  }
+  f.seek(_cursor, fs::SeekSet);
+
+  size_t n = 0;
+  uint8_t cab[FILA_CABECALHO];
+  while (f.read(cab, sizeof(cab)) == sizeof(cab)) {
+    size_t tamanho = cab[0] | (cab[1] << 8);
+    if (n + sizeof(cab) + tamanho > maximo) {
+      if (n == 0) {         // não cabe nem sozinho: nunca vai sair
+        _descartados++;
+        f.close();
+        confirmar(sizeof(cab) + tamanho);
+        return 0;
+      }
+      break;
+    }
+    memcpy(destino + n, cab, sizeof(cab));
+    if (f.read(destino + n + sizeof(cab), tamanho) != tamanho) break;   // lote cortado
+    memcpy(&ultimo, cab + 2, sizeof(ultimo));
+    n += sizeof(cab) + tamanho;
+  }
+  bool fim = n == 0 && f.position() >= f.size();
+  f.close();
+  if (fim && _primeiro < _ultimo) confirmar(0);   // só restos de um lote cortado
+  return n;
+}
+
+// Os n bytes devolvidos por ler() chegaram: saem da fila
+void FilaLotes_PI2::confirmar(size_t bytes) {
+  if (_ultimo == 0) return;
+  _cursor += bytes;
+
+  fs::File f = _fs->open(caminho(_primeiro), "r");
+  size_t tamanho = f ? f.size() : 0;
+  if (f) f.close();
+  if (_cursor < tamanho) return;
+
+  if (_primeiro == _ultimo) {
+    // fila vazia: a numeração fica guardada para o próximo boot
+    _fs->remove(caminho(_primeiro));
+    _primeiro = _ultimo = 0;
+    _cursor = 0;
+    f = _fs->open(String(_pasta) + "/numero", "w");
+    if (f) {
+      f.write((const uint8_t *)&_numero, sizeof(_numero));
+      f.close();
+    }
+    return;
+  }
+  _fs->remove(caminho(_primeiro));
+  _primeiro++;
+  _cursor = 0;
+}
+
+void FilaLotes_PI2::apagarPrimeiro(void) {
+  fs::File f = _fs->open(caminho(_primeiro), "r");
+  if (f) {
+    // conta os lotes que não chegaram ao destino
+    uint8_t cab[FILA_CABECALHO];
+    f.seek(_cursor, fs::SeekSet);
+    while (f.read(cab, sizeof(cab)) == sizeof(cab)) {
+      _descartados++;
+      f.seek(cab[0] | (cab[1] << 8), fs::SeekCur);
+    }
+    f.close();
+  }
+  _fs->remove(caminho(_primeiro));
+  if (_primeiro == _ultimo) {
+    _primeiro = _ultimo = 0;
+  } else {
+    _primeiro++;
+  }
+  _cursor = 0;
+}
+
+bool FilaLotes_PI2::vazia(void) {
+  return _ultimo == 0;
+}
+
+uint16_t FilaLotes_PI2::segmentos(void) {
+  return _ultimo ? _ultimo - _primeiro + 1 : 0;
+}
+
+uint32_t FilaLotes_PI2::descartados(void) {
+  return _descartados;
+}
+
+// CRC-32 (IEEE 802.3, o do zip) bit a bit: a configuração tem menos de
+// 1 kB e é conferida só no boot, não vale a tabela de 1 kB na RAM.
+// Em partes: crc32_PI2(b, nb, crc32_PI2(a, na)) == crc32_PI2(a + b)
+uint32_t crc32_PI2(const void *dados, size_t n, uint32_t crc) {
+  const uint8_t *p = (const uint8_t *)dados;
+  crc = ~crc;
+  while (n--) {
+    crc ^= *p++;
+    for (uint8_t i = 0; i < 8; i++) crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+  }
+  return ~crc;
+}
+
+CopiaDupla_PI2::CopiaDupla_PI2(const char *caminhoA, const char *caminhoB) {
+  _caminho[0] = caminhoA;
+  _caminho[1] = caminhoB;
+  _sequencia = 0;
+  _atual = -1;
+}
+
+// Lê a cópia inteira calculando o CRC, sem buffer além do do arquivo
+bool CopiaDupla_PI2::conferir(fs::FS &fs, uint8_t copia, uint16_t tamanho, uint32_t &sequencia) {
+  fs::File f = fs.open(_caminho[copia], "r");
+  if (!f) return false;
+  DuplaCabecalho cab;
+  bool ok = f.read((uint8_t *)&cab, sizeof(cab)) == sizeof(cab) && cab.magico == DUPLA_MAGICO
+            && cab.tamanho == tamanho && f.size() == sizeof(cab) + tamanho;
+  uint32_t crc = crc32_PI2(&cab, offsetof(DuplaCabecalho, crc));
+  uint8_t bloco[64];
+  while (ok && f.available()) {
+    size_t n = f.read(bloco, sizeof(bloco));
+    if (n == 0) ok = false;
+    crc = crc32_PI2(bloco, n, crc);
+  }
+  f.close();
+  if (!ok || crc != cab.crc) return false;
+  sequencia = cab.sequencia;
+  return true;
+}
+
+// A estrutura vem da cópia válida de maior sequência (a comparação
+// aguenta a volta do contador)
+bool CopiaDupla_PI2::ler(fs::FS &fs, void *destino, uint16_t tamanho) {
+  uint32_t seq[2];
+  bool valida[2];
+  for (uint8_t i = 0; i < 2; i++) valida[i] = conferir(fs, i, tamanho, seq[i]);
+  _atual = -1;
+  if (valida[0] && valida[1]) _atual = (int32_t)(seq[1] - seq[0]) > 0 ? 1 : 0;
+  else if (valida[0]) _atual = 0;
+  else if (valida[1]) _atual = 1;
+  if (_atual < 0) return false;
+
+  fs::File f = fs.open(_caminho[_atual], "r");
+  bool ok = f && f.seek(sizeof(DuplaCabecalho), fs::SeekSet)
+            && f.read((uint8_t *)destino, tamanho) == tamanho;
+  if (f) f.close();
+  if (!ok) {
+    _atual = -1;
+    return false;
+  }
+  _sequencia = seq[_atual];
+  return true;
+}
+
+// Sobre a outra cópia, com a sequência seguinte; só passa a ser a atual
+// depois de escrita e fechada
+bool CopiaDupla_PI2::gravar(fs::FS &fs, const void *origem, uint16_t tamanho) {
+  uint8_t alvo = _atual == 0 ? 1 : 0;
+  DuplaCabecalho cab;
+  cab.magico = DUPLA_MAGICO;
+  cab.sequencia = _sequencia + 1;
+  cab.tamanho = tamanho;
+  cab.reservado = 0;
+  cab.crc = crc32_PI2(origem, tamanho, crc32_PI2(&cab, offsetof(DuplaCabecalho, crc)));
+
+  fs::File f = fs.open(_caminho[alvo], "w");
+  if (!f) return false;
+  bool ok = f.write((const uint8_t *)&cab, sizeof(cab)) == sizeof(cab)
+            && f.write((const uint8_t *)origem, tamanho) == tamanho;
+  f.close();
+  if (!ok) return false;
+  _atual = alvo;
+  _sequencia = cab.sequencia;
+  return true;
+}
+
+uint32_t CopiaDupla_PI2::sequencia(void) {
+  return _sequencia;
+}
+
+char CopiaDupla_PI2::atual(void) {
+  return _atual < 0 ? 0 : 'A' + _atual;
+}
@@ -0,0 +1,164 @@
+/*  Biblioteca de Registro das corridas do Forno
+ *  Grava cada corrida em um arquivo binário só de acréscimo na LittleFS,
+ *  com registros de largura fixa, uma página de flash por escrita.
+ *
+ *  registro_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef RegistroForno
+#define RegistroForno
+
+#include <Arduino.h>
+#include <FS.h>
+
+#define REGISTRO_PASTA        "/corridas"
+#define REGISTRO_MAX_CORRIDAS 8     // as mais antigas são apagadas
+#define REGISTRO_PAGINA       256   // bytes por escrita na flash
+#define REGISTRO_MAGICO       0x52324950UL   // "PI2R"
+#define REGISTRO_VERSAO       3     // 2: hora UTC do início no cabeçalho; 3: RegistroResumo no fim
+#define REGISTRO_RESUMO_MAGICO 0x53324950UL  // "PI2S"
+
+// bits de RegistroAmostra::estado
+#define REGISTRO_SEGMENTO     0x1F  // segmento do perfil
+#define REGISTRO_FALHA_SENSOR 0x80
+
+struct RegistroAmostra {
+  uint16_t tempo_ds;        // décimos de segundo desde o início da corrida
+  int16_t temperatura_dC;   // décimos de grau
+  int16_t set_point_dC;
+  uint8_t potencia;         // 0-100
+  uint8_t estado;
+} __attribute__((packed));
+
+// Cabeçalho no início de cada arquivo, lido pelas ferramentas de análise
+struct RegistroCabecalho {
+  uint32_t magico;
+  uint8_t versao;
+  uint8_t tamanho_registro;
+  uint16_t periodo_ms;      // intervalo entre registros
+  uint8_t perfil;           // índice no catálogo
+  uint32_t inicio_s;        // hora UTC do início (s desde 1970), 0 = desconhecida
+  uint16_t inicio_ms;
+  uint8_t reservado[1];
+} __attribute__((packed));
+
+// Resumo da corrida, gravado depois do último registro quando a corrida
+// fecha. O mágico fica nos 4 bytes finais do arquivo: quem lê confere o
+// fim antes de tratar os 16 bytes como resumo, e não como 2 registros
+struct RegistroResumo {
+  int16_t pico_dC;
+  uint16_t tal_ds;          // décimos de segundo acima do liquidus
+  uint16_t patamar_ds;
+  uint8_t subida_dCs;       // décimos de C/s, saturados em 255
+  uint8_t descida_dCs;
+  uint16_t falhas;          // bits ANALISE_* de perfil_PI2.h, 0 = aprovada
+  uint8_t reservado[2];
+  uint32_t magico;
+} __attribute__((packed));
+
+#define REGISTROS_POR_PAGINA (REGISTRO_PAGINA / sizeof(RegistroAmostra))
+
+// Produtor (tarefa de controle) enche uma página em RAM enquanto o
+// loop() grava a anterior; registrar() nunca espera pela flash. Se as
+// duas páginas estiverem cheias o registro é descartado e contado.
+class RegistroCorrida_PI2 {
+ public:
+  RegistroCorrida_PI2();
+  bool iniciar(fs::FS &fs);
+  bool abrir(uint8_t perfil, uint16_t periodo_ms, uint64_t inicio_utc_us = 0);
+  void registrar(uint16_t tempo_ds, float temperatura, float set_point,
+                 int potencia, uint8_t estado);
+  void atender(void);
+  void fechar(const RegistroResumo *resumo = NULL);
+  bool aberto(void);
+  bool resumo(uint16_t corrida, RegistroResumo &destino);   // false: sem resumo gravado
+  uint16_t corrida(void);
+  uint32_t descartados(void);
+  String caminho(uint16_t corrida);
+
+ private:
+  void gravar(uint8_t pagina, size_t n);
+  void apagarAntigas(void);
+
+  fs::FS *_fs;
+  fs::File _arquivo;
+  uint16_t _corrida;
+  RegistroAmostra _paginas[2][REGISTROS_POR_PAGINA];
+  volatile bool _pronta[2];
+  volatile uint8_t _ativa;
+  volatile uint8_t _posicao;
+  volatile bool _aberto;
+  volatile uint32_t _descartados;
+};
+
+// Fila de lotes para enviar depois (store-and-forward): cada lote é
+// gravado na hora em segmentos só de acréscimo, e sai da flash quando o
+// destino confirma. Registro: [tamanho u16][número u32][lote], little
+// endian; o número só cresce, também entre boots, para o destino
+// descartar o que receber repetido.
+#define FILA_PASTA          "/fila"
+#define FILA_SEGMENTO       16384   // bytes por arquivo antes de abrir o próximo
+#define FILA_MAX_SEGMENTOS  16      // cheia, o segmento mais antigo é apagado
+#define FILA_CABECALHO      6
+
+// Sem RAM para os lotes: o que não foi confirmado antes de um reset é
+// lido de novo desde o início do segmento mais antigo.
+class FilaLotes_PI2 {
+ public:
+  FilaLotes_PI2();
+  bool iniciar(fs::FS &fs, const char *pasta = FILA_PASTA);
+  bool acrescentar(const uint8_t *lote, size_t tamanho);
+  size_t ler(uint8_t *destino, size_t maximo, uint32_t &ultimo);
+  void confirmar(size_t bytes);
+  bool vazia(void);
+  uint16_t segmentos(void);
+  uint32_t descartados(void);
+
+ private:
+  String caminho(uint16_t segmento);
+  void apagarPrimeiro(void);
+
+  fs::FS *_fs;
+  const char *_pasta;
+  uint16_t _primeiro;       // segmentos _primeiro.._ultimo; 0 = fila vazia
+  uint16_t _ultimo;
+  uint32_t _cursor;         // bytes já confirmados do _primeiro
+  uint32_t _numero;         // do próximo lote
+  uint32_t _descartados;    // lotes perdidos: fila cheia ou maiores que ler()
+};
+
+// Estrutura binária guardada em duas cópias (A/B), cada uma com número de
+// sequência e CRC32. gravar() escreve sempre sobre a cópia mais velha:
+// uma queda de energia no meio estraga só ela, e a outra continua valendo.
+// ler() confere as duas numa passada e fica com a válida mais nova; sem
+// texto para interpretar, o boot é uma cópia de memória conferida.
+#define DUPLA_MAGICO 0x44324950UL   // "PI2D"
+
+struct DuplaCabecalho {
+  uint32_t magico;
+  uint32_t sequencia;       // a maior válida é a atual
+  uint16_t tamanho;         // bytes da estrutura depois do cabeçalho
+  uint16_t reservado;
+  uint32_t crc;             // CRC32 do cabeçalho até aqui e da estrutura
+} __attribute__((packed));
+
+class CopiaDupla_PI2 {
+ public:
+  CopiaDupla_PI2(const char *caminhoA, const char *caminhoB);
+  bool ler(fs::FS &fs, void *destino, uint16_t tamanho);          // false: nenhuma cópia válida
+  bool gravar(fs::FS &fs, const void *origem, uint16_t tamanho);
+  uint32_t sequencia(void);  // da cópia atual; 0 = nenhuma
+  char atual(void);          // 'A', 'B' ou 0
+
+ private:
+  bool conferir(fs::FS &fs, uint8_t copia, uint16_t tamanho, uint32_t &sequencia);
+
+  const char *_caminho[2];
+  uint32_t _sequencia;
+  int8_t _atual;            // -1 = nenhuma
+};
+
+uint32_t crc32_PI2(const void *dados, size_t n, uint32_t crc = 0);
+
+#endif
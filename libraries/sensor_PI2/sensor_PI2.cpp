@@ -7,13 +7,70 @@
 
 #include <stdlib.h>
 #include <Arduino.h>
+#include <SPI.h>
 #include "sensor_PI2.h"
 
+// Pausa de ~100 ns a 80 MHz: tempo de saída do dado (tDO) do MAX6675
+#define ESPERA_MAX6675() __asm__ __volatile__("nop; nop; nop; nop; nop; nop; nop; nop")
+
+// Máscara do pino nos registradores GPIO do ESP8266 (GPIO16 fica no RTC)
+static uint32_t mascaraGPIO(int8_t pino) {
+  return (pino >= 0 && pino < 16) ? (1UL << pino) : 0;
+}
+
+Termopar_PI2::Termopar_PI2() {
+  falhasLidas = 0;
+  juncaoLida = NAN;
+  inicioConversao = millis();
+  instante = 0;
+  amostras = 0;
+  ultima = NAN;
+}
+
+double Termopar_PI2::juncaoFria(void) {
+  return juncaoLida;
+}
+
+bool Termopar_PI2::atualizar(void) {
+  uint32_t agora = millis();
+
+  if ((uint32_t)(agora - inicioConversao) < conversaoMs()) {
+    return false;
+  }
+
+  ultima = lerCelsius();
+  instante = agora;
+  inicioConversao = millis();
+  amostras++;
+  return true;
+}
+
+double Termopar_PI2::ultimaCelsius(void) {
+  return ultima;
+}
+
+uint8_t Termopar_PI2::falhas(void) {
+  return falhasLidas;
+}
+
+uint32_t Termopar_PI2::instanteAmostra(void) {
+  return instante;
+}
+
+uint32_t Termopar_PI2::contadorAmostras(void) {
+  return amostras;
+}
+
 // Criação do objeto MAX
 MAX6675_PI2::MAX6675_PI2(int8_t SCLK, int8_t CS, int8_t MISO) {
   sclk = SCLK;
   cs = CS;
   miso = MISO;
+  spiHardware = false;
+
+  mascaraSclk = mascaraGPIO(sclk);
+  mascaraCs = mascaraGPIO(cs);
+  mascaraMiso = mascaraGPIO(miso);
 
   //define pin modes
   pinMode(cs, OUTPUT);
@@ -23,23 +80,28 @@ MAX6675_PI2::MAX6675_PI2(int8_t SCLK, int8_t CS, int8_t MISO) {
   digitalWrite(cs, HIGH);
 }
 
-// Função Celsius
-double MAX6675_PI2::lerCelsius(void) {
-
-  uint16_t pre_temp;
+MAX6675_PI2::MAX6675_PI2(int8_t CS) {
+  sclk = -1;
+  cs = CS;
+  miso = -1;
+  spiHardware = true;
+  mascaraSclk = mascaraCs = mascaraMiso = 0;
 
-  digitalWrite(cs, LOW);
-  //delay(1);
+  pinMode(cs, OUTPUT);
+  digitalWrite(cs, HIGH);
+  SPI.begin();
+}
 
-  pre_temp = leituraSPI();
-  pre_temp <<= 8;
-  pre_temp |= leituraSPI();
+// Função Celsius
+double MAX6675_PI2::lerCelsius(void) {
 
-  digitalWrite(cs, HIGH);
+  uint16_t pre_temp = lerQuadro();
 
   if (pre_temp & 0x4) {
+    falhasLidas = TERMOPAR_ABERTO;
     return NAN; 
   }
+  falhasLidas = 0;
 
   pre_temp >>= 3;
 
@@ -48,6 +110,69 @@ double MAX6675_PI2::lerCelsius(void) {
   return temp_celsius;
 }
 
+uint16_t MAX6675_PI2::conversaoMs(void) {
+  return MAX6675_CONVERSAO_MS;
+}
+
+// Lê os 16 bits do conversor com o CS baixo durante todo o quadro
+uint16_t MAX6675_PI2::lerQuadro(void) {
+  uint16_t quadro;
+
+  if (spiHardware) {
+    SPI.beginTransaction(SPISettings(MAX6675_SPI_HZ, MSBFIRST, SPI_MODE0));
+    digitalWrite(cs, LOW);
+    quadro = SPI.transfer16(0);
+    digitalWrite(cs, HIGH);
+    SPI.endTransaction();
+    return quadro;
+  }
+
+#if defined(ESP8266)
+  if (mascaraSclk && mascaraCs) {
+    return leituraRegistradores();
+  }
+#endif
+
+  digitalWrite(cs, LOW);
+  quadro = leituraSPI();
+  quadro <<= 8;
+  quadro |= leituraSPI();
+  digitalWrite(cs, HIGH);
+
+  return quadro;
+}
+
+// Bit-bang direto nos registradores: poucos microssegundos para o quadro
+static uint32_t quadroRegistradores(uint32_t mascaraSclk, uint32_t mascaraCs, uint32_t mascaraMiso,
+                                    uint8_t bits = 16) {
+  uint32_t quadro = 0;
+#if defined(ESP8266)
+  GPOC = mascaraCs;
+  ESPERA_MAX6675();
+  for (int i = bits - 1; i >= 0; i--) {
+    GPOC = mascaraSclk;
+    ESPERA_MAX6675();
+    bool bit = mascaraMiso ? (GPI & mascaraMiso) : (GP16I & 0x01);
+    if (bit) {
+      quadro |= (1UL << i);
+    }
+    GPOS = mascaraSclk;
+    ESPERA_MAX6675();
+  }
+  GPOS = mascaraCs;
+#else
+  (void)mascaraSclk;
+  (void)mascaraCs;
+  (void)mascaraMiso;
+  (void)bits;
+#endif
+  return quadro;
+}
+
+uint16_t MAX6675_PI2::leituraRegistradores(void) {
+  return quadroRegistradores(mascaraSclk, mascaraCs, mascaraMiso);
+}
+
 // Função SPI
 byte MAX6675_PI2::leituraSPI(void) { 
   int i;
@@ -67,3 +192,615 @@ byte MAX6675_PI2::leituraSPI(void) {
 
   return registrador;
 }
+
+FiltroTemperatura_PI2::FiltroTemperatura_PI2(uint8_t n, uint8_t deslocamentoIIR) {
+  if (n < 1) n = 1;
+  if (n > FILTRO_MAX_N) n = FILTRO_MAX_N;
+  tamanho = n;
+  k = deslocamentoIIR;
+  reiniciar();
+}
+
+void FiltroTemperatura_PI2::reiniciar(void) {
+  posicao = 0;
+  ocupados = 0;
+  estado = 0;
+  iniciado = false;
+  falhasSeguidas = 0;
+  emFalha = false;
+}
+
+void FiltroTemperatura_PI2::adicionar(double celsius) {
+  if (isnan(celsius)) {
+    if (falhasSeguidas < 255) falhasSeguidas++;
+    if (falhasSeguidas >= FILTRO_FALHAS_LIMITE && !emFalha) {
+      // descarta o histórico: ao voltar, o filtro recomeça do zero
+      reiniciar();
+      emFalha = true;
+    }
+    return;
+  }
+
+  falhasSeguidas = 0;
+  janela[posicao] = (int16_t)lround(celsius * FILTRO_ESCALA);
+  posicao = (posicao + 1) % tamanho;
+  if (ocupados < tamanho) ocupados++;
+
+  // só sai da falha com a janela da mediana cheia de leituras válidas
+  if (emFalha && ocupados < tamanho) return;
+  emFalha = false;
+
+  int32_t entrada = (int32_t)mediana() << 8;
+  if (!iniciado) {
+    estado = entrada;
+    iniciado = true;
+  }
+  else {
+    estado += (entrada - estado) >> k;
+  }
+}
+
+bool FiltroTemperatura_PI2::falha(void) {
+  return emFalha;
+}
+
+bool FiltroTemperatura_PI2::valido(void) {
+  return iniciado && !emFalha;
+}
+
+float FiltroTemperatura_PI2::celsius(void) {
+  if (!valido()) return NAN;
+  return estado / (FILTRO_ESCALA * 256.0);
+}
+
+// Ordenação por inserção de uma cópia: N é pequeno
+int16_t FiltroTemperatura_PI2::mediana(void) {
+  int16_t ordenado[FILTRO_MAX_N];
+
+  for (uint8_t i = 0; i < ocupados; i++) {
+    int16_t v = janela[i];
+    int8_t j = i - 1;
+    while (j >= 0 && ordenado[j] > v) {
+      ordenado[j + 1] = ordenado[j];
+      j--;
+    }
+    ordenado[j + 1] = v;
+  }
+  return ordenado[ocupados / 2];
+}
+
+MAX6675Bus::MAX6675Bus(int8_t SCLK, int8_t MISO, const int8_t *cs, uint8_t canais) {
+  sclk = SCLK;
+  miso = MISO;
+  quantidade = (canais > BARRAMENTO_MAX_CANAIS) ? BARRAMENTO_MAX_CANAIS : canais;
+  mascaraSclk = mascaraGPIO(sclk);
+  mascaraMiso = mascaraGPIO(miso);
+
+  pinMode(sclk, OUTPUT);
+  pinMode(miso, INPUT);
+  for (uint8_t c = 0; c < quantidade; c++) {
+    this->cs[c] = cs[c];
+    mascaraCs[c] = mascaraGPIO(cs[c]);
+    pinMode(cs[c], OUTPUT);
+    digitalWrite(cs[c], HIGH);
+  }
+
+  memset(&dados, 0, sizeof(dados));
+  dados.falhas = (quantidade >= 8) ? 0xFF : (uint8_t)((1 << quantidade) - 1);  // nada lido ainda
+  inicioConversao = millis();
+  varreduras = 0;
+}
+
+uint16_t MAX6675Bus::lerQuadro(uint8_t canal) {
+#if defined(ESP8266)
+  if (mascaraSclk && mascaraCs[canal]) {
+    return quadroRegistradores(mascaraSclk, mascaraCs[canal], mascaraMiso);
+  }
+#endif
+  uint16_t quadro = 0;
+  digitalWrite(cs[canal], LOW);
+  for (int i = 15; i >= 0; i--) {
+    digitalWrite(sclk, LOW);
+    delayMicroseconds(1);
+    if (digitalRead(miso)) quadro |= (1 << i);
+    digitalWrite(sclk, HIGH);
+    delayMicroseconds(1);
+  }
+  digitalWrite(cs[canal], HIGH);
+  return quadro;
+}
+
+void MAX6675Bus::varrer(VarreduraMAX6675 &v) {
+  v.falhas = 0;
+  for (uint8_t c = 0; c < quantidade; c++) {
+    uint16_t quadro = lerQuadro(c);
+    if (quadro & 0x4) {
+      v.falhas |= (1 << c);
+      v.quartos[c] = 0;
+    }
+    else {
+      v.quartos[c] = quadro >> 3;
+    }
+  }
+  v.instante = millis();
+}
+
+bool MAX6675Bus::atualizar(void) {
+  if ((uint32_t)(millis() - inicioConversao) < MAX6675_CONVERSAO_MS) {
+    return false;
+  }
+  varrer(dados);
+  inicioConversao = millis();
+  varreduras++;
+  return true;
+}
+
+const VarreduraMAX6675 &MAX6675Bus::ultima(void) {
+  return dados;
+}
+
+double MAX6675Bus::celsius(uint8_t canal) {
+  if (canal >= quantidade || falha(canal)) return NAN;
+  return dados.quartos[canal] * 0.25;
+}
+
+bool MAX6675Bus::falha(uint8_t canal) {
+  return canal >= quantidade || (dados.falhas & (1 << canal));
+}
+
+uint8_t MAX6675Bus::canais(void) {
+  return quantidade;
+}
+
+uint32_t MAX6675Bus::contadorVarreduras(void) {
+  return varreduras;
+}
+
+MAX31855_PI2::MAX31855_PI2(int8_t SCLK, int8_t CS, int8_t MISO) {
+  sclk = SCLK;
+  cs = CS;
+  miso = MISO;
+  spiHardware = false;
+  mascaraSclk = mascaraGPIO(sclk);
+  mascaraCs = mascaraGPIO(cs);
+  mascaraMiso = mascaraGPIO(miso);
+
+  pinMode(cs, OUTPUT);
+  pinMode(sclk, OUTPUT);
+  pinMode(miso, INPUT);
+  digitalWrite(cs, HIGH);
+}
+
+MAX31855_PI2::MAX31855_PI2(int8_t CS) {
+  sclk = miso = -1;
+  cs = CS;
+  spiHardware = true;
+  mascaraSclk = mascaraCs = mascaraMiso = 0;
+
+  pinMode(cs, OUTPUT);
+  digitalWrite(cs, HIGH);
+  SPI.begin();
+}
+
+uint16_t MAX31855_PI2::conversaoMs(void) {
+  return MAX31855_CONVERSAO_MS;
+}
+
+uint32_t MAX31855_PI2::lerQuadro(void) {
+  uint32_t quadro = 0;
+
+  if (spiHardware) {
+    SPI.beginTransaction(SPISettings(MAX31855_SPI_HZ, MSBFIRST, SPI_MODE0));
+    digitalWrite(cs, LOW);
+    quadro = (uint32_t)SPI.transfer16(0) << 16;
+    quadro |= SPI.transfer16(0);
+    digitalWrite(cs, HIGH);
+    SPI.endTransaction();
+    return quadro;
+  }
+
+#if defined(ESP8266)
+  if (mascaraSclk && mascaraCs) {
+    return quadroRegistradores(mascaraSclk, mascaraCs, mascaraMiso, 32);
+  }
+#endif
+
+  digitalWrite(cs, LOW);
+  for (int i = 31; i >= 0; i--) {
+    digitalWrite(sclk, LOW);
+    delayMicroseconds(1);
+    if (digitalRead(miso)) quadro |= (1UL << i);
+    digitalWrite(sclk, HIGH);
+    delayMicroseconds(1);
+  }
+  digitalWrite(cs, HIGH);
+  return quadro;
+}
+
+// D31-18 termopar, D16 falha, D15-4 junção fria, D2-0 SCV/SCG/OC
+double MAX31855_PI2::lerCelsius(void) {
+  uint32_t quadro = lerQuadro();
+
+  juncaoLida = ((int16_t)(quadro & 0xFFF0) >> 4) * 0.0625;
+  falhasLidas = 0;
+  if (quadro & 0x01) falhasLidas |= TERMOPAR_ABERTO;
+  if (quadro & 0x02) falhasLidas |= TERMOPAR_CURTO_GND;
+  if (quadro & 0x04) falhasLidas |= TERMOPAR_CURTO_VCC;
+  if (quadro & 0x10000) return NAN;
+
+  return ((int32_t)(quadro & 0xFFFC0000) >> 18) * 0.25;
+}
+
+MAX31856_PI2::MAX31856_PI2(int8_t SCLK, int8_t CS, int8_t MISO, int8_t MOSI) {
+  sclk = SCLK;
+  cs = CS;
+  miso = MISO;
+  mosi = MOSI;
+  spiHardware = false;
+
+  pinMode(cs, OUTPUT);
+  pinMode(sclk, OUTPUT);
+  pinMode(mosi, OUTPUT);
+  pinMode(miso, INPUT);
+  digitalWrite(cs, HIGH);
+  digitalWrite(sclk, LOW);
+}
+
+MAX31856_PI2::MAX31856_PI2(int8_t CS) {
+  sclk = miso = mosi = -1;
+  cs = CS;
+  spiHardware = true;
+
+  pinMode(cs, OUTPUT);
+  digitalWrite(cs, HIGH);
+  SPI.begin();
+}
+
+uint16_t MAX31856_PI2::conversaoMs(void) {
+  return MAX31856_CONVERSAO_MS;
+}
+
+// CR0: conversão automática, falha de termopar aberto detectada a cada
+// conversão, filtro da rede; CR1: sem média e o tipo de termopar
+void MAX31856_PI2::iniciar(uint8_t tipo, uint8_t hz) {
+  escrever(0x00, 0x80 | 0x10 | (hz == 50 ? 0x01 : 0x00));
+  escrever(0x01, tipo & 0x0F);
+  escrever(0x02, 0x00);      // MASK: todas as falhas ativas no pino FAULT
+  inicioConversao = millis();
+}
+
+// LTCB (0x0C-0x0E) 19 bits em 2^-7 C, CJT (0x0A-0x0B) 14 bits em 2^-6 C, SR (0x0F)
+double MAX31856_PI2::lerCelsius(void) {
+  uint8_t r[6];
+  ler(0x0A, r, 6);
+
+  juncaoLida = ((int16_t)((r[0] << 8) | r[1]) >> 2) * 0.015625;
+
+  uint8_t sr = r[5];
+  falhasLidas = 0;
+  if (sr & 0x01) falhasLidas |= TERMOPAR_ABERTO;
+  if (sr & 0x02) falhasLidas |= TERMOPAR_SOBRETENSAO;
+  if (sr & 0xFC) falhasLidas |= TERMOPAR_FORA_FAIXA;
+  if (sr & 0x03) return NAN;
+
+  int32_t bruto = ((int32_t)r[2] << 24) | ((int32_t)r[3] << 16) | ((int32_t)r[4] << 8);
+  return (bruto >> 13) * 0.0078125;
+}
+
+void MAX31856_PI2::escrever(uint8_t registrador, uint8_t valor) {
+  if (spiHardware) SPI.beginTransaction(SPISettings(MAX31856_SPI_HZ, MSBFIRST, SPI_MODE1));
+  digitalWrite(cs, LOW);
+  transferir(registrador | 0x80);
+  transferir(valor);
+  digitalWrite(cs, HIGH);
+  if (spiHardware) SPI.endTransaction();
+}
+
+void MAX31856_PI2::ler(uint8_t registrador, uint8_t *destino, uint8_t n) {
+  if (spiHardware) SPI.beginTransaction(SPISettings(MAX31856_SPI_HZ, MSBFIRST, SPI_MODE1));
+  digitalWrite(cs, LOW);
+  transferir(registrador & 0x7F);
+  for (uint8_t i = 0; i < n; i++) destino[i] = transferir(0);
+  digitalWrite(cs, HIGH);
+  if (spiHardware) SPI.endTransaction();
+}
+
+// Modo 1: o dado muda na subida do SCLK e é amostrado na descida
+uint8_t MAX31856_PI2::transferir(uint8_t byte) {
+  if (spiHardware) return SPI.transfer(byte);
+
+  uint8_t lido = 0;
+  for (int i = 7; i >= 0; i--) {
+    digitalWrite(sclk, HIGH);
+    digitalWrite(mosi, (byte >> i) & 1);
+    delayMicroseconds(1);
+    digitalWrite(sclk, LOW);
+    if (digitalRead(miso)) lido |= (1 << i);
+    delayMicroseconds(1);
+  }
+  return lido;
+}
+
+CalibracaoTermopar_PI2::CalibracaoTermopar_PI2() {
+  configurar(NULL, 0);
+}
+
+// Pares com lido crescente; a correção de cada nó da grade sai da reta
+// entre os dois pares vizinhos
+bool CalibracaoTermopar_PI2::configurar(const ParCalibracao *pares, uint8_t n) {
+  if (n > CALIBRACAO_PARES) return false;
+  for (uint8_t i = 0; i < n; i++) {
+    int16_t erro = pares[i].referencia_dC - pares[i].lido_dC;
+    if (erro > CALIBRACAO_MAXIMA_C * 10 || erro < -CALIBRACAO_MAXIMA_C * 10) return false;
+    if (i > 0 && pares[i].lido_dC <= pares[i - 1].lido_dC) return false;
+  }
+
+  temCorrecao = n > 0;
+  for (uint8_t k = 0; k < CALIBRACAO_NOS; k++) {
+    float x = (float)((uint32_t)k << CALIBRACAO_DESLOCAMENTO) / FILTRO_ESCALA * 10;   // dC
+    float erro = 0;
+    if (n == 1 || (n > 1 && x <= pares[0].lido_dC)) {
+      erro = pares[0].referencia_dC - pares[0].lido_dC;
+    }
+    else if (n > 1 && x >= pares[n - 1].lido_dC) {
+      erro = pares[n - 1].referencia_dC - pares[n - 1].lido_dC;
+    }
+    else if (n > 1) {
+      uint8_t i = 1;
+      while (pares[i].lido_dC < x) i++;
+      const ParCalibracao &a = pares[i - 1], &b = pares[i];
+      float ea = a.referencia_dC - a.lido_dC, eb = b.referencia_dC - b.lido_dC;
+      erro = ea + (eb - ea) * (x - a.lido_dC) / (b.lido_dC - a.lido_dC);
+    }
+    correcao[k] = (int16_t)lroundf(erro * FILTRO_ESCALA / 10);
+  }
+  return true;
+}
+
+int16_t CalibracaoTermopar_PI2::corrigir16(int16_t lido) {
+  if (!temCorrecao) return lido;
+  if (lido < 0) return lido + correcao[0];
+  uint16_t segmento = (uint16_t)lido >> CALIBRACAO_DESLOCAMENTO;
+  if (segmento >= CALIBRACAO_NOS - 1) return lido + correcao[CALIBRACAO_NOS - 1];
+  int32_t fracao = lido & ((1 << CALIBRACAO_DESLOCAMENTO) - 1);
+  int32_t a = correcao[segmento], b = correcao[segmento + 1];
+  return lido + (int16_t)(a + (((b - a) * fracao) >> CALIBRACAO_DESLOCAMENTO));
+}
+
+double CalibracaoTermopar_PI2::corrigir(double celsius) {
+  if (!temCorrecao || isnan(celsius)) return celsius;
+  return corrigir16((int16_t)lround(celsius * FILTRO_ESCALA)) / (double)FILTRO_ESCALA;
+}
+
+bool CalibracaoTermopar_PI2::ativa(void) {
+  return temCorrecao;
+}
+
+RelogioSonda_PI2::RelogioSonda_PI2() {
+  baseLocal = baseMestre = 0;
+  ppm = 0;
+  ultimoErro = 0;
+  balizas = 0;
+}
+
+// Chamada com o instante local em que a baliza chegou
+void RelogioSonda_PI2::sincronizar(uint64_t mestre_us, uint64_t local_us) {
+  if (balizas > 0) {
+    int64_t e = (int64_t)(mestre_us - mestre(local_us));
+    int64_t intervalo = (int64_t)(local_us - baseLocal);
+    if (e > RELOGIO_SALTO_US || e < -RELOGIO_SALTO_US || intervalo <= 0) {
+      balizas = 0;
+      ppm = 0;
+    }
+    else {
+      ultimoErro = e;
+      // a segunda baliza mede a deriva inteira; as seguintes a refinam
+      ppm += (float)e * 1e6f / intervalo * (balizas == 1 ? 1 : RELOGIO_GANHO);
+    }
+  }
+  baseLocal = local_us;
+  baseMestre = mestre_us;
+  if (balizas < 255) balizas++;
+}
+
+bool RelogioSonda_PI2::sincronizado(uint64_t local_us) {
+  return balizas > 0 && local_us - baseLocal < RELOGIO_VALIDADE_US;
+}
+
+uint64_t RelogioSonda_PI2::mestre(uint64_t local_us) {
+  int64_t dl = (int64_t)(local_us - baseLocal);
+  return baseMestre + dl + (int64_t)((float)dl * (ppm * 1e-6f));
+}
+
+uint64_t RelogioSonda_PI2::local(uint64_t mestre_us) {
+  int64_t dm = (int64_t)(mestre_us - baseMestre);
+  float k = ppm * 1e-6f;
+  return baseLocal + dm - (int64_t)((float)dm * k / (1 + k));
+}
+
+float RelogioSonda_PI2::deriva(void) {
+  return ppm;
+}
+
+int32_t RelogioSonda_PI2::erro(void) {
+  return ultimoErro;
+}
+
+FusaoPlaca_PI2::FusaoPlaca_PI2() {
+  cabeca = quantidade = 0;
+  memset(sondas, 0, sizeof(sondas));
+  grupoInstante = 0;
+  grupoSoma = grupoMin = grupoMax = 0;
+  grupoN = 0;
+  tau = 0;
+  placaC = NAN;
+  gradienteC = 0;
+  alvo = dif = 0;
+  instantePlaca = ultimaFusao = 0;
+  nova = temPlaca = false;
+  nRecebidos = nPerdidos = nRejeitados = 0;
+}
+
+void FusaoPlaca_PI2::configurar(float tau_s) {
+  tau = (tau_s > 0) ? tau_s : 0;
+}
+
+// Chamada quando o rádio entrega um pacote; voo_ms é o tempo no ar
+bool FusaoPlaca_PI2::receber(const uint8_t *dados, uint8_t tamanho, uint8_t no, uint32_t chegada, uint16_t voo_ms) {
+  PacoteSonda_PI2 p;
+  if (tamanho != sizeof(p) || no < 1 || no > SONDA_NOS) {
+    nRejeitados++;
+    return false;
+  }
+  memcpy(&p, dados, sizeof(p));
+  Sonda &s = sondas[no - 1];
+  if (p.versao != SONDA_VERSAO || (s.vista && p.sequencia == s.sequencia)) {
+    nRejeitados++;
+    return false;
+  }
+  uint16_t salto = p.sequencia - s.sequencia - 1;
+  if (s.vista && salto < 1000) nPerdidos += salto;   // maior: a sonda reiniciou
+  s.vista = true;
+  s.sequencia = p.sequencia;
+  s.bateria = p.bateria_mV;
+  s.chegada = chegada;
+  s.sincronizada = p.instante_ms != 0;
+  nRecebidos++;
+  if (p.temperatura_q == SONDA_FALHA) {
+    s.celsius = NAN;
+    return false;
+  }
+  s.celsius = p.temperatura_q * 0.25;
+  s.instante = s.sincronizada ? p.instante_ms : chegada - p.idade_ms - voo_ms;
+
+  if (!s.sincronizada) {
+    // sem instante comum, a leitura é um grupo sozinha
+    fecharGrupo();
+  }
+  else if (temPlaca && (int32_t)(s.instante - instantePlaca) <= 0) {
+    return false;   // o grupo deste instante já fechou
+  }
+  else if (grupoN > 0 && s.instante != grupoInstante) {
+    if ((int32_t)(s.instante - grupoInstante) < 0) return false;
+    fecharGrupo();
+  }
+
+  if (grupoN == 0) {
+    grupoInstante = s.instante;
+    grupoSoma = 0;
+    grupoMin = grupoMax = s.celsius;
+  }
+  grupoSoma += s.celsius;
+  if (s.celsius < grupoMin) grupoMin = s.celsius;
+  if (s.celsius > grupoMax) grupoMax = s.celsius;
+  grupoN++;
+
+  uint8_t esperadas = 0;
+  for (uint8_t n = 1; n <= SONDA_NOS; n++) {
+    if (noAtivo(n, chegada) && sondas[n - 1].sincronizada && !isnan(sondas[n - 1].celsius)) esperadas++;
+  }
+  if (!s.sincronizada || grupoN >= esperadas) fecharGrupo();
+  return true;
+}
+
+void FusaoPlaca_PI2::fecharGrupo(void) {
+  if (grupoN == 0) return;
+  placaC = grupoSoma / grupoN;
+  gradienteC = grupoMax - grupoMin;
+  instantePlaca = grupoInstante;
+  nova = temPlaca = true;
+  grupoN = 0;
+}
+// Ar no instante pedido, interpolado entre as leituras vizinhas do histórico
+float FusaoPlaca_PI2::arNoInstante(uint32_t instante) {
+  uint8_t i = (cabeca + FUSAO_HISTORICO - 1) % FUSAO_HISTORICO;
+  const LeituraAr *depois = &historico[i];
+  for (uint8_t n = 1; n < quantidade; n++) {
+    i = (i + FUSAO_HISTORICO - 1) % FUSAO_HISTORICO;
+    const LeituraAr *antes = &historico[i];
+    if ((int32_t)(instante - antes->instante) >= 0) {
+      if ((int32_t)(instante - depois->instante) >= 0) return depois->celsius;
+      float f = (float)(instante - antes->instante) / (depois->instante - antes->instante);
+      return antes->celsius + (depois->celsius - antes->celsius) * f;
+    }
+    depois = antes;
+  }
+  return depois->celsius;   // mais antiga que o histórico
+}
+
+float FusaoPlaca_PI2::fundir(float ar, uint32_t instante_ar, uint32_t agora) {
+  if (isnan(ar)) return ar;
+  // uma entrada por conversão do termopar, não por chamada
+  uint8_t ultima = (cabeca + FUSAO_HISTORICO - 1) % FUSAO_HISTORICO;
+  if (quantidade == 0 || historico[ultima].instante != instante_ar) {
+    historico[cabeca].instante = instante_ar;
+    historico[cabeca].celsius = ar;
+    cabeca = (cabeca + 1) % FUSAO_HISTORICO;
+    if (quantidade < FUSAO_HISTORICO) quantidade++;
+  }
+
+  if (nova) {
+    nova = false;
+    alvo = arNoInstante(instantePlaca) - placaC;
+  }
+  float dt = (ultimaFusao != 0) ? (agora - ultimaFusao) / 1000.0 : 0;
+  ultimaFusao = agora;
+  float passo = (tau > 0) ? dt / tau : 1;
+  if (passo > 1) passo = 1;
+  dif += ((ativa(agora) ? alvo : 0) - dif) * passo;
+  return ar - dif;
+}
+
+bool FusaoPlaca_PI2::ativa(uint32_t agora) {
+  return temPlaca && (int32_t)(agora - instantePlaca) < SONDA_VALIDADE_MS;
+}
+
+float FusaoPlaca_PI2::placa(void) {
+  return placaC;
+}
+
+float FusaoPlaca_PI2::gradiente(void) {
+  return gradienteC;
+}
+
+float FusaoPlaca_PI2::diferenca(void) {
+  return dif;
+}
+
+uint8_t FusaoPlaca_PI2::ativas(uint32_t agora) {
+  uint8_t n = 0;
+  for (uint8_t no = 1; no <= SONDA_NOS; no++) {
+    if (noAtivo(no, agora)) n++;
+  }
+  return n;
+}
+
+bool FusaoPlaca_PI2::noAtivo(uint8_t no, uint32_t agora) {
+  if (no < 1 || no > SONDA_NOS) return false;
+  const Sonda &s = sondas[no - 1];
+  return s.vista && (int32_t)(agora - s.chegada) < SONDA_VALIDADE_MS;
+}
+
+float FusaoPlaca_PI2::noCelsius(uint8_t no) {
+  return (no >= 1 && no <= SONDA_NOS && sondas[no - 1].vista) ? sondas[no - 1].celsius : NAN;
+}
+
+uint16_t FusaoPlaca_PI2::noBateria(uint8_t no) {
+  return (no >= 1 && no <= SONDA_NOS) ? sondas[no - 1].bateria : 0;
+}
+
+bool FusaoPlaca_PI2::noSincronizado(uint8_t no) {
+  return no >= 1 && no <= SONDA_NOS && sondas[no - 1].sincronizada;
+}
+
+uint32_t FusaoPlaca_PI2::recebidos(void) {
+  return nRecebidos;
+}
+
+uint32_t FusaoPlaca_PI2::perdidos(void) {
+  return nPerdidos;
+}
+
+uint32_t FusaoPlaca_PI2::rejeitados(void) {
+  return nRejeitados;
+}
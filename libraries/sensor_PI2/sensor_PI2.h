@@ -11,15 +11,315 @@
  
 #include <Arduino.h>
 
+#define MAX6675_SPI_HZ 4000000   // SCK máximo do MAX6675 é 4,3 MHz
+#define MAX6675_CONVERSAO_MS 220  // tempo máximo de conversão do MAX6675
+#define MAX31855_SPI_HZ 5000000
+#define MAX31855_CONVERSAO_MS 100
+#define MAX31856_SPI_HZ 5000000
+#define MAX31856_CONVERSAO_MS 100 // conversão contínua, filtro de 50/60 Hz
+
+// Bits de Termopar_PI2::falhas(), comuns aos conversores
+#define TERMOPAR_ABERTO      0x01
+#define TERMOPAR_CURTO_GND   0x02
+#define TERMOPAR_CURTO_VCC   0x04
+#define TERMOPAR_FORA_FAIXA  0x08   // termopar ou junção fria fora da faixa
+#define TERMOPAR_SOBRETENSAO 0x10
+
+// Interface comum aos conversores de termopar: o controle só enxerga
+// esta classe e o conversor pode ser trocado sem mexer nele.
+class Termopar_PI2 {
+ public:
+  Termopar_PI2();
+  virtual ~Termopar_PI2() {}
+  virtual double lerCelsius(void) = 0;   // leitura imediata; NAN em falha
+  virtual double juncaoFria(void);       // NAN se o conversor não informa
+  virtual uint16_t conversaoMs(void) = 0;
+
+  // Aquisição sem bloqueio: só lê de novo depois de conversaoMs(). Pode
+  // ser chamada com qualquer frequência; true quando fez uma leitura nova.
+  bool atualizar(void);
+  double ultimaCelsius(void);
+  uint8_t falhas(void);                  // bits TERMOPAR_* da última leitura
+  uint32_t instanteAmostra(void);        // millis() da última leitura
+  uint32_t contadorAmostras(void);
+
+ protected:
+  uint8_t falhasLidas;
+  double juncaoLida;
+  uint32_t inicioConversao;
+
+ private:
+  uint32_t instante;
+  uint32_t amostras;
+  double ultima;
+};
+
 // Criação da classe
-class MAX6675_PI2 {
+class MAX6675_PI2 : public Termopar_PI2 {
  public:
+  // Bit-bang nos pinos dados (no ESP8266 por acesso direto aos registradores GPIO)
   MAX6675_PI2(int8_t SCLK, int8_t CS, int8_t MISO);
+  // SPI por hardware (HSPI no ESP8266: SCK = D5, MISO = D6); só o CS é livre
+  MAX6675_PI2(int8_t CS);
   double lerCelsius(void);
+  uint16_t lerQuadro(void);   // quadro bruto de 16 bits, em uma transação
+  // a conversão recomeça quando o CS sobe
+  uint16_t conversaoMs(void);
   
  private:
   int8_t sclk, miso, cs;
+  bool spiHardware;
+  uint32_t mascaraSclk, mascaraCs, mascaraMiso;
   uint8_t leituraSPI(void);
+  uint16_t leituraRegistradores(void);
+};
+
+// MAX31855: só leitura, quadro de 32 bits com o termopar em 0,25 C
+// (14 bits com sinal), a junção fria em 0,0625 C e os bits de falha.
+class MAX31855_PI2 : public Termopar_PI2 {
+ public:
+  MAX31855_PI2(int8_t SCLK, int8_t CS, int8_t MISO);
+  MAX31855_PI2(int8_t CS);    // HSPI
+  double lerCelsius(void);
+  uint32_t lerQuadro(void);
+  uint16_t conversaoMs(void);
+
+ private:
+  int8_t sclk, miso, cs;
+  bool spiHardware;
+  uint32_t mascaraSclk, mascaraCs, mascaraMiso;
+};
+
+// MAX31856: registradores por SPI modo 1, conversão contínua, termopar
+// em 2^-7 C (19 bits) e linearização para vários tipos de termopar.
+#define MAX31856_TIPO_K 0x03
+#define MAX31856_TIPO_J 0x02
+#define MAX31856_TIPO_T 0x07
+
+class MAX31856_PI2 : public Termopar_PI2 {
+ public:
+  MAX31856_PI2(int8_t SCLK, int8_t CS, int8_t MISO, int8_t MOSI);
+  MAX31856_PI2(int8_t CS);    // HSPI (MOSI = D7)
+  // tipo MAX31856_TIPO_*, rede de 50 ou 60 Hz; chamar no setup()
+  void iniciar(uint8_t tipo, uint8_t hz);
+  double lerCelsius(void);
+  uint16_t conversaoMs(void);
+
+ private:
+  int8_t sclk, miso, mosi, cs;
+  bool spiHardware;
+  void escrever(uint8_t registrador, uint8_t valor);
+  void ler(uint8_t registrador, uint8_t *destino, uint8_t n);
+  uint8_t transferir(uint8_t byte);
+};
+
+#define BARRAMENTO_MAX_CANAIS 8   // CS por MAX6675Bus
+
+// Resultado de uma varredura do barramento, compacto para telemetria
+struct VarreduraMAX6675 {
+  uint32_t instante;                         // millis() da varredura
+  uint8_t falhas;                            // bit c: termopar do canal c aberto
+  int16_t quartos[BARRAMENTO_MAX_CANAIS];    // quartos de grau (0 em falha)
+};
+
+// Vários MAX6675 em um barramento: SCLK e MISO comuns, um CS por chip.
+// Uma varredura lê os chips em sequência, sem nada entre os quadros:
+// os CS sobem com poucos microssegundos de diferença, as conversões
+// recomeçam juntas e todos os canais ficam com o mesmo instante.
+class MAX6675Bus {
+ public:
+  MAX6675Bus(int8_t SCLK, int8_t MISO, const int8_t *cs, uint8_t canais);
+  void varrer(VarreduraMAX6675 &v);   // leitura imediata de todos os canais
+  bool atualizar(void);               // varre quando a conversão terminou
+  const VarreduraMAX6675 &ultima(void);
+  double celsius(uint8_t canal);      // NAN em falha, como MAX6675_PI2
+  bool falha(uint8_t canal);
+  uint8_t canais(void);
+  uint32_t contadorVarreduras(void);
+
+ private:
+  int8_t sclk, miso;
+  int8_t cs[BARRAMENTO_MAX_CANAIS];
+  uint8_t quantidade;
+  uint32_t mascaraSclk, mascaraMiso;
+  uint32_t mascaraCs[BARRAMENTO_MAX_CANAIS];
+  uint32_t inicioConversao;
+  uint32_t varreduras;
+  VarreduraMAX6675 dados;
+
+  uint16_t lerQuadro(uint8_t canal);
+};
+
+#define FILTRO_MAX_N 9          // maior janela de mediana suportada
+#define FILTRO_FALHAS_LIMITE 2  // leituras abertas seguidas até declarar falha
+#define FILTRO_ESCALA 16        // passos por grau: 1/16 C cobre o MAX31855/31856
+
+// Filtro entre o sensor e o controle: mediana de N sobre um buffer
+// circular e depois um IIR de primeira ordem em ponto fixo (Q8, em
+// 1/FILTRO_ESCALA de grau, abaixo da resolução dos conversores). Leituras NAN (termopar
+// aberto) não entram no filtro; várias seguidas levam ao estado de falha.
+class FiltroTemperatura_PI2 {
+ public:
+  FiltroTemperatura_PI2(uint8_t n, uint8_t deslocamentoIIR);
+  void adicionar(double celsius);
+  void reiniciar(void);
+  bool falha(void);
+  bool valido(void);        // já existe saída filtrada
+  float celsius(void);
+
+ private:
+  uint8_t tamanho, k;
+  int16_t janela[FILTRO_MAX_N];   // 1/FILTRO_ESCALA de grau
+  uint8_t posicao, ocupados;
+  int32_t estado;                 // saída do IIR em Q8
+  bool iniciado;
+  uint8_t falhasSeguidas;
+  bool emFalha;
+
+  int16_t mediana(void);
+};
+
+// Calibração de um termopar contra uma sonda de referência: pares
+// (lido, referência) viram uma tabela de correção em uma grade fixa de
+// 2^CALIBRACAO_DESLOCAMENTO / FILTRO_ESCALA graus (16 C), e cada leitura
+// é corrigida com um deslocamento (o segmento), uma máscara e uma
+// interpolação inteira, em 1/FILTRO_ESCALA de grau como no filtro. Fora
+// dos pares vale a correção do par mais próximo.
+#define CALIBRACAO_PARES        8
+#define CALIBRACAO_DESLOCAMENTO 8     // 256/16 = 16 C por segmento
+#define CALIBRACAO_NOS          33    // 0 a 512 C
+#define CALIBRACAO_MAXIMA_C     50    // maior correção aceita
+
+struct ParCalibracao {
+  int16_t lido_dC;          // décimos de grau
+  int16_t referencia_dC;
+};
+
+class CalibracaoTermopar_PI2 {
+ public:
+  CalibracaoTermopar_PI2();
+  bool configurar(const ParCalibracao *pares, uint8_t n);   // n = 0: sem correção
+  int16_t corrigir16(int16_t lido);      // 1/FILTRO_ESCALA de grau
+  double corrigir(double celsius);       // NAN passa direto
+  bool ativa(void);
+
+ private:
+  int16_t correcao[CALIBRACAO_NOS];      // referência - lido em cada nó, 1/FILTRO_ESCALA
+  bool temCorrecao;
+};
+
+// Sondas sem fio presas à placa (sketch sonda_placa/): MAX6675 a bateria
+// que mandam cada conversão por rádio. O forno difunde uma baliza com o
+// relógio dele (BalizaSonda_PI2, RHDatagram em broadcast); cada sonda
+// segue esse relógio (RelogioSonda_PI2) e todas leem juntas nos múltiplos
+// de periodo_ms do forno, transmitindo cada uma na sua janela. O pacote
+// traz o instante da leitura no relógio do forno; antes da primeira
+// baliza vai 0 e a idade da amostra no envio, e o forno data pela chegada.
+#define SONDA_VERSAO      2
+#define SONDA_FALHA       INT16_MIN   // temperatura_q: termopar aberto
+#define SONDA_VALIDADE_MS 2000        // sem pacote por mais que isso, a sonda caiu
+#define SONDA_NOS         8           // endereços RHDatagram 1 a SONDA_NOS
+#define FUSAO_HISTORICO   16          // leituras do ar guardadas para alinhar (~1,6 s em Ts = 100 ms)
+
+struct __attribute__((packed)) PacoteSonda_PI2 {
+  uint8_t versao;
+  uint8_t reservado;
+  uint16_t sequencia;       // +1 por pacote; salto = pacotes perdidos
+  uint32_t instante_ms;     // da leitura, no relógio do forno; 0 sem baliza
+  uint16_t idade_ms;        // da leitura do MAX6675 até o envio
+  int16_t temperatura_q;    // 1/4 C, a resolução do MAX6675
+  uint16_t bateria_mV;
+};
+
+// Balizas nos múltiplos de baliza_ms mais meio período, longe das
+// janelas de transmissão das sondas
+struct __attribute__((packed)) BalizaSonda_PI2 {
+  uint8_t versao;
+  uint8_t janela_ms;        // a sonda n transmite n janelas depois da leitura
+  uint16_t periodo_ms;      // leituras nos múltiplos deste período
+  uint16_t baliza_ms;       // intervalo entre balizas
+  uint64_t mestre_us;       // relógio do forno ao entregar a baliza ao rádio
+};
+
+// Relógio do forno visto por uma sonda: fase e deriva do oscilador local
+// (o ressonador do Pro Mini erra até 0,5%) corrigidas a cada baliza. A
+// fase salta para a da baliza; a deriva é a média do erro por segundo
+// entre balizas, com ganho RELOGIO_GANHO. O atraso fixo do rádio é o
+// mesmo em todas as sondas e não desalinha as leituras entre elas.
+#define RELOGIO_GANHO       0.25
+#define RELOGIO_SALTO_US    20000     // erro maior: recomeça do zero
+#define RELOGIO_VALIDADE_US 5000000   // sem baliza por mais que isso, dessincronizada
+
+class RelogioSonda_PI2 {
+ public:
+  RelogioSonda_PI2();
+  void sincronizar(uint64_t mestre_us, uint64_t local_us);
+  bool sincronizado(uint64_t local_us);
+  uint64_t mestre(uint64_t local_us);    // instante local no relógio do forno
+  uint64_t local(uint64_t mestre_us);    // e o inverso, para agendar
+  float deriva(void);                    // ppm do local em relação ao forno
+  int32_t erro(void);                    // us, da última baliza contra a previsão
+
+ private:
+  uint64_t baseLocal, baseMestre;
+  float ppm;
+  int32_t ultimoErro;
+  uint8_t balizas;
+};
+
+// A placa segue o ar com atraso e diferença que dependem da carga; as
+// sondas chegam devagar (~4 Hz, com perdas) e o termopar do ar chega a
+// cada conversão. Os pacotes de um mesmo instante formam um grupo, fechado
+// quando todas as sondas ativas chegaram ou quando chega outro instante;
+// o grupo dá a média da placa e o gradiente (maior - menor). A medida do
+// controle é o ar menos a diferença ar-placa, que a cada grupo se
+// aproxima, com constante tau, de ar - média no instante do grupo (o ar
+// daquele instante vem do histórico). Sem pacotes por SONDA_VALIDADE_MS a
+// diferença volta a zero com o mesmo tau e a medida volta a ser o ar,
+// sem degrau.
+class FusaoPlaca_PI2 {
+ public:
+  FusaoPlaca_PI2();
+  void configurar(float tau_s);
+  // no = endereço de origem; false: tamanho, versão, nó, repetido, atrasado ou termopar aberto
+  bool receber(const uint8_t *dados, uint8_t tamanho, uint8_t no, uint32_t chegada, uint16_t voo_ms);
+  float fundir(float ar, uint32_t instante_ar, uint32_t agora);   // NAN passa direto
+
+  bool ativa(uint32_t agora);
+  float placa(void);             // média do último grupo; NAN antes do primeiro
+  float gradiente(void);         // maior - menor no último grupo
+  float diferenca(void);         // ar - placa em uso
+  uint8_t ativas(uint32_t agora);
+  bool noAtivo(uint8_t no, uint32_t agora);
+  float noCelsius(uint8_t no);
+  uint16_t noBateria(uint8_t no);    // mV
+  bool noSincronizado(uint8_t no);
+  uint32_t recebidos(void);
+  uint32_t perdidos(void);       // pelos saltos de sequência
+  uint32_t rejeitados(void);
+
+ private:
+  struct LeituraAr { uint32_t instante; float celsius; };
+  struct Sonda {
+    uint32_t chegada, instante;
+    float celsius;
+    uint16_t sequencia, bateria;
+    bool vista, sincronizada;
+  };
+  LeituraAr historico[FUSAO_HISTORICO];
+  uint8_t cabeca, quantidade;
+  Sonda sondas[SONDA_NOS];
+  uint32_t grupoInstante;
+  float grupoSoma, grupoMin, grupoMax;
+  uint8_t grupoN;
+  float tau;
+  float placaC, gradienteC, alvo, dif;
+  uint32_t instantePlaca, ultimaFusao;
+  bool nova, temPlaca;
+  uint32_t nRecebidos, nPerdidos, nRejeitados;
+
+  float arNoInstante(uint32_t instante);
+  void fecharGrupo(void);
 };
 
 #endif
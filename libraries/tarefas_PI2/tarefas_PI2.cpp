@@ -0,0 +1,107 @@
+/*  Biblioteca de Tarefas do controle do Forno
+ *
+ *  tarefas_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "tarefas_PI2.h"
+
+#if defined(ESP8266)
+  // PS.INTLEVEL = 15: nem NMI de Wi-Fi preempta a reserva
+  #define FILA_TRAVAR()      uint32_t _ps = xt_rsil(15)
+  #define FILA_DESTRAVAR()   xt_wsr_ps(_ps)
+#else
+  #define FILA_TRAVAR()      noInterrupts()
+  #define FILA_DESTRAVAR()   interrupts()
+#endif
+
+FilaTrabalho_PI2::FilaTrabalho_PI2() {
+  for (uint32_t i = 0; i < FILA_TRABALHO_CAPACIDADE; i++) {
+    celulas[i].seq = i;
+  }
+  cabeca = 0;
+  cauda = 0;
+  perdidos = 0;
+  maximo = 0;
+}
+
+// Pode ser chamada de ISR, do Ticker ou do loop(). Retorna false e conta
+// o descarte se a fila está cheia.
+bool IRAM_ATTR FilaTrabalho_PI2::postar(uint8_t tipo, uint32_t valor, uint8_t arg, uint16_t extra) {
+  uint32_t posicao;
+#if defined(ESP32)
+  // mascarar interrupções só vale para um núcleo: a posição sai de um CAS
+  posicao = __atomic_load_n(&cabeca, __ATOMIC_RELAXED);
+  do {
+    if (celulas[posicao & (FILA_TRABALHO_CAPACIDADE - 1)].seq != posicao) {
+      __atomic_fetch_add(&perdidos, 1, __ATOMIC_RELAXED);
+      return false;
+    }
+  } while (!__atomic_compare_exchange_n(&cabeca, &posicao, posicao + 1, true,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+  uint32_t ocupacao = posicao + 1 - cauda;
+  uint32_t anterior = __atomic_load_n(&maximo, __ATOMIC_RELAXED);
+  while (ocupacao > anterior &&
+         !__atomic_compare_exchange_n(&maximo, &anterior, ocupacao, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {}
+#else
+  {
+    FILA_TRAVAR();
+    posicao = cabeca;
+    if (celulas[posicao & (FILA_TRABALHO_CAPACIDADE - 1)].seq != posicao) {
+      perdidos = perdidos + 1;
+      FILA_DESTRAVAR();
+      return false;
+    }
+    cabeca = posicao + 1;
+    uint32_t ocupacao = posicao + 1 - cauda;
+    if (ocupacao > maximo) maximo = ocupacao;
+    FILA_DESTRAVAR();
+  }
+#endif
+
+  Celula &c = celulas[posicao & (FILA_TRABALHO_CAPACIDADE - 1)];
+  c.trabalho.tipo = tipo;
+  c.trabalho.arg = arg;
+  c.trabalho.extra = extra;
+  c.trabalho.valor = valor;
+  __sync_synchronize();
+  c.seq = posicao + 1;
+  return true;
+}
+
+// Chamar do loop(): entrega até lote eventos, em ordem de reserva, e para
+// antes se o orçamento de tempo acabar. Um evento reservado mas ainda em
+// escrita (o produtor foi interrompido) segura os seguintes até a próxima
+// chamada. Retorna quantos foram tratados.
+size_t FilaTrabalho_PI2::drenar(TratadorTrabalho tratar, uint32_t orcamento_us, size_t lote) {
+  uint32_t inicio = micros();
+  size_t tratados = 0;
+
+  while (tratados < lote) {
+    Celula &c = celulas[cauda & (FILA_TRABALHO_CAPACIDADE - 1)];
+    if (c.seq != cauda + 1) break;
+    __sync_synchronize();
+    Trabalho t = c.trabalho;
+    __sync_synchronize();
+    c.seq = cauda + FILA_TRABALHO_CAPACIDADE;   // livre para a próxima volta
+    cauda = cauda + 1;
+
+    tratar(t);
+    tratados++;
+    if ((uint32_t)(micros() - inicio) >= orcamento_us) break;
+  }
+  return tratados;
+}
+
+uint32_t FilaTrabalho_PI2::descartados(void) const {
+  return perdidos;
+}
+
+uint32_t FilaTrabalho_PI2::pendentes(void) const {
+  return cabeca - cauda;
+}
+
+uint32_t FilaTrabalho_PI2::pico(void) const {
+  return maximo;
+}
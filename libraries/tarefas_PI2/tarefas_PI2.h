@@ -0,0 +1,58 @@
+/*  Biblioteca de Tarefas do controle do Forno
+ *  Fila de trabalho entre as interrupções/Ticker e o loop(): quem está
+ *  em contexto de interrupção só posta um evento pequeno, o loop() faz o
+ *  trabalho pesado.
+ *
+ *  tarefas_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef TarefasForno
+#define TarefasForno
+
+#include <Arduino.h>
+
+#define FILA_TRABALHO_CAPACIDADE 32   // eventos em espera, potência de 2
+#define FILA_TRABALHO_LOTE       8    // eventos por drenar(), no máximo
+
+// Evento: um tipo escolhido pelo sketch e dois campos livres
+struct Trabalho {
+  uint8_t tipo;
+  uint8_t arg;
+  uint16_t extra;
+  uint32_t valor;
+};
+
+typedef void (*TratadorTrabalho)(const Trabalho &trabalho);
+
+// Fila limitada de vários produtores e um consumidor, com um número de
+// sequência por célula: a célula só é lida quando o produtor terminou de
+// escrevê-la e só é reescrita depois que o consumidor a liberou. O lx106
+// não tem CAS, então a reserva da posição é feita com as interrupções
+// mascaradas por poucas instruções; no ESP32, onde o produtor pode estar
+// no outro núcleo, a reserva é um CAS (S32C1I). A cópia do evento e todo
+// o lado do consumidor rodam sem mascarar nada.
+class FilaTrabalho_PI2 {
+ public:
+  FilaTrabalho_PI2();
+  bool postar(uint8_t tipo, uint32_t valor = 0, uint8_t arg = 0, uint16_t extra = 0);
+  size_t drenar(TratadorTrabalho tratar, uint32_t orcamento_us,
+                size_t lote = FILA_TRABALHO_LOTE);
+  uint32_t descartados(void) const;
+  uint32_t pendentes(void) const;
+  uint32_t pico(void) const;
+
+ private:
+  struct Celula {
+    volatile uint32_t seq;    // = posição livre, posição+1 pronta
+    Trabalho trabalho;
+  };
+
+  Celula celulas[FILA_TRABALHO_CAPACIDADE];
+  volatile uint32_t cabeca;   // próxima posição a reservar (produtores)
+  volatile uint32_t cauda;    // próxima posição a ler (consumidor)
+  volatile uint32_t perdidos;
+  volatile uint32_t maximo;   // maior ocupação vista
+};
+
+#endif
@@ -0,0 +1,418 @@
+/*  Biblioteca de Telemetria do controle do Forno
+ *
+ *  telemetria_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "telemetria_PI2.h"
+
+Telemetria_PI2::Telemetria_PI2() {
+  seq = 0;
+  memset(&dados, 0, sizeof(dados));
+}
+
+// Chamada apenas pela tarefa de controle (único produtor)
+void Telemetria_PI2::publicar(const AmostraControle &amostra) {
+  seq = seq + 1;            // ímpar: escrita em andamento
+  __sync_synchronize();
+  dados = amostra;
+  __sync_synchronize();
+  seq = seq + 1;            // par: retrato consistente
+}
+
+// Pode ser chamada de qualquer contexto, inclusive durante uma publicação
+void Telemetria_PI2::ler(AmostraControle &amostra) const {
+  uint32_t antes, depois;
+
+  do {
+    antes = seq;
+    __sync_synchronize();
+    amostra = dados;
+    __sync_synchronize();
+    depois = seq;
+  } while ((antes & 1) || (antes != depois));
+}
+
+uint32_t Telemetria_PI2::sequencia(void) const {
+  return seq;
+}
+
+Relogio_PI2::Relogio_PI2() {
+  seq = 0;
+  baseLocal = baseUtc = 0;
+  pendente = ultimoErro = 0;
+  sinc = false;
+}
+
+uint64_t Relogio_PI2::calcular(uint64_t local_us) const {
+  uint64_t dt = local_us - baseLocal;
+  uint64_t maximo = dt * RELOGIO_SLEW_PPM / 1000000UL;
+  if (pendente >= 0) {
+    return baseUtc + dt + ((uint64_t)pendente < maximo ? (uint64_t)pendente : maximo);
+  }
+  uint64_t falta = (uint64_t)(-pendente);
+  return baseUtc + dt - (falta < maximo ? falta : maximo);
+}
+
+// Pode ser chamada de qualquer contexto, inclusive durante uma correção
+uint64_t Relogio_PI2::agora(uint64_t local_us) const {
+  uint32_t antes, depois;
+  uint64_t t;
+
+  do {
+    antes = seq;
+    __sync_synchronize();
+    t = calcular(local_us);
+    __sync_synchronize();
+    depois = seq;
+  } while ((antes & 1) || (antes != depois));
+  return t;
+}
+
+// Chamada apenas pelo loop() (único produtor)
+void Relogio_PI2::corrigir(uint64_t local_us, uint64_t referencia_us) {
+  uint64_t atual = calcular(local_us);
+  int64_t e = (int64_t)(referencia_us - atual);
+
+  seq = seq + 1;            // ímpar: escrita em andamento
+  __sync_synchronize();
+  baseLocal = local_us;
+  if (!sinc || e > RELOGIO_DEGRAU_US) {
+    baseUtc = referencia_us;   // à frente: saltar não desfaz nenhuma ordem
+    pendente = 0;
+  } else {
+    baseUtc = atual;           // continua de onde estava
+    pendente = e;
+  }
+  ultimoErro = e;
+  sinc = true;
+  __sync_synchronize();
+  seq = seq + 1;            // par: estado consistente
+}
+
+bool Relogio_PI2::sincronizado(void) const {
+  return sinc;
+}
+
+int64_t Relogio_PI2::erro(void) const {
+  return ultimoErro;
+}
+
+Historico_PI2::Historico_PI2() {
+  reiniciar();
+}
+
+// Chamar com o produtor parado (antes de iniciar uma corrida)
+void Historico_PI2::reiniciar(void) {
+  total = 0;
+  memset(amostras, 0, sizeof(amostras));
+}
+
+// Chamada apenas pela tarefa de controle (único produtor)
+void Historico_PI2::registrar(uint16_t tempo_s, float temperatura, int potencia) {
+  long dC = lroundf(temperatura * 10.0f);
+  if (dC > 32767) dC = 32767;
+  if (dC < -32768) dC = -32768;
+  if (potencia < 0) potencia = 0;
+  if (potencia > 100) potencia = 100;
+
+  AmostraHistorico &a = amostras[total & (HISTORICO_CAPACIDADE - 1)];
+  a.tempo_s = tempo_s;
+  a.temperatura_dC = (int16_t)dC;
+  a.potencia = (uint8_t)potencia;
+  __sync_synchronize();
+  total = total + 1;         // só agora a amostra fica visível
+}
+
+// Índice da amostra mais antiga ainda no anel
+uint32_t Historico_PI2::primeiro(void) const {
+  uint32_t n = total;
+  return n > HISTORICO_CAPACIDADE ? n - HISTORICO_CAPACIDADE : 0;
+}
+
+// Índice que a próxima amostra vai receber
+uint32_t Historico_PI2::proximo(void) const {
+  return total;
+}
+
+// Copia até `maximo` amostras a partir do índice `desde`, que é avançado
+// para o primeiro índice retido se já tiver sido sobrescrito. Devolve
+// quantas amostras foram copiadas; `desde` + retorno é o próximo pedido.
+size_t Historico_PI2::copiar(uint32_t &desde, AmostraHistorico *destino, size_t maximo) const {
+  size_t n;
+
+  for (;;) {
+    uint32_t fim = total;
+    uint32_t inicio = fim > HISTORICO_CAPACIDADE ? fim - HISTORICO_CAPACIDADE : 0;
+    if (desde < inicio) desde = inicio;
+    if (desde > fim) desde = fim;
+    n = fim - desde;
+    if (n > maximo) n = maximo;
+
+    __sync_synchronize();
+    for (size_t i = 0; i < n; i++)
+      destino[i] = amostras[(desde + i) & (HISTORICO_CAPACIDADE - 1)];
+    __sync_synchronize();
+
+    // as posições copiadas continuam válidas se o produtor não passou
+    // de desde + CAPACIDADE enquanto a cópia acontecia
+    if (total - desde <= HISTORICO_CAPACIDADE) break;
+  }
+  return n;
+}
+
+ReducaoHistorico_PI2::ReducaoHistorico_PI2(const Historico_PI2 &historico, uint32_t desde,
+                                           uint32_t fim, uint16_t pontos)
+  : historico(historico), desde(desde), total(fim > desde ? fim - desde : 0), pontos(pontos) {
+  uint32_t retido = historico.primeiro();
+  if (this->desde < retido) {
+    total = fim > retido ? fim - retido : 0;
+    this->desde = retido;
+  }
+  emitidos = 0;
+  ax = ay = 0;
+  if (this->pontos < 3 || total <= this->pontos) this->pontos = 0;   // sem redução
+}
+
+// Baldes 0..pontos-3 entre a primeira e a última amostra; o pontos-2
+// começa na última
+uint32_t ReducaoHistorico_PI2::inicioBalde(uint16_t balde) const {
+  return 1 + (uint64_t)balde * (total - 2) / (pontos - 2);
+}
+
+bool ReducaoHistorico_PI2::ler(uint32_t deslocamento, AmostraHistorico &amostra) {
+  uint32_t indice = desde + deslocamento;
+  return historico.copiar(indice, &amostra, 1) == 1;
+}
+
+bool ReducaoHistorico_PI2::proxima(uint32_t &indice, AmostraHistorico &amostra) {
+  if (pontos == 0) {
+    if (emitidos >= total) return false;
+    indice = desde + emitidos;
+    return ler(emitidos++, amostra);
+  }
+  if (emitidos >= pontos) return false;
+
+  uint32_t escolhida;
+  if (emitidos == 0 || emitidos == pontos - 1) {
+    escolhida = emitidos == 0 ? 0 : total - 1;
+    if (!ler(escolhida, amostra)) return false;
+  }
+  else {
+    uint16_t balde = emitidos - 1;
+    AmostraHistorico bloco[REDUCAO_BLOCO];
+
+    // média do balde seguinte (o último "balde" é a última amostra)
+    uint32_t inicio = inicioBalde(balde + 1);
+    uint32_t fim = balde + 1 == pontos - 2 ? total : inicioBalde(balde + 2);
+    float cx = 0, cy = 0;
+    uint32_t n = 0;
+    for (uint32_t i = inicio; i < fim;) {
+      uint32_t pedido = desde + i;
+      size_t lidas = historico.copiar(pedido, bloco, fim - i < REDUCAO_BLOCO ? fim - i : REDUCAO_BLOCO);
+      if (lidas == 0) break;
+      for (size_t k = 0; k < lidas; k++) {
+        cx += bloco[k].tempo_s;
+        cy += bloco[k].temperatura_dC;
+      }
+      n += lidas;
+      i += lidas;
+    }
+    if (n == 0) return false;
+    cx /= n;
+    cy /= n;
+
+    // no balde atual, a do maior triângulo com a anterior e a média
+    float maior = -1;
+    escolhida = inicioBalde(balde);
+    fim = inicioBalde(balde + 1);
+    for (uint32_t i = escolhida; i < fim;) {
+      uint32_t pedido = desde + i;
+      size_t lidas = historico.copiar(pedido, bloco, fim - i < REDUCAO_BLOCO ? fim - i : REDUCAO_BLOCO);
+      if (lidas == 0) break;
+      for (size_t k = 0; k < lidas; k++) {
+        float area = fabsf((ax - cx) * (bloco[k].temperatura_dC - ay)
+                           - (ax - bloco[k].tempo_s) * (cy - ay));
+        if (area > maior) {
+          maior = area;
+          escolhida = i + k;
+          amostra = bloco[k];
+        }
+      }
+      i += lidas;
+    }
+    if (maior < 0) return false;
+  }
+
+  ax = amostra.tempo_s;
+  ay = amostra.temperatura_dC;
+  indice = desde + escolhida;
+  emitidos++;
+  return true;
+}
+
+FluxoSerial_PI2::FluxoSerial_PI2(uint8_t formato) {
+  this->formato = formato;
+  cabeca = cauda = 0;
+  perdidos = 0;
+  enviado = tamanho = 0;
+}
+
+// Chamada apenas pela tarefa de controle (único produtor)
+void FluxoSerial_PI2::registrar(const AmostraControle &amostra) {
+  if (cabeca - cauda >= FLUXO_FILA) {   // a UART não deu conta: descarta
+    perdidos = perdidos + 1;
+    return;
+  }
+
+  QuadroFluxo &q = fila[cabeca & (FLUXO_FILA - 1)];
+  q.timestamp = amostra.timestamp;
+  q.rk_dC = (int16_t)lroundf(amostra.rk * 10.0f);
+  q.set_point_dC = (int16_t)lroundf(amostra.set_point * 10.0f);
+  q.uk_c = (int16_t)lroundf(amostra.uk * 100.0f);
+  q.potencia = (uint8_t)amostra.controle_potencia;
+  q.estado = (amostra.array_perfil & 0x1F) | (amostra.desarme ? 0x40 : 0) | (amostra.falha_sensor ? 0x80 : 0);
+  __sync_synchronize();
+  cabeca = cabeca + 1;
+}
+
+// Chamar do loop(): continua o registro em envio e só pega o próximo
+// quando o anterior saiu inteiro
+void FluxoSerial_PI2::atender(Print &saida) {
+  for (;;) {
+    if (enviado == tamanho) {
+      if (cauda == cabeca) return;
+      __sync_synchronize();
+      QuadroFluxo q = fila[cauda & (FLUXO_FILA - 1)];
+      __sync_synchronize();
+      cauda = cauda + 1;
+      tamanho = codificar(q, this->saida);
+      enviado = 0;
+    }
+
+    int livre = saida.availableForWrite();
+    if (livre <= 0) return;
+    size_t n = tamanho - enviado;
+    if (n > (size_t)livre) n = livre;
+    enviado += saida.write(this->saida + enviado, n);
+  }
+}
+
+uint32_t FluxoSerial_PI2::descartados(void) const {
+  return perdidos;
+}
+
+size_t FluxoSerial_PI2::codificar(const QuadroFluxo &q, uint8_t *destino) {
+  if (formato == FLUXO_CSV) {
+    int n = snprintf((char *)destino, sizeof(saida), "%lu,%.1f,%.1f,%.2f,%u,%u\n",
+                     (unsigned long)q.timestamp, q.rk_dC / 10.0f, q.set_point_dC / 10.0f,
+                     q.uk_c / 100.0f, q.potencia, q.estado);
+    return n < (int)sizeof(saida) ? n : sizeof(saida) - 1;
+  }
+
+  // COBS: nenhum byte 0x00 dentro do quadro, o 0x00 final sincroniza o PC
+  uint8_t bruto[sizeof(QuadroFluxo) + 1];
+  memcpy(bruto, &q, sizeof(q));
+  uint8_t xo = 0;
+  for (size_t i = 0; i < sizeof(q); i++) xo ^= bruto[i];
+  bruto[sizeof(q)] = xo;
+
+  size_t codigo = 0, n = 1;
+  for (size_t i = 0; i < sizeof(bruto); i++) {
+    if (bruto[i] == 0) {
+      destino[codigo] = n - codigo;
+      codigo = n++;
+    } else {
+      destino[n++] = bruto[i];
+    }
+  }
+  destino[codigo] = n - codigo;
+  destino[n++] = 0;
+  return n;
+}
+
+#define PERFIL_CICLOS_US (F_CPU / 1000000L)
+
+Perfilador_PI2::Perfilador_PI2() {
+  fechados = 0;
+  n = 0;
+  memset(trechos, 0, sizeof(trechos));
+}
+
+// O mesmo nome devolve sempre o mesmo índice; compara o ponteiro antes do
+// texto porque o nome é quase sempre o mesmo literal
+uint8_t Perfilador_PI2::trecho(const char *nome) {
+  for (uint8_t i = 0; i < n; i++) {
+    if (trechos[i].nome == nome || strcmp(trechos[i].nome, nome) == 0) return i;
+  }
+  if (n == PERFIL_TRECHOS) return PERFIL_NENHUM;
+  trechos[n].nome = nome;
+  trechos[n].minimo = UINT32_MAX;
+  return n++;
+}
+
+void Perfilador_PI2::registrar(uint8_t id, uint32_t ciclos) {
+  if (id >= n) return;
+  TrechoPerfil &t = trechos[id];
+  t.chamadas++;
+  t.soma += ciclos;
+  if (ciclos < t.minimo) t.minimo = ciclos;
+  if (ciclos > t.maximo) t.maximo = ciclos;
+
+  uint32_t us = ciclos / PERFIL_CICLOS_US;
+  uint8_t b = (us < 2) ? 0 : 31 - __builtin_clz(us);
+  if (b >= PERFIL_BALDES) b = PERFIL_BALDES - 1;
+  t.baldes[b]++;
+}
+
+uint8_t Perfilador_PI2::quantos(void) const {
+  return n;
+}
+
+const TrechoPerfil &Perfilador_PI2::ler(uint8_t id) const {
+  return trechos[id];
+}
+
+void Perfilador_PI2::zerar(void) {
+  for (uint8_t i = 0; i < n; i++) {
+    const char *nome = trechos[i].nome;
+    memset(&trechos[i], 0, sizeof(trechos[i]));
+    trechos[i].nome = nome;
+    trechos[i].minimo = UINT32_MAX;
+  }
+}
+
+// "nome;chamadas;min_us;med_us;max_us;b0,b1,...,b11"
+size_t Perfilador_PI2::formatar(uint8_t id, char *destino, size_t tamanho) const {
+  const TrechoPerfil &t = trechos[id];
+  float por_us = PERFIL_CICLOS_US;
+  float minimo = t.chamadas ? t.minimo / por_us : 0;
+  float media = t.chamadas ? (float)t.soma / t.chamadas / por_us : 0;
+  int c = snprintf(destino, tamanho, "%s;%lu;%.1f;%.1f;%.1f;", t.nome, (unsigned long)t.chamadas,
+                   minimo, media, t.maximo / por_us);
+  for (uint8_t b = 0; b < PERFIL_BALDES && c > 0 && (size_t)c < tamanho; b++) {
+    c += snprintf(destino + c, tamanho - c, b ? ",%lu" : "%lu", (unsigned long)t.baldes[b]);
+  }
+  if (c > 0 && (size_t)c < tamanho) c += snprintf(destino + c, tamanho - c, "\n");
+  return (c < 0) ? 0 : ((size_t)c < tamanho ? c : tamanho - 1);
+}
+
+void Perfilador_PI2::imprimir(Print &saida) const {
+  char linha[128];
+  saida.println(PERFIL_CABECALHO);
+  for (uint8_t i = 0; i < n; i++) {
+    formatar(i, linha, sizeof(linha));
+    saida.print(linha);
+  }
+}
+
+uint8_t codificarVarint(uint8_t *p, int32_t v) {
+  uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+  uint8_t n = 0;
+  while (z >= 0x80) {
+    p[n++] = (uint8_t)(z | 0x80);
+    z >>= 7;
+  }
+  p[n++] = (uint8_t)z;
+  return n;
+}
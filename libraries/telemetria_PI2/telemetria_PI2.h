@@ -0,0 +1,245 @@
+/*  Biblioteca de Telemetria do controle do Forno
+ *  Troca de amostras entre a tarefa de controle e os consumidores
+ *  (servidor web, serial) sem desabilitar interrupções.
+ *
+ *  telemetria_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef TelemetriaForno
+#define TelemetriaForno
+
+#include <Arduino.h>
+
+// Retrato do estado do controle em um instante
+struct AmostraControle {
+  uint32_t timestamp;       // millis() da amostra
+  uint32_t instante_rk;     // millis() da leitura do termopar
+  float rk;                 // temperatura lida
+  float set_point;          // temperatura desejada
+  float uk;                 // saída do PID
+  int controle_potencia;    // potência aplicada (0-100)
+  int t_perfil;             // tempo do perfil em s
+  int array_perfil;         // segmento atual do perfil
+  bool falha_sensor;        // termopar aberto
+  uint8_t desarme;          // MotivoDesarme do supervisor, 0 = armado
+  uint8_t corrida;          // EstadoCorrida do sketch
+  uint64_t utc_us;          // µs desde 1970 pelo Relogio_PI2, 0 = não sincronizado
+  float energia_Wh;         // das resistências na corrida atual ou na última
+};
+
+// Seqlock de um produtor e vários consumidores.
+// O produtor deixa o contador ímpar durante a escrita; o consumidor
+// repete a cópia até ler o mesmo contador par antes e depois.
+class Telemetria_PI2 {
+ public:
+  Telemetria_PI2();
+  void publicar(const AmostraControle &amostra);
+  void ler(AmostraControle &amostra) const;
+  uint32_t sequencia(void) const;
+
+ private:
+  volatile uint32_t seq;
+  AmostraControle dados;
+};
+
+// Histórico da corrida: uma amostra compacta por segundo em um anel.
+// 1024 amostras de 5 bytes cobrem 17 min, mais que qualquer perfil.
+#define HISTORICO_CAPACIDADE 1024   // potência de 2
+
+struct AmostraHistorico {
+  uint16_t tempo_s;         // segundos desde reiniciar()
+  int16_t temperatura_dC;   // décimos de grau
+  uint8_t potencia;         // 0-100
+} __attribute__((packed));
+
+// Cada amostra tem um índice absoluto que só cresce; o anel guarda as
+// últimas HISTORICO_CAPACIDADE. Um produtor (controle), consumidores no
+// loop(). O consumidor confere depois da cópia se o produtor deu a volta
+// sobre o que foi copiado.
+class Historico_PI2 {
+ public:
+  Historico_PI2();
+  void reiniciar(void);
+  void registrar(uint16_t tempo_s, float temperatura, int potencia);
+  uint32_t primeiro(void) const;
+  uint32_t proximo(void) const;
+  size_t copiar(uint32_t &desde, AmostraHistorico *destino, size_t maximo) const;
+
+ private:
+  volatile uint32_t total;
+  AmostraHistorico amostras[HISTORICO_CAPACIDADE];
+};
+
+// Redução do histórico a um gráfico de N pontos por LTTB (largest
+// triangle three buckets): fica a primeira e a última amostra e, de cada
+// um dos N-2 baldes entre elas, a que forma o maior triângulo com a
+// escolhida no balde anterior e a média do balde seguinte. Picos e
+// degraus sobrevivem, o que não acontece com uma média. proxima() resolve um
+// balde por vez lendo o anel em blocos de REDUCAO_BLOCO: a memória não
+// depende de N nem da duração. Com até N amostras, saem todas.
+#define REDUCAO_BLOCO 16
+
+class ReducaoHistorico_PI2 {
+ public:
+  ReducaoHistorico_PI2(const Historico_PI2 &historico, uint32_t desde, uint32_t fim, uint16_t pontos);
+  bool proxima(uint32_t &indice, AmostraHistorico &amostra);   // false: acabou
+
+ private:
+  uint32_t inicioBalde(uint16_t balde) const;   // deslocamento desde `desde`
+  bool ler(uint32_t deslocamento, AmostraHistorico &amostra);
+
+  const Historico_PI2 &historico;
+  uint32_t desde, total;
+  uint16_t pontos, emitidos;
+  float ax, ay;             // escolhida no balde anterior: tempo_s, dC
+};
+
+// Fluxo serial de telemetria: um registro por amostra de controle.
+// O controle só enfileira; o loop() codifica e escreve no máximo o que
+// cabe no FIFO da UART (availableForWrite), então nunca espera.
+#define FLUXO_FILA    32      // registros em espera, potência de 2
+#define FLUXO_CSV     1       // "t_ms,rk,set_point,uk,potencia,estado\n"
+#define FLUXO_COBS    2       // registro binário + XOR, COBS, terminado em 0x00
+
+struct QuadroFluxo {
+  uint32_t timestamp;       // millis()
+  int16_t rk_dC;            // décimos de grau
+  int16_t set_point_dC;
+  int16_t uk_c;             // saída do PID em centésimos
+  uint8_t potencia;
+  uint8_t estado;           // bits 0-4 segmento, 6 desarme, 7 falha do sensor
+} __attribute__((packed));
+
+class FluxoSerial_PI2 {
+ public:
+  FluxoSerial_PI2(uint8_t formato);
+  void registrar(const AmostraControle &amostra);
+  void atender(Print &saida);
+  uint32_t descartados(void) const;
+
+ private:
+  size_t codificar(const QuadroFluxo &q, uint8_t *destino);
+
+  uint8_t formato;
+  QuadroFluxo fila[FLUXO_FILA];
+  volatile uint32_t cabeca;   // escrito só pelo produtor
+  volatile uint32_t cauda;    // escrito só pelo consumidor
+  volatile uint32_t perdidos;
+  uint8_t saida[56];          // registro codificado em envio
+  uint8_t enviado, tamanho;
+};
+
+// Relógio UTC monotônico em µs: o relógio local (micros64()) mais um
+// deslocamento corrigido a cada referência externa (SNTP). Um erro pequeno
+// é absorvido aos poucos, no máximo RELOGIO_SLEW_PPM, então o relógio
+// nunca volta nem salta entre amostras; só um adiantamento maior que
+// RELOGIO_DEGRAU_US, ou a primeira referência, muda a hora de uma vez.
+// agora() é só aritmética, para ser lida de qualquer tarefa.
+#define RELOGIO_SLEW_PPM   500UL
+#define RELOGIO_DEGRAU_US  1000000LL
+
+class Relogio_PI2 {
+ public:
+  Relogio_PI2();
+  uint64_t agora(uint64_t local_us) const;
+  void corrigir(uint64_t local_us, uint64_t referencia_us);
+  bool sincronizado(void) const;
+  int64_t erro(void) const;          // referência - relógio na última correção
+
+ private:
+  uint64_t calcular(uint64_t local_us) const;
+
+  volatile uint32_t seq;             // seqlock, como Telemetria_PI2
+  uint64_t baseLocal;                // micros64() da última correção
+  uint64_t baseUtc;                  // hora do relógio nesse instante
+  int64_t pendente;                  // correção ainda a absorver
+  int64_t ultimoErro;
+  bool sinc;
+};
+
+// Perfilador de trechos do código: uma MedidaTrecho lê o contador de
+// ciclos da CPU (CCOUNT do Xtensa) ao ser criada e entrega a diferença ao
+// seu trecho quando sai do escopo. Por trecho: chamadas, mínimo, média,
+// máximo e um histograma em potências de 2 µs. O trecho é registrado pelo
+// nome na primeira passagem; com a tabela cheia, trecho() devolve
+// PERFIL_NENHUM e as medidas dele são ignoradas. O CCOUNT dá a volta a
+// cada 2^32 ciclos (53 s a 80 MHz): só serve para trechos mais curtos.
+// Um trecho conta só o tempo próprio: no ESP8266 os Tickers rodam sempre
+// que o loop() cede (handleClient, WiFi, delay), no meio de um trecho
+// como "web", e o trecho que o Ticker mede ("controle") é descontado do
+// que o contém. No ESP32 o controle roda em outra tarefa, em paralelo, e
+// não há desconto: lá cada trecho é o tempo de parede entre entrar e
+// sair, com o que a outra tarefa tomou do núcleo. Sem trava; não use
+// dentro de uma ISR.
+#define PERFIL_TRECHOS 16
+#define PERFIL_BALDES  12     // [0,2) µs, [2,4), [4,8) ... [1024,2048), 2048 ou mais
+#define PERFIL_NENHUM  0xFF
+#define PERFIL_CABECALHO "trecho;chamadas;min_us;med_us;max_us;<2,<4,<8,<16,<32,<64,<128,<256,<512,<1024,<2048,>=2048 us"   // colunas de formatar()
+
+struct TrechoPerfil {
+  const char *nome;
+  uint32_t chamadas;
+  uint32_t minimo;            // ciclos
+  uint32_t maximo;            // ciclos
+  uint64_t soma;              // ciclos, para a média
+  uint32_t baldes[PERFIL_BALDES];
+};
+
+class Perfilador_PI2 {
+ public:
+  Perfilador_PI2();
+  uint8_t trecho(const char *nome);
+  void registrar(uint8_t id, uint32_t ciclos);
+  uint8_t quantos(void) const;
+  const TrechoPerfil &ler(uint8_t id) const;
+  void zerar(void);          // mantém os nomes, zera as contagens
+  size_t formatar(uint8_t id, char *destino, size_t tamanho) const;
+  void imprimir(Print &saida) const;
+
+  uint32_t fechados;         // ciclos de todos os trechos já fechados (MedidaTrecho)
+
+ private:
+  TrechoPerfil trechos[PERFIL_TRECHOS];
+  uint8_t n;
+};
+
+static inline uint32_t ciclosCpu(void) {
+#if defined(__XTENSA__)
+  uint32_t c;
+  __asm__ __volatile__("rsr %0, ccount" : "=a"(c));
+  return c;
+#else
+  return micros() * (F_CPU / 1000000L);
+#endif
+}
+
+// Os trechos fechados enquanto este estava aberto (aninhados, ou um
+// Ticker que entrou numa cessão) saem do tempo dele; ao fechar, ele entra
+// inteiro em `fechados`, para o trecho que o contém descontar uma vez só
+class MedidaTrecho {
+ public:
+  MedidaTrecho(Perfilador_PI2 &perfilador, uint8_t id)
+    : perfilador(perfilador), id(id), base(perfilador.fechados), inicio(ciclosCpu()) {}
+  ~MedidaTrecho() {
+    uint32_t bruto = ciclosCpu() - inicio;
+#if defined(ESP32)
+    perfilador.registrar(id, bruto);
+#else
+    perfilador.registrar(id, bruto - (perfilador.fechados - base));
+    perfilador.fechados = base + bruto;
+#endif
+  }
+
+ private:
+  Perfilador_PI2 &perfilador;
+  uint8_t id;
+  uint32_t base;
+  uint32_t inicio;
+};
+
+// Inteiro com sinal em zigzag, 7 bits por byte (até 5); devolve os
+// bytes escritos. Usado nos quadros compactos e nos lotes do celular.
+uint8_t codificarVarint(uint8_t *p, int32_t v);
+
+#endif
@@ -0,0 +1,143 @@
+/*  Biblioteca de transporte do Forno
+ *
+ *  transporte_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "transporte_PI2.h"
+
+TransporteReserva_PI2::TransporteReserva_PI2(Client &primario, Client &reserva)
+  : _primario(primario), _reserva(reserva)
+{
+  _ativo = &_primario;
+  _saudePrimario = NULL;
+  _saudeReserva = NULL;
+  _primarioBom = true;
+  _instante = 0;
+  _recusas = 0;
+  _trocas = 0;
+}
+
+// primario: o enlace está de pé (WiFi associado); reserva: dá para abrir
+// conexão por ela (contexto GPRS ativo)
+void TransporteReserva_PI2::saude(SaudeEnlace primario, SaudeEnlace reserva)
+{
+  _saudePrimario = primario;
+  _saudeReserva = reserva;
+}
+
+bool TransporteReserva_PI2::naReserva(void) const
+{
+  return _ativo == &_reserva;
+}
+
+uint32_t TransporteReserva_PI2::trocas(void) const
+{
+  return _trocas;
+}
+
+bool TransporteReserva_PI2::pronto(Client *enlace)
+{
+  if (enlace == &_primario) return _saudePrimario == NULL || _saudePrimario();
+  return _saudeReserva == NULL || _saudeReserva();
+}
+
+// Chamado no loop(), antes de quem usa a conexão
+void TransporteReserva_PI2::atender(void)
+{
+  unsigned long agora = millis();
+  bool bom = pronto(&_primario);
+  if (bom != _primarioBom) {
+    _primarioBom = bom;
+    _instante = agora;
+  }
+
+  if (_ativo == &_primario) {
+    bool caiu = !bom && agora - _instante >= TRANSPORTE_FALHA_MS;
+    if ((caiu || _recusas >= TRANSPORTE_TENTATIVAS) && pronto(&_reserva)) trocar(&_reserva);
+  }
+  else if (bom && (agora - _instante >= TRANSPORTE_VOLTA_MS || !pronto(&_reserva))) {
+    trocar(&_primario);
+  }
+}
+
+// A conexão aberta cai: o dono reconecta, já pelo outro enlace
+void TransporteReserva_PI2::trocar(Client *enlace)
+{
+  _ativo->stop();
+  _ativo = enlace;
+  _instante = millis();
+  _recusas = 0;
+  _trocas++;
+}
+
+void TransporteReserva_PI2::resultado(int conectou)
+{
+  if (_ativo != &_primario) return;
+  if (conectou) _recusas = 0;
+  else if (_recusas < 255) _recusas++;
+}
+
+int TransporteReserva_PI2::connect(IPAddress ip, uint16_t porta)
+{
+  int conectou = _ativo->connect(ip, porta);
+  resultado(conectou);
+  return conectou;
+}
+
+int TransporteReserva_PI2::connect(const char *host, uint16_t porta)
+{
+  int conectou = _ativo->connect(host, porta);
+  resultado(conectou);
+  return conectou;
+}
+
+size_t TransporteReserva_PI2::write(uint8_t c)
+{
+  return _ativo->write(c);
+}
+
+size_t TransporteReserva_PI2::write(const uint8_t *dados, size_t tamanho)
+{
+  return _ativo->write(dados, tamanho);
+}
+
+int TransporteReserva_PI2::available(void)
+{
+  return _ativo->available();
+}
+
+int TransporteReserva_PI2::read(void)
+{
+  return _ativo->read();
+}
+
+int TransporteReserva_PI2::read(uint8_t *destino, size_t tamanho)
+{
+  return _ativo->read(destino, tamanho);
+}
+
+int TransporteReserva_PI2::peek(void)
+{
+  return _ativo->peek();
+}
+
+void TransporteReserva_PI2::flush(void)
+{
+  _ativo->flush();
+}
+
+void TransporteReserva_PI2::stop(void)
+{
+  _ativo->stop();
+}
+
+uint8_t TransporteReserva_PI2::connected(void)
+{
+  return _ativo->connected();
+}
+
+TransporteReserva_PI2::operator bool(void)
+{
+  return _ativo->connected();
+}
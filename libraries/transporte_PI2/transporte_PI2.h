@@ -0,0 +1,64 @@
+/*  Biblioteca de transporte do Forno
+ *  Um Client que junta dois enlaces, o primário (WiFiClient) e a reserva
+ *  (o GsmClient do modem), e entrega a quem publica sempre o que está bom.
+ *  atender(), no loop(), consulta a saúde do primário: fora há
+ *  TRANSPORTE_FALHA_MS, ou com TRANSPORTE_TENTATIVAS connect() seguidos
+ *  recusados, a conexão aberta cai e o próximo connect() sai pela reserva.
+ *  Volta ao primário depois de TRANSPORTE_VOLTA_MS com ele bom, para não
+ *  ficar pulando de um para o outro num sinal fraco. Quem usa (o
+ *  ClienteMqtt_PI2) só vê a conexão cair e reconecta como sempre.
+ *
+ *  transporte_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef TransporteForno
+#define TransporteForno
+
+#include <Arduino.h>
+#include <Client.h>
+
+#define TRANSPORTE_FALHA_MS   2000    // primário fora por isso: vai para a reserva
+#define TRANSPORTE_VOLTA_MS   60000   // primário bom por isso: volta
+#define TRANSPORTE_TENTATIVAS 2       // connect() recusados seguidos com o primário "bom"
+
+typedef bool (*SaudeEnlace)(void);
+
+class TransporteReserva_PI2 : public Client {
+ public:
+  TransporteReserva_PI2(Client &primario, Client &reserva);
+  void saude(SaudeEnlace primario, SaudeEnlace reserva = NULL);
+  void atender(void);
+  bool naReserva(void) const;
+  uint32_t trocas(void) const;
+
+  virtual int connect(IPAddress ip, uint16_t porta);
+  virtual int connect(const char *host, uint16_t porta);
+  virtual size_t write(uint8_t c);
+  virtual size_t write(const uint8_t *dados, size_t tamanho);
+  virtual int available(void);
+  virtual int read(void);
+  virtual int read(uint8_t *destino, size_t tamanho);
+  virtual int peek(void);
+  virtual void flush(void);
+  virtual void stop(void);
+  virtual uint8_t connected(void);
+  virtual operator bool(void);
+
+ private:
+  bool pronto(Client *enlace);
+  void trocar(Client *enlace);
+  void resultado(int conectou);
+
+  Client &_primario;
+  Client &_reserva;
+  Client *_ativo;
+  SaudeEnlace _saudePrimario;   // NULL: sempre bom
+  SaudeEnlace _saudeReserva;
+  bool _primarioBom;
+  unsigned long _instante;      // millis() da última mudança da saúde ou troca
+  uint8_t _recusas;             // connect() seguidos que falharam no primário
+  uint32_t _trocas;
+};
+
+#endif
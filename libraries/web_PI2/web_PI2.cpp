@@ -0,0 +1,1170 @@
+/*  Biblioteca do servidor HTTP do Forno
+ *
+ *  web_PI2.cpp
+ */
+
+#include <Arduino.h>
+#include "web_PI2.h"
+
+#include "lwip/opt.h"
+#include "lwip/tcp.h"
+#include "lwip/inet.h"
+
+static const char *textoStatus(int codigo) {
+  switch (codigo) {
+    case 200: return "OK";
+    case 204: return "No Content";
+    case 301: return "Moved Permanently";
+    case 302: return "Found";
+    case 303: return "See Other";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 403: return "Forbidden";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 409: return "Conflict";
+    case 413: return "Payload Too Large";
+    case 429: return "Too Many Requests";
+    case 431: return "Request Header Fields Too Large";
+    case 500: return "Internal Server Error";
+    case 503: return "Service Unavailable";
+    default:  return "";
+  }
+}
+
+static HTTPMethod lerMetodo(const char *texto) {
+  if (strcmp(texto, "GET") == 0) return HTTP_GET;
+  if (strcmp(texto, "POST") == 0) return HTTP_POST;
+  if (strcmp(texto, "HEAD") == 0) return HTTP_HEAD;
+  if (strcmp(texto, "PUT") == 0) return HTTP_PUT;
+  if (strcmp(texto, "PATCH") == 0) return HTTP_PATCH;
+  if (strcmp(texto, "DELETE") == 0) return HTTP_DELETE;
+  if (strcmp(texto, "OPTIONS") == 0) return HTTP_OPTIONS;
+  return HTTP_ANY;
+}
+
+static int valorHex(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// %XX e '+' de um trecho da URL ou do formulário, em destino, que cabe o
+// trecho inteiro (decodificado nunca cresce); devolve o tamanho
+static size_t decodificar(const char *de, const char *ate, char *destino) {
+  char *p = destino;
+  while (de < ate) {
+    char c = *de++;
+    if (c == '+') c = ' ';
+    else if (c == '%' && ate - de >= 2 && valorHex(de[0]) >= 0 && valorHex(de[1]) >= 0) {
+      c = (char)(valorHex(de[0]) * 16 + valorHex(de[1]));
+      de += 2;
+    }
+    *p++ = c;
+  }
+  return p - destino;
+}
+
+// O trecho, decodificado, é igual a nome? Sem copiar
+static bool igualDecodificado(const char *de, const char *ate, const char *nome) {
+  while (de < ate) {
+    char c = *de++;
+    if (c == '+') c = ' ';
+    else if (c == '%' && ate - de >= 2 && valorHex(de[0]) >= 0 && valorHex(de[1]) >= 0) {
+      c = (char)(valorHex(de[0]) * 16 + valorHex(de[1]));
+      de += 2;
+    }
+    if (*nome++ != c) return false;
+  }
+  return *nome == '\0';
+}
+
+// Os n bytes de texto em base64 são iguais a dado? Compara enquanto codifica
+static bool base64Igual(const uint8_t *p, size_t n, const char *dado) {
+  static const char alfabeto[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  for (size_t i = 0; i < n; i += 3) {
+    uint32_t v = (uint32_t)p[i] << 16;
+    if (i + 1 < n) v |= (uint32_t)p[i + 1] << 8;
+    if (i + 2 < n) v |= p[i + 2];
+    char quatro[4] = {
+      alfabeto[(v >> 18) & 63],
+      alfabeto[(v >> 12) & 63],
+      i + 1 < n ? alfabeto[(v >> 6) & 63] : '=',
+      i + 2 < n ? alfabeto[v & 63] : '='
+    };
+    for (uint8_t k = 0; k < 4; k++) {
+      if (*dado++ != quatro[k]) return false;
+    }
+  }
+  return *dado == '\0';
+}
+
+// ------------------------------------------------------------ cliente retido
+
+ClienteHttp_PI2::ClienteHttp_PI2() {
+  _servidor = NULL;
+  _vaga = 0;
+  _geracao = 0;
+}
+
+ClienteHttp_PI2::ClienteHttp_PI2(ServidorHttp_PI2 *servidor, uint8_t vaga, uint16_t geracao) {
+  _servidor = servidor;
+  _vaga = vaga;
+  _geracao = geracao;
+}
+
+uint8_t ClienteHttp_PI2::connected(void) {
+  return _servidor && _servidor->retida(_vaga, _geracao) ? 1 : 0;
+}
+
+int ClienteHttp_PI2::availableForWrite(void) {
+  ServidorHttp_PI2::Conexao *c = _servidor ? _servidor->retida(_vaga, _geracao) : NULL;
+  return c ? tcp_sndbuf(c->pcb) : 0;
+}
+
+size_t ClienteHttp_PI2::write(const uint8_t *dados, size_t tamanho) {
+  return _servidor ? _servidor->escreverRetida(_vaga, _geracao, dados, tamanho) : 0;
+}
+
+size_t ClienteHttp_PI2::print(const char *texto) {
+  return write((const uint8_t *)texto, strlen(texto));
+}
+
+// Inteiro ou nada, como write(): a cópia da flash sai em pedaços só depois
+// de saber que tudo cabe
+size_t ClienteHttp_PI2::print(const __FlashStringHelper *texto) {
+  PGM_P p = reinterpret_cast<PGM_P>(texto);
+  size_t n = strlen_P(p);
+  if ((size_t)availableForWrite() < n) return 0;
+  char pedaco[64];
+  for (size_t feito = 0; feito < n; ) {
+    size_t k = n - feito < sizeof(pedaco) ? n - feito : sizeof(pedaco);
+    memcpy_P(pedaco, p + feito, k);
+    if (write((const uint8_t *)pedaco, k) != k) return feito;
+    feito += k;
+  }
+  return n;
+}
+
+int ClienteHttp_PI2::available(void) {
+  return 0;
+}
+
+int ClienteHttp_PI2::read(void) {
+  return -1;
+}
+
+void ClienteHttp_PI2::setNoDelay(bool ligado) {
+  ServidorHttp_PI2::Conexao *c = _servidor ? _servidor->retida(_vaga, _geracao) : NULL;
+  if (!c) return;
+  if (ligado) tcp_nagle_disable(c->pcb);
+  else tcp_nagle_enable(c->pcb);
+}
+
+void ClienteHttp_PI2::stop(void) {
+  ServidorHttp_PI2::Conexao *c = _servidor ? _servidor->retida(_vaga, _geracao) : NULL;
+  if (c) _servidor->fechar(*c);
+}
+
+// ------------------------------------------------------------ servidor
+
+ServidorHttp_PI2::ServidorHttp_PI2(uint16_t porta) {
+  _porta = porta;
+  _escuta = NULL;
+  for (uint8_t i = 0; i < HTTP_CONEXOES; i++) {
+    Conexao &c = _conexoes[i];
+    c.pcb = NULL;
+    c.estado = LIVRE;
+    c.geracao = 0;
+    c.entrada = NULL;
+    c.lido = 0;
+    c.saida = NULL;
+    c.naFila = 0;
+  }
+  for (uint8_t i = 0; i < HTTP_ESPERA; i++) _espera[i] = NULL;
+  _rotas = NULL;
+  _quantosColetar = 0;
+  _atual = NULL;
+  _usadosCabecalhos = 0;
+  _cabecalhosPerdidos = 0;
+  _usadosArena = 0;
+  _picoArena = 0;
+  _tamanho = CONTENT_LENGTH_NOT_SET;
+  _respondeu = false;
+  _retida = false;
+  _donoUpload = NULL;
+  _casados = 0;
+  _parte = FIM_MULTIPART;
+  _arquivo = false;
+  _usadosParte = 0;
+  _janela = 0;
+  _pedidos = 0;
+  _recusadas = 0;
+  _derrubadas = 0;
+}
+
+void ServidorHttp_PI2::begin(void) {
+  if (_escuta) return;
+  struct tcp_pcb *pcb = tcp_new();
+  if (!pcb) return;
+  pcb->so_options |= SOF_REUSEADDR;
+  if (tcp_bind(pcb, IP_ADDR_ANY, _porta) != ERR_OK) {
+    tcp_close(pcb);
+    return;
+  }
+  _escuta = tcp_listen(pcb);
+  if (!_escuta) {
+    tcp_close(pcb);
+    return;
+  }
+  tcp_arg(_escuta, this);
+  tcp_accept(_escuta, [](void *arg, struct tcp_pcb *novo, err_t erro) -> err_t {
+    if (erro != ERR_OK || novo == NULL) return ERR_VAL;
+    return static_cast<ServidorHttp_PI2 *>(arg)->aceitar(novo) ? ERR_OK : ERR_ABRT;
+  });
+}
+
+// Callback do lwIP: fora do loop(), só registra a conexão
+bool ServidorHttp_PI2::aceitar(struct tcp_pcb *pcb) {
+  tcp_accepted(_escuta);
+  if (ocupar(pcb)) return true;
+  for (uint8_t i = 0; i < HTTP_ESPERA; i++) {
+    if (!_espera[i]) {
+      esperar(i, pcb);
+      return true;
+    }
+  }
+  _recusadas++;
+  tcp_abort(pcb);
+  return false;
+}
+
+bool ServidorHttp_PI2::ocupar(struct tcp_pcb *pcb) {
+  for (uint8_t i = 0; i < HTTP_CONEXOES; i++) {
+    Conexao &c = _conexoes[i];
+    if (c.estado != LIVRE) continue;
+    c.pcb = pcb;
+    c.entrada = NULL;
+    c.lido = 0;
+    c.fimRemoto = false;
+    reiniciar(c);
+
+    tcp_setprio(pcb, TCP_PRIO_MIN);
+    tcp_arg(pcb, &c);
+    tcp_recv(pcb, [](void *arg, struct tcp_pcb *, struct pbuf *p, err_t) -> err_t {
+      Conexao *c = static_cast<Conexao *>(arg);
+      if (p == NULL) c->fimRemoto = true;
+      else if (c->entrada) pbuf_cat(c->entrada, p);
+      else c->entrada = p;
+      return ERR_OK;
+    });
+    // o lwIP já liberou o pcb; handleClient() libera a vaga
+    tcp_err(pcb, [](void *arg, err_t) {
+      static_cast<Conexao *>(arg)->pcb = NULL;
+    });
+    return true;
+  }
+  return false;
+}
+
+// Sem vaga: o pcb fica parado e o lwIP guarda o que chegar (refused_data)
+// até ocupar() trocar os callbacks
+void ServidorHttp_PI2::esperar(uint8_t i, struct tcp_pcb *pcb) {
+  _espera[i] = pcb;
+  tcp_arg(pcb, &_espera[i]);
+  tcp_recv(pcb, [](void *, struct tcp_pcb *, struct pbuf *p, err_t) -> err_t {
+    return p ? ERR_MEM : ERR_OK;
+  });
+  tcp_err(pcb, [](void *arg, err_t) {
+    *static_cast<struct tcp_pcb **>(arg) = NULL;
+  });
+}
+
+void ServidorHttp_PI2::handleClient(void) {
+  for (uint8_t i = 0; i < HTTP_ESPERA; i++) {
+    if (_espera[i] && ocupar(_espera[i])) _espera[i] = NULL;
+  }
+
+  for (uint8_t i = 0; i < HTTP_CONEXOES; i++) {
+    Conexao &c = _conexoes[i];
+    if (c.estado == LIVRE) continue;
+    if (c.pcb == NULL) {
+      liberar(c);
+      continue;
+    }
+    // pedidos em sequência (pipelining): enquanto a resposta anterior foi
+    // toda ao TCP e o próximo pedido já está na entrada
+    for (uint8_t volta = 0; volta < HTTP_SEGUIDOS; volta++) {
+      EstadoConexao antes = c.estado;
+      uint32_t atendidos = _pedidos;
+      avancar(c);
+      if (c.estado != LENDO || !disponivel(c) || (antes == LENDO && _pedidos == atendidos)) break;
+    }
+    if (c.estado == LIVRE || c.estado == RETIDA) continue;
+    uint32_t prazo = c.estado == ENVIANDO ? HTTP_ENVIO_MS : HTTP_OCIOSA_MS;
+    if (millis() - c.instante > prazo) derrubar(c);
+  }
+}
+
+void ServidorHttp_PI2::avancar(Conexao &c) {
+  switch (c.estado) {
+    case LENDO:    lerPedido(c); break;
+    case CORPO:    lerCorpo(c); break;
+    case UPLOAD:   lerUpload(c); break;
+    case ENVIANDO: empurrar(c); break;
+    case RETIDA:
+      consumir(c, disponivel(c));
+      if (c.fimRemoto) fechar(c);
+      break;
+    default: break;
+  }
+}
+
+void ServidorHttp_PI2::on(const String &caminho, THandlerFunction tratador) {
+  on(caminho, HTTP_ANY, tratador, nullptr);
+}
+
+void ServidorHttp_PI2::on(const String &caminho, HTTPMethod metodo, THandlerFunction tratador) {
+  on(caminho, metodo, tratador, nullptr);
+}
+
+// Na ordem do registro, como o ESP8266WebServer: a primeira que casa atende
+void ServidorHttp_PI2::on(const String &caminho, HTTPMethod metodo, THandlerFunction tratador,
+                          THandlerFunction upload) {
+  Rota *r = new Rota;
+  r->proxima = NULL;
+  r->caminho = caminho;
+  r->metodo = metodo;
+  r->tratador = tratador;
+  r->upload = upload;
+  Rota **fim = &_rotas;
+  while (*fim) fim = &(*fim)->proxima;
+  *fim = r;
+}
+
+void ServidorHttp_PI2::collectHeaders(const char *nomes[], size_t quantidade) {
+  if (quantidade > HTTP_COLETADOS) quantidade = HTTP_COLETADOS;
+  for (size_t i = 0; i < quantidade; i++) _coletar[i] = nomes[i];
+  _quantosColetar = quantidade;
+}
+
+// ------------------------------------------------------------ entrada
+
+size_t ServidorHttp_PI2::disponivel(Conexao &c) {
+  return c.entrada ? c.entrada->tot_len - c.lido : 0;
+}
+
+size_t ServidorHttp_PI2::espiar(Conexao &c, void *destino, size_t max) {
+  size_t n = disponivel(c);
+  if (n > max) n = max;
+  if (n == 0) return 0;
+  return pbuf_copy_partial(c.entrada, destino, n, c.lido);
+}
+
+// Como o ClientContext: só o que foi lido volta à janela do TCP
+void ServidorHttp_PI2::consumir(Conexao &c, size_t n) {
+  if (n && c.pcb) tcp_recved(c.pcb, n);
+  while (n && c.entrada) {
+    size_t resto = c.entrada->len - c.lido;
+    if (n < resto) {
+      c.lido += n;
+      return;
+    }
+    n -= resto;
+    struct pbuf *cabeca = c.entrada;
+    c.entrada = cabeca->next;
+    c.lido = 0;
+    if (c.entrada) pbuf_ref(c.entrada);
+    pbuf_free(cabeca);
+  }
+}
+
+void ServidorHttp_PI2::lerPedido(Conexao &c) {
+  // o "\r\n" que alguns clientes mandam depois do corpo de um POST
+  char b;
+  while (c.usados == 0 && espiar(c, &b, 1) && (b == '\r' || b == '\n')) consumir(c, 1);
+
+  size_t n = espiar(c, c.pedido + c.usados, HTTP_PEDIDO_MAX - c.usados);
+  if (n == 0) {
+    if (c.fimRemoto) fechar(c);
+    return;
+  }
+  c.instante = millis();
+  size_t total = c.usados + n;
+  for (size_t i = c.usados > 3 ? c.usados - 3 : 0; i + 3 < total; i++) {
+    if (memcmp(c.pedido + i, "\r\n\r\n", 4) == 0) {
+      consumir(c, i + 4 - c.usados);   // o corpo e o próximo pedido ficam na entrada
+      c.usados = i + 4;
+      processar(c);
+      return;
+    }
+  }
+  consumir(c, n);
+  c.usados = total;
+  if (c.usados == HTTP_PEDIDO_MAX) recusar(c, 431, "cabecalhos grandes demais");
+}
+
+// Linha do pedido e cabeçalhos, em pedido[0, usados): cada linha termina
+// em "\r\n", trocado por '\0'; os ponteiros da Conexao apontam para lá
+void ServidorHttp_PI2::processar(Conexao &c) {
+  c.tipo = "";
+  c.autorizacao = "";
+  c.consulta = "";
+  for (uint8_t k = 0; k < HTTP_COLETADOS; k++) c.coletados[k] = NULL;
+  const char *conexao = NULL;
+
+  char *p = c.pedido;
+  char *limite = c.pedido + c.usados - 2;   // a linha vazia
+  bool primeira = true;
+  while (p < limite) {
+    char *fim = (char *)memchr(p, '\r', limite - p);
+    if (!fim) break;
+    *fim = '\0';
+    char *linha = p;
+    p = fim + 2;
+
+    if (primeira) {
+      primeira = false;
+      char *alvo = strchr(linha, ' ');
+      char *versao = alvo ? strchr(alvo + 1, ' ') : NULL;
+      if (!versao) {
+        recusar(c, 400, "pedido invalido");
+        return;
+      }
+      *alvo++ = '\0';
+      *versao++ = '\0';
+      c.metodo = lerMetodo(linha);
+      c.http10 = strcmp(versao, "HTTP/1.0") == 0;
+      char *q = strchr(alvo, '?');
+      if (q) {
+        *q = '\0';
+        c.consulta = q + 1;
+      }
+      c.caminho = alvo;
+      continue;
+    }
+
+    char *dp = strchr(linha, ':');
+    if (!dp) continue;
+    *dp = '\0';
+    char *valor = dp + 1;
+    while (*valor == ' ') valor++;
+    if (strcasecmp(linha, "Content-Length") == 0) c.restante = strtoul(valor, NULL, 10);
+    else if (strcasecmp(linha, "Content-Type") == 0) c.tipo = valor;
+    else if (strcasecmp(linha, "Connection") == 0) conexao = valor;
+    else if (strcasecmp(linha, "Authorization") == 0) c.autorizacao = valor;
+    for (uint8_t k = 0; k < _quantosColetar; k++) {
+      if (strcasecmp(linha, _coletar[k]) == 0) c.coletados[k] = valor;
+    }
+  }
+  if (primeira) {
+    recusar(c, 400, "pedido invalido");
+    return;
+  }
+  if (c.http10) c.manter = conexao && strcasecmp(conexao, "keep-alive") == 0;
+  else c.manter = !(conexao && strcasecmp(conexao, "close") == 0);
+
+  for (Rota *r = _rotas; r; r = r->proxima) {
+    if ((r->metodo == HTTP_ANY || r->metodo == c.metodo) && r->caminho == c.caminho) {
+      c.rota = r;
+      break;
+    }
+  }
+
+  if (c.restante == 0) {
+    despachar(c);
+    return;
+  }
+  if (c.rota && c.rota->upload && strncasecmp(c.tipo, "multipart/form-data", 19) == 0) {
+    if (_donoUpload) {
+      recusar(c, 503, "outro upload em andamento");
+      return;
+    }
+    if (!iniciarMultipart(c.tipo)) {
+      recusar(c, 400, "multipart sem boundary");
+      return;
+    }
+    _upload.contentLength = c.restante;
+    _donoUpload = &c;
+    c.estado = UPLOAD;
+    lerUpload(c);
+    return;
+  }
+  if (c.restante > (uint32_t)(HTTP_PEDIDO_MAX - c.usados)) {
+    recusar(c, 413, "corpo grande demais");
+    return;
+  }
+  c.corpo = c.usados;
+  c.estado = CORPO;
+  lerCorpo(c);
+}
+
+void ServidorHttp_PI2::lerCorpo(Conexao &c) {
+  size_t n = espiar(c, c.pedido + c.usados, c.restante);
+  if (n == 0) {
+    if (c.fimRemoto) fechar(c);
+    return;
+  }
+  consumir(c, n);
+  c.usados += n;
+  c.restante -= n;
+  c.instante = millis();
+  if (c.restante) return;
+  c.pedido[c.usados] = '\0';
+  despachar(c);
+}
+
+// Até HTTP_ORCAMENTO bytes por volta: o tratador grava na flash a cada
+// HTTP_UPLOAD_BUFLEN, e o loop() tem mais o que fazer
+void ServidorHttp_PI2::lerUpload(Conexao &c) {
+  uint8_t pedaco[128];
+  size_t orcamento = HTTP_ORCAMENTO;
+  while (c.restante && orcamento) {
+    size_t max = sizeof(pedaco);
+    if (max > c.restante) max = c.restante;
+    if (max > orcamento) max = orcamento;
+    size_t n = espiar(c, pedaco, max);
+    if (n == 0) break;
+    consumir(c, n);
+    c.restante -= n;
+    orcamento -= n;
+    c.instante = millis();
+    for (size_t i = 0; i < n; i++) multipart(pedaco[i]);
+  }
+  if (c.restante) {
+    if (c.fimRemoto && disponivel(c) == 0) fechar(c);   // liberar() avisa o tratador
+    return;
+  }
+  // o corpo acabou sem o delimitador final
+  if (_arquivo) chamarUpload(UPLOAD_FILE_ABORTED);
+  _arquivo = false;
+  _donoUpload = NULL;
+  despachar(c);
+}
+
+// ------------------------------------------------------------ resposta
+
+void ServidorHttp_PI2::preparar(Conexao &c) {
+  _atual = &c;
+  _usadosCabecalhos = 0;
+  _usadosArena = 0;
+  _tamanho = CONTENT_LENGTH_NOT_SET;
+  _respondeu = false;
+  _retida = false;
+  c.fonte = nullptr;
+  c.fragmentado = false;
+  c.concluida = false;
+  c.transbordou = false;
+}
+
+void ServidorHttp_PI2::despachar(Conexao &c) {
+  _pedidos++;
+  preparar(c);
+  if (c.rota) c.rota->tratador();
+  else {
+    const char *texto = formatar("nao encontrado: %s", c.caminho);
+    send(404, "text/plain", texto ? texto : "nao encontrado");
+  }
+  _usadosArena = 0;   // a resposta já foi copiada para a fila
+  if (_retida) {
+    _atual = NULL;
+    c.estado = RETIDA;
+    return;
+  }
+  if (!_respondeu) send(500, "text/plain", "sem resposta");
+  _atual = NULL;
+  finalizar(c);
+}
+
+// Resposta de erro antes do tratador; o resto do pedido não será lido
+void ServidorHttp_PI2::recusar(Conexao &c, int codigo, const char *texto) {
+  c.manter = false;
+  preparar(c);
+  send(codigo, "text/plain", texto);
+  _atual = NULL;
+  finalizar(c);
+}
+
+void ServidorHttp_PI2::finalizar(Conexao &c) {
+  if (!c.concluida && !c.fonte) {
+    if (c.fragmentado) enfileirar(c, "0\r\n\r\n", 5);
+    c.concluida = true;
+  }
+  if (c.transbordou) {
+    derrubar(c);
+    return;
+  }
+  c.estado = ENVIANDO;
+  c.instante = millis();
+  empurrar(c);
+}
+
+// Pronta para o próximo pedido da mesma conexão
+void ServidorHttp_PI2::reiniciar(Conexao &c) {
+  c.estado = LENDO;
+  c.instante = millis();
+  c.usados = 0;
+  c.corpo = 0;
+  c.restante = 0;
+  c.metodo = HTTP_ANY;
+  c.caminho = "";
+  c.consulta = "";
+  c.tipo = "";
+  c.autorizacao = "";
+  c.rota = NULL;
+  c.manter = false;
+  c.http10 = false;
+  c.fonte = nullptr;
+  c.fragmentado = false;
+  c.concluida = false;
+  c.transbordou = false;
+}
+
+// Passa ao TCP o que couber; com a fila vazia, puxa o próximo pedaço da fonte
+void ServidorHttp_PI2::empurrar(Conexao &c) {
+  if (!c.pcb) return;
+  bool escreveu = false;
+  while (true) {
+    if (!c.saida && c.fonte) {
+      uint8_t pedaco[HTTP_BLOCO - 8];   // cabe num bloco com o enquadramento do chunk
+      size_t n = c.fonte(pedaco, sizeof(pedaco));
+      if (n == 0) {
+        c.fonte = nullptr;
+        if (c.fragmentado) enfileirar(c, "0\r\n\r\n", 5);
+        c.concluida = true;
+      }
+      else if (c.fragmentado) fragmento(c, pedaco, n);
+      else enfileirar(c, pedaco, n);
+      if (c.transbordou) {
+        derrubar(c);
+        return;
+      }
+    }
+    BlocoSaida *b = c.saida;
+    if (!b) break;
+    size_t n = b->tamanho - b->enviado;
+    size_t livre = tcp_sndbuf(c.pcb);
+    if (n > livre) n = livre;
+    if (n == 0 || tcp_write(c.pcb, b->dados + b->enviado, n, TCP_WRITE_FLAG_COPY) != ERR_OK) break;
+    escreveu = true;
+    b->enviado += n;
+    c.naFila -= n;
+    if (b->enviado == b->tamanho) {
+      c.saida = b->proximo;
+      free(b);
+    }
+  }
+  if (escreveu) {
+    tcp_output(c.pcb);
+    c.instante = millis();
+  }
+  if (c.estado != ENVIANDO || c.saida || c.fonte || !c.concluida) return;
+  if (c.manter && !c.fimRemoto) reiniciar(c);
+  else fechar(c);
+}
+
+void ServidorHttp_PI2::fechar(Conexao &c) {
+  if (c.pcb) {
+    consumir(c, disponivel(c));   // com dados não lidos o lwIP fecharia com RST
+    tcp_arg(c.pcb, NULL);
+    tcp_recv(c.pcb, NULL);
+    tcp_err(c.pcb, NULL);
+    if (tcp_close(c.pcb) != ERR_OK) tcp_abort(c.pcb);
+  }
+  liberar(c);
+}
+
+void ServidorHttp_PI2::derrubar(Conexao &c) {
+  if (c.pcb) {
+    tcp_arg(c.pcb, NULL);
+    tcp_recv(c.pcb, NULL);
+    tcp_err(c.pcb, NULL);
+    tcp_abort(c.pcb);
+  }
+  _derrubadas++;
+  liberar(c);
+}
+
+void ServidorHttp_PI2::liberar(Conexao &c) {
+  if (_donoUpload == &c) {
+    if (_arquivo) chamarUpload(UPLOAD_FILE_ABORTED);
+    _arquivo = false;
+    _donoUpload = NULL;
+  }
+  if (c.entrada) pbuf_free(c.entrada);
+  c.entrada = NULL;
+  c.lido = 0;
+  while (c.saida) {
+    BlocoSaida *b = c.saida;
+    c.saida = b->proximo;
+    free(b);
+  }
+  c.naFila = 0;
+  c.fonte = nullptr;
+  c.pcb = NULL;
+  c.estado = LIVRE;
+  c.geracao++;
+}
+
+void ServidorHttp_PI2::cabecalho(int codigo, const char *tipo, size_t tamanho) {
+  Conexao &c = *_atual;
+  char linha[64];
+  int n = snprintf(linha, sizeof(linha), "HTTP/1.1 %d %s\r\n", codigo, textoStatus(codigo));
+  enfileirar(c, linha, n);
+  if (tipo && *tipo) {
+    enfileirar(c, "Content-Type: ", 14);
+    enfileirar(c, tipo, strlen(tipo));
+    enfileirar(c, "\r\n", 2);
+  }
+  if (tamanho != CONTENT_LENGTH_UNKNOWN) {
+    n = snprintf(linha, sizeof(linha), "Content-Length: %lu\r\n", (unsigned long)tamanho);
+    enfileirar(c, linha, n);
+  }
+  else if (c.http10) c.manter = false;   // o fim da conexão marca o fim da resposta
+  else {
+    c.fragmentado = true;
+    enfileirar(c, "Transfer-Encoding: chunked\r\n", 28);
+  }
+  // o keep-alive é o padrão do HTTP/1.1: só o 1.0 precisa ouvi-lo
+  if (!c.manter) enfileirar(c, "Connection: close\r\n", 19);
+  else if (c.http10) enfileirar(c, "Connection: keep-alive\r\n", 24);
+  enfileirar(c, _cabecalhos, _usadosCabecalhos);
+  enfileirar(c, "\r\n", 2);
+  _respondeu = true;
+}
+
+// Na fila de saída, sem passar de HTTP_SAIDA_MAX
+bool ServidorHttp_PI2::enfileirar(Conexao &c, const void *dados, size_t n) {
+  if (c.naFila + n > HTTP_SAIDA_MAX) {
+    c.transbordou = true;
+    return false;
+  }
+  const uint8_t *p = (const uint8_t *)dados;
+  BlocoSaida *ultimo = c.saida;
+  while (ultimo && ultimo->proximo) ultimo = ultimo->proximo;
+  while (n) {
+    if (!ultimo || ultimo->tamanho == HTTP_BLOCO) {
+      BlocoSaida *novo = (BlocoSaida *)malloc(sizeof(BlocoSaida));
+      if (!novo) {
+        c.transbordou = true;
+        return false;
+      }
+      novo->proximo = NULL;
+      novo->tamanho = 0;
+      novo->enviado = 0;
+      if (ultimo) ultimo->proximo = novo;
+      else c.saida = novo;
+      ultimo = novo;
+    }
+    size_t k = HTTP_BLOCO - ultimo->tamanho;
+    if (k > n) k = n;
+    memcpy(ultimo->dados + ultimo->tamanho, p, k);
+    ultimo->tamanho += k;
+    c.naFila += k;
+    p += k;
+    n -= k;
+  }
+  return true;
+}
+
+void ServidorHttp_PI2::fragmento(Conexao &c, const void *dados, size_t n) {
+  char tamanho[12];
+  int k = snprintf(tamanho, sizeof(tamanho), "%X\r\n", (unsigned)n);
+  enfileirar(c, tamanho, k);
+  enfileirar(c, dados, n);
+  enfileirar(c, "\r\n", 2);
+}
+
+void ServidorHttp_PI2::sendHeader(const String &nome, const String &valor, bool primeiro) {
+  sendHeader(nome.c_str(), valor.c_str(), primeiro);
+}
+
+// Cabeçalho que não cabe em HTTP_CABECALHOS fica de fora
+void ServidorHttp_PI2::sendHeader(const char *nome, const char *valor, bool primeiro) {
+  size_t a = strlen(nome), b = strlen(valor), n = a + b + 4;
+  if (_usadosCabecalhos + n > HTTP_CABECALHOS) {
+    _cabecalhosPerdidos++;
+    return;
+  }
+  char *linha = _cabecalhos + _usadosCabecalhos;
+  if (primeiro) {
+    memmove(_cabecalhos + n, _cabecalhos, _usadosCabecalhos);
+    linha = _cabecalhos;
+  }
+  memcpy(linha, nome, a);
+  memcpy(linha + a, ": ", 2);
+  memcpy(linha + a + 2, valor, b);
+  memcpy(linha + a + 2 + b, "\r\n", 2);
+  _usadosCabecalhos += n;
+}
+
+void ServidorHttp_PI2::setContentLength(size_t tamanho) {
+  _tamanho = tamanho;
+}
+
+void ServidorHttp_PI2::enviarTexto(int codigo, const char *tipo, const char *conteudo, size_t tamanho) {
+  if (!_atual || _respondeu || _retida) return;
+  cabecalho(codigo, tipo, _tamanho == CONTENT_LENGTH_NOT_SET ? tamanho : _tamanho);
+  if (tamanho == 0) return;
+  if (_atual->fragmentado) fragmento(*_atual, conteudo, tamanho);
+  else enfileirar(*_atual, conteudo, tamanho);
+}
+
+void ServidorHttp_PI2::send(int codigo, const char *tipo, const String &conteudo) {
+  enviarTexto(codigo, tipo, conteudo.c_str(), conteudo.length());
+}
+
+void ServidorHttp_PI2::send(int codigo, const char *tipo, const char *conteudo) {
+  enviarTexto(codigo, tipo, conteudo ? conteudo : "", conteudo ? strlen(conteudo) : 0);
+}
+
+void ServidorHttp_PI2::send(int codigo, const String &tipo, const String &conteudo) {
+  enviarTexto(codigo, tipo.c_str(), conteudo.c_str(), conteudo.length());
+}
+
+// Da flash direto ao TCP, conforme ele aceita: nada passa pela fila inteiro
+void ServidorHttp_PI2::send_P(int codigo, const char *tipo, PGM_P conteudo, size_t tamanho) {
+  if (_tamanho == CONTENT_LENGTH_NOT_SET) _tamanho = tamanho;
+  enviarFonte(codigo, tipo, [conteudo, tamanho](uint8_t *destino, size_t max) mutable {
+    size_t n = tamanho < max ? tamanho : max;
+    memcpy_P(destino, conteudo, n);
+    conteudo += n;
+    tamanho -= n;
+    return n;
+  });
+}
+
+void ServidorHttp_PI2::sendContent(const String &conteudo) {
+  sendContent(conteudo.c_str(), conteudo.length());
+}
+
+void ServidorHttp_PI2::sendContent(const char *conteudo) {
+  sendContent(conteudo, strlen(conteudo));
+}
+
+// Vazio termina a resposta; com a fila perto do limite, o TCP leva antes
+// o que couber agora
+void ServidorHttp_PI2::sendContent(const char *conteudo, size_t tamanho) {
+  if (!_atual || _retida || _atual->concluida) return;
+  Conexao &c = *_atual;
+  if (tamanho == 0) {
+    if (c.fragmentado) enfileirar(c, "0\r\n\r\n", 5);
+    c.concluida = true;
+    return;
+  }
+  if (c.naFila + tamanho + 16 > HTTP_SAIDA_MAX) empurrar(c);
+  if (c.fragmentado) fragmento(c, conteudo, tamanho);
+  else enfileirar(c, conteudo, tamanho);
+}
+
+// A resposta sai da fonte em handleClient(), não dentro do tratador; sem
+// setContentLength(), fragmentada
+void ServidorHttp_PI2::enviarFonte(int codigo, const char *tipo, FonteHttp_PI2 fonte) {
+  if (!_atual || _respondeu || _retida) return;
+  cabecalho(codigo, tipo, _tamanho == CONTENT_LENGTH_NOT_SET ? CONTENT_LENGTH_UNKNOWN : _tamanho);
+  _atual->fonte = fonte;
+}
+
+// ------------------------------------------------------------ pedido atual
+
+HTTPMethod ServidorHttp_PI2::method(void) {
+  return _atual ? _atual->metodo : HTTP_ANY;
+}
+
+String ServidorHttp_PI2::uri(void) {
+  return _atual ? String(_atual->caminho) : String();
+}
+
+bool ServidorHttp_PI2::corpoFormulario(Conexao &c) {
+  return c.corpo && (*c.tipo == '\0' || strncasecmp(c.tipo, "application/x-www-form-urlencoded", 33) == 0);
+}
+
+// "a=1&b=2": o valor, ainda codificado, do primeiro nome igual, até
+// *fimValor; NULL se o nome não aparece
+const char *ServidorHttp_PI2::buscarArg(const char *texto, const char *nome, const char **fimValor) {
+  const char *p = texto;
+  while (*p) {
+    const char *fim = strchr(p, '&');
+    if (!fim) fim = p + strlen(p);
+    const char *igual = (const char *)memchr(p, '=', fim - p);
+    if (igualDecodificado(p, igual ? igual : fim, nome)) {
+      *fimValor = fim;
+      return igual ? igual + 1 : fim;
+    }
+    p = *fim ? fim + 1 : fim;
+  }
+  return NULL;
+}
+
+// Da URL ou do corpo de formulário, decodificado na arena
+const char *ServidorHttp_PI2::argumento(const char *nome) {
+  if (!_atual) return NULL;
+  Conexao &c = *_atual;
+  const char *fim;
+  const char *valor = buscarArg(c.consulta, nome, &fim);
+  if (!valor && c.corpo && strcmp(nome, "plain") == 0) return c.pedido + c.corpo;   // como o ESP8266WebServer
+  if (!valor && corpoFormulario(c)) valor = buscarArg(c.pedido + c.corpo, nome, &fim);
+  if (!valor) return NULL;
+  char *destino = (char *)reservar(fim - valor + 1);
+  if (!destino) return NULL;
+  destino[decodificar(valor, fim, destino)] = '\0';
+  return destino;
+}
+
+// A String já é uma cópia: a arena volta ao que era
+String ServidorHttp_PI2::arg(const String &nome) {
+  size_t usados = _usadosArena;
+  const char *valor = argumento(nome.c_str());
+  String texto = valor ? String(valor) : String();
+  _usadosArena = usados;
+  return texto;
+}
+
+bool ServidorHttp_PI2::hasArg(const String &nome) {
+  if (!_atual) return false;
+  Conexao &c = *_atual;
+  const char *fim;
+  if (buscarArg(c.consulta, nome.c_str(), &fim)) return true;
+  if (c.corpo && nome == "plain") return true;
+  return corpoFormulario(c) && buscarArg(c.pedido + c.corpo, nome.c_str(), &fim);
+}
+
+const char *ServidorHttp_PI2::cabecalhoPedido(const char *nome) {
+  if (!_atual) return NULL;
+  for (uint8_t k = 0; k < _quantosColetar; k++) {
+    if (strcasecmp(nome, _coletar[k]) == 0) return _atual->coletados[k];
+  }
+  return NULL;
+}
+
+String ServidorHttp_PI2::header(const String &nome) {
+  const char *valor = cabecalhoPedido(nome.c_str());
+  return valor ? String(valor) : String();
+}
+
+bool ServidorHttp_PI2::authenticate(const char *usuario, const char *senha) {
+  if (!_atual || strncasecmp(_atual->autorizacao, "Basic ", 6) != 0) return false;
+  const char *dado = _atual->autorizacao + 6;
+  while (*dado == ' ') dado++;
+  size_t usados = _usadosArena;
+  const char *par = formatar("%s:%s", usuario, senha);
+  bool igual = par && base64Igual((const uint8_t *)par, strlen(par), dado);
+  _usadosArena = usados;
+  return igual;
+}
+
+// ------------------------------------------------------------ arena do pedido
+
+void *ServidorHttp_PI2::reservar(size_t tamanho) {
+  size_t inicio = (_usadosArena + 3) & ~(size_t)3;
+  if (inicio + tamanho > HTTP_ARENA) return NULL;
+  _usadosArena = inicio + tamanho;
+  if (_usadosArena > _picoArena) _picoArena = _usadosArena;
+  return _arena + inicio;
+}
+
+char *ServidorHttp_PI2::formatar(const char *formato, ...) {
+  va_list argumentos;
+  va_start(argumentos, formato);
+  char *texto = formatarV(formato, argumentos);
+  va_end(argumentos);
+  return texto;
+}
+
+char *ServidorHttp_PI2::formatarV(const char *formato, va_list argumentos) {
+  char *destino = (char *)_arena + _usadosArena;
+  size_t livre = HTTP_ARENA - _usadosArena;
+  int n = vsnprintf(destino, livre, formato, argumentos);
+  if (n < 0 || (size_t)n >= livre) return NULL;
+  _usadosArena += n + 1;
+  if (_usadosArena > _picoArena) _picoArena = _usadosArena;
+  return destino;
+}
+
+HTTPUpload &ServidorHttp_PI2::upload(void) {
+  return _upload;
+}
+
+// O tratador fica com a conexão: não há resposta a montar nem timeout
+ClienteHttp_PI2 ServidorHttp_PI2::client(void) {
+  if (!_atual) return ClienteHttp_PI2();
+  _retida = true;
+  return ClienteHttp_PI2(this, _atual - _conexoes, _atual->geracao);
+}
+
+ServidorHttp_PI2::Conexao *ServidorHttp_PI2::retida(uint8_t vaga, uint16_t geracao) {
+  if (vaga >= HTTP_CONEXOES) return NULL;
+  Conexao *c = &_conexoes[vaga];
+  if (c->geracao != geracao || !c->pcb || !(c->estado == RETIDA || c == _atual)) return NULL;
+  return c;
+}
+
+size_t ServidorHttp_PI2::escreverRetida(uint8_t vaga, uint16_t geracao, const uint8_t *dados, size_t n) {
+  Conexao *c = retida(vaga, geracao);
+  if (!c || n > tcp_sndbuf(c->pcb)) return 0;
+  if (tcp_write(c->pcb, dados, n, TCP_WRITE_FLAG_COPY) != ERR_OK) return 0;
+  tcp_output(c->pcb);
+  return n;
+}
+
+uint32_t ServidorHttp_PI2::pedidos(void) const {
+  return _pedidos;
+}
+
+uint32_t ServidorHttp_PI2::recusadas(void) const {
+  return _recusadas;
+}
+
+uint32_t ServidorHttp_PI2::derrubadas(void) const {
+  return _derrubadas;
+}
+
+size_t ServidorHttp_PI2::arenaPico(void) const {
+  return _picoArena;
+}
+
+uint32_t ServidorHttp_PI2::cabecalhosPerdidos(void) const {
+  return _cabecalhosPerdidos;
+}
+
+uint8_t ServidorHttp_PI2::abertas(void) const {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < HTTP_CONEXOES; i++) {
+    if (_conexoes[i].estado != LIVRE) n++;
+  }
+  return n;
+}
+
+// ------------------------------------------------------------ multipart
+
+bool ServidorHttp_PI2::iniciarMultipart(const char *tipo) {
+  const char *b = strstr(tipo, "boundary=");
+  if (!b) return false;
+  b += 9;
+  bool aspas = *b == '"';
+  if (aspas) b++;
+  const char *fim = b;
+  while (*fim && *fim != (aspas ? '"' : ';')) fim++;
+  if (fim == b) return false;
+  _fronteira = "\r\n--";
+  while (b < fim) _fronteira += *b++;
+  _casados = 2;   // o corpo começa pela fronteira, sem o "\r\n"
+  _parte = DADOS;
+  _arquivo = false;
+  _usadosParte = 0;
+  _janela = 0;
+  _upload.totalSize = 0;
+  _upload.currentSize = 0;
+  return true;
+}
+
+// Um byte do corpo: a fronteira é reconhecida byte a byte, e o que parecia
+// o começo dela e não era volta aos dados
+void ServidorHttp_PI2::multipart(uint8_t b) {
+  switch (_parte) {
+    case DADOS:
+      if (b == (uint8_t)_fronteira[_casados]) {
+        if (++_casados < _fronteira.length()) return;
+        fimDaParte();
+        _usadosParte = 0;
+        _parte = APOS_FRONTEIRA;
+        return;
+      }
+      if (_casados) {
+        for (uint8_t i = 0; i < _casados; i++) emitir(_fronteira[i]);
+        _casados = 0;
+        if (b == (uint8_t)_fronteira[0]) {   // só o primeiro byte da fronteira é '\r'
+          _casados = 1;
+          return;
+        }
+      }
+      emitir(b);
+      return;
+
+    case APOS_FRONTEIRA:   // "--" encerra, "\r\n" abre a próxima parte
+      _cabecalhoParte[_usadosParte++] = b;
+      if (_usadosParte < 2) return;
+      _parte = _cabecalhoParte[0] == '\r' && _cabecalhoParte[1] == '\n' ? CABECALHOS_PARTE : FIM_MULTIPART;
+      _usadosParte = 0;
+      _janela = 0;
+      return;
+
+    case CABECALHOS_PARTE:
+      if (_usadosParte < sizeof(_cabecalhoParte) - 1) _cabecalhoParte[_usadosParte++] = b;
+      _janela = (_janela << 8) | b;
+      if (_janela != 0x0D0A0D0A) return;
+      _cabecalhoParte[_usadosParte] = '\0';
+      cabecalhoParte();
+      return;
+
+    case FIM_MULTIPART:
+      return;
+  }
+}
+
+static String valorEntreAspas(const char *texto, const char *chave) {
+  const char *p = strstr(texto, chave);
+  if (!p) return String();
+  p += strlen(chave);
+  const char *fim = strchr(p, '"');
+  if (!fim) return String();
+  String valor;
+  while (p < fim) valor += *p++;
+  return valor;
+}
+
+// Só as partes com filename vão ao tratador
+void ServidorHttp_PI2::cabecalhoParte(void) {
+  _parte = DADOS;
+  _casados = 0;
+  String arquivo = valorEntreAspas(_cabecalhoParte, "filename=\"");
+  if (!arquivo.length()) return;
+  _upload.filename = arquivo;
+  _upload.name = valorEntreAspas(_cabecalhoParte, " name=\"");
+  _upload.type = String();
+  for (char *linha = _cabecalhoParte; linha && *linha; ) {
+    char *fim = strstr(linha, "\r\n");
+    if (strncasecmp(linha, "Content-Type:", 13) == 0) {
+      const char *v = linha + 13;
+      while (*v == ' ') v++;
+      while (*v && *v != '\r') _upload.type += *v++;
+    }
+    linha = fim ? fim + 2 : NULL;
+  }
+  _upload.totalSize = 0;
+  _upload.currentSize = 0;
+  _arquivo = true;
+  chamarUpload(UPLOAD_FILE_START);
+}
+
+void ServidorHttp_PI2::emitir(uint8_t b) {
+  if (!_arquivo) return;
+  _upload.buf[_upload.currentSize++] = b;
+  if (_upload.currentSize < HTTP_UPLOAD_BUFLEN) return;
+  chamarUpload(UPLOAD_FILE_WRITE);
+  _upload.totalSize += _upload.currentSize;
+  _upload.currentSize = 0;
+}
+
+void ServidorHttp_PI2::fimDaParte(void) {
+  if (!_arquivo) return;
+  if (_upload.currentSize) {
+    chamarUpload(UPLOAD_FILE_WRITE);
+    _upload.totalSize += _upload.currentSize;
+    _upload.currentSize = 0;
+  }
+  chamarUpload(UPLOAD_FILE_END);
+  _arquivo = false;
+}
+
+// O tratador de upload lê arg() e authenticate() do pedido que o trouxe
+void ServidorHttp_PI2::chamarUpload(HTTPUploadStatus status) {
+  if (!_donoUpload || !_donoUpload->rota || !_donoUpload->rota->upload) return;
+  _upload.status = status;
+  Conexao *antes = _atual;
+  _atual = _donoUpload;
+  _donoUpload->rota->upload();
+  _atual = antes;
+}
@@ -0,0 +1,297 @@
+/*  Biblioteca do servidor HTTP do Forno
+ *  Servidor HTTP/1.1 para o ESP8266 direto sobre os callbacks crus do lwIP
+ *  (tcp_accept, tcp_recv, tcp_err), como o ClientContext do core, no lugar
+ *  do ESP8266WebServer: aquele atende um cliente por vez dentro de
+ *  handleClient() e espera cada leitura e cada escrita, e um navegador
+ *  lento segura o loop() inteiro.
+ *
+ *  Aqui cada conexão (até HTTP_CONEXOES, mais HTTP_ESPERA aceitas e
+ *  paradas até vagar uma) é uma máquina de estados: lendo o pedido, lendo
+ *  o corpo, recebendo um upload, enviando, retida. A linha do pedido, os
+ *  cabeçalhos e um corpo de formulário cabem num buffer fixo de
+ *  HTTP_PEDIDO_MAX bytes por conexão; além disso a resposta é 431 ou 413.
+ *  Os callbacks do lwIP só encadeiam os pbufs recebidos; handleClient(),
+ *  no loop(), avança todas as conexões sem esperar nenhuma: lê o que já
+ *  chegou (e só então devolve a janela com tcp_recved), chama o tratador
+ *  da rota e passa ao TCP o que couber em tcp_sndbuf(). O resto sai nas
+ *  voltas seguintes: os pedaços de sendContent() esperam numa fila de até
+ *  HTTP_SAIDA_MAX bytes e send_P(), streamFile() e enviarFonte() são
+ *  puxados da flash, do arquivo ou da fonte conforme o TCP aceita. A
+ *  conexão fica aberta (keep-alive) até HTTP_OCIOSA_MS sem pedido, e
+ *  pedidos em sequência (pipelining) saem na mesma volta, até
+ *  HTTP_SEGUIDOS, quando cada resposta coube no TCP; quem não lê a
+ *  resposta por HTTP_ENVIO_MS é derrubado.
+ *
+ *  A interface é a parte do ESP8266WebServer que o sketch usa (on, arg,
+ *  send, sendContent, upload, authenticate, client...), com os mesmos
+ *  nomes, para os tratadores servirem aos dois servidores; por isso este
+ *  arquivo não pode ser incluído junto do ESP8266WebServer.h. Uploads
+ *  multipart: um por vez, só as partes com arquivo (argumentos vão na URL).
+ *  Autenticação só básica.
+ *
+ *  Cada pedido tem uma arena de HTTP_ARENA bytes, zerada quando o tratador
+ *  retorna: formatar() escreve nela como o snprintf, argumento() decodifica
+ *  nela, e send() e sendHeader() também aceitam char*, sem String. O que o
+ *  tratador formata só precisa viver até o send(), que copia para a fila de
+ *  saída; uma FonteHttp_PI2, puxada depois, não pode apontar para a arena.
+ *  Os cabeçalhos da resposta ficam num buffer fixo de HTTP_CABECALHOS.
+ *
+ *  web_PI2.h
+ */
+
+  // guarda de inclusão
+#ifndef WebForno
+#define WebForno
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <functional>
+
+#define HTTP_CONEXOES      4
+#define HTTP_ESPERA        4       // aceitas sem vaga, à espera de uma
+#define HTTP_SEGUIDOS      4       // pedidos em sequência da mesma conexão por handleClient()
+#define HTTP_PEDIDO_MAX    1024    // linha do pedido + cabeçalhos + corpo de formulário
+#define HTTP_COLETADOS     4       // cabeçalhos guardados por collectHeaders()
+#define HTTP_SAIDA_MAX     8192    // de sendContent() ainda fora do TCP, por conexão
+#define HTTP_BLOCO         512     // alocação da fila de saída
+#define HTTP_OCIOSA_MS     15000   // keep-alive sem pedido, ou pedido pela metade
+#define HTTP_ENVIO_MS      10000   // resposta parada: o cliente não está lendo
+#define HTTP_ORCAMENTO     4096    // bytes de upload tratados por handleClient()
+#define HTTP_UPLOAD_BUFLEN 1024
+#define HTTP_ARENA         1536    // texto formatado pelo tratador, por pedido
+#define HTTP_CABECALHOS    384     // de sendHeader(), por resposta
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t) -1)
+#define CONTENT_LENGTH_NOT_SET ((size_t) -2)
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+enum HTTPUploadStatus { UPLOAD_FILE_START, UPLOAD_FILE_WRITE, UPLOAD_FILE_END, UPLOAD_FILE_ABORTED };
+
+struct HTTPUpload {
+  HTTPUploadStatus status;
+  String filename;
+  String name;
+  String type;
+  size_t totalSize;       // até o pedaço anterior
+  size_t currentSize;     // em buf
+  size_t contentLength;   // do pedido inteiro
+  uint8_t buf[HTTP_UPLOAD_BUFLEN];
+};
+
+// Próximo pedaço da resposta em destino, até max bytes; 0 termina
+typedef std::function<size_t(uint8_t *destino, size_t max)> FonteHttp_PI2;
+
+struct tcp_pcb;
+struct pbuf;
+class ServidorHttp_PI2;
+
+// A conexão do pedido, tirada do servidor por client() como o WiFiClient
+// do ESP8266WebServer: o tratador escreve a resposta por ela e a conexão
+// continua aberta depois dele (Server-Sent Events). Uma escrita que não
+// cabe no buffer do TCP é recusada inteira, nunca esperada
+class ClienteHttp_PI2 {
+ public:
+  ClienteHttp_PI2();
+  uint8_t connected(void);
+  int availableForWrite(void);
+  size_t write(const uint8_t *dados, size_t tamanho);
+  size_t print(const char *texto);
+  size_t print(const __FlashStringHelper *texto);
+  int available(void);    // o que chega numa conexão retida é descartado
+  int read(void);
+  void setNoDelay(bool ligado);
+  void stop(void);
+
+ private:
+  friend class ServidorHttp_PI2;
+  ClienteHttp_PI2(ServidorHttp_PI2 *servidor, uint8_t vaga, uint16_t geracao);
+
+  ServidorHttp_PI2 *_servidor;
+  uint8_t _vaga;
+  uint16_t _geracao;
+};
+
+class ServidorHttp_PI2 {
+ public:
+  typedef std::function<void(void)> THandlerFunction;
+
+  ServidorHttp_PI2(uint16_t porta = 80);
+  void begin(void);
+  void handleClient(void);   // loop(): nunca espera a rede
+  void on(const String &caminho, THandlerFunction tratador);
+  void on(const String &caminho, HTTPMethod metodo, THandlerFunction tratador);
+  void on(const String &caminho, HTTPMethod metodo, THandlerFunction tratador, THandlerFunction upload);
+  void collectHeaders(const char *nomes[], size_t quantidade);
+
+  // Do pedido em atendimento, dentro de um tratador
+  HTTPMethod method(void);
+  String uri(void);
+  String arg(const String &nome);   // da URL ou do corpo de formulário
+  bool hasArg(const String &nome);
+  String header(const String &nome);
+  const char *cabecalhoPedido(const char *nome);   // coletado, NULL se ausente
+  const char *argumento(const char *nome);         // decodificado na arena, NULL se ausente
+  bool authenticate(const char *usuario, const char *senha);
+  HTTPUpload &upload(void);
+  ClienteHttp_PI2 client(void);
+
+  // Arena do pedido: NULL quando não cabe, e nada é consumido
+  void *reservar(size_t tamanho);
+  char *formatar(const char *formato, ...) __attribute__((format(printf, 2, 3)));
+  char *formatarV(const char *formato, va_list argumentos);
+
+  void sendHeader(const String &nome, const String &valor, bool primeiro = false);
+  void sendHeader(const char *nome, const char *valor, bool primeiro = false);
+  void setContentLength(size_t tamanho);
+  void send(int codigo, const char *tipo = NULL, const String &conteudo = String());
+  void send(int codigo, const char *tipo, const char *conteudo);
+  void send(int codigo, const String &tipo, const String &conteudo);
+  void send_P(int codigo, const char *tipo, PGM_P conteudo, size_t tamanho);
+  void sendContent(const String &conteudo);
+  void sendContent(const char *conteudo);
+  void sendContent(const char *conteudo, size_t tamanho);
+  void enviarFonte(int codigo, const char *tipo, FonteHttp_PI2 fonte);
+
+  template<typename Arquivo> size_t streamFile(Arquivo &arquivo, const String &tipo) {
+    size_t tamanho = arquivo.size();
+    Arquivo copia = arquivo;   // o File é uma referência: continua aberto até o fim do envio
+    setContentLength(tamanho);
+    enviarFonte(200, tipo.c_str(), [copia](uint8_t *destino, size_t max) mutable {
+      return (size_t)copia.read(destino, max);
+    });
+    return tamanho;
+  }
+
+  uint32_t pedidos(void) const;
+  uint32_t recusadas(void) const;    // sem vaga nem espera
+  uint32_t derrubadas(void) const;   // prazo vencido, saída cheia ou pedido grande demais
+  uint8_t abertas(void) const;
+  size_t arenaPico(void) const;      // maior uso da arena num pedido
+  uint32_t cabecalhosPerdidos(void) const;   // não couberam em HTTP_CABECALHOS
+
+ private:
+  friend class ClienteHttp_PI2;
+
+  enum EstadoConexao { LIVRE, LENDO, CORPO, UPLOAD, ENVIANDO, RETIDA };
+  enum ParteMultipart { DADOS, APOS_FRONTEIRA, CABECALHOS_PARTE, FIM_MULTIPART };
+
+  struct Rota {
+    Rota *proxima;
+    String caminho;
+    HTTPMethod metodo;
+    THandlerFunction tratador;
+    THandlerFunction upload;
+  };
+
+  struct BlocoSaida {
+    BlocoSaida *proximo;
+    uint16_t tamanho;
+    uint16_t enviado;
+    uint8_t dados[HTTP_BLOCO];
+  };
+
+  struct Conexao {
+    struct tcp_pcb *pcb;
+    EstadoConexao estado;
+    uint16_t geracao;          // muda a cada uso da vaga: um ClienteHttp_PI2 velho não a reconhece
+    struct pbuf *entrada;      // recebido e ainda não lido
+    uint16_t lido;             // do primeiro pbuf de entrada
+    bool fimRemoto;            // o cliente fechou o lado dele
+    uint32_t instante;         // millis() do último progresso
+
+    char pedido[HTTP_PEDIDO_MAX + 1];
+    uint16_t usados;
+    uint16_t corpo;            // início do corpo em pedido; 0 = sem corpo
+    uint32_t restante;         // bytes do corpo por ler
+    HTTPMethod metodo;
+    const char *caminho;
+    const char *consulta;
+    const char *tipo;
+    const char *autorizacao;
+    const char *coletados[HTTP_COLETADOS];
+    Rota *rota;
+    bool manter;               // keep-alive
+    bool http10;
+
+    BlocoSaida *saida;         // fila ainda fora do TCP
+    size_t naFila;
+    FonteHttp_PI2 fonte;
+    bool fragmentado;          // Transfer-Encoding: chunked
+    bool concluida;            // o tratador terminou a resposta
+    bool transbordou;          // a fila passou de HTTP_SAIDA_MAX
+  };
+
+  bool aceitar(struct tcp_pcb *pcb);
+  bool ocupar(struct tcp_pcb *pcb);
+  void esperar(uint8_t i, struct tcp_pcb *pcb);
+  void avancar(Conexao &c);
+  size_t disponivel(Conexao &c);
+  size_t espiar(Conexao &c, void *destino, size_t max);
+  void consumir(Conexao &c, size_t n);
+  void lerPedido(Conexao &c);
+  void lerCorpo(Conexao &c);
+  void lerUpload(Conexao &c);
+  void processar(Conexao &c);
+  void preparar(Conexao &c);
+  void despachar(Conexao &c);
+  void recusar(Conexao &c, int codigo, const char *texto);
+  void finalizar(Conexao &c);
+  void reiniciar(Conexao &c);
+  void empurrar(Conexao &c);
+  void fechar(Conexao &c);
+  void derrubar(Conexao &c);
+  void liberar(Conexao &c);
+
+  void cabecalho(int codigo, const char *tipo, size_t tamanho);
+  void enviarTexto(int codigo, const char *tipo, const char *conteudo, size_t tamanho);
+  bool enfileirar(Conexao &c, const void *dados, size_t n);
+  void fragmento(Conexao &c, const void *dados, size_t n);
+  bool corpoFormulario(Conexao &c);
+  const char *buscarArg(const char *texto, const char *nome, const char **fimValor);
+  size_t escreverRetida(uint8_t vaga, uint16_t geracao, const uint8_t *dados, size_t n);
+  Conexao *retida(uint8_t vaga, uint16_t geracao);
+
+  bool iniciarMultipart(const char *tipo);
+  void multipart(uint8_t b);
+  void cabecalhoParte(void);
+  void emitir(uint8_t b);
+  void fimDaParte(void);
+  void chamarUpload(HTTPUploadStatus status);
+
+  uint16_t _porta;
+  struct tcp_pcb *_escuta;
+  Conexao _conexoes[HTTP_CONEXOES];
+  struct tcp_pcb *_espera[HTTP_ESPERA];
+  Rota *_rotas;
+  const char *_coletar[HTTP_COLETADOS];
+  uint8_t _quantosColetar;
+
+  // resposta em montagem
+  Conexao *_atual;
+  char _cabecalhos[HTTP_CABECALHOS + 1];
+  uint16_t _usadosCabecalhos;
+  uint32_t _cabecalhosPerdidos;
+  uint8_t _arena[HTTP_ARENA];
+  size_t _usadosArena;
+  size_t _picoArena;
+  size_t _tamanho;
+  bool _respondeu;
+  bool _retida;
+
+  // upload em andamento (um por vez)
+  Conexao *_donoUpload;
+  HTTPUpload _upload;
+  String _fronteira;          // "\r\n--" + boundary
+  uint8_t _casados;           // bytes de _fronteira já reconhecidos
+  ParteMultipart _parte;
+  bool _arquivo;              // a parte atual é um arquivo
+  char _cabecalhoParte[160];
+  uint8_t _usadosParte;
+  uint32_t _janela;           // últimos 4 bytes, para achar o "\r\n\r\n"
+
+  uint32_t _pedidos;
+  uint32_t _recusadas;
+  uint32_t _derrubadas;
+};
+
+#endif
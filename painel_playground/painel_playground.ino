@@ -0,0 +1,256 @@
+/*  Painel do forno no Circuit Playground Express
+ *  Ao lado de cada forno, sem tablet: o anel de NeoPixels mostra o estado
+ *  pela cor e o andamento do perfil pelos pixels acesos (um por segmento),
+ *  o botão A (esquerdo) inicia, o B (direito) aborta e o alto-falante
+ *  avisa desarme, falha do termopar e a hora de abrir a porta. A chave
+ *  deslizante silencia.
+ *
+ *  Entrada: o fluxo serial do forno em COBS (MODO_SERIAL FLUXO_COBS, em
+ *  BAUD_FLUXO): TX do NodeMCU no RX (A6) desta placa, terras juntos. Cada
+ *  quadro é um QuadroFluxo (telemetria_PI2) com temperatura, set point,
+ *  potência e o segmento do perfil; quadro com o XOR errado é descartado.
+ *  Saída: os botões viram os mesmos NEC do controle remoto do forno
+ *  (MODO_IR, integracao_full/ir.ino), pelo LED IR da placa apontado para
+ *  o receptor. Nada muda no forno.
+ *
+ *  O loop() nunca espera: o anel só é reescrito quando algum pixel muda, e
+ *  o show() vai por DMA no SERCOM5 (useDMA), sem travar interrupções nem
+ *  perder bytes da UART; o aviso sonoro é uma onda quadrada gerada pela
+ *  reprodução em segundo plano do alto-falante. Só o envio IR (~70 ms)
+ *  bloqueia, no aperto de um botão.
+ *
+ *  painel_playground.ino
+ */
+
+#include <Adafruit_Circuit_Playground.h>
+#include <telemetria_PI2.h>
+
+#if defined(__AVR__)
+#error "o painel usa o DMA do NeoPixel e o LED IR do Circuit Playground Express"
+#endif
+
+// Os mesmos do forno (integracao_full.ino)
+#define BAUD_FLUXO 460800
+#define IR_ENDERECO 0x00
+#define IR_INICIAR  0x45
+#define IR_ABORTAR  0x47
+
+#define PAINEL_BRILHO 30
+#define PAINEL_SILENCIO_MS 3000    // sem quadro: o forno sumiu ou o cabo soltou
+#define PAINEL_PISCA_MS 500
+#define PAINEL_DEBOUNCE_MS 30
+#define PIXELS 10
+
+#define TOM_TAXA 8000              // amostras/s da reprodução
+#define TOM_AMPLITUDE 300          // em torno do 512 de repouso
+#define TOM_BIPE_MS 150            // bipe e pausa têm a mesma duração
+
+enum EstadoPainel {
+  PAINEL_SEM_DADOS,
+  PAINEL_PARADO,
+  PAINEL_AQUECENDO,
+  PAINEL_RESFRIANDO,
+  PAINEL_DESARME,
+  PAINEL_FALHA
+};
+
+// Cor cheia do pixel do segmento atual; os anteriores ficam em 1/8
+const uint32_t CORES[] = {
+  0x202020,   // sem dados: branco, piscando
+  0x00FF20,   // parado
+  0xFF6000,   // aquecendo
+  0x0040FF,   // resfriando: abrir a porta
+  0xFF0000,   // desarme, piscando
+  0xFF00C0    // falha do termopar, piscando
+};
+
+// Quadro COBS: código, 14 bytes do QuadroFluxo, XOR e o 0x00 final
+uint8_t entrada[sizeof(QuadroFluxo) + 3];
+uint8_t entrada_n = 0;
+bool entrada_perdida = false;      // estourou: espera o próximo 0x00
+
+QuadroFluxo quadro;
+unsigned long quadro_instante = 0;
+bool quadro_valido = false;
+bool resfriando = false;           // set point descendo desde o último quadro
+int16_t set_point_anterior = 0;
+
+EstadoPainel estado = PAINEL_SEM_DADOS;
+uint32_t anel[PIXELS];             // o que o anel mostra agora
+bool anel_pendente = true;         // mudou desde o último show()
+
+bool botao_a = false, botao_b = false;
+unsigned long botao_instante = 0;
+
+// Padrão do aviso, lido pela reprodução em segundo plano
+uint16_t tom_meio = 0;             // amostras por meio período da onda
+uint32_t tom_pos = 0;
+uint32_t tom_total = 0;
+
+void setup()
+{
+  CircuitPlayground.begin(PAINEL_BRILHO);
+  CircuitPlayground.strip.useDMA(true);
+  CircuitPlayground.strip.clear();
+  for(uint8_t i=0; i<PIXELS; i++) anel[i] = 0;
+  Serial1.begin(BAUD_FLUXO);
+}
+
+void loop()
+{
+  receber();
+  atualizarEstado();
+  desenhar();
+  botoes();
+  CircuitPlayground.speaker.update();
+}
+
+// Tudo o que já chegou na UART, sem esperar
+void receber()
+{
+  while(Serial1.available()){
+    uint8_t b = Serial1.read();
+    if(b == 0){
+      if(!entrada_perdida && entrada_n > 0) quadroCompleto();
+      entrada_n = 0;
+      entrada_perdida = false;
+    }
+    else if(entrada_n < sizeof(entrada)) entrada[entrada_n++] = b;
+    else entrada_perdida = true;
+  }
+}
+
+void quadroCompleto()
+{
+  uint8_t bruto[sizeof(QuadroFluxo) + 1];
+  uint8_t n = 0, i = 0;
+  while(i < entrada_n){
+    uint8_t codigo = entrada[i++];
+    for(uint8_t k=1; k<codigo; k++){
+      if(i >= entrada_n || n >= sizeof(bruto)) return;
+      bruto[n++] = entrada[i++];
+    }
+    if(codigo < 0xFF && i < entrada_n){
+      if(n >= sizeof(bruto)) return;
+      bruto[n++] = 0;
+    }
+  }
+  uint8_t xo = 0;
+  for(uint8_t k=0; k<sizeof(QuadroFluxo); k++) xo ^= bruto[k];
+  if(n != sizeof(bruto) || xo != bruto[sizeof(QuadroFluxo)]) return;
+
+  memcpy(&quadro, bruto, sizeof(quadro));
+  if(quadro_valido && quadro.set_point_dC != set_point_anterior){
+    resfriando = quadro.set_point_dC < set_point_anterior;
+  }
+  set_point_anterior = quadro.set_point_dC;
+  quadro_instante = millis();
+  quadro_valido = true;
+}
+
+void atualizarEstado()
+{
+  EstadoPainel novo;
+  uint8_t segmento = quadro.estado & 0x1F;
+  if(!quadro_valido || millis() - quadro_instante > PAINEL_SILENCIO_MS) novo = PAINEL_SEM_DADOS;
+  else if(quadro.estado & 0x80) novo = PAINEL_FALHA;
+  else if(quadro.estado & 0x40) novo = PAINEL_DESARME;
+  else if(segmento > 0 && resfriando) novo = PAINEL_RESFRIANDO;
+  else if(segmento > 0 || quadro.potencia > 0) novo = PAINEL_AQUECENDO;
+  else novo = PAINEL_PARADO;
+
+  if(novo == estado) return;
+  estado = novo;
+  switch(estado){
+    case PAINEL_DESARME:
+    case PAINEL_FALHA:      avisar(440, 3); break;
+    case PAINEL_RESFRIANDO: avisar(1760, 2); break;
+    default: break;
+  }
+}
+
+// Só os pixels que mudaram; o show() sai quando o DMA anterior terminou
+void desenhar()
+{
+  bool aceso = (millis() / PAINEL_PISCA_MS) % 2 == 0;
+  bool pisca = estado == PAINEL_SEM_DADOS || estado == PAINEL_DESARME || estado == PAINEL_FALHA;
+  uint32_t cor = CORES[estado];
+  uint32_t fraca = (cor >> 3) & 0x1F1F1F;
+  uint8_t atual = 0;
+  if(estado != PAINEL_SEM_DADOS){
+    atual = quadro.estado & 0x1F;
+    if(atual >= PIXELS) atual = PIXELS - 1;
+  }
+
+  for(uint8_t i=0; i<PIXELS; i++){
+    uint32_t alvo = 0;
+    if(estado == PAINEL_DESARME || estado == PAINEL_FALHA) alvo = cor;   // o anel todo
+    else if(i < atual) alvo = fraca;
+    else if(i == atual) alvo = cor;
+    if(pisca && !aceso) alvo = 0;
+    if(alvo != anel[i]){
+      anel[i] = alvo;
+      CircuitPlayground.strip.setPixelColor(i, alvo);
+      anel_pendente = true;
+    }
+  }
+  if(anel_pendente && CircuitPlayground.strip.canShow()){
+    CircuitPlayground.strip.show();
+    anel_pendente = false;
+  }
+}
+
+// Na borda de descida de cada botão, com debounce
+void botoes()
+{
+  if(millis() - botao_instante < PAINEL_DEBOUNCE_MS) return;
+  bool a = CircuitPlayground.leftButton();
+  bool b = CircuitPlayground.rightButton();
+  if(a == botao_a && b == botao_b) return;
+  botao_instante = millis();
+  if(a && !botao_a) enviarComando(IR_INICIAR);
+  if(b && !botao_b) enviarComando(IR_ABORTAR);
+  botao_a = a;
+  botao_b = b;
+}
+
+uint8_t inverterBits(uint8_t v)
+{
+  uint8_t r = 0;
+  for(uint8_t i=0; i<8; i++){
+    r = (r << 1) | (v & 1);
+    v >>= 1;
+  }
+  return r;
+}
+
+// O IRLib manda os 32 bits do MSB; o NEC manda cada byte a partir do LSB
+void enviarComando(uint8_t comando)
+{
+  uint8_t a = inverterBits(IR_ENDERECO), c = inverterBits(comando);
+  uint32_t codigo = ((uint32_t)a << 24) | ((uint32_t)(uint8_t)~a << 16) | ((uint32_t)c << 8) | (uint8_t)~c;
+  CircuitPlayground.irSend.send(NEC, codigo);
+}
+
+// bipes de TOM_BIPE_MS em freq Hz, separados por pausas iguais
+void avisar(uint16_t freq, uint8_t bipes)
+{
+  if(!CircuitPlayground.slideSwitch()) return;   // chave para a direita: silêncio
+  tom_meio = TOM_TAXA / freq / 2;
+  tom_pos = 0;
+  tom_total = (uint32_t)(2 * bipes - 1) * TOM_BIPE_MS * TOM_TAXA / 1000;
+  CircuitPlayground.speaker.startPlayback(TOM_TAXA, tomEncher);
+}
+
+uint16_t tomEncher(uint16_t *buf, uint16_t len)
+{
+  const uint32_t bipe = (uint32_t)TOM_BIPE_MS * TOM_TAXA / 1000;
+  uint16_t n = 0;
+  while(n < len && tom_pos < tom_total){
+    bool som = (tom_pos / bipe) % 2 == 0;
+    bool alto = (tom_pos / tom_meio) % 2 == 0;
+    buf[n++] = !som ? 512 : alto ? 512 + TOM_AMPLITUDE : 512 - TOM_AMPLITUDE;
+    tom_pos++;
+  }
+  return n;
+}
@@ -0,0 +1,224 @@
+/*  Emulador de bancada para o ensaio de longa duração (soak)
+ *  Um ESP32 no lugar do forno: responde como o MAX6675 no barramento do
+ *  termopar, gera o cruzamento por zero da rede e lê o gatilho do triac.
+ *  A temperatura sai do mesmo modelo de integracao_full/simulacao/planta.h
+ *  (três atrasos em cascata), alimentado pelos semiciclos em que o forno
+ *  de verdade disparou. O firmware do forno não muda: ele corre perfis
+ *  inteiros, com o supervisor e os Tickers de sempre, sem resistência.
+ *
+ *  Aceleração: parado há RESFRIAR_APOS_S, o modelo esfria ACELERACAO vezes
+ *  mais rápido (a porta aberta). O aquecimento segue o modelo normal: os
+ *  ganhos do forno e o SUPERVISOR_SUBIDA_MAX são os da planta real. Uma
+ *  corrida de SAC305 leva uns 7 min em vez de 12.
+ *
+ *  A cada segundo, uma linha CSV na serial (115200), lida pelo
+ *  integracao_full/simulacao/soak.py:
+ *    t_s,camara,potencia,atraso_us,atrasados
+ *  potencia: % dos semiciclos do último segundo com o gatilho em alto;
+ *  atraso_us: maior atraso do cruzamento por zero até a subida do gatilho
+ *  no último segundo, medido por fora do forno (só há subida quando o
+ *  triac volta a disparar depois de um semiciclo apagado); atrasados:
+ *  subidas depois de ATRASO_LIMITE_US desde o boot, meio semiciclo perdido.
+ *
+ *  Ligações (3,3 V nos dois lados, terras juntos):
+ *    forno maxSO  (D0) <- MISO_PINO    forno maxCS (D1) -> CS_PINO
+ *    forno maxCLK (D2) -> SCK_PINO     forno zero  (D7) <- ZERO_PINO
+ *    forno triac  (D6) -> GATILHO_PINO
+ *  Sem o optoacoplador da placa do forno: o D7 recebe o pulso direto.
+ *
+ *  soak_emulador.ino
+ */
+
+#if !defined(ESP32)
+#error "o emulador usa o SPI escravo e o timer do ESP32"
+#endif
+
+#include <driver/spi_slave.h>
+
+#define SCK_PINO      18
+#define MISO_PINO     19
+#define CS_PINO       5
+#define ZERO_PINO     25
+#define GATILHO_PINO  26
+
+#define REDE_HZ 60
+#define SEMICICLO_US (1000000UL / (2 * REDE_HZ))
+#define PULSO_ZERO_US 20           // largura do pulso no D7 do forno
+#define ATRASO_LIMITE_US 500
+
+// Planta padrão da simulação (parametrosPadrao() em simulador.cpp)
+#define PLANTA_GANHO 4.5           // C/%
+#define PLANTA_TAU_R 25.0          // s
+#define PLANTA_TAU_C 180.0
+#define PLANTA_TAU_T 2.0
+#define PLANTA_AMBIENTE 25.0
+#define ACELERACAO 6               // no resfriamento
+#define RESFRIAR_APOS_S 20         // sem disparo
+
+// A mesma planta de integracao_full/simulacao/planta.h, com o tau da
+// câmara trocável
+class Planta {
+ public:
+  void passo(float potencia, float dt_s, bool acelerar) {
+    resistencia = atraso(resistencia, PLANTA_GANHO * potencia, PLANTA_TAU_R, dt_s);
+    ar = atraso(ar, resistencia, acelerar ? PLANTA_TAU_C / ACELERACAO : PLANTA_TAU_C, dt_s);
+    junta = atraso(junta, ar, PLANTA_TAU_T, dt_s);
+  }
+  float camara() const { return PLANTA_AMBIENTE + ar; }
+  float termopar() const { return PLANTA_AMBIENTE + junta; }
+
+ private:
+  float resistencia = 0, ar = 0, junta = 0;
+
+  static float atraso(float estado, float alvo, float tau, float dt_s) {
+    return alvo + (estado - alvo) * expf(-dt_s / tau);
+  }
+};
+
+Planta planta;
+
+// Escritos pelas interrupções
+volatile uint32_t semiciclos = 0;
+volatile uint32_t ligados = 0;            // semiciclos com o gatilho em alto
+volatile uint32_t instante_zero = 0;      // micros() do último pulso
+volatile uint32_t atraso_maior = 0;       // desde a última linha CSV
+volatile uint32_t atrasados = 0;
+
+hw_timer_t *timer_rede = NULL;
+
+// Uma transação na fila por vez, com a temperatura de quando a anterior
+// terminou; os dois buffers se alternam para o SPI nunca ler um que está
+// sendo escrito
+WORD_ALIGNED_ATTR uint8_t quadros[2][4];
+spi_slave_transaction_t transacoes[2];
+uint8_t proxima = 0;
+uint8_t na_fila = 0;
+
+uint32_t semiciclos_lidos = 0, ligados_lidos = 0;
+uint32_t ultimo_disparo_ms = 0;
+uint32_t linha_ms = 0, linha_semiciclos = 0, linha_ligados = 0;
+
+// Semiciclo: o nível do gatilho até aqui é o do semiciclo que termina
+void IRAM_ATTR cruzamento()
+{
+  if(digitalRead(GATILHO_PINO)) ligados++;
+  semiciclos++;
+  instante_zero = micros();
+  digitalWrite(ZERO_PINO, HIGH);
+  delayMicroseconds(PULSO_ZERO_US);
+  digitalWrite(ZERO_PINO, LOW);
+}
+
+void IRAM_ATTR gatilho()
+{
+  uint32_t atraso = micros() - instante_zero;
+  if(atraso > atraso_maior) atraso_maior = atraso;
+  if(atraso > ATRASO_LIMITE_US && atraso < SEMICICLO_US) atrasados++;
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  pinMode(ZERO_PINO, OUTPUT);
+  digitalWrite(ZERO_PINO, LOW);
+  pinMode(GATILHO_PINO, INPUT_PULLDOWN);
+  attachInterrupt(GATILHO_PINO, gatilho, RISING);
+
+  // O forno lê depois de cada borda de descida do SCK, que fica em alto
+  // entre quadros, e espera o D15 já no CS baixo: modo 2
+  spi_bus_config_t barramento = {};
+  barramento.mosi_io_num = -1;
+  barramento.miso_io_num = MISO_PINO;
+  barramento.sclk_io_num = SCK_PINO;
+  barramento.quadwp_io_num = -1;
+  barramento.quadhd_io_num = -1;
+  spi_slave_interface_config_t escravo = {};
+  escravo.mode = 2;
+  escravo.spics_io_num = CS_PINO;
+  escravo.queue_size = 1;
+  spi_slave_initialize(VSPI_HOST, &barramento, &escravo, 0);   // sem DMA
+  quadroNovo();
+
+#if ESP_ARDUINO_VERSION_MAJOR >= 3
+  timer_rede = timerBegin(1000000);
+  timerAttachInterrupt(timer_rede, cruzamento);
+  timerAlarm(timer_rede, SEMICICLO_US, true, 0);
+#else
+  timer_rede = timerBegin(0, 80, true);
+  timerAttachInterrupt(timer_rede, cruzamento, true);
+  timerAlarmWrite(timer_rede, SEMICICLO_US, true);
+  timerAlarmEnable(timer_rede);
+#endif
+  Serial.println("t_s,camara,potencia,atraso_us,atrasados");
+}
+
+void loop()
+{
+  modelo();
+  atenderSpi();
+  imprimir();
+}
+
+// Os semiciclos que passaram desde a última volta, com a potência média deles
+void modelo()
+{
+  noInterrupts();
+  uint32_t s = semiciclos, l = ligados;
+  interrupts();
+  uint32_t novos = s - semiciclos_lidos;
+  if(novos == 0) return;
+  uint32_t acesos = l - ligados_lidos;
+  semiciclos_lidos = s;
+  ligados_lidos = l;
+  if(acesos > 0) ultimo_disparo_ms = millis();
+
+  bool resfriar = millis() - ultimo_disparo_ms > RESFRIAR_APOS_S * 1000UL;
+  planta.passo(100.0 * acesos / novos, novos * SEMICICLO_US / 1e6, resfriar);
+}
+
+// Cada quadro lido pelo forno é trocado por um com a temperatura de agora
+void atenderSpi()
+{
+  spi_slave_transaction_t *feita;
+  while(spi_slave_get_trans_result(VSPI_HOST, &feita, 0) == ESP_OK){
+    na_fila--;
+    quadroNovo();
+  }
+}
+
+void quadroNovo()
+{
+  if(na_fila > 0) return;
+  float t = planta.termopar();
+  if(t < 0) t = 0;
+  uint16_t contagem = (uint16_t)(t * 4);           // 0,25 C por contagem
+  uint16_t quadro = (contagem & 0x0FFF) << 3;
+  uint8_t *buf = quadros[proxima];
+  buf[0] = quadro >> 8;
+  buf[1] = quadro & 0xFF;
+
+  spi_slave_transaction_t &tr = transacoes[proxima];
+  memset(&tr, 0, sizeof(tr));
+  tr.length = 16;
+  tr.tx_buffer = buf;
+  if(spi_slave_queue_trans(VSPI_HOST, &tr, 0) == ESP_OK){
+    na_fila++;
+    proxima ^= 1;
+  }
+}
+
+void imprimir()
+{
+  if(millis() - linha_ms < 1000) return;
+  linha_ms += 1000;
+  noInterrupts();
+  uint32_t s = semiciclos, l = ligados, maior = atraso_maior, tarde = atrasados;
+  atraso_maior = 0;
+  interrupts();
+  uint32_t n = s - linha_semiciclos;
+  Serial.printf("%lu,%.2f,%lu,%lu,%lu\n", (unsigned long)(millis() / 1000), planta.camara(),
+                (unsigned long)(n ? 100 * (l - linha_ligados) / n : 0), (unsigned long)maior,
+                (unsigned long)tarde);
+  linha_semiciclos = s;
+  linha_ligados = l;
+}
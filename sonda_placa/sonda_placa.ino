@@ -0,0 +1,191 @@
+/*  Sonda sem fio da placa
+ *  Um MAX6675 com o termopar preso à placa no forno (só o termopar entra;
+ *  a sonda fica fora, a bateria) manda cada conversão ao forno por rádio,
+ *  RFM69 ou LoRa pelo RadioHead (RHDatagram), sem confirmação: um pacote
+ *  perdido é coberto pelo seguinte. O pacote e quem o recebe estão no
+ *  sensor_PI2 (PacoteSonda_PI2, FusaoPlaca_PI2) e em integracao_full/sonda.ino.
+ *
+ *  Várias sondas na mesma placa, cada uma com o seu SONDA_NO, leem juntas:
+ *  o forno difunde a cada baliza_ms o relógio dele, a sonda corrige fase e
+ *  deriva do próprio oscilador (RelogioSonda_PI2), lê nos múltiplos de
+ *  periodo_ms do forno e transmite SONDA_NO janelas depois, sem colidir
+ *  com as outras. O rádio só escuta perto da baliza esperada; sem baliza
+ *  escuta sempre e lê a cada SONDA_PERIODO_LIVRE_MS, sem agenda comum.
+ *
+ *  Placa: Arduino Pro Mini 3,3 V / 8 MHz, alimentada direto por uma LiPo
+ *  ou duas AA (sem regulador, a bateria é o VCC medido). O processador
+ *  dorme em idle: o timer0 precisa seguir contando o relógio local.
+ *
+ *  sonda_placa.ino
+ */
+
+#include <SPI.h>
+#include <avr/sleep.h>
+#include <RHDatagram.h>
+#include <sensor_PI2.h>
+
+#define SONDA_NO 1                 // 1 a SONDA_NOS, diferente em cada sonda da placa
+// Os mesmos do forno (integracao_full.ino)
+#define SONDA_RADIO 69             // 69 = RFM69 (RH_RF69), 95 = LoRa (RH_RF95)
+#define SONDA_FREQUENCIA_MHZ 915.0
+#define SONDA_FORNO 100            // SONDA_ENDERECO do forno
+#define SONDA_POTENCIA_DBM 13
+#define SONDA_BATERIA_PACOTES 40   // VCC medido a cada ~10 s
+#define SONDA_PERIODO_LIVRE_MS 250
+#define ESCUTA_ANTES_US 10000      // a escuta abre antes da baliza esperada
+#define ESCUTA_DEPOIS_US 40000     // e fecha depois, se ela não vier
+#define AGENDA_ESPERA_US 2000      // perto da leitura, espera ocupada (o idle acorda a cada ~1 ms)
+
+#if SONDA_RADIO == 95
+#include <RH_RF95.h>
+#define SONDA_BALIZA_ATRASO_US 12000   // do micros64() do forno ao available() aqui
+RH_RF95 radio(10, 2);              // NSS, DIO0 (INT0)
+#else
+#include <RH_RF69.h>
+#define SONDA_BALIZA_ATRASO_US 1200
+RH_RF69 radio(10, 2);
+#endif
+RHDatagram gerente(radio, SONDA_NO);
+
+//Pinos do MAX6675, por bit-bang: o SPI de hardware é do rádio
+#define maxSO  7
+#define maxCS  6
+#define maxCLK 5
+
+MAX6675_PI2 termopar(maxCLK, maxCS, maxSO);
+RelogioSonda_PI2 relogio;
+PacoteSonda_PI2 pacote;
+
+uint16_t periodo_ms = SONDA_PERIODO_LIVRE_MS;   // da baliza
+uint16_t baliza_ms = 1000;
+uint8_t janela_ms = 5;
+uint32_t proxima_ms = 0;       // próxima leitura no relógio do forno; 0 = sem agenda
+uint64_t proxima_local = 0;    // próxima leitura livre
+uint64_t leitura_local = 0;
+uint64_t envio_local = 0;
+bool pendente = false;         // leitura feita, esperando a janela
+
+void setup()
+{
+  pacote.versao = SONDA_VERSAO;
+  pacote.reservado = 0;
+  pacote.sequencia = 0;
+  pacote.bateria_mV = lerVcc();
+  if(!gerente.init()){
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    while(true) sleep_mode();      // sem rádio não há o que fazer
+  }
+#if SONDA_RADIO == 95
+  radio.setModemConfig(RH_RF95::Bw500Cr45Sf128);   // o menor tempo no ar
+  radio.setTxPower(SONDA_POTENCIA_DBM, false);
+#else
+  radio.setModemConfig(RH_RF69::GFSK_Rb250Fd250);
+  radio.setTxPower(SONDA_POTENCIA_DBM);
+#endif
+  radio.setFrequency(SONDA_FREQUENCIA_MHZ);
+  proxima_local = relogioLocal() + MAX6675_CONVERSAO_MS * 1000UL;   // primeira conversão
+}
+
+void loop()
+{
+  receberBaliza();
+  uint64_t agora = relogioLocal();
+  bool sincronizada = relogio.sincronizado(agora);
+
+  // ler solta o CS e recomeça a conversão, que termina (220 ms) antes da próxima
+  if(!pendente && sincronizada){
+    uint32_t mestre_ms = relogio.mestre(agora) / 1000;
+    if(proxima_ms == 0 || (int32_t)(mestre_ms - proxima_ms) > 0){
+      proxima_ms = (mestre_ms / periodo_ms + 1) * periodo_ms;   // (re)começa a agenda
+    }
+    uint64_t alvo = relogio.local(proxima_ms * 1000ULL);
+    if(agora + AGENDA_ESPERA_US >= alvo){
+      while(relogioLocal() < alvo);
+      ler(proxima_ms);
+      envio_local = relogio.local((proxima_ms + (uint32_t)SONDA_NO * janela_ms) * 1000ULL);
+      proxima_ms += periodo_ms;
+    }
+  }
+  else if(!pendente && agora >= proxima_local){
+    proxima_ms = 0;
+    ler(0);
+    envio_local = leitura_local;
+    proxima_local = leitura_local + SONDA_PERIODO_LIVRE_MS * 1000UL;
+  }
+  if(pendente && relogioLocal() >= envio_local) enviar();
+
+  escutar(sincronizada);
+  set_sleep_mode(SLEEP_MODE_IDLE);   // acorda no timer0 ou no DIO0
+  sleep_mode();
+}
+
+// instante_ms = 0: leitura fora da agenda, o forno data pela chegada
+void ler(uint32_t instante_ms)
+{
+  leitura_local = relogioLocal();
+  double celsius = termopar.lerCelsius();
+  pacote.temperatura_q = isnan(celsius) ? SONDA_FALHA : (int16_t)(celsius * 4);
+  pacote.instante_ms = instante_ms;
+  pendente = true;
+}
+
+void enviar()
+{
+  if(pacote.sequencia % SONDA_BATERIA_PACOTES == 0) pacote.bateria_mV = lerVcc();
+  pacote.idade_ms = (relogioLocal() - leitura_local) / 1000;
+  gerente.sendto((uint8_t*)&pacote, sizeof(pacote), SONDA_FORNO);
+  gerente.waitPacketSent();
+  pacote.sequencia++;
+  pendente = false;
+}
+
+// Com o rádio em recepção, a baliza é datada assim que chega
+void receberBaliza()
+{
+  if(radio.mode() != RHGenericDriver::RHModeRx || !gerente.available()) return;
+  uint64_t chegada = relogioLocal();
+  BalizaSonda_PI2 b;
+  uint8_t tamanho = sizeof(b);
+  uint8_t de;
+  if(!gerente.recvfrom((uint8_t*)&b, &tamanho, &de)) return;
+  if(de != SONDA_FORNO || tamanho != sizeof(b) || b.versao != SONDA_VERSAO || b.periodo_ms == 0) return;
+  relogio.sincronizar(b.mestre_us + SONDA_BALIZA_ATRASO_US, chegada);
+  periodo_ms = b.periodo_ms;
+  baliza_ms = b.baliza_ms;
+  janela_ms = b.janela_ms;
+}
+
+// Balizas em k * baliza_ms + periodo_ms / 2 no relógio do forno
+void escutar(bool sincronizada)
+{
+  if(pendente) return;                        // enviar() decide o rádio
+  bool perto = !sincronizada;
+  if(sincronizada){
+    uint64_t intervalo = baliza_ms * 1000ULL;
+    uint64_t fase = (relogio.mestre(relogioLocal()) + intervalo - periodo_ms * 500ULL) % intervalo;
+    perto = fase < ESCUTA_DEPOIS_US || fase > intervalo - ESCUTA_ANTES_US;
+  }
+  if(perto && radio.mode() != RHGenericDriver::RHModeRx) radio.setModeRx();
+  else if(!perto && radio.mode() != RHGenericDriver::RHModeSleep) radio.sleep();
+}
+
+// micros() em 64 bits; o loop() roda a cada ~1 ms, bem antes de uma volta
+uint64_t relogioLocal()
+{
+  static uint32_t ultimo = 0;
+  static uint64_t voltas = 0;
+  uint32_t agora = micros();
+  if(agora < ultimo) voltas += 1ULL << 32;
+  ultimo = agora;
+  return voltas + agora;
+}
+
+// VCC em mV pela referência interna de 1,1 V medida contra o próprio VCC
+uint16_t lerVcc()
+{
+  ADMUX = _BV(REFS0) | _BV(MUX3) | _BV(MUX2) | _BV(MUX1);
+  delay(2);                        // a referência assenta
+  ADCSRA |= _BV(ADSC);
+  while(bit_is_set(ADCSRA, ADSC));
+  return 1125300UL / ADC;          // 1,1 V * 1023 * 1000
+}